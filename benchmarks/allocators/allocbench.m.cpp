@@ -0,0 +1,945 @@
+// allocbench.m.cpp                                                   -*-C++-*-
+
+//@PURPOSE: Benchmark BDE allocators under representative allocation patterns.
+//
+//@DESCRIPTION: This program measures the run time of a set of allocation
+// patterns, each exercised with each of a set of allocators, and writes the
+// results in a machine-readable format (CSV, or JSON Lines) suitable for
+// regression tracking.
+//
+// The 'create-destroy' and 'locality' patterns follow the strategies of the
+// ISO WG21 papers "On Quantifying Memory-Allocation Strategies" (N4468,
+// P0089R0, and P0089R1):
+//
+//: o 'create-destroy': Repeatedly create a container, populate it with a
+//:   number of elements, and destroy it, supplying each container with its
+//:   own, newly-created, allocator.  The total number of elements is constant
+//:   across container sizes.
+//:
+//: o 'locality': Populate a number of "subsystems" (lists of integers) by
+//:   interleaving their insertions, and then repeatedly traverse each
+//:   subsystem.  The 'shared' variant supplies one allocator to all of the
+//:   subsystems, so that the memory of each subsystem is diffused through
+//:   that of the others; the 'per-subsystem' variant supplies each subsystem
+//:   with its own allocator.
+//
+// The remaining patterns model allocation behavior common in our
+// applications:
+//
+//: o 'producer-consumer': Producer threads allocate messages that are
+//:   deallocated by consumer threads, to which they are passed through a
+//:   queue.  Only the thread-safe allocators are exercised.
+//:
+//: o 'container-churn': A long-lived hash map of strings undergoes a long
+//:   sequence of random insertions, erasures, and string growth.
+//:
+//: o 'shared-ptr-graph': Graphs of nodes held by 'bsl::shared_ptr' and
+//:   'bsl::weak_ptr' (created by 'bsl::allocate_shared') are built,
+//:   traversed, and destroyed.
+//
+// The allocators exercised are 'bslma::NewDeleteAllocator',
+// 'bslma::TestAllocator', 'bdlma::MultipoolAllocator',
+// 'bdlma::ConcurrentMultipoolAllocator',
+// 'bdlma::ThreadCachingMultipoolAllocator', and the sequential arenas
+// 'bdlma::SequentialAllocator' and 'bdlma::LocalSequentialAllocator'.  Each
+// trial of a pattern creates the allocators it uses and destroys them before
+// it completes, so that the cost of releasing an arena is measured.
+//
+///Output
+///------
+// For each combination of pattern variant and allocator, the program runs
+// one untimed warm-up trial followed by the requested number of timed trials,
+// and writes one record having the following fields:
+//..
+//  benchmark    name of the pattern (e.g., 'create-destroy')
+//  variant      parameters of the pattern (e.g., 'vector<int>/64')
+//  allocator    name of the allocator (e.g., 'multipool')
+//  threads      number of threads exercising the allocator
+//  scale        workload multiplier
+//  trials       number of timed trials
+//  operations   number of pattern operations performed per trial
+//  min_ns       minimum duration of a trial (in nanoseconds)
+//  median_ns    median duration of a trial (in nanoseconds)
+//  max_ns       maximum duration of a trial (in nanoseconds)
+//  ns_per_op    'median_ns / operations'
+//..
+// Records are written as CSV (with a header line) by default, or as JSON
+// Lines if '-f json' is specified.  Run 'allocbench -h' for the complete set
+// of options.
+
+#include <bdlcc_deque.h>
+
+#include <bdlma_concurrentmultipoolallocator.h>
+#include <bdlma_localsequentialallocator.h>
+#include <bdlma_multipoolallocator.h>
+#include <bdlma_sequentialallocator.h>
+#include <bdlma_threadcachingmultipoolallocator.h>
+
+#include <bslma_allocator.h>
+#include <bslma_newdeleteallocator.h>
+#include <bslma_testallocator.h>
+
+#include <bslmf_assert.h>
+
+#include <bslmt_threadgroup.h>
+
+#include <bsls_alignedbuffer.h>
+#include <bsls_assert.h>
+#include <bsls_timeutil.h>
+#include <bsls_types.h>
+
+#include <bsl_algorithm.h>
+#include <bsl_cstdlib.h>
+#include <bsl_cstring.h>
+#include <bsl_iomanip.h>
+#include <bsl_iostream.h>
+#include <bsl_list.h>
+#include <bsl_memory.h>
+#include <bsl_new.h>
+#include <bsl_set.h>
+#include <bsl_string.h>
+#include <bsl_unordered_map.h>
+#include <bsl_vector.h>
+
+using namespace BloombergLP;
+
+namespace {
+
+typedef bsls::Types::Int64 Int64;
+
+enum {
+    k_ELEMENTS_PER_SCALE = 1 << 16,  // number of elements (or operations)
+                                     // of a pattern per unit of scale
+
+    k_DEFAULT_SCALE      = 4,        // default workload multiplier
+
+    k_DEFAULT_NUM_TRIALS = 5,        // default number of timed trials
+
+    k_LOCAL_BUFFER_SIZE  = 8192,     // size of the buffer of the local
+                                     // sequential allocator
+
+    k_STORAGE_SIZE       = 16384     // size of the in-place storage for an
+                                     // allocator
+};
+
+                          // ======================
+                          // class RandomGenerator
+                          // ======================
+
+class RandomGenerator {
+    // This class provides a fast, deterministic, generator of pseudo-random
+    // numbers (a 32-bit xorshift generator), so that every allocator is
+    // exercised with the same sequence of operations.
+
+    // DATA
+    unsigned int d_state;
+
+  public:
+    // CREATORS
+    explicit RandomGenerator(unsigned int seed = 2463534242U)
+    : d_state(seed)
+    {
+    }
+
+    // MANIPULATORS
+    unsigned int operator()()
+        // Return the next pseudo-random number of this generator.
+    {
+        d_state ^= d_state << 13;
+        d_state ^= d_state >> 17;
+        d_state ^= d_state << 5;
+        return d_state;
+    }
+};
+
+                           // ====================
+                           // struct AllocatorKind
+                           // ====================
+
+struct AllocatorKind {
+    // This 'struct' describes an allocator exercised by the benchmarks.
+
+    // DATA
+    const char        *d_name;          // name reported in the output
+
+    bool               d_isThreadSafe;  // whether the allocator may be used
+                                        // concurrently by multiple threads
+
+    bslma::Allocator *(*d_construct_p)(void *address);
+                                        // create an allocator at 'address'
+};
+
+template <class ALLOCATOR>
+bslma::Allocator *constructAllocator(void *address)
+    // Create a default-constructed 'ALLOCATOR' at the specified 'address' and
+    // return its address.
+{
+    BSLMF_ASSERT(sizeof(ALLOCATOR) <= k_STORAGE_SIZE);
+
+    return new (address) ALLOCATOR();
+}
+
+typedef bdlma::LocalSequentialAllocator<k_LOCAL_BUFFER_SIZE>
+                                                      LocalSequentialAllocator;
+
+const AllocatorKind ALLOCATOR_KINDS[] = {
+    { "newdelete",              true,
+      &constructAllocator<bslma::NewDeleteAllocator>                      },
+    { "test",                   true,
+      &constructAllocator<bslma::TestAllocator>                           },
+    { "multipool",              false,
+      &constructAllocator<bdlma::MultipoolAllocator>                      },
+    { "concurrentmultipool",    true,
+      &constructAllocator<bdlma::ConcurrentMultipoolAllocator>            },
+    { "threadcachingmultipool", true,
+      &constructAllocator<bdlma::ThreadCachingMultipoolAllocator>         },
+    { "sequential",             false,
+      &constructAllocator<bdlma::SequentialAllocator>                     },
+    { "localsequential",        false,
+      &constructAllocator<LocalSequentialAllocator>                       }
+};
+
+const int NUM_ALLOCATOR_KINDS = sizeof  ALLOCATOR_KINDS
+                              / sizeof *ALLOCATOR_KINDS;
+
+                           // ====================
+                           // class TrialAllocator
+                           // ====================
+
+class TrialAllocator {
+    // This class creates, in place, an allocator of a specified kind, and
+    // destroys it (thereby releasing all memory it manages) on destruction.
+
+    // DATA
+    bsls::AlignedBuffer<k_STORAGE_SIZE>  d_storage;      // allocator storage
+    bslma::Allocator                    *d_allocator_p;  // created allocator
+
+  private:
+    // NOT IMPLEMENTED
+    TrialAllocator(const TrialAllocator&);
+    TrialAllocator& operator=(const TrialAllocator&);
+
+  public:
+    // CREATORS
+    explicit TrialAllocator(const AllocatorKind& kind)
+    : d_allocator_p(kind.d_construct_p(d_storage.buffer()))
+    {
+    }
+
+    ~TrialAllocator()
+    {
+        d_allocator_p->~Allocator();
+    }
+
+    // ACCESSORS
+    bslma::Allocator *get() const
+        // Return the address of the allocator created by this object.
+    {
+        return d_allocator_p;
+    }
+};
+
+// ============================================================================
+//                          PATTERN: create-destroy
+// ----------------------------------------------------------------------------
+
+void appendElement(bsl::vector<int> *container, int value)
+    // Append the specified 'value' to the specified 'container'.
+{
+    container->push_back(value);
+}
+
+void appendElement(bsl::list<int> *container, int value)
+    // Append the specified 'value' to the specified 'container'.
+{
+    container->push_back(value);
+}
+
+void appendElement(bsl::set<bsl::string> *container, int value)
+    // Insert into the specified 'container' a string, distinct for each
+    // specified 'value', that is too long for the short-string optimization.
+{
+    bsl::string element(32 + value % 16, 'x', container->get_allocator());
+    bsl::memcpy(&element[0], &value, sizeof value);
+    container->insert(element);
+}
+
+void appendElement(bsl::unordered_map<int, bsl::string> *container,
+                   int                                   value)
+    // Insert into the specified 'container' an element having the specified
+    // 'value' as key, and a string too long for the short-string optimization
+    // as mapped value.
+{
+    (*container)[value].assign(32 + value % 16, 'x');
+}
+
+template <class CONTAINER>
+Int64 createDestroy(const AllocatorKind& kind, int size, int scale)
+    // Repeatedly create a 'CONTAINER' having the specified 'size' elements,
+    // using a newly-created allocator of the specified 'kind', and destroy it,
+    // until a total of the specified 'scale' times 'k_ELEMENTS_PER_SCALE'
+    // elements have been created.  Return the number of elements created.
+{
+    const Int64 numElements   = static_cast<Int64>(k_ELEMENTS_PER_SCALE)
+                                                                      * scale;
+    const Int64 numContainers = numElements / size;
+
+    for (Int64 i = 0; i < numContainers; ++i) {
+        TrialAllocator allocator(kind);
+
+        CONTAINER container(allocator.get());
+        for (int j = 0; j < size; ++j) {
+            appendElement(&container, j);
+        }
+    }
+
+    return numContainers * size;
+}
+
+// ============================================================================
+//                             PATTERN: locality
+// ----------------------------------------------------------------------------
+
+enum { k_NUM_SUBSYSTEMS = 16, k_NUM_PASSES = 8 };
+
+Int64 locality(const AllocatorKind& kind, int perSubsystem, int scale)
+    // Populate 'k_NUM_SUBSYSTEMS' lists with a total of the specified 'scale'
+    // times 'k_ELEMENTS_PER_SCALE' elements, interleaving their insertions,
+    // and traverse each list 'k_NUM_PASSES' times, supplying each list with
+    // its own allocator of the specified 'kind' if the specified
+    // 'perSubsystem' is non-zero, and a single, shared, allocator of 'kind'
+    // otherwise.  Return the number of elements inserted or visited.
+{
+    typedef bsl::list<int> Subsystem;
+
+    const int numElements = k_ELEMENTS_PER_SCALE * scale;
+    const int numAllocators = perSubsystem ? k_NUM_SUBSYSTEMS : 1;
+
+    TrialAllocator *allocators[k_NUM_SUBSYSTEMS];
+    for (int i = 0; i < numAllocators; ++i) {
+        allocators[i] = new TrialAllocator(kind);
+    }
+
+    Int64 sum = 0;
+    {
+        bsls::AlignedBuffer<sizeof(Subsystem)> buffers[k_NUM_SUBSYSTEMS];
+        Subsystem *subsystems[k_NUM_SUBSYSTEMS];
+
+        for (int i = 0; i < k_NUM_SUBSYSTEMS; ++i) {
+            subsystems[i] = new (buffers[i].buffer())
+                              Subsystem(allocators[i % numAllocators]->get());
+        }
+
+        for (int i = 0; i < numElements; ++i) {
+            subsystems[i % k_NUM_SUBSYSTEMS]->push_back(i);
+        }
+
+        for (int i = 0; i < k_NUM_SUBSYSTEMS; ++i) {
+            for (int pass = 0; pass < k_NUM_PASSES; ++pass) {
+                for (Subsystem::const_iterator it  = subsystems[i]->begin();
+                                               it != subsystems[i]->end();
+                                             ++it) {
+                    sum += *it;
+                }
+            }
+        }
+
+        for (int i = 0; i < k_NUM_SUBSYSTEMS; ++i) {
+            subsystems[i]->~Subsystem();
+        }
+    }
+
+    for (int i = 0; i < numAllocators; ++i) {
+        delete allocators[i];
+    }
+
+    BSLS_ASSERT(0 < sum);
+
+    return static_cast<Int64>(numElements) * (1 + k_NUM_PASSES);
+}
+
+// ============================================================================
+//                         PATTERN: producer-consumer
+// ----------------------------------------------------------------------------
+
+struct Message {
+    // This 'struct' models a message passed from a producer thread to a
+    // consumer thread.
+
+    // DATA
+    bsl::string       d_topic;
+    bsl::vector<char> d_payload;
+
+    // CREATORS
+    explicit Message(bslma::Allocator *basicAllocator)
+    : d_topic(basicAllocator)
+    , d_payload(basicAllocator)
+    {
+    }
+};
+
+typedef bdlcc::Deque<Message *> MessageQueue;
+
+class Producer {
+    // This class provides a functor that allocates messages and pushes them
+    // onto a queue.
+
+    // DATA
+    MessageQueue     *d_queue_p;
+    bslma::Allocator *d_allocator_p;
+    int               d_numMessages;
+    unsigned int      d_seed;
+
+  public:
+    // CREATORS
+    Producer(MessageQueue     *queue,
+             bslma::Allocator *allocator,
+             int               numMessages,
+             unsigned int      seed)
+    : d_queue_p(queue)
+    , d_allocator_p(allocator)
+    , d_numMessages(numMessages)
+    , d_seed(seed)
+    {
+    }
+
+    // ACCESSORS
+    void operator()() const
+        // Push 'd_numMessages' messages, allocated from 'd_allocator_p' and
+        // having payloads of random size, onto 'd_queue_p'.
+    {
+        RandomGenerator random(d_seed);
+
+        for (int i = 0; i < d_numMessages; ++i) {
+            Message *message = new (*d_allocator_p) Message(d_allocator_p);
+            message->d_topic.assign(24 + i % 32, 't');
+            message->d_payload.resize(16 + random() % 1009);
+            d_queue_p->pushBack(message);
+        }
+    }
+};
+
+class Consumer {
+    // This class provides a functor that pops messages from a queue and
+    // deallocates them.
+
+    // DATA
+    MessageQueue     *d_queue_p;
+    bslma::Allocator *d_allocator_p;
+
+  public:
+    // CREATORS
+    Consumer(MessageQueue *queue, bslma::Allocator *allocator)
+    : d_queue_p(queue)
+    , d_allocator_p(allocator)
+    {
+    }
+
+    // ACCESSORS
+    void operator()() const
+        // Pop messages from 'd_queue_p' and deallocate them to
+        // 'd_allocator_p', until a null message is popped.
+    {
+        while (Message *message = d_queue_p->popFront()) {
+            d_allocator_p->deleteObject(message);
+        }
+    }
+};
+
+Int64 producerConsumer(const AllocatorKind& kind,
+                       int                  numProducers,
+                       int                  scale)
+    // Pass a total of the specified 'scale' times 'k_ELEMENTS_PER_SCALE'
+    // messages, allocated from an allocator of the specified 'kind', from the
+    // specified 'numProducers' producer threads to as many consumer threads.
+    // Return the number of messages passed.
+{
+    const int numMessages = k_ELEMENTS_PER_SCALE * scale / numProducers;
+
+    TrialAllocator           allocator(kind);
+    bslma::NewDeleteAllocator queueAllocator;
+    MessageQueue             queue(1024, &queueAllocator);
+
+    bslmt::ThreadGroup consumers(&queueAllocator);
+    consumers.addThreads(Consumer(&queue, allocator.get()), numProducers);
+
+    bslmt::ThreadGroup producers(&queueAllocator);
+    for (int i = 0; i < numProducers; ++i) {
+        producers.addThread(Producer(&queue,
+                                     allocator.get(),
+                                     numMessages,
+                                     2463534242U + i));
+    }
+    producers.joinAll();
+
+    for (int i = 0; i < numProducers; ++i) {
+        queue.pushBack(0);
+    }
+    consumers.joinAll();
+
+    return static_cast<Int64>(numMessages) * numProducers;
+}
+
+// ============================================================================
+//                          PATTERN: container-churn
+// ----------------------------------------------------------------------------
+
+Int64 containerChurn(const AllocatorKind& kind, int numLiveKeys, int scale)
+    // Populate a hash map, using an allocator of the specified 'kind', with
+    // the specified 'numLiveKeys' elements having string values, and then
+    // perform the specified 'scale' times 'k_ELEMENTS_PER_SCALE' random
+    // insertions, erasures, and appends to the string values, maintaining
+    // approximately 'numLiveKeys' elements.  Return the number of operations
+    // performed.
+{
+    typedef bsl::unordered_map<int, bsl::string> Map;
+
+    const Int64 numOperations = static_cast<Int64>(k_ELEMENTS_PER_SCALE)
+                                                                      * scale;
+
+    TrialAllocator  allocator(kind);
+    RandomGenerator random;
+
+    Map map(allocator.get());
+    for (int i = 0; i < numLiveKeys; ++i) {
+        map[i].assign(16 + random() % 128, 'v');
+    }
+
+    for (Int64 i = 0; i < numOperations; ++i) {
+        const unsigned int r   = random();
+        const int          key = static_cast<int>(r % (2 * numLiveKeys));
+
+        Map::iterator it = map.find(key);
+        if (map.end() == it) {
+            map[key].assign(16 + (r >> 8) % 128, 'v');
+        }
+        else if (0 == ((r >> 24) & 3)) {
+            it->second.append(24, 'a');
+        }
+        else {
+            map.erase(it);
+        }
+    }
+
+    return numOperations;
+}
+
+// ============================================================================
+//                         PATTERN: shared-ptr-graph
+// ----------------------------------------------------------------------------
+
+struct Node {
+    // This 'struct' models a node of a graph of objects having shared
+    // ownership.
+
+    // DATA
+    bsl::vector<bsl::shared_ptr<Node> > d_children;  // owned
+    bsl::vector<bsl::weak_ptr<Node> >   d_links;     // not owned
+    int                                 d_value;
+
+    // CREATORS
+    Node(int value, bslma::Allocator *basicAllocator)
+    : d_children(basicAllocator)
+    , d_links(basicAllocator)
+    , d_value(value)
+    {
+    }
+};
+
+Int64 sharedPtrGraph(const AllocatorKind& kind, int numNodes, int scale)
+    // Repeatedly build a random tree of the specified 'numNodes' nodes, each
+    // created by 'bsl::allocate_shared' using an allocator of the specified
+    // 'kind', having an additional weak link from each node to another random
+    // node, traverse it, following the weak links, and destroy it, until a
+    // total of the specified 'scale' times 'k_ELEMENTS_PER_SCALE' nodes have
+    // been created.  Return the number of nodes created.
+{
+    const Int64 numGraphs = static_cast<Int64>(k_ELEMENTS_PER_SCALE) * scale
+                                                                   / numNodes;
+
+    TrialAllocator   allocator(kind);
+    bslma::Allocator *alloc = allocator.get();
+    RandomGenerator  random;
+    Int64            sum = 0;
+
+    for (Int64 graph = 0; graph < numGraphs; ++graph) {
+        bsl::shared_ptr<Node> root;
+        {
+            bsl::vector<Node *> nodes(alloc);
+            nodes.reserve(numNodes);
+
+            root = bsl::allocate_shared<Node>(alloc, 0, alloc);
+            nodes.push_back(root.get());
+
+            for (int i = 1; i < numNodes; ++i) {
+                bsl::shared_ptr<Node> node =
+                                   bsl::allocate_shared<Node>(alloc, i, alloc);
+
+                nodes[random() % i]->d_children.push_back(node);
+                nodes.push_back(node.get());
+            }
+
+            for (int i = 0; i < numNodes; ++i) {
+                Node *target = nodes[random() % numNodes];
+                nodes[i]->d_links.push_back(
+                            bsl::shared_ptr<Node>(root, target));
+            }
+        }
+
+        bsl::vector<Node *> stack(alloc);
+        stack.push_back(root.get());
+        while (!stack.empty()) {
+            Node *node = stack.back();
+            stack.pop_back();
+
+            sum += node->d_value;
+            for (bsl::size_t i = 0; i < node->d_links.size(); ++i) {
+                bsl::shared_ptr<Node> link = node->d_links[i].lock();
+                if (link) {
+                    sum += link->d_value;
+                }
+            }
+            for (bsl::size_t i = 0; i < node->d_children.size(); ++i) {
+                stack.push_back(node->d_children[i].get());
+            }
+        }
+    }
+
+    BSLS_ASSERT(0 < sum);
+
+    return numGraphs * numNodes;
+}
+
+// ============================================================================
+//                                BENCHMARKS
+// ----------------------------------------------------------------------------
+
+struct Benchmark {
+    // This 'struct' describes a variant of a pattern.
+
+    // DATA
+    const char *d_name;          // name of the pattern
+
+    const char *d_variant;       // description of 'd_parameter'
+
+    int         d_parameter;     // parameter passed to 'd_run_p'
+
+    int         d_numThreads;    // number of threads exercising the
+                                 // allocator; if greater than 1, only
+                                 // thread-safe allocators are exercised
+
+    Int64     (*d_run_p)(const AllocatorKind&, int parameter, int scale);
+                                 // run one trial and return the number of
+                                 // operations performed
+};
+
+const Benchmark BENCHMARKS[] = {
+    { "create-destroy",    "vector<int>/64",                  64,  1,
+      &createDestroy<bsl::vector<int> >                                     },
+    { "create-destroy",    "vector<int>/4096",              4096,  1,
+      &createDestroy<bsl::vector<int> >                                     },
+    { "create-destroy",    "list<int>/64",                    64,  1,
+      &createDestroy<bsl::list<int> >                                       },
+    { "create-destroy",    "list<int>/4096",                4096,  1,
+      &createDestroy<bsl::list<int> >                                       },
+    { "create-destroy",    "set<string>/64",                  64,  1,
+      &createDestroy<bsl::set<bsl::string> >                                },
+    { "create-destroy",    "set<string>/4096",              4096,  1,
+      &createDestroy<bsl::set<bsl::string> >                                },
+    { "create-destroy",    "unordered_map<int,string>/64",    64,  1,
+      &createDestroy<bsl::unordered_map<int, bsl::string> >                 },
+    { "create-destroy",    "unordered_map<int,string>/4096",
+                                                            4096,  1,
+      &createDestroy<bsl::unordered_map<int, bsl::string> >                 },
+    { "locality",          "shared",                           0,  1,
+      &locality                                                             },
+    { "locality",          "per-subsystem",                    1,  1,
+      &locality                                                             },
+    { "producer-consumer", "1x1",                              1,  2,
+      &producerConsumer                                                     },
+    { "producer-consumer", "4x4",                              4,  8,
+      &producerConsumer                                                     },
+    { "container-churn",   "keys/4096",                     4096,  1,
+      &containerChurn                                                       },
+    { "container-churn",   "keys/65536",                   65536,  1,
+      &containerChurn                                                       },
+    { "shared-ptr-graph",  "nodes/64",                        64,  1,
+      &sharedPtrGraph                                                       },
+    { "shared-ptr-graph",  "nodes/4096",                    4096,  1,
+      &sharedPtrGraph                                                       }
+};
+
+const int NUM_BENCHMARKS = sizeof BENCHMARKS / sizeof *BENCHMARKS;
+
+                              // =============
+                              // struct Result
+                              // =============
+
+struct Result {
+    // This 'struct' holds the measurements of a benchmark exercising an
+    // allocator.
+
+    // DATA
+    const Benchmark     *d_benchmark_p;
+    const AllocatorKind *d_allocatorKind_p;
+    int                  d_scale;
+    int                  d_numTrials;
+    Int64                d_numOperations;
+    Int64                d_minNanoseconds;
+    Int64                d_medianNanoseconds;
+    Int64                d_maxNanoseconds;
+};
+
+Result measure(const Benchmark&     benchmark,
+               const AllocatorKind& kind,
+               int                  scale,
+               int                  numTrials)
+    // Run one untimed trial, and the specified 'numTrials' timed trials, of
+    // the specified 'benchmark' exercising an allocator of the specified
+    // 'kind', with the specified 'scale', and return the measurements.
+{
+    BSLS_ASSERT(0 < numTrials);
+
+    Result result;
+    result.d_benchmark_p      = &benchmark;
+    result.d_allocatorKind_p  = &kind;
+    result.d_scale            = scale;
+    result.d_numTrials        = numTrials;
+    result.d_numOperations    = benchmark.d_run_p(kind,
+                                                  benchmark.d_parameter,
+                                                  scale);
+
+    bsl::vector<Int64> durations;
+    durations.reserve(numTrials);
+
+    for (int i = 0; i < numTrials; ++i) {
+        const Int64 start = bsls::TimeUtil::getTimer();
+        benchmark.d_run_p(kind, benchmark.d_parameter, scale);
+        durations.push_back(bsls::TimeUtil::getTimer() - start);
+    }
+
+    bsl::sort(durations.begin(), durations.end());
+
+    result.d_minNanoseconds    = durations.front();
+    result.d_medianNanoseconds = durations[numTrials / 2];
+    result.d_maxNanoseconds    = durations.back();
+
+    return result;
+}
+
+// ============================================================================
+//                                  OUTPUT
+// ----------------------------------------------------------------------------
+
+enum Format { e_CSV, e_JSON };
+
+double nanosecondsPerOperation(const Result& result)
+    // Return the median duration of a trial of the specified 'result' divided
+    // by its number of operations.
+{
+    return static_cast<double>(result.d_medianNanoseconds)
+         / static_cast<double>(result.d_numOperations);
+}
+
+void printHeader(bsl::ostream& stream, Format format)
+    // Write to the specified 'stream' the header preceding the records of the
+    // specified 'format', if any.
+{
+    if (e_CSV == format) {
+        stream << "benchmark,variant,allocator,threads,scale,trials,"
+                  "operations,min_ns,median_ns,max_ns,ns_per_op\n";
+    }
+}
+
+void printRecord(bsl::ostream& stream, const Result& result, Format format)
+    // Write to the specified 'stream' the specified 'result' in the specified
+    // 'format', followed by a newline.  Note that the variant, which may
+    // contain commas, is the only field quoted in the CSV format, and that
+    // none of the strings written require escaping in either format.
+{
+    const Benchmark&     benchmark = *result.d_benchmark_p;
+    const AllocatorKind& kind      = *result.d_allocatorKind_p;
+
+    if (e_CSV == format) {
+        stream << benchmark.d_name               << ','
+               << '"' << benchmark.d_variant << '"' << ','
+               << kind.d_name                    << ','
+               << benchmark.d_numThreads         << ','
+               << result.d_scale                 << ','
+               << result.d_numTrials             << ','
+               << result.d_numOperations         << ','
+               << result.d_minNanoseconds        << ','
+               << result.d_medianNanoseconds     << ','
+               << result.d_maxNanoseconds        << ','
+               << nanosecondsPerOperation(result) << '\n';
+    }
+    else {
+        stream << "{\"benchmark\":\"" << benchmark.d_name    << "\","
+               << "\"variant\":\""    << benchmark.d_variant << "\","
+               << "\"allocator\":\""  << kind.d_name         << "\","
+               << "\"threads\":"      << benchmark.d_numThreads     << ','
+               << "\"scale\":"        << result.d_scale             << ','
+               << "\"trials\":"       << result.d_numTrials         << ','
+               << "\"operations\":"   << result.d_numOperations     << ','
+               << "\"min_ns\":"       << result.d_minNanoseconds    << ','
+               << "\"median_ns\":"    << result.d_medianNanoseconds << ','
+               << "\"max_ns\":"       << result.d_maxNanoseconds    << ','
+               << "\"ns_per_op\":"    << nanosecondsPerOperation(result)
+               << "}\n";
+    }
+    stream << bsl::flush;
+}
+
+void printUsage(bsl::ostream& stream, const char *program)
+    // Write to the specified 'stream' the usage of the specified 'program'.
+{
+    stream << "usage: " << program << " [-f csv|json] [-t trials]"
+           << " [-s scale] [-b benchmark]... [-a allocator]... [-l]\n"
+           << "  -f  output format (default: csv)\n"
+           << "  -t  number of timed trials (default: "
+           << k_DEFAULT_NUM_TRIALS << ")\n"
+           << "  -s  workload multiplier; each trial performs 'scale * "
+           << k_ELEMENTS_PER_SCALE << "' operations (default: "
+           << k_DEFAULT_SCALE << ")\n"
+           << "  -b  run only the named benchmark (may be repeated)\n"
+           << "  -a  exercise only the named allocator (may be repeated)\n"
+           << "  -l  list the benchmarks and allocators, and exit\n";
+}
+
+void printList(bsl::ostream& stream)
+    // Write to the specified 'stream' the names of the benchmarks, with their
+    // variants, and of the allocators.
+{
+    stream << "benchmarks:\n";
+    for (int i = 0; i < NUM_BENCHMARKS; ++i) {
+        stream << "  " << BENCHMARKS[i].d_name << ' '
+               << BENCHMARKS[i].d_variant << '\n';
+    }
+    stream << "allocators:\n";
+    for (int i = 0; i < NUM_ALLOCATOR_KINDS; ++i) {
+        stream << "  " << ALLOCATOR_KINDS[i].d_name
+               << (ALLOCATOR_KINDS[i].d_isThreadSafe ? "" : " (single-thread)")
+               << '\n';
+    }
+}
+
+bool isSelected(const bsl::vector<const char *>& names, const char *name)
+    // Return 'true' if the specified 'names' is empty or contains the
+    // specified 'name', and 'false' otherwise.
+{
+    if (names.empty()) {
+        return true;                                                  // RETURN
+    }
+    for (bsl::size_t i = 0; i < names.size(); ++i) {
+        if (0 == bsl::strcmp(names[i], name)) {
+            return true;                                              // RETURN
+        }
+    }
+    return false;
+}
+
+}  // close unnamed namespace
+
+// ============================================================================
+//                               MAIN PROGRAM
+// ----------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    Format                    format    = e_CSV;
+    int                       numTrials = k_DEFAULT_NUM_TRIALS;
+    int                       scale     = k_DEFAULT_SCALE;
+    bsl::vector<const char *> benchmarkNames;
+    bsl::vector<const char *> allocatorNames;
+
+    for (int i = 1; i < argc; ++i) {
+        const char *option = argv[i];
+
+        if (0 == bsl::strcmp(option, "-l")) {
+            printList(bsl::cout);
+            return 0;                                                 // RETURN
+        }
+        if (0 == bsl::strcmp(option, "-h") || i + 1 == argc) {
+            printUsage(bsl::cerr, argv[0]);
+            return 0 == bsl::strcmp(option, "-h") ? 0 : 1;            // RETURN
+        }
+
+        const char *value = argv[++i];
+
+        if (0 == bsl::strcmp(option, "-f")) {
+            if (0 == bsl::strcmp(value, "csv")) {
+                format = e_CSV;
+            }
+            else if (0 == bsl::strcmp(value, "json")) {
+                format = e_JSON;
+            }
+            else {
+                printUsage(bsl::cerr, argv[0]);
+                return 1;                                             // RETURN
+            }
+        }
+        else if (0 == bsl::strcmp(option, "-t")) {
+            numTrials = bsl::atoi(value);
+        }
+        else if (0 == bsl::strcmp(option, "-s")) {
+            scale = bsl::atoi(value);
+        }
+        else if (0 == bsl::strcmp(option, "-b")) {
+            benchmarkNames.push_back(value);
+        }
+        else if (0 == bsl::strcmp(option, "-a")) {
+            allocatorNames.push_back(value);
+        }
+        else {
+            printUsage(bsl::cerr, argv[0]);
+            return 1;                                                 // RETURN
+        }
+    }
+
+    if (numTrials <= 0 || scale <= 0) {
+        printUsage(bsl::cerr, argv[0]);
+        return 1;                                                     // RETURN
+    }
+
+    bsl::cout << bsl::setprecision(6);
+    printHeader(bsl::cout, format);
+
+    for (int i = 0; i < NUM_BENCHMARKS; ++i) {
+        const Benchmark& benchmark = BENCHMARKS[i];
+
+        if (!isSelected(benchmarkNames, benchmark.d_name)) {
+            continue;
+        }
+
+        for (int j = 0; j < NUM_ALLOCATOR_KINDS; ++j) {
+            const AllocatorKind& kind = ALLOCATOR_KINDS[j];
+
+            if (!isSelected(allocatorNames, kind.d_name)
+             || (1 < benchmark.d_numThreads && !kind.d_isThreadSafe)) {
+                continue;
+            }
+
+            printRecord(bsl::cout,
+                        measure(benchmark, kind, scale, numTrials),
+                        format);
+        }
+    }
+
+    return 0;
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2020 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
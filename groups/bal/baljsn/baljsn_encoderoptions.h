@@ -72,10 +72,14 @@ BSLS_IDENT("$Id: $")
 //:                                        'DatetimeTz'.
 //:
 //: o 'maxFloatPrecision': option specifying the maximum number of decimal
-//:                        places used to encode each 'float' value.
+//:                        places used to encode each 'float' value.  If 0,
+//:                        each value is encoded with the fewest digits that
+//:                        convert back to the same 'float'.
 //:
 //: o 'maxDoublePrecision': option specifying the maximum number of decimal
-//:                         places used to encode each 'double' value.
+//:                         places used to encode each 'double' value.  If 0,
+//:                         each value is encoded with the fewest digits that
+//:                         convert back to the same 'double'.
 //
 ///Implementation Note
 ///- - - - - - - - - -
@@ -197,7 +201,8 @@ class EncoderOptions {
     // milliseconds printed with date time values.  By default a precision of
     // '3' decimal places is used.  The 'MaxFloatPrecision' and
     // 'MaxDoublePrecision' attributes allow specifying the maximum precision
-    // for 'float' and 'double' values.
+    // for 'float' and 'double' values; a value of 0 requests the shortest
+    // representation that converts back to the same value.
 
     // INSTANCE DATA
     int                   d_initialIndentLevel;
@@ -705,7 +710,7 @@ void EncoderOptions::setDatetimeFractionalSecondPrecision(int value)
 inline
 void EncoderOptions::setMaxFloatPrecision(int value)
 {
-    BSLS_ASSERT(1 <= value     );
+    BSLS_ASSERT(0 <= value     );
     BSLS_ASSERT(     value <= 9);
 
     d_maxFloatPrecision = value;
@@ -714,7 +719,7 @@ void EncoderOptions::setMaxFloatPrecision(int value)
 inline
 void EncoderOptions::setMaxDoublePrecision(int value)
 {
-    BSLS_ASSERT(1 <= value     );
+    BSLS_ASSERT(0 <= value     );
     BSLS_ASSERT(     value <= 17);
 
     d_maxDoublePrecision = value;
@@ -7,8 +7,12 @@ BSLS_IDENT_RCSID(baljsn_printutil_cpp,"$Id$ $CSID$")
 #include <bdlde_base64encoder.h>
 #include <bdlde_utf8util.h>
 
+#include <bslalg_numericformatterutil.h>
+
 #include <bsls_annotation.h>
+#include <bsls_platform.h>
 
+#include <bsl_cstring.h>
 #include <bsl_sstream.h>
 
 namespace BloombergLP {
@@ -30,6 +34,142 @@ void writeEscapedChar(bsl::ostream&   stream,
     *currentStart = iter + 1;
 }
 
+#if defined(BSLS_PLATFORM_CMP_MSVC) && BSLS_PLATFORM_CMP_VERSION < 1900
+const int k_MIN_EXPONENT_DIGITS = 3;  // match the older Windows 'snprintf'
+#else
+const int k_MIN_EXPONENT_DIGITS = 2;
+#endif
+
+int formatGeneral(char       *buffer,
+                  bool        isNegative,
+                  const char *digits,
+                  int         length,
+                  int         exponent,
+                  int         precision)
+    // Write into the specified 'buffer' the number formed by the specified
+    // 'length' decimal 'digits' scaled by '10^exponent', for the specified
+    // 'exponent', negated if the specified 'isNegative' is 'true', in the
+    // layout chosen by the '"%g"' format for the specified 'precision' (i.e.,
+    // scientific notation if the decimal exponent of the number is less than
+    // -4 or not less than 'precision', and fixed notation otherwise, without
+    // trailing zeros), and return the number of characters written.
+{
+    char *out = buffer;
+    if (isNegative) {
+        *out++ = '-';
+    }
+
+    const int scientificExponent = length + exponent - 1;
+
+    if (scientificExponent < -4 || scientificExponent >= precision) {
+        *out++ = digits[0];
+        if (length > 1) {
+            *out++ = '.';
+            bsl::memcpy(out, digits + 1, length - 1);
+            out += length - 1;
+        }
+        *out++ = 'e';
+
+        int value = scientificExponent;
+        if (value < 0) {
+            *out++ = '-';
+            value  = -value;
+        }
+        else {
+            *out++ = '+';
+        }
+        if (value >= 100 || 3 == k_MIN_EXPONENT_DIGITS) {
+            *out++ = static_cast<char>('0' + value / 100);
+            value %= 100;
+        }
+        *out++ = static_cast<char>('0' + value / 10);
+        *out++ = static_cast<char>('0' + value % 10);
+    }
+    else if (scientificExponent >= 0) {
+        const int integralLength = scientificExponent + 1;
+        if (length <= integralLength) {
+            bsl::memcpy(out, digits, length);
+            out += length;
+            for (int i = length; i < integralLength; ++i) {
+                *out++ = '0';
+            }
+        }
+        else {
+            bsl::memcpy(out, digits, integralLength);
+            out += integralLength;
+            *out++ = '.';
+            bsl::memcpy(out, digits + integralLength, length - integralLength);
+            out += length - integralLength;
+        }
+    }
+    else {
+        *out++ = '0';
+        *out++ = '.';
+        for (int i = -1; i > scientificExponent; --i) {
+            *out++ = '0';
+        }
+        bsl::memcpy(out, digits, length);
+        out += length;
+    }
+    return static_cast<int>(out - buffer);
+}
+
+template <class TYPE>
+int formatShortestImp(char *buffer, TYPE value, int precision)
+    // Write into the specified 'buffer' the specified finite 'value' as
+    // documented for 'PrintUtil::formatShortest' with the specified
+    // 'precision', and return the number of characters written, or 0 if the
+    // output cannot be derived from the shortest round-trip digits of
+    // 'value'.
+{
+    // The correctly rounded 'p'-digit representation of a value whose
+    // shortest round-trip representation has at most 'p' digits is that
+    // representation, provided that 'p' does not exceed 'digits10' (the
+    // spacing of 'p'-digit decimals then exceeds twice the rounding error of
+    // the shortest representation), and that the value is normalized (the
+    // rounding error of a subnormal value is relatively larger).  For larger
+    // precisions, subnormal values, and values needing more digits, defer to
+    // 'snprintf'.
+
+    const int k_DIGITS10 = bsl::numeric_limits<TYPE>::digits10;
+
+    if (precision < 0 || precision > k_DIGITS10) {
+        return 0;                                                     // RETURN
+    }
+
+    const bool isNegative = bdlb::Float::signBit(value);
+
+    if (0 == value) {
+        buffer[0] = '-';
+        buffer[isNegative] = '0';
+        return 1 + isNegative;                                        // RETURN
+    }
+
+    typedef bslalg::NumericFormatterUtil FormatterUtil;
+
+    char digits[FormatterUtil::k_MAX_DIGITS_DOUBLE];
+    int  exponent;
+    int  length = FormatterUtil::shortestDigits(digits,
+                                                &exponent,
+                                                isNegative ? -value : value);
+
+    if (0 == precision) {
+        precision = k_DIGITS10;
+    }
+    else if (length > precision
+          || (isNegative ? -value : value)
+                                       < bsl::numeric_limits<TYPE>::min()) {
+        return 0;                                                     // RETURN
+    }
+
+    return formatGeneral(buffer,
+                         isNegative,
+                         digits,
+                         length,
+                         exponent,
+                         precision);
+}
+
 }  // close unnamed namespace
 
 namespace baljsn {
@@ -38,6 +178,18 @@ namespace baljsn {
                               // class PrintUtil
                               // ---------------
 
+// PRIVATE CLASS METHODS
+int PrintUtil::formatShortest(char *buffer, double value, int precision)
+{
+    return formatShortestImp(buffer, value, precision);
+}
+
+int PrintUtil::formatShortest(char *buffer, float value, int precision)
+{
+    return formatShortestImp(buffer, value, precision);
+}
+
+// CLASS METHODS
 int PrintUtil::printString(bsl::ostream&            stream,
                            const bslstl::StringRef& value)
 {
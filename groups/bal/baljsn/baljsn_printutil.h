@@ -113,6 +113,19 @@ struct PrintUtil {
 
   private:
     // PRIVATE CLASS METHODS
+    static int formatShortest(char *buffer, double value, int precision);
+    static int formatShortest(char *buffer, float  value, int precision);
+        // Write into the specified 'buffer', having room for at least 32
+        // characters, the specified finite 'value' in the format produced by
+        // 'snprintf' with the '"%-1.*g"' format and the specified 'precision',
+        // or, if 'precision' is 0, the shortest representation that converts
+        // back to 'value' laid out as that format would be with the
+        // 'bsl::numeric_limits<double>::digits10' (respectively
+        // 'bsl::numeric_limits<float>::digits10') precision, and return the
+        // number of characters written.  Return 0, writing nothing, if
+        // 'precision' is not 0 and the output cannot be derived from the
+        // shortest round-trip digits of 'value'.
+
     template <class TYPE>
     static int maxStreamPrecision(const baljsn::EncoderOptions *options);
         // Return the maximum precision for streaming values of the specified
@@ -135,7 +148,10 @@ struct PrintUtil {
                                   const EncoderOptions *options);
         // Encode the specified floating point 'value' into JSON and output the
         // result to the specified 'stream'.  Use the optionally-specified
-        // 'options' to decide how 'value' is encoded.
+        // 'options' to decide how 'value' is encoded: 'value' is written with
+        // at most the number of significant digits given by the maximum
+        // precision option for 'TYPE', or, if that option is 0, with the
+        // fewest significant digits that convert back to 'value'.
 
     static int printString(bsl::ostream&             stream,
                            const bslstl::StringRef&  value);
@@ -301,19 +317,21 @@ int PrintUtil::printFloatingPoint(bsl::ostream&                 stream,
         const int k_SIZE = 32;
         char      buffer[k_SIZE];
 
+        const int precision = maxStreamPrecision<TYPE>(options);
+
+        int len = formatShortest(buffer, value, precision);
+
+        if (0 == len) {
 #if defined(BSLS_PLATFORM_CMP_MSVC)
 #define snprintf _snprintf
 #endif
 
-        const int len = snprintf(buffer,
-                                 k_SIZE,
-                                 "%-1.*g",
-                                 maxStreamPrecision<TYPE>(options),
-                                 value);
+            len = snprintf(buffer, k_SIZE, "%-1.*g", precision, value);
 
 #if defined(BSLS_PLATFORM_CMP_MSVC)
 #undef snprintf
 #endif
+        }
         stream.write(buffer, len);
       }
     }
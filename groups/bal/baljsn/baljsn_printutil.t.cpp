@@ -10,15 +10,20 @@
 #include <bdlt_time.h>
 #include <bdlt_timetz.h>
 
+#include <bslalg_numericformatterutil.h>
 #include <bslim_testutil.h>
 #include <bsls_platform.h>
+#include <bsls_stopwatch.h>
 
 #include <bsl_climits.h>
 #include <bsl_cmath.h>
+#include <bsl_cstdio.h>
 #include <bsl_cstdlib.h>
+#include <bsl_cstring.h>
 #include <bsl_iostream.h>
 #include <bsl_sstream.h>
 #include <bsl_string.h>
+#include <bsl_vector.h>
 
 using namespace BloombergLP;
 using bsl::cout;
@@ -65,7 +70,9 @@ using bsl::endl;
 // [ 6] static int printValue(bsl::ostream& s, const bdlt::DatetimeInterval v);
 // ----------------------------------------------------------------------------
 // [ 1] BREATHING TEST
-// [ 8] USAGE EXAMPLE
+// [ 8] ENCODING FLOATING POINT NUMBERS USING SHORTEST DIGITS
+// [ 9] USAGE EXAMPLE
+// [-1] PERFORMANCE: ENCODING 'double'
 
 // ============================================================================
 //                     STANDARD BDE ASSERT TEST FUNCTION
@@ -129,6 +136,30 @@ typedef baljsn::PrintUtil    Obj;
 typedef bsls::Types::Int64  Int64;
 typedef bsls::Types::Uint64 Uint64;
 
+Uint64 nextRandom(Uint64 *state)
+    // Advance the specified 'state' of a 64-bit linear congruential generator
+    // and return a pseudo-random value derived from it.
+{
+    *state = *state * 6364136223846793005ULL + 1442695040888963407ULL;
+    return *state ^ (*state >> 29);
+}
+
+template <class TYPE>
+TYPE randomFloatingPoint(Uint64 *state)
+    // Return a pseudo-random finite value of the specified 'TYPE' built from
+    // random bits obtained from the specified 'state'.  The behavior is
+    // undefined unless 'TYPE' is 'float' or 'double'.
+{
+    for (;;) {
+        const Uint64 bits = nextRandom(state);
+        TYPE         value;
+        bsl::memcpy(&value, &bits, sizeof value);
+        if (value == value && value - value == 0) {
+            return value;                                             // RETURN
+        }
+    }
+}
+
 template <class TYPE>
 void testNumber()
 {
@@ -251,7 +282,7 @@ int main(int argc, char *argv[])
     cout << "TEST " << __FILE__ << " CASE " << test << endl;
 
     switch (test) { case 0:
-      case 8: {
+      case 9: {
         // --------------------------------------------------------------------
         // USAGE EXAMPLE
         //   Extracted from component header file.
@@ -329,6 +360,229 @@ int main(int argc, char *argv[])
 //  }
 //..
       } break;
+      case 8: {
+        // --------------------------------------------------------------------
+        // ENCODING FLOATING POINT NUMBERS USING SHORTEST DIGITS
+        //
+        // Concerns:
+        //: 1 If the maximum precision option is 0, floating point values are
+        //:   encoded with the fewest significant digits that convert back to
+        //:   the original value, in the layout of the '"%g"' format having
+        //:   the 'digits10' precision of the type.
+        //:
+        //: 2 For any other precision, the output is identical to that of
+        //:   'snprintf' with the '"%-1.*g"' format, whether or not it is
+        //:   derived from the shortest round-trip digits.
+        //
+        // Plan:
+        //: 1 Using the table-driven technique, encode values with a maximum
+        //:   precision of 0 and compare to the expected strings.  (C-1)
+        //:
+        //: 2 Encode pseudo-random values with a maximum precision of 0 and
+        //:   verify that the output has the same number of digits as
+        //:   'bslalg::NumericFormatterUtil::shortestDigits' and is parsed back
+        //:   to the original value by 'strtod'.  (C-1)
+        //:
+        //: 3 Encode pseudo-random values, both arbitrary and with few
+        //:   significant digits, with every valid precision (from 1 to 17 for
+        //:   'double', and to 9 for 'float') and compare the output to
+        //:   'snprintf'.  (C-2)
+        //
+        // Testing:
+        //   ENCODING FLOATING POINT NUMBERS USING SHORTEST DIGITS
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                  << "ENCODING FLOATING POINT NUMBERS USING SHORTEST DIGITS"
+                  << endl
+                  << "====================================================="
+                  << endl;
+
+        if (verbose) cout << "Table of values with precision 0" << endl;
+        {
+            const struct {
+                int         d_line;
+                double      d_value;
+                const char *d_result;
+            } DATA[] = {
+                //LINE                VALUE  RESULT
+                //----                -----  ------
+
+                { L_,                   0.0,  "0"                         },
+                { L_,                  -0.0,  "-0"                        },
+                { L_,                   0.1,  "0.1"                       },
+                { L_,                  -1.5,  "-1.5"                      },
+                { L_,             0.1 + 0.2,  "0.30000000000000004"       },
+                { L_,   0.12345678901234567,  "0.12345678901234566"       },
+                { L_,             1.0 / 3.0,  "0.3333333333333333"        },
+                { L_,      123456789012345.,  "123456789012345"           },
+#if defined(BALJSN_PRINTUTIL_EXTRA_ZERO_PADDING_FOR_EXPONENTS)
+                { L_,     1234567890123456.,  "1.234567890123456e+015"    },
+                { L_,                1.0e15,  "1e+015"                    },
+                { L_,                1.0e-5,  "1e-005"                    },
+#else
+                { L_,     1234567890123456.,  "1.234567890123456e+15"     },
+                { L_,                1.0e15,  "1e+15"                     },
+                { L_,                1.0e-5,  "1e-05"                     },
+#endif
+                { L_,              -9.9e100,  "-9.9e+100"                 },
+                { L_,             2.23e-308,  "2.23e-308"                 },
+                { L_, 1.7976931348623157e308, "1.7976931348623157e+308"   },
+            };
+            const int NUM_DATA = sizeof DATA / sizeof *DATA;
+
+            for (int ti = 0; ti < NUM_DATA; ++ti) {
+                const int         LINE  = DATA[ti].d_line;
+                const double      VALUE = DATA[ti].d_value;
+                const char *const EXP   = DATA[ti].d_result;
+
+                baljsn::EncoderOptions options;
+                options.setMaxDoublePrecision(0);
+
+                bsl::ostringstream oss;
+                ASSERTV(LINE, 0 == Obj::printValue(oss, VALUE, &options));
+
+                bsl::string result = oss.str();
+                ASSERTV(LINE, result, EXP, result == EXP);
+            }
+        }
+        {
+            const struct {
+                int         d_line;
+                float       d_value;
+                const char *d_result;
+            } DATA[] = {
+                //LINE           VALUE  RESULT
+                //----           -----  ------
+
+                { L_,             0.0f,  "0"              },
+                { L_,             0.1f,  "0.1"            },
+                { L_,     0.123456789f,  "0.12345679"     },
+                { L_,       -123456.0f,  "-123456"        },
+#if defined(BALJSN_PRINTUTIL_EXTRA_ZERO_PADDING_FOR_EXPONENTS)
+                { L_,      1234567.0f,  "1.234567e+006"  },
+                { L_,   3.4028235e38f,  "3.4028235e+038" },
+#else
+                { L_,      1234567.0f,  "1.234567e+06"   },
+                { L_,   3.4028235e38f,  "3.4028235e+38"  },
+#endif
+            };
+            const int NUM_DATA = sizeof DATA / sizeof *DATA;
+
+            for (int ti = 0; ti < NUM_DATA; ++ti) {
+                const int         LINE  = DATA[ti].d_line;
+                const float       VALUE = DATA[ti].d_value;
+                const char *const EXP   = DATA[ti].d_result;
+
+                baljsn::EncoderOptions options;
+                options.setMaxFloatPrecision(0);
+
+                bsl::ostringstream oss;
+                ASSERTV(LINE, 0 == Obj::printValue(oss, VALUE, &options));
+
+                bsl::string result = oss.str();
+                ASSERTV(LINE, result, EXP, result == EXP);
+            }
+        }
+
+        if (verbose) cout << "Round trip with precision 0" << endl;
+        {
+            baljsn::EncoderOptions options;
+            options.setMaxDoublePrecision(0);
+            options.setMaxFloatPrecision(0);
+
+            Uint64 state = 1;
+            for (int i = 0; i < 20000; ++i) {
+                const double VALUE = randomFloatingPoint<double>(&state);
+
+                bsl::ostringstream oss;
+                ASSERTV(i, 0 == Obj::printValue(oss, VALUE, &options));
+
+                const bsl::string result = oss.str();
+                ASSERTV(i, result, VALUE == bsl::strtod(result.c_str(), 0));
+
+                char digits[bslalg::NumericFormatterUtil::k_MAX_DIGITS_DOUBLE];
+                int  exponent;
+                int  numDigits = 0 == VALUE
+                               ? 1
+                               : bslalg::NumericFormatterUtil::shortestDigits(
+                                                 digits,
+                                                 &exponent,
+                                                 VALUE < 0 ? -VALUE : VALUE);
+
+                // Count the digits from the first to the last non-zero one.
+
+                int count   = 0;
+                int pending = 0;
+                for (bsl::size_t j = 0; j < result.length(); ++j) {
+                    const char c = result[j];
+                    if ('e' == c) {
+                        break;
+                    }
+                    if ('1' <= c && c <= '9') {
+                        count   += pending + 1;
+                        pending  = 0;
+                    }
+                    else if ('0' == c && 0 < count) {
+                        ++pending;
+                    }
+                }
+                if (0 == VALUE) {
+                    count = 1;
+                }
+                ASSERTV(i, result, numDigits, count, numDigits == count);
+
+                const float FVALUE = randomFloatingPoint<float>(&state);
+
+                oss.str("");
+                ASSERTV(i, 0 == Obj::printValue(oss, FVALUE, &options));
+                ASSERTV(i, oss.str(),
+                        FVALUE == bsl::strtof(oss.str().c_str(), 0));
+            }
+        }
+
+        if (verbose) cout << "Compare to 'snprintf'" << endl;
+        {
+            Uint64 state = 2;
+            for (int i = 0; i < 4000; ++i) {
+                const double VALUES[] = {
+                    randomFloatingPoint<double>(&state),
+                    static_cast<double>(nextRandom(&state) % 1000000) / 1000.0,
+                    static_cast<double>(nextRandom(&state) % 1000) * 1.0e20,
+                };
+
+                for (int v = 0; v < 3; ++v) {
+                    const double VALUE  = VALUES[v];
+                    const float  FVALUE = static_cast<float>(VALUE);
+
+                    for (int precision = 1; precision <= 17; ++precision) {
+                        baljsn::EncoderOptions options;
+                        options.setMaxDoublePrecision(precision);
+
+                        char buffer[64];
+
+                        bsl::ostringstream oss;
+                        ASSERTV(0 == Obj::printValue(oss, VALUE, &options));
+                        bsl::sprintf(buffer, "%-1.*g", precision, VALUE);
+                        ASSERTV(i, precision, oss.str(), buffer,
+                                oss.str() == buffer);
+
+                        if (precision > 9 || FVALUE - FVALUE != 0) {
+                            continue;                               // CONTINUE
+                        }
+
+                        options.setMaxFloatPrecision(precision);
+
+                        oss.str("");
+                        ASSERTV(0 == Obj::printValue(oss, FVALUE, &options));
+                        bsl::sprintf(buffer, "%-1.*g", precision, FVALUE);
+                        ASSERTV(i, precision, oss.str(), buffer,
+                                oss.str() == buffer);
+                    }
+                }
+            }
+        }
+      } break;
       case 7: {
         // --------------------------------------------------------------------
         // ENCODING 'INF' AND 'NaN' FLOATING POINT VALUES
@@ -1533,6 +1787,63 @@ int main(int argc, char *argv[])
             }
         }
       } break;
+      case -1: {
+        // --------------------------------------------------------------------
+        // PERFORMANCE: ENCODING 'double'
+        //
+        // Concerns:
+        //: 1 Encoding using the shortest round-trip digits is faster than
+        //:   using 'snprintf'.
+        //
+        // Plan:
+        //: 1 Encode arrays of pseudo-random values, both arbitrary and with
+        //:   few significant digits, with the default options and with a
+        //:   maximum precision of 0 and of 17, and report the average time
+        //:   per value.  (C-1)
+        //
+        // Testing:
+        //   PERFORMANCE: ENCODING 'double'
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "PERFORMANCE: ENCODING 'double'" << endl
+                          << "==============================" << endl;
+
+        const int k_NUM_VALUES = 200000;
+
+        bsl::vector<double> values(k_NUM_VALUES);
+
+        for (int set = 0; set < 2; ++set) {
+            Uint64 state = 3;
+            for (int i = 0; i < k_NUM_VALUES; ++i) {
+                values[i] = 0 == set
+                          ? randomFloatingPoint<double>(&state)
+                          : static_cast<double>(nextRandom(&state) % 1000000)
+                                                                       / 100.0;
+            }
+
+            const int PRECISIONS[] = { 15, 0, 17 };
+
+            for (int p = 0; p < 3; ++p) {
+                baljsn::EncoderOptions options;
+                options.setMaxDoublePrecision(PRECISIONS[p]);
+
+                bsl::ostringstream oss;
+                bsls::Stopwatch    timer;
+                timer.start(true);
+                for (int i = 0; i < k_NUM_VALUES; ++i) {
+                    oss.seekp(0);
+                    Obj::printValue(oss, values[i], &options);
+                }
+                timer.stop();
+
+                cout << (0 == set ? "random " : "decimal")
+                     << " precision " << PRECISIONS[p] << ": "
+                     << timer.accumulatedWallTime() * 1e9 / k_NUM_VALUES
+                     << " ns/value" << endl;
+            }
+        }
+      } break;
       default: {
         cerr << "WARNING: CASE `" << test << "' NOT FOUND." << endl;
         testStatus = -1;
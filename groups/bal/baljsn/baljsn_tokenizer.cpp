@@ -4,7 +4,11 @@
 #include <bsls_ident.h>
 BSLS_IDENT_RCSID(baljsn_tokenizer_cpp,"$Id$ $CSID$")
 
-#include <bdlb_chartype.h>
+#include <bdlb_bitutil.h>
+
+#include <bslmt_once.h>
+
+#include <bsls_platform.h>
 
 #include <bsl_cstring.h>
 #include <bsl_ios.h>
@@ -12,6 +16,11 @@ BSLS_IDENT_RCSID(baljsn_tokenizer_cpp,"$Id$ $CSID$")
 
 #include <baljsn_parserutil.h>                 // for testing only
 
+#if defined(BSLS_PLATFORM_HAS_X86_TARGET_ATTRIBUTE)
+#include <cpuid.h>
+#include <immintrin.h>
+#endif
+
 // IMPLEMENTATION NOTES
 // --------------------
 // The following table provides the various transitions that need to be handled
@@ -52,22 +61,313 @@ BSLS_IDENT_RCSID(baljsn_tokenizer_cpp,"$Id$ $CSID$")
 //   END_OBJECT                   '}'         ']'              END_ARRAY
 //   END_ARRAY                    ']'         ']'              END_ARRAY
 //..
+//
+// Searches within 'd_stringBuffer' use the structural index, 'd_index', which
+// is kept in sync with 'd_stringBuffer' by 'updateIndex' whenever characters
+// are read from the 'streambuf'.  When more characters are appended to a
+// value that is being extracted (see 'expandBufferForLargeValue'), only the
+// blocks following the previous end of the buffer are indexed again; when the
+// characters of a value are moved to the front of the buffer (see
+// 'moveValueCharsToStartAndReloadBuffer'), the whole buffer is indexed again.
 
 namespace BloombergLP {
 namespace {
 
-    static const char *WHITESPACE = " \n\t\v\f\r";
-    static const char *TOKENS     = "{}[]:,";
+typedef bsls::Types::Uint64        Uint64;
+typedef baljsn::Tokenizer_IndexUtil IndexUtil;
+
+enum {
+    k_BLOCK_SIZE      = IndexUtil::k_BLOCK_SIZE,
+    k_WORDS_PER_BLOCK = IndexUtil::k_WORDS_PER_BLOCK
+};
+
+inline
+void classifyScalar(Uint64      *whitespace,
+                    Uint64      *delimiter,
+                    Uint64      *stringSpecial,
+                    const char  *data,
+                    bsl::size_t  length)
+    // Load into the specified 'whitespace', 'delimiter', and 'stringSpecial'
+    // the masks describing the specified 'length' characters at the specified
+    // 'data'.  The behavior is undefined unless 'length <= k_BLOCK_SIZE'.
+{
+    Uint64 ws      = 0;
+    Uint64 delim   = 0;
+    Uint64 special = 0;
+
+    for (bsl::size_t i = 0; i < length; ++i) {
+        const Uint64 bit = static_cast<Uint64>(1) << i;
+
+        switch (data[i]) {
+          case ' ':
+          case '\n':
+          case '\t':
+          case '\v':
+          case '\f':
+          case '\r': {
+            ws    |= bit;
+            delim |= bit;
+          } break;
+          case '{':
+          case '}':
+          case '[':
+          case ']':
+          case ':':
+          case ',': {
+            delim |= bit;
+          } break;
+          case '"':
+          case '\\': {
+            special |= bit;
+          } break;
+          default: {
+          } break;
+        }
+    }
+
+    *whitespace    = ws;
+    *delimiter     = delim;
+    *stringSpecial = special;
+}
+
+void buildScalar(Uint64 *index, const char *data, bsl::size_t length)
+    // Load into the specified 'index' the structural index of the specified
+    // 'length' characters at the specified 'data' using the portable
+    // implementation.
+{
+    for (; length; index += k_WORDS_PER_BLOCK) {
+        const bsl::size_t n = length < k_BLOCK_SIZE
+                            ? length
+                            : static_cast<bsl::size_t>(k_BLOCK_SIZE);
+
+        classifyScalar(index + IndexUtil::k_WHITESPACE,
+                       index + IndexUtil::k_DELIMITER,
+                       index + IndexUtil::k_STRING_SPECIAL,
+                       data,
+                       n);
+
+        data   += n;
+        length -= n;
+    }
+}
+
+#if defined(BSLS_PLATFORM_HAS_X86_TARGET_ATTRIBUTE)
+__attribute__((target("avx2")))
+inline
+void classifyAvx2(Uint64 *index, __m256i input, int shift)
+    // Add to the masks of the specified 'index' the classification of the 32
+    // characters of the specified 'input', shifted left by the specified
+    // 'shift' bits.
+{
+    // Whitespace is ' ' or a character in '[ '\t' .. '\r' ]'; '{' and '['
+    // (respectively '}' and ']') differ only in bit 5.
+
+    const __m256i ctrl   = _mm256_sub_epi8(input, _mm256_set1_epi8('\t'));
+    const __m256i folded = _mm256_or_si256(input, _mm256_set1_epi8(0x20));
+
+    const __m256i ws = _mm256_or_si256(
+               _mm256_cmpeq_epi8(input, _mm256_set1_epi8(' ')),
+               _mm256_cmpeq_epi8(_mm256_min_epu8(ctrl, _mm256_set1_epi8(4)),
+                                 ctrl));
+
+    const __m256i structural = _mm256_or_si256(
+                _mm256_or_si256(
+                          _mm256_cmpeq_epi8(folded, _mm256_set1_epi8('{')),
+                          _mm256_cmpeq_epi8(folded, _mm256_set1_epi8('}'))),
+                _mm256_or_si256(
+                          _mm256_cmpeq_epi8(input, _mm256_set1_epi8(':')),
+                          _mm256_cmpeq_epi8(input, _mm256_set1_epi8(','))));
+
+    const __m256i special = _mm256_or_si256(
+                          _mm256_cmpeq_epi8(input, _mm256_set1_epi8('"')),
+                          _mm256_cmpeq_epi8(input, _mm256_set1_epi8('\\')));
+
+    const Uint64 wsMask      = static_cast<unsigned int>(
+                                                    _mm256_movemask_epi8(ws));
+    const Uint64 delimMask   = static_cast<unsigned int>(
+                       _mm256_movemask_epi8(_mm256_or_si256(ws, structural)));
+    const Uint64 specialMask = static_cast<unsigned int>(
+                                               _mm256_movemask_epi8(special));
+
+    index[IndexUtil::k_WHITESPACE]     |= wsMask      << shift;
+    index[IndexUtil::k_DELIMITER]      |= delimMask   << shift;
+    index[IndexUtil::k_STRING_SPECIAL] |= specialMask << shift;
+}
+
+__attribute__((target("avx2")))
+void buildAvx2(Uint64 *index, const char *data, bsl::size_t length)
+    // Load into the specified 'index' the structural index of the specified
+    // 'length' characters at the specified 'data' using AVX2 instructions.
+    // The behavior is undefined unless the processor supports AVX2.
+{
+    for (; length >= k_BLOCK_SIZE; index += k_WORDS_PER_BLOCK) {
+        const __m256i *p = reinterpret_cast<const __m256i *>(data);
+
+        index[IndexUtil::k_WHITESPACE]     = 0;
+        index[IndexUtil::k_DELIMITER]      = 0;
+        index[IndexUtil::k_STRING_SPECIAL] = 0;
+
+        classifyAvx2(index, _mm256_loadu_si256(p),      0);
+        classifyAvx2(index, _mm256_loadu_si256(p + 1), 32);
+
+        data   += k_BLOCK_SIZE;
+        length -= k_BLOCK_SIZE;
+    }
+
+    if (length) {
+        classifyScalar(index + IndexUtil::k_WHITESPACE,
+                       index + IndexUtil::k_DELIMITER,
+                       index + IndexUtil::k_STRING_SPECIAL,
+                       data,
+                       length);
+    }
+}
+#endif  // BSLS_PLATFORM_HAS_X86_TARGET_ATTRIBUTE
+
+IndexUtil::Kernel detectKernel()
+    // Return the best implementation of 'IndexUtil::build' supported by the
+    // running processor.
+{
+#if defined(BSLS_PLATFORM_HAS_X86_TARGET_ATTRIBUTE)
+    static const unsigned int k_OSXSAVE_BIT = 1u << 27;  // leaf 1, ECX
+    static const unsigned int k_AVX_BIT     = 1u << 28;  // leaf 1, ECX
+    static const unsigned int k_AVX2_BIT    = 1u << 5;   // leaf 7, EBX
+
+    unsigned int eax, ebx, ecx, edx;
+
+    if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx)
+     || (ecx & (k_OSXSAVE_BIT | k_AVX_BIT)) != (k_OSXSAVE_BIT | k_AVX_BIT)
+     || __get_cpuid_max(0, 0) < 7) {
+        return IndexUtil::e_SCALAR;                                   // RETURN
+    }
+
+    // Verify that the operating system saves the YMM registers.
+
+    unsigned int xcr0Lo, xcr0Hi;
+    __asm__ __volatile__("xgetbv" : "=a"(xcr0Lo), "=d"(xcr0Hi) : "c"(0));
+    (void)xcr0Hi;
+
+    if ((xcr0Lo & 6) != 6) {
+        return IndexUtil::e_SCALAR;                                   // RETURN
+    }
+
+    __cpuid_count(7, 0, eax, ebx, ecx, edx);
+
+    return (ebx & k_AVX2_BIT) ? IndexUtil::e_AVX2 : IndexUtil::e_SCALAR;
+#else
+    return IndexUtil::e_SCALAR;
+#endif
+}
+
+template <int WORD, bool INVERT>
+inline
+bsl::size_t findInIndex(const Uint64 *index,
+                        bsl::size_t   numWords,
+                        bsl::size_t   length,
+                        bsl::size_t   position)
+    // Return the position of the first character at or after the specified
+    // 'position' whose bit is set in the mask at offset 'WORD' of the
+    // specified 'index' having the specified 'numWords' words and describing
+    // 'length' characters, or whose bit is unset in that mask if 'INVERT' is
+    // 'true', or 'length' if there is no such character.
+{
+    if (position >= length) {
+        return length;                                                // RETURN
+    }
+
+    bsl::size_t word  = position / k_BLOCK_SIZE * k_WORDS_PER_BLOCK + WORD;
+    Uint64      mask  = INVERT ? ~index[word] : index[word];
+
+    mask &= ~static_cast<Uint64>(0) << (position % k_BLOCK_SIZE);
+
+    while (0 == mask) {
+        word += k_WORDS_PER_BLOCK;
+        if (word >= numWords) {
+            return length;                                            // RETURN
+        }
+        mask = INVERT ? ~index[word] : index[word];
+    }
+
+    const bsl::size_t result =
+                   (word / k_WORDS_PER_BLOCK) * k_BLOCK_SIZE
+                 + bdlb::BitUtil::numTrailingUnsetBits(
+                                   static_cast<bdlb::BitUtil::uint64_t>(mask));
+
+    return result < length ? result : length;
+}
 
 }  // close unnamed namespace
 
 namespace baljsn {
 
+                         // --------------------------
+                         // struct Tokenizer_IndexUtil
+                         // --------------------------
+
+// CLASS METHODS
+Tokenizer_IndexUtil::Kernel Tokenizer_IndexUtil::bestKernel()
+{
+    static Kernel kernel = e_SCALAR;
+
+    BSLMT_ONCE_DO {
+        kernel = detectKernel();
+    }
+
+    return kernel;
+}
+
+bool Tokenizer_IndexUtil::isSupported(Kernel kernel)
+{
+    return kernel <= bestKernel();
+}
+
+void Tokenizer_IndexUtil::build(bsls::Types::Uint64 *index,
+                                const char          *data,
+                                bsl::size_t          length)
+{
+    build(bestKernel(), index, data, length);
+}
+
+void Tokenizer_IndexUtil::build(Kernel               kernel,
+                                bsls::Types::Uint64 *index,
+                                const char          *data,
+                                bsl::size_t          length)
+{
+    BSLS_ASSERT(index || !length);
+    BSLS_ASSERT(data  || !length);
+    BSLS_ASSERT(isSupported(kernel));
+
+#if defined(BSLS_PLATFORM_HAS_X86_TARGET_ATTRIBUTE)
+    if (e_AVX2 == kernel) {
+        buildAvx2(index, data, length);
+        return;                                                       // RETURN
+    }
+#else
+    (void)kernel;
+#endif
+
+    buildScalar(index, data, length);
+}
+
                               // ----------------
                               // struct Tokenizer
                               // ----------------
 
 // PRIVATE MANIPULATORS
+void Tokenizer::updateIndex(bsl::size_t position)
+{
+    const bsl::size_t begin  = position / k_BLOCK_SIZE * k_BLOCK_SIZE;
+    const bsl::size_t length = d_stringBuffer.size();
+
+    d_index.resize(IndexUtil::numWords(length));
+
+    if (begin < length) {
+        IndexUtil::build(&d_index[begin / k_BLOCK_SIZE * k_WORDS_PER_BLOCK],
+                         d_stringBuffer.data() + begin,
+                         length - begin);
+    }
+}
+
 int Tokenizer::reloadStringBuffer()
 {
     d_stringBuffer.resize(k_MAX_STRING_SIZE);
@@ -76,6 +376,7 @@ int Tokenizer::reloadStringBuffer()
                                                            k_MAX_STRING_SIZE));
     d_cursor = 0;
     d_stringBuffer.resize(numRead);
+    updateIndex(0);
     return numRead;
 }
 
@@ -88,6 +389,7 @@ int Tokenizer::expandBufferForLargeValue()
             static_cast<int>(d_streambuf_p->sgetn(&d_stringBuffer[d_valueIter],
                                                   k_MAX_STRING_SIZE));
     d_stringBuffer.resize(currLength + numRead);
+    updateIndex(currLength);
     return numRead ? 0 : -1;
 }
 
@@ -105,6 +407,7 @@ int Tokenizer::moveValueCharsToStartAndReloadBuffer()
                                              k_MAX_STRING_SIZE - d_valueIter));
 
     d_stringBuffer.resize(d_valueIter + numRead);
+    updateIndex(0);
 
     return numRead;
 }
@@ -112,9 +415,14 @@ int Tokenizer::moveValueCharsToStartAndReloadBuffer()
 int Tokenizer::skipWhitespace()
 {
     while (true) {
-        bsl::size_t pos = d_stringBuffer.find_first_not_of(WHITESPACE,
-                                                           d_cursor);
-        if (bsl::string::npos != pos) {
+        const bsl::size_t length = d_stringBuffer.size();
+        const bsl::size_t pos    =
+                           findInIndex<IndexUtil::k_WHITESPACE, true>(
+                                                                d_index.data(),
+                                                                d_index.size(),
+                                                                length,
+                                                                d_cursor);
+        if (pos < length) {
             d_cursor = pos;
             break;
         }
@@ -129,22 +437,36 @@ int Tokenizer::skipWhitespace()
 
 int Tokenizer::extractStringValue()
 {
-    bool firstTime    = true;
-    char previousChar = 0;
+    bool firstTime = true;
+    bool escaped   = false;  // 'true' if the next character is escaped
 
     while (true) {
-        while (d_valueIter < d_stringBuffer.length()
-            && '"' != d_stringBuffer[d_valueIter]) {
+        const bsl::size_t length = d_stringBuffer.length();
 
-            if ('\\' == d_stringBuffer[d_valueIter]
-             && '\\' == previousChar) {
-                previousChar = 0;
-            }
-            else {
-                previousChar = d_stringBuffer[d_valueIter];
+        // Find the first quote that is not escaped by a backslash, skipping
+        // from one quote or backslash to the next using the index.
+
+        while (d_valueIter < length) {
+            if (escaped) {
+                ++d_valueIter;
+                escaped = false;
+                continue;
             }
 
-            ++d_valueIter;
+            d_valueIter =
+                       findInIndex<IndexUtil::k_STRING_SPECIAL, false>(
+                                                                d_index.data(),
+                                                                d_index.size(),
+                                                                length,
+                                                                d_valueIter);
+
+            if (d_valueIter < length) {
+                if ('"' == d_stringBuffer[d_valueIter]) {
+                    break;
+                }
+                escaped = true;
+                ++d_valueIter;
+            }
         }
 
         if (d_valueIter >= d_stringBuffer.length()) {
@@ -177,11 +499,6 @@ int Tokenizer::extractStringValue()
             }
         }
         else {
-            if ('\\' == previousChar) {
-                ++d_valueIter;
-                previousChar = 0;
-                continue;
-            }
             d_valueEnd = d_valueIter;
             return 0;                                                 // RETURN
         }
@@ -194,11 +511,11 @@ int Tokenizer::skipNonWhitespaceOrTillToken()
     bool firstTime = true;
 
     while (true) {
-        while (d_valueIter < d_stringBuffer.length()
-            && !bdlb::CharType::isSpace(d_stringBuffer[d_valueIter])
-            && !bsl::strchr(TOKENS, d_stringBuffer[d_valueIter])) {
-            ++d_valueIter;
-        }
+        d_valueIter = findInIndex<IndexUtil::k_DELIMITER, false>(
+                                                      d_index.data(),
+                                                      d_index.size(),
+                                                      d_stringBuffer.length(),
+                                                      d_valueIter);
 
         if (d_valueIter >= d_stringBuffer.length()) {
 
@@ -9,6 +9,7 @@ BSLS_IDENT("$Id: $")
 //
 //@CLASSES:
 //  baljsn::Tokenizer: tokenizer for parsing JSON data from a 'streambuf'
+//  baljsn::Tokenizer_IndexUtil: build a structural index of JSON text
 //
 //@SEE_ALSO: baljsn_decoder, baljsn_parserutil
 //
@@ -23,6 +24,22 @@ BSLS_IDENT("$Id: $")
 // package and in most cases clients should use the 'baljsn_decoder' component
 // instead of using this 'class'.
 //
+///Structural Index
+///----------------
+// The tokenizer reads the 'streambuf' in blocks of up to 8K characters.  Each
+// time a block is read, the tokenizer classifies every character of the block
+// and records the result in a structural index: for every 64 characters, one
+// bit mask of whitespace characters, one of delimiters (whitespace and the
+// structural characters '{', '}', '[', ']', ':', and ','), and one of the
+// characters that are significant inside a string ('"' and '\').  Skipping
+// whitespace, finding the end of a string, and finding the end of a number
+// or literal are then performed a 64-character word at a time, rather than
+// one character at a time.  On x86 processors supporting AVX2 (when built
+// with GCC 4.9 or later, or clang) the index is built using AVX2 instructions
+// selected at runtime; otherwise a portable implementation is used.  The
+// component-private 'struct' 'baljsn::Tokenizer_IndexUtil' provides the
+// index-building functions, and is exposed for testing only.
+//
 ///Usage
 ///-----
 // This section illustrates intended use of this component.
@@ -131,6 +148,8 @@ BSLS_IDENT("$Id: $")
 #include <bsls_assert.h>
 #include <bsls_types.h>
 
+#include <bsl_cstddef.h>
+
 #include <bsl_streambuf.h>
 #include <bsl_string.h>
 #include <bsl_vector.h>
@@ -138,6 +157,71 @@ BSLS_IDENT("$Id: $")
 namespace BloombergLP {
 namespace baljsn {
 
+                         // ==========================
+                         // struct Tokenizer_IndexUtil
+                         // ==========================
+
+struct Tokenizer_IndexUtil {
+    // [!PRIVATE!] This 'struct' provides a namespace for functions that build
+    // the structural index of a sequence of characters used by 'Tokenizer'.
+    // The index of a sequence of 'N' characters comprises
+    // 'k_WORDS_PER_BLOCK * ((N + k_BLOCK_SIZE - 1) / k_BLOCK_SIZE)' 64-bit
+    // words: for each block of 'k_BLOCK_SIZE' consecutive characters, the
+    // words at offsets 'k_WHITESPACE', 'k_DELIMITER', and 'k_STRING_SPECIAL'
+    // hold bit masks having bit 'i' set if character 'i' of the block is,
+    // respectively, whitespace, whitespace or a structural character, or a
+    // quote or backslash.  Bits beyond the end of the sequence are unset.
+    // This 'struct' is an implementation detail of 'Tokenizer' and is
+    // exposed only for testing.
+
+    // TYPES
+    enum Kernel {
+        // Enumerates the implementations of 'build'.
+
+        e_SCALAR,  // portable implementation
+        e_AVX2     // x86 AVX2 implementation
+    };
+
+    enum {
+        k_BLOCK_SIZE      = 64,  // characters described by one block
+
+        k_WORDS_PER_BLOCK = 3,   // words of index per block
+
+        k_WHITESPACE      = 0,   // offset of whitespace mask in a block
+
+        k_DELIMITER       = 1,   // offset of delimiter mask in a block
+
+        k_STRING_SPECIAL  = 2    // offset of '"' and '\\' mask in a block
+    };
+
+    // CLASS METHODS
+    static Kernel bestKernel();
+        // Return the implementation used by 'Tokenizer' on this processor.
+
+    static bool isSupported(Kernel kernel);
+        // Return 'true' if the specified 'kernel' is both compiled into this
+        // component and supported by the running processor, and 'false'
+        // otherwise.
+
+    static void build(bsls::Types::Uint64 *index,
+                      const char          *data,
+                      bsl::size_t          length);
+    static void build(Kernel               kernel,
+                      bsls::Types::Uint64 *index,
+                      const char          *data,
+                      bsl::size_t          length);
+        // Load into the specified 'index' the structural index of the
+        // specified 'length' characters at the specified 'data', using the
+        // optionally specified 'kernel', or 'bestKernel()' if 'kernel' is not
+        // specified.  The behavior is undefined unless 'index' refers to an
+        // array of at least 'numWords(length)' words, and, if 'kernel' is
+        // specified, 'isSupported(kernel)'.
+
+    static bsl::size_t numWords(bsl::size_t length);
+        // Return the number of words in the structural index of a sequence of
+        // the specified 'length' characters.
+};
+
                               // ===============
                               // class Tokenizer
                               // ===============
@@ -190,7 +274,11 @@ class Tokenizer {
         k_BUFSIZE         = 1024 * 8,
         k_MAX_STRING_SIZE = k_BUFSIZE - 1,
 
-        k_STACKBUFSIZE    = 256
+        k_STACKBUFSIZE    = 256,
+
+        k_INDEXBUFSIZE    = k_BUFSIZE / Tokenizer_IndexUtil::k_BLOCK_SIZE
+                          * Tokenizer_IndexUtil::k_WORDS_PER_BLOCK
+                          * sizeof(bsls::Types::Uint64)
     };
 
     // DATA
@@ -198,14 +286,23 @@ class Tokenizer {
 
     bsls::AlignedBuffer<k_STACKBUFSIZE>  d_stackBuffer;     // stack buffer
 
+    bsls::AlignedBuffer<k_INDEXBUFSIZE>  d_indexBuffer;     // index buffer
+
     bdlma::BufferedSequentialAllocator   d_allocator;       // string allocator
                                                             // (owned)
 
     bdlma::BufferedSequentialAllocator   d_stackAllocator;  // stack allocator
                                                             // (owned)
 
+    bdlma::BufferedSequentialAllocator   d_indexAllocator;  // index allocator
+                                                            // (owned)
+
     bsl::string                          d_stringBuffer;    // string buffer
 
+    bsl::vector<bsls::Types::Uint64>     d_index;           // structural
+                                                            // index of
+                                                            // 'd_stringBuffer'
+
     bsl::streambuf                      *d_streambuf_p;     // streambuf
                                                             // (held, not
                                                             // owned)
@@ -239,6 +336,13 @@ class Tokenizer {
                                                             // values
 
     // PRIVATE MANIPULATORS
+    void updateIndex(bsl::size_t position);
+        // Rebuild the structural index, 'd_index', of the characters of
+        // 'd_stringBuffer' starting with the block containing the specified
+        // 'position', and resize it to describe exactly the characters of
+        // 'd_stringBuffer'.  The behavior is undefined unless the index
+        // describes the characters of 'd_stringBuffer' preceding that block.
+
     int extractStringValue();
         // Extract the string value starting at the current data cursor and
         // update the value begin and end pointers to refer to the begin and
@@ -365,6 +469,21 @@ class Tokenizer {
 //                            INLINE DEFINITIONS
 // ============================================================================
 
+                         // --------------------------
+                         // struct Tokenizer_IndexUtil
+                         // --------------------------
+
+// CLASS METHODS
+inline
+bsl::size_t Tokenizer_IndexUtil::numWords(bsl::size_t length)
+{
+    return (length + k_BLOCK_SIZE - 1) / k_BLOCK_SIZE * k_WORDS_PER_BLOCK;
+}
+
+                              // ---------------
+                              // class Tokenizer
+                              // ---------------
+
 // PRIVATE MANIPULATORS
 inline
 Tokenizer::ContextType Tokenizer::popContext()
@@ -397,7 +516,9 @@ inline
 Tokenizer::Tokenizer(bslma::Allocator *basicAllocator)
 : d_allocator(d_buffer.buffer(), k_BUFSIZE, basicAllocator)
 , d_stackAllocator(d_stackBuffer.buffer(), k_STACKBUFSIZE, basicAllocator)
+, d_indexAllocator(d_indexBuffer.buffer(), k_INDEXBUFSIZE, basicAllocator)
 , d_stringBuffer(&d_allocator)
+, d_index(&d_indexAllocator)
 , d_streambuf_p(0)
 , d_cursor(0)
 , d_valueBegin(0)
@@ -409,6 +530,7 @@ Tokenizer::Tokenizer(bslma::Allocator *basicAllocator)
 , d_allowHeterogenousArrays(true)
 {
     d_stringBuffer.reserve(k_MAX_STRING_SIZE);
+    d_index.reserve(k_INDEXBUFSIZE / sizeof(bsls::Types::Uint64));
     d_contextStack.clear();
     pushContext(e_OBJECT_CONTEXT);
 
@@ -425,6 +547,7 @@ void Tokenizer::reset(bsl::streambuf *streambuf)
 {
     d_streambuf_p = streambuf;
     d_stringBuffer.clear();
+    d_index.clear();
     d_cursor      = 0;
     d_valueBegin  = 0;
     d_valueEnd    = 0;
@@ -5,6 +5,7 @@
 
 #include <bslim_testutil.h>
 
+#include <bsl_algorithm.h>
 #include <bsl_cfloat.h>
 #include <bsl_climits.h>
 #include <bsl_iostream.h>
@@ -17,6 +18,8 @@
 #include <bslma_defaultallocatorguard.h>
 #include <bslma_testallocator.h>
 
+#include <bsls_stopwatch.h>
+
 #include <bdlsb_memoutstreambuf.h>            // for testing only
 #include <bdlsb_fixedmemoutstreambuf.h>       // for testing only
 #include <bdlsb_fixedmeminstreambuf.h>        // for testing only
@@ -59,9 +62,18 @@ using bsl::endl;
 // [13] bool allowStandAloneValues() const;
 // [14] bool allowHeterogenousArrays() const;
 // [ 3] int value(bslstl::StringRef *data) const;
+//
+// baljsn::Tokenizer_IndexUtil
+// [17] Kernel bestKernel();
+// [17] bool isSupported(Kernel kernel);
+// [17] void build(Uint64 *index, const char *data, size_t length);
+// [17] void build(Kernel, Uint64 *index, const char *data, size_t length);
+// [17] size_t numWords(size_t length);
 // ----------------------------------------------------------------------------
 // [ 1] BREATHING TEST
-// [17] USAGE EXAMPLE
+// [18] CONCERN: TOKENIZING GENERATED DOCUMENTS
+// [19] USAGE EXAMPLE
+// [-1] PERFORMANCE TEST
 
 // ============================================================================
 //                     STANDARD BDE ASSERT TEST FUNCTION
@@ -175,6 +187,271 @@ void confirmStreamBufReset(bsl::streambuf     *sb,
     }
 }
 
+                          // =======================
+                          // class DocumentGenerator
+                          // =======================
+
+class DocumentGenerator {
+    // This class generates pseudo-random JSON documents, along with the
+    // sequence of tokens (and token values) that 'Obj' is expected to produce
+    // when traversing them.  The documents contain arbitrary whitespace,
+    // escape sequences, strings containing structural characters, and strings
+    // longer than the internal buffer of 'Obj'.
+
+  public:
+    // TYPES
+    struct Token {
+        Obj::TokenType d_type;   // expected token type
+        bsl::string    d_value;  // expected value, if a name or value
+    };
+
+  private:
+    // DATA
+    unsigned int        d_seed;             // state of the generator
+    int                 d_maxDepth;         // maximum nesting depth
+    bool                d_compact;          // 'true' if no whitespace
+    bsl::string        *d_document_p;       // document being generated
+    bsl::vector<Token> *d_tokens_p;         // expected tokens
+
+    // PRIVATE MANIPULATORS
+    unsigned int random(unsigned int range);
+        // Return a pseudo-random value in the range '[0 .. range - 1]'.
+
+    void addToken(Obj::TokenType type, const bsl::string& value = "");
+        // Append a token having the specified 'type' and the optionally
+        // specified 'value' to the expected tokens.
+
+    void generateWhitespace();
+        // Append a pseudo-random (possibly empty) sequence of whitespace to
+        // the document.
+
+    bsl::string generateString();
+        // Append a pseudo-random quoted string to the document and return its
+        // text, excluding the quotes.
+
+    void generateValue(int depth);
+        // Append a pseudo-random value, nested at the specified 'depth', to
+        // the document.
+
+  public:
+    // CREATORS
+    DocumentGenerator(unsigned int seed, int maxDepth, bool compact);
+        // Create a generator initialized with the specified 'seed' that
+        // generates values nested up to the specified 'maxDepth', and that
+        // generates no whitespace if the specified 'compact' is 'true'.
+
+    // MANIPULATORS
+    void generate(bsl::string        *document,
+                  bsl::vector<Token> *tokens,
+                  bsl::size_t         minLength);
+        // Load into the specified 'document' a JSON array having at least the
+        // specified 'minLength' characters, and load into the specified
+        // 'tokens' the tokens expected when traversing 'document'.
+};
+
+                          // -----------------------
+                          // class DocumentGenerator
+                          // -----------------------
+
+// PRIVATE MANIPULATORS
+unsigned int DocumentGenerator::random(unsigned int range)
+{
+    d_seed = d_seed * 1103515245 + 12345;
+    return (d_seed >> 8) % range;
+}
+
+void DocumentGenerator::addToken(Obj::TokenType type, const bsl::string& value)
+{
+    Token token;
+    token.d_type  = type;
+    token.d_value = value;
+    d_tokens_p->push_back(token);
+}
+
+void DocumentGenerator::generateWhitespace()
+{
+    static const char WHITESPACE[] = " \n\t\v\f\r";
+
+    if (d_compact || 0 == random(3)) {
+        return;                                                       // RETURN
+    }
+
+    const unsigned int length = 0 == random(40) ? random(300) : random(6);
+    for (unsigned int i = 0; i < length; ++i) {
+        *d_document_p += 0 == random(2) ? ' ' : WHITESPACE[random(6)];
+    }
+}
+
+bsl::string DocumentGenerator::generateString()
+{
+    static const char ALPHABET[] = "abcdefghijklmnopqrstuvwxyz"
+                                   "ABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789"
+                                   " {}[]:,'/-+.";
+    static const char *const ESCAPES[] = {
+        "\\\"", "\\\\", "\\/", "\\b", "\\f", "\\n", "\\r", "\\t", "\\u00e9"
+    };
+
+    const unsigned int length = 0 == random(200)
+                                ? 8000 + random(12000)
+                                : 1 + random(20);
+
+    bsl::string text;
+    while (text.length() < length) {
+        if (0 == random(8)) {
+            text += ESCAPES[random(sizeof ESCAPES / sizeof *ESCAPES)];
+        }
+        else {
+            text += ALPHABET[random(sizeof ALPHABET - 1)];
+        }
+    }
+
+    *d_document_p += '"';
+    *d_document_p += text;
+    *d_document_p += '"';
+
+    return text;
+}
+
+void DocumentGenerator::generateValue(int depth)
+{
+    static const char *const SCALARS[] = {
+        "0", "-1", "12345", "3.25", "-0.5e-3", "1E+20", "true", "false", "null"
+    };
+
+    const unsigned int kind = depth < d_maxDepth ? random(10) : 4 + random(6);
+
+    switch (kind) {
+      case 0:
+      case 1: {
+        *d_document_p += '{';
+        addToken(Obj::e_START_OBJECT);
+
+        const unsigned int numMembers = random(5);
+        for (unsigned int i = 0; i < numMembers; ++i) {
+            if (i) {
+                *d_document_p += ',';
+            }
+            generateWhitespace();
+            addToken(Obj::e_ELEMENT_NAME, generateString());
+            generateWhitespace();
+            *d_document_p += ':';
+            generateWhitespace();
+            generateValue(depth + 1);
+            generateWhitespace();
+        }
+
+        *d_document_p += '}';
+        addToken(Obj::e_END_OBJECT);
+      } break;
+      case 2:
+      case 3: {
+        *d_document_p += '[';
+        addToken(Obj::e_START_ARRAY);
+
+        const unsigned int numElements = random(5);
+        for (unsigned int i = 0; i < numElements; ++i) {
+            if (i) {
+                *d_document_p += ',';
+            }
+            generateWhitespace();
+            generateValue(depth + 1);
+            generateWhitespace();
+        }
+
+        *d_document_p += ']';
+        addToken(Obj::e_END_ARRAY);
+      } break;
+      case 4:
+      case 5:
+      case 6: {
+        addToken(Obj::e_ELEMENT_VALUE, '"' + generateString() + '"');
+      } break;
+      default: {
+        const char *scalar = SCALARS[random(sizeof SCALARS / sizeof *SCALARS)];
+
+        *d_document_p += scalar;
+        addToken(Obj::e_ELEMENT_VALUE, scalar);
+      } break;
+    }
+}
+
+// CREATORS
+DocumentGenerator::DocumentGenerator(unsigned int seed,
+                                     int          maxDepth,
+                                     bool         compact)
+: d_seed(seed)
+, d_maxDepth(maxDepth)
+, d_compact(compact)
+, d_document_p(0)
+, d_tokens_p(0)
+{
+}
+
+// MANIPULATORS
+void DocumentGenerator::generate(bsl::string        *document,
+                                 bsl::vector<Token> *tokens,
+                                 bsl::size_t         minLength)
+{
+    d_document_p = document;
+    d_tokens_p   = tokens;
+
+    document->clear();
+    tokens->clear();
+
+    generateWhitespace();
+    *document += '[';
+    addToken(Obj::e_START_ARRAY);
+
+    bool first = true;
+    do {
+        if (!first) {
+            *document += ',';
+        }
+        first = false;
+
+        generateWhitespace();
+        generateValue(1);
+        generateWhitespace();
+    } while (document->length() < minLength);
+
+    *document += ']';
+    addToken(Obj::e_END_ARRAY);
+    generateWhitespace();
+}
+
+void computeIndex(bsls::Types::Uint64 *index,
+                  const char          *data,
+                  bsl::size_t          length)
+    // Load into the specified 'index' the structural index of the specified
+    // 'length' characters at the specified 'data', as specified by
+    // 'baljsn::Tokenizer_IndexUtil', computed one character at a time.
+{
+    typedef baljsn::Tokenizer_IndexUtil Util;
+
+    bsl::fill(index, index + Util::numWords(length), 0);
+
+    for (bsl::size_t i = 0; i < length; ++i) {
+        const char                c     = data[i];
+        const bsls::Types::Uint64 bit   = 1ULL << (i % Util::k_BLOCK_SIZE);
+        bsls::Types::Uint64      *block = index
+                                        + i / Util::k_BLOCK_SIZE
+                                                     * Util::k_WORDS_PER_BLOCK;
+
+        const bool isWhitespace = c && bsl::strchr(" \n\t\v\f\r", c);
+        const bool isStructural = c && bsl::strchr("{}[]:,", c);
+
+        if (isWhitespace) {
+            block[Util::k_WHITESPACE] |= bit;
+        }
+        if (isWhitespace || isStructural) {
+            block[Util::k_DELIMITER] |= bit;
+        }
+        if ('"' == c || '\\' == c) {
+            block[Util::k_STRING_SPECIAL] |= bit;
+        }
+    }
+}
+
 // ============================================================================
 //                               MAIN PROGRAM
 // ----------------------------------------------------------------------------
@@ -196,7 +473,7 @@ int main(int argc, char *argv[])
     bslma::Default::setGlobalAllocator(&globalAllocator);
 
     switch (test) { case 0:  // Zero is always the leading case.
-      case 17: {
+      case 19: {
         // --------------------------------------------------------------------
         // USAGE EXAMPLE
         //   Extracted from component header file.
@@ -318,6 +595,206 @@ int main(int argc, char *argv[])
     ASSERT(10022           == address.d_zipcode);
 //..
       } break;
+      case 18: {
+        // --------------------------------------------------------------------
+        // TESTING TOKENIZING GENERATED DOCUMENTS
+        //
+        // Concerns:
+        //: 1 Tokens are found correctly regardless of where they fall relative
+        //:   to the 64-character blocks of the structural index and to the
+        //:   8K blocks read from the 'streambuf'.
+        //:
+        //: 2 Escaped quotes and backslashes, and structural characters within
+        //:   strings, do not terminate strings, including when the escape
+        //:   sequence straddles the end of a block read from the 'streambuf'.
+        //:
+        //: 3 Runs of whitespace of any length and composition are skipped.
+        //:
+        //: 4 Strings longer than the internal buffer are extracted correctly.
+        //
+        // Plan:
+        //: 1 Using 'DocumentGenerator', generate pseudo-random documents,
+        //:   both compact and containing whitespace, along with the expected
+        //:   sequence of tokens.  Traverse each document with a tokenizer and
+        //:   verify that the tokens and their values are as expected.
+        //:   (C-1..4)
+        //
+        // Testing:
+        //   CONCERN: TOKENIZING GENERATED DOCUMENTS
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "TESTING TOKENIZING GENERATED DOCUMENTS" << endl
+                          << "======================================" << endl;
+
+        typedef DocumentGenerator::Token Token;
+
+        bslma::TestAllocator da("default", veryVeryVerbose);
+        bslma::DefaultAllocatorGuard dag(&da);
+
+        for (unsigned int seed = 1; seed <= 40; ++seed) {
+            const bool COMPACT = 0 == seed % 4;
+
+            DocumentGenerator generator(seed, 1 + seed % 5, COMPACT);
+
+            bsl::string        document;
+            bsl::vector<Token> tokens;
+
+            generator.generate(&document, &tokens, 20000 + 3000 * seed);
+
+            if (veryVerbose) {
+                P_(seed) P_(document.length()) P(tokens.size())
+            }
+
+            bdlsb::FixedMemInStreamBuf isb(document.data(), document.length());
+
+            bslma::TestAllocator oa("object", veryVeryVerbose);
+
+            Obj mX(&oa);  const Obj& X = mX;
+            mX.reset(&isb);
+
+            for (bsl::size_t i = 0; i < tokens.size(); ++i) {
+                const Token& EXP = tokens[i];
+
+                const int rc = mX.advanceToNextToken();
+                LOOP2_ASSERT(seed, i, 0 == rc);
+                LOOP4_ASSERT(seed, i, EXP.d_type, X.tokenType(),
+                             EXP.d_type == X.tokenType());
+                if (rc || EXP.d_type != X.tokenType()) {
+                    break;
+                }
+
+                if (Obj::e_ELEMENT_NAME  == EXP.d_type
+                 || Obj::e_ELEMENT_VALUE == EXP.d_type) {
+                    bslstl::StringRef value;
+                    LOOP2_ASSERT(seed, i, 0 == X.value(&value));
+                    LOOP4_ASSERT(seed, i, EXP.d_value, value,
+                                 EXP.d_value == value);
+                }
+            }
+        }
+      } break;
+      case 17: {
+        // --------------------------------------------------------------------
+        // TESTING 'Tokenizer_IndexUtil'
+        //
+        // Concerns:
+        //: 1 'numWords' returns the number of words in the index of a sequence
+        //:   of the given length.
+        //:
+        //: 2 Each implementation of 'build' classifies every character value
+        //:   correctly, including characters with the high bit set and the
+        //:   null character.
+        //:
+        //: 3 'build' is correct for every length and alignment, sets no bits
+        //:   beyond the end of the sequence, and writes no words beyond the
+        //:   end of the index.
+        //:
+        //: 4 'bestKernel' is supported, and 'e_SCALAR' is always supported.
+        //
+        // Plan:
+        //: 1 Verify 'numWords' for a few lengths.  (C-1)
+        //:
+        //: 2 For every supported kernel, and for every length in '[0 .. 300]'
+        //:   and every offset in '[0 .. 31]', build the index of
+        //:   pseudo-random data rich in whitespace and structural characters,
+        //:   and compare it against an index computed one character at a
+        //:   time.  Verify that a sentinel word following the index is not
+        //:   modified.  (C-2..3)
+        //:
+        //: 3 Verify 'isSupported' for 'e_SCALAR' and 'bestKernel()'.  (C-4)
+        //
+        // Testing:
+        //   Kernel Tokenizer_IndexUtil::bestKernel();
+        //   bool Tokenizer_IndexUtil::isSupported(Kernel kernel);
+        //   void Tokenizer_IndexUtil::build(Uint64 *, const char *, size_t);
+        //   void Tokenizer_IndexUtil::build(Kernel, Uint64 *, const char *, ..
+        //   size_t Tokenizer_IndexUtil::numWords(size_t length);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "TESTING 'Tokenizer_IndexUtil'" << endl
+                          << "=============================" << endl;
+
+        typedef baljsn::Tokenizer_IndexUtil Util;
+
+        if (verbose) {
+            P(Util::bestKernel());
+        }
+
+        ASSERT(0 == Util::numWords(0));
+        ASSERT(3 == Util::numWords(1));
+        ASSERT(3 == Util::numWords(64));
+        ASSERT(6 == Util::numWords(65));
+        ASSERT(6 == Util::numWords(128));
+
+        ASSERT(Util::isSupported(Util::e_SCALAR));
+        ASSERT(Util::isSupported(Util::bestKernel()));
+
+        static const char RICH[] = " \n\t\v\f\r{}[]:,\"\\aZ09-+.e\x08\x0e\x1f"
+                                   "\x7b\x5b\x3a\x2c\xfb\xdb\xba\xac\x80\xff";
+
+        enum { k_MAX_LENGTH = 300, k_MAX_OFFSET = 32 };
+
+        char data[k_MAX_LENGTH + k_MAX_OFFSET];
+        {
+            unsigned int seed = 4321;
+            for (int i = 0; i < k_MAX_LENGTH + k_MAX_OFFSET; ++i) {
+                seed = seed * 1103515245 + 12345;
+                const unsigned int r = seed >> 8;
+                data[i] = r % 3
+                        ? RICH[(r >> 2) % sizeof RICH]
+                        : static_cast<char>(r >> 4);
+            }
+        }
+
+        static const Util::Kernel KERNELS[] = { Util::e_SCALAR, Util::e_AVX2 };
+        const int NUM_KERNELS = sizeof KERNELS / sizeof *KERNELS;
+
+        const Uint64 SENTINEL = 0x0123456789abcdefULL;
+
+        for (int k = 0; k < NUM_KERNELS; ++k) {
+            const Util::Kernel KERNEL = KERNELS[k];
+
+            if (!Util::isSupported(KERNEL)) {
+                if (verbose) cout << "Kernel " << KERNEL << " not supported"
+                                  << endl;
+                continue;
+            }
+
+            for (int offset = 0; offset < k_MAX_OFFSET; ++offset) {
+                for (int length = 0; length <= k_MAX_LENGTH; ++length) {
+                    const char        *DATA      = data + offset;
+                    const bsl::size_t  NUM_WORDS = Util::numWords(length);
+
+                    Uint64 expected[(k_MAX_LENGTH / 64 + 1) * 3];
+                    Uint64 actual  [(k_MAX_LENGTH / 64 + 1) * 3 + 1];
+
+                    computeIndex(expected, DATA, length);
+
+                    bsl::fill(actual, actual + NUM_WORDS + 1, SENTINEL);
+                    Util::build(KERNEL, actual, DATA, length);
+
+                    LOOP3_ASSERT(KERNEL, offset, length,
+                                 bsl::equal(expected,
+                                            expected + NUM_WORDS,
+                                            actual));
+                    LOOP3_ASSERT(KERNEL, offset, length,
+                                 SENTINEL == actual[NUM_WORDS]);
+
+                    if (Util::bestKernel() == KERNEL) {
+                        bsl::fill(actual, actual + NUM_WORDS + 1, SENTINEL);
+                        Util::build(actual, DATA, length);
+
+                        LOOP2_ASSERT(offset, length,
+                                     bsl::equal(expected,
+                                                expected + NUM_WORDS,
+                                                actual));
+                    }
+                }
+            }
+        }
+      } break;
       case 16: {
         // --------------------------------------------------------------------
         // TESTING that arrays of heterogenous types are handled correctly
@@ -6814,6 +7291,83 @@ int main(int argc, char *argv[])
         Obj mX;  const Obj& X = mX;
         ASSERTV(X.tokenType(), Obj::e_BEGIN == X.tokenType());
       } break;
+      case -1: {
+        // --------------------------------------------------------------------
+        // PERFORMANCE TEST
+        //
+        // Concerns:
+        //: 1 Traversing large documents, and many small documents, is fast.
+        //
+        // Plan:
+        //: 1 Generate a large (about 4MB) document with whitespace, a large
+        //:   compact document, and a small (about 300 characters) document,
+        //:   and report the time taken to traverse each of them repeatedly.
+        //:   (C-1)
+        //
+        // Testing:
+        //   PERFORMANCE TEST
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "PERFORMANCE TEST" << endl
+                          << "================" << endl;
+
+        typedef DocumentGenerator::Token Token;
+
+        bslma::TestAllocator da("default", veryVeryVerbose);
+        bslma::DefaultAllocatorGuard dag(&da);
+
+        const struct {
+            const char  *d_name;         // description
+            bool         d_compact;      // no whitespace
+            bsl::size_t  d_minLength;    // minimum document length
+            int          d_iterations;   // number of traversals
+        } DATA[] = {
+            { "large",         false, 4 << 20,        10 },
+            { "large compact", true,  4 << 20,        10 },
+            { "small",         false, 300,      100000 },
+            { "small compact", true,  300,      100000 },
+        };
+        const int NUM_DATA = sizeof DATA / sizeof *DATA;
+
+        for (int ti = 0; ti < NUM_DATA; ++ti) {
+            DocumentGenerator generator(ti + 1, 4, DATA[ti].d_compact);
+
+            bsl::string        document;
+            bsl::vector<Token> tokens;
+
+            generator.generate(&document, &tokens, DATA[ti].d_minLength);
+
+            const int ITERATIONS = DATA[ti].d_iterations;
+
+            Obj         mX;
+            bsl::size_t numTokens = 0;
+
+            bsls::Stopwatch timer;
+            timer.start();
+            for (int i = 0; i < ITERATIONS; ++i) {
+                bdlsb::FixedMemInStreamBuf isb(document.data(),
+                                               document.length());
+                mX.reset(&isb);
+                while (0 == mX.advanceToNextToken()) {
+                    ++numTokens;
+                }
+            }
+            timer.stop();
+
+            ASSERT(numTokens == tokens.size() * ITERATIONS);
+
+            const double seconds = timer.elapsedTime();
+            const double MB      = static_cast<double>(document.length())
+                                 * ITERATIONS / (1024 * 1024);
+
+            cout << DATA[ti].d_name << ": " << document.length()
+                 << " bytes, " << tokens.size() << " tokens: "
+                 << MB / seconds << " MB/s, "
+                 << seconds * 1e9 / static_cast<double>(numTokens)
+                 << " ns/token" << endl;
+        }
+      } break;
       default: {
         cerr << "WARNING: CASE `" << test << "' NOT FOUND." << endl;
         testStatus = -1;
@@ -19,6 +19,9 @@ BSLS_IDENT_RCSID(ball_asyncfileobserver_cpp,"$Id$ $CSID$")
 #include <bslmt_threadattributes.h>
 
 #include <bsls_assert.h>
+#include <bsls_systemtime.h>
+#include <bsls_timeinterval.h>
+#include <bsls_types.h>
 
 #include <bsl_functional.h>
 #include <bsl_memory.h>
@@ -41,8 +44,10 @@ namespace ball {
 namespace {
 
 enum {
-    k_DEFAULT_FIXED_QUEUE_SIZE = 8192,
-    k_FORCE_WARN_THRESHOLD     = 5000
+    k_DEFAULT_FIXED_QUEUE_SIZE       = 8192,
+    k_FORCE_WARN_THRESHOLD           = 5000,
+    k_DEFAULT_MAX_BATCH_SIZE         = 256,
+    k_DEFAULT_MAX_BATCH_LATENCY_USEC = 10 * 1000
 };
 
 static const char *const k_LOG_CATEGORY = "BALL.ASYNCFILEOBSERVER";
@@ -76,7 +81,7 @@ void AsyncFileObserver::logDroppedMessageWarning(int numDropped)
 
     populateWarnRecord(&d_droppedRecordWarning, __LINE__, numDropped);
     Context context(Transmission::e_PASSTHROUGH, 0, 0);
-    d_fileObserver.publish(d_droppedRecordWarning, context);
+    d_fileObserver.publishDeferred(d_droppedRecordWarning, context);
 }
 
 void AsyncFileObserver::publishThreadEntryPoint()
@@ -88,36 +93,91 @@ void AsyncFileObserver::publishThreadEntryPoint()
     while (!done) {
         AsyncFileObserver_Record asyncRecord = d_recordQueue.popFront();
 
-        // Publish the next log record on the queue only if the observer is not
-        // shutting down.
+        // Records are formatted into the buffer of the file observer, and the
+        // buffer is written to the log file when the batch is full, when the
+        // maximum batch latency has elapsed, or when the queue is empty (see
+        // {Batched Publication}).
+
+        const int                maxBatchSize = d_maxBatchSize.loadRelaxed();
+        const bsls::Types::Int64 maxBatchLatency =
+                                              d_maxBatchLatency.loadRelaxed();
+        const bsls::TimeInterval batchStartTime =
+                                         bsls::SystemTime::nowMonotonicClock();
+        int                      batchSize = 0;
+        int                      numRemoved = 0;
+
+        while (true) {
+            // Publish the next log record on the queue only if the observer is
+            // not shutting down.  Note that the bogus record enqueued by
+            // 'stopThread' is not counted by 'd_numUnwrittenRecords'.
+
+            const bool isEnd = Transmission::e_END ==
+                                     asyncRecord.d_context.transmissionCause();
+            if (!isEnd) {
+                ++numRemoved;
+            }
 
-        if (Transmission::e_END == asyncRecord.d_context.transmissionCause()
-            || d_shuttingDownFlag) {
-            done = true;
-        }
-        else {
-            d_fileObserver.publish(*asyncRecord.d_record,
-                                   asyncRecord.d_context);
-        }
+            if (isEnd || d_shuttingDownFlag) {
+                done = true;
+            }
+            else {
+                d_fileObserver.publishDeferred(*asyncRecord.d_record,
+                                               asyncRecord.d_context);
+                ++batchSize;
+            }
 
-        // Publish the count of dropped records.  To avoid repeatedly
-        // publishing this information when the record queue is full, we
-        // publish the number of dropped records only when the queue becomes
-        // half empty or when a sufficient number of records have been dropped.
-        // Finally, we publish the dropped record count if the observer is
-        // shutting down, so the information is not lost.
-
-        if (0 < d_dropCount.loadRelaxed()) {
-            if (d_recordQueue.length() <= d_recordQueue.size() / 2
-            ||  d_dropCount.loadRelaxed() >= k_FORCE_WARN_THRESHOLD
-            ||  d_shuttingDownFlag) {
-                int numDropped = d_dropCount.swap(0);
-                BSLS_ASSERT(0 < numDropped); // No other thread should have
-                                             // cleared the count.
-                logDroppedMessageWarning(numDropped);
+            // Publish the count of dropped records.  To avoid repeatedly
+            // publishing this information when the record queue is full, we
+            // publish the number of dropped records only when the queue
+            // becomes half empty or when a sufficient number of records have
+            // been dropped.  Finally, we publish the dropped record count if
+            // the observer is shutting down, so the information is not lost.
+
+            if (0 < d_dropCount.loadRelaxed()) {
+                if (d_recordQueue.length() <= d_recordQueue.size() / 2
+                ||  d_dropCount.loadRelaxed() >= k_FORCE_WARN_THRESHOLD
+                ||  d_shuttingDownFlag) {
+                    int numDropped = d_dropCount.swap(0);
+                    BSLS_ASSERT(0 < numDropped); // No other thread should
+                                                 // have cleared the count.
+                    logDroppedMessageWarning(numDropped);
+                }
             }
+
+            if (done
+             || batchSize >= maxBatchSize
+             || maxBatchLatency <=
+                     (bsls::SystemTime::nowMonotonicClock() - batchStartTime)
+                                                       .totalMicroseconds()) {
+                break;
+            }
+
+            if (0 != d_recordQueue.tryPopFront(&asyncRecord)) {
+                break;
+            }
+        }
+
+        // The records of the batch are accounted for by 'recordQueueLength'
+        // until they are written to the log file (see {Batched Publication}).
+
+        d_fileObserver.writeDeferredRecords();
+        d_numUnwrittenRecords.add(-numRemoved);
+    }
+}
+
+void AsyncFileObserver::removeAllRecords()
+{
+    AsyncFileObserver_Record asyncRecord;
+    int                      numRemoved = 0;
+
+    for (int i = d_recordQueue.length();
+         0 < i && 0 == d_recordQueue.tryPopFront(&asyncRecord);
+         --i) {
+        if (Transmission::e_END != asyncRecord.d_context.transmissionCause()) {
+            ++numRemoved;
         }
     }
+    d_numUnwrittenRecords.add(-numRemoved);
 }
 
 int AsyncFileObserver::startThread()
@@ -166,7 +226,7 @@ int AsyncFileObserver::shutdownThread()
     // We clear the queue to remove the bogus log record appended by
     // 'stopThread'.
 
-    d_recordQueue.removeAll();
+    removeAllRecords();
     d_shuttingDownFlag = 0;
     return ret;
 }
@@ -176,6 +236,8 @@ void AsyncFileObserver::construct()
     d_threadHandle     = bslmt::ThreadUtil::invalidHandle();
     d_shuttingDownFlag = 0;
     d_dropCount        = 0;
+    d_maxBatchSize     = k_DEFAULT_MAX_BATCH_SIZE;
+    d_maxBatchLatency  = k_DEFAULT_MAX_BATCH_LATENCY_USEC;
 
     d_publishThreadEntryPoint = bsl::function<void()>(
             bsl::allocator_arg_t(),
@@ -272,8 +334,14 @@ void AsyncFileObserver::publish(const bsl::shared_ptr<const Record>& record,
     asyncRecord.d_record  = record;
     asyncRecord.d_context = context;
 
+    // The record is counted before it is enqueued, so that the publication
+    // thread cannot write it before it is counted.
+
+    d_numUnwrittenRecords.add(1);
+
     if (record->fixedFields().severity() > d_dropRecordsOnFullQueueThreshold) {
         if (0 != d_recordQueue.tryPushBack(asyncRecord)) {
+            d_numUnwrittenRecords.add(-1);
             d_dropCount.addRelaxed(1);
         }
     }
@@ -290,7 +358,7 @@ void AsyncFileObserver::releaseRecords()
         startThread();
     }
     else {
-        d_recordQueue.removeAll();
+        removeAllRecords();
     }
 }
 
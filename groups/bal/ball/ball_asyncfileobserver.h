@@ -38,16 +38,20 @@ BSLS_IDENT("$Id: $")
 //                         |              ctor
 //                         |              disableFileLogging
 //                         |              disablePublishInLocalTime
+//                         |              disableRotatedFileCompression
 //                         |              disableSizeRotation
 //                         |              disableStdoutLoggingPrefix
 //                         |              disableTimeIntervalRotation
 //                         |              enableFileLogging
 //                         |              enableStdoutLoggingPrefix
 //                         |              enablePublishInLocalTime
+//                         |              enableRotatedFileCompression
 //                         |              forceRotation
 //                         |              rotateOnSize
 //                         |              rotateOnTimeInterval
 //                         |              setLogFormat
+//                         |              setMaxBatchLatency
+//                         |              setMaxBatchSize
 //                         |              setOnFileRotationCallback
 //                         |              setStdoutThreshold
 //                         |              shutdownPublicationThread
@@ -57,7 +61,10 @@ BSLS_IDENT("$Id: $")
 //                         |              isFileLoggingEnabled
 //                         |              isPublicationThreadRunning
 //                         |              isPublishInLocalTimeEnabled
+//                         |              isRotatedFileCompressionEnabled
 //                         |              isStdoutLoggingPrefixEnabled
+//                         |              maxBatchLatency
+//                         |              maxBatchSize
 //                         |              recordQueueLength
 //                         |              rotationLifetime
 //                         |              rotationSize
@@ -125,6 +132,9 @@ BSLS_IDENT("$Id: $")
 // | Thread      | stopPublicationThread       |                              |
 // | Management  | shutdownPublicationThread   |                              |
 // +-------------+-----------------------------+------------------------------+
+// | Batched     | setMaxBatchSize             | maxBatchSize                 |
+// | Publication | setMaxBatchLatency          | maxBatchLatency              |
+// +-------------+-----------------------------+------------------------------+
 //..
 // In general, a 'ball::AsyncFileObserver' object can be dynamically configured
 // throughout its lifetime (in particular, before or after being registered
@@ -164,6 +174,30 @@ BSLS_IDENT("$Id: $")
 // record count is reset to 0 after each such warning is published, so each
 // dropped record is counted only once.
 //
+///Batched Publication
+///-------------------
+// The publication thread removes records from the queue in batches.  Each
+// record of a batch is formatted into an in-memory buffer (see {Deferred
+// Publication} in 'ball_fileobserver2'), and the buffer is written to the log
+// file using a single 'write' system call when any of the following holds:
+//
+//: o 'maxBatchSize' records have been buffered (256 by default),
+//:
+//: o 'maxBatchLatency' has elapsed since the first record of the batch was
+//:   removed from the queue (10 milliseconds by default), or
+//:
+//: o the queue is empty.
+//
+// Batching therefore never delays the writing of a record when the
+// publication thread keeps up with the publishing threads, and otherwise
+// bounds both the memory used by the buffer and the time a record that has
+// been removed from the queue may remain unwritten.  Setting 'maxBatchSize'
+// to 1 (or 'maxBatchLatency' to 0) causes each record to be written to the
+// log file individually.  Note that records logged to 'stdout' are not
+// batched.  Records of a batch that are not yet written to the log file are
+// included in 'recordQueueLength', so that a 'recordQueueLength' of 0
+// indicates that every published record has been written.
+//
 ///Log Record Formatting
 ///---------------------
 // By default, the output format of published log records (whether to 'stdout'
@@ -482,7 +516,9 @@ BSLS_IDENT("$Id: $")
 
 #include <bslmt_threadutil.h>
 
+#include <bsls_assert.h>
 #include <bsls_atomic.h>
+#include <bsls_timeinterval.h>
 
 #include <bsl_functional.h>
 #include <bsl_memory.h>
@@ -546,6 +582,22 @@ class AsyncFileObserver : public Observer {
                                                      // each time drop count is
                                                      // published
 
+    bsls::AtomicInt                d_maxBatchSize;   // maximum number of
+                                                     // records written to the
+                                                     // log file per 'write'
+
+    bsls::AtomicInt64              d_maxBatchLatency;
+                                                     // maximum time (in
+                                                     // microseconds) a record
+                                                     // removed from the queue
+                                                     // may remain buffered
+
+    bsls::AtomicInt                d_numUnwrittenRecords;
+                                                     // number of published
+                                                     // records neither written
+                                                     // to the log file nor
+                                                     // discarded
+
     bsl::function<void()>          d_publishThreadEntryPoint;
                                                      // publication thread
                                                      // entry point functor
@@ -585,6 +637,11 @@ class AsyncFileObserver : public Observer {
         // thread-safe.  Note that this function is the entry point for the
         // publication thread.
 
+    void removeAllRecords();
+        // Remove the records currently on the record queue without publishing
+        // them.  The behavior is undefined unless the calling thread holds a
+        // lock on 'd_mutex'.
+
     int shutdownThread();
         // Stop the publication thread and discard all currently queued log
         // records.  Return 0 on success, and a non-zero value if there is an
@@ -719,6 +776,12 @@ class AsyncFileObserver : public Observer {
         // records subsequently received through the 'publish' method as well
         // as those that are currently on the queue.
 
+    void disableRotatedFileCompression();
+        // Disable the compression of log files subsequently rotated by this
+        // async file observer.  This method has no effect if rotated file
+        // compression is not enabled.  Note that the rotated log files already
+        // submitted for compression are still compressed.
+
     void disableSizeRotation();
         // Disable log file rotation based on log file size for this async file
         // observer.  This method has no effect if rotation-on-size is not
@@ -787,6 +850,15 @@ class AsyncFileObserver : public Observer {
         // that this method affects records subsequently received through the
         // 'publish' method as well as those that are currently on the queue.
 
+    int enableRotatedFileCompression();
+        // Enable the compression, in the gzip format and on a background
+        // thread, of each log file subsequently rotated by this async file
+        // observer.  Return 0 on success, and a non-zero value if the
+        // background thread could not be started, in which case rotated log
+        // files are not compressed.  This method has no effect (and returns 0)
+        // if rotated file compression is already enabled.  See
+        // {'ball_fileobserver2'|Rotated File Compression}.
+
     void forceRotation();
         // Forcefully perform a log file rotation by this async file observer.
         // Close the current log file, rename the log file if necessary, and
@@ -857,6 +929,21 @@ class AsyncFileObserver : public Observer {
         // received through the 'publish' method as well as those that are
         // currently on the queue.
 
+    void setMaxBatchLatency(const bsls::TimeInterval& maxBatchLatency);
+        // Set the maximum time that a record removed from the record queue by
+        // the publication thread of this async file observer may remain
+        // buffered in memory before being written to the log file to the
+        // specified 'maxBatchLatency'.  The behavior is undefined unless
+        // 'bsls::TimeInterval() <= maxBatchLatency'.  Note that a value of 0
+        // causes each record to be written individually.  See {Batched
+        // Publication}.
+
+    void setMaxBatchSize(int maxBatchSize);
+        // Set the maximum number of records that the publication thread of
+        // this async file observer writes to the log file using a single
+        // 'write' system call to the specified 'maxBatchSize'.  The behavior
+        // is undefined unless '1 <= maxBatchSize'.  See {Batched Publication}.
+
     void setOnFileRotationCallback(
                              const OnFileRotationCallback& onRotationCallback);
         // Set the specified 'onRotationCallback' to be invoked after each time
@@ -931,6 +1018,10 @@ class AsyncFileObserver : public Observer {
         // that the value returned by this method also affects log filenames
         // (see {Log Filename Patterns}).
 
+    bool isRotatedFileCompressionEnabled() const;
+        // Return 'true' if the log files rotated by this async file observer
+        // are compressed, and 'false' otherwise.
+
     bool isStdoutLoggingPrefixEnabled() const;
         // Return 'true' if this async file observer uses the long output
         // format when writing to 'stdout', and 'false' otherwise (in which
@@ -955,9 +1046,21 @@ class AsyncFileObserver : public Observer {
         // !DEPRECATED!: Use 'bdlt::LocalTimeOffset' instead.
 #endif // BDE_OMIT_INTERNAL_DEPRECATED
 
+    bsls::TimeInterval maxBatchLatency() const;
+        // Return the maximum time that a record removed from the record queue
+        // by the publication thread of this async file observer may remain
+        // buffered in memory before being written to the log file.
+
+    int maxBatchSize() const;
+        // Return the maximum number of records that the publication thread of
+        // this async file observer writes to the log file using a single
+        // 'write' system call.
+
     int recordQueueLength() const;
         // Return the number of log records currently on the record queue of
-        // this async file observer.
+        // this async file observer, including the records removed from the
+        // queue by the publication thread that are not yet written to the log
+        // file (see {Batched Publication}).
 
     bdlt::DatetimeInterval rotationLifetime() const;
         // Return the log file lifetime that will trigger a file rotation by
@@ -997,6 +1100,12 @@ void AsyncFileObserver::disablePublishInLocalTime()
     d_fileObserver.disablePublishInLocalTime();
 }
 
+inline
+void AsyncFileObserver::disableRotatedFileCompression()
+{
+    d_fileObserver.disableRotatedFileCompression();
+}
+
 inline
 void AsyncFileObserver::disableSizeRotation()
 {
@@ -1027,6 +1136,12 @@ void AsyncFileObserver::enablePublishInLocalTime()
     d_fileObserver.enablePublishInLocalTime();
 }
 
+inline
+int AsyncFileObserver::enableRotatedFileCompression()
+{
+    return d_fileObserver.enableRotatedFileCompression();
+}
+
 inline
 void AsyncFileObserver::enableStdoutLoggingPrefix()
 {
@@ -1074,6 +1189,23 @@ void AsyncFileObserver::setOnFileRotationCallback(
     d_fileObserver.setOnFileRotationCallback(onRotationCallback);
 }
 
+inline
+void AsyncFileObserver::setMaxBatchLatency(
+                                     const bsls::TimeInterval& maxBatchLatency)
+{
+    BSLS_ASSERT(bsls::TimeInterval() <= maxBatchLatency);
+
+    d_maxBatchLatency.storeRelaxed(maxBatchLatency.totalMicroseconds());
+}
+
+inline
+void AsyncFileObserver::setMaxBatchSize(int maxBatchSize)
+{
+    BSLS_ASSERT(1 <= maxBatchSize);
+
+    d_maxBatchSize.storeRelaxed(maxBatchSize);
+}
+
 inline
 void AsyncFileObserver::setStdoutThreshold(Severity::Level stdoutThreshold)
 {
@@ -1112,6 +1244,12 @@ bool AsyncFileObserver::isPublishInLocalTimeEnabled() const
     return d_fileObserver.isPublishInLocalTimeEnabled();
 }
 
+inline
+bool AsyncFileObserver::isRotatedFileCompressionEnabled() const
+{
+    return d_fileObserver.isRotatedFileCompressionEnabled();
+}
+
 inline
 bool AsyncFileObserver::isStdoutLoggingPrefixEnabled() const
 {
@@ -1132,10 +1270,24 @@ bdlt::DatetimeInterval AsyncFileObserver::localTimeOffset() const
 }
 #endif // BDE_OMIT_INTERNAL_DEPRECATED
 
+inline
+bsls::TimeInterval AsyncFileObserver::maxBatchLatency() const
+{
+    bsls::TimeInterval result;
+    result.addMicroseconds(d_maxBatchLatency.loadRelaxed());
+    return result;
+}
+
+inline
+int AsyncFileObserver::maxBatchSize() const
+{
+    return d_maxBatchSize.loadRelaxed();
+}
+
 inline
 int AsyncFileObserver::recordQueueLength() const
 {
-    return d_recordQueue.length();
+    return d_numUnwrittenRecords;
 }
 
 inline
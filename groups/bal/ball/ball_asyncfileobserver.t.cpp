@@ -28,6 +28,11 @@
 #include <bsls_assert.h>
 #include <bsls_platform.h>
 #include <bsls_stopwatch.h>
+#include <bsls_timeinterval.h>
+#include <bsls_timeutil.h>
+#include <bsls_types.h>
+
+#include <bsl_algorithm.h>
 
 #include <bsl_climits.h>
 #include <bsl_cmath.h>
@@ -35,10 +40,12 @@
 #include <bsl_cstdio.h>      // 'remove'
 #include <bsl_cstdlib.h>
 #include <bsl_cstring.h>
+#include <bsl_fstream.h>
 #include <bsl_ctime.h>       // 'time_t'
 #include <bsl_iomanip.h>     // 'setfill'
 #include <bsl_iostream.h>
 #include <bsl_sstream.h>
+#include <bsl_vector.h>
 
 #include <bsl_c_stdlib.h>    // 'unsetenv'
 
@@ -104,6 +111,8 @@ using bsl::flush;
 // [ 6] void rotateOnTimeInterval(const DatetimeInterval timeInterval);
 // [ 6] void rotateOnTimeInterval(const DatetimeI&, const Datetime&);
 // [ 1] void setLogFormat(const char* logF, const char* stdoutF);
+// [12] void setMaxBatchLatency(const bsls::TimeInterval&);
+// [12] void setMaxBatchSize(int);
 // [ 8] void setOnFileRotationCallback(const OnFileRotationCallback&);
 // [ 1] void setStdoutThreshold(ball::Severity::Level stdoutThreshold);
 // [ 3] void shutdownPublicationThread();
@@ -118,6 +127,8 @@ using bsl::flush;
 // [ 1] bool isPublishInLocalTimeEnabled() const;
 // [ 1] bool isStdoutLoggingPrefixEnabled() const;
 // [ 1] bool isUserFieldsLoggingEnabled() const;
+// [12] bsls::TimeInterval maxBatchLatency() const;
+// [12] int maxBatchSize() const;
 // [11] int recordQueueLength() const;
 // [ 6] bdlt::DatetimeInterval rotationLifetime() const;
 // [ 6] int rotationSize() const;
@@ -128,7 +139,9 @@ using bsl::flush;
 // [ 7] CONCERN: LOGGING TO A FAILING STREAM
 // [ 5] CONCERN: LOG MESSAGE DROP
 // [ 9] CONCERN: ROTATION
-// [12] USAGE EXAMPLE
+// [12] CONCERN: BATCHED PUBLICATION
+// [13] USAGE EXAMPLE
+// [-1] PERFORMANCE: BATCHED PUBLICATION
 
 // Note assert and debug macros all output to 'cerr' instead of cout, unlike
 // most other test drivers.  This is necessary because test case 2 plays tricks
@@ -605,6 +618,49 @@ extern "C" void *workerThread2(void *arg)
 
 }  // close namespace BALL_ASYNCFILEOBSERVER_TEST_CONCURRENCY
 
+namespace BALL_ASYNCFILEOBSERVER_TEST_BENCHMARK {
+
+struct ThreadArgs {
+    // This 'struct' holds the arguments and the results of a benchmark
+    // publication thread.
+
+    ball::AsyncFileObserver         *d_observer_p;   // observer to publish to
+    int                              d_numRecords;   // records to publish
+    bsl::vector<bsls::Types::Int64>  d_latencies;    // nanoseconds spent in
+                                                     // each call to 'publish'
+};
+
+extern "C" void *benchmarkThread(void *arg)
+    // Publish 'd_numRecords' records to the observer supplied by the specified
+    // 'arg' (that must refer to a 'ThreadArgs' object), and record the time
+    // spent in each call to 'publish' in 'd_latencies'.
+{
+    ThreadArgs *args = static_cast<ThreadArgs *>(arg);
+
+    bsl::shared_ptr<ball::Record> record = bsl::make_shared<ball::Record>();
+    record->fixedFields().setSeverity(ball::Severity::e_INFO);
+    record->fixedFields().setCategory("ball::AsyncFileObserverBenchmark");
+    record->fixedFields().setFileName(__FILE__);
+    record->fixedFields().setLineNumber(__LINE__);
+    record->fixedFields().setTimestamp(bdlt::CurrentTime::utc());
+    record->fixedFields().setMessage(
+                     "ball::AsyncFileObserver benchmark record of typical "
+                     "length, carrying a value or two: 12345, 3.14159.");
+
+    const ball::Context context(ball::Transmission::e_PASSTHROUGH, 0, 1);
+
+    args->d_latencies.reserve(args->d_numRecords);
+
+    for (int i = 0; i < args->d_numRecords; ++i) {
+        const bsls::Types::Int64 start = bsls::TimeUtil::getTimer();
+        args->d_observer_p->publish(record, context);
+        args->d_latencies.push_back(bsls::TimeUtil::getTimer() - start);
+    }
+    return 0;
+}
+
+}  // close namespace BALL_ASYNCFILEOBSERVER_TEST_BENCHMARK
+
 //=============================================================================
 //                                 MAIN PROGRAM
 //-----------------------------------------------------------------------------
@@ -623,7 +679,7 @@ int main(int argc, char *argv[])
     bslma::TestAllocator *Z = &allocator;
 
     switch (test) { case 0:
-      case 12: {
+      case 13: {
         // --------------------------------------------------------------------
         // USAGE EXAMPLE
         //
@@ -775,6 +831,178 @@ int main(int argc, char *argv[])
 //..
 
       } break;
+      case 12: {
+        // --------------------------------------------------------------------
+        // TESTING BATCHED PUBLICATION
+        //
+        // Concerns:
+        //: 1 The maximum batch size and latency have the documented default
+        //:   values, and the manipulators set the values reported by the
+        //:   accessors.
+        //:
+        //: 2 For any batch configuration, all published records are written
+        //:   to the log file in the order in which they were published.
+        //:
+        //: 3 A record is written to the log file once the record queue is
+        //:   empty, irrespective of the batch configuration.
+        //
+        // Plan:
+        //: 1 Verify the default values of 'maxBatchSize' and
+        //:   'maxBatchLatency', set new values, and verify the accessors.
+        //:   (C-1)
+        //:
+        //: 2 For a set of batch sizes and latencies, publish a sequence of
+        //:   numbered records to a blocking observer, stop the publication
+        //:   thread, and verify the content of the log file.  (C-2)
+        //:
+        //: 3 Configure a large batch size and latency, publish a single
+        //:   record, and verify that it is written to the log file well
+        //:   before the latency has elapsed.  (C-3)
+        //
+        // Testing:
+        //   void setMaxBatchLatency(const bsls::TimeInterval&);
+        //   void setMaxBatchSize(int);
+        //   bsls::TimeInterval maxBatchLatency() const;
+        //   int maxBatchSize() const;
+        //   CONCERN: BATCHED PUBLICATION
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << "\nTESTING BATCHED PUBLICATION"
+                          << "\n===========================" << endl;
+
+        bslma::TestAllocator ta(veryVeryVeryVerbose);
+
+        if (verbose) cout << "\tTesting default values and accessors." << endl;
+        {
+            Obj mX(&ta);  const Obj& X = mX;
+
+            ASSERT(256 == X.maxBatchSize());
+            ASSERT(bsls::TimeInterval(0, 10 * 1000 * 1000) ==
+                                                         X.maxBatchLatency());
+
+            mX.setMaxBatchSize(1);
+            ASSERT(1 == X.maxBatchSize());
+
+            mX.setMaxBatchSize(4096);
+            ASSERT(4096 == X.maxBatchSize());
+
+            mX.setMaxBatchLatency(bsls::TimeInterval());
+            ASSERT(bsls::TimeInterval() == X.maxBatchLatency());
+
+            mX.setMaxBatchLatency(bsls::TimeInterval(2, 1000));
+            ASSERT(bsls::TimeInterval(2, 1000) == X.maxBatchLatency());
+        }
+
+        if (verbose) cout << "\tTesting record order." << endl;
+        {
+            static const struct {
+                int d_line;
+                int d_maxBatchSize;
+                int d_maxBatchLatencyUsec;
+            } DATA[] = {
+                //LINE  SIZE   LATENCY
+                //----  -----  -------
+                { L_,       1,   10000 },
+                { L_,       2,   10000 },
+                { L_,       7,       0 },
+                { L_,     256,       0 },
+                { L_,     256,   10000 },
+                { L_,    8192, 1000000 },
+            };
+            const int NUM_DATA = sizeof DATA / sizeof *DATA;
+
+            const int NUM_RECORDS = 2000;
+
+            for (int ti = 0; ti < NUM_DATA; ++ti) {
+                const int LINE    = DATA[ti].d_line;
+                const int SIZE    = DATA[ti].d_maxBatchSize;
+                const int LATENCY = DATA[ti].d_maxBatchLatencyUsec;
+
+                TempDirectoryGuard tempDirGuard;
+                bsl::string        fileName(tempDirGuard.getTempDirName());
+                bdls::PathUtil::appendRaw(&fileName, "testLog");
+
+                Obj mX(ball::Severity::e_OFF,
+                       false,
+                       64,
+                       ball::Severity::e_TRACE,
+                       &ta);
+
+                bsls::TimeInterval latency;
+                latency.addMicroseconds(LATENCY);
+
+                mX.setMaxBatchSize(SIZE);
+                mX.setMaxBatchLatency(latency);
+                mX.setLogFormat("%m\n", "%m\n");
+                ASSERTV(LINE, 0 == mX.enableFileLogging(fileName.c_str()));
+                ASSERTV(LINE, 0 == mX.startPublicationThread());
+
+                for (int i = 0; i < NUM_RECORDS; ++i) {
+                    bsl::shared_ptr<ball::Record> record =
+                                  bsl::allocate_shared<ball::Record>(&ta);
+                    record->fixedFields().setSeverity(ball::Severity::e_INFO);
+
+                    bsl::ostringstream oss;
+                    oss << i;
+                    record->fixedFields().setMessage(oss.str().c_str());
+
+                    mX.publish(record, ball::Context());
+                }
+
+                ASSERTV(LINE, 0 == mX.stopPublicationThread());
+                mX.disableFileLogging();
+
+                bsl::ifstream fs(fileName.c_str());
+                bsl::string   line;
+                int           numLines = 0;
+                while (getline(fs, line)) {
+                    bsl::ostringstream oss;
+                    oss << numLines;
+                    ASSERTV(LINE, numLines, line, oss.str() == line);
+                    ++numLines;
+                }
+                ASSERTV(LINE, numLines, NUM_RECORDS == numLines);
+            }
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+
+        if (verbose) cout << "\tTesting write on empty queue." << endl;
+        {
+            TempDirectoryGuard tempDirGuard;
+            bsl::string        fileName(tempDirGuard.getTempDirName());
+            bdls::PathUtil::appendRaw(&fileName, "testLog");
+
+            Obj mX(ball::Severity::e_OFF, &ta);
+
+            mX.setMaxBatchSize(8192);
+            mX.setMaxBatchLatency(bsls::TimeInterval(60, 0));
+            mX.setLogFormat("%m\n", "%m\n");
+            ASSERT(0 == mX.enableFileLogging(fileName.c_str()));
+            ASSERT(0 == mX.startPublicationThread());
+
+            bsl::shared_ptr<ball::Record> record =
+                                  bsl::allocate_shared<ball::Record>(&ta);
+            record->fixedFields().setSeverity(ball::Severity::e_INFO);
+            record->fixedFields().setMessage("single");
+
+            mX.publish(record, ball::Context());
+
+            bsls::Stopwatch timer;
+            timer.start();
+
+            while (7 != FsUtil::getFileSize(fileName)
+                && timer.elapsedTime() < 5) {
+                bslmt::ThreadUtil::microSleep(1000, 0);
+            }
+
+            ASSERTV(timer.elapsedTime(),
+                    FsUtil::getFileSize(fileName),
+                    7 == FsUtil::getFileSize(fileName));
+
+            ASSERT(0 == mX.stopPublicationThread());
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+      } break;
       case 11: {
         // --------------------------------------------------------------------
         // TESTING 'recordQueueLength'
@@ -3513,6 +3741,104 @@ int main(int argc, char *argv[])
         }
         fclose(stdout);
       } break;
+      case -1: {
+        // --------------------------------------------------------------------
+        // PERFORMANCE: BATCHED PUBLICATION
+        //
+        // Concerns:
+        //: 1 Batching the records written by the publication thread increases
+        //:   the rate at which records are published, and reduces the latency
+        //:   of 'publish' when the record queue would otherwise fill up.
+        //
+        // Plan:
+        //: 1 For a set of maximum batch sizes, publish records from several
+        //:   threads to a blocking observer logging to a file, measuring the
+        //:   time spent in each call to 'publish' and the overall time until
+        //:   all records are written.  Report the number of records written
+        //:   per second, and the median and 99th percentile of the latency of
+        //:   'publish'.  (C-1)
+        //
+        // Testing:
+        //   PERFORMANCE: BATCHED PUBLICATION
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << "\nPERFORMANCE: BATCHED PUBLICATION"
+                          << "\n================================" << endl;
+
+        using namespace BALL_ASYNCFILEOBSERVER_TEST_BENCHMARK;
+
+        bslma::TestAllocator ta(veryVeryVeryVerbose);
+
+        const int NUM_THREADS            = 4;
+        const int NUM_RECORDS_PER_THREAD = 100000;
+
+        const int BATCH_SIZES[]  = { 1, 16, 256, 4096 };
+        const int NUM_BATCH_SIZES = sizeof BATCH_SIZES / sizeof *BATCH_SIZES;
+
+        for (int ti = 0; ti < NUM_BATCH_SIZES; ++ti) {
+            const int BATCH_SIZE = BATCH_SIZES[ti];
+
+            TempDirectoryGuard tempDirGuard;
+            bsl::string        fileName(tempDirGuard.getTempDirName());
+            bdls::PathUtil::appendRaw(&fileName, "testLog");
+
+            Obj mX(ball::Severity::e_OFF,
+                   false,
+                   8192,
+                   ball::Severity::e_TRACE,
+                   &ta);
+
+            mX.setMaxBatchSize(BATCH_SIZE);
+            ASSERT(0 == mX.enableFileLogging(fileName.c_str()));
+            ASSERT(0 == mX.startPublicationThread());
+
+            ThreadArgs                args[NUM_THREADS];
+            bslmt::ThreadUtil::Handle handles[NUM_THREADS];
+
+            const bsls::Types::Int64 start = bsls::TimeUtil::getTimer();
+
+            for (int i = 0; i < NUM_THREADS; ++i) {
+                args[i].d_observer_p = &mX;
+                args[i].d_numRecords = NUM_RECORDS_PER_THREAD;
+                ASSERT(0 == bslmt::ThreadUtil::create(&handles[i],
+                                                      benchmarkThread,
+                                                      &args[i]));
+            }
+            for (int i = 0; i < NUM_THREADS; ++i) {
+                ASSERT(0 == bslmt::ThreadUtil::join(handles[i]));
+            }
+
+            ASSERT(0 == mX.stopPublicationThread());
+
+            const double elapsed =
+                 static_cast<double>(bsls::TimeUtil::getTimer() - start) / 1e9;
+
+            mX.disableFileLogging();
+
+            bsl::vector<bsls::Types::Int64> latencies;
+            for (int i = 0; i < NUM_THREADS; ++i) {
+                latencies.insert(latencies.end(),
+                                 args[i].d_latencies.begin(),
+                                 args[i].d_latencies.end());
+            }
+            bsl::sort(latencies.begin(), latencies.end());
+
+            const int NUM_RECORDS = NUM_THREADS * NUM_RECORDS_PER_THREAD;
+
+            ASSERTV(BATCH_SIZE,
+                    countLoggedRecords(fileName),
+                    NUM_RECORDS == countLoggedRecords(fileName));
+
+            cout << "maxBatchSize = " << bsl::setw(4) << BATCH_SIZE
+                 << ": " << bsl::setw(9)
+                 << static_cast<int>(NUM_RECORDS / elapsed) << " records/s"
+                 << ", publish p50 = "
+                 << latencies[latencies.size() / 2] << " ns"
+                 << ", p99 = "
+                 << latencies[latencies.size() * 99 / 100] << " ns"
+                 << endl;
+        }
+      } break;
       default: {
         cerr << "WARNING: CASE `" << test << "' NOT FOUND." << endl;
         testStatus = -1;
@@ -50,6 +50,22 @@ BSLS_IDENT_RCSID(ball_attributecontext_cpp,"$Id$ $CSID$")
 // lock would need to be held (until the message was actually written to the
 // log).
 //
+// Cached evaluations are invalidated selectively when attributes are added or
+// removed (see {Rule Evaluation Cache} in the component documentation).  The
+// invariant maintained by 'AttributeContext_RuleEvaluationCache' is that
+// 'd_resultMask' is a subset of 'd_evalMask': a rule whose bit is set in
+// 'd_evalMask' has been evaluated for the current attributes, and its bit in
+// 'd_resultMask' holds the result.  'invalidateInactiveRules' keeps only the
+// evaluated rules that are active, and 'invalidateActiveRules' keeps only the
+// evaluated rules that are inactive, both of which preserve the invariant.
+//
+// 'update' evaluates the rules in bulk: each distinct predicate indexed by the
+// rule set, that is held by some rule still to be evaluated and not yet known
+// to be unsatisfied, is tested against the attribute container list once, and
+// the masks of the rules holding the unsatisfied predicates are accumulated.
+// A rule to be evaluated is then active if its bit is not set in the
+// accumulated mask (which includes the rules having no predicates).
+//
 ///'initialize' and 'reset'
 ///------------------------
 // Although there is no lock in the implementation of this component, the
@@ -83,18 +99,36 @@ AttributeContext_RuleEvaluationCache::update(
 
     RuleSet::MaskType needEvaluations = ~d_evalMask & relevantRulesMask;
 
+    if (!needEvaluations) {
+        return d_resultMask;                                          // RETURN
+    }
+
+    // Test each distinct predicate held by a rule to evaluate, unless each
+    // such rule is already known to be inactive.
+
+    RuleSet::MaskType unsatisfied = 0;
+
+    const int numPredicates = rules.numDistinctPredicates();
+    for (int j = 0; j < numPredicates; ++j) {
+        const RuleSet::MaskType dependents =
+                 rules.predicateRuleMask(j) & needEvaluations & ~unsatisfied;
+
+        if (dependents
+         && !attributes.hasValue(rules.distinctPredicate(j).attribute())) {
+            unsatisfied |= dependents;
+        }
+    }
+
     int i;
 
     // Get the index, 'i', of each relevant rule to evaluate.
     while ((i = bdlb::BitUtil::numTrailingUnsetBits(needEvaluations))
                                                  != RuleSet::e_MAX_NUM_RULES) {
-        const Rule *rule;
-
         // 'rules.getRuleById(i)' will return null if rule 'i' has been removed
         // from the category manager's rule set.
 
-        if ((rule = rules.getRuleById(i))) {
-            RuleSet::MaskType result = rule->evaluate(attributes) ? 1 : 0;
+        if (rules.getRuleById(i)) {
+            RuleSet::MaskType result = (unsatisfied >> i) & 1 ? 0 : 1;
             d_resultMask |= result << i;  // OR in result of evaluation.
             d_evalMask   |=      1 << i;  // Mark rule as evaluated.
         }
@@ -67,6 +67,29 @@ BSLS_IDENT("$Id: $")
 // category, factoring in any active rules that apply to the category that
 // might override the category's thresholds.
 //
+///Rule Evaluation Cache
+///---------------------
+// The results of evaluating the rules for the attributes of a thread are
+// cached by the thread's 'ball::AttributeContext', so that the threshold
+// levels of a category can be determined repeatedly without re-evaluating the
+// predicates of its relevant rules.  Because a rule is active if and only if
+// *each* of its predicates is satisfied by *some* attribute held by the
+// context, adding attributes to a context can only activate rules, and
+// removing attributes can only deactivate rules.  Therefore, 'addAttributes'
+// discards only the cached evaluations of the rules found to be inactive, and
+// 'removeAttributes' discards only those of the rules found to be active; the
+// other cached evaluations remain valid.  This is particularly effective for
+// the typical use of scoped attributes (see 'ball_scopedattributes'), in which
+// attributes are added and removed around short units of work for which the
+// thresholds of many categories are checked.
+//
+// When rules are evaluated, each distinct predicate of the relevant rules is
+// tested against the attributes of the context at most once, using the
+// predicate index maintained by 'ball::RuleSet' (see {'ball_ruleset'|Predicate
+// Index}), rather than once per rule holding it.  A change to the set of rules
+// (indicated by a change in the rule set sequence number of the category
+// manager) discards all cached evaluations.
+//
 ///Usage
 ///-----
 // This section illustrates the intended use of 'ball::AttributeContext'.
@@ -337,8 +360,12 @@ class AttributeContext_RuleEvaluationCache {
     // a bit mask) have already been evaluated.  A context accesses the current
     // cache of rule evaluations using the 'knownActiveRules' method.  Finally,
     // a context updates the cache of rule evaluations using the 'update'
-    // method.  Note that the 'isDataAvailable' method should be used prior to
-    // using 'knownActiveRules' in order to ensure the relevant rules have been
+    // method.  When attributes are added to or removed from the collection
+    // for which the rules are evaluated, a context discards the cached
+    // evaluations that may have changed using the 'invalidateInactiveRules'
+    // and 'invalidateActiveRules' methods, respectively.  Note that the
+    // 'isDataAvailable' method should be used prior to using
+    // 'knownActiveRules' in order to ensure the relevant rules have been
     // evaluated and that those evaluations are up-to-date.
 
     // DATA
@@ -353,7 +380,8 @@ class AttributeContext_RuleEvaluationCache {
                                           // the result of the most recent
                                           // evaluation of the corresponding
                                           // rule (1 if the rule is active and
-                                          // 0 otherwise)
+                                          // 0 otherwise); a subset of
+                                          // 'd_evalMask'
 
     bsls::Types::Int64 d_sequenceNumber;  // sequence number used to determine
                                           // if this cache is in sync with the
@@ -383,6 +411,20 @@ class AttributeContext_RuleEvaluationCache {
         // Clear any currently cached rule evaluation data, restoring this
         // object to its default constructed state (empty).
 
+    void invalidateActiveRules();
+        // Discard the cached evaluations of the rules known to be active,
+        // retaining those of the rules known to be inactive.  Note that this
+        // method should be called when attributes are removed from the
+        // collection of attributes for which the rules are evaluated, as
+        // doing so cannot activate a rule.
+
+    void invalidateInactiveRules();
+        // Discard the cached evaluations of the rules known to be inactive,
+        // retaining those of the rules known to be active.  Note that this
+        // method should be called when attributes are added to the collection
+        // of attributes for which the rules are evaluated, as doing so cannot
+        // deactivate a rule.
+
     RuleSet::MaskType update(bsls::Types::Int64            sequenceNumber,
                              RuleSet::MaskType             relevantRulesMask,
                              const RuleSet&                rules,
@@ -399,9 +441,11 @@ class AttributeContext_RuleEvaluationCache {
         // 'relevantRulesMask' *will* be evaluated.  A particular rule is
         // considered "active" if all of its predicates are satisfied by
         // 'attributes' (i.e., if 'Rule::evaluate' returns 'true' for
-        // 'attributes').  The behavior is undefined unless 'rules' is not
-        // modified during this operation (i.e., any lock associated with
-        // 'rules' must be locked during this operation).
+        // 'attributes').  Each distinct predicate of the rules to be
+        // evaluated is tested against 'attributes' at most once (see
+        // 'RuleSet::predicateRuleMask').  The behavior is undefined unless
+        // 'rules' is not modified during this operation (i.e., any lock
+        // associated with 'rules' must be locked during this operation).
 
     // ACCESSORS
     bool isDataAvailable(bsls::Types::Int64 sequenceNumber,
@@ -574,12 +618,13 @@ class AttributeContext {
     // MANIPULATORS
     iterator addAttributes(const AttributeContainer *attributes);
         // Add the specified 'attributes' to the list of attribute containers
-        // maintained by this object.  The behavior is undefined unless
-        // 'attributes' remains valid *and* *unmodified* until either
-        // 'attributes' is removed from this context, 'clearCache' is called,
-        // or this object is destroyed.  Note that this method can be invoked
-        // safely even if the 'initialize' class method has not yet been
-        // called.
+        // maintained by this object, discarding the cached evaluations of the
+        // rules that were inactive (see {Rule Evaluation Cache}).  The
+        // behavior is undefined unless 'attributes' remains valid *and*
+        // *unmodified* until either 'attributes' is removed from this context,
+        // 'clearCache' is called, or this object is destroyed.  Note that this
+        // method can be invoked safely even if the 'initialize' class method
+        // has not yet been called.
 
     void clearCache();
         // Clear this object's cache of evaluated rules.  Note that this method
@@ -588,9 +633,10 @@ class AttributeContext {
 
     void removeAttributes(iterator element);
         // Remove the specified 'element' from the list of attribute containers
-        // maintained by this object.  Note that this method can be invoked
-        // safely even if the 'initialize' class method has not yet been
-        // called.
+        // maintained by this object, discarding the cached evaluations of the
+        // rules that were active (see {Rule Evaluation Cache}).  Note that
+        // this method can be invoked safely even if the 'initialize' class
+        // method has not yet been called.
 
     // ACCESSORS
     bool hasRelevantActiveRules(const Category *category) const;
@@ -713,6 +759,19 @@ void AttributeContext_RuleEvaluationCache::clear()
     d_sequenceNumber = -1;
 }
 
+inline
+void AttributeContext_RuleEvaluationCache::invalidateActiveRules()
+{
+    d_evalMask   &= ~d_resultMask;
+    d_resultMask  =  0;
+}
+
+inline
+void AttributeContext_RuleEvaluationCache::invalidateInactiveRules()
+{
+    d_evalMask &= d_resultMask;
+}
+
 // ACCESSORS
 inline
 bool AttributeContext_RuleEvaluationCache::isDataAvailable(
@@ -741,7 +800,7 @@ AttributeContext::addAttributes(const AttributeContainer *attributes)
 {
     BSLS_ASSERT(attributes);
 
-    d_ruleCache_p.clear();
+    d_ruleCache_p.invalidateInactiveRules();
     return d_containerList.pushFront(attributes);
 }
 
@@ -754,7 +813,7 @@ void AttributeContext::clearCache()
 inline
 void AttributeContext::removeAttributes(iterator element)
 {
-    d_ruleCache_p.clear();
+    d_ruleCache_p.invalidateActiveRules();
     d_containerList.remove(element);
 }
 
@@ -33,8 +33,10 @@
 #include <bsls_objectbuffer.h>
 #include <bsls_platform.h>
 #include <bsls_review.h>
+#include <bsls_stopwatch.h>
 
 #include <bsl_cstddef.h>
+#include <bsl_cstdio.h>
 #include <bsl_cstdlib.h>
 #include <bsl_cstring.h>
 #include <bsl_iostream.h>
@@ -68,6 +70,8 @@ using namespace bsl;
 // [ 2] static AttributeContext *lookupContext();
 // [ 3] iterator addAttributes(const AttributeContainer *attributes);
 // [ 4] void clearCache();
+// [10] iterator addAttributes(const AttributeContainer *attributes);
+// [10] void removeAttributes(iterator element);
 // [ 3] void removeAttributes(iterator element);
 // [ 4] bool hasRelevantActiveRules(const Cat *cat) const;
 // [ 4] void determineThresholdLevels(TL *lvls, const Cat *cat) const;
@@ -85,6 +89,8 @@ using namespace bsl;
 // [ 7] (OLD) USAGE EXAMPLE
 // [ 8] USAGE EXAMPLE 1
 // [ 9] USAGE EXAMPLE 2
+// [10] CONCERN: Cached evaluations survive attribute changes.
+// [-1] PERFORMANCE: THRESHOLD CHECKS WITH SCOPED ATTRIBUTES
 
 //=============================================================================
 //                      STANDARD BDE ASSERT TEST MACRO
@@ -688,6 +694,51 @@ extern "C" void *oldUsageExample(void *args)
 
 }  // close namespace BALL_ATTRIBUTECONTEXT_USAGE_EXAMPLE_OLD
 
+//=============================================================================
+//                         CASE 10 RELATED ENTITIES
+//-----------------------------------------------------------------------------
+
+namespace BALL_ATTRIBUTECONTEXT_TEST_CASE_10 {
+
+enum {
+    k_NUM_RULES     = ball::RuleSet::e_MAX_NUM_RULES,  // one rule per bit
+    k_NUM_VALUES    = 6,                               // "uuid" values
+    k_MAX_DEPTH     = 8,                               // attribute sets
+    k_NUM_ITERATION = 4000                             // random steps
+};
+
+void ruleName(char *buffer, int index)
+    // Load into the specified 'buffer' the name of the category to which only
+    // the rule having the specified 'index' is relevant.
+{
+    bsl::sprintf(buffer, "R%02d", index);
+}
+
+ball::Rule makeRule(int index)
+    // Return the rule having the specified 'index', which is relevant only to
+    // the category named by 'ruleName', has threshold levels '100 + index',
+    // and holds the predicate '("uuid", j)' for each bit 'j' set in 'index'.
+{
+    char name[8];
+    ruleName(name, index);
+    bsl::strcat(name, "*");
+
+    ball::Rule rule(name,
+                    100 + index,
+                    100 + index,
+                    100 + index,
+                    100 + index);
+
+    for (int j = 0; j < k_NUM_VALUES; ++j) {
+        if (index & (1 << j)) {
+            rule.addPredicate(ball::Predicate("uuid", j));
+        }
+    }
+    return rule;
+}
+
+}  // close namespace BALL_ATTRIBUTECONTEXT_TEST_CASE_10
+
 //=============================================================================
 //                         CASE 4 RELATED ENTITIES
 //-----------------------------------------------------------------------------
@@ -1320,6 +1371,131 @@ int main(int argc, char *argv[])
     bslma::Default::setGlobalAllocator(&globalAllocator);
 
     switch (test) { case 0:  // Zero is always the leading case.
+      case 10: {
+        // --------------------------------------------------------------------
+        // CONCERN: CACHED EVALUATIONS SURVIVE ADDING AND REMOVING ATTRIBUTES
+        //
+        // Concerns:
+        //: 1 After 'addAttributes', 'hasRelevantActiveRules' and
+        //:   'determineThresholdLevels' reflect each rule that the added
+        //:   attributes activate, while the rules that were active remain
+        //:   active.
+        //:
+        //: 2 After 'removeAttributes', these methods reflect each rule that
+        //:   the removal deactivates, while the rules that were inactive
+        //:   remain inactive.
+        //:
+        //: 3 Rules evaluated and cached only for some categories (i.e., a
+        //:   partially populated cache) are handled correctly.
+        //:
+        //: 4 Adding or removing rules discards the cached evaluations.
+        //
+        // Plan:
+        //: 1 Install one rule per bit of 'RuleSet::MaskType', each relevant to
+        //:   a single category, and holding predicates, shared between rules,
+        //:   on a small set of attribute values.
+        //:
+        //: 2 Perform a long random sequence of additions and removals of
+        //:   attribute sets to the context.  After each step, query a random
+        //:   subset of the categories, and compare the result of
+        //:   'hasRelevantActiveRules' and 'determineThresholdLevels' with the
+        //:   result of 'Rule::evaluate' for the container list of the context.
+        //:   (C-1..3)
+        //:
+        //: 3 Periodically remove and re-add a rule during the sequence, and
+        //:   verify the results as in P-2.  (C-4)
+        //
+        // Testing:
+        //   iterator addAttributes(const AttributeContainer *attributes);
+        //   void removeAttributes(iterator element);
+        //   CONCERN: Cached evaluations survive attribute changes.
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "CONCERN: CACHED EVALUATIONS SURVIVE ADDING AND "
+                             "REMOVING ATTRIBUTES" << endl
+                          << "==============================================="
+                             "===================" << endl;
+
+        using namespace BALL_ATTRIBUTECONTEXT_TEST_CASE_10;
+
+        CatMngr manager;
+        Obj::initialize(&manager);
+
+        const ball::Category *categories[k_NUM_RULES];
+        for (int i = 0; i < k_NUM_RULES; ++i) {
+            char name[8];
+            ruleName(name, i);
+            categories[i] = manager.addCategory(name, 64, 64, 64, 64);
+            ASSERTV(i, categories[i]);
+            ASSERTV(i, 0 <= manager.addRule(makeRule(i)));
+        }
+
+        Obj *context = Obj::getContext();
+
+        AttributeSet  sets[k_MAX_DEPTH];
+        int           values[k_MAX_DEPTH];
+        Obj::iterator iterators[k_MAX_DEPTH];
+        int           depth = 0;
+
+        unsigned int seed    = 0;
+        int          removed = -1;  // index of the removed rule, if any
+
+        for (int n = 0; n < k_NUM_ITERATION; ++n) {
+            const int action = rand_r(&seed) % 4;
+
+            if (0 == n % 500) {
+                // Remove or re-add a rule.
+
+                if (0 > removed) {
+                    removed = rand_r(&seed) % k_NUM_RULES;
+                    ASSERTV(n, 1 == manager.removeRule(makeRule(removed)));
+                }
+                else {
+                    ASSERTV(n, 0 <= manager.addRule(makeRule(removed)));
+                    removed = -1;
+                }
+            }
+            else if ((action < 2 || 0 == depth) && depth < k_MAX_DEPTH) {
+                values[depth] = rand_r(&seed) % k_NUM_VALUES;
+                sets[depth].insert(ball::Attribute("uuid", values[depth]));
+                iterators[depth] = context->addAttributes(&sets[depth]);
+                ++depth;
+            }
+            else {
+                --depth;
+                context->removeAttributes(iterators[depth]);
+                sets[depth].remove(ball::Attribute("uuid", values[depth]));
+            }
+
+            const int numQueries = rand_r(&seed) % k_NUM_RULES;
+            for (int q = 0; q < numQueries; ++q) {
+                const int   i    = rand_r(&seed) % k_NUM_RULES;
+                const bool  EXP  = i != removed
+                                && makeRule(i).evaluate(context->containers());
+                const int   EXPL = EXP ? 100 + i : 64;
+
+                ASSERTV(n, i, depth, EXP,
+                        EXP == context->hasRelevantActiveRules(categories[i]));
+
+                ball::ThresholdAggregate levels(0, 0, 0, 0);
+                context->determineThresholdLevels(&levels, categories[i]);
+                ASSERTV(n, i, depth, EXPL, levels.passLevel(),
+                        EXPL == levels.passLevel());
+            }
+        }
+
+        while (depth) {
+            --depth;
+            context->removeAttributes(iterators[depth]);
+        }
+        for (int i = 0; i < k_NUM_RULES; ++i) {
+            ASSERTV(i, (0 == i && 0 != removed) ==
+                             context->hasRelevantActiveRules(categories[i]));
+        }
+
+        ball::AttributeContextProctor proctor;  // destroys context
+      } break;
       case 9: {
         // --------------------------------------------------------------------
         // TESTING USAGE EXAMPLE 2
@@ -2113,6 +2289,128 @@ int main(int argc, char *argv[])
         ASSERT(0 == defaultAllocator.numBytesInUse());
 
       } break;
+      case -1: {
+        // --------------------------------------------------------------------
+        // PERFORMANCE: THRESHOLD CHECKS WITH SCOPED ATTRIBUTES
+        //
+        // Concerns:
+        //: 1 Adding and removing attributes around a unit of work does not
+        //:   require re-evaluating every rule for each threshold check.
+        //:
+        //: 2 Evaluating rules sharing predicates tests each predicate once.
+        //
+        // Plan:
+        //: 1 Install the maximum number of rules, each relevant to every
+        //:   category and holding two predicates drawn from a small set of
+        //:   attribute values.
+        //:
+        //: 2 Time a loop that adds an attribute set, determines the threshold
+        //:   levels of each of several categories (as is done to decide
+        //:   whether a message is enabled), and removes the attribute set.
+        //:   Report the average time per unit of work, and per check.  (C-1)
+        //:
+        //: 3 Time the same threshold checks without attributes being added
+        //:   or removed (i.e., entirely cached), and the evaluation of every
+        //:   rule using 'Rule::evaluate' (i.e., without the predicate index)
+        //:   for reference.  (C-2)
+        //
+        // Testing:
+        //   PERFORMANCE: THRESHOLD CHECKS WITH SCOPED ATTRIBUTES
+        // --------------------------------------------------------------------
+
+        cout << "PERFORMANCE: THRESHOLD CHECKS WITH SCOPED ATTRIBUTES\n"
+                "====================================================\n";
+
+        enum { k_NUM_CATEGORIES = 16, k_NUM_UUIDS = 8 };
+
+        const int NUM_ITERATIONS = argc > 2 ? bsl::atoi(argv[2])
+                                            : 1000 * 1000;
+
+        CatMngr manager;
+        Obj::initialize(&manager);
+
+        const ball::Category *categories[k_NUM_CATEGORIES];
+        for (int i = 0; i < k_NUM_CATEGORIES; ++i) {
+            char name[16];
+            bsl::sprintf(name, "PERF.%02d", i);
+            categories[i] = manager.addCategory(name, 64, 64, 64, 64);
+        }
+
+        for (int i = 0; i < ball::RuleSet::e_MAX_NUM_RULES; ++i) {
+            ball::Rule rule("PERF.*", 100, 100, 100, 100);
+            rule.addPredicate(ball::Predicate("uuid", i % k_NUM_UUIDS));
+            rule.addPredicate(ball::Predicate("service",
+                                              i / k_NUM_UUIDS));
+            manager.addRule(rule);
+        }
+
+        Obj *context = Obj::getContext();
+
+        AttributeSet request;
+        request.insert(ball::Attribute("uuid", k_NUM_UUIDS));    // no match
+        request.insert(ball::Attribute("service", 1));
+
+        AttributeSet session;
+        session.insert(ball::Attribute("user", "nobody"));
+        Obj::iterator sessionIt = context->addAttributes(&session);
+
+        ball::ThresholdAggregate levels(0, 0, 0, 0);
+        int                      numEnabled = 0;
+
+        bsls::Stopwatch timer;
+
+        timer.start();
+        for (int n = 0; n < NUM_ITERATIONS; ++n) {
+            Obj::iterator it = context->addAttributes(&request);
+            for (int i = 0; i < k_NUM_CATEGORIES; ++i) {
+                context->determineThresholdLevels(&levels, categories[i]);
+                numEnabled += levels.passLevel() >= 100;
+            }
+            context->removeAttributes(it);
+        }
+        timer.stop();
+        cout << "Add, " << k_NUM_CATEGORIES << " checks, remove: "
+             << timer.elapsedTime() * 1e9 / NUM_ITERATIONS << " ns ("
+             << timer.elapsedTime() * 1e9 / NUM_ITERATIONS / k_NUM_CATEGORIES
+             << " ns/check)" << endl;
+
+        Obj::iterator it = context->addAttributes(&request);
+
+        timer.reset();
+        timer.start();
+        for (int n = 0; n < NUM_ITERATIONS; ++n) {
+            for (int i = 0; i < k_NUM_CATEGORIES; ++i) {
+                context->determineThresholdLevels(&levels, categories[i]);
+                numEnabled += levels.passLevel() >= 100;
+            }
+        }
+        timer.stop();
+        cout << "Cached checks:                "
+             << timer.elapsedTime() * 1e9 / NUM_ITERATIONS / k_NUM_CATEGORIES
+             << " ns/check" << endl;
+
+        const ball::RuleSet& rules = manager.ruleSet();
+
+        timer.reset();
+        timer.start();
+        for (int n = 0; n < NUM_ITERATIONS; ++n) {
+            for (int i = 0; i < ball::RuleSet::e_MAX_NUM_RULES; ++i) {
+                numEnabled += rules.getRuleById(i)->evaluate(
+                                                        context->containers());
+            }
+        }
+        timer.stop();
+        cout << "'Rule::evaluate' of each rule: "
+             << timer.elapsedTime() * 1e9 / NUM_ITERATIONS
+             << " ns/evaluation of all rules" << endl;
+
+        context->removeAttributes(it);
+        context->removeAttributes(sessionIt);
+
+        if (veryVerbose) { P(numEnabled) }
+
+        ball::AttributeContextProctor proctor;  // destroys context
+      } break;
       default: {
         cerr << "WARNING: CASE `" << test << "' NOT FOUND." << endl;
         testStatus = -1;
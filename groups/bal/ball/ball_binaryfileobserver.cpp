@@ -0,0 +1,60 @@
+// ball_binaryfileobserver.cpp                                        -*-C++-*-
+#include <ball_binaryfileobserver.h>
+
+#include <bsls_ident.h>
+BSLS_IDENT_RCSID(ball_binaryfileobserver_cpp,"$Id$ $CSID$")
+
+#include <ball_binaryrecordutil.h>
+#include <ball_context.h>
+#include <ball_record.h>
+
+#include <bsl_ostream.h>
+
+namespace BloombergLP {
+namespace ball {
+
+namespace {
+
+void writeBinaryRecord(bsl::ostream& stream, const Record& record)
+    // Write the specified 'record' to the specified 'stream' in the format
+    // defined by 'ball_binaryrecordutil', and flush 'stream'.
+{
+    BinaryRecordUtil::write(stream, record);
+    stream.flush();
+}
+
+}  // close unnamed namespace
+
+                          // ------------------------
+                          // class BinaryFileObserver
+                          // ------------------------
+
+// CREATORS
+BinaryFileObserver::BinaryFileObserver(bslma::Allocator *basicAllocator)
+: d_fileObserver2(basicAllocator)
+{
+    d_fileObserver2.setLogFileFunctor(&writeBinaryRecord);
+}
+
+BinaryFileObserver::~BinaryFileObserver()
+{
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+// ----------------------------------------------------------------------------
+// Copyright 2020 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,449 @@
+// ball_binaryfileobserver.h                                          -*-C++-*-
+#ifndef INCLUDED_BALL_BINARYFILEOBSERVER
+#define INCLUDED_BALL_BINARYFILEOBSERVER
+
+#include <bsls_ident.h>
+BSLS_IDENT("$Id: $")
+
+//@PURPOSE: Provide a thread-safe observer that logs binary records to a file.
+//
+//@CLASSES:
+//  ball::BinaryFileObserver: observer that writes binary log records to a file
+//
+//@SEE_ALSO: ball_binaryrecordutil, ball_fileobserver2, ball_observer
+//
+//@DESCRIPTION: This component provides a concrete implementation of the
+// 'ball::Observer' protocol, 'ball::BinaryFileObserver', for publishing log
+// records to a user-specified file in the compact binary format defined by
+// 'ball_binaryrecordutil'.  The following inheritance hierarchy diagram shows
+// the classes involved and their methods:
+//..
+//             ,------------------------.
+//            ( ball::BinaryFileObserver )
+//             `------------------------'
+//                         |              ctor
+//                         |              disableFileLogging
+//                         |              disablePublishInLocalTime
+//                         |              disableSizeRotation
+//                         |              disableTimeIntervalRotation
+//                         |              enableFileLogging
+//                         |              enablePublishInLocalTime
+//                         |              forceRotation
+//                         |              rotateOnSize
+//                         |              rotateOnTimeInterval
+//                         |              setOnFileRotationCallback
+//                         |              isFileLoggingEnabled
+//                         |              isPublishInLocalTimeEnabled
+//                         |              rotationLifetime
+//                         |              rotationSize
+//                         V
+//                  ,--------------.
+//                 ( ball::Observer )
+//                  `--------------'
+//                                        dtor
+//                                        publish
+//                                        releaseRecords
+//..
+// A 'ball::BinaryFileObserver' writes each record that it receives through its
+// 'publish' method to its log file as a single binary frame, holding the fixed
+// fields of the record and all of its user-defined fields.  No text
+// formatting is performed on the publishing thread: timestamps, integers, and
+// the severity are copied verbatim rather than converted to text, which makes
+// publishing a record considerably cheaper than with 'ball::FileObserver'.
+// The binary log files are rendered as text later, when (and if) they need to
+// be read (see {Reading Binary Log Files} below).
+//
+// 'ball::BinaryFileObserver' is implemented in terms of 'ball::FileObserver2',
+// and supports the same log filename patterns (see
+// {'ball_fileobserver2'|Log Filename Patterns}) and the same log file rotation
+// rules (see {'ball_fileobserver2'|Log File Rotation}).  Because each frame is
+// self-delimiting and a binary log file has no header, rotated files (and
+// files truncated by an abnormal program termination) remain independently
+// decodable.  Each record is flushed to the log file before 'publish' returns,
+// as is the case for 'ball::FileObserver2'.
+//
+///Log Record Timestamps
+///---------------------
+// Record timestamps are always written to the log file in UTC time.  Whether
+// they are displayed in local time is decided when the log file is rendered
+// (see 'ball::RecordStringFormatter::enablePublishInLocalTime').  The
+// 'enablePublishInLocalTime' and 'disablePublishInLocalTime' methods of this
+// observer affect only the timestamps that are substituted into log filenames
+// (see {'ball_fileobserver2'|Log Filename Patterns}) and the reference time of
+// time-based rotation.
+//
+///Reading Binary Log Files
+///------------------------
+// 'ball::BinaryRecordUtil::renderFile' renders a binary log file as text,
+// using a 'ball::RecordStringFormatter' and therefore any of the format
+// specifications that can be supplied to 'ball::FileObserver::setLogFormat'.
+// 'ball::BinaryRecordUtil::decode' may be used to process the records of a
+// binary log file programmatically.
+//
+///Thread Safety
+///-------------
+// All methods of 'ball::BinaryFileObserver' are thread-safe, and can be called
+// concurrently by multiple threads.
+//
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Publishing and Rendering a Binary Log
+/// - - - - - - - - - - - - - - - - - - - - - - - -
+// First, we create a binary file observer and enable logging to a file:
+//..
+//  ball::BinaryFileObserver observer;
+//  int rc = observer.enableFileLogging(fileName.c_str());
+//  assert(0 == rc);
+//..
+// Then, we publish a record to the observer (typically the logger manager
+// does this on our behalf):
+//..
+//  ball::Record record;
+//  record.fixedFields().setTimestamp(bdlt::Datetime(2020, 6, 1, 12, 30));
+//  record.fixedFields().setProcessID(1234);
+//  record.fixedFields().setThreadID(5);
+//  record.fixedFields().setSeverity(ball::Severity::e_ERROR);
+//  record.fixedFields().setFileName("server.cpp");
+//  record.fixedFields().setLineNumber(42);
+//  record.fixedFields().setCategory("SERVER");
+//  record.fixedFields().setMessage("connection lost");
+//
+//  observer.publish(record, ball::Context());
+//  observer.disableFileLogging();
+//..
+// Finally, at a later time (possibly in a different process), we render the
+// log file as text:
+//..
+//  ball::RecordStringFormatter formatter("%d %s %f:%l %c %m\n");
+//  bsl::ostringstream          output;
+//
+//  rc = ball::BinaryRecordUtil::renderFile(output,
+//                                          fileName.c_str(),
+//                                          formatter);
+//  assert(0 == rc);
+//  assert("01JUN2020_12:30:00.000 ERROR server.cpp:42 SERVER "
+//         "connection lost\n" == output.str());
+//..
+
+#include <balscm_version.h>
+
+#include <ball_fileobserver2.h>
+#include <ball_observer.h>
+
+#include <bdlt_datetime.h>
+#include <bdlt_datetimeinterval.h>
+
+#include <bslma_allocator.h>
+#include <bslma_usesbslmaallocator.h>
+
+#include <bslmf_nestedtraitdeclaration.h>
+
+#include <bsl_memory.h>
+#include <bsl_string.h>
+
+namespace BloombergLP {
+namespace ball {
+
+class Context;
+class Record;
+
+                          // ========================
+                          // class BinaryFileObserver
+                          // ========================
+
+class BinaryFileObserver : public Observer {
+    // This class implements the 'Observer' protocol.  The 'publish' method of
+    // this class writes the log records that it receives, in binary form, to a
+    // user-specified file.  This class is thread-safe; different threads can
+    // operate on an object concurrently.  This class is exception-neutral with
+    // no guarantee of rollback.  In no event is memory leaked.
+
+    // DATA
+    FileObserver2 d_fileObserver2;  // forward most operations to this object
+
+  private:
+    // NOT IMPLEMENTED
+    BinaryFileObserver(const BinaryFileObserver&);
+    BinaryFileObserver& operator=(const BinaryFileObserver&);
+
+  public:
+    // PUBLIC TYPES
+    typedef FileObserver2::OnFileRotationCallback OnFileRotationCallback;
+        // 'OnFileRotationCallback' is an alias for a user-supplied callback
+        // function that is invoked after the file observer attempts to rotate
+        // its log file (see 'ball::FileObserver2::OnFileRotationCallback').
+
+    // TRAITS
+    BSLMF_NESTED_TRAIT_DECLARATION(BinaryFileObserver,
+                                   bslma::UsesBslmaAllocator);
+
+    // CREATORS
+    explicit BinaryFileObserver(bslma::Allocator *basicAllocator = 0);
+        // Create a binary file observer with file logging initially disabled.
+        // Optionally specify a 'basicAllocator' used to supply memory.  If
+        // 'basicAllocator' is 0, the currently installed default allocator is
+        // used.
+
+    ~BinaryFileObserver();
+        // Close the log file of this binary file observer if file logging is
+        // enabled, and destroy this binary file observer.
+
+    // MANIPULATORS
+    void disableFileLogging();
+        // Disable file logging for this binary file observer.  This method has
+        // no effect if file logging is not enabled.
+
+    void disablePublishInLocalTime();
+        // Disable the use of local time for timestamps substituted into log
+        // filenames by this binary file observer.  Note that the timestamps
+        // of records are always written in UTC time.
+
+    void disableSizeRotation();
+        // Disable log file rotation based on log file size for this binary
+        // file observer.  This method has no effect if rotation-on-size is not
+        // enabled.
+
+    void disableTimeIntervalRotation();
+        // Disable log file rotation based on a periodic time interval for this
+        // binary file observer.  This method has no effect if
+        // rotation-on-time-interval is not enabled.
+
+    int enableFileLogging(const char *logFilenamePattern);
+        // Enable logging of all records published to this binary file
+        // observer to a file whose name is derived from the specified
+        // 'logFilenamePattern'.  Return 0 on success, a positive value if file
+        // logging is already enabled (with no effect), and a negative value
+        // otherwise.  The basename of 'logFilenamePattern' may contain '%'-
+        // escape sequences that are interpreted as described in
+        // {'ball_fileobserver2'|Log Filename Patterns}.  If the log file
+        // already exists, records are appended to it.
+
+    void enablePublishInLocalTime();
+        // Enable the use of local time for timestamps substituted into log
+        // filenames by this binary file observer.  Note that the timestamps
+        // of records are always written in UTC time.
+
+    void forceRotation();
+        // Forcefully perform a log file rotation by this binary file observer.
+        // Close the current log file, rename the log file if necessary, and
+        // open a new log file.  This method has no effect if file logging is
+        // not enabled.
+
+    void publish(const Record& record, const Context& context);
+        // Write the specified log 'record' to the log file of this binary file
+        // observer if file logging is enabled.  The specified 'context' is
+        // ignored.
+        //
+        // !DEPRECATED!: Use the alternative 'publish' overload instead.
+
+    void publish(const bsl::shared_ptr<const Record>& record,
+                 const Context&                       context);
+        // Write the specified log 'record' to the log file of this binary file
+        // observer if file logging is enabled.  The specified 'context' is
+        // ignored.
+
+    void releaseRecords();
+        // Discard any shared reference to a 'Record' object that was supplied
+        // to the 'publish' method, and is held by this observer.  Note that
+        // this operation should be called if resources underlying the
+        // previously provided shared-pointers must be released.
+
+    void rotateOnSize(int size);
+        // Set this binary file observer to perform a file rotation if the size
+        // of the file exceeds the specified 'size' (in kilobytes).  This rule
+        // replaces any rotation-on-size rule currently in effect.  The
+        // behavior is undefined unless 'size > 0'.
+
+    void rotateOnTimeInterval(const bdlt::DatetimeInterval& interval);
+    void rotateOnTimeInterval(const bdlt::DatetimeInterval& interval,
+                              const bdlt::Datetime&         startTime);
+        // Set this binary file observer to perform a periodic log file
+        // rotation at multiples of the specified 'interval'.  Optionally
+        // specify a 'startTime' indicating the *local* datetime to use as the
+        // starting point for computing the periodic rotation schedule.  If
+        // 'startTime' is not specified, the current time is used.  This rule
+        // replaces any rotation-on-time-interval rule currently in effect.
+        // The behavior is undefined unless '0 < interval.totalMilliseconds()'.
+
+    void setOnFileRotationCallback(
+                             const OnFileRotationCallback& onRotationCallback);
+        // Set the specified 'onRotationCallback' to be invoked after each time
+        // this binary file observer attempts to perform a log file rotation.
+        // The behavior is undefined if the supplied function calls either
+        // 'setOnFileRotationCallback', 'forceRotation', or 'publish' on this
+        // binary file observer (i.e., the supplied callback should *not*
+        // attempt to write to the 'ball' log).
+
+    // ACCESSORS
+    bool isFileLoggingEnabled() const;
+    bool isFileLoggingEnabled(bsl::string *result) const;
+        // Return 'true' if file logging is enabled for this binary file
+        // observer, and 'false' otherwise.  Load the optionally specified
+        // 'result' with the name of the current log file if file logging is
+        // enabled, and leave 'result' unmodified otherwise.
+
+    bool isPublishInLocalTimeEnabled() const;
+        // Return 'true' if this binary file observer uses local time for the
+        // timestamps substituted into log filenames, and 'false' otherwise.
+
+    bdlt::DatetimeInterval rotationLifetime() const;
+        // Return the lifetime of the log file that will trigger a file
+        // rotation by this binary file observer if rotation-on-lifetime is in
+        // effect, and a 0 time interval otherwise.
+
+    int rotationSize() const;
+        // Return the size (in kilobytes) of the log file that will trigger a
+        // file rotation by this binary file observer if rotation-on-size is in
+        // effect, and 0 otherwise.
+};
+
+// ============================================================================
+//                              INLINE DEFINITIONS
+// ============================================================================
+
+                          // ------------------------
+                          // class BinaryFileObserver
+                          // ------------------------
+
+// MANIPULATORS
+inline
+void BinaryFileObserver::disableFileLogging()
+{
+    d_fileObserver2.disableFileLogging();
+}
+
+inline
+void BinaryFileObserver::disablePublishInLocalTime()
+{
+    d_fileObserver2.disablePublishInLocalTime();
+}
+
+inline
+void BinaryFileObserver::disableSizeRotation()
+{
+    d_fileObserver2.disableSizeRotation();
+}
+
+inline
+void BinaryFileObserver::disableTimeIntervalRotation()
+{
+    d_fileObserver2.disableTimeIntervalRotation();
+}
+
+inline
+int BinaryFileObserver::enableFileLogging(const char *logFilenamePattern)
+{
+    return d_fileObserver2.enableFileLogging(logFilenamePattern);
+}
+
+inline
+void BinaryFileObserver::enablePublishInLocalTime()
+{
+    d_fileObserver2.enablePublishInLocalTime();
+}
+
+inline
+void BinaryFileObserver::forceRotation()
+{
+    d_fileObserver2.forceRotation();
+}
+
+inline
+void BinaryFileObserver::publish(const Record& record, const Context& context)
+{
+    d_fileObserver2.publish(record, context);
+}
+
+inline
+void BinaryFileObserver::publish(const bsl::shared_ptr<const Record>& record,
+                                 const Context&                       context)
+{
+    publish(*record, context);
+}
+
+inline
+void BinaryFileObserver::releaseRecords()
+{
+}
+
+inline
+void BinaryFileObserver::rotateOnSize(int size)
+{
+    d_fileObserver2.rotateOnSize(size);
+}
+
+inline
+void BinaryFileObserver::rotateOnTimeInterval(
+                                        const bdlt::DatetimeInterval& interval)
+{
+    d_fileObserver2.rotateOnTimeInterval(interval);
+}
+
+inline
+void BinaryFileObserver::rotateOnTimeInterval(
+                                       const bdlt::DatetimeInterval& interval,
+                                       const bdlt::Datetime&         startTime)
+{
+    d_fileObserver2.rotateOnTimeInterval(interval, startTime);
+}
+
+inline
+void BinaryFileObserver::setOnFileRotationCallback(
+                              const OnFileRotationCallback& onRotationCallback)
+{
+    d_fileObserver2.setOnFileRotationCallback(onRotationCallback);
+}
+
+// ACCESSORS
+inline
+bool BinaryFileObserver::isFileLoggingEnabled() const
+{
+    return d_fileObserver2.isFileLoggingEnabled();
+}
+
+inline
+bool BinaryFileObserver::isFileLoggingEnabled(bsl::string *result) const
+{
+    return d_fileObserver2.isFileLoggingEnabled(result);
+}
+
+inline
+bool BinaryFileObserver::isPublishInLocalTimeEnabled() const
+{
+    return d_fileObserver2.isPublishInLocalTimeEnabled();
+}
+
+inline
+bdlt::DatetimeInterval BinaryFileObserver::rotationLifetime() const
+{
+    return d_fileObserver2.rotationLifetime();
+}
+
+inline
+int BinaryFileObserver::rotationSize() const
+{
+    return d_fileObserver2.rotationSize();
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2020 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,752 @@
+// ball_binaryfileobserver.t.cpp                                      -*-C++-*-
+#include <ball_binaryfileobserver.h>
+
+#include <ball_binaryrecordutil.h>
+#include <ball_context.h>
+#include <ball_record.h>
+#include <ball_recordattributes.h>
+#include <ball_recordstringformatter.h>
+#include <ball_severity.h>
+#include <ball_userfields.h>
+
+#include <bdls_filesystemutil.h>
+#include <bdls_pathutil.h>
+
+#include <bdlt_datetime.h>
+#include <bdlt_datetimeinterval.h>
+
+#include <bslim_testutil.h>
+
+#include <bslma_default.h>
+#include <bslma_defaultallocatorguard.h>
+#include <bslma_testallocator.h>
+#include <bslma_usesbslmaallocator.h>
+
+#include <bslmf_assert.h>
+#include <bslmf_nestedtraitdeclaration.h>
+
+#include <bsls_platform.h>
+#include <bsls_review.h>
+#include <bsls_stopwatch.h>
+
+#include <bsl_cstdlib.h>
+#include <bsl_iostream.h>
+#include <bsl_memory.h>
+#include <bsl_sstream.h>
+#include <bsl_string.h>
+
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+#include <windows.h>
+#endif
+
+using namespace BloombergLP;
+using namespace bsl;
+
+// ============================================================================
+//                                   TEST PLAN
+// ----------------------------------------------------------------------------
+//                                   Overview
+//                                   --------
+// The component under test is an observer that forwards its configuration to
+// an embedded 'ball::FileObserver2' and installs a record functor that writes
+// records in binary form.  We verify that the configuration is forwarded, that
+// published records can be rendered from the log file to the same text that a
+// formatter produces for the original records, and that every file produced by
+// rotation is independently decodable.
+// ----------------------------------------------------------------------------
+// CREATORS
+// [ 1] BinaryFileObserver(bslma::Allocator *basicAllocator = 0);
+// [ 1] ~BinaryFileObserver();
+//
+// MANIPULATORS
+// [ 2] void disableFileLogging();
+// [ 2] void disablePublishInLocalTime();
+// [ 2] void disableSizeRotation();
+// [ 2] void disableTimeIntervalRotation();
+// [ 1] int enableFileLogging(const char *logFilenamePattern);
+// [ 2] void enablePublishInLocalTime();
+// [ 3] void forceRotation();
+// [ 1] void publish(const Record& record, const Context& context);
+// [ 1] void publish(const shared_ptr<const Record>&, const Context&);
+// [ 1] void releaseRecords();
+// [ 3] void rotateOnSize(int size);
+// [ 2] void rotateOnTimeInterval(const DatetimeInterval& interval);
+// [ 2] void rotateOnTimeInterval(const DtInterval&, const Datetime&);
+// [ 3] void setOnFileRotationCallback(const OnFileRotationCallback&);
+//
+// ACCESSORS
+// [ 2] bool isFileLoggingEnabled() const;
+// [ 2] bool isFileLoggingEnabled(bsl::string *result) const;
+// [ 2] bool isPublishInLocalTimeEnabled() const;
+// [ 2] bdlt::DatetimeInterval rotationLifetime() const;
+// [ 2] int rotationSize() const;
+// ----------------------------------------------------------------------------
+// [ 4] USAGE EXAMPLE
+// [-1] PERFORMANCE: 'BinaryFileObserver' VS. 'FileObserver2'
+
+// ============================================================================
+//                     STANDARD BDE ASSERT TEST FUNCTION
+// ----------------------------------------------------------------------------
+
+namespace {
+
+int testStatus = 0;
+
+void aSsErT(bool condition, const char *message, int line)
+{
+    if (condition) {
+        cout << "Error " __FILE__ "(" << line << "): " << message
+             << "    (failed)" << endl;
+
+        if (0 <= testStatus && testStatus <= 100) {
+            ++testStatus;
+        }
+    }
+}
+
+}  // close unnamed namespace
+
+// ============================================================================
+//               STANDARD BDE TEST DRIVER MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT       BSLIM_TESTUTIL_ASSERT
+#define ASSERTV      BSLIM_TESTUTIL_ASSERTV
+
+#define LOOP_ASSERT  BSLIM_TESTUTIL_LOOP_ASSERT
+#define LOOP0_ASSERT BSLIM_TESTUTIL_LOOP0_ASSERT
+#define LOOP1_ASSERT BSLIM_TESTUTIL_LOOP1_ASSERT
+#define LOOP2_ASSERT BSLIM_TESTUTIL_LOOP2_ASSERT
+#define LOOP3_ASSERT BSLIM_TESTUTIL_LOOP3_ASSERT
+#define LOOP4_ASSERT BSLIM_TESTUTIL_LOOP4_ASSERT
+#define LOOP5_ASSERT BSLIM_TESTUTIL_LOOP5_ASSERT
+#define LOOP6_ASSERT BSLIM_TESTUTIL_LOOP6_ASSERT
+
+#define Q            BSLIM_TESTUTIL_Q   // Quote identifier literally.
+#define P            BSLIM_TESTUTIL_P   // Print identifier and value.
+#define P_           BSLIM_TESTUTIL_P_  // P(X) without '\n'.
+#define T_           BSLIM_TESTUTIL_T_  // Print a tab (w/o newline).
+#define L_           BSLIM_TESTUTIL_L_  // current Line number
+
+//=============================================================================
+//                  GLOBAL TYPEDEFS/CONSTANTS FOR TESTING
+//-----------------------------------------------------------------------------
+
+typedef ball::BinaryFileObserver Obj;
+typedef ball::BinaryRecordUtil   Util;
+
+static const char *const FORMAT = "\n%d %p:%t %s %f:%l %c %m %u\n";
+
+// ============================================================================
+//                                 TYPE TRAITS
+// ----------------------------------------------------------------------------
+
+BSLMF_ASSERT(true == bslma::UsesBslmaAllocator<Obj>::value);
+
+//=============================================================================
+//                      HELPER FUNCTIONS FOR TESTING
+//-----------------------------------------------------------------------------
+
+namespace {
+
+class TempDirectoryGuard {
+    // This class implements a scoped temporary directory guard.  The guard
+    // tries to create a temporary directory in the system-wide temp directory
+    // and falls back to the current directory.
+
+    // DATA
+    bsl::string       d_dirName;      // path to the created directory
+    bslma::Allocator *d_allocator_p;  // memory allocator (held, not owned)
+
+  private:
+    // NOT IMPLEMENTED
+    TempDirectoryGuard(const TempDirectoryGuard&);
+    TempDirectoryGuard& operator=(const TempDirectoryGuard&);
+
+  public:
+    // TRAITS
+    BSLMF_NESTED_TRAIT_DECLARATION(TempDirectoryGuard,
+                                   bslma::UsesBslmaAllocator);
+
+    // CREATORS
+    explicit TempDirectoryGuard(bslma::Allocator *basicAllocator = 0)
+        // Create temporary directory in the system-wide temp or current
+        // directory.  Optionally specify a 'basicAllocator' used to supply
+        // memory.  If 'basicAllocator' is 0, the currently installed default
+        // allocator is used.
+    : d_dirName(bslma::Default::allocator(basicAllocator))
+    , d_allocator_p(bslma::Default::allocator(basicAllocator))
+    {
+        bsl::string tmpPath(d_allocator_p);
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+        char tmpPathBuf[MAX_PATH];
+        GetTempPath(MAX_PATH, tmpPathBuf);
+        tmpPath.assign(tmpPathBuf);
+#else
+        const char *envTmpPath = bsl::getenv("TMPDIR");
+        if (envTmpPath) {
+            tmpPath.assign(envTmpPath);
+        }
+#endif
+
+        int res = bdls::PathUtil::appendIfValid(&tmpPath, "ball_");
+        ASSERTV(tmpPath, 0 == res);
+
+        res = bdls::FilesystemUtil::createTemporaryDirectory(&d_dirName,
+                                                             tmpPath);
+        ASSERTV(tmpPath, 0 == res);
+    }
+
+    ~TempDirectoryGuard()
+        // Destroy this object and remove the temporary directory (recursively)
+        // created at construction.
+    {
+        bdls::FilesystemUtil::remove(d_dirName, true);
+    }
+
+    // ACCESSORS
+    const bsl::string& getTempDirName() const
+        // Return a 'const' reference to the name of the created temporary
+        // directory.
+    {
+        return d_dirName;
+    }
+};
+
+class RenderingRotationCallback {
+    // This class implements a rotation callback that renders each rotated log
+    // file as soon as the rotation has happened, before the file can be
+    // replaced by a subsequent rotation.
+
+    // DATA
+    const ball::RecordStringFormatter *d_formatter_p;   // held, not owned
+    bsl::string                       *d_output_p;      // held, not owned
+    int                               *d_numRecords_p;  // held, not owned
+    int                               *d_numErrors_p;   // held, not owned
+
+  public:
+    // CREATORS
+    RenderingRotationCallback(const ball::RecordStringFormatter *formatter,
+                              bsl::string                       *output,
+                              int                               *numRecords,
+                              int                               *numErrors)
+        // Create a callback that appends to the specified 'output' the
+        // rendering, using the specified 'formatter', of each rotated file,
+        // adds the number of records rendered to the specified 'numRecords',
+        // and increments the specified 'numErrors' for each failed rotation
+        // or rendering.
+    : d_formatter_p(formatter)
+    , d_output_p(output)
+    , d_numRecords_p(numRecords)
+    , d_numErrors_p(numErrors)
+    {
+    }
+
+    // ACCESSORS
+    void operator()(int status, const bsl::string& rotatedFileName) const
+        // Render the log file having the specified 'rotatedFileName' if the
+        // specified 'status' is 0, and record an error otherwise.
+    {
+        if (0 != status) {
+            ++*d_numErrors_p;
+            return;                                                   // RETURN
+        }
+
+        bsl::ostringstream output;
+        int                numRecords = 0;
+
+        if (0 != Util::renderFile(output,
+                                  rotatedFileName.c_str(),
+                                  *d_formatter_p,
+                                  &numRecords)) {
+            ++*d_numErrors_p;
+        }
+        *d_output_p     += output.str();
+        *d_numRecords_p += numRecords;
+    }
+};
+
+void makeRecord(ball::Record *record, int index)
+    // Load into the specified 'record' a value that is determined by the
+    // specified 'index'.
+{
+    ball::RecordAttributes& attributes = record->fixedFields();
+
+    attributes.setTimestamp(bdlt::Datetime(2020,
+                                           1 + index % 12,
+                                           1 + index % 28,
+                                           index % 24,
+                                           index % 60,
+                                           index % 60,
+                                           index % 1000));
+    attributes.setProcessID(100);
+    attributes.setThreadID(index % 7);
+    attributes.setSeverity(ball::Severity::e_INFO);
+    attributes.setFileName("ball_binaryfileobserver.t.cpp");
+    attributes.setLineNumber(index);
+    attributes.setCategory("TEST");
+
+    bsl::ostringstream message;
+    message << "message number " << index;
+    attributes.setMessage(message.str().c_str());
+
+    record->customFields().removeAll();
+    record->customFields().appendInt64(index);
+}
+
+}  // close unnamed namespace
+
+//=============================================================================
+//                              MAIN PROGRAM
+//-----------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    const int                 test = argc > 1 ? atoi(argv[1]) : 0;
+    const bool             verbose = argc > 2;
+    const bool         veryVerbose = argc > 3;
+    const bool     veryVeryVerbose = argc > 4;
+    const bool veryVeryVeryVerbose = argc > 5;
+
+    (void)veryVerbose;
+    (void)veryVeryVerbose;
+
+    cout << "TEST " << __FILE__ << " CASE " << test << endl;
+
+    // CONCERN: 'BSLS_REVIEW' failures should lead to test failures.
+    bsls::ReviewFailureHandlerGuard reviewGuard(&bsls::Review::failByAbort);
+
+    // CONCERN: In no case does memory come from the global allocator.
+
+    bslma::TestAllocator globalAllocator("global", veryVeryVeryVerbose);
+    bslma::Default::setGlobalAllocator(&globalAllocator);
+
+    switch (test) { case 0:
+      case 4: {
+        // --------------------------------------------------------------------
+        // USAGE EXAMPLE
+        //   Extracted from component header file.
+        //
+        // Concerns:
+        //: 1 The usage example provided in the component header file compiles,
+        //:   links, and runs as shown.
+        //
+        // Plan:
+        //: 1 Incorporate usage example from header into test driver, remove
+        //:   leading comment characters, and replace 'assert' with 'ASSERT'.
+        //:   (C-1)
+        //
+        // Testing:
+        //   USAGE EXAMPLE
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "USAGE EXAMPLE" << endl
+                          << "=============" << endl;
+
+        TempDirectoryGuard tempDirGuard;
+
+        bsl::string fileName(tempDirGuard.getTempDirName());
+        bdls::PathUtil::appendRaw(&fileName, "usage.log");
+
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Publishing and Rendering a Binary Log
+/// - - - - - - - - - - - - - - - - - - - - - - - -
+// First, we create a binary file observer and enable logging to a file:
+//..
+    ball::BinaryFileObserver observer;
+    int rc = observer.enableFileLogging(fileName.c_str());
+    ASSERT(0 == rc);
+//..
+// Then, we publish a record to the observer (typically the logger manager
+// does this on our behalf):
+//..
+    ball::Record record;
+    record.fixedFields().setTimestamp(bdlt::Datetime(2020, 6, 1, 12, 30));
+    record.fixedFields().setProcessID(1234);
+    record.fixedFields().setThreadID(5);
+    record.fixedFields().setSeverity(ball::Severity::e_ERROR);
+    record.fixedFields().setFileName("server.cpp");
+    record.fixedFields().setLineNumber(42);
+    record.fixedFields().setCategory("SERVER");
+    record.fixedFields().setMessage("connection lost");
+
+    observer.publish(record, ball::Context());
+    observer.disableFileLogging();
+//..
+// Finally, at a later time (possibly in a different process), we render the
+// log file as text:
+//..
+    ball::RecordStringFormatter formatter("%d %s %f:%l %c %m\n");
+    bsl::ostringstream          output;
+
+    rc = ball::BinaryRecordUtil::renderFile(output,
+                                            fileName.c_str(),
+                                            formatter);
+    ASSERT(0 == rc);
+    ASSERT("01JUN2020_12:30:00.000 ERROR server.cpp:42 SERVER "
+           "connection lost\n" == output.str());
+//..
+      } break;
+      case 3: {
+        // --------------------------------------------------------------------
+        // ROTATION
+        //
+        // Concerns:
+        //: 1 Size-based and forced rotations produce log files that are each
+        //:   independently decodable.
+        //:
+        //: 2 No record is lost or duplicated across rotations.
+        //:
+        //: 3 The rotation callback is invoked on each rotation.
+        //
+        // Plan:
+        //: 1 Rotate on a small size, publish many records, and force
+        //:   additional rotations along the way.  Render each rotated file
+        //:   from the rotation callback, and the active file at the end, and
+        //:   verify that each file renders without error, and that the
+        //:   renderings contain every record exactly once, in order.
+        //:   (C-1..3)
+        //
+        // Testing:
+        //   void forceRotation();
+        //   void rotateOnSize(int size);
+        //   void setOnFileRotationCallback(const OnFileRotationCallback&);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "ROTATION" << endl
+                          << "========" << endl;
+
+        const int NUM_RECORDS = 2000;
+
+        TempDirectoryGuard tempDirGuard;
+
+        bsl::string fileName(tempDirGuard.getTempDirName());
+        bdls::PathUtil::appendRaw(&fileName, "rotation.log");
+
+        ball::RecordStringFormatter formatter(FORMAT);
+        bsl::string                 rendered;
+        int                         numRendered = 0;
+        int                         numErrors   = 0;
+
+        Obj mX;
+        mX.setOnFileRotationCallback(RenderingRotationCallback(&formatter,
+                                                               &rendered,
+                                                               &numRendered,
+                                                               &numErrors));
+        mX.rotateOnSize(4);
+
+        ASSERT(0 == mX.enableFileLogging(fileName.c_str()));
+
+        ball::Record       record;
+        bsl::ostringstream expected;
+
+        for (int i = 0; i < NUM_RECORDS; ++i) {
+            makeRecord(&record, i);
+            mX.publish(record, ball::Context());
+            formatter(expected, record);
+
+            if (0 == i % 500) {
+                mX.forceRotation();
+            }
+        }
+        mX.disableFileLogging();
+
+        // Render the records remaining in the active log file.
+
+        RenderingRotationCallback(&formatter,
+                                  &rendered,
+                                  &numRendered,
+                                  &numErrors)(0, fileName);
+
+        ASSERTV(numErrors, 0 == numErrors);
+        ASSERTV(numRendered, NUM_RECORDS == numRendered);
+        ASSERT(expected.str() == rendered);
+      } break;
+      case 2: {
+        // --------------------------------------------------------------------
+        // CONFIGURATION FORWARDING
+        //
+        // Concerns:
+        //: 1 Each manipulator forwards to the embedded file observer, and each
+        //:   accessor reports the resulting configuration.
+        //
+        // Plan:
+        //: 1 Invoke each manipulator and verify the value reported by the
+        //:   corresponding accessor.  (C-1)
+        //
+        // Testing:
+        //   void disableFileLogging();
+        //   void disablePublishInLocalTime();
+        //   void disableSizeRotation();
+        //   void disableTimeIntervalRotation();
+        //   void enablePublishInLocalTime();
+        //   void rotateOnTimeInterval(const DatetimeInterval& interval);
+        //   void rotateOnTimeInterval(const DtInterval&, const Datetime&);
+        //   bool isFileLoggingEnabled() const;
+        //   bool isFileLoggingEnabled(bsl::string *result) const;
+        //   bool isPublishInLocalTimeEnabled() const;
+        //   bdlt::DatetimeInterval rotationLifetime() const;
+        //   int rotationSize() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "CONFIGURATION FORWARDING" << endl
+                          << "========================" << endl;
+
+        TempDirectoryGuard tempDirGuard;
+
+        bsl::string fileName(tempDirGuard.getTempDirName());
+        bdls::PathUtil::appendRaw(&fileName, "config.log");
+
+        bslma::TestAllocator oa("object", veryVeryVeryVerbose);
+
+        Obj mX(&oa);  const Obj& X = mX;
+
+        ASSERT(false                    == X.isFileLoggingEnabled());
+        ASSERT(false                    == X.isPublishInLocalTimeEnabled());
+        ASSERT(0                        == X.rotationSize());
+        ASSERT(bdlt::DatetimeInterval() == X.rotationLifetime());
+
+        mX.enablePublishInLocalTime();
+        ASSERT(true  == X.isPublishInLocalTimeEnabled());
+
+        mX.disablePublishInLocalTime();
+        ASSERT(false == X.isPublishInLocalTimeEnabled());
+
+        mX.rotateOnSize(1024);
+        ASSERT(1024 == X.rotationSize());
+
+        mX.disableSizeRotation();
+        ASSERT(0    == X.rotationSize());
+
+        mX.rotateOnTimeInterval(bdlt::DatetimeInterval(0, 1));
+        ASSERT(bdlt::DatetimeInterval(0, 1) == X.rotationLifetime());
+
+        mX.rotateOnTimeInterval(bdlt::DatetimeInterval(1),
+                                bdlt::Datetime(2020, 1, 1));
+        ASSERT(bdlt::DatetimeInterval(1)    == X.rotationLifetime());
+
+        mX.disableTimeIntervalRotation();
+        ASSERT(bdlt::DatetimeInterval()     == X.rotationLifetime());
+
+        ASSERT(0 == mX.enableFileLogging(fileName.c_str()));
+        ASSERT(0 <  mX.enableFileLogging(fileName.c_str()));
+
+        bsl::string result;
+        ASSERT(true     == X.isFileLoggingEnabled());
+        ASSERT(true     == X.isFileLoggingEnabled(&result));
+        ASSERT(fileName == result);
+
+        mX.disableFileLogging();
+
+        result = "unchanged";
+        ASSERT(false       == X.isFileLoggingEnabled());
+        ASSERT(false       == X.isFileLoggingEnabled(&result));
+        ASSERT("unchanged" == result);
+      } break;
+      case 1: {
+        // --------------------------------------------------------------------
+        // BREATHING TEST
+        //
+        // Concerns:
+        //: 1 Records published through either 'publish' overload are written
+        //:   to the log file in binary form, and render to the same text that
+        //:   a formatter produces for the original records.
+        //:
+        //: 2 Records published while file logging is disabled are dropped.
+        //:
+        //: 3 Records are appended to an existing log file.
+        //:
+        //: 4 The supplied allocator is used.
+        //
+        // Plan:
+        //: 1 Publish records before, while, and after enabling file logging,
+        //:   enable logging to the same file again, publish more records, and
+        //:   render the log file.  (C-1..4)
+        //
+        // Testing:
+        //   BinaryFileObserver(bslma::Allocator *basicAllocator = 0);
+        //   ~BinaryFileObserver();
+        //   int enableFileLogging(const char *logFilenamePattern);
+        //   void publish(const Record& record, const Context& context);
+        //   void publish(const shared_ptr<const Record>&, const Context&);
+        //   void releaseRecords();
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "BREATHING TEST" << endl
+                          << "==============" << endl;
+
+        TempDirectoryGuard tempDirGuard;
+
+        bsl::string fileName(tempDirGuard.getTempDirName());
+        bdls::PathUtil::appendRaw(&fileName, "breathing.log");
+
+        bslma::TestAllocator oa("object", veryVeryVeryVerbose);
+
+        ball::RecordStringFormatter formatter(FORMAT);
+        bsl::ostringstream          expected;
+
+        {
+            Obj mX(&oa);
+
+            ball::Record record;
+
+            makeRecord(&record, 0);
+            mX.publish(record, ball::Context());  // dropped
+
+            ASSERT(0 == mX.enableFileLogging(fileName.c_str()));
+            ASSERT(0 <  oa.numBlocksInUse());
+
+            for (int i = 1; i <= 10; ++i) {
+                makeRecord(&record, i);
+                if (i % 2) {
+                    mX.publish(record, ball::Context());
+                }
+                else {
+                    bsl::shared_ptr<const ball::Record> handle(
+                                           new ball::Record(record),
+                                           bslma::Default::defaultAllocator());
+                    mX.publish(handle, ball::Context());
+                }
+                formatter(expected, record);
+            }
+            mX.releaseRecords();
+
+            mX.disableFileLogging();
+
+            makeRecord(&record, 11);
+            mX.publish(record, ball::Context());  // dropped
+        }
+        ASSERT(0 == oa.numBlocksInUse());
+
+        {
+            Obj mX(&oa);
+
+            ASSERT(0 == mX.enableFileLogging(fileName.c_str()));
+
+            ball::Record record;
+            makeRecord(&record, 12);
+            mX.publish(record, ball::Context());
+            formatter(expected, record);
+        }
+
+        bsl::ostringstream output;
+        int                numRecords = -1;
+
+        ASSERT(0  == Util::renderFile(output,
+                                      fileName.c_str(),
+                                      formatter,
+                                      &numRecords));
+        ASSERT(11 == numRecords);
+        ASSERT(expected.str() == output.str());
+
+        if (veryVerbose) {
+            P(output.str());
+        }
+      } break;
+      case -1: {
+        // --------------------------------------------------------------------
+        // PERFORMANCE: 'BinaryFileObserver' VS. 'FileObserver2'
+        //
+        // Concerns:
+        //: 1 Publishing a record to a binary file observer is substantially
+        //:   cheaper than publishing it to a text file observer.
+        //
+        // Plan:
+        //: 1 Time publishing a typical record many times to each observer and
+        //:   report the times.  (C-1)
+        //
+        // Testing:
+        //   PERFORMANCE: 'BinaryFileObserver' VS. 'FileObserver2'
+        // --------------------------------------------------------------------
+
+        cout << endl
+             << "PERFORMANCE: 'BinaryFileObserver' VS. 'FileObserver2'"
+             << endl
+             << "====================================================="
+             << endl;
+
+        const int NUM_ITERATIONS = argc > 2 ? atoi(argv[2]) : 100000;
+
+        TempDirectoryGuard tempDirGuard;
+
+        bsl::string textName(tempDirGuard.getTempDirName());
+        bdls::PathUtil::appendRaw(&textName, "text.log");
+
+        bsl::string binaryName(tempDirGuard.getTempDirName());
+        bdls::PathUtil::appendRaw(&binaryName, "binary.log");
+
+        ball::Record record;
+        makeRecord(&record, 17);
+
+        bsls::Stopwatch timer;
+
+        {
+            ball::FileObserver2 observer;
+            observer.setLogFileFunctor(ball::RecordStringFormatter(FORMAT));
+            observer.enableFileLogging(textName.c_str());
+
+            timer.start();
+            for (int i = 0; i < NUM_ITERATIONS; ++i) {
+                observer.publish(record, ball::Context());
+            }
+            timer.stop();
+        }
+        const double textTime = timer.elapsedTime();
+
+        {
+            Obj observer;
+            observer.enableFileLogging(binaryName.c_str());
+
+            timer.reset();
+            timer.start();
+            for (int i = 0; i < NUM_ITERATIONS; ++i) {
+                observer.publish(record, ball::Context());
+            }
+            timer.stop();
+        }
+        const double binaryTime = timer.elapsedTime();
+
+        cout << "text:   " << textTime   * 1e9 / NUM_ITERATIONS
+             << " ns/record" << endl
+             << "binary: " << binaryTime * 1e9 / NUM_ITERATIONS
+             << " ns/record" << endl;
+      } break;
+      default: {
+        cerr << "WARNING: CASE `" << test << "' NOT FOUND." << endl;
+        testStatus = -1;
+      }
+    }
+
+    // CONCERN: In no case does memory come from the global allocator.
+
+    ASSERTV(globalAllocator.numBlocksTotal(),
+            0 == globalAllocator.numBlocksTotal());
+
+    if (testStatus > 0) {
+        cerr << "Error, non-zero test status = " << testStatus << "." << endl;
+    }
+    return testStatus;
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2020 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,655 @@
+// ball_binaryrecordutil.cpp                                          -*-C++-*-
+#include <ball_binaryrecordutil.h>
+
+#include <bsls_ident.h>
+BSLS_IDENT_RCSID(ball_binaryrecordutil_cpp,"$Id$ $CSID$")
+
+#include <ball_record.h>
+#include <ball_recordattributes.h>
+#include <ball_recordstringformatter.h>
+#include <ball_userfields.h>
+#include <ball_userfieldtype.h>
+#include <ball_userfieldvalue.h>
+
+#include <bdlma_localsequentialallocator.h>
+
+#include <bdlt_date.h>
+#include <bdlt_datetime.h>
+#include <bdlt_datetimetz.h>
+
+#include <bslstl_stringref.h>
+
+#include <bsls_assert.h>
+#include <bsls_types.h>
+
+#include <bsl_algorithm.h>
+#include <bsl_cstring.h>
+#include <bsl_fstream.h>
+#include <bsl_istream.h>
+#include <bsl_ostream.h>
+#include <bsl_vector.h>
+
+///Implementation Notes
+///--------------------
+// Integers are serialized one byte at a time (rather than by copying their
+// object representation) so that the format is independent of the byte order
+// of the platform that wrote it.  'encode' appends the frame header with a
+// placeholder payload length, appends the payload, and then patches the
+// length in place, so that each record is encoded in a single pass.
+//
+// 'render' reads its input in large chunks into a buffer and decodes frames
+// directly from that buffer.  When 'decode' reports that the buffer does not
+// start with a well-formed frame, 'render' skips ahead to the next occurrence
+// of the first magic byte and tries again; this resynchronizes on the next
+// intact frame after damaged or truncated data.
+
+namespace BloombergLP {
+namespace ball {
+
+namespace {
+
+typedef bsls::Types::Int64  Int64;
+typedef bsls::Types::Uint64 Uint64;
+
+const unsigned char k_MAGIC[4] = { 0xBA, 0x11, 0x0B, 0x1F };
+    // bytes starting each frame
+
+const bsl::size_t k_MAX_PAYLOAD_LENGTH = 1 << 30;
+    // largest payload length accepted by 'decode'; larger values are assumed
+    // to be the result of data corruption
+
+const Int64 k_MICROSECONDS_PER_DAY = 86400LL * 1000 * 1000;
+
+const int k_WRITE_BUFFER_SIZE = 1024;
+    // size of the stack buffer in which 'write' encodes typical records
+
+const bsl::size_t k_READ_CHUNK_SIZE = 64 * 1024;
+    // number of bytes read from the input by 'render' at a time
+
+                            // --------------
+                            // Encoding Utils
+                            // --------------
+
+void storeUint32(char *destination, unsigned int value)
+    // Store the specified 'value' in little-endian order into the 4 bytes
+    // starting at the specified 'destination'.
+{
+    destination[0] = static_cast<char>(value);
+    destination[1] = static_cast<char>(value >> 8);
+    destination[2] = static_cast<char>(value >> 16);
+    destination[3] = static_cast<char>(value >> 24);
+}
+
+void appendUint8(bsl::string *buffer, unsigned int value)
+    // Append the low-order byte of the specified 'value' to the specified
+    // 'buffer'.
+{
+    buffer->push_back(static_cast<char>(value));
+}
+
+void appendUint32(bsl::string *buffer, unsigned int value)
+    // Append the specified 'value' in little-endian order to the specified
+    // 'buffer'.
+{
+    char bytes[4];
+    storeUint32(bytes, value);
+    buffer->append(bytes, sizeof bytes);
+}
+
+void appendUint64(bsl::string *buffer, Uint64 value)
+    // Append the specified 'value' in little-endian order to the specified
+    // 'buffer'.
+{
+    char bytes[8];
+    storeUint32(bytes,     static_cast<unsigned int>(value));
+    storeUint32(bytes + 4, static_cast<unsigned int>(value >> 32));
+    buffer->append(bytes, sizeof bytes);
+}
+
+void appendString(bsl::string *buffer, const char *data, bsl::size_t length)
+    // Append the specified 'length' to the specified 'buffer' followed by the
+    // 'length' characters starting at the specified 'data'.
+{
+    appendUint32(buffer, static_cast<unsigned int>(length));
+    buffer->append(data, length);
+}
+
+void appendDatetime(bsl::string *buffer, const bdlt::Datetime& datetime)
+    // Append the specified 'datetime' to the specified 'buffer' as the number
+    // of days since 0001/01/01 followed by the number of microseconds since
+    // the start of that day.
+{
+    const int   days         = datetime.date() - bdlt::Date();
+    const Int64 microseconds =
+                   ((datetime.hour() * 60LL + datetime.minute()) * 60
+                                            + datetime.second()) * 1000 * 1000
+                 + datetime.millisecond() * 1000
+                 + datetime.microsecond();
+
+    appendUint32(buffer, static_cast<unsigned int>(days));
+    appendUint64(buffer, static_cast<Uint64>(microseconds));
+}
+
+void appendUserField(bsl::string *buffer, const UserFieldValue& value)
+    // Append the type and value of the specified user field 'value' to the
+    // specified 'buffer'.
+{
+    appendUint8(buffer, value.type());
+
+    switch (value.type()) {
+      case UserFieldType::e_VOID: {
+      } break;
+      case UserFieldType::e_INT64: {
+        appendUint64(buffer, static_cast<Uint64>(value.theInt64()));
+      } break;
+      case UserFieldType::e_DOUBLE: {
+        Uint64 bits;
+        const double doubleValue = value.theDouble();
+        bsl::memcpy(&bits, &doubleValue, sizeof bits);
+        appendUint64(buffer, bits);
+      } break;
+      case UserFieldType::e_STRING: {
+        const bsl::string& stringValue = value.theString();
+        appendString(buffer, stringValue.data(), stringValue.length());
+      } break;
+      case UserFieldType::e_DATETIMETZ: {
+        const bdlt::DatetimeTz& datetimeTz = value.theDatetimeTz();
+        appendDatetime(buffer, datetimeTz.localDatetime());
+        appendUint32(buffer, static_cast<unsigned int>(datetimeTz.offset()));
+      } break;
+      case UserFieldType::e_CHAR_ARRAY: {
+        const bsl::vector<char>& array = value.theCharArray();
+        appendString(buffer, array.data(), array.size());
+      } break;
+    }
+}
+
+                            // -----------------
+                            // class InputCursor
+                            // -----------------
+
+class InputCursor {
+    // This mechanism extracts the primitive elements of a frame payload from a
+    // contiguous range of bytes.  An attempt to read past the end of the range
+    // (or to extract an invalid value) places the cursor in an invalid state,
+    // in which all extractions return a default value.
+
+    // DATA
+    const char *d_cursor_p;  // next byte to extract
+    const char *d_end_p;     // end of the range
+    bool        d_isValid;   // 'false' if an extraction has failed
+
+    // PRIVATE MANIPULATORS
+    bool require(bsl::size_t numBytes);
+        // Return 'true' if this cursor is valid and at least the specified
+        // 'numBytes' bytes remain to be extracted, and invalidate this cursor
+        // and return 'false' otherwise.
+
+  public:
+    // CREATORS
+    InputCursor(const char *begin, const char *end);
+        // Create a cursor over the range '[begin .. end)'.
+
+    // MANIPULATORS
+    unsigned int getUint8();
+    unsigned int getUint32();
+    Uint64 getUint64();
+        // Extract and return an unsigned integer of the indicated width.
+
+    bslstl::StringRef getString();
+        // Extract and return a length-prefixed character sequence.
+
+    bdlt::Datetime getDatetime();
+        // Extract and return a datetime value.
+
+    void invalidate();
+        // Place this cursor in the invalid state.
+
+    // ACCESSORS
+    bool isAtEnd() const;
+        // Return 'true' if all bytes have been extracted, and 'false'
+        // otherwise.
+
+    bool isValid() const;
+        // Return 'true' if no extraction has failed, and 'false' otherwise.
+};
+
+// PRIVATE MANIPULATORS
+bool InputCursor::require(bsl::size_t numBytes)
+{
+    if (d_isValid && static_cast<bsl::size_t>(d_end_p - d_cursor_p)
+                                                                >= numBytes) {
+        return true;                                                  // RETURN
+    }
+    d_isValid = false;
+    return false;
+}
+
+// CREATORS
+InputCursor::InputCursor(const char *begin, const char *end)
+: d_cursor_p(begin)
+, d_end_p(end)
+, d_isValid(true)
+{
+}
+
+// MANIPULATORS
+unsigned int InputCursor::getUint8()
+{
+    if (!require(1)) {
+        return 0;                                                     // RETURN
+    }
+    return static_cast<unsigned char>(*d_cursor_p++);
+}
+
+unsigned int InputCursor::getUint32()
+{
+    if (!require(4)) {
+        return 0;                                                     // RETURN
+    }
+    const unsigned char *bytes =
+                         reinterpret_cast<const unsigned char *>(d_cursor_p);
+    d_cursor_p += 4;
+
+    return  static_cast<unsigned int>(bytes[0])
+         | (static_cast<unsigned int>(bytes[1]) << 8)
+         | (static_cast<unsigned int>(bytes[2]) << 16)
+         | (static_cast<unsigned int>(bytes[3]) << 24);
+}
+
+Uint64 InputCursor::getUint64()
+{
+    const Uint64 low  = getUint32();
+    const Uint64 high = getUint32();
+    return low | (high << 32);
+}
+
+bslstl::StringRef InputCursor::getString()
+{
+    const unsigned int length = getUint32();
+    if (!require(length)) {
+        return bslstl::StringRef();                                   // RETURN
+    }
+    const char *data = d_cursor_p;
+    d_cursor_p += length;
+    return bslstl::StringRef(data, length);
+}
+
+bdlt::Datetime InputCursor::getDatetime()
+{
+    const int   days         = static_cast<int>(getUint32());
+    const Int64 microseconds = static_cast<Int64>(getUint64());
+
+    bdlt::Date date;
+    if (!d_isValid
+     || 0 > days
+     || 0 != date.addDaysIfValid(days)
+     || 0 > microseconds
+     || k_MICROSECONDS_PER_DAY < microseconds) {
+        d_isValid = false;
+        return bdlt::Datetime();                                      // RETURN
+    }
+
+    const Int64 totalSeconds = microseconds / (1000 * 1000);
+    const int   hour         = static_cast<int>(totalSeconds / 3600);
+    const int   minute       = static_cast<int>(totalSeconds / 60 % 60);
+    const int   second       = static_cast<int>(totalSeconds % 60);
+    const int   fraction     = static_cast<int>(microseconds % (1000 * 1000));
+
+    if (!bdlt::Datetime::isValid(date.year(),
+                                 date.month(),
+                                 date.day(),
+                                 hour,
+                                 minute,
+                                 second,
+                                 fraction / 1000,
+                                 fraction % 1000)) {
+        d_isValid = false;
+        return bdlt::Datetime();                                      // RETURN
+    }
+
+    return bdlt::Datetime(date.year(),
+                          date.month(),
+                          date.day(),
+                          hour,
+                          minute,
+                          second,
+                          fraction / 1000,
+                          fraction % 1000);
+}
+
+void InputCursor::invalidate()
+{
+    d_isValid = false;
+}
+
+// ACCESSORS
+bool InputCursor::isAtEnd() const
+{
+    return d_cursor_p == d_end_p;
+}
+
+bool InputCursor::isValid() const
+{
+    return d_isValid;
+}
+
+                            // --------------
+                            // Decoding Utils
+                            // --------------
+
+bool decodeUserField(UserFields *fields, InputCursor *cursor)
+    // Extract a user field value from the specified 'cursor' and append it to
+    // the specified 'fields'.  Return 'true' on success, and 'false'
+    // otherwise.
+{
+    const unsigned int type = cursor->getUint8();
+    if (!cursor->isValid()) {
+        return false;                                                 // RETURN
+    }
+
+    switch (type) {
+      case UserFieldType::e_VOID: {
+        fields->appendNull();
+      } break;
+      case UserFieldType::e_INT64: {
+        const Int64 value = static_cast<Int64>(cursor->getUint64());
+        fields->appendInt64(value);
+      } break;
+      case UserFieldType::e_DOUBLE: {
+        const Uint64 bits = cursor->getUint64();
+        double       value;
+        bsl::memcpy(&value, &bits, sizeof value);
+        fields->appendDouble(value);
+      } break;
+      case UserFieldType::e_STRING: {
+        fields->appendString(cursor->getString());
+      } break;
+      case UserFieldType::e_DATETIMETZ: {
+        const bdlt::Datetime localDatetime = cursor->getDatetime();
+        const int            offset        =
+                                       static_cast<int>(cursor->getUint32());
+        if (!cursor->isValid()
+         || !bdlt::DatetimeTz::isValid(localDatetime, offset)) {
+            return false;                                             // RETURN
+        }
+        fields->appendDatetimeTz(bdlt::DatetimeTz(localDatetime, offset));
+      } break;
+      case UserFieldType::e_CHAR_ARRAY: {
+        const bslstl::StringRef array = cursor->getString();
+        fields->appendCharArray(bsl::vector<char>(array.begin(),
+                                                  array.end()));
+      } break;
+      default: {
+        return false;                                                 // RETURN
+      }
+    }
+
+    return cursor->isValid();
+}
+
+bool isMagicPrefix(const char *buffer, bsl::size_t length)
+    // Return 'true' if the specified 'buffer' of the specified 'length' holds
+    // the first 'min(length, 4)' bytes of the frame magic, and 'false'
+    // otherwise.
+{
+    return 0 == bsl::memcmp(buffer,
+                            k_MAGIC,
+                            bsl::min(length, sizeof k_MAGIC));
+}
+
+}  // close unnamed namespace
+
+                          // -----------------------
+                          // struct BinaryRecordUtil
+                          // -----------------------
+
+// CLASS METHODS
+int BinaryRecordUtil::decode(Record      *record,
+                             int         *frameLength,
+                             const char  *buffer,
+                             bsl::size_t  length)
+{
+    BSLS_ASSERT(record);
+    BSLS_ASSERT(frameLength);
+    BSLS_ASSERT(buffer || 0 == length);
+
+    if (!isMagicPrefix(buffer, length)) {
+        return -1;                                                    // RETURN
+    }
+
+    if (length < k_FRAME_HEADER_SIZE) {
+        *frameLength = k_FRAME_HEADER_SIZE;
+        return 1;                                                     // RETURN
+    }
+
+    InputCursor       header(buffer + sizeof k_MAGIC,
+                             buffer + k_FRAME_HEADER_SIZE);
+    const bsl::size_t payloadLength = header.getUint32();
+
+    if (k_MAX_PAYLOAD_LENGTH < payloadLength) {
+        return -1;                                                    // RETURN
+    }
+
+    *frameLength = static_cast<int>(k_FRAME_HEADER_SIZE + payloadLength);
+
+    if (length < k_FRAME_HEADER_SIZE + payloadLength) {
+        return 1;                                                     // RETURN
+    }
+
+    const char  *payload = buffer + k_FRAME_HEADER_SIZE;
+    InputCursor  cursor(payload, payload + payloadLength);
+
+    if (k_FORMAT_VERSION != cursor.getUint8()) {
+        return -2;                                                    // RETURN
+    }
+
+    RecordAttributes& attributes = record->fixedFields();
+
+    attributes.setTimestamp(cursor.getDatetime());
+    attributes.setProcessID(static_cast<int>(cursor.getUint32()));
+    attributes.setThreadID(cursor.getUint64());
+    attributes.setSeverity(static_cast<int>(cursor.getUint32()));
+    attributes.setLineNumber(static_cast<int>(cursor.getUint32()));
+
+    // 'setFileName' and 'setCategory' require null-terminated strings.
+
+    bdlma::LocalSequentialAllocator<256> stringAllocator;
+    bsl::string                          name(&stringAllocator);
+
+    name.assign(cursor.getString());
+    attributes.setFileName(name.c_str());
+
+    name.assign(cursor.getString());
+    attributes.setCategory(name.c_str());
+
+    const bslstl::StringRef message = cursor.getString();
+    attributes.clearMessage();
+    attributes.messageStreamBuf().sputn(
+                              message.data(),
+                              static_cast<bsl::streamsize>(message.length()));
+
+    const unsigned int numUserFields = cursor.getUint32();
+    UserFields&        userFields    = record->customFields();
+
+    userFields.removeAll();
+    for (unsigned int i = 0; i < numUserFields && cursor.isValid(); ++i) {
+        if (!decodeUserField(&userFields, &cursor)) {
+            cursor.invalidate();
+        }
+    }
+
+    if (!cursor.isValid() || !cursor.isAtEnd()) {
+        return -3;                                                    // RETURN
+    }
+
+    return 0;
+}
+
+void BinaryRecordUtil::encode(bsl::string *buffer, const Record& record)
+{
+    BSLS_ASSERT(buffer);
+
+    const RecordAttributes& attributes = record.fixedFields();
+    const UserFields&       userFields = record.customFields();
+    const bsl::size_t       frameStart = buffer->length();
+
+    buffer->append(reinterpret_cast<const char *>(k_MAGIC), sizeof k_MAGIC);
+    appendUint32(buffer, 0);  // payload length, patched below
+
+    appendUint8(buffer, k_FORMAT_VERSION);
+    appendDatetime(buffer, attributes.timestamp());
+    appendUint32(buffer, static_cast<unsigned int>(attributes.processID()));
+    appendUint64(buffer, attributes.threadID());
+    appendUint32(buffer, static_cast<unsigned int>(attributes.severity()));
+    appendUint32(buffer, static_cast<unsigned int>(attributes.lineNumber()));
+
+    const char *fileName = attributes.fileName();
+    appendString(buffer, fileName, bsl::strlen(fileName));
+
+    const char *category = attributes.category();
+    appendString(buffer, category, bsl::strlen(category));
+
+    const bslstl::StringRef message = attributes.messageRef();
+    appendString(buffer, message.data(), message.length());
+
+    const int numUserFields = userFields.length();
+    appendUint32(buffer, static_cast<unsigned int>(numUserFields));
+    for (int i = 0; i < numUserFields; ++i) {
+        appendUserField(buffer, userFields[i]);
+    }
+
+    const bsl::size_t payloadLength =
+                         buffer->length() - frameStart - k_FRAME_HEADER_SIZE;
+
+    storeUint32(&(*buffer)[frameStart + sizeof k_MAGIC],
+                static_cast<unsigned int>(payloadLength));
+}
+
+int BinaryRecordUtil::render(bsl::ostream&                textStream,
+                             bsl::istream&                binaryStream,
+                             const RecordStringFormatter& formatter,
+                             int                         *numRecords)
+{
+    bsl::vector<char> buffer;
+    Record            record;
+    bsl::size_t       begin       = 0;      // start of undecoded input
+    bsl::size_t       needed      = k_READ_CHUNK_SIZE;
+    bool              isEndOfData = false;
+    int               status      = 0;
+    int               count       = 0;
+
+    while (true) {
+        // Decode all complete frames in 'buffer[begin .. buffer.size())'.
+
+        while (begin < buffer.size()) {
+            const bsl::size_t available   = buffer.size() - begin;
+            int               frameLength = 0;
+            const int         rc          = decode(&record,
+                                                   &frameLength,
+                                                   buffer.data() + begin,
+                                                   available);
+            if (0 == rc) {
+                formatter(textStream, record);
+                ++count;
+                begin += frameLength;
+            }
+            else if (0 < rc) {
+                needed = static_cast<bsl::size_t>(frameLength) - available;
+                break;
+            }
+            else {
+                // Resynchronize on the next byte that may start a frame.
+
+                status = 1;
+                const char *next = static_cast<const char *>(
+                                  bsl::memchr(buffer.data() + begin + 1,
+                                              k_MAGIC[0],
+                                              available - 1));
+                begin = next ? next - buffer.data() : buffer.size();
+            }
+        }
+
+        if (isEndOfData) {
+            if (begin < buffer.size()) {
+                status = 1;  // truncated final frame
+            }
+            break;
+        }
+
+        // Discard the consumed input and read more.
+
+        buffer.erase(buffer.begin(), buffer.begin() + begin);
+        begin = 0;
+
+        const bsl::size_t oldSize   = buffer.size();
+        const bsl::size_t chunkSize = bsl::max(needed, k_READ_CHUNK_SIZE);
+
+        buffer.resize(oldSize + chunkSize);
+        binaryStream.read(buffer.data() + oldSize,
+                          static_cast<bsl::streamsize>(chunkSize));
+
+        const bsl::size_t numRead =
+                             static_cast<bsl::size_t>(binaryStream.gcount());
+        buffer.resize(oldSize + numRead);
+        needed = k_READ_CHUNK_SIZE;
+
+        if (numRead < chunkSize) {
+            isEndOfData = true;
+        }
+    }
+
+    if (numRecords) {
+        *numRecords = count;
+    }
+
+    return textStream.good() ? status : -1;
+}
+
+int BinaryRecordUtil::renderFile(bsl::ostream&                textStream,
+                                 const char                  *fileName,
+                                 const RecordStringFormatter& formatter,
+                                 int                         *numRecords)
+{
+    BSLS_ASSERT(fileName);
+
+    bsl::ifstream file(fileName, bsl::ios_base::in | bsl::ios_base::binary);
+    if (!file.is_open()) {
+        if (numRecords) {
+            *numRecords = 0;
+        }
+        return -1;                                                    // RETURN
+    }
+
+    return render(textStream, file, formatter, numRecords);
+}
+
+void BinaryRecordUtil::write(bsl::ostream& stream, const Record& record)
+{
+    bdlma::LocalSequentialAllocator<k_WRITE_BUFFER_SIZE> allocator;
+    bsl::string                                          buffer(&allocator);
+
+    buffer.reserve(k_WRITE_BUFFER_SIZE / 2);
+    encode(&buffer, record);
+
+    stream.write(buffer.data(), static_cast<bsl::streamsize>(buffer.length()));
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+// ----------------------------------------------------------------------------
+// Copyright 2020 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
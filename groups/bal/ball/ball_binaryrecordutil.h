@@ -0,0 +1,227 @@
+// ball_binaryrecordutil.h                                            -*-C++-*-
+#ifndef INCLUDED_BALL_BINARYRECORDUTIL
+#define INCLUDED_BALL_BINARYRECORDUTIL
+
+#include <bsls_ident.h>
+BSLS_IDENT("$Id: $")
+
+//@PURPOSE: Provide utilities to encode, decode, and render binary log records.
+//
+//@CLASSES:
+//  ball::BinaryRecordUtil: namespace for binary log record format utilities
+//
+//@SEE_ALSO: ball_binaryfileobserver, ball_record, ball_recordstringformatter
+//
+//@DESCRIPTION: This component provides a namespace 'struct',
+// 'ball::BinaryRecordUtil', containing functions that encode a 'ball::Record'
+// (its fixed fields and its user-defined fields) into a compact binary
+// "frame", decode such a frame back into a 'ball::Record', and render a
+// sequence of frames (e.g., the contents of a log file written by
+// 'ball::BinaryFileObserver') as text using a 'ball::RecordStringFormatter'.
+//
+// Encoding a record is considerably cheaper than formatting it as text: no
+// timestamp or integer conversions are performed, and every field is copied
+// verbatim into the output.  Applications that log at high rates can therefore
+// publish records in binary form and defer the cost of formatting to an
+// offline process (or to the rare occasion where a log file is actually read).
+//
+///Binary Format
+///-------------
+// A binary log is a sequence of self-delimiting frames, each holding exactly
+// one record.  There is no file header, so a log file may be rotated,
+// truncated, or concatenated with another log file at any frame boundary and
+// remain decodable.  All integers are written in little-endian byte order,
+// independent of the platform.  A frame has the following layout:
+//..
+//  +---------------+-----------------------------------------------------+
+//  | Field         | Encoding                                            |
+//  +===============+=====================================================+
+//  | magic         | the 4 bytes 0xBA 0x11 0x0B 0x1F                     |
+//  | payloadLength | uint32: number of bytes in the rest of the frame    |
+//  +---------------+-----------------------------------------------------+
+//  | version       | uint8: 'k_FORMAT_VERSION'                           |
+//  | timestamp     | DATETIME (see below)                                |
+//  | processID     | int32                                               |
+//  | threadID      | uint64                                              |
+//  | severity      | int32                                               |
+//  | lineNumber    | int32                                               |
+//  | fileName      | STRING: uint32 length followed by the characters    |
+//  | category      | STRING                                              |
+//  | message       | STRING                                              |
+//  | numUserFields | uint32                                              |
+//  | userFields    | 'numUserFields' times: uint8 'ball::UserFieldType'  |
+//  |               | followed by the value for that type:                |
+//  |               |   e_VOID:       (nothing)                           |
+//  |               |   e_INT64:      int64                               |
+//  |               |   e_DOUBLE:     IEEE-754 bits of the value as int64 |
+//  |               |   e_STRING:     STRING                              |
+//  |               |   e_DATETIMETZ: DATETIME and int32 offset (minutes) |
+//  |               |   e_CHAR_ARRAY: STRING                              |
+//  +---------------+-----------------------------------------------------+
+//..
+// where DATETIME is an int32 holding the number of days since 0001/01/01
+// followed by an int64 holding the number of microseconds since the start of
+// that day (the default 'bdlt::Datetime' value, 0001/01/01_24:00:00.000000,
+// is represented by 0 days and 86400000000 microseconds).  Record timestamps
+// are written exactly as they are held in the record (i.e., in UTC); any
+// conversion to local time is performed when the frame is rendered.
+//
+// The magic bytes allow a reader to resynchronize on the next frame after
+// encountering damaged data (e.g., a partially written frame at the end of a
+// log file of a process that was terminated abruptly).
+//
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Round-Tripping a Record
+/// - - - - - - - - - - - - - - - - -
+// Suppose we have a log record that we want to store in binary form, and
+// later render as text.
+//
+// First, we create a record:
+//..
+//  ball::Record record;
+//  record.fixedFields().setTimestamp(bdlt::Datetime(2020, 6, 1, 12, 30));
+//  record.fixedFields().setProcessID(1234);
+//  record.fixedFields().setThreadID(5);
+//  record.fixedFields().setSeverity(ball::Severity::e_WARN);
+//  record.fixedFields().setFileName("server.cpp");
+//  record.fixedFields().setLineNumber(42);
+//  record.fixedFields().setCategory("SERVER");
+//  record.fixedFields().setMessage("disk almost full");
+//  record.customFields().appendInt64(97);
+//..
+// Then, we encode the record into a buffer:
+//..
+//  bsl::string buffer;
+//  ball::BinaryRecordUtil::encode(&buffer, record);
+//..
+// Next, we decode the buffer into another record, and verify that the two
+// records have the same value:
+//..
+//  ball::Record decoded;
+//  int          frameLength;
+//  int          rc = ball::BinaryRecordUtil::decode(&decoded,
+//                                                   &frameLength,
+//                                                   buffer.data(),
+//                                                   buffer.length());
+//  assert(0                                       == rc);
+//  assert(static_cast<int>(buffer.length())       == frameLength);
+//  assert(record                                  == decoded);
+//..
+// Finally, we render the binary data as text, using the same format that a
+// 'ball::FileObserver' might have been configured with:
+//..
+//  bsl::istringstream         input(buffer);
+//  bsl::ostringstream         output;
+//  ball::RecordStringFormatter formatter("%d %p:%t %s %f:%l %c %m %u\n");
+//
+//  rc = ball::BinaryRecordUtil::render(output, input, formatter);
+//  assert(0 == rc);
+//  assert("01JUN2020_12:30:00.000 1234:5 WARN server.cpp:42 SERVER "
+//         "disk almost full 97\n" == output.str());
+//..
+
+#include <balscm_version.h>
+
+#include <bsl_cstddef.h>
+#include <bsl_iosfwd.h>
+#include <bsl_string.h>
+
+namespace BloombergLP {
+namespace ball {
+
+class Record;
+class RecordStringFormatter;
+
+                          // =======================
+                          // struct BinaryRecordUtil
+                          // =======================
+
+struct BinaryRecordUtil {
+    // This 'struct' provides a namespace for functions that convert log
+    // records to and from a compact, self-delimiting binary representation.
+
+    // CONSTANTS
+    enum {
+        k_FORMAT_VERSION    = 1,  // version of the frame payload layout
+                                  // written by 'encode'
+
+        k_FRAME_HEADER_SIZE = 8   // number of bytes preceding the payload of
+                                  // each frame
+    };
+
+    // CLASS METHODS
+    static int decode(Record      *record,
+                      int         *frameLength,
+                      const char  *buffer,
+                      bsl::size_t  length);
+        // Decode into the specified 'record' the frame at the start of the
+        // specified 'buffer' of the specified 'length', and load into the
+        // specified 'frameLength' the number of bytes occupied by that frame.
+        // Return 0 on success, a positive value if 'buffer' holds only a
+        // prefix of a (possibly) well-formed frame, and a negative value if
+        // 'buffer' does not start with a well-formed frame.  On a positive
+        // return, if 'length' is at least 'k_FRAME_HEADER_SIZE', 'frameLength'
+        // is loaded with the total length of the frame; otherwise it is
+        // loaded with 'k_FRAME_HEADER_SIZE'.  If a non-zero value is returned,
+        // the value of 'record' is unspecified.  The behavior is undefined
+        // unless 'buffer' refers to at least 'length' bytes.
+
+    static void encode(bsl::string *buffer, const Record& record);
+        // Append to the specified 'buffer' a frame holding the value of the
+        // specified 'record'.
+
+    static int render(bsl::ostream&                textStream,
+                      bsl::istream&                binaryStream,
+                      const RecordStringFormatter& formatter,
+                      int                         *numRecords = 0);
+        // Read frames from the specified 'binaryStream' until the end of the
+        // stream, and write each decoded record to the specified 'textStream'
+        // using the specified 'formatter'.  Optionally specify 'numRecords',
+        // into which the number of records written is loaded.  Return 0 if
+        // the entire input consists of well-formed frames, a positive value
+        // if some input could not be decoded (such input is skipped, and
+        // rendering continues with the next well-formed frame), and a
+        // negative value if 'textStream' is not in a good state on return.
+
+    static int renderFile(bsl::ostream&                textStream,
+                          const char                  *fileName,
+                          const RecordStringFormatter& formatter,
+                          int                         *numRecords = 0);
+        // Render, as text, the binary log file having the specified
+        // 'fileName' to the specified 'textStream' using the specified
+        // 'formatter' as if by calling 'render'.  Optionally specify
+        // 'numRecords', into which the number of records written is loaded.
+        // Return 0 on success, a positive value if some of the file could not
+        // be decoded, and a negative value if the file could not be opened or
+        // 'textStream' is not in a good state on return.
+
+    static void write(bsl::ostream& stream, const Record& record);
+        // Write to the specified 'stream' a frame holding the value of the
+        // specified 'record'.  Note that the signature of this function
+        // matches 'ball::FileObserver2::LogRecordFunctor', and that 'stream'
+        // is not flushed.
+};
+
+}  // close package namespace
+}  // close enterprise namespace
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2020 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,1103 @@
+// ball_binaryrecordutil.t.cpp                                        -*-C++-*-
+#include <ball_binaryrecordutil.h>
+
+#include <ball_record.h>
+#include <ball_recordattributes.h>
+#include <ball_recordstringformatter.h>
+#include <ball_severity.h>
+#include <ball_userfields.h>
+#include <ball_userfieldtype.h>
+
+#include <bdls_filesystemutil.h>
+
+#include <bdlt_date.h>
+#include <bdlt_datetime.h>
+#include <bdlt_datetimetz.h>
+
+#include <bslim_testutil.h>
+
+#include <bslma_default.h>
+#include <bslma_defaultallocatorguard.h>
+#include <bslma_testallocator.h>
+
+#include <bsls_assert.h>
+#include <bsls_asserttest.h>
+#include <bsls_review.h>
+#include <bsls_stopwatch.h>
+#include <bsls_types.h>
+
+#include <bsl_cstdlib.h>
+#include <bsl_cstring.h>
+#include <bsl_iostream.h>
+#include <bsl_limits.h>
+#include <bsl_sstream.h>
+#include <bsl_string.h>
+#include <bsl_vector.h>
+
+using namespace BloombergLP;
+using namespace bsl;
+
+// ============================================================================
+//                                   TEST PLAN
+// ----------------------------------------------------------------------------
+//                                   Overview
+//                                   --------
+// The component under test is a utility for converting log records to and
+// from a binary frame format.  We verify that 'encode' followed by 'decode'
+// reproduces every record value (including all user field types and boundary
+// values), that 'decode' rejects malformed input and recognizes incomplete
+// input, that 'write' produces the same bytes as 'encode', and that 'render'
+// produces the same text as the formatter applied directly, resynchronizing
+// after damaged data.
+// ----------------------------------------------------------------------------
+// CLASS METHODS
+// [ 2] int decode(Record *, int *, const char *, size_t);
+// [ 2] void encode(bsl::string *buffer, const Record& record);
+// [ 3] int decode(Record *, int *, const char *, size_t);
+// [ 4] void write(bsl::ostream& stream, const Record& record);
+// [ 5] int render(ostream&, istream&, const Formatter&, int *);
+// [ 6] int renderFile(ostream&, const char *, const Formatter&, int *);
+// ----------------------------------------------------------------------------
+// [ 1] BREATHING TEST
+// [ 7] USAGE EXAMPLE
+// [-1] PERFORMANCE: 'write' VS. 'RecordStringFormatter'
+
+// ============================================================================
+//                     STANDARD BDE ASSERT TEST FUNCTION
+// ----------------------------------------------------------------------------
+
+namespace {
+
+int testStatus = 0;
+
+void aSsErT(bool condition, const char *message, int line)
+{
+    if (condition) {
+        cout << "Error " __FILE__ "(" << line << "): " << message
+             << "    (failed)" << endl;
+
+        if (0 <= testStatus && testStatus <= 100) {
+            ++testStatus;
+        }
+    }
+}
+
+}  // close unnamed namespace
+
+// ============================================================================
+//               STANDARD BDE TEST DRIVER MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT       BSLIM_TESTUTIL_ASSERT
+#define ASSERTV      BSLIM_TESTUTIL_ASSERTV
+
+#define LOOP_ASSERT  BSLIM_TESTUTIL_LOOP_ASSERT
+#define LOOP0_ASSERT BSLIM_TESTUTIL_LOOP0_ASSERT
+#define LOOP1_ASSERT BSLIM_TESTUTIL_LOOP1_ASSERT
+#define LOOP2_ASSERT BSLIM_TESTUTIL_LOOP2_ASSERT
+#define LOOP3_ASSERT BSLIM_TESTUTIL_LOOP3_ASSERT
+#define LOOP4_ASSERT BSLIM_TESTUTIL_LOOP4_ASSERT
+#define LOOP5_ASSERT BSLIM_TESTUTIL_LOOP5_ASSERT
+#define LOOP6_ASSERT BSLIM_TESTUTIL_LOOP6_ASSERT
+
+#define Q            BSLIM_TESTUTIL_Q   // Quote identifier literally.
+#define P            BSLIM_TESTUTIL_P   // Print identifier and value.
+#define P_           BSLIM_TESTUTIL_P_  // P(X) without '\n'.
+#define T_           BSLIM_TESTUTIL_T_  // Print a tab (w/o newline).
+#define L_           BSLIM_TESTUTIL_L_  // current Line number
+
+// ============================================================================
+//                  NEGATIVE-TEST MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT_SAFE_PASS(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_PASS(EXPR)
+#define ASSERT_SAFE_FAIL(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_FAIL(EXPR)
+#define ASSERT_PASS(EXPR)      BSLS_ASSERTTEST_ASSERT_PASS(EXPR)
+#define ASSERT_FAIL(EXPR)      BSLS_ASSERTTEST_ASSERT_FAIL(EXPR)
+#define ASSERT_OPT_PASS(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_PASS(EXPR)
+#define ASSERT_OPT_FAIL(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_FAIL(EXPR)
+
+//=============================================================================
+//                  GLOBAL TYPEDEFS/CONSTANTS FOR TESTING
+//-----------------------------------------------------------------------------
+
+typedef ball::BinaryRecordUtil Util;
+typedef bsls::Types::Int64     Int64;
+typedef bsls::Types::Uint64    Uint64;
+
+static const char *const FORMAT = "\n%d %p:%t %s %f:%l %c %m %u\n";
+
+//=============================================================================
+//                      HELPER FUNCTIONS FOR TESTING
+//-----------------------------------------------------------------------------
+
+static void makeRecord(ball::Record          *record,
+                       const bdlt::Datetime&  timestamp,
+                       int                    processID,
+                       Uint64                 threadID,
+                       int                    severity,
+                       const char            *fileName,
+                       int                    lineNumber,
+                       const char            *category,
+                       const bsl::string&     message)
+    // Load into the specified 'record' the specified 'timestamp',
+    // 'processID', 'threadID', 'severity', 'fileName', 'lineNumber',
+    // 'category', and 'message', and remove all user fields of 'record'.
+{
+    ball::RecordAttributes& attributes = record->fixedFields();
+
+    attributes.setTimestamp(timestamp);
+    attributes.setProcessID(processID);
+    attributes.setThreadID(threadID);
+    attributes.setSeverity(severity);
+    attributes.setFileName(fileName);
+    attributes.setLineNumber(lineNumber);
+    attributes.setCategory(category);
+    attributes.clearMessage();
+    attributes.messageStreamBuf().sputn(message.data(), message.length());
+
+    record->customFields().removeAll();
+}
+
+static void makeRecord(ball::Record *record, int index)
+    // Load into the specified 'record' a value that is determined by the
+    // specified 'index'.
+{
+    bsl::ostringstream message;
+    message << "message number " << index;
+
+    makeRecord(record,
+               bdlt::Datetime(2020, 1 + index % 12, 1 + index % 28,
+                              index % 24, index % 60, index % 60,
+                              index % 1000, index % 1000),
+               1000 + index,
+               index * 3,
+               ball::Severity::e_INFO,
+               "binary.cpp",
+               index,
+               "CATEGORY",
+               message.str());
+
+    record->customFields().appendInt64(index);
+    record->customFields().appendString("user");
+}
+
+//=============================================================================
+//                               USAGE EXAMPLE
+//-----------------------------------------------------------------------------
+
+//=============================================================================
+//                              MAIN PROGRAM
+//-----------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    const int                 test = argc > 1 ? atoi(argv[1]) : 0;
+    const bool             verbose = argc > 2;
+    const bool         veryVerbose = argc > 3;
+    const bool     veryVeryVerbose = argc > 4;
+    const bool veryVeryVeryVerbose = argc > 5;
+
+    (void)veryVeryVerbose;
+
+    cout << "TEST " << __FILE__ << " CASE " << test << endl;
+
+    // CONCERN: 'BSLS_REVIEW' failures should lead to test failures.
+    bsls::ReviewFailureHandlerGuard reviewGuard(&bsls::Review::failByAbort);
+
+    // CONCERN: In no case does memory come from the global allocator.
+
+    bslma::TestAllocator globalAllocator("global", veryVeryVeryVerbose);
+    bslma::Default::setGlobalAllocator(&globalAllocator);
+
+    switch (test) { case 0:
+      case 7: {
+        // --------------------------------------------------------------------
+        // USAGE EXAMPLE
+        //   Extracted from component header file.
+        //
+        // Concerns:
+        //: 1 The usage example provided in the component header file compiles,
+        //:   links, and runs as shown.
+        //
+        // Plan:
+        //: 1 Incorporate usage example from header into test driver, remove
+        //:   leading comment characters, and replace 'assert' with 'ASSERT'.
+        //:   (C-1)
+        //
+        // Testing:
+        //   USAGE EXAMPLE
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "USAGE EXAMPLE" << endl
+                          << "=============" << endl;
+
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Round-Tripping a Record
+/// - - - - - - - - - - - - - - - - -
+// Suppose we have a log record that we want to store in binary form, and
+// later render as text.
+//
+// First, we create a record:
+//..
+    ball::Record record;
+    record.fixedFields().setTimestamp(bdlt::Datetime(2020, 6, 1, 12, 30));
+    record.fixedFields().setProcessID(1234);
+    record.fixedFields().setThreadID(5);
+    record.fixedFields().setSeverity(ball::Severity::e_WARN);
+    record.fixedFields().setFileName("server.cpp");
+    record.fixedFields().setLineNumber(42);
+    record.fixedFields().setCategory("SERVER");
+    record.fixedFields().setMessage("disk almost full");
+    record.customFields().appendInt64(97);
+//..
+// Then, we encode the record into a buffer:
+//..
+    bsl::string buffer;
+    ball::BinaryRecordUtil::encode(&buffer, record);
+//..
+// Next, we decode the buffer into another record, and verify that the two
+// records have the same value:
+//..
+    ball::Record decoded;
+    int          frameLength;
+    int          rc = ball::BinaryRecordUtil::decode(&decoded,
+                                                     &frameLength,
+                                                     buffer.data(),
+                                                     buffer.length());
+    ASSERT(0                                 == rc);
+    ASSERT(static_cast<int>(buffer.length()) == frameLength);
+    ASSERT(record                            == decoded);
+//..
+// Finally, we render the binary data as text, using the same format that a
+// 'ball::FileObserver' might have been configured with:
+//..
+    bsl::istringstream          input(buffer);
+    bsl::ostringstream          output;
+    ball::RecordStringFormatter formatter("%d %p:%t %s %f:%l %c %m %u\n");
+
+    rc = ball::BinaryRecordUtil::render(output, input, formatter);
+    ASSERT(0 == rc);
+    ASSERT("01JUN2020_12:30:00.000 1234:5 WARN server.cpp:42 SERVER "
+           "disk almost full 97\n" == output.str());
+//..
+      } break;
+      case 6: {
+        // --------------------------------------------------------------------
+        // 'renderFile'
+        //
+        // Concerns:
+        //: 1 'renderFile' renders the frames held in the named file.
+        //:
+        //: 2 'renderFile' returns a negative value, and loads 0 into
+        //:   'numRecords', if the file cannot be opened.
+        //
+        // Plan:
+        //: 1 Write several frames to a temporary file, render the file, and
+        //:   compare the output with the text produced by the formatter.
+        //:   (C-1)
+        //:
+        //: 2 Render a file that does not exist.  (C-2)
+        //
+        // Testing:
+        //   int renderFile(ostream&, const char *, const Formatter&, int *);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "'renderFile'" << endl
+                          << "============" << endl;
+
+        typedef bdls::FilesystemUtil FileUtil;
+
+        ball::RecordStringFormatter formatter(FORMAT);
+        ball::Record                record;
+        bsl::string                 binary;
+        bsl::ostringstream          expected;
+
+        for (int i = 0; i < 10; ++i) {
+            makeRecord(&record, i);
+            Util::encode(&binary, record);
+            formatter(expected, record);
+        }
+
+        bsl::string              fileName;
+        FileUtil::FileDescriptor fd =
+                       FileUtil::createTemporaryFile(&fileName, "ball_brutil");
+        ASSERT(FileUtil::k_INVALID_FD != fd);
+        ASSERT(static_cast<int>(binary.length()) ==
+                                     FileUtil::write(fd,
+                                                     binary.data(),
+                                                     static_cast<int>(
+                                                           binary.length())));
+        FileUtil::close(fd);
+
+        {
+            bsl::ostringstream output;
+            int                numRecords = -1;
+
+            ASSERT(0  == Util::renderFile(output,
+                                          fileName.c_str(),
+                                          formatter,
+                                          &numRecords));
+            ASSERT(10 == numRecords);
+            ASSERT(expected.str() == output.str());
+        }
+
+        FileUtil::remove(fileName);
+
+        {
+            bsl::ostringstream output;
+            int                numRecords = -1;
+
+            ASSERT(0 > Util::renderFile(output,
+                                        fileName.c_str(),
+                                        formatter,
+                                        &numRecords));
+            ASSERT(0 == numRecords);
+            ASSERT(output.str().empty());
+        }
+      } break;
+      case 5: {
+        // --------------------------------------------------------------------
+        // 'render'
+        //
+        // Concerns:
+        //: 1 Each frame is rendered exactly as the formatter renders the
+        //:   original record.
+        //:
+        //: 2 Frames that straddle the boundaries of the internal read buffer
+        //:   are rendered correctly, including frames larger than that
+        //:   buffer.
+        //:
+        //: 3 Damaged data is skipped, rendering resumes with the next intact
+        //:   frame, and a positive value is returned.
+        //:
+        //: 4 A truncated final frame is skipped, and a positive value is
+        //:   returned.
+        //:
+        //: 5 An empty input renders nothing and returns 0.
+        //:
+        //: 6 A negative value is returned if the output stream fails.
+        //
+        // Plan:
+        //: 1 Encode many records, render them, and compare with the output of
+        //:   the formatter applied to the records directly.  (C-1..2)
+        //:
+        //: 2 Insert garbage before, between, and after frames, and overwrite
+        //:   bytes of a frame.  Verify that the intact frames are rendered and
+        //:   that the return value is positive.  (C-3)
+        //:
+        //: 3 Truncate the input within the last frame.  (C-4)
+        //:
+        //: 4 Render an empty stream.  (C-5)
+        //:
+        //: 5 Render to a stream in a failed state.  (C-6)
+        //
+        // Testing:
+        //   int render(ostream&, istream&, const Formatter&, int *);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "'render'" << endl
+                          << "========" << endl;
+
+        ball::RecordStringFormatter formatter(FORMAT);
+
+        if (verbose) cout << "\tMany records, including a large one." << endl;
+        {
+            const int NUM_RECORDS = 5000;
+
+            ball::Record       record;
+            bsl::string        binary;
+            bsl::ostringstream expected;
+
+            for (int i = 0; i < NUM_RECORDS; ++i) {
+                makeRecord(&record, i);
+                if (NUM_RECORDS / 2 == i) {
+                    const bsl::string large(200 * 1000, 'x');
+                    record.fixedFields().setMessage(large.c_str());
+                }
+                Util::encode(&binary, record);
+                formatter(expected, record);
+            }
+
+            bsl::istringstream input(binary);
+            bsl::ostringstream output;
+            int                numRecords = -1;
+
+            ASSERT(0 == Util::render(output, input, formatter, &numRecords));
+            ASSERTV(numRecords, NUM_RECORDS == numRecords);
+            ASSERT(expected.str() == output.str());
+        }
+
+        if (verbose) cout << "\tDamaged data." << endl;
+        {
+            ball::Record record;
+            bsl::string  frames[3];
+            bsl::string  text[3];
+
+            for (int i = 0; i < 3; ++i) {
+                makeRecord(&record, i);
+                Util::encode(&frames[i], record);
+
+                bsl::ostringstream oss;
+                formatter(oss, record);
+                text[i] = oss.str();
+            }
+
+            const char GARBAGE[] = "\xBA\x11garbage\xBA";
+
+            static const struct {
+                int         d_line;
+                const char *d_spec;      // 'A', 'B', 'C' are frames; 'g' is
+                                         // garbage; 'x' is frame 'B' with a
+                                         // damaged version byte
+                const char *d_expected;  // records expected to be rendered
+                int         d_status;    // expected return value
+            } DATA[] = {
+                //LINE  SPEC      EXPECTED  STATUS
+                //----  --------  --------  ------
+                { L_,   "",       "",       0      },
+                { L_,   "ABC",    "ABC",    0      },
+                { L_,   "gABC",   "ABC",    1      },
+                { L_,   "AgBC",   "ABC",    1      },
+                { L_,   "ABCg",   "ABC",    1      },
+                { L_,   "AggBgC", "ABC",    1      },
+                { L_,   "AxC",    "AC",     1      },
+                { L_,   "xxx",    "",       1      },
+                { L_,   "g",      "",       1      },
+            };
+            const int NUM_DATA = sizeof DATA / sizeof *DATA;
+
+            for (int ti = 0; ti < NUM_DATA; ++ti) {
+                const int         LINE     = DATA[ti].d_line;
+                const char *const SPEC     = DATA[ti].d_spec;
+                const char *const EXPECTED = DATA[ti].d_expected;
+                const int         STATUS   = DATA[ti].d_status;
+
+                bsl::string binary;
+                bsl::string expected;
+
+                for (const char *s = SPEC; *s; ++s) {
+                    if ('g' == *s) {
+                        binary.append(GARBAGE, sizeof GARBAGE - 1);
+                    }
+                    else if ('x' == *s) {
+                        bsl::string damaged(frames[1]);
+                        damaged[Util::k_FRAME_HEADER_SIZE] = '\xFF';
+                        binary += damaged;
+                    }
+                    else {
+                        binary += frames[*s - 'A'];
+                    }
+                }
+                for (const char *s = EXPECTED; *s; ++s) {
+                    expected += text[*s - 'A'];
+                }
+
+                bsl::istringstream input(binary);
+                bsl::ostringstream output;
+                int                numRecords = -1;
+
+                const int rc = Util::render(output,
+                                            input,
+                                            formatter,
+                                            &numRecords);
+
+                ASSERTV(LINE, rc, STATUS == rc);
+                ASSERTV(LINE, numRecords,
+                        static_cast<int>(bsl::strlen(EXPECTED)) == numRecords);
+                ASSERTV(LINE, expected == output.str());
+            }
+        }
+
+        if (verbose) cout << "\tTruncated input." << endl;
+        {
+            ball::Record record;
+            bsl::string  binary;
+
+            makeRecord(&record, 1);
+            Util::encode(&binary, record);
+
+            bsl::ostringstream expected;
+            formatter(expected, record);
+
+            const bsl::size_t firstLength = binary.length();
+
+            makeRecord(&record, 2);
+            Util::encode(&binary, record);
+
+            for (bsl::size_t length = firstLength;
+                 length < binary.length();
+                 ++length) {
+                bsl::istringstream input(binary.substr(0, length));
+                bsl::ostringstream output;
+                int                numRecords = -1;
+
+                const int rc = Util::render(output,
+                                            input,
+                                            formatter,
+                                            &numRecords);
+
+                ASSERTV(length, (firstLength == length ? 0 : 1) == rc);
+                ASSERTV(length, 1 == numRecords);
+                ASSERTV(length, expected.str() == output.str());
+            }
+        }
+
+        if (verbose) cout << "\tFailed output stream." << endl;
+        {
+            ball::Record record;
+            bsl::string  binary;
+
+            makeRecord(&record, 1);
+            Util::encode(&binary, record);
+
+            bsl::istringstream input(binary);
+            bsl::ostringstream output;
+            output.setstate(bsl::ios_base::badbit);
+
+            ASSERT(0 > Util::render(output, input, formatter));
+        }
+      } break;
+      case 4: {
+        // --------------------------------------------------------------------
+        // 'write'
+        //
+        // Concerns:
+        //: 1 'write' writes to the stream exactly the bytes that 'encode'
+        //:   appends, for small and large records.
+        //:
+        //: 2 'write' allocates no memory from the default allocator for a
+        //:   typical record.
+        //
+        // Plan:
+        //: 1 Compare the output of 'write' with the output of 'encode' for
+        //:   records having messages of various lengths, and monitor the
+        //:   default allocator.  (C-1..2)
+        //
+        // Testing:
+        //   void write(bsl::ostream& stream, const Record& record);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "'write'" << endl
+                          << "=======" << endl;
+
+        const int LENGTHS[] = { 0, 1, 100, 300, 1000, 5000 };
+        const int NUM_LENGTHS = sizeof LENGTHS / sizeof *LENGTHS;
+
+        for (int ti = 0; ti < NUM_LENGTHS; ++ti) {
+            const int LENGTH = LENGTHS[ti];
+
+            ball::Record record;
+            makeRecord(&record, ti);
+            record.fixedFields().setMessage(bsl::string(LENGTH, 'm').c_str());
+
+            bsl::string expected;
+            Util::encode(&expected, record);
+
+            bsl::ostringstream output;
+
+            bslma::TestAllocator         da("default", veryVeryVeryVerbose);
+            bslma::DefaultAllocatorGuard dag(&da);
+
+            Util::write(output, record);
+
+            if (LENGTH <= 300) {
+                ASSERTV(LENGTH, 0 == da.numAllocations());
+            }
+
+            ASSERTV(LENGTH, expected == output.str());
+        }
+      } break;
+      case 3: {
+        // --------------------------------------------------------------------
+        // 'decode' ERROR HANDLING
+        //
+        // Concerns:
+        //: 1 Every proper prefix of a frame, including the empty prefix, is
+        //:   reported as incomplete, and the reported frame length is the
+        //:   header size until the header is available, and the full frame
+        //:   length thereafter.
+        //:
+        //: 2 Input not starting with the magic bytes is rejected.
+        //:
+        //: 3 Frames having an unknown version, an unknown user field type, an
+        //:   invalid timestamp, an implausible payload length, or a payload
+        //:   length inconsistent with their contents are rejected.
+        //
+        // Plan:
+        //: 1 Decode every prefix of an encoded frame.  (C-1)
+        //:
+        //: 2 Corrupt each magic byte in turn.  (C-2)
+        //:
+        //: 3 Modify individual bytes of an encoded frame at known offsets.
+        //:   (C-3)
+        //
+        // Testing:
+        //   int decode(Record *, int *, const char *, size_t);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "'decode' ERROR HANDLING" << endl
+                          << "=======================" << endl;
+
+        ball::Record record;
+        makeRecord(&record, 7);
+
+        bsl::string frame;
+        Util::encode(&frame, record);
+
+        const int FRAME_LENGTH = static_cast<int>(frame.length());
+
+        if (verbose) cout << "\tIncomplete frames." << endl;
+
+        for (int length = 0; length < FRAME_LENGTH; ++length) {
+            ball::Record decoded;
+            int          frameLength = -1;
+
+            const int rc = Util::decode(&decoded,
+                                        &frameLength,
+                                        frame.data(),
+                                        length);
+
+            ASSERTV(length, 0 < rc);
+            if (length < Util::k_FRAME_HEADER_SIZE) {
+                ASSERTV(length, frameLength,
+                        Util::k_FRAME_HEADER_SIZE == frameLength);
+            }
+            else {
+                ASSERTV(length, frameLength, FRAME_LENGTH == frameLength);
+            }
+        }
+
+        if (verbose) cout << "\tBad magic." << endl;
+
+        for (int i = 0; i < 4; ++i) {
+            bsl::string damaged(frame);
+            damaged[i] = static_cast<char>(damaged[i] ^ 0x40);
+
+            ball::Record decoded;
+            int          frameLength;
+
+            ASSERTV(i, 0 > Util::decode(&decoded,
+                                        &frameLength,
+                                        damaged.data(),
+                                        damaged.length()));
+            ASSERTV(i, 0 > Util::decode(&decoded,
+                                        &frameLength,
+                                        damaged.data(),
+                                        i + 1));
+        }
+
+        if (verbose) cout << "\tBad payloads." << endl;
+        {
+            // Offsets within the frame ('k_FRAME_HEADER_SIZE' is 8).
+
+            const int VERSION_OFFSET = 8;
+            const int DAYS_OFFSET    = 9;
+            const int TIME_OFFSET    = 13;
+
+            static const struct {
+                int d_line;
+                int d_offset;
+                int d_value;
+            } DATA[] = {
+                //LINE  OFFSET               VALUE
+                //----  -------------------  -----
+                { L_,   4,                   0x01  },  // payload too short
+                { L_,   4,                   0xFF  },  // payload too long
+                { L_,   7,                   0x7F  },  // implausible length
+                { L_,   VERSION_OFFSET,      0     },
+                { L_,   VERSION_OFFSET,      2     },
+                { L_,   DAYS_OFFSET + 3,     0x80  },  // negative days
+                { L_,   DAYS_OFFSET + 2,     0x7F  },  // beyond 9999/12/31
+                { L_,   TIME_OFFSET + 7,     0x80  },  // negative time
+                { L_,   TIME_OFFSET + 5,     0x7F  },  // time beyond 24:00
+                { L_,   -1,                  0x7F  },  // unknown field type
+            };
+            const int NUM_DATA = sizeof DATA / sizeof *DATA;
+
+            // The last user field of the record is a "user" string: 1 type
+            // byte, 4 length bytes, and 4 characters.
+
+            const int LAST_FIELD_TYPE_OFFSET = FRAME_LENGTH - 9;
+
+            for (int ti = 0; ti < NUM_DATA; ++ti) {
+                const int LINE   = DATA[ti].d_line;
+                const int OFFSET = -1 == DATA[ti].d_offset
+                                   ? LAST_FIELD_TYPE_OFFSET
+                                   : DATA[ti].d_offset;
+                const int VALUE  = DATA[ti].d_value;
+
+                bsl::string damaged(frame);
+                damaged[OFFSET] = static_cast<char>(VALUE);
+
+                ball::Record decoded;
+                int          frameLength;
+
+                const int rc = Util::decode(&decoded,
+                                            &frameLength,
+                                            damaged.data(),
+                                            damaged.length());
+                if (4 == OFFSET && 0xFF == VALUE) {
+                    // The payload extends past the available data.
+
+                    ASSERTV(LINE, rc, 0 < rc);
+                }
+                else {
+                    ASSERTV(LINE, rc, 0 > rc);
+                }
+            }
+        }
+      } break;
+      case 2: {
+        // --------------------------------------------------------------------
+        // 'encode' AND 'decode' ROUND TRIP
+        //
+        // Concerns:
+        //: 1 'decode' restores every attribute of the encoded record,
+        //:   including boundary values of each attribute.
+        //:
+        //: 2 All user field types, including unset values, round-trip.
+        //:
+        //: 3 Messages may contain embedded null characters.
+        //:
+        //: 4 'encode' appends to, rather than replaces, its buffer.
+        //:
+        //: 5 'decode' replaces the user fields of the target record.
+        //
+        // Plan:
+        //: 1 Using the table-driven technique, encode records having boundary
+        //:   values for each attribute and verify that decoding each frame
+        //:   yields a record equal to the original.  (C-1, 3)
+        //:
+        //: 2 Encode a record having each type of user field and verify the
+        //:   round trip.  (C-2)
+        //:
+        //: 3 Encode several records into the same buffer and decode them in
+        //:   turn into a single record that initially holds user fields.
+        //:   (C-4..5)
+        //
+        // Testing:
+        //   void encode(bsl::string *buffer, const Record& record);
+        //   int decode(Record *, int *, const char *, size_t);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "'encode' AND 'decode' ROUND TRIP" << endl
+                          << "================================" << endl;
+
+        const int    INT_MAX_ = bsl::numeric_limits<int>::max();
+        const int    INT_MIN_ = bsl::numeric_limits<int>::min();
+        const Uint64 U64_MAX  = bsl::numeric_limits<Uint64>::max();
+
+        static const struct {
+            int         d_line;
+            int         d_year;
+            int         d_month;
+            int         d_day;
+            int         d_hour;
+            int         d_minute;
+            int         d_second;
+            int         d_msec;
+            int         d_usec;
+            int         d_processID;
+            Uint64      d_threadID;
+            int         d_severity;
+            const char *d_fileName;
+            int         d_lineNumber;
+            const char *d_category;
+        } DATA[] = {
+            { L_,    1,  1,  1, 24,  0,  0,   0,   0,  0, 0, 0, "",  0, ""  },
+            { L_,    1,  1,  1,  0,  0,  0,   0,   0,  1, 1, 1, "a", 1, "b" },
+            { L_, 9999, 12, 31, 23, 59, 59, 999, 999, -1, 2, 2, "f", 2, "c" },
+            { L_, 2020,  2, 29, 12, 34, 56, 789, 123, INT_MAX_, U64_MAX,
+                                                  INT_MAX_, "x.cpp",
+                                                  INT_MAX_, "CAT.SUB" },
+            { L_, 1970,  1,  1,  0,  0,  0,   0,   1, INT_MIN_, 12345,
+                                                  INT_MIN_, "y.cpp",
+                                                  INT_MIN_, "C" },
+        };
+        const int NUM_DATA = sizeof DATA / sizeof *DATA;
+
+        const bsl::string MESSAGES[] = {
+            "",
+            "hello",
+            bsl::string("embedded\0null", 13),
+            bsl::string(1000, 'z'),
+        };
+        const int NUM_MESSAGES = sizeof MESSAGES / sizeof *MESSAGES;
+
+        if (verbose) cout << "\tFixed fields." << endl;
+
+        for (int ti = 0; ti < NUM_DATA; ++ti) {
+            for (int mi = 0; mi < NUM_MESSAGES; ++mi) {
+                const int LINE = DATA[ti].d_line;
+
+                ball::Record record;
+                makeRecord(&record,
+                           bdlt::Datetime(DATA[ti].d_year,
+                                          DATA[ti].d_month,
+                                          DATA[ti].d_day,
+                                          DATA[ti].d_hour,
+                                          DATA[ti].d_minute,
+                                          DATA[ti].d_second,
+                                          DATA[ti].d_msec,
+                                          DATA[ti].d_usec),
+                           DATA[ti].d_processID,
+                           DATA[ti].d_threadID,
+                           DATA[ti].d_severity,
+                           DATA[ti].d_fileName,
+                           DATA[ti].d_lineNumber,
+                           DATA[ti].d_category,
+                           MESSAGES[mi]);
+
+                bsl::string buffer;
+                Util::encode(&buffer, record);
+
+                ball::Record decoded;
+                int          frameLength = -1;
+
+                ASSERTV(LINE, mi, 0 == Util::decode(&decoded,
+                                                    &frameLength,
+                                                    buffer.data(),
+                                                    buffer.length()));
+                ASSERTV(LINE, mi,
+                        static_cast<int>(buffer.length()) == frameLength);
+                ASSERTV(LINE, mi, record == decoded);
+                ASSERTV(LINE, mi,
+                        MESSAGES[mi] == decoded.fixedFields().messageRef());
+
+                if (veryVerbose) {
+                    P_(LINE) P_(mi) P(buffer.length());
+                }
+            }
+        }
+
+        if (verbose) cout << "\tUser fields." << endl;
+        {
+            ball::Record record;
+            makeRecord(&record, 3);
+
+            ball::UserFields& fields = record.customFields();
+
+            bsl::vector<char> array;
+            array.push_back('a');
+            array.push_back('\0');
+            array.push_back('\xFF');
+
+            fields.appendNull();
+            fields.appendInt64(0);
+            fields.appendInt64(bsl::numeric_limits<Int64>::min());
+            fields.appendInt64(bsl::numeric_limits<Int64>::max());
+            fields.appendDouble(0.1);
+            fields.appendDouble(-1.5e300);
+            fields.appendDouble(bsl::numeric_limits<double>::infinity());
+            fields.appendString("");
+            fields.appendString("value");
+            fields.appendDatetimeTz(bdlt::DatetimeTz());
+            fields.appendDatetimeTz(bdlt::DatetimeTz(
+                                    bdlt::Datetime(2020, 3, 4, 5, 6, 7, 8, 9),
+                                    -1439));
+            fields.appendDatetimeTz(bdlt::DatetimeTz(
+                                    bdlt::Datetime(2020, 3, 4, 5, 6, 7, 8, 9),
+                                    1439));
+            fields.appendCharArray(bsl::vector<char>());
+            fields.appendCharArray(array);
+
+            bsl::string buffer;
+            Util::encode(&buffer, record);
+
+            ball::Record decoded;
+            int          frameLength = -1;
+
+            ASSERT(0 == Util::decode(&decoded,
+                                     &frameLength,
+                                     buffer.data(),
+                                     buffer.length()));
+            ASSERT(static_cast<int>(buffer.length()) == frameLength);
+            ASSERT(record == decoded);
+        }
+
+        if (verbose) cout << "\tConsecutive frames." << endl;
+        {
+            const int NUM_RECORDS = 20;
+
+            bsl::string  buffer("prefix");
+            ball::Record record;
+
+            for (int i = 0; i < NUM_RECORDS; ++i) {
+                makeRecord(&record, i);
+                Util::encode(&buffer, record);
+            }
+            ASSERT(0 == buffer.compare(0, 6, "prefix"));
+
+            ball::Record decoded;
+            decoded.customFields().appendString("stale");
+            decoded.customFields().appendString("values");
+            decoded.customFields().appendString("here");
+
+            bsl::size_t offset = 6;
+            for (int i = 0; i < NUM_RECORDS; ++i) {
+                int frameLength = -1;
+                ASSERTV(i, 0 == Util::decode(&decoded,
+                                             &frameLength,
+                                             buffer.data() + offset,
+                                             buffer.length() - offset));
+                makeRecord(&record, i);
+                ASSERTV(i, record == decoded);
+                offset += frameLength;
+            }
+            ASSERT(buffer.length() == offset);
+        }
+      } break;
+      case 1: {
+        // --------------------------------------------------------------------
+        // BREATHING TEST
+        //   This case exercises (but does not fully test) basic functionality.
+        //
+        // Concerns:
+        //: 1 The class is sufficiently functional to enable comprehensive
+        //:   testing in subsequent test cases.
+        //
+        // Plan:
+        //: 1 Encode a record, decode it, and render it.  (C-1)
+        //
+        // Testing:
+        //   BREATHING TEST
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "BREATHING TEST" << endl
+                          << "==============" << endl;
+
+        ball::Record record;
+        makeRecord(&record, 1);
+
+        bsl::string buffer;
+        Util::encode(&buffer, record);
+        ASSERT(Util::k_FRAME_HEADER_SIZE < static_cast<int>(buffer.length()));
+
+        ball::Record decoded;
+        int          frameLength = -1;
+
+        ASSERT(0 == Util::decode(&decoded,
+                                 &frameLength,
+                                 buffer.data(),
+                                 buffer.length()));
+        ASSERT(static_cast<int>(buffer.length()) == frameLength);
+        ASSERT(record == decoded);
+
+        ball::RecordStringFormatter formatter(FORMAT);
+        bsl::ostringstream          expected;
+        formatter(expected, record);
+
+        bsl::istringstream input(buffer);
+        bsl::ostringstream output;
+
+        ASSERT(0 == Util::render(output, input, formatter));
+        ASSERT(expected.str() == output.str());
+
+        if (veryVerbose) {
+            P(output.str());
+        }
+      } break;
+      case -1: {
+        // --------------------------------------------------------------------
+        // PERFORMANCE: 'write' VS. 'RecordStringFormatter'
+        //
+        // Concerns:
+        //: 1 Writing a record in binary form is substantially cheaper than
+        //:   formatting it as text.
+        //
+        // Plan:
+        //: 1 Time writing a typical record to a string stream many times,
+        //:   using 'write' and using a formatter with the default file
+        //:   observer format, and report the times.  (C-1)
+        //
+        // Testing:
+        //   PERFORMANCE: 'write' VS. 'RecordStringFormatter'
+        // --------------------------------------------------------------------
+
+        cout << endl
+             << "PERFORMANCE: 'write' VS. 'RecordStringFormatter'" << endl
+             << "================================================" << endl;
+
+        const int NUM_ITERATIONS = argc > 2 ? atoi(argv[2]) : 1000000;
+
+        ball::Record record;
+        makeRecord(&record, 17);
+        record.fixedFields().setMessage(
+                    "order 12345 accepted: 100 shares at 37.25 for ACCOUNT-7");
+
+        ball::RecordStringFormatter formatter(FORMAT);
+
+        bsls::Stopwatch    timer;
+        bsl::ostringstream textOutput;
+
+        timer.start();
+        for (int i = 0; i < NUM_ITERATIONS; ++i) {
+            formatter(textOutput, record);
+            if (0 == (i & 1023)) {
+                textOutput.str("");
+            }
+        }
+        timer.stop();
+        const double textTime = timer.elapsedTime();
+
+        bsl::ostringstream binaryOutput;
+
+        timer.reset();
+        timer.start();
+        for (int i = 0; i < NUM_ITERATIONS; ++i) {
+            Util::write(binaryOutput, record);
+            if (0 == (i & 1023)) {
+                binaryOutput.str("");
+            }
+        }
+        timer.stop();
+        const double binaryTime = timer.elapsedTime();
+
+        cout << "text:   " << textTime   * 1e9 / NUM_ITERATIONS
+             << " ns/record" << endl
+             << "binary: " << binaryTime * 1e9 / NUM_ITERATIONS
+             << " ns/record" << endl;
+      } break;
+      default: {
+        cerr << "WARNING: CASE `" << test << "' NOT FOUND." << endl;
+        testStatus = -1;
+      }
+    }
+
+    // CONCERN: In no case does memory come from the global allocator.
+
+    ASSERTV(globalAllocator.numBlocksTotal(),
+            0 == globalAllocator.numBlocksTotal());
+
+    if (testStatus > 0) {
+        cerr << "Error, non-zero test status = " << testStatus << "." << endl;
+    }
+    return testStatus;
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2020 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
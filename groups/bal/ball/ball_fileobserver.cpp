@@ -236,6 +236,24 @@ void FileObserver::publish(const Record& record, const Context& context)
     d_fileObserver2.publish(record, context);
 }
 
+void FileObserver::publishDeferred(const Record&  record,
+                                   const Context& context)
+{
+    bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+
+    if (record.fixedFields().severity() <= d_stdoutThreshold) {
+        bsl::ostringstream oss;
+        d_stdoutFormatter(oss, record);
+
+        // Use 'fwrite' to specify the length to write.
+
+        bsl::fwrite(oss.str().c_str(), 1, oss.str().length(), stdout);
+        bsl::fflush(stdout);
+    }
+
+    d_fileObserver2.publishDeferred(record, context);
+}
+
 void FileObserver::setLogFormat(const char *logFileFormat,
                                 const char *stdoutFormat)
 {
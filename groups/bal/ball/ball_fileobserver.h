@@ -26,19 +26,24 @@ BSLS_IDENT("$Id: $")
 //                         |              disableSizeRotation
 //                         |              disableStdoutLoggingPrefix
 //                         |              disablePublishInLocalTime
+//                         |              disableRotatedFileCompression
 //                         |              enableFileLogging
 //                         |              enableStdoutLoggingPrefix
 //                         |              enablePublishInLocalTime
+//                         |              enableRotatedFileCompression
 //                         |              forceRotation
+//                         |              publishDeferred
 //                         |              rotateOnSize
 //                         |              rotateOnTimeInterval
 //                         |              setOnFileRotationCallback
 //                         |              setStdoutThreshold
 //                         |              setLogFormat
+//                         |              writeDeferredRecords
 //                         |              getLogFormat
 //                         |              isFileLoggingEnabled
 //                         |              isStdoutLoggingPrefixEnabled
 //                         |              isPublishInLocalTimeEnabled
+//                         |              isRotatedFileCompressionEnabled
 //                         |              rotationLifetime
 //                         |              rotationSize
 //                         |              stdoutThreshold
@@ -545,6 +550,12 @@ class FileObserver : public Observer {
         // enabled.  Note that this method also affects log filenames (see {Log
         // Filename Patterns}).
 
+    void disableRotatedFileCompression();
+        // Disable the compression of log files subsequently rotated by this
+        // file observer.  This method has no effect if rotated file
+        // compression is not enabled.  Note that the rotated log files already
+        // submitted for compression are still compressed.
+
     int enableFileLogging(const char *logFilenamePattern);
         // Enable logging of all records published to this file observer to a
         // file whose name is derived from the specified 'logFilenamePattern'.
@@ -609,6 +620,15 @@ class FileObserver : public Observer {
         // in local time is already enabled.  Note that this method also
         // affects log filenames (see {Log Filename Patterns}).
 
+    int enableRotatedFileCompression();
+        // Enable the compression, in the gzip format and on a background
+        // thread, of each log file subsequently rotated by this file observer.
+        // Return 0 on success, and a non-zero value if the background thread
+        // could not be started, in which case rotated log files are not
+        // compressed.  This method has no effect (and returns 0) if rotated
+        // file compression is already enabled.  See
+        // {'ball_fileobserver2'|Rotated File Compression}.
+
     void publish(const Record& record, const Context& context);
         // Process the specified log 'record' having the specified publishing
         // 'context' by writing 'record' and 'context' to the current log file
@@ -625,6 +645,17 @@ class FileObserver : public Observer {
         // 'record' is at least as severe as the value returned by
         // 'stdoutThreshold'.
 
+    void publishDeferred(const Record& record, const Context& context);
+        // Process the specified log 'record' having the specified publishing
+        // 'context' by writing 'record' and 'context' to 'stdout' if the
+        // severity of 'record' is at least as severe as the value returned by
+        // 'stdoutThreshold', and, if file logging is enabled for this file
+        // observer, by formatting 'record' into an in-memory buffer to be
+        // written to the current log file by the next call to
+        // 'writeDeferredRecords' (or by any operation that writes to, rotates,
+        // or closes the log file).  See {Deferred Publication} in
+        // 'ball_fileobserver2'.
+
     void releaseRecords();
         // Discard any shared references to 'Record' objects that were supplied
         // to the 'publish' method, and are held by this observer.  Note that
@@ -696,6 +727,11 @@ class FileObserver : public Observer {
         // needs to add them explicitly to the format string to preserve this
         // behavior.
 
+    void writeDeferredRecords();
+        // Write all records supplied to 'publishDeferred' since the last write
+        // to the log file of this file observer using a single 'write' system
+        // call.  This method has no effect if there are no such records.
+
     // ACCESSORS
     bslma::Allocator *allocator() const;
         // Return the memory allocator used by this object.
@@ -736,6 +772,10 @@ class FileObserver : public Observer {
         // value returned by this method also affects log filenames (see {Log
         // Filename Patterns}).
 
+    bool isRotatedFileCompressionEnabled() const;
+        // Return 'true' if the log files rotated by this file observer are
+        // compressed, and 'false' otherwise.
+
     bdlt::DatetimeInterval localTimeOffset() const;
         // Return the difference between the local time and UTC time in effect
         // when this file observer was constructed.  Note that this value
@@ -784,6 +824,12 @@ void FileObserver::disableLifetimeRotation()
     d_fileObserver2.disableTimeIntervalRotation();
 }
 
+inline
+void FileObserver::disableRotatedFileCompression()
+{
+    d_fileObserver2.disableRotatedFileCompression();
+}
+
 inline
 void FileObserver::disableSizeRotation()
 {
@@ -810,6 +856,12 @@ int FileObserver::enableFileLogging(const char *logFilenamePattern,
                                              appendTimestampFlag);
 }
 
+inline
+int FileObserver::enableRotatedFileCompression()
+{
+    return d_fileObserver2.enableRotatedFileCompression();
+}
+
 inline
 void FileObserver::forceRotation()
 {
@@ -861,6 +913,12 @@ void FileObserver::setOnFileRotationCallback(
     d_fileObserver2.setOnFileRotationCallback(onRotationCallback);
 }
 
+inline
+void FileObserver::writeDeferredRecords()
+{
+    d_fileObserver2.writeDeferredRecords();
+}
+
 // ACCESSORS
 inline
 bool FileObserver::isFileLoggingEnabled() const
@@ -874,6 +932,12 @@ bool FileObserver::isFileLoggingEnabled(bsl::string *result) const
     return d_fileObserver2.isFileLoggingEnabled(result);
 }
 
+inline
+bool FileObserver::isRotatedFileCompressionEnabled() const
+{
+    return d_fileObserver2.isRotatedFileCompressionEnabled();
+}
+
 inline
 bdlt::DatetimeInterval FileObserver::localTimeOffset() const
 {
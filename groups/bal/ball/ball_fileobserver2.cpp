@@ -36,6 +36,7 @@ BSLS_IDENT_RCSID(ball_fileobserver2_cpp,"$Id$ $CSID$")
 
 #include <bslstl_stringref.h>
 
+#include <bsl_climits.h>
 #include <bsl_cstdio.h>
 #include <bsl_cstring.h>
 #include <bsl_iomanip.h>
@@ -365,6 +366,17 @@ static bdlt::Datetime computeNextRotationTime(
                           // -------------------
 
 // PRIVATE MANIPULATORS
+void FileObserver2::invokeRotationCallback(
+                                         int                rotationStatus,
+                                         const bsl::string& rotatedLogFileName)
+{
+    bslmt::LockGuard<bslmt::Mutex> guard(&d_rotationCbMutex);
+
+    if (d_onRotationCb) {
+        d_onRotationCb(rotationStatus, rotatedLogFileName);
+    }
+}
+
 void FileObserver2::logRecordDefault(bsl::ostream& stream,
                                      const Record& record)
 
@@ -420,6 +432,34 @@ void FileObserver2::logRecordDefault(bsl::ostream& stream,
     stream.flush();
 }
 
+void FileObserver2::onRotatedFileCompressed(int, const bsl::string& fileName)
+{
+    // 'fileName' names the compressed file on success, and the (complete)
+    // rotated log file otherwise.
+
+    invokeRotationCallback(k_ROTATE_SUCCESS, fileName);
+}
+
+void FileObserver2::onRotation(int                rotationStatus,
+                               const bsl::string& rotatedLogFileName,
+                               bool               compressFlag)
+{
+    if (0 < rotationStatus) {
+        return;                                                       // RETURN
+    }
+
+    if (compressFlag && k_ROTATE_SUCCESS == rotationStatus) {
+        d_compressor.compressFileAsync(
+                                    rotatedLogFileName,
+                                    bdlf::MemFnUtil::memFn(
+                                      &FileObserver2::onRotatedFileCompressed,
+                                      this));
+        return;                                                       // RETURN
+    }
+
+    invokeRotationCallback(rotationStatus, rotatedLogFileName);
+}
+
 int FileObserver2::rotateFile(bsl::string *rotatedLogFileName)
 {
     BSLS_ASSERT(rotatedLogFileName);
@@ -430,6 +470,11 @@ int FileObserver2::rotateFile(bsl::string *rotatedLogFileName)
 
     BSLS_ASSERT(d_logFilePattern.size() > 0);
 
+    // Records buffered by 'publishDeferred' belong to the log file being
+    // closed.
+
+    writeDeferredRecordsRaw();
+
     int returnStatus = k_ROTATE_SUCCESS;
 
     if (0 != d_logStreamBuf.clear()) {
@@ -528,7 +573,14 @@ int FileObserver2::rotateIfNecessary(bsl::string           *rotatedLogFileName,
         // 'tellp' returns -1 on failure.  Rotate the log file if either
         // 'tellp' fails, or the rotation size is exceeded.
 
-        if (static_cast<bsls::Types::Uint64>(d_logOutStream.tellp()) >
+        // Records buffered by 'publishDeferred' count toward the size of the
+        // log file.
+
+        const bsls::Types::Int64 position = d_logOutStream.tellp();
+
+        if (0 > position
+         || static_cast<bsls::Types::Uint64>(position)
+                                            + d_deferredStreamBuf.length() >
             static_cast<bsls::Types::Uint64>(d_rotationSize) * 1024) {
 
             return rotateFile(rotatedLogFileName);                    // RETURN
@@ -543,6 +595,67 @@ int FileObserver2::rotateIfNecessary(bsl::string           *rotatedLogFileName,
     return 1;
 }
 
+int FileObserver2::writeDeferredRecordsRaw()
+{
+    const char  *data   = d_deferredStreamBuf.data();
+    bsl::size_t  length = d_deferredStreamBuf.length();
+
+    if (0 == length) {
+        return 0;                                                     // RETURN
+    }
+
+    // Rewind (rather than 'reset') the buffer so that its capacity is reused
+    // by the next batch.
+
+    d_deferredStreamBuf.pubseekpos(0, bsl::ios_base::out);
+
+    if (!d_logStreamBuf.isOpened()) {
+        return 0;                                                     // RETURN
+    }
+
+    // Flush any output buffered by 'd_logStreamBuf' before writing directly
+    // to the underlying file descriptor, so that records are written in
+    // order and 'tellp' remains accurate.
+
+    int rc = d_logOutStream.flush() ? 0 : -1;
+
+    const bdls::FilesystemUtil::FileDescriptor fd =
+                                               d_logStreamBuf.fileDescriptor();
+
+    while (0 == rc && 0 < length) {
+        const int numBytes = length > static_cast<bsl::size_t>(INT_MAX)
+                             ? INT_MAX
+                             : static_cast<int>(length);
+        const int numWritten = bdls::FilesystemUtil::write(fd,
+                                                           data,
+                                                           numBytes);
+        if (0 >= numWritten) {
+            rc = -1;
+            break;
+        }
+        data   += numWritten;
+        length -= numWritten;
+    }
+
+    if (0 != rc) {
+        char errorBuffer[256];
+
+        snprintf(errorBuffer,
+                 sizeof errorBuffer,
+                 "Error on file stream for %s: %s.",
+                 d_logFileName.c_str(),
+                 bsl::strerror(getErrorCode()));
+        bsls::Log::platformDefaultMessageHandler(bsls::LogSeverity::e_ERROR,
+                                                 __FILE__,
+                                                 __LINE__,
+                                                 errorBuffer);
+
+        d_logStreamBuf.clear();
+    }
+
+    return rc;
+}
+
 // CREATORS
 FileObserver2::FileObserver2(bslma::Allocator *basicAllocator)
 : d_logStreamBuf(bdls::FilesystemUtil::k_INVALID_FD,
@@ -551,6 +664,8 @@ FileObserver2::FileObserver2(bslma::Allocator *basicAllocator)
                  false,
                  basicAllocator)
 , d_logOutStream(&d_logStreamBuf)
+, d_deferredStreamBuf(basicAllocator)
+, d_deferredOutStream(&d_deferredStreamBuf)
 , d_logFilePattern(basicAllocator)
 , d_logFileName(basicAllocator)
 , d_logFileFunctor(
@@ -564,11 +679,15 @@ FileObserver2::FileObserver2(bslma::Allocator *basicAllocator)
                  bsl::allocator<FileObserver2::OnFileRotationCallback>(
                                                                basicAllocator))
 , d_rotationCbMutex()
+, d_compressRotatedFiles(false)
+, d_compressor(basicAllocator)
 {
 }
 
 FileObserver2::~FileObserver2()
 {
+    writeDeferredRecordsRaw();
+
     if (d_logStreamBuf.isOpened()) {
         d_logStreamBuf.clear();
     }
@@ -579,6 +698,8 @@ void FileObserver2::disableFileLogging()
 {
     bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
 
+    writeDeferredRecordsRaw();
+
     if (d_logStreamBuf.isOpened()) {
         d_logStreamBuf.clear();
     }
@@ -596,6 +717,13 @@ void FileObserver2::disablePublishInLocalTime()
     d_publishInLocalTime = false;
 }
 
+void FileObserver2::disableRotatedFileCompression()
+{
+    bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+
+    d_compressRotatedFiles = false;
+}
+
 void FileObserver2::disableSizeRotation()
 {
     bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
@@ -663,20 +791,17 @@ void FileObserver2::forceRotation()
 {
     bsl::string rotatedLogFileName;
     int         rotationStatus;
+    bool        compressFlag;
     {
         bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
         rotationStatus = rotateFile(&rotatedLogFileName);
+        compressFlag   = d_compressRotatedFiles;
     }
 
     // The file-rotation callback must be invoked without a lock on 'd_mutex'
     // to allow the callback to invoke other manipulators on this object.
 
-    if (0 >= rotationStatus) {
-        bslmt::LockGuard<bslmt::Mutex> guard(&d_rotationCbMutex);
-        if (d_onRotationCb) {
-            d_onRotationCb(rotationStatus, rotatedLogFileName);
-        }
-    }
+    onRotation(rotationStatus, rotatedLogFileName, compressFlag);
 }
 
 void FileObserver2::enablePublishInLocalTime()
@@ -685,15 +810,36 @@ void FileObserver2::enablePublishInLocalTime()
     d_publishInLocalTime = true;
 }
 
+int FileObserver2::enableRotatedFileCompression()
+{
+    bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+
+    if (d_compressRotatedFiles) {
+        return 0;                                                     // RETURN
+    }
+
+    const int rc = d_compressor.start();
+    if (0 != rc) {
+        return rc;                                                    // RETURN
+    }
+
+    d_compressRotatedFiles = true;
+    return 0;
+}
+
 void FileObserver2::publish(const Record& record, const Context&)
 {
     bsl::string rotatedFileName;
     int         rotationStatus;
+    bool        compressFlag;
 
     {
         bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
         rotationStatus = rotateIfNecessary(&rotatedFileName,
                                            record.fixedFields().timestamp());
+        compressFlag   = d_compressRotatedFiles;
+
+        writeDeferredRecordsRaw();
 
         if (d_logStreamBuf.isOpened()) {
             d_logFileFunctor(d_logOutStream, record);
@@ -717,13 +863,31 @@ void FileObserver2::publish(const Record& record, const Context&)
         }
     }
 
-    if (0 >= rotationStatus) {
-        bslmt::LockGuard<bslmt::Mutex> guard(&d_rotationCbMutex);
+    onRotation(rotationStatus, rotatedFileName, compressFlag);
+}
+
+void FileObserver2::publishDeferred(const Record& record, const Context&)
+{
+    bsl::string rotatedFileName;
+    int         rotationStatus;
+    bool        compressFlag;
+
+    {
+        bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+        rotationStatus = rotateIfNecessary(&rotatedFileName,
+                                           record.fixedFields().timestamp());
+        compressFlag   = d_compressRotatedFiles;
+
+        if (d_logStreamBuf.isOpened()) {
+            // Note that flushing 'd_deferredOutStream' (as the formatting
+            // functor typically does) does not result in a system call.
 
-        if (d_onRotationCb) {
-            d_onRotationCb(rotationStatus, rotatedFileName);
+            d_logFileFunctor(d_deferredOutStream, record);
+            d_deferredOutStream.clear();
         }
     }
+
+    onRotation(rotationStatus, rotatedFileName, compressFlag);
 }
 
 void FileObserver2::rotateOnLifetime(
@@ -784,6 +948,13 @@ void FileObserver2::setOnFileRotationCallback(
     d_onRotationCb = onRotationCallback;
 }
 
+void FileObserver2::writeDeferredRecords()
+{
+    bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+
+    writeDeferredRecordsRaw();
+}
+
 // ACCESSORS
 bool FileObserver2::isFileLoggingEnabled() const
 {
@@ -813,6 +984,13 @@ bool FileObserver2::isPublishInLocalTimeEnabled() const
     return d_publishInLocalTime;
 }
 
+bool FileObserver2::isRotatedFileCompressionEnabled() const
+{
+    bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+
+    return d_compressRotatedFiles;
+}
+
 bdlt::DatetimeInterval FileObserver2::localTimeOffset() const
 {
     bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
@@ -12,7 +12,7 @@ BSLS_IDENT("$Id: $")
 //  ball::FileObserver2: observer that outputs log records to a file
 //
 //@SEE_ALSO: ball_record, ball_context, ball_observer,
-//           ball_recordstringformatter
+//           ball_recordstringformatter, ball_logfilecompressor
 //
 //@DESCRIPTION: This component provides a concrete implementation of the
 // 'ball::Observer' protocol, 'ball::FileObserver2', for publishing log records
@@ -27,15 +27,20 @@ BSLS_IDENT("$Id: $")
 //                         |              disableTimeIntervalRotation
 //                         |              disableSizeRotation
 //                         |              disablePublishInLocalTime
+//                         |              disableRotatedFileCompression
 //                         |              enableFileLogging
 //                         |              enablePublishInLocalTime
+//                         |              enableRotatedFileCompression
 //                         |              forceRotation
+//                         |              publishDeferred
 //                         |              rotateOnSize
 //                         |              rotateOnTimeInterval
 //                         |              setLogFileFunctor
 //                         |              setOnFileRotationCallback
+//                         |              writeDeferredRecords
 //                         |              isFileLoggingEnabled
 //                         |              isPublishInLocalTimeEnabled
+//                         |              isRotatedFileCompressionEnabled
 //                         |              rotationLifetime
 //                         |              rotationSize
 //                         V
@@ -80,6 +85,11 @@ BSLS_IDENT("$Id: $")
 // |             | disableTimeIntervalRotation |                              |
 // |             | setOnFileRotationCallback   |                              |
 // +-------------+-----------------------------+------------------------------+
+// | Rotated     | enableRotatedFile-          | isRotatedFileCompression-    |
+// | File        |             Compression     |                     Enabled  |
+// | Compression | disableRotatedFile-         |                              |
+// |             |             Compression     |                              |
+// +-------------+-----------------------------+------------------------------+
 //..
 // In general, a 'ball::FileObserver2' object can be dynamically configured
 // throughout its lifetime (in particular, before or after being registered
@@ -171,6 +181,21 @@ BSLS_IDENT("$Id: $")
 // 01-May-2011 at 12:30:00 local time (assuming 'enablePublishInLocalTime' was
 // called).
 //
+///Deferred Publication
+///--------------------
+// By default, each record received through 'publish' is formatted and written
+// to the log file immediately, which (for the default and most user-supplied
+// formats) costs one 'write' system call per record.  Clients that publish
+// records in bursts (e.g., a thread draining a queue of records, as is done by
+// 'ball_asyncfileobserver') may instead supply records to 'publishDeferred',
+// which formats each record into an in-memory buffer, and then call
+// 'writeDeferredRecords' to write the whole buffer to the log file using a
+// single 'write' system call.  Rotation conditions are evaluated for each
+// deferred record as if it had already been written, and buffered records are
+// always written to the log file before it is rotated or closed, or before a
+// record supplied to 'publish' is written, so the order of records in the log
+// file is the order in which they were received.
+//
 ///Log File Rotation
 ///-----------------
 // A 'ball::FileObserver2' may be configured to perform automatic rotation of
@@ -238,6 +263,35 @@ BSLS_IDENT("$Id: $")
 // in the filename.  In any case, logging resumes to a new, initially empty,
 // file.
 //
+///Rotated File Compression
+/// - - - - - - - - - - - -
+// Rotated log files may be compressed to reduce the disk space (and the disk
+// bandwidth of subsequent transfers) they consume.  When
+// 'enableRotatedFileCompression' is in effect, each log file that is rotated
+// successfully is handed to a background thread owned by the file observer
+// (see 'ball_logfilecompressor'), which writes its contents, in the gzip
+// format, to a file having the name of the rotated log file followed by
+// ".gz", and then removes the rotated log file.  The thread that triggers the
+// rotation (e.g., the thread that calls 'publish') never waits on the
+// compression; rotated files are compressed one at a time, in order of
+// rotation.  Compressed files can be read with standard tools (e.g., 'zcat',
+// 'zgrep').  Continuing the example above, when compression is enabled the
+// rotated log file "a.log.20110520_123000" is replaced by
+// "a.log.20110520_123000.gz".
+//
+// When compression is enabled, the callback supplied to
+// 'setOnFileRotationCallback' is invoked for a successful rotation only once
+// the compression of the rotated file is complete, from the background
+// thread, and with the name of the compressed file (or, if the file could not
+// be compressed, with the name of the uncompressed rotated file, which is
+// then left in place).  The callback is invoked as before, from the thread
+// that attempted the rotation, for a rotation that failed.  Hence a callback
+// that processes rotated files -- in particular the callback installed by
+// 'ball::LogFileCleanerUtil::enableLogFileCleanup', whose file patterns match
+// the ".gz" suffix -- observes each rotated file in its final state.  Files
+// pending compression when the file observer is destroyed are compressed by
+// its destructor.
+//
 ///Thread Safety
 ///-------------
 // All methods of 'ball::FileObserver2' are thread-safe, and can be called
@@ -302,11 +356,14 @@ BSLS_IDENT("$Id: $")
 
 #include <balscm_version.h>
 
+#include <ball_logfilecompressor.h>
 #include <ball_observer.h>
 #include <ball_severity.h>
 
 #include <bdls_fdstreambuf.h>
 
+#include <bdlsb_memoutstreambuf.h>
+
 #include <bdlt_datetime.h>
 #include <bdlt_datetimeinterval.h>
 
@@ -369,6 +426,16 @@ class FileObserver2 : public Observer {
                                                        // file logging (refers
                                                        // to 'd_logStreamBuf')
 
+    bdlsb::MemOutStreamBuf d_deferredStreamBuf;        // in-memory buffer of
+                                                       // formatted records
+                                                       // not yet written to
+                                                       // the log file
+
+    bsl::ostream           d_deferredOutStream;        // output stream for
+                                                       // deferred records
+                                                       // (refers to the
+                                                       // deferred buffer)
+
     bsl::string            d_logFilePattern;           // log filename pattern
 
     bsl::string            d_logFileName;              // current log filename
@@ -419,6 +486,19 @@ class FileObserver2 : public Observer {
                                                        // called with 'd_mutex'
                                                        // unlocked
 
+    bool                   d_compressRotatedFiles;     // 'true' if rotated
+                                                       // log files are
+                                                       // compressed
+
+    LogFileCompressor      d_compressor;               // compresses rotated
+                                                       // log files in the
+                                                       // background (declared
+                                                       // last, so that
+                                                       // pending compressions
+                                                       // complete before the
+                                                       // callback is
+                                                       // destroyed)
+
   private:
     // NOT IMPLEMENTED
     FileObserver2(const FileObserver2&);
@@ -426,10 +506,36 @@ class FileObserver2 : public Observer {
 
   private:
     // PRIVATE MANIPULATORS
+    void invokeRotationCallback(int                rotationStatus,
+                                const bsl::string& rotatedLogFileName);
+        // Invoke the file-rotation callback of this file observer, if any,
+        // with the specified 'rotationStatus' and 'rotatedLogFileName'.  The
+        // behavior is undefined if the caller holds the lock for this object.
+
     void logRecordDefault(bsl::ostream& stream, const Record& record);
         // Write the specified log 'record' to the specified output 'stream'
         // using the default record format of this file observer.
 
+    void onRotatedFileCompressed(int                compressionStatus,
+                                 const bsl::string& fileName);
+        // Invoke the file-rotation callback of this file observer, if any,
+        // for the successful rotation of a log file whose compression
+        // completed with the specified 'compressionStatus', leaving the
+        // specified 'fileName'.  Note that the rotation itself succeeded
+        // regardless of 'compressionStatus'.
+
+    void onRotation(int                rotationStatus,
+                    const bsl::string& rotatedLogFileName,
+                    bool               compressFlag);
+        // Complete a log file rotation attempt having the specified
+        // 'rotationStatus' and 'rotatedLogFileName': if the specified
+        // 'compressFlag' is 'true' and the rotation succeeded, submit the
+        // rotated log file for compression, and invoke the file-rotation
+        // callback once the compression completes; otherwise, invoke the
+        // file-rotation callback immediately.  This method has no effect if
+        // 'rotationStatus' is positive (i.e., no rotation was attempted).  The
+        // behavior is undefined if the caller holds the lock for this object.
+
     int rotateFile(bsl::string *rotatedLogFileName);
         // Perform a log file rotation by closing the current log file of this
         // file observer, renaming the closed log file if necessary, and
@@ -453,6 +559,14 @@ class FileObserver2 : public Observer {
         // and the 'rotateOnSize' methods, respectively.  The behavior is
         // undefined unless the caller acquired the lock for this object.
 
+    int writeDeferredRecordsRaw();
+        // Write any records buffered by 'publishDeferred' to the current log
+        // file of this file observer using a single write operation and clear
+        // the buffer.  Return 0 on success, and a non-zero value otherwise.
+        // Buffered records are discarded if file logging is not enabled, and
+        // file logging is disabled if the write fails.  The behavior is
+        // undefined unless the caller acquired the lock for this object.
+
   public:
     // TRAITS
     BSLMF_NESTED_TRAIT_DECLARATION(FileObserver2, bslma::UsesBslmaAllocator);
@@ -470,7 +584,9 @@ class FileObserver2 : public Observer {
 
     ~FileObserver2();
         // Close the log file of this file observer if file logging is enabled,
-        // and destroy this file observer.
+        // complete the compression of any rotated log files pending
+        // compression (see {Rotated File Compression}), and destroy this file
+        // observer.
 
     // MANIPULATORS
     void disableFileLogging();
@@ -503,6 +619,12 @@ class FileObserver2 : public Observer {
         // enabled.  Note that this method also affects log filenames (see {Log
         // Filename Patterns}).
 
+    void disableRotatedFileCompression();
+        // Disable the compression of log files subsequently rotated by this
+        // file observer.  This method has no effect if rotated file
+        // compression is not enabled.  Note that the rotated log files already
+        // submitted for compression are still compressed.
+
     int enableFileLogging(const char *logFilenamePattern);
         // Enable logging of all records published to this file observer to a
         // file whose name is derived from the specified 'logFilenamePattern'.
@@ -550,12 +672,22 @@ class FileObserver2 : public Observer {
         // in local time is already enabled.  Note that this method also
         // affects log filenames (see {Log Filename Patterns}).
 
+    int enableRotatedFileCompression();
+        // Enable the compression, in the gzip format and on a background
+        // thread, of each log file subsequently rotated by this file observer.
+        // Return 0 on success, and a non-zero value if the background thread
+        // could not be started, in which case rotated log files are not
+        // compressed.  This method has no effect (and returns 0) if rotated
+        // file compression is already enabled.  See {Rotated File
+        // Compression}.
+
     void publish(const Record& record, const Context& context);
         // Process the specified log 'record' having the specified publishing
         // 'context' by writing 'record' and 'context' to the current log file
         // if file logging is enabled for this file observer.  The method has
         // no effect if file logging is not enabled, in which case 'record' is
-        // dropped.
+        // dropped.  Note that any records previously supplied to
+        // 'publishDeferred' are written to the log file before 'record'.
 
     void publish(const bsl::shared_ptr<const Record>& record,
                  const Context&                       context);
@@ -565,6 +697,15 @@ class FileObserver2 : public Observer {
         // enabled for this file observer.  The method has no effect if file
         // logging is not enabled, in which case 'record' is dropped.
 
+    void publishDeferred(const Record& record, const Context& context);
+        // Process the specified log 'record' having the specified publishing
+        // 'context' by formatting 'record' into the in-memory buffer of this
+        // file observer if file logging is enabled, to be written to the log
+        // file by the next call to 'writeDeferredRecords' (or by any operation
+        // that writes to, rotates, or closes the log file).  The method has no
+        // effect if file logging is not enabled, in which case 'record' is
+        // dropped.  See {Deferred Publication}.
+
     void releaseRecords();
         // Discard any shared references to 'Record' objects that were supplied
         // to the 'publish' method, and are held by this observer.  Note that
@@ -620,11 +761,18 @@ class FileObserver2 : public Observer {
     void setOnFileRotationCallback(
                              const OnFileRotationCallback& onRotationCallback);
         // Set the specified 'onRotationCallback' to be invoked after each time
-        // this file observer attempts to perform a log file rotation.  The
-        // behavior is undefined if the supplied function calls either
-        // 'setOnFileRotationCallback', 'forceRotation', or 'publish' on this
-        // file observer (i.e., the supplied callback should *not* attempt to
-        // write to the 'ball' log).
+        // this file observer attempts to perform a log file rotation (and, if
+        // the rotated log file is compressed, after its compression; see
+        // {Rotated File Compression}).  The behavior is undefined if the
+        // supplied function calls either 'setOnFileRotationCallback',
+        // 'forceRotation', or 'publish' on this file observer (i.e., the
+        // supplied callback should *not* attempt to write to the 'ball' log).
+
+    void writeDeferredRecords();
+        // Write all records supplied to 'publishDeferred' since the last write
+        // to the log file of this file observer using a single 'write' system
+        // call.  This method has no effect if there are no such records.  See
+        // {Deferred Publication}.
 
     // ACCESSORS
     bool isFileLoggingEnabled() const;
@@ -643,6 +791,10 @@ class FileObserver2 : public Observer {
         // value returned by this method also affects log filenames (see {Log
         // Filename Patterns}).
 
+    bool isRotatedFileCompressionEnabled() const;
+        // Return 'true' if the log files rotated by this file observer are
+        // compressed, and 'false' otherwise.
+
     bdlt::DatetimeInterval rotationLifetime() const;
         // Return the lifetime of the log file that will trigger a file
         // rotation by this file observer if rotation-on-lifetime is in effect,
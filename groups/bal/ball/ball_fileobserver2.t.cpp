@@ -94,13 +94,16 @@ using bsl::flush;
 // [ 1] void disableFileLogging();
 // [ 2] void disableLifetimeRotation();
 // [ 1] void disablePublishInLocalTime();
+// [15] void disableRotatedFileCompression();
 // [ 2] void disableSizeRotation();
 // [ 8] void disableTimeIntervalRotation();
 // [ 1] int  enableFileLogging(const char *fileName);
 // [ 1] int  enableFileLogging(const char *fileName, bool timestampFlag);
 // [ 1] void enablePublishInLocalTime();
+// [15] int enableRotatedFileCompression();
 // [ 1] void publish(const Record& record, const Context& context);
 // [ 1] void publish(const shared_ptr<Record>&, const Context&);
+// [14] void publishDeferred(const Record&, const Context&);
 // [ 2] void forceRotation();
 // [ 2] void rotateOnSize(int size);
 // [ 2] void rotateOnLifetime(DatetimeInterval& interval);
@@ -108,15 +111,17 @@ using bsl::flush;
 // [ 9] void rotateOnTimeInterval(const DtInterval& i, const Datetime& s);
 // [ 1] void setLogFileFunctor(const logRecordFunctor& logFileFunctor);
 // [ 5] void setOnFileRotationCallback(const OnFileRotationCallback&);
+// [14] void writeDeferredRecords();
 //
 // ACCESSORS
 // [ 1] bool isFileLoggingEnabled() const;
 // [ 1] bool isFileLoggingEnabled(bsl::string *result) const;
 // [ 1] bool isPublishInLocalTimeEnabled() const;
+// [15] bool isRotatedFileCompressionEnabled() const;
 // [ 2] DatetimeInterval rotationLifetime() const;
 // [ 2] int rotationSize() const;
 // ----------------------------------------------------------------------------
-// [13] USAGE EXAMPLE
+// [16] USAGE EXAMPLE
 // [12] CONCERN: CURRENT LOCAL-TIME OFFSET IN TIMESTAMP
 // [11] CONCERN: TIME CALLBACKS ARE CALLED
 // [10] CONCERN: ROTATION CAN BE ENABLED AFTER FILE LOGGING
@@ -556,6 +561,32 @@ void publishRecord(Obj *observer, const char *message)
     observer->publish(record, context);
 }
 
+void publishDeferredRecord(Obj *observer, const char *message)
+    // Publish the specified 'message' to the specified 'observer' object using
+    // the 'publishDeferred' method.
+{
+    ball::RecordAttributes attr(bdlt::CurrentTime::utc(),
+                               1,
+                               2,
+                               "FILENAME",
+                               3,
+                               "CATEGORY",
+                               32,
+                               message);
+
+    ball::Record  record(attr, ball::UserFields());
+    ball::Context context(ball::Transmission::e_PASSTHROUGH, 0, 1);
+
+    observer->publishDeferred(record, context);
+}
+
+void logMessage(bsl::ostream& stream, const ball::Record& record)
+    // Write the message of the specified 'record', followed by a newline, to
+    // the specified 'stream' and flush 'stream'.
+{
+    stream << record.fixedFields().message() << '\n' << bsl::flush;
+}
+
 
 int getNumLines(const char *fileName)
     // Return the number of lines in the file with the specified 'fileName'.
@@ -712,7 +743,7 @@ int main(int argc, char *argv[])
     ASSERT(0 == bslma::Default::setDefaultAllocator(&defaultAllocator));
 
     switch (test) { case 0:
-      case 14: {
+      case 16: {
         // --------------------------------------------------------------------
         // USAGE EXAMPLE
         //
@@ -788,6 +819,305 @@ int main(int argc, char *argv[])
 //..
 
       } break;
+      case 15: {
+        // --------------------------------------------------------------------
+        // TESTING ROTATED FILE COMPRESSION
+        //
+        // Concerns:
+        //: 1 Rotated file compression is initially disabled, and can be
+        //:   enabled and disabled.
+        //:
+        //: 2 When compression is enabled, a rotated log file is replaced by a
+        //:   gzip file having the same name followed by ".gz", and the
+        //:   rotation callback is invoked once, with a status of 0 and the
+        //:   name of the compressed file.
+        //:
+        //: 3 Logging continues to the new log file while the rotated file is
+        //:   compressed.
+        //:
+        //: 4 When compression is disabled, rotated log files are left
+        //:   uncompressed and the rotation callback is invoked immediately.
+        //:
+        //: 5 All memory is supplied by the object allocator.
+        //
+        // Plan:
+        //: 1 Enable and disable compression, and verify the value returned by
+        //:   'isRotatedFileCompressionEnabled'.  (C-1)
+        //:
+        //: 2 Enable compression, publish records, force a rotation, publish
+        //:   more records, and destroy the observer (which completes the
+        //:   compression).  Verify the rotation callback, the compressed
+        //:   file, and the new log file.  (C-2..3, 5)
+        //:
+        //: 3 Repeat P-2 with compression disabled.  (C-4)
+        //
+        // Testing:
+        //   void disableRotatedFileCompression();
+        //   int enableRotatedFileCompression();
+        //   bool isRotatedFileCompressionEnabled() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << "\nTESTING ROTATED FILE COMPRESSION"
+                          << "\n================================" << endl;
+
+        bslma::TestAllocator ta("ta", veryVeryVeryVerbose);
+
+        if (verbose) cout << "\tEnabling and disabling." << endl;
+        {
+            Obj mX(&ta);  const Obj& X = mX;
+
+            ASSERT(false == X.isRotatedFileCompressionEnabled());
+
+            ASSERT(0     == mX.enableRotatedFileCompression());
+            ASSERT(true  == X.isRotatedFileCompressionEnabled());
+
+            ASSERT(0     == mX.enableRotatedFileCompression());
+            ASSERT(true  == X.isRotatedFileCompressionEnabled());
+
+            mX.disableRotatedFileCompression();
+            ASSERT(false == X.isRotatedFileCompressionEnabled());
+
+            mX.disableRotatedFileCompression();
+            ASSERT(false == X.isRotatedFileCompressionEnabled());
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+
+        if (verbose) cout << "\tRotated files are compressed." << endl;
+        {
+            TempDirectoryGuard tempDirGuard;
+            bsl::string        fileName(tempDirGuard.getTempDirName());
+            bdls::PathUtil::appendRaw(&fileName, "testLog");
+
+            RotCb cb(&ta);
+            {
+                Obj mX(&ta);
+                mX.setLogFileFunctor(&logMessage);
+                mX.setOnFileRotationCallback(cb);
+                ASSERT(0 == mX.enableRotatedFileCompression());
+                ASSERT(0 == mX.enableFileLogging(fileName.c_str()));
+
+                for (int i = 0; i < 100; ++i) {
+                    publishRecord(&mX, "a record that is rotated");
+                }
+                mX.forceRotation();
+
+                publishRecord(&mX, "a record that is not rotated");
+            }
+
+            ASSERT(1 == cb.numInvocations());
+            ASSERT(0 == cb.status());
+
+            const bsl::string& compressedName = cb.rotatedFileName();
+            const bsl::string  rotatedName(compressedName,
+                                           0,
+                                           compressedName.size() - 3);
+
+            ASSERTV(compressedName, rotatedName + ".gz" == compressedName);
+            ASSERTV(compressedName, FsUtil::exists(compressedName));
+            ASSERTV(rotatedName,   !FsUtil::exists(rotatedName));
+
+            const Int64 compressedSize = FsUtil::getFileSize(compressedName);
+            ASSERTV(compressedSize, 0 < compressedSize);
+            ASSERTV(compressedSize, 100 * 25 > compressedSize);
+
+            bsl::ifstream stream(compressedName.c_str(), bsl::ios::binary);
+            ASSERT(0x1f == stream.get());
+            ASSERT(0x8b == stream.get());
+
+            ASSERT(1 == getNumLines(fileName.c_str()));
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+
+        if (verbose) cout << "\tRotated files are not compressed." << endl;
+        {
+            TempDirectoryGuard tempDirGuard;
+            bsl::string        fileName(tempDirGuard.getTempDirName());
+            bdls::PathUtil::appendRaw(&fileName, "testLog");
+
+            RotCb cb(&ta);
+
+            Obj mX(&ta);
+            mX.setLogFileFunctor(&logMessage);
+            mX.setOnFileRotationCallback(cb);
+            ASSERT(0 == mX.enableRotatedFileCompression());
+            mX.disableRotatedFileCompression();
+            ASSERT(0 == mX.enableFileLogging(fileName.c_str()));
+
+            publishRecord(&mX, "a record that is rotated");
+            mX.forceRotation();
+
+            ASSERT(1 == cb.numInvocations());
+            ASSERT(0 == cb.status());
+            ASSERTV(cb.rotatedFileName(),
+                    FsUtil::exists(cb.rotatedFileName()));
+            ASSERT(1 == getNumLines(cb.rotatedFileName().c_str()));
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+      } break;
+      case 14: {
+        // --------------------------------------------------------------------
+        // TESTING DEFERRED PUBLICATION
+        //
+        // Concerns:
+        //: 1 Records supplied to 'publishDeferred' are not written to the log
+        //:   file until 'writeDeferredRecords' is called, and are then written
+        //:   in the order they were received.
+        //:
+        //: 2 Deferred records are written before a record subsequently
+        //:   supplied to 'publish'.
+        //:
+        //: 3 Deferred records are written when file logging is disabled and
+        //:   when the observer is destroyed.
+        //:
+        //: 4 Deferred records count toward the size of the log file for the
+        //:   purpose of rotation-on-size, and are written to the log file
+        //:   being rotated.
+        //:
+        //: 5 'publishDeferred' and 'writeDeferredRecords' have no effect if
+        //:   file logging is not enabled.
+        //
+        // Plan:
+        //: 1 Publish records using 'publishDeferred', verify that the log file
+        //:   is empty, then call 'writeDeferredRecords' and verify the content
+        //:   of the log file.  (C-1)
+        //:
+        //: 2 Interleave calls to 'publishDeferred' and 'publish', and verify
+        //:   the content of the log file.  (C-2)
+        //:
+        //: 3 Publish deferred records, then disable file logging or destroy
+        //:   the observer, and verify the content of the log file.  (C-3)
+        //:
+        //: 4 Configure a small rotation size, publish deferred records
+        //:   exceeding that size, and verify that a rotation occurs before
+        //:   'writeDeferredRecords' is called and that the rotated log file
+        //:   contains the records published before the rotation.  (C-4)
+        //:
+        //: 5 Call 'publishDeferred' and 'writeDeferredRecords' on an observer
+        //:   having file logging disabled.  (C-5)
+        //
+        // Testing:
+        //   void publishDeferred(const Record&, const Context&);
+        //   void writeDeferredRecords();
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << "\nTESTING DEFERRED PUBLICATION"
+                          << "\n============================" << endl;
+
+        bslma::TestAllocator ta("ta", veryVeryVeryVerbose);
+
+        if (verbose) cout << "\tRecords are written on request." << endl;
+        {
+            TempDirectoryGuard tempDirGuard;
+            bsl::string        fileName(tempDirGuard.getTempDirName());
+            bdls::PathUtil::appendRaw(&fileName, "testLog");
+
+            Obj mX(&ta);
+            mX.setLogFileFunctor(&logMessage);
+            ASSERT(0 == mX.enableFileLogging(fileName.c_str()));
+
+            publishDeferredRecord(&mX, "one");
+            publishDeferredRecord(&mX, "two");
+            publishDeferredRecord(&mX, "three");
+
+            ASSERT(0 == FsUtil::getFileSize(fileName));
+
+            mX.writeDeferredRecords();
+
+            bsl::string content;
+            ASSERT(3 == readFileIntoString(__LINE__, fileName, content));
+            ASSERTV(content, "one\ntwo\nthree\n" == content);
+
+            // A second call has no effect.
+
+            mX.writeDeferredRecords();
+            ASSERT(14 == FsUtil::getFileSize(fileName));
+
+            publishDeferredRecord(&mX, "four");
+            publishRecord(&mX, "five");
+            publishDeferredRecord(&mX, "six");
+
+            ASSERT(5 == readFileIntoString(__LINE__, fileName, content));
+            ASSERTV(content, "one\ntwo\nthree\nfour\nfive\n" == content);
+
+            mX.disableFileLogging();
+
+            ASSERT(6 == readFileIntoString(__LINE__, fileName, content));
+            ASSERTV(content,
+                    "one\ntwo\nthree\nfour\nfive\nsix\n" == content);
+
+            publishDeferredRecord(&mX, "seven");
+            mX.writeDeferredRecords();
+
+            ASSERT(6 == readFileIntoString(__LINE__, fileName, content));
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+
+        if (verbose) cout << "\tRecords are written on destruction." << endl;
+        {
+            TempDirectoryGuard tempDirGuard;
+            bsl::string        fileName(tempDirGuard.getTempDirName());
+            bdls::PathUtil::appendRaw(&fileName, "testLog");
+
+            {
+                Obj mX(&ta);
+                mX.setLogFileFunctor(&logMessage);
+                ASSERT(0 == mX.enableFileLogging(fileName.c_str()));
+
+                publishDeferredRecord(&mX, "one");
+                publishDeferredRecord(&mX, "two");
+
+                ASSERT(0 == FsUtil::getFileSize(fileName));
+            }
+
+            bsl::string content;
+            ASSERT(2 == readFileIntoString(__LINE__, fileName, content));
+            ASSERTV(content, "one\ntwo\n" == content);
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+
+        if (verbose) cout << "\tDeferred records trigger rotation." << endl;
+        {
+            TempDirectoryGuard tempDirGuard;
+            bsl::string        fileName(tempDirGuard.getTempDirName());
+            bdls::PathUtil::appendRaw(&fileName, "testLog");
+
+            RotCb cb(&ta);
+
+            Obj mX(&ta);
+            mX.setLogFileFunctor(&logMessage);
+            mX.setOnFileRotationCallback(cb);
+            mX.rotateOnSize(1);
+            ASSERT(0 == mX.enableFileLogging(fileName.c_str()));
+
+            // Each record is 64 bytes long, so the 18th record is published
+            // after the 1024-byte rotation size has been exceeded.
+
+            const bsl::string message(63, 'x');
+
+            for (int i = 0; i < 17; ++i) {
+                publishDeferredRecord(&mX, message.c_str());
+            }
+
+            ASSERT(0 == cb.numInvocations());
+            ASSERT(0 == FsUtil::getFileSize(fileName));
+
+            publishDeferredRecord(&mX, "last");
+
+            ASSERT(1 == cb.numInvocations());
+            ASSERT(0 == cb.status());
+
+            // The new log file is empty until the last record is written.
+
+            ASSERT(0 == FsUtil::getFileSize(fileName));
+
+            mX.writeDeferredRecords();
+
+            ASSERT(1  == getNumLines(fileName.c_str()));
+            ASSERT(17 == getNumLines(cb.rotatedFileName().c_str()));
+            ASSERT(17 * 64 == FsUtil::getFileSize(cb.rotatedFileName()));
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+      } break;
       case 13: {
         // --------------------------------------------------------------------
         // REPRODUCE BUG FROM DRQS 123123158
@@ -0,0 +1,397 @@
+// ball_lockfreerecordbuffer.cpp                                      -*-C++-*-
+#include <ball_lockfreerecordbuffer.h>
+
+#include <bsls_ident.h>
+BSLS_IDENT_RCSID(ball_lockfreerecordbuffer_cpp,"$Id$ $CSID$")
+
+#include <bslma_default.h>
+
+#include <bslmt_lockguard.h>
+#include <bslmt_threadutil.h>
+
+#include <bsls_alignmentutil.h>
+#include <bsls_assert.h>
+
+#include <bsl_new.h>
+
+// ============================================================================
+//                           IMPLEMENTATION NOTES
+// ----------------------------------------------------------------------------
+//
+// The ring is a bounded queue in which each slot carries a sequence number
+// (after D. Vyukov's bounded MPMC queue).  A slot at position 'p' (modulo the
+// capacity) is free for the enqueuer at position 'p' when its sequence number
+// is 'p', and holds a record for the dequeuer at position 'p' when its
+// sequence number is 'p + 1'; the dequeuer then sets it to 'p + capacity'.
+// Enqueuers and dequeuers claim positions with a compare-and-swap on
+// 'd_enqueuePosition' and 'd_dequeuePosition', respectively, and never wait
+// on one another except while another thread is between claiming a position
+// and publishing the sequence number of its slot.
+//
+// The ring is dequeued both by 'pushBack', to evict the oldest records, and
+// by the operations serialized by 'd_mutex', to detach the contents of the
+// ring.  Records are charged to 'd_currentTotalSize' *before* they are
+// enqueued, and released only after they are removed from the buffer, so
+// that the budget is never exceeded.
+// ----------------------------------------------------------------------------
+
+namespace BloombergLP {
+namespace ball {
+
+                      // ================================
+                      // struct LockFreeRecordBuffer_Slot
+                      // ================================
+
+struct LockFreeRecordBuffer_Slot {
+    // This component-private struct holds one record handle of the ring.
+
+    bsls::AtomicInt64       d_sequence;  // position for which the slot is
+                                         // ready (see implementation notes)
+
+    bsl::shared_ptr<Record> d_handle;    // record handle, or empty
+};
+
+namespace {
+
+const int k_MAX_CAPACITY = 1 << 16;  // upper bound of the ring capacity
+
+int ringCapacity(int maxTotalSize)
+    // Return the capacity of the ring of a buffer having the specified
+    // 'maxTotalSize' budget.  Every record is charged at least its footprint,
+    // so a ring having 'maxTotalSize / sizeof(Record)' slots (rounded up to a
+    // power of 2) never limits the number of records that fit in the budget.
+{
+    const int minimumSize = static_cast<int>(
+               bsls::AlignmentUtil::roundUpToMaximalAlignment(sizeof(Record)));
+
+    int capacity = 2;
+    while (capacity < k_MAX_CAPACITY && capacity < maxTotalSize / minimumSize)
+    {
+        capacity *= 2;
+    }
+    return capacity;
+}
+
+}  // close unnamed namespace
+
+                         // --------------------------
+                         // class LockFreeRecordBuffer
+                         // --------------------------
+
+// PRIVATE CLASS METHODS
+int LockFreeRecordBuffer::recordSize(const Record& record)
+{
+    return record.numAllocatedBytes() + static_cast<int>(
+               bsls::AlignmentUtil::roundUpToMaximalAlignment(sizeof(Record)));
+}
+
+// PRIVATE MANIPULATORS
+void LockFreeRecordBuffer::detachRing()
+{
+    bsl::shared_ptr<Record> handle;
+    while (tryDequeue(&handle)) {
+        d_detached.push_back(bsl::shared_ptr<Record>());
+        d_detached.back().swap(handle);
+    }
+}
+
+bool LockFreeRecordBuffer::evictOldest()
+{
+    bsl::shared_ptr<Record> handle;
+    if (!tryDequeue(&handle)) {
+        return false;                                                 // RETURN
+    }
+    d_currentTotalSize.addRelaxed(-recordSize(*handle));
+    return true;
+}
+
+void LockFreeRecordBuffer::popDetachedBack()
+{
+    BSLS_ASSERT(!d_detached.empty());
+
+    d_currentTotalSize.addRelaxed(-recordSize(*d_detached.back()));
+    d_detached.pop_back();
+}
+
+void LockFreeRecordBuffer::popDetachedFront()
+{
+    BSLS_ASSERT(!d_detached.empty());
+
+    d_currentTotalSize.addRelaxed(-recordSize(*d_detached.front()));
+    d_detached.pop_front();
+}
+
+bool LockFreeRecordBuffer::reserveSize(int size)
+{
+    int current = d_currentTotalSize.loadRelaxed();
+    while (current + size <= d_maxTotalSize) {
+        const int previous = d_currentTotalSize.testAndSwap(current,
+                                                            current + size);
+        if (previous == current) {
+            return true;                                              // RETURN
+        }
+        current = previous;
+    }
+    return false;
+}
+
+bool LockFreeRecordBuffer::tryDequeue(bsl::shared_ptr<Record> *handle)
+{
+    BSLS_ASSERT(handle);
+    BSLS_ASSERT(!*handle);
+
+    bsls::Types::Int64 position = d_dequeuePosition.loadRelaxed();
+    for (;;) {
+        LockFreeRecordBuffer_Slot& slot =
+                                     d_slots_p[position & (d_capacity - 1)];
+
+        const bsls::Types::Int64 difference =
+                                  slot.d_sequence.loadAcquire() - position - 1;
+        if (0 == difference) {
+            const bsls::Types::Int64 previous =
+                       d_dequeuePosition.testAndSwap(position, position + 1);
+            if (previous == position) {
+                handle->swap(slot.d_handle);
+                slot.d_sequence.storeRelease(position + d_capacity);
+                return true;                                          // RETURN
+            }
+            position = previous;
+        }
+        else if (0 > difference) {
+            return false;                                             // RETURN
+        }
+        else {
+            position = d_dequeuePosition.loadRelaxed();
+        }
+    }
+}
+
+bool LockFreeRecordBuffer::tryEnqueue(const bsl::shared_ptr<Record>& handle)
+{
+    bsls::Types::Int64 position = d_enqueuePosition.loadRelaxed();
+    for (;;) {
+        LockFreeRecordBuffer_Slot& slot =
+                                     d_slots_p[position & (d_capacity - 1)];
+
+        const bsls::Types::Int64 difference =
+                                      slot.d_sequence.loadAcquire() - position;
+        if (0 == difference) {
+            const bsls::Types::Int64 previous =
+                       d_enqueuePosition.testAndSwap(position, position + 1);
+            if (previous == position) {
+                slot.d_handle = handle;
+                slot.d_sequence.storeRelease(position + 1);
+                return true;                                          // RETURN
+            }
+            position = previous;
+        }
+        else if (0 > difference) {
+            return false;                                             // RETURN
+        }
+        else {
+            position = d_enqueuePosition.loadRelaxed();
+        }
+    }
+}
+
+// CREATORS
+LockFreeRecordBuffer::LockFreeRecordBuffer(int               maxTotalSize,
+                                           bslma::Allocator *basicAllocator)
+: d_enqueuePosition(0)
+, d_enqueuePad()
+, d_dequeuePosition(0)
+, d_dequeuePad()
+, d_currentTotalSize(0)
+, d_maxTotalSize(maxTotalSize)
+, d_capacity(ringCapacity(maxTotalSize))
+, d_slots_p(0)
+, d_detached(basicAllocator)
+, d_sequenceDepth(0)
+, d_allocator_p(bslma::Default::allocator(basicAllocator))
+{
+    BSLS_ASSERT(0 < maxTotalSize);
+
+    d_slots_p = static_cast<LockFreeRecordBuffer_Slot *>(
+                   d_allocator_p->allocate(sizeof(LockFreeRecordBuffer_Slot) *
+                                           d_capacity));
+
+    for (int i = 0; i < d_capacity; ++i) {
+        new (d_slots_p + i) LockFreeRecordBuffer_Slot();
+        d_slots_p[i].d_sequence.storeRelaxed(i);
+    }
+}
+
+LockFreeRecordBuffer::~LockFreeRecordBuffer()
+{
+    removeAll();
+
+    for (int i = 0; i < d_capacity; ++i) {
+        d_slots_p[i].~LockFreeRecordBuffer_Slot();
+    }
+    d_allocator_p->deallocate(d_slots_p);
+}
+
+// MANIPULATORS
+void LockFreeRecordBuffer::beginSequence()
+{
+    d_mutex.lock();
+
+    if (0 == d_sequenceDepth) {
+        detachRing();
+    }
+    ++d_sequenceDepth;
+}
+
+void LockFreeRecordBuffer::endSequence()
+{
+    BSLS_ASSERT(0 < d_sequenceDepth);
+
+    --d_sequenceDepth;
+    d_mutex.unlock();
+}
+
+void LockFreeRecordBuffer::popBack()
+{
+    bslmt::LockGuard<bslmt::RecursiveMutex> guard(&d_mutex);
+
+    if (0 == d_sequenceDepth) {
+        detachRing();
+    }
+    popDetachedBack();
+}
+
+void LockFreeRecordBuffer::popFront()
+{
+    bslmt::LockGuard<bslmt::RecursiveMutex> guard(&d_mutex);
+
+    if (0 == d_sequenceDepth && d_detached.empty()) {
+        detachRing();
+    }
+    popDetachedFront();
+}
+
+int LockFreeRecordBuffer::pushBack(const bsl::shared_ptr<Record>& handle)
+{
+    const int size = recordSize(*handle);
+
+    if (size > d_maxTotalSize) {
+        // Impossible to accommodate this record.
+
+        return -1;                                                    // RETURN
+    }
+
+    while (!reserveSize(size)) {
+        if (!evictOldest()) {
+            // The remaining budget is held by detached records or by records
+            // that other threads are appending.
+
+            return -1;                                                // RETURN
+        }
+    }
+
+    while (!tryEnqueue(handle)) {
+        if (!evictOldest()) {
+            // The slot at the head of the ring is being released or published
+            // by another thread.
+
+            bslmt::ThreadUtil::yield();
+        }
+    }
+    return 0;
+}
+
+int LockFreeRecordBuffer::pushFront(const bsl::shared_ptr<Record>& handle)
+{
+    bslmt::LockGuard<bslmt::RecursiveMutex> guard(&d_mutex);
+
+    const int size = recordSize(*handle);
+
+    if (size > d_maxTotalSize) {
+        // Impossible to accommodate this record.
+
+        return -1;                                                    // RETURN
+    }
+
+    if (0 == d_sequenceDepth) {
+        detachRing();
+    }
+
+    while (!reserveSize(size)) {
+        if (d_detached.empty()) {
+            // The remaining budget is held by records that other threads are
+            // appending.
+
+            return -1;                                                // RETURN
+        }
+        popDetachedBack();
+    }
+
+    d_detached.push_front(handle);
+    return 0;
+}
+
+void LockFreeRecordBuffer::removeAll()
+{
+    bslmt::LockGuard<bslmt::RecursiveMutex> guard(&d_mutex);
+
+    while (!d_detached.empty()) {
+        popDetachedBack();
+    }
+    while (evictOldest()) {
+    }
+}
+
+// ACCESSORS
+const bsl::shared_ptr<Record>& LockFreeRecordBuffer::back() const
+{
+    bslmt::LockGuard<bslmt::RecursiveMutex> guard(&d_mutex);
+
+    BSLS_ASSERT(0 < d_sequenceDepth);
+
+    return d_detached.back();
+}
+
+const bsl::shared_ptr<Record>& LockFreeRecordBuffer::front() const
+{
+    bslmt::LockGuard<bslmt::RecursiveMutex> guard(&d_mutex);
+
+    BSLS_ASSERT(0 < d_sequenceDepth);
+
+    return d_detached.front();
+}
+
+int LockFreeRecordBuffer::length() const
+{
+    bslmt::LockGuard<bslmt::RecursiveMutex> guard(&d_mutex);
+
+    int result = static_cast<int>(d_detached.size());
+
+    if (0 == d_sequenceDepth) {
+        const bsls::Types::Int64 numEnqueued =
+                                        d_enqueuePosition.loadAcquire()
+                                      - d_dequeuePosition.loadAcquire();
+        if (0 < numEnqueued) {
+            result += static_cast<int>(numEnqueued);
+        }
+    }
+    return result;
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+// ----------------------------------------------------------------------------
+// Copyright 2020 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,396 @@
+// ball_lockfreerecordbuffer.h                                        -*-C++-*-
+#ifndef INCLUDED_BALL_LOCKFREERECORDBUFFER
+#define INCLUDED_BALL_LOCKFREERECORDBUFFER
+
+#include <bsls_ident.h>
+BSLS_IDENT("$Id: $")
+
+//@PURPOSE: Provide a fixed-capacity record buffer having lock-free appends.
+//
+//@CLASSES:
+//  ball::LockFreeRecordBuffer: record buffer having lock-free 'pushBack'
+//
+//@SEE_ALSO: ball_recordbuffer, ball_fixedsizerecordbuffer
+//
+//@DESCRIPTION: This component provides a concrete thread-safe implementation
+// of the 'ball::RecordBuffer' protocol, 'ball::LockFreeRecordBuffer', whose
+// 'pushBack' method neither blocks nor acquires a lock:
+//..
+//              ( ball::LockFreeRecordBuffer )
+//                            |              ctor
+//                            V
+//                  ( ball::RecordBuffer )
+//                                           dtor
+//                                           beginSequence
+//                                           endSequence
+//                                           popBack
+//                                           popFront
+//                                           pushBack
+//                                           pushFront
+//                                           removeAll
+//                                           length
+//                                           back
+//                                           front
+//..
+// 'ball::LockFreeRecordBuffer' is intended for the "record-all,
+// publish-on-error" mode of the logger (see 'ball_loggermanager'), in which
+// every log record whose severity is at least the Record threshold level is
+// appended to the buffer of its logger, while the buffer is read only when a
+// Trigger or Trigger-All event occurs.  Whereas 'ball::FixedSizeRecordBuffer'
+// serializes every append on a mutex, a 'ball::LockFreeRecordBuffer' appends
+// record handles to a preallocated, fixed-capacity, multi-producer ring.  The
+// remaining (consumer-side) operations are serialized by a mutex that is
+// never acquired by 'pushBack'.
+//
+// Like 'ball::FixedSizeRecordBuffer', a 'ball::LockFreeRecordBuffer' is
+// bounded by a byte budget, 'maxTotalSize', supplied at construction: at any
+// time, the sum of the sizes of the contained records (the memory allocated
+// by each record plus the footprint of the record itself) is less than or
+// equal to 'maxTotalSize'.  The capacity of the ring (see 'capacity') is
+// derived from 'maxTotalSize' so that, up to a limit of 65536 records, it
+// never limits the number of records that fit within the byte budget.  Note
+// that, unlike 'ball::FixedSizeRecordBuffer', the memory used by the ring
+// itself is allocated once at construction and is not charged to the budget.
+//
+// In order to accommodate a 'pushBack' request, the oldest records appended
+// to the ring are evicted.  During a sequence (i.e., between 'beginSequence'
+// and 'endSequence'), the records present in the buffer when the sequence
+// began are *detached* from the ring, so that records appended concurrently
+// by other threads are not observed by the sequence (they appear after the
+// detached records once the sequence ends); a 'pushBack' that cannot be
+// accommodated by evicting records from the ring alone is discarded.  If a
+// record can not be accommodated in the buffer, it is silently (but otherwise
+// safely) discarded.
+//
+///Thread Safety
+///-------------
+// 'ball::LockFreeRecordBuffer' is *thread-safe*, except that the methods
+// 'front' and 'back' must be called after locking the buffer by invoking
+// 'beginSequence'.  'pushBack' is *lock-free* (more precisely, it never waits
+// on a thread that is not itself executing an operation on the buffer); all
+// other manipulators may block while another thread holds the buffer locked.
+//
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Buffering Records from Several Threads
+///- - - - - - - - - - - - - - - - - - - - - - - - -
+// In the following example we append records from several threads to a
+// record buffer, and then publish them in the order in which they were
+// appended.
+//
+// First, we define a function that appends a few records to a record buffer:
+//..
+//  void appendRecords(ball::RecordBuffer *buffer, int id)
+//  {
+//      bslma::Allocator *allocator = bslma::Default::globalAllocator();
+//
+//      for (int i = 0; i < 10; ++i) {
+//          bsl::shared_ptr<ball::Record> handle;
+//          handle.createInplace(allocator, allocator);
+//
+//          char message[32];
+//          bsl::sprintf(message, "record %d from thread %d", i, id);
+//          handle->fixedFields().setMessage(message);
+//
+//          buffer->pushBack(handle);
+//      }
+//  }
+//..
+// Then, we create a record buffer having a budget of 32 kilobytes:
+//..
+//  ball::LockFreeRecordBuffer buffer(32 * 1024);
+//  assert(0 == buffer.length());
+//..
+// Next, we append records to the buffer from four threads:
+//..
+//  bslmt::ThreadGroup threads;
+//  for (int i = 0; i < 4; ++i) {
+//      threads.addThread(bdlf::BindUtil::bind(&appendRecords, &buffer, i));
+//  }
+//  threads.joinAll();
+//
+//  assert(40 == buffer.length());
+//..
+// Finally, we lock the buffer and consume the records, oldest first, as a
+// logger does on a Trigger event configured for FIFO order:
+//..
+//  buffer.beginSequence();
+//  while (buffer.length()) {
+//      const ball::Record& record = *buffer.front();
+//      if (verbose) {
+//          bsl::cout << record.fixedFields().message() << bsl::endl;
+//      }
+//      buffer.popFront();
+//  }
+//  buffer.endSequence();
+//..
+
+#include <balscm_version.h>
+
+#include <ball_record.h>
+#include <ball_recordbuffer.h>
+
+#include <bslma_allocator.h>
+#include <bslma_usesbslmaallocator.h>
+
+#include <bslmf_nestedtraitdeclaration.h>
+
+#include <bslmt_platform.h>
+#include <bslmt_recursivemutex.h>
+
+#include <bsls_atomic.h>
+#include <bsls_types.h>
+
+#include <bsl_deque.h>
+#include <bsl_memory.h>
+
+namespace BloombergLP {
+namespace ball {
+
+struct LockFreeRecordBuffer_Slot;
+
+                         // ==========================
+                         // class LockFreeRecordBuffer
+                         // ==========================
+
+class LockFreeRecordBuffer : public RecordBuffer {
+    // This class provides a concrete, thread-safe implementation of the
+    // 'RecordBuffer' protocol whose 'pushBack' method is lock-free.  This
+    // class is a mechanism.  At any time, the sum of sizes of all records
+    // contained in a 'LockFreeRecordBuffer' object is guaranteed to be less
+    // than or equal to an upper bound specified at creation.  The class is
+    // thread-safe, except that the methods 'front' and 'back' must be called
+    // after locking the buffer by invoking 'beginSequence'.  In order to
+    // accommodate a 'pushBack' request, the oldest records appended to the
+    // buffer may be removed.  In order to accommodate a 'pushFront' request,
+    // the records from the back end of the buffer may be removed.  If a record
+    // can not be accommodated in the buffer, it is silently (but otherwise
+    // safely) discarded.
+
+    // DATA
+    bsls::AtomicInt64            d_enqueuePosition;  // next ring position to
+                                                     // append to
+
+    const char                   d_enqueuePad[
+                                          bslmt::Platform::e_CACHE_LINE_SIZE
+                                        - sizeof(bsls::AtomicInt64)];
+                                                     // padding to prevent
+                                                     // false sharing
+
+    bsls::AtomicInt64            d_dequeuePosition;  // next ring position to
+                                                     // remove from
+
+    const char                   d_dequeuePad[
+                                          bslmt::Platform::e_CACHE_LINE_SIZE
+                                        - sizeof(bsls::AtomicInt64)];
+                                                     // padding to prevent
+                                                     // false sharing
+
+    bsls::AtomicInt              d_currentTotalSize; // current sum of sizes of
+                                                     // contained records
+
+    const int                    d_maxTotalSize;     // maximum possible sum of
+                                                     // sizes of contained
+                                                     // records
+
+    const int                    d_capacity;         // number of slots in the
+                                                     // ring (a power of 2)
+
+    LockFreeRecordBuffer_Slot   *d_slots_p;          // ring of slots (owned)
+
+    mutable bslmt::RecursiveMutex
+                                 d_mutex;            // serializes all
+                                                     // operations other than
+                                                     // 'pushBack'
+
+    bsl::deque<bsl::shared_ptr<Record> >
+                                 d_detached;         // records removed from
+                                                     // the ring, oldest first
+                                                     // (guarded by 'd_mutex')
+
+    int                          d_sequenceDepth;    // nesting depth of
+                                                     // 'beginSequence' calls
+                                                     // (guarded by 'd_mutex')
+
+    bslma::Allocator            *d_allocator_p;      // memory allocator (held,
+                                                     // not owned)
+
+    // NOT IMPLEMENTED
+    LockFreeRecordBuffer(const LockFreeRecordBuffer&);
+    LockFreeRecordBuffer& operator=(const LockFreeRecordBuffer&);
+
+    // PRIVATE CLASS METHODS
+    static int recordSize(const Record& record);
+        // Return the number of bytes charged to the budget of a buffer for
+        // the specified 'record'.
+
+    // PRIVATE MANIPULATORS
+    void detachRing();
+        // Move all records appended to the ring to the back of the detached
+        // records.  The behavior is undefined unless 'd_mutex' is held by the
+        // calling thread.
+
+    bool evictOldest();
+        // Remove the oldest record from the ring and release its size from
+        // the budget.  Return 'true' if a record was removed, and 'false' if
+        // the ring appeared empty.
+
+    void popDetachedBack();
+        // Remove the newest detached record and release its size from the
+        // budget.  The behavior is undefined unless 'd_mutex' is held by the
+        // calling thread and '!d_detached.empty()'.
+
+    void popDetachedFront();
+        // Remove the oldest detached record and release its size from the
+        // budget.  The behavior is undefined unless 'd_mutex' is held by the
+        // calling thread and '!d_detached.empty()'.
+
+    bool reserveSize(int size);
+        // Charge the specified 'size' to the budget of this buffer if it can
+        // be accommodated without exceeding the budget.  Return 'true' on
+        // success, and 'false' otherwise with no effect.
+
+    bool tryDequeue(bsl::shared_ptr<Record> *handle);
+        // Remove the oldest record handle from the ring and load it into the
+        // specified 'handle'.  Return 'true' on success, and 'false' if the
+        // ring appeared empty.  The behavior is undefined unless '*handle' is
+        // empty.
+
+    bool tryEnqueue(const bsl::shared_ptr<Record>& handle);
+        // Append the specified 'handle' to the ring.  Return 'true' on
+        // success, and 'false' if the ring appeared full.
+
+  public:
+    // TRAITS
+    BSLMF_NESTED_TRAIT_DECLARATION(LockFreeRecordBuffer,
+                                   bslma::UsesBslmaAllocator);
+
+    // CREATORS
+    explicit
+    LockFreeRecordBuffer(int               maxTotalSize,
+                         bslma::Allocator *basicAllocator = 0);
+        // Create a lock-free record buffer such that at any time the sum of
+        // sizes of all records contained is guaranteed to be less than or
+        // equal to the specified 'maxTotalSize'.  Optionally specify a
+        // 'basicAllocator' used to supply memory.  If 'basicAllocator' is 0,
+        // the currently installed default allocator is used.  The behavior is
+        // undefined unless 'maxTotalSize > 0'.
+
+    virtual ~LockFreeRecordBuffer();
+        // Remove all record handles from this record buffer and destroy this
+        // record buffer.
+
+    // MANIPULATORS
+    virtual void beginSequence();
+        // *Lock* this record buffer so that a sequence of method invocations
+        // on this record buffer can occur uninterrupted by other threads.  The
+        // buffer will remain *locked* until 'endSequence' is called.  Records
+        // appended by other threads while the buffer is locked are not
+        // observed until the sequence ends.  It is valid to invoke other
+        // methods on this record buffer between the calls to 'beginSequence'
+        // and 'endSequence' (the implementation guarantees this by employing
+        // a recursive mutex).
+
+    virtual void endSequence();
+        // *Unlock* this record buffer, thus allowing other threads to access
+        // it.  The behavior is undefined unless the buffer is already *locked*
+        // by 'beginSequence'.
+
+    virtual void popBack();
+        // Remove from this record buffer the record handle positioned at the
+        // back end of the buffer.  The behavior is undefined unless
+        // '0 < length()'.
+
+    virtual void popFront();
+        // Remove from this record buffer the record handle positioned at the
+        // front end of the buffer.  The behavior is undefined unless
+        // '0 < length()'.
+
+    virtual int pushBack(const bsl::shared_ptr<Record>& handle);
+        // Push the specified 'handle' at the back end of this record buffer
+        // without acquiring a lock.  Return 0 on success, and a non-zero value
+        // otherwise.  In order to accommodate a record, the oldest records
+        // appended to the buffer may be removed.  If a record can not be
+        // accommodated in the buffer, it is silently discarded.
+
+    virtual int pushFront(const bsl::shared_ptr<Record>& handle);
+        // Push the specified 'handle' at the front end of this record buffer.
+        // Return 0 on success, and a non-zero value otherwise.  In order to
+        // accommodate a record, the records from the back end of the buffer
+        // may be removed.  If a record can not be accommodated in the buffer,
+        // it is silently discarded.
+
+    virtual void removeAll();
+        // Remove all record handles stored in this record buffer.  Note that
+        // 'length()' is now 0.
+
+    // ACCESSORS
+    virtual const bsl::shared_ptr<Record>& back() const;
+        // Return a reference of the shared pointer referring to the record
+        // positioned at the back end of this record buffer.  The behavior is
+        // undefined unless this record buffer has been locked by the
+        // 'beginSequence' method and unless '0 < length()'.
+
+    int capacity() const;
+        // Return the number of record handles that the ring of this record
+        // buffer can hold.
+
+    virtual const bsl::shared_ptr<Record>& front() const;
+        // Return a reference of the shared pointer referring to the record
+        // positioned at the front end of this record buffer.  The behavior is
+        // undefined unless this record buffer has been locked by the
+        // 'beginSequence' method and unless '0 < length()'.
+
+    virtual int length() const;
+        // Return the number of record handles in this record buffer.  If this
+        // record buffer is locked by the calling thread, the records appended
+        // by other threads since the buffer was locked are not counted.
+
+    int totalSize() const;
+        // Return the sum of sizes of all records contained in this record
+        // buffer.
+};
+
+// ============================================================================
+//                              INLINE DEFINITIONS
+// ============================================================================
+
+                         // --------------------------
+                         // class LockFreeRecordBuffer
+                         // --------------------------
+
+// ACCESSORS
+inline
+int LockFreeRecordBuffer::capacity() const
+{
+    return d_capacity;
+}
+
+inline
+int LockFreeRecordBuffer::totalSize() const
+{
+    return d_currentTotalSize;
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2020 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
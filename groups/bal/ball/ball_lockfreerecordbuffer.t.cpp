@@ -0,0 +1,877 @@
+// ball_lockfreerecordbuffer.t.cpp                                    -*-C++-*-
+#include <ball_lockfreerecordbuffer.h>
+
+#include <ball_fixedsizerecordbuffer.h>
+#include <ball_record.h>
+#include <ball_recordattributes.h>
+
+#include <bdlf_bind.h>
+
+#include <bslim_testutil.h>
+
+#include <bslma_default.h>
+#include <bslma_defaultallocatorguard.h>
+#include <bslma_testallocator.h>
+
+#include <bslmt_barrier.h>
+#include <bslmt_threadgroup.h>
+#include <bslmt_threadutil.h>
+
+#include <bsls_alignmentutil.h>
+#include <bsls_atomic.h>
+#include <bsls_review.h>
+#include <bsls_stopwatch.h>
+#include <bsls_types.h>
+
+#include <bsl_cstdio.h>
+#include <bsl_cstdlib.h>
+#include <bsl_cstring.h>
+#include <bsl_iostream.h>
+#include <bsl_memory.h>
+#include <bsl_string.h>
+#include <bsl_vector.h>
+
+using namespace BloombergLP;
+using namespace bsl;
+
+// ============================================================================
+//                                   TEST PLAN
+// ----------------------------------------------------------------------------
+//                                   Overview
+//                                   --------
+// The component under test is a record buffer whose 'pushBack' method is
+// lock-free.  We verify that the buffer behaves as a double-ended queue of
+// record handles, that the sum of the sizes of the contained records never
+// exceeds the budget (the oldest records being evicted to accommodate
+// 'pushBack', and the newest to accommodate 'pushFront'), that a sequence
+// does not observe records appended concurrently by other threads, and that
+// concurrent appends neither lose nor duplicate records.
+// ----------------------------------------------------------------------------
+// CREATORS
+// [ 1] LockFreeRecordBuffer(int maxTotalSize, bslma::Allocator *ba = 0);
+// [ 1] virtual ~LockFreeRecordBuffer();
+//
+// MANIPULATORS
+// [ 4] virtual void beginSequence();
+// [ 4] virtual void endSequence();
+// [ 2] virtual void popBack();
+// [ 2] virtual void popFront();
+// [ 2] virtual int pushBack(const bsl::shared_ptr<Record>& handle);
+// [ 2] virtual int pushFront(const bsl::shared_ptr<Record>& handle);
+// [ 2] virtual void removeAll();
+//
+// ACCESSORS
+// [ 2] virtual const bsl::shared_ptr<Record>& back() const;
+// [ 1] int capacity() const;
+// [ 2] virtual const bsl::shared_ptr<Record>& front() const;
+// [ 2] virtual int length() const;
+// [ 3] int totalSize() const;
+// ----------------------------------------------------------------------------
+// [ 1] BREATHING TEST
+// [ 3] BYTE-BUDGET EVICTION
+// [ 5] CONCURRENT APPENDS
+// [ 6] USAGE EXAMPLE
+// [-1] PERFORMANCE: CONCURRENT 'pushBack'
+
+// ============================================================================
+//                     STANDARD BDE ASSERT TEST FUNCTION
+// ----------------------------------------------------------------------------
+
+namespace {
+
+int testStatus = 0;
+
+void aSsErT(bool condition, const char *message, int line)
+{
+    if (condition) {
+        cout << "Error " __FILE__ "(" << line << "): " << message
+             << "    (failed)" << endl;
+
+        if (0 <= testStatus && testStatus <= 100) {
+            ++testStatus;
+        }
+    }
+}
+
+}  // close unnamed namespace
+
+// ============================================================================
+//               STANDARD BDE TEST DRIVER MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT       BSLIM_TESTUTIL_ASSERT
+#define ASSERTV      BSLIM_TESTUTIL_ASSERTV
+
+#define LOOP_ASSERT  BSLIM_TESTUTIL_LOOP_ASSERT
+#define LOOP0_ASSERT BSLIM_TESTUTIL_LOOP0_ASSERT
+#define LOOP1_ASSERT BSLIM_TESTUTIL_LOOP1_ASSERT
+#define LOOP2_ASSERT BSLIM_TESTUTIL_LOOP2_ASSERT
+#define LOOP3_ASSERT BSLIM_TESTUTIL_LOOP3_ASSERT
+#define LOOP4_ASSERT BSLIM_TESTUTIL_LOOP4_ASSERT
+#define LOOP5_ASSERT BSLIM_TESTUTIL_LOOP5_ASSERT
+#define LOOP6_ASSERT BSLIM_TESTUTIL_LOOP6_ASSERT
+
+#define Q            BSLIM_TESTUTIL_Q   // Quote identifier literally.
+#define P            BSLIM_TESTUTIL_P   // Print identifier and value.
+#define P_           BSLIM_TESTUTIL_P_  // P(X) without '\n'.
+#define T_           BSLIM_TESTUTIL_T_  // Print a tab (w/o newline).
+#define L_           BSLIM_TESTUTIL_L_  // current Line number
+
+// ============================================================================
+//                  GLOBAL TYPEDEFS/CONSTANTS FOR TESTING
+// ----------------------------------------------------------------------------
+
+typedef ball::LockFreeRecordBuffer Obj;
+typedef bsl::shared_ptr<ball::Record> Handle;
+
+// ============================================================================
+//                          HELPER FUNCTIONS FOR TESTING
+// ----------------------------------------------------------------------------
+
+namespace {
+
+Handle makeRecord(const char *message, bslma::Allocator *allocator)
+    // Return a handle to a record having the specified 'message', using the
+    // specified 'allocator' to supply memory for the record and the handle.
+{
+    Handle handle;
+    handle.createInplace(allocator, allocator);
+    handle->fixedFields().setMessage(message);
+    return handle;
+}
+
+Handle makeRecord(int id, int sequence, bslma::Allocator *allocator)
+    // Return a handle to a record whose message identifies the specified
+    // 'id' and 'sequence', using the specified 'allocator' to supply memory.
+{
+    char message[32];
+    bsl::sprintf(message, "%d:%d", id, sequence);
+    return makeRecord(message, allocator);
+}
+
+int recordSize(const Handle& handle)
+    // Return the number of bytes charged by a record buffer for the record
+    // referred to by the specified 'handle'.
+{
+    return handle->numAllocatedBytes() + static_cast<int>(
+               bsls::AlignmentUtil::roundUpToMaximalAlignment(
+                                                        sizeof(ball::Record)));
+}
+
+bsl::string frontMessage(ball::RecordBuffer *buffer)
+    // Return the message of the record at the front end of the specified
+    // 'buffer'.
+{
+    buffer->beginSequence();
+    bsl::string result(buffer->front()->fixedFields().message());
+    buffer->endSequence();
+    return result;
+}
+
+bsl::string backMessage(ball::RecordBuffer *buffer)
+    // Return the message of the record at the back end of the specified
+    // 'buffer'.
+{
+    buffer->beginSequence();
+    bsl::string result(buffer->back()->fixedFields().message());
+    buffer->endSequence();
+    return result;
+}
+
+struct AppendThreadArgs {
+    // This 'struct' holds the arguments of 'appendThread'.
+
+    ball::RecordBuffer *d_buffer_p;
+    int                 d_id;
+    int                 d_numRecords;
+    bslmt::Barrier     *d_barrier_p;
+    bslma::Allocator   *d_allocator_p;
+    bsls::AtomicInt    *d_numFinished_p;
+};
+
+void appendThread(AppendThreadArgs *args)
+    // Append 'args->d_numRecords' sequence-numbered records to
+    // 'args->d_buffer_p' after waiting on 'args->d_barrier_p', and then
+    // increment '*args->d_numFinished_p'.
+{
+    args->d_barrier_p->wait();
+    for (int i = 0; i < args->d_numRecords; ++i) {
+        args->d_buffer_p->pushBack(makeRecord(args->d_id,
+                                              i,
+                                              args->d_allocator_p));
+    }
+    ++*args->d_numFinished_p;
+}
+
+void appendPreallocated(ball::RecordBuffer        *buffer,
+                        const bsl::vector<Handle> *records,
+                        int                        numRecords,
+                        bslmt::Barrier            *barrier)
+    // Append the specified 'numRecords' handles, cycling through the specified
+    // 'records', to the specified 'buffer' after waiting on the specified
+    // 'barrier'.
+{
+    barrier->wait();
+
+    const int numHandles = static_cast<int>(records->size());
+    for (int i = 0; i < numRecords; ++i) {
+        buffer->pushBack((*records)[i % numHandles]);
+    }
+}
+
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Buffering Records from Several Threads
+///- - - - - - - - - - - - - - - - - - - - - - - - -
+// In the following example we append records from several threads to a
+// record buffer, and then publish them in the order in which they were
+// appended.
+//
+// First, we define a function that appends a few records to a record buffer:
+//..
+    void appendRecords(ball::RecordBuffer *buffer, int id)
+    {
+        bslma::Allocator *allocator = bslma::Default::globalAllocator();
+
+        for (int i = 0; i < 10; ++i) {
+            bsl::shared_ptr<ball::Record> handle;
+            handle.createInplace(allocator, allocator);
+
+            char message[32];
+            bsl::sprintf(message, "record %d from thread %d", i, id);
+            handle->fixedFields().setMessage(message);
+
+            buffer->pushBack(handle);
+        }
+    }
+//..
+
+}  // close unnamed namespace
+
+// ============================================================================
+//                               MAIN PROGRAM
+// ----------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    const int                 test = argc > 1 ? atoi(argv[1]) : 0;
+    const bool             verbose = argc > 2;
+    const bool         veryVerbose = argc > 3;
+    const bool     veryVeryVerbose = argc > 4;
+    const bool veryVeryVeryVerbose = argc > 5;
+
+    (void)veryVeryVerbose;
+
+    cout << "TEST " << __FILE__ << " CASE " << test << endl;
+
+    // CONCERN: 'BSLS_REVIEW' failures should lead to test failures.
+    bsls::ReviewFailureHandlerGuard reviewGuard(&bsls::Review::failByAbort);
+
+    bslma::TestAllocator globalAllocator("global", veryVeryVeryVerbose);
+    bslma::Default::setGlobalAllocator(&globalAllocator);
+
+    bslma::TestAllocator defaultAllocator("default", veryVeryVeryVerbose);
+    bslma::DefaultAllocatorGuard guard(&defaultAllocator);
+
+    switch (test) { case 0:
+      case 6: {
+        // --------------------------------------------------------------------
+        // USAGE EXAMPLE
+        //   Extracted from component header file.
+        //
+        // Concerns:
+        //: 1 The usage example provided in the component header file compiles,
+        //:   links, and runs as shown.
+        //
+        // Plan:
+        //: 1 Incorporate usage example from header into test driver, remove
+        //:   leading comment characters, and replace 'assert' with 'ASSERT'.
+        //:   (C-1)
+        //
+        // Testing:
+        //   USAGE EXAMPLE
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "USAGE EXAMPLE" << endl
+                          << "=============" << endl;
+
+// Then, we create a record buffer having a budget of 32 kilobytes:
+//..
+    ball::LockFreeRecordBuffer buffer(32 * 1024);
+    ASSERT(0 == buffer.length());
+//..
+// Next, we append records to the buffer from four threads:
+//..
+    bslmt::ThreadGroup threads;
+    for (int i = 0; i < 4; ++i) {
+        threads.addThread(bdlf::BindUtil::bind(&appendRecords, &buffer, i));
+    }
+    threads.joinAll();
+
+    ASSERT(40 == buffer.length());
+//..
+// Finally, we lock the buffer and consume the records, oldest first, as a
+// logger does on a Trigger event configured for FIFO order:
+//..
+    buffer.beginSequence();
+    while (buffer.length()) {
+        const ball::Record& record = *buffer.front();
+        if (verbose) {
+            bsl::cout << record.fixedFields().message() << bsl::endl;
+        }
+        buffer.popFront();
+    }
+    buffer.endSequence();
+//..
+      } break;
+      case 5: {
+        // --------------------------------------------------------------------
+        // CONCURRENT APPENDS
+        //
+        // Concerns:
+        //: 1 Records appended concurrently are neither lost nor duplicated
+        //:   while the buffer has room for them.
+        //:
+        //: 2 The records appended by each thread remain in the order in which
+        //:   they were appended.
+        //:
+        //: 3 Under eviction, the budget is never exceeded, the surviving
+        //:   records of each thread are its most recent ones in order, and no
+        //:   memory is leaked.
+        //
+        // Plan:
+        //: 1 Append sequence-numbered records from several threads to a large
+        //:   buffer and verify the contents.  (C-1..2)
+        //:
+        //: 2 Repeat with a small buffer, concurrently consuming the buffer in
+        //:   sequences from the main thread.  (C-3)
+        //
+        // Testing:
+        //   CONCURRENT APPENDS
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "CONCURRENT APPENDS" << endl
+                          << "==================" << endl;
+
+        bslma::TestAllocator ta("object", veryVeryVeryVerbose);
+
+        enum { k_NUM_THREADS = 6, k_NUM_RECORDS = 1000 };
+
+        for (int pass = 0; pass < 2; ++pass) {
+            const bool isSmall = 1 == pass;
+
+            if (veryVerbose) { T_ P(isSmall) }
+
+            Obj mX(isSmall ? 16 * 1024 : 64 * 1024 * 1024, &ta);
+
+            bslmt::Barrier     barrier(k_NUM_THREADS + 1);
+            bsls::AtomicInt    numFinished(0);
+            AppendThreadArgs   args[k_NUM_THREADS];
+            bslmt::ThreadGroup group(&ta);
+
+            for (int i = 0; i < k_NUM_THREADS; ++i) {
+                args[i].d_buffer_p      = &mX;
+                args[i].d_id            = i;
+                args[i].d_numRecords    = k_NUM_RECORDS;
+                args[i].d_barrier_p     = &barrier;
+                args[i].d_allocator_p   = &ta;
+                args[i].d_numFinished_p = &numFinished;
+                ASSERT(0 == group.addThread(
+                               bdlf::BindUtil::bind(&appendThread, args + i)));
+            }
+            barrier.wait();
+
+            int next[k_NUM_THREADS] = { 0 };
+            int numConsumed         = 0;
+
+            bool isFinished = false;
+            while (!isFinished) {
+                // Consume concurrently with the appending threads only if the
+                // buffer is small; check for completion before consuming so
+                // that the last pass consumes every record.
+
+                isFinished = k_NUM_THREADS == numFinished;
+
+                if (!isSmall && !isFinished) {
+                    bslmt::ThreadUtil::yield();
+                    continue;
+                }
+
+                mX.beginSequence();
+                while (0 < mX.length()) {
+                    int id;
+                    int sequence;
+                    ASSERT(2 == bsl::sscanf(
+                                         mX.front()->fixedFields().message(),
+                                         "%d:%d",
+                                         &id,
+                                         &sequence));
+                    ASSERTV(id, 0 <= id && id < k_NUM_THREADS);
+                    if (0 <= id && id < k_NUM_THREADS) {
+                        if (isSmall) {
+                            ASSERTV(id, sequence, next[id],
+                                    next[id] <= sequence);
+                        }
+                        else {
+                            ASSERTV(id, sequence, next[id],
+                                    next[id] == sequence);
+                        }
+                        next[id] = sequence + 1;
+                    }
+                    mX.popFront();
+                    ++numConsumed;
+                }
+                mX.endSequence();
+
+                ASSERTV(mX.totalSize(), mX.totalSize() <= 16 * 1024
+                                                               || !isSmall);
+            }
+            group.joinAll();
+
+            if (veryVerbose) { T_ P(numConsumed) }
+
+            if (isSmall) {
+                ASSERTV(numConsumed, 0 < numConsumed);
+            }
+            else {
+                ASSERTV(numConsumed,
+                        k_NUM_THREADS * k_NUM_RECORDS == numConsumed);
+            }
+
+            ASSERTV(mX.totalSize(), 0 == mX.totalSize());
+        }
+        ASSERTV(ta.numBlocksInUse(), 0 == ta.numBlocksInUse());
+      } break;
+      case 4: {
+        // --------------------------------------------------------------------
+        // TESTING SEQUENCES
+        //
+        // Concerns:
+        //: 1 A sequence observes exactly the records present when it began,
+        //:   even while other threads append records.
+        //:
+        //: 2 Records appended during a sequence follow the records remaining
+        //:   from the sequence once it ends.
+        //:
+        //: 3 Sequences nest.
+        //
+        // Plan:
+        //: 1 Begin a sequence, append records from another thread, and verify
+        //:   the length and contents observed by the sequence and, after the
+        //:   sequence ends, by the buffer.  (C-1..3)
+        //
+        // Testing:
+        //   virtual void beginSequence();
+        //   virtual void endSequence();
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "TESTING SEQUENCES" << endl
+                          << "=================" << endl;
+
+        bslma::TestAllocator ta("object", veryVeryVeryVerbose);
+        {
+            Obj mX(64 * 1024, &ta);
+
+            ASSERT(0 == mX.pushBack(makeRecord("a", &ta)));
+            ASSERT(0 == mX.pushBack(makeRecord("b", &ta)));
+            ASSERT(0 == mX.pushBack(makeRecord("c", &ta)));
+
+            mX.beginSequence();
+            mX.beginSequence();
+            ASSERT(3 == mX.length());
+
+            bslmt::Barrier     barrier(2);
+            bsls::AtomicInt    numFinished(0);
+            AppendThreadArgs   args = { &mX, 7, 5, &barrier, &ta,
+                                        &numFinished };
+            bslmt::ThreadGroup group(&ta);
+            ASSERT(0 == group.addThread(
+                                  bdlf::BindUtil::bind(&appendThread, &args)));
+            barrier.wait();
+            group.joinAll();
+
+            ASSERTV(mX.length(), 3 == mX.length());
+            mX.endSequence();
+
+            ASSERTV(mX.length(), 3 == mX.length());
+            ASSERT(bsl::string("c") == mX.back()->fixedFields().message());
+            mX.popBack();
+            ASSERT(bsl::string("a") == mX.front()->fixedFields().message());
+            mX.endSequence();
+
+            ASSERTV(mX.length(), 7 == mX.length());
+
+            mX.beginSequence();
+            ASSERT(bsl::string("a") == mX.front()->fixedFields().message());
+            ASSERT(bsl::string("7:4") == mX.back()->fixedFields().message());
+            mX.popFront();
+            ASSERT(bsl::string("b") == mX.front()->fixedFields().message());
+            mX.popFront();
+            ASSERT(bsl::string("7:0") == mX.front()->fixedFields().message());
+            mX.endSequence();
+
+            ASSERTV(mX.length(), 5 == mX.length());
+        }
+        ASSERTV(ta.numBlocksInUse(), 0 == ta.numBlocksInUse());
+      } break;
+      case 3: {
+        // --------------------------------------------------------------------
+        // BYTE-BUDGET EVICTION
+        //
+        // Concerns:
+        //: 1 'totalSize' is the sum of the sizes of the contained records.
+        //:
+        //: 2 'pushBack' evicts the oldest records to accommodate a record, and
+        //:   'pushFront' evicts the newest records.
+        //:
+        //: 3 A record larger than the budget is rejected and leaves the buffer
+        //:   unchanged.
+        //:
+        //: 4 During a sequence, a record is accommodated by evicting only
+        //:   records appended since the sequence began, and is rejected if
+        //:   there are none.
+        //
+        // Plan:
+        //: 1 Create a buffer whose budget holds exactly three records of equal
+        //:   size, and verify the contents and 'totalSize' after each push.
+        //:   (C-1..4)
+        //
+        // Testing:
+        //   BYTE-BUDGET EVICTION
+        //   int totalSize() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "BYTE-BUDGET EVICTION" << endl
+                          << "====================" << endl;
+
+        bslma::TestAllocator ta("object", veryVeryVeryVerbose);
+        {
+            const int SIZE = recordSize(makeRecord("0", &ta));
+
+            Obj mX(3 * SIZE, &ta);  const Obj& X = mX;
+            ASSERT(0 == X.totalSize());
+
+            const char *MESSAGES[] = { "0", "1", "2", "3", "4" };
+
+            for (int i = 0; i < 5; ++i) {
+                ASSERTV(i, 0 == mX.pushBack(makeRecord(MESSAGES[i], &ta)));
+                const int EXP = i < 3 ? i + 1 : 3;
+                ASSERTV(i, X.length(), EXP == X.length());
+                ASSERTV(i, X.totalSize(), EXP * SIZE == X.totalSize());
+            }
+            ASSERT("2" == frontMessage(&mX));
+            ASSERT("4" == backMessage(&mX));
+
+            ASSERT(0 == mX.pushFront(makeRecord("1", &ta)));
+            ASSERT(3 == X.length());
+            ASSERT("1" == frontMessage(&mX));
+            ASSERT("3" == backMessage(&mX));
+            ASSERT(3 * SIZE == X.totalSize());
+
+            bsl::string longMessage(4 * SIZE, 'x');
+            ASSERT(0 != mX.pushBack(makeRecord(longMessage.c_str(), &ta)));
+            ASSERT(0 != mX.pushFront(makeRecord(longMessage.c_str(), &ta)));
+            ASSERT(3 == X.length());
+            ASSERT(3 * SIZE == X.totalSize());
+
+            mX.beginSequence();
+            ASSERT(0 != mX.pushBack(makeRecord("5", &ta)));
+            ASSERT(3 == X.length());
+            mX.popFront();
+            ASSERT(0 == mX.pushBack(makeRecord("5", &ta)));
+            ASSERT(0 == mX.pushBack(makeRecord("6", &ta)));
+            ASSERT(2 == X.length());
+            mX.endSequence();
+
+            ASSERT(3 == X.length());
+            ASSERT("2" == frontMessage(&mX));
+            ASSERT("6" == backMessage(&mX));
+
+            mX.removeAll();
+            ASSERT(0 == X.length());
+            ASSERT(0 == X.totalSize());
+        }
+        ASSERTV(ta.numBlocksInUse(), 0 == ta.numBlocksInUse());
+      } break;
+      case 2: {
+        // --------------------------------------------------------------------
+        // TESTING PRIMARY MANIPULATORS AND ACCESSORS
+        //
+        // Concerns:
+        //: 1 The buffer behaves as a double-ended queue of record handles.
+        //:
+        //: 2 'removeAll' removes all record handles.
+        //:
+        //: 3 Records are destroyed once removed from the buffer.
+        //
+        // Plan:
+        //: 1 Perform a series of 'pushBack', 'pushFront', 'popBack', and
+        //:   'popFront' operations on a buffer and on a 'bsl::vector' oracle,
+        //:   comparing 'length', 'front', and 'back' after each.  (C-1..2)
+        //:
+        //: 2 Verify that the object allocator has no blocks in use after
+        //:   'removeAll' and the records are released.  (C-3)
+        //
+        // Testing:
+        //   virtual void popBack();
+        //   virtual void popFront();
+        //   virtual int pushBack(const bsl::shared_ptr<Record>& handle);
+        //   virtual int pushFront(const bsl::shared_ptr<Record>& handle);
+        //   virtual void removeAll();
+        //   virtual const bsl::shared_ptr<Record>& back() const;
+        //   virtual const bsl::shared_ptr<Record>& front() const;
+        //   virtual int length() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "TESTING PRIMARY MANIPULATORS AND ACCESSORS"
+                          << endl
+                          << "=========================================="
+                          << endl;
+
+        bslma::TestAllocator ta("object", veryVeryVeryVerbose);
+        bslma::TestAllocator ra("records", veryVeryVeryVerbose);
+        {
+            static const struct {
+                int         d_line;
+                char        d_op;       // 'B'/'F' push, 'b'/'f' pop
+                const char *d_message;
+            } DATA[] = {
+                //LINE  OP   MESSAGE
+                //----  --   -------
+                { L_,  'B',  "1"     },
+                { L_,  'B',  "2"     },
+                { L_,  'F',  "0"     },
+                { L_,  'b',  ""      },
+                { L_,  'B',  "3"     },
+                { L_,  'B',  "4"     },
+                { L_,  'f',  ""      },
+                { L_,  'F',  "5"     },
+                { L_,  'f',  ""      },
+                { L_,  'f',  ""      },
+                { L_,  'B',  "6"     },
+                { L_,  'b',  ""      },
+                { L_,  'b',  ""      },
+                { L_,  'f',  ""      },
+                { L_,  'B',  "7"     },
+            };
+            const int NUM_DATA = static_cast<int>(sizeof DATA / sizeof *DATA);
+
+            Obj mX(64 * 1024, &ta);  const Obj& X = mX;
+
+            bsl::vector<bsl::string> oracle(&ta);
+
+            for (int ti = 0; ti < NUM_DATA; ++ti) {
+                const int   LINE    = DATA[ti].d_line;
+                const char  OP      = DATA[ti].d_op;
+                const char *MESSAGE = DATA[ti].d_message;
+
+                switch (OP) {
+                  case 'B': {
+                    ASSERTV(LINE, 0 == mX.pushBack(makeRecord(MESSAGE, &ra)));
+                    oracle.push_back(MESSAGE);
+                  } break;
+                  case 'F': {
+                    ASSERTV(LINE, 0 == mX.pushFront(makeRecord(MESSAGE, &ra)));
+                    oracle.insert(oracle.begin(), MESSAGE);
+                  } break;
+                  case 'b': {
+                    mX.popBack();
+                    oracle.pop_back();
+                  } break;
+                  case 'f': {
+                    mX.popFront();
+                    oracle.erase(oracle.begin());
+                  } break;
+                }
+
+                const int LENGTH = static_cast<int>(oracle.size());
+                ASSERTV(LINE, X.length(), LENGTH == X.length());
+                if (0 < LENGTH) {
+                    ASSERTV(LINE, oracle.front() == frontMessage(&mX));
+                    ASSERTV(LINE, oracle.back()  == backMessage(&mX));
+                }
+            }
+
+            ASSERT(0 < ra.numBlocksInUse());
+            mX.removeAll();
+            ASSERT(0 == X.length());
+            ASSERT(0 == X.totalSize());
+            ASSERTV(ra.numBlocksInUse(), 0 == ra.numBlocksInUse());
+
+            ASSERT(0 == mX.pushBack(makeRecord("8", &ra)));
+            ASSERT(1 == X.length());
+        }
+        ASSERTV(ra.numBlocksInUse(), 0 == ra.numBlocksInUse());
+        ASSERTV(ta.numBlocksInUse(), 0 == ta.numBlocksInUse());
+      } break;
+      case 1: {
+        // --------------------------------------------------------------------
+        // BREATHING TEST
+        //   This case exercises (but does not fully test) basic functionality.
+        //
+        // Concerns:
+        //: 1 The class is sufficiently functional to enable comprehensive
+        //:   testing in subsequent test cases.
+        //:
+        //: 2 The capacity of the ring is a power of 2 that does not limit the
+        //:   number of records fitting in the budget.
+        //:
+        //: 3 All memory is supplied by the object allocator.
+        //
+        // Plan:
+        //: 1 Create buffers having various budgets, verify their capacity,
+        //:   and append and consume a few records.  (C-1..3)
+        //
+        // Testing:
+        //   BREATHING TEST
+        //   LockFreeRecordBuffer(int maxTotalSize, bslma::Allocator *ba = 0);
+        //   virtual ~LockFreeRecordBuffer();
+        //   int capacity() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "BREATHING TEST" << endl
+                          << "==============" << endl;
+
+        bslma::TestAllocator ta("object", veryVeryVeryVerbose);
+
+        const int SIZES[] = { 1, 100, 1000, 32 * 1024, 1024 * 1024 };
+        const int NUM_SIZES = static_cast<int>(sizeof SIZES / sizeof *SIZES);
+
+        for (int i = 0; i < NUM_SIZES; ++i) {
+            const int SIZE = SIZES[i];
+
+            Obj mX(SIZE, &ta);  const Obj& X = mX;
+
+            ASSERTV(SIZE, 0 < ta.numBlocksInUse());
+            ASSERTV(SIZE, 0 == defaultAllocator.numBlocksInUse());
+
+            const int CAPACITY = X.capacity();
+            if (veryVerbose) { T_ P_(SIZE) P(CAPACITY) }
+
+            ASSERTV(SIZE, CAPACITY, 2 <= CAPACITY);
+            ASSERTV(SIZE, CAPACITY, 0 == (CAPACITY & (CAPACITY - 1)));
+            ASSERTV(SIZE, CAPACITY,
+                    CAPACITY * static_cast<int>(sizeof(ball::Record)) >= SIZE);
+
+            ASSERT(0 == X.length());
+
+            Handle handle = makeRecord("hello", &ta);
+            const int EXP = recordSize(handle) <= SIZE ? 0 : -1;
+            ASSERTV(SIZE, EXP == mX.pushBack(handle));
+            ASSERTV(SIZE, (0 == EXP) == (1 == X.length()));
+
+            if (1 == X.length()) {
+                ASSERT("hello" == frontMessage(&mX));
+                mX.popFront();
+            }
+            ASSERT(0 == X.length());
+        }
+        ASSERTV(ta.numBlocksInUse(), 0 == ta.numBlocksInUse());
+      } break;
+      case -1: {
+        // --------------------------------------------------------------------
+        // PERFORMANCE: CONCURRENT 'pushBack'
+        //
+        // Concerns:
+        //: 1 Appending records to a 'ball::LockFreeRecordBuffer' scales better
+        //:   with the number of threads than appending them to a
+        //:   'ball::FixedSizeRecordBuffer'.
+        //
+        // Plan:
+        //: 1 For 1, 2, 4, and 8 threads, append a fixed number of records per
+        //:   thread to each kind of buffer (having the default budget of the
+        //:   logger manager), and report the aggregate rate.  The records are
+        //:   preallocated so that only the buffers are measured.
+        //
+        // Testing:
+        //   PERFORMANCE: CONCURRENT 'pushBack'
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "PERFORMANCE: CONCURRENT 'pushBack'" << endl
+                          << "==================================" << endl;
+
+        enum { k_NUM_RECORDS = 200000, k_BUDGET = 32 * 1024 };
+
+        bslma::Allocator *allocator = bslma::Default::globalAllocator();
+
+        bsl::vector<Handle> records(allocator);
+        for (int i = 0; i < 64; ++i) {
+            records.push_back(makeRecord(i, i, allocator));
+        }
+
+        for (int kind = 0; kind < 2; ++kind) {
+            for (int numThreads = 1; numThreads <= 8; numThreads *= 2) {
+                ball::FixedSizeRecordBuffer fixed(k_BUDGET, allocator);
+                Obj                         lockFree(k_BUDGET, allocator);
+
+                ball::RecordBuffer *buffer =
+                                  0 == kind
+                                  ? static_cast<ball::RecordBuffer *>(&fixed)
+                                  : static_cast<ball::RecordBuffer *>(
+                                                                   &lockFree);
+
+                bslmt::Barrier     barrier(numThreads + 1);
+                bslmt::ThreadGroup group(allocator);
+
+                for (int i = 0; i < numThreads; ++i) {
+                    group.addThread(bdlf::BindUtil::bind(
+                                                 &appendPreallocated,
+                                                 buffer,
+                                                 &records,
+                                                 static_cast<int>(
+                                                               k_NUM_RECORDS),
+                                                 &barrier));
+                }
+
+                bsls::Stopwatch timer;
+                timer.start();
+                barrier.wait();
+                group.joinAll();
+                timer.stop();
+
+                cout << (0 == kind ? "FixedSizeRecordBuffer"
+                                   : "LockFreeRecordBuffer ")
+                     << "  threads: " << numThreads
+                     << "  records/s: "
+                     << static_cast<bsls::Types::Int64>(
+                           numThreads * k_NUM_RECORDS / timer.elapsedTime())
+                     << endl;
+            }
+        }
+      } break;
+      default: {
+        cerr << "WARNING: CASE `" << test << "' NOT FOUND." << endl;
+        testStatus = -1;
+      }
+    }
+
+    if (testStatus > 0) {
+        cerr << "Error, non-zero test status = " << testStatus << "." << endl;
+    }
+    return testStatus;
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2020 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -219,6 +219,11 @@ BSLS_IDENT("$Id: $")
 //      'operator<<' is defined.  The resulting formatted message string is
 //      logged with the specified 'SEVERITY'.
 //..
+// The C++ stream-based macros format the message directly into the message
+// stream buffer of a record obtained from the record pool of the logger, and
+// the shared pointer by which the logger publishes the record is allocated
+// from a pool as well.  Once the pools are warm, logging a record that is not
+// retained in the record buffer of the logger allocates no memory.
 // Another set of macros based on C++ streams, similar to 'BALL_LOG_TRACE',
 // etc., allow the caller to specify a "callback" function that is passed the
 // 'ball::UserFields *' used to represent the user fields of a log record.
@@ -2917,6 +2917,45 @@ void *workerThreadPerformance(void *)
 
 }  // close namespace BALL_LOG_TEST_CASE_MINUS_2
 
+// ============================================================================
+//                         CASE -3 RELATED ENTITIES
+// ----------------------------------------------------------------------------
+
+namespace BALL_LOG_TEST_CASE_MINUS_3 {
+
+class NullObserver : public BloombergLP::ball::Observer {
+    // This class provides an observer that discards the records published to
+    // it, so that the cost of logging can be measured in isolation.
+
+  public:
+    using BloombergLP::ball::Observer::publish;
+
+    virtual void publish(
+                   const bsl::shared_ptr<const BloombergLP::ball::Record>&,
+                   const BloombergLP::ball::Context&)
+        // Discard the published record.
+    {
+    }
+
+    virtual void releaseRecords()
+        // Do nothing.
+    {
+    }
+};
+
+void logStreamRecords(int numRecords)
+    // Log the specified 'numRecords' records using 'BALL_LOG_STREAM'.
+{
+    BALL_LOG_SET_CATEGORY("ALLOCATIONS");
+
+    for (int i = 0; i < numRecords; ++i) {
+        BALL_LOG_STREAM(BloombergLP::ball::Severity::e_INFO)
+                                   << "record " << i << " of " << numRecords;
+    }
+}
+
+}  // close namespace BALL_LOG_TEST_CASE_MINUS_3
+
 // ============================================================================
 //                              MAIN PROGRAM
 // ----------------------------------------------------------------------------
@@ -11968,6 +12007,79 @@ if (verbose) bsl::cout << "printf-style macro usage" << bsl::endl;
                   << " seconds."
                   << bsl::endl;
       } break;
+      case -3: {
+        // --------------------------------------------------------------------
+        // 'BALL_LOG_STREAM' ALLOCATION BENCHMARK
+        //
+        // Concerns:
+        //: 1 This test reports the number of allocations, and the time, per
+        //:   invocation of 'BALL_LOG_STREAM' for records that are published,
+        //:   and for records that are retained in the record buffer.
+        //
+        // Plan:
+        //: 1 Create a logger manager using a test allocator, and a test
+        //:   allocator as the default allocator.  For each configuration of
+        //:   the thresholds, log a number of records to warm up the record
+        //:   pool, then log more records, and report the allocations made by
+        //:   each allocator and the time per record.
+        // --------------------------------------------------------------------
+
+        using namespace BALL_LOG_TEST_CASE_MINUS_3;
+        using namespace BloombergLP;  // okay here
+
+        const int NUM_RECORDS = argc > 2 ? bsl::atoi(argv[2]) : 100000;
+
+        bslma::TestAllocator         da("default", veryVeryVeryVerbose);
+        bslma::DefaultAllocatorGuard guard(&da);
+
+        ball::LoggerManagerConfiguration lmc;
+        ball::LoggerManagerScopedGuard   lmg(lmc, &ta);
+
+        bsl::shared_ptr<NullObserver> observer(new (ta) NullObserver(), &ta);
+        ASSERT(0 == ball::LoggerManager::singleton().registerObserver(
+                                                                    observer,
+                                                                    "null"));
+
+        const struct {
+            const char *d_name;
+            int         d_recordLevel;
+            int         d_passLevel;
+        } CONFIGS[] = {
+            { "published", ball::Severity::e_OFF,   ball::Severity::e_TRACE },
+            { "retained",  ball::Severity::e_TRACE, ball::Severity::e_OFF   },
+        };
+        const int NUM_CONFIGS = sizeof CONFIGS / sizeof *CONFIGS;
+
+        for (int ti = 0; ti < NUM_CONFIGS; ++ti) {
+            ASSERT(0 == ball::Administration::setAllThresholdLevels(
+                                                     CONFIGS[ti].d_recordLevel,
+                                                     CONFIGS[ti].d_passLevel,
+                                                     ball::Severity::e_OFF,
+                                                     ball::Severity::e_OFF));
+
+            logStreamRecords(NUM_RECORDS);
+
+            const bsls::Types::Int64 managerAllocations = ta.numAllocations();
+            const bsls::Types::Int64 defaultAllocations = da.numAllocations();
+
+            bsls::Stopwatch timer;
+            timer.start();
+
+            logStreamRecords(NUM_RECORDS);
+
+            timer.stop();
+
+            bsl::cout << CONFIGS[ti].d_name << ": "
+                      << static_cast<double>(ta.numAllocations() -
+                                             managerAllocations) / NUM_RECORDS
+                      << " manager and "
+                      << static_cast<double>(da.numAllocations() -
+                                             defaultAllocations) / NUM_RECORDS
+                      << " default allocations per record, "
+                      << timer.accumulatedWallTime() * 1e9 / NUM_RECORDS
+                      << " ns per record" << bsl::endl;
+        }
+      } break;
       default: {
         bsl::cerr << "WARNING: CASE `" << test << "' NOT FOUND." << bsl::endl;
         testStatus = -1;
@@ -61,6 +61,19 @@ BSLS_IDENT("$Id: $")
 //  -------------------+---------------
 //..
 //
+///Compressed Rotated Log Files
+///----------------------------
+// A file observer may be configured to compress its rotated log files (see
+// {'ball_fileobserver2'|Rotated File Compression}), in which case each
+// rotated log file is replaced by a file having the same name followed by
+// ".gz".  Since every file pattern produced by 'logPatternToFilePattern'
+// terminates with '*', compressed log files match the same file pattern as
+// uncompressed ones, and are therefore removed by the cleanup installed by
+// 'enableLogFileCleanup'.  Note that the rotation callback of such an
+// observer is invoked once the compression of the rotated log file is
+// complete, so that the cleanup performed on a rotation observes the
+// compressed file (and not a partially written one).
+//
 ///Usage
 ///-----
 // This section illustrates intended use of this component.
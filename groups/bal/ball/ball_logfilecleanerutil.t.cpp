@@ -28,6 +28,8 @@
 #include <bsl_ctime.h>
 #include <bsl_iostream.h>
 #include <bsl_fstream.h>
+#include <bsl_string.h>
+#include <bsl_vector.h>
 
 #ifndef BSLS_PLATFORM_OS_WINDOWS
 #include <sys/stat.h>
@@ -489,6 +491,53 @@ int main(int argc, char *argv[])
             ASSERT(false == bdls::FilesystemUtil::exists(baseName + "3"));
             ASSERT(false == bdls::FilesystemUtil::exists(baseName + "4"));
         }
+        {
+            // Compressed rotated log files are cleaned up.
+
+            TempDirectoryGuard tempDirGuard;
+            bsl::string        baseName(tempDirGuard.getTempDirName());
+            bdls::PathUtil::appendRaw(&baseName, "logFile");
+
+            createFile(baseName + ".1.gz");
+            createFile(baseName + ".2.gz");
+
+            changeModificationTime(baseName + ".1.gz", -10);
+            changeModificationTime(baseName + ".2.gz", -40);
+
+            balb::FileCleanerConfiguration config((baseName + "*").c_str(),
+                                                  bsls::TimeInterval(25),
+                                                  0);
+            {
+                ball::FileObserver2 observer;
+                ASSERT(0 == observer.enableRotatedFileCompression());
+                observer.enableFileLogging(baseName.c_str());
+
+                Obj::enableLogFileCleanup(&observer, config);
+
+                // The cleanup is called immediately.
+                ASSERT(true  == bdls::FilesystemUtil::exists(baseName
+                                                                   + ".1.gz"));
+                ASSERT(false == bdls::FilesystemUtil::exists(baseName
+                                                                   + ".2.gz"));
+
+                changeModificationTime(baseName + ".1.gz", -30);
+
+                bslmt::ThreadUtil::microSleep(0, 1);
+                observer.forceRotation();
+
+                // Destroying the observer completes the compression, which
+                // is followed by the cleanup.
+            }
+
+            bsl::vector<bsl::string> paths;
+            bdls::FilesystemUtil::findMatchingPaths(
+                                             &paths,
+                                             (baseName + ".*.gz").c_str());
+
+            ASSERTV(paths.size(), 1 == paths.size());
+            ASSERT(false == bdls::FilesystemUtil::exists(baseName + ".1.gz"));
+            ASSERT(true  == bdls::FilesystemUtil::exists(baseName));
+        }
       } break;
       case 2: {
         // --------------------------------------------------------------------
@@ -0,0 +1,847 @@
+// ball_logfilecompressor.cpp                                         -*-C++-*-
+#include <ball_logfilecompressor.h>
+
+#include <bsls_ident.h>
+BSLS_IDENT_RCSID(ball_logfilecompressor_cpp,"$Id$ $CSID$")
+
+#include <bdlde_crc32.h>
+
+#include <bdlf_memfn.h>
+
+#include <bdls_filesystemutil.h>
+
+#include <bslma_default.h>
+#include <bslma_managedptr.h>
+
+#include <bslmt_lockguard.h>
+#include <bslmt_threadattributes.h>
+
+#include <bsls_assert.h>
+#include <bsls_log.h>
+#include <bsls_platform.h>
+#include <bsls_types.h>
+
+#include <bsl_algorithm.h>
+#include <bsl_cstring.h>
+#include <bsl_vector.h>
+
+#include <bsl_c_stdio.h>   // for 'snprintf'
+
+#if defined(BSLS_PLATFORM_CMP_MSVC)
+#define snprintf _snprintf
+#endif
+
+// ============================================================================
+//                           IMPLEMENTATION NOTES
+// ----------------------------------------------------------------------------
+//
+// The input file is read into a buffer ('window') holding the 32 kilobytes of
+// history that a DEFLATE back-reference may address, followed by the data
+// remaining to be encoded.  Before the buffer is refilled, the history
+// preceding the next byte to encode is moved to the start of the buffer, so
+// that every byte is moved at most once.
+//
+// Matches are found using hash chains, as in zlib: 'head' maps the hash of
+// the 3 bytes at a position to the most recent (absolute) position having
+// that hash, and 'prev' maps each position of the window (modulo the window
+// size) to the previous position having the same hash.  Positions are
+// absolute offsets in the input, so that the tables need not be adjusted when
+// the buffer is shifted; a chain ends at the first position that is more than
+// a window away from the current position.  Each match is greedy (no "lazy"
+// evaluation), and the length of every chain search is bounded.
+//
+// The input is divided into blocks of about 'k_BLOCK_SIZE' bytes.  The
+// symbols (literals and back-references) of a block are buffered, along with
+// the number of bits needed to encode them using the fixed Huffman codes (RFC
+// 1951, section 3.2.6), which avoids computing codes for each block.  When the
+// block ends, it is written using the fixed codes or, if that would take more
+// space than its input (e.g., for data that is already compressed), as a
+// stored block (RFC 1951, section 3.2.4), so that incompressible input grows
+// by only a few bytes per block.  The input of a block is always still in the
+// buffer when the block ends, because blocks are smaller than the history
+// retained by the buffer.  Since blocks are written only once they end, the
+// last block is flagged as final when the input is exhausted.
+// ----------------------------------------------------------------------------
+
+namespace BloombergLP {
+namespace ball {
+
+namespace {
+
+typedef bdls::FilesystemUtil FileUtil;
+
+const int k_WINDOW_SIZE   = 1 << 15;          // size of the LZ77 window
+const int k_BUFFER_SIZE   = 2 * k_WINDOW_SIZE;
+const int k_MIN_MATCH     = 3;
+const int k_MAX_MATCH     = 258;
+const int k_MIN_LOOKAHEAD = k_MAX_MATCH + k_MIN_MATCH + 1;
+const int k_HASH_BITS     = 15;
+const int k_HASH_SIZE     = 1 << k_HASH_BITS;
+const int k_MAX_CHAIN     = 32;               // bound on a chain search
+const int k_OUTPUT_SIZE   = 16 * 1024;        // size of the output buffer
+const int k_BLOCK_SIZE    = 16 * 1024;        // input bytes that end a block
+const int k_MAX_SYMBOLS   = k_BLOCK_SIZE + k_MAX_MATCH;
+                                              // symbols in a block
+
+const int k_END_OF_BLOCK  = 256;
+
+const unsigned short k_LENGTH_BASE[] = {
+      3,   4,   5,   6,   7,   8,   9,  10,  11,  13,
+     15,  17,  19,  23,  27,  31,  35,  43,  51,  59,
+     67,  83,  99, 115, 131, 163, 195, 227, 258
+};
+
+const unsigned char k_LENGTH_EXTRA_BITS[] = {
+      0,   0,   0,   0,   0,   0,   0,   0,   1,   1,
+      1,   1,   2,   2,   2,   2,   3,   3,   3,   3,
+      4,   4,   4,   4,   5,   5,   5,   5,   0
+};
+
+const unsigned short k_DISTANCE_BASE[] = {
+        1,     2,     3,     4,     5,     7,     9,    13,    17,    25,
+       33,    49,    65,    97,   129,   193,   257,   385,   513,   769,
+     1025,  1537,  2049,  3073,  4097,  6145,  8193, 12289, 16385, 24577
+};
+
+const unsigned char k_DISTANCE_EXTRA_BITS[] = {
+      0,   0,   0,   0,   1,   1,   2,   2,   3,   3,
+      4,   4,   5,   5,   6,   6,   7,   7,   8,   8,
+      9,   9,  10,  10,  11,  11,  12,  12,  13,  13
+};
+
+const int k_NUM_LENGTH_CODES   = sizeof k_LENGTH_BASE / sizeof *k_LENGTH_BASE;
+const int k_NUM_DISTANCE_CODES = sizeof k_DISTANCE_BASE
+                                                     / sizeof *k_DISTANCE_BASE;
+
+inline
+unsigned int hash(const unsigned char *data)
+    // Return the hash of the 3 bytes at the specified 'data'.
+{
+    return ((static_cast<unsigned int>(data[0]) << 10)
+          ^ (static_cast<unsigned int>(data[1]) <<  5)
+          ^  static_cast<unsigned int>(data[2])) & (k_HASH_SIZE - 1);
+}
+
+                             // ================
+                             // class GzipWriter
+                             // ================
+
+class GzipWriter {
+    // This class writes a gzip stream, whose data is encoded in DEFLATE
+    // blocks using either the fixed Huffman codes or no compression, to a
+    // file descriptor.
+
+    // DATA
+    FileUtil::FileDescriptor d_descriptor;            // output file
+    unsigned char            d_output[k_OUTPUT_SIZE]; // pending output
+    int                      d_outputLength;          // bytes in 'd_output'
+    bsls::Types::Uint64      d_bits;                  // pending bits
+    int                      d_numBits;               // number of bits in
+                                                      // 'd_bits'
+    unsigned int             d_symbols[k_MAX_SYMBOLS];
+                                                      // symbols of the current
+                                                      // block: 'distance << 9
+                                                      // | length' for a match,
+                                                      // and the byte for a
+                                                      // literal
+    int                      d_numSymbols;            // symbols in
+                                                      // 'd_symbols'
+    bsls::Types::Uint64      d_blockBits;             // bits needed to encode
+                                                      // 'd_symbols' using the
+                                                      // fixed codes
+    bool                     d_failed;                // 'true' if a write
+                                                      // failed
+
+    // NOT IMPLEMENTED
+    GzipWriter(const GzipWriter&);
+    GzipWriter& operator=(const GzipWriter&);
+
+    // PRIVATE MANIPULATORS
+    void flushOutput();
+        // Write the pending output to the file.
+
+    void writeByte(unsigned char byte);
+        // Append the specified 'byte' to the output.
+
+    void writeBits(unsigned int value, int numBits);
+        // Append the specified 'numBits' low-order bits of the specified
+        // 'value' to the output, least-significant bit first.
+
+    void writeCode(unsigned int code, int length);
+        // Append the Huffman 'code' having the specified 'length' to the
+        // output, most-significant bit first.
+
+    void writeSymbol(int symbol);
+        // Append the fixed Huffman code of the specified literal/length
+        // 'symbol' to the output.
+
+    // PRIVATE CLASS METHODS
+    static int lengthCode(int length);
+        // Return the index of the length code of the specified match
+        // 'length'.
+
+    static int distanceCode(int distance);
+        // Return the distance code of the specified match 'distance'.
+
+    static int symbolBits(int symbol);
+        // Return the length of the fixed Huffman code of the specified
+        // literal/length 'symbol'.
+
+  public:
+    // CREATORS
+    explicit GzipWriter(FileUtil::FileDescriptor descriptor);
+        // Create a writer of the specified 'descriptor', and write the gzip
+        // header.
+
+    // MANIPULATORS
+    void writeLiteral(unsigned char byte);
+        // Append the specified literal 'byte' to the current block.
+
+    void writeMatch(int length, int distance);
+        // Append a back-reference of the specified 'length' at the specified
+        // 'distance' to the current block.  The behavior is undefined unless
+        // 'k_MIN_MATCH <= length <= k_MAX_MATCH',
+        // '1 <= distance <= k_WINDOW_SIZE', and the current block holds fewer
+        // than 'k_MAX_SYMBOLS' symbols.
+
+    void writeBlock(const unsigned char *data, int length, bool isFinal);
+        // Write the current block, whose symbols encode the specified
+        // 'length' bytes at the specified 'data', using the fixed Huffman
+        // codes or, if that is not shorter, as a stored block, and start a
+        // new block.  Flag the block as the last of the stream if the
+        // specified 'isFinal' is 'true'.  The behavior is undefined unless
+        // 'length <= 65535'.
+
+    int finish(unsigned int crc, bsls::Types::Uint64 inputSize);
+        // Write the gzip trailer having the specified 'crc' and 'inputSize'
+        // of the uncompressed data.  Return 0 if every write to the file
+        // succeeded, and a non-zero value otherwise.  The behavior is
+        // undefined unless the last block written was flagged as final.
+};
+
+                             // ----------------
+                             // class GzipWriter
+                             // ----------------
+
+// PRIVATE MANIPULATORS
+void GzipWriter::flushOutput()
+{
+    const unsigned char *data   = d_output;
+    int                  length = d_outputLength;
+
+    while (!d_failed && 0 < length) {
+        const int numWritten = FileUtil::write(d_descriptor, data, length);
+        if (0 >= numWritten) {
+            d_failed = true;
+        }
+        else {
+            data   += numWritten;
+            length -= numWritten;
+        }
+    }
+    d_outputLength = 0;
+}
+
+inline
+void GzipWriter::writeByte(unsigned char byte)
+{
+    if (k_OUTPUT_SIZE == d_outputLength) {
+        flushOutput();
+    }
+    d_output[d_outputLength++] = byte;
+}
+
+inline
+void GzipWriter::writeBits(unsigned int value, int numBits)
+{
+    d_bits    |= static_cast<bsls::Types::Uint64>(value) << d_numBits;
+    d_numBits += numBits;
+
+    while (8 <= d_numBits) {
+        writeByte(static_cast<unsigned char>(d_bits));
+        d_bits    >>= 8;
+        d_numBits  -= 8;
+    }
+}
+
+inline
+void GzipWriter::writeCode(unsigned int code, int length)
+{
+    unsigned int reversed = 0;
+    for (int i = 0; i < length; ++i) {
+        reversed = (reversed << 1) | (code & 1);
+        code >>= 1;
+    }
+    writeBits(reversed, length);
+}
+
+inline
+void GzipWriter::writeSymbol(int symbol)
+{
+    if (144 > symbol) {
+        writeCode(0x30 + symbol, 8);
+    }
+    else if (256 > symbol) {
+        writeCode(0x190 + symbol - 144, 9);
+    }
+    else if (280 > symbol) {
+        writeCode(symbol - 256, 7);
+    }
+    else {
+        writeCode(0xc0 + symbol - 280, 8);
+    }
+}
+
+// PRIVATE CLASS METHODS
+inline
+int GzipWriter::lengthCode(int length)
+{
+    return static_cast<int>(bsl::upper_bound(k_LENGTH_BASE,
+                                             k_LENGTH_BASE +
+                                                           k_NUM_LENGTH_CODES,
+                                             length) - k_LENGTH_BASE) - 1;
+}
+
+inline
+int GzipWriter::distanceCode(int distance)
+{
+    return static_cast<int>(bsl::upper_bound(k_DISTANCE_BASE,
+                                             k_DISTANCE_BASE +
+                                                         k_NUM_DISTANCE_CODES,
+                                             distance) - k_DISTANCE_BASE) - 1;
+}
+
+inline
+int GzipWriter::symbolBits(int symbol)
+{
+    return 144 > symbol ? 8
+         : 256 > symbol ? 9
+         : 280 > symbol ? 7
+         :                8;
+}
+
+// CREATORS
+GzipWriter::GzipWriter(FileUtil::FileDescriptor descriptor)
+: d_descriptor(descriptor)
+, d_outputLength(0)
+, d_bits(0)
+, d_numBits(0)
+, d_numSymbols(0)
+, d_blockBits(0)
+, d_failed(false)
+{
+    // gzip header: magic number, "deflate" method, no flags, no modification
+    // time, no extra flags, and "unknown" operating system.
+
+    static const unsigned char k_HEADER[] = {
+        0x1f, 0x8b, 8, 0, 0, 0, 0, 0, 0, 0xff
+    };
+
+    for (bsl::size_t i = 0; i < sizeof k_HEADER; ++i) {
+        writeByte(k_HEADER[i]);
+    }
+}
+
+// MANIPULATORS
+int GzipWriter::finish(unsigned int crc, bsls::Types::Uint64 inputSize)
+{
+    BSLS_ASSERT(0 == d_numBits);
+
+    const unsigned int size = static_cast<unsigned int>(inputSize);
+    for (int i = 0; i < 4; ++i) {
+        writeByte(static_cast<unsigned char>(crc >> (8 * i)));
+    }
+    for (int i = 0; i < 4; ++i) {
+        writeByte(static_cast<unsigned char>(size >> (8 * i)));
+    }
+
+    flushOutput();
+
+    return d_failed ? -1 : 0;
+}
+
+inline
+void GzipWriter::writeLiteral(unsigned char byte)
+{
+    BSLS_ASSERT(k_MAX_SYMBOLS > d_numSymbols);
+
+    d_symbols[d_numSymbols++]  = byte;
+    d_blockBits               += symbolBits(byte);
+}
+
+void GzipWriter::writeMatch(int length, int distance)
+{
+    BSLS_ASSERT(k_MIN_MATCH <= length);
+    BSLS_ASSERT(k_MAX_MATCH >= length);
+    BSLS_ASSERT(1 <= distance);
+    BSLS_ASSERT(k_WINDOW_SIZE >= distance);
+    BSLS_ASSERT(k_MAX_SYMBOLS > d_numSymbols);
+
+    const int lCode = lengthCode(length);
+    const int dCode = distanceCode(distance);
+
+    d_symbols[d_numSymbols++]  = static_cast<unsigned int>(distance) << 9
+                               | static_cast<unsigned int>(length);
+    d_blockBits               += symbolBits(257 + lCode)
+                               + k_LENGTH_EXTRA_BITS[lCode]
+                               + 5
+                               + k_DISTANCE_EXTRA_BITS[dCode];
+}
+
+void GzipWriter::writeBlock(const unsigned char *data,
+                            int                  length,
+                            bool                 isFinal)
+{
+    BSLS_ASSERT(0 <= length);
+    BSLS_ASSERT(0xffff >= length);
+
+    // A stored block takes its 3-bit header, at most 7 bits of padding to a
+    // byte boundary, 'LEN' and 'NLEN', and its data.
+
+    const bsls::Types::Uint64 fixedBits  = 3
+                                         + d_blockBits
+                                         + symbolBits(k_END_OF_BLOCK);
+    const bsls::Types::Uint64 storedBits = 3 + 7 + 32
+                                         + 8 * bsls::Types::Uint64(length);
+
+    writeBits(isFinal ? 1 : 0, 1);
+
+    if (fixedBits < storedBits) {
+        writeBits(1, 2);
+
+        for (int i = 0; i < d_numSymbols; ++i) {
+            const unsigned int symbol   = d_symbols[i];
+            const int          distance = static_cast<int>(symbol >> 9);
+
+            if (0 == distance) {
+                writeSymbol(static_cast<int>(symbol));
+                continue;
+            }
+
+            const int matchLength = static_cast<int>(symbol & 0x1ff);
+            const int lCode       = lengthCode(matchLength);
+            const int dCode       = distanceCode(distance);
+
+            writeSymbol(257 + lCode);
+            writeBits(matchLength - k_LENGTH_BASE[lCode],
+                      k_LENGTH_EXTRA_BITS[lCode]);
+            writeCode(dCode, 5);
+            writeBits(distance - k_DISTANCE_BASE[dCode],
+                      k_DISTANCE_EXTRA_BITS[dCode]);
+        }
+        writeSymbol(k_END_OF_BLOCK);
+    }
+    else {
+        writeBits(0, 2);
+        if (0 < d_numBits) {
+            writeBits(0, 8 - d_numBits);
+        }
+
+        const unsigned int len = static_cast<unsigned int>(length);
+        writeBits(len, 16);
+        writeBits(~len & 0xffff, 16);
+
+        for (int i = 0; i < length; ++i) {
+            writeByte(data[i]);
+        }
+    }
+
+    if (isFinal && 0 < d_numBits) {
+        writeBits(0, 8 - d_numBits);
+    }
+
+    d_numSymbols = 0;
+    d_blockBits  = 0;
+}
+
+int deflateFile(FileUtil::FileDescriptor  output,
+                FileUtil::FileDescriptor  input,
+                bslma::Allocator         *allocator)
+    // Write the contents of the specified 'input' file, compressed in the
+    // gzip format, to the specified 'output' file.  Use the specified
+    // 'allocator' to supply memory.  Return 0 on success, and a non-zero
+    // value otherwise.
+{
+    typedef bsls::Types::Int64 Int64;
+
+    bsl::vector<unsigned char> window(k_BUFFER_SIZE, 0, allocator);
+    bsl::vector<Int64>         head(k_HASH_SIZE, -1, allocator);
+    bsl::vector<Int64>         prev(k_WINDOW_SIZE, -1, allocator);
+
+    bslma::ManagedPtr<GzipWriter> writer(
+                                      new (*allocator) GzipWriter(output),
+                                      allocator);
+    bdlde::Crc32 crc;
+
+    unsigned char *buffer     = window.data();
+    Int64          base       = 0;    // absolute position of 'buffer[0]'
+    int            end        = 0;    // number of bytes in 'buffer'
+    Int64          position   = 0;    // absolute position of the next byte
+    Int64          blockStart = 0;    // absolute position of the first byte
+                                      // of the current block
+    bool           eof        = false;
+
+    for (;;) {
+        if (k_BLOCK_SIZE <= position - blockStart) {
+            writer->writeBlock(buffer + (blockStart - base),
+                               static_cast<int>(position - blockStart),
+                               false);
+            blockStart = position;
+        }
+
+        if (!eof && base + end - position < k_MIN_LOOKAHEAD) {
+            const int offset = static_cast<int>(position - base);
+            if (k_WINDOW_SIZE < offset) {
+                const int shift = offset - k_WINDOW_SIZE;
+                bsl::memmove(buffer, buffer + shift, end - shift);
+                base += shift;
+                end  -= shift;
+            }
+
+            while (!eof && end < k_BUFFER_SIZE) {
+                const int numRead = FileUtil::read(input,
+                                                   buffer + end,
+                                                   k_BUFFER_SIZE - end);
+                if (0 > numRead) {
+                    return -1;                                        // RETURN
+                }
+                if (0 == numRead) {
+                    eof = true;
+                }
+                else {
+                    crc.update(buffer + end, numRead);
+                    end += numRead;
+                }
+            }
+        }
+
+        const int lookahead = static_cast<int>(base + end - position);
+        if (0 == lookahead) {
+            break;
+        }
+
+        const int      offset    = static_cast<int>(position - base);
+        unsigned char *current   = buffer + offset;
+        int            bestLength = 0;
+        Int64          bestMatch  = 0;
+
+        if (k_MIN_MATCH <= lookahead) {
+            const unsigned int h         = hash(current);
+            const int          maxLength = bsl::min(lookahead, k_MAX_MATCH);
+
+            Int64 candidate = head[h];
+            for (int chain = 0;
+                 chain < k_MAX_CHAIN
+              && 0 <= candidate
+              && base <= candidate
+              && position - candidate <= k_WINDOW_SIZE;
+                 ++chain) {
+                const unsigned char *match = buffer + (candidate - base);
+
+                if (match[bestLength] == current[bestLength]) {
+                    int length = 0;
+                    while (length < maxLength
+                        && match[length] == current[length]) {
+                        ++length;
+                    }
+                    if (length > bestLength) {
+                        bestLength = length;
+                        bestMatch  = candidate;
+                        if (length == maxLength) {
+                            break;
+                        }
+                    }
+                }
+
+                const Int64 next = prev[candidate & (k_WINDOW_SIZE - 1)];
+                if (next >= candidate) {
+                    break;
+                }
+                candidate = next;
+            }
+
+            prev[position & (k_WINDOW_SIZE - 1)] = head[h];
+            head[h]                              = position;
+        }
+
+        if (k_MIN_MATCH <= bestLength) {
+            writer->writeMatch(bestLength,
+                               static_cast<int>(position - bestMatch));
+
+            // Index the positions covered by the match.
+
+            const Int64 matchEnd  = position + bestLength;
+            const Int64 hashLimit = base + end - (k_MIN_MATCH - 1);
+            for (Int64 p = position + 1; p < matchEnd && p < hashLimit; ++p) {
+                const unsigned int h = hash(buffer + (p - base));
+                prev[p & (k_WINDOW_SIZE - 1)] = head[h];
+                head[h]                       = p;
+            }
+            position = matchEnd;
+        }
+        else {
+            writer->writeLiteral(*current);
+            ++position;
+        }
+    }
+
+    writer->writeBlock(buffer + (blockStart - base),
+                       static_cast<int>(position - blockStart),
+                       true);
+
+    return writer->finish(crc.checksum(),
+                          static_cast<bsls::Types::Uint64>(position));
+}
+
+void reportError(const char *message, const char *fileName)
+    // Report the specified error 'message' regarding the file having the
+    // specified 'fileName'.
+{
+    char buffer[512];
+    snprintf(buffer, sizeof buffer, "%s: %s.", message, fileName);
+    bsls::Log::platformDefaultMessageHandler(bsls::LogSeverity::e_WARN,
+                                             __FILE__,
+                                             __LINE__,
+                                             buffer);
+}
+
+}  // close unnamed namespace
+
+                        // ---------------------------
+                        // class LogFileCompressor_Job
+                        // ---------------------------
+
+// CREATORS
+LogFileCompressor_Job::LogFileCompressor_Job(
+                                     const bsl::string&         fileName,
+                                     const CompletionCallback&  callback,
+                                     bslma::Allocator          *allocator)
+: d_fileName(fileName, allocator)
+, d_callback(bsl::allocator_arg_t(),
+             bsl::allocator<CompletionCallback>(allocator),
+             callback)
+{
+}
+
+LogFileCompressor_Job::LogFileCompressor_Job(
+                                  const LogFileCompressor_Job&  original,
+                                  bslma::Allocator             *allocator)
+: d_fileName(original.d_fileName, allocator)
+, d_callback(bsl::allocator_arg_t(),
+             bsl::allocator<CompletionCallback>(allocator),
+             original.d_callback)
+{
+}
+
+                          // -----------------------
+                          // class LogFileCompressor
+                          // -----------------------
+
+// CLASS DATA
+const char LogFileCompressor::k_COMPRESSED_FILE_SUFFIX[] = ".gz";
+
+// PRIVATE MANIPULATORS
+void LogFileCompressor::threadEntryPoint()
+{
+    bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+
+    for (;;) {
+        while (d_jobs.empty() && !d_stopFlag) {
+            d_jobCondition.wait(&d_mutex);
+        }
+        if (d_jobs.empty()) {
+            break;
+        }
+
+        LogFileCompressor_Job job(d_jobs.front(), d_allocator_p);
+        d_jobs.pop_front();
+        d_busyFlag = true;
+
+        {
+            bslmt::UnLockGuard<bslmt::Mutex> unlockGuard(&d_mutex);
+
+            bsl::string compressedFileName(job.d_fileName, d_allocator_p);
+            compressedFileName += k_COMPRESSED_FILE_SUFFIX;
+
+            int rc = compressFile(compressedFileName.c_str(),
+                                  job.d_fileName.c_str(),
+                                  d_allocator_p);
+            if (0 == rc) {
+                rc = FileUtil::remove(job.d_fileName);
+                if (0 != rc) {
+                    // Keep the uncompressed file, which is complete.
+
+                    reportError("Cannot remove rotated log file",
+                                job.d_fileName.c_str());
+                    FileUtil::remove(compressedFileName);
+                }
+            }
+
+            if (job.d_callback) {
+                job.d_callback(rc, 0 == rc ? compressedFileName
+                                           : job.d_fileName);
+            }
+        }
+
+        d_busyFlag = false;
+        if (d_jobs.empty()) {
+            d_idleCondition.broadcast();
+        }
+    }
+}
+
+// CLASS METHODS
+int LogFileCompressor::compressFile(const char       *compressedFileName,
+                                    const char       *fileName,
+                                    bslma::Allocator *basicAllocator)
+{
+    BSLS_ASSERT(compressedFileName);
+    BSLS_ASSERT(fileName);
+
+    const FileUtil::FileDescriptor input = FileUtil::open(
+                                                        fileName,
+                                                        FileUtil::e_OPEN,
+                                                        FileUtil::e_READ_ONLY);
+    if (FileUtil::k_INVALID_FD == input) {
+        reportError("Cannot open log file for compression", fileName);
+        return -1;                                                    // RETURN
+    }
+
+    const FileUtil::FileDescriptor output = FileUtil::open(
+                                                    compressedFileName,
+                                                    FileUtil::e_OPEN_OR_CREATE,
+                                                    FileUtil::e_WRITE_ONLY,
+                                                    FileUtil::e_TRUNCATE);
+    if (FileUtil::k_INVALID_FD == output) {
+        reportError("Cannot create compressed log file", compressedFileName);
+        FileUtil::close(input);
+        return -2;                                                    // RETURN
+    }
+
+    int rc = deflateFile(output,
+                         input,
+                         bslma::Default::allocator(basicAllocator));
+
+    FileUtil::close(input);
+    if (0 != FileUtil::close(output)) {
+        rc = -1;
+    }
+
+    if (0 != rc) {
+        reportError("Cannot compress log file", fileName);
+        FileUtil::remove(compressedFileName);
+        return -3;                                                    // RETURN
+    }
+    return 0;
+}
+
+// CREATORS
+LogFileCompressor::LogFileCompressor(bslma::Allocator *basicAllocator)
+: d_jobs(basicAllocator)
+, d_busyFlag(false)
+, d_stopFlag(false)
+, d_threadHandle(bslmt::ThreadUtil::invalidHandle())
+, d_allocator_p(bslma::Default::allocator(basicAllocator))
+{
+}
+
+LogFileCompressor::~LogFileCompressor()
+{
+    stop();
+}
+
+// MANIPULATORS
+void LogFileCompressor::compressFileAsync(const bsl::string&        fileName,
+                                          const CompletionCallback& callback)
+{
+    bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+
+    d_jobs.push_back(LogFileCompressor_Job(fileName, callback, d_allocator_p));
+    d_jobCondition.signal();
+}
+
+void LogFileCompressor::drain()
+{
+    bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+
+    BSLS_ASSERT(bslmt::ThreadUtil::invalidHandle() != d_threadHandle);
+
+    while (!d_jobs.empty() || d_busyFlag) {
+        d_idleCondition.wait(&d_mutex);
+    }
+}
+
+int LogFileCompressor::start()
+{
+    bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+
+    if (bslmt::ThreadUtil::invalidHandle() != d_threadHandle) {
+        return 0;                                                     // RETURN
+    }
+
+    d_stopFlag = false;
+
+    bslmt::ThreadAttributes attributes;
+    attributes.setThreadName("ball.compress");
+
+    return bslmt::ThreadUtil::create(
+                           &d_threadHandle,
+                           attributes,
+                           bdlf::MemFnUtil::memFn(
+                                          &LogFileCompressor::threadEntryPoint,
+                                          this));
+}
+
+void LogFileCompressor::stop()
+{
+    bslmt::ThreadUtil::Handle handle;
+    {
+        bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+
+        if (bslmt::ThreadUtil::invalidHandle() == d_threadHandle) {
+            return;                                                   // RETURN
+        }
+
+        d_stopFlag = true;
+        d_jobCondition.signal();
+
+        handle         = d_threadHandle;
+        d_threadHandle = bslmt::ThreadUtil::invalidHandle();
+    }
+
+    bslmt::ThreadUtil::join(handle);
+}
+
+// ACCESSORS
+bool LogFileCompressor::isStarted() const
+{
+    bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+
+    return bslmt::ThreadUtil::invalidHandle() != d_threadHandle;
+}
+
+int LogFileCompressor::numPendingFiles() const
+{
+    bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+
+    return static_cast<int>(d_jobs.size()) + (d_busyFlag ? 1 : 0);
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+// ----------------------------------------------------------------------------
+// Copyright 2020 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
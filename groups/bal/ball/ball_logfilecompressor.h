@@ -0,0 +1,332 @@
+// ball_logfilecompressor.h                                           -*-C++-*-
+#ifndef INCLUDED_BALL_LOGFILECOMPRESSOR
+#define INCLUDED_BALL_LOGFILECOMPRESSOR
+
+#include <bsls_ident.h>
+BSLS_IDENT("$Id: $")
+
+//@PURPOSE: Provide a mechanism that compresses log files in the background.
+//
+//@CLASSES:
+//  ball::LogFileCompressor: background gzip compressor of (rotated) log files
+//
+//@SEE_ALSO: ball_fileobserver2, ball_logfilecleanerutil
+//
+//@DESCRIPTION: This component provides a mechanism,
+// 'ball::LogFileCompressor', that compresses files -- typically log files
+// that have just been rotated by a 'ball::FileObserver2' -- on a dedicated
+// background thread.  A client supplies the name of a file to
+// 'compressFileAsync', along with a callback; the call returns immediately,
+// and the background thread later writes the compressed contents of the file
+// to a new file whose name is the original name followed by the suffix ".gz"
+// (see 'k_COMPRESSED_FILE_SUFFIX'), removes the original file, and invokes the
+// callback with the status of the operation and the name of the resulting
+// file.  Files are compressed one at a time, in the order in which they were
+// supplied.  The compression itself is also available synchronously through
+// the 'compressFile' class method.
+//
+///Compressed File Format
+///----------------------
+// Compressed files are written in the gzip format (RFC 1952), and can
+// therefore be read by standard tools (e.g., 'zcat', 'zgrep', and 'gzip -d').
+// The compressed data is encoded by a self-contained implementation of the
+// DEFLATE algorithm (RFC 1951) that uses a 32-kilobyte LZ77 window and the
+// fixed Huffman codes of the format.  This encoding trades some compression
+// ratio (compared to, e.g., 'gzip -6') for speed, bounded memory use, and the
+// absence of any dependency on a third-party compression library; typical log
+// files are reduced to between a fifth and a third of their original size.
+//
+///Thread Safety
+///-------------
+// 'ball::LogFileCompressor' is *thread-safe*: its methods may be called
+// concurrently from multiple threads.  The callbacks supplied to
+// 'compressFileAsync' are invoked from the background thread, and must not
+// call 'stop' or 'drain' on the compressor that invokes them.
+//
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Compressing a Log File in the Background
+///- - - - - - - - - - - - - - - - - - - - - - - - - -
+// In the following example we compress a log file without blocking the
+// thread that requests the compression.
+//
+// First, we define a callback that records the outcome of the compression:
+//..
+//  void onCompressed(int                *status,
+//                    bsl::string        *result,
+//                    int                 compressionStatus,
+//                    const bsl::string&  compressedFileName)
+//  {
+//      *status = compressionStatus;
+//      *result = compressedFileName;
+//  }
+//..
+// Then, we write a log file that we want to compress:
+//..
+//  bsl::string fileName = tempDirectory + "/example.log";
+//  {
+//      bsl::ofstream file(fileName.c_str());
+//      for (int i = 0; i < 1000; ++i) {
+//          file << "INFO example.cpp:42 EXAMPLE message " << i << '\n';
+//      }
+//  }
+//..
+// Next, we create a compressor and start its background thread:
+//..
+//  ball::LogFileCompressor compressor;
+//  int rc = compressor.start();
+//  assert(0 == rc);
+//..
+// Now, we request the compression of the file.  The call returns
+// immediately:
+//..
+//  int         status = -1;
+//  bsl::string compressedFileName;
+//
+//  compressor.compressFileAsync(
+//                     fileName,
+//                     bdlf::BindUtil::bind(&onCompressed,
+//                                          &status,
+//                                          &compressedFileName,
+//                                          bdlf::PlaceHolders::_1,
+//                                          bdlf::PlaceHolders::_2));
+//..
+// Finally, we wait for the compression to complete, and observe that the log
+// file was replaced by its compressed counterpart:
+//..
+//  compressor.drain();
+//
+//  assert(0 == status);
+//  assert(fileName + ".gz" == compressedFileName);
+//  assert( bdls::FilesystemUtil::exists(compressedFileName));
+//  assert(!bdls::FilesystemUtil::exists(fileName));
+//..
+
+#include <balscm_version.h>
+
+#include <bslma_allocator.h>
+#include <bslma_usesbslmaallocator.h>
+
+#include <bslmf_nestedtraitdeclaration.h>
+
+#include <bslmt_condition.h>
+#include <bslmt_mutex.h>
+#include <bslmt_threadutil.h>
+
+#include <bsl_deque.h>
+#include <bsl_functional.h>
+#include <bsl_string.h>
+
+namespace BloombergLP {
+namespace ball {
+
+                        // ===========================
+                        // class LogFileCompressor_Job
+                        // ===========================
+
+class LogFileCompressor_Job {
+    // This component-private class describes one file submitted for
+    // compression.
+
+  public:
+    // PUBLIC TYPES
+    typedef bsl::function<void(int, const bsl::string&)> CompletionCallback;
+        // 'CompletionCallback' is an alias for the type of the callback
+        // invoked once the file is compressed (see 'LogFileCompressor').
+
+    // PUBLIC DATA
+    bsl::string        d_fileName;  // file to compress
+
+    CompletionCallback d_callback;  // completion callback
+
+    // TRAITS
+    BSLMF_NESTED_TRAIT_DECLARATION(LogFileCompressor_Job,
+                                   bslma::UsesBslmaAllocator);
+
+    // CREATORS
+    LogFileCompressor_Job(const bsl::string&         fileName,
+                          const CompletionCallback&  callback,
+                          bslma::Allocator          *allocator);
+        // Create a job for the specified 'fileName' and 'callback'.  Use the
+        // specified 'allocator' to supply memory.
+
+    LogFileCompressor_Job(const LogFileCompressor_Job&  original,
+                          bslma::Allocator             *allocator);
+        // Create a job having the value of the specified 'original' job.  Use
+        // the specified 'allocator' to supply memory.
+};
+
+                          // =======================
+                          // class LogFileCompressor
+                          // =======================
+
+class LogFileCompressor {
+    // This mechanism compresses files, in the gzip format, on a background
+    // thread.  This class is thread-safe (see {Thread Safety}).
+
+  public:
+    // PUBLIC TYPES
+    typedef LogFileCompressor_Job::CompletionCallback CompletionCallback;
+        // 'CompletionCallback' is an alias for a callback invoked after the
+        // compressor attempts to compress a file.  The callback takes two
+        // arguments: (1) an integer status value where 0 indicates that the
+        // file was compressed (and removed) successfully, and (2) the name of
+        // the compressed file on success, and the name of the (uncompressed)
+        // file otherwise.
+
+    // CLASS DATA
+    static const char k_COMPRESSED_FILE_SUFFIX[];  // ".gz"
+
+  private:
+    // DATA
+    bsl::deque<LogFileCompressor_Job> d_jobs;          // files to compress, in
+                                                       // order of submission
+
+    mutable bslmt::Mutex              d_mutex;         // serialize access to
+                                                       // the data members
+
+    bslmt::Condition                  d_jobCondition;  // signaled when a job
+                                                       // is submitted, or the
+                                                       // thread must stop
+
+    bslmt::Condition                  d_idleCondition; // signaled when all
+                                                       // submitted jobs are
+                                                       // complete
+
+    bool                              d_busyFlag;      // 'true' while a job is
+                                                       // being processed
+
+    bool                              d_stopFlag;      // 'true' when the
+                                                       // thread must stop
+                                                       // once idle
+
+    bslmt::ThreadUtil::Handle         d_threadHandle;  // background thread, or
+                                                       // the invalid handle
+
+    bslma::Allocator                 *d_allocator_p;   // memory allocator
+                                                       // (held, not owned)
+
+  private:
+    // NOT IMPLEMENTED
+    LogFileCompressor(const LogFileCompressor&);
+    LogFileCompressor& operator=(const LogFileCompressor&);
+
+    // PRIVATE MANIPULATORS
+    void threadEntryPoint();
+        // Process the submitted jobs, in order, until 'stop' is called and no
+        // job remains.
+
+  public:
+    // TRAITS
+    BSLMF_NESTED_TRAIT_DECLARATION(LogFileCompressor,
+                                   bslma::UsesBslmaAllocator);
+
+    // CLASS METHODS
+    static int compressFile(const char       *compressedFileName,
+                            const char       *fileName,
+                            bslma::Allocator *basicAllocator = 0);
+        // Write the contents of the file having the specified 'fileName',
+        // compressed in the gzip format, to the file having the specified
+        // 'compressedFileName', replacing any existing file by that name.
+        // Optionally specify a 'basicAllocator' used to supply memory for
+        // temporary buffers.  If 'basicAllocator' is 0, the currently
+        // installed default allocator is used.  Return 0 on success, and a
+        // non-zero value otherwise, in which case no file named
+        // 'compressedFileName' remains.  Note that the file named 'fileName'
+        // is not modified.
+
+    // CREATORS
+    explicit LogFileCompressor(bslma::Allocator *basicAllocator = 0);
+        // Create a compressor whose background thread is not started.
+        // Optionally specify a 'basicAllocator' used to supply memory.  If
+        // 'basicAllocator' is 0, the currently installed default allocator is
+        // used.
+
+    ~LogFileCompressor();
+        // Compress the files submitted to this compressor that remain to be
+        // compressed, stop the background thread, and destroy this object.
+        // Note that files are not compressed if the background thread was
+        // never started.
+
+    // MANIPULATORS
+    void compressFileAsync(const bsl::string&        fileName,
+                           const CompletionCallback& callback);
+        // Submit the file having the specified 'fileName' for compression by
+        // the background thread of this compressor, and invoke the specified
+        // 'callback' from the background thread once the compression has been
+        // attempted.  On success, the compressed file is named 'fileName'
+        // followed by 'k_COMPRESSED_FILE_SUFFIX', and the file named
+        // 'fileName' is removed.  Note that this method does not block on the
+        // compression of this or any other file; the file is compressed once
+        // the background thread is started (see 'start').
+
+    void drain();
+        // Block until all the files submitted to this compressor have been
+        // compressed (and their callbacks have returned).  The behavior is
+        // undefined unless the background thread of this compressor is
+        // started, and this method is called from a thread other than the
+        // background thread.
+
+    int start();
+        // Start the background thread of this compressor if it is not already
+        // started.  Return 0 on success, and a non-zero value otherwise.
+
+    void stop();
+        // Compress the files submitted to this compressor that remain to be
+        // compressed and then stop the background thread of this compressor.
+        // This method has no effect if the thread is not started.  The
+        // behavior is undefined if this method is called from the background
+        // thread.
+
+    // ACCESSORS
+    bool isStarted() const;
+        // Return 'true' if the background thread of this compressor is
+        // started, and 'false' otherwise.
+
+    int numPendingFiles() const;
+        // Return the number of files submitted to this compressor whose
+        // compression is not complete.
+
+                                  // Aspects
+
+    bslma::Allocator *allocator() const;
+        // Return the allocator used by this object to supply memory.
+};
+
+// ============================================================================
+//                              INLINE DEFINITIONS
+// ============================================================================
+
+                          // -----------------------
+                          // class LogFileCompressor
+                          // -----------------------
+
+// ACCESSORS
+inline
+bslma::Allocator *LogFileCompressor::allocator() const
+{
+    return d_allocator_p;
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2020 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
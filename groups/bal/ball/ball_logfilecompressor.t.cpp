@@ -0,0 +1,1121 @@
+// ball_logfilecompressor.t.cpp                                       -*-C++-*-
+#include <ball_logfilecompressor.h>
+
+#include <bdlde_crc32.h>
+
+#include <bdlf_bind.h>
+#include <bdlf_placeholder.h>
+
+#include <bdls_filesystemutil.h>
+#include <bdls_pathutil.h>
+
+#include <bslim_testutil.h>
+
+#include <bslma_default.h>
+#include <bslma_defaultallocatorguard.h>
+#include <bslma_testallocator.h>
+#include <bslma_usesbslmaallocator.h>
+
+#include <bslmf_nestedtraitdeclaration.h>
+
+#include <bslmt_mutex.h>
+#include <bslmt_lockguard.h>
+
+#include <bsls_platform.h>
+#include <bsls_review.h>
+#include <bsls_stopwatch.h>
+#include <bsls_types.h>
+
+#include <bsl_cstdio.h>
+#include <bsl_cstdlib.h>
+#include <bsl_cstring.h>
+#include <bsl_fstream.h>
+#include <bsl_iostream.h>
+#include <bsl_sstream.h>
+#include <bsl_string.h>
+#include <bsl_vector.h>
+
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+#include <windows.h>
+#endif
+
+using namespace BloombergLP;
+using namespace bsl;
+
+// ============================================================================
+//                                   TEST PLAN
+// ----------------------------------------------------------------------------
+//                                   Overview
+//                                   --------
+// The component under test is a mechanism that compresses files, in the gzip
+// format, on a background thread.  We verify the compressed format by
+// decoding the output with a minimal gzip decoder implemented in this test
+// driver (supporting the subset of DEFLATE produced by the component), which
+// also verifies the CRC and the size recorded in the gzip trailer.  We then
+// verify that files submitted for asynchronous compression are compressed in
+// order, that the originals are removed on success (and only on success), and
+// that the completion callbacks report the outcome of each compression.
+// ----------------------------------------------------------------------------
+// CLASS METHODS
+// [ 2] static int compressFile(const char *, const char *, Allocator * = 0);
+//
+// CREATORS
+// [ 3] LogFileCompressor(bslma::Allocator *basicAllocator = 0);
+// [ 3] ~LogFileCompressor();
+//
+// MANIPULATORS
+// [ 3] void compressFileAsync(const string&, const CompletionCallback&);
+// [ 3] void drain();
+// [ 3] int start();
+// [ 3] void stop();
+//
+// ACCESSORS
+// [ 3] bool isStarted() const;
+// [ 3] int numPendingFiles() const;
+// [ 3] bslma::Allocator *allocator() const;
+// ----------------------------------------------------------------------------
+// [ 1] BREATHING TEST
+// [ 4] INCOMPRESSIBLE INPUT
+// [ 5] USAGE EXAMPLE
+// [-1] PERFORMANCE: COMPRESSION THROUGHPUT AND RATIO
+
+// ============================================================================
+//                     STANDARD BDE ASSERT TEST FUNCTION
+// ----------------------------------------------------------------------------
+
+namespace {
+
+int testStatus = 0;
+
+void aSsErT(bool condition, const char *message, int line)
+{
+    if (condition) {
+        cout << "Error " __FILE__ "(" << line << "): " << message
+             << "    (failed)" << endl;
+
+        if (0 <= testStatus && testStatus <= 100) {
+            ++testStatus;
+        }
+    }
+}
+
+}  // close unnamed namespace
+
+// ============================================================================
+//               STANDARD BDE TEST DRIVER MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT       BSLIM_TESTUTIL_ASSERT
+#define ASSERTV      BSLIM_TESTUTIL_ASSERTV
+
+#define LOOP_ASSERT  BSLIM_TESTUTIL_LOOP_ASSERT
+#define LOOP0_ASSERT BSLIM_TESTUTIL_LOOP0_ASSERT
+#define LOOP1_ASSERT BSLIM_TESTUTIL_LOOP1_ASSERT
+#define LOOP2_ASSERT BSLIM_TESTUTIL_LOOP2_ASSERT
+#define LOOP3_ASSERT BSLIM_TESTUTIL_LOOP3_ASSERT
+#define LOOP4_ASSERT BSLIM_TESTUTIL_LOOP4_ASSERT
+#define LOOP5_ASSERT BSLIM_TESTUTIL_LOOP5_ASSERT
+#define LOOP6_ASSERT BSLIM_TESTUTIL_LOOP6_ASSERT
+
+#define Q            BSLIM_TESTUTIL_Q   // Quote identifier literally.
+#define P            BSLIM_TESTUTIL_P   // Print identifier and value.
+#define P_           BSLIM_TESTUTIL_P_  // P(X) without '\n'.
+#define T_           BSLIM_TESTUTIL_T_  // Print a tab (w/o newline).
+#define L_           BSLIM_TESTUTIL_L_  // current Line number
+
+// ============================================================================
+//                  GLOBAL TYPEDEFS/CONSTANTS FOR TESTING
+// ----------------------------------------------------------------------------
+
+typedef ball::LogFileCompressor Obj;
+typedef bdls::FilesystemUtil    FsUtil;
+
+// ============================================================================
+//                          HELPER FUNCTIONS FOR TESTING
+// ----------------------------------------------------------------------------
+
+namespace {
+
+class TempDirectoryGuard {
+    // This class implements a scoped temporary directory guard.  The guard
+    // tries to create a temporary directory in the system-wide temp directory
+    // and falls back to the current directory.
+
+    // DATA
+    bsl::string       d_dirName;      // path to the created directory
+    bslma::Allocator *d_allocator_p;  // memory allocator (held, not owned)
+
+  private:
+    // NOT IMPLEMENTED
+    TempDirectoryGuard(const TempDirectoryGuard&);
+    TempDirectoryGuard& operator=(const TempDirectoryGuard&);
+
+  public:
+    // TRAITS
+    BSLMF_NESTED_TRAIT_DECLARATION(TempDirectoryGuard,
+                                   bslma::UsesBslmaAllocator);
+
+    // CREATORS
+    explicit TempDirectoryGuard(bslma::Allocator *basicAllocator = 0)
+        // Create temporary directory in the system-wide temp or current
+        // directory.  Optionally specify a 'basicAllocator' used to supply
+        // memory.  If 'basicAllocator' is 0, the currently installed default
+        // allocator is used.
+    : d_dirName(bslma::Default::allocator(basicAllocator))
+    , d_allocator_p(bslma::Default::allocator(basicAllocator))
+    {
+        bsl::string tmpPath(d_allocator_p);
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+        char tmpPathBuf[MAX_PATH];
+        GetTempPath(MAX_PATH, tmpPathBuf);
+        tmpPath.assign(tmpPathBuf);
+#else
+        const char *envTmpPath = bsl::getenv("TMPDIR");
+        if (envTmpPath) {
+            tmpPath.assign(envTmpPath);
+        }
+#endif
+
+        int res = bdls::PathUtil::appendIfValid(&tmpPath, "ball_");
+        ASSERTV(tmpPath, 0 == res);
+
+        res = bdls::FilesystemUtil::createTemporaryDirectory(&d_dirName,
+                                                             tmpPath);
+        ASSERTV(tmpPath, 0 == res);
+    }
+
+    ~TempDirectoryGuard()
+        // Destroy this object and remove the temporary directory (recursively)
+        // created at construction.
+    {
+        bdls::FilesystemUtil::remove(d_dirName, true);
+    }
+
+    // ACCESSORS
+    const bsl::string& getTempDirName() const
+        // Return a 'const' reference to the name of the created temporary
+        // directory.
+    {
+        return d_dirName;
+    }
+};
+
+void writeFile(const bsl::string& fileName, const bsl::string& contents)
+    // Write the specified 'contents' to the file having the specified
+    // 'fileName', replacing any existing file by that name.
+{
+    bsl::ofstream file(fileName.c_str(), bsl::ios::binary);
+    file.write(contents.data(), contents.size());
+    ASSERTV(fileName, file.good());
+}
+
+bsl::string readFile(const bsl::string& fileName)
+    // Return the contents of the file having the specified 'fileName'.
+{
+    bsl::ifstream      file(fileName.c_str(), bsl::ios::binary);
+    bsl::ostringstream contents;
+    contents << file.rdbuf();
+    return contents.str();
+}
+
+bsl::string makeLogText(int numLines)
+    // Return text resembling the specified 'numLines' lines of a log file.
+{
+    static const char *const k_CATEGORIES[] = {
+        "REQUEST", "RESPONSE", "CACHE", "DATABASE"
+    };
+
+    bsl::string result;
+    char        line[256];
+
+    for (int i = 0; i < numLines; ++i) {
+        bsl::sprintf(line,
+                     "\n17JUN2020_16:%02d:%02d.%03d 4711:%d INFO "
+                     "server.cpp:%d %s processed request %d in %d us\n",
+                     (i / 6000) % 60,
+                     (i / 100) % 60,
+                     (i * 7) % 1000,
+                     1 + i % 8,
+                     100 + (i * 13) % 400,
+                     k_CATEGORIES[i % 4],
+                     i,
+                     (i * 7919) % 100000);
+        result += line;
+    }
+    return result;
+}
+
+bsl::string makeRandomData(int length, unsigned int seed)
+    // Return the specified 'length' pseudo-random bytes generated from the
+    // specified 'seed'.
+{
+    bsl::string result(length, '\0');
+    for (int i = 0; i < length; ++i) {
+        seed = seed * 1103515245 + 12345;
+        result[i] = static_cast<char>(seed >> 16);
+    }
+    return result;
+}
+
+                            // ===================
+                            // class InflateReader
+                            // ===================
+
+class InflateReader {
+    // This class decodes a DEFLATE stream made of stored blocks and of blocks
+    // compressed using the fixed Huffman codes, which is the subset of
+    // DEFLATE produced by the component under test.
+
+    // DATA
+    const unsigned char *d_data;       // compressed data
+    bsl::size_t          d_length;     // length of the compressed data
+    bsl::size_t          d_bitOffset;  // offset of the next bit to read
+    bool                 d_error;      // 'true' if the data is truncated
+
+  public:
+    // CREATORS
+    InflateReader(const unsigned char *data, bsl::size_t length)
+        // Create a reader of the specified 'length' bytes at the specified
+        // 'data'.
+    : d_data(data)
+    , d_length(length)
+    , d_bitOffset(0)
+    , d_error(false)
+    {
+    }
+
+    // MANIPULATORS
+    unsigned int bits(int numBits)
+        // Return the next specified 'numBits' bits of the stream, the first
+        // bit being the least significant.
+    {
+        unsigned int result = 0;
+        for (int i = 0; i < numBits; ++i) {
+            if (d_bitOffset / 8 >= d_length) {
+                d_error = true;
+                return 0;                                             // RETURN
+            }
+            const unsigned int bit =
+                         (d_data[d_bitOffset / 8] >> (d_bitOffset % 8)) & 1;
+            result |= bit << i;
+            ++d_bitOffset;
+        }
+        return result;
+    }
+
+    unsigned int code(int numBits)
+        // Return the next specified 'numBits' bits of the stream, the first
+        // bit being the most significant.
+    {
+        unsigned int result = 0;
+        for (int i = 0; i < numBits; ++i) {
+            result = (result << 1) | bits(1);
+        }
+        return result;
+    }
+
+    int fixedSymbol()
+        // Return the next literal/length symbol, encoded using the fixed
+        // Huffman code.
+    {
+        unsigned int value = code(7);
+        if (0x17 >= value) {
+            return 256 + value;                                       // RETURN
+        }
+        value = (value << 1) | bits(1);
+        if (0x30 <= value && 0xbf >= value) {
+            return value - 0x30;                                      // RETURN
+        }
+        if (0xc0 <= value && 0xc7 >= value) {
+            return 280 + value - 0xc0;                                // RETURN
+        }
+        value = (value << 1) | bits(1);
+        return 144 + value - 0x190;
+    }
+
+    void alignToByte()
+        // Skip to the next byte boundary.
+    {
+        d_bitOffset = (d_bitOffset + 7) / 8 * 8;
+    }
+
+    // ACCESSORS
+    bool error() const
+        // Return 'true' if the data was exhausted, and 'false' otherwise.
+    {
+        return d_error;
+    }
+
+    bsl::size_t byteOffset() const
+        // Return the offset of the byte following the last bit read.
+    {
+        return (d_bitOffset + 7) / 8;
+    }
+};
+
+int gunzip(bsl::string *result, const bsl::string& compressed)
+    // Load into the specified 'result' the data decoded from the specified
+    // 'compressed' gzip stream.  Return 0 on success, and a non-zero value if
+    // 'compressed' is not a valid gzip stream (of the subset of DEFLATE
+    // supported by 'InflateReader'), or if the CRC or the size in its trailer
+    // do not match the decoded data.
+{
+    static const int k_LENGTH_BASE[] = {
+        3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31, 35, 43, 51,
+        59, 67, 83, 99, 115, 131, 163, 195, 227, 258
+    };
+    static const int k_LENGTH_EXTRA[] = {
+        0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4,
+        4, 5, 5, 5, 5, 0
+    };
+    static const int k_DISTANCE_BASE[] = {
+        1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193, 257, 385,
+        513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385,
+        24577
+    };
+    static const int k_DISTANCE_EXTRA[] = {
+        0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10,
+        10, 11, 11, 12, 12, 13, 13
+    };
+
+    const unsigned char *data =
+                     reinterpret_cast<const unsigned char *>(compressed.data());
+
+    if (18 > compressed.size()
+     || 0x1f != data[0] || 0x8b != data[1] || 8 != data[2] || 0 != data[3]) {
+        return 1;                                                     // RETURN
+    }
+
+    InflateReader reader(data + 10, compressed.size() - 10);
+    result->clear();
+
+    bool final = false;
+    while (!final) {
+        final = 1 == reader.bits(1);
+
+        const unsigned int type = reader.bits(2);
+        if (0 == type) {
+            reader.alignToByte();
+            const unsigned int length = reader.bits(16);
+            if ((length ^ 0xffff) != reader.bits(16)) {
+                return 2;                                             // RETURN
+            }
+            for (unsigned int i = 0; i < length; ++i) {
+                result->push_back(static_cast<char>(reader.bits(8)));
+            }
+        }
+        else if (1 == type) {
+            for (;;) {
+                const int symbol = reader.fixedSymbol();
+                if (reader.error() || 285 < symbol) {
+                    return 3;                                         // RETURN
+                }
+                if (256 > symbol) {
+                    result->push_back(static_cast<char>(symbol));
+                    continue;
+                }
+                if (256 == symbol) {
+                    break;
+                }
+                const int lengthCode = symbol - 257;
+                const int length     = k_LENGTH_BASE[lengthCode]
+                                     + reader.bits(k_LENGTH_EXTRA[lengthCode]);
+
+                const unsigned int distanceCode = reader.code(5);
+                if (29 < distanceCode) {
+                    return 4;                                         // RETURN
+                }
+                const bsl::size_t distance =
+                                   k_DISTANCE_BASE[distanceCode]
+                                 + reader.bits(k_DISTANCE_EXTRA[distanceCode]);
+                if (distance > result->size() || 32768 < distance) {
+                    return 5;                                         // RETURN
+                }
+                for (int i = 0; i < length; ++i) {
+                    result->push_back((*result)[result->size() - distance]);
+                }
+            }
+        }
+        else {
+            return 6;                                                 // RETURN
+        }
+        if (reader.error()) {
+            return 7;                                                 // RETURN
+        }
+    }
+
+    const bsl::size_t trailer = 10 + reader.byteOffset();
+    if (trailer + 8 != compressed.size()) {
+        return 8;                                                     // RETURN
+    }
+
+    unsigned int crc  = 0;
+    unsigned int size = 0;
+    for (int i = 3; i >= 0; --i) {
+        crc  = (crc  << 8) | data[trailer + i];
+        size = (size << 8) | data[trailer + 4 + i];
+    }
+
+    if (crc != bdlde::Crc32(result->data(), result->size()).checksum()
+     || size != static_cast<unsigned int>(result->size())) {
+        return 9;                                                     // RETURN
+    }
+    return 0;
+}
+
+                           // ======================
+                           // class CompletionRecord
+                           // ======================
+
+class CompletionRecord {
+    // This class records the invocations of the completion callback of a
+    // compressor.
+
+    // DATA
+    mutable bslmt::Mutex     d_mutex;     // serialize access
+    bsl::vector<int>         d_statuses;  // statuses, in order of invocation
+    bsl::vector<bsl::string> d_names;     // names, in order of invocation
+
+  private:
+    // NOT IMPLEMENTED
+    CompletionRecord(const CompletionRecord&);
+    CompletionRecord& operator=(const CompletionRecord&);
+
+  public:
+    // CREATORS
+    explicit CompletionRecord(bslma::Allocator *basicAllocator)
+        // Create an empty record.  Use the specified 'basicAllocator' to
+        // supply memory.
+    : d_statuses(basicAllocator)
+    , d_names(basicAllocator)
+    {
+    }
+
+    // MANIPULATORS
+    void onCompletion(int status, const bsl::string& fileName)
+        // Record an invocation having the specified 'status' and 'fileName'.
+    {
+        bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+        d_statuses.push_back(status);
+        d_names.push_back(fileName);
+    }
+
+    // ACCESSORS
+    int numCompletions() const
+        // Return the number of recorded invocations.
+    {
+        bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+        return static_cast<int>(d_statuses.size());
+    }
+
+    bsl::string name(int index) const
+        // Return the file name of the specified 'index'th invocation.
+    {
+        bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+        return d_names[index];
+    }
+
+    int status(int index) const
+        // Return the status of the specified 'index'th invocation.
+    {
+        bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+        return d_statuses[index];
+    }
+};
+
+Obj::CompletionCallback makeCallback(CompletionRecord *record)
+    // Return a completion callback that records its invocations in the
+    // specified 'record'.
+{
+    return bdlf::BindUtil::bind(&CompletionRecord::onCompletion,
+                                record,
+                                bdlf::PlaceHolders::_1,
+                                bdlf::PlaceHolders::_2);
+}
+
+}  // close unnamed namespace
+
+// ============================================================================
+//                                USAGE EXAMPLE
+// ----------------------------------------------------------------------------
+
+namespace {
+
+///Example 1: Compressing a Log File in the Background
+///- - - - - - - - - - - - - - - - - - - - - - - - - -
+// In the following example we compress a log file without blocking the
+// thread that requests the compression.
+//
+// First, we define a callback that records the outcome of the compression:
+//..
+    void onCompressed(int                *status,
+                      bsl::string        *result,
+                      int                 compressionStatus,
+                      const bsl::string&  compressedFileName)
+    {
+        *status = compressionStatus;
+        *result = compressedFileName;
+    }
+//..
+
+}  // close unnamed namespace
+
+// ============================================================================
+//                               MAIN PROGRAM
+// ----------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    const int                 test = argc > 1 ? atoi(argv[1]) : 0;
+    const bool             verbose = argc > 2;
+    const bool         veryVerbose = argc > 3;
+    const bool     veryVeryVerbose = argc > 4;
+    const bool veryVeryVeryVerbose = argc > 5;
+
+    (void)veryVeryVerbose;
+
+    cout << "TEST " << __FILE__ << " CASE " << test << endl;
+
+    // CONCERN: 'BSLS_REVIEW' failures should lead to test failures.
+    bsls::ReviewFailureHandlerGuard reviewGuard(&bsls::Review::failByAbort);
+
+    bslma::TestAllocator globalAllocator("global", veryVeryVeryVerbose);
+    bslma::Default::setGlobalAllocator(&globalAllocator);
+
+    bslma::TestAllocator defaultAllocator("default", veryVeryVeryVerbose);
+    bslma::DefaultAllocatorGuard guard(&defaultAllocator);
+
+    switch (test) { case 0:
+      case 5: {
+        // --------------------------------------------------------------------
+        // USAGE EXAMPLE
+        //   Extracted from component header file.
+        //
+        // Concerns:
+        //: 1 The usage example provided in the component header file compiles,
+        //:   links, and runs as shown.
+        //
+        // Plan:
+        //: 1 Incorporate usage example from header into test driver, replace
+        //:   leading comment characters with spaces, replace 'assert' with
+        //:   'ASSERT', and insert 'if (veryVerbose)' before all output
+        //:   operations.  (C-1)
+        //
+        // Testing:
+        //   USAGE EXAMPLE
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "USAGE EXAMPLE" << endl
+                          << "=============" << endl;
+
+        TempDirectoryGuard tempDirGuard;
+        const bsl::string& tempDirectory = tempDirGuard.getTempDirName();
+
+// Then, we write a log file that we want to compress:
+//..
+    bsl::string fileName = tempDirectory + "/example.log";
+    {
+        bsl::ofstream file(fileName.c_str());
+        for (int i = 0; i < 1000; ++i) {
+            file << "INFO example.cpp:42 EXAMPLE message " << i << '\n';
+        }
+    }
+//..
+// Next, we create a compressor and start its background thread:
+//..
+    ball::LogFileCompressor compressor;
+    int rc = compressor.start();
+    ASSERT(0 == rc);
+//..
+// Now, we request the compression of the file.  The call returns
+// immediately:
+//..
+    int         status = -1;
+    bsl::string compressedFileName;
+
+    compressor.compressFileAsync(
+                       fileName,
+                       bdlf::BindUtil::bind(&onCompressed,
+                                            &status,
+                                            &compressedFileName,
+                                            bdlf::PlaceHolders::_1,
+                                            bdlf::PlaceHolders::_2));
+//..
+// Finally, we wait for the compression to complete, and observe that the log
+// file was replaced by its compressed counterpart:
+//..
+    compressor.drain();
+
+    ASSERT(0 == status);
+    ASSERT(fileName + ".gz" == compressedFileName);
+    ASSERT( bdls::FilesystemUtil::exists(compressedFileName));
+    ASSERT(!bdls::FilesystemUtil::exists(fileName));
+//..
+      } break;
+      case 4: {
+        // --------------------------------------------------------------------
+        // INCOMPRESSIBLE INPUT
+        //
+        // Concerns:
+        //: 1 Input that cannot be compressed (e.g., data that is already
+        //:   compressed) grows by at most a few bytes per block, rather than
+        //:   by the cost of encoding every byte as a literal.
+        //:
+        //: 2 Input alternating between compressible and incompressible data
+        //:   is decoded correctly, and its compressible parts are compressed.
+        //
+        // Plan:
+        //: 1 Compress random data, and verify that the output decodes to the
+        //:   input and is no longer than the input, plus the gzip header and
+        //:   trailer, plus 5 bytes for each stored block of at most 16K.
+        //:   (C-1)
+        //:
+        //: 2 Compress an input made of alternating sections of random data
+        //:   and log text, and verify that the output decodes to the input and
+        //:   is shorter than the random data it contains plus half of its log
+        //:   text.  (C-2)
+        //
+        // Testing:
+        //   INCOMPRESSIBLE INPUT
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "INCOMPRESSIBLE INPUT" << endl
+                          << "====================" << endl;
+
+        TempDirectoryGuard tempDirGuard;
+        const bsl::string  input  = tempDirGuard.getTempDirName() + "/in.log";
+        const bsl::string  output = input + ".gz";
+
+        if (verbose) cout << "\tTesting random data." << endl;
+
+        static const int SIZES[] = { 1, 1000, 16384, 16385, 100000, 1000000 };
+        const int        NUM_SIZES = static_cast<int>(sizeof SIZES
+                                                      / sizeof *SIZES);
+
+        for (int i = 0; i < NUM_SIZES; ++i) {
+            const int         SIZE  = SIZES[i];
+            const bsl::string INPUT = makeRandomData(SIZE, 7 + i);
+
+            writeFile(input, INPUT);
+            ASSERTV(i, 0 == Obj::compressFile(output.c_str(), input.c_str()));
+
+            const bsl::string compressed = readFile(output);
+            bsl::string       decoded;
+
+            ASSERTV(i, 0 == gunzip(&decoded, compressed));
+            ASSERTV(i, INPUT == decoded);
+
+            const bsl::size_t numBlocks = SIZE / 16384 + 1;
+            const bsl::size_t maxSize   = SIZE + 18 + 5 * numBlocks;
+
+            if (veryVerbose) { T_ P_(SIZE) P_(compressed.size()) P(maxSize) }
+
+            ASSERTV(i, compressed.size(), maxSize,
+                    compressed.size() <= maxSize);
+        }
+
+        if (verbose) cout << "\tTesting mixed data." << endl;
+        {
+            bsl::string INPUT;
+            bsl::size_t randomSize = 0;
+            for (int i = 0; i < 8; ++i) {
+                const bsl::string random = makeRandomData(40000, 100 + i);
+
+                INPUT      += random;
+                INPUT      += makeLogText(100 * (i + 1));
+                randomSize += random.size();
+            }
+
+            writeFile(input, INPUT);
+            ASSERT(0 == Obj::compressFile(output.c_str(), input.c_str()));
+
+            const bsl::string compressed = readFile(output);
+            bsl::string       decoded;
+
+            ASSERT(0 == gunzip(&decoded, compressed));
+            ASSERT(INPUT == decoded);
+
+            if (veryVerbose) {
+                T_ P_(INPUT.size()) P_(randomSize) P(compressed.size())
+            }
+
+            const bsl::size_t textSize = INPUT.size() - randomSize;
+
+            ASSERTV(compressed.size(), randomSize, textSize,
+                    compressed.size() < randomSize + textSize / 2);
+        }
+      } break;
+      case 3: {
+        // --------------------------------------------------------------------
+        // ASYNCHRONOUS COMPRESSION
+        //
+        // Concerns:
+        //: 1 Files submitted before the thread is started are compressed once
+        //:   it is started, and 'numPendingFiles' reflects the files whose
+        //:   compression is not complete.
+        //:
+        //: 2 Files are compressed in order of submission, the originals are
+        //:   removed, and each callback is invoked with a status of 0 and the
+        //:   name of the compressed file.
+        //:
+        //: 3 If a file cannot be compressed, the callback is invoked with a
+        //:   non-zero status and the name of the original file, and the
+        //:   original file (if any) is not removed.
+        //:
+        //: 4 'stop' (and the destructor) compress the pending files before
+        //:   stopping the thread, and the thread can be restarted.
+        //:
+        //: 5 All memory is supplied by the object allocator.
+        //
+        // Plan:
+        //: 1 Submit files, with callbacks recording their invocations, before
+        //:   and after starting the thread, and verify the callbacks, the
+        //:   files, and the compressed contents.  (C-1..5)
+        //
+        // Testing:
+        //   LogFileCompressor(bslma::Allocator *basicAllocator = 0);
+        //   ~LogFileCompressor();
+        //   void compressFileAsync(const string&, const CompletionCallback&);
+        //   void drain();
+        //   int start();
+        //   void stop();
+        //   bool isStarted() const;
+        //   int numPendingFiles() const;
+        //   bslma::Allocator *allocator() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "ASYNCHRONOUS COMPRESSION" << endl
+                          << "========================" << endl;
+
+        TempDirectoryGuard tempDirGuard;
+        const bsl::string& dir = tempDirGuard.getTempDirName();
+
+        const int   NUM_FILES = 5;
+        bsl::string names[NUM_FILES];
+        bsl::string contents[NUM_FILES];
+
+        for (int i = 0; i < NUM_FILES; ++i) {
+            bsl::ostringstream name;
+            name << dir << "/rotated.log." << i;
+            names[i]    = name.str();
+            contents[i] = makeLogText(100 * (i + 1));
+            writeFile(names[i], contents[i]);
+        }
+
+        bslma::TestAllocator oa("object", veryVeryVeryVerbose);
+        bslma::TestAllocator ra("record", veryVeryVeryVerbose);
+
+        const bsls::Types::Int64 numDefaultBlocks =
+                                             defaultAllocator.numBlocksInUse();
+
+        {
+            CompletionRecord completions(&ra);
+
+            Obj mX(&oa);  const Obj& X = mX;
+
+            ASSERT(&oa   == X.allocator());
+            ASSERT(false == X.isStarted());
+            ASSERT(0     == X.numPendingFiles());
+
+            if (veryVerbose) cout << "\tSubmitting before 'start'." << endl;
+
+            mX.compressFileAsync(names[0], makeCallback(&completions));
+            mX.compressFileAsync(names[1], makeCallback(&completions));
+
+            ASSERT(2 == X.numPendingFiles());
+            ASSERT(0 == completions.numCompletions());
+            ASSERT(FsUtil::exists(names[0]));
+
+            ASSERT(0    == mX.start());
+            ASSERT(true == X.isStarted());
+            ASSERT(0    == mX.start());
+
+            if (veryVerbose) cout << "\tSubmitting after 'start'." << endl;
+
+            const bsl::string missing = dir + "/missing.log";
+
+            mX.compressFileAsync(names[2], makeCallback(&completions));
+            mX.compressFileAsync(missing,  makeCallback(&completions));
+            mX.compressFileAsync(names[3], makeCallback(&completions));
+
+            mX.drain();
+
+            ASSERT(0 == X.numPendingFiles());
+            ASSERTV(completions.numCompletions(),
+                    5 == completions.numCompletions());
+
+            const int EXPECTED[] = { 0, 1, 2, -1, 3 };
+
+            for (int i = 0; i < 5; ++i) {
+                const int j = EXPECTED[i];
+                if (0 > j) {
+                    ASSERTV(i, 0 != completions.status(i));
+                    ASSERTV(i, missing == completions.name(i));
+                    ASSERTV(i, !FsUtil::exists(missing + ".gz"));
+                    continue;
+                }
+                ASSERTV(i, 0 == completions.status(i));
+                ASSERTV(i, names[j] + ".gz" == completions.name(i));
+                ASSERTV(i, !FsUtil::exists(names[j]));
+
+                bsl::string decoded;
+                ASSERTV(i, 0 == gunzip(&decoded,
+                                       readFile(names[j] + ".gz")));
+                ASSERTV(i, contents[j] == decoded);
+            }
+
+            if (veryVerbose) cout << "\tTesting 'stop' and restart." << endl;
+
+            mX.stop();
+            ASSERT(false == X.isStarted());
+            mX.stop();
+
+            mX.compressFileAsync(names[4], makeCallback(&completions));
+            ASSERT(1 == X.numPendingFiles());
+            ASSERT(0 == mX.start());
+            mX.stop();
+
+            ASSERT(6 == completions.numCompletions());
+            ASSERT(0 == completions.status(5));
+            ASSERT(!FsUtil::exists(names[4]));
+
+            if (veryVerbose) cout << "\tTesting the destructor." << endl;
+
+            writeFile(names[0], contents[0]);
+            ASSERT(0 == mX.start());
+            mX.compressFileAsync(names[0], makeCallback(&completions));
+        }
+
+        ASSERT(!FsUtil::exists(names[0]));
+        ASSERT( FsUtil::exists(names[0] + ".gz"));
+
+        ASSERT(0 <  oa.numAllocations());
+        ASSERT(0 == oa.numBlocksInUse());
+        ASSERT(numDefaultBlocks == defaultAllocator.numBlocksInUse());
+      } break;
+      case 2: {
+        // --------------------------------------------------------------------
+        // CLASS METHOD 'compressFile'
+        //
+        // Concerns:
+        //: 1 The output is a valid gzip stream that decodes to the input, for
+        //:   inputs that are empty, short, highly repetitive (matches of the
+        //:   maximal length), incompressible (every literal code length), and
+        //:   longer than the buffer of the implementation (window shifts and
+        //:   distances up to the window size).
+        //:
+        //: 2 An existing output file is replaced.
+        //:
+        //: 3 If the input cannot be read or the output cannot be created, a
+        //:   non-zero value is returned and no output file remains.
+        //:
+        //: 4 Temporary memory is supplied by the specified allocator.
+        //
+        // Plan:
+        //: 1 Compress a table of inputs, and decode the output with a
+        //:   reference decoder that verifies the gzip trailer.  (C-1..2, 4)
+        //:
+        //: 2 Attempt to compress a missing file, and to write to a missing
+        //:   directory.  (C-3)
+        //
+        // Testing:
+        //   static int compressFile(const char *, const char *, Allocator *);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "CLASS METHOD 'compressFile'" << endl
+                          << "===========================" << endl;
+
+        TempDirectoryGuard tempDirGuard;
+        const bsl::string  input  = tempDirGuard.getTempDirName() + "/in.log";
+        const bsl::string  output = input + ".gz";
+
+        bsl::vector<bsl::string> inputs;
+        inputs.push_back("");
+        inputs.push_back("x");
+        inputs.push_back("abc");
+        inputs.push_back("abcabcabcabcabcabcabcabcabcabc");
+        inputs.push_back(bsl::string(100000, 'a'));
+        inputs.push_back(makeRandomData(1000, 1));
+        inputs.push_back(makeRandomData(300000, 2));
+        inputs.push_back(makeLogText(10));
+        inputs.push_back(makeLogText(5000));
+        {
+            // Repeat a block of random data at the largest distances.
+
+            const bsl::string block = makeRandomData(32768, 3);
+            inputs.push_back(block + block + block);
+            inputs.push_back(block + "x" + block);
+        }
+
+        bslma::TestAllocator sa("scratch", veryVeryVeryVerbose);
+
+        for (bsl::size_t i = 0; i < inputs.size(); ++i) {
+            const bsl::string& INPUT = inputs[i];
+
+            if (veryVerbose) { T_ P_(i) P(INPUT.size()) }
+
+            writeFile(input, INPUT);
+            writeFile(output, "previous contents");
+
+            ASSERTV(i, 0 == Obj::compressFile(output.c_str(),
+                                              input.c_str(),
+                                              &sa));
+
+            const bsl::string compressed = readFile(output);
+            bsl::string       decoded;
+
+            ASSERTV(i, 0 == gunzip(&decoded, compressed));
+            ASSERTV(i, INPUT == decoded);
+            ASSERTV(i, readFile(input) == INPUT);
+
+            if (veryVerbose) { T_ T_ P(compressed.size()) }
+        }
+
+        ASSERT(0 <  sa.numAllocations());
+        ASSERT(0 == sa.numBlocksInUse());
+
+        if (verbose) cout << "\tTesting failures." << endl;
+        {
+            const bsl::string missing = tempDirGuard.getTempDirName()
+                                      + "/missing.log";
+            ASSERT(0 != Obj::compressFile(output.c_str(), missing.c_str()));
+
+            const bsl::string badOutput = tempDirGuard.getTempDirName()
+                                        + "/no/such/dir/out.gz";
+            ASSERT(0 != Obj::compressFile(badOutput.c_str(), input.c_str()));
+            ASSERT(!FsUtil::exists(badOutput));
+        }
+      } break;
+      case 1: {
+        // --------------------------------------------------------------------
+        // BREATHING TEST
+        //   This case exercises (but does not fully test) basic functionality.
+        //
+        // Concerns:
+        //: 1 The class is sufficiently functional to enable comprehensive
+        //:   testing in subsequent test cases.
+        //
+        // Plan:
+        //: 1 Compress a file synchronously and asynchronously.  (C-1)
+        //
+        // Testing:
+        //   BREATHING TEST
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "BREATHING TEST" << endl
+                          << "==============" << endl;
+
+        TempDirectoryGuard tempDirGuard;
+        const bsl::string  name = tempDirGuard.getTempDirName() + "/a.log";
+        const bsl::string  text = makeLogText(50);
+
+        writeFile(name, text);
+
+        ASSERT(0 == Obj::compressFile((name + ".1.gz").c_str(),
+                                      name.c_str()));
+
+        bsl::string decoded;
+        ASSERT(0 == gunzip(&decoded, readFile(name + ".1.gz")));
+        ASSERT(text == decoded);
+        ASSERT(readFile(name + ".1.gz").size() < text.size());
+
+        CompletionRecord completions(&defaultAllocator);
+        {
+            Obj mX;
+            ASSERT(0 == mX.start());
+            mX.compressFileAsync(name, makeCallback(&completions));
+        }
+        ASSERT(1 == completions.numCompletions());
+        ASSERT(0 == completions.status(0));
+        ASSERT(name + ".gz" == completions.name(0));
+        ASSERT(!FsUtil::exists(name));
+
+        decoded.clear();
+        ASSERT(0 == gunzip(&decoded, readFile(name + ".gz")));
+        ASSERT(text == decoded);
+      } break;
+      case -1: {
+        // --------------------------------------------------------------------
+        // PERFORMANCE: COMPRESSION THROUGHPUT AND RATIO
+        //
+        // Concerns:
+        //: 1 Compressing log files is fast enough to keep up with the volume
+        //:   of a busy process, and reduces their size significantly.
+        //
+        // Plan:
+        //: 1 Compress a file of synthetic log records, of a size optionally
+        //:   specified (in megabytes) as the second argument, and report the
+        //:   throughput and the compression ratio.
+        //
+        // Testing:
+        //   PERFORMANCE: COMPRESSION THROUGHPUT AND RATIO
+        // --------------------------------------------------------------------
+
+        cout << endl
+             << "PERFORMANCE: COMPRESSION THROUGHPUT AND RATIO" << endl
+             << "=============================================" << endl;
+
+        const int sizeMb = argc > 2 ? atoi(argv[2]) : 64;
+
+        TempDirectoryGuard tempDirGuard;
+        const bsl::string  name = tempDirGuard.getTempDirName() + "/perf.log";
+        {
+            const bsl::string  chunk = makeLogText(10000);
+            bsl::ofstream      file(name.c_str(), bsl::ios::binary);
+            bsls::Types::Int64 written = 0;
+            while (written < sizeMb * 1024LL * 1024) {
+                file.write(chunk.data(), chunk.size());
+                written += chunk.size();
+            }
+        }
+
+        const bsls::Types::Int64 inputSize = FsUtil::getFileSize(name);
+
+        bsls::Stopwatch timer;
+        timer.start();
+        ASSERT(0 == Obj::compressFile((name + ".gz").c_str(), name.c_str()));
+        timer.stop();
+
+        const bsls::Types::Int64 outputSize =
+                                            FsUtil::getFileSize(name + ".gz");
+
+        cout << "input: " << inputSize << " bytes, output: " << outputSize
+             << " bytes, ratio: "
+             << static_cast<double>(inputSize) / outputSize
+             << ", throughput: "
+             << inputSize / timer.elapsedTime() / (1024 * 1024)
+             << " MB/s" << endl;
+      } break;
+      default: {
+        cerr << "WARNING: CASE `" << test << "' NOT FOUND." << endl;
+        testStatus = -1;
+      }
+    }
+
+    if (testStatus > 0) {
+        cerr << "Error, non-zero test status = " << testStatus << "." << endl;
+    }
+
+    return testStatus;
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2020 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -7,8 +7,10 @@ BSLS_IDENT_RCSID(ball_loggermanager_cpp,"$Id$ $CSID$")
 #include <ball_attributecontext.h>
 #include <ball_context.h>
 #include <ball_fixedsizerecordbuffer.h>
+#include <ball_lockfreerecordbuffer.h>
 #include <ball_loggermanagerdefaults.h>
 #include <ball_recordattributes.h>
+#include <ball_recordcapture.h>
 #include <ball_severity.h>
 #include <ball_streamobserver.h>           // for testing only
 #include <ball_testobserver.h>             // for testing only
@@ -283,8 +285,10 @@ Logger::Logger(const bsl::shared_ptr<Observer>&            observer,
                int                                         scratchBufferSize,
                LoggerManagerConfiguration::LogOrder        logOrder,
                LoggerManagerConfiguration::TriggerMarkers  triggerMarkers,
+               RecordCapture                              *recordCapture,
                bslma::Allocator                           *globalAllocator)
 : d_recordPool(-1, globalAllocator)
+, d_handleAllocator(globalAllocator)
 , d_observer(observer)
 , d_recordBuffer_p(recordBuffer)
 , d_populator(populator)
@@ -293,6 +297,7 @@ Logger::Logger(const bsl::shared_ptr<Observer>&            observer,
 , d_scratchBufferSize(scratchBufferSize)
 , d_logOrder(logOrder)
 , d_triggerMarkers(triggerMarkers)
+, d_recordCapture_p(recordCapture)
 , d_allocator_p(globalAllocator)
 {
     BSLS_ASSERT(d_observer);
@@ -338,7 +343,21 @@ void Logger::logMessage(const Category&            category,
         d_populator(&record->customFields());
     }
 
-    bsl::shared_ptr<Record> handle(record, &d_recordPool, d_allocator_p);
+    if (d_recordCapture_p && d_recordCapture_p->isReservedRecord(record)) {
+        d_recordCapture_p->commitRecord(levels, this);
+        return;                                                       // RETURN
+    }
+
+    dispatchRecord(record, severity, levels);
+}
+
+void Logger::dispatchRecord(Record                    *record,
+                            int                        severity,
+                            const ThresholdAggregate&  levels)
+{
+    bsl::shared_ptr<Record> handle(record,
+                                   &d_recordPool,
+                                   &d_handleAllocator);
 
     if (levels.recordLevel() >= severity) {
         d_recordBuffer_p->pushBack(handle);
@@ -363,12 +382,13 @@ void Logger::logMessage(const Category&            category,
 
         if (Config::e_BEGIN_END_MARKERS == d_triggerMarkers) {
             Context triggerContext(Transmission::e_TRIGGER, 0, 1);
-            Record *marker = getRecord(record->fixedFields().fileName(),
-                                       record->fixedFields().lineNumber());
+            Record *marker = getPooledRecord(
+                                          record->fixedFields().fileName(),
+                                          record->fixedFields().lineNumber());
 
             bsl::shared_ptr<Record> handle(marker,
                                            &d_recordPool,
-                                           d_allocator_p);
+                                           &d_handleAllocator);
 
             copyAttributesWithoutMessage(handle.get(), record->fixedFields());
 
@@ -397,12 +417,13 @@ void Logger::logMessage(const Category&            category,
 
         if (Config::e_BEGIN_END_MARKERS == d_triggerMarkers) {
             Context triggerContext(Transmission::e_TRIGGER, 0, 1);
-            Record *marker = getRecord(record->fixedFields().fileName(),
-                                       record->fixedFields().lineNumber());
+            Record *marker = getPooledRecord(
+                                          record->fixedFields().fileName(),
+                                          record->fixedFields().lineNumber());
 
             bsl::shared_ptr<Record> handle(marker,
                                            &d_recordPool,
-                                           d_allocator_p);
+                                           &d_handleAllocator);
 
             copyAttributesWithoutMessage(handle.get(), record->fixedFields());
 
@@ -426,6 +447,32 @@ void Logger::logMessage(const Category&            category,
     }
 }
 
+Record *Logger::getPooledRecord(const char *file, int line)
+{
+    Record *record = d_recordPool.getObject();
+
+    // Note that the records obtained from the record pool are guaranteed to
+    // have all custom fields removed and the message stream cleared.  So only
+    // the filename and line number fields are initialized here.
+
+    record->fixedFields().setFileName(file);
+    record->fixedFields().setLineNumber(line);
+    return record;
+}
+
+void Logger::publishCapturedRecord(Record                    *record,
+                                   const ThresholdAggregate&  levels)
+{
+    // The captured record is owned by the record capture and its slot is
+    // reused as soon as this method returns, while observers may retain the
+    // published record indefinitely, so a pooled copy is published instead.
+
+    Record *copy = d_recordPool.getObject();
+    *copy = *record;
+
+    dispatchRecord(copy, copy->fixedFields().severity(), levels);
+}
+
 void Logger::publish(Transmission::Cause cause)
 {
     d_recordBuffer_p->beginSequence();
@@ -460,15 +507,20 @@ void Logger::publish(Transmission::Cause cause)
 // MANIPULATORS
 Record *Logger::getRecord(const char *file, int line)
 {
-    Record *record = d_recordPool.getObject();
+    if (d_recordCapture_p) {
+        Record *record = d_recordCapture_p->reserveRecord();
 
-    // Note that the records obtained from the record pool are guaranteed to
-    // have all custom fields removed and the message stream cleared.  So only
-    // the filename and line number fields are initialized here.
+        if (record) {
+            // Note that captured records are cleared when their slot is
+            // released, as are the records of the record pool.
 
-    record->fixedFields().setFileName(file);
-    record->fixedFields().setLineNumber(line);
-    return record;
+            record->fixedFields().setFileName(file);
+            record->fixedFields().setLineNumber(line);
+            return record;                                            // RETURN
+        }
+    }
+
+    return getPooledRecord(file, line);
 }
 
 void Logger::logMessage(const Category&  category,
@@ -485,7 +537,7 @@ void Logger::logMessage(const Category&  category,
         return;                                                       // RETURN
     }
 
-    Record *record = getRecord(fileName, lineNumber);
+    Record *record = getPooledRecord(fileName, lineNumber);
     record->fixedFields().setMessage(message);
     logMessage(category, severity, record, thresholds);
 }
@@ -496,7 +548,12 @@ void Logger::logMessage(const Category&  category,
 {
     ThresholdAggregate thresholds;
     if (!isCategoryEnabled(&thresholds, category, severity)) {
-        d_recordPool.deleteObject(record);
+        if (d_recordCapture_p && d_recordCapture_p->isReservedRecord(record)) {
+            d_recordCapture_p->cancelRecord();
+        }
+        else {
+            d_recordPool.deleteObject(record);
+        }
         return;                                                       // RETURN
     }
     logMessage(category, severity, record, thresholds);
@@ -539,6 +596,16 @@ static bslmt::QLock singletonQLock = BSLMT_QLOCK_INITIALIZER;
 }  // close unnamed namespace
 
 // PRIVATE CLASS METHODS
+void LoggerManager::dispatchCapturedRecord(Record                    *record,
+                                           const ThresholdAggregate&  levels,
+                                           void                      *logger)
+{
+    BSLS_ASSERT(record);
+    BSLS_ASSERT(logger);
+
+    static_cast<Logger *>(logger)->publishCapturedRecord(record, levels);
+}
+
 void LoggerManager::initSingletonImpl(
                             const LoggerManagerConfiguration&  configuration,
                             bslma::Allocator                  *globalAllocator)
@@ -607,6 +674,7 @@ LoggerManager::LoggerManager(
 , d_defaultLoggers(bslma::Default::globalAllocator(globalAllocator))
 , d_logOrder(configuration.logOrder())
 , d_triggerMarkers(configuration.triggerMarkers())
+, d_recordCapture_p(0)
 , d_allocator_p(bslma::Default::globalAllocator(globalAllocator))
 {
     BSLS_ASSERT(d_observer);
@@ -638,9 +706,38 @@ void LoggerManager::constructObject(
       bdlf::MemFnUtil::memFn(&LoggerManager::publishAllImp, this));
 
     int recordBufferSize = configuration.defaults().defaultRecordBufferSize();
-    d_recordBuffer_p     = new(*d_allocator_p) FixedSizeRecordBuffer(
+    if (LoggerManagerConfiguration::e_LOCK_FREE_BUFFER ==
+                                            configuration.recordBufferType()) {
+        d_recordBuffer_p = new(*d_allocator_p) LockFreeRecordBuffer(
                                                               recordBufferSize,
                                                               d_allocator_p);
+    }
+    else {
+        d_recordBuffer_p = new(*d_allocator_p) FixedSizeRecordBuffer(
+                                                              recordBufferSize,
+                                                              d_allocator_p);
+    }
+
+    if (0 < configuration.recordCaptureCapacity()) {
+        d_recordCapture_p = new(*d_allocator_p) RecordCapture(
+                                       configuration.recordCaptureCapacity(),
+                                       &LoggerManager::dispatchCapturedRecord,
+                                       d_allocator_p);
+
+        if (0 != d_recordCapture_p->start()) {
+            // Log synchronously if the merge thread cannot be created.
+
+            bsls::Log::platformDefaultMessageHandler(
+                          bsls::LogSeverity::e_WARN,
+                          __FILE__,
+                          __LINE__,
+                          "Failed to start record capture thread; records"
+                          " will be published synchronously.");
+
+            d_allocator_p->deleteObject(d_recordCapture_p);
+            d_recordCapture_p = 0;
+        }
+    }
 
     d_logger_p = new(*d_allocator_p) Logger(d_observer,
                                             d_recordBuffer_p,
@@ -649,6 +746,7 @@ void LoggerManager::constructObject(
                                             d_scratchBufferSize,
                                             d_logOrder,
                                             d_triggerMarkers,
+                                            d_recordCapture_p,
                                             d_allocator_p);
     d_loggers.insert(d_logger_p);
     d_defaultCategory_p = d_categoryManager.addCategory(
@@ -992,6 +1090,7 @@ LoggerManager::LoggerManager(
 , d_defaultLoggers(bslma::Default::globalAllocator(globalAllocator))
 , d_logOrder(configuration.logOrder())
 , d_triggerMarkers(configuration.triggerMarkers())
+, d_recordCapture_p(0)
 , d_allocator_p(bslma::Default::globalAllocator(globalAllocator))
 {
     BSLS_ASSERT(d_observer);
@@ -1012,6 +1111,12 @@ LoggerManager::~LoggerManager()
     // while another is still accessing the data members, immediately reset
     // all category holders to their default value.
 
+    // Publish the captured records before the observers are deregistered.
+
+    if (d_recordCapture_p) {
+        d_recordCapture_p->stop();
+    }
+
     d_observer->deregisterAllObservers();
 
     d_categoryManager.resetCategoryHolders();  // do this first!
@@ -1023,6 +1128,10 @@ LoggerManager::~LoggerManager()
     }
     d_recordBuffer_p->~RecordBuffer();
     d_allocator_p->deallocate(d_recordBuffer_p);
+
+    if (d_recordCapture_p) {
+        d_allocator_p->deleteObject(d_recordCapture_p);
+    }
 }
 
 // MANIPULATORS
@@ -1039,6 +1148,7 @@ Logger *LoggerManager::allocateLogger(RecordBuffer *buffer)
                                                 d_scratchBufferSize,
                                                 d_logOrder,
                                                 d_triggerMarkers,
+                                                d_recordCapture_p,
                                                 d_allocator_p);
     d_loggers.insert(logger);
 
@@ -1057,6 +1167,7 @@ Logger *LoggerManager::allocateLogger(RecordBuffer *buffer,
                                                 scratchBufferSize,
                                                 d_logOrder,
                                                 d_triggerMarkers,
+                                                d_recordCapture_p,
                                                 d_allocator_p);
     d_loggers.insert(logger);
 
@@ -1080,6 +1191,7 @@ Logger *LoggerManager::allocateLogger(RecordBuffer *buffer,
                                                 d_scratchBufferSize,
                                                 d_logOrder,
                                                 d_triggerMarkers,
+                                                d_recordCapture_p,
                                                 d_allocator_p);
     d_loggers.insert(logger);
 
@@ -1103,6 +1215,7 @@ Logger *LoggerManager::allocateLogger(RecordBuffer *buffer,
                                                 scratchBufferSize,
                                                 d_logOrder,
                                                 d_triggerMarkers,
+                                                d_recordCapture_p,
                                                 d_allocator_p);
 
     d_loggers.insert(logger);
@@ -1124,6 +1237,7 @@ Logger *LoggerManager::allocateLogger(
                                                 d_scratchBufferSize,
                                                 d_logOrder,
                                                 d_triggerMarkers,
+                                                d_recordCapture_p,
                                                 d_allocator_p);
     d_loggers.insert(logger);
 
@@ -1144,6 +1258,7 @@ Logger *LoggerManager::allocateLogger(
                                                 scratchBufferSize,
                                                 d_logOrder,
                                                 d_triggerMarkers,
+                                                d_recordCapture_p,
                                                 d_allocator_p);
 
     d_loggers.insert(logger);
@@ -1153,6 +1268,12 @@ Logger *LoggerManager::allocateLogger(
 
 void LoggerManager::deallocateLogger(Logger *logger)
 {
+    if (d_recordCapture_p) {
+        // Dispatch the records captured for 'logger' before destroying it.
+
+        d_recordCapture_p->drain();
+    }
+
     d_loggersLock.lockWrite();
     d_loggers.erase(logger);
     d_loggersLock.unlock();
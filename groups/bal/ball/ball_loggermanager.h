@@ -73,7 +73,12 @@ BSLS_IDENT("$Id: $")
 // a circular buffer may not be appropriate for all situations; the user can
 // change the behavior of the default logger by adjusting the logging threshold
 // levels (see below) or can install a logger that uses a different kind of
-// record buffer.
+// record buffer.  In particular, when records are routinely logged at or above
+// the Record threshold level by many threads, the 'recordBufferType' attribute
+// of the configuration can be set to
+// 'ball::LoggerManagerConfiguration::e_LOCK_FREE_BUFFER', so that the default
+// logger appends records to a 'ball::LockFreeRecordBuffer' without acquiring
+// a lock (see the 'ball_lockfreerecordbuffer' component).
 //
 ///Logger Manager Singleton Initialization
 ///---------------------------------------
@@ -333,6 +338,26 @@ BSLS_IDENT("$Id: $")
 // have them share a common logger so that the trace-back log *does* include
 // all relevant records.
 //
+///Per-Thread Record Capture
+///- - - - - - - - - - - - -
+// By default, every record that passes the thresholds of its category is
+// obtained from the record pool of a 'ball::Logger', and is stored in the
+// (shared) record buffer of the logger and passed to its observer by the
+// logging thread itself.  If the 'recordCaptureCapacity' attribute of the
+// 'ball::LoggerManagerConfiguration' supplied at construction is positive,
+// the logger manager instead creates a 'ball::RecordCapture' object (see
+// 'ball_recordcapture'): each thread that logs through the logging macros
+// then populates a record from a private, preallocated ring of that many
+// records, and a background thread merges the rings in timestamp order and
+// stores, passes through, and triggers the publication of those records on
+// behalf of the logging threads.  The logging hot path then neither allocates
+// memory nor contends on a lock shared with other logging threads.  If the
+// ring of a thread is full, or a log message is itself formatted by code that
+// logs, the record is published synchronously as usual.  Note that records of
+// different threads are published in timestamp order on a best-effort basis
+// only, and that Trigger and Trigger-All events caused by captured records
+// are processed by the background thread.
+//
 ///'bsls::Log' Logging Redirection
 ///-------------------------------
 // The 'ball::LoggerManager' singleton, on construction, redirects 'bsls::Log'
@@ -880,6 +905,7 @@ BSLS_IDENT("$Id: $")
 #include <bdlcc_objectpool.h>
 
 #include <bdlma_concurrentpool.h>
+#include <bdlma_concurrentpoolallocator.h>
 
 #include <bslma_allocator.h>
 #include <bslma_managedptr.h>
@@ -900,6 +926,7 @@ namespace ball {
 class LoggerManager;
 class Observer;
 class RecordBuffer;
+class RecordCapture;
 
                            // ============
                            // class Logger
@@ -932,6 +959,11 @@ class Logger {
                   d_recordPool;                 // pool of records with a
                                                 // custom RESETTER
 
+    bdlma::ConcurrentPoolAllocator
+                  d_handleAllocator;            // pool supplying the
+                                                // representations of the
+                                                // shared pointers to records
+
     const bsl::shared_ptr<Observer>
                   d_observer;                   // holds observer
 
@@ -963,6 +995,11 @@ class Logger {
     LoggerManagerConfiguration::TriggerMarkers
                   d_triggerMarkers;             // trigger markers
 
+    RecordCapture
+                 *d_recordCapture_p;            // per-thread record capture,
+                                                // or 0 if disabled (held, not
+                                                // owned)
+
     bslma::Allocator
                  *d_allocator_p;                // memory allocator (held, not
                                                 // owned)
@@ -983,6 +1020,7 @@ class Logger {
            int                                         scratchBufferSize,
            LoggerManagerConfiguration::LogOrder        logOrder,
            LoggerManagerConfiguration::TriggerMarkers  triggerMarkers,
+           RecordCapture                              *recordCapture,
            bslma::Allocator                           *globalAllocator);
         // Create a logger having the specified 'observer' that receives
         // published log records, the specified 'recordBuffer' that stores log
@@ -990,13 +1028,14 @@ class Logger {
         // fields of log records, the specified 'publishAllCallback' that is
         // invoked when a Trigger-All event occurs, the specified
         // 'scratchBufferSize' for the internal message buffer accessible via
-        // 'obtainMessageBuffer', and the specified 'globalAllocator' used to
-        // supply memory.  On a Trigger or Trigger-All event, the messages are
-        // published in the specified 'logOrder'.  The behavior is undefined
-        // unless 'observer', 'recordBuffer', and 'globalAllocator' are
-        // non-null.  Note that this constructor is 'private' since the
-        // creation of instances of 'Logger' is managed by its 'friend'
-        // 'LoggerManager'.
+        // 'obtainMessageBuffer', the specified 'recordCapture' from which
+        // 'getRecord' obtains records when possible (if non-null), and the
+        // specified 'globalAllocator' used to supply memory.  On a Trigger or
+        // Trigger-All event, the messages are published in the specified
+        // 'logOrder'.  The behavior is undefined unless 'observer',
+        // 'recordBuffer', and 'globalAllocator' are non-null.  Note that this
+        // constructor is 'private' since the creation of instances of 'Logger'
+        // is managed by its 'friend' 'LoggerManager'.
 
     ~Logger();
         // Destroy this logger.
@@ -1026,7 +1065,31 @@ class Logger {
         // the threshold levels of 'levels'.  The behavior is undefined unless
         // 'severity' is in the range '[1 .. 255]', 'record' was previously
         // obtained via a call to 'getRecord', and 'record' is not reused after
-        // invoking this method.
+        // invoking this method.  Note that if 'record' was reserved from the
+        // record capture of this logger, it is committed to the capture
+        // instead, and is dispatched later from the merge thread of the
+        // capture (see 'publishCapturedRecord').
+
+    void dispatchRecord(Record                    *record,
+                        int                        severity,
+                        const ThresholdAggregate&  levels);
+        // Store, pass through, and trigger the publication of the specified
+        // fully-populated 'record' having the specified 'severity' according
+        // to the specified 'levels', as described for 'logMessage'.  The
+        // behavior is undefined unless 'record' was obtained from the record
+        // pool of this logger.
+
+    Record *getPooledRecord(const char *file, int line);
+        // Return the address of a modifiable record having the specified
+        // 'file' and 'line' attributes, and retrieved from the object pool
+        // managed by this logger.
+
+    void publishCapturedRecord(Record                    *record,
+                               const ThresholdAggregate&  levels);
+        // Copy the specified captured 'record' into a record from the pool of
+        // this logger and dispatch the copy according to the specified
+        // 'levels'.  This method is invoked from the merge thread of the
+        // record capture of this logger.
 
     void publish(Transmission::Cause cause);
         // Publish to the observer held by this logger all records stored in
@@ -1038,7 +1101,10 @@ class Logger {
     Record *getRecord(const char *file, int line);
         // Return the address of a modifiable record having the specified
         // 'file' and 'line' attributes, and retrieved from the object pool
-        // managed by this logger.
+        // managed by this logger or, if the logger manager was configured
+        // with a positive 'recordCaptureCapacity', from the private record
+        // ring of the calling thread.  The record must be passed to
+        // 'logMessage' by the calling thread.
 
     void logMessage(const Category&  category,
                     int              severity,
@@ -1269,10 +1335,21 @@ class LoggerManager {
     LoggerManagerConfiguration::TriggerMarkers
                            d_triggerMarkers;     // trigger markers
 
+    RecordCapture         *d_recordCapture_p;    // per-thread record capture,
+                                                 // or 0 if disabled (owned)
+
     bslma::Allocator      *d_allocator_p;        // memory allocator (held,
                                                  // not owned)
 
     // PRIVATE CLASS METHODS
+    static void dispatchCapturedRecord(Record                    *record,
+                                       const ThresholdAggregate&  levels,
+                                       void                      *logger);
+        // Publish the specified captured 'record' according to the specified
+        // 'levels' through the specified 'logger'.  This method is the
+        // dispatch callback of the record capture of a logger manager.  The
+        // behavior is undefined unless 'logger' is the address of a 'Logger'.
+
     static void initSingletonImpl(
                            const LoggerManagerConfiguration&  configuration,
                            bslma::Allocator                  *globalAllocator);
@@ -207,6 +207,9 @@ using namespace bdlf::PlaceHolders;
 // [30] TESTING 'ball::Logger::logMessage' (RULE BASED LOGGING)
 // [31] TESTING '~LoggerManager' calls 'Observer::releaseRecords'
 // [36] SINGLETON REINITIALIZATION
+// [44] PER-THREAD RECORD CAPTURE
+// [45] LOCK-FREE DEFAULT RECORD BUFFER
+// [46] CONCERN: STEADY-STATE LOGGING DOES NOT ALLOCATE
 // [38] USAGE EXAMPLE #1
 // [39] USAGE EXAMPLE #2
 // [40] USAGE EXAMPLE #3
@@ -1750,6 +1753,26 @@ void testUserFieldsPopulatorCb(ball::UserFields *list)
     list->appendInt64(1066);
 }
 
+void threadIdPopulatorCb(ball::UserFields *list)
+    // Append the id of the calling thread to the specified 'list'.
+{
+    list->appendInt64(static_cast<bsls::Types::Int64>(
+                                         bslmt::ThreadUtil::selfIdAsUint64()));
+}
+
+void logInfoMessages(ball::Logger *logger, const Cat *category, int count)
+    // Log the specified 'count' messages to the specified 'category' at
+    // 'e_INFO' severity using the specified 'logger'.
+{
+    for (int i = 0; i < count; ++i) {
+        logger->logMessage(*category,
+                           ball::Severity::e_INFO,
+                           __FILE__,
+                           i,
+                           "info");
+    }
+}
+
 }  // close unnamed namespace
 
 // ============================================================================
@@ -1767,6 +1790,422 @@ int main(int argc, char *argv[])
     cout << "TEST " << __FILE__ << " CASE " << test << endl;;
 
     switch (test) { case 0:  // Zero is always the leading case.
+      case 46: {
+        // --------------------------------------------------------------------
+        // CONCERN: STEADY-STATE LOGGING DOES NOT ALLOCATE
+        //
+        // Concerns:
+        //: 1 Once the record pool of a logger holds enough records, logging a
+        //:   record obtained with 'getRecord' (as the 'BALL_LOG_STREAM' macro
+        //:   does) allocates no memory if the record is published, and no
+        //:   memory per record if the record is retained in the record
+        //:   buffer.
+        //:
+        //: 2 No memory is allocated from the default allocator.
+        //
+        // Plan:
+        //: 1 Create a logger manager with a test allocator, and log records
+        //:   through 'getRecord' and 'logMessage' to a category whose Pass
+        //:   threshold is set, streaming a message into each record.  After
+        //:   a few records, verify that logging more records allocates no
+        //:   memory from either allocator.  (C-1..2)
+        //:
+        //: 2 Repeat P-1 for records that are retained in the record buffer
+        //:   until a Trigger event publishes them, verifying that a second
+        //:   round of records does not allocate memory per record.  (C-1..2)
+        //
+        // Testing:
+        //   CONCERN: STEADY-STATE LOGGING DOES NOT ALLOCATE
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "CONCERN: STEADY-STATE LOGGING DOES NOT ALLOCATE"
+                          << endl
+                          << "==============================================="
+                          << endl;
+
+        enum { k_NUM_RECORDS = 100 };
+
+        bslma::TestAllocator         da("default", veryVeryVeryVerbose);
+        bslma::DefaultAllocatorGuard guard(&da);
+
+        bslma::TestAllocator ta("manager", veryVeryVeryVerbose);
+
+        bsl::shared_ptr<PerformanceObserver> observer(
+                                         new (ta) PerformanceObserver(), &ta);
+
+        ball::LoggerManagerConfiguration mLMC;
+        mLMC.setTriggerMarkers(ball::LoggerManagerConfiguration::e_NO_MARKERS);
+        {
+            bslma::ManagedPtr<Obj> mp;
+            Obj::createLoggerManager(&mp, mLMC, &ta);
+            Obj& mX = *mp;
+
+            ASSERT(0 == mX.registerObserver(observer, "test"));
+
+            const Cat *passed   = mX.addCategory("PASSED",
+                                                 0,
+                                                 ball::Severity::e_TRACE,
+                                                 0,
+                                                 0);
+            const Cat *retained = mX.addCategory("RETAINED",
+                                                 ball::Severity::e_TRACE,
+                                                 0,
+                                                 ball::Severity::e_ERROR,
+                                                 0);
+            ASSERT(passed);
+            ASSERT(retained);
+
+            Logger& logger = mX.getLogger();
+
+            if (veryVerbose) cout << "\tPublished records." << endl;
+            {
+                bsls::Types::Int64 numAllocations = 0;
+
+                for (int i = 0; i < 2 * k_NUM_RECORDS; ++i) {
+                    if (k_NUM_RECORDS == i) {
+                        numAllocations = ta.numAllocations();
+                    }
+                    ball::Record *record = logger.getRecord(__FILE__, i);
+                    bsl::ostream  stream(
+                                   &record->fixedFields().messageStreamBuf());
+                    stream << "record " << i;
+                    logger.logMessage(*passed, ball::Severity::e_INFO, record);
+                }
+                ASSERTV(ta.numAllocations() - numAllocations,
+                        numAllocations == ta.numAllocations());
+
+                ASSERTV(observer->publishCount(),
+                        2 * k_NUM_RECORDS == observer->publishCount());
+            }
+
+            if (veryVerbose) cout << "\tRetained records." << endl;
+            {
+                for (int round = 0; round < 2; ++round) {
+                    const bsls::Types::Int64 numAllocations =
+                                                           ta.numAllocations();
+
+                    for (int i = 0; i < k_NUM_RECORDS; ++i) {
+                        ball::Record *record = logger.getRecord(__FILE__, i);
+                        bsl::ostream  stream(
+                                   &record->fixedFields().messageStreamBuf());
+                        stream << "record " << i;
+                        logger.logMessage(*retained,
+                                          ball::Severity::e_INFO,
+                                          record);
+                    }
+                    logger.logMessage(*retained,
+                                      ball::Severity::e_ERROR,
+                                      __FILE__,
+                                      0,
+                                      "error");
+
+                    if (veryVerbose) {
+                        T_ P_(round) P(ta.numAllocations() - numAllocations)
+                    }
+                    // The default record buffer allocates the storage of the
+                    // handles it holds in blocks, so only the absence of
+                    // per-record allocations is verified.
+
+                    if (1 == round) {
+                        ASSERTV(ta.numAllocations() - numAllocations,
+                                ta.numAllocations() - numAllocations <
+                                                           k_NUM_RECORDS / 10);
+                    }
+                }
+            }
+        }
+        observer.reset();
+        ASSERTV(ta.numBlocksInUse(), 0 == ta.numBlocksInUse());
+        ASSERTV(da.numBlocksTotal(), 0 == da.numBlocksTotal());
+      } break;
+      case 45: {
+        // --------------------------------------------------------------------
+        // LOCK-FREE DEFAULT RECORD BUFFER
+        //
+        // Concerns:
+        //: 1 If 'recordBufferType' is 'e_LOCK_FREE_BUFFER', the default
+        //:   logger buffers records that are only recorded, and publishes them
+        //:   in the configured order on a Trigger event.
+        //:
+        //: 2 Records logged concurrently by several threads are all
+        //:   published on a Trigger event if the buffer is large enough.
+        //
+        // Plan:
+        //: 1 Create a logger manager configured for a lock-free buffer and
+        //:   FIFO order, log records from one and then several threads to a
+        //:   category whose Record and Trigger levels are set, and verify the
+        //:   records published by a test observer.  (C-1..2)
+        //
+        // Testing:
+        //   LOCK-FREE DEFAULT RECORD BUFFER
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "LOCK-FREE DEFAULT RECORD BUFFER" << endl
+                          << "===============================" << endl;
+
+        bslma::TestAllocator ta("manager", veryVeryVeryVerbose);
+
+        bsl::shared_ptr<ball::TestObserver> observer(
+                                    new (ta) ball::TestObserver(&cout, &ta),
+                                    &ta);
+
+        ball::LoggerManagerConfiguration mLMC;
+        ASSERT(0 == mLMC.setDefaultRecordBufferSizeIfValid(1024 * 1024));
+        mLMC.setLogOrder(ball::LoggerManagerConfiguration::e_FIFO);
+        mLMC.setTriggerMarkers(ball::LoggerManagerConfiguration::e_NO_MARKERS);
+        mLMC.setRecordBufferType(
+                         ball::LoggerManagerConfiguration::e_LOCK_FREE_BUFFER);
+        {
+            bslma::ManagedPtr<Obj> mp;
+            Obj::createLoggerManager(&mp, mLMC, &ta);
+            Obj& mX = *mp;
+
+            ASSERT(0 == mX.registerObserver(observer, "test"));
+
+            const Cat *trigger = mX.addCategory("TRIGGER",
+                                                ball::Severity::e_TRACE,
+                                                0,
+                                                ball::Severity::e_ERROR,
+                                                0);
+            ASSERT(trigger);
+
+            Logger& logger = mX.getLogger();
+
+            if (veryVerbose) cout << "\tSingle thread." << endl;
+            {
+                const char *MESSAGES[] = { "0", "1", "2", "3" };
+
+                for (int i = 0; i < 4; ++i) {
+                    logger.logMessage(*trigger,
+                                      ball::Severity::e_INFO,
+                                      __FILE__,
+                                      i,
+                                      MESSAGES[i]);
+                }
+                ASSERT(0 == observer->numPublishedRecords());
+
+                logger.logMessage(*trigger,
+                                  ball::Severity::e_ERROR,
+                                  __FILE__,
+                                  4,
+                                  "error");
+
+                ASSERTV(observer->numPublishedRecords(),
+                        5 == observer->numPublishedRecords());
+
+                // In FIFO order, the triggering record is published last.
+
+                ASSERT(0 == bsl::strcmp("error",
+                                        observer->lastPublishedRecord().
+                                                     fixedFields().message()));
+            }
+
+            if (veryVerbose) cout << "\tSeveral threads." << endl;
+            {
+                enum { k_NUM_THREADS = 4, k_NUM_RECORDS = 100 };
+
+                const int numPublished = observer->numPublishedRecords();
+
+                bslmt::ThreadUtil::Handle threads[k_NUM_THREADS];
+                for (int i = 0; i < k_NUM_THREADS; ++i) {
+                    ASSERT(0 == bslmt::ThreadUtil::create(
+                                    &threads[i],
+                                    bdlf::BindUtil::bind(
+                                                  &logInfoMessages,
+                                                  &logger,
+                                                  trigger,
+                                                  static_cast<int>(
+                                                            k_NUM_RECORDS))));
+                }
+                for (int i = 0; i < k_NUM_THREADS; ++i) {
+                    ASSERT(0 == bslmt::ThreadUtil::join(threads[i]));
+                }
+
+                logger.logMessage(*trigger,
+                                  ball::Severity::e_ERROR,
+                                  __FILE__,
+                                  0,
+                                  "error");
+
+                ASSERTV(numPublished, observer->numPublishedRecords(),
+                        numPublished + k_NUM_THREADS * k_NUM_RECORDS + 1 ==
+                                             observer->numPublishedRecords());
+            }
+        }
+        observer.reset();
+        ASSERTV(ta.numBlocksInUse(), 0 == ta.numBlocksInUse());
+      } break;
+      case 44: {
+        // --------------------------------------------------------------------
+        // PER-THREAD RECORD CAPTURE
+        //
+        // Concerns:
+        //: 1 If 'recordCaptureCapacity' is positive, records obtained with
+        //:   'ball::Logger::getRecord' are published with all fixed fields
+        //:   set, and with user fields populated by the logging thread.
+        //:
+        //: 2 Records less severe than all thresholds are discarded.
+        //:
+        //: 3 A record obtained while another record obtained by the same
+        //:   thread is outstanding is published synchronously.
+        //:
+        //: 4 Trigger events caused by captured records publish the record
+        //:   buffer of the logger.
+        //:
+        //: 5 All captured records are published before the logger manager is
+        //:   destroyed, and before 'deallocateLogger' returns.
+        //:
+        //: 6 All memory is supplied by the allocator of the logger manager.
+        //
+        // Plan:
+        //: 1 Create a logger manager having a positive record capture
+        //:   capacity and a populator recording the thread id, log records
+        //:   through 'getRecord' and 'logMessage', and verify the published
+        //:   records.  (C-1..6)
+        //
+        // Testing:
+        //   PER-THREAD RECORD CAPTURE
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "PER-THREAD RECORD CAPTURE" << endl
+                          << "=========================" << endl;
+
+        bslma::TestAllocator ta("manager", veryVeryVeryVerbose);
+
+        bsl::shared_ptr<ball::TestObserver> observer(
+                                    new (ta) ball::TestObserver(&cout, &ta),
+                                    &ta);
+
+        ball::LoggerManagerConfiguration mLMC;
+        ASSERT(0 == mLMC.setRecordCaptureCapacityIfValid(64));
+        mLMC.setTriggerMarkers(ball::LoggerManagerConfiguration::e_NO_MARKERS);
+        mLMC.setUserFieldsPopulatorCallback(&threadIdPopulatorCb);
+
+        const bsls::Types::Int64 THREAD_ID =
+                                     static_cast<bsls::Types::Int64>(
+                                         bslmt::ThreadUtil::selfIdAsUint64());
+
+        {
+            bslma::ManagedPtr<Obj> mp;
+            Obj::createLoggerManager(&mp, mLMC, &ta);
+            Obj& mX = *mp;
+
+            ASSERT(0 == mX.registerObserver(observer, "test"));
+
+            const Cat *category = mX.addCategory("CAPTURE",
+                                                 0,
+                                                 ball::Severity::e_WARN,
+                                                 0,
+                                                 0);
+            ASSERT(category);
+
+            const Cat *trigger = mX.addCategory("TRIGGER",
+                                                ball::Severity::e_TRACE,
+                                                0,
+                                                ball::Severity::e_ERROR,
+                                                0);
+            ASSERT(trigger);
+
+            Logger& logger = mX.getLogger();
+
+            if (veryVerbose) cout << "\tPass-through records." << endl;
+            {
+                for (int i = 0; i < 20; ++i) {
+                    Rec *record = logger.getRecord("capture.cpp", i);
+                    record->fixedFields().setMessage("warn");
+                    logger.logMessage(*category,
+                                      ball::Severity::e_WARN,
+                                      record);
+                }
+
+                Rec *record = logger.getRecord("capture.cpp", 20);
+                logger.logMessage(*category, 255, record);  // discarded
+            }
+
+            if (veryVerbose) cout << "\tNested records." << endl;
+            {
+                Rec *outer = logger.getRecord("capture.cpp", 30);
+                Rec *inner = logger.getRecord("capture.cpp", 31);
+                ASSERT(outer != inner);
+
+                const int numPublished = observer->numPublishedRecords();
+
+                inner->fixedFields().setMessage("inner");
+                logger.logMessage(*category, ball::Severity::e_WARN, inner);
+
+                // The inner record is published synchronously.
+
+                ASSERTV(numPublished, observer->numPublishedRecords(),
+                        numPublished + 1 <= observer->numPublishedRecords());
+
+                outer->fixedFields().setMessage("outer");
+                logger.logMessage(*category, ball::Severity::e_WARN, outer);
+            }
+
+            if (veryVerbose) cout << "\tTrigger." << endl;
+            {
+                for (int i = 0; i < 3; ++i) {
+                    Rec *record = logger.getRecord("capture.cpp", 40);
+                    record->fixedFields().setMessage("info");
+                    logger.logMessage(*trigger,
+                                      ball::Severity::e_INFO,
+                                      record);
+                }
+                Rec *record = logger.getRecord("capture.cpp", 41);
+                record->fixedFields().setMessage("error");
+                logger.logMessage(*trigger, ball::Severity::e_ERROR, record);
+            }
+
+            if (veryVerbose) cout << "\t'deallocateLogger'." << endl;
+            {
+                ball::FixedSizeRecordBuffer buffer(1024, &ta);
+
+                Logger *allocated = mX.allocateLogger(&buffer);
+
+                Rec *record = allocated->getRecord("capture.cpp", 50);
+                record->fixedFields().setMessage("allocated");
+                allocated->logMessage(*category,
+                                      ball::Severity::e_WARN,
+                                      record);
+
+                mX.deallocateLogger(allocated);
+
+                ASSERTV(observer->lastPublishedRecord().fixedFields().
+                                                                     message(),
+                        0 == bsl::strcmp("allocated",
+                                         observer->lastPublishedRecord().
+                                                     fixedFields().message()));
+            }
+        }
+
+        // 20 pass-through, 2 nested, 4 triggered by the error, and 1 from
+        // the allocated logger.
+
+        ASSERTV(observer->numPublishedRecords(),
+                27 == observer->numPublishedRecords());
+
+        // The last published record reflects the fields populated by the
+        // logging thread.
+
+        const ball::RecordAttributes& attributes =
+                                      observer->lastPublishedRecord().
+                                                                 fixedFields();
+        ASSERT(50 == attributes.lineNumber());
+        ASSERT(0 == bsl::strcmp("CAPTURE", attributes.category()));
+        ASSERT(ball::Severity::e_WARN == attributes.severity());
+        ASSERT(static_cast<bsls::Types::Uint64>(THREAD_ID) ==
+                                                       attributes.threadID());
+
+        const ball::UserFields& fields =
+                                observer->lastPublishedRecord().customFields();
+        ASSERTV(fields.length(), 1 == fields.length());
+        if (1 == fields.length()) {
+            ASSERT(THREAD_ID == fields[0].theInt64());
+        }
+      } break;
 #ifndef BDE_OMIT_INTERNAL_DEPRECATED
       case 43: {
         // --------------------------------------------------------------------
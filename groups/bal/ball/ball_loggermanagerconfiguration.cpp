@@ -44,6 +44,12 @@ LoggerManagerConfiguration::areValidDefaultThresholdLevels(int recordLevel,
                                                               triggerAllLevel);
 }
 
+bool
+LoggerManagerConfiguration::isValidRecordCaptureCapacity(int numRecords)
+{
+    return 0 <= numRecords;
+}
+
 // CREATORS
 LoggerManagerConfiguration::LoggerManagerConfiguration(
                                               bslma::Allocator *basicAllocator)
@@ -58,6 +64,8 @@ LoggerManagerConfiguration::LoggerManagerConfiguration(
                 bsl::allocator<DefaultThresholdLevelsCallback>(basicAllocator))
 , d_logOrder(e_LIFO)
 , d_triggerMarkers(e_BEGIN_END_MARKERS)
+, d_recordCaptureCapacity(0)
+, d_recordBufferType(e_FIXED_SIZE_BUFFER)
 , d_allocator_p(bslma::Default::allocator(basicAllocator))
 {
 }
@@ -79,6 +87,8 @@ LoggerManagerConfiguration::LoggerManagerConfiguration(
                 original.d_defaultThresholdsCb)
 , d_logOrder(original.d_logOrder)
 , d_triggerMarkers(original.d_triggerMarkers)
+, d_recordCaptureCapacity(original.d_recordCaptureCapacity)
+, d_recordBufferType(original.d_recordBufferType)
 , d_allocator_p(bslma::Default::allocator(basicAllocator))
 {
 }
@@ -87,12 +97,14 @@ LoggerManagerConfiguration::LoggerManagerConfiguration(
 LoggerManagerConfiguration&
 LoggerManagerConfiguration::operator=(const LoggerManagerConfiguration& rhs)
 {
-    d_defaults            = rhs.d_defaults;
-    d_userPopulator       = rhs.d_userPopulator;
-    d_categoryNameFilter  = rhs.d_categoryNameFilter;
-    d_defaultThresholdsCb = rhs.d_defaultThresholdsCb;
-    d_logOrder            = rhs.d_logOrder;
-    d_triggerMarkers      = rhs.d_triggerMarkers;
+    d_defaults              = rhs.d_defaults;
+    d_userPopulator         = rhs.d_userPopulator;
+    d_categoryNameFilter    = rhs.d_categoryNameFilter;
+    d_defaultThresholdsCb   = rhs.d_defaultThresholdsCb;
+    d_logOrder              = rhs.d_logOrder;
+    d_triggerMarkers        = rhs.d_triggerMarkers;
+    d_recordCaptureCapacity = rhs.d_recordCaptureCapacity;
+    d_recordBufferType      = rhs.d_recordBufferType;
 
     return *this;
 }
@@ -159,6 +171,22 @@ void LoggerManagerConfiguration::setTriggerMarkers(TriggerMarkers value)
     d_triggerMarkers = value;
 }
 
+int LoggerManagerConfiguration::setRecordCaptureCapacityIfValid(
+                                                                int numRecords)
+{
+    if (!isValidRecordCaptureCapacity(numRecords)) {
+        return -1;                                                    // RETURN
+    }
+
+    d_recordCaptureCapacity = numRecords;
+    return 0;
+}
+
+void LoggerManagerConfiguration::setRecordBufferType(RecordBufferType value)
+{
+    d_recordBufferType = value;
+}
+
 // ACCESSORS
 const LoggerManagerDefaults& LoggerManagerConfiguration::defaults() const
 {
@@ -225,6 +253,17 @@ LoggerManagerConfiguration::triggerMarkers() const
     return d_triggerMarkers;
 }
 
+int LoggerManagerConfiguration::recordCaptureCapacity() const
+{
+    return d_recordCaptureCapacity;
+}
+
+LoggerManagerConfiguration::RecordBufferType
+LoggerManagerConfiguration::recordBufferType() const
+{
+    return d_recordBufferType;
+}
+
 bsl::ostream&
 LoggerManagerConfiguration::print(bsl::ostream& stream,
                                   int           level,
@@ -272,6 +311,15 @@ LoggerManagerConfiguration::print(bsl::ostream& stream,
                                                  : "BEGIN_END_MARKERS";
     stream << "Trigger markers are " << triggerMarker << NL;
 
+    bdlb::Print::indent(stream, level + 1, spacesPerLevel);
+    stream << "Record capture capacity is " << d_recordCaptureCapacity << NL;
+
+    bdlb::Print::indent(stream, level + 1, spacesPerLevel);
+    const char *recordBufferType = d_recordBufferType == e_FIXED_SIZE_BUFFER
+                                                 ? "FIXED_SIZE_BUFFER"
+                                                 : "LOCK_FREE_BUFFER";
+    stream << "Record buffer type is " << recordBufferType << NL;
+
     bdlb::Print::indent(stream, level, spacesPerLevel);
     stream << ']' << NL;
 
@@ -295,7 +343,9 @@ bool ball::operator==(const ball::LoggerManagerConfiguration& lhs,
         && (bool)lhs.d_categoryNameFilter  == (bool)rhs.d_categoryNameFilter
         && (bool)lhs.d_defaultThresholdsCb == (bool)rhs.d_defaultThresholdsCb
         && lhs.d_logOrder                  == rhs.d_logOrder
-        && lhs.d_triggerMarkers            == rhs.d_triggerMarkers;
+        && lhs.d_triggerMarkers            == rhs.d_triggerMarkers
+        && lhs.d_recordCaptureCapacity     == rhs.d_recordCaptureCapacity
+        && lhs.d_recordBufferType          == rhs.d_recordBufferType;
 }
 
 bool ball::operator!=(const ball::LoggerManagerConfiguration& lhs,
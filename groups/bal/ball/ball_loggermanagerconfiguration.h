@@ -62,6 +62,10 @@ BSLS_IDENT("$Id: $")
 //
 //  TriggerMarkers                               triggerMarkers
 //
+//  int                                          recordCaptureCapacity
+//
+//  RecordBufferType                             recordBufferType
+//
 //  NAME                            DESCRIPTION
 //  -------------------             -------------------------------------------
 //  defaults                        constrained defaults for buffer size and
@@ -90,6 +94,22 @@ BSLS_IDENT("$Id: $")
 //                                  sequence of records logged due to a Trigger
 //                                  or Trigger-All event; default is
 //                                  'e_BEGIN_END_MARKERS'.
+//
+//  recordCaptureCapacity           number of preallocated records in each
+//                                  thread's private capture ring; if
+//                                  positive, records logged through the
+//                                  logging macros are captured per thread and
+//                                  dispatched by a background thread (see
+//                                  'ball_recordcapture'); default is 0 (record
+//                                  capture disabled)
+//
+//  recordBufferType                defines the type of the record buffer of
+//                                  the default logger; if this attribute is
+//                                  'e_LOCK_FREE_BUFFER', records are appended
+//                                  to a 'ball::LockFreeRecordBuffer' without
+//                                  acquiring a lock; default is
+//                                  'e_FIXED_SIZE_BUFFER' (a
+//                                  'ball::FixedSizeRecordBuffer')
 //..
 // The constraints are as follows:
 //..
@@ -107,6 +127,10 @@ BSLS_IDENT("$Id: $")
 //  +--------------------------------+--------------------------------+
 //  | triggerMarkers                 | (none)                         |
 //  +--------------------------------+--------------------------------+
+//  | recordCaptureCapacity          | 0 <= recordCaptureCapacity     |
+//  +--------------------------------+--------------------------------+
+//  | recordBufferType               | (none)                         |
+//  +--------------------------------+--------------------------------+
 //..
 // For convenience, the 'ball::LoggerManagerConfiguration' interface contains
 // manipulators and accessors to configure and inspect the value of its
@@ -201,6 +225,8 @@ BSLS_IDENT("$Id: $")
 //      Default Threshold Callback functor is null
 //      Logging order is FIFO
 //      Trigger markers are NO_MARKERS
+//      Record capture capacity is 0
+//      Record buffer type is FIXED_SIZE_BUFFER
 //  ]
 //..
 
@@ -301,6 +327,17 @@ class LoggerManagerConfiguration {
 #endif // BDE_OMIT_INTERNAL_DEPRECATED
     };
 
+    enum RecordBufferType {
+        // The 'RecordBufferType' enumeration defines the type of the record
+        // buffer created by the logger manager for its default logger.  The
+        // default value of this attribute is 'e_FIXED_SIZE_BUFFER'.
+
+        e_FIXED_SIZE_BUFFER,  // 'ball::FixedSizeRecordBuffer' (default)
+
+        e_LOCK_FREE_BUFFER    // 'ball::LockFreeRecordBuffer', whose
+                              // 'pushBack' does not acquire a lock
+    };
+
   private:
     // DATA
     LoggerManagerDefaults d_defaults;             // default buffer size for
@@ -328,6 +365,14 @@ class LoggerManagerConfiguration {
 
     TriggerMarkers        d_triggerMarkers;       // trigger marker
 
+    int                   d_recordCaptureCapacity;
+                                                  // capacity of per-thread
+                                                  // record capture rings (0
+                                                  // disables record capture)
+
+    RecordBufferType      d_recordBufferType;     // type of the record buffer
+                                                  // of the default logger
+
     bslma::Allocator     *d_allocator_p;          // memory allocator (held,
                                                   // not owned)
 
@@ -359,6 +404,11 @@ class LoggerManagerConfiguration {
         // severity threshold level, and 'false' otherwise.  Valid severity
         // threshold levels are in the range '[0 .. 255]'.
 
+    static bool isValidRecordCaptureCapacity(int numRecords);
+        // Return 'true' if the specified 'numRecords' is a valid record
+        // capture capacity value, and 'false' otherwise.  'numRecords' is
+        // valid if '0 <= numRecords'.
+
     // TRAITS
     BSLMF_NESTED_TRAIT_DECLARATION(LoggerManagerConfiguration,
                                    bslma::UsesBslmaAllocator);
@@ -450,6 +500,16 @@ class LoggerManagerConfiguration {
         // Set the trigger marker attribute of this object to the specified
         // 'value'.
 
+    int setRecordCaptureCapacityIfValid(int numRecords);
+        // Set the record capture capacity attribute of this object to the
+        // specified 'numRecords' if '0 <= numRecords'.  Return 0 on success,
+        // and a non-zero value otherwise with no effect on this object.  A
+        // value of 0 disables per-thread record capture.
+
+    void setRecordBufferType(RecordBufferType value);
+        // Set the record buffer type attribute of this object to the specified
+        // 'value'.
+
     // ACCESSORS
     const LoggerManagerDefaults& defaults() const;
         // Return a reference to the non-modifiable defaults object attribute
@@ -500,6 +560,14 @@ class LoggerManagerConfiguration {
         // Return the trigger marker attribute of this object.  See attributes
         // description for effects of the trigger markers.
 
+    int recordCaptureCapacity() const;
+        // Return the record capture capacity attribute of this object.  See
+        // attributes description for effects of the record capture capacity.
+
+    RecordBufferType recordBufferType() const;
+        // Return the record buffer type attribute of this object.  See
+        // attributes description for effects of the record buffer type.
+
     bsl::ostream& print(bsl::ostream& stream,
                         int           level          = 0,
                         int           spacesPerLevel = 4) const;
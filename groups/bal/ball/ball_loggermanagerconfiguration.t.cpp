@@ -54,6 +54,8 @@ using namespace bsl;  // automatically added by script
 // [ 1] void setDefaultValues(const ball::LMD& defaults);
 // [ 5] void setLogOrder(LogOrder value);
 // [ 6] void setTriggerMarkers(TriggerMarkers value);
+// [ 7] int setRecordCaptureCapacityIfValid(int numRecords);
+// [ 8] void setRecordBufferType(RecordBufferType value);
 // [ 1] void setUserFieldsPopulatorCallback(const Populator&);
 // [ 1] void setCategoryNameFilterCallback(const CNF& nameFilter);
 // [ 1] void setDefaultThresholdLevelsCallback(const DTC& );
@@ -61,6 +63,8 @@ using namespace bsl;  // automatically added by script
 // [ 1] const ball::LMD& defaults() const;
 // [ 5] const LogOrder logOrder() const;
 // [ 6] const TriggerMarkers triggerMarkers() const;
+// [ 7] int recordCaptureCapacity() const;
+// [ 8] RecordBufferType recordBufferType() const;
 // [ 1] const Populator& userFieldsPopulatorCallback() const;
 // [ 1] const CNF& categoryNameFilterCallback() const;
 // [ 1] const DTC& defaultThresholdLevelsCallback() const;
@@ -69,8 +73,9 @@ using namespace bsl;  // automatically added by script
 // [ 1] bool operator==(const ball::LMC& lhs, const ball::LMC& rhs);
 // [ 1] bool operator!=(const ball::LMC& lhs, const ball::LMC& rhs);
 // [ 1] bsl::ostream& operator<<(bsl::ostream&, const ball::LMC);
+// [ 7] static bool isValidRecordCaptureCapacity(int numRecords);
 //-----------------------------------------------------------------------------
-// [ 7] USAGE EXAMPLE
+// [ 9] USAGE EXAMPLE
 //-----------------------------------------------------------------------------
 
 // ============================================================================
@@ -223,6 +228,8 @@ typedef bsl::function<void(int *, int *, int *, int *, const char*)> DtCb;
 //      Default Threshold Callback functor is null
 //      Logging order is FIFO
 //      Trigger markers are NO_MARKERS
+//      Record capture capacity is 0
+//      Record buffer type is FIXED_SIZE_BUFFER
 //  ]
 //..
 
@@ -309,7 +316,7 @@ int main(int argc, char *argv[])
     const DtCb   DTCB1(dtCb1);
 
     switch (test) { case 0:  // Zero is always the leading case.
-      case 7: {
+      case 9: {
         // --------------------------------------------------------------------
         // TESTING USAGE EXAMPLE
         //   The usage example provided in the component header file must
@@ -328,6 +335,120 @@ int main(int argc, char *argv[])
 
         initializeConfiguration(verbose);
 
+      } break;
+      case 8: {
+        // --------------------------------------------------------------------
+        // TESTING 'setRecordBufferType' AND 'recordBufferType':
+        //   Verify the record buffer type attribute.
+        //
+        // Concerns:
+        //: 1 The record buffer type is 'e_FIXED_SIZE_BUFFER' by default.
+        //:
+        //: 2 'setRecordBufferType' sets the value reported by
+        //:   'recordBufferType'.
+        //:
+        //: 3 The attribute participates in copy, assignment, equality, and
+        //:   printing.
+        //
+        // Plan:
+        //: 1 Set each enumerator and verify the attribute.  (C-1..2)
+        //:
+        //: 2 Copy, assign, compare, and print objects having different record
+        //:   buffer types.  (C-3)
+        //
+        // Testing:
+        //   void setRecordBufferType(RecordBufferType value);
+        //   RecordBufferType recordBufferType() const;
+        // --------------------------------------------------------------------
+
+        if (verbose)
+            cout << "\nTESTING 'setRecordBufferType' AND 'recordBufferType'"
+                 << "\n===================================================\n";
+
+        Obj mX;  const Obj& X = mX;
+        ASSERT(Obj::e_FIXED_SIZE_BUFFER == X.recordBufferType());
+
+        mX.setRecordBufferType(Obj::e_LOCK_FREE_BUFFER);
+        ASSERT(Obj::e_LOCK_FREE_BUFFER == X.recordBufferType());
+
+        Obj mY(X);  const Obj& Y = mY;
+        ASSERT(Obj::e_LOCK_FREE_BUFFER == Y.recordBufferType());
+        ASSERT(X == Y);
+
+        mY.setRecordBufferType(Obj::e_FIXED_SIZE_BUFFER);
+        ASSERT(Obj::e_FIXED_SIZE_BUFFER == Y.recordBufferType());
+        ASSERT(X != Y);
+
+        bsl::ostringstream osX;
+        bsl::ostringstream osY;
+        osX << X;
+        osY << Y;
+        ASSERT(bsl::string::npos != osX.str().find("LOCK_FREE_BUFFER"));
+        ASSERT(bsl::string::npos != osY.str().find("FIXED_SIZE_BUFFER"));
+
+        mY = X;
+        ASSERT(Obj::e_LOCK_FREE_BUFFER == Y.recordBufferType());
+        ASSERT(X == Y);
+
+      } break;
+      case 7: {
+        // --------------------------------------------------------------------
+        // TESTING 'setRecordCaptureCapacityIfValid' AND
+        // 'recordCaptureCapacity':
+        //   Verify the record capture capacity attribute.
+        //
+        // Concerns:
+        //: 1 The record capture capacity is 0 by default.
+        //:
+        //: 2 Non-negative values are accepted and reported by
+        //:   'recordCaptureCapacity'.
+        //:
+        //: 3 Negative values are rejected with no effect on the object.
+        //:
+        //: 4 The attribute participates in copy, assignment, and equality.
+        //
+        // Plan:
+        //: 1 Set a series of valid and invalid capacities and verify the
+        //:   return status and the resulting attribute value.  (C-1..3)
+        //:
+        //: 2 Copy, assign, and compare objects having different capacities.
+        //:   (C-4)
+        //
+        // Testing:
+        //   static bool isValidRecordCaptureCapacity(int numRecords);
+        //   int setRecordCaptureCapacityIfValid(int numRecords);
+        //   int recordCaptureCapacity() const;
+        // --------------------------------------------------------------------
+
+        if (verbose)
+            cout << "\nTESTING 'setRecordCaptureCapacityIfValid'"
+                 << "\n=========================================\n";
+
+        Obj mX;  const Obj& X = mX;
+        ASSERT(0 == X.recordCaptureCapacity());
+
+        ASSERT( Obj::isValidRecordCaptureCapacity(0));
+        ASSERT( Obj::isValidRecordCaptureCapacity(1));
+        ASSERT(!Obj::isValidRecordCaptureCapacity(-1));
+
+        ASSERT(0 == mX.setRecordCaptureCapacityIfValid(64));
+        ASSERT(64 == X.recordCaptureCapacity());
+
+        ASSERT(0 != mX.setRecordCaptureCapacityIfValid(-1));
+        ASSERT(64 == X.recordCaptureCapacity());
+
+        Obj mY(X);  const Obj& Y = mY;
+        ASSERT(64 == Y.recordCaptureCapacity());
+        ASSERT(X == Y);
+
+        ASSERT(0 == mY.setRecordCaptureCapacityIfValid(0));
+        ASSERT(0 == Y.recordCaptureCapacity());
+        ASSERT(X != Y);
+
+        mY = X;
+        ASSERT(64 == Y.recordCaptureCapacity());
+        ASSERT(X == Y);
+
       } break;
       case 6: {
         // --------------------------------------------------------------------
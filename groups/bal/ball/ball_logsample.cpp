@@ -0,0 +1,209 @@
+// ball_logsample.cpp                                                 -*-C++-*-
+#include <ball_logsample.h>
+
+#include <bsls_ident.h>
+BSLS_IDENT_RCSID(ball_logsample_cpp,"$Id$ $CSID$")
+
+#include <bsls_assert.h>
+#include <bsls_atomic.h>
+#include <bsls_systemtime.h>
+
+#include <bsl_climits.h>
+#include <bsl_cmath.h>
+
+// ============================================================================
+//                           IMPLEMENTATION NOTES
+// ----------------------------------------------------------------------------
+//
+// The stream-style sampling macros expand to a sequence of 'for' statements,
+// in the manner of the macros of 'ball_log' and 'ball_logthrottle', each of
+// which declares one of the following variables, and whose body is executed
+// at most once:
+//
+//: 1 'ball_logsample_cAtEgOrYhOlDeR', the category holder of the enclosing
+//:   scope if the severity of the message is enabled, and 0 otherwise.  Every
+//:   subsequent 'for' statement resets this variable to 0 once its body has
+//:   executed, which terminates all the enclosing 'for' statements.
+//:
+//: 2 'ball_logsample_sItE', the static 'LogSample_Site' of the invocation,
+//:   which is aggregate initialized so that its initialization is free of
+//:   race conditions on C++03 compilers.
+//:
+//: 3 'ball_logsample_cOuNtDoWn' and 'ball_logsample_tHrEaDrAtE', the
+//:   thread-local number of messages to skip and the sampling rate with which
+//:   that number was drawn (omitted if thread-local variables are not
+//:   supported).
+//:
+//: 4 'ball_logsample_rAtE', the sampling rate with which the current message
+//:   was selected, loaded by 'isSampled'.
+//:
+//: 5 'ball_log_lOg_StReAm', the 'Log_Stream' of the logged message, whose
+//:   record is given the sampling rate as its first user field before the
+//:   controlled statement is executed (as is done by the 'BALL_LOGCB' macros
+//:   of 'ball_log').
+//
+// The number of messages to skip is drawn from the geometric distribution by
+// inversion: if 'u' is uniformly distributed in '(0 .. 1]', and 'p' is the
+// probability of success, 'floor(log(u) / log(1 - p))' is the number of
+// failures preceding the first success of a Bernoulli process.  The uniform
+// variates are obtained by applying the "splitmix64" finalizer to a global
+// sequence number, which is incremented only when a message is logged.
+// ----------------------------------------------------------------------------
+
+namespace BloombergLP {
+namespace ball {
+
+namespace {
+
+const bsls::Types::Int64 k_NANOSECONDS_PER_PERIOD = 1000 * 1000 * 1000;
+                                                 // period of adaptation of the
+                                                 // sampling rate
+
+bsls::AtomicUint64 g_sequenceNumber(0);          // input of the pseudo-random
+                                                 // number generator
+
+double nextUniformVariate()
+    // Return a pseudo-random number uniformly distributed in '(0 .. 1]'.
+{
+    bsls::Types::Uint64 x = g_sequenceNumber.addRelaxed(
+                                                  0x9E3779B97F4A7C15ULL);
+
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    x =  x ^ (x >> 31);
+
+    // Use the 53 high-order bits, the precision of a 'double'.
+
+    return static_cast<double>((x >> 11) + 1) * (1.0 / 9007199254740992.0);
+}
+
+}  // close unnamed namespace
+
+                           // --------------------
+                           // class LogSample_Site
+                           // --------------------
+
+// PUBLIC CONSTANTS
+const int LogSample_Site::k_MAX_RATE;
+
+// PRIVATE MANIPULATORS
+void LogSample_Site::adaptRate()
+{
+    if (0 == d_maxRecordsPerSecond) {
+        return;                                                       // RETURN
+    }
+
+    const int numSampled =
+                      AtomicOps::addIntNvAcqRel(&d_numSampledInPeriod, 1);
+
+    const bsls::Types::Int64 now =
+                    bsls::SystemTime::nowMonotonicClock().totalNanoseconds();
+
+    const bsls::Types::Int64 start =
+                                  AtomicOps::getInt64Acquire(&d_periodStart);
+
+    if (0 == start) {
+        // This is the first message logged by this site.
+
+        AtomicOps::testAndSwapInt64AcqRel(&d_periodStart, 0, now);
+        return;                                                       // RETURN
+    }
+
+    const bsls::Types::Int64 elapsed = now - start;
+
+    if (elapsed < k_NANOSECONDS_PER_PERIOD
+     && numSampled <= d_maxRecordsPerSecond) {
+        return;                                                       // RETURN
+    }
+
+    if (start != AtomicOps::testAndSwapInt64AcqRel(&d_periodStart,
+                                                    start,
+                                                    now)) {
+        // Another thread is adapting the rate for this period.
+
+        return;                                                       // RETURN
+    }
+
+    const int numSampledInPeriod =
+                          AtomicOps::swapIntAcqRel(&d_numSampledInPeriod, 0);
+
+    const double numSubmittedPerSecond =
+                      static_cast<double>(numSampledInPeriod) * rate()
+                    * static_cast<double>(k_NANOSECONDS_PER_PERIOD)
+                    / static_cast<double>(0 < elapsed ? elapsed : 1);
+
+    const double newRate =
+                     bsl::ceil(numSubmittedPerSecond / d_maxRecordsPerSecond);
+
+    AtomicOps::setIntRelaxed(&d_rate,
+                             newRate < 1.0        ? 1
+                           : newRate > k_MAX_RATE ? k_MAX_RATE
+                           : static_cast<int>(newRate));
+}
+
+void LogSample_Site::sample(unsigned int *countdown, unsigned int *threadRate)
+{
+    BSLS_ASSERT(countdown);
+    BSLS_ASSERT(threadRate);
+
+    adaptRate();
+
+    const int currentRate = rate();
+
+    *threadRate = currentRate;
+    *countdown  = numToSkip(currentRate);
+}
+
+bool LogSample_Site::sampleShared(unsigned int *rate)
+{
+    BSLS_ASSERT(rate);
+
+    *rate = this->rate();
+
+    adaptRate();
+
+    const unsigned int numSkipped = numToSkip(this->rate());
+
+    AtomicOps::setIntRelaxed(&d_sharedCountdown,
+                             numSkipped > INT_MAX
+                             ? INT_MAX
+                             : static_cast<int>(numSkipped));
+    return true;
+}
+
+// CLASS METHODS
+unsigned int LogSample_Site::numToSkip(int rate)
+{
+    BSLS_ASSERT(0 < rate);
+
+    if (1 == rate) {
+        return 0;                                                     // RETURN
+    }
+
+    const double numSkipped = bsl::floor(
+                                   bsl::log(nextUniformVariate())
+                                 / bsl::log(1.0 - 1.0 / rate));
+
+    return numSkipped < static_cast<double>(UINT_MAX)
+           ? static_cast<unsigned int>(numSkipped)
+           : UINT_MAX;
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+// ----------------------------------------------------------------------------
+// Copyright 2020 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,752 @@
+// ball_logsample.h                                                   -*-C++-*-
+#ifndef INCLUDED_BALL_LOGSAMPLE
+#define INCLUDED_BALL_LOGSAMPLE
+
+#include <bsls_ident.h>
+BSLS_IDENT("$Id: $")
+
+//@PURPOSE: Provide sampling equivalents of some of the 'ball_log' macros.
+//
+//@CLASSES:
+//  ball::LogSample_Site: (component-private) state of one sampling macro
+//
+//@MACROS: BALL_LOGSAMPLE_TRACE,                 BALL_LOGSAMPLE_DEBUG,
+//         BALL_LOGSAMPLE_INFO,                  BALL_LOGSAMPLE_WARN,
+//         BALL_LOGSAMPLE_ERROR,                 BALL_LOGSAMPLE_FATAL,
+//         BALL_LOGSAMPLE_STREAM,
+//
+//         BALL_LOGSAMPLE_TRACE_BLOCK,           BALL_LOGSAMPLE_DEBUG_BLOCK,
+//         BALL_LOGSAMPLE_INFO_BLOCK,            BALL_LOGSAMPLE_WARN_BLOCK,
+//         BALL_LOGSAMPLE_ERROR_BLOCK,           BALL_LOGSAMPLE_FATAL_BLOCK,
+//         BALL_LOGSAMPLE_BLOCK,
+//
+//         BALL_LOGSAMPLEVA_TRACE,               BALL_LOGSAMPLEVA_DEBUG,
+//         BALL_LOGSAMPLEVA_INFO,                BALL_LOGSAMPLEVA_WARN,
+//         BALL_LOGSAMPLEVA_ERROR,               BALL_LOGSAMPLEVA_FATAL,
+//         BALL_LOGSAMPLEVA,
+//
+//         BALL_LOGSAMPLEADAPTIVE_TRACE,         BALL_LOGSAMPLEADAPTIVE_DEBUG,
+//         BALL_LOGSAMPLEADAPTIVE_INFO,          BALL_LOGSAMPLEADAPTIVE_WARN,
+//         BALL_LOGSAMPLEADAPTIVE_ERROR,         BALL_LOGSAMPLEADAPTIVE_FATAL,
+//         BALL_LOGSAMPLEADAPTIVE_STREAM,
+//
+//         BALL_LOGSAMPLEADAPTIVE_TRACE_BLOCK,
+//         BALL_LOGSAMPLEADAPTIVE_DEBUG_BLOCK,
+//         BALL_LOGSAMPLEADAPTIVE_INFO_BLOCK,
+//         BALL_LOGSAMPLEADAPTIVE_WARN_BLOCK,
+//         BALL_LOGSAMPLEADAPTIVE_ERROR_BLOCK,
+//         BALL_LOGSAMPLEADAPTIVE_FATAL_BLOCK,
+//         BALL_LOGSAMPLEADAPTIVE_BLOCK
+//
+//@SEE_ALSO: ball_log, ball_logthrottle, ball_userfields
+//
+//@DESCRIPTION: This component provides numerous macros for performing logging
+// where only a random *sample* of the messages is logged.  The macros in this
+// component are all analogous to corresponding macros in 'ball_log'.  For
+// example, the sampling version of 'BALL_LOG_INFO' is 'BALL_LOGSAMPLE_INFO',
+// and the sampling version of 'BALL_LOGVA' is 'BALL_LOGSAMPLEVA'.
+//
+// Whereas the macros provided by 'ball_logthrottle' bound the number of
+// messages logged in a period of time, the macros provided by this component
+// are intended for "hot" code paths, where a statistically representative
+// fraction of the messages is more useful than the first few messages of each
+// period, and where the cost of *not* logging a message must be minimal.
+//
+// Two families of sampling macros are provided:
+//
+//: o The 'BALL_LOGSAMPLE*' macros log, on average, one in every 'RATE'
+//:   messages, where 'RATE' is an argument of the macro.
+//:
+//: o The 'BALL_LOGSAMPLEADAPTIVE*' macros adapt the sampling rate of each
+//:   invocation site (see {Adaptive Sampling}) so that the site logs, on
+//:   average, no more than 'MAX_RECORDS_PER_SECOND' messages per second, where
+//:   'MAX_RECORDS_PER_SECOND' is an argument of the macro.
+//
+// Each invocation of any of the macros provided by this component instantiates
+// its own sampling state; the rate of a site is shared by all threads, and
+// the selection of the messages to log is made independently by each thread.
+//
+///Sampling Concepts
+///-----------------
+// Messages are selected for logging by a Bernoulli process: each message of a
+// site whose sampling rate is 'RATE' is logged with probability '1 / RATE',
+// independently of the other messages.  Rather than drawing a random number
+// for every message, each thread draws, once per logged message, the number
+// of subsequent messages to skip from the corresponding geometric
+// distribution, and stores it in a counter specific to the invocation site and
+// to the thread.  A message that is not logged therefore costs the check of
+// the category threshold that is performed by all 'ball_log' macros (see
+// {Logging Macro Performance} in 'ball_log'), followed by the decrement of a
+// thread-local counter; in particular, the clock is not read, no memory is
+// shared with other threads, and the arguments of the message are not
+// evaluated.
+//
+// Note that the first message of each site is logged by every thread that
+// executes the site, and that, unlike a "one in 'N'" counter, sampling is not
+// susceptible to aliasing with periodic patterns in the sequence of messages.
+//
+///Adaptive Sampling
+///- - - - - - - - -
+// The sampling rate of a 'BALL_LOGSAMPLEADAPTIVE*' site is initially 1 (i.e.,
+// every message is logged).  Each time a message is logged, the site counts
+// the logged message and, once per second (or sooner, if the site logged more
+// than 'MAX_RECORDS_PER_SECOND' messages since the previous adjustment),
+// estimates the rate at which messages are *submitted* to the site from the
+// number of messages logged and the sampling rate in effect.  The sampling
+// rate is then set to the smallest integer that brings the expected number of
+// messages logged per second within 'MAX_RECORDS_PER_SECOND'.  The sampling
+// rate therefore increases as a site gets "hotter", and decreases (down to 1)
+// as it cools down.  Note that the adjustment is performed only when a
+// message is logged, so that a site that is no longer executed retains its
+// sampling rate until it is next executed.
+//
+///Recorded Sampling Rate
+///----------------------
+// Each record logged by a macro of this component carries, as a user field of
+// type 'bsls::Types::Int64', the sampling rate with which the message was
+// selected, i.e., the reciprocal of the probability that the message was
+// logged.  The sampling rate is the *first* user field of the record,
+// followed by any user fields supplied by the user fields populator callback
+// that is configured by the logger manager (see 'ball_loggermanager').
+// Analysis tools can therefore estimate the total number of messages
+// submitted to a site by summing the sampling rates of the logged records (the
+// Horvitz-Thompson estimator), even if the rate of the site changed over time:
+//..
+//  bsls::Types::Int64 estimatedNumMessages = 0;
+//  for (int i = 0; i < numLoggedRecords; ++i) {
+//      estimatedNumMessages +=
+//                          loggedRecords[i].customFields()[0].theInt64();
+//  }
+//..
+// Note that the rate can be rendered in text logs using the '%U' specifier of
+// 'ball::RecordStringFormatter'.
+//
+///Thread Safety
+///-------------
+// All macros defined in this component are thread-safe, and can be invoked
+// concurrently by multiple threads.  On platforms that do not support
+// thread-local variables (see 'bslmt_threadlocalvariable'), the counter of
+// messages to skip is shared by all threads executing a site, and is updated
+// atomically.
+//
+///Macro Reference
+///---------------
+// This section documents the preprocessor macros defined in this component.
+// The following constraints pertain to all of the macros defined in this
+// component.
+//
+//: o 'RATE' and 'MAX_RECORDS_PER_SECOND' must be compile-time constants of
+//:   type 'int', and may not contain any floating-point subexpressions.
+//:
+//: o Any 'SEVERITY' argument is of type 'int' and is interpreted as described
+//:   by the 'ball_severity' component.
+//:
+//: o The behavior is undefined unless 'SEVERITY' is in the range '[0 .. 255]',
+//:   '0 < RATE', and '0 < MAX_RECORDS_PER_SECOND'.
+//
+///Stream-Based Sampling Macros
+/// - - - - - - - - - - - - - -
+// The 'BALL_LOGSAMPLE_*' macros are analogous to the 'BALL_LOG_*' macros,
+// except that they take an additional argument, 'RATE', described in
+// {Sampling Concepts} above:
+//..
+//  BALL_LOGSAMPLE_<SEVERITY>(RATE) << X << Y ... ;
+//      Log, with probability '1 / RATE', the formatted message resulting from
+//      'X, Y, ...', which represents any sequence of values for which
+//      'operator<<' is defined, with the severity indicated by the name of the
+//      macro (e.g., 'BALL_LOGSAMPLE_ERROR' logs with severity
+//      'ball::Severity::e_ERROR').  'X, Y, ...' are not evaluated unless the
+//      message is logged.
+//
+//  BALL_LOGSAMPLE_STREAM(SEVERITY, RATE) << X << Y ... ;
+//      Log, with probability '1 / RATE', the formatted message resulting from
+//      'X, Y, ...' with the specified 'SEVERITY'.
+//..
+// The 'BALL_LOGSAMPLEADAPTIVE_*' macros take the 'MAX_RECORDS_PER_SECOND'
+// argument described in {Adaptive Sampling} above instead of 'RATE':
+//..
+//  BALL_LOGSAMPLEADAPTIVE_<SEVERITY>(MAX_RECORDS_PER_SECOND) << X << Y ... ;
+//  BALL_LOGSAMPLEADAPTIVE_STREAM(SEVERITY, MAX_RECORDS_PER_SECOND)
+//                                                             << X << Y ... ;
+//      Log the formatted message resulting from 'X, Y, ...' with the
+//      severity indicated by the name of the macro, or the specified
+//      'SEVERITY', respectively, with a probability that is adapted such that
+//      the invocation site logs, on average, no more than the specified
+//      'MAX_RECORDS_PER_SECOND' messages per second.
+//..
+// For example:
+//..
+//  BALL_LOGSAMPLE_DEBUG(1000) << "Processed order " << orderId;
+//
+//  BALL_LOGSAMPLEADAPTIVE_INFO(10) << "Cache miss for " << key;
+//..
+//
+///BLOCK-Style Sampling Macros
+///- - - - - - - - - - - - - -
+// The 'BALL_LOGSAMPLE_*_BLOCK', 'BALL_LOGSAMPLE_BLOCK',
+// 'BALL_LOGSAMPLEADAPTIVE_*_BLOCK', and 'BALL_LOGSAMPLEADAPTIVE_BLOCK' macros
+// are analogous to the 'BALL_LOG_*_BLOCK' macros, except that they take the
+// additional sampling-related argument of their stream-based counterparts:
+//..
+//  BALL_LOGSAMPLE_<SEVERITY>_BLOCK(RATE) <block>
+//  BALL_LOGSAMPLE_BLOCK(SEVERITY, RATE) <block>
+//  BALL_LOGSAMPLEADAPTIVE_<SEVERITY>_BLOCK(MAX_RECORDS_PER_SECOND) <block>
+//  BALL_LOGSAMPLEADAPTIVE_BLOCK(SEVERITY, MAX_RECORDS_PER_SECOND) <block>
+//      If the message is selected as described for the corresponding
+//      stream-based macro, execute the controlled '<block>', within which any
+//      sequence of values for which 'operator<<' is defined may be streamed to
+//      'BALL_LOG_OUTPUT_STREAM', and log the resulting formatted message.
+//..
+// For example:
+//..
+//  BALL_LOGSAMPLE_TRACE_BLOCK(100) {
+//      for (int i = 0; i < numLevels; ++i) {
+//          BALL_LOG_OUTPUT_STREAM << book.level(i) << ' ';
+//      }
+//  }
+//..
+//
+///'printf'-Style Sampling Macros
+/// - - - - - - - - - - - - - - -
+// The 'BALL_LOGSAMPLEVA_*' macros are analogous to the 'BALL_LOGVA_*' macros,
+// except that they take an additional argument, 'RATE', described in
+// {Sampling Concepts} above:
+//..
+//  BALL_LOGSAMPLEVA_<SEVERITY>(RATE, MSG, ...);
+//  BALL_LOGSAMPLEVA(SEVERITY, RATE, MSG, ...);
+//      Log, with probability '1 / RATE', the message resulting from formatting
+//      the specified '...' optional arguments, if any, according to the
+//      'printf'-style format specification in the specified 'MSG' (assumed to
+//      be of type convertible to 'const char *'), with the severity indicated
+//      by the name of the macro, or the specified 'SEVERITY', respectively.
+//      The behavior is undefined unless the number and types of the optional
+//      arguments are compatible with the format specification in 'MSG'.  Note
+//      that each use of these macros must be terminated by a ';'.
+//..
+// For example:
+//..
+//  BALL_LOGSAMPLEVA_DEBUG(1000, "Processed order %d", orderId);
+//..
+//
+///Usage
+///-----
+// This section illustrates the intended use of this component.
+//
+///Example 1: Sampling the Messages of a Hot Code Path
+///- - - - - - - - - - - - - - - - - - - - - - - - - -
+// Suppose that we process a high volume of market data ticks, and that we
+// want to trace the processing of the ticks without flooding the log.
+//
+// First, we define a function that processes a tick, and traces, on average,
+// one in every 100 ticks that it processes:
+//..
+//  void processTick(int tickId)
+//  {
+//      BALL_LOG_SET_CATEGORY("TICKS.PROCESSOR");
+//
+//      BALL_LOGSAMPLE_TRACE(100) << "Processing tick " << tickId;
+//
+//      // ...
+//  }
+//..
+// Then, we process 100,000 ticks:
+//..
+//  for (int i = 0; i < 100 * 1000; ++i) {
+//      processTick(i);
+//  }
+//..
+// Now, assuming that the records logged were collected by an observer in the
+// vector 'records', we observe that approximately 1,000 of the ticks were
+// traced:
+//..
+//  assert(  800 < records.size());
+//  assert(1200  > records.size());
+//..
+// Finally, we estimate the number of ticks processed from the sampling rate
+// recorded in the first user field of the records:
+//..
+//  bsls::Types::Int64 estimatedNumTicks = 0;
+//  for (bsl::size_t i = 0; i < records.size(); ++i) {
+//      estimatedNumTicks += records[i].customFields()[0].theInt64();
+//  }
+//  assert( 80 * 1000 < estimatedNumTicks);
+//  assert(120 * 1000 > estimatedNumTicks);
+//..
+
+#include <balscm_version.h>
+
+#include <ball_category.h>
+#include <ball_log.h>
+#include <ball_severity.h>
+
+#include <bslmt_threadlocalvariable.h>
+
+#include <bsls_atomicoperations.h>
+#include <bsls_types.h>
+
+namespace BloombergLP {
+namespace ball {
+
+                           // ====================
+                           // class LogSample_Site
+                           // ====================
+
+class LogSample_Site {
+    // This component-private class holds the sampling state of one invocation
+    // of a macro of this component.  The data members of 'LogSample_Site' are
+    // public to allow for compile-time (aggregate) initialization of
+    // 'LogSample_Site' objects having static storage duration (see
+    // 'BALL_LOGSAMPLE_SITE_INIT_IMP').
+
+    // PRIVATE TYPES
+    typedef bsls::AtomicOperations AtomicOps;
+    typedef AtomicOps::AtomicTypes AtomicTypes;
+
+  public:
+    // PUBLIC CONSTANTS
+    static const int k_MAX_RATE = 1 << 30;  // maximum adaptive sampling rate
+
+    // PUBLIC DATA
+    AtomicTypes::Int   d_rate;                 // current sampling rate
+
+    AtomicTypes::Int   d_sharedCountdown;      // number of messages to skip,
+                                               // used only if thread-local
+                                               // variables are not supported
+
+    AtomicTypes::Int   d_numSampledInPeriod;   // number of messages logged
+                                               // since the start of the
+                                               // current period
+
+    AtomicTypes::Int64 d_periodStart;          // start of the current period
+                                               // (in nanoseconds, on the
+                                               // monotonic clock), or 0 if no
+                                               // message was logged yet
+
+    int                d_maxRecordsPerSecond;  // target of an adaptive site,
+                                               // or 0 for a fixed rate
+
+  private:
+    // PRIVATE MANIPULATORS
+    void adaptRate();
+        // Account for a message logged by this site and, if this site is
+        // adaptive and the current period is complete, adjust the sampling
+        // rate of this site as described in {Adaptive Sampling}.
+
+    void sample(unsigned int *countdown, unsigned int *threadRate);
+        // Account for a message logged by this site, and load into the
+        // specified 'countdown' a random number of subsequent messages to skip
+        // drawn according to the sampling rate of this site, which is loaded
+        // into the specified 'threadRate'.
+
+    bool sampleShared(unsigned int *rate);
+        // Account for a message logged by this site, reload
+        // 'd_sharedCountdown' with a random number of subsequent messages to
+        // skip, and load into the specified 'rate' the sampling rate of this
+        // site.  Return 'true'.
+
+  public:
+    // CLASS METHODS
+    static unsigned int numToSkip(int rate);
+        // Return a random number of messages to skip, drawn from the geometric
+        // distribution of the number of failures preceding the first success
+        // of a Bernoulli process having the probability '1 / rate' of success.
+        // The behavior is undefined unless '0 < rate'.
+
+    // MANIPULATORS
+    bool isSampled(unsigned int *rate,
+                   unsigned int *countdown,
+                   unsigned int *threadRate);
+        // Return 'true' if the current message of this site is to be logged,
+        // and 'false' otherwise, using the specified 'countdown' and
+        // 'threadRate' thread-local variables of this site, whose initial
+        // values must be 0 and 1, respectively.  If 'true' is returned, load
+        // into the specified 'rate' the sampling rate with which the message
+        // was selected.
+
+    bool isSampledShared(unsigned int *rate);
+        // Return 'true' if the current message of this site is to be logged,
+        // and 'false' otherwise, using the counter of this site shared by all
+        // threads.  If 'true' is returned, load into the specified 'rate' the
+        // sampling rate with which the message was selected.
+
+    // ACCESSORS
+    int rate() const;
+        // Return the current sampling rate of this site.
+};
+
+}  // close package namespace
+}  // close enterprise namespace
+
+                 // ====================================
+                 // Implementation Details: Do *NOT* Use
+                 // ====================================
+
+#define BALL_LOGSAMPLE_SITE_INIT_IMP(RATE, MAX_RECORDS_PER_SECOND) {          \
+    { (RATE) }, { 0 }, { 0 }, { 0 }, (MAX_RECORDS_PER_SECOND)                 \
+}
+
+#if defined(BSLMT_THREAD_LOCAL_KEYWORD)
+
+#define BALL_LOGSAMPLE_SELECT_IMP(RATE, MAX_RECORDS_PER_SECOND)               \
+for (static BloombergLP::ball::LogSample_Site ball_logsample_sItE =           \
+                    BALL_LOGSAMPLE_SITE_INIT_IMP((RATE),                      \
+                                                 (MAX_RECORDS_PER_SECOND));   \
+     ball_logsample_cAtEgOrYhOlDeR;                                           \
+     ball_logsample_cAtEgOrYhOlDeR = 0)                                       \
+for (static BSLMT_THREAD_LOCAL_KEYWORD unsigned int                           \
+                                            ball_logsample_cOuNtDoWn = 0,     \
+                                            ball_logsample_tHrEaDrAtE = 1;    \
+     ball_logsample_cAtEgOrYhOlDeR;                                           \
+     ball_logsample_cAtEgOrYhOlDeR = 0)                                       \
+for (unsigned int ball_logsample_rAtE = 0;                                    \
+     ball_logsample_cAtEgOrYhOlDeR                                            \
+    && ball_logsample_sItE.isSampled(&ball_logsample_rAtE,                    \
+                                     &ball_logsample_cOuNtDoWn,               \
+                                     &ball_logsample_tHrEaDrAtE);             \
+     )
+
+#else
+
+#define BALL_LOGSAMPLE_SELECT_IMP(RATE, MAX_RECORDS_PER_SECOND)               \
+for (static BloombergLP::ball::LogSample_Site ball_logsample_sItE =           \
+                    BALL_LOGSAMPLE_SITE_INIT_IMP((RATE),                      \
+                                                 (MAX_RECORDS_PER_SECOND));   \
+     ball_logsample_cAtEgOrYhOlDeR;                                           \
+     ball_logsample_cAtEgOrYhOlDeR = 0)                                       \
+for (unsigned int ball_logsample_rAtE = 0;                                    \
+     ball_logsample_cAtEgOrYhOlDeR                                            \
+    && ball_logsample_sItE.isSampledShared(&ball_logsample_rAtE);             \
+     )
+
+#endif
+
+#define BALL_LOGSAMPLE_STREAM_TAIL_IMP(SEVERITY)                              \
+for (BloombergLP::ball::Log_Stream ball_log_lOg_StReAm(                       \
+                                   ball_logsample_cAtEgOrYhOlDeR->category(), \
+                                   __FILE__,                                  \
+                                   __LINE__,                                  \
+                                   (SEVERITY));                               \
+     ball_logsample_cAtEgOrYhOlDeR                                            \
+    && (ball_log_lOg_StReAm.record()->customFields().appendInt64(             \
+                                                  ball_logsample_rAtE), true);\
+     ball_logsample_cAtEgOrYhOlDeR = 0)
+
+#define BALL_LOGSAMPLE_STREAM_CONST_IMP(SEVERITY,                             \
+                                        RATE,                                 \
+                                        MAX_RECORDS_PER_SECOND)               \
+for (const BloombergLP::ball::CategoryHolder *ball_logsample_cAtEgOrYhOlDeR   \
+             = BloombergLP::ball::Log::categoryHolderIfEnabled<(SEVERITY)>(   \
+                        ball_log_getCategoryHolder(BALL_LOG_CATEGORYHOLDER)); \
+     ball_logsample_cAtEgOrYhOlDeR;                                           \
+     ball_logsample_cAtEgOrYhOlDeR = 0)                                       \
+BALL_LOGSAMPLE_SELECT_IMP((RATE), (MAX_RECORDS_PER_SECOND))                   \
+BALL_LOGSAMPLE_STREAM_TAIL_IMP((SEVERITY))
+
+#define BALL_LOGSAMPLE_STREAM_IMP(SEVERITY, RATE, MAX_RECORDS_PER_SECOND)     \
+for (const BloombergLP::ball::CategoryHolder *ball_logsample_cAtEgOrYhOlDeR   \
+                       = ball_log_getCategoryHolder(BALL_LOG_CATEGORYHOLDER); \
+     ball_logsample_cAtEgOrYhOlDeR                                            \
+    && ball_logsample_cAtEgOrYhOlDeR->threshold() >= (SEVERITY)               \
+    && BloombergLP::ball::Log::isCategoryEnabled(                             \
+                                            ball_logsample_cAtEgOrYhOlDeR,    \
+                                            (SEVERITY));                      \
+     ball_logsample_cAtEgOrYhOlDeR = 0)                                       \
+BALL_LOGSAMPLE_SELECT_IMP((RATE), (MAX_RECORDS_PER_SECOND))                   \
+BALL_LOGSAMPLE_STREAM_TAIL_IMP((SEVERITY))
+
+#define BALL_LOGSAMPLEVA_IMP(SEVERITY, RATE, ...)                             \
+do {                                                                          \
+    for (const BloombergLP::ball::CategoryHolder                              \
+                                            *ball_logsample_cAtEgOrYhOlDeR    \
+                      = ball_log_getCategoryHolder(BALL_LOG_CATEGORYHOLDER);  \
+         ball_logsample_cAtEgOrYhOlDeR                                        \
+        && ball_logsample_cAtEgOrYhOlDeR->threshold() >= (SEVERITY)           \
+        && BloombergLP::ball::Log::isCategoryEnabled(                         \
+                                            ball_logsample_cAtEgOrYhOlDeR,    \
+                                            (SEVERITY));                      \
+         ball_logsample_cAtEgOrYhOlDeR = 0)                                   \
+    BALL_LOGSAMPLE_SELECT_IMP((RATE), 0)                                      \
+    for (BloombergLP::ball::Log_Formatter ball_logsample_fOrMaTtEr(           \
+                                 ball_logsample_cAtEgOrYhOlDeR->category(),   \
+                                 __FILE__,                                    \
+                                 __LINE__,                                    \
+                                 (SEVERITY));                                 \
+         ball_logsample_cAtEgOrYhOlDeR                                        \
+        && (ball_logsample_fOrMaTtEr.record()->customFields().appendInt64(    \
+                                                  ball_logsample_rAtE), true);\
+         ball_logsample_cAtEgOrYhOlDeR = 0)                                   \
+        BloombergLP::ball::Log::format(                                       \
+                                 ball_logsample_fOrMaTtEr.messageBuffer(),    \
+                                 ball_logsample_fOrMaTtEr.messageBufferLen(), \
+                                 __VA_ARGS__);                                \
+} while(0)
+
+#define BALL_LOGSAMPLEVA_CONST_IMP(SEVERITY, RATE, ...)                       \
+do {                                                                          \
+    for (const BloombergLP::ball::CategoryHolder                              \
+                                            *ball_logsample_cAtEgOrYhOlDeR    \
+            = BloombergLP::ball::Log::categoryHolderIfEnabled<(SEVERITY)>(    \
+                      ball_log_getCategoryHolder(BALL_LOG_CATEGORYHOLDER));   \
+         ball_logsample_cAtEgOrYhOlDeR;                                       \
+         ball_logsample_cAtEgOrYhOlDeR = 0)                                   \
+    BALL_LOGSAMPLE_SELECT_IMP((RATE), 0)                                      \
+    for (BloombergLP::ball::Log_Formatter ball_logsample_fOrMaTtEr(           \
+                                 ball_logsample_cAtEgOrYhOlDeR->category(),   \
+                                 __FILE__,                                    \
+                                 __LINE__,                                    \
+                                 (SEVERITY));                                 \
+         ball_logsample_cAtEgOrYhOlDeR                                        \
+        && (ball_logsample_fOrMaTtEr.record()->customFields().appendInt64(    \
+                                                  ball_logsample_rAtE), true);\
+         ball_logsample_cAtEgOrYhOlDeR = 0)                                   \
+        BloombergLP::ball::Log::format(                                       \
+                                 ball_logsample_fOrMaTtEr.messageBuffer(),    \
+                                 ball_logsample_fOrMaTtEr.messageBufferLen(), \
+                                 __VA_ARGS__);                                \
+} while(0)
+
+                       // ================================
+                       // C++ Stream-Style sampling macros
+                       // ================================
+
+#define BALL_LOGSAMPLE_STREAM(SEVERITY, RATE)                                 \
+    BALL_LOGSAMPLE_STREAM_IMP((SEVERITY), (RATE), 0) BALL_LOG_OUTPUT_STREAM
+
+#define BALL_LOGSAMPLE_TRACE(RATE)                                            \
+    BALL_LOGSAMPLE_STREAM_CONST_IMP(BloombergLP::ball::Severity::e_TRACE,     \
+                                    (RATE),                                   \
+                                    0) BALL_LOG_OUTPUT_STREAM
+
+#define BALL_LOGSAMPLE_DEBUG(RATE)                                            \
+    BALL_LOGSAMPLE_STREAM_CONST_IMP(BloombergLP::ball::Severity::e_DEBUG,     \
+                                    (RATE),                                   \
+                                    0) BALL_LOG_OUTPUT_STREAM
+
+#define BALL_LOGSAMPLE_INFO(RATE)                                             \
+    BALL_LOGSAMPLE_STREAM_CONST_IMP(BloombergLP::ball::Severity::e_INFO,      \
+                                    (RATE),                                   \
+                                    0) BALL_LOG_OUTPUT_STREAM
+
+#define BALL_LOGSAMPLE_WARN(RATE)                                             \
+    BALL_LOGSAMPLE_STREAM_CONST_IMP(BloombergLP::ball::Severity::e_WARN,      \
+                                    (RATE),                                   \
+                                    0) BALL_LOG_OUTPUT_STREAM
+
+#define BALL_LOGSAMPLE_ERROR(RATE)                                            \
+    BALL_LOGSAMPLE_STREAM_CONST_IMP(BloombergLP::ball::Severity::e_ERROR,     \
+                                    (RATE),                                   \
+                                    0) BALL_LOG_OUTPUT_STREAM
+
+#define BALL_LOGSAMPLE_FATAL(RATE)                                            \
+    BALL_LOGSAMPLE_STREAM_CONST_IMP(BloombergLP::ball::Severity::e_FATAL,     \
+                                    (RATE),                                   \
+                                    0) BALL_LOG_OUTPUT_STREAM
+
+#define BALL_LOGSAMPLEADAPTIVE_STREAM(SEVERITY, MAX_RECORDS_PER_SECOND)       \
+    BALL_LOGSAMPLE_STREAM_IMP((SEVERITY), 1, (MAX_RECORDS_PER_SECOND))        \
+                                                         BALL_LOG_OUTPUT_STREAM
+
+#define BALL_LOGSAMPLEADAPTIVE_TRACE(MAX_RECORDS_PER_SECOND)                  \
+    BALL_LOGSAMPLE_STREAM_CONST_IMP(BloombergLP::ball::Severity::e_TRACE,     \
+                                    1,                                        \
+                                    (MAX_RECORDS_PER_SECOND))                 \
+                                                         BALL_LOG_OUTPUT_STREAM
+
+#define BALL_LOGSAMPLEADAPTIVE_DEBUG(MAX_RECORDS_PER_SECOND)                  \
+    BALL_LOGSAMPLE_STREAM_CONST_IMP(BloombergLP::ball::Severity::e_DEBUG,     \
+                                    1,                                        \
+                                    (MAX_RECORDS_PER_SECOND))                 \
+                                                         BALL_LOG_OUTPUT_STREAM
+
+#define BALL_LOGSAMPLEADAPTIVE_INFO(MAX_RECORDS_PER_SECOND)                   \
+    BALL_LOGSAMPLE_STREAM_CONST_IMP(BloombergLP::ball::Severity::e_INFO,      \
+                                    1,                                        \
+                                    (MAX_RECORDS_PER_SECOND))                 \
+                                                         BALL_LOG_OUTPUT_STREAM
+
+#define BALL_LOGSAMPLEADAPTIVE_WARN(MAX_RECORDS_PER_SECOND)                   \
+    BALL_LOGSAMPLE_STREAM_CONST_IMP(BloombergLP::ball::Severity::e_WARN,      \
+                                    1,                                        \
+                                    (MAX_RECORDS_PER_SECOND))                 \
+                                                         BALL_LOG_OUTPUT_STREAM
+
+#define BALL_LOGSAMPLEADAPTIVE_ERROR(MAX_RECORDS_PER_SECOND)                  \
+    BALL_LOGSAMPLE_STREAM_CONST_IMP(BloombergLP::ball::Severity::e_ERROR,     \
+                                    1,                                        \
+                                    (MAX_RECORDS_PER_SECOND))                 \
+                                                         BALL_LOG_OUTPUT_STREAM
+
+#define BALL_LOGSAMPLEADAPTIVE_FATAL(MAX_RECORDS_PER_SECOND)                  \
+    BALL_LOGSAMPLE_STREAM_CONST_IMP(BloombergLP::ball::Severity::e_FATAL,     \
+                                    1,                                        \
+                                    (MAX_RECORDS_PER_SECOND))                 \
+                                                         BALL_LOG_OUTPUT_STREAM
+
+                          // ===========================
+                          // BLOCK-Style sampling macros
+                          // ===========================
+
+#define BALL_LOGSAMPLE_BLOCK(SEVERITY, RATE)                                  \
+    BALL_LOGSAMPLE_STREAM_IMP((SEVERITY), (RATE), 0)
+
+#define BALL_LOGSAMPLE_TRACE_BLOCK(RATE)                                      \
+    BALL_LOGSAMPLE_STREAM_CONST_IMP(BloombergLP::ball::Severity::e_TRACE,     \
+                                    (RATE),                                   \
+                                    0)
+
+#define BALL_LOGSAMPLE_DEBUG_BLOCK(RATE)                                      \
+    BALL_LOGSAMPLE_STREAM_CONST_IMP(BloombergLP::ball::Severity::e_DEBUG,     \
+                                    (RATE),                                   \
+                                    0)
+
+#define BALL_LOGSAMPLE_INFO_BLOCK(RATE)                                       \
+    BALL_LOGSAMPLE_STREAM_CONST_IMP(BloombergLP::ball::Severity::e_INFO,      \
+                                    (RATE),                                   \
+                                    0)
+
+#define BALL_LOGSAMPLE_WARN_BLOCK(RATE)                                       \
+    BALL_LOGSAMPLE_STREAM_CONST_IMP(BloombergLP::ball::Severity::e_WARN,      \
+                                    (RATE),                                   \
+                                    0)
+
+#define BALL_LOGSAMPLE_ERROR_BLOCK(RATE)                                      \
+    BALL_LOGSAMPLE_STREAM_CONST_IMP(BloombergLP::ball::Severity::e_ERROR,     \
+                                    (RATE),                                   \
+                                    0)
+
+#define BALL_LOGSAMPLE_FATAL_BLOCK(RATE)                                      \
+    BALL_LOGSAMPLE_STREAM_CONST_IMP(BloombergLP::ball::Severity::e_FATAL,     \
+                                    (RATE),                                   \
+                                    0)
+
+#define BALL_LOGSAMPLEADAPTIVE_BLOCK(SEVERITY, MAX_RECORDS_PER_SECOND)        \
+    BALL_LOGSAMPLE_STREAM_IMP((SEVERITY), 1, (MAX_RECORDS_PER_SECOND))
+
+#define BALL_LOGSAMPLEADAPTIVE_TRACE_BLOCK(MAX_RECORDS_PER_SECOND)            \
+    BALL_LOGSAMPLE_STREAM_CONST_IMP(BloombergLP::ball::Severity::e_TRACE,     \
+                                    1,                                        \
+                                    (MAX_RECORDS_PER_SECOND))
+
+#define BALL_LOGSAMPLEADAPTIVE_DEBUG_BLOCK(MAX_RECORDS_PER_SECOND)            \
+    BALL_LOGSAMPLE_STREAM_CONST_IMP(BloombergLP::ball::Severity::e_DEBUG,     \
+                                    1,                                        \
+                                    (MAX_RECORDS_PER_SECOND))
+
+#define BALL_LOGSAMPLEADAPTIVE_INFO_BLOCK(MAX_RECORDS_PER_SECOND)             \
+    BALL_LOGSAMPLE_STREAM_CONST_IMP(BloombergLP::ball::Severity::e_INFO,      \
+                                    1,                                        \
+                                    (MAX_RECORDS_PER_SECOND))
+
+#define BALL_LOGSAMPLEADAPTIVE_WARN_BLOCK(MAX_RECORDS_PER_SECOND)             \
+    BALL_LOGSAMPLE_STREAM_CONST_IMP(BloombergLP::ball::Severity::e_WARN,      \
+                                    1,                                        \
+                                    (MAX_RECORDS_PER_SECOND))
+
+#define BALL_LOGSAMPLEADAPTIVE_ERROR_BLOCK(MAX_RECORDS_PER_SECOND)            \
+    BALL_LOGSAMPLE_STREAM_CONST_IMP(BloombergLP::ball::Severity::e_ERROR,     \
+                                    1,                                        \
+                                    (MAX_RECORDS_PER_SECOND))
+
+#define BALL_LOGSAMPLEADAPTIVE_FATAL_BLOCK(MAX_RECORDS_PER_SECOND)            \
+    BALL_LOGSAMPLE_STREAM_CONST_IMP(BloombergLP::ball::Severity::e_FATAL,     \
+                                    1,                                        \
+                                    (MAX_RECORDS_PER_SECOND))
+
+                        // ==============================
+                        // 'printf'-style sampling macros
+                        // ==============================
+
+#define BALL_LOGSAMPLEVA(SEVERITY, RATE, ...)                                 \
+    BALL_LOGSAMPLEVA_IMP((SEVERITY), (RATE), __VA_ARGS__)
+
+#define BALL_LOGSAMPLEVA_TRACE(RATE, ...)                                     \
+    BALL_LOGSAMPLEVA_CONST_IMP(BloombergLP::ball::Severity::e_TRACE,          \
+                               (RATE),                                        \
+                               __VA_ARGS__)
+
+#define BALL_LOGSAMPLEVA_DEBUG(RATE, ...)                                     \
+    BALL_LOGSAMPLEVA_CONST_IMP(BloombergLP::ball::Severity::e_DEBUG,          \
+                               (RATE),                                        \
+                               __VA_ARGS__)
+
+#define BALL_LOGSAMPLEVA_INFO(RATE, ...)                                      \
+    BALL_LOGSAMPLEVA_CONST_IMP(BloombergLP::ball::Severity::e_INFO,           \
+                               (RATE),                                        \
+                               __VA_ARGS__)
+
+#define BALL_LOGSAMPLEVA_WARN(RATE, ...)                                      \
+    BALL_LOGSAMPLEVA_CONST_IMP(BloombergLP::ball::Severity::e_WARN,           \
+                               (RATE),                                        \
+                               __VA_ARGS__)
+
+#define BALL_LOGSAMPLEVA_ERROR(RATE, ...)                                     \
+    BALL_LOGSAMPLEVA_CONST_IMP(BloombergLP::ball::Severity::e_ERROR,          \
+                               (RATE),                                        \
+                               __VA_ARGS__)
+
+#define BALL_LOGSAMPLEVA_FATAL(RATE, ...)                                     \
+    BALL_LOGSAMPLEVA_CONST_IMP(BloombergLP::ball::Severity::e_FATAL,          \
+                               (RATE),                                        \
+                               __VA_ARGS__)
+
+namespace BloombergLP {
+namespace ball {
+
+// ============================================================================
+//                              INLINE DEFINITIONS
+// ============================================================================
+
+                           // --------------------
+                           // class LogSample_Site
+                           // --------------------
+
+// MANIPULATORS
+inline
+bool LogSample_Site::isSampled(unsigned int *rate,
+                               unsigned int *countdown,
+                               unsigned int *threadRate)
+{
+    if (*countdown) {
+        --*countdown;
+        return false;                                                 // RETURN
+    }
+
+    *rate = *threadRate;
+    sample(countdown, threadRate);
+    return true;
+}
+
+inline
+bool LogSample_Site::isSampledShared(unsigned int *rate)
+{
+    return -1 == AtomicOps::addIntNvRelaxed(&d_sharedCountdown, -1)
+        && sampleShared(rate);
+}
+
+// ACCESSORS
+inline
+int LogSample_Site::rate() const
+{
+    return AtomicOps::getIntRelaxed(&d_rate);
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2020 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,1479 @@
+// ball_logsample.t.cpp                                               -*-C++-*-
+#include <ball_logsample.h>
+
+#include <ball_administration.h>
+#include <ball_context.h>
+#include <ball_log.h>
+#include <ball_loggermanager.h>
+#include <ball_loggermanagerconfiguration.h>
+#include <ball_observer.h>
+#include <ball_record.h>
+#include <ball_userfields.h>
+#include <ball_userfieldtype.h>
+
+#include <bslim_testutil.h>
+
+#include <bslma_testallocator.h>
+
+#include <bslmt_barrier.h>
+#include <bslmt_lockguard.h>
+#include <bslmt_mutex.h>
+#include <bslmt_threadgroup.h>
+
+#include <bsls_assert.h>
+#include <bsls_platform.h>
+#include <bsls_stopwatch.h>
+#include <bsls_systemtime.h>
+#include <bsls_types.h>
+
+#include <bsl_cstddef.h>
+#include <bsl_cstdlib.h>    // atoi()
+#include <bsl_cstring.h>    // strcmp()
+#include <bsl_iostream.h>
+#include <bsl_memory.h>
+#include <bsl_sstream.h>
+#include <bsl_vector.h>
+
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+// Undefine some awkwardly named Windows macros that interfere with this cpp
+// file, but only after the last #include.
+# undef ERROR
+#endif
+
+// ============================================================================
+//                             TEST PLAN
+// ----------------------------------------------------------------------------
+//                              Overview
+//                              --------
+// The component under test consists of a large number of preprocessor macros,
+// and of a component-private class, 'ball::LogSample_Site', that holds the
+// state of an invocation site of the macros.
+//
+// We first test the methods of 'ball::LogSample_Site' directly: the
+// distribution of the number of messages to skip, the selection of messages
+// using thread-local and shared counters, and the adaptation of the sampling
+// rate.  We then test the macros, verifying that approximately the expected
+// fraction of the messages is logged, that each logged record carries the
+// sampling rate as its first user field, that the arguments of the skipped
+// messages are not evaluated, and that each use of a macro is a single
+// statement.
+// ----------------------------------------------------------------------------
+// CLASS METHODS
+// [ 2] unsigned int numToSkip(int rate);
+//
+// MANIPULATORS
+// [ 1] bool isSampled(unsigned int *, unsigned int *, unsigned int *);
+// [ 1] bool isSampledShared(unsigned int *);
+// [ 3] bool isSampled(unsigned int *, unsigned int *, unsigned int *);
+//
+// ACCESSORS
+// [ 1] int rate() const;
+//
+// MACROS
+// [ 4] BALL_LOGSAMPLE_STREAM
+// [ 4] BALL_LOGSAMPLE_TRACE
+// [ 4] BALL_LOGSAMPLE_DEBUG
+// [ 4] BALL_LOGSAMPLE_INFO
+// [ 4] BALL_LOGSAMPLE_WARN
+// [ 4] BALL_LOGSAMPLE_ERROR
+// [ 4] BALL_LOGSAMPLE_FATAL
+// [ 5] BALL_LOGSAMPLE_BLOCK
+// [ 5] BALL_LOGSAMPLE_TRACE_BLOCK
+// [ 5] BALL_LOGSAMPLE_DEBUG_BLOCK
+// [ 5] BALL_LOGSAMPLE_INFO_BLOCK
+// [ 5] BALL_LOGSAMPLE_WARN_BLOCK
+// [ 5] BALL_LOGSAMPLE_ERROR_BLOCK
+// [ 5] BALL_LOGSAMPLE_FATAL_BLOCK
+// [ 6] BALL_LOGSAMPLEVA
+// [ 6] BALL_LOGSAMPLEVA_TRACE
+// [ 6] BALL_LOGSAMPLEVA_DEBUG
+// [ 6] BALL_LOGSAMPLEVA_INFO
+// [ 6] BALL_LOGSAMPLEVA_WARN
+// [ 6] BALL_LOGSAMPLEVA_ERROR
+// [ 6] BALL_LOGSAMPLEVA_FATAL
+// [ 7] BALL_LOGSAMPLEADAPTIVE_STREAM
+// [ 7] BALL_LOGSAMPLEADAPTIVE_TRACE
+// [ 7] BALL_LOGSAMPLEADAPTIVE_DEBUG
+// [ 7] BALL_LOGSAMPLEADAPTIVE_INFO
+// [ 7] BALL_LOGSAMPLEADAPTIVE_WARN
+// [ 7] BALL_LOGSAMPLEADAPTIVE_ERROR
+// [ 7] BALL_LOGSAMPLEADAPTIVE_FATAL
+// [ 7] BALL_LOGSAMPLEADAPTIVE_BLOCK
+// [ 7] BALL_LOGSAMPLEADAPTIVE_TRACE_BLOCK
+// [ 7] BALL_LOGSAMPLEADAPTIVE_DEBUG_BLOCK
+// [ 7] BALL_LOGSAMPLEADAPTIVE_INFO_BLOCK
+// [ 7] BALL_LOGSAMPLEADAPTIVE_WARN_BLOCK
+// [ 7] BALL_LOGSAMPLEADAPTIVE_ERROR_BLOCK
+// [ 7] BALL_LOGSAMPLEADAPTIVE_FATAL_BLOCK
+// ----------------------------------------------------------------------------
+// [ 9] USAGE EXAMPLE
+// [ 8] CONCURRENCY: MULTIPLE THREADS SHARING A SITE
+// [-1] PERFORMANCE: COST OF A SKIPPED MESSAGE
+// ----------------------------------------------------------------------------
+
+// Please do not include the entire 'BloombergLP' or 'bsl' namespaces into
+// this component, because we want to make sure that the macros under test
+// work properly without them.
+
+using bsl::cout;
+using bsl::cerr;
+using bsl::endl;
+
+// ============================================================================
+//                     STANDARD BDE ASSERT TEST FUNCTION
+// ----------------------------------------------------------------------------
+
+namespace {
+
+int testStatus = 0;
+
+void aSsErT(bool condition, const char *message, int line)
+{
+    if (condition) {
+        cout << "Error " __FILE__ "(" << line << "): " << message
+             << "    (failed)" << endl;
+
+        if (0 <= testStatus && testStatus <= 100) {
+            ++testStatus;
+        }
+    }
+}
+
+}  // close unnamed namespace
+
+// ============================================================================
+//               STANDARD BDE TEST DRIVER MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT       BSLIM_TESTUTIL_ASSERT
+#define ASSERTV      BSLIM_TESTUTIL_ASSERTV
+
+#define Q            BSLIM_TESTUTIL_Q   // Quote identifier literally.
+#define P            BSLIM_TESTUTIL_P   // Print identifier and value.
+#define P_           BSLIM_TESTUTIL_P_  // P(X) without '\n'.
+#define T_           BSLIM_TESTUTIL_T_  // Print a tab (w/o newline).
+#define L_           BSLIM_TESTUTIL_L_  // current Line number
+
+// ============================================================================
+//                  GLOBAL TYPEDEFS/CONSTANTS FOR TESTING
+// ----------------------------------------------------------------------------
+
+typedef BloombergLP::ball::LogSample_Site Obj;
+typedef BloombergLP::ball::Record         Record;
+typedef BloombergLP::ball::Severity       Sev;
+typedef BloombergLP::bslma::TestAllocator TestAllocator;
+typedef BloombergLP::bsls::Types::Int64   Int64;
+
+static bool verbose;
+static bool veryVerbose;
+static bool veryVeryVerbose;
+static bool veryVeryVeryVerbose;
+
+// ============================================================================
+//                  GLOBAL HELPER FUNCTIONS FOR TESTING
+// ----------------------------------------------------------------------------
+
+namespace {
+namespace u {
+
+                           // =====================
+                           // class RecordCollector
+                           // =====================
+
+class RecordCollector : public BloombergLP::ball::Observer {
+    // This class provides an observer that keeps a copy of every record that
+    // it publishes.
+
+    // DATA
+    mutable BloombergLP::bslmt::Mutex d_mutex;    // serialize access
+    bsl::vector<Record>               d_records;  // published records
+
+  public:
+    // CREATORS
+    explicit RecordCollector(BloombergLP::bslma::Allocator *basicAllocator)
+    : d_records(basicAllocator)
+        // Create a collector having no record.  Use the specified
+        // 'basicAllocator' to supply memory.
+    {
+    }
+
+    // MANIPULATORS
+    using BloombergLP::ball::Observer::publish;
+
+    void publish(const bsl::shared_ptr<const Record>& record,
+                 const BloombergLP::ball::Context&)
+        // Keep a copy of the specified 'record'.
+    {
+        BloombergLP::bslmt::LockGuard<BloombergLP::bslmt::Mutex> guard(
+                                                                    &d_mutex);
+        d_records.push_back(*record);
+    }
+
+    void reset()
+        // Discard the records kept by this collector.
+    {
+        BloombergLP::bslmt::LockGuard<BloombergLP::bslmt::Mutex> guard(
+                                                                    &d_mutex);
+        d_records.clear();
+    }
+
+    // ACCESSORS
+    const bsl::vector<Record>& records() const
+        // Return a reference providing non-modifiable access to the records
+        // kept by this collector.
+    {
+        return d_records;
+    }
+
+    int numRecords() const
+        // Return the number of records kept by this collector.
+    {
+        BloombergLP::bslmt::LockGuard<BloombergLP::bslmt::Mutex> guard(
+                                                                    &d_mutex);
+        return static_cast<int>(d_records.size());
+    }
+
+    Int64 sumOfRates() const
+        // Return the sum of the sampling rates recorded in the first user
+        // field of the records kept by this collector.
+    {
+        BloombergLP::bslmt::LockGuard<BloombergLP::bslmt::Mutex> guard(
+                                                                    &d_mutex);
+        Int64 result = 0;
+        for (bsl::size_t i = 0; i < d_records.size(); ++i) {
+            result += d_records[i].customFields()[0].theInt64();
+        }
+        return result;
+    }
+};
+
+bool isRecordOkay(const Record&  record,
+                  int            severity,
+                  Int64          rate,
+                  const char    *message)
+    // Return 'true' if the specified 'record' has the specified 'severity',
+    // has the specified 'message', and has exactly one user field whose value
+    // is the specified 'rate', and 'false' otherwise.
+{
+    const int saveStatus = testStatus;
+
+    ASSERTV(severity, record.fixedFields().severity(),
+            severity == record.fixedFields().severity());
+    ASSERTV(message, record.fixedFields().message(),
+            0 == bsl::strcmp(message, record.fixedFields().message()));
+    ASSERTV(record.customFields().length(),
+            1 == record.customFields().length());
+
+    if (1 == record.customFields().length()) {
+        ASSERTV(BloombergLP::ball::UserFieldType::e_INT64 ==
+                                          record.customFields()[0].type());
+        ASSERTV(rate, record.customFields()[0].theInt64(),
+                rate == record.customFields()[0].theInt64());
+    }
+    return saveStatus == testStatus;
+}
+
+bool isRateOkay(const RecordCollector& collector,
+                int                    rate,
+                int                    numMessages)
+    // Return 'true' if the records kept by the specified 'collector' are the
+    // expected outcome of the sampling of the specified 'numMessages' messages
+    // with the specified 'rate' by a single thread, i.e., the first record has
+    // a rate of 1, every other record has a rate of 'rate', and the number of
+    // records is within 20% of 'numMessages / rate', and 'false' otherwise.
+{
+    const int saveStatus = testStatus;
+
+    const bsl::vector<Record>& records  = collector.records();
+    const int                  expected = numMessages / rate;
+    const int                  actual   = static_cast<int>(records.size());
+
+    ASSERTV(rate, expected, actual,
+            expected * 8 / 10 < actual && actual < expected * 12 / 10);
+
+    for (bsl::size_t i = 0; i < records.size(); ++i) {
+        const Int64 EXP = 0 == i ? 1 : rate;
+        ASSERTV(i, EXP, records[i].customFields()[0].theInt64(),
+                EXP == records[i].customFields()[0].theInt64());
+    }
+    return saveStatus == testStatus;
+}
+
+int increment(int *counter)
+    // Increment the specified 'counter' and return its new value.
+{
+    return ++*counter;
+}
+
+}  // close namespace u
+}  // close unnamed namespace
+
+// ============================================================================
+//                             CONCURRENCY TEST
+// ----------------------------------------------------------------------------
+
+namespace Concurrency {
+
+enum {
+    k_NUM_THREADS          = 4,
+    k_MESSAGES_PER_THREAD  = 100 * 1000,
+    k_RATE                 = 100
+};
+
+BloombergLP::bslmt::Barrier barrier(k_NUM_THREADS);
+
+void threadFunction()
+    // Wait on 'barrier', and then submit 'k_MESSAGES_PER_THREAD' messages to
+    // a single site sampling with a rate of 'k_RATE'.
+{
+    BALL_LOG_SET_CATEGORY("CONCURRENCY");
+
+    barrier.wait();
+
+    for (int i = 0; i < k_MESSAGES_PER_THREAD; ++i) {
+        BALL_LOGSAMPLE_INFO(k_RATE) << "message " << i;
+    }
+}
+
+}  // close namespace Concurrency
+
+// ============================================================================
+//                               USAGE EXAMPLE
+// ----------------------------------------------------------------------------
+
+namespace Usage {
+
+///Example 1: Sampling the Messages of a Hot Code Path
+///- - - - - - - - - - - - - - - - - - - - - - - - - -
+// Suppose that we process a high volume of market data ticks, and that we
+// want to trace the processing of the ticks without flooding the log.
+//
+// First, we define a function that processes a tick, and traces, on average,
+// one in every 100 ticks that it processes:
+//..
+    void processTick(int tickId)
+    {
+        BALL_LOG_SET_CATEGORY("TICKS.PROCESSOR");
+
+        BALL_LOGSAMPLE_TRACE(100) << "Processing tick " << tickId;
+
+        // ...
+    }
+//..
+
+}  // close namespace Usage
+
+// ============================================================================
+//                              MAIN PROGRAM
+// ----------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    int test            = argc > 1 ? bsl::atoi(argv[1]) : 0;
+    verbose             = argc > 2;
+    veryVerbose         = argc > 3;
+    veryVeryVerbose     = argc > 4;
+    veryVeryVeryVerbose = argc > 5;
+
+    cout << "TEST " << __FILE__ << " CASE " << test << endl;
+
+    TestAllocator ta("test", veryVeryVeryVerbose);
+
+    switch (test) { case 0:  // Zero is always the leading case.
+      case 9: {
+        // --------------------------------------------------------------------
+        // USAGE EXAMPLE
+        //
+        // Concerns:
+        //: 1 The usage example provided in the component header file compiles,
+        //:   links, and runs as shown.
+        //
+        // Plan:
+        //: 1 Incorporate usage example from header into test driver, replace
+        //:   leading comment characters with spaces, replace 'assert' with
+        //:   'ASSERT', and insert 'if (veryVerbose)' before all output
+        //:   operations.  (C-1)
+        //
+        // Testing:
+        //   USAGE EXAMPLE
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << "USAGE EXAMPLE\n"
+                             "=============\n";
+
+        u::RecordCollector                            collector(&ta);
+        BloombergLP::ball::LoggerManagerConfiguration lmc;
+        BloombergLP::ball::LoggerManagerScopedGuard   lmg(&collector,
+                                                          lmc,
+                                                          &ta);
+
+        BloombergLP::ball::Administration::addCategory("TICKS.PROCESSOR",
+                                                       Sev::e_TRACE,
+                                                       Sev::e_TRACE,
+                                                       0,
+                                                       0);
+
+        const bsl::vector<Record>& records = collector.records();
+
+// Then, we process 100,000 ticks:
+//..
+    for (int i = 0; i < 100 * 1000; ++i) {
+        Usage::processTick(i);
+    }
+//..
+// Now, assuming that the records logged were collected by an observer in the
+// vector 'records', we observe that approximately 1,000 of the ticks were
+// traced:
+//..
+    ASSERT(  800 < records.size());
+    ASSERT(1200  > records.size());
+//..
+// Finally, we estimate the number of ticks processed from the sampling rate
+// recorded in the first user field of the records:
+//..
+    BloombergLP::bsls::Types::Int64 estimatedNumTicks = 0;
+    for (bsl::size_t i = 0; i < records.size(); ++i) {
+        estimatedNumTicks += records[i].customFields()[0].theInt64();
+    }
+    ASSERT( 80 * 1000 < estimatedNumTicks);
+    ASSERT(120 * 1000 > estimatedNumTicks);
+//..
+
+        if (veryVerbose) {
+            P_(records.size());    P(estimatedNumTicks);
+        }
+      } break;
+      case 8: {
+        // --------------------------------------------------------------------
+        // CONCURRENCY: MULTIPLE THREADS SHARING A SITE
+        //
+        // Concerns:
+        //: 1 Messages submitted to a site by multiple threads concurrently are
+        //:   sampled independently by each thread, with the rate of the site.
+        //:
+        //: 2 The sum of the rates recorded in the logged records estimates the
+        //:   number of messages submitted.
+        //
+        // Plan:
+        //: 1 Submit 'k_MESSAGES_PER_THREAD' messages to a single site having
+        //:   a rate of 'k_RATE' from each of 'k_NUM_THREADS' threads, and
+        //:   verify that the number of logged records, and the sum of their
+        //:   rates, are within 20% of their expected values.  (C-1..2)
+        //
+        // Testing:
+        //   CONCURRENCY: MULTIPLE THREADS SHARING A SITE
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << "CONCURRENCY: MULTIPLE THREADS SHARING A SITE\n"
+                             "============================================\n";
+
+        using namespace Concurrency;
+
+        u::RecordCollector                            collector(&ta);
+        BloombergLP::ball::LoggerManagerConfiguration lmc;
+        BloombergLP::ball::LoggerManagerScopedGuard   lmg(&collector,
+                                                          lmc,
+                                                          &ta);
+
+        BloombergLP::ball::Administration::addCategory("CONCURRENCY",
+                                                       Sev::e_INFO,
+                                                       Sev::e_INFO,
+                                                       0,
+                                                       0);
+
+        BloombergLP::bslmt::ThreadGroup threadGroup(&ta);
+        threadGroup.addThreads(&threadFunction, k_NUM_THREADS);
+        threadGroup.joinAll();
+
+        const int   NUM_MESSAGES = k_NUM_THREADS * k_MESSAGES_PER_THREAD;
+        const int   numRecords   = collector.numRecords();
+        const Int64 sumOfRates   = collector.sumOfRates();
+
+        if (veryVerbose) {
+            P_(numRecords);    P(sumOfRates);
+        }
+
+        ASSERTV(numRecords, NUM_MESSAGES / k_RATE * 8 / 10 < numRecords);
+        ASSERTV(numRecords, NUM_MESSAGES / k_RATE * 12 / 10 > numRecords);
+
+        ASSERTV(sumOfRates, NUM_MESSAGES * 8 / 10 < sumOfRates);
+        ASSERTV(sumOfRates, NUM_MESSAGES * 12 / 10 > sumOfRates);
+      } break;
+      case 7: {
+        // --------------------------------------------------------------------
+        // TESTING ADAPTIVE MACROS
+        //
+        // Concerns:
+        //: 1 An adaptive site logs every message until it logs more than its
+        //:   maximum number of messages per second.
+        //:
+        //: 2 An adaptive site that receives messages at a high rate raises its
+        //:   sampling rate, such that it logs far fewer messages than it
+        //:   receives, while the sum of the recorded rates still estimates
+        //:   the number of messages submitted.
+        //:
+        //: 3 Each adaptive macro logs with the severity indicated by its name
+        //:   or argument, and is a single statement.
+        //
+        // Plan:
+        //: 1 Submit a burst of messages to an adaptive site, and verify that
+        //:   the first 'MAX_RECORDS_PER_SECOND' records have a rate of 1, that
+        //:   the number of logged records is a small fraction of the number
+        //:   of messages, and that the sum of their rates is within 50% of
+        //:   the number of messages.  (C-1..2)
+        //:
+        //: 2 Invoke each of the adaptive macros once, in an 'if' statement
+        //:   having an 'else' clause, and verify the logged record.  (C-3)
+        //
+        // Testing:
+        //   BALL_LOGSAMPLEADAPTIVE_STREAM
+        //   BALL_LOGSAMPLEADAPTIVE_TRACE
+        //   BALL_LOGSAMPLEADAPTIVE_DEBUG
+        //   BALL_LOGSAMPLEADAPTIVE_INFO
+        //   BALL_LOGSAMPLEADAPTIVE_WARN
+        //   BALL_LOGSAMPLEADAPTIVE_ERROR
+        //   BALL_LOGSAMPLEADAPTIVE_FATAL
+        //   BALL_LOGSAMPLEADAPTIVE_BLOCK
+        //   BALL_LOGSAMPLEADAPTIVE_TRACE_BLOCK
+        //   BALL_LOGSAMPLEADAPTIVE_DEBUG_BLOCK
+        //   BALL_LOGSAMPLEADAPTIVE_INFO_BLOCK
+        //   BALL_LOGSAMPLEADAPTIVE_WARN_BLOCK
+        //   BALL_LOGSAMPLEADAPTIVE_ERROR_BLOCK
+        //   BALL_LOGSAMPLEADAPTIVE_FATAL_BLOCK
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << "TESTING ADAPTIVE MACROS\n"
+                             "=======================\n";
+
+        u::RecordCollector                            collector(&ta);
+        BloombergLP::ball::LoggerManagerConfiguration lmc;
+        BloombergLP::ball::LoggerManagerScopedGuard   lmg(&collector,
+                                                          lmc,
+                                                          &ta);
+
+        BloombergLP::ball::Administration::addCategory("sieve",
+                                                       Sev::e_TRACE,
+                                                       Sev::e_TRACE,
+                                                       0,
+                                                       0);
+        BALL_LOG_SET_CATEGORY("sieve");
+
+        if (verbose) cout << "\tTesting adaptation to a burst." << endl;
+        {
+            const int MAX_RECORDS_PER_SECOND = 100;
+            const int NUM_MESSAGES           = 5 * 1000 * 1000;
+
+            for (int i = 0; i < NUM_MESSAGES; ++i) {
+                BALL_LOGSAMPLEADAPTIVE_INFO(MAX_RECORDS_PER_SECOND) << i;
+            }
+
+            const bsl::vector<Record>& records    = collector.records();
+            const int                  numRecords = collector.numRecords();
+            const Int64                sumOfRates = collector.sumOfRates();
+
+            if (veryVerbose) {
+                P_(numRecords);    P(sumOfRates);
+            }
+
+            ASSERTV(numRecords, MAX_RECORDS_PER_SECOND < numRecords);
+            ASSERTV(numRecords, NUM_MESSAGES / 100 > numRecords);
+
+            for (int i = 0; i <= MAX_RECORDS_PER_SECOND && i < numRecords;
+                                                                        ++i) {
+                ASSERTV(i, 1 == records[i].customFields()[0].theInt64());
+            }
+            ASSERTV(records.back().customFields()[0].theInt64(),
+                    1 < records.back().customFields()[0].theInt64());
+
+            ASSERTV(sumOfRates, NUM_MESSAGES / 2 < sumOfRates);
+            ASSERTV(sumOfRates, NUM_MESSAGES * 3 / 2 > sumOfRates);
+        }
+
+        if (verbose) cout << "\tTesting each macro." << endl;
+        {
+            collector.reset();
+
+#define TEST_ADAPTIVE(SEVERITY, MACRO)                                        \
+            if (true) {                                                       \
+                MACRO << "adaptive";                                          \
+            }                                                                 \
+            else {                                                            \
+                MACRO << "never";                                             \
+            }                                                                 \
+            ASSERTV(#MACRO, 1 == collector.numRecords());                     \
+            ASSERTV(#MACRO, u::isRecordOkay(collector.records().back(),       \
+                                            (SEVERITY),                       \
+                                            1,                                \
+                                            "adaptive"));                     \
+            collector.reset();
+
+#define TEST_ADAPTIVE_BLOCK(SEVERITY, MACRO)                                  \
+            if (true)                                                         \
+                MACRO {                                                       \
+                    BALL_LOG_OUTPUT_STREAM << "adaptive";                     \
+                }                                                             \
+            else                                                              \
+                MACRO {                                                       \
+                    BALL_LOG_OUTPUT_STREAM << "never";                        \
+                }                                                             \
+            ASSERTV(#MACRO, 1 == collector.numRecords());                     \
+            ASSERTV(#MACRO, u::isRecordOkay(collector.records().back(),       \
+                                            (SEVERITY),                       \
+                                            1,                                \
+                                            "adaptive"));                     \
+            collector.reset();
+
+            int severity = Sev::e_WARN;
+
+            TEST_ADAPTIVE(Sev::e_WARN,
+                          BALL_LOGSAMPLEADAPTIVE_STREAM(severity, 10));
+            TEST_ADAPTIVE(Sev::e_TRACE, BALL_LOGSAMPLEADAPTIVE_TRACE(10));
+            TEST_ADAPTIVE(Sev::e_DEBUG, BALL_LOGSAMPLEADAPTIVE_DEBUG(10));
+            TEST_ADAPTIVE(Sev::e_INFO,  BALL_LOGSAMPLEADAPTIVE_INFO(10));
+            TEST_ADAPTIVE(Sev::e_WARN,  BALL_LOGSAMPLEADAPTIVE_WARN(10));
+            TEST_ADAPTIVE(Sev::e_ERROR, BALL_LOGSAMPLEADAPTIVE_ERROR(10));
+            TEST_ADAPTIVE(Sev::e_FATAL, BALL_LOGSAMPLEADAPTIVE_FATAL(10));
+
+            TEST_ADAPTIVE_BLOCK(Sev::e_WARN,
+                                BALL_LOGSAMPLEADAPTIVE_BLOCK(severity, 10));
+            TEST_ADAPTIVE_BLOCK(Sev::e_TRACE,
+                                BALL_LOGSAMPLEADAPTIVE_TRACE_BLOCK(10));
+            TEST_ADAPTIVE_BLOCK(Sev::e_DEBUG,
+                                BALL_LOGSAMPLEADAPTIVE_DEBUG_BLOCK(10));
+            TEST_ADAPTIVE_BLOCK(Sev::e_INFO,
+                                BALL_LOGSAMPLEADAPTIVE_INFO_BLOCK(10));
+            TEST_ADAPTIVE_BLOCK(Sev::e_WARN,
+                                BALL_LOGSAMPLEADAPTIVE_WARN_BLOCK(10));
+            TEST_ADAPTIVE_BLOCK(Sev::e_ERROR,
+                                BALL_LOGSAMPLEADAPTIVE_ERROR_BLOCK(10));
+            TEST_ADAPTIVE_BLOCK(Sev::e_FATAL,
+                                BALL_LOGSAMPLEADAPTIVE_FATAL_BLOCK(10));
+
+#undef TEST_ADAPTIVE
+#undef TEST_ADAPTIVE_BLOCK
+        }
+      } break;
+      case 6: {
+        // --------------------------------------------------------------------
+        // TESTING 'printf'-STYLE MACROS
+        //
+        // Concerns:
+        //: 1 Each macro logs approximately one in 'RATE' messages, with the
+        //:   severity indicated by its name or argument, and the formatted
+        //:   message.
+        //:
+        //: 2 Each logged record has the sampling rate as its only user field.
+        //:
+        //: 3 The arguments of the skipped messages are not evaluated.
+        //:
+        //: 4 No message is logged, and no argument is evaluated, if the
+        //:   severity is disabled.
+        //:
+        //: 5 Each use of a macro, terminated by a ';', is a single statement.
+        //
+        // Plan:
+        //: 1 For each macro, submit 'NUM_MESSAGES' messages in a loop, using
+        //:   an argument that counts its evaluations, and verify the number of
+        //:   records, their rates, the last record, and the number of
+        //:   evaluations.  (C-1..3)
+        //:
+        //: 2 Repeat P-1 for a disabled severity.  (C-4)
+        //:
+        //: 3 Invoke each macro in an 'if' statement having an 'else' clause.
+        //:   (C-5)
+        //
+        // Testing:
+        //   BALL_LOGSAMPLEVA
+        //   BALL_LOGSAMPLEVA_TRACE
+        //   BALL_LOGSAMPLEVA_DEBUG
+        //   BALL_LOGSAMPLEVA_INFO
+        //   BALL_LOGSAMPLEVA_WARN
+        //   BALL_LOGSAMPLEVA_ERROR
+        //   BALL_LOGSAMPLEVA_FATAL
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << "TESTING 'printf'-STYLE MACROS\n"
+                             "=============================\n";
+
+        u::RecordCollector                            collector(&ta);
+        BloombergLP::ball::LoggerManagerConfiguration lmc;
+        BloombergLP::ball::LoggerManagerScopedGuard   lmg(&collector,
+                                                          lmc,
+                                                          &ta);
+
+        BloombergLP::ball::Administration::addCategory("sieve",
+                                                       Sev::e_TRACE,
+                                                       Sev::e_TRACE,
+                                                       0,
+                                                       0);
+        BloombergLP::ball::Administration::addCategory("noTRACE",
+                                                       Sev::e_DEBUG,
+                                                       Sev::e_DEBUG,
+                                                       0,
+                                                       0);
+
+        const int RATE         = 10;
+        const int NUM_MESSAGES = 10 * 1000;
+
+#define TEST_VA(SEVERITY, MACRO_CALL)                                         \
+        {                                                                     \
+            collector.reset();                                                \
+            int count = 0;                                                    \
+            for (int i = 0; i < NUM_MESSAGES; ++i) {                          \
+                MACRO_CALL;                                                   \
+            }                                                                 \
+            ASSERTV(#MACRO_CALL,                                              \
+                    u::isRateOkay(collector, RATE, NUM_MESSAGES));            \
+            ASSERTV(#MACRO_CALL, count, collector.numRecords(),               \
+                    count == collector.numRecords());                         \
+            bsl::ostringstream expected;                                      \
+            expected << "message " << count;                                  \
+            ASSERTV(#MACRO_CALL, u::isRecordOkay(collector.records().back(),  \
+                                                 (SEVERITY),                  \
+                                                 RATE,                        \
+                                                 expected.str().c_str()));    \
+        }
+
+        {
+            BALL_LOG_SET_CATEGORY("sieve");
+
+            int severity = Sev::e_ERROR;
+
+            TEST_VA(Sev::e_ERROR,
+                    BALL_LOGSAMPLEVA(severity,
+                                     RATE,
+                                     "message %d",
+                                     u::increment(&count)));
+            TEST_VA(Sev::e_TRACE,
+                    BALL_LOGSAMPLEVA_TRACE(RATE,
+                                           "message %d",
+                                           u::increment(&count)));
+            TEST_VA(Sev::e_DEBUG,
+                    BALL_LOGSAMPLEVA_DEBUG(RATE,
+                                           "message %d",
+                                           u::increment(&count)));
+            TEST_VA(Sev::e_INFO,
+                    BALL_LOGSAMPLEVA_INFO(RATE,
+                                          "message %d",
+                                          u::increment(&count)));
+            TEST_VA(Sev::e_WARN,
+                    BALL_LOGSAMPLEVA_WARN(RATE,
+                                          "message %d",
+                                          u::increment(&count)));
+            TEST_VA(Sev::e_ERROR,
+                    BALL_LOGSAMPLEVA_ERROR(RATE,
+                                           "message %d",
+                                           u::increment(&count)));
+            TEST_VA(Sev::e_FATAL,
+                    BALL_LOGSAMPLEVA_FATAL(RATE,
+                                           "message %d",
+                                           u::increment(&count)));
+        }
+#undef TEST_VA
+
+        if (verbose) cout << "\tTesting a disabled severity." << endl;
+        {
+            BALL_LOG_SET_CATEGORY("noTRACE");
+
+            collector.reset();
+
+            int count    = 0;
+            int severity = Sev::e_TRACE;
+
+            for (int i = 0; i < NUM_MESSAGES; ++i) {
+                BALL_LOGSAMPLEVA_TRACE(1, "%d", u::increment(&count));
+                BALL_LOGSAMPLEVA(severity, 1, "%d", u::increment(&count));
+            }
+            ASSERTV(collector.numRecords(), 0 == collector.numRecords());
+            ASSERTV(count, 0 == count);
+        }
+
+        if (verbose) cout << "\tTesting single statements." << endl;
+        {
+            BALL_LOG_SET_CATEGORY("sieve");
+
+            collector.reset();
+
+            if (true)
+                BALL_LOGSAMPLEVA_INFO(1, "statement");
+            else
+                BALL_LOGSAMPLEVA_INFO(1, "never");
+
+            if (true)
+                BALL_LOGSAMPLEVA(Sev::e_INFO, 1, "statement");
+            else
+                BALL_LOGSAMPLEVA(Sev::e_INFO, 1, "never");
+
+            ASSERTV(collector.numRecords(), 2 == collector.numRecords());
+            ASSERT(u::isRecordOkay(collector.records().back(),
+                                   Sev::e_INFO,
+                                   1,
+                                   "statement"));
+        }
+      } break;
+      case 5: {
+        // --------------------------------------------------------------------
+        // TESTING BLOCK-STYLE MACROS
+        //
+        // Concerns:
+        //: 1 Each macro executes its block, and logs the resulting message,
+        //:   for approximately one in 'RATE' messages, with the severity
+        //:   indicated by its name or argument.
+        //:
+        //: 2 Each logged record has the sampling rate as its only user field.
+        //:
+        //: 3 The block is not executed if the message is skipped, or if the
+        //:   severity is disabled.
+        //:
+        //: 4 Each use of a macro is a single statement.
+        //
+        // Plan:
+        //: 1 For each macro, submit 'NUM_MESSAGES' messages in a loop, using a
+        //:   block that counts its executions, and verify the number of
+        //:   records, their rates, the last record, and the number of
+        //:   executions.  (C-1..3)
+        //:
+        //: 2 Repeat P-1 for a disabled severity.  (C-3)
+        //:
+        //: 3 Invoke each macro in an 'if' statement having an 'else' clause.
+        //:   (C-4)
+        //
+        // Testing:
+        //   BALL_LOGSAMPLE_BLOCK
+        //   BALL_LOGSAMPLE_TRACE_BLOCK
+        //   BALL_LOGSAMPLE_DEBUG_BLOCK
+        //   BALL_LOGSAMPLE_INFO_BLOCK
+        //   BALL_LOGSAMPLE_WARN_BLOCK
+        //   BALL_LOGSAMPLE_ERROR_BLOCK
+        //   BALL_LOGSAMPLE_FATAL_BLOCK
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << "TESTING BLOCK-STYLE MACROS\n"
+                             "==========================\n";
+
+        u::RecordCollector                            collector(&ta);
+        BloombergLP::ball::LoggerManagerConfiguration lmc;
+        BloombergLP::ball::LoggerManagerScopedGuard   lmg(&collector,
+                                                          lmc,
+                                                          &ta);
+
+        BloombergLP::ball::Administration::addCategory("sieve",
+                                                       Sev::e_TRACE,
+                                                       Sev::e_TRACE,
+                                                       0,
+                                                       0);
+        BloombergLP::ball::Administration::addCategory("noTRACE",
+                                                       Sev::e_DEBUG,
+                                                       Sev::e_DEBUG,
+                                                       0,
+                                                       0);
+
+        const int RATE         = 10;
+        const int NUM_MESSAGES = 10 * 1000;
+
+#define TEST_BLOCK(SEVERITY, MACRO)                                           \
+        {                                                                     \
+            collector.reset();                                                \
+            int count = 0;                                                    \
+            for (int i = 0; i < NUM_MESSAGES; ++i) {                          \
+                MACRO {                                                       \
+                    BALL_LOG_OUTPUT_STREAM << "message ";                     \
+                    BALL_LOG_OUTPUT_STREAM << u::increment(&count);           \
+                }                                                             \
+            }                                                                 \
+            ASSERTV(#MACRO, u::isRateOkay(collector, RATE, NUM_MESSAGES));    \
+            ASSERTV(#MACRO, count, collector.numRecords(),                    \
+                    count == collector.numRecords());                         \
+            bsl::ostringstream expected;                                      \
+            expected << "message " << count;                                  \
+            ASSERTV(#MACRO, u::isRecordOkay(collector.records().back(),       \
+                                            (SEVERITY),                       \
+                                            RATE,                             \
+                                            expected.str().c_str()));         \
+        }
+
+        {
+            BALL_LOG_SET_CATEGORY("sieve");
+
+            int severity = Sev::e_ERROR;
+
+            TEST_BLOCK(Sev::e_ERROR, BALL_LOGSAMPLE_BLOCK(severity, RATE));
+            TEST_BLOCK(Sev::e_TRACE, BALL_LOGSAMPLE_TRACE_BLOCK(RATE));
+            TEST_BLOCK(Sev::e_DEBUG, BALL_LOGSAMPLE_DEBUG_BLOCK(RATE));
+            TEST_BLOCK(Sev::e_INFO,  BALL_LOGSAMPLE_INFO_BLOCK(RATE));
+            TEST_BLOCK(Sev::e_WARN,  BALL_LOGSAMPLE_WARN_BLOCK(RATE));
+            TEST_BLOCK(Sev::e_ERROR, BALL_LOGSAMPLE_ERROR_BLOCK(RATE));
+            TEST_BLOCK(Sev::e_FATAL, BALL_LOGSAMPLE_FATAL_BLOCK(RATE));
+        }
+#undef TEST_BLOCK
+
+        if (verbose) cout << "\tTesting a disabled severity." << endl;
+        {
+            BALL_LOG_SET_CATEGORY("noTRACE");
+
+            collector.reset();
+
+            int count    = 0;
+            int severity = Sev::e_TRACE;
+
+            for (int i = 0; i < NUM_MESSAGES; ++i) {
+                BALL_LOGSAMPLE_TRACE_BLOCK(1) {
+                    u::increment(&count);
+                }
+                BALL_LOGSAMPLE_BLOCK(severity, 1) {
+                    u::increment(&count);
+                }
+            }
+            ASSERTV(collector.numRecords(), 0 == collector.numRecords());
+            ASSERTV(count, 0 == count);
+        }
+
+        if (verbose) cout << "\tTesting single statements." << endl;
+        {
+            BALL_LOG_SET_CATEGORY("sieve");
+
+            collector.reset();
+
+            if (true)
+                BALL_LOGSAMPLE_INFO_BLOCK(1) {
+                    BALL_LOG_OUTPUT_STREAM << "statement";
+                }
+            else
+                BALL_LOGSAMPLE_INFO_BLOCK(1) {
+                    BALL_LOG_OUTPUT_STREAM << "never";
+                }
+
+            if (true)
+                BALL_LOGSAMPLE_BLOCK(Sev::e_INFO, 1) {
+                    BALL_LOG_OUTPUT_STREAM << "statement";
+                }
+            else
+                BALL_LOGSAMPLE_BLOCK(Sev::e_INFO, 1) {
+                    BALL_LOG_OUTPUT_STREAM << "never";
+                }
+
+            ASSERTV(collector.numRecords(), 2 == collector.numRecords());
+            ASSERT(u::isRecordOkay(collector.records().back(),
+                                   Sev::e_INFO,
+                                   1,
+                                   "statement"));
+        }
+      } break;
+      case 4: {
+        // --------------------------------------------------------------------
+        // TESTING STREAM-STYLE MACROS
+        //
+        // Concerns:
+        //: 1 Each macro logs approximately one in 'RATE' messages, with the
+        //:   severity indicated by its name or argument, and the streamed
+        //:   message.
+        //:
+        //: 2 Each logged record has the sampling rate as its only user field.
+        //:
+        //: 3 The arguments of the skipped messages are not evaluated.
+        //:
+        //: 4 No message is logged, and no argument is evaluated, if the
+        //:   severity is disabled.
+        //:
+        //: 5 Distinct invocations of the macros sample independently.
+        //:
+        //: 6 Each use of a macro, terminated by a ';', is a single statement.
+        //
+        // Plan:
+        //: 1 For each macro, submit 'NUM_MESSAGES' messages in a loop, using
+        //:   an argument that counts its evaluations, and verify the number of
+        //:   records, their rates, the last record, and the number of
+        //:   evaluations.  Note that each macro is a distinct site, so that
+        //:   the first record of each is logged with a rate of 1.  (C-1..3, 5)
+        //:
+        //: 2 Repeat P-1 for a disabled severity.  (C-4)
+        //:
+        //: 3 Invoke each macro in an 'if' statement having an 'else' clause.
+        //:   (C-6)
+        //
+        // Testing:
+        //   BALL_LOGSAMPLE_STREAM
+        //   BALL_LOGSAMPLE_TRACE
+        //   BALL_LOGSAMPLE_DEBUG
+        //   BALL_LOGSAMPLE_INFO
+        //   BALL_LOGSAMPLE_WARN
+        //   BALL_LOGSAMPLE_ERROR
+        //   BALL_LOGSAMPLE_FATAL
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << "TESTING STREAM-STYLE MACROS\n"
+                             "===========================\n";
+
+        u::RecordCollector                            collector(&ta);
+        BloombergLP::ball::LoggerManagerConfiguration lmc;
+        BloombergLP::ball::LoggerManagerScopedGuard   lmg(&collector,
+                                                          lmc,
+                                                          &ta);
+
+        BloombergLP::ball::Administration::addCategory("sieve",
+                                                       Sev::e_TRACE,
+                                                       Sev::e_TRACE,
+                                                       0,
+                                                       0);
+        BloombergLP::ball::Administration::addCategory("noTRACE",
+                                                       Sev::e_DEBUG,
+                                                       Sev::e_DEBUG,
+                                                       0,
+                                                       0);
+
+        const int RATE         = 10;
+        const int NUM_MESSAGES = 10 * 1000;
+
+#define TEST_STREAM(SEVERITY, MACRO)                                          \
+        {                                                                     \
+            collector.reset();                                                \
+            int count = 0;                                                    \
+            for (int i = 0; i < NUM_MESSAGES; ++i) {                          \
+                MACRO << "message " << u::increment(&count);                  \
+            }                                                                 \
+            ASSERTV(#MACRO, u::isRateOkay(collector, RATE, NUM_MESSAGES));    \
+            ASSERTV(#MACRO, count, collector.numRecords(),                    \
+                    count == collector.numRecords());                         \
+            bsl::ostringstream expected;                                      \
+            expected << "message " << count;                                  \
+            ASSERTV(#MACRO, u::isRecordOkay(collector.records().back(),       \
+                                            (SEVERITY),                       \
+                                            RATE,                             \
+                                            expected.str().c_str()));         \
+        }
+
+        {
+            BALL_LOG_SET_CATEGORY("sieve");
+
+            int severity = Sev::e_ERROR;
+
+            TEST_STREAM(Sev::e_ERROR, BALL_LOGSAMPLE_STREAM(severity, RATE));
+            TEST_STREAM(Sev::e_TRACE, BALL_LOGSAMPLE_TRACE(RATE));
+            TEST_STREAM(Sev::e_DEBUG, BALL_LOGSAMPLE_DEBUG(RATE));
+            TEST_STREAM(Sev::e_INFO,  BALL_LOGSAMPLE_INFO(RATE));
+            TEST_STREAM(Sev::e_WARN,  BALL_LOGSAMPLE_WARN(RATE));
+            TEST_STREAM(Sev::e_ERROR, BALL_LOGSAMPLE_ERROR(RATE));
+            TEST_STREAM(Sev::e_FATAL, BALL_LOGSAMPLE_FATAL(RATE));
+        }
+#undef TEST_STREAM
+
+        if (verbose) cout << "\tTesting a disabled severity." << endl;
+        {
+            BALL_LOG_SET_CATEGORY("noTRACE");
+
+            collector.reset();
+
+            int count    = 0;
+            int severity = Sev::e_TRACE;
+
+            for (int i = 0; i < NUM_MESSAGES; ++i) {
+                BALL_LOGSAMPLE_TRACE(1) << u::increment(&count);
+                BALL_LOGSAMPLE_STREAM(severity, 1) << u::increment(&count);
+            }
+            ASSERTV(collector.numRecords(), 0 == collector.numRecords());
+            ASSERTV(count, 0 == count);
+        }
+
+        if (verbose) cout << "\tTesting single statements." << endl;
+        {
+            BALL_LOG_SET_CATEGORY("sieve");
+
+            collector.reset();
+
+            if (true)
+                BALL_LOGSAMPLE_INFO(1) << "statement";
+            else
+                BALL_LOGSAMPLE_INFO(1) << "never";
+
+            if (true)
+                BALL_LOGSAMPLE_STREAM(Sev::e_INFO, 1) << "statement";
+            else
+                BALL_LOGSAMPLE_STREAM(Sev::e_INFO, 1) << "never";
+
+            ASSERTV(collector.numRecords(), 2 == collector.numRecords());
+            ASSERT(u::isRecordOkay(collector.records().back(),
+                                   Sev::e_INFO,
+                                   1,
+                                   "statement"));
+        }
+      } break;
+      case 3: {
+        // --------------------------------------------------------------------
+        // TESTING RATE ADAPTATION
+        //
+        // Concerns:
+        //: 1 The rate of a site having a fixed rate never changes.
+        //:
+        //: 2 The rate of an adaptive site is not adjusted before the end of
+        //:   a period, unless the site logged more than its maximum number of
+        //:   messages per second.
+        //:
+        //: 3 At the end of a period, the rate of an adaptive site is set to
+        //:   the smallest rate that bounds the expected number of logged
+        //:   messages per second by the maximum of the site, and is never
+        //:   less than 1.
+        //
+        // Plan:
+        //: 1 Log many messages through a site having a fixed rate, and verify
+        //:   that its rate is unchanged.  (C-1)
+        //:
+        //: 2 Log messages through an adaptive site and verify that its rate is
+        //:   adjusted only once its maximum is exceeded.  (C-2)
+        //:
+        //: 3 Set the start of the current period of an adaptive site, and the
+        //:   number of messages logged in that period, to known values, log a
+        //:   message, and verify the adjusted rate.  (C-3)
+        //
+        // Testing:
+        //   bool isSampled(unsigned int *, unsigned int *, unsigned int *);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << "TESTING RATE ADAPTATION\n"
+                             "=======================\n";
+
+        typedef BloombergLP::bsls::AtomicOperations AtomicOps;
+
+        if (verbose) cout << "\tTesting a fixed rate." << endl;
+        {
+            Obj mX = BALL_LOGSAMPLE_SITE_INIT_IMP(3, 0);
+
+            unsigned int rate = 0, countdown = 0, threadRate = 1;
+
+            for (int i = 0; i < 100 * 1000; ++i) {
+                mX.isSampled(&rate, &countdown, &threadRate);
+            }
+            ASSERTV(mX.rate(), 3 == mX.rate());
+            ASSERTV(AtomicOps::getInt64(&mX.d_periodStart),
+                    0 == AtomicOps::getInt64(&mX.d_periodStart));
+        }
+
+        if (verbose) cout << "\tTesting early adjustment." << endl;
+        {
+            const int MAX = 50;
+
+            Obj mX = BALL_LOGSAMPLE_SITE_INIT_IMP(1, MAX);
+
+            unsigned int rate = 0, countdown = 0, threadRate = 1;
+
+            for (int i = 0; i < MAX; ++i) {
+                ASSERTV(i, mX.isSampled(&rate, &countdown, &threadRate));
+                ASSERTV(i, rate, 1 == rate);
+                ASSERTV(i, mX.rate(), 1 == mX.rate());
+            }
+
+            // Log messages until the rate is adjusted.  All the messages are
+            // logged in much less than one second.
+
+            ASSERT(mX.isSampled(&rate, &countdown, &threadRate));
+            ASSERTV(mX.rate(), 1 < mX.rate());
+            ASSERTV(mX.rate(), threadRate, mX.rate() == (int)threadRate);
+        }
+
+        if (verbose) cout << "\tTesting adjustment at the end of a period."
+                          << endl;
+        {
+            static const struct {
+                int d_line;         // source line number
+                int d_rate;         // rate before adjustment
+                int d_numSampled;   // messages logged in the period
+                int d_seconds;      // duration of the period
+                int d_max;          // maximum records per second
+                int d_expRate;      // expected rate after adjustment
+            } DATA[] = {
+                //LINE  RATE  NUM  SECONDS   MAX   EXP
+                //----  ----  ---  -------  ----  ----
+                { L_,      1,   9,       2,   10,    1 },
+                { L_,      1,  39,       2,   10,    2 },
+                { L_,     10,  99,      10,   10,   10 },
+                { L_,     10,  99,     100,   10,    1 },
+                { L_,    100,  49,       5,   10,  100 },
+                { L_,    100, 199,       2,    1, 10000 },
+            };
+            const int NUM_DATA = sizeof DATA / sizeof *DATA;
+
+            for (int ti = 0; ti < NUM_DATA; ++ti) {
+                const int LINE        = DATA[ti].d_line;
+                const int RATE        = DATA[ti].d_rate;
+                const int NUM_SAMPLED = DATA[ti].d_numSampled;
+                const int SECONDS     = DATA[ti].d_seconds;
+                const int MAX         = DATA[ti].d_max;
+                const int EXP_RATE    = DATA[ti].d_expRate;
+
+                Obj mX = BALL_LOGSAMPLE_SITE_INIT_IMP(RATE, MAX);
+
+                // Backdate the start of the period, accounting for the
+                // message logged by 'isSampled'.  The adjustment is
+                // approximate, as the period is slightly longer than
+                // 'SECONDS'.
+
+                const Int64 now = BloombergLP::bsls::SystemTime::
+                                      nowMonotonicClock().totalNanoseconds();
+                AtomicOps::setInt64(&mX.d_periodStart,
+                                    now - SECONDS * 1000LL * 1000 * 1000);
+                AtomicOps::setInt(&mX.d_numSampledInPeriod, NUM_SAMPLED);
+
+                unsigned int rate = 0, countdown = 0, threadRate = RATE;
+
+                ASSERTV(LINE, mX.isSampled(&rate, &countdown, &threadRate));
+                ASSERTV(LINE, rate, RATE == (int)rate);
+                ASSERTV(LINE, EXP_RATE, mX.rate(), EXP_RATE == mX.rate());
+                ASSERTV(LINE, threadRate, EXP_RATE == (int)threadRate);
+                ASSERTV(LINE,
+                        0 == AtomicOps::getInt(&mX.d_numSampledInPeriod));
+            }
+        }
+      } break;
+      case 2: {
+        // --------------------------------------------------------------------
+        // TESTING 'numToSkip'
+        //
+        // Concerns:
+        //: 1 'numToSkip(1)' is always 0.
+        //:
+        //: 2 The numbers returned by 'numToSkip(rate)' follow a geometric
+        //:   distribution whose mean is 'rate - 1'.
+        //:
+        //: 3 'numToSkip' does not overflow for the largest rates.
+        //
+        // Plan:
+        //: 1 Call 'numToSkip(1)' many times, and verify the result.  (C-1)
+        //:
+        //: 2 For a set of rates, draw many numbers, and verify that their mean
+        //:   is within 5% of 'rate - 1', and that the fraction of the numbers
+        //:   equal to 0 is within 10% of '1 / rate'.  (C-2)
+        //:
+        //: 3 Call 'numToSkip(k_MAX_RATE)' many times, and verify that the
+        //:   mean of the results is within 5% of 'k_MAX_RATE'.  (C-3)
+        //
+        // Testing:
+        //   unsigned int numToSkip(int rate);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << "TESTING 'numToSkip'\n"
+                             "===================\n";
+
+        for (int i = 0; i < 1000; ++i) {
+            ASSERTV(i, 0 == Obj::numToSkip(1));
+        }
+
+        const int RATES[]   = { 2, 3, 10, 100, 1000 };
+        const int NUM_RATES = sizeof RATES / sizeof *RATES;
+
+        for (int ti = 0; ti < NUM_RATES; ++ti) {
+            const int RATE      = RATES[ti];
+            const int NUM_DRAWS = 1000 * RATE < 200 * 1000
+                                  ? 200 * 1000
+                                  : 1000 * RATE;
+
+            double sum     = 0;
+            int    numZero = 0;
+            for (int i = 0; i < NUM_DRAWS; ++i) {
+                const unsigned int n = Obj::numToSkip(RATE);
+                sum += n;
+                numZero += 0 == n;
+            }
+            const double mean         = sum / NUM_DRAWS;
+            const double zeroFraction = static_cast<double>(numZero)
+                                                                   / NUM_DRAWS;
+
+            if (veryVerbose) {
+                P_(RATE);    P_(mean);    P(zeroFraction);
+            }
+
+            ASSERTV(RATE, mean, (RATE - 1) * 0.95 <= mean);
+            ASSERTV(RATE, mean, (RATE - 1) * 1.05 >= mean);
+            ASSERTV(RATE, zeroFraction, 0.9 / RATE <= zeroFraction);
+            ASSERTV(RATE, zeroFraction, 1.1 / RATE >= zeroFraction);
+        }
+
+        {
+            const int NUM_DRAWS = 10 * 1000;
+
+            double sum = 0;
+            for (int i = 0; i < NUM_DRAWS; ++i) {
+                sum += Obj::numToSkip(Obj::k_MAX_RATE);
+            }
+            const double mean = sum / NUM_DRAWS;
+
+            if (veryVerbose) { P(mean); }
+
+            ASSERTV(mean, Obj::k_MAX_RATE * 0.95 <= mean);
+            ASSERTV(mean, Obj::k_MAX_RATE * 1.05 >= mean);
+        }
+      } break;
+      case 1: {
+        // --------------------------------------------------------------------
+        // BREATHING TEST
+        //
+        // Concerns:
+        //: 1 The class is sufficiently functional to enable comprehensive
+        //:   testing in subsequent test cases.
+        //
+        // Plan:
+        //: 1 Create sites having a fixed rate and sample messages through
+        //:   them, using both thread-local and shared counters, and verify
+        //:   that the first message is selected with a rate of 1, and that
+        //:   approximately one in 'RATE' messages is subsequently selected
+        //:   with a rate of 'RATE'.  (C-1)
+        //
+        // Testing:
+        //   BREATHING TEST
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << "BREATHING TEST\n"
+                             "==============\n";
+
+        const int RATE         = 4;
+        const int NUM_MESSAGES = 40 * 1000;
+
+        if (verbose) cout << "\tTesting 'isSampled'." << endl;
+        {
+            Obj mX = BALL_LOGSAMPLE_SITE_INIT_IMP(RATE, 0);  const Obj& X = mX;
+
+            ASSERT(RATE == X.rate());
+
+            unsigned int rate = 0, countdown = 0, threadRate = 1;
+
+            ASSERT(mX.isSampled(&rate, &countdown, &threadRate));
+            ASSERTV(rate, 1 == rate);
+            ASSERTV(threadRate, RATE == (int)threadRate);
+
+            int numSampled = 0;
+            for (int i = 0; i < NUM_MESSAGES; ++i) {
+                rate = 0;
+                if (mX.isSampled(&rate, &countdown, &threadRate)) {
+                    ++numSampled;
+                    ASSERTV(i, rate, RATE == (int)rate);
+                }
+                else {
+                    ASSERTV(i, rate, 0 == rate);
+                }
+            }
+
+            if (veryVerbose) { P(numSampled); }
+
+            ASSERTV(numSampled, NUM_MESSAGES / RATE * 9 / 10 < numSampled);
+            ASSERTV(numSampled, NUM_MESSAGES / RATE * 11 / 10 > numSampled);
+            ASSERT(RATE == X.rate());
+        }
+
+        if (verbose) cout << "\tTesting 'isSampledShared'." << endl;
+        {
+            Obj mX = BALL_LOGSAMPLE_SITE_INIT_IMP(RATE, 0);  const Obj& X = mX;
+
+            unsigned int rate = 0;
+
+            ASSERT(mX.isSampledShared(&rate));
+            ASSERTV(rate, RATE == (int)rate);
+
+            int numSampled = 0;
+            for (int i = 0; i < NUM_MESSAGES; ++i) {
+                rate = 0;
+                if (mX.isSampledShared(&rate)) {
+                    ++numSampled;
+                    ASSERTV(i, rate, RATE == (int)rate);
+                }
+            }
+
+            if (veryVerbose) { P(numSampled); }
+
+            ASSERTV(numSampled, NUM_MESSAGES / RATE * 9 / 10 < numSampled);
+            ASSERTV(numSampled, NUM_MESSAGES / RATE * 11 / 10 > numSampled);
+            ASSERT(RATE == X.rate());
+        }
+      } break;
+      case -1: {
+        // --------------------------------------------------------------------
+        // PERFORMANCE: COST OF A SKIPPED MESSAGE
+        //
+        // Concerns:
+        //: 1 A message skipped by a sampling macro costs little more than a
+        //:   message whose severity is disabled.
+        //
+        // Plan:
+        //: 1 Time a loop submitting messages to a sampling macro having a high
+        //:   rate, to a sampling macro whose severity is disabled, and to a
+        //:   'ball_log' macro whose severity is disabled, and report the
+        //:   average time per message.  (C-1)
+        //
+        // Testing:
+        //   PERFORMANCE: COST OF A SKIPPED MESSAGE
+        // --------------------------------------------------------------------
+
+        cout << "PERFORMANCE: COST OF A SKIPPED MESSAGE\n"
+                "======================================\n";
+
+        u::RecordCollector                            collector(&ta);
+        BloombergLP::ball::LoggerManagerConfiguration lmc;
+        BloombergLP::ball::LoggerManagerScopedGuard   lmg(&collector,
+                                                          lmc,
+                                                          &ta);
+
+        BloombergLP::ball::Administration::addCategory("PERF",
+                                                       Sev::e_DEBUG,
+                                                       Sev::e_DEBUG,
+                                                       0,
+                                                       0);
+        BALL_LOG_SET_CATEGORY("PERF");
+
+        const int NUM_MESSAGES = argc > 2 ? bsl::atoi(argv[2])
+                                          : 100 * 1000 * 1000;
+
+        BloombergLP::bsls::Stopwatch timer;
+
+        timer.start();
+        for (int i = 0; i < NUM_MESSAGES; ++i) {
+            BALL_LOGSAMPLE_DEBUG(1000 * 1000) << i;
+        }
+        timer.stop();
+        cout << "Sampled (1 in 1,000,000): "
+             << timer.elapsedTime() * 1e9 / NUM_MESSAGES << " ns/message ("
+             << collector.numRecords() << " records)" << endl;
+
+        timer.reset();
+        timer.start();
+        for (int i = 0; i < NUM_MESSAGES; ++i) {
+            BALL_LOGSAMPLE_TRACE(1000 * 1000) << i;
+        }
+        timer.stop();
+        cout << "Sampled (disabled):       "
+             << timer.elapsedTime() * 1e9 / NUM_MESSAGES << " ns/message"
+             << endl;
+
+        timer.reset();
+        timer.start();
+        for (int i = 0; i < NUM_MESSAGES; ++i) {
+            BALL_LOG_TRACE << i;
+        }
+        timer.stop();
+        cout << "BALL_LOG_TRACE (disabled): "
+             << timer.elapsedTime() * 1e9 / NUM_MESSAGES << " ns/message"
+             << endl;
+      } break;
+      default: {
+        cerr << "WARNING: CASE `" << test << "' NOT FOUND." << endl;
+        testStatus = -1;
+      }
+    }
+
+    if (testStatus > 0) {
+        cerr << "Error, non-zero test status = " << testStatus << "." << endl;
+    }
+    return testStatus;
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2020 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
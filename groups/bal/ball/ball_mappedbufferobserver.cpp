@@ -0,0 +1,412 @@
+// ball_mappedbufferobserver.cpp                                      -*-C++-*-
+#include <ball_mappedbufferobserver.h>
+
+#include <bsls_ident.h>
+BSLS_IDENT_RCSID(ball_mappedbufferobserver_cpp,"$Id$ $CSID$")
+
+#include <ball_binaryrecordutil.h>
+#include <ball_record.h>
+#include <ball_recordstringformatter.h>
+
+#include <bdls_filesystemutil.h>
+#include <bdls_memoryutil.h>
+#include <bdls_processutil.h>
+
+#include <bslmf_assert.h>
+
+#include <bslmt_lockguard.h>
+
+#include <bsls_assert.h>
+#include <bsls_atomicoperations.h>
+
+#include <bsl_algorithm.h>
+#include <bsl_cstring.h>
+#include <bsl_fstream.h>
+#include <bsl_sstream.h>
+
+// ============================================================================
+//                           IMPLEMENTATION NOTES
+// ----------------------------------------------------------------------------
+//
+// The header of a buffer file is accessed through the 'Header' structure,
+// whose layout is that documented in {Buffer File Format}.  The writer holds
+// 'd_mutex' while writing a frame, so 'reservedEnd' and 'committedEnd' are
+// equal whenever the mutex is not held.  Writing a frame proceeds as follows:
+//
+//: 1 'reservedEnd' is advanced past the frame using a sequentially consistent
+//:   store, so that it is stored to the mapping before any byte of the frame.
+//:
+//: 2 The frame is copied into the buffer (in two parts if it wraps around the
+//:   end of the buffer).
+//:
+//: 3 'numRecords' and 'committedEnd' are advanced, the latter using a release
+//:   store, so that it is stored to the mapping after every byte of the frame.
+//
+// Should the process terminate in the middle of these steps, the stores that
+// it performed are held in the page cache of the operating system in program
+// order, and the reader finds the frames that were entirely written in the
+// stream offsets '[max(0, reservedEnd - capacity) .. committedEnd)'.
+//
+// The reader does not know the offset at which the first entire frame in the
+// buffer starts once the buffer has wrapped around.  It tries each offset at
+// which a frame can be decoded, and chooses the first from which consecutive
+// frames can be decoded up to the end of the buffer.  The magic bytes and the
+// length of each frame make a false match extremely unlikely.
+// ----------------------------------------------------------------------------
+
+namespace BloombergLP {
+namespace ball {
+
+namespace {
+
+typedef bsls::AtomicOperations AtomicOps;
+
+const char         k_MAGIC[8]        = { 'B', 'A', 'L', 'L',
+                                         'M', 'B', 'U', 'F' };
+const unsigned int k_BYTE_ORDER_MARK = 0x01020304;
+
+struct Header {
+    // This 'struct' describes the header of a buffer file (see {Buffer File
+    // Format}).
+
+    // DATA
+    char                             d_magic[8];
+    unsigned int                     d_version;
+    unsigned int                     d_byteOrderMark;
+    bsls::Types::Uint64              d_capacity;
+    AtomicOps::AtomicTypes::Uint64   d_reservedEnd;
+    AtomicOps::AtomicTypes::Uint64   d_committedEnd;
+    AtomicOps::AtomicTypes::Uint64   d_numRecords;
+    int                              d_processId;
+    char                             d_unused[12];
+};
+
+BSLMF_ASSERT(sizeof(Header) == MappedBufferObserver::k_HEADER_SIZE);
+
+bool isChainComplete(const char *data, bsl::size_t length, Record *scratch)
+    // Return 'true' if the specified 'data' of the specified 'length' consists
+    // of consecutive well-formed frames, and 'false' otherwise.  Use the
+    // specified 'scratch' record to decode the frames.
+{
+    bsl::size_t offset = 0;
+    while (offset < length) {
+        int frameLength;
+        if (0 != BinaryRecordUtil::decode(scratch,
+                                          &frameLength,
+                                          data + offset,
+                                          length - offset)) {
+            return false;                                             // RETURN
+        }
+        offset += frameLength;
+    }
+    return true;
+}
+
+bsl::size_t findFirstFrame(const bsl::string& frames)
+    // Return the offset of the first entire frame in the specified 'frames',
+    // whose first frame may have been partially overwritten, or the length of
+    // 'frames' if no frame is found.
+{
+    Record      scratch;
+    bsl::size_t firstDecodable = frames.length();
+
+    for (bsl::size_t offset = 0; offset < frames.length(); ++offset) {
+        int frameLength;
+        if (0 != BinaryRecordUtil::decode(&scratch,
+                                          &frameLength,
+                                          frames.data() + offset,
+                                          frames.length() - offset)) {
+            continue;
+        }
+        if (isChainComplete(frames.data() + offset,
+                            frames.length() - offset,
+                            &scratch)) {
+            return offset;                                            // RETURN
+        }
+        if (firstDecodable == frames.length()) {
+            firstDecodable = offset;
+        }
+    }
+    return firstDecodable;
+}
+
+}  // close unnamed namespace
+
+                         // --------------------------
+                         // class MappedBufferObserver
+                         // --------------------------
+
+// CLASS METHODS
+int MappedBufferObserver::loadFrames(bsl::string *frames,
+                                     const char  *fileName)
+{
+    BSLS_ASSERT(frames);
+    BSLS_ASSERT(fileName);
+
+    frames->clear();
+
+    bsl::ifstream file(fileName, bsl::ios_base::in | bsl::ios_base::binary);
+    if (!file.is_open()) {
+        return -1;                                                    // RETURN
+    }
+
+    Header header;
+    if (!file.read(reinterpret_cast<char *>(&header), sizeof header)) {
+        return -2;                                                    // RETURN
+    }
+
+    if (0 != bsl::memcmp(header.d_magic, k_MAGIC, sizeof k_MAGIC)
+     || k_FORMAT_VERSION  != header.d_version
+     || k_BYTE_ORDER_MARK != header.d_byteOrderMark
+     || 0                 == header.d_capacity) {
+        return -3;                                                    // RETURN
+    }
+
+    const bsls::Types::Uint64 capacity  = header.d_capacity;
+    const bsls::Types::Uint64 reserved  =
+                            AtomicOps::getUint64Relaxed(&header.d_reservedEnd);
+    const bsls::Types::Uint64 committed =
+                           AtomicOps::getUint64Relaxed(&header.d_committedEnd);
+
+    if (committed > reserved || reserved - committed > capacity) {
+        return -4;                                                    // RETURN
+    }
+
+    bsl::string buffer;
+    buffer.resize(static_cast<bsl::size_t>(capacity));
+    if (!file.read(&buffer[0], static_cast<bsl::streamsize>(capacity))) {
+        return -5;                                                    // RETURN
+    }
+
+    // Copy the stream offsets '[begin .. committed)' in order.
+
+    bsls::Types::Uint64 begin = reserved > capacity ? reserved - capacity : 0;
+    if (begin > committed) {
+        begin = committed;
+    }
+
+    const bsl::size_t length = static_cast<bsl::size_t>(committed - begin);
+    const bsl::size_t start  = static_cast<bsl::size_t>(begin % capacity);
+    const bsl::size_t first  = bsl::min(length,
+                                        static_cast<bsl::size_t>(capacity)
+                                                                     - start);
+
+    frames->reserve(length);
+    frames->append(buffer, start, first);
+    frames->append(buffer, 0, length - first);
+
+    if (0 < begin) {
+        // The buffer has wrapped around: skip the partially overwritten
+        // frame.
+
+        frames->erase(0, findFirstFrame(*frames));
+    }
+    return 0;
+}
+
+int MappedBufferObserver::renderFile(bsl::ostream&                textStream,
+                                     const char                  *fileName,
+                                     const RecordStringFormatter& formatter,
+                                     int                         *numRecords)
+{
+    BSLS_ASSERT(fileName);
+
+    bsl::string frames;
+    if (0 != loadFrames(&frames, fileName)) {
+        if (numRecords) {
+            *numRecords = 0;
+        }
+        return -1;                                                    // RETURN
+    }
+
+    bsl::istringstream input(frames);
+    return BinaryRecordUtil::render(textStream, input, formatter, numRecords);
+}
+
+// CREATORS
+MappedBufferObserver::MappedBufferObserver(bslma::Allocator *basicAllocator)
+: d_mapping_p(0)
+, d_capacity(0)
+, d_fileName(basicAllocator)
+, d_frame(basicAllocator)
+, d_numDropped(0)
+{
+}
+
+MappedBufferObserver::~MappedBufferObserver()
+{
+    close();
+}
+
+// MANIPULATORS
+void MappedBufferObserver::close()
+{
+    bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+
+    if (!d_mapping_p) {
+        return;                                                       // RETURN
+    }
+
+    int rc = bdls::FilesystemUtil::unmap(
+                         d_mapping_p,
+                         static_cast<bsl::size_t>(k_HEADER_SIZE + d_capacity));
+    BSLS_ASSERT(0 == rc);
+    (void)rc;
+
+    d_mapping_p = 0;
+    d_capacity  = 0;
+    d_fileName.clear();
+}
+
+int MappedBufferObserver::open(const char         *fileName,
+                               bsls::Types::Int64  capacity)
+{
+    BSLS_ASSERT(fileName);
+    BSLS_ASSERT(0 < capacity);
+
+    typedef bdls::FilesystemUtil Util;
+
+    bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+
+    if (d_mapping_p) {
+        return 1;                                                     // RETURN
+    }
+
+    Util::FileDescriptor fd = Util::open(fileName,
+                                         Util::e_OPEN_OR_CREATE,
+                                         Util::e_READ_WRITE,
+                                         Util::e_TRUNCATE);
+    if (Util::k_INVALID_FD == fd) {
+        return -1;                                                    // RETURN
+    }
+
+    const bsls::Types::Int64 size = k_HEADER_SIZE + capacity;
+
+    // Preallocate the file so that writing to the mapping cannot fail for
+    // lack of disk space.
+
+    void *address = 0;
+    if (0 != Util::growFile(fd, size, true)
+     || 0 != Util::map(fd,
+                       &address,
+                       0,
+                       static_cast<bsl::size_t>(size),
+                       bdls::MemoryUtil::k_ACCESS_READ_WRITE)) {
+        Util::close(fd);
+        return -2;                                                    // RETURN
+    }
+
+    // The mapping remains valid after the file descriptor is closed.
+
+    Util::close(fd);
+
+    Header *header = reinterpret_cast<Header *>(address);
+    bsl::memset(header, 0, sizeof *header);
+    bsl::memcpy(header->d_magic, k_MAGIC, sizeof k_MAGIC);
+    header->d_version       = k_FORMAT_VERSION;
+    header->d_byteOrderMark = k_BYTE_ORDER_MARK;
+    header->d_capacity      = capacity;
+    header->d_processId     = bdls::ProcessUtil::getProcessId();
+    AtomicOps::setUint64Release(&header->d_committedEnd, 0);
+
+    d_mapping_p = static_cast<char *>(address);
+    d_capacity  = capacity;
+    d_fileName  = fileName;
+    return 0;
+}
+
+void MappedBufferObserver::publish(const bsl::shared_ptr<const Record>& record,
+                                   const Context&)
+{
+    BSLS_ASSERT(record);
+
+    bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+
+    if (!d_mapping_p) {
+        return;                                                       // RETURN
+    }
+
+    d_frame.clear();
+    BinaryRecordUtil::encode(&d_frame, *record);
+
+    const bsl::size_t length = d_frame.length();
+    if (length > d_capacity) {
+        d_numDropped.addRelaxed(1);
+        return;                                                       // RETURN
+    }
+
+    Header     *header = reinterpret_cast<Header *>(d_mapping_p);
+    char *const buffer = d_mapping_p + k_HEADER_SIZE;
+
+    const bsls::Types::Uint64 end    =
+                          AtomicOps::getUint64Relaxed(&header->d_committedEnd);
+    const bsls::Types::Uint64 newEnd = end + length;
+
+    AtomicOps::setUint64(&header->d_reservedEnd, newEnd);
+
+    const bsl::size_t start = static_cast<bsl::size_t>(end % d_capacity);
+    const bsl::size_t first = bsl::min(
+                                 length,
+                                 static_cast<bsl::size_t>(d_capacity) - start);
+
+    bsl::memcpy(buffer + start, d_frame.data(), first);
+    bsl::memcpy(buffer, d_frame.data() + first, length - first);
+
+    AtomicOps::setUint64Relaxed(
+                       &header->d_numRecords,
+                       AtomicOps::getUint64Relaxed(&header->d_numRecords) + 1);
+    AtomicOps::setUint64Release(&header->d_committedEnd, newEnd);
+}
+
+// ACCESSORS
+bsls::Types::Int64 MappedBufferObserver::capacity() const
+{
+    bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+
+    return d_capacity;
+}
+
+bsl::string MappedBufferObserver::fileName() const
+{
+    bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+
+    return d_fileName;
+}
+
+bool MappedBufferObserver::isOpen() const
+{
+    bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+
+    return 0 != d_mapping_p;
+}
+
+bsls::Types::Int64 MappedBufferObserver::numRecordsPublished() const
+{
+    bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+
+    if (!d_mapping_p) {
+        return 0;                                                     // RETURN
+    }
+
+    const Header *header = reinterpret_cast<const Header *>(d_mapping_p);
+    return AtomicOps::getUint64Relaxed(&header->d_numRecords);
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+// ----------------------------------------------------------------------------
+// Copyright 2020 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,378 @@
+// ball_mappedbufferobserver.h                                        -*-C++-*-
+#ifndef INCLUDED_BALL_MAPPEDBUFFEROBSERVER
+#define INCLUDED_BALL_MAPPEDBUFFEROBSERVER
+
+#include <bsls_ident.h>
+BSLS_IDENT("$Id: $")
+
+//@PURPOSE: Provide an observer logging to a memory-mapped circular buffer.
+//
+//@CLASSES:
+//  ball::MappedBufferObserver: observer writing records to a mapped file
+//
+//@SEE_ALSO: ball_binaryrecordutil, ball_binaryfileobserver, ball_observer
+//
+//@DESCRIPTION: This component provides a concrete implementation of the
+// 'ball::Observer' protocol, 'ball::MappedBufferObserver', that writes the
+// records it receives, in the binary format defined by
+// 'ball_binaryrecordutil', to a fixed-size circular buffer held in a
+// memory-mapped file.  The most recent records published to the observer
+// survive an abnormal termination of the process (e.g., a crash, or a
+// 'SIGKILL'), and can be rendered as text by an offline tool after the fact.
+// The following inheritance hierarchy diagram shows the classes involved and
+// their methods:
+//..
+//             ,--------------------------.
+//            ( ball::MappedBufferObserver )
+//             `--------------------------'
+//                         |              ctor
+//                         |              close
+//                         |              open
+//                         |              capacity
+//                         |              fileName
+//                         |              isOpen
+//                         |              numRecordsDropped
+//                         |              numRecordsPublished
+//                         |              loadFrames
+//                         |              renderFile
+//                         V
+//                  ,--------------.
+//                 ( ball::Observer )
+//                  `--------------'
+//                                        dtor
+//                                        publish
+//                                        releaseRecords
+//..
+// A 'ball::MappedBufferObserver' is intended to hold a "post-mortem" trace of
+// the activity of a process: typically, it is registered (e.g., using a
+// 'ball::BroadcastObserver') alongside an observer writing to a regular log
+// file, and is configured to receive records of every severity (e.g., 'TRACE'
+// records that would be too costly to write to the log file), so that the
+// detailed history preceding a crash can be examined.
+//
+///Cost of Publication
+///-------------------
+// Publishing a record encodes it (see 'ball::BinaryRecordUtil::encode') and
+// copies the encoded frame into the mapped memory.  No system call is made:
+// the operating system writes the modified pages of the mapping back to the
+// file asynchronously, as it does for any shared file mapping, and keeps them
+// in its page cache should the process terminate.  Publication is therefore
+// considerably cheaper than writing a record to a file with
+// 'ball::FileObserver' or 'ball::BinaryFileObserver', and its cost does not
+// depend on the performance of the file system.  Note that the buffer file
+// does not survive a failure of the operating system (or of the machine)
+// unless its pages have been written back to disk before the failure.
+//
+///Buffer File Format
+///------------------
+// A buffer file consists of a header of 'k_HEADER_SIZE' (64) bytes, followed
+// by the circular buffer of frames, whose size in bytes is the "capacity"
+// supplied to 'open'.  The header has the following layout (the integers of
+// the header are stored in the byte order of the platform that wrote the
+// file, which is recorded by the byte order mark):
+//..
+//  +--------+---------------+--------------------------------------------+
+//  | Offset | Field         | Description                                |
+//  +========+===============+============================================+
+//  |      0 | magic         | the 8 characters "BALLMBUF"                |
+//  |      8 | version       | uint32: 'k_FORMAT_VERSION'                 |
+//  |     12 | byteOrderMark | uint32: 0x01020304                         |
+//  |     16 | capacity      | uint64: number of bytes in the buffer      |
+//  |     24 | reservedEnd   | uint64: end offset of the frames written   |
+//  |        |               | or being written                           |
+//  |     32 | committedEnd  | uint64: end offset of the frames written   |
+//  |     40 | numRecords    | uint64: number of frames written           |
+//  |     48 | processID     | int32: process ID of the writer            |
+//  |     52 | (unused)      | 12 bytes of zeros                          |
+//  +--------+---------------+--------------------------------------------+
+//..
+// Frames are written one after another as though to an unbounded stream; a
+// frame starting at the stream offset 'n' is held at the offset
+// 'n % capacity' of the buffer, and continues at the start of the buffer if it
+// does not fit before its end.  Before writing a frame, the writer advances
+// 'reservedEnd' past the frame, and once the frame is entirely written it
+// advances 'committedEnd' to 'reservedEnd'.  The stream offsets
+// '[max(0, reservedEnd - capacity) .. committedEnd)' therefore hold frames
+// that were entirely written (even if the writer was terminated in the middle
+// of writing a frame), the first of which may have been partially overwritten
+// (i.e., the buffer may begin in the middle of a frame).  A record whose
+// frame is longer than the capacity of the buffer is not written, and is
+// counted by 'numRecordsDropped'.
+//
+///Reading a Buffer File
+///---------------------
+// The 'loadFrames' class method loads the frames held in a buffer file, in
+// the order in which they were written, skipping the partially overwritten
+// frame at the start of the buffer (if any).  The loaded frames may be
+// decoded using 'ball::BinaryRecordUtil::decode', or rendered as text using
+// 'ball::BinaryRecordUtil::render'.  The 'renderFile' class method renders the
+// frames held in a buffer file as text using a 'ball::RecordStringFormatter'
+// (and therefore any of the format specifications that can be supplied to
+// 'ball::FileObserver::setLogFormat'), and is suitable for implementing an
+// offline tool.  Note that a buffer file should be read only once the
+// observer writing to it has been closed (or the process holding the
+// observer has terminated); the result of reading a buffer file that is
+// being written is unspecified (but does not have undefined behavior).
+//
+///Thread Safety
+///-------------
+// All methods of 'ball::MappedBufferObserver' are thread-safe, and can be
+// called concurrently by multiple threads.  The class methods 'loadFrames'
+// and 'renderFile' are thread-safe.
+//
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Recovering the Trace of a Terminated Process
+///- - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// First, we create a mapped buffer observer, and open a buffer file having a
+// capacity of 1 MB:
+//..
+//  ball::MappedBufferObserver observer;
+//  int rc = observer.open(fileName.c_str(), 1024 * 1024);
+//  assert(0 == rc);
+//..
+// Then, we publish records to the observer (typically, the logger manager
+// does this on our behalf):
+//..
+//  for (int i = 0; i < 3; ++i) {
+//      bsl::shared_ptr<ball::Record> record(new ball::Record());
+//      record->fixedFields().setTimestamp(bdlt::Datetime(2020, 6, 1, 12, 30));
+//      record->fixedFields().setSeverity(ball::Severity::e_TRACE);
+//      record->fixedFields().setFileName("server.cpp");
+//      record->fixedFields().setLineNumber(42 + i);
+//      record->fixedFields().setCategory("SERVER");
+//      record->fixedFields().setMessage("processing request");
+//
+//      observer.publish(record, ball::Context());
+//  }
+//  assert(3 == observer.numRecordsPublished());
+//..
+// Now, suppose that the process terminates abruptly at this point: the
+// records published so far are held in the buffer file, even though the
+// observer was not closed.  We simulate this by closing the observer:
+//..
+//  observer.close();
+//..
+// Finally, an offline tool renders the contents of the buffer file as text:
+//..
+//  ball::RecordStringFormatter formatter("%s %f:%l %c %m\n");
+//  bsl::ostringstream          output;
+//  int                         numRecords;
+//
+//  rc = ball::MappedBufferObserver::renderFile(output,
+//                                              fileName.c_str(),
+//                                              formatter,
+//                                              &numRecords);
+//  assert(0 == rc);
+//  assert(3 == numRecords);
+//  assert("TRACE server.cpp:42 SERVER processing request\n"
+//         "TRACE server.cpp:43 SERVER processing request\n"
+//         "TRACE server.cpp:44 SERVER processing request\n" == output.str());
+//..
+
+#include <balscm_version.h>
+
+#include <ball_observer.h>
+
+#include <bslma_allocator.h>
+#include <bslma_usesbslmaallocator.h>
+
+#include <bslmf_nestedtraitdeclaration.h>
+
+#include <bslmt_mutex.h>
+
+#include <bsls_atomic.h>
+#include <bsls_types.h>
+
+#include <bsl_iosfwd.h>
+#include <bsl_memory.h>
+#include <bsl_string.h>
+
+namespace BloombergLP {
+namespace ball {
+
+class Context;
+class Record;
+class RecordStringFormatter;
+
+                         // ==========================
+                         // class MappedBufferObserver
+                         // ==========================
+
+class MappedBufferObserver : public Observer {
+    // This class provides a concrete implementation of the 'Observer'
+    // protocol that writes the records published to it, in binary form, to a
+    // circular buffer held in a memory-mapped file.  Records published while
+    // no buffer file is open are discarded.
+
+  public:
+    // PUBLIC CONSTANTS
+    enum {
+        k_FORMAT_VERSION = 1,  // version of the buffer file header written by
+                               // 'open'
+
+        k_HEADER_SIZE    = 64  // number of bytes preceding the circular
+                               // buffer in a buffer file
+    };
+
+  private:
+    // DATA
+    mutable bslmt::Mutex  d_mutex;            // serializes publication and
+                                              // the opening and closing of
+                                              // the buffer file
+
+    char                 *d_mapping_p;        // address of the mapped buffer
+                                              // file, or 0 if not open
+
+    bsls::Types::Uint64   d_capacity;         // number of bytes in the
+                                              // circular buffer
+
+    bsl::string           d_fileName;         // name of the buffer file
+
+    bsl::string           d_frame;            // scratch buffer holding the
+                                              // frame being written
+
+    bsls::AtomicInt64     d_numDropped;       // number of records too long
+                                              // to be written
+
+    // NOT IMPLEMENTED
+    MappedBufferObserver(const MappedBufferObserver&);
+    MappedBufferObserver& operator=(const MappedBufferObserver&);
+
+  public:
+    // TRAITS
+    BSLMF_NESTED_TRAIT_DECLARATION(MappedBufferObserver,
+                                   bslma::UsesBslmaAllocator);
+
+    // CLASS METHODS
+    static int loadFrames(bsl::string *frames, const char *fileName);
+        // Load into the specified 'frames' the binary frames held in the
+        // buffer file having the specified 'fileName', in the order in which
+        // they were written, omitting the partially overwritten frame at the
+        // start of the buffer (if any).  Return 0 on success, and a non-zero
+        // value if the file could not be read or is not a buffer file written
+        // by this version of the component (in which case 'frames' is
+        // cleared).
+
+    static int renderFile(bsl::ostream&                textStream,
+                          const char                  *fileName,
+                          const RecordStringFormatter& formatter,
+                          int                         *numRecords = 0);
+        // Render, as text, the records held in the buffer file having the
+        // specified 'fileName', in the order in which they were written, to
+        // the specified 'textStream' using the specified 'formatter'.
+        // Optionally specify 'numRecords', into which the number of records
+        // written is loaded.  Return 0 on success, a positive value if some
+        // of the buffer could not be decoded, and a negative value if the
+        // file could not be read, is not a buffer file, or 'textStream' is
+        // not in a good state on return.
+
+    // CREATORS
+    explicit MappedBufferObserver(bslma::Allocator *basicAllocator = 0);
+        // Create a mapped buffer observer having no open buffer file.
+        // Optionally specify a 'basicAllocator' used to supply memory.  If
+        // 'basicAllocator' is 0, the currently installed default allocator is
+        // used.
+
+    virtual ~MappedBufferObserver();
+        // Close the buffer file of this observer (if any), and destroy this
+        // object.  Note that the buffer file is not removed.
+
+    // MANIPULATORS
+    void close();
+        // Unmap the buffer file of this observer, if one is open, and discard
+        // the records subsequently published to this observer.  Note that the
+        // buffer file is not removed.
+
+    int open(const char *fileName, bsls::Types::Int64 capacity);
+        // Create (or truncate) the buffer file having the specified
+        // 'fileName', holding a circular buffer of the specified 'capacity'
+        // (in bytes), and map it in memory so that the records subsequently
+        // published to this observer are written to it.  Return 0 on success,
+        // a positive value if a buffer file is already open (with no effect),
+        // and a negative value otherwise.  The behavior is undefined unless
+        // '0 < capacity'.  Note that a file of 'k_HEADER_SIZE + capacity'
+        // bytes is allocated on disk.
+
+    using Observer::publish;  // Avoid hiding base class method.
+
+    virtual void publish(const bsl::shared_ptr<const Record>& record,
+                         const Context&                       context);
+        // Write the specified 'record' to the buffer file of this observer,
+        // if one is open, overwriting the oldest records in the buffer if
+        // needed.  The specified 'context' is ignored.  Note that the record
+        // is not written (and is counted by 'numRecordsDropped') if its
+        // encoded frame is longer than the capacity of the buffer.
+
+    virtual void releaseRecords();
+        // Discard any shared reference to a 'Record' object that was supplied
+        // to the 'publish' method, and is held by this observer.  Note that
+        // this observer holds no such reference, and this method has no
+        // effect.
+
+    // ACCESSORS
+    bsls::Types::Int64 capacity() const;
+        // Return the capacity (in bytes) of the circular buffer of the open
+        // buffer file of this observer, and 0 if no buffer file is open.
+
+    bsl::string fileName() const;
+        // Return the name of the open buffer file of this observer, and an
+        // empty string if no buffer file is open.
+
+    bool isOpen() const;
+        // Return 'true' if a buffer file is open, and 'false' otherwise.
+
+    bsls::Types::Int64 numRecordsDropped() const;
+        // Return the number of records that were not written to a buffer file
+        // because their encoded frames were longer than the capacity of the
+        // buffer.
+
+    bsls::Types::Int64 numRecordsPublished() const;
+        // Return the number of records written to the open buffer file of
+        // this observer (including those that have since been overwritten),
+        // and 0 if no buffer file is open.
+};
+
+// ============================================================================
+//                              INLINE DEFINITIONS
+// ============================================================================
+
+                         // --------------------------
+                         // class MappedBufferObserver
+                         // --------------------------
+
+// MANIPULATORS
+inline
+void MappedBufferObserver::releaseRecords()
+{
+}
+
+// ACCESSORS
+inline
+bsls::Types::Int64 MappedBufferObserver::numRecordsDropped() const
+{
+    return d_numDropped.loadRelaxed();
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2020 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,1065 @@
+// ball_mappedbufferobserver.t.cpp                                    -*-C++-*-
+#include <ball_mappedbufferobserver.h>
+
+#include <ball_binaryfileobserver.h>
+#include <ball_binaryrecordutil.h>
+#include <ball_context.h>
+#include <ball_record.h>
+#include <ball_recordattributes.h>
+#include <ball_recordstringformatter.h>
+#include <ball_severity.h>
+#include <ball_userfields.h>
+
+#include <bdls_filesystemutil.h>
+#include <bdls_pathutil.h>
+
+#include <bdlt_datetime.h>
+
+#include <bslim_testutil.h>
+
+#include <bslma_default.h>
+#include <bslma_testallocator.h>
+#include <bslma_usesbslmaallocator.h>
+
+#include <bslmf_assert.h>
+#include <bslmf_nestedtraitdeclaration.h>
+
+#include <bslmt_threadutil.h>
+
+#include <bsls_platform.h>
+#include <bsls_review.h>
+#include <bsls_stopwatch.h>
+#include <bsls_types.h>
+
+#include <bsl_cstdlib.h>
+#include <bsl_cstring.h>
+#include <bsl_fstream.h>
+#include <bsl_iostream.h>
+#include <bsl_memory.h>
+#include <bsl_sstream.h>
+#include <bsl_string.h>
+#include <bsl_vector.h>
+
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+#include <windows.h>
+#else
+#include <signal.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+using namespace BloombergLP;
+using namespace bsl;
+
+// ============================================================================
+//                                   TEST PLAN
+// ----------------------------------------------------------------------------
+//                                   Overview
+//                                   --------
+// The component under test is an observer that writes binary frames to a
+// circular buffer in a memory-mapped file, and a pair of class methods that
+// read the frames back from such a file.  We verify the state transitions of
+// the observer, that the reader recovers exactly the most recent records
+// after the buffer has wrapped around (including when the writer was
+// interrupted in the middle of a frame, or killed without closing the
+// observer), and that concurrent publication leaves a decodable buffer.
+// ----------------------------------------------------------------------------
+// CLASS METHODS
+// [ 2] static int loadFrames(bsl::string *frames, const char *fileName);
+// [ 2] static int renderFile(ostream&, const char *, const RSF&, int * = 0);
+//
+// CREATORS
+// [ 1] MappedBufferObserver(bslma::Allocator *basicAllocator = 0);
+// [ 1] ~MappedBufferObserver();
+//
+// MANIPULATORS
+// [ 1] void close();
+// [ 1] int open(const char *fileName, bsls::Types::Int64 capacity);
+// [ 2] void publish(const shared_ptr<const Record>&, const Context&);
+// [ 1] void releaseRecords();
+//
+// ACCESSORS
+// [ 1] bsls::Types::Int64 capacity() const;
+// [ 1] bsl::string fileName() const;
+// [ 1] bool isOpen() const;
+// [ 2] bsls::Types::Int64 numRecordsDropped() const;
+// [ 1] bsls::Types::Int64 numRecordsPublished() const;
+// ----------------------------------------------------------------------------
+// [ 3] CONCERN: Frames survive an interrupted write.
+// [ 4] CONCERN: Frames survive the termination of the writing process.
+// [ 5] CONCERN: Concurrent publication.
+// [ 6] USAGE EXAMPLE
+// [-1] PERFORMANCE: 'MappedBufferObserver' VS. 'BinaryFileObserver'
+
+// ============================================================================
+//                     STANDARD BDE ASSERT TEST FUNCTION
+// ----------------------------------------------------------------------------
+
+namespace {
+
+int testStatus = 0;
+
+void aSsErT(bool condition, const char *message, int line)
+{
+    if (condition) {
+        cout << "Error " __FILE__ "(" << line << "): " << message
+             << "    (failed)" << endl;
+
+        if (0 <= testStatus && testStatus <= 100) {
+            ++testStatus;
+        }
+    }
+}
+
+}  // close unnamed namespace
+
+// ============================================================================
+//               STANDARD BDE TEST DRIVER MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT       BSLIM_TESTUTIL_ASSERT
+#define ASSERTV      BSLIM_TESTUTIL_ASSERTV
+
+#define LOOP_ASSERT  BSLIM_TESTUTIL_LOOP_ASSERT
+#define LOOP0_ASSERT BSLIM_TESTUTIL_LOOP0_ASSERT
+#define LOOP1_ASSERT BSLIM_TESTUTIL_LOOP1_ASSERT
+#define LOOP2_ASSERT BSLIM_TESTUTIL_LOOP2_ASSERT
+#define LOOP3_ASSERT BSLIM_TESTUTIL_LOOP3_ASSERT
+#define LOOP4_ASSERT BSLIM_TESTUTIL_LOOP4_ASSERT
+#define LOOP5_ASSERT BSLIM_TESTUTIL_LOOP5_ASSERT
+#define LOOP6_ASSERT BSLIM_TESTUTIL_LOOP6_ASSERT
+
+#define Q            BSLIM_TESTUTIL_Q   // Quote identifier literally.
+#define P            BSLIM_TESTUTIL_P   // Print identifier and value.
+#define P_           BSLIM_TESTUTIL_P_  // P(X) without '\n'.
+#define T_           BSLIM_TESTUTIL_T_  // Print a tab (w/o newline).
+#define L_           BSLIM_TESTUTIL_L_  // current Line number
+
+//=============================================================================
+//                  GLOBAL TYPEDEFS/CONSTANTS FOR TESTING
+//-----------------------------------------------------------------------------
+
+typedef ball::MappedBufferObserver Obj;
+typedef ball::BinaryRecordUtil     Util;
+typedef bsls::Types::Uint64        Uint64;
+
+// Offsets of the fields of the header of a buffer file (see {Buffer File
+// Format} in the component documentation).
+
+const int k_RESERVED_END_OFFSET  = 24;
+const int k_COMMITTED_END_OFFSET = 32;
+
+// ============================================================================
+//                                 TYPE TRAITS
+// ----------------------------------------------------------------------------
+
+BSLMF_ASSERT(true == bslma::UsesBslmaAllocator<Obj>::value);
+
+//=============================================================================
+//                      HELPER FUNCTIONS FOR TESTING
+//-----------------------------------------------------------------------------
+
+namespace {
+
+class TempDirectoryGuard {
+    // This class implements a scoped temporary directory guard.  The guard
+    // tries to create a temporary directory in the system-wide temp directory
+    // and falls back to the current directory.
+
+    // DATA
+    bsl::string       d_dirName;      // path to the created directory
+    bslma::Allocator *d_allocator_p;  // memory allocator (held, not owned)
+
+  private:
+    // NOT IMPLEMENTED
+    TempDirectoryGuard(const TempDirectoryGuard&);
+    TempDirectoryGuard& operator=(const TempDirectoryGuard&);
+
+  public:
+    // TRAITS
+    BSLMF_NESTED_TRAIT_DECLARATION(TempDirectoryGuard,
+                                   bslma::UsesBslmaAllocator);
+
+    // CREATORS
+    explicit TempDirectoryGuard(bslma::Allocator *basicAllocator = 0)
+        // Create temporary directory in the system-wide temp or current
+        // directory.  Optionally specify a 'basicAllocator' used to supply
+        // memory.  If 'basicAllocator' is 0, the currently installed default
+        // allocator is used.
+    : d_dirName(bslma::Default::allocator(basicAllocator))
+    , d_allocator_p(bslma::Default::allocator(basicAllocator))
+    {
+        bsl::string tmpPath(d_allocator_p);
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+        char tmpPathBuf[MAX_PATH];
+        GetTempPath(MAX_PATH, tmpPathBuf);
+        tmpPath.assign(tmpPathBuf);
+#else
+        const char *envTmpPath = bsl::getenv("TMPDIR");
+        if (envTmpPath) {
+            tmpPath.assign(envTmpPath);
+        }
+#endif
+
+        int res = bdls::PathUtil::appendIfValid(&tmpPath, "ball_");
+        ASSERTV(tmpPath, 0 == res);
+
+        res = bdls::FilesystemUtil::createTemporaryDirectory(&d_dirName,
+                                                             tmpPath);
+        ASSERTV(tmpPath, 0 == res);
+    }
+
+    ~TempDirectoryGuard()
+        // Destroy this object and remove the temporary directory (recursively)
+        // created at construction.
+    {
+        bdls::FilesystemUtil::remove(d_dirName, true);
+    }
+
+    // ACCESSORS
+    const bsl::string& getTempDirName() const
+        // Return a 'const' reference to the name of the created temporary
+        // directory.
+    {
+        return d_dirName;
+    }
+};
+
+bsl::shared_ptr<ball::Record> makeRecord(int index)
+    // Return a record whose value is determined by the specified 'index', and
+    // whose message has a length that varies with 'index'.
+{
+    bsl::shared_ptr<ball::Record> record =
+                                        bsl::make_shared<ball::Record>();
+    ball::RecordAttributes& attributes = record->fixedFields();
+
+    attributes.setTimestamp(bdlt::Datetime(2020,
+                                           1 + index % 12,
+                                           1 + index % 28,
+                                           index % 24,
+                                           index % 60,
+                                           index % 60,
+                                           index % 1000));
+    attributes.setProcessID(100);
+    attributes.setThreadID(index % 7);
+    attributes.setSeverity(ball::Severity::e_TRACE);
+    attributes.setFileName("ball_mappedbufferobserver.t.cpp");
+    attributes.setLineNumber(index);
+    attributes.setCategory("TEST");
+
+    bsl::ostringstream message;
+    message << "message number " << index << ' '
+            << bsl::string(index % 37, 'x');
+    attributes.setMessage(message.str().c_str());
+
+    record->customFields().appendInt64(index);
+    return record;
+}
+
+int decodeAll(bsl::vector<int> *indices, const bsl::string& frames)
+    // Decode the specified 'frames' and load into the specified 'indices' the
+    // first user field of each decoded record.  Return 0 if 'frames' consists
+    // of well-formed frames holding records having the value returned by
+    // 'makeRecord' for their index, and a non-zero value otherwise.
+{
+    indices->clear();
+
+    ball::Record record;
+    bsl::size_t  offset = 0;
+
+    while (offset < frames.length()) {
+        int frameLength;
+        if (0 != Util::decode(&record,
+                              &frameLength,
+                              frames.data() + offset,
+                              frames.length() - offset)) {
+            return 1;                                                 // RETURN
+        }
+        offset += frameLength;
+
+        if (1 != record.customFields().length()) {
+            return 2;                                                 // RETURN
+        }
+
+        const int index = static_cast<int>(
+                                     record.customFields()[0].theInt64());
+        if (!(*makeRecord(index) == record)) {
+            return 3;                                                 // RETURN
+        }
+        indices->push_back(index);
+    }
+    return 0;
+}
+
+Uint64 getField(const bsl::string& contents, int offset)
+    // Return the 64-bit header field at the specified 'offset' of the
+    // specified buffer file 'contents'.
+{
+    Uint64 value;
+    bsl::memcpy(&value, contents.data() + offset, sizeof value);
+    return value;
+}
+
+void setField(bsl::string *contents, int offset, Uint64 value)
+    // Set the 64-bit header field at the specified 'offset' of the specified
+    // buffer file 'contents' to the specified 'value'.
+{
+    bsl::memcpy(&(*contents)[offset], &value, sizeof value);
+}
+
+bsl::string readFile(const bsl::string& fileName)
+    // Return the contents of the file having the specified 'fileName'.
+{
+    bsl::ifstream      file(fileName.c_str(),
+                            bsl::ios_base::in | bsl::ios_base::binary);
+    bsl::ostringstream contents;
+    contents << file.rdbuf();
+    return contents.str();
+}
+
+void writeFile(const bsl::string& fileName, const bsl::string& contents)
+    // Replace the contents of the file having the specified 'fileName' with
+    // the specified 'contents'.
+{
+    bsl::ofstream file(fileName.c_str(),
+                       bsl::ios_base::out | bsl::ios_base::binary);
+    file.write(contents.data(), contents.length());
+}
+
+struct PublishJob {
+    // This 'struct' describes the records published by a thread of the
+    // concurrency test.
+
+    // DATA
+    Obj *d_observer_p;  // observer to publish to
+    int  d_first;       // index of the first record to publish
+    int  d_count;       // number of records to publish
+};
+
+}  // close unnamed namespace
+
+extern "C" void *publishThread(void *arg)
+    // Publish the records described by the 'PublishJob' addressed by the
+    // specified 'arg'.
+{
+    const PublishJob *job = static_cast<const PublishJob *>(arg);
+    for (int i = 0; i < job->d_count; ++i) {
+        job->d_observer_p->publish(makeRecord(job->d_first + i),
+                                   ball::Context());
+    }
+    return 0;
+}
+
+//=============================================================================
+//                              MAIN PROGRAM
+//-----------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    const int                 test = argc > 1 ? atoi(argv[1]) : 0;
+    const bool             verbose = argc > 2;
+    const bool         veryVerbose = argc > 3;
+    const bool     veryVeryVerbose = argc > 4;
+    const bool veryVeryVeryVerbose = argc > 5;
+
+    (void)veryVeryVerbose;
+
+    cout << "TEST " << __FILE__ << " CASE " << test << endl;
+
+    // CONCERN: 'BSLS_REVIEW' failures should lead to test failures.
+    bsls::ReviewFailureHandlerGuard reviewGuard(&bsls::Review::failByAbort);
+
+    // CONCERN: In no case does memory come from the global allocator.
+
+    bslma::TestAllocator globalAllocator("global", veryVeryVeryVerbose);
+    bslma::Default::setGlobalAllocator(&globalAllocator);
+
+    switch (test) { case 0:
+      case 6: {
+        // --------------------------------------------------------------------
+        // USAGE EXAMPLE
+        //   Extracted from component header file.
+        //
+        // Concerns:
+        //: 1 The usage example provided in the component header file compiles,
+        //:   links, and runs as shown.
+        //
+        // Plan:
+        //: 1 Incorporate usage example from header into test driver, remove
+        //:   leading comment characters, and replace 'assert' with 'ASSERT'.
+        //:   (C-1)
+        //
+        // Testing:
+        //   USAGE EXAMPLE
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "USAGE EXAMPLE" << endl
+                          << "=============" << endl;
+
+        TempDirectoryGuard tempDirGuard;
+
+        bsl::string fileName(tempDirGuard.getTempDirName());
+        bdls::PathUtil::appendRaw(&fileName, "usage.buf");
+
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Recovering the Trace of a Terminated Process
+///- - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// First, we create a mapped buffer observer, and open a buffer file having a
+// capacity of 1 MB:
+//..
+    ball::MappedBufferObserver observer;
+    int rc = observer.open(fileName.c_str(), 1024 * 1024);
+    ASSERT(0 == rc);
+//..
+// Then, we publish records to the observer (typically, the logger manager
+// does this on our behalf):
+//..
+    for (int i = 0; i < 3; ++i) {
+        bsl::shared_ptr<ball::Record> record(new ball::Record());
+        record->fixedFields().setTimestamp(bdlt::Datetime(2020, 6, 1, 12, 30));
+        record->fixedFields().setSeverity(ball::Severity::e_TRACE);
+        record->fixedFields().setFileName("server.cpp");
+        record->fixedFields().setLineNumber(42 + i);
+        record->fixedFields().setCategory("SERVER");
+        record->fixedFields().setMessage("processing request");
+
+        observer.publish(record, ball::Context());
+    }
+    ASSERT(3 == observer.numRecordsPublished());
+//..
+// Now, suppose that the process terminates abruptly at this point: the
+// records published so far are held in the buffer file, even though the
+// observer was not closed.  We simulate this by closing the observer:
+//..
+    observer.close();
+//..
+// Finally, an offline tool renders the contents of the buffer file as text:
+//..
+    ball::RecordStringFormatter formatter("%s %f:%l %c %m\n");
+    bsl::ostringstream          output;
+    int                         numRecords;
+
+    rc = ball::MappedBufferObserver::renderFile(output,
+                                                fileName.c_str(),
+                                                formatter,
+                                                &numRecords);
+    ASSERT(0 == rc);
+    ASSERT(3 == numRecords);
+    ASSERT("TRACE server.cpp:42 SERVER processing request\n"
+           "TRACE server.cpp:43 SERVER processing request\n"
+           "TRACE server.cpp:44 SERVER processing request\n" == output.str());
+//..
+      } break;
+      case 5: {
+        // --------------------------------------------------------------------
+        // CONCERN: CONCURRENT PUBLICATION
+        //
+        // Concerns:
+        //: 1 Records published concurrently by several threads are each
+        //:   written as an entire frame.
+        //
+        // Plan:
+        //: 1 Publish disjoint ranges of records from several threads to an
+        //:   observer whose buffer wraps around many times, and verify that
+        //:   the buffer consists of well-formed frames holding distinct
+        //:   records, and that the number of records published is the total
+        //:   number of records.  (C-1)
+        //
+        // Testing:
+        //   CONCERN: Concurrent publication.
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "CONCERN: CONCURRENT PUBLICATION" << endl
+                          << "===============================" << endl;
+
+        enum { k_NUM_THREADS = 4, k_NUM_RECORDS = 5000 };
+
+        TempDirectoryGuard tempDirGuard;
+
+        bsl::string fileName(tempDirGuard.getTempDirName());
+        bdls::PathUtil::appendRaw(&fileName, "concurrent.buf");
+
+        Obj mX;  const Obj& X = mX;
+        ASSERT(0 == mX.open(fileName.c_str(), 64 * 1024));
+
+        bslmt::ThreadUtil::Handle handles[k_NUM_THREADS];
+        PublishJob                jobs[k_NUM_THREADS];
+        for (int i = 0; i < k_NUM_THREADS; ++i) {
+            PublishJob job = { &mX, i * k_NUM_RECORDS, k_NUM_RECORDS };
+            jobs[i] = job;
+            ASSERTV(i, 0 == bslmt::ThreadUtil::create(&handles[i],
+                                                      &publishThread,
+                                                      &jobs[i]));
+        }
+        for (int i = 0; i < k_NUM_THREADS; ++i) {
+            ASSERTV(i, 0 == bslmt::ThreadUtil::join(handles[i]));
+        }
+
+        ASSERT(k_NUM_THREADS * k_NUM_RECORDS == X.numRecordsPublished());
+        mX.close();
+
+        bsl::string frames;
+        ASSERT(0 == Obj::loadFrames(&frames, fileName.c_str()));
+
+        bsl::vector<int> indices;
+        ASSERT(0 == decodeAll(&indices, frames));
+        ASSERT(100 < indices.size());
+
+        bsl::vector<char> seen(k_NUM_THREADS * k_NUM_RECORDS, 0);
+        for (bsl::size_t i = 0; i < indices.size(); ++i) {
+            ASSERTV(i, 0 == seen[indices[i]]);
+            seen[indices[i]] = 1;
+        }
+      } break;
+      case 4: {
+        // --------------------------------------------------------------------
+        // CONCERN: FRAMES SURVIVE THE TERMINATION OF THE WRITING PROCESS
+        //
+        // Concerns:
+        //: 1 The records published by a process that is killed without
+        //:   closing the observer can be read from the buffer file.
+        //
+        // Plan:
+        //: 1 Fork a child process that opens an observer, publishes records,
+        //:   and kills itself using 'SIGKILL'.  Verify that the parent
+        //:   process reads the most recent records from the buffer file.
+        //:   (C-1)
+        //
+        // Testing:
+        //   CONCERN: Frames survive the termination of the writing process.
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+               << "CONCERN: FRAMES SURVIVE THE TERMINATION OF THE WRITING "
+                  "PROCESS" << endl
+               << "======================================================="
+                  "=======" << endl;
+
+#ifndef BSLS_PLATFORM_OS_WINDOWS
+        enum { k_NUM_RECORDS = 1000 };
+
+        TempDirectoryGuard tempDirGuard;
+
+        bsl::string fileName(tempDirGuard.getTempDirName());
+        bdls::PathUtil::appendRaw(&fileName, "killed.buf");
+
+        cout << flush;
+
+        const pid_t pid = fork();
+        ASSERT(-1 != pid);
+
+        if (0 == pid) {
+            Obj mX;
+            if (0 != mX.open(fileName.c_str(), 8 * 1024)) {
+                _exit(1);
+            }
+            for (int i = 0; i < k_NUM_RECORDS; ++i) {
+                mX.publish(makeRecord(i), ball::Context());
+            }
+            kill(getpid(), SIGKILL);
+            _exit(2);
+        }
+
+        int status = 0;
+        ASSERT(pid == waitpid(pid, &status, 0));
+        ASSERTV(status, WIFSIGNALED(status));
+        ASSERTV(status, SIGKILL == WTERMSIG(status));
+
+        bsl::string frames;
+        ASSERT(0 == Obj::loadFrames(&frames, fileName.c_str()));
+
+        bsl::vector<int> indices;
+        ASSERT(0 == decodeAll(&indices, frames));
+        ASSERT(10 < indices.size());
+        ASSERT(!indices.empty() && k_NUM_RECORDS - 1 == indices.back());
+
+        for (bsl::size_t i = 1; i < indices.size(); ++i) {
+            ASSERTV(i, indices[i - 1] + 1 == indices[i]);
+        }
+
+        if (veryVerbose) { P_(indices.size()) P(indices.front()) }
+#else
+        if (verbose) cout << "Skipped on Windows." << endl;
+#endif
+      } break;
+      case 3: {
+        // --------------------------------------------------------------------
+        // CONCERN: FRAMES SURVIVE AN INTERRUPTED WRITE
+        //
+        // Concerns:
+        //: 1 If the writer is terminated after advancing 'reservedEnd', but
+        //:   before advancing 'committedEnd', the frames that were entirely
+        //:   written and not overwritten are read from the buffer file.
+        //
+        // Plan:
+        //: 1 For several buffer files in which the buffer has wrapped around,
+        //:   simulate the interrupted write of frames of various lengths by
+        //:   advancing 'reservedEnd' in the header, and overwriting the bytes
+        //:   of the buffer that the frame would have occupied with a prefix of
+        //:   a frame.  Verify that 'loadFrames' loads the frames that were
+        //:   written in full and not overwritten.  (C-1)
+        //
+        // Testing:
+        //   CONCERN: Frames survive an interrupted write.
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "CONCERN: FRAMES SURVIVE AN INTERRUPTED WRITE"
+                          << endl
+                          << "============================================"
+                          << endl;
+
+        TempDirectoryGuard tempDirGuard;
+
+        bsl::string fileName(tempDirGuard.getTempDirName());
+        bdls::PathUtil::appendRaw(&fileName, "interrupted.buf");
+
+        const int CAPACITY = 2000;
+
+        for (int numRecords = 30; numRecords < 60; numRecords += 7) {
+            for (int partial = 1; partial < 300; partial += 37) {
+                Obj mX;
+                ASSERT(0 == mX.open(fileName.c_str(), CAPACITY));
+                for (int i = 0; i < numRecords; ++i) {
+                    mX.publish(makeRecord(i), ball::Context());
+                }
+                mX.close();
+
+                bsl::string contents = readFile(fileName);
+                ASSERT(Obj::k_HEADER_SIZE + CAPACITY == contents.length());
+
+                const Uint64 end = getField(contents, k_COMMITTED_END_OFFSET);
+                ASSERT(end == getField(contents, k_RESERVED_END_OFFSET));
+                ASSERT(CAPACITY < end);
+
+                // Write 'partial' bytes of a frame for a record that is
+                // 'partial' bytes long.
+
+                bsl::string frame;
+                Util::encode(&frame, *makeRecord(numRecords));
+                frame.resize(partial);
+
+                for (int i = 0; i < partial; ++i) {
+                    contents[Obj::k_HEADER_SIZE
+                             + static_cast<int>((end + i) % CAPACITY)] =
+                                                                     frame[i];
+                }
+                setField(&contents, k_RESERVED_END_OFFSET, end + partial);
+                writeFile(fileName, contents);
+
+                bsl::string frames;
+                ASSERTV(numRecords, partial,
+                        0 == Obj::loadFrames(&frames, fileName.c_str()));
+
+                bsl::vector<int> indices;
+                ASSERTV(numRecords, partial,
+                        0 == decodeAll(&indices, frames));
+                ASSERTV(numRecords, partial, !indices.empty());
+                if (indices.empty()) {
+                    continue;
+                }
+
+                ASSERTV(numRecords, partial, indices.back(),
+                        numRecords - 1 == indices.back());
+                for (bsl::size_t i = 1; i < indices.size(); ++i) {
+                    ASSERTV(numRecords, partial, i,
+                            indices[i - 1] + 1 == indices[i]);
+                }
+
+                // Every record that was not overwritten is loaded: the total
+                // length of the frames that precede the first loaded frame and
+                // follow the partial frame exceeds the capacity.
+
+                Uint64 length = partial;
+                for (int i = indices.front() - 1; 0 <= i; --i) {
+                    bsl::string previous;
+                    Util::encode(&previous, *makeRecord(i));
+                    length += previous.length();
+                }
+                length += frames.length();
+
+                ASSERTV(numRecords, partial, length, end,
+                        0 == indices.front() || CAPACITY < length);
+
+                if (veryVerbose) {
+                    T_ P_(numRecords) P_(partial) P(indices.front())
+                }
+            }
+        }
+      } break;
+      case 2: {
+        // --------------------------------------------------------------------
+        // PUBLICATION AND READING
+        //
+        // Concerns:
+        //: 1 Published records are written as frames that 'loadFrames' loads
+        //:   in the order in which they were published.
+        //:
+        //: 2 Once the buffer has wrapped around, the oldest records are
+        //:   overwritten, and 'loadFrames' loads every record that was not
+        //:   (even partially) overwritten.
+        //:
+        //: 3 A record whose frame is longer than the capacity of the buffer is
+        //:   dropped, and counted by 'numRecordsDropped'.
+        //:
+        //: 4 'renderFile' renders the loaded frames using the formatter.
+        //:
+        //: 5 'loadFrames' and 'renderFile' fail for a file that does not exist
+        //:   or is not a buffer file.
+        //
+        // Plan:
+        //: 1 For capacities ranging from less than the length of a frame to
+        //:   more than the length of all frames, publish a sequence of records
+        //:   and verify that the loaded frames hold the longest suffix of the
+        //:   sequence whose total length does not exceed the capacity.
+        //:   (C-1..3)
+        //:
+        //: 2 Compare the output of 'renderFile' with that of the formatter
+        //:   for the records of the loaded frames.  (C-4)
+        //:
+        //: 3 Call 'loadFrames' and 'renderFile' for a missing file, an empty
+        //:   file, and a text file.  (C-5)
+        //
+        // Testing:
+        //   static int loadFrames(bsl::string *frames, const char *fileName);
+        //   static int renderFile(ostream&, const char *, const RSF&, int *);
+        //   void publish(const shared_ptr<const Record>&, const Context&);
+        //   bsls::Types::Int64 numRecordsDropped() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "PUBLICATION AND READING" << endl
+                          << "=======================" << endl;
+
+        enum { k_NUM_RECORDS = 100 };
+
+        TempDirectoryGuard tempDirGuard;
+
+        bsl::string fileName(tempDirGuard.getTempDirName());
+        bdls::PathUtil::appendRaw(&fileName, "publish.buf");
+
+        bsl::vector<int> frameLengths;
+        for (int i = 0; i < k_NUM_RECORDS; ++i) {
+            bsl::string frame;
+            Util::encode(&frame, *makeRecord(i));
+            frameLengths.push_back(static_cast<int>(frame.length()));
+        }
+
+        const ball::RecordStringFormatter formatter("%d %s %f:%l %c %m %u\n");
+
+        const int CAPACITIES[] = { 1, 50, 150, 151, 152, 500, 1000, 4096,
+                                   10000, 100000 };
+        const int NUM_CAPACITIES = sizeof CAPACITIES / sizeof *CAPACITIES;
+
+        for (int ti = 0; ti < NUM_CAPACITIES; ++ti) {
+            const int CAPACITY = CAPACITIES[ti];
+
+            Obj mX;  const Obj& X = mX;
+            ASSERTV(CAPACITY, 0 == mX.open(fileName.c_str(), CAPACITY));
+
+            int numDropped = 0;
+            for (int i = 0; i < k_NUM_RECORDS; ++i) {
+                mX.publish(makeRecord(i), ball::Context());
+                numDropped += frameLengths[i] > CAPACITY;
+            }
+            ASSERTV(CAPACITY, numDropped == X.numRecordsDropped());
+            ASSERTV(CAPACITY,
+                    k_NUM_RECORDS - numDropped == X.numRecordsPublished());
+            mX.close();
+
+            // The expected records are the longest suffix of the records that
+            // were not dropped whose frames fit in the buffer.
+
+            bsl::vector<int> expected;
+            int              length = 0;
+            for (int i = k_NUM_RECORDS - 1; 0 <= i; --i) {
+                if (frameLengths[i] > CAPACITY) {
+                    continue;
+                }
+                if (length + frameLengths[i] > CAPACITY) {
+                    break;
+                }
+                length += frameLengths[i];
+                expected.insert(expected.begin(), i);
+            }
+
+            bsl::string frames;
+            ASSERTV(CAPACITY, 0 == Obj::loadFrames(&frames, fileName.c_str()));
+
+            bsl::vector<int> indices;
+            ASSERTV(CAPACITY, 0 == decodeAll(&indices, frames));
+            ASSERTV(CAPACITY, indices.size(), expected.size(),
+                    expected == indices);
+
+            bsl::ostringstream expectedText;
+            for (bsl::size_t i = 0; i < expected.size(); ++i) {
+                formatter(expectedText, *makeRecord(expected[i]));
+            }
+
+            bsl::ostringstream output;
+            int                numRecords = -1;
+            ASSERTV(CAPACITY, 0 == Obj::renderFile(output,
+                                                   fileName.c_str(),
+                                                   formatter,
+                                                   &numRecords));
+            ASSERTV(CAPACITY,
+                    static_cast<int>(expected.size()) == numRecords);
+            ASSERTV(CAPACITY, expectedText.str() == output.str());
+        }
+
+        if (verbose) cout << "\nTesting invalid files." << endl;
+        {
+            bsl::string missing(tempDirGuard.getTempDirName());
+            bdls::PathUtil::appendRaw(&missing, "missing.buf");
+
+            bsl::string empty(tempDirGuard.getTempDirName());
+            bdls::PathUtil::appendRaw(&empty, "empty.buf");
+            writeFile(empty, "");
+
+            bsl::string text(tempDirGuard.getTempDirName());
+            bdls::PathUtil::appendRaw(&text, "text.log");
+            writeFile(text, bsl::string(1000, 'x'));
+
+            const char *NAMES[] = { missing.c_str(),
+                                    empty.c_str(),
+                                    text.c_str() };
+            for (int i = 0; i < 3; ++i) {
+                bsl::string frames("garbage");
+                ASSERTV(i, 0 != Obj::loadFrames(&frames, NAMES[i]));
+                ASSERTV(i, frames.empty());
+
+                bsl::ostringstream output;
+                int                numRecords = -1;
+                ASSERTV(i, 0 > Obj::renderFile(output,
+                                               NAMES[i],
+                                               formatter,
+                                               &numRecords));
+                ASSERTV(i, 0 == numRecords);
+                ASSERTV(i, output.str().empty());
+            }
+        }
+      } break;
+      case 1: {
+        // --------------------------------------------------------------------
+        // BREATHING TEST
+        //
+        // Concerns:
+        //: 1 An observer is created having no open buffer file, and records
+        //:   published to it are discarded.
+        //:
+        //: 2 'open' creates a buffer file of the expected size, and fails
+        //:   (with no effect) if a buffer file is open, or if the file cannot
+        //:   be created.
+        //:
+        //: 3 'close' unmaps the buffer file, leaving the file in place, and
+        //:   has no effect if no buffer file is open.
+        //:
+        //: 4 The accessors reflect the state of the observer.
+        //:
+        //: 5 'open' truncates an existing buffer file.
+        //:
+        //: 6 Memory is allocated from the supplied allocator.
+        //
+        // Plan:
+        //: 1 Exercise the manipulators and verify the accessors after each.
+        //:   (C-1..6)
+        //
+        // Testing:
+        //   MappedBufferObserver(bslma::Allocator *basicAllocator = 0);
+        //   ~MappedBufferObserver();
+        //   void close();
+        //   int open(const char *fileName, bsls::Types::Int64 capacity);
+        //   void releaseRecords();
+        //   bsls::Types::Int64 capacity() const;
+        //   bsl::string fileName() const;
+        //   bool isOpen() const;
+        //   bsls::Types::Int64 numRecordsPublished() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "BREATHING TEST" << endl
+                          << "==============" << endl;
+
+        TempDirectoryGuard tempDirGuard;
+
+        bsl::string fileName(tempDirGuard.getTempDirName());
+        bdls::PathUtil::appendRaw(&fileName, "breathing.buf");
+
+        bsl::string badName(tempDirGuard.getTempDirName());
+        bdls::PathUtil::appendRaw(&badName, "missing");
+        bdls::PathUtil::appendRaw(&badName, "breathing.buf");
+
+        bslma::TestAllocator ta("test", veryVeryVeryVerbose);
+        {
+            Obj mX(&ta);  const Obj& X = mX;
+
+            ASSERT(false == X.isOpen());
+            ASSERT(0     == X.capacity());
+            ASSERT(""    == X.fileName());
+            ASSERT(0     == X.numRecordsPublished());
+            ASSERT(0     == X.numRecordsDropped());
+
+            mX.publish(makeRecord(0), ball::Context());
+            mX.releaseRecords();
+            mX.close();
+            ASSERT(false == X.isOpen());
+            ASSERT(0     == X.numRecordsPublished());
+
+            ASSERT(0 >  mX.open(badName.c_str(), 1024));
+            ASSERT(false == X.isOpen());
+
+            ASSERT(0 == mX.open(fileName.c_str(), 1024));
+            ASSERT(true     == X.isOpen());
+            ASSERT(1024     == X.capacity());
+            ASSERT(fileName == X.fileName());
+            ASSERT(0        == X.numRecordsPublished());
+            ASSERT(Obj::k_HEADER_SIZE + 1024 ==
+                   bdls::FilesystemUtil::getFileSize(fileName));
+
+            ASSERT(0 <  mX.open(fileName.c_str(), 2048));
+            ASSERT(1024 == X.capacity());
+
+            mX.publish(makeRecord(0), ball::Context());
+            mX.publish(makeRecord(1), ball::Context());
+            ASSERT(2 == X.numRecordsPublished());
+
+            mX.close();
+            ASSERT(false == X.isOpen());
+            ASSERT(0     == X.capacity());
+            ASSERT(""    == X.fileName());
+            ASSERT(0     == X.numRecordsPublished());
+            ASSERT(bdls::FilesystemUtil::exists(fileName));
+
+            bsl::string frames;
+            bsl::vector<int> indices;
+            ASSERT(0 == Obj::loadFrames(&frames, fileName.c_str()));
+            ASSERT(0 == decodeAll(&indices, frames));
+            ASSERT(2 == indices.size());
+
+            // Reopening truncates the file.
+
+            ASSERT(0 == mX.open(fileName.c_str(), 512));
+            ASSERT(512 == X.capacity());
+            ASSERT(Obj::k_HEADER_SIZE + 512 ==
+                   bdls::FilesystemUtil::getFileSize(fileName));
+            ASSERT(0 == Obj::loadFrames(&frames, fileName.c_str()));
+            ASSERT(frames.empty());
+
+            mX.publish(makeRecord(2), ball::Context());
+            ASSERT(1 == X.numRecordsPublished());
+
+            ASSERT(0 < ta.numBlocksInUse());
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+
+        bsl::string frames;
+        bsl::vector<int> indices;
+        ASSERT(0 == Obj::loadFrames(&frames, fileName.c_str()));
+        ASSERT(0 == decodeAll(&indices, frames));
+        ASSERT(1 == indices.size() && 2 == indices[0]);
+      } break;
+      case -1: {
+        // --------------------------------------------------------------------
+        // PERFORMANCE: 'MappedBufferObserver' VS. 'BinaryFileObserver'
+        //
+        // Concerns:
+        //: 1 Publishing a record to a mapped buffer observer is substantially
+        //:   cheaper than writing it to a file.
+        //
+        // Plan:
+        //: 1 Time publishing a typical record many times to each observer and
+        //:   report the times.  (C-1)
+        //
+        // Testing:
+        //   PERFORMANCE: 'MappedBufferObserver' VS. 'BinaryFileObserver'
+        // --------------------------------------------------------------------
+
+        cout << endl
+             << "PERFORMANCE: 'MappedBufferObserver' VS. 'BinaryFileObserver'"
+             << endl
+             << "============================================================"
+             << endl;
+
+        const int NUM_ITERATIONS = argc > 2 ? atoi(argv[2]) : 1000000;
+
+        TempDirectoryGuard tempDirGuard;
+
+        bsl::string mappedName(tempDirGuard.getTempDirName());
+        bdls::PathUtil::appendRaw(&mappedName, "mapped.buf");
+
+        bsl::string binaryName(tempDirGuard.getTempDirName());
+        bdls::PathUtil::appendRaw(&binaryName, "binary.log");
+
+        const bsl::shared_ptr<ball::Record> record = makeRecord(17);
+
+        bsls::Stopwatch timer;
+
+        {
+            Obj observer;
+            observer.open(mappedName.c_str(), 16 * 1024 * 1024);
+
+            timer.start();
+            for (int i = 0; i < NUM_ITERATIONS; ++i) {
+                observer.publish(record, ball::Context());
+            }
+            timer.stop();
+        }
+        const double mappedTime = timer.elapsedTime();
+
+        const int NUM_FILE_ITERATIONS = NUM_ITERATIONS / 10;
+        {
+            ball::BinaryFileObserver observer;
+            observer.enableFileLogging(binaryName.c_str());
+
+            timer.reset();
+            timer.start();
+            for (int i = 0; i < NUM_FILE_ITERATIONS; ++i) {
+                observer.publish(record, ball::Context());
+            }
+            timer.stop();
+        }
+        const double binaryTime = timer.elapsedTime();
+
+        cout << "mapped buffer: " << mappedTime * 1e9 / NUM_ITERATIONS
+             << " ns/record" << endl
+             << "binary file:   " << binaryTime * 1e9 / NUM_FILE_ITERATIONS
+             << " ns/record" << endl;
+      } break;
+      default: {
+        cerr << "WARNING: CASE `" << test << "' NOT FOUND." << endl;
+        testStatus = -1;
+      }
+    }
+
+    // CONCERN: In no case does memory come from the global allocator.
+
+    ASSERTV(globalAllocator.numBlocksTotal(),
+            0 == globalAllocator.numBlocksTotal());
+
+    if (testStatus > 0) {
+        cerr << "Error, non-zero test status = " << testStatus << "." << endl;
+    }
+    return testStatus;
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2020 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,724 @@
+// ball_recordcapture.cpp                                             -*-C++-*-
+#include <ball_recordcapture.h>
+
+#include <bsls_ident.h>
+BSLS_IDENT_RCSID(ball_recordcapture_cpp,"$Id$ $CSID$")
+
+#include <ball_recordattributes.h>
+
+#include <bdlf_memfn.h>
+
+#include <bdlt_datetime.h>
+
+#include <bslma_default.h>
+#include <bslma_newdeleteallocator.h>
+
+#include <bslmt_once.h>
+#include <bslmt_platform.h>
+#include <bslmt_qlock.h>
+#include <bslmt_threadattributes.h>
+#include <bslmt_threadlocalvariable.h>
+
+#include <bsls_assert.h>
+#include <bsls_log.h>
+#include <bsls_systemtime.h>
+#include <bsls_timeinterval.h>
+#include <bsls_types.h>
+
+#include <bsl_algorithm.h>
+
+// ============================================================================
+//                           IMPLEMENTATION NOTES
+// ----------------------------------------------------------------------------
+//
+// Each ring is a classic single-producer single-consumer circular buffer of
+// 'd_size == ringCapacity + 1' slots: the producing thread owns the slots in
+// '[d_tail .. d_head)' and the merge thread owns the slots in
+// '[d_head .. d_tail)'.  The merge thread advances 'd_head' only *after* the
+// dispatch callback returns, so that a ring whose 'd_head == d_tail' has no
+// record in flight.  Each side also counts the records it has committed
+// ('d_numCommitted') or dispatched ('d_numDispatched'), so that 'drain' can
+// wait for the records committed before it was called without waiting for
+// the rings to become empty.
+//
+// A producing thread publishes its reservation in 'd_reserved_p' and then
+// re-examines 'd_running', while 'stop' resets 'd_running' and then examines
+// the 'd_reserved_p' of every ring (all with sequentially consistent
+// operations).  Therefore, either the producing thread observes that the
+// capture is stopping and abandons its reservation, or 'stop' observes the
+// reservation and waits for it to be released before dispatching the
+// remaining records.  Reservations are thus tracked without any state shared
+// between producing threads.
+//
+// The merge thread blocks on 'd_wakeUp' when all rings are empty.  To avoid a
+// lost wake-up, it sets 'd_consumerWaiting' and re-examines the rings before
+// blocking, while a producer stores 'd_tail' and then examines
+// 'd_consumerWaiting' (both with sequentially consistent operations), posting
+// 'd_wakeUp' only if it is the one to reset the flag.  The wait is bounded
+// regardless, so that orphaned rings are eventually reclaimed.
+//
+// Rings are associated with threads through a 'RecordCapture_ThreadHandle'
+// held in thread-specific storage.  The association between handles and rings
+// is guarded by a single process-wide lock, which is acquired only when a
+// thread registers its ring, when a thread exits, when the merge thread
+// observes a change in the set of rings, and when a capture is destroyed.
+// ----------------------------------------------------------------------------
+
+namespace BloombergLP {
+namespace ball {
+
+                         // ========================
+                         // class RecordCapture_Ring
+                         // ========================
+
+class RecordCapture_Ring {
+    // This component-private class holds the preallocated records of one
+    // producing thread.
+
+  public:
+    // DATA
+    bsls::AtomicUint64              d_numDispatched;
+                                                    // number of records
+                                                    // dispatched (merge
+                                                    // thread)
+
+    bsls::AtomicInt                 d_head;         // next slot to dispatch
+                                                    // (merge thread)
+
+    const char                      d_headPad[
+                                          bslmt::Platform::e_CACHE_LINE_SIZE
+                                        - sizeof(bsls::AtomicUint64)
+                                        - sizeof(bsls::AtomicInt)];
+                                                    // padding to prevent
+                                                    // false sharing
+
+    bsls::AtomicUint64              d_numCommitted; // number of records
+                                                    // committed (producer)
+
+    bsls::AtomicInt                 d_tail;         // next slot to reserve
+                                                    // (producer)
+
+    bsls::AtomicPointer<Record>     d_reserved_p;   // reserved record, if any
+                                                    // (producer)
+
+    const char                      d_tailPad[
+                                          bslmt::Platform::e_CACHE_LINE_SIZE
+                                        - sizeof(bsls::AtomicUint64)
+                                        - sizeof(bsls::AtomicInt)
+                                        - sizeof(bsls::AtomicPointer<Record>)];
+                                                    // padding to prevent
+                                                    // false sharing
+
+    bsl::vector<Record>             d_records;      // preallocated records
+
+    bsl::vector<ThresholdAggregate> d_levels;       // levels of each
+                                                    // committed record
+
+    bsl::vector<void *>             d_owners;       // owner of each committed
+                                                    // record
+
+    const int                       d_size;         // number of slots
+
+    int                             d_id;           // value of the
+                                                    // generation of the
+                                                    // capture when this ring
+                                                    // was registered
+
+    RecordCapture                  *d_capture_p;    // owning capture
+
+    RecordCapture_ThreadHandle     *d_handle_p;     // producer handle, or 0
+                                                    // if orphaned (guarded by
+                                                    // the registry lock)
+
+    // CREATORS
+    RecordCapture_Ring(int               ringCapacity,
+                       RecordCapture    *capture,
+                       bslma::Allocator *basicAllocator);
+        // Create a ring able to hold the specified 'ringCapacity' committed
+        // records for the specified 'capture', using the specified
+        // 'basicAllocator' to supply memory.
+
+    // ACCESSORS
+    int next(int index) const;
+        // Return the slot following the specified 'index'.
+
+    bool isEmpty() const;
+        // Return 'true' if this ring holds no committed record, and 'false'
+        // otherwise.
+};
+
+                      // ================================
+                      // struct RecordCapture_ThreadHandle
+                      // ================================
+
+struct RecordCapture_ThreadHandle {
+    // This component-private struct associates a thread with its ring.
+
+    RecordCapture_Ring *d_ring_p;  // ring of the thread, or 0 (guarded by the
+                                   // registry lock for writes)
+};
+
+namespace {
+
+#ifdef BSLMT_THREAD_LOCAL_VARIABLE
+BSLMT_THREAD_LOCAL_VARIABLE(RecordCapture_ThreadHandle *,
+                            g_threadLocalHandle,
+                            0);
+    // Cache for 'bslmt::ThreadUtil::getSpecific' on supported platforms.  The
+    // memory is managed by 'bslmt::ThreadUtil' thread-specific storage.
+#endif
+
+static bslmt::QLock s_registryLock = BSLMT_QLOCK_INITIALIZER;
+    // The lock protecting the association between thread handles and rings,
+    // and the ring list of every capture.
+
+enum {
+    k_MAX_WAIT_MILLISECONDS = 100  // bound on an idle wait of the merge
+                                   // thread
+};
+
+struct DrainTarget {
+    // This struct identifies a ring and the number of records that must be
+    // dispatched from it before 'drain' returns.
+
+    const RecordCapture_Ring *d_ring_p;        // ring
+
+    int                       d_id;            // 'd_id' of the ring
+
+    bsls::Types::Uint64       d_numCommitted;  // records committed to the
+                                               // ring when 'drain' was called
+};
+
+}  // close unnamed namespace
+
+                         // ------------------------
+                         // class RecordCapture_Ring
+                         // ------------------------
+
+// CREATORS
+RecordCapture_Ring::RecordCapture_Ring(int               ringCapacity,
+                                       RecordCapture    *capture,
+                                       bslma::Allocator *basicAllocator)
+: d_numDispatched(0)
+, d_head(0)
+, d_headPad()
+, d_numCommitted(0)
+, d_tail(0)
+, d_reserved_p(0)
+, d_tailPad()
+, d_records(ringCapacity + 1, basicAllocator)
+, d_levels(ringCapacity + 1, ThresholdAggregate(), basicAllocator)
+, d_owners(ringCapacity + 1, static_cast<void *>(0), basicAllocator)
+, d_size(ringCapacity + 1)
+, d_id(0)
+, d_capture_p(capture)
+, d_handle_p(0)
+{
+}
+
+// ACCESSORS
+inline
+int RecordCapture_Ring::next(int index) const
+{
+    return d_size - 1 == index ? 0 : index + 1;
+}
+
+inline
+bool RecordCapture_Ring::isEmpty() const
+{
+    return d_head.loadAcquire() == d_tail.loadAcquire();
+}
+
+                           // -------------------
+                           // class RecordCapture
+                           // -------------------
+
+// PRIVATE CLASS METHODS
+const bslmt::ThreadUtil::Key& RecordCapture::threadHandleKey()
+{
+    static bslmt::ThreadUtil::Key s_handleKey;
+    BSLMT_ONCE_DO {
+        bslmt::ThreadUtil::createKey(&s_handleKey,
+                                     (bslmt::ThreadUtil::Destructor)
+                                     RecordCapture::releaseThreadHandle);
+    }
+    return s_handleKey;
+}
+
+RecordCapture_ThreadHandle *RecordCapture::threadHandle()
+{
+#ifdef BSLMT_THREAD_LOCAL_VARIABLE
+    if (g_threadLocalHandle) {
+        return g_threadLocalHandle;                                   // RETURN
+    }
+#endif
+
+    const bslmt::ThreadUtil::Key& key = threadHandleKey();
+
+    RecordCapture_ThreadHandle *handle =
+                                     static_cast<RecordCapture_ThreadHandle *>(
+                                          bslmt::ThreadUtil::getSpecific(key));
+
+    if (!handle) {
+        handle = new (bslma::NewDeleteAllocator::singleton())
+                                                  RecordCapture_ThreadHandle();
+        handle->d_ring_p = 0;
+
+        if (0 != bslmt::ThreadUtil::setSpecific(key, handle)) {
+            bsls::Log::platformDefaultMessageHandler(
+                bsls::LogSeverity::e_ERROR,
+                __FILE__,
+                __LINE__,
+                "Failed to add record capture handle to thread specific"
+                " storage.");
+            bslma::NewDeleteAllocator::singleton().deleteObject(handle);
+            return 0;                                                 // RETURN
+        }
+    }
+
+#ifdef BSLMT_THREAD_LOCAL_VARIABLE
+    g_threadLocalHandle = handle;
+#endif
+
+    return handle;
+}
+
+void RecordCapture::releaseThreadHandle(void *handle)
+{
+#ifdef BSLMT_THREAD_LOCAL_VARIABLE
+    g_threadLocalHandle = 0;
+#endif
+
+    RecordCapture_ThreadHandle *threadHandle =
+                             static_cast<RecordCapture_ThreadHandle *>(handle);
+    if (!threadHandle) {
+        return;                                                       // RETURN
+    }
+
+    {
+        bslmt::QLockGuard guard(&s_registryLock);
+
+        RecordCapture_Ring *ring = threadHandle->d_ring_p;
+        if (ring) {
+            Record *reserved = ring->d_reserved_p.loadRelaxed();
+            if (reserved) {
+                // The thread exited without releasing its reservation.
+
+                reserved->clear();
+                ring->d_reserved_p = 0;
+            }
+            ring->d_handle_p = 0;
+            ++ring->d_capture_p->d_generation;
+        }
+    }
+
+    bslma::NewDeleteAllocator::singleton().deleteObject(threadHandle);
+}
+
+// PRIVATE MANIPULATORS
+bool RecordCapture::dispatchOldest(
+                                const bsl::vector<RecordCapture_Ring *>& rings)
+{
+    RecordCapture_Ring *oldest = 0;
+
+    for (bsl::vector<RecordCapture_Ring *>::const_iterator it = rings.begin();
+         it != rings.end();
+         ++it) {
+        RecordCapture_Ring *ring = *it;
+        const int           head = ring->d_head.loadRelaxed();
+
+        if (head == ring->d_tail.loadAcquire()) {
+            continue;
+        }
+
+        if (0 == oldest
+         || ring->d_records[head].fixedFields().timestamp() <
+                     oldest->d_records[oldest->d_head.loadRelaxed()].
+                                                   fixedFields().timestamp()) {
+            oldest = ring;
+        }
+    }
+
+    if (0 == oldest) {
+        return false;                                                 // RETURN
+    }
+
+    const int head = oldest->d_head.loadRelaxed();
+
+    d_callback(&oldest->d_records[head],
+               oldest->d_levels[head],
+               oldest->d_owners[head]);
+
+    oldest->d_records[head].clear();
+    oldest->d_head.storeRelease(oldest->next(head));
+    oldest->d_numDispatched.storeRelease(
+                                  oldest->d_numDispatched.loadRelaxed() + 1);
+
+    return true;
+}
+
+void RecordCapture::dispatchRemaining()
+{
+    bsl::vector<RecordCapture_Ring *> rings(d_allocator_p);
+    refreshRings(&rings);
+
+    while (dispatchOldest(rings)) {
+    }
+}
+
+void RecordCapture::mergeThreadEntryPoint()
+{
+    bsl::vector<RecordCapture_Ring *> rings(d_allocator_p);
+    int                               generation = refreshRings(&rings);
+
+    while (true) {
+        if (generation != d_generation.loadAcquire()) {
+            generation = refreshRings(&rings);
+        }
+
+        if (dispatchOldest(rings)) {
+            continue;
+        }
+
+        if (!d_running) {
+            break;
+        }
+
+        d_consumerWaiting = 1;
+
+        bool isIdle = generation == d_generation && d_running;
+        for (bsl::size_t i = 0; isIdle && i < rings.size(); ++i) {
+            isIdle = rings[i]->isEmpty();
+        }
+
+        if (isIdle) {
+            d_wakeUp.timedWait(bsls::SystemTime::nowRealtimeClock() +
+                               bsls::TimeInterval(0,
+                                                  k_MAX_WAIT_MILLISECONDS *
+                                                                     1000000));
+        }
+
+        d_consumerWaiting = 0;
+
+        if (-1 == generation) {
+            generation = refreshRings(&rings);
+        }
+    }
+}
+
+RecordCapture_Ring *RecordCapture::registerRing(
+                                            RecordCapture_ThreadHandle *handle)
+{
+    RecordCapture_Ring *ring = new (*d_allocator_p) RecordCapture_Ring(
+                                                                d_ringCapacity,
+                                                                this,
+                                                                d_allocator_p);
+
+    bslmt::QLockGuard guard(&s_registryLock);
+
+    d_rings.push_back(ring);
+
+    ring->d_handle_p = handle;
+    handle->d_ring_p = ring;
+
+    ring->d_id = ++d_generation;
+
+    return ring;
+}
+
+int RecordCapture::refreshRings(bsl::vector<RecordCapture_Ring *> *rings)
+{
+    BSLS_ASSERT(rings);
+
+    bslmt::QLockGuard guard(&s_registryLock);
+
+    int  generation = d_generation;
+    bool hasOrphans = false;
+
+    for (bsl::size_t i = 0; i < d_rings.size(); ) {
+        RecordCapture_Ring *ring = d_rings[i];
+
+        if (0 == ring->d_handle_p) {
+            if (ring->isEmpty()) {
+                d_rings.erase(d_rings.begin() + i);
+                d_allocator_p->deleteObject(ring);
+                continue;
+            }
+            hasOrphans = true;
+        }
+        ++i;
+    }
+
+    *rings = d_rings;
+
+    return hasOrphans ? -1 : generation;
+}
+
+// CREATORS
+RecordCapture::RecordCapture(int                      ringCapacity,
+                             const DispatchCallback&  dispatchCallback,
+                             bslma::Allocator        *basicAllocator)
+: d_rings(basicAllocator)
+, d_generation(0)
+, d_running(false)
+, d_consumerWaiting(0)
+, d_wakeUp()
+, d_threadHandle(bslmt::ThreadUtil::invalidHandle())
+, d_ringCapacity(ringCapacity)
+, d_callback(bsl::allocator_arg_t(),
+             bsl::allocator<DispatchCallback>(basicAllocator),
+             dispatchCallback)
+, d_allocator_p(bslma::Default::allocator(basicAllocator))
+{
+    BSLS_ASSERT(0 < ringCapacity);
+}
+
+RecordCapture::~RecordCapture()
+{
+    stop();
+
+    bslmt::QLockGuard guard(&s_registryLock);
+
+    for (bsl::size_t i = 0; i < d_rings.size(); ++i) {
+        RecordCapture_Ring *ring = d_rings[i];
+
+        if (ring->d_handle_p) {
+            ring->d_handle_p->d_ring_p = 0;
+        }
+        d_allocator_p->deleteObject(ring);
+    }
+    d_rings.clear();
+}
+
+// MANIPULATORS
+int RecordCapture::start()
+{
+    if (bslmt::ThreadUtil::invalidHandle() != d_threadHandle) {
+        return 0;                                                     // RETURN
+    }
+
+    d_running = true;
+
+    bslmt::ThreadAttributes attributes;
+    int rc = bslmt::ThreadUtil::create(
+                   &d_threadHandle,
+                   attributes,
+                  bdlf::MemFnUtil::memFn(&RecordCapture::mergeThreadEntryPoint,
+                                         this));
+    if (0 != rc) {
+        d_running      = false;
+        d_threadHandle = bslmt::ThreadUtil::invalidHandle();
+    }
+    return rc;
+}
+
+void RecordCapture::stop()
+{
+    if (bslmt::ThreadUtil::invalidHandle() == d_threadHandle) {
+        return;                                                       // RETURN
+    }
+
+    d_running = false;
+    d_wakeUp.post();
+
+    bslmt::ThreadUtil::join(d_threadHandle);
+    d_threadHandle = bslmt::ThreadUtil::invalidHandle();
+
+    // Wait for the threads that reserved a record before 'd_running' was
+    // reset to commit or cancel it, and then dispatch the records committed
+    // after the merge thread exited.
+
+    while (true) {
+        bool isReserved = false;
+        {
+            bslmt::QLockGuard guard(&s_registryLock);
+
+            for (bsl::size_t i = 0; !isReserved && i < d_rings.size(); ++i) {
+                isReserved = 0 != d_rings[i]->d_reserved_p.load();
+            }
+        }
+
+        if (!isReserved) {
+            break;
+        }
+        bslmt::ThreadUtil::yield();
+    }
+
+    dispatchRemaining();
+}
+
+Record *RecordCapture::reserveRecord()
+{
+    if (!d_running.loadRelaxed()) {
+        return 0;                                                     // RETURN
+    }
+
+    RecordCapture_ThreadHandle *handle = threadHandle();
+    if (0 == handle) {
+        return 0;                                                     // RETURN
+    }
+
+    RecordCapture_Ring *ring = handle->d_ring_p;
+    if (0 == ring) {
+        ring = registerRing(handle);
+    }
+    else if (this != ring->d_capture_p || ring->d_reserved_p.loadRelaxed()) {
+        return 0;                                                     // RETURN
+    }
+
+    const int tail = ring->d_tail.loadRelaxed();
+    if (ring->next(tail) == ring->d_head.loadAcquire()) {
+        return 0;                                                     // RETURN
+    }
+
+    // Publish the reservation before checking 'd_running' again, so that
+    // either 'stop' observes the reservation and waits for it to be released,
+    // or this thread observes that the capture is stopping (see the
+    // implementation notes).
+
+    Record *record = &ring->d_records[tail];
+
+    ring->d_reserved_p = record;
+    if (!d_running) {
+        ring->d_reserved_p.storeRelaxed(0);
+        return 0;                                                     // RETURN
+    }
+
+    return record;
+}
+
+void RecordCapture::commitRecord(const ThresholdAggregate&  levels,
+                                 void                      *owner)
+{
+    RecordCapture_Ring *ring = threadHandle()->d_ring_p;
+
+    BSLS_ASSERT(ring);
+    BSLS_ASSERT(this == ring->d_capture_p);
+    BSLS_ASSERT(ring->d_reserved_p.loadRelaxed());
+
+    const int tail = ring->d_tail.loadRelaxed();
+
+    ring->d_levels[tail] = levels;
+    ring->d_owners[tail] = owner;
+
+    ring->d_tail = ring->next(tail);
+    ring->d_numCommitted.storeRelease(ring->d_numCommitted.loadRelaxed() + 1);
+    ring->d_reserved_p.storeRelease(0);
+
+    if (d_consumerWaiting && 1 == d_consumerWaiting.testAndSwap(1, 0)) {
+        d_wakeUp.post();
+    }
+}
+
+void RecordCapture::cancelRecord()
+{
+    RecordCapture_Ring *ring = threadHandle()->d_ring_p;
+
+    BSLS_ASSERT(ring);
+    BSLS_ASSERT(this == ring->d_capture_p);
+    BSLS_ASSERT(ring->d_reserved_p.loadRelaxed());
+
+    ring->d_reserved_p.loadRelaxed()->clear();
+    ring->d_reserved_p.storeRelease(0);
+}
+
+void RecordCapture::drain()
+{
+    // Snapshot the number of records committed to each ring, and wait until
+    // that many records have been dispatched from each ring, so that records
+    // committed concurrently cannot delay the return.  A ring that is no
+    // longer registered has been reclaimed, which happens only once it is
+    // empty.
+
+    bsl::vector<DrainTarget> targets(d_allocator_p);
+    {
+        bslmt::QLockGuard guard(&s_registryLock);
+
+        for (bsl::size_t i = 0; i < d_rings.size(); ++i) {
+            const RecordCapture_Ring *ring   = d_rings[i];
+            const DrainTarget         target = {
+                ring,
+                ring->d_id,
+                ring->d_numCommitted.loadAcquire()
+            };
+
+            if (ring->d_numDispatched.loadAcquire() < target.d_numCommitted) {
+                targets.push_back(target);
+            }
+        }
+    }
+
+    while (!targets.empty()) {
+        {
+            bslmt::QLockGuard guard(&s_registryLock);
+
+            for (bsl::size_t i = 0; i < targets.size(); ) {
+                const DrainTarget& target = targets[i];
+
+                bsl::vector<RecordCapture_Ring *>::const_iterator it =
+                                                 bsl::find(d_rings.begin(),
+                                                           d_rings.end(),
+                                                           target.d_ring_p);
+
+                if (d_rings.end() == it
+                 || target.d_id != (*it)->d_id
+                 || target.d_numCommitted <=
+                                       (*it)->d_numDispatched.loadAcquire()) {
+                    targets[i] = targets.back();
+                    targets.pop_back();
+                }
+                else {
+                    ++i;
+                }
+            }
+        }
+
+        if (targets.empty()) {
+            return;                                                   // RETURN
+        }
+
+        if (!d_running) {
+            // Records committed to a stopped capture are dispatched by
+            // 'stop'.
+
+            return;                                                   // RETURN
+        }
+
+        if (d_consumerWaiting && 1 == d_consumerWaiting.testAndSwap(1, 0)) {
+            d_wakeUp.post();
+        }
+        bslmt::ThreadUtil::yield();
+    }
+}
+
+// ACCESSORS
+bool RecordCapture::isReservedRecord(const Record *record) const
+{
+    RecordCapture_ThreadHandle *handle = threadHandle();
+    if (0 == handle || 0 == handle->d_ring_p) {
+        return false;                                                 // RETURN
+    }
+
+    const RecordCapture_Ring *ring = handle->d_ring_p;
+    return this == ring->d_capture_p && 0 != record
+        && record == ring->d_reserved_p.loadRelaxed();
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+// ----------------------------------------------------------------------------
+// Copyright 2020 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,340 @@
+// ball_recordcapture.h                                               -*-C++-*-
+#ifndef INCLUDED_BALL_RECORDCAPTURE
+#define INCLUDED_BALL_RECORDCAPTURE
+
+#include <bsls_ident.h>
+BSLS_IDENT("$Id: $")
+
+//@PURPOSE: Provide per-thread lock-free capture of log records.
+//
+//@CLASSES:
+//  ball::RecordCapture: per-thread record rings merged by a background thread
+//
+//@SEE_ALSO: ball_loggermanager, ball_loggermanagerconfiguration
+//
+//@DESCRIPTION: This component provides a mechanism, 'ball::RecordCapture',
+// that allows threads to log into private, preallocated, single-producer
+// single-consumer rings of 'ball::Record' objects, and that dispatches the
+// captured records from a single background "merge" thread.  A
+// 'ball::RecordCapture' object is used by 'ball::LoggerManager' when the
+// 'recordCaptureCapacity' attribute of the 'ball::LoggerManagerConfiguration'
+// supplied at construction is positive, so that the logging hot path neither
+// allocates memory nor acquires a lock shared with other logging threads.
+//
+// Each thread that calls 'reserveRecord' on a started capture is lazily
+// assigned a ring of 'ringCapacity' records (this one-time registration is
+// the only operation on the producing side that allocates memory or acquires
+// a lock).  A producing thread reserves the next free slot of its ring,
+// populates the returned record, and then either commits it along with the
+// threshold levels that apply to it and an opaque "owner" address (typically
+// the 'ball::Logger' that produced it), or cancels it.  'reserveRecord'
+// returns 0 if the ring of the calling thread is full, if the calling thread
+// already holds a reservation (e.g., when a log message is formatted by code
+// that itself logs), or if the capture is not running; callers are expected
+// to fall back to their ordinary, synchronous logging path in that case.
+//
+// The merge thread repeatedly selects, among the oldest records of all rings,
+// the one having the earliest timestamp, invokes the 'DispatchCallback'
+// supplied at construction with that record, and then returns the slot to its
+// producer.  Records produced by a single thread are therefore always
+// dispatched in the order in which they were committed; records produced by
+// different threads are dispatched in timestamp order on a best-effort basis
+// (a record committed after the merge thread has already dispatched a later
+// record from another ring is not reordered).  Note that the dispatched
+// record remains owned by the capture, and that the callback must copy any
+// part of it that is needed after the callback returns.
+//
+///Thread Safety
+///-------------
+// 'ball::RecordCapture' is *thread-safe*, meaning that 'reserveRecord',
+// 'isReservedRecord', 'commitRecord', 'cancelRecord', and 'drain' may be
+// called concurrently from any number of threads (other than the merge
+// thread, for 'drain').  'start' and the destructor must not be called
+// concurrently with any other method, and 'stop' must not be called
+// concurrently with 'start', 'stop', or 'drain'.  In particular, a record
+// reserved by another thread before 'stop' is called may be committed (or
+// cancelled) while 'stop' runs: 'stop' waits until every outstanding
+// reservation is released, so that every committed record is dispatched
+// before 'stop' returns.  A thread captures records into at most one
+// 'ball::RecordCapture' object at a time; 'reserveRecord' returns 0 on a
+// thread whose ring belongs to a different, still existing, capture.
+//
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Capturing Records
+/// - - - - - - - - - - - - - -
+// First, we define a dispatch callback that counts the captured records:
+//..
+//  void countRecord(int                             *count,
+//                   ball::Record                    *record,
+//                   const ball::ThresholdAggregate&  ,
+//                   void                            *)
+//  {
+//      assert(0 == bsl::strcmp("Hello", record->fixedFields().message()));
+//      ++*count;
+//  }
+//..
+// Then, we create a capture having rings of 16 records and start its merge
+// thread:
+//..
+//  int count = 0;
+//
+//  ball::RecordCapture capture(16,
+//                              bdlf::BindUtil::bind(&countRecord,
+//                                                   &count,
+//                                                   bdlf::PlaceHolders::_1,
+//                                                   bdlf::PlaceHolders::_2,
+//                                                   bdlf::PlaceHolders::_3));
+//  int rc = capture.start();
+//  assert(0 == rc);
+//..
+// Next, we reserve a record, populate it, and commit it:
+//..
+//  ball::Record *record = capture.reserveRecord();
+//  assert(record);
+//  assert(capture.isReservedRecord(record));
+//
+//  record->fixedFields().setMessage("Hello");
+//  capture.commitRecord(ball::ThresholdAggregate(), 0);
+//..
+// Finally, we wait for the merge thread to dispatch the record:
+//..
+//  capture.drain();
+//  assert(1 == count);
+//
+//  capture.stop();
+//..
+
+#include <balscm_version.h>
+
+#include <ball_record.h>
+#include <ball_thresholdaggregate.h>
+
+#include <bslma_allocator.h>
+#include <bslma_usesbslmaallocator.h>
+
+#include <bslmf_nestedtraitdeclaration.h>
+
+#include <bslmt_threadutil.h>
+#include <bslmt_timedsemaphore.h>
+
+#include <bsls_atomic.h>
+
+#include <bsl_functional.h>
+#include <bsl_vector.h>
+
+namespace BloombergLP {
+namespace ball {
+
+class RecordCapture_Ring;
+struct RecordCapture_ThreadHandle;
+
+                           // ===================
+                           // class RecordCapture
+                           // ===================
+
+class RecordCapture {
+    // This class provides a mechanism that captures log records into
+    // per-thread rings of preallocated records and dispatches them, in
+    // timestamp order on a best-effort basis, from a background thread.
+
+  public:
+    // TYPES
+    typedef bsl::function<void(Record                    *,
+                               const ThresholdAggregate&,
+                               void                      *)> DispatchCallback;
+        // 'DispatchCallback' is the type of the functor invoked by the merge
+        // thread for each captured record with the threshold levels and owner
+        // supplied when the record was committed.
+
+  private:
+    // DATA
+    bsl::vector<RecordCapture_Ring *>
+                          d_rings;             // registered rings (owned);
+                                               // guarded by the registry lock
+
+    bsls::AtomicInt       d_generation;        // incremented whenever
+                                               // 'd_rings' changes or a ring
+                                               // is orphaned
+
+    bsls::AtomicBool      d_running;           // 'true' while the merge
+                                               // thread is running
+
+    bsls::AtomicInt       d_consumerWaiting;   // 1 while the merge thread is
+                                               // (about to be) blocked on
+                                               // 'd_wakeUp'
+
+    bslmt::TimedSemaphore d_wakeUp;            // wakes the merge thread
+
+    bslmt::ThreadUtil::Handle
+                          d_threadHandle;      // merge thread handle
+
+    const int             d_ringCapacity;      // records per ring
+
+    DispatchCallback      d_callback;          // dispatch callback
+
+    bslma::Allocator     *d_allocator_p;       // memory allocator (held, not
+                                               // owned)
+
+  private:
+    // NOT IMPLEMENTED
+    RecordCapture(const RecordCapture&);
+    RecordCapture& operator=(const RecordCapture&);
+
+    // PRIVATE CLASS METHODS
+    static const bslmt::ThreadUtil::Key& threadHandleKey();
+        // Return a reference to the non-modifiable key of the thread-specific
+        // storage slot holding the 'RecordCapture_ThreadHandle' of each
+        // thread, creating the key on first use.
+
+    static RecordCapture_ThreadHandle *threadHandle();
+        // Return the address of the modifiable handle of the calling thread,
+        // creating it on first use, or 0 if the handle could not be stored in
+        // thread-specific storage.
+
+    static void releaseThreadHandle(void *handle);
+        // Destroy the specified 'handle' of an exiting thread, marking the
+        // ring (if any) associated with it as orphaned so that the merge
+        // thread reclaims it once empty.
+
+    // PRIVATE MANIPULATORS
+    bool dispatchOldest(const bsl::vector<RecordCapture_Ring *>& rings);
+        // Dispatch the record having the earliest timestamp among the oldest
+        // records of the specified 'rings' and release its slot.  Return
+        // 'true' if a record was dispatched, and 'false' if all 'rings' were
+        // empty.
+
+    void dispatchRemaining();
+        // Dispatch, from the calling thread, all records remaining in the
+        // registered rings.  The behavior is undefined unless the merge
+        // thread is not running.
+
+    void mergeThreadEntryPoint();
+        // Dispatch captured records until 'stop' is called.
+
+    RecordCapture_Ring *registerRing(RecordCapture_ThreadHandle *handle);
+        // Create a ring for the thread owning the specified 'handle', register
+        // it with this capture, and return its address.
+
+    int refreshRings(bsl::vector<RecordCapture_Ring *> *rings);
+        // Reclaim empty orphaned rings, load the registered rings into the
+        // specified 'rings', and return the generation to which 'rings'
+        // corresponds, or -1 if an orphaned ring could not yet be reclaimed.
+
+  public:
+    // TRAITS
+    BSLMF_NESTED_TRAIT_DECLARATION(RecordCapture, bslma::UsesBslmaAllocator);
+
+    // CREATORS
+    RecordCapture(int                      ringCapacity,
+                  const DispatchCallback&  dispatchCallback,
+                  bslma::Allocator        *basicAllocator = 0);
+        // Create a record capture whose per-thread rings hold the specified
+        // 'ringCapacity' records, and that invokes the specified
+        // 'dispatchCallback' from its merge thread for each captured record.
+        // Optionally specify a 'basicAllocator' used to supply memory.  If
+        // 'basicAllocator' is 0, the currently installed default allocator is
+        // used.  The capture is initially stopped.  The behavior is undefined
+        // unless '0 < ringCapacity'.
+
+    ~RecordCapture();
+        // Stop this capture (see 'stop') and destroy it.
+
+    // MANIPULATORS
+    int start();
+        // Start the merge thread of this capture.  Return 0 on success, and a
+        // non-zero value otherwise.  This method has no effect if the capture
+        // is already started.
+
+    void stop();
+        // Stop accepting new reservations, join the merge thread, wait until
+        // every record reserved by other threads is committed or cancelled,
+        // and dispatch all committed records.  This method has no effect if
+        // the capture is not started.  The behavior is undefined if the
+        // calling thread holds a reservation on this capture.
+
+    Record *reserveRecord();
+        // Return the address of the next free record in the ring of the
+        // calling thread, or 0 if this capture is not running, the ring is
+        // full, the calling thread already holds a reservation, or the
+        // calling thread captures into a different 'RecordCapture'.  The
+        // returned record has no custom fields and an empty message.  The
+        // calling thread must subsequently call either 'commitRecord' or
+        // 'cancelRecord'.
+
+    void commitRecord(const ThresholdAggregate& levels, void *owner);
+        // Publish the record reserved by the calling thread to the merge
+        // thread, which will invoke the dispatch callback with it and the
+        // specified 'levels' and 'owner'.  The behavior is undefined unless
+        // the calling thread holds a reservation on this capture.
+
+    void cancelRecord();
+        // Release the record reserved by the calling thread without
+        // dispatching it.  The behavior is undefined unless the calling
+        // thread holds a reservation on this capture.
+
+    void drain();
+        // Block until every record committed to this capture before the call
+        // has been dispatched.  The behavior is undefined if this method is
+        // invoked from the merge thread (e.g., from the dispatch callback).
+        // Note that records committed by other threads during the call do
+        // not delay its return.
+
+    // ACCESSORS
+    bool isReservedRecord(const Record *record) const;
+        // Return 'true' if the specified 'record' is the record currently
+        // reserved by the calling thread on this capture, and 'false'
+        // otherwise.
+
+    bool isRunning() const;
+        // Return 'true' if the merge thread of this capture is running, and
+        // 'false' otherwise.
+
+    int ringCapacity() const;
+        // Return the number of records in each per-thread ring of this
+        // capture.
+};
+
+// ============================================================================
+//                              INLINE DEFINITIONS
+// ============================================================================
+
+                           // -------------------
+                           // class RecordCapture
+                           // -------------------
+
+// ACCESSORS
+inline
+bool RecordCapture::isRunning() const
+{
+    return d_running;
+}
+
+inline
+int RecordCapture::ringCapacity() const
+{
+    return d_ringCapacity;
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2020 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
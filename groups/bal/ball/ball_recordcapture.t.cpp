@@ -0,0 +1,1075 @@
+// ball_recordcapture.t.cpp                                           -*-C++-*-
+#include <ball_recordcapture.h>
+
+#include <ball_record.h>
+#include <ball_recordattributes.h>
+#include <ball_thresholdaggregate.h>
+#include <ball_userfields.h>
+
+#include <bdlf_bind.h>
+#include <bdlf_placeholder.h>
+
+#include <bdlt_currenttime.h>
+#include <bdlt_datetime.h>
+
+#include <bslim_testutil.h>
+
+#include <bslma_default.h>
+#include <bslma_defaultallocatorguard.h>
+#include <bslma_testallocator.h>
+
+#include <bslmt_barrier.h>
+#include <bslmt_lockguard.h>
+#include <bslmt_mutex.h>
+#include <bslmt_semaphore.h>
+#include <bslmt_threadgroup.h>
+#include <bslmt_threadutil.h>
+
+#include <bsls_atomic.h>
+#include <bsls_review.h>
+#include <bsls_stopwatch.h>
+#include <bsls_types.h>
+
+#include <bsl_cstdio.h>
+#include <bsl_cstdlib.h>
+#include <bsl_cstring.h>
+#include <bsl_iostream.h>
+#include <bsl_string.h>
+#include <bsl_vector.h>
+
+using namespace BloombergLP;
+using namespace bsl;
+
+// ============================================================================
+//                                   TEST PLAN
+// ----------------------------------------------------------------------------
+//                                   Overview
+//                                   --------
+// The component under test is a mechanism that captures records into
+// per-thread rings and dispatches them from a merge thread.  We verify that
+// reservations fail when they must (capture stopped, reservation outstanding,
+// ring full), that committed records are dispatched exactly once with the
+// supplied levels and owner and in per-thread order, that the merge thread
+// prefers the record having the earliest timestamp, that 'stop' dispatches
+// every committed record, and that the rings of exited threads are reclaimed.
+// ----------------------------------------------------------------------------
+// CREATORS
+// [ 1] RecordCapture(int, const DispatchCallback&, bslma::Allocator *);
+// [ 1] ~RecordCapture();
+//
+// MANIPULATORS
+// [ 1] int start();
+// [ 5] void stop();
+// [ 2] Record *reserveRecord();
+// [ 1] void commitRecord(const ThresholdAggregate& levels, void *owner);
+// [ 2] void cancelRecord();
+// [ 1] void drain();
+//
+// ACCESSORS
+// [ 2] bool isReservedRecord(const Record *record) const;
+// [ 1] bool isRunning() const;
+// [ 1] int ringCapacity() const;
+// ----------------------------------------------------------------------------
+// [ 1] BREATHING TEST
+// [ 3] CONCURRENT PRODUCERS
+// [ 4] TIMESTAMP ORDERING
+// [ 6] RECLAIMING THE RINGS OF EXITED THREADS
+// [ 7] USAGE EXAMPLE
+// [-1] PERFORMANCE: RESERVE AND COMMIT THROUGHPUT
+
+// ============================================================================
+//                     STANDARD BDE ASSERT TEST FUNCTION
+// ----------------------------------------------------------------------------
+
+namespace {
+
+int testStatus = 0;
+
+void aSsErT(bool condition, const char *message, int line)
+{
+    if (condition) {
+        cout << "Error " __FILE__ "(" << line << "): " << message
+             << "    (failed)" << endl;
+
+        if (0 <= testStatus && testStatus <= 100) {
+            ++testStatus;
+        }
+    }
+}
+
+}  // close unnamed namespace
+
+// ============================================================================
+//               STANDARD BDE TEST DRIVER MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT       BSLIM_TESTUTIL_ASSERT
+#define ASSERTV      BSLIM_TESTUTIL_ASSERTV
+
+#define LOOP_ASSERT  BSLIM_TESTUTIL_LOOP_ASSERT
+#define LOOP0_ASSERT BSLIM_TESTUTIL_LOOP0_ASSERT
+#define LOOP1_ASSERT BSLIM_TESTUTIL_LOOP1_ASSERT
+#define LOOP2_ASSERT BSLIM_TESTUTIL_LOOP2_ASSERT
+#define LOOP3_ASSERT BSLIM_TESTUTIL_LOOP3_ASSERT
+#define LOOP4_ASSERT BSLIM_TESTUTIL_LOOP4_ASSERT
+#define LOOP5_ASSERT BSLIM_TESTUTIL_LOOP5_ASSERT
+#define LOOP6_ASSERT BSLIM_TESTUTIL_LOOP6_ASSERT
+
+#define Q            BSLIM_TESTUTIL_Q   // Quote identifier literally.
+#define P            BSLIM_TESTUTIL_P   // Print identifier and value.
+#define P_           BSLIM_TESTUTIL_P_  // P(X) without '\n'.
+#define T_           BSLIM_TESTUTIL_T_  // Print a tab (w/o newline).
+#define L_           BSLIM_TESTUTIL_L_  // current Line number
+
+// ============================================================================
+//                  GLOBAL TYPEDEFS/CONSTANTS FOR TESTING
+// ----------------------------------------------------------------------------
+
+typedef ball::RecordCapture Obj;
+
+// ============================================================================
+//                          HELPER CLASSES FOR TESTING
+// ----------------------------------------------------------------------------
+
+namespace {
+
+class RecordCollector {
+    // This class provides a dispatch callback that records the message,
+    // user-supplied sequence number, pass level, and owner of each dispatched
+    // record, and that can be blocked to keep the merge thread busy.
+
+    // DATA
+    mutable bslmt::Mutex d_mutex;
+    bsl::vector<bsl::string>
+                         d_messages;
+    bsl::vector<int>     d_passLevels;
+    bsl::vector<void *>  d_owners;
+    bsls::AtomicInt      d_isBlocked;
+    bslmt::Semaphore     d_entered;
+    bslmt::Semaphore     d_release;
+
+  public:
+    // CREATORS
+    explicit
+    RecordCollector(bslma::Allocator *basicAllocator)
+    : d_messages(basicAllocator)
+    , d_passLevels(basicAllocator)
+    , d_owners(basicAllocator)
+    , d_isBlocked(0)
+    {
+    }
+
+    // MANIPULATORS
+    void block()
+        // Block the next invocation of 'dispatch' until 'release' is called.
+    {
+        d_isBlocked = 1;
+    }
+
+    void dispatch(ball::Record                    *record,
+                  const ball::ThresholdAggregate&  levels,
+                  void                            *owner)
+    {
+        if (1 == d_isBlocked.testAndSwap(1, 0)) {
+            d_entered.post();
+            d_release.wait();
+        }
+
+        bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+        d_messages.push_back(record->fixedFields().message());
+        d_passLevels.push_back(levels.passLevel());
+        d_owners.push_back(owner);
+    }
+
+    void release()
+        // Release a blocked invocation of 'dispatch'.
+    {
+        d_release.post();
+    }
+
+    void waitUntilBlocked()
+        // Wait until an invocation of 'dispatch' is blocked.
+    {
+        d_entered.wait();
+    }
+
+    // ACCESSORS
+    bsl::string message(int index) const
+    {
+        bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+        return d_messages[index];
+    }
+
+    int numRecords() const
+    {
+        bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+        return static_cast<int>(d_messages.size());
+    }
+
+    void *owner(int index) const
+    {
+        bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+        return d_owners[index];
+    }
+
+    int passLevel(int index) const
+    {
+        bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+        return d_passLevels[index];
+    }
+};
+
+Obj::DispatchCallback makeCallback(RecordCollector *collector)
+    // Return a dispatch callback forwarding to the specified 'collector'.
+{
+    return bdlf::BindUtil::bind(&RecordCollector::dispatch,
+                                collector,
+                                bdlf::PlaceHolders::_1,
+                                bdlf::PlaceHolders::_2,
+                                bdlf::PlaceHolders::_3);
+}
+
+void capture(Obj *object, const char *message, int passLevel = 0)
+    // Reserve a record from the specified 'object', set its message to the
+    // specified 'message' and its timestamp to the current time, and commit
+    // it with the optionally specified 'passLevel', spinning while the ring
+    // of the calling thread is full.
+{
+    ball::Record *record;
+    while (0 == (record = object->reserveRecord())) {
+        bslmt::ThreadUtil::yield();
+    }
+    record->fixedFields().setTimestamp(bdlt::CurrentTime::utc());
+    record->fixedFields().setMessage(message);
+    object->commitRecord(ball::ThresholdAggregate(0, passLevel, 0, 0), 0);
+}
+
+                        // ============================
+                        // struct ProducerThreadArgs
+                        // ============================
+
+struct ProducerThreadArgs {
+    // Arguments of 'producerThread'.
+
+    Obj             *d_capture_p;
+    int              d_id;
+    int              d_numRecords;
+    bslmt::Barrier  *d_barrier_p;
+};
+
+void producerThread(ProducerThreadArgs *args)
+    // Capture 'args->d_numRecords' records whose messages are
+    // "<id>:<sequence number>" into 'args->d_capture_p'.
+{
+    args->d_barrier_p->wait();
+
+    for (int i = 0; i < args->d_numRecords; ++i) {
+        char buffer[32];
+        bsl::sprintf(buffer, "%d:%d", args->d_id, i);
+        capture(args->d_capture_p, buffer);
+    }
+}
+
+                        // ==========================
+                        // struct RacingProducerArgs
+                        // ==========================
+
+struct RacingProducerArgs {
+    // Arguments of 'racingProducerThread'.
+
+    Obj             *d_capture_p;
+    int              d_numCommitted;
+    bslmt::Barrier  *d_barrier_p;
+};
+
+void racingProducerThread(RacingProducerArgs *args)
+    // Capture records into 'args->d_capture_p' until the capture is stopped,
+    // yielding between the reservation and the commit of each record, and
+    // load into 'args->d_numCommitted' the number of records committed.
+{
+    args->d_numCommitted = 0;
+    args->d_barrier_p->wait();
+
+    while (true) {
+        ball::Record *record = args->d_capture_p->reserveRecord();
+        if (0 == record) {
+            if (!args->d_capture_p->isRunning()) {
+                break;
+            }
+            bslmt::ThreadUtil::yield();
+            continue;
+        }
+        record->fixedFields().setTimestamp(bdlt::CurrentTime::utc());
+        record->fixedFields().setMessage("racing");
+        bslmt::ThreadUtil::yield();
+        args->d_capture_p->commitRecord(ball::ThresholdAggregate(), 0);
+        ++args->d_numCommitted;
+    }
+}
+
+void stoppingThread(Obj *object, bsls::AtomicInt *isStopped)
+    // Stop the specified 'object' and then set the specified 'isStopped' to
+    // 1.
+{
+    object->stop();
+    *isStopped = 1;
+}
+
+void exitingThread(Obj *object)
+    // Capture a single record into the specified 'object' and exit.
+{
+    capture(object, "exiting");
+}
+
+void noopCallback(ball::Record *, const ball::ThresholdAggregate&, void *)
+    // Do nothing.
+{
+}
+
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Capturing Records
+/// - - - - - - - - - - - - - -
+// First, we define a dispatch callback that counts the captured records:
+//..
+    void countRecord(int                             *count,
+                     ball::Record                    *record,
+                     const ball::ThresholdAggregate&  ,
+                     void                            *)
+    {
+        ASSERT(0 == bsl::strcmp("Hello", record->fixedFields().message()));
+        ++*count;
+    }
+//..
+
+}  // close unnamed namespace
+
+// ============================================================================
+//                               MAIN PROGRAM
+// ----------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    const int                 test = argc > 1 ? atoi(argv[1]) : 0;
+    const bool             verbose = argc > 2;
+    const bool         veryVerbose = argc > 3;
+    const bool     veryVeryVerbose = argc > 4;
+    const bool veryVeryVeryVerbose = argc > 5;
+
+    (void)veryVerbose;
+    (void)veryVeryVerbose;
+
+    cout << "TEST " << __FILE__ << " CASE " << test << endl;
+
+    // CONCERN: 'BSLS_REVIEW' failures should lead to test failures.
+    bsls::ReviewFailureHandlerGuard reviewGuard(&bsls::Review::failByAbort);
+
+    bslma::TestAllocator defaultAllocator("default", veryVeryVeryVerbose);
+    bslma::DefaultAllocatorGuard guard(&defaultAllocator);
+
+    switch (test) { case 0:
+      case 7: {
+        // --------------------------------------------------------------------
+        // USAGE EXAMPLE
+        //   Extracted from component header file.
+        //
+        // Concerns:
+        //: 1 The usage example provided in the component header file compiles,
+        //:   links, and runs as shown.
+        //
+        // Plan:
+        //: 1 Incorporate usage example from header into test driver, remove
+        //:   leading comment characters, and replace 'assert' with 'ASSERT'.
+        //:   (C-1)
+        //
+        // Testing:
+        //   USAGE EXAMPLE
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "USAGE EXAMPLE" << endl
+                          << "=============" << endl;
+
+// Then, we create a capture having rings of 16 records and start its merge
+// thread:
+//..
+    int count = 0;
+
+    ball::RecordCapture capture(16,
+                                bdlf::BindUtil::bind(&countRecord,
+                                                     &count,
+                                                     bdlf::PlaceHolders::_1,
+                                                     bdlf::PlaceHolders::_2,
+                                                     bdlf::PlaceHolders::_3));
+    int rc = capture.start();
+    ASSERT(0 == rc);
+//..
+// Next, we reserve a record, populate it, and commit it:
+//..
+    ball::Record *record = capture.reserveRecord();
+    ASSERT(record);
+    ASSERT(capture.isReservedRecord(record));
+
+    record->fixedFields().setMessage("Hello");
+    capture.commitRecord(ball::ThresholdAggregate(), 0);
+//..
+// Finally, we wait for the merge thread to dispatch the record:
+//..
+    capture.drain();
+    ASSERT(1 == count);
+
+    capture.stop();
+//..
+      } break;
+      case 6: {
+        // --------------------------------------------------------------------
+        // RECLAIMING THE RINGS OF EXITED THREADS
+        //
+        // Concerns:
+        //: 1 The records captured by a thread that has exited are dispatched.
+        //:
+        //: 2 The ring of an exited thread is released by the merge thread.
+        //:
+        //: 3 A capture destroyed while a thread still holds a ring does not
+        //:   prevent that thread from capturing into another capture.
+        //
+        // Plan:
+        //: 1 Capture one record from each of several short-lived threads, and
+        //:   verify that every record is dispatched and that the memory in
+        //:   use by the capture eventually returns to (nearly) its value
+        //:   before the threads were created.  (C-1..2)
+        //:
+        //: 2 Capture from the main thread into a capture, destroy it, and
+        //:   capture from the main thread into a second capture.  (C-3)
+        //
+        // Testing:
+        //   RECLAIMING THE RINGS OF EXITED THREADS
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "RECLAIMING THE RINGS OF EXITED THREADS" << endl
+                          << "======================================" << endl;
+
+        bslma::TestAllocator ta("object", veryVeryVeryVerbose);
+
+        {
+            RecordCollector collector(&ta);
+
+            Obj mX(4, makeCallback(&collector), &ta);
+            ASSERT(0 == mX.start());
+
+            // Register the ring of the main thread to estimate the memory
+            // used by a single ring.
+
+            const bsls::Types::Int64 initial = ta.numBytesInUse();
+            capture(&mX, "main");
+            mX.drain();
+
+            const bsls::Types::Int64 baseline = ta.numBytesInUse();
+            const bsls::Types::Int64 ringSize = baseline - initial;
+
+            enum { k_NUM_THREADS = 8 };
+
+            for (int i = 0; i < k_NUM_THREADS; ++i) {
+                bslmt::ThreadUtil::Handle handle;
+                ASSERT(0 == bslmt::ThreadUtil::create(
+                                     &handle,
+                                     bdlf::BindUtil::bind(&exitingThread,
+                                                          &mX)));
+                ASSERT(0 == bslmt::ThreadUtil::join(handle));
+            }
+
+            mX.drain();
+            ASSERTV(collector.numRecords(),
+                    k_NUM_THREADS + 1 == collector.numRecords());
+
+            // Allow for the growth of the ring lists, but not for a ring.
+
+            const bsls::Types::Int64 limit = baseline + ringSize / 2;
+            for (int i = 0; i < 200 && limit < ta.numBytesInUse(); ++i) {
+                bslmt::ThreadUtil::microSleep(10 * 1000);
+            }
+            ASSERTV(baseline, ringSize, ta.numBytesInUse(),
+                    limit >= ta.numBytesInUse());
+        }
+        ASSERTV(ta.numBlocksInUse(), 0 == ta.numBlocksInUse());
+
+        RecordCollector collector(&ta);
+        {
+            Obj mX(4, makeCallback(&collector), &ta);
+            ASSERT(0 == mX.start());
+            capture(&mX, "first");
+        }
+        {
+            Obj mY(4, makeCallback(&collector), &ta);
+            ASSERT(0 == mY.start());
+
+            ball::Record *record = mY.reserveRecord();
+            ASSERT(0 != record);
+            if (record) {
+                mY.cancelRecord();
+            }
+            capture(&mY, "second");
+        }
+        ASSERTV(collector.numRecords(), 2 == collector.numRecords());
+      } break;
+      case 5: {
+        // --------------------------------------------------------------------
+        // TESTING 'stop'
+        //
+        // Concerns:
+        //: 1 'stop' dispatches every committed record before returning.
+        //:
+        //: 2 After 'stop', 'reserveRecord' returns 0.
+        //:
+        //: 3 A capture can be restarted after 'stop'.
+        //:
+        //: 4 'stop' on a capture that is not started has no effect.
+        //:
+        //: 5 A record reserved by another thread before 'stop' is called, and
+        //:   committed while 'stop' runs, is dispatched before 'stop'
+        //:   returns.
+        //:
+        //: 6 Every record committed by threads racing with 'stop' is
+        //:   dispatched.
+        //
+        // Plan:
+        //: 1 Block the merge thread in the dispatch callback, commit several
+        //:   records, release the callback from another thread, and verify
+        //:   that 'stop' returns only after all records are dispatched.
+        //:   (C-1..2)
+        //:
+        //: 2 Restart the capture and capture another record.  (C-3)
+        //:
+        //: 3 Invoke 'stop' twice.  (C-4)
+        //:
+        //: 4 Reserve a record, call 'stop' from another thread, verify that
+        //:   'stop' does not return while the reservation is held, and then
+        //:   commit the record and verify that it is dispatched.  (C-5)
+        //:
+        //: 5 Start several threads that capture records until the capture is
+        //:   stopped, stop the capture, and verify that the number of
+        //:   dispatched records is the number of records the threads
+        //:   committed.  (C-6)
+        //
+        // Testing:
+        //   void stop();
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "TESTING 'stop'" << endl
+                          << "==============" << endl;
+
+        bslma::TestAllocator ta("object", veryVeryVeryVerbose);
+
+        RecordCollector collector(&ta);
+
+        Obj mX(8, makeCallback(&collector), &ta);  const Obj& X = mX;
+
+        mX.stop();
+        ASSERT(!X.isRunning());
+
+        ASSERT(0 == mX.start());
+
+        collector.block();
+        capture(&mX, "0");
+        collector.waitUntilBlocked();
+
+        capture(&mX, "1");
+        capture(&mX, "2");
+        capture(&mX, "3");
+
+        collector.release();
+        mX.stop();
+
+        ASSERTV(collector.numRecords(), 4 == collector.numRecords());
+        ASSERT(!X.isRunning());
+        ASSERT(0 == mX.reserveRecord());
+
+        ASSERT(0 == mX.start());
+        ASSERT(X.isRunning());
+        capture(&mX, "4");
+        mX.stop();
+        mX.stop();
+
+        ASSERTV(collector.numRecords(), 5 == collector.numRecords());
+        for (int i = 0; i < collector.numRecords(); ++i) {
+            char expected[16];
+            bsl::sprintf(expected, "%d", i);
+            ASSERTV(i, collector.message(i), expected == collector.message(i));
+        }
+
+        if (verbose) cout << "\tCommitting while 'stop' runs." << endl;
+        {
+            ASSERT(0 == mX.start());
+
+            ball::Record *record = mX.reserveRecord();
+            ASSERT(0 != record);
+
+            bsls::AtomicInt           isStopped(0);
+            bslmt::ThreadUtil::Handle handle;
+            ASSERT(0 == bslmt::ThreadUtil::create(
+                                 &handle,
+                                 bdlf::BindUtil::bind(&stoppingThread,
+                                                      &mX,
+                                                      &isStopped)));
+
+            while (X.isRunning()) {
+                bslmt::ThreadUtil::yield();
+            }
+            bslmt::ThreadUtil::microSleep(50 * 1000);
+            ASSERT(0 == isStopped);
+
+            if (record) {
+                record->fixedFields().setMessage("5");
+                mX.commitRecord(ball::ThresholdAggregate(), 0);
+            }
+            ASSERT(0 == bslmt::ThreadUtil::join(handle));
+            ASSERT(1 == isStopped);
+
+            ASSERTV(collector.numRecords(), 6 == collector.numRecords());
+            ASSERTV(collector.message(5), "5" == collector.message(5));
+        }
+
+        if (verbose) cout << "\tProducers racing with 'stop'." << endl;
+        {
+            enum { k_NUM_THREADS = 4, k_NUM_ITERATIONS = 20 };
+
+            for (int i = 0; i < k_NUM_ITERATIONS; ++i) {
+                RecordCollector racing(&ta);
+
+                Obj mY(8, makeCallback(&racing), &ta);
+                ASSERT(0 == mY.start());
+
+                bslmt::Barrier     barrier(k_NUM_THREADS + 1);
+                RacingProducerArgs args[k_NUM_THREADS];
+                bslmt::ThreadGroup group(&ta);
+
+                for (int j = 0; j < k_NUM_THREADS; ++j) {
+                    args[j].d_capture_p = &mY;
+                    args[j].d_barrier_p = &barrier;
+                    ASSERT(0 == group.addThread(
+                                    bdlf::BindUtil::bind(&racingProducerThread,
+                                                         &args[j])));
+                }
+
+                barrier.wait();
+                bslmt::ThreadUtil::microSleep(1000 * (i % 4));
+                mY.stop();
+                group.joinAll();
+
+                int numCommitted = 0;
+                for (int j = 0; j < k_NUM_THREADS; ++j) {
+                    numCommitted += args[j].d_numCommitted;
+                }
+                ASSERTV(i, numCommitted, racing.numRecords(),
+                        numCommitted == racing.numRecords());
+            }
+        }
+      } break;
+      case 4: {
+        // --------------------------------------------------------------------
+        // TIMESTAMP ORDERING
+        //
+        // Concerns:
+        //: 1 Among the records available to the merge thread, the record
+        //:   having the earliest timestamp is dispatched first.
+        //
+        // Plan:
+        //: 1 Block the merge thread in the dispatch callback.  Commit, from a
+        //:   second thread, a record timestamped later than a record then
+        //:   committed from the main thread.  Release the callback and verify
+        //:   the dispatch order.  (C-1)
+        //
+        // Testing:
+        //   TIMESTAMP ORDERING
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "TIMESTAMP ORDERING" << endl
+                          << "==================" << endl;
+
+        bslma::TestAllocator ta("object", veryVeryVeryVerbose);
+
+        RecordCollector collector(&ta);
+
+        Obj mX(8, makeCallback(&collector), &ta);
+        ASSERT(0 == mX.start());
+
+        collector.block();
+        capture(&mX, "blocker");
+        collector.waitUntilBlocked();
+
+        const bdlt::Datetime EARLY(2020, 1, 1, 0, 0, 0);
+        const bdlt::Datetime LATE(2020, 1, 1, 0, 0, 1);
+
+        bslmt::ThreadUtil::Handle handle;
+        ASSERT(0 == bslmt::ThreadUtil::create(
+                                     &handle,
+                                     bdlf::BindUtil::bind(&exitingThread,
+                                                          &mX)));
+        ASSERT(0 == bslmt::ThreadUtil::join(handle));
+
+        for (int i = 0; i < 2; ++i) {
+            ball::Record *record = mX.reserveRecord();
+            ASSERT(record);
+            record->fixedFields().setTimestamp(0 == i ? EARLY : LATE);
+            record->fixedFields().setMessage(0 == i ? "early" : "late");
+            mX.commitRecord(ball::ThresholdAggregate(), 0);
+        }
+
+        collector.release();
+        mX.drain();
+
+        ASSERTV(collector.numRecords(), 4 == collector.numRecords());
+        if (4 == collector.numRecords()) {
+            ASSERTV(collector.message(0), "blocker" == collector.message(0));
+            ASSERTV(collector.message(1), "early"   == collector.message(1));
+            ASSERTV(collector.message(2), "late"    == collector.message(2));
+            ASSERTV(collector.message(3), "exiting" == collector.message(3));
+        }
+      } break;
+      case 3: {
+        // --------------------------------------------------------------------
+        // CONCURRENT PRODUCERS
+        //
+        // Concerns:
+        //: 1 Every record committed by concurrent producers is dispatched
+        //:   exactly once.
+        //:
+        //: 2 The records of each producer are dispatched in the order in
+        //:   which they were committed.
+        //:
+        //: 3 'drain' returns, having dispatched the records committed before
+        //:   it was called, while other threads commit records continuously.
+        //
+        // Plan:
+        //: 1 Capture a series of sequence-numbered records from several
+        //:   threads into small rings, and verify the dispatched records.
+        //:   (C-1..2)
+        //:
+        //: 2 Start several threads that capture records until the capture is
+        //:   stopped.  Repeatedly capture a record from the main thread, call
+        //:   'drain', and verify that the record has been dispatched.  (C-3)
+        //
+        // Testing:
+        //   CONCURRENT PRODUCERS
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "CONCURRENT PRODUCERS" << endl
+                          << "====================" << endl;
+
+        bslma::TestAllocator ta("object", veryVeryVeryVerbose);
+
+        enum { k_NUM_THREADS = 6, k_NUM_RECORDS = 2000 };
+
+        RecordCollector collector(&ta);
+
+        Obj mX(16, makeCallback(&collector), &ta);
+        ASSERT(0 == mX.start());
+
+        bslmt::Barrier     barrier(k_NUM_THREADS);
+        ProducerThreadArgs args[k_NUM_THREADS];
+        bslmt::ThreadGroup group(&ta);
+
+        for (int i = 0; i < k_NUM_THREADS; ++i) {
+            args[i].d_capture_p  = &mX;
+            args[i].d_id         = i;
+            args[i].d_numRecords = k_NUM_RECORDS;
+            args[i].d_barrier_p  = &barrier;
+            ASSERT(0 == group.addThread(
+                             bdlf::BindUtil::bind(&producerThread, args + i)));
+        }
+        group.joinAll();
+        mX.drain();
+
+        ASSERTV(collector.numRecords(),
+                k_NUM_THREADS * k_NUM_RECORDS == collector.numRecords());
+
+        int next[k_NUM_THREADS] = { 0 };
+        for (int i = 0; i < collector.numRecords(); ++i) {
+            int id;
+            int sequence;
+            ASSERT(2 == bsl::sscanf(collector.message(i).c_str(),
+                                    "%d:%d",
+                                    &id,
+                                    &sequence));
+            ASSERTV(id, 0 <= id && id < k_NUM_THREADS);
+            if (0 <= id && id < k_NUM_THREADS) {
+                ASSERTV(id, sequence, next[id], next[id] == sequence);
+                next[id] = sequence + 1;
+            }
+        }
+
+        if (verbose) cout << "\tDraining while producers commit." << endl;
+        {
+            enum { k_NUM_ITERATIONS = 20 };
+
+            RecordCollector racing(&ta);
+
+            Obj mY(16, makeCallback(&racing), &ta);
+            ASSERT(0 == mY.start());
+
+            bslmt::Barrier     barrier(k_NUM_THREADS + 1);
+            RacingProducerArgs args[k_NUM_THREADS];
+            bslmt::ThreadGroup group(&ta);
+
+            for (int i = 0; i < k_NUM_THREADS; ++i) {
+                args[i].d_capture_p = &mY;
+                args[i].d_barrier_p = &barrier;
+                ASSERT(0 == group.addThread(
+                                    bdlf::BindUtil::bind(&racingProducerThread,
+                                                         &args[i])));
+            }
+            barrier.wait();
+
+            for (int i = 0; i < k_NUM_ITERATIONS; ++i) {
+                char marker[16];
+                bsl::sprintf(marker, "marker %d", i);
+                capture(&mY, marker);
+
+                mY.drain();
+
+                bool found = false;
+                for (int j = racing.numRecords() - 1; !found && 0 <= j; --j) {
+                    found = marker == racing.message(j);
+                }
+                ASSERTV(i, found);
+            }
+
+            mY.stop();
+            group.joinAll();
+        }
+      } break;
+      case 2: {
+        // --------------------------------------------------------------------
+        // TESTING 'reserveRecord' AND 'cancelRecord'
+        //
+        // Concerns:
+        //: 1 'reserveRecord' returns 0 if the capture is not running.
+        //:
+        //: 2 'reserveRecord' returns 0 while a reservation is outstanding.
+        //:
+        //: 3 'reserveRecord' returns 0 when the ring of the calling thread is
+        //:   full, and succeeds again once a record has been dispatched.
+        //:
+        //: 4 'isReservedRecord' identifies exactly the reserved record.
+        //:
+        //: 5 'cancelRecord' releases the reservation without dispatching the
+        //:   record, and clears the record.
+        //
+        // Plan:
+        //: 1 Exercise each condition directly, blocking the merge thread in
+        //:   the dispatch callback to fill the ring.  (C-1..5)
+        //
+        // Testing:
+        //   Record *reserveRecord();
+        //   void cancelRecord();
+        //   bool isReservedRecord(const Record *record) const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "TESTING 'reserveRecord' AND 'cancelRecord'"
+                          << endl
+                          << "=========================================="
+                          << endl;
+
+        bslma::TestAllocator ta("object", veryVeryVeryVerbose);
+
+        enum { k_CAPACITY = 4 };
+
+        RecordCollector collector(&ta);
+
+        Obj mX(k_CAPACITY, makeCallback(&collector), &ta);
+        const Obj& X = mX;
+
+        ASSERT(0 == mX.reserveRecord());
+
+        ASSERT(0 == mX.start());
+
+        ball::Record *record = mX.reserveRecord();
+        ASSERT(0 != record);
+        ASSERT( X.isReservedRecord(record));
+        ASSERT(!X.isReservedRecord(0));
+        ball::Record other(&ta);
+        ASSERT(!X.isReservedRecord(&other));
+
+        ASSERT(0 == mX.reserveRecord());
+
+        record->fixedFields().setMessage("cancelled");
+        record->customFields().appendInt64(1);
+        mX.cancelRecord();
+        ASSERT(!X.isReservedRecord(record));
+        ASSERT(0 == bsl::strlen(record->fixedFields().message()));
+        ASSERT(0 == record->customFields().length());
+
+        collector.block();
+        capture(&mX, "0", 1);
+        collector.waitUntilBlocked();
+
+        for (int i = 1; i < k_CAPACITY; ++i) {
+            record = mX.reserveRecord();
+            ASSERTV(i, 0 != record);
+            if (record) {
+                record->fixedFields().setMessage("x");
+                mX.commitRecord(ball::ThresholdAggregate(), &other);
+            }
+        }
+
+        ASSERT(0 == mX.reserveRecord());
+
+        collector.release();
+        mX.drain();
+
+        ASSERTV(collector.numRecords(),
+                k_CAPACITY == collector.numRecords());
+        ASSERT("0" == collector.message(0));
+        ASSERT(1 == collector.passLevel(0));
+        ASSERT(0 == collector.owner(0));
+        ASSERT(&other == collector.owner(1));
+
+        record = mX.reserveRecord();
+        ASSERT(0 != record);
+        if (record) {
+            mX.cancelRecord();
+        }
+      } break;
+      case 1: {
+        // --------------------------------------------------------------------
+        // BREATHING TEST
+        //   This case exercises (but does not fully test) basic functionality.
+        //
+        // Concerns:
+        //: 1 The class is sufficiently functional to enable comprehensive
+        //:   testing in subsequent test cases.
+        //
+        // Plan:
+        //: 1 Create a capture, capture and drain a few records, and verify
+        //:   that they are dispatched with the supplied levels, and that all
+        //:   memory is supplied by the object allocator.  (C-1)
+        //
+        // Testing:
+        //   BREATHING TEST
+        //   RecordCapture(int, const DispatchCallback&, bslma::Allocator *);
+        //   ~RecordCapture();
+        //   int start();
+        //   void commitRecord(const ThresholdAggregate& levels, void *owner);
+        //   void drain();
+        //   bool isRunning() const;
+        //   int ringCapacity() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "BREATHING TEST" << endl
+                          << "==============" << endl;
+
+        bslma::TestAllocator ta("object", veryVeryVeryVerbose);
+        {
+            RecordCollector collector(&ta);
+
+            Obj mX(8, makeCallback(&collector), &ta);  const Obj& X = mX;
+
+            ASSERT(8 == X.ringCapacity());
+            ASSERT(!X.isRunning());
+
+            ASSERT(0 == mX.start());
+            ASSERT(X.isRunning());
+            ASSERT(0 == mX.start());
+
+            for (int i = 0; i < 20; ++i) {
+                capture(&mX, "hello", i + 1);
+            }
+            mX.drain();
+
+            ASSERTV(collector.numRecords(), 20 == collector.numRecords());
+            for (int i = 0; i < collector.numRecords(); ++i) {
+                ASSERTV(i, "hello" == collector.message(i));
+                ASSERTV(i, i + 1 == collector.passLevel(i));
+            }
+        }
+        ASSERTV(ta.numBlocksInUse(), 0 == ta.numBlocksInUse());
+      } break;
+      case -1: {
+        // --------------------------------------------------------------------
+        // PERFORMANCE: RESERVE AND COMMIT THROUGHPUT
+        //
+        // Concerns:
+        //: 1 Capturing records scales with the number of producing threads.
+        //
+        // Plan:
+        //: 1 For 1, 2, 4, and 8 threads, capture a fixed number of records per
+        //:   thread having a short message, and report the aggregate rate.
+        //
+        // Testing:
+        //   PERFORMANCE: RESERVE AND COMMIT THROUGHPUT
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "PERFORMANCE: RESERVE AND COMMIT THROUGHPUT"
+                          << endl
+                          << "=========================================="
+                          << endl;
+
+        enum { k_NUM_RECORDS = 200000 };
+
+        for (int numThreads = 1; numThreads <= 8; numThreads *= 2) {
+            Obj mX(1024, &noopCallback);
+            ASSERT(0 == mX.start());
+
+            bslmt::Barrier     barrier(numThreads + 1);
+            ProducerThreadArgs args[8];
+            bslmt::ThreadGroup group;
+
+            for (int i = 0; i < numThreads; ++i) {
+                args[i].d_capture_p  = &mX;
+                args[i].d_id         = i;
+                args[i].d_numRecords = k_NUM_RECORDS;
+                args[i].d_barrier_p  = &barrier;
+                group.addThread(bdlf::BindUtil::bind(&producerThread,
+                                                     args + i));
+            }
+
+            bsls::Stopwatch timer;
+            timer.start();
+            barrier.wait();
+            group.joinAll();
+            mX.drain();
+            timer.stop();
+
+            cout << "threads: " << numThreads
+                 << "  records/s: "
+                 << static_cast<bsls::Types::Int64>(
+                       numThreads * k_NUM_RECORDS / timer.elapsedTime())
+                 << endl;
+        }
+      } break;
+      default: {
+        cerr << "WARNING: CASE `" << test << "' NOT FOUND." << endl;
+        testStatus = -1;
+      }
+    }
+
+    if (testStatus > 0) {
+        cerr << "Error, non-zero test status = " << testStatus << "." << endl;
+    }
+    return testStatus;
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2020 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -13,6 +13,14 @@
 // significant performance overhead.  For this reason, the 'operator()' method
 // is implemented by writing the formatted string to a buffer before inserting
 // to a stream.
+//
+// The format specification is parsed once, when it is set, into a sequence of
+// 'FormatOp' objects, each of which is either a conversion or a run of literal
+// text (with '\'-escape sequences already interpolated).  'operator()' then
+// simply executes that sequence.  Records are typically published many times
+// per second, so the text of the most recently formatted timestamp, truncated
+// to the second, is cached, and only the fractional seconds are formatted for
+// subsequent records within the same second.
 
 #include <ball_recordstringformatter.h>
 
@@ -44,7 +52,6 @@ BSLS_IDENT_RCSID(ball_recordstringformatter_cpp,"$Id$ $CSID$")
 #include <bsl_climits.h>   // for 'INT_MAX'
 #include <bsl_cstring.h>   // for 'bsl::strcmp'
 #include <bsl_c_stdlib.h>
-#include <bsl_c_stdio.h>   // for 'snprintf'
 
 #include <bsl_iomanip.h>
 #include <bsl_ostream.h>
@@ -59,61 +66,66 @@ const char *const DEFAULT_FORMAT_SPEC = "\n%d %p:%t %s %f:%l %c %m %u\n";
 namespace BloombergLP {
 
 // STATIC HELPER FUNCTIONS
-static void appendToString(bsl::string *result, int value)
+static void appendToString(bsl::string *result, bsls::Types::Uint64 value)
     // Convert the specified 'value' into ASCII characters and append it to the
     // specified 'result.
 {
-    char buffer[16];
-
-#if defined(BSLS_PLATFORM_CMP_MSVC)
-#define snprintf _snprintf
-#endif
-
-    snprintf(buffer, sizeof buffer, "%d", value);
+    char  buffer[32];
+    char *end = buffer + sizeof buffer;
+    char *p   = end;
 
-#if defined(BSLS_PLATFORM_CMP_MSVC)
-#undef snprintf
-#endif
+    do {
+        *--p   = static_cast<char>('0' + value % 10);
+        value /= 10;
+    } while (value);
 
-    *result += buffer;
+    result->append(p, end);
 }
 
-static void appendToString(bsl::string *result, bsls::Types::Uint64 value)
+static void appendToString(bsl::string *result, int value)
     // Convert the specified 'value' into ASCII characters and append it to the
     // specified 'result.
 {
-    char buffer[32];
-
-#if defined(BSLS_PLATFORM_CMP_MSVC)
-#define snprintf _snprintf
-#endif
-
-    snprintf(buffer, sizeof buffer, "%llu", value);
+    bsls::Types::Uint64 magnitude = static_cast<bsls::Types::Uint64>(value);
 
-#if defined(BSLS_PLATFORM_CMP_MSVC)
-#undef snprintf
-#endif
+    if (value < 0) {
+        *result   += '-';
+        magnitude  = 0 - static_cast<bsls::Types::Uint64>(
+                                      static_cast<bsls::Types::Int64>(value));
+    }
 
-    *result += buffer;
+    appendToString(result, magnitude);
 }
 
 static void appendToStringAsHex(bsl::string *result, bsls::Types::Uint64 value)
     // Convert the specified 'value' into hexadecimal and append it to the
     // specified 'result'.
 {
-    char buffer[32];
+    static const char k_HEX_DIGITS[] = "0123456789ABCDEF";
 
-#if defined(BSLS_PLATFORM_CMP_MSVC)
-#define snprintf _snprintf
-#endif
+    char  buffer[32];
+    char *end = buffer + sizeof buffer;
+    char *p   = end;
 
-    snprintf(buffer, sizeof(buffer), "%llX", value);
+    do {
+        *--p    = k_HEX_DIGITS[value & 0xF];
+        value >>= 4;
+    } while (value);
 
-#if defined(BSLS_PLATFORM_CMP_MSVC)
-#undef snprintf
-#endif
+    result->append(p, end);
+}
 
-    *result += buffer;
+static char *writeDigits(char *buffer, int value, int numDigits)
+    // Write the specified 'value' as exactly the specified 'numDigits' decimal
+    // digits, padded with leading zeros, to the specified 'buffer', and return
+    // a pointer one past the last digit written.  The behavior is undefined
+    // unless '0 <= value < 10^numDigits'.
+{
+    for (int i = numDigits - 1; i >= 0; --i) {
+        buffer[i] = static_cast<char>('0' + value % 10);
+        value /= 10;
+    }
+    return buffer + numDigits;
 }
 
 namespace ball {
@@ -134,14 +146,20 @@ const int RecordStringFormatter::k_DISABLE_PUBLISH_IN_LOCALTIME = INT_MIN;
 RecordStringFormatter::RecordStringFormatter(bslma::Allocator *basicAllocator)
 : d_formatSpec(DEFAULT_FORMAT_SPEC, basicAllocator)
 , d_timestampOffset(0)
+, d_program(basicAllocator)
+, d_literals(basicAllocator)
 {
+    compileFormat();
 }
 
 RecordStringFormatter::RecordStringFormatter(const char       *format,
                                              bslma::Allocator *basicAllocator)
 : d_formatSpec(format, basicAllocator)
 , d_timestampOffset(0)
+, d_program(basicAllocator)
+, d_literals(basicAllocator)
 {
+    compileFormat();
 }
 
 RecordStringFormatter::RecordStringFormatter(
@@ -149,7 +167,10 @@ RecordStringFormatter::RecordStringFormatter(
                                  bslma::Allocator              *basicAllocator)
 : d_formatSpec(DEFAULT_FORMAT_SPEC, basicAllocator)
 , d_timestampOffset(offset)
+, d_program(basicAllocator)
+, d_literals(basicAllocator)
 {
+    compileFormat();
 }
 
 RecordStringFormatter::RecordStringFormatter(
@@ -163,7 +184,10 @@ RecordStringFormatter::RecordStringFormatter(
                     publishInLocalTime
                     ?  k_ENABLE_PUBLISH_IN_LOCALTIME
                     : k_DISABLE_PUBLISH_IN_LOCALTIME)
+, d_program(basicAllocator)
+, d_literals(basicAllocator)
 {
+    compileFormat();
 }
 
 RecordStringFormatter::RecordStringFormatter(
@@ -172,7 +196,10 @@ RecordStringFormatter::RecordStringFormatter(
                                  bslma::Allocator              *basicAllocator)
 : d_formatSpec(format, basicAllocator)
 , d_timestampOffset(offset)
+, d_program(basicAllocator)
+, d_literals(basicAllocator)
 {
+    compileFormat();
 }
 
 RecordStringFormatter::RecordStringFormatter(
@@ -187,7 +214,10 @@ RecordStringFormatter::RecordStringFormatter(
                     publishInLocalTime
                     ?  k_ENABLE_PUBLISH_IN_LOCALTIME
                     : k_DISABLE_PUBLISH_IN_LOCALTIME)
+, d_program(basicAllocator)
+, d_literals(basicAllocator)
 {
+    compileFormat();
 }
 
 RecordStringFormatter::RecordStringFormatter(
@@ -195,7 +225,118 @@ RecordStringFormatter::RecordStringFormatter(
                                   bslma::Allocator             *basicAllocator)
 : d_formatSpec(original.d_formatSpec, basicAllocator)
 , d_timestampOffset(original.d_timestampOffset)
+, d_program(basicAllocator)
+, d_literals(basicAllocator)
 {
+    compileFormat();
+}
+
+// PRIVATE MANIPULATORS
+void RecordStringFormatter::compileFormat()
+{
+    d_program.clear();
+    d_literals.clear();
+    d_hasTimestamp = false;
+
+    d_timestampCache.d_secondsKey     = -1;
+    d_timestampCache.d_offsetMinutes  = 0;
+    d_timestampCache.d_datetimeLength = 0;
+    d_timestampCache.d_iso8601Length  = 0;
+
+    // Step through the format string, appending a conversion for each
+    // recognized '%'-conversion specification, and merging everything else
+    // (after interpolating '\'-escape sequences) into runs of literal text.
+
+    const char *iter = d_formatSpec.data();
+    const char *end  = iter + d_formatSpec.length();
+
+    while (iter != end) {
+        char literal[2];
+        int  literalLength = 0;
+        char conversion    = 0;
+
+        switch (*iter) {
+          case '%': {
+            if (++iter == end) {
+                break;
+            }
+            switch (*iter) {
+              case '%': {
+                literal[literalLength++] = '%';
+              } break;
+              case 'd': BSLS_ANNOTATION_FALLTHROUGH;
+              case 'D': BSLS_ANNOTATION_FALLTHROUGH;
+              case 'i': BSLS_ANNOTATION_FALLTHROUGH;
+              case 'I': BSLS_ANNOTATION_FALLTHROUGH;
+              case 'O': {
+                conversion     = *iter;
+                d_hasTimestamp = true;
+              } break;
+              case 'p': BSLS_ANNOTATION_FALLTHROUGH;
+              case 't': BSLS_ANNOTATION_FALLTHROUGH;
+              case 'T': BSLS_ANNOTATION_FALLTHROUGH;
+              case 's': BSLS_ANNOTATION_FALLTHROUGH;
+              case 'f': BSLS_ANNOTATION_FALLTHROUGH;
+              case 'F': BSLS_ANNOTATION_FALLTHROUGH;
+              case 'l': BSLS_ANNOTATION_FALLTHROUGH;
+              case 'c': BSLS_ANNOTATION_FALLTHROUGH;
+              case 'm': BSLS_ANNOTATION_FALLTHROUGH;
+              case 'x': BSLS_ANNOTATION_FALLTHROUGH;
+              case 'X': BSLS_ANNOTATION_FALLTHROUGH;
+              case 'u': {
+                conversion = *iter;
+              } break;
+              default: {
+                // Undefined: we just output the verbatim characters.
+
+                literal[literalLength++] = '%';
+                literal[literalLength++] = *iter;
+              }
+            }
+            ++iter;
+          } break;
+          case '\\': {
+            if (++iter == end) {
+                break;
+            }
+            switch (*iter) {
+              case 'n': {
+                literal[literalLength++] = '\n';
+              } break;
+              case 't': {
+                literal[literalLength++] = '\t';
+              } break;
+              case '\\': {
+                literal[literalLength++] = '\\';
+              } break;
+              default: {
+                // Undefined: we just output the verbatim characters.
+
+                literal[literalLength++] = '\\';
+                literal[literalLength++] = *iter;
+              }
+            }
+            ++iter;
+          } break;
+          default: {
+            literal[literalLength++] = *iter;
+            ++iter;
+          }
+        }
+
+        if (conversion) {
+            FormatOp op = { conversion, 0, 0 };
+            d_program.push_back(op);
+        }
+        else if (literalLength) {
+            if (d_program.empty() || 0 != d_program.back().d_conversion) {
+                FormatOp op = { 0, static_cast<int>(d_literals.length()), 0 };
+                d_program.push_back(op);
+            }
+            d_literals.append(literal, literalLength);
+            d_program.back().d_length += literalLength;
+        }
+    }
 }
 
 // MANIPULATORS
@@ -205,37 +346,138 @@ RecordStringFormatter& RecordStringFormatter::operator=(
     if (this != &rhs) {
         d_formatSpec      = rhs.d_formatSpec;
         d_timestampOffset = rhs.d_timestampOffset;
+        compileFormat();
     }
 
     return *this;
 }
 
+void RecordStringFormatter::setFormat(const char *format)
+{
+    d_formatSpec = format;
+    compileFormat();
+}
+
+// PRIVATE ACCESSORS
+int RecordStringFormatter::formatTimestamp(
+                                     char                    *buffer,
+                                     const bdlt::DatetimeTz&  timestamp,
+                                     char                     conversion) const
+{
+    const bdlt::Datetime& datetime = timestamp.localDatetime();
+
+    int hour, minute, second, millisecond, microsecond;
+    datetime.getTime(&hour, &minute, &second, &millisecond, &microsecond);
+
+    // Note that the hour may be 24 (for the default 'bdlt::Datetime' value),
+    // so we use a day length that cannot collide with the next day.
+
+    const bsls::Types::Int64 days = datetime.date() - bdlt::Date();
+    const bsls::Types::Int64 secondsKey = days * 100000
+                                        + hour * 3600 + minute * 60 + second;
+
+    // The cache is shared by all threads using this formatter.  A thread that
+    // finds it in use by another thread formats the whole timestamp instead of
+    // waiting.
+
+    TimestampCache  localCache;
+    const bool      useSharedCache =
+                          0 == d_timestampCacheInUse.testAndSwapAcqRel(0, 1);
+    TimestampCache *cache = useSharedCache ? &d_timestampCache : &localCache;
+
+    if (!useSharedCache
+     || secondsKey         != cache->d_secondsKey
+     || timestamp.offset() != cache->d_offsetMinutes) {
+        cache->d_secondsKey     = secondsKey;
+        cache->d_offsetMinutes  = timestamp.offset();
+        cache->d_datetimeLength = 0;
+        cache->d_iso8601Length  = 0;
+    }
+
+    char *p = buffer;
+
+    if ('d' == conversion || 'D' == conversion) {
+        // "DDMonYYYY_HH:MM:SS" followed by milliseconds, and microseconds for
+        // "%D".
+
+        if (0 == cache->d_datetimeLength) {
+            cache->d_datetimeLength = datetime.printToBuffer(
+                                                 cache->d_datetime,
+                                                 TimestampCache::k_BUFFER_SIZE,
+                                                 0);
+        }
+        bsl::memcpy(p, cache->d_datetime, cache->d_datetimeLength);
+        p    += cache->d_datetimeLength;
+        *p++  = '.';
+        p     = writeDigits(p, millisecond, 3);
+        if ('D' == conversion) {
+            p = writeDigits(p, microsecond, 3);
+        }
+    }
+    else {
+        // ISO 8601 "extended" format, with the fractional seconds (if any)
+        // inserted between the seconds and the time zone.
+
+        enum { k_SECONDS_LENGTH = 19 };  // length of "YYYY-MM-DDTHH:MM:SS"
+
+        if (0 == cache->d_iso8601Length) {
+            bdlt::Iso8601UtilConfiguration config;
+            config.setFractionalSecondPrecision(0);
+            config.setUseZAbbreviationForUtc(true);
+
+            cache->d_iso8601Length = bdlt::Iso8601Util::generateRaw(
+                                                             cache->d_iso8601,
+                                                             timestamp,
+                                                             config);
+        }
+        bsl::memcpy(p, cache->d_iso8601, k_SECONDS_LENGTH);
+        p += k_SECONDS_LENGTH;
+        if ('i' != conversion) {
+            *p++ = '.';
+            p    = writeDigits(p, millisecond, 3);
+            if ('O' == conversion) {
+                p = writeDigits(p, microsecond, 3);
+            }
+        }
+        bsl::memcpy(p,
+                    cache->d_iso8601 + k_SECONDS_LENGTH,
+                    cache->d_iso8601Length - k_SECONDS_LENGTH);
+        p += cache->d_iso8601Length - k_SECONDS_LENGTH;
+    }
+
+    if (useSharedCache) {
+        d_timestampCacheInUse.storeRelease(0);
+    }
+
+    return static_cast<int>(p - buffer);
+}
+
 // ACCESSORS
 void RecordStringFormatter::operator()(bsl::ostream& stream,
                                        const Record& record) const
 
 {
     const RecordAttributes& fixedFields = record.fixedFields();
-    bdlt::DatetimeInterval  offset;
 
-    if (k_ENABLE_PUBLISH_IN_LOCALTIME ==
+    bdlt::DatetimeTz timestamp;
+
+    if (d_hasTimestamp) {
+        bdlt::DatetimeInterval offset;
+
+        if (k_ENABLE_PUBLISH_IN_LOCALTIME ==
                                        d_timestampOffset.totalMilliseconds()) {
-        bsls::Types::Int64 localTimeOffsetInSeconds =
-            bdlt::LocalTimeOffset::localTimeOffset(
+            bsls::Types::Int64 localTimeOffsetInSeconds =
+                bdlt::LocalTimeOffset::localTimeOffset(
                                        fixedFields.timestamp()).totalSeconds();
-        offset.setTotalSeconds(localTimeOffsetInSeconds);
-    } else if (k_DISABLE_PUBLISH_IN_LOCALTIME !=
+            offset.setTotalSeconds(localTimeOffsetInSeconds);
+        } else if (k_DISABLE_PUBLISH_IN_LOCALTIME !=
                                        d_timestampOffset.totalMilliseconds()) {
-        offset = d_timestampOffset;
-    }
-
-    bdlt::DatetimeTz timestamp(fixedFields.timestamp() + offset,
-                               static_cast<int>(offset.totalMinutes()));
-
-    // Step through the format string, outputting the required elements.
+            offset = d_timestampOffset;
+        }
 
-    const char* iter = d_formatSpec.data();
-    const char* end  = iter + d_formatSpec.length();
+        timestamp.setDatetimeTz(fixedFields.timestamp() + offset,
+                                static_cast<int>(offset.totalMinutes()));
+    }
 
     // Create a buffer on the stack for formatting the record.  Note that the
     // size of the buffer should be slightly larger than the amount we reserve
@@ -251,173 +493,106 @@ void RecordStringFormatter::operator()(bsl::ostream& stream,
     bsl::string output(&stringAllocator);
     output.reserve(STRING_RESERVATION);
 
-    while (iter != end) {
-        switch (*iter) {
-          case '%': {
-            if (++iter == end) {
-                break;
-            }
-            switch (*iter) {
-              case '%': {
-                output += '%';
-              } break;
-              case 'd': BSLS_ANNOTATION_FALLTHROUGH;
-              case 'D': {
-                const int fractionalSecondPrecision = 'd' == *iter ? 3 : 6;
-
-                char buffer[32];
-                timestamp.localDatetime().printToBuffer(
-                                                    buffer,
-                                                    sizeof buffer,
-                                                    fractionalSecondPrecision);
-
-                output += buffer;
-              } break;
-              case 'I': BSLS_ANNOTATION_FALLTHROUGH;
-              case 'O': BSLS_ANNOTATION_FALLTHROUGH;
-              case 'i': {
-                // Use ISO8601 "extended" format.
-
-                const int fractionalSecondPrecision = 'O' == *iter ? 6 : 3;
-
-                bdlt::Iso8601UtilConfiguration config;
-                config.setFractionalSecondPrecision(fractionalSecondPrecision);
-                config.setUseZAbbreviationForUtc(true);
-
-                char buffer[bdlt::Iso8601Util::k_DATETIMETZ_STRLEN + 1];
-
-                int outputLength = bdlt::Iso8601Util::generateRaw(buffer,
-                                                                  timestamp,
-                                                                  config);
-
-                if ('i' == *iter) {
-                    // Remove milliseconds part.
-
-                    enum { k_DECIMAL_SIGN_OFFSET = 19,
-                           k_TZINFO_OFFSET       = k_DECIMAL_SIGN_OFFSET + 4 };
-                    bslstl::StringRef head(buffer, k_DECIMAL_SIGN_OFFSET);
+    // Execute the compiled format specification, outputting the required
+    // elements.
 
-                    bslstl::StringRef tail(buffer + k_TZINFO_OFFSET,
-                                           outputLength - k_TZINFO_OFFSET);
+    const FormatOp *op  = d_program.data();
+    const FormatOp *end = op + d_program.size();
 
-                    output += head + tail;
-                }
-                else {
-                    output.append(buffer, outputLength);
-                }
-              } break;
-              case 'p': {
-                appendToString(&output, fixedFields.processID());
-              } break;
-              case 't': {
-                appendToString(&output, fixedFields.threadID());
-              } break;
-              case 'T': {
-                appendToStringAsHex(&output, fixedFields.threadID());
-              } break;
-              case 's': {
-                output += Severity::toAscii(
+    for (; op != end; ++op) {
+        switch (op->d_conversion) {
+          case 0: {
+            output.append(d_literals.data() + op->d_offset, op->d_length);
+          } break;
+          case 'd': BSLS_ANNOTATION_FALLTHROUGH;
+          case 'D': BSLS_ANNOTATION_FALLTHROUGH;
+          case 'i': BSLS_ANNOTATION_FALLTHROUGH;
+          case 'I': BSLS_ANNOTATION_FALLTHROUGH;
+          case 'O': {
+            char buffer[bdlt::Iso8601Util::k_DATETIMETZ_STRLEN + 1];
+
+            const int length = formatTimestamp(buffer,
+                                               timestamp,
+                                               op->d_conversion);
+            output.append(buffer, length);
+          } break;
+          case 'p': {
+            appendToString(&output, fixedFields.processID());
+          } break;
+          case 't': {
+            appendToString(&output, fixedFields.threadID());
+          } break;
+          case 'T': {
+            appendToStringAsHex(&output, fixedFields.threadID());
+          } break;
+          case 's': {
+            output += Severity::toAscii(
                                  (Severity::Level)fixedFields.severity());
-              } break;
-              case 'f': {
-                output += fixedFields.fileName();
-              } break;
-              case 'F': {
-                const bsl::string& filename = fixedFields.fileName();
-                bsl::string::size_type rightmostSlashIndex =
+          } break;
+          case 'f': {
+            output += fixedFields.fileName();
+          } break;
+          case 'F': {
 #ifdef BSLS_PLATFORM_OS_WINDOWS
-                    filename.rfind('\\');
+            const char k_SEPARATOR = '\\';
 #else
-                    filename.rfind('/');
+            const char k_SEPARATOR = '/';
 #endif
-                if (bsl::string::npos == rightmostSlashIndex) {
-                    output += filename;
-                }
-                else {
-                    output += filename.substr(rightmostSlashIndex + 1);
-                }
-              } break;
-              case 'l': {
-                appendToString(&output, fixedFields.lineNumber());
-              } break;
-              case 'c': {
-                output += fixedFields.category();
-              } break;
-              case 'm': {
-                bslstl::StringRef message = fixedFields.messageRef();
-                output.append(message.data(), message.length());
-              } break;
-              case 'x': {
-                bsl::stringstream ss;
-                int length = static_cast<int>(
-                                      fixedFields.messageStreamBuf().length());
-                bdlb::Print::printString(ss,
-                                        fixedFields.message(),
-                                        length,
-                                        false);
-                output += ss.str();
-              } break;
-              case 'X': {
-                bsl::stringstream ss;
-                int length = static_cast<int>(
-                                      fixedFields.messageStreamBuf().length());
-                bdlb::Print::singleLineHexDump(ss,
-                                              fixedFields.message(),
-                                              length);
-                output += ss.str();
-              } break;
-              case 'u': {
-                typedef ball::UserFields Values;
-                const Values& customFields = record.customFields();
-                const int numCustomFields  = customFields.length();
-
-                if (numCustomFields > 0) {
-                    bsl::stringstream ss;
-                    Values::ConstIterator it = customFields.begin();
-                    ss << *it;
-                    ++it;
-                    for (; it != customFields.end(); ++it) {
-                        ss << " " << *it;
-                    }
-                    output += ss.str();
-                }
-              } break;
-              default: {
-                // Undefined: we just output the verbatim characters.
+            const bsl::string&  filename = fixedFields.fileName();
+            const char         *nameEnd  = filename.data() + filename.length();
+            const char         *basename = nameEnd;
 
-                output += '%';
-                output += *iter;
-              }
+            while (basename != filename.data()
+                && k_SEPARATOR != basename[-1]) {
+                --basename;
             }
-            ++iter;
+            output.append(basename, nameEnd);
           } break;
-          case '\\': {
-            if (++iter == end) {
-                break;
-            }
-            switch (*iter) {
-              case 'n': {
-                output += '\n';
-              } break;
-              case 't': {
-                output += '\t';
-              } break;
-              case '\\': {
-                output += '\\';
-              } break;
-              default: {
-                // Undefined: we just output the verbatim characters.
+          case 'l': {
+            appendToString(&output, fixedFields.lineNumber());
+          } break;
+          case 'c': {
+            output += fixedFields.category();
+          } break;
+          case 'm': {
+            bslstl::StringRef message = fixedFields.messageRef();
+            output.append(message.data(), message.length());
+          } break;
+          case 'x': {
+            bsl::stringstream ss;
+            int length = static_cast<int>(
+                                      fixedFields.messageStreamBuf().length());
+            bdlb::Print::printString(ss,
+                                    fixedFields.message(),
+                                    length,
+                                    false);
+            output += ss.str();
+          } break;
+          case 'X': {
+            bsl::stringstream ss;
+            int length = static_cast<int>(
+                                      fixedFields.messageStreamBuf().length());
+            bdlb::Print::singleLineHexDump(ss,
+                                          fixedFields.message(),
+                                          length);
+            output += ss.str();
+          } break;
+          case 'u': {
+            typedef ball::UserFields Values;
+            const Values& customFields = record.customFields();
+            const int numCustomFields  = customFields.length();
 
-                output += '\\';
-                output += *iter;
-              }
+            if (numCustomFields > 0) {
+                bsl::stringstream ss;
+                Values::ConstIterator it = customFields.begin();
+                ss << *it;
+                ++it;
+                for (; it != customFields.end(); ++it) {
+                    ss << " " << *it;
+                }
+                output += ss.str();
             }
-            ++iter;
           } break;
-          default: {
-            output += *iter;
-            ++iter;
-          }
         }
     }
 
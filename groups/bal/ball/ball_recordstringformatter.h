@@ -93,6 +93,18 @@ BSLS_IDENT("$Id: $")
 // 27AUG2007_16:09:46.161 2040:1 WARN subdir/process.cpp:542 FOO.BAR.BAZ <text>
 //..
 //
+///Performance
+///-----------
+// A record formatter parses its format specification once, when the
+// specification is supplied, into a sequence of formatting steps that
+// 'operator()' then executes for each record.  In addition, the text of the
+// most recently formatted timestamp is cached (to the second), so that only
+// the fractional seconds need be formatted for subsequent records logged
+// within the same second.  The cache is used by one thread at a time; a
+// thread that finds the cache in use by another thread formats the whole
+// timestamp instead, so 'operator()' may still be called concurrently on the
+// same object.
+//
 ///Usage
 ///-----
 // The following snippets of code illustrate how to use an instance of
@@ -130,14 +142,19 @@ BSLS_IDENT("$Id: $")
 #include <balscm_version.h>
 
 #include <bdlt_datetimeinterval.h>
+#include <bdlt_datetimetz.h>
 
 #include <bslma_allocator.h>
 #include <bslma_usesbslmaallocator.h>
 
 #include <bslmf_nestedtraitdeclaration.h>
 
+#include <bsls_atomic.h>
+#include <bsls_types.h>
+
 #include <bsl_iosfwd.h>
 #include <bsl_string.h>
+#include <bsl_vector.h>
 
 #ifndef BDE_DONT_ALLOW_TRANSITIVE_INCLUDES
 #include <bslalg_typetraits.h>
@@ -177,9 +194,79 @@ class RecordStringFormatter {
                                               // adjusted to the current local
                                               // time.
 
+    // PRIVATE TYPES
+    struct FormatOp {
+        // This 'struct' describes one step of a compiled format
+        // specification: either a conversion specification or a run of
+        // literal text.
+
+        char d_conversion;  // conversion character (e.g., 'm' for "%m"), or
+                            // 0 for literal text
+
+        int  d_offset;      // offset of the literal text in 'd_literals'
+
+        int  d_length;      // length of the literal text
+    };
+
+    struct TimestampCache {
+        // This 'struct' holds the text of the most recently formatted
+        // timestamp, truncated to the second, so that records logged within
+        // the same second need only format their fractional seconds.
+
+        enum { k_BUFFER_SIZE = 32 };  // large enough for any timestamp text
+
+        bsls::Types::Int64 d_secondsKey;              // identifies the
+                                                      // cached local time,
+                                                      // truncated to the
+                                                      // second
+
+        int                d_offsetMinutes;           // time zone offset of
+                                                      // the cached timestamp
+
+        int                d_datetimeLength;          // length of
+                                                      // 'd_datetime', or 0 if
+                                                      // not yet formatted
+
+        char               d_datetime[k_BUFFER_SIZE]; // "DDMonYYYY_HH:MM:SS"
+
+        int                d_iso8601Length;           // length of
+                                                      // 'd_iso8601', or 0 if
+                                                      // not yet formatted
+
+        char               d_iso8601[k_BUFFER_SIZE];  // ISO 8601 timestamp
+                                                      // with no fractional
+                                                      // seconds
+    };
+
     // DATA
     bsl::string            d_formatSpec;       // 'printf'-style format spec.
     bdlt::DatetimeInterval d_timestampOffset;  // offset added to timestamps
+    bsl::vector<FormatOp>  d_program;          // compiled 'd_formatSpec'
+    bsl::string            d_literals;         // literal text of 'd_program'
+    bool                   d_hasTimestamp;     // 'true' if 'd_program' has a
+                                               // timestamp conversion
+
+    mutable TimestampCache d_timestampCache;   // last timestamp formatted
+
+    mutable bsls::AtomicInt
+                           d_timestampCacheInUse;
+                                               // 1 while 'd_timestampCache'
+                                               // is in use, and 0 otherwise
+
+    // PRIVATE MANIPULATORS
+    void compileFormat();
+        // Compile 'd_formatSpec' into 'd_program' and 'd_literals', and reset
+        // the timestamp cache.
+
+    // PRIVATE ACCESSORS
+    int formatTimestamp(char                    *buffer,
+                        const bdlt::DatetimeTz&  timestamp,
+                        char                     conversion) const;
+        // Write into the specified 'buffer' the text of the specified
+        // 'timestamp' for the specified 'conversion' (one of 'd', 'D', 'i',
+        // 'I', or 'O'), and return the number of characters written.  No null
+        // terminator is written.  'buffer' must have room for at least
+        // 'bdlt::Iso8601Util::k_DATETIMETZ_STRLEN' characters.
 
   public:
     // TRAITS
@@ -355,12 +442,6 @@ void RecordStringFormatter::enablePublishInLocalTime()
     d_timestampOffset.setTotalMilliseconds(k_ENABLE_PUBLISH_IN_LOCALTIME);
 }
 
-inline
-void RecordStringFormatter::setFormat(const char *format)
-{
-    d_formatSpec = format;
-}
-
 inline
 void RecordStringFormatter::setTimestampOffset(
                                           const bdlt::DatetimeInterval& offset)
@@ -8,7 +8,9 @@
 
 #include <bdlt_currenttime.h>
 #include <bdlt_datetime.h>
+#include <bdlt_datetimetz.h>
 #include <bdlt_iso8601util.h>
+#include <bdlt_iso8601utilconfiguration.h>
 #include <bdlt_localtimeoffset.h>
 
 #include <bslim_testutil.h>
@@ -21,6 +23,7 @@
 #include <bslmt_threadutil.h>
 
 #include <bsls_platform.h>
+#include <bsls_stopwatch.h>
 #include <bsls_types.h>
 
 #include <bsl_iostream.h>
@@ -89,6 +92,9 @@ using bsl::uppercase;
 // ----------------------------------------------------------------------------
 // [ 1] breathing test
 // [12] USAGE example
+// [14] CONCERN: format specification is compiled once
+// [14] CONCERN: timestamp text is cached per second
+// [-1] PERFORMANCE: Formatting Records
 
 // ============================================================================
 //                     STANDARD BDE ASSERT TEST FUNCTION
@@ -246,6 +252,56 @@ bool compareText(bslstl::StringRef lhs, bslstl::StringRef rhs)
 
 namespace {
 
+struct ConcurrentFormatJob {
+    // This 'struct' is a thread function that formats records having
+    // timestamps in alternating seconds using a shared formatter, and counts
+    // the results that differ from the text produced by 'bdlt'.
+
+    const ball::RecordStringFormatter *d_formatter_p;  // shared formatter
+    int                                d_seed;         // distinguishes threads
+    int                                d_numRecords;   // records to format
+    int                                d_numErrors;    // incorrect results
+
+    void operator()()
+        // Format 'd_numRecords' records with '*d_formatter_p' (which must
+        // have the format "%i %I %D"), and increment 'd_numErrors' for each
+        // incorrect result.
+    {
+        ball::RecordAttributes fixedFields;
+        ball::Record           record;
+
+        for (int i = 0; i < d_numRecords; ++i) {
+            bdlt::Datetime utc(2020, 1, 1 + d_seed, 0, 0, i % 2);
+            utc.addMicroseconds(i * 7 % 1000000);
+            fixedFields.setTimestamp(utc);
+            record.setFixedFields(fixedFields);
+
+            bdlt::Iso8601UtilConfiguration config;
+            config.setUseZAbbreviationForUtc(true);
+
+            char        buffer[64];
+            bsl::string expected;
+
+            config.setFractionalSecondPrecision(0);
+            bdlt::Iso8601Util::generate(buffer, sizeof buffer, utc, config);
+            expected  = buffer;
+            config.setFractionalSecondPrecision(3);
+            bdlt::Iso8601Util::generate(buffer, sizeof buffer, utc, config);
+            expected += " ";
+            expected += buffer;
+            utc.printToBuffer(buffer, sizeof buffer, 6);
+            expected += " ";
+            expected += buffer;
+
+            ostringstream oss;
+            (*d_formatter_p)(oss, record);
+            if (expected != oss.str()) {
+                ++d_numErrors;
+            }
+        }
+    }
+};
+
 }  // close unnamed namespace
 
 //=============================================================================
@@ -263,6 +319,245 @@ int main(int argc, char *argv[])
     cout << "TEST " << __FILE__ << " CASE " << test << endl;
 
     switch (test) { case 0:
+      case 14: {
+        // --------------------------------------------------------------------
+        // TESTING: Compiled Format Specification and Timestamp Cache
+        //
+        // Concerns:
+        //: 1 Literal text, '\'-escape sequences, unrecognized conversion
+        //:   specifications, and a trailing '%' or '\' are output exactly as
+        //:   before the format specification was compiled.
+        //:
+        //: 2 'setFormat', copy construction, and assignment recompile the
+        //:   format specification.
+        //:
+        //: 3 Each timestamp conversion produces the same text as formatting
+        //:   the timestamp directly, for sequences of records that fall
+        //:   within the same second, move forward or backward by a second or
+        //:   more, cross a day, or differ only in their time zone offset.
+        //:
+        //: 4 Formatting the same record concurrently from several threads
+        //:   produces the correct text.
+        //
+        // Plan:
+        //: 1 Using a table of format specifications and expected results,
+        //:   format a record having known attributes.  (C-1)
+        //:
+        //: 2 Change the format specification of an object using 'setFormat',
+        //:   and verify the output of copies and assigned objects.  (C-2)
+        //:
+        //: 3 Format a sequence of records with "%d %D %i %I %O", changing the
+        //:   timestamp offset between some of them, and compare the result to
+        //:   the text produced by 'bdlt::Datetime::printToBuffer' and
+        //:   'bdlt::Iso8601Util::generate'.  (C-3)
+        //:
+        //: 4 Format records with timestamps in alternating seconds from
+        //:   several threads using a single object, and verify each result.
+        //:   (C-4)
+        //
+        // Testing:
+        //   CONCERN: format specification is compiled once
+        //   CONCERN: timestamp text is cached per second
+        // --------------------------------------------------------------------
+
+        if (verbose) cout
+               << endl
+               << "TESTING: Compiled Format Specification and Timestamp Cache"
+               << endl
+               << "=========================================================="
+               << endl;
+
+        ball::RecordAttributes fixedFields;
+        fixedFields.setTimestamp(bdlt::Datetime(2020, 6, 30, 23, 59, 58, 7,
+                                                8));
+        fixedFields.setProcessID(77);
+        fixedFields.setThreadID(255);
+        fixedFields.setFileName("a/b/c.cpp");
+        fixedFields.setLineNumber(-42);
+        fixedFields.setCategory("CAT");
+        fixedFields.setSeverity(ball::Severity::e_WARN);
+        fixedFields.setMessage("msg");
+
+        ball::Record record;
+        record.setFixedFields(fixedFields);
+
+        if (verbose) cout << "\nLiteral text and conversions." << endl;
+        {
+            static const struct {
+                int         d_line;      // source line number
+                const char *d_format;    // format specification
+                const char *d_expected;  // expected output
+            } DATA[] = {
+                //line  format                   expected
+                //----  -----------------------  -----------------------------
+                { L_,   "",                      ""                          },
+                { L_,   "abc",                   "abc"                       },
+                { L_,   "%",                     ""                          },
+                { L_,   "\\",                    ""                          },
+                { L_,   "a%",                    "a"                         },
+                { L_,   "a\\",                   "a"                         },
+                { L_,   "%%",                    "%"                         },
+                { L_,   "%%%",                   "%"                         },
+                { L_,   "\\\\",                  "\\"                        },
+                { L_,   "\\n\\t\\q",             "\n\t\\q"                   },
+                { L_,   "%z%",                   "%z"                        },
+                { L_,   "[%m]",                  "[msg]"                     },
+                { L_,   "%m%m",                  "msgmsg"                    },
+                { L_,   "%c:%s",                 "CAT:WARN"                  },
+                { L_,   "%l %p",                 "-42 77"                    },
+                { L_,   "%t/%T",                 "255/FF"                    },
+                { L_,   "%f %F",                 "a/b/c.cpp c.cpp"           },
+                { L_,   "x%%y\\%m",              "x%y\\%m"                   },
+                { L_,   "x%%y\\ %m",             "x%y\\ msg"                 },
+            };
+            const int NUM_DATA = sizeof DATA / sizeof *DATA;
+
+            for (int ti = 0; ti < NUM_DATA; ++ti) {
+                const int   LINE     = DATA[ti].d_line;
+                const char *FORMAT   = DATA[ti].d_format;
+                const char *EXPECTED = DATA[ti].d_expected;
+
+                Obj mX(FORMAT);  const Obj& X = mX;
+
+                ostringstream oss;
+                X(oss, record);
+                ASSERTV(LINE, EXPECTED, oss.str(), EXPECTED == oss.str());
+            }
+        }
+
+        if (verbose) cout << "\nRecompilation." << endl;
+        {
+            Obj mX("%m");  const Obj& X = mX;
+
+            mX.setFormat("<%c>");
+            ostringstream oss;
+            X(oss, record);
+            ASSERTV(oss.str(), "<CAT>" == oss.str());
+
+            Obj mY(X);  const Obj& Y = mY;
+            oss.str("");
+            Y(oss, record);
+            ASSERTV(oss.str(), "<CAT>" == oss.str());
+
+            Obj mZ("%l");  const Obj& Z = mZ;
+            mZ = X;
+            mX.setFormat("%s");
+            oss.str("");
+            Z(oss, record);
+            ASSERTV(oss.str(), "<CAT>" == oss.str());
+            oss.str("");
+            X(oss, record);
+            ASSERTV(oss.str(), "WARN" == oss.str());
+        }
+
+        if (verbose) cout << "\nTimestamp cache." << endl;
+        {
+            static const struct {
+                int d_line;           // source line number
+                int d_day;            // day of month
+                int d_second;         // second of minute
+                int d_microseconds;   // microseconds of second
+                int d_offsetMinutes;  // timestamp offset
+            } DATA[] = {
+                //line  day  sec  usec     offset
+                //----  ---  ---  -------  ------
+                { L_,    1,   0,        0,      0 },
+                { L_,    1,   0,        1,      0 },
+                { L_,    1,   0,   999999,      0 },
+                { L_,    1,   1,        0,      0 },
+                { L_,    1,   1,     1000,      0 },
+                { L_,    1,   0,   500000,      0 },
+                { L_,    1,   0,   500000,     60 },
+                { L_,    1,   0,   500001,     60 },
+                { L_,    1,   0,   500002,    -90 },
+                { L_,    2,   0,   500002,    -90 },
+                { L_,    2,   0,   500002,      0 },
+                { L_,    1,  59,   123456,      0 },
+                { L_,    1,  59,   654321,      0 },
+            };
+            const int NUM_DATA = sizeof DATA / sizeof *DATA;
+
+            Obj mX("%d|%D|%i|%I|%O|%d");  const Obj& X = mX;
+
+            for (int ti = 0; ti < NUM_DATA; ++ti) {
+                const int LINE   = DATA[ti].d_line;
+                const int OFFSET = DATA[ti].d_offsetMinutes;
+
+                bdlt::Datetime utc(2020, 3, DATA[ti].d_day, 12, 30,
+                                   DATA[ti].d_second);
+                utc.addMicroseconds(DATA[ti].d_microseconds);
+
+                mX.setTimestampOffset(bdlt::DatetimeInterval(0, 0, OFFSET));
+
+                fixedFields.setTimestamp(utc);
+                record.setFixedFields(fixedFields);
+
+                const bdlt::DatetimeTz local(
+                               utc + bdlt::DatetimeInterval(0, 0, OFFSET),
+                               OFFSET);
+
+                char buffer[64];
+                bsl::string expected;
+
+                local.localDatetime().printToBuffer(buffer, sizeof buffer, 3);
+                const bsl::string d(buffer);
+                local.localDatetime().printToBuffer(buffer, sizeof buffer, 6);
+                const bsl::string D(buffer);
+
+                bdlt::Iso8601UtilConfiguration config;
+                config.setUseZAbbreviationForUtc(true);
+
+                config.setFractionalSecondPrecision(0);
+                bdlt::Iso8601Util::generate(buffer, sizeof buffer, local,
+                                            config);
+                const bsl::string i(buffer);
+                config.setFractionalSecondPrecision(3);
+                bdlt::Iso8601Util::generate(buffer, sizeof buffer, local,
+                                            config);
+                const bsl::string I(buffer);
+                config.setFractionalSecondPrecision(6);
+                bdlt::Iso8601Util::generate(buffer, sizeof buffer, local,
+                                            config);
+                const bsl::string O(buffer);
+
+                expected = d + "|" + D + "|" + i + "|" + I + "|" + O + "|" + d;
+
+                ostringstream oss;
+                X(oss, record);
+                ASSERTV(LINE, expected, oss.str(), expected == oss.str());
+
+                // A copy starts with an empty cache.
+
+                Obj mY(X);  const Obj& Y = mY;
+                oss.str("");
+                Y(oss, record);
+                ASSERTV(LINE, expected, oss.str(), expected == oss.str());
+            }
+        }
+
+        if (verbose) cout << "\nConcurrent use." << endl;
+        {
+            enum { k_NUM_THREADS = 4, k_NUM_RECORDS = 2000 };
+
+            const Obj X("%i %I %D");
+
+            ConcurrentFormatJob jobs[k_NUM_THREADS];
+            bslmt::ThreadUtil::Handle handles[k_NUM_THREADS];
+
+            for (int ti = 0; ti < k_NUM_THREADS; ++ti) {
+                jobs[ti].d_formatter_p = &X;
+                jobs[ti].d_seed        = ti;
+                jobs[ti].d_numRecords  = k_NUM_RECORDS;
+                jobs[ti].d_numErrors   = 0;
+                ASSERT(0 == bslmt::ThreadUtil::create(&handles[ti],
+                                                      jobs[ti]));
+            }
+            for (int ti = 0; ti < k_NUM_THREADS; ++ti) {
+                ASSERT(0 == bslmt::ThreadUtil::join(handles[ti]));
+                ASSERTV(ti, jobs[ti].d_numErrors, 0 == jobs[ti].d_numErrors);
+            }
+        }
+      } break;
       case 13: {
         // --------------------------------------------------------------------
         // TESTING: Records Show Calculated Local-Time Offset
@@ -1771,6 +2066,71 @@ int main(int argc, char *argv[])
         ASSERT( 1 == (X1 == X4));        ASSERT(0 == (X1 != X4));
       } break;
 
+      case -1: {
+        // --------------------------------------------------------------------
+        // PERFORMANCE: Formatting Records
+        //
+        // Concerns:
+        //: 1 The time needed to format a record is small compared to the rate
+        //:   at which records are published by file observers.
+        //
+        // Plan:
+        //: 1 Format a large number of records, whose timestamps advance by a
+        //:   few microseconds each, with several common format
+        //:   specifications, and report the average time per record.
+        //
+        // Testing:
+        //   PERFORMANCE: Formatting Records
+        // --------------------------------------------------------------------
+
+        cout << endl
+             << "PERFORMANCE: Formatting Records" << endl
+             << "===============================" << endl;
+
+        static const char *FORMATS[] = {
+            "\n%d %p:%t %s %f:%l %c %m %u\n",
+            "\n%I %p:%t %s %F:%l %c %m\n",
+            "%O %T %s %c %m\n",
+            "%m\n"
+        };
+        const int NUM_FORMATS = sizeof FORMATS / sizeof *FORMATS;
+
+        const int NUM_RECORDS = argc > 2 ? bsl::atoi(argv[2]) : 200000;
+
+        ball::RecordAttributes fixedFields;
+        fixedFields.setProcessID(12345);
+        fixedFields.setThreadID(140234567);
+        fixedFields.setFileName("groups/bal/ball/ball_recordattributes.cpp");
+        fixedFields.setLineNumber(1234);
+        fixedFields.setCategory("BALL.RECORDSTRINGFORMATTER");
+        fixedFields.setSeverity(ball::Severity::e_INFO);
+        fixedFields.setMessage("Processed request 12345 for user 678 in 42us");
+
+        ball::Record record;
+        record.setFixedFields(fixedFields);
+
+        for (int fi = 0; fi < NUM_FORMATS; ++fi) {
+            const Obj X(FORMATS[fi]);
+
+            bdlt::Datetime timestamp(2020, 1, 1);
+
+            ostringstream   oss;
+            bsls::Stopwatch timer;
+            timer.start();
+            for (int i = 0; i < NUM_RECORDS; ++i) {
+                timestamp.addMicroseconds(3);
+                record.fixedFields().setTimestamp(timestamp);
+
+                oss.seekp(0);
+                X(oss, record);
+            }
+            timer.stop();
+
+            cout << "\"" << FORMATS[fi] << "\": "
+                 << timer.elapsedTime() / NUM_RECORDS * 1e9
+                 << " ns/record" << endl;
+        }
+      } break;
       default:
         {
             cerr << "WARNING: CASE `" << test << "' NOT FOUND." << endl;
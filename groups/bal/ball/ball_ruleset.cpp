@@ -20,6 +20,7 @@ BSLS_IDENT_RCSID(ball_ruleset_cpp,"$Id$ $CSID$")
 #include <bsls_assert.h>
 
 #include <bsl_climits.h>
+#include <bsl_cstddef.h>
 #include <bsl_cstdint.h>
 #include <bsl_functional.h>
 
@@ -33,6 +34,58 @@ namespace ball {
 // CLASS DATA
 int RuleSet::RuleHash::s_hashtableSize = INT_MAX;
 
+// PRIVATE MANIPULATORS
+void RuleSet::indexRule(int id, const Rule& rule)
+{
+    const MaskType bit = static_cast<MaskType>(1) << id;
+
+    for (PredicateSet::const_iterator iter = rule.begin();
+         iter != rule.end();
+         ++iter) {
+        bsl::size_t i = 0;
+        while (i < d_predicates.size() && !(d_predicates[i] == *iter)) {
+            ++i;
+        }
+
+        if (i == d_predicates.size()) {
+            d_predicates.push_back(*iter);
+            d_predicateRules.push_back(bit);
+        }
+        else {
+            d_predicateRules[i] |= bit;
+        }
+    }
+}
+
+void RuleSet::unindexRule(int id, const Rule& rule)
+{
+    const MaskType bit = static_cast<MaskType>(1) << id;
+
+    for (PredicateSet::const_iterator iter = rule.begin();
+         iter != rule.end();
+         ++iter) {
+        bsl::size_t i = 0;
+        while (i < d_predicates.size() && !(d_predicates[i] == *iter)) {
+            ++i;
+        }
+        BSLS_ASSERT(i < d_predicates.size());
+
+        d_predicateRules[i] &= ~bit;
+
+        if (0 == d_predicateRules[i]) {
+            // No remaining rule holds the predicate: move the last entry of
+            // the index into its place.
+
+            if (i + 1 != d_predicates.size()) {
+                d_predicates[i]     = d_predicates.back();
+                d_predicateRules[i] = d_predicateRules.back();
+            }
+            d_predicates.pop_back();
+            d_predicateRules.pop_back();
+        }
+    }
+}
+
 // CLASS METHODS
 void RuleSet::printMask(bsl::ostream& stream,
                         MaskType      mask,
@@ -59,6 +112,8 @@ RuleSet::RuleSet(bslma::Allocator *basicAllocator)
 , d_ruleAddresses(basicAllocator)
 , d_freeRuleIds(basicAllocator)
 , d_numPredicates(0)
+, d_predicates(basicAllocator)
+, d_predicateRules(basicAllocator)
 {
     for (int i = 0; i < maxNumRules(); ++i) {
         d_ruleAddresses.push_back(0);
@@ -73,6 +128,9 @@ RuleSet::RuleSet(const RuleSet& original, bslma::Allocator *basicAllocator)
                   basicAllocator)
 , d_ruleAddresses(basicAllocator)
 , d_freeRuleIds(basicAllocator)
+, d_numPredicates(0)
+, d_predicates(basicAllocator)
+, d_predicateRules(basicAllocator)
 {
     for (int i = 0; i < maxNumRules(); ++i) {
         d_ruleAddresses.push_back(0);
@@ -96,6 +154,7 @@ int RuleSet::addRule(const Rule& value)
     d_freeRuleIds.pop_back();
     d_ruleAddresses[ruleId] = &*iter;
     d_numPredicates += value.numPredicates();
+    indexRule(ruleId, value);
     return ruleId;
 }
 
@@ -132,6 +191,7 @@ int RuleSet::removeRuleById(int id)
     }
 
     d_numPredicates -= rule->numPredicates();
+    unindexRule(id, *rule);
 
     // Note that removing 'iter' from 'd_ruleHashTable' invalidates 'rule'.
     HashtableType::iterator iter = d_ruleHashtable.find(*rule);
@@ -165,6 +225,9 @@ void RuleSet::removeAllRules()
     d_ruleAddresses.clear();
     d_ruleHashtable.clear();
     d_freeRuleIds.clear();
+    d_numPredicates = 0;
+    d_predicates.clear();
+    d_predicateRules.clear();
 
     for (int i = 0; i < maxNumRules(); ++i) {
         d_ruleAddresses.push_back(0);
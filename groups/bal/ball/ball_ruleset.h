@@ -24,10 +24,29 @@ BSLS_IDENT("$Id: $")
 // 'ball::RuleSet', for storage and efficient retrieval of 'ball::Rule'
 // objects.
 //
+// In addition to the rules themselves, a 'ball::RuleSet' maintains an index
+// of the distinct predicates appearing in its rules, mapping each predicate to
+// the bit mask of the rules that hold it (see {Predicate Index}).
+//
 // This component participates in the implementation of "Rule-Based Logging".
 // For more information on how to use that feature, please see the package
 // level documentation and usage examples for "Rule-Based Logging".
 //
+///Predicate Index
+///---------------
+// Rules frequently share predicates (e.g., several rules conditioned on the
+// same "uuid" attribute).  Evaluating each rule independently tests a shared
+// predicate once per rule holding it.  The 'numDistinctPredicates',
+// 'distinctPredicate', and 'predicateRuleMask' accessors expose an index of
+// the distinct predicates of the rules in a rule set, each associated with a
+// 'MaskType' value in which bit 'i' is set if the rule having the id 'i' holds
+// that predicate.  A client evaluating a subset of rules against a collection
+// of attributes can thereby test each distinct predicate at most once: a rule
+// is satisfied if none of its predicates are unsatisfied, i.e., if its bit is
+// not set in the union of the masks of the unsatisfied predicates.  The index
+// is maintained by every manipulator, and the order of its entries is
+// implementation dependent.
+//
 ///Thread Safety
 ///-------------
 // 'ball::RuleSet' is *not* thread-safe in that multiple threads attempting to
@@ -92,6 +111,7 @@ BSLS_IDENT("$Id: $")
 
 #include <balscm_version.h>
 
+#include <ball_predicate.h>
 #include <ball_rule.h>
 
 #include <bslma_allocator.h>
@@ -99,6 +119,8 @@ BSLS_IDENT("$Id: $")
 
 #include <bslmf_nestedtraitdeclaration.h>
 
+#include <bsls_assert.h>
+
 #include <bsl_unordered_set.h>
 #include <bsl_vector.h>
 
@@ -165,11 +187,28 @@ class RuleSet {
 
     int                        d_numPredicates;  // total number of predicates
 
+    bsl::vector<Predicate>     d_predicates;     // distinct predicates of the
+                                                 // rules in this rule set
+
+    bsl::vector<MaskType>      d_predicateRules; // rules holding the predicate
+                                                 // at the same index in
+                                                 // 'd_predicates'
+
     // FRIENDS
     friend bool          operator==(const RuleSet&, const RuleSet&);
     friend bool          operator!=(const RuleSet&, const RuleSet&);
     friend bsl::ostream& operator<<(bsl::ostream&,  const RuleSet&);
 
+    // PRIVATE MANIPULATORS
+    void indexRule(int id, const Rule& rule);
+        // Add each predicate of the specified 'rule', having the specified
+        // 'id', to the predicate index of this rule set.
+
+    void unindexRule(int id, const Rule& rule);
+        // Remove each predicate of the specified 'rule', having the specified
+        // 'id', from the predicate index of this rule set, erasing the
+        // predicates held by no other rule.
+
   public:
     // CLASS METHODS
     static int maxNumRules();
@@ -273,6 +312,25 @@ class RuleSet {
         // Return the total number of predicates in all rules maintained by
         // this object.
 
+    int numDistinctPredicates() const;
+        // Return the number of distinct predicates in all rules maintained by
+        // this object (i.e., the number of entries in the predicate index of
+        // this rule set).
+
+    const Predicate& distinctPredicate(int index) const;
+        // Return a 'const' reference to the distinct predicate at the
+        // specified 'index' in the predicate index of this rule set.  The
+        // behavior is undefined unless '0 <= index < numDistinctPredicates()'.
+        // Note that the reference is invalidated by any manipulator of this
+        // object.
+
+    MaskType predicateRuleMask(int index) const;
+        // Return the bit mask of the rules holding the distinct predicate at
+        // the specified 'index' in the predicate index of this rule set: bit
+        // 'i' of the returned value is set if the rule having the id 'i'
+        // holds 'distinctPredicate(index)'.  The behavior is undefined unless
+        // '0 <= index < numDistinctPredicates()'.
+
     bsl::ostream& print(bsl::ostream& stream,
                         int           level = 0,
                         int           spacesPerLevel = 4) const;
@@ -338,6 +396,30 @@ int RuleSet::numPredicates() const
     return d_numPredicates;
 }
 
+inline
+int RuleSet::numDistinctPredicates() const
+{
+    return static_cast<int>(d_predicates.size());
+}
+
+inline
+const Predicate& RuleSet::distinctPredicate(int index) const
+{
+    BSLS_ASSERT(0 <= index);
+    BSLS_ASSERT(index < numDistinctPredicates());
+
+    return d_predicates[index];
+}
+
+inline
+RuleSet::MaskType RuleSet::predicateRuleMask(int index) const
+{
+    BSLS_ASSERT(0 <= index);
+    BSLS_ASSERT(index < numDistinctPredicates());
+
+    return d_predicateRules[index];
+}
+
 }  // close package namespace
 
 inline
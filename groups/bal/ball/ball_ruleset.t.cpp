@@ -49,6 +49,9 @@ using namespace bsl;  // automatically added by script
 // [ 2] int removeRule(const ball::Rule& value);
 // [10] int removeRules(const ball::RuleSet& rules);
 // [10] void removeAllRules();
+// [11] int numDistinctPredicates() const;
+// [11] const ball::Predicate& distinctPredicate(int index) const;
+// [11] MaskType predicateRuleMask(int index) const;
 // [ 9] const ball::Rule& operator=(const ball::Rule& other);
 // [ 4] int ruleId(const ball::Rule& value) const;
 // [ 4] const ball::Rule *getRuleById(int id) const;
@@ -61,7 +64,7 @@ using namespace bsl;  // automatically added by script
 // [ 1] BREATHING TEST
 // [ 3] PRIMITIVE TEST APPARATUS: 'gg'
 // [ 8] UNUSED
-// [11] USAGE EXAMPLE
+// [12] USAGE EXAMPLE
 
 // ============================================================================
 //                     STANDARD BDE ASSERT TEST FUNCTION
@@ -191,6 +194,68 @@ bool verifyRuleSet(const ball::RuleSet& ruleSet)
     return count == ruleSet.numRules();
 }
 
+bool verifyPredicateIndex(const ball::RuleSet& ruleSet)
+    // Return 'true' if the predicate index of the specified 'ruleSet' holds
+    // each distinct predicate of the rules in the set exactly once, associated
+    // with the mask of the ids of the rules holding it, and if 'numPredicates'
+    // is the total number of predicates of the rules in the set, and 'false'
+    // otherwise.
+{
+    int numPredicates = 0;
+    int numIndexed    = 0;
+
+    for (int i = 0; i < ruleSet.maxNumRules(); ++i) {
+        const ball::Rule *rule = ruleSet.getRuleById(i);
+        if (!rule) {
+            continue;
+        }
+        numPredicates += rule->numPredicates();
+
+        for (ball::PredicateSet::const_iterator iter  = rule->begin();
+                                                iter != rule->end();
+                                              ++iter) {
+            // Find the (unique) entry of the index for '*iter'.
+
+            int index = -1;
+            for (int j = 0; j < ruleSet.numDistinctPredicates(); ++j) {
+                if (ruleSet.distinctPredicate(j) == *iter) {
+                    if (-1 != index) {
+                        return false;                                 // RETURN
+                    }
+                    index = j;
+                }
+            }
+            if (-1 == index) {
+                return false;                                         // RETURN
+            }
+
+            // Compute the expected mask of the rules holding '*iter'.
+
+            ball::RuleSet::MaskType expected = 0;
+            for (int k = 0; k < ruleSet.maxNumRules(); ++k) {
+                const ball::Rule *other = ruleSet.getRuleById(k);
+                if (other && other->hasPredicate(*iter)) {
+                    expected |= static_cast<ball::RuleSet::MaskType>(1) << k;
+                }
+            }
+            if (expected != ruleSet.predicateRuleMask(index)) {
+                return false;                                         // RETURN
+            }
+
+            // Count the entry once, from the rule having the lowest id.
+
+            const ball::RuleSet::MaskType lowerIds =
+                            (static_cast<ball::RuleSet::MaskType>(1) << i) - 1;
+            if (0 == (expected & lowerIds)) {
+                ++numIndexed;
+            }
+        }
+    }
+
+    return numPredicates == ruleSet.numPredicates()
+        && numIndexed    == ruleSet.numDistinctPredicates();
+}
+
 bool compareText(bslstl::StringRef lhs,
                  bslstl::StringRef rhs,
                  bsl::ostream&     errorStream = bsl::cout)
@@ -347,7 +412,7 @@ int main(int argc, char *argv[])
     cout << "TEST " << __FILE__ << " CASE " << test << endl;;
 
     switch (test) { case 0:  // Zero is always the leading case.
-      case 11: {
+      case 12: {
         // --------------------------------------------------------------------
         // TESTING USAGE EXAMPLE
         //
@@ -424,6 +489,112 @@ int main(int argc, char *argv[])
 //..
 
       } break;
+      case 11: {
+        // --------------------------------------------------------------------
+        // TESTING PREDICATE INDEX
+        //
+        // Concerns:
+        //: 1 Each distinct predicate of the rules in a rule set appears
+        //:   exactly once in the predicate index.
+        //:
+        //: 2 The mask associated with a predicate has a bit set for each rule
+        //:   holding the predicate, and no other bit set.
+        //:
+        //: 3 Removing a rule clears its bit in the mask of each of its
+        //:   predicates, and erases the predicates held by no other rule.
+        //:
+        //: 4 The index is maintained by the copy constructor, the assignment
+        //:   operator, 'addRules', 'removeRules', and 'removeAllRules'.
+        //
+        // Plan:
+        //: 1 For each specification in a table, create a rule set using 'gg',
+        //:   and verify its index using 'verifyPredicateIndex', which compares
+        //:   the index to one computed by brute force.  (C-1..2)
+        //:
+        //: 2 Remove the rules of each rule set one at a time, alternately in
+        //:   increasing and decreasing order of id, verifying the index after
+        //:   each removal.  (C-3)
+        //:
+        //: 3 Verify the index of the copies of each rule set, and after
+        //:   'addRules', 'removeRules', and 'removeAllRules'.  (C-4)
+        //
+        // Testing:
+        //   int numDistinctPredicates() const;
+        //   const ball::Predicate& distinctPredicate(int index) const;
+        //   MaskType predicateRuleMask(int index) const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << "\nTesting Predicate Index"
+                          << "\n=======================" << endl;
+
+        static const struct {
+            int         d_line;           // source line number
+            const char *d_spec;           // spec for rule set
+            int         d_numDistinct;    // expected number of distinct
+                                          // predicates
+        } DATA[] = {
+            // line spec                    numDistinct
+            // ---- ----                    -----------
+            {  L_, "",                      0           },
+            {  L_, "R0",                    0           },
+            {  L_, "R1",                    1           },
+            {  L_, "R1R4",                  1           },
+            {  L_, "R1R2R3",                3           },
+            {  L_, "R3R6R7",                3           },
+            {  L_, "R0R1R2R3R4R5R6R7R8",    9           },
+            {  L_, "r0,32",                 5           },
+            {  L_, "r100,132",              8           },
+        };
+        const int NUM_DATA = sizeof DATA / sizeof *DATA;
+
+        for (int ti = 0; ti < NUM_DATA; ++ti) {
+            const int   LINE = DATA[ti].d_line;
+            const char *SPEC = DATA[ti].d_spec;
+            const int   EXP  = DATA[ti].d_numDistinct;
+
+            if (veryVerbose) { T_ P_(LINE) P_(SPEC) P(EXP) }
+
+            Obj mX(&testAllocator); const Obj& X = gg(&mX, SPEC);
+
+            ASSERTV(LINE, EXP == X.numDistinctPredicates());
+            ASSERTV(LINE, verifyPredicateIndex(X));
+
+            const Obj Y(X, &testAllocator);
+            ASSERTV(LINE, EXP == Y.numDistinctPredicates());
+            ASSERTV(LINE, verifyPredicateIndex(Y));
+
+            Obj mZ(&testAllocator); const Obj& Z = gg(&mZ, "R7R8");
+            mZ = X;
+            ASSERTV(LINE, EXP == Z.numDistinctPredicates());
+            ASSERTV(LINE, verifyPredicateIndex(Z));
+
+            mZ.removeRules(X);
+            ASSERTV(LINE, 0 == Z.numDistinctPredicates());
+            ASSERTV(LINE, verifyPredicateIndex(Z));
+
+            mZ.addRules(X);
+            ASSERTV(LINE, EXP == Z.numDistinctPredicates());
+            ASSERTV(LINE, verifyPredicateIndex(Z));
+
+            mZ.removeAllRules();
+            ASSERTV(LINE, 0 == Z.numDistinctPredicates());
+            ASSERTV(LINE, 0 == Z.numPredicates());
+            ASSERTV(LINE, verifyPredicateIndex(Z));
+
+            int low  = 0;
+            int high = X.maxNumRules() - 1;
+            for (int n = 0; low <= high; ++n) {
+                const int id = n % 2 ? high-- : low++;
+
+                if (X.getRuleById(id)) {
+                    ASSERTV(LINE, id, 1 == mX.removeRuleById(id));
+                    ASSERTV(LINE, id, verifyPredicateIndex(X));
+                }
+            }
+            ASSERTV(LINE, 0 == X.numRules());
+            ASSERTV(LINE, 0 == X.numDistinctPredicates());
+        }
+      } break;
       case 10: {
         // --------------------------------------------------------------------
         // TESTING NON-PRIMARY MANIPULATORS
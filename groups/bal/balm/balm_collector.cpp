@@ -12,12 +12,119 @@
 #include <bsls_ident.h>
 BSLS_IDENT_RCSID(balm_collector_cpp,"$Id$ $CSID$")
 
+#include <bslma_default.h>
+
+#include <bslmf_assert.h>
+
+#include <bsls_assert.h>
+#include <bsls_types.h>
+
+#include <bsl_new.h>
+
 namespace BloombergLP {
+namespace balm {
+
+BSLMF_ASSERT(sizeof(Collector_Shard) <= CollectorShardUtil::k_CACHE_LINE_SIZE);
+
+                           // ----------------------
+                           // struct Collector_Shard
+                           // ----------------------
+
+// CREATORS
+Collector_Shard::Collector_Shard()
+: d_count(0)
+, d_total(toBits(0.0))
+, d_min(toBits(MetricRecord::k_DEFAULT_MIN))
+, d_max(toBits(MetricRecord::k_DEFAULT_MAX))
+{
+}
+
+// MANIPULATORS
+void Collector_Shard::exchange(MetricRecord *record)
+{
+    BSLS_ASSERT(record);
+
+    const int    count = d_count.swapAcqRel(0);
+    const double total = fromBits(d_total.swapAcqRel(toBits(0.0)));
+    const double min   = fromBits(d_min.swapAcqRel(
+                                       toBits(MetricRecord::k_DEFAULT_MIN)));
+    const double max   = fromBits(d_max.swapAcqRel(
+                                       toBits(MetricRecord::k_DEFAULT_MAX)));
+
+    record->count() += count;
+    record->total() += total;
+    record->min()   =  bsl::min(record->min(), min);
+    record->max()   =  bsl::max(record->max(), max);
+}
+
+void Collector_Shard::reset()
+{
+    d_count.storeRelaxed(0);
+    d_total.storeRelaxed(toBits(0.0));
+    d_min.storeRelaxed(toBits(MetricRecord::k_DEFAULT_MIN));
+    d_max.storeRelaxed(toBits(MetricRecord::k_DEFAULT_MAX));
+}
+
+// ACCESSORS
+void Collector_Shard::combineInto(MetricRecord *record) const
+{
+    BSLS_ASSERT(record);
+
+    record->count() += d_count.loadAcquire();
+    record->total() += fromBits(d_total.loadAcquire());
+    record->min()   =  bsl::min(record->min(), fromBits(d_min.loadAcquire()));
+    record->max()   =  bsl::max(record->max(), fromBits(d_max.loadAcquire()));
+}
 
                               // ---------------
                               // class Collector
                               // ---------------
 
+// CREATORS
+Collector::Collector(const MetricId&   metricId,
+                     int               numShards,
+                     bslma::Allocator *basicAllocator)
+: d_record(metricId)
+, d_lock()
+, d_buffer_p(0)
+, d_shards_p(0)
+, d_shardMask(0)
+, d_allocator_p(bslma::Default::allocator(basicAllocator))
+{
+    BSLS_ASSERT(0 <= numShards);
+
+    const int count = 0 == numShards
+                      ? CollectorShardUtil::defaultNumShards()
+                      : CollectorShardUtil::roundUpNumShards(numShards);
+
+    // Allocate one additional cache line so that the first shard can be
+    // aligned on a cache-line boundary.
+
+    const int k_LINE = CollectorShardUtil::k_CACHE_LINE_SIZE;
+
+    d_buffer_p = d_allocator_p->allocate((count + 1) * k_LINE);
+
+    const bsls::Types::UintPtr address =
+                            reinterpret_cast<bsls::Types::UintPtr>(d_buffer_p);
+    d_shards_p = static_cast<char *>(d_buffer_p)
+               + (k_LINE - address % k_LINE) % k_LINE;
+
+    for (int i = 0; i < count; ++i) {
+        new (d_shards_p + i * k_LINE) Collector_Shard();
+    }
+    d_shardMask = count - 1;
+}
+
+Collector::~Collector()
+{
+    if (d_buffer_p) {
+        // 'Collector_Shard' is trivially destructible.
+
+        d_allocator_p->deallocate(d_buffer_p);
+    }
+}
+
+}  // close package namespace
 }  // close enterprise namespace
 
 // ----------------------------------------------------------------------------
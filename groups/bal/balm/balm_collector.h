@@ -34,6 +34,26 @@ BSLS_IDENT("$Id: balm_collector.h,v 1.7 2008/04/16 20:00:49 hversche Exp $")
 // clients should not need to access a 'balm::Collector' directly, but instead
 // use it through another type (see 'balm_metric').
 //
+///Sharded Mode
+///------------
+// By default, a 'balm::Collector' serializes every operation on a single
+// mutex, so that a metric updated from many threads concurrently becomes a
+// point of contention.  A collector created with a number of shards (see the
+// two-argument constructor) instead holds that many independent accumulators,
+// each occupying its own cache line, and each thread calling 'update' or
+// 'accumulateCountTotalMinMax' modifies the accumulator selected by its thread
+// index (see 'balm_collectorshardutil') using atomic operations, without
+// acquiring a lock.  The count, total, minimum, and maximum of the shards are
+// combined only by 'load' and 'loadAndReset'.
+//
+// The consistency guarantees of a sharded collector are weaker than those of
+// a non-sharded one: an update concurrent with 'load', 'loadAndReset',
+// 'reset', or 'setCountTotalMinMax' may be partially reflected (e.g., the
+// count of an update may be attributed to one 'loadAndReset' and its value to
+// the next), although no update is ever lost or counted twice by successive
+// calls to 'loadAndReset'.  Sharding is therefore appropriate for frequently
+// updated metrics that are published periodically.
+//
 ///Alternative Systems for Telemetry
 ///---------------------------------
 // Bloomberg software may alternatively use the GUTS telemetry API, which is
@@ -82,19 +102,77 @@ BSLS_IDENT("$Id: balm_collector.h,v 1.7 2008/04/16 20:00:49 hversche Exp $")
 
 #include <balscm_version.h>
 
+#include <balm_collectorshardutil.h>
 #include <balm_metricrecord.h>
 #include <balm_metricid.h>
 
+#include <bslma_allocator.h>
+
 #include <bslmt_mutex.h>
 #include <bslmt_lockguard.h>
 
+#include <bsls_atomic.h>
+#include <bsls_types.h>
+
 #include <bsl_algorithm.h>
+#include <bsl_cstring.h>
 
 namespace BloombergLP {
 
 
 namespace balm {
 
+                           // ======================
+                           // struct Collector_Shard
+                           // ======================
+
+struct Collector_Shard {
+    // This 'struct' holds the accumulated count, total, minimum, and maximum
+    // of one shard of a sharded 'Collector'.  The 'double' aggregates are
+    // stored as their 64-bit patterns so that they can be updated atomically.
+    // This 'struct' is an implementation detail of 'Collector', and must not
+    // be used directly by clients.
+
+    // DATA
+    bsls::AtomicInt   d_count;  // aggregated count of events
+    bsls::AtomicInt64 d_total;  // bit pattern of the total of values
+    bsls::AtomicInt64 d_min;    // bit pattern of the minimum value
+    bsls::AtomicInt64 d_max;    // bit pattern of the maximum value
+
+    // CLASS METHODS
+    static double fromBits(bsls::Types::Int64 bits);
+        // Return the 'double' value having the specified 'bits'.
+
+    static bsls::Types::Int64 toBits(double value);
+        // Return the bit pattern of the specified 'value'.
+
+    // CREATORS
+    Collector_Shard();
+        // Create a shard having a count of 0, total of 0.0, min of
+        // 'MetricRecord::k_DEFAULT_MIN', and max of
+        // 'MetricRecord::k_DEFAULT_MAX'.
+
+    // MANIPULATORS
+    void accumulate(int count, double total, double min, double max);
+        // Atomically add the specified 'count' and 'total' to the count and
+        // total of this shard, and lower (raise) the minimum (maximum) of this
+        // shard to the specified 'min' ('max') if it is less (greater).
+
+    void exchange(MetricRecord *record);
+        // Set the count, total, minimum, and maximum of this shard to their
+        // default values and combine their previous values into the specified
+        // 'record'.
+
+    void reset();
+        // Set the count, total, minimum, and maximum of this shard to their
+        // default values.
+
+    // ACCESSORS
+    void combineInto(MetricRecord *record) const;
+        // Combine the count, total, minimum, and maximum of this shard into
+        // the specified 'record'.
+};
+
                               // ===============
                               // class Collector
                               // ===============
@@ -110,13 +188,46 @@ class Collector {
     // the default maximum value is 'MetricRecord::k_DEFAULT_MAX'.
 
     // DATA
-    MetricRecord         d_record;  // the recorded metric information
-    mutable bslmt::Mutex d_lock;    // record synchronization mechanism
+    MetricRecord          d_record;      // the recorded metric information
+                                         // (only the metric id is used in
+                                         // sharded mode)
+
+    mutable bslmt::Mutex  d_lock;        // record synchronization mechanism
+                                         // (serializes loads and resets in
+                                         // sharded mode)
+
+    void                 *d_buffer_p;    // memory holding the shards, or 0
+                                         // if this collector is not sharded
+
+    char                 *d_shards_p;    // cache-line aligned address of the
+                                         // first shard, or 0
+
+    int                   d_shardMask;   // number of shards minus one
+
+    bslma::Allocator     *d_allocator_p; // memory allocator (held, not
+                                         // owned), or 0
 
     // NOT IMPLEMENTED
     Collector(const Collector&);
     Collector& operator=(const Collector&);
 
+    // PRIVATE MANIPULATORS
+    Collector_Shard& shard(int index);
+        // Return a reference to the shard having the specified 'index'.  The
+        // behavior is undefined unless this collector is sharded and
+        // '0 <= index < numShards()'.
+
+    Collector_Shard& threadShard();
+        // Return a reference to the shard to be updated by the calling
+        // thread.  The behavior is undefined unless this collector is
+        // sharded.
+
+    // PRIVATE ACCESSORS
+    const Collector_Shard& shard(int index) const;
+        // Return a reference to the non-modifiable shard having the specified
+        // 'index'.  The behavior is undefined unless this collector is sharded
+        // and '0 <= index < numShards()'.
+
   public:
      // CREATORS
     Collector(const MetricId& metricId);
@@ -125,6 +236,21 @@ class Collector {
         // 'MetricRecord::k_DEFAULT_MIN', and max of
         // 'MetricRecord::k_DEFAULT_MAX'.
 
+    Collector(const MetricId&   metricId,
+              int               numShards,
+              bslma::Allocator *basicAllocator = 0);
+        // Create a sharded collector (see {Sharded Mode}) for a metric having
+        // the specified 'metricId', using the specified 'numShards' rounded up
+        // to a power of two (see 'CollectorShardUtil::roundUpNumShards') as
+        // the number of independently updated accumulators, and having an
+        // initial count of 0, total of 0.0, min of
+        // 'MetricRecord::k_DEFAULT_MIN', and max of
+        // 'MetricRecord::k_DEFAULT_MAX'.  If 'numShards' is 0, the number of
+        // shards is 'CollectorShardUtil::defaultNumShards()'.  Optionally
+        // specify a 'basicAllocator' used to supply memory.  If
+        // 'basicAllocator' is 0, the currently installed default allocator is
+        // used.  The behavior is undefined unless '0 <= numShards'.
+
     ~Collector();
         // Destroy this object.
 
@@ -177,26 +303,116 @@ class Collector {
         // Load into the specified 'record' the id of the metric being
         // collected, as well as the current count, total, minimum, and
         // maximum aggregated values for the metric.
+
+    int numShards() const;
+        // Return the number of shards of this collector, or 0 if this
+        // collector is not sharded.
 };
 
 // ============================================================================
 //                            INLINE DEFINITIONS
 // ============================================================================
 
+                           // ----------------------
+                           // struct Collector_Shard
+                           // ----------------------
+
+// CLASS METHODS
+inline
+double Collector_Shard::fromBits(bsls::Types::Int64 bits)
+{
+    double value;
+    bsl::memcpy(&value, &bits, sizeof value);
+    return value;
+}
+
+inline
+bsls::Types::Int64 Collector_Shard::toBits(double value)
+{
+    bsls::Types::Int64 bits;
+    bsl::memcpy(&bits, &value, sizeof bits);
+    return bits;
+}
+
+// MANIPULATORS
+inline
+void Collector_Shard::accumulate(int    count,
+                                 double total,
+                                 double min,
+                                 double max)
+{
+    d_count.addRelaxed(count);
+
+    bsls::Types::Int64 expected = d_total.loadRelaxed();
+    for (;;) {
+        const bsls::Types::Int64 previous = d_total.testAndSwapAcqRel(
+                                         expected,
+                                         toBits(fromBits(expected) + total));
+        if (previous == expected) {
+            break;
+        }
+        expected = previous;
+    }
+
+    expected = d_min.loadRelaxed();
+    while (min < fromBits(expected)) {
+        const bsls::Types::Int64 previous = d_min.testAndSwapAcqRel(
+                                                                 expected,
+                                                                 toBits(min));
+        if (previous == expected) {
+            break;
+        }
+        expected = previous;
+    }
+
+    expected = d_max.loadRelaxed();
+    while (max > fromBits(expected)) {
+        const bsls::Types::Int64 previous = d_max.testAndSwapAcqRel(
+                                                                 expected,
+                                                                 toBits(max));
+        if (previous == expected) {
+            break;
+        }
+        expected = previous;
+    }
+}
+
                               // ---------------
                               // class Collector
                               // ---------------
 
-// CREATORS
+// PRIVATE MANIPULATORS
 inline
-Collector::Collector(const MetricId& metricId)
-: d_record(metricId)
-, d_lock()
+Collector_Shard& Collector::shard(int index)
 {
+    return *reinterpret_cast<Collector_Shard *>(
+                   d_shards_p + index * CollectorShardUtil::k_CACHE_LINE_SIZE);
 }
 
 inline
-Collector::~Collector()
+Collector_Shard& Collector::threadShard()
+{
+    return shard(static_cast<int>(CollectorShardUtil::threadIndex())
+                                                                & d_shardMask);
+}
+
+// PRIVATE ACCESSORS
+inline
+const Collector_Shard& Collector::shard(int index) const
+{
+    return *reinterpret_cast<const Collector_Shard *>(
+                   d_shards_p + index * CollectorShardUtil::k_CACHE_LINE_SIZE);
+}
+
+// CREATORS
+inline
+Collector::Collector(const MetricId& metricId)
+: d_record(metricId)
+, d_lock()
+, d_buffer_p(0)
+, d_shards_p(0)
+, d_shardMask(0)
+, d_allocator_p(0)
 {
 }
 
@@ -205,6 +421,12 @@ inline
 void Collector::reset()
 {
     bslmt::LockGuard<bslmt::Mutex> guard(&d_lock);
+    if (d_shards_p) {
+        for (int i = 0; i <= d_shardMask; ++i) {
+            shard(i).reset();
+        }
+        return;                                                       // RETURN
+    }
     d_record.count() = 0;
     d_record.total() = 0.0;
     d_record.min()   = MetricRecord::k_DEFAULT_MIN;
@@ -215,6 +437,13 @@ inline
 void Collector::loadAndReset(MetricRecord *record)
 {
     bslmt::LockGuard<bslmt::Mutex> guard(&d_lock);
+    if (d_shards_p) {
+        *record = MetricRecord(d_record.metricId());
+        for (int i = 0; i <= d_shardMask; ++i) {
+            shard(i).exchange(record);
+        }
+        return;                                                       // RETURN
+    }
     *record          = d_record;
     d_record.count() = 0;
     d_record.total() = 0.0;
@@ -225,6 +454,10 @@ void Collector::loadAndReset(MetricRecord *record)
 inline
 void Collector::update(double value)
 {
+    if (d_shards_p) {
+        threadShard().accumulate(1, value, value, value);
+        return;                                                       // RETURN
+    }
     bslmt::LockGuard<bslmt::Mutex> guard(&d_lock);
     ++d_record.count();
     d_record.total() += value;
@@ -238,6 +471,10 @@ void Collector::accumulateCountTotalMinMax(int    count,
                                            double min,
                                            double max)
 {
+    if (d_shards_p) {
+        threadShard().accumulate(count, total, min, max);
+        return;                                                       // RETURN
+    }
     bslmt::LockGuard<bslmt::Mutex> guard(&d_lock);
     d_record.count() += count;
     d_record.total() += total;
@@ -252,6 +489,17 @@ void Collector::setCountTotalMinMax(int    count,
                                     double max)
 {
     bslmt::LockGuard<bslmt::Mutex> guard(&d_lock);
+    if (d_shards_p) {
+        for (int i = 1; i <= d_shardMask; ++i) {
+            shard(i).reset();
+        }
+        Collector_Shard& first = shard(0);
+        first.d_count.storeRelaxed(count);
+        first.d_total.storeRelaxed(Collector_Shard::toBits(total));
+        first.d_min.storeRelaxed(Collector_Shard::toBits(min));
+        first.d_max.storeRelaxed(Collector_Shard::toBits(max));
+        return;                                                       // RETURN
+    }
     d_record.count() = count;
     d_record.total() = total;
     d_record.min()   = min;
@@ -269,8 +517,21 @@ inline
 void Collector::load(MetricRecord *record) const
 {
     bslmt::LockGuard<bslmt::Mutex> guard(&d_lock);
+    if (d_shards_p) {
+        *record = MetricRecord(d_record.metricId());
+        for (int i = 0; i <= d_shardMask; ++i) {
+            shard(i).combineInto(record);
+        }
+        return;                                                       // RETURN
+    }
     *record = d_record;
 }
+
+inline
+int Collector::numShards() const
+{
+    return d_shards_p ? d_shardMask + 1 : 0;
+}
 }  // close package namespace
 
 }  // close enterprise namespace
@@ -0,0 +1,107 @@
+// balm_collectorshardutil.cpp                                        -*-C++-*-
+#include <balm_collectorshardutil.h>
+
+#include <bsls_ident.h>
+BSLS_IDENT_RCSID(balm_collectorshardutil_cpp,"$Id$ $CSID$")
+
+#include <bslmt_once.h>
+#include <bslmt_threadlocalvariable.h>
+#include <bslmt_threadutil.h>
+
+#include <bsls_assert.h>
+#include <bsls_atomic.h>
+#include <bsls_types.h>
+
+namespace BloombergLP {
+
+namespace {
+
+bsls::AtomicUint g_nextThreadIndex(0);
+    // next thread index to be assigned
+
+// On supported platforms, define a thread-local variable,
+// 'g_threadIndexPlusOne', to cache the index of the calling thread; a value
+// of 0 indicates that the index has not yet been assigned.  On other
+// platforms the index is kept in 'bslmt::ThreadUtil' thread-specific storage.
+
+#ifdef BSLMT_THREAD_LOCAL_VARIABLE
+BSLMT_THREAD_LOCAL_VARIABLE(unsigned int, g_threadIndexPlusOne, 0);
+#else
+const bslmt::ThreadUtil::Key& threadIndexKey()
+    // Return a reference to the non-modifiable thread-specific storage key
+    // holding the index (plus one) of each thread.
+{
+    static bslmt::ThreadUtil::Key s_key;
+    BSLMT_ONCE_DO {
+        bslmt::ThreadUtil::createKey(&s_key, 0);
+    }
+    return s_key;
+}
+#endif
+
+}  // close unnamed namespace
+
+namespace balm {
+
+                          // -------------------------
+                          // struct CollectorShardUtil
+                          // -------------------------
+
+// CLASS METHODS
+int CollectorShardUtil::defaultNumShards()
+{
+    const unsigned int concurrency = bslmt::ThreadUtil::hardwareConcurrency();
+    return roundUpNumShards(0 < concurrency && concurrency < k_MAX_NUM_SHARDS
+                            ? static_cast<int>(concurrency)
+                            : k_MAX_NUM_SHARDS);
+}
+
+int CollectorShardUtil::roundUpNumShards(int numShards)
+{
+    BSLS_ASSERT(0 < numShards);
+
+    int rv = 1;
+    while (rv < numShards && rv < k_MAX_NUM_SHARDS) {
+        rv <<= 1;
+    }
+    return rv;
+}
+
+unsigned int CollectorShardUtil::threadIndex()
+{
+#ifdef BSLMT_THREAD_LOCAL_VARIABLE
+    if (0 == g_threadIndexPlusOne) {
+        g_threadIndexPlusOne = g_nextThreadIndex.addRelaxed(1);
+    }
+    return g_threadIndexPlusOne - 1;
+#else
+    const bslmt::ThreadUtil::Key& key = threadIndexKey();
+
+    bsls::Types::UintPtr value = reinterpret_cast<bsls::Types::UintPtr>(
+                                          bslmt::ThreadUtil::getSpecific(key));
+    if (0 == value) {
+        value = g_nextThreadIndex.addRelaxed(1);
+        bslmt::ThreadUtil::setSpecific(key, reinterpret_cast<void *>(value));
+    }
+    return static_cast<unsigned int>(value - 1);
+#endif
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+// ----------------------------------------------------------------------------
+// Copyright 2020 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
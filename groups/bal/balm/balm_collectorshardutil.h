@@ -0,0 +1,106 @@
+// balm_collectorshardutil.h                                          -*-C++-*-
+#ifndef INCLUDED_BALM_COLLECTORSHARDUTIL
+#define INCLUDED_BALM_COLLECTORSHARDUTIL
+
+#include <bsls_ident.h>
+BSLS_IDENT("$Id: $")
+
+//@PURPOSE: Provide utilities for sharding the state of metric collectors.
+//
+//@CLASSES:
+//   balm::CollectorShardUtil: namespace for collector sharding utilities
+//
+//@SEE_ALSO: balm_collector, balm_integercollector
+//
+//@DESCRIPTION: This component provides a utility 'struct',
+// 'balm::CollectorShardUtil', that supplies the operations shared by the
+// sharded modes of 'balm::Collector' and 'balm::IntegerCollector'.  A sharded
+// collector holds an array of independently updated accumulators ("shards"),
+// each occupying its own cache line, and each thread updating the collector
+// selects a shard using the small integer returned by 'threadIndex'.  Thread
+// indices are assigned in the order in which threads first call
+// 'threadIndex', so that the first 'N' threads to update a collector having
+// 'N' shards each update a distinct shard.
+//
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Selecting a Shard
+/// - - - - - - - - - - - - - -
+// Suppose we maintain a number of per-shard counters and want each thread to
+// update its own counter.  First, we determine the number of shards, which
+// must be a power of two:
+//..
+//  const int numShards = balm::CollectorShardUtil::roundUpNumShards(6);
+//  assert(8 == numShards);
+//..
+// Then, we select the shard of the calling thread:
+//..
+//  const unsigned int index = balm::CollectorShardUtil::threadIndex()
+//                           & (numShards - 1);
+//  assert(index < 8);
+//..
+// Finally, we observe that the index of the calling thread does not change:
+//..
+//  assert(index == (balm::CollectorShardUtil::threadIndex()
+//                                                       & (numShards - 1)));
+//..
+
+#include <balscm_version.h>
+
+namespace BloombergLP {
+namespace balm {
+
+                          // =========================
+                          // struct CollectorShardUtil
+                          // =========================
+
+struct CollectorShardUtil {
+    // This 'struct' provides a namespace for utility functions supporting the
+    // sharded modes of the metric collectors.
+
+    // PUBLIC CONSTANTS
+    enum {
+        k_CACHE_LINE_SIZE = 64,   // size (and alignment) of a shard
+        k_MAX_NUM_SHARDS  = 256   // maximum number of shards of a collector
+    };
+
+    // CLASS METHODS
+    static int defaultNumShards();
+        // Return the number of shards a sharded collector uses if no number is
+        // explicitly requested: the hardware concurrency of the host rounded
+        // up to a power of two, and at most 'k_MAX_NUM_SHARDS'.
+
+    static int roundUpNumShards(int numShards);
+        // Return the smallest power of two that is not less than the
+        // specified 'numShards', and at most 'k_MAX_NUM_SHARDS'.  The behavior
+        // is undefined unless '0 < numShards'.
+
+    static unsigned int threadIndex();
+        // Return a small integer identifying the calling thread.  The first
+        // thread to call this method (in this process) is assigned 0, the
+        // second 1, and so on; subsequent calls from a thread return the
+        // value previously assigned to that thread.
+};
+
+}  // close package namespace
+}  // close enterprise namespace
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2020 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,386 @@
+// balm_collectorshardutil.t.cpp                                      -*-C++-*-
+#include <balm_collectorshardutil.h>
+
+#include <bslim_testutil.h>
+
+#include <bslmt_barrier.h>
+#include <bslmt_threadgroup.h>
+#include <bslmt_threadutil.h>
+
+#include <bdlf_bind.h>
+
+#include <bsls_asserttest.h>
+
+#include <bsl_algorithm.h>
+#include <bsl_cstdlib.h>
+#include <bsl_iostream.h>
+#include <bsl_vector.h>
+
+using namespace BloombergLP;
+using bsl::cout;
+using bsl::endl;
+
+// ============================================================================
+//                                  TEST PLAN
+// ----------------------------------------------------------------------------
+//                                  Overview
+//                                  --------
+// The component under test is a utility 'struct' whose functions supply the
+// number of shards of a sharded collector and the index of the calling
+// thread.  'roundUpNumShards' is tested with a table of values.
+// 'defaultNumShards' is tested against the hardware concurrency.
+// 'threadIndex' is tested by calling it from a number of threads and
+// verifying the indices are distinct and stable.
+// ----------------------------------------------------------------------------
+// CLASS METHODS
+// [ 2] int defaultNumShards();
+// [ 2] int roundUpNumShards(int numShards);
+// [ 3] unsigned int threadIndex();
+// ----------------------------------------------------------------------------
+// [ 1] BREATHING TEST
+// [ 4] USAGE EXAMPLE
+
+// ============================================================================
+//                     STANDARD BDE ASSERT TEST FUNCTION
+// ----------------------------------------------------------------------------
+
+namespace {
+
+int testStatus = 0;
+
+void aSsErT(bool condition, const char *message, int line)
+{
+    if (condition) {
+        cout << "Error " __FILE__ "(" << line << "): " << message
+             << "    (failed)" << endl;
+
+        if (0 <= testStatus && testStatus <= 100) {
+            ++testStatus;
+        }
+    }
+}
+
+}  // close unnamed namespace
+
+// ============================================================================
+//               STANDARD BDE TEST DRIVER MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT       BSLIM_TESTUTIL_ASSERT
+#define ASSERTV      BSLIM_TESTUTIL_ASSERTV
+
+#define LOOP_ASSERT  BSLIM_TESTUTIL_LOOP_ASSERT
+#define LOOP0_ASSERT BSLIM_TESTUTIL_LOOP0_ASSERT
+#define LOOP1_ASSERT BSLIM_TESTUTIL_LOOP1_ASSERT
+#define LOOP2_ASSERT BSLIM_TESTUTIL_LOOP2_ASSERT
+#define LOOP3_ASSERT BSLIM_TESTUTIL_LOOP3_ASSERT
+#define LOOP4_ASSERT BSLIM_TESTUTIL_LOOP4_ASSERT
+#define LOOP5_ASSERT BSLIM_TESTUTIL_LOOP5_ASSERT
+#define LOOP6_ASSERT BSLIM_TESTUTIL_LOOP6_ASSERT
+
+#define Q            BSLIM_TESTUTIL_Q   // Quote identifier literally.
+#define P            BSLIM_TESTUTIL_P   // Print identifier and value.
+#define P_           BSLIM_TESTUTIL_P_  // P(X) without '\n'.
+#define T_           BSLIM_TESTUTIL_T_  // Print a tab (w/o newline).
+#define L_           BSLIM_TESTUTIL_L_  // current Line number
+
+// ============================================================================
+//                  NEGATIVE-TEST MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT_PASS(EXPR)      BSLS_ASSERTTEST_ASSERT_PASS(EXPR)
+#define ASSERT_FAIL(EXPR)      BSLS_ASSERTTEST_ASSERT_FAIL(EXPR)
+
+// ============================================================================
+//                  GLOBAL TYPEDEFS/CONSTANTS FOR TESTING
+// ----------------------------------------------------------------------------
+
+typedef balm::CollectorShardUtil Util;
+
+// ============================================================================
+//                      GLOBAL HELPER FUNCTIONS FOR TESTING
+// ----------------------------------------------------------------------------
+
+void loadThreadIndex(unsigned int *result, bslmt::Barrier *barrier)
+    // Wait on the specified 'barrier', then load the index of the calling
+    // thread into the specified 'result', verifying that subsequent calls to
+    // 'threadIndex' return the same value.  Wait on 'barrier' again before
+    // returning, so that all the calling threads are alive at the same time.
+{
+    barrier->wait();
+    *result = Util::threadIndex();
+    for (int i = 0; i < 100; ++i) {
+        ASSERTV(*result, Util::threadIndex(), *result == Util::threadIndex());
+    }
+    barrier->wait();
+}
+
+// ============================================================================
+//                               MAIN PROGRAM
+// ----------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    int         test = argc > 1 ? bsl::atoi(argv[1]) : 0;
+    bool     verbose = argc > 2;
+    bool veryVerbose = argc > 3;
+
+    cout << "TEST " << __FILE__ << " CASE " << test << endl;
+
+    switch (test) { case 0:  // Zero is always the leading case.
+      case 4: {
+        // --------------------------------------------------------------------
+        // USAGE EXAMPLE
+        //   Extracted from component header file.
+        //
+        // Concerns:
+        //: 1 The usage example provided in the component header file compiles,
+        //:   links, and runs as shown.
+        //
+        // Plan:
+        //: 1 Incorporate usage example from header into test driver, remove
+        //:   leading comment characters, and replace 'assert' with 'ASSERT'.
+        //:   (C-1)
+        //
+        // Testing:
+        //   USAGE EXAMPLE
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "USAGE EXAMPLE" << endl
+                          << "=============" << endl;
+
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Selecting a Shard
+/// - - - - - - - - - - - - - -
+// Suppose we maintain a number of per-shard counters and want each thread to
+// update its own counter.  First, we determine the number of shards, which
+// must be a power of two:
+//..
+    const int numShards = balm::CollectorShardUtil::roundUpNumShards(6);
+    ASSERT(8 == numShards);
+//..
+// Then, we select the shard of the calling thread:
+//..
+    const unsigned int index = balm::CollectorShardUtil::threadIndex()
+                             & (numShards - 1);
+    ASSERT(index < 8);
+//..
+// Finally, we observe that the index of the calling thread does not change:
+//..
+    ASSERT(index == (balm::CollectorShardUtil::threadIndex()
+                                                         & (numShards - 1)));
+//..
+      } break;
+      case 3: {
+        // --------------------------------------------------------------------
+        // TESTING 'threadIndex'
+        //
+        // Concerns:
+        //: 1 'threadIndex' returns the same value on every call from a thread.
+        //:
+        //: 2 Threads that are alive at the same time are assigned distinct
+        //:   indices.
+        //
+        // Plan:
+        //: 1 Call 'threadIndex' repeatedly from the main thread and from a
+        //:   number of concurrently running threads, and verify that each
+        //:   thread observes a single value, and that the values are
+        //:   distinct.  (C-1..2)
+        //
+        // Testing:
+        //   unsigned int threadIndex();
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "TESTING 'threadIndex'" << endl
+                          << "=====================" << endl;
+
+        const int NUM_THREADS = 16;
+
+        const unsigned int MAIN_INDEX = Util::threadIndex();
+        ASSERT(MAIN_INDEX == Util::threadIndex());
+
+        bsl::vector<unsigned int> indices(NUM_THREADS, 0);
+        bslmt::Barrier            barrier(NUM_THREADS);
+        bslmt::ThreadGroup        threadGroup;
+
+        for (int i = 0; i < NUM_THREADS; ++i) {
+            ASSERT(0 == threadGroup.addThread(
+                                       bdlf::BindUtil::bind(&loadThreadIndex,
+                                                            &indices[i],
+                                                            &barrier)));
+        }
+        threadGroup.joinAll();
+
+        indices.push_back(MAIN_INDEX);
+        bsl::sort(indices.begin(), indices.end());
+
+        if (veryVerbose) {
+            for (bsl::size_t i = 0; i < indices.size(); ++i) {
+                T_ P(indices[i])
+            }
+        }
+
+        ASSERT(indices.end() ==
+                          bsl::adjacent_find(indices.begin(), indices.end()));
+        ASSERT(MAIN_INDEX == Util::threadIndex());
+      } break;
+      case 2: {
+        // --------------------------------------------------------------------
+        // TESTING 'roundUpNumShards' AND 'defaultNumShards'
+        //
+        // Concerns:
+        //: 1 'roundUpNumShards' returns the smallest power of two not less
+        //:   than its argument, limited to 'k_MAX_NUM_SHARDS'.
+        //:
+        //: 2 'defaultNumShards' returns a power of two not less than the
+        //:   hardware concurrency, limited to 'k_MAX_NUM_SHARDS'.
+        //:
+        //: 3 QoI: Asserted precondition violations are detected when enabled.
+        //
+        // Plan:
+        //: 1 Using the table-driven technique, verify the result of
+        //:   'roundUpNumShards' for a set of values.  (C-1)
+        //:
+        //: 2 Compare the result of 'defaultNumShards' to the result of
+        //:   'roundUpNumShards' on the hardware concurrency.  (C-2)
+        //:
+        //: 3 Verify that, in appropriate build modes, defensive checks are
+        //:   triggered for invalid arguments.  (C-3)
+        //
+        // Testing:
+        //   int defaultNumShards();
+        //   int roundUpNumShards(int numShards);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                   << "TESTING 'roundUpNumShards' AND 'defaultNumShards'"
+                   << endl
+                   << "================================================="
+                   << endl;
+
+        static const struct {
+            int d_line;       // source line number
+            int d_numShards;  // argument
+            int d_expected;   // expected result
+        } DATA[] = {
+            //LINE  ARG        EXP
+            //----  ---------  ---
+            { L_,           1,   1 },
+            { L_,           2,   2 },
+            { L_,           3,   4 },
+            { L_,           4,   4 },
+            { L_,           5,   8 },
+            { L_,           7,   8 },
+            { L_,           9,  16 },
+            { L_,          33,  64 },
+            { L_,         128, 128 },
+            { L_,         129, 256 },
+            { L_,         256, 256 },
+            { L_,         257, 256 },
+            { L_,  0x7fffffff, 256 },
+        };
+        const int NUM_DATA = static_cast<int>(sizeof DATA / sizeof *DATA);
+
+        for (int ti = 0; ti < NUM_DATA; ++ti) {
+            const int LINE = DATA[ti].d_line;
+            const int ARG  = DATA[ti].d_numShards;
+            const int EXP  = DATA[ti].d_expected;
+
+            if (veryVerbose) { T_ P_(LINE) P_(ARG) P(EXP) }
+
+            ASSERTV(LINE, EXP, Util::roundUpNumShards(ARG),
+                    EXP == Util::roundUpNumShards(ARG));
+        }
+
+        const int          NUM_SHARDS  = Util::defaultNumShards();
+        const unsigned int CONCURRENCY =
+                                     bslmt::ThreadUtil::hardwareConcurrency();
+
+        if (veryVerbose) { T_ P_(NUM_SHARDS) P(CONCURRENCY) }
+
+        ASSERT(0 < NUM_SHARDS);
+        ASSERT(NUM_SHARDS <= Util::k_MAX_NUM_SHARDS);
+        ASSERT(0 == (NUM_SHARDS & (NUM_SHARDS - 1)));
+        if (0 < CONCURRENCY && CONCURRENCY < Util::k_MAX_NUM_SHARDS) {
+            ASSERTV(NUM_SHARDS, CONCURRENCY,
+                    Util::roundUpNumShards(CONCURRENCY) == NUM_SHARDS);
+        }
+        else {
+            ASSERT(Util::k_MAX_NUM_SHARDS == NUM_SHARDS);
+        }
+
+        if (verbose) cout << "\nNegative Testing." << endl;
+        {
+            bsls::AssertTestHandlerGuard hG;
+
+            ASSERT_PASS(Util::roundUpNumShards( 1));
+            ASSERT_FAIL(Util::roundUpNumShards( 0));
+            ASSERT_FAIL(Util::roundUpNumShards(-1));
+        }
+      } break;
+      case 1: {
+        // --------------------------------------------------------------------
+        // BREATHING TEST
+        //   This case exercises (but does not fully test) basic functionality.
+        //
+        // Concerns:
+        //: 1 The class is sufficiently functional to enable comprehensive
+        //:   testing in subsequent test cases.
+        //
+        // Plan:
+        //: 1 Invoke each function and verify the basic properties of its
+        //:   result.  (C-1)
+        //
+        // Testing:
+        //   BREATHING TEST
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "BREATHING TEST" << endl
+                          << "==============" << endl;
+
+        ASSERT(64  == Util::k_CACHE_LINE_SIZE);
+        ASSERT(256 == Util::k_MAX_NUM_SHARDS);
+
+        ASSERT(1 == Util::roundUpNumShards(1));
+        ASSERT(8 == Util::roundUpNumShards(6));
+
+        const int NUM_SHARDS = Util::defaultNumShards();
+        ASSERT(0 < NUM_SHARDS);
+        ASSERT(NUM_SHARDS == Util::roundUpNumShards(NUM_SHARDS));
+
+        const unsigned int INDEX = Util::threadIndex();
+        ASSERT(INDEX == Util::threadIndex());
+      } break;
+      default: {
+        cout << "WARNING: CASE `" << test << "' NOT FOUND." << endl;
+        testStatus = -1;
+      }
+    }
+
+    if (testStatus > 0) {
+        cout << "Error, non-zero test status = " << testStatus << "." << endl;
+    }
+    return testStatus;
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2020 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
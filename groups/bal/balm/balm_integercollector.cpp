@@ -12,9 +12,16 @@
 #include <bsls_ident.h>
 BSLS_IDENT_RCSID(balm_integercollector_cpp,"$Id$ $CSID$")
 
+#include <bslma_default.h>
+
+#include <bslmf_assert.h>
+
+#include <bsls_assert.h>
 #include <bsls_types.h>
 
+#include <bsl_algorithm.h>
 #include <bsl_climits.h>
+#include <bsl_new.h>
 
 namespace BloombergLP {
 
@@ -31,6 +38,117 @@ const int balm::IntegerCollector::DEFAULT_MAX = INT_MIN;
 #endif
 
 namespace balm {
+
+BSLMF_ASSERT(sizeof(IntegerCollector_Shard) <=
+                                        CollectorShardUtil::k_CACHE_LINE_SIZE);
+
+                       // -----------------------------
+                       // struct IntegerCollector_Shard
+                       // -----------------------------
+
+// CREATORS
+IntegerCollector_Shard::IntegerCollector_Shard()
+: d_count(0)
+, d_total(0)
+, d_min(IntegerCollector::k_DEFAULT_MIN)
+, d_max(IntegerCollector::k_DEFAULT_MAX)
+{
+}
+
+// MANIPULATORS
+void IntegerCollector_Shard::reset()
+{
+    d_count.storeRelaxed(0);
+    d_total.storeRelaxed(0);
+    d_min.storeRelaxed(IntegerCollector::k_DEFAULT_MIN);
+    d_max.storeRelaxed(IntegerCollector::k_DEFAULT_MAX);
+}
+
+                           // ----------------------
+                           // class IntegerCollector
+                           // ----------------------
+
+// PRIVATE ACCESSORS
+void IntegerCollector::combineShards(int                *count,
+                                     bsls::Types::Int64 *total,
+                                     int                *min,
+                                     int                *max,
+                                     bool                resetFlag) const
+{
+    BSLS_ASSERT(d_shards_p);
+
+    *count = 0;
+    *total = 0;
+    *min   = k_DEFAULT_MIN;
+    *max   = k_DEFAULT_MAX;
+
+    for (int i = 0; i <= d_shardMask; ++i) {
+        IntegerCollector_Shard& shard =
+                  *reinterpret_cast<IntegerCollector_Shard *>(
+                       d_shards_p + i * CollectorShardUtil::k_CACHE_LINE_SIZE);
+        if (resetFlag) {
+            *count += shard.d_count.swapAcqRel(0);
+            *total += shard.d_total.swapAcqRel(0);
+            *min   =  bsl::min(*min, shard.d_min.swapAcqRel(k_DEFAULT_MIN));
+            *max   =  bsl::max(*max, shard.d_max.swapAcqRel(k_DEFAULT_MAX));
+        }
+        else {
+            *count += shard.d_count.loadAcquire();
+            *total += shard.d_total.loadAcquire();
+            *min   =  bsl::min(*min, shard.d_min.loadAcquire());
+            *max   =  bsl::max(*max, shard.d_max.loadAcquire());
+        }
+    }
+}
+
+// CREATORS
+IntegerCollector::IntegerCollector(const MetricId&   metricId,
+                                   int               numShards,
+                                   bslma::Allocator *basicAllocator)
+: d_metricId(metricId)
+, d_count(0)
+, d_total(0)
+, d_min(k_DEFAULT_MIN)
+, d_max(k_DEFAULT_MAX)
+, d_mutex()
+, d_buffer_p(0)
+, d_shards_p(0)
+, d_shardMask(0)
+, d_allocator_p(bslma::Default::allocator(basicAllocator))
+{
+    BSLS_ASSERT(0 <= numShards);
+
+    const int count = 0 == numShards
+                      ? CollectorShardUtil::defaultNumShards()
+                      : CollectorShardUtil::roundUpNumShards(numShards);
+
+    // Allocate one additional cache line so that the first shard can be
+    // aligned on a cache-line boundary.
+
+    const int k_LINE = CollectorShardUtil::k_CACHE_LINE_SIZE;
+
+    d_buffer_p = d_allocator_p->allocate((count + 1) * k_LINE);
+
+    const bsls::Types::UintPtr address =
+                            reinterpret_cast<bsls::Types::UintPtr>(d_buffer_p);
+    d_shards_p = static_cast<char *>(d_buffer_p)
+               + (k_LINE - address % k_LINE) % k_LINE;
+
+    for (int i = 0; i < count; ++i) {
+        new (d_shards_p + i * k_LINE) IntegerCollector_Shard();
+    }
+    d_shardMask = count - 1;
+}
+
+IntegerCollector::~IntegerCollector()
+{
+    if (d_buffer_p) {
+        // 'IntegerCollector_Shard' is trivially destructible.
+
+        d_allocator_p->deallocate(d_buffer_p);
+    }
+}
+
 // MANIPULATORS
 void IntegerCollector::loadAndReset(MetricRecord *records)
 {
@@ -40,15 +158,20 @@ void IntegerCollector::loadAndReset(MetricRecord *records)
     int                max;
     {
         bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
-        count = d_count;
-        total = d_total;
-        min   = d_min;
-        max   = d_max;
-
-        d_count = 0;
-        d_total = 0;
-        d_min   = k_DEFAULT_MIN;
-        d_max   = k_DEFAULT_MAX;
+        if (d_shards_p) {
+            combineShards(&count, &total, &min, &max, true);
+        }
+        else {
+            count = d_count;
+            total = d_total;
+            min   = d_min;
+            max   = d_max;
+
+            d_count = 0;
+            d_total = 0;
+            d_min   = k_DEFAULT_MIN;
+            d_max   = k_DEFAULT_MAX;
+        }
     }
     // Perform the conversion to double values outside of the lock.
     records->metricId() = d_metricId;
@@ -72,10 +195,15 @@ void IntegerCollector::load(MetricRecord *record) const
 
     {
         bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
-        count = d_count;
-        total = d_total;
-        min   = d_min;
-        max   = d_max;
+        if (d_shards_p) {
+            combineShards(&count, &total, &min, &max, false);
+        }
+        else {
+            count = d_count;
+            total = d_total;
+            min   = d_min;
+            max   = d_max;
+        }
     }
 
     // Perform the conversion to double values outside of the lock.
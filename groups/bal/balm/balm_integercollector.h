@@ -44,6 +44,19 @@ BSLS_IDENT("$Id: $")
 // non-creator operations on a given instance can be safely invoked
 // simultaneously from multiple threads.
 //
+///Sharded Mode
+///------------
+// A 'balm::IntegerCollector' created with a number of shards (see the
+// two-argument constructor) holds that many independent accumulators, each
+// occupying its own cache line, and 'update' and 'accumulateCountTotalMinMax'
+// modify the accumulator selected by the thread index of the caller (see
+// 'balm_collectorshardutil') using atomic operations rather than a mutex.  The
+// accumulators are combined only by 'load' and 'loadAndReset'.  As with a
+// sharded 'balm::Collector', an update concurrent with 'load',
+// 'loadAndReset', 'reset', or 'setCountTotalMinMax' may be partially
+// reflected, although no update is ever lost or counted twice by successive
+// calls to 'loadAndReset'.
+//
 ///Usage
 ///-----
 // The following example creates a 'balm::IntegerCollector', modifies its
@@ -83,17 +96,54 @@ BSLS_IDENT("$Id: $")
 
 #include <balscm_version.h>
 
+#include <balm_collectorshardutil.h>
 #include <balm_metricid.h>
 #include <balm_metricrecord.h>
 
+#include <bslma_allocator.h>
+
 #include <bslmt_mutex.h>
 #include <bslmt_lockguard.h>
 
+#include <bsls_atomic.h>
 #include <bsls_types.h>
 
 namespace BloombergLP {
 namespace balm {
 
+                       // =============================
+                       // struct IntegerCollector_Shard
+                       // =============================
+
+struct IntegerCollector_Shard {
+    // This 'struct' holds the accumulated count, total, minimum, and maximum
+    // of one shard of a sharded 'IntegerCollector'.  This 'struct' is an
+    // implementation detail of 'IntegerCollector', and must not be used
+    // directly by clients.
+
+    // DATA
+    bsls::AtomicInt   d_count;  // aggregated count of events
+    bsls::AtomicInt64 d_total;  // total of values across events
+    bsls::AtomicInt   d_min;    // minimum value across events
+    bsls::AtomicInt   d_max;    // maximum value across events
+
+    // CREATORS
+    IntegerCollector_Shard();
+        // Create a shard having a count of 0, total of 0, min of
+        // 'IntegerCollector::k_DEFAULT_MIN', and max of
+        // 'IntegerCollector::k_DEFAULT_MAX'.
+
+    // MANIPULATORS
+    void accumulate(int count, int total, int min, int max);
+        // Atomically add the specified 'count' and 'total' to the count and
+        // total of this shard, and lower (raise) the minimum (maximum) of this
+        // shard to the specified 'min' ('max') if it is less (greater).
+
+    void reset();
+        // Set the count, total, minimum, and maximum of this shard to their
+        // default values.
+};
+
                            // ======================
                            // class IntegerCollector
                            // ======================
@@ -109,17 +159,55 @@ class IntegerCollector {
     // for the maximum is 'k_DEFAULT_MAX'.
 
     // DATA
-    MetricId             d_metricId;  // metric identifier
-    int                  d_count;     // aggregated count of events
-    bsls::Types::Int64   d_total;     // total of values across events
-    int                  d_min;       // minimum value across events
-    int                  d_max;       // maximum value across events
-    mutable bslmt::Mutex d_mutex;     // synchronizes access to data
+    MetricId             d_metricId;     // metric identifier
+    int                  d_count;        // aggregated count of events
+    bsls::Types::Int64   d_total;        // total of values across events
+    int                  d_min;          // minimum value across events
+    int                  d_max;          // maximum value across events
+    mutable bslmt::Mutex d_mutex;        // synchronizes access to data
+                                         // (serializes loads and resets in
+                                         // sharded mode)
+
+    void                *d_buffer_p;     // memory holding the shards, or 0
+                                         // if this collector is not sharded
+
+    char                *d_shards_p;     // cache-line aligned address of the
+                                         // first shard, or 0
+
+    int                  d_shardMask;    // number of shards minus one
+
+    bslma::Allocator    *d_allocator_p;  // memory allocator (held, not
+                                         // owned), or 0
 
     // NOT IMPLEMENTED
     IntegerCollector(const IntegerCollector&);
     IntegerCollector& operator=(const IntegerCollector&);
 
+    // PRIVATE MANIPULATORS
+    IntegerCollector_Shard& shard(int index);
+        // Return a reference to the shard having the specified 'index'.  The
+        // behavior is undefined unless this collector is sharded and
+        // '0 <= index < numShards()'.
+
+    IntegerCollector_Shard& threadShard();
+        // Return a reference to the shard to be updated by the calling
+        // thread.  The behavior is undefined unless this collector is
+        // sharded.
+
+    // PRIVATE ACCESSORS
+    void combineShards(int                *count,
+                       bsls::Types::Int64 *total,
+                       int                *min,
+                       int                *max,
+                       bool                resetFlag) const;
+        // Load into the specified 'count', 'total', 'min', and 'max' the
+        // combined aggregates of the shards of this collector and, if the
+        // specified 'resetFlag' is 'true', reset each shard to its default
+        // state.  The behavior is undefined unless this collector is sharded
+        // and 'd_mutex' is locked by the calling thread.  Note that this
+        // method is 'const' but modifies the (atomic) shards if 'resetFlag'
+        // is 'true'.
+
   public:
     // PUBLIC CONSTANTS
     static const int k_DEFAULT_MIN;  // default minimum value (INT_MAX)
@@ -135,6 +223,21 @@ class IntegerCollector {
         // 'metricId', and having an initial count of 0, total of 0, min of
         // 'k_DEFAULT_MIN', and max of 'k_DEFAULT_MAX'.
 
+    IntegerCollector(const MetricId&   metricId,
+                     int               numShards,
+                     bslma::Allocator *basicAllocator = 0);
+        // Create a sharded integer collector (see {Sharded Mode}) for a metric
+        // having the specified 'metricId', using the specified 'numShards'
+        // rounded up to a power of two (see
+        // 'CollectorShardUtil::roundUpNumShards') as the number of
+        // independently updated accumulators, and having an initial count of
+        // 0, total of 0, min of 'k_DEFAULT_MIN', and max of 'k_DEFAULT_MAX'.
+        // If 'numShards' is 0, the number of shards is
+        // 'CollectorShardUtil::defaultNumShards()'.  Optionally specify a
+        // 'basicAllocator' used to supply memory.  If 'basicAllocator' is 0,
+        // the currently installed default allocator is used.  The behavior is
+        // undefined unless '0 <= numShards'.
+
     ~IntegerCollector();
         // Destroy this object.
 
@@ -195,16 +298,65 @@ class IntegerCollector {
         // minimum value of 'MetricRecord::k_DEFAULT_MIN' and a maximum value
         // of 'k_DEFAULT_MAX' will populate a maximum value of
         // 'MetricRecord::k_DEFAULT_MAX'.
+
+    int numShards() const;
+        // Return the number of shards of this collector, or 0 if this
+        // collector is not sharded.
 };
 
 // ============================================================================
 //                            INLINE DEFINITIONS
 // ============================================================================
 
+                       // -----------------------------
+                       // struct IntegerCollector_Shard
+                       // -----------------------------
+
+// MANIPULATORS
+inline
+void IntegerCollector_Shard::accumulate(int count, int total, int min, int max)
+{
+    d_count.addRelaxed(count);
+    d_total.addRelaxed(total);
+
+    int expected = d_min.loadRelaxed();
+    while (min < expected) {
+        const int previous = d_min.testAndSwapAcqRel(expected, min);
+        if (previous == expected) {
+            break;
+        }
+        expected = previous;
+    }
+
+    expected = d_max.loadRelaxed();
+    while (max > expected) {
+        const int previous = d_max.testAndSwapAcqRel(expected, max);
+        if (previous == expected) {
+            break;
+        }
+        expected = previous;
+    }
+}
+
                            // ----------------------
                            // class IntegerCollector
                            // ----------------------
 
+// PRIVATE MANIPULATORS
+inline
+IntegerCollector_Shard& IntegerCollector::shard(int index)
+{
+    return *reinterpret_cast<IntegerCollector_Shard *>(
+                   d_shards_p + index * CollectorShardUtil::k_CACHE_LINE_SIZE);
+}
+
+inline
+IntegerCollector_Shard& IntegerCollector::threadShard()
+{
+    return shard(static_cast<int>(CollectorShardUtil::threadIndex())
+                                                                & d_shardMask);
+}
+
 // CREATORS
 inline
 IntegerCollector::IntegerCollector(const MetricId& metricId)
@@ -214,11 +366,10 @@ IntegerCollector::IntegerCollector(const MetricId& metricId)
 , d_min(k_DEFAULT_MIN)
 , d_max(k_DEFAULT_MAX)
 , d_mutex()
-{
-}
-
-inline
-IntegerCollector::~IntegerCollector()
+, d_buffer_p(0)
+, d_shards_p(0)
+, d_shardMask(0)
+, d_allocator_p(0)
 {
 }
 
@@ -227,6 +378,12 @@ inline
 void IntegerCollector::reset()
 {
     bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+    if (d_shards_p) {
+        for (int i = 0; i <= d_shardMask; ++i) {
+            shard(i).reset();
+        }
+        return;                                                       // RETURN
+    }
     d_count = 0;
     d_total = 0;
     d_min   = k_DEFAULT_MIN;
@@ -236,6 +393,10 @@ void IntegerCollector::reset()
 inline
 void IntegerCollector::update(int value)
 {
+    if (d_shards_p) {
+        threadShard().accumulate(1, value, value, value);
+        return;                                                       // RETURN
+    }
     bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
     ++d_count;
     d_total += value;
@@ -249,6 +410,10 @@ void IntegerCollector::accumulateCountTotalMinMax(int count,
                                                   int min,
                                                   int max)
 {
+    if (d_shards_p) {
+        threadShard().accumulate(count, total, min, max);
+        return;                                                       // RETURN
+    }
     bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
     d_count += count;
     d_total += total;
@@ -263,6 +428,17 @@ void IntegerCollector::setCountTotalMinMax(int count,
                                            int max)
 {
     bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+    if (d_shards_p) {
+        for (int i = 1; i <= d_shardMask; ++i) {
+            shard(i).reset();
+        }
+        IntegerCollector_Shard& first = shard(0);
+        first.d_count.storeRelaxed(count);
+        first.d_total.storeRelaxed(total);
+        first.d_min.storeRelaxed(min);
+        first.d_max.storeRelaxed(max);
+        return;                                                       // RETURN
+    }
     d_count = count;
     d_total = total;
     d_min   = min;
@@ -276,6 +452,12 @@ const MetricId& IntegerCollector::metricId() const
     return d_metricId;
 }
 
+inline
+int IntegerCollector::numShards() const
+{
+    return d_shards_p ? d_shardMask + 1 : 0;
+}
+
 }  // close package namespace
 }  // close enterprise namespace
 
@@ -11,18 +11,24 @@
 
 #include <bslma_testallocator.h>
 #include <bslmt_barrier.h>
+#include <bslmt_threadutil.h>
+#include <bslmt_throughputbenchmark.h>
+#include <bslmt_throughputbenchmarkresult.h>
 #include <bdlmt_fixedthreadpool.h>
 #include <bdlf_bind.h>
 
 #include <bslma_defaultallocatorguard.h>
 #include <bslma_testallocator.h>
 
+#include <bsls_atomic.h>
 #include <bsls_types.h>
 
+#include <bsl_algorithm.h>
 #include <bsl_functional.h>
 #include <bsl_ostream.h>
 #include <bsl_cstring.h>
 #include <bsl_cstdlib.h>
+#include <bsl_iomanip.h>
 #include <bsl_iostream.h>
 #include <bsl_sstream.h>
 
@@ -45,6 +51,7 @@ using bsl::flush;
 // ----------------------------------------------------------------------------
 // CREATORS
 // [ 3]  balm::Collector(const balm::MetricId& metric);
+// [ 9]  balm::IntegerCollector(const MetricId&, int, bslma::Allocator *);
 // [ 3]  ~balm::Collector();
 //
 // MANIPULATORS
@@ -60,10 +67,12 @@ using bsl::flush;
 // ACCESSORS
 // [ 2]  const balm::MetricId& metric() const;
 // [ 2]  void load(balm::MetricRecord *record) const;
+// [ 9]  int numShards() const;
 // ----------------------------------------------------------------------------
 // [ 1] BREATHING TEST
 // [ 8] CONCURRENCY TEST
-// [ 9] USAGE EXAMPLE
+// [10] USAGE EXAMPLE
+// [-1] BENCHMARK: 'update' THROUGHPUT
 
 // ============================================================================
 //                      STANDARD BDE ASSERT TEST MACRO
@@ -216,6 +225,51 @@ void ConcurrencyTest::runTest()
     d_pool.drain();
 }
 
+void updateCollector(Obj             *collector,
+                     int              numUpdates,
+                     bsls::AtomicInt *numFinished,
+                     bslmt::Barrier  *barrier)
+    // Wait on the specified 'barrier', then update the specified 'collector'
+    // with each of the values in the range '[1 .. numUpdates]' for the
+    // specified 'numUpdates', and finally increment the specified
+    // 'numFinished'.
+{
+    barrier->wait();
+    for (int i = 1; i <= numUpdates; ++i) {
+        collector->update(i);
+    }
+    ++*numFinished;
+}
+
+void loadAndResetCollector(Obj              *collector,
+                           Rec              *sum,
+                           bsls::AtomicBool *done,
+                           bslmt::Barrier   *barrier)
+    // Wait on the specified 'barrier', then repeatedly load and reset the
+    // specified 'collector', combining each loaded record into the specified
+    // 'sum', until the specified 'done' flag is 'true'.
+{
+    barrier->wait();
+    while (!*done) {
+        Rec record;
+        collector->loadAndReset(&record);
+        sum->count() += record.count();
+        sum->total() += record.total();
+        sum->min()    = bsl::min(sum->min(), record.min());
+        sum->max()    = bsl::max(sum->max(), record.max());
+    }
+}
+
+void benchmarkUpdate(Obj *collector, int)
+    // Update the specified 'collector' 100 times.  Note that this function
+    // is a 'bslmt::ThroughputBenchmark::RunFunction'; its second argument (the
+    // index of the calling thread) is ignored.
+{
+    for (int i = 0; i < 100; ++i) {
+        collector->update(i);
+    }
+}
+
 // ============================================================================
 //                               USAGE EXAMPLE
 // ----------------------------------------------------------------------------
@@ -248,7 +302,7 @@ int main(int argc, char *argv[])
     Id metric_E(DESC_E); const Id& METRIC_E = metric_E;
 
     switch (test) { case 0:  // Zero is always the leading case.
-      case 9: {
+      case 10: {
         // --------------------------------------------------------------------
         // TESTING USAGE EXAMPLE
         //
@@ -303,6 +357,201 @@ int main(int argc, char *argv[])
 //..
 
       } break;
+      case 9: {
+        // --------------------------------------------------------------------
+        // TESTING SHARDED MODE
+        //
+        // Concerns:
+        //: 1 The requested number of shards is rounded up to a power of two,
+        //:   and 0 selects the default number of shards.
+        //:
+        //: 2 A sharded collector supplies the same values as a non-sharded
+        //:   collector for the same sequence of operations.
+        //:
+        //: 3 Memory is supplied by the specified allocator, and released when
+        //:   the collector is destroyed.
+        //:
+        //: 4 No update made concurrently with 'loadAndReset' is lost or
+        //:   counted twice.
+        //
+        // Plan:
+        //: 1 Create sharded collectors for a table of requested numbers of
+        //:   shards, and verify 'numShards'.  (C-1)
+        //:
+        //: 2 Apply the same sequence of manipulators to a sharded and a
+        //:   non-sharded collector, and verify that 'load' supplies the same
+        //:   record after each operation.  (C-2)
+        //:
+        //: 3 Use a test allocator to verify memory use.  (C-3)
+        //:
+        //: 4 Update a sharded collector from several threads while another
+        //:   thread repeatedly calls 'loadAndReset', and verify that the
+        //:   combined records equal the expected aggregates.  (C-4)
+        //
+        // Testing:
+        //   balm::IntegerCollector(const MetricId&, int, bslma::Allocator *);
+        //   int numShards() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl << "TESTING SHARDED MODE" << endl
+                                  << "====================" << endl;
+
+        bslma::TestAllocator defaultAllocator;
+        bslma::DefaultAllocatorGuard guard(&defaultAllocator);
+
+        bslma::TestAllocator testAllocator;
+
+        if (verbose) cout << "\tTesting 'numShards'." << endl;
+        {
+            static const struct {
+                int d_line;       // source line
+                int d_requested;  // requested number of shards
+                int d_expected;   // expected number of shards
+            } DATA[] = {
+                { L_,   1,   1 },
+                { L_,   2,   2 },
+                { L_,   3,   4 },
+                { L_,   5,   8 },
+                { L_,  64,  64 },
+                { L_, 100, 128 },
+                { L_, 256, 256 },
+                { L_, 257, 256 },
+            };
+            const int NUM_DATA = sizeof DATA / sizeof *DATA;
+
+            for (int i = 0; i < NUM_DATA; ++i) {
+                const int LINE = DATA[i].d_line;
+
+                Obj mX(METRIC_A, DATA[i].d_requested, &testAllocator);
+                const Obj& MX = mX;
+
+                LOOP_ASSERT(LINE, DATA[i].d_expected == MX.numShards());
+                LOOP_ASSERT(LINE, METRIC_A == MX.metricId());
+                LOOP_ASSERT(LINE, 0 < testAllocator.numBytesInUse());
+            }
+            ASSERT(0 == testAllocator.numBytesInUse());
+
+            Obj mX(METRIC_A, 0, &testAllocator); const Obj& MX = mX;
+            ASSERT(balm::CollectorShardUtil::defaultNumShards() ==
+                                                              MX.numShards());
+
+            Obj mY(METRIC_A); const Obj& MY = mY;
+            ASSERT(0 == MY.numShards());
+
+            Obj mZ(METRIC_A, 4); const Obj& MZ = mZ;
+            ASSERT(4 == MZ.numShards());
+            ASSERT(0 <  defaultAllocator.numBytesInUse());
+        }
+        ASSERT(0 == testAllocator.numBytesInUse());
+        ASSERT(0 == defaultAllocator.numBytesInUse());
+
+        if (verbose) cout << "\tTesting manipulators and accessors." << endl;
+        {
+            Obj mX(METRIC_A, 4, &testAllocator); const Obj& MX = mX;
+            Obj mY(METRIC_A);                    const Obj& MY = mY;
+
+            Rec r1, r2;
+
+            MX.load(&r1); MY.load(&r2); ASSERT(r1 == r2);
+
+            mX.update(2);   mY.update(2);
+            mX.update(-3);  mY.update(-3);
+            MX.load(&r1); MY.load(&r2); ASSERT(r1 == r2);
+            ASSERT(2  == r1.count());
+            ASSERT(-1 == r1.total());
+            ASSERT(-3 == r1.min());
+            ASSERT(2  == r1.max());
+
+            mX.accumulateCountTotalMinMax(3, 10, -5, 8);
+            mY.accumulateCountTotalMinMax(3, 10, -5, 8);
+            MX.load(&r1); MY.load(&r2); ASSERT(r1 == r2);
+
+            mX.loadAndReset(&r1); mY.loadAndReset(&r2); ASSERT(r1 == r2);
+            ASSERT(5  == r1.count());
+            ASSERT(9  == r1.total());
+            ASSERT(-5 == r1.min());
+            ASSERT(8  == r1.max());
+
+            MX.load(&r1); MY.load(&r2); ASSERT(r1 == r2);
+            ASSERT(0                  == r1.count());
+            ASSERT(0                  == r1.total());
+            ASSERT(Rec::k_DEFAULT_MIN == r1.min());
+            ASSERT(Rec::k_DEFAULT_MAX == r1.max());
+
+            mX.update(7); mY.update(7);
+            mX.setCountTotalMinMax(2, 3, 1, 2);
+            mY.setCountTotalMinMax(2, 3, 1, 2);
+            MX.load(&r1); MY.load(&r2); ASSERT(r1 == r2);
+            ASSERT(2 == r1.count());
+            ASSERT(3 == r1.total());
+            ASSERT(1 == r1.min());
+            ASSERT(2 == r1.max());
+
+            mX.update(INT_MAX); mY.update(INT_MAX);
+            mX.update(INT_MIN); mY.update(INT_MIN);
+            MX.load(&r1); MY.load(&r2); ASSERT(r1 == r2);
+
+            mX.reset(); mY.reset();
+            MX.load(&r1); MY.load(&r2); ASSERT(r1 == r2);
+            ASSERT(0                  == r1.count());
+            ASSERT(0                  == r1.total());
+            ASSERT(Rec::k_DEFAULT_MIN == r1.min());
+            ASSERT(Rec::k_DEFAULT_MAX == r1.max());
+        }
+        ASSERT(0 == testAllocator.numBytesInUse());
+
+        if (verbose) cout << "\tTesting concurrent updates." << endl;
+        {
+            const int NUM_THREADS = 8;
+            const int NUM_UPDATES = 10000;
+
+            Obj mX(METRIC_A, 4, &testAllocator);
+
+            Rec              sum;
+            bsls::AtomicBool done(false);
+            bsls::AtomicInt  numFinished(0);
+            bslmt::Barrier   barrier(NUM_THREADS + 1);
+
+            bdlmt::FixedThreadPool pool(NUM_THREADS + 1, 100, &testAllocator);
+            pool.start();
+            for (int i = 0; i < NUM_THREADS; ++i) {
+                pool.enqueueJob(bdlf::BindUtil::bind(&updateCollector,
+                                                     &mX,
+                                                     NUM_UPDATES,
+                                                     &numFinished,
+                                                     &barrier));
+            }
+            pool.enqueueJob(bdlf::BindUtil::bind(&loadAndResetCollector,
+                                                 &mX,
+                                                 &sum,
+                                                 &done,
+                                                 &barrier));
+
+            // Wait for the updating threads, then stop the reader.
+
+            while (NUM_THREADS > numFinished) {
+                bslmt::ThreadUtil::yield();
+            }
+            done = true;
+            pool.drain();
+
+            Rec record;
+            mX.loadAndReset(&record);
+            sum.count() += record.count();
+            sum.total() += record.total();
+            sum.min()    = bsl::min(sum.min(), record.min());
+            sum.max()    = bsl::max(sum.max(), record.max());
+
+            const double EXP_TOTAL = NUM_THREADS * 0.5 * NUM_UPDATES
+                                                         * (NUM_UPDATES + 1);
+
+            ASSERTV(sum.count(), NUM_THREADS * NUM_UPDATES == sum.count());
+            ASSERTV(sum.total(), EXP_TOTAL                 == sum.total());
+            ASSERTV(sum.min(),   1                         == sum.min());
+            ASSERTV(sum.max(),   NUM_UPDATES               == sum.max());
+        }
+        ASSERT(0 == testAllocator.numBytesInUse());
+      } break;
       case 8: {
         // --------------------------------------------------------------------
         // CONCURRENCY TEST
@@ -739,6 +988,64 @@ int main(int argc, char *argv[])
         ASSERT(Rec::k_DEFAULT_MIN == r1.min());
         ASSERT(Rec::k_DEFAULT_MAX == r1.max());
       } break;
+      case -1: {
+        // --------------------------------------------------------------------
+        // BENCHMARK: 'update' THROUGHPUT
+        //
+        // Concerns:
+        //: 1 The throughput of 'update' on a sharded collector scales with the
+        //:   number of updating threads, whereas a non-sharded collector is
+        //:   limited by contention on its mutex.
+        //
+        // Plan:
+        //: 1 Using 'bslmt::ThroughputBenchmark', measure the median number of
+        //:   calls to 'update' per second for a non-sharded collector and a
+        //:   collector having the default number of shards, for 1, 2, 4, 8,
+        //:   16, and 32 updating threads.  The maximum number of threads and
+        //:   the duration of each sample (in milliseconds) may be supplied as
+        //:   the second and third command-line arguments.
+        //
+        // Testing:
+        //   BENCHMARK: 'update' THROUGHPUT
+        // --------------------------------------------------------------------
+
+        cout << endl << "BENCHMARK: 'update' THROUGHPUT" << endl
+                     << "==============================" << endl;
+
+        const int MAX_THREADS = argc > 2 ? bsl::atoi(argv[2]) : 32;
+        const int NUM_MILLIS  = argc > 3 ? bsl::atoi(argv[3]) : 500;
+        const int NUM_SAMPLES = 5;
+
+        cout << "threads, mutex (updates/s), sharded (updates/s)" << endl;
+
+        for (int numThreads = 1; numThreads <= MAX_THREADS; numThreads *= 2) {
+            double median[2];
+
+            for (int sharded = 0; sharded < 2; ++sharded) {
+                Obj mX(METRIC_A);
+                Obj mY(METRIC_A, 0);
+
+                bslmt::ThroughputBenchmark       bench;
+                bslmt::ThroughputBenchmarkResult result;
+
+                bench.addThreadGroup(
+                               bdlf::BindUtil::bind(&benchmarkUpdate,
+                                                    sharded ? &mY : &mX,
+                                                    bdlf::PlaceHolders::_1),
+                               numThreads,
+                               0);
+                bench.execute(&result, NUM_MILLIS, NUM_SAMPLES);
+                result.getMedian(&median[sharded], 0);
+            }
+
+            // Each invocation of 'benchmarkUpdate' makes 100 updates.
+
+            cout << numThreads << ", "
+                 << bsl::fixed << bsl::setprecision(0)
+                 << median[0] * 100 << ", "
+                 << median[1] * 100 << endl;
+        }
+      } break;
       default: {
         bsl::cerr << "WARNING: CASE `" << test << "' NOT FOUND." << bsl::endl;
         testStatus = -1;
@@ -0,0 +1,497 @@
+// balst_stacktracesamplingallocator.cpp                              -*-C++-*-
+#include <balst_stacktracesamplingallocator.h>
+
+#include <bsls_ident.h>
+BSLS_IDENT_RCSID(balst_stacktracesamplingallocator_cpp,"$Id$ $CSID$")
+
+#include <balst_stacktrace.h>
+#include <balst_stacktraceutil.h>
+
+#include <bdlb_random.h>
+
+#include <bslma_deallocatorproctor.h>
+#include <bslma_default.h>
+#include <bslma_rawdeleterproctor.h>
+
+#include <bslmt_lockguard.h>
+
+#include <bslmf_assert.h>
+
+#include <bsls_assert.h>
+#include <bsls_performancehint.h>
+#include <bsls_stackaddressutil.h>
+
+#include <bsl_algorithm.h>
+#include <bsl_cmath.h>
+#include <bsl_ostream.h>
+#include <bsl_utility.h>
+
+namespace BloombergLP {
+namespace {
+
+typedef bsls::StackAddressUtil AddressUtil;
+
+enum {
+    k_IGNORE_FRAMES = AddressUtil::k_IGNORE_FRAMES,
+        // On some platforms, gathering the stack pointers wastes one frame
+        // gathering the address of 'AddressUtil::getStackAddresses', which is
+        // reflected in whether 'AddressUtil::k_IGNORE_FRAMES' is 0 or 1.
+
+    k_MAX_ALIGNMENT = bsls::AlignmentUtil::BSLS_MAX_ALIGNMENT
+};
+
+bool isMoreSignificant(const balst::StackTraceSamplingAllocator::CallSite& lhs,
+                       const balst::StackTraceSamplingAllocator::CallSite& rhs)
+    // Return 'true' if the specified 'lhs' call site has more bytes in use
+    // than the specified 'rhs' call site, or if they have the same number of
+    // bytes in use and 'lhs' has a higher peak, and 'false' otherwise.
+{
+    if (lhs.d_liveBytes != rhs.d_liveBytes) {
+        return lhs.d_liveBytes > rhs.d_liveBytes;                     // RETURN
+    }
+    return lhs.d_peakLiveBytes > rhs.d_peakLiveBytes;
+}
+
+bsls::Types::Int64 roundToInt64(double value)
+    // Return the specified non-negative 'value' rounded to the nearest
+    // integer, or 0 if 'value' is negative (which can only be the result of
+    // rounding errors accumulated by the caller).
+{
+    return value <= 0 ? 0 : static_cast<bsls::Types::Int64>(value + 0.5);
+}
+
+}  // close unnamed namespace
+
+namespace balst {
+
+               // ==============================================
+               // struct StackTraceSamplingAllocator::Site
+               // ==============================================
+
+struct StackTraceSamplingAllocator::Site {
+    // This 'struct' accumulates the weighted statistics of the samples taken
+    // at one call site.  Byte counts are accumulated as (rounded) integers so
+    // that they return exactly to 0 when all sampled blocks are deallocated;
+    // block counts are fractional weights and are rounded on export.
+
+    // DATA
+    bsls::Types::Int64 d_liveBytes;      // weighted bytes in use
+    bsls::Types::Int64 d_peakLiveBytes;  // maximum of 'd_liveBytes'
+    bsls::Types::Int64 d_totalBytes;     // weighted bytes ever allocated
+    double             d_liveBlocks;     // weighted blocks in use
+    double             d_totalBlocks;    // weighted blocks ever allocated
+    bsls::Types::Int64 d_numSamples;     // samples ever taken
+};
+
+               // ==============================================
+               // union StackTraceSamplingAllocator::Sample
+               // ==============================================
+
+union StackTraceSamplingAllocator::Sample {
+    // This 'union' is stored at the start of each sampled block, immediately
+    // before the 'Header' of the block, and records the weight with which the
+    // block contributes to the statistics of its call site.
+
+    struct Data {
+        Site               *d_site_p;   // call site of the allocation
+        bsls::Types::Int64  d_bytes;    // weighted size of the block
+        double              d_blocks;   // weight of the block
+    };
+
+    Data                                d_data;
+    bsls::AlignmentUtil::MaxAlignedType d_alignment;  // force alignment
+};
+
+                     // ---------------------------------
+                     // class StackTraceSamplingAllocator
+                     // ---------------------------------
+
+// PRIVATE MANIPULATORS
+bsls::Types::Int64 StackTraceSamplingAllocator::nextSamplingInterval()
+{
+    // Combine two 15-bit random values into a value uniformly distributed
+    // over '(0, 1]', and map it to an exponential distribution by inverting
+    // the cumulative distribution function.
+
+    const int high = bdlb::Random::generate15(&d_seed);
+    const int low  = bdlb::Random::generate15(&d_seed);
+
+    const double uniform = (static_cast<double>((high << 15) | low) + 1.0)
+                                                         / (1 << 30);
+    const double interval = -bsl::log(uniform)
+                                 * static_cast<double>(d_meanSamplingInterval);
+
+    return interval < 1.0 ? 1 : static_cast<bsls::Types::Int64>(interval);
+}
+
+void *StackTraceSamplingAllocator::allocateSample(size_type size)
+{
+    // Re-arm the countdown before anything that can throw, so that a failed
+    // allocation cannot leave sampling disabled.  Adding (rather than
+    // storing) the next interval preserves the bytes other threads have
+    // counted down in the meantime, and skipping whole intervals that are
+    // already exhausted is how a Poisson process treats several sampling
+    // points falling within a single allocation.
+
+    {
+        bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+
+        while (d_bytesUntilSample.addRelaxed(nextSamplingInterval()) <= 0) {
+        }
+    }
+
+    const size_type blockSize =
+                          sizeof(Sample)
+                        + sizeof(Header)
+                        + bsls::AlignmentUtil::roundUpToMaximalAlignment(size);
+
+    Sample *sample = static_cast<Sample *>(d_allocator_p->allocate(blockSize));
+
+    bslma::DeallocatorProctor<bslma::Allocator> blockProctor(sample,
+                                                             d_allocator_p);
+
+    StackAddresses addresses(d_maxRecordedFrames, 0, d_allocator_p);
+
+    int numAddresses = AddressUtil::getStackAddresses(
+                                         const_cast<void **>(addresses.data()),
+                                         d_maxRecordedFrames);
+    if (numAddresses < k_IGNORE_FRAMES) {
+        numAddresses = k_IGNORE_FRAMES;
+    }
+    addresses.resize(numAddresses);
+    addresses.erase(addresses.begin(), addresses.begin() + k_IGNORE_FRAMES);
+
+    // Weight the sample by the inverse of the probability that an allocation
+    // of 'size' bytes is sampled.
+
+    const double interval    = static_cast<double>(d_meanSamplingInterval);
+    const double probability = 1.0 - bsl::exp(-static_cast<double>(size)
+                                                                  / interval);
+
+    const double             blocks = 1.0 / probability;
+    const bsls::Types::Int64 bytes  = roundToInt64(static_cast<double>(size)
+                                                                    * blocks);
+
+    bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+
+    SiteMap::iterator it = d_sites.find(addresses);
+    if (d_sites.end() == it) {
+        Site *site = new (*d_allocator_p) Site();
+
+        bslma::RawDeleterProctor<Site, bslma::Allocator> siteProctor(
+                                                                site,
+                                                                d_allocator_p);
+
+        it = d_sites.insert(SiteMap::value_type(addresses,
+                                                site,
+                                                d_allocator_p)).first;
+
+        siteProctor.release();
+    }
+
+    Site *site = it->second;
+
+    site->d_liveBytes   += bytes;
+    site->d_totalBytes  += bytes;
+    site->d_liveBlocks  += blocks;
+    site->d_totalBlocks += blocks;
+    ++site->d_numSamples;
+    if (site->d_liveBytes > site->d_peakLiveBytes) {
+        site->d_peakLiveBytes = site->d_liveBytes;
+    }
+
+    d_bytesInUse += bytes;
+    if (d_bytesInUse > d_peakBytesInUse) {
+        d_peakBytesInUse = d_bytesInUse;
+    }
+    ++d_numSamples;
+    ++d_numSamplesInUse;
+
+    sample->d_data.d_site_p = site;
+    sample->d_data.d_bytes  = bytes;
+    sample->d_data.d_blocks = blocks;
+
+    Header *header = reinterpret_cast<Header *>(sample + 1);
+    header->d_sample_p = sample;
+
+    blockProctor.release();
+
+    return header + 1;
+}
+
+void StackTraceSamplingAllocator::deallocateSample(Header *header)
+{
+    Sample *sample = header->d_sample_p;
+
+    BSLS_ASSERT(reinterpret_cast<Header *>(sample + 1) == header);
+
+    {
+        bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+
+        Site *site = sample->d_data.d_site_p;
+
+        site->d_liveBytes  -= sample->d_data.d_bytes;
+        site->d_liveBlocks -= sample->d_data.d_blocks;
+
+        d_bytesInUse -= sample->d_data.d_bytes;
+        --d_numSamplesInUse;
+
+        BSLS_ASSERT(0 <= site->d_liveBytes);
+        BSLS_ASSERT(0 <= d_numSamplesInUse);
+    }
+
+    d_allocator_p->deallocate(sample);
+}
+
+// CREATORS
+StackTraceSamplingAllocator::StackTraceSamplingAllocator(
+                                              bslma::Allocator *basicAllocator)
+: d_meanSamplingInterval(k_DEFAULT_MEAN_SAMPLING_INTERVAL)
+, d_maxRecordedFrames(k_DEFAULT_NUM_RECORDED_FRAMES + k_IGNORE_FRAMES)
+, d_bytesUntilSample(0)
+, d_seed(0)
+, d_sites(basicAllocator)
+, d_bytesInUse(0)
+, d_peakBytesInUse(0)
+, d_numSamples(0)
+, d_numSamplesInUse(0)
+, d_mutex()
+, d_allocator_p(bslma::Default::allocator(basicAllocator))
+{
+    BSLMF_ASSERT(0 == sizeof(Header) % k_MAX_ALIGNMENT);
+    BSLMF_ASSERT(0 == sizeof(Sample) % k_MAX_ALIGNMENT);
+
+    d_bytesUntilSample = nextSamplingInterval();
+}
+
+StackTraceSamplingAllocator::StackTraceSamplingAllocator(
+                                      bsls::Types::Int64  meanSamplingInterval,
+                                      bslma::Allocator   *basicAllocator)
+: d_meanSamplingInterval(meanSamplingInterval)
+, d_maxRecordedFrames(k_DEFAULT_NUM_RECORDED_FRAMES + k_IGNORE_FRAMES)
+, d_bytesUntilSample(0)
+, d_seed(0)
+, d_sites(basicAllocator)
+, d_bytesInUse(0)
+, d_peakBytesInUse(0)
+, d_numSamples(0)
+, d_numSamplesInUse(0)
+, d_mutex()
+, d_allocator_p(bslma::Default::allocator(basicAllocator))
+{
+    BSLS_ASSERT(0 < meanSamplingInterval);
+
+    d_bytesUntilSample = nextSamplingInterval();
+}
+
+StackTraceSamplingAllocator::StackTraceSamplingAllocator(
+                                      bsls::Types::Int64  meanSamplingInterval,
+                                      int                 numRecordedFrames,
+                                      bslma::Allocator   *basicAllocator)
+: d_meanSamplingInterval(meanSamplingInterval)
+, d_maxRecordedFrames(numRecordedFrames + k_IGNORE_FRAMES)
+, d_bytesUntilSample(0)
+, d_seed(0)
+, d_sites(basicAllocator)
+, d_bytesInUse(0)
+, d_peakBytesInUse(0)
+, d_numSamples(0)
+, d_numSamplesInUse(0)
+, d_mutex()
+, d_allocator_p(bslma::Default::allocator(basicAllocator))
+{
+    BSLS_ASSERT(0 < meanSamplingInterval);
+    BSLS_ASSERT(0 < numRecordedFrames);
+
+    d_bytesUntilSample = nextSamplingInterval();
+}
+
+StackTraceSamplingAllocator::~StackTraceSamplingAllocator()
+{
+    BSLS_ASSERT(0 == d_numSamplesInUse);
+
+    for (SiteMap::iterator it = d_sites.begin(); d_sites.end() != it; ++it) {
+        d_allocator_p->deleteObjectRaw(it->second);
+    }
+}
+
+// MANIPULATORS
+void *StackTraceSamplingAllocator::allocate(size_type size)
+{
+    if (0 == size) {
+        return 0;                                                     // RETURN
+    }
+
+    // Only the allocation that takes the countdown from positive to
+    // non-positive is sampled.  Allocations by other threads that find the
+    // countdown already exhausted, before 'allocateSample' has re-armed it,
+    // are not sampled; their bytes remain counted down, and are deducted from
+    // the next interval.
+
+    typedef bsls::Types::Int64 Int64;
+
+    const Int64 signedSize = static_cast<Int64>(size);
+    const Int64 remaining  = d_bytesUntilSample.addRelaxed(-signedSize);
+
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(remaining <= 0)
+     && remaining + signedSize > 0) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+
+        return allocateSample(size);                                  // RETURN
+    }
+
+    Header *header = static_cast<Header *>(d_allocator_p->allocate(
+                                  sizeof(Header)
+                      + bsls::AlignmentUtil::roundUpToMaximalAlignment(size)));
+    header->d_sample_p = 0;
+
+    return header + 1;
+}
+
+void StackTraceSamplingAllocator::deallocate(void *address)
+{
+    if (0 == address) {
+        return;                                                       // RETURN
+    }
+
+    Header *header = static_cast<Header *>(address) - 1;
+
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(0 != header->d_sample_p)) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+
+        deallocateSample(header);
+        return;                                                       // RETURN
+    }
+
+    d_allocator_p->deallocate(header);
+}
+
+// ACCESSORS
+void StackTraceSamplingAllocator::loadProfile(
+                                           bsl::vector<CallSite> *result) const
+{
+    BSLS_ASSERT(result);
+
+    result->clear();
+
+    {
+        bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+
+        result->reserve(d_sites.size());
+
+        for (SiteMap::const_iterator it = d_sites.begin();
+                                               d_sites.end() != it; ++it) {
+            const Site *site = it->second;
+
+            CallSite callSite;
+            callSite.d_addresses_p   = it->first.data();
+            callSite.d_numAddresses  = static_cast<int>(it->first.size());
+            callSite.d_liveBytes     = site->d_liveBytes;
+            callSite.d_liveBlocks    = roundToInt64(site->d_liveBlocks);
+            callSite.d_peakLiveBytes = site->d_peakLiveBytes;
+            callSite.d_totalBytes    = site->d_totalBytes;
+            callSite.d_totalBlocks   = roundToInt64(site->d_totalBlocks);
+            callSite.d_numSamples    = site->d_numSamples;
+
+            result->push_back(callSite);
+        }
+    }
+
+    bsl::sort(result->begin(), result->end(), &isMoreSignificant);
+}
+
+int StackTraceSamplingAllocator::numRecordedFrames() const
+{
+    return d_maxRecordedFrames - k_IGNORE_FRAMES;
+}
+
+bsls::Types::Int64 StackTraceSamplingAllocator::numSamples() const
+{
+    bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+
+    return d_numSamples;
+}
+
+bsls::Types::Int64 StackTraceSamplingAllocator::peakBytesInUse() const
+{
+    bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+
+    return d_peakBytesInUse;
+}
+
+bsl::ostream& StackTraceSamplingAllocator::printProfile(
+                                           bsl::ostream& stream,
+                                           int           maxNumCallSites) const
+{
+    bsl::vector<CallSite> profile(d_allocator_p);
+    loadProfile(&profile);
+
+    bsl::size_t numCallSites = profile.size();
+    if (0 <= maxNumCallSites
+     && static_cast<bsl::size_t>(maxNumCallSites) < numCallSites) {
+        numCallSites = maxNumCallSites;
+    }
+
+    stream << "Heap profile: "
+           << sampledBytesInUse() << " byte(s) in use (estimated), peak "
+           << peakBytesInUse() << " byte(s); "
+           << numSamples() << " sample(s) at a mean interval of "
+           << d_meanSamplingInterval << " byte(s) from "
+           << profile.size() << " call site(s).\n";
+
+    StackTrace stackTrace(d_allocator_p);
+    for (bsl::size_t i = 0; i < numCallSites; ++i) {
+        const CallSite& callSite = profile[i];
+
+        stream << "------------------------------------------"
+               << "-------------------------------------\n"
+               << "Call site " << i + 1 << ": "
+               << callSite.d_liveBytes << " byte(s) in "
+               << callSite.d_liveBlocks << " block(s) in use, peak "
+               << callSite.d_peakLiveBytes << " byte(s);\n"
+               << "    " << callSite.d_totalBytes << " byte(s) in "
+               << callSite.d_totalBlocks << " block(s) allocated, "
+               << callSite.d_numSamples << " sample(s).\n"
+               << "Stack trace at allocation time:\n";
+
+        int rc = StackTraceUtil::loadStackTraceFromAddressArray(
+                                                      &stackTrace,
+                                                      callSite.d_addresses_p,
+                                                      callSite.d_numAddresses);
+        if (rc || 0 == stackTrace.length()) {
+            stream << "... stack trace failed ...\n";
+        }
+        else {
+            StackTraceUtil::printFormatted(stream, stackTrace);
+        }
+        stackTrace.removeAll();
+    }
+
+    return stream;
+}
+
+bsls::Types::Int64 StackTraceSamplingAllocator::sampledBytesInUse() const
+{
+    bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+
+    return d_bytesInUse;
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+// ----------------------------------------------------------------------------
+// Copyright 2020 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,448 @@
+// balst_stacktracesamplingallocator.h                                -*-C++-*-
+#ifndef INCLUDED_BALST_STACKTRACESAMPLINGALLOCATOR
+#define INCLUDED_BALST_STACKTRACESAMPLINGALLOCATOR
+
+#include <bsls_ident.h>
+BSLS_IDENT("$Id: $")
+
+//@PURPOSE: Provide an allocator adaptor producing a sampled heap profile.
+//
+//@CLASSES:
+//  balst::StackTraceSamplingAllocator: sampling, profiling allocator adaptor
+//
+//@SEE_ALSO: balst_stacktracetestallocator, balst_stacktraceutil
+//
+//@DESCRIPTION: This component provides an allocator adaptor,
+// 'balst::StackTraceSamplingAllocator', that implements the 'bslma::Allocator'
+// protocol by forwarding every request to an underlying allocator supplied at
+// construction, while recording the call stack of a statistically
+// representative *sample* of the allocations.  The samples are aggregated per
+// allocating call site (i.e., per unique call stack), and an estimate of the
+// live and peak heap usage attributable to each call site can be obtained at
+// any time, either as a list of 'CallSite' records (see 'loadProfile') or as a
+// human-readable report with symbolically resolved stack traces (see
+// 'printProfile'):
+//..
+//   ,----------------------------------.
+//  ( balst::StackTraceSamplingAllocator )
+//   `----------------------------------'
+//                    |       ctor/dtor
+//                    |       loadProfile
+//                    |       meanSamplingInterval
+//                    |       numSamples
+//                    |       peakBytesInUse
+//                    |       printProfile
+//                    |       sampledBytesInUse
+//                    V
+//           ,----------------.
+//          ( bslma::Allocator )
+//           `----------------'
+//                            allocate
+//                            deallocate
+//..
+// Unlike 'balst::StackTraceTestAllocator' and 'bslma::TestAllocator', which
+// record every allocation and are therefore intended for test drivers, this
+// allocator is designed to be left enabled in production processes in order
+// to find the call sites responsible for the bulk of a process's memory use.
+//
+///Sampling
+///--------
+// Allocations are sampled by *byte* count rather than by allocation count:
+// conceptually, every byte allocated is sampled independently with probability
+// '1 / meanSamplingInterval', and an allocation is sampled if any one of its
+// bytes is.  This is implemented by drawing the distance (in bytes) to the
+// next sample from an exponential distribution having the mean sampling
+// interval supplied at construction (2MB by default), and counting that
+// distance down as memory is allocated.  An allocation of 'S' bytes is
+// therefore sampled with probability 'p = 1 - exp(-S / meanSamplingInterval)',
+// and each sample is weighted by '1 / p' when the profile is estimated, which
+// makes the estimates of bytes and blocks per call site unbiased: large
+// allocations are almost always sampled and counted at (nearly) face value,
+// and small allocations are rarely sampled but each sample stands for many
+// unsampled allocations from the same call site.
+//
+// Note that all figures reported by this allocator, other than the number of
+// samples, are *estimates*, and their accuracy depends on the number of
+// samples taken from a call site: call sites that allocate many multiples of
+// the sampling interval are estimated accurately, and call sites that allocate
+// a small fraction of it may not appear in the profile at all.
+//
+///Overhead
+///--------
+// Allocations that are not sampled cost one atomic subtraction from the
+// sampling countdown, and each block carries a header of
+// 'bsls::AlignmentUtil::BSLS_MAX_ALIGNMENT' bytes that identifies whether it
+// was sampled; deallocating an unsampled block costs a load of that header.
+// Sampling an allocation is much more expensive -- the call stack is walked,
+// the call site is looked up in a map, and a mutex is acquired, for a total
+// of several microseconds, dominated by walking the stack -- but happens on
+// average only once per 'meanSamplingInterval' bytes allocated.  For example,
+// with the default interval of 2MB, a workload allocating blocks of a few
+// hundred bytes at a few tens of nanoseconds each takes a sample about every
+// 8000 allocations, which adds less than 2% to the cost of the allocations.
+// Clients allocating many small blocks from a very fast underlying allocator
+// may need a larger interval to stay within a similar budget, at the cost of
+// a less accurate profile.  Note that symbols are *not* resolved when a
+// sample is taken; the (very expensive) symbol resolution is performed only
+// by 'printProfile', outside of any lock held by this allocator.
+//
+// Each call site that has ever been sampled retains a record (holding its
+// stack addresses and statistics) for the lifetime of the allocator, so the
+// memory consumed by the profile is bounded by the number of distinct call
+// sites in the program, not by the number of allocations.
+//
+///Thread Safety
+///-------------
+// 'balst::StackTraceSamplingAllocator' is fully thread-safe, meaning that
+// multiple threads may use their own instances of the class or use a shared
+// instance without further synchronization, provided that the underlying
+// allocator supplied at construction is also thread-safe.
+//
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Finding the Largest Consumers of Memory
+/// - - - - - - - - - - - - - - - - - - - - - - - - -
+// Suppose that a long-running service is observed to use far more memory than
+// expected, and that we want to find out, in production, which parts of the
+// service are responsible.
+//
+// First, we define two functions that allocate memory from a supplied
+// allocator, one of which allocates far more than the other:
+//..
+//  void cacheQuotes(bsl::vector<void *> *blocks, bslma::Allocator *allocator)
+//      // Load into the specified 'blocks' 1000 blocks of 1024 bytes each,
+//      // obtained from the specified 'allocator'.
+//  {
+//      for (int i = 0; i < 1000; ++i) {
+//          blocks->push_back(allocator->allocate(1024));
+//      }
+//  }
+//
+//  void cacheSymbols(bsl::vector<void *> *blocks, bslma::Allocator *allocator)
+//      // Load into the specified 'blocks' 1000 blocks of 16 bytes each,
+//      // obtained from the specified 'allocator'.
+//  {
+//      for (int i = 0; i < 1000; ++i) {
+//          blocks->push_back(allocator->allocate(16));
+//      }
+//  }
+//..
+// Then, we create a 'balst::StackTraceSamplingAllocator' that forwards to the
+// allocator the service would otherwise use.  Since our example allocates only
+// about 1MB, we specify a mean sampling interval of 4KB, rather than accepting
+// the default of 2MB that would be appropriate for a production process:
+//..
+//  bslma::Allocator *basicAllocator = bslma::Default::defaultAllocator();
+//
+//  balst::StackTraceSamplingAllocator profiler(4 * 1024, basicAllocator);
+//..
+// Next, we run the "service", supplying the profiling allocator:
+//..
+//  bsl::vector<void *> quotes;
+//  bsl::vector<void *> symbols;
+//
+//  cacheQuotes(&quotes, &profiler);
+//  cacheSymbols(&symbols, &profiler);
+//..
+// Then, we obtain the profile, which lists the call sites in descending order
+// of the (estimated) number of bytes they currently have in use:
+//..
+//  bsl::vector<balst::StackTraceSamplingAllocator::CallSite> profile;
+//  profiler.loadProfile(&profile);
+//
+//  assert(0 < profile.size());
+//  assert(profile[0].d_liveBytes > 500 * 1024);
+//..
+// Now, we could write a report, including a symbolic stack trace for each call
+// site, to any stream.  The stack trace of the first call site in the report
+// will include the frame of 'cacheQuotes'.  Here we limit the report to the
+// two most significant call sites:
+//..
+//  bsl::ostringstream report;
+//  profiler.printProfile(report, 2);
+//..
+// Finally, we return the memory; once it has all been freed, the estimate of
+// the bytes in use drops back to 0, while the peak is retained:
+//..
+//  for (bsl::size_t i = 0; i < quotes.size(); ++i) {
+//      profiler.deallocate(quotes[i]);
+//  }
+//  for (bsl::size_t i = 0; i < symbols.size(); ++i) {
+//      profiler.deallocate(symbols[i]);
+//  }
+//
+//  assert(0 == profiler.sampledBytesInUse());
+//  assert(0 <  profiler.peakBytesInUse());
+//..
+
+#include <balscm_version.h>
+
+#include <bslma_allocator.h>
+
+#include <bslmt_mutex.h>
+
+#include <bsls_alignmentutil.h>
+#include <bsls_atomic.h>
+#include <bsls_types.h>
+
+#include <bsl_cstddef.h>
+#include <bsl_iosfwd.h>
+#include <bsl_map.h>
+#include <bsl_vector.h>
+
+namespace BloombergLP {
+namespace balst {
+
+                     // =================================
+                     // class StackTraceSamplingAllocator
+                     // =================================
+
+class StackTraceSamplingAllocator : public bslma::Allocator {
+    // This class provides a thread-safe allocator adaptor that implements the
+    // 'bslma::Allocator' protocol, forwarding all requests to an underlying
+    // allocator, and that records the call stacks of a byte-count-driven,
+    // Poisson-distributed sample of the allocations in order to estimate the
+    // live and peak heap usage of each allocating call site.
+
+  public:
+    // PUBLIC TYPES
+    enum {
+        k_DEFAULT_MEAN_SAMPLING_INTERVAL = 2 * 1024 * 1024,
+                                      // default mean number of bytes allocated
+                                      // between two samples
+
+        k_DEFAULT_NUM_RECORDED_FRAMES    = 16
+                                      // default maximum number of stack frames
+                                      // recorded per sample
+    };
+
+    struct CallSite {
+        // This 'struct' provides the estimated heap usage attributable to a
+        // single allocating call site, as loaded by 'loadProfile'.  Note that,
+        // except for 'd_numSamples', all figures are estimates scaled from the
+        // samples taken.
+
+        // DATA
+        const void * const  *d_addresses_p;   // return addresses of the call
+                                              // stack, innermost first; valid
+                                              // for the lifetime of the
+                                              // allocator
+
+        int                  d_numAddresses;  // number of addresses at
+                                              // 'd_addresses_p'
+
+        bsls::Types::Int64   d_liveBytes;     // bytes currently in use
+
+        bsls::Types::Int64   d_liveBlocks;    // blocks currently in use
+
+        bsls::Types::Int64   d_peakLiveBytes; // maximum of 'd_liveBytes'
+
+        bsls::Types::Int64   d_totalBytes;    // bytes ever allocated
+
+        bsls::Types::Int64   d_totalBlocks;   // blocks ever allocated
+
+        bsls::Types::Int64   d_numSamples;    // samples ever taken (exact)
+    };
+
+  private:
+    // PRIVATE TYPES
+    struct Site;                      // statistics of one call site (defined
+                                      // in the '.cpp')
+
+    union Sample;                     // record prepended to each sampled block
+                                      // (defined in the '.cpp')
+
+    union Header {
+        // This 'union' is prepended to every block supplied by this allocator;
+        // it refers to the sample record of the block, if any.
+
+        Sample                              *d_sample_p;  // 0 if unsampled
+
+        bsls::AlignmentUtil::MaxAlignedType  d_alignment; // force alignment
+    };
+
+    typedef bsl::vector<const void *>   StackAddresses;
+
+    typedef bsl::map<StackAddresses, Site *> SiteMap;
+
+    // DATA
+    const bsls::Types::Int64  d_meanSamplingInterval;
+                                          // mean number of bytes between
+                                          // samples
+
+    const int                 d_maxRecordedFrames;
+                                          // number of frames captured per
+                                          // sample, including ignored frames
+
+    bsls::AtomicInt64         d_bytesUntilSample;
+                                          // number of bytes remaining to be
+                                          // allocated before the next sample
+
+    int                       d_seed;     // state of the generator of
+                                          // sampling intervals
+
+    SiteMap                   d_sites;    // call sites sampled so far
+
+    bsls::Types::Int64        d_bytesInUse;
+                                          // estimated bytes in use
+
+    bsls::Types::Int64        d_peakBytesInUse;
+                                          // maximum of 'd_bytesInUse'
+
+    bsls::Types::Int64        d_numSamples;
+                                          // number of samples ever taken
+
+    bsls::Types::Int64        d_numSamplesInUse;
+                                          // number of sampled blocks not yet
+                                          // deallocated
+
+    mutable bslmt::Mutex      d_mutex;    // guards the sampling state above,
+                                          // other than 'd_bytesUntilSample'
+
+    bslma::Allocator         *d_allocator_p;
+                                          // underlying allocator (held, not
+                                          // owned)
+
+  private:
+    // NOT IMPLEMENTED
+    StackTraceSamplingAllocator(const StackTraceSamplingAllocator&);
+    StackTraceSamplingAllocator& operator=(const StackTraceSamplingAllocator&);
+
+  private:
+    // PRIVATE MANIPULATORS
+    bsls::Types::Int64 nextSamplingInterval();
+        // Return a positive number of bytes drawn from an exponential
+        // distribution having a mean of 'd_meanSamplingInterval'.  The
+        // behavior is undefined unless the calling thread has exclusive
+        // access to 'd_seed' (e.g., by holding 'd_mutex').
+
+    void *allocateSample(size_type size);
+        // Return the address of a newly allocated, sampled block of memory of
+        // (at least) the specified 'size' (in bytes), recording the call stack
+        // of the caller, and re-arm the sampling countdown.  The behavior is
+        // undefined unless the allocation of 'size' bytes exhausted the
+        // countdown.
+
+    void deallocateSample(Header *header);
+        // Return to the underlying allocator the sampled block having the
+        // specified 'header', and update the statistics of its call site.
+
+  public:
+    // CREATORS
+    explicit
+    StackTraceSamplingAllocator(bslma::Allocator *basicAllocator = 0);
+    explicit
+    StackTraceSamplingAllocator(bsls::Types::Int64  meanSamplingInterval,
+                                bslma::Allocator   *basicAllocator = 0);
+    StackTraceSamplingAllocator(bsls::Types::Int64  meanSamplingInterval,
+                                int                 numRecordedFrames,
+                                bslma::Allocator   *basicAllocator = 0);
+        // Create a sampling allocator that forwards all requests to the
+        // underlying allocator.  Optionally specify a 'meanSamplingInterval',
+        // the mean number of bytes allocated between two samples.  If
+        // 'meanSamplingInterval' is not specified,
+        // 'k_DEFAULT_MEAN_SAMPLING_INTERVAL' is used.  Optionally specify
+        // 'numRecordedFrames', the maximum number of stack frames recorded
+        // for each sample.  If 'numRecordedFrames' is not specified,
+        // 'k_DEFAULT_NUM_RECORDED_FRAMES' is used.  Optionally specify a
+        // 'basicAllocator' used as the underlying allocator, and to supply
+        // the memory of the profile.  If 'basicAllocator' is 0, the currently
+        // installed default allocator is used.  The behavior is undefined
+        // unless '0 < meanSamplingInterval' and '0 < numRecordedFrames'.
+
+    virtual ~StackTraceSamplingAllocator();
+        // Destroy this allocator.  The behavior is undefined unless all memory
+        // allocated from this allocator has been deallocated.
+
+    // MANIPULATORS
+    virtual void *allocate(size_type size);
+        // Return a newly allocated block of memory of (at least) the specified
+        // positive 'size' (in bytes), obtained from the underlying allocator.
+        // If 'size' is 0, a null pointer is returned with no other effect.
+        // The allocation is sampled, recording the call stack of the caller,
+        // if the sampling countdown is exhausted by 'size'.  The returned
+        // block is maximally aligned provided that the underlying allocator
+        // supplies maximally aligned blocks for sizes that are a multiple of
+        // the maximal alignment.
+
+    virtual void deallocate(void *address);
+        // Return the memory block at the specified 'address' back to this
+        // allocator, and, if the block was sampled, update the profile
+        // accordingly.  If 'address' is 0, this function has no effect.  The
+        // behavior is undefined unless 'address' was allocated using this
+        // allocator object and has not already been deallocated.
+
+    // ACCESSORS
+    void loadProfile(bsl::vector<CallSite> *result) const;
+        // Load into the specified 'result' a record of the estimated heap
+        // usage of every call site that has been sampled, in descending order
+        // of the estimated number of bytes currently in use ('d_liveBytes'),
+        // then of the estimated peak number of bytes in use.  The previous
+        // contents of 'result' are discarded.
+
+    bsls::Types::Int64 meanSamplingInterval() const;
+        // Return the mean number of bytes allocated between two samples.
+
+    int numRecordedFrames() const;
+        // Return the maximum number of stack frames recorded for each sample.
+
+    bsls::Types::Int64 numSamples() const;
+        // Return the number of allocations that have been sampled.
+
+    bsls::Types::Int64 peakBytesInUse() const;
+        // Return an estimate of the maximum number of bytes that have been in
+        // use at any one time.
+
+    bsl::ostream& printProfile(bsl::ostream& stream,
+                               int           maxNumCallSites = -1) const;
+        // Write to the specified 'stream' a human-readable report of the
+        // estimated heap usage of the sampled call sites, in the order
+        // described by 'loadProfile', including a symbolically resolved stack
+        // trace of each call site, and return a reference to 'stream'.
+        // Optionally specify 'maxNumCallSites', the maximum number of call
+        // sites to report.  If 'maxNumCallSites' is negative or not specified,
+        // all sampled call sites are reported.  Note that resolving symbols is
+        // very expensive, but is done without blocking other threads' use of
+        // this allocator.
+
+    bsls::Types::Int64 sampledBytesInUse() const;
+        // Return an estimate of the number of bytes currently in use.
+};
+
+// ============================================================================
+//                            INLINE DEFINITIONS
+// ============================================================================
+
+                     // ---------------------------------
+                     // class StackTraceSamplingAllocator
+                     // ---------------------------------
+
+// ACCESSORS
+inline
+bsls::Types::Int64 StackTraceSamplingAllocator::meanSamplingInterval() const
+{
+    return d_meanSamplingInterval;
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2020 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,1248 @@
+// balst_stacktracesamplingallocator.t.cpp                            -*-C++-*-
+#include <balst_stacktracesamplingallocator.h>
+
+#include <bslim_testutil.h>
+
+#include <bslma_default.h>
+#include <bslma_defaultallocatorguard.h>
+#include <bslma_newdeleteallocator.h>
+#include <bslma_testallocator.h>
+#include <bslma_testallocatorexception.h>
+
+#include <bslmt_threadutil.h>
+
+#include <bsls_alignmentutil.h>
+#include <bsls_review.h>
+#include <bsls_stopwatch.h>
+#include <bsls_types.h>
+
+#include <bsl_cmath.h>
+#include <bsl_cstdlib.h>
+#include <bsl_cstring.h>
+#include <bsl_iostream.h>
+#include <bsl_sstream.h>
+#include <bsl_string.h>
+#include <bsl_vector.h>
+
+using namespace BloombergLP;
+using namespace bsl;
+
+// ============================================================================
+//                                   TEST PLAN
+// ----------------------------------------------------------------------------
+//                                   Overview
+//                                   --------
+// The component under test is an allocator adaptor that forwards requests to
+// an underlying allocator and records the call stacks of a byte-driven,
+// Poisson-distributed sample of the allocations.  We verify that requests are
+// forwarded with the expected alignment, that sampling at a mean interval of 1
+// byte records every allocation at face value, that the samples are
+// aggregated per call site and ordered by their live bytes, that the weighted
+// estimates converge to the true figures at realistic sampling intervals, and
+// that the adaptor is exception-neutral and thread-safe.
+// ----------------------------------------------------------------------------
+// CREATORS
+// [ 2] StackTraceSamplingAllocator(bslma::Allocator *basicAllocator = 0);
+// [ 2] StackTraceSamplingAllocator(Int64 interval, Allocator *ba = 0);
+// [ 2] StackTraceSamplingAllocator(Int64, int, Allocator *ba = 0);
+// [ 2] ~StackTraceSamplingAllocator();
+//
+// MANIPULATORS
+// [ 3] void *allocate(size_type size);
+// [ 3] void deallocate(void *address);
+//
+// ACCESSORS
+// [ 5] void loadProfile(bsl::vector<CallSite> *result) const;
+// [ 2] bsls::Types::Int64 meanSamplingInterval() const;
+// [ 2] int numRecordedFrames() const;
+// [ 4] bsls::Types::Int64 numSamples() const;
+// [ 4] bsls::Types::Int64 peakBytesInUse() const;
+// [ 7] bsl::ostream& printProfile(bsl::ostream& stream, int = -1) const;
+// [ 4] bsls::Types::Int64 sampledBytesInUse() const;
+// ----------------------------------------------------------------------------
+// [ 1] BREATHING TEST
+// [ 6] CONCERN: Estimates converge at realistic sampling intervals.
+// [ 8] CONCERN: Exception neutrality.
+// [ 9] CONCERN: Concurrent allocation and deallocation.
+// [10] USAGE EXAMPLE
+// [-1] PERFORMANCE: OVERHEAD OVER THE UNDERLYING ALLOCATOR
+
+// ============================================================================
+//                     STANDARD BDE ASSERT TEST FUNCTION
+// ----------------------------------------------------------------------------
+
+namespace {
+
+int testStatus = 0;
+
+void aSsErT(bool condition, const char *message, int line)
+{
+    if (condition) {
+        cout << "Error " __FILE__ "(" << line << "): " << message
+             << "    (failed)" << endl;
+
+        if (0 <= testStatus && testStatus <= 100) {
+            ++testStatus;
+        }
+    }
+}
+
+}  // close unnamed namespace
+
+// ============================================================================
+//               STANDARD BDE TEST DRIVER MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT       BSLIM_TESTUTIL_ASSERT
+#define ASSERTV      BSLIM_TESTUTIL_ASSERTV
+
+#define LOOP_ASSERT  BSLIM_TESTUTIL_LOOP_ASSERT
+#define LOOP0_ASSERT BSLIM_TESTUTIL_LOOP0_ASSERT
+#define LOOP1_ASSERT BSLIM_TESTUTIL_LOOP1_ASSERT
+#define LOOP2_ASSERT BSLIM_TESTUTIL_LOOP2_ASSERT
+#define LOOP3_ASSERT BSLIM_TESTUTIL_LOOP3_ASSERT
+#define LOOP4_ASSERT BSLIM_TESTUTIL_LOOP4_ASSERT
+#define LOOP5_ASSERT BSLIM_TESTUTIL_LOOP5_ASSERT
+#define LOOP6_ASSERT BSLIM_TESTUTIL_LOOP6_ASSERT
+
+#define Q            BSLIM_TESTUTIL_Q   // Quote identifier literally.
+#define P            BSLIM_TESTUTIL_P   // Print identifier and value.
+#define P_           BSLIM_TESTUTIL_P_  // P(X) without '\n'.
+#define T_           BSLIM_TESTUTIL_T_  // Print a tab (w/o newline).
+#define L_           BSLIM_TESTUTIL_L_  // current Line number
+
+// ============================================================================
+//                  GLOBAL TYPEDEFS/CONSTANTS FOR TESTING
+// ----------------------------------------------------------------------------
+
+typedef balst::StackTraceSamplingAllocator Obj;
+typedef Obj::CallSite                      CallSite;
+typedef bsls::Types::Int64                 Int64;
+
+const Int64 k_NEVER = static_cast<Int64>(1) << 50;
+    // A mean sampling interval so large that no allocation made by this test
+    // driver is ever sampled.
+
+// ============================================================================
+//                      HELPER FUNCTIONS FOR TESTING
+// ----------------------------------------------------------------------------
+
+static
+void loadBlocksFromSiteA(bsl::vector<void *> *blocks,
+                         bslma::Allocator    *allocator,
+                         bsl::size_t          numBlocks,
+                         int                  size)
+    // Append to the specified 'blocks' blocks of the specified 'size'
+    // obtained from the specified 'allocator' until 'blocks' holds the
+    // specified 'numBlocks'.  Note that testing the size of 'blocks' (rather
+    // than counting iterations) prevents the compiler from unrolling the loop,
+    // which would make each iteration a distinct call site.
+{
+    while (blocks->size() < numBlocks) {
+        blocks->push_back(allocator->allocate(size));
+    }
+}
+
+static
+void loadBlocksFromSiteB(bsl::vector<void *> *blocks,
+                         bslma::Allocator    *allocator,
+                         bsl::size_t          numBlocks,
+                         int                  size)
+    // Append to the specified 'blocks' blocks of the specified 'size'
+    // obtained from the specified 'allocator' until 'blocks' holds the
+    // specified 'numBlocks'.  Note that this function is identical to
+    // 'loadBlocksFromSiteA', but is a different call site.
+{
+    while (blocks->size() < numBlocks) {
+        void *block = allocator->allocate(size);
+        blocks->push_back(block);
+    }
+}
+
+static
+bool isWithin(double estimate, double actual, double tolerance)
+    // Return 'true' if the specified 'estimate' differs from the specified
+    // 'actual' value by at most the specified 'tolerance' (a fraction of
+    // 'actual'), and 'false' otherwise.
+{
+    return bsl::fabs(estimate - actual) <= tolerance * actual;
+}
+
+                          // ======================
+                          // struct AllocatorThread
+                          // ======================
+
+struct AllocatorThreadJob {
+    // Arguments of 'allocatorThread'.
+
+    Obj *d_allocator_p;  // allocator under test
+    int  d_numBlocks;    // number of blocks to allocate and deallocate
+};
+
+extern "C" void *allocatorThread(void *arg)
+    // Allocate and deallocate blocks of various sizes from the allocator
+    // described by the specified 'arg', which must point to an
+    // 'AllocatorThreadJob'.
+{
+    AllocatorThreadJob *job = static_cast<AllocatorThreadJob *>(arg);
+
+    enum { k_NUM_SLOTS = 64 };
+
+    void *slots[k_NUM_SLOTS];
+    bsl::memset(slots, 0, sizeof slots);
+
+    for (int i = 0; i < job->d_numBlocks; ++i) {
+        const int slot = (i * 7) % k_NUM_SLOTS;
+
+        job->d_allocator_p->deallocate(slots[slot]);
+        slots[slot] = job->d_allocator_p->allocate(1 + (i * 37) % 1000);
+        bsl::memset(slots[slot], 0xa5, 1);
+    }
+    for (int i = 0; i < k_NUM_SLOTS; ++i) {
+        job->d_allocator_p->deallocate(slots[i]);
+    }
+    return 0;
+}
+
+// ============================================================================
+//                               USAGE EXAMPLE
+// ----------------------------------------------------------------------------
+
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Finding the Largest Consumers of Memory
+/// - - - - - - - - - - - - - - - - - - - - - - - - -
+// Suppose that a long-running service is observed to use far more memory than
+// expected, and that we want to find out, in production, which parts of the
+// service are responsible.
+//
+// First, we define two functions that allocate memory from a supplied
+// allocator, one of which allocates far more than the other:
+//..
+    void cacheQuotes(bsl::vector<void *> *blocks, bslma::Allocator *allocator)
+        // Load into the specified 'blocks' 1000 blocks of 1024 bytes each,
+        // obtained from the specified 'allocator'.
+    {
+        for (int i = 0; i < 1000; ++i) {
+            blocks->push_back(allocator->allocate(1024));
+        }
+    }
+
+    void cacheSymbols(bsl::vector<void *> *blocks, bslma::Allocator *allocator)
+        // Load into the specified 'blocks' 1000 blocks of 16 bytes each,
+        // obtained from the specified 'allocator'.
+    {
+        for (int i = 0; i < 1000; ++i) {
+            blocks->push_back(allocator->allocate(16));
+        }
+    }
+//..
+
+// ============================================================================
+//                               MAIN PROGRAM
+// ----------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    const int                 test = argc > 1 ? atoi(argv[1]) : 0;
+    const bool             verbose = argc > 2;
+    const bool         veryVerbose = argc > 3;
+    const bool     veryVeryVerbose = argc > 4;
+    const bool veryVeryVeryVerbose = argc > 5;
+
+    (void)veryVeryVerbose;
+
+    cout << "TEST " << __FILE__ << " CASE " << test << endl;
+
+    // CONCERN: 'BSLS_REVIEW' failures should lead to test failures.
+    bsls::ReviewFailureHandlerGuard reviewGuard(&bsls::Review::failByAbort);
+
+    // CONCERN: In no case does memory come from the global allocator.
+
+    bslma::TestAllocator globalAllocator("global", veryVeryVeryVerbose);
+    bslma::Default::setGlobalAllocator(&globalAllocator);
+
+    switch (test) { case 0:
+      case 10: {
+        // --------------------------------------------------------------------
+        // USAGE EXAMPLE
+        //   Extracted from component header file.
+        //
+        // Concerns:
+        //: 1 The usage example provided in the component header file compiles,
+        //:   links, and runs as shown.
+        //
+        // Plan:
+        //: 1 Incorporate usage example from header into test driver, remove
+        //:   leading comment characters, and replace 'assert' with 'ASSERT'.
+        //:   (C-1)
+        //
+        // Testing:
+        //   USAGE EXAMPLE
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "USAGE EXAMPLE" << endl
+                          << "=============" << endl;
+
+        bslma::TestAllocator         da("default", veryVeryVeryVerbose);
+        bslma::DefaultAllocatorGuard dag(&da);
+
+// Then, we create a 'balst::StackTraceSamplingAllocator' that forwards to the
+// allocator the service would otherwise use.  Since our example allocates only
+// about 1MB, we specify a mean sampling interval of 4KB, rather than accepting
+// the default of 512KB that would be appropriate for a production process:
+//..
+    bslma::Allocator *basicAllocator = bslma::Default::defaultAllocator();
+
+    balst::StackTraceSamplingAllocator profiler(4 * 1024, basicAllocator);
+//..
+// Next, we run the "service", supplying the profiling allocator:
+//..
+    bsl::vector<void *> quotes;
+    bsl::vector<void *> symbols;
+
+    cacheQuotes(&quotes, &profiler);
+    cacheSymbols(&symbols, &profiler);
+//..
+// Then, we obtain the profile, which lists the call sites in descending order
+// of the (estimated) number of bytes they currently have in use:
+//..
+    bsl::vector<balst::StackTraceSamplingAllocator::CallSite> profile;
+    profiler.loadProfile(&profile);
+
+    ASSERT(0 < profile.size());
+    ASSERT(profile[0].d_liveBytes > 500 * 1024);
+//..
+// Now, we could write a report, including a symbolic stack trace for each call
+// site, to any stream.  The stack trace of the first call site in the report
+// will include the frame of 'cacheQuotes'.  Here we limit the report to the
+// two most significant call sites:
+//..
+    bsl::ostringstream report;
+    profiler.printProfile(report, 2);
+//..
+// Finally, we return the memory; once it has all been freed, the estimate of
+// the bytes in use drops back to 0, while the peak is retained:
+//..
+    for (bsl::size_t i = 0; i < quotes.size(); ++i) {
+        profiler.deallocate(quotes[i]);
+    }
+    for (bsl::size_t i = 0; i < symbols.size(); ++i) {
+        profiler.deallocate(symbols[i]);
+    }
+
+    ASSERT(0 == profiler.sampledBytesInUse());
+    ASSERT(0 <  profiler.peakBytesInUse());
+//..
+
+        if (veryVerbose) {
+            cout << report.str();
+        }
+      } break;
+      case 9: {
+        // --------------------------------------------------------------------
+        // CONCERN: CONCURRENT ALLOCATION AND DEALLOCATION
+        //
+        // Concerns:
+        //: 1 Several threads can allocate and deallocate from the same
+        //:   allocator concurrently, whether or not their allocations are
+        //:   sampled.
+        //:
+        //: 2 Once all blocks have been deallocated, every block has been
+        //:   returned to the underlying allocator, and the estimated bytes in
+        //:   use is 0.
+        //:
+        //: 3 Sampling continues throughout, at roughly the expected rate.
+        //
+        // Plan:
+        //: 1 Create an allocator with a small sampling interval, and start
+        //:   several threads that each allocate and deallocate blocks of
+        //:   various sizes, keeping a bounded number in use.  Join the
+        //:   threads and verify the statistics of the allocator and of the
+        //:   underlying test allocator.  (C-1..3)
+        //
+        // Testing:
+        //   CONCERN: Concurrent allocation and deallocation.
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "CONCURRENT ALLOCATION AND DEALLOCATION" << endl
+                          << "======================================" << endl;
+
+        enum { k_NUM_THREADS = 4, k_NUM_BLOCKS = 20000 };
+
+        bslma::TestAllocator ta("underlying", veryVeryVeryVerbose);
+        {
+            Obj mX(4096, &ta);  const Obj& X = mX;
+
+            AllocatorThreadJob             job = { &mX, k_NUM_BLOCKS };
+            bslmt::ThreadUtil::Handle handles[k_NUM_THREADS];
+
+            for (int i = 0; i < k_NUM_THREADS; ++i) {
+                ASSERT(0 == bslmt::ThreadUtil::create(&handles[i],
+                                                      &allocatorThread,
+                                                      &job));
+            }
+            for (int i = 0; i < k_NUM_THREADS; ++i) {
+                ASSERT(0 == bslmt::ThreadUtil::join(handles[i]));
+            }
+
+            // Each thread allocates about 500 bytes per block, so about
+            // '4 * 20000 * 500 / 4096', i.e., about 10000 samples are
+            // expected.
+
+            if (veryVerbose) { P(X.numSamples()); }
+
+            ASSERTV(X.numSamples(), 5000 < X.numSamples());
+            ASSERTV(X.sampledBytesInUse(), 0 == X.sampledBytesInUse());
+            ASSERTV(X.peakBytesInUse(),    0 <  X.peakBytesInUse());
+
+            bsl::vector<CallSite> profile(&ta);
+            X.loadProfile(&profile);
+
+            ASSERT(0 < profile.size());
+            for (bsl::size_t i = 0; i < profile.size(); ++i) {
+                ASSERTV(i, 0 == profile[i].d_liveBytes);
+                ASSERTV(i, 0 == profile[i].d_liveBlocks);
+            }
+        }
+        ASSERTV(ta.numBlocksInUse(), 0 == ta.numBlocksInUse());
+      } break;
+      case 8: {
+        // --------------------------------------------------------------------
+        // CONCERN: EXCEPTION NEUTRALITY
+        //
+        // Concerns:
+        //: 1 If the underlying allocator throws while a sampled allocation is
+        //:   being made, the exception propagates, and no memory is leaked.
+        //:
+        //: 2 An exception thrown while a sample is taken does not disable
+        //:   sampling of subsequent allocations.
+        //
+        // Plan:
+        //: 1 Using the 'BSLMA_TESTALLOCATOR_EXCEPTION_TEST_*' macros, allocate
+        //:   and deallocate blocks from an allocator with a mean sampling
+        //:   interval of 1 byte (so that every allocation is sampled) built
+        //:   over a test allocator, and verify that the statistics are
+        //:   consistent on every iteration.  (C-1..2)
+        //
+        // Testing:
+        //   CONCERN: Exception neutrality.
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "EXCEPTION NEUTRALITY" << endl
+                          << "====================" << endl;
+
+#ifdef BDE_BUILD_TARGET_EXC
+        bslma::TestAllocator ta("underlying", veryVeryVeryVerbose);
+        {
+            Obj mX(1, &ta);  const Obj& X = mX;
+
+            int numAttempts = 0;
+
+            BSLMA_TESTALLOCATOR_EXCEPTION_TEST_BEGIN(ta) {
+                ++numAttempts;
+
+                void *block = mX.allocate(100);
+                bsl::memset(block, 0, 100);
+
+                ASSERTV(X.sampledBytesInUse(), 100 == X.sampledBytesInUse());
+
+                mX.deallocate(block);
+            } BSLMA_TESTALLOCATOR_EXCEPTION_TEST_END
+
+            ASSERTV(numAttempts, 1 < numAttempts);
+            ASSERTV(X.numSamples(), 1 <= X.numSamples());
+            ASSERTV(X.sampledBytesInUse(), 0 == X.sampledBytesInUse());
+
+            const Int64 NUM_SAMPLES = X.numSamples();
+
+            mX.deallocate(mX.allocate(100));
+
+            ASSERTV(X.numSamples(), NUM_SAMPLES + 1 == X.numSamples());
+        }
+        ASSERTV(ta.numBlocksInUse(), 0 == ta.numBlocksInUse());
+#else
+        if (verbose) cout << "Skipped: exceptions are not enabled." << endl;
+#endif
+      } break;
+      case 7: {
+        // --------------------------------------------------------------------
+        // 'printProfile'
+        //
+        // Concerns:
+        //: 1 'printProfile' writes a summary line and one section per call
+        //:   site, including a stack trace, in the order of 'loadProfile'.
+        //:
+        //: 2 'maxNumCallSites' limits the number of call sites reported, and
+        //:   a negative value reports all of them.
+        //:
+        //: 3 'printProfile' returns a reference to the stream.
+        //:
+        //: 4 An allocator that has taken no samples writes only the summary.
+        //
+        // Plan:
+        //: 1 Print the profile of an allocator that has not sampled anything.
+        //:   (C-3..4)
+        //:
+        //: 2 Sample allocations from two call sites, and print the profile
+        //:   with 'maxNumCallSites' of -1, 1 and 0, counting the sections
+        //:   written.  (C-1..3)
+        //
+        // Testing:
+        //   bsl::ostream& printProfile(bsl::ostream& stream, int = -1) const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "'printProfile'" << endl
+                          << "==============" << endl;
+
+        bslma::TestAllocator ta("underlying", veryVeryVeryVerbose);
+        bslma::TestAllocator da("default",    veryVeryVeryVerbose);
+        bslma::DefaultAllocatorGuard dag(&da);
+        {
+            Obj mX(1, &ta);  const Obj& X = mX;
+
+            {
+                bsl::ostringstream out;
+                ASSERT(&out == &X.printProfile(out));
+                ASSERTV(out.str(),
+                        bsl::string::npos == out.str().find("Call site"));
+                ASSERTV(out.str(),
+                        bsl::string::npos != out.str().find("0 call site(s)"));
+            }
+
+            bsl::vector<void *> blocksA(&ta);
+            bsl::vector<void *> blocksB(&ta);
+
+            loadBlocksFromSiteA(&blocksA, &mX, 1, 1000);
+            loadBlocksFromSiteB(&blocksB, &mX, 1, 100);
+
+            const struct {
+                int d_line;
+                int d_maxNumCallSites;
+                int d_expSections;
+            } DATA[] = {
+                { L_, -1, 2 },
+                { L_,  2, 2 },
+                { L_,  1, 1 },
+                { L_,  0, 0 },
+            };
+            const int NUM_DATA = static_cast<int>(sizeof DATA / sizeof *DATA);
+
+            for (int ti = 0; ti < NUM_DATA; ++ti) {
+                const int LINE = DATA[ti].d_line;
+
+                bsl::ostringstream out;
+                X.printProfile(out, DATA[ti].d_maxNumCallSites);
+
+                const bsl::string REPORT = out.str();
+
+                if (veryVerbose) { cout << REPORT; }
+
+                ASSERTV(LINE, REPORT,
+                        bsl::string::npos != REPORT.find("2 call site(s)"));
+
+                int numSections = 0;
+                for (bsl::size_t pos = REPORT.find("Call site ");
+                     bsl::string::npos != pos;
+                     pos = REPORT.find("Call site ", pos + 1)) {
+                    ++numSections;
+                }
+                ASSERTV(LINE, numSections,
+                        DATA[ti].d_expSections == numSections);
+
+                if (0 < DATA[ti].d_expSections) {
+                    ASSERTV(LINE, REPORT, bsl::string::npos !=
+                          REPORT.find("Call site 1: 1000 byte(s) in 1 block"));
+                    ASSERTV(LINE, REPORT, bsl::string::npos !=
+                              REPORT.find("Stack trace at allocation time:"));
+                }
+            }
+
+            mX.deallocate(blocksA[0]);
+            mX.deallocate(blocksB[0]);
+        }
+        ASSERTV(ta.numBlocksInUse(), 0 == ta.numBlocksInUse());
+      } break;
+      case 6: {
+        // --------------------------------------------------------------------
+        // CONCERN: ESTIMATES CONVERGE AT REALISTIC SAMPLING INTERVALS
+        //
+        // Concerns:
+        //: 1 When blocks much smaller than the sampling interval are
+        //:   allocated, only a fraction of them is sampled, but the weighted
+        //:   estimates of bytes and blocks approach the true figures.
+        //:
+        //: 2 Blocks larger than the sampling interval are nearly always
+        //:   sampled, and weighted at close to face value.
+        //:
+        //: 3 The rate of sampling matches the mean sampling interval.
+        //
+        // Plan:
+        //: 1 Allocate many small blocks from one call site, and a number of
+        //:   large blocks from another, at a mean sampling interval of 4KB,
+        //:   and compare the estimates of each call site to the actual
+        //:   figures, and the number of samples to its expected value.
+        //:   (C-1..3)
+        //
+        // Testing:
+        //   CONCERN: Estimates converge at realistic sampling intervals.
+        // --------------------------------------------------------------------
+
+        if (verbose) cout
+                       << endl
+                       << "ESTIMATES CONVERGE AT REALISTIC INTERVALS" << endl
+                       << "=========================================" << endl;
+
+        enum {
+            k_INTERVAL   = 4096,
+            k_NUM_SMALL  = 40000,
+            k_SMALL_SIZE = 256,
+            k_NUM_LARGE  = 50,
+            k_LARGE_SIZE = 64 * 1024
+        };
+
+        bslma::TestAllocator ta("underlying", veryVeryVeryVerbose);
+        {
+            Obj mX(k_INTERVAL, &ta);  const Obj& X = mX;
+
+            bsl::vector<void *> blocks(&ta);
+            blocks.reserve(k_NUM_SMALL + k_NUM_LARGE);
+
+            loadBlocksFromSiteA(&blocks, &mX, k_NUM_SMALL, k_SMALL_SIZE);
+            loadBlocksFromSiteB(&blocks,
+                                &mX,
+                                k_NUM_SMALL + k_NUM_LARGE,
+                                k_LARGE_SIZE);
+
+            const double SMALL_BYTES = 1.0 * k_NUM_SMALL * k_SMALL_SIZE;
+            const double LARGE_BYTES = 1.0 * k_NUM_LARGE * k_LARGE_SIZE;
+
+            bsl::vector<CallSite> profile(&ta);
+            X.loadProfile(&profile);
+
+            ASSERTV(profile.size(), 2 == profile.size());
+
+            if (2 == profile.size()) {
+                const CallSite& SMALL = profile[0];
+                const CallSite& LARGE = profile[1];
+
+                if (veryVerbose) {
+                    P_(SMALL.d_liveBytes);  P_(SMALL.d_liveBlocks);
+                    P(SMALL.d_numSamples);
+                    P_(LARGE.d_liveBytes);  P_(LARGE.d_liveBlocks);
+                    P(LARGE.d_numSamples);
+                }
+
+                // About 2400 samples are expected from the small blocks, so
+                // the relative standard deviation of the estimate is about
+                // 2%; allow for five deviations.
+
+                ASSERTV(SMALL.d_liveBytes,
+                        isWithin(static_cast<double>(SMALL.d_liveBytes),
+                                 SMALL_BYTES,
+                                 0.1));
+                ASSERTV(SMALL.d_liveBlocks,
+                        isWithin(static_cast<double>(SMALL.d_liveBlocks),
+                                 k_NUM_SMALL,
+                                 0.1));
+                ASSERTV(SMALL.d_peakLiveBytes,
+                        SMALL.d_liveBytes == SMALL.d_peakLiveBytes);
+
+                ASSERTV(LARGE.d_numSamples, k_NUM_LARGE == LARGE.d_numSamples);
+                ASSERTV(LARGE.d_liveBytes,
+                        isWithin(static_cast<double>(LARGE.d_liveBytes),
+                                 LARGE_BYTES,
+                                 0.001));
+                ASSERTV(LARGE.d_liveBlocks, k_NUM_LARGE == LARGE.d_liveBlocks);
+
+                // Each large block is sampled once, however many sampling
+                // points fall within it.
+
+                const double EXP_SAMPLES =
+                         k_NUM_SMALL * (1.0 - bsl::exp(-1.0 * k_SMALL_SIZE
+                                                             / k_INTERVAL))
+                       + k_NUM_LARGE;
+                ASSERTV(X.numSamples(),
+                        isWithin(static_cast<double>(X.numSamples()),
+                                 EXP_SAMPLES,
+                                 0.2));
+            }
+
+            for (bsl::size_t i = 0; i < blocks.size(); ++i) {
+                mX.deallocate(blocks[i]);
+            }
+
+            ASSERTV(X.sampledBytesInUse(), 0 == X.sampledBytesInUse());
+        }
+        ASSERTV(ta.numBlocksInUse(), 0 == ta.numBlocksInUse());
+      } break;
+      case 5: {
+        // --------------------------------------------------------------------
+        // 'loadProfile'
+        //
+        // Concerns:
+        //: 1 Samples are aggregated per call site: allocations from the same
+        //:   call site are attributed to one 'CallSite', and allocations from
+        //:   different call sites to different ones.
+        //:
+        //: 2 The call sites are ordered by their bytes in use, then by their
+        //:   peak bytes in use.
+        //:
+        //: 3 The stack addresses of a call site are available, and number at
+        //:   most 'numRecordedFrames()'.
+        //:
+        //: 4 A call site is retained, with 0 bytes in use, after all of its
+        //:   blocks are deallocated, and its peak and totals are retained.
+        //:
+        //: 5 The previous contents of 'result' are discarded.
+        //
+        // Plan:
+        //: 1 Using a mean sampling interval of 1 byte, allocate blocks from
+        //:   two call sites, and verify the profile, before and after
+        //:   deallocating the blocks of either site.  (C-1..5)
+        //
+        // Testing:
+        //   void loadProfile(bsl::vector<CallSite> *result) const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "'loadProfile'" << endl
+                          << "=============" << endl;
+
+        bslma::TestAllocator ta("underlying", veryVeryVeryVerbose);
+        {
+            Obj mX(1, 8, &ta);  const Obj& X = mX;
+
+            bsl::vector<CallSite> profile(&ta);
+            X.loadProfile(&profile);
+            ASSERTV(profile.size(), 0 == profile.size());
+
+            bsl::vector<void *> blocksA(&ta);
+            bsl::vector<void *> blocksB(&ta);
+
+            loadBlocksFromSiteA(&blocksA, &mX, 3, 100);
+            loadBlocksFromSiteB(&blocksB, &mX, 2, 200);
+
+            // Site B has 400 bytes in use, and site A 300 bytes.
+
+            profile.resize(5);
+            X.loadProfile(&profile);
+            ASSERTV(profile.size(), 2 == profile.size());
+
+            if (2 == profile.size()) {
+                ASSERTV(profile[0].d_liveBytes,
+                        400 == profile[0].d_liveBytes);
+                ASSERTV(profile[0].d_liveBlocks,
+                        2 == profile[0].d_liveBlocks);
+                ASSERTV(profile[0].d_numSamples,
+                        2 == profile[0].d_numSamples);
+                ASSERTV(profile[1].d_liveBytes,
+                        300 == profile[1].d_liveBytes);
+                ASSERTV(profile[1].d_liveBlocks,
+                        3 == profile[1].d_liveBlocks);
+                ASSERTV(profile[1].d_numSamples,
+                        3 == profile[1].d_numSamples);
+
+                for (int i = 0; i < 2; ++i) {
+                    ASSERTV(i, 0 != profile[i].d_addresses_p);
+                    ASSERTV(i, profile[i].d_numAddresses,
+                            0 < profile[i].d_numAddresses);
+                    ASSERTV(i, profile[i].d_numAddresses,
+                            X.numRecordedFrames() >=
+                                                  profile[i].d_numAddresses);
+                }
+            }
+
+            // After site B's blocks are freed, site A is first; site B is
+            // retained, with its peak.
+
+            for (bsl::size_t i = 0; i < blocksB.size(); ++i) {
+                mX.deallocate(blocksB[i]);
+            }
+
+            X.loadProfile(&profile);
+            ASSERTV(profile.size(), 2 == profile.size());
+
+            if (2 == profile.size()) {
+                ASSERTV(profile[0].d_liveBytes,
+                        300 == profile[0].d_liveBytes);
+                ASSERTV(profile[1].d_liveBytes,
+                        0 == profile[1].d_liveBytes);
+                ASSERTV(profile[1].d_liveBlocks,
+                        0 == profile[1].d_liveBlocks);
+                ASSERTV(profile[1].d_peakLiveBytes,
+                        400 == profile[1].d_peakLiveBytes);
+                ASSERTV(profile[1].d_totalBytes,
+                        400 == profile[1].d_totalBytes);
+                ASSERTV(profile[1].d_totalBlocks,
+                        2 == profile[1].d_totalBlocks);
+            }
+
+            // With no bytes in use anywhere, the peaks decide the order.
+
+            for (bsl::size_t i = 0; i < blocksA.size(); ++i) {
+                mX.deallocate(blocksA[i]);
+            }
+
+            X.loadProfile(&profile);
+            ASSERTV(profile.size(), 2 == profile.size());
+
+            if (2 == profile.size()) {
+                ASSERTV(profile[0].d_peakLiveBytes,
+                        400 == profile[0].d_peakLiveBytes);
+                ASSERTV(profile[1].d_peakLiveBytes,
+                        300 == profile[1].d_peakLiveBytes);
+            }
+        }
+        ASSERTV(ta.numBlocksInUse(), 0 == ta.numBlocksInUse());
+      } break;
+      case 4: {
+        // --------------------------------------------------------------------
+        // SAMPLING EVERY ALLOCATION
+        //
+        // Concerns:
+        //: 1 With a mean sampling interval of 1 byte, every allocation is
+        //:   sampled, with a weight of 1.
+        //:
+        //: 2 'sampledBytesInUse' tracks the (requested) bytes in use, and
+        //:   'peakBytesInUse' its maximum.
+        //:
+        //: 3 Deallocating a sampled block returns all of its memory to the
+        //:   underlying allocator.
+        //
+        // Plan:
+        //: 1 Allocate and deallocate blocks of various sizes in an order that
+        //:   makes the bytes in use rise and fall, verifying the accessors
+        //:   against an oracle after each operation.  (C-1..3)
+        //
+        // Testing:
+        //   bsls::Types::Int64 numSamples() const;
+        //   bsls::Types::Int64 peakBytesInUse() const;
+        //   bsls::Types::Int64 sampledBytesInUse() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "SAMPLING EVERY ALLOCATION" << endl
+                          << "=========================" << endl;
+
+        bslma::TestAllocator ta("underlying", veryVeryVeryVerbose);
+        {
+            Obj mX(1, &ta);  const Obj& X = mX;
+
+            ASSERT(0 == X.numSamples());
+            ASSERT(0 == X.sampledBytesInUse());
+            ASSERT(0 == X.peakBytesInUse());
+
+            const int SIZES[]   = { 64, 100, 1000, 37, 4096, 200 };
+            const int NUM_SIZES = static_cast<int>(sizeof SIZES
+                                                   / sizeof *SIZES);
+
+            bsl::vector<void *> blocks(&ta);
+            blocks.reserve(NUM_SIZES);
+
+            Int64 inUse = 0;
+            Int64 peak  = 0;
+
+            for (int i = 0; i < NUM_SIZES; ++i) {
+                blocks.push_back(mX.allocate(SIZES[i]));
+                bsl::memset(blocks.back(), 0xff, SIZES[i]);
+
+                inUse += SIZES[i];
+                peak   = inUse > peak ? inUse : peak;
+
+                ASSERTV(i, X.numSamples(),        i + 1 == X.numSamples());
+                ASSERTV(i, X.sampledBytesInUse(),
+                        inUse == X.sampledBytesInUse());
+                ASSERTV(i, X.peakBytesInUse(),    peak  == X.peakBytesInUse());
+
+                if (i % 2) {
+                    // Free every other block as soon as it is allocated.
+
+                    mX.deallocate(blocks.back());
+                    blocks.back() = 0;
+                    inUse -= SIZES[i];
+
+                    ASSERTV(i, X.sampledBytesInUse(),
+                            inUse == X.sampledBytesInUse());
+                    ASSERTV(i, X.peakBytesInUse(),
+                            peak  == X.peakBytesInUse());
+                }
+            }
+
+            for (int i = 0; i < NUM_SIZES; ++i) {
+                mX.deallocate(blocks[i]);
+            }
+
+            ASSERTV(X.sampledBytesInUse(), 0 == X.sampledBytesInUse());
+            ASSERTV(X.peakBytesInUse(),    peak == X.peakBytesInUse());
+            ASSERTV(X.numSamples(),   NUM_SIZES == X.numSamples());
+
+            // Only the map holding the one call site, its stack, and its
+            // statistics remain allocated.
+
+            blocks.clear();
+            blocks.shrink_to_fit();
+            ASSERTV(ta.numBlocksInUse(), 3 >= ta.numBlocksInUse());
+        }
+        ASSERTV(ta.numBlocksInUse(), 0 == ta.numBlocksInUse());
+      } break;
+      case 3: {
+        // --------------------------------------------------------------------
+        // 'allocate' AND 'deallocate'
+        //
+        // Concerns:
+        //: 1 'allocate' forwards to the underlying allocator, and returns a
+        //:   maximally aligned block at least as large as requested.
+        //:
+        //: 2 'allocate(0)' returns 0, and 'deallocate(0)' has no effect.
+        //:
+        //: 3 'deallocate' returns the block to the underlying allocator.
+        //:
+        //: 4 Unsampled allocations do not change the profile.
+        //
+        // Plan:
+        //: 1 Using an allocator that never samples, built over a test
+        //:   allocator, allocate blocks of every size from 1 to 300 bytes,
+        //:   verify their alignment, and write over their full length (the
+        //:   test allocator detects overruns).  Deallocate them, verifying
+        //:   the number of blocks in use of the test allocator.  (C-1..4)
+        //
+        // Testing:
+        //   void *allocate(size_type size);
+        //   void deallocate(void *address);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "'allocate' AND 'deallocate'" << endl
+                          << "===========================" << endl;
+
+        bslma::TestAllocator ta("underlying", veryVeryVeryVerbose);
+        {
+            Obj mX(k_NEVER, &ta);  const Obj& X = mX;
+
+            ASSERT(0 == mX.allocate(0));
+            ASSERT(0 == ta.numBlocksTotal());
+
+            mX.deallocate(0);
+            ASSERT(0 == ta.numBlocksTotal());
+
+            enum { k_MAX_SIZE = 300 };
+
+            void *blocks[k_MAX_SIZE + 1];
+
+            for (int size = 1; size <= k_MAX_SIZE; ++size) {
+                blocks[size] = mX.allocate(size);
+
+                const bsls::Types::UintPtr address =
+                          reinterpret_cast<bsls::Types::UintPtr>(blocks[size]);
+
+                ASSERTV(size, 0 ==
+                           address % bsls::AlignmentUtil::BSLS_MAX_ALIGNMENT);
+                ASSERTV(size, size == ta.numBlocksInUse());
+
+                bsl::memset(blocks[size], size & 0xff, size);
+            }
+            for (int size = 1; size <= k_MAX_SIZE; ++size) {
+                mX.deallocate(blocks[size]);
+                ASSERTV(size, k_MAX_SIZE - size == ta.numBlocksInUse());
+            }
+
+            ASSERT(0 == X.numSamples());
+            ASSERT(0 == X.sampledBytesInUse());
+
+            bsl::vector<CallSite> profile(&ta);
+            X.loadProfile(&profile);
+            ASSERT(0 == profile.size());
+        }
+        ASSERTV(ta.numBlocksInUse(), 0 == ta.numBlocksInUse());
+      } break;
+      case 2: {
+        // --------------------------------------------------------------------
+        // CREATORS AND BASIC ACCESSORS
+        //
+        // Concerns:
+        //: 1 Each constructor sets the mean sampling interval and the number
+        //:   of recorded frames, using the documented defaults for those not
+        //:   specified.
+        //:
+        //: 2 If no allocator is supplied, the default allocator is used.
+        //:
+        //: 3 A newly created allocator has not sampled anything.
+        //:
+        //: 4 The destructor returns the memory of the profile.
+        //
+        // Plan:
+        //: 1 Create objects using each constructor, with and without an
+        //:   allocator, verifying the accessors and the allocator that
+        //:   supplies memory.  (C-1..4)
+        //
+        // Testing:
+        //   StackTraceSamplingAllocator(bslma::Allocator *basicAllocator = 0);
+        //   StackTraceSamplingAllocator(Int64 interval, Allocator *ba = 0);
+        //   StackTraceSamplingAllocator(Int64, int, Allocator *ba = 0);
+        //   ~StackTraceSamplingAllocator();
+        //   bsls::Types::Int64 meanSamplingInterval() const;
+        //   int numRecordedFrames() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "CREATORS AND BASIC ACCESSORS" << endl
+                          << "============================" << endl;
+
+        bslma::TestAllocator         da("default", veryVeryVeryVerbose);
+        bslma::TestAllocator         ta("supplied", veryVeryVeryVerbose);
+        bslma::DefaultAllocatorGuard dag(&da);
+
+        for (char cfg = 'a'; cfg <= 'f'; ++cfg) {
+            const char CONFIG = cfg;
+
+            Obj *objPtr = 0;
+
+            Int64 expInterval = Obj::k_DEFAULT_MEAN_SAMPLING_INTERVAL;
+            int   expFrames   = Obj::k_DEFAULT_NUM_RECORDED_FRAMES;
+
+            bslma::TestAllocator& oa = CONFIG % 2 ? da : ta;
+
+            switch (CONFIG) {
+              case 'a': {
+                objPtr = new (ta) Obj();
+              } break;
+              case 'b': {
+                objPtr = new (ta) Obj(&ta);
+              } break;
+              case 'c': {
+                objPtr = new (ta) Obj(1024);
+                expInterval = 1024;
+              } break;
+              case 'd': {
+                objPtr = new (ta) Obj(2048, &ta);
+                expInterval = 2048;
+              } break;
+              case 'e': {
+                objPtr = new (ta) Obj(1, 4);
+                expInterval = 1;
+                expFrames   = 4;
+              } break;
+              case 'f': {
+                objPtr = new (ta) Obj(1, 32, &ta);
+                expInterval = 1;
+                expFrames   = 32;
+              } break;
+            }
+
+            Obj& mX = *objPtr;  const Obj& X = mX;
+
+            ASSERTV(CONFIG, expInterval == X.meanSamplingInterval());
+            ASSERTV(CONFIG, expFrames   == X.numRecordedFrames());
+            ASSERTV(CONFIG, 0 == X.numSamples());
+            ASSERTV(CONFIG, 0 == X.sampledBytesInUse());
+            ASSERTV(CONFIG, 0 == X.peakBytesInUse());
+
+            const Int64 NUM_BLOCKS = oa.numBlocksInUse();
+
+            void *block = mX.allocate(10);
+            ASSERTV(CONFIG, NUM_BLOCKS < oa.numBlocksInUse());
+            mX.deallocate(block);
+
+            ta.deleteObject(objPtr);
+
+            ASSERTV(CONFIG, da.numBlocksInUse(), 0 == da.numBlocksInUse());
+            ASSERTV(CONFIG, ta.numBlocksInUse(), 0 == ta.numBlocksInUse());
+        }
+      } break;
+      case 1: {
+        // --------------------------------------------------------------------
+        // BREATHING TEST
+        //   This case exercises (but does not fully test) basic functionality.
+        //
+        // Concerns:
+        //: 1 The class is sufficiently functional to enable comprehensive
+        //:   testing in subsequent test cases.
+        //
+        // Plan:
+        //: 1 Allocate and deallocate from allocators that sample nothing and
+        //:   everything, and print a profile.  (C-1)
+        //
+        // Testing:
+        //   BREATHING TEST
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "BREATHING TEST" << endl
+                          << "==============" << endl;
+
+        bslma::TestAllocator ta("underlying", veryVeryVeryVerbose);
+        {
+            Obj mX(k_NEVER, &ta);  const Obj& X = mX;
+
+            void *p = mX.allocate(100);
+            ASSERT(0 != p);
+            ASSERT(1 == ta.numBlocksInUse());
+            ASSERT(0 == X.numSamples());
+
+            mX.deallocate(p);
+            ASSERT(0 == ta.numBlocksInUse());
+        }
+        {
+            Obj mX(1, &ta);  const Obj& X = mX;
+
+            void *p = mX.allocate(100);
+            ASSERT(0 != p);
+            ASSERT(1 == X.numSamples());
+            ASSERT(100 == X.sampledBytesInUse());
+
+            bsl::ostringstream out;
+            X.printProfile(out);
+            if (veryVerbose) {
+                cout << out.str();
+            }
+            ASSERT(bsl::string::npos != out.str().find("Call site 1"));
+
+            mX.deallocate(p);
+            ASSERT(0 == X.sampledBytesInUse());
+            ASSERT(100 == X.peakBytesInUse());
+        }
+        ASSERTV(ta.numBlocksInUse(), 0 == ta.numBlocksInUse());
+      } break;
+      case -1: {
+        // --------------------------------------------------------------------
+        // PERFORMANCE: OVERHEAD OVER THE UNDERLYING ALLOCATOR
+        //
+        // Concerns:
+        //: 1 With the default sampling interval, the cost of allocating and
+        //:   deallocating through the adaptor is within a few percent of the
+        //:   cost of using the underlying allocator directly.
+        //
+        // Plan:
+        //: 1 Time a loop that keeps a window of blocks of various sizes in
+        //:   use, replacing one block per iteration, using
+        //:   'bslma::NewDeleteAllocator' directly, through an adaptor that
+        //:   never samples, and through an adaptor using the default
+        //:   interval.  Report the time per iteration and the relative
+        //:   overhead.  (C-1)
+        //
+        // Testing:
+        //   PERFORMANCE: OVERHEAD OVER THE UNDERLYING ALLOCATOR
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                         << "OVERHEAD OVER THE UNDERLYING ALLOCATOR" << endl
+                         << "======================================" << endl;
+
+        enum { k_ITERATIONS = 4 * 1000 * 1000, k_WINDOW = 1024 };
+
+        bslma::Allocator *newDelete = &bslma::NewDeleteAllocator::singleton();
+
+        Obj unsampled(k_NEVER, newDelete);
+        Obj sampled(newDelete);
+
+        bslma::Allocator *const ALLOCATORS[] = {
+            newDelete, &unsampled, &sampled
+        };
+        const char *const NAMES[] = {
+            "NewDeleteAllocator:          ",
+            "adaptor, no sampling:        ",
+            "adaptor, default interval:   "
+        };
+
+        double times[3];
+
+        // Make two passes, and report only the second one, so that the first
+        // allocator measured does not pay for warming up the heap.
+
+        for (int pass = 0; pass < 2; ++pass)
+        for (int a = 0; a < 3; ++a) {
+            bslma::Allocator *allocator = ALLOCATORS[a];
+
+            void *window[k_WINDOW];
+            for (int i = 0; i < k_WINDOW; ++i) {
+                window[i] = allocator->allocate(16 + (i * 61) % 512);
+            }
+
+            bsls::Stopwatch timer;
+            timer.start();
+            for (int i = 0; i < k_ITERATIONS; ++i) {
+                const int slot = (i * 13) % k_WINDOW;
+
+                allocator->deallocate(window[slot]);
+                window[slot] = allocator->allocate(16 + (i * 61) % 512);
+            }
+            timer.stop();
+
+            for (int i = 0; i < k_WINDOW; ++i) {
+                allocator->deallocate(window[i]);
+            }
+
+            times[a] = timer.elapsedTime();
+
+            if (0 == pass) {
+                continue;
+            }
+
+            cout << NAMES[a] << times[a] * 1e9 / k_ITERATIONS
+                 << " ns/iteration" << endl;
+        }
+
+        // Measure the cost of sampling an allocation in isolation.
+
+        {
+            enum { k_NUM_SAMPLES = 20000 };
+
+            Obj everything(1, newDelete);
+
+            bsls::Stopwatch timer;
+            timer.start();
+            for (int i = 0; i < k_NUM_SAMPLES; ++i) {
+                everything.deallocate(everything.allocate(64));
+            }
+            timer.stop();
+
+            cout << "sampled allocation:          "
+                 << timer.elapsedTime() * 1e9 / k_NUM_SAMPLES
+                 << " ns/iteration" << endl;
+        }
+
+        cout << "samples taken: " << sampled.numSamples() << endl
+             << "overhead of sampling: "
+             << (times[2] - times[1]) * 100 / times[0] << "%" << endl
+             << "overhead of adaptor:  "
+             << (times[2] - times[0]) * 100 / times[0] << "%" << endl;
+      } break;
+      default: {
+        cerr << "WARNING: CASE `" << test << "' NOT FOUND." << endl;
+        testStatus = -1;
+      }
+    }
+
+    // CONCERN: In no case does memory come from the global allocator.
+
+    ASSERTV(globalAllocator.numBlocksTotal(),
+            0 == globalAllocator.numBlocksTotal());
+
+    if (testStatus > 0) {
+        cerr << "Error, non-zero test status = " << testStatus << "." << endl;
+    }
+    return testStatus;
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2020 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
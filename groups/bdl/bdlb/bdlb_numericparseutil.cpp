@@ -4,15 +4,20 @@
 #include <bsls_ident.h>
 BSLS_IDENT_RCSID(bdlb_numericparseutil_cpp, "$Id$ $CSID$")
 
+#include <bdlb_bitutil.h>
 #include <bdlb_chartype.h>
 
 #include <bslma_allocator.h>
 #include <bslma_default.h>
 #include <bsls_assert.h>
+#include <bsls_byteorderutil.h>
 #include <bsls_platform.h>
 #include <bslmf_assert.h>
 
+#include <bsl_cstddef.h>
+#include <bsl_cstdint.h>
 #include <bsl_cstdlib.h>  // strtod
+#include <bsl_cstring.h>
 #include <bsl_clocale.h>  // setlocale
 
 #if defined(BSLS_PLATFORM_CMP_MSVC) && BSLS_PLATFORM_CMP_VERSION < 1900
@@ -26,6 +31,9 @@ namespace BloombergLP {
 
 namespace bdlb {
 
+typedef bsls::Types::Int64  Int64;
+typedef bsls::Types::Uint64 Uint64;
+
 namespace {
 
 #if defined(BSLS_PLATFORM_OS_LINUX)
@@ -46,6 +54,1073 @@ int doubleSign(double number)
 }
 #endif
 
+typedef NumericParseUtil::size_type size_type;
+
+inline
+bool isDecimalDigit(char character)
+    // Return 'true' if the specified 'character' is one of the characters
+    // '0' through '9', and 'false' otherwise.
+{
+    return static_cast<unsigned>(character - '0') <= 9u;
+}
+
+inline
+Uint64 loadEightCharacters(const char *characters)
+    // Return the eight characters starting at the specified 'characters'
+    // packed into a 64-bit integer such that the first character occupies
+    // the least significant byte.
+{
+    Uint64 result;
+    bsl::memcpy(&result, characters, sizeof result);
+#ifdef BSLS_PLATFORM_IS_BIG_ENDIAN
+    result = bsls::ByteOrderUtil::swapBytes(result);
+#endif
+    return result;
+}
+
+inline
+bool isEightDigits(Uint64 characters)
+    // Return 'true' if each of the eight bytes of the specified 'characters'
+    // (as returned by 'loadEightCharacters') is a decimal digit, and 'false'
+    // otherwise.  A byte is a digit if its high nibble is 3 and adding 6 to
+    // it does not carry into that nibble.
+{
+    return 0 == (((characters & 0xF0F0F0F0F0F0F0F0ULL)
+               | (((characters + 0x0606060606060606ULL)
+                   & 0xF0F0F0F0F0F0F0F0ULL) >> 4))
+                                                  ^ 0x3333333333333333ULL);
+}
+
+inline
+Uint64 parseEightDigits(Uint64 characters)
+    // Return the value of the eight decimal digits packed into the specified
+    // 'characters' (as returned by 'loadEightCharacters').  The behavior is
+    // undefined unless 'isEightDigits(characters)'.  Note that the digits are
+    // combined pairwise in three multiplications rather than one at a time.
+{
+    const Uint64 k_MASK = 0x000000FF000000FFULL;
+    const Uint64 k_MUL1 = 0x000F424000000064ULL;  // 100 + (1000000 << 32)
+    const Uint64 k_MUL2 = 0x0000271000000001ULL;  // 1 + (10000 << 32)
+
+    characters -= 0x3030303030303030ULL;
+    characters  = characters * 10 + (characters >> 8);
+    return (((characters & k_MASK) * k_MUL1)
+          + (((characters >> 16) & k_MASK) * k_MUL2)) >> 32;
+}
+
+size_type parseDecimalDigitGroups(Uint64     *result,
+                                  const char *characters,
+                                  size_type   maxNumCharacters,
+                                  Uint64      maxValue)
+    // Consume groups of eight decimal digits from the specified 'characters',
+    // examining at most the specified 'maxNumCharacters', appending each group
+    // to the value of the specified 'result' for as long as doing so cannot
+    // produce a value greater than the specified 'maxValue'.  Return the
+    // number of characters consumed (a multiple of 8).  Note that the caller
+    // is expected to parse any remaining digits one at a time.
+{
+    const Uint64 limit = maxValue / 100000000;
+
+    Uint64    value = *result;
+    size_type i     = 0;
+
+    while (maxNumCharacters - i >= 8 && value < limit) {
+        const Uint64 group = loadEightCharacters(characters + i);
+        if (!isEightDigits(group)) {
+            break;                                                     // BREAK
+        }
+        value = value * 100000000 + parseEightDigits(group);
+        i    += 8;
+    }
+
+    *result = value;
+    return i;
+}
+
+enum {
+    k_MIN_POWER_OF_TEN = -348,  // exponent of the first 's_powersOfTen' entry
+    k_MAX_POWER_OF_TEN =  347   // exponent of the last 's_powersOfTen' entry
+};
+
+// The 128-bit significands, rounded down, of the powers of ten from '1e-348'
+// to '1e347', each normalized so that its most significant bit is set.  Each
+// entry holds the low 64 bits followed by the high 64 bits.
+
+static const Uint64 s_powersOfTen[][2] = {
+    { 0x1732C869CD60E453uLL, 0xFA8FD5A0081C0288uLL },  // 1e-348
+    { 0x0E7FBD42205C8EB4uLL, 0x9C99E58405118195uLL },  // 1e-347
+    { 0x521FAC92A873B261uLL, 0xC3C05EE50655E1FAuLL },  // 1e-346
+    { 0xE6A797B752909EF9uLL, 0xF4B0769E47EB5A78uLL },  // 1e-345
+    { 0x9028BED2939A635CuLL, 0x98EE4A22ECF3188BuLL },  // 1e-344
+    { 0x7432EE873880FC33uLL, 0xBF29DCABA82FDEAEuLL },  // 1e-343
+    { 0x113FAA2906A13B3FuLL, 0xEEF453D6923BD65AuLL },  // 1e-342
+    { 0x4AC7CA59A424C507uLL, 0x9558B4661B6565F8uLL },  // 1e-341
+    { 0x5D79BCF00D2DF649uLL, 0xBAAEE17FA23EBF76uLL },  // 1e-340
+    { 0xF4D82C2C107973DCuLL, 0xE95A99DF8ACE6F53uLL },  // 1e-339
+    { 0x79071B9B8A4BE869uLL, 0x91D8A02BB6C10594uLL },  // 1e-338
+    { 0x9748E2826CDEE284uLL, 0xB64EC836A47146F9uLL },  // 1e-337
+    { 0xFD1B1B2308169B25uLL, 0xE3E27A444D8D98B7uLL },  // 1e-336
+    { 0xFE30F0F5E50E20F7uLL, 0x8E6D8C6AB0787F72uLL },  // 1e-335
+    { 0xBDBD2D335E51A935uLL, 0xB208EF855C969F4FuLL },  // 1e-334
+    { 0xAD2C788035E61382uLL, 0xDE8B2B66B3BC4723uLL },  // 1e-333
+    { 0x4C3BCB5021AFCC31uLL, 0x8B16FB203055AC76uLL },  // 1e-332
+    { 0xDF4ABE242A1BBF3DuLL, 0xADDCB9E83C6B1793uLL },  // 1e-331
+    { 0xD71D6DAD34A2AF0DuLL, 0xD953E8624B85DD78uLL },  // 1e-330
+    { 0x8672648C40E5AD68uLL, 0x87D4713D6F33AA6BuLL },  // 1e-329
+    { 0x680EFDAF511F18C2uLL, 0xA9C98D8CCB009506uLL },  // 1e-328
+    { 0x0212BD1B2566DEF2uLL, 0xD43BF0EFFDC0BA48uLL },  // 1e-327
+    { 0x014BB630F7604B57uLL, 0x84A57695FE98746DuLL },  // 1e-326
+    { 0x419EA3BD35385E2DuLL, 0xA5CED43B7E3E9188uLL },  // 1e-325
+    { 0x52064CAC828675B9uLL, 0xCF42894A5DCE35EAuLL },  // 1e-324
+    { 0x7343EFEBD1940993uLL, 0x818995CE7AA0E1B2uLL },  // 1e-323
+    { 0x1014EBE6C5F90BF8uLL, 0xA1EBFB4219491A1FuLL },  // 1e-322
+    { 0xD41A26E077774EF6uLL, 0xCA66FA129F9B60A6uLL },  // 1e-321
+    { 0x8920B098955522B4uLL, 0xFD00B897478238D0uLL },  // 1e-320
+    { 0x55B46E5F5D5535B0uLL, 0x9E20735E8CB16382uLL },  // 1e-319
+    { 0xEB2189F734AA831DuLL, 0xC5A890362FDDBC62uLL },  // 1e-318
+    { 0xA5E9EC7501D523E4uLL, 0xF712B443BBD52B7BuLL },  // 1e-317
+    { 0x47B233C92125366EuLL, 0x9A6BB0AA55653B2DuLL },  // 1e-316
+    { 0x999EC0BB696E840AuLL, 0xC1069CD4EABE89F8uLL },  // 1e-315
+    { 0xC00670EA43CA250DuLL, 0xF148440A256E2C76uLL },  // 1e-314
+    { 0x380406926A5E5728uLL, 0x96CD2A865764DBCAuLL },  // 1e-313
+    { 0xC605083704F5ECF2uLL, 0xBC807527ED3E12BCuLL },  // 1e-312
+    { 0xF7864A44C633682EuLL, 0xEBA09271E88D976BuLL },  // 1e-311
+    { 0x7AB3EE6AFBE0211DuLL, 0x93445B8731587EA3uLL },  // 1e-310
+    { 0x5960EA05BAD82964uLL, 0xB8157268FDAE9E4CuLL },  // 1e-309
+    { 0x6FB92487298E33BDuLL, 0xE61ACF033D1A45DFuLL },  // 1e-308
+    { 0xA5D3B6D479F8E056uLL, 0x8FD0C16206306BABuLL },  // 1e-307
+    { 0x8F48A4899877186CuLL, 0xB3C4F1BA87BC8696uLL },  // 1e-306
+    { 0x331ACDABFE94DE87uLL, 0xE0B62E2929ABA83CuLL },  // 1e-305
+    { 0x9FF0C08B7F1D0B14uLL, 0x8C71DCD9BA0B4925uLL },  // 1e-304
+    { 0x07ECF0AE5EE44DD9uLL, 0xAF8E5410288E1B6FuLL },  // 1e-303
+    { 0xC9E82CD9F69D6150uLL, 0xDB71E91432B1A24AuLL },  // 1e-302
+    { 0xBE311C083A225CD2uLL, 0x892731AC9FAF056EuLL },  // 1e-301
+    { 0x6DBD630A48AAF406uLL, 0xAB70FE17C79AC6CAuLL },  // 1e-300
+    { 0x092CBBCCDAD5B108uLL, 0xD64D3D9DB981787DuLL },  // 1e-299
+    { 0x25BBF56008C58EA5uLL, 0x85F0468293F0EB4EuLL },  // 1e-298
+    { 0xAF2AF2B80AF6F24EuLL, 0xA76C582338ED2621uLL },  // 1e-297
+    { 0x1AF5AF660DB4AEE1uLL, 0xD1476E2C07286FAAuLL },  // 1e-296
+    { 0x50D98D9FC890ED4DuLL, 0x82CCA4DB847945CAuLL },  // 1e-295
+    { 0xE50FF107BAB528A0uLL, 0xA37FCE126597973CuLL },  // 1e-294
+    { 0x1E53ED49A96272C8uLL, 0xCC5FC196FEFD7D0CuLL },  // 1e-293
+    { 0x25E8E89C13BB0F7AuLL, 0xFF77B1FCBEBCDC4FuLL },  // 1e-292
+    { 0x77B191618C54E9ACuLL, 0x9FAACF3DF73609B1uLL },  // 1e-291
+    { 0xD59DF5B9EF6A2417uLL, 0xC795830D75038C1DuLL },  // 1e-290
+    { 0x4B0573286B44AD1DuLL, 0xF97AE3D0D2446F25uLL },  // 1e-289
+    { 0x4EE367F9430AEC32uLL, 0x9BECCE62836AC577uLL },  // 1e-288
+    { 0x229C41F793CDA73FuLL, 0xC2E801FB244576D5uLL },  // 1e-287
+    { 0x6B43527578C1110FuLL, 0xF3A20279ED56D48AuLL },  // 1e-286
+    { 0x830A13896B78AAA9uLL, 0x9845418C345644D6uLL },  // 1e-285
+    { 0x23CC986BC656D553uLL, 0xBE5691EF416BD60CuLL },  // 1e-284
+    { 0x2CBFBE86B7EC8AA8uLL, 0xEDEC366B11C6CB8FuLL },  // 1e-283
+    { 0x7BF7D71432F3D6A9uLL, 0x94B3A202EB1C3F39uLL },  // 1e-282
+    { 0xDAF5CCD93FB0CC53uLL, 0xB9E08A83A5E34F07uLL },  // 1e-281
+    { 0xD1B3400F8F9CFF68uLL, 0xE858AD248F5C22C9uLL },  // 1e-280
+    { 0x23100809B9C21FA1uLL, 0x91376C36D99995BEuLL },  // 1e-279
+    { 0xABD40A0C2832A78AuLL, 0xB58547448FFFFB2DuLL },  // 1e-278
+    { 0x16C90C8F323F516CuLL, 0xE2E69915B3FFF9F9uLL },  // 1e-277
+    { 0xAE3DA7D97F6792E3uLL, 0x8DD01FAD907FFC3BuLL },  // 1e-276
+    { 0x99CD11CFDF41779CuLL, 0xB1442798F49FFB4AuLL },  // 1e-275
+    { 0x40405643D711D583uLL, 0xDD95317F31C7FA1DuLL },  // 1e-274
+    { 0x482835EA666B2572uLL, 0x8A7D3EEF7F1CFC52uLL },  // 1e-273
+    { 0xDA3243650005EECFuLL, 0xAD1C8EAB5EE43B66uLL },  // 1e-272
+    { 0x90BED43E40076A82uLL, 0xD863B256369D4A40uLL },  // 1e-271
+    { 0x5A7744A6E804A291uLL, 0x873E4F75E2224E68uLL },  // 1e-270
+    { 0x711515D0A205CB36uLL, 0xA90DE3535AAAE202uLL },  // 1e-269
+    { 0x0D5A5B44CA873E03uLL, 0xD3515C2831559A83uLL },  // 1e-268
+    { 0xE858790AFE9486C2uLL, 0x8412D9991ED58091uLL },  // 1e-267
+    { 0x626E974DBE39A872uLL, 0xA5178FFF668AE0B6uLL },  // 1e-266
+    { 0xFB0A3D212DC8128FuLL, 0xCE5D73FF402D98E3uLL },  // 1e-265
+    { 0x7CE66634BC9D0B99uLL, 0x80FA687F881C7F8EuLL },  // 1e-264
+    { 0x1C1FFFC1EBC44E80uLL, 0xA139029F6A239F72uLL },  // 1e-263
+    { 0xA327FFB266B56220uLL, 0xC987434744AC874EuLL },  // 1e-262
+    { 0x4BF1FF9F0062BAA8uLL, 0xFBE9141915D7A922uLL },  // 1e-261
+    { 0x6F773FC3603DB4A9uLL, 0x9D71AC8FADA6C9B5uLL },  // 1e-260
+    { 0xCB550FB4384D21D3uLL, 0xC4CE17B399107C22uLL },  // 1e-259
+    { 0x7E2A53A146606A48uLL, 0xF6019DA07F549B2BuLL },  // 1e-258
+    { 0x2EDA7444CBFC426DuLL, 0x99C102844F94E0FBuLL },  // 1e-257
+    { 0xFA911155FEFB5308uLL, 0xC0314325637A1939uLL },  // 1e-256
+    { 0x793555AB7EBA27CAuLL, 0xF03D93EEBC589F88uLL },  // 1e-255
+    { 0x4BC1558B2F3458DEuLL, 0x96267C7535B763B5uLL },  // 1e-254
+    { 0x9EB1AAEDFB016F16uLL, 0xBBB01B9283253CA2uLL },  // 1e-253
+    { 0x465E15A979C1CADCuLL, 0xEA9C227723EE8BCBuLL },  // 1e-252
+    { 0x0BFACD89EC191EC9uLL, 0x92A1958A7675175FuLL },  // 1e-251
+    { 0xCEF980EC671F667BuLL, 0xB749FAED14125D36uLL },  // 1e-250
+    { 0x82B7E12780E7401AuLL, 0xE51C79A85916F484uLL },  // 1e-249
+    { 0xD1B2ECB8B0908810uLL, 0x8F31CC0937AE58D2uLL },  // 1e-248
+    { 0x861FA7E6DCB4AA15uLL, 0xB2FE3F0B8599EF07uLL },  // 1e-247
+    { 0x67A791E093E1D49AuLL, 0xDFBDCECE67006AC9uLL },  // 1e-246
+    { 0xE0C8BB2C5C6D24E0uLL, 0x8BD6A141006042BDuLL },  // 1e-245
+    { 0x58FAE9F773886E18uLL, 0xAECC49914078536DuLL },  // 1e-244
+    { 0xAF39A475506A899EuLL, 0xDA7F5BF590966848uLL },  // 1e-243
+    { 0x6D8406C952429603uLL, 0x888F99797A5E012DuLL },  // 1e-242
+    { 0xC8E5087BA6D33B83uLL, 0xAAB37FD7D8F58178uLL },  // 1e-241
+    { 0xFB1E4A9A90880A64uLL, 0xD5605FCDCF32E1D6uLL },  // 1e-240
+    { 0x5CF2EEA09A55067FuLL, 0x855C3BE0A17FCD26uLL },  // 1e-239
+    { 0xF42FAA48C0EA481EuLL, 0xA6B34AD8C9DFC06FuLL },  // 1e-238
+    { 0xF13B94DAF124DA26uLL, 0xD0601D8EFC57B08BuLL },  // 1e-237
+    { 0x76C53D08D6B70858uLL, 0x823C12795DB6CE57uLL },  // 1e-236
+    { 0x54768C4B0C64CA6EuLL, 0xA2CB1717B52481EDuLL },  // 1e-235
+    { 0xA9942F5DCF7DFD09uLL, 0xCB7DDCDDA26DA268uLL },  // 1e-234
+    { 0xD3F93B35435D7C4CuLL, 0xFE5D54150B090B02uLL },  // 1e-233
+    { 0xC47BC5014A1A6DAFuLL, 0x9EFA548D26E5A6E1uLL },  // 1e-232
+    { 0x359AB6419CA1091BuLL, 0xC6B8E9B0709F109AuLL },  // 1e-231
+    { 0xC30163D203C94B62uLL, 0xF867241C8CC6D4C0uLL },  // 1e-230
+    { 0x79E0DE63425DCF1DuLL, 0x9B407691D7FC44F8uLL },  // 1e-229
+    { 0x985915FC12F542E4uLL, 0xC21094364DFB5636uLL },  // 1e-228
+    { 0x3E6F5B7B17B2939DuLL, 0xF294B943E17A2BC4uLL },  // 1e-227
+    { 0xA705992CEECF9C42uLL, 0x979CF3CA6CEC5B5AuLL },  // 1e-226
+    { 0x50C6FF782A838353uLL, 0xBD8430BD08277231uLL },  // 1e-225
+    { 0xA4F8BF5635246428uLL, 0xECE53CEC4A314EBDuLL },  // 1e-224
+    { 0x871B7795E136BE99uLL, 0x940F4613AE5ED136uLL },  // 1e-223
+    { 0x28E2557B59846E3FuLL, 0xB913179899F68584uLL },  // 1e-222
+    { 0x331AEADA2FE589CFuLL, 0xE757DD7EC07426E5uLL },  // 1e-221
+    { 0x3FF0D2C85DEF7621uLL, 0x9096EA6F3848984FuLL },  // 1e-220
+    { 0x0FED077A756B53A9uLL, 0xB4BCA50B065ABE63uLL },  // 1e-219
+    { 0xD3E8495912C62894uLL, 0xE1EBCE4DC7F16DFBuLL },  // 1e-218
+    { 0x64712DD7ABBBD95CuLL, 0x8D3360F09CF6E4BDuLL },  // 1e-217
+    { 0xBD8D794D96AACFB3uLL, 0xB080392CC4349DECuLL },  // 1e-216
+    { 0xECF0D7A0FC5583A0uLL, 0xDCA04777F541C567uLL },  // 1e-215
+    { 0xF41686C49DB57244uLL, 0x89E42CAAF9491B60uLL },  // 1e-214
+    { 0x311C2875C522CED5uLL, 0xAC5D37D5B79B6239uLL },  // 1e-213
+    { 0x7D633293366B828BuLL, 0xD77485CB25823AC7uLL },  // 1e-212
+    { 0xAE5DFF9C02033197uLL, 0x86A8D39EF77164BCuLL },  // 1e-211
+    { 0xD9F57F830283FDFCuLL, 0xA8530886B54DBDEBuLL },  // 1e-210
+    { 0xD072DF63C324FD7BuLL, 0xD267CAA862A12D66uLL },  // 1e-209
+    { 0x4247CB9E59F71E6DuLL, 0x8380DEA93DA4BC60uLL },  // 1e-208
+    { 0x52D9BE85F074E608uLL, 0xA46116538D0DEB78uLL },  // 1e-207
+    { 0x67902E276C921F8BuLL, 0xCD795BE870516656uLL },  // 1e-206
+    { 0x00BA1CD8A3DB53B6uLL, 0x806BD9714632DFF6uLL },  // 1e-205
+    { 0x80E8A40ECCD228A4uLL, 0xA086CFCD97BF97F3uLL },  // 1e-204
+    { 0x6122CD128006B2CDuLL, 0xC8A883C0FDAF7DF0uLL },  // 1e-203
+    { 0x796B805720085F81uLL, 0xFAD2A4B13D1B5D6CuLL },  // 1e-202
+    { 0xCBE3303674053BB0uLL, 0x9CC3A6EEC6311A63uLL },  // 1e-201
+    { 0xBEDBFC4411068A9CuLL, 0xC3F490AA77BD60FCuLL },  // 1e-200
+    { 0xEE92FB5515482D44uLL, 0xF4F1B4D515ACB93BuLL },  // 1e-199
+    { 0x751BDD152D4D1C4AuLL, 0x991711052D8BF3C5uLL },  // 1e-198
+    { 0xD262D45A78A0635DuLL, 0xBF5CD54678EEF0B6uLL },  // 1e-197
+    { 0x86FB897116C87C34uLL, 0xEF340A98172AACE4uLL },  // 1e-196
+    { 0xD45D35E6AE3D4DA0uLL, 0x9580869F0E7AAC0EuLL },  // 1e-195
+    { 0x8974836059CCA109uLL, 0xBAE0A846D2195712uLL },  // 1e-194
+    { 0x2BD1A438703FC94BuLL, 0xE998D258869FACD7uLL },  // 1e-193
+    { 0x7B6306A34627DDCFuLL, 0x91FF83775423CC06uLL },  // 1e-192
+    { 0x1A3BC84C17B1D542uLL, 0xB67F6455292CBF08uLL },  // 1e-191
+    { 0x20CABA5F1D9E4A93uLL, 0xE41F3D6A7377EECAuLL },  // 1e-190
+    { 0x547EB47B7282EE9CuLL, 0x8E938662882AF53EuLL },  // 1e-189
+    { 0xE99E619A4F23AA43uLL, 0xB23867FB2A35B28DuLL },  // 1e-188
+    { 0x6405FA00E2EC94D4uLL, 0xDEC681F9F4C31F31uLL },  // 1e-187
+    { 0xDE83BC408DD3DD04uLL, 0x8B3C113C38F9F37EuLL },  // 1e-186
+    { 0x9624AB50B148D445uLL, 0xAE0B158B4738705EuLL },  // 1e-185
+    { 0x3BADD624DD9B0957uLL, 0xD98DDAEE19068C76uLL },  // 1e-184
+    { 0xE54CA5D70A80E5D6uLL, 0x87F8A8D4CFA417C9uLL },  // 1e-183
+    { 0x5E9FCF4CCD211F4CuLL, 0xA9F6D30A038D1DBCuLL },  // 1e-182
+    { 0x7647C3200069671FuLL, 0xD47487CC8470652BuLL },  // 1e-181
+    { 0x29ECD9F40041E073uLL, 0x84C8D4DFD2C63F3BuLL },  // 1e-180
+    { 0xF468107100525890uLL, 0xA5FB0A17C777CF09uLL },  // 1e-179
+    { 0x7182148D4066EEB4uLL, 0xCF79CC9DB955C2CCuLL },  // 1e-178
+    { 0xC6F14CD848405530uLL, 0x81AC1FE293D599BFuLL },  // 1e-177
+    { 0xB8ADA00E5A506A7CuLL, 0xA21727DB38CB002FuLL },  // 1e-176
+    { 0xA6D90811F0E4851CuLL, 0xCA9CF1D206FDC03BuLL },  // 1e-175
+    { 0x908F4A166D1DA663uLL, 0xFD442E4688BD304AuLL },  // 1e-174
+    { 0x9A598E4E043287FEuLL, 0x9E4A9CEC15763E2EuLL },  // 1e-173
+    { 0x40EFF1E1853F29FDuLL, 0xC5DD44271AD3CDBAuLL },  // 1e-172
+    { 0xD12BEE59E68EF47CuLL, 0xF7549530E188C128uLL },  // 1e-171
+    { 0x82BB74F8301958CEuLL, 0x9A94DD3E8CF578B9uLL },  // 1e-170
+    { 0xE36A52363C1FAF01uLL, 0xC13A148E3032D6E7uLL },  // 1e-169
+    { 0xDC44E6C3CB279AC1uLL, 0xF18899B1BC3F8CA1uLL },  // 1e-168
+    { 0x29AB103A5EF8C0B9uLL, 0x96F5600F15A7B7E5uLL },  // 1e-167
+    { 0x7415D448F6B6F0E7uLL, 0xBCB2B812DB11A5DEuLL },  // 1e-166
+    { 0x111B495B3464AD21uLL, 0xEBDF661791D60F56uLL },  // 1e-165
+    { 0xCAB10DD900BEEC34uLL, 0x936B9FCEBB25C995uLL },  // 1e-164
+    { 0x3D5D514F40EEA742uLL, 0xB84687C269EF3BFBuLL },  // 1e-163
+    { 0x0CB4A5A3112A5112uLL, 0xE65829B3046B0AFAuLL },  // 1e-162
+    { 0x47F0E785EABA72ABuLL, 0x8FF71A0FE2C2E6DCuLL },  // 1e-161
+    { 0x59ED216765690F56uLL, 0xB3F4E093DB73A093uLL },  // 1e-160
+    { 0x306869C13EC3532CuLL, 0xE0F218B8D25088B8uLL },  // 1e-159
+    { 0x1E414218C73A13FBuLL, 0x8C974F7383725573uLL },  // 1e-158
+    { 0xE5D1929EF90898FAuLL, 0xAFBD2350644EEACFuLL },  // 1e-157
+    { 0xDF45F746B74ABF39uLL, 0xDBAC6C247D62A583uLL },  // 1e-156
+    { 0x6B8BBA8C328EB783uLL, 0x894BC396CE5DA772uLL },  // 1e-155
+    { 0x066EA92F3F326564uLL, 0xAB9EB47C81F5114FuLL },  // 1e-154
+    { 0xC80A537B0EFEFEBDuLL, 0xD686619BA27255A2uLL },  // 1e-153
+    { 0xBD06742CE95F5F36uLL, 0x8613FD0145877585uLL },  // 1e-152
+    { 0x2C48113823B73704uLL, 0xA798FC4196E952E7uLL },  // 1e-151
+    { 0xF75A15862CA504C5uLL, 0xD17F3B51FCA3A7A0uLL },  // 1e-150
+    { 0x9A984D73DBE722FBuLL, 0x82EF85133DE648C4uLL },  // 1e-149
+    { 0xC13E60D0D2E0EBBAuLL, 0xA3AB66580D5FDAF5uLL },  // 1e-148
+    { 0x318DF905079926A8uLL, 0xCC963FEE10B7D1B3uLL },  // 1e-147
+    { 0xFDF17746497F7052uLL, 0xFFBBCFE994E5C61FuLL },  // 1e-146
+    { 0xFEB6EA8BEDEFA633uLL, 0x9FD561F1FD0F9BD3uLL },  // 1e-145
+    { 0xFE64A52EE96B8FC0uLL, 0xC7CABA6E7C5382C8uLL },  // 1e-144
+    { 0x3DFDCE7AA3C673B0uLL, 0xF9BD690A1B68637BuLL },  // 1e-143
+    { 0x06BEA10CA65C084EuLL, 0x9C1661A651213E2DuLL },  // 1e-142
+    { 0x486E494FCFF30A62uLL, 0xC31BFA0FE5698DB8uLL },  // 1e-141
+    { 0x5A89DBA3C3EFCCFAuLL, 0xF3E2F893DEC3F126uLL },  // 1e-140
+    { 0xF89629465A75E01CuLL, 0x986DDB5C6B3A76B7uLL },  // 1e-139
+    { 0xF6BBB397F1135823uLL, 0xBE89523386091465uLL },  // 1e-138
+    { 0x746AA07DED582E2CuLL, 0xEE2BA6C0678B597FuLL },  // 1e-137
+    { 0xA8C2A44EB4571CDCuLL, 0x94DB483840B717EFuLL },  // 1e-136
+    { 0x92F34D62616CE413uLL, 0xBA121A4650E4DDEBuLL },  // 1e-135
+    { 0x77B020BAF9C81D17uLL, 0xE896A0D7E51E1566uLL },  // 1e-134
+    { 0x0ACE1474DC1D122EuLL, 0x915E2486EF32CD60uLL },  // 1e-133
+    { 0x0D819992132456BAuLL, 0xB5B5ADA8AAFF80B8uLL },  // 1e-132
+    { 0x10E1FFF697ED6C69uLL, 0xE3231912D5BF60E6uLL },  // 1e-131
+    { 0xCA8D3FFA1EF463C1uLL, 0x8DF5EFABC5979C8FuLL },  // 1e-130
+    { 0xBD308FF8A6B17CB2uLL, 0xB1736B96B6FD83B3uLL },  // 1e-129
+    { 0xAC7CB3F6D05DDBDEuLL, 0xDDD0467C64BCE4A0uLL },  // 1e-128
+    { 0x6BCDF07A423AA96BuLL, 0x8AA22C0DBEF60EE4uLL },  // 1e-127
+    { 0x86C16C98D2C953C6uLL, 0xAD4AB7112EB3929DuLL },  // 1e-126
+    { 0xE871C7BF077BA8B7uLL, 0xD89D64D57A607744uLL },  // 1e-125
+    { 0x11471CD764AD4972uLL, 0x87625F056C7C4A8BuLL },  // 1e-124
+    { 0xD598E40D3DD89BCFuLL, 0xA93AF6C6C79B5D2DuLL },  // 1e-123
+    { 0x4AFF1D108D4EC2C3uLL, 0xD389B47879823479uLL },  // 1e-122
+    { 0xCEDF722A585139BAuLL, 0x843610CB4BF160CBuLL },  // 1e-121
+    { 0xC2974EB4EE658828uLL, 0xA54394FE1EEDB8FEuLL },  // 1e-120
+    { 0x733D226229FEEA32uLL, 0xCE947A3DA6A9273EuLL },  // 1e-119
+    { 0x0806357D5A3F525FuLL, 0x811CCC668829B887uLL },  // 1e-118
+    { 0xCA07C2DCB0CF26F7uLL, 0xA163FF802A3426A8uLL },  // 1e-117
+    { 0xFC89B393DD02F0B5uLL, 0xC9BCFF6034C13052uLL },  // 1e-116
+    { 0xBBAC2078D443ACE2uLL, 0xFC2C3F3841F17C67uLL },  // 1e-115
+    { 0xD54B944B84AA4C0DuLL, 0x9D9BA7832936EDC0uLL },  // 1e-114
+    { 0x0A9E795E65D4DF11uLL, 0xC5029163F384A931uLL },  // 1e-113
+    { 0x4D4617B5FF4A16D5uLL, 0xF64335BCF065D37DuLL },  // 1e-112
+    { 0x504BCED1BF8E4E45uLL, 0x99EA0196163FA42EuLL },  // 1e-111
+    { 0xE45EC2862F71E1D6uLL, 0xC06481FB9BCF8D39uLL },  // 1e-110
+    { 0x5D767327BB4E5A4CuLL, 0xF07DA27A82C37088uLL },  // 1e-109
+    { 0x3A6A07F8D510F86FuLL, 0x964E858C91BA2655uLL },  // 1e-108
+    { 0x890489F70A55368BuLL, 0xBBE226EFB628AFEAuLL },  // 1e-107
+    { 0x2B45AC74CCEA842EuLL, 0xEADAB0ABA3B2DBE5uLL },  // 1e-106
+    { 0x3B0B8BC90012929DuLL, 0x92C8AE6B464FC96FuLL },  // 1e-105
+    { 0x09CE6EBB40173744uLL, 0xB77ADA0617E3BBCBuLL },  // 1e-104
+    { 0xCC420A6A101D0515uLL, 0xE55990879DDCAABDuLL },  // 1e-103
+    { 0x9FA946824A12232DuLL, 0x8F57FA54C2A9EAB6uLL },  // 1e-102
+    { 0x47939822DC96ABF9uLL, 0xB32DF8E9F3546564uLL },  // 1e-101
+    { 0x59787E2B93BC56F7uLL, 0xDFF9772470297EBDuLL },  // 1e-100
+    { 0x57EB4EDB3C55B65AuLL, 0x8BFBEA76C619EF36uLL },  // 1e-99
+    { 0xEDE622920B6B23F1uLL, 0xAEFAE51477A06B03uLL },  // 1e-98
+    { 0xE95FAB368E45ECEDuLL, 0xDAB99E59958885C4uLL },  // 1e-97
+    { 0x11DBCB0218EBB414uLL, 0x88B402F7FD75539BuLL },  // 1e-96
+    { 0xD652BDC29F26A119uLL, 0xAAE103B5FCD2A881uLL },  // 1e-95
+    { 0x4BE76D3346F0495FuLL, 0xD59944A37C0752A2uLL },  // 1e-94
+    { 0x6F70A4400C562DDBuLL, 0x857FCAE62D8493A5uLL },  // 1e-93
+    { 0xCB4CCD500F6BB952uLL, 0xA6DFBD9FB8E5B88EuLL },  // 1e-92
+    { 0x7E2000A41346A7A7uLL, 0xD097AD07A71F26B2uLL },  // 1e-91
+    { 0x8ED400668C0C28C8uLL, 0x825ECC24C873782FuLL },  // 1e-90
+    { 0x728900802F0F32FAuLL, 0xA2F67F2DFA90563BuLL },  // 1e-89
+    { 0x4F2B40A03AD2FFB9uLL, 0xCBB41EF979346BCAuLL },  // 1e-88
+    { 0xE2F610C84987BFA8uLL, 0xFEA126B7D78186BCuLL },  // 1e-87
+    { 0x0DD9CA7D2DF4D7C9uLL, 0x9F24B832E6B0F436uLL },  // 1e-86
+    { 0x91503D1C79720DBBuLL, 0xC6EDE63FA05D3143uLL },  // 1e-85
+    { 0x75A44C6397CE912AuLL, 0xF8A95FCF88747D94uLL },  // 1e-84
+    { 0xC986AFBE3EE11ABAuLL, 0x9B69DBE1B548CE7CuLL },  // 1e-83
+    { 0xFBE85BADCE996168uLL, 0xC24452DA229B021BuLL },  // 1e-82
+    { 0xFAE27299423FB9C3uLL, 0xF2D56790AB41C2A2uLL },  // 1e-81
+    { 0xDCCD879FC967D41AuLL, 0x97C560BA6B0919A5uLL },  // 1e-80
+    { 0x5400E987BBC1C920uLL, 0xBDB6B8E905CB600FuLL },  // 1e-79
+    { 0x290123E9AAB23B68uLL, 0xED246723473E3813uLL },  // 1e-78
+    { 0xF9A0B6720AAF6521uLL, 0x9436C0760C86E30BuLL },  // 1e-77
+    { 0xF808E40E8D5B3E69uLL, 0xB94470938FA89BCEuLL },  // 1e-76
+    { 0xB60B1D1230B20E04uLL, 0xE7958CB87392C2C2uLL },  // 1e-75
+    { 0xB1C6F22B5E6F48C2uLL, 0x90BD77F3483BB9B9uLL },  // 1e-74
+    { 0x1E38AEB6360B1AF3uLL, 0xB4ECD5F01A4AA828uLL },  // 1e-73
+    { 0x25C6DA63C38DE1B0uLL, 0xE2280B6C20DD5232uLL },  // 1e-72
+    { 0x579C487E5A38AD0EuLL, 0x8D590723948A535FuLL },  // 1e-71
+    { 0x2D835A9DF0C6D851uLL, 0xB0AF48EC79ACE837uLL },  // 1e-70
+    { 0xF8E431456CF88E65uLL, 0xDCDB1B2798182244uLL },  // 1e-69
+    { 0x1B8E9ECB641B58FFuLL, 0x8A08F0F8BF0F156BuLL },  // 1e-68
+    { 0xE272467E3D222F3FuLL, 0xAC8B2D36EED2DAC5uLL },  // 1e-67
+    { 0x5B0ED81DCC6ABB0FuLL, 0xD7ADF884AA879177uLL },  // 1e-66
+    { 0x98E947129FC2B4E9uLL, 0x86CCBB52EA94BAEAuLL },  // 1e-65
+    { 0x3F2398D747B36224uLL, 0xA87FEA27A539E9A5uLL },  // 1e-64
+    { 0x8EEC7F0D19A03AADuLL, 0xD29FE4B18E88640EuLL },  // 1e-63
+    { 0x1953CF68300424ACuLL, 0x83A3EEEEF9153E89uLL },  // 1e-62
+    { 0x5FA8C3423C052DD7uLL, 0xA48CEAAAB75A8E2BuLL },  // 1e-61
+    { 0x3792F412CB06794DuLL, 0xCDB02555653131B6uLL },  // 1e-60
+    { 0xE2BBD88BBEE40BD0uLL, 0x808E17555F3EBF11uLL },  // 1e-59
+    { 0x5B6ACEAEAE9D0EC4uLL, 0xA0B19D2AB70E6ED6uLL },  // 1e-58
+    { 0xF245825A5A445275uLL, 0xC8DE047564D20A8BuLL },  // 1e-57
+    { 0xEED6E2F0F0D56712uLL, 0xFB158592BE068D2EuLL },  // 1e-56
+    { 0x55464DD69685606BuLL, 0x9CED737BB6C4183DuLL },  // 1e-55
+    { 0xAA97E14C3C26B886uLL, 0xC428D05AA4751E4CuLL },  // 1e-54
+    { 0xD53DD99F4B3066A8uLL, 0xF53304714D9265DFuLL },  // 1e-53
+    { 0xE546A8038EFE4029uLL, 0x993FE2C6D07B7FABuLL },  // 1e-52
+    { 0xDE98520472BDD033uLL, 0xBF8FDB78849A5F96uLL },  // 1e-51
+    { 0x963E66858F6D4440uLL, 0xEF73D256A5C0F77CuLL },  // 1e-50
+    { 0xDDE7001379A44AA8uLL, 0x95A8637627989AADuLL },  // 1e-49
+    { 0x5560C018580D5D52uLL, 0xBB127C53B17EC159uLL },  // 1e-48
+    { 0xAAB8F01E6E10B4A6uLL, 0xE9D71B689DDE71AFuLL },  // 1e-47
+    { 0xCAB3961304CA70E8uLL, 0x9226712162AB070DuLL },  // 1e-46
+    { 0x3D607B97C5FD0D22uLL, 0xB6B00D69BB55C8D1uLL },  // 1e-45
+    { 0x8CB89A7DB77C506AuLL, 0xE45C10C42A2B3B05uLL },  // 1e-44
+    { 0x77F3608E92ADB242uLL, 0x8EB98A7A9A5B04E3uLL },  // 1e-43
+    { 0x55F038B237591ED3uLL, 0xB267ED1940F1C61CuLL },  // 1e-42
+    { 0x6B6C46DEC52F6688uLL, 0xDF01E85F912E37A3uLL },  // 1e-41
+    { 0x2323AC4B3B3DA015uLL, 0x8B61313BBABCE2C6uLL },  // 1e-40
+    { 0xABEC975E0A0D081AuLL, 0xAE397D8AA96C1B77uLL },  // 1e-39
+    { 0x96E7BD358C904A21uLL, 0xD9C7DCED53C72255uLL },  // 1e-38
+    { 0x7E50D64177DA2E54uLL, 0x881CEA14545C7575uLL },  // 1e-37
+    { 0xDDE50BD1D5D0B9E9uLL, 0xAA242499697392D2uLL },  // 1e-36
+    { 0x955E4EC64B44E864uLL, 0xD4AD2DBFC3D07787uLL },  // 1e-35
+    { 0xBD5AF13BEF0B113EuLL, 0x84EC3C97DA624AB4uLL },  // 1e-34
+    { 0xECB1AD8AEACDD58EuLL, 0xA6274BBDD0FADD61uLL },  // 1e-33
+    { 0x67DE18EDA5814AF2uLL, 0xCFB11EAD453994BAuLL },  // 1e-32
+    { 0x80EACF948770CED7uLL, 0x81CEB32C4B43FCF4uLL },  // 1e-31
+    { 0xA1258379A94D028DuLL, 0xA2425FF75E14FC31uLL },  // 1e-30
+    { 0x096EE45813A04330uLL, 0xCAD2F7F5359A3B3EuLL },  // 1e-29
+    { 0x8BCA9D6E188853FCuLL, 0xFD87B5F28300CA0DuLL },  // 1e-28
+    { 0x775EA264CF55347DuLL, 0x9E74D1B791E07E48uLL },  // 1e-27
+    { 0x95364AFE032A819DuLL, 0xC612062576589DDAuLL },  // 1e-26
+    { 0x3A83DDBD83F52204uLL, 0xF79687AED3EEC551uLL },  // 1e-25
+    { 0xC4926A9672793542uLL, 0x9ABE14CD44753B52uLL },  // 1e-24
+    { 0x75B7053C0F178293uLL, 0xC16D9A0095928A27uLL },  // 1e-23
+    { 0x5324C68B12DD6338uLL, 0xF1C90080BAF72CB1uLL },  // 1e-22
+    { 0xD3F6FC16EBCA5E03uLL, 0x971DA05074DA7BEEuLL },  // 1e-21
+    { 0x88F4BB1CA6BCF584uLL, 0xBCE5086492111AEAuLL },  // 1e-20
+    { 0x2B31E9E3D06C32E5uLL, 0xEC1E4A7DB69561A5uLL },  // 1e-19
+    { 0x3AFF322E62439FCFuLL, 0x9392EE8E921D5D07uLL },  // 1e-18
+    { 0x09BEFEB9FAD487C2uLL, 0xB877AA3236A4B449uLL },  // 1e-17
+    { 0x4C2EBE687989A9B3uLL, 0xE69594BEC44DE15BuLL },  // 1e-16
+    { 0x0F9D37014BF60A10uLL, 0x901D7CF73AB0ACD9uLL },  // 1e-15
+    { 0x538484C19EF38C94uLL, 0xB424DC35095CD80FuLL },  // 1e-14
+    { 0x2865A5F206B06FB9uLL, 0xE12E13424BB40E13uLL },  // 1e-13
+    { 0xF93F87B7442E45D3uLL, 0x8CBCCC096F5088CBuLL },  // 1e-12
+    { 0xF78F69A51539D748uLL, 0xAFEBFF0BCB24AAFEuLL },  // 1e-11
+    { 0xB573440E5A884D1BuLL, 0xDBE6FECEBDEDD5BEuLL },  // 1e-10
+    { 0x31680A88F8953030uLL, 0x89705F4136B4A597uLL },  // 1e-9
+    { 0xFDC20D2B36BA7C3DuLL, 0xABCC77118461CEFCuLL },  // 1e-8
+    { 0x3D32907604691B4CuLL, 0xD6BF94D5E57A42BCuLL },  // 1e-7
+    { 0xA63F9A49C2C1B10FuLL, 0x8637BD05AF6C69B5uLL },  // 1e-6
+    { 0x0FCF80DC33721D53uLL, 0xA7C5AC471B478423uLL },  // 1e-5
+    { 0xD3C36113404EA4A8uLL, 0xD1B71758E219652BuLL },  // 1e-4
+    { 0x645A1CAC083126E9uLL, 0x83126E978D4FDF3BuLL },  // 1e-3
+    { 0x3D70A3D70A3D70A3uLL, 0xA3D70A3D70A3D70AuLL },  // 1e-2
+    { 0xCCCCCCCCCCCCCCCCuLL, 0xCCCCCCCCCCCCCCCCuLL },  // 1e-1
+    { 0x0000000000000000uLL, 0x8000000000000000uLL },  // 1e0
+    { 0x0000000000000000uLL, 0xA000000000000000uLL },  // 1e1
+    { 0x0000000000000000uLL, 0xC800000000000000uLL },  // 1e2
+    { 0x0000000000000000uLL, 0xFA00000000000000uLL },  // 1e3
+    { 0x0000000000000000uLL, 0x9C40000000000000uLL },  // 1e4
+    { 0x0000000000000000uLL, 0xC350000000000000uLL },  // 1e5
+    { 0x0000000000000000uLL, 0xF424000000000000uLL },  // 1e6
+    { 0x0000000000000000uLL, 0x9896800000000000uLL },  // 1e7
+    { 0x0000000000000000uLL, 0xBEBC200000000000uLL },  // 1e8
+    { 0x0000000000000000uLL, 0xEE6B280000000000uLL },  // 1e9
+    { 0x0000000000000000uLL, 0x9502F90000000000uLL },  // 1e10
+    { 0x0000000000000000uLL, 0xBA43B74000000000uLL },  // 1e11
+    { 0x0000000000000000uLL, 0xE8D4A51000000000uLL },  // 1e12
+    { 0x0000000000000000uLL, 0x9184E72A00000000uLL },  // 1e13
+    { 0x0000000000000000uLL, 0xB5E620F480000000uLL },  // 1e14
+    { 0x0000000000000000uLL, 0xE35FA931A0000000uLL },  // 1e15
+    { 0x0000000000000000uLL, 0x8E1BC9BF04000000uLL },  // 1e16
+    { 0x0000000000000000uLL, 0xB1A2BC2EC5000000uLL },  // 1e17
+    { 0x0000000000000000uLL, 0xDE0B6B3A76400000uLL },  // 1e18
+    { 0x0000000000000000uLL, 0x8AC7230489E80000uLL },  // 1e19
+    { 0x0000000000000000uLL, 0xAD78EBC5AC620000uLL },  // 1e20
+    { 0x0000000000000000uLL, 0xD8D726B7177A8000uLL },  // 1e21
+    { 0x0000000000000000uLL, 0x878678326EAC9000uLL },  // 1e22
+    { 0x0000000000000000uLL, 0xA968163F0A57B400uLL },  // 1e23
+    { 0x0000000000000000uLL, 0xD3C21BCECCEDA100uLL },  // 1e24
+    { 0x0000000000000000uLL, 0x84595161401484A0uLL },  // 1e25
+    { 0x0000000000000000uLL, 0xA56FA5B99019A5C8uLL },  // 1e26
+    { 0x0000000000000000uLL, 0xCECB8F27F4200F3AuLL },  // 1e27
+    { 0x4000000000000000uLL, 0x813F3978F8940984uLL },  // 1e28
+    { 0x5000000000000000uLL, 0xA18F07D736B90BE5uLL },  // 1e29
+    { 0xA400000000000000uLL, 0xC9F2C9CD04674EDEuLL },  // 1e30
+    { 0x4D00000000000000uLL, 0xFC6F7C4045812296uLL },  // 1e31
+    { 0xF020000000000000uLL, 0x9DC5ADA82B70B59DuLL },  // 1e32
+    { 0x6C28000000000000uLL, 0xC5371912364CE305uLL },  // 1e33
+    { 0xC732000000000000uLL, 0xF684DF56C3E01BC6uLL },  // 1e34
+    { 0x3C7F400000000000uLL, 0x9A130B963A6C115CuLL },  // 1e35
+    { 0x4B9F100000000000uLL, 0xC097CE7BC90715B3uLL },  // 1e36
+    { 0x1E86D40000000000uLL, 0xF0BDC21ABB48DB20uLL },  // 1e37
+    { 0x1314448000000000uLL, 0x96769950B50D88F4uLL },  // 1e38
+    { 0x17D955A000000000uLL, 0xBC143FA4E250EB31uLL },  // 1e39
+    { 0x5DCFAB0800000000uLL, 0xEB194F8E1AE525FDuLL },  // 1e40
+    { 0x5AA1CAE500000000uLL, 0x92EFD1B8D0CF37BEuLL },  // 1e41
+    { 0xF14A3D9E40000000uLL, 0xB7ABC627050305ADuLL },  // 1e42
+    { 0x6D9CCD05D0000000uLL, 0xE596B7B0C643C719uLL },  // 1e43
+    { 0xE4820023A2000000uLL, 0x8F7E32CE7BEA5C6FuLL },  // 1e44
+    { 0xDDA2802C8A800000uLL, 0xB35DBF821AE4F38BuLL },  // 1e45
+    { 0xD50B2037AD200000uLL, 0xE0352F62A19E306EuLL },  // 1e46
+    { 0x4526F422CC340000uLL, 0x8C213D9DA502DE45uLL },  // 1e47
+    { 0x9670B12B7F410000uLL, 0xAF298D050E4395D6uLL },  // 1e48
+    { 0x3C0CDD765F114000uLL, 0xDAF3F04651D47B4CuLL },  // 1e49
+    { 0xA5880A69FB6AC800uLL, 0x88D8762BF324CD0FuLL },  // 1e50
+    { 0x8EEA0D047A457A00uLL, 0xAB0E93B6EFEE0053uLL },  // 1e51
+    { 0x72A4904598D6D880uLL, 0xD5D238A4ABE98068uLL },  // 1e52
+    { 0x47A6DA2B7F864750uLL, 0x85A36366EB71F041uLL },  // 1e53
+    { 0x999090B65F67D924uLL, 0xA70C3C40A64E6C51uLL },  // 1e54
+    { 0xFFF4B4E3F741CF6DuLL, 0xD0CF4B50CFE20765uLL },  // 1e55
+    { 0xBFF8F10E7A8921A4uLL, 0x82818F1281ED449FuLL },  // 1e56
+    { 0xAFF72D52192B6A0DuLL, 0xA321F2D7226895C7uLL },  // 1e57
+    { 0x9BF4F8A69F764490uLL, 0xCBEA6F8CEB02BB39uLL },  // 1e58
+    { 0x02F236D04753D5B4uLL, 0xFEE50B7025C36A08uLL },  // 1e59
+    { 0x01D762422C946590uLL, 0x9F4F2726179A2245uLL },  // 1e60
+    { 0x424D3AD2B7B97EF5uLL, 0xC722F0EF9D80AAD6uLL },  // 1e61
+    { 0xD2E0898765A7DEB2uLL, 0xF8EBAD2B84E0D58BuLL },  // 1e62
+    { 0x63CC55F49F88EB2FuLL, 0x9B934C3B330C8577uLL },  // 1e63
+    { 0x3CBF6B71C76B25FBuLL, 0xC2781F49FFCFA6D5uLL },  // 1e64
+    { 0x8BEF464E3945EF7AuLL, 0xF316271C7FC3908AuLL },  // 1e65
+    { 0x97758BF0E3CBB5ACuLL, 0x97EDD871CFDA3A56uLL },  // 1e66
+    { 0x3D52EEED1CBEA317uLL, 0xBDE94E8E43D0C8ECuLL },  // 1e67
+    { 0x4CA7AAA863EE4BDDuLL, 0xED63A231D4C4FB27uLL },  // 1e68
+    { 0x8FE8CAA93E74EF6AuLL, 0x945E455F24FB1CF8uLL },  // 1e69
+    { 0xB3E2FD538E122B44uLL, 0xB975D6B6EE39E436uLL },  // 1e70
+    { 0x60DBBCA87196B616uLL, 0xE7D34C64A9C85D44uLL },  // 1e71
+    { 0xBC8955E946FE31CDuLL, 0x90E40FBEEA1D3A4AuLL },  // 1e72
+    { 0x6BABAB6398BDBE41uLL, 0xB51D13AEA4A488DDuLL },  // 1e73
+    { 0xC696963C7EED2DD1uLL, 0xE264589A4DCDAB14uLL },  // 1e74
+    { 0xFC1E1DE5CF543CA2uLL, 0x8D7EB76070A08AECuLL },  // 1e75
+    { 0x3B25A55F43294BCBuLL, 0xB0DE65388CC8ADA8uLL },  // 1e76
+    { 0x49EF0EB713F39EBEuLL, 0xDD15FE86AFFAD912uLL },  // 1e77
+    { 0x6E3569326C784337uLL, 0x8A2DBF142DFCC7ABuLL },  // 1e78
+    { 0x49C2C37F07965404uLL, 0xACB92ED9397BF996uLL },  // 1e79
+    { 0xDC33745EC97BE906uLL, 0xD7E77A8F87DAF7FBuLL },  // 1e80
+    { 0x69A028BB3DED71A3uLL, 0x86F0AC99B4E8DAFDuLL },  // 1e81
+    { 0xC40832EA0D68CE0CuLL, 0xA8ACD7C0222311BCuLL },  // 1e82
+    { 0xF50A3FA490C30190uLL, 0xD2D80DB02AABD62BuLL },  // 1e83
+    { 0x792667C6DA79E0FAuLL, 0x83C7088E1AAB65DBuLL },  // 1e84
+    { 0x577001B891185938uLL, 0xA4B8CAB1A1563F52uLL },  // 1e85
+    { 0xED4C0226B55E6F86uLL, 0xCDE6FD5E09ABCF26uLL },  // 1e86
+    { 0x544F8158315B05B4uLL, 0x80B05E5AC60B6178uLL },  // 1e87
+    { 0x696361AE3DB1C721uLL, 0xA0DC75F1778E39D6uLL },  // 1e88
+    { 0x03BC3A19CD1E38E9uLL, 0xC913936DD571C84CuLL },  // 1e89
+    { 0x04AB48A04065C723uLL, 0xFB5878494ACE3A5FuLL },  // 1e90
+    { 0x62EB0D64283F9C76uLL, 0x9D174B2DCEC0E47BuLL },  // 1e91
+    { 0x3BA5D0BD324F8394uLL, 0xC45D1DF942711D9AuLL },  // 1e92
+    { 0xCA8F44EC7EE36479uLL, 0xF5746577930D6500uLL },  // 1e93
+    { 0x7E998B13CF4E1ECBuLL, 0x9968BF6ABBE85F20uLL },  // 1e94
+    { 0x9E3FEDD8C321A67EuLL, 0xBFC2EF456AE276E8uLL },  // 1e95
+    { 0xC5CFE94EF3EA101EuLL, 0xEFB3AB16C59B14A2uLL },  // 1e96
+    { 0xBBA1F1D158724A12uLL, 0x95D04AEE3B80ECE5uLL },  // 1e97
+    { 0x2A8A6E45AE8EDC97uLL, 0xBB445DA9CA61281FuLL },  // 1e98
+    { 0xF52D09D71A3293BDuLL, 0xEA1575143CF97226uLL },  // 1e99
+    { 0x593C2626705F9C56uLL, 0x924D692CA61BE758uLL },  // 1e100
+    { 0x6F8B2FB00C77836CuLL, 0xB6E0C377CFA2E12EuLL },  // 1e101
+    { 0x0B6DFB9C0F956447uLL, 0xE498F455C38B997AuLL },  // 1e102
+    { 0x4724BD4189BD5EACuLL, 0x8EDF98B59A373FECuLL },  // 1e103
+    { 0x58EDEC91EC2CB657uLL, 0xB2977EE300C50FE7uLL },  // 1e104
+    { 0x2F2967B66737E3EDuLL, 0xDF3D5E9BC0F653E1uLL },  // 1e105
+    { 0xBD79E0D20082EE74uLL, 0x8B865B215899F46CuLL },  // 1e106
+    { 0xECD8590680A3AA11uLL, 0xAE67F1E9AEC07187uLL },  // 1e107
+    { 0xE80E6F4820CC9495uLL, 0xDA01EE641A708DE9uLL },  // 1e108
+    { 0x3109058D147FDCDDuLL, 0x884134FE908658B2uLL },  // 1e109
+    { 0xBD4B46F0599FD415uLL, 0xAA51823E34A7EEDEuLL },  // 1e110
+    { 0x6C9E18AC7007C91AuLL, 0xD4E5E2CDC1D1EA96uLL },  // 1e111
+    { 0x03E2CF6BC604DDB0uLL, 0x850FADC09923329EuLL },  // 1e112
+    { 0x84DB8346B786151CuLL, 0xA6539930BF6BFF45uLL },  // 1e113
+    { 0xE612641865679A63uLL, 0xCFE87F7CEF46FF16uLL },  // 1e114
+    { 0x4FCB7E8F3F60C07EuLL, 0x81F14FAE158C5F6EuLL },  // 1e115
+    { 0xE3BE5E330F38F09DuLL, 0xA26DA3999AEF7749uLL },  // 1e116
+    { 0x5CADF5BFD3072CC5uLL, 0xCB090C8001AB551CuLL },  // 1e117
+    { 0x73D9732FC7C8F7F6uLL, 0xFDCB4FA002162A63uLL },  // 1e118
+    { 0x2867E7FDDCDD9AFAuLL, 0x9E9F11C4014DDA7EuLL },  // 1e119
+    { 0xB281E1FD541501B8uLL, 0xC646D63501A1511DuLL },  // 1e120
+    { 0x1F225A7CA91A4226uLL, 0xF7D88BC24209A565uLL },  // 1e121
+    { 0x3375788DE9B06958uLL, 0x9AE757596946075FuLL },  // 1e122
+    { 0x0052D6B1641C83AEuLL, 0xC1A12D2FC3978937uLL },  // 1e123
+    { 0xC0678C5DBD23A49AuLL, 0xF209787BB47D6B84uLL },  // 1e124
+    { 0xF840B7BA963646E0uLL, 0x9745EB4D50CE6332uLL },  // 1e125
+    { 0xB650E5A93BC3D898uLL, 0xBD176620A501FBFFuLL },  // 1e126
+    { 0xA3E51F138AB4CEBEuLL, 0xEC5D3FA8CE427AFFuLL },  // 1e127
+    { 0xC66F336C36B10137uLL, 0x93BA47C980E98CDFuLL },  // 1e128
+    { 0xB80B0047445D4184uLL, 0xB8A8D9BBE123F017uLL },  // 1e129
+    { 0xA60DC059157491E5uLL, 0xE6D3102AD96CEC1DuLL },  // 1e130
+    { 0x87C89837AD68DB2FuLL, 0x9043EA1AC7E41392uLL },  // 1e131
+    { 0x29BABE4598C311FBuLL, 0xB454E4A179DD1877uLL },  // 1e132
+    { 0xF4296DD6FEF3D67AuLL, 0xE16A1DC9D8545E94uLL },  // 1e133
+    { 0x1899E4A65F58660CuLL, 0x8CE2529E2734BB1DuLL },  // 1e134
+    { 0x5EC05DCFF72E7F8FuLL, 0xB01AE745B101E9E4uLL },  // 1e135
+    { 0x76707543F4FA1F73uLL, 0xDC21A1171D42645DuLL },  // 1e136
+    { 0x6A06494A791C53A8uLL, 0x899504AE72497EBAuLL },  // 1e137
+    { 0x0487DB9D17636892uLL, 0xABFA45DA0EDBDE69uLL },  // 1e138
+    { 0x45A9D2845D3C42B6uLL, 0xD6F8D7509292D603uLL },  // 1e139
+    { 0x0B8A2392BA45A9B2uLL, 0x865B86925B9BC5C2uLL },  // 1e140
+    { 0x8E6CAC7768D7141EuLL, 0xA7F26836F282B732uLL },  // 1e141
+    { 0x3207D795430CD926uLL, 0xD1EF0244AF2364FFuLL },  // 1e142
+    { 0x7F44E6BD49E807B8uLL, 0x8335616AED761F1FuLL },  // 1e143
+    { 0x5F16206C9C6209A6uLL, 0xA402B9C5A8D3A6E7uLL },  // 1e144
+    { 0x36DBA887C37A8C0FuLL, 0xCD036837130890A1uLL },  // 1e145
+    { 0xC2494954DA2C9789uLL, 0x802221226BE55A64uLL },  // 1e146
+    { 0xF2DB9BAA10B7BD6CuLL, 0xA02AA96B06DEB0FDuLL },  // 1e147
+    { 0x6F92829494E5ACC7uLL, 0xC83553C5C8965D3DuLL },  // 1e148
+    { 0xCB772339BA1F17F9uLL, 0xFA42A8B73ABBF48CuLL },  // 1e149
+    { 0xFF2A760414536EFBuLL, 0x9C69A97284B578D7uLL },  // 1e150
+    { 0xFEF5138519684ABAuLL, 0xC38413CF25E2D70DuLL },  // 1e151
+    { 0x7EB258665FC25D69uLL, 0xF46518C2EF5B8CD1uLL },  // 1e152
+    { 0xEF2F773FFBD97A61uLL, 0x98BF2F79D5993802uLL },  // 1e153
+    { 0xAAFB550FFACFD8FAuLL, 0xBEEEFB584AFF8603uLL },  // 1e154
+    { 0x95BA2A53F983CF38uLL, 0xEEAABA2E5DBF6784uLL },  // 1e155
+    { 0xDD945A747BF26183uLL, 0x952AB45CFA97A0B2uLL },  // 1e156
+    { 0x94F971119AEEF9E4uLL, 0xBA756174393D88DFuLL },  // 1e157
+    { 0x7A37CD5601AAB85DuLL, 0xE912B9D1478CEB17uLL },  // 1e158
+    { 0xAC62E055C10AB33AuLL, 0x91ABB422CCB812EEuLL },  // 1e159
+    { 0x577B986B314D6009uLL, 0xB616A12B7FE617AAuLL },  // 1e160
+    { 0xED5A7E85FDA0B80BuLL, 0xE39C49765FDF9D94uLL },  // 1e161
+    { 0x14588F13BE847307uLL, 0x8E41ADE9FBEBC27DuLL },  // 1e162
+    { 0x596EB2D8AE258FC8uLL, 0xB1D219647AE6B31CuLL },  // 1e163
+    { 0x6FCA5F8ED9AEF3BBuLL, 0xDE469FBD99A05FE3uLL },  // 1e164
+    { 0x25DE7BB9480D5854uLL, 0x8AEC23D680043BEEuLL },  // 1e165
+    { 0xAF561AA79A10AE6AuLL, 0xADA72CCC20054AE9uLL },  // 1e166
+    { 0x1B2BA1518094DA04uLL, 0xD910F7FF28069DA4uLL },  // 1e167
+    { 0x90FB44D2F05D0842uLL, 0x87AA9AFF79042286uLL },  // 1e168
+    { 0x353A1607AC744A53uLL, 0xA99541BF57452B28uLL },  // 1e169
+    { 0x42889B8997915CE8uLL, 0xD3FA922F2D1675F2uLL },  // 1e170
+    { 0x69956135FEBADA11uLL, 0x847C9B5D7C2E09B7uLL },  // 1e171
+    { 0x43FAB9837E699095uLL, 0xA59BC234DB398C25uLL },  // 1e172
+    { 0x94F967E45E03F4BBuLL, 0xCF02B2C21207EF2EuLL },  // 1e173
+    { 0x1D1BE0EEBAC278F5uLL, 0x8161AFB94B44F57DuLL },  // 1e174
+    { 0x6462D92A69731732uLL, 0xA1BA1BA79E1632DCuLL },  // 1e175
+    { 0x7D7B8F7503CFDCFEuLL, 0xCA28A291859BBF93uLL },  // 1e176
+    { 0x5CDA735244C3D43EuLL, 0xFCB2CB35E702AF78uLL },  // 1e177
+    { 0x3A0888136AFA64A7uLL, 0x9DEFBF01B061ADABuLL },  // 1e178
+    { 0x088AAA1845B8FDD0uLL, 0xC56BAEC21C7A1916uLL },  // 1e179
+    { 0x8AAD549E57273D45uLL, 0xF6C69A72A3989F5BuLL },  // 1e180
+    { 0x36AC54E2F678864BuLL, 0x9A3C2087A63F6399uLL },  // 1e181
+    { 0x84576A1BB416A7DDuLL, 0xC0CB28A98FCF3C7FuLL },  // 1e182
+    { 0x656D44A2A11C51D5uLL, 0xF0FDF2D3F3C30B9FuLL },  // 1e183
+    { 0x9F644AE5A4B1B325uLL, 0x969EB7C47859E743uLL },  // 1e184
+    { 0x873D5D9F0DDE1FEEuLL, 0xBC4665B596706114uLL },  // 1e185
+    { 0xA90CB506D155A7EAuLL, 0xEB57FF22FC0C7959uLL },  // 1e186
+    { 0x09A7F12442D588F2uLL, 0x9316FF75DD87CBD8uLL },  // 1e187
+    { 0x0C11ED6D538AEB2FuLL, 0xB7DCBF5354E9BECEuLL },  // 1e188
+    { 0x8F1668C8A86DA5FAuLL, 0xE5D3EF282A242E81uLL },  // 1e189
+    { 0xF96E017D694487BCuLL, 0x8FA475791A569D10uLL },  // 1e190
+    { 0x37C981DCC395A9ACuLL, 0xB38D92D760EC4455uLL },  // 1e191
+    { 0x85BBE253F47B1417uLL, 0xE070F78D3927556AuLL },  // 1e192
+    { 0x93956D7478CCEC8EuLL, 0x8C469AB843B89562uLL },  // 1e193
+    { 0x387AC8D1970027B2uLL, 0xAF58416654A6BABBuLL },  // 1e194
+    { 0x06997B05FCC0319EuLL, 0xDB2E51BFE9D0696AuLL },  // 1e195
+    { 0x441FECE3BDF81F03uLL, 0x88FCF317F22241E2uLL },  // 1e196
+    { 0xD527E81CAD7626C3uLL, 0xAB3C2FDDEEAAD25AuLL },  // 1e197
+    { 0x8A71E223D8D3B074uLL, 0xD60B3BD56A5586F1uLL },  // 1e198
+    { 0xF6872D5667844E49uLL, 0x85C7056562757456uLL },  // 1e199
+    { 0xB428F8AC016561DBuLL, 0xA738C6BEBB12D16CuLL },  // 1e200
+    { 0xE13336D701BEBA52uLL, 0xD106F86E69D785C7uLL },  // 1e201
+    { 0xECC0024661173473uLL, 0x82A45B450226B39CuLL },  // 1e202
+    { 0x27F002D7F95D0190uLL, 0xA34D721642B06084uLL },  // 1e203
+    { 0x31EC038DF7B441F4uLL, 0xCC20CE9BD35C78A5uLL },  // 1e204
+    { 0x7E67047175A15271uLL, 0xFF290242C83396CEuLL },  // 1e205
+    { 0x0F0062C6E984D386uLL, 0x9F79A169BD203E41uLL },  // 1e206
+    { 0x52C07B78A3E60868uLL, 0xC75809C42C684DD1uLL },  // 1e207
+    { 0xA7709A56CCDF8A82uLL, 0xF92E0C3537826145uLL },  // 1e208
+    { 0x88A66076400BB691uLL, 0x9BBCC7A142B17CCBuLL },  // 1e209
+    { 0x6ACFF893D00EA435uLL, 0xC2ABF989935DDBFEuLL },  // 1e210
+    { 0x0583F6B8C4124D43uLL, 0xF356F7EBF83552FEuLL },  // 1e211
+    { 0xC3727A337A8B704AuLL, 0x98165AF37B2153DEuLL },  // 1e212
+    { 0x744F18C0592E4C5CuLL, 0xBE1BF1B059E9A8D6uLL },  // 1e213
+    { 0x1162DEF06F79DF73uLL, 0xEDA2EE1C7064130CuLL },  // 1e214
+    { 0x8ADDCB5645AC2BA8uLL, 0x9485D4D1C63E8BE7uLL },  // 1e215
+    { 0x6D953E2BD7173692uLL, 0xB9A74A0637CE2EE1uLL },  // 1e216
+    { 0xC8FA8DB6CCDD0437uLL, 0xE8111C87C5C1BA99uLL },  // 1e217
+    { 0x1D9C9892400A22A2uLL, 0x910AB1D4DB9914A0uLL },  // 1e218
+    { 0x2503BEB6D00CAB4BuLL, 0xB54D5E4A127F59C8uLL },  // 1e219
+    { 0x2E44AE64840FD61DuLL, 0xE2A0B5DC971F303AuLL },  // 1e220
+    { 0x5CEAECFED289E5D2uLL, 0x8DA471A9DE737E24uLL },  // 1e221
+    { 0x7425A83E872C5F47uLL, 0xB10D8E1456105DADuLL },  // 1e222
+    { 0xD12F124E28F77719uLL, 0xDD50F1996B947518uLL },  // 1e223
+    { 0x82BD6B70D99AAA6FuLL, 0x8A5296FFE33CC92FuLL },  // 1e224
+    { 0x636CC64D1001550BuLL, 0xACE73CBFDC0BFB7BuLL },  // 1e225
+    { 0x3C47F7E05401AA4EuLL, 0xD8210BEFD30EFA5AuLL },  // 1e226
+    { 0x65ACFAEC34810A71uLL, 0x8714A775E3E95C78uLL },  // 1e227
+    { 0x7F1839A741A14D0DuLL, 0xA8D9D1535CE3B396uLL },  // 1e228
+    { 0x1EDE48111209A050uLL, 0xD31045A8341CA07CuLL },  // 1e229
+    { 0x934AED0AAB460432uLL, 0x83EA2B892091E44DuLL },  // 1e230
+    { 0xF81DA84D5617853FuLL, 0xA4E4B66B68B65D60uLL },  // 1e231
+    { 0x36251260AB9D668EuLL, 0xCE1DE40642E3F4B9uLL },  // 1e232
+    { 0xC1D72B7C6B426019uLL, 0x80D2AE83E9CE78F3uLL },  // 1e233
+    { 0xB24CF65B8612F81FuLL, 0xA1075A24E4421730uLL },  // 1e234
+    { 0xDEE033F26797B627uLL, 0xC94930AE1D529CFCuLL },  // 1e235
+    { 0x169840EF017DA3B1uLL, 0xFB9B7CD9A4A7443CuLL },  // 1e236
+    { 0x8E1F289560EE864EuLL, 0x9D412E0806E88AA5uLL },  // 1e237
+    { 0xF1A6F2BAB92A27E2uLL, 0xC491798A08A2AD4EuLL },  // 1e238
+    { 0xAE10AF696774B1DBuLL, 0xF5B5D7EC8ACB58A2uLL },  // 1e239
+    { 0xACCA6DA1E0A8EF29uLL, 0x9991A6F3D6BF1765uLL },  // 1e240
+    { 0x17FD090A58D32AF3uLL, 0xBFF610B0CC6EDD3FuLL },  // 1e241
+    { 0xDDFC4B4CEF07F5B0uLL, 0xEFF394DCFF8A948EuLL },  // 1e242
+    { 0x4ABDAF101564F98EuLL, 0x95F83D0A1FB69CD9uLL },  // 1e243
+    { 0x9D6D1AD41ABE37F1uLL, 0xBB764C4CA7A4440FuLL },  // 1e244
+    { 0x84C86189216DC5EDuLL, 0xEA53DF5FD18D5513uLL },  // 1e245
+    { 0x32FD3CF5B4E49BB4uLL, 0x92746B9BE2F8552CuLL },  // 1e246
+    { 0x3FBC8C33221DC2A1uLL, 0xB7118682DBB66A77uLL },  // 1e247
+    { 0x0FABAF3FEAA5334AuLL, 0xE4D5E82392A40515uLL },  // 1e248
+    { 0x29CB4D87F2A7400EuLL, 0x8F05B1163BA6832DuLL },  // 1e249
+    { 0x743E20E9EF511012uLL, 0xB2C71D5BCA9023F8uLL },  // 1e250
+    { 0x914DA9246B255416uLL, 0xDF78E4B2BD342CF6uLL },  // 1e251
+    { 0x1AD089B6C2F7548EuLL, 0x8BAB8EEFB6409C1AuLL },  // 1e252
+    { 0xA184AC2473B529B1uLL, 0xAE9672ABA3D0C320uLL },  // 1e253
+    { 0xC9E5D72D90A2741EuLL, 0xDA3C0F568CC4F3E8uLL },  // 1e254
+    { 0x7E2FA67C7A658892uLL, 0x8865899617FB1871uLL },  // 1e255
+    { 0xDDBB901B98FEEAB7uLL, 0xAA7EEBFB9DF9DE8DuLL },  // 1e256
+    { 0x552A74227F3EA565uLL, 0xD51EA6FA85785631uLL },  // 1e257
+    { 0xD53A88958F87275FuLL, 0x8533285C936B35DEuLL },  // 1e258
+    { 0x8A892ABAF368F137uLL, 0xA67FF273B8460356uLL },  // 1e259
+    { 0x2D2B7569B0432D85uLL, 0xD01FEF10A657842CuLL },  // 1e260
+    { 0x9C3B29620E29FC73uLL, 0x8213F56A67F6B29BuLL },  // 1e261
+    { 0x8349F3BA91B47B8FuLL, 0xA298F2C501F45F42uLL },  // 1e262
+    { 0x241C70A936219A73uLL, 0xCB3F2F7642717713uLL },  // 1e263
+    { 0xED238CD383AA0110uLL, 0xFE0EFB53D30DD4D7uLL },  // 1e264
+    { 0xF4363804324A40AAuLL, 0x9EC95D1463E8A506uLL },  // 1e265
+    { 0xB143C6053EDCD0D5uLL, 0xC67BB4597CE2CE48uLL },  // 1e266
+    { 0xDD94B7868E94050AuLL, 0xF81AA16FDC1B81DAuLL },  // 1e267
+    { 0xCA7CF2B4191C8326uLL, 0x9B10A4E5E9913128uLL },  // 1e268
+    { 0xFD1C2F611F63A3F0uLL, 0xC1D4CE1F63F57D72uLL },  // 1e269
+    { 0xBC633B39673C8CECuLL, 0xF24A01A73CF2DCCFuLL },  // 1e270
+    { 0xD5BE0503E085D813uLL, 0x976E41088617CA01uLL },  // 1e271
+    { 0x4B2D8644D8A74E18uLL, 0xBD49D14AA79DBC82uLL },  // 1e272
+    { 0xDDF8E7D60ED1219EuLL, 0xEC9C459D51852BA2uLL },  // 1e273
+    { 0xCABB90E5C942B503uLL, 0x93E1AB8252F33B45uLL },  // 1e274
+    { 0x3D6A751F3B936243uLL, 0xB8DA1662E7B00A17uLL },  // 1e275
+    { 0x0CC512670A783AD4uLL, 0xE7109BFBA19C0C9DuLL },  // 1e276
+    { 0x27FB2B80668B24C5uLL, 0x906A617D450187E2uLL },  // 1e277
+    { 0xB1F9F660802DEDF6uLL, 0xB484F9DC9641E9DAuLL },  // 1e278
+    { 0x5E7873F8A0396973uLL, 0xE1A63853BBD26451uLL },  // 1e279
+    { 0xDB0B487B6423E1E8uLL, 0x8D07E33455637EB2uLL },  // 1e280
+    { 0x91CE1A9A3D2CDA62uLL, 0xB049DC016ABC5E5FuLL },  // 1e281
+    { 0x7641A140CC7810FBuLL, 0xDC5C5301C56B75F7uLL },  // 1e282
+    { 0xA9E904C87FCB0A9DuLL, 0x89B9B3E11B6329BAuLL },  // 1e283
+    { 0x546345FA9FBDCD44uLL, 0xAC2820D9623BF429uLL },  // 1e284
+    { 0xA97C177947AD4095uLL, 0xD732290FBACAF133uLL },  // 1e285
+    { 0x49ED8EABCCCC485DuLL, 0x867F59A9D4BED6C0uLL },  // 1e286
+    { 0x5C68F256BFFF5A74uLL, 0xA81F301449EE8C70uLL },  // 1e287
+    { 0x73832EEC6FFF3111uLL, 0xD226FC195C6A2F8CuLL },  // 1e288
+    { 0xC831FD53C5FF7EABuLL, 0x83585D8FD9C25DB7uLL },  // 1e289
+    { 0xBA3E7CA8B77F5E55uLL, 0xA42E74F3D032F525uLL },  // 1e290
+    { 0x28CE1BD2E55F35EBuLL, 0xCD3A1230C43FB26FuLL },  // 1e291
+    { 0x7980D163CF5B81B3uLL, 0x80444B5E7AA7CF85uLL },  // 1e292
+    { 0xD7E105BCC332621FuLL, 0xA0555E361951C366uLL },  // 1e293
+    { 0x8DD9472BF3FEFAA7uLL, 0xC86AB5C39FA63440uLL },  // 1e294
+    { 0xB14F98F6F0FEB951uLL, 0xFA856334878FC150uLL },  // 1e295
+    { 0x6ED1BF9A569F33D3uLL, 0x9C935E00D4B9D8D2uLL },  // 1e296
+    { 0x0A862F80EC4700C8uLL, 0xC3B8358109E84F07uLL },  // 1e297
+    { 0xCD27BB612758C0FAuLL, 0xF4A642E14C6262C8uLL },  // 1e298
+    { 0x8038D51CB897789CuLL, 0x98E7E9CCCFBD7DBDuLL },  // 1e299
+    { 0xE0470A63E6BD56C3uLL, 0xBF21E44003ACDD2CuLL },  // 1e300
+    { 0x1858CCFCE06CAC74uLL, 0xEEEA5D5004981478uLL },  // 1e301
+    { 0x0F37801E0C43EBC8uLL, 0x95527A5202DF0CCBuLL },  // 1e302
+    { 0xD30560258F54E6BAuLL, 0xBAA718E68396CFFDuLL },  // 1e303
+    { 0x47C6B82EF32A2069uLL, 0xE950DF20247C83FDuLL },  // 1e304
+    { 0x4CDC331D57FA5441uLL, 0x91D28B7416CDD27EuLL },  // 1e305
+    { 0xE0133FE4ADF8E952uLL, 0xB6472E511C81471DuLL },  // 1e306
+    { 0x58180FDDD97723A6uLL, 0xE3D8F9E563A198E5uLL },  // 1e307
+    { 0x570F09EAA7EA7648uLL, 0x8E679C2F5E44FF8FuLL },  // 1e308
+    { 0x2CD2CC6551E513DAuLL, 0xB201833B35D63F73uLL },  // 1e309
+    { 0xF8077F7EA65E58D1uLL, 0xDE81E40A034BCF4FuLL },  // 1e310
+    { 0xFB04AFAF27FAF782uLL, 0x8B112E86420F6191uLL },  // 1e311
+    { 0x79C5DB9AF1F9B563uLL, 0xADD57A27D29339F6uLL },  // 1e312
+    { 0x18375281AE7822BCuLL, 0xD94AD8B1C7380874uLL },  // 1e313
+    { 0x8F2293910D0B15B5uLL, 0x87CEC76F1C830548uLL },  // 1e314
+    { 0xB2EB3875504DDB22uLL, 0xA9C2794AE3A3C69AuLL },  // 1e315
+    { 0x5FA60692A46151EBuLL, 0xD433179D9C8CB841uLL },  // 1e316
+    { 0xDBC7C41BA6BCD333uLL, 0x849FEEC281D7F328uLL },  // 1e317
+    { 0x12B9B522906C0800uLL, 0xA5C7EA73224DEFF3uLL },  // 1e318
+    { 0xD768226B34870A00uLL, 0xCF39E50FEAE16BEFuLL },  // 1e319
+    { 0xE6A1158300D46640uLL, 0x81842F29F2CCE375uLL },  // 1e320
+    { 0x60495AE3C1097FD0uLL, 0xA1E53AF46F801C53uLL },  // 1e321
+    { 0x385BB19CB14BDFC4uLL, 0xCA5E89B18B602368uLL },  // 1e322
+    { 0x46729E03DD9ED7B5uLL, 0xFCF62C1DEE382C42uLL },  // 1e323
+    { 0x6C07A2C26A8346D1uLL, 0x9E19DB92B4E31BA9uLL },  // 1e324
+    { 0xC7098B7305241885uLL, 0xC5A05277621BE293uLL },  // 1e325
+    { 0xB8CBEE4FC66D1EA7uLL, 0xF70867153AA2DB38uLL },  // 1e326
+    { 0x737F74F1DC043328uLL, 0x9A65406D44A5C903uLL },  // 1e327
+    { 0x505F522E53053FF2uLL, 0xC0FE908895CF3B44uLL },  // 1e328
+    { 0x647726B9E7C68FEFuLL, 0xF13E34AABB430A15uLL },  // 1e329
+    { 0x5ECA783430DC19F5uLL, 0x96C6E0EAB509E64DuLL },  // 1e330
+    { 0xB67D16413D132072uLL, 0xBC789925624C5FE0uLL },  // 1e331
+    { 0xE41C5BD18C57E88FuLL, 0xEB96BF6EBADF77D8uLL },  // 1e332
+    { 0x8E91B962F7B6F159uLL, 0x933E37A534CBAAE7uLL },  // 1e333
+    { 0x723627BBB5A4ADB0uLL, 0xB80DC58E81FE95A1uLL },  // 1e334
+    { 0xCEC3B1AAA30DD91CuLL, 0xE61136F2227E3B09uLL },  // 1e335
+    { 0x213A4F0AA5E8A7B1uLL, 0x8FCAC257558EE4E6uLL },  // 1e336
+    { 0xA988E2CD4F62D19DuLL, 0xB3BD72ED2AF29E1FuLL },  // 1e337
+    { 0x93EB1B80A33B8605uLL, 0xE0ACCFA875AF45A7uLL },  // 1e338
+    { 0xBC72F130660533C3uLL, 0x8C6C01C9498D8B88uLL },  // 1e339
+    { 0xEB8FAD7C7F8680B4uLL, 0xAF87023B9BF0EE6AuLL },  // 1e340
+    { 0xA67398DB9F6820E1uLL, 0xDB68C2CA82ED2A05uLL },  // 1e341
+    { 0x88083F8943A1148CuLL, 0x892179BE91D43A43uLL },  // 1e342
+    { 0x6A0A4F6B948959B0uLL, 0xAB69D82E364948D4uLL },  // 1e343
+    { 0x848CE34679ABB01CuLL, 0xD6444E39C3DB9B09uLL },  // 1e344
+    { 0xF2D80E0C0C0B4E11uLL, 0x85EAB0E41A6940E5uLL },  // 1e345
+    { 0x6F8E118F0F0E2195uLL, 0xA7655D1D2103911FuLL },  // 1e346
+    { 0x4B7195F2D2D1A9FBuLL, 0xD13EB46469447567uLL },  // 1e347
+};
+
+inline
+void multiply128(Uint64 *high, Uint64 *low, Uint64 lhs, Uint64 rhs)
+    // Load into the specified 'high' and 'low' the upper and lower 64 bits,
+    // respectively, of the exact product of the specified 'lhs' and 'rhs'.
+{
+#if defined(__SIZEOF_INT128__)
+    const unsigned __int128 product =
+                                  static_cast<unsigned __int128>(lhs) * rhs;
+    *high = static_cast<Uint64>(product >> 64);
+    *low  = static_cast<Uint64>(product);
+#else
+    const Uint64 k_MASK32 = 0xFFFFFFFFULL;
+
+    const Uint64 a = lhs >> 32;
+    const Uint64 b = lhs & k_MASK32;
+    const Uint64 c = rhs >> 32;
+    const Uint64 d = rhs & k_MASK32;
+
+    const Uint64 ac = a * c;
+    const Uint64 bc = b * c;
+    const Uint64 ad = a * d;
+    const Uint64 bd = b * d;
+
+    const Uint64 middle = (bd >> 32) + (ad & k_MASK32) + (bc & k_MASK32);
+
+    *high = ac + (ad >> 32) + (bc >> 32) + (middle >> 32);
+    *low  = (middle << 32) | (bd & k_MASK32);
+#endif
+}
+
+inline
+int floorLog2PowerOfTen(int exponent)
+    // Return 'floor(log2(10^exponent))'.  The behavior is undefined unless
+    // '-1233 <= exponent <= 1232'.  Note that '217706 / 2^16' approximates
+    // 'log2(10)' closely enough over that range.
+{
+    return exponent >= 0 ?   (217706 * exponent) >> 16
+                         : -((-217706 * exponent + 65535) >> 16);
+}
+
+bool eiselLemire(double *result,
+                 Uint64  significand,
+                 int     exponent,
+                 bool    isNegative)
+    // Load into the specified 'result' the 'double' value nearest to
+    // 'significand * 10^exponent', for the specified 'significand' and
+    // 'exponent', negated if the specified 'isNegative' is 'true', and return
+    // 'true', if that value is a normal, finite number that can be determined
+    // exactly from a 128-bit approximation of '10^exponent'; otherwise return
+    // 'false' with no effect on 'result'.  The behavior is undefined unless
+    // '0 != significand'.  See "Number Parsing at a Gigabyte per Second",
+    // Daniel Lemire, Software: Practice and Experience 51(8), 2021.
+{
+    BSLS_ASSERT(0 != significand);
+
+    if (exponent < k_MIN_POWER_OF_TEN || k_MAX_POWER_OF_TEN < exponent) {
+        return false;                                                 // RETURN
+    }
+
+    const Uint64 *power = s_powersOfTen[exponent - k_MIN_POWER_OF_TEN];
+
+    // Normalize the significand so that its most significant bit is set.
+
+    const int leadingZeros = BitUtil::numLeadingUnsetBits(
+                                      static_cast<bsl::uint64_t>(significand));
+    significand <<= leadingZeros;
+
+    int binaryExponent = floorLog2PowerOfTen(exponent) - leadingZeros
+                                                       + 64 + 1023;
+
+    // Multiply by the high half of the power of ten.  If the lower bits of
+    // the product are all set, the truncated low half of the power might
+    // affect the result, so include it.
+
+    Uint64 high, low;
+    multiply128(&high, &low, significand, power[1]);
+
+    if (0x1FF == (high & 0x1FF) && low + significand < low) {
+        Uint64 nextHigh, nextLow;
+        multiply128(&nextHigh, &nextLow, significand, power[0]);
+
+        Uint64 mergedHigh = high;
+        Uint64 mergedLow  = low + nextHigh;
+        if (mergedLow < low) {
+            ++mergedHigh;
+        }
+        if (0x1FF == (mergedHigh & 0x1FF)
+         && ~0ULL == mergedLow
+         && nextLow + significand < nextLow) {
+            return false;                                             // RETURN
+        }
+        high = mergedHigh;
+        low  = mergedLow;
+    }
+
+    // Keep the top 54 bits, then round to 53 bits.  An exact tie cannot be
+    // resolved from the approximation.
+
+    const int msb = static_cast<int>(high >> 63);
+    Uint64    mantissa = high >> (msb + 9);
+    binaryExponent -= 1 ^ msb;
+
+    if (0 == low && 0 == (high & 0x1FF) && 1 == (mantissa & 3)) {
+        return false;                                                 // RETURN
+    }
+
+    mantissa += mantissa & 1;
+    mantissa >>= 1;
+    if (mantissa >> 53) {
+        mantissa >>= 1;
+        ++binaryExponent;
+    }
+
+    if (binaryExponent <= 0 || 0x7FF <= binaryExponent) {
+        // Subnormal, zero, or infinite: leave these to the exact algorithm.
+
+        return false;                                                 // RETURN
+    }
+
+    Uint64 bits = static_cast<Uint64>(binaryExponent) << 52
+                | (mantissa & 0x000FFFFFFFFFFFFFULL);
+    if (isNegative) {
+        bits |= 0x8000000000000000ULL;
+    }
+
+    bsl::memcpy(result, &bits, sizeof *result);
+    return true;
+}
+
+bool parseDecimalDouble(double     *result,
+                        size_type  *numParsed,
+                        const char *begin,
+                        const char *end)
+    // Parse the (non-empty) character range '[begin, end)', specified by
+    // 'begin' and 'end', as the longest prefix matching the production rule
+    // <REAL> (see {GRAMMAR PRODUCTION RULES}) and, if its value can be
+    // determined without resorting to arbitrary-precision arithmetic, load
+    // that value into the specified 'result', load the length of the prefix
+    // into the specified 'numParsed', and return 'true'.  Otherwise, return
+    // 'false' with no effect on 'result' and 'numParsed'; this is the case for
+    // infinities, NaNs, hexadecimal numbers, numbers having more than 19
+    // significant digits, values that overflow or are subnormal, rare
+    // inputs very close to the midpoint of two 'double' values, and invalid
+    // input.  The behavior is undefined unless 'begin < end'.
+{
+    const char *p = begin;
+
+    const bool isNegative = '-' == *p;
+    if (isNegative || '+' == *p) {
+        ++p;
+    }
+
+    if (end - p >= 2 && '0' == p[0] && ('x' == p[1] || 'X' == p[1])) {
+        return false;                                                 // RETURN
+    }
+
+    // Accumulate all digits of the significand, ignoring the decimal point.
+    // The accumulation may wrap around if there are more than 19 digits, in
+    // which case the value is discarded below.
+
+    Uint64 significand = 0;
+
+    const char *integerBegin = p;
+    while (end - p >= 8 && isEightDigits(loadEightCharacters(p))) {
+        significand = significand * 100000000
+                    + parseEightDigits(loadEightCharacters(p));
+        p += 8;
+    }
+    while (p != end && isDecimalDigit(*p)) {
+        significand = significand * 10 + (*p - '0');
+        ++p;
+    }
+    bsl::ptrdiff_t numDigits = p - integerBegin;
+
+    int exponent = 0;
+    if (p != end && '.' == *p) {
+        ++p;
+        const char *fractionBegin = p;
+        while (end - p >= 8 && isEightDigits(loadEightCharacters(p))) {
+            significand = significand * 100000000
+                        + parseEightDigits(loadEightCharacters(p));
+            p += 8;
+        }
+        while (p != end && isDecimalDigit(*p)) {
+            significand = significand * 10 + (*p - '0');
+            ++p;
+        }
+        if (p - fractionBegin > 0x10000) {
+            return false;                                             // RETURN
+        }
+        exponent   = -static_cast<int>(p - fractionBegin);
+        numDigits += p - fractionBegin;
+    }
+
+    if (0 == numDigits) {
+        return false;                                                 // RETURN
+    }
+
+    // An exponent is consumed only if it has at least one digit.
+
+    if (p != end && ('e' == *p || 'E' == *p)) {
+        const char *q = p + 1;
+
+        const bool isNegativeExponent = q != end && '-' == *q;
+        if (q != end && (isNegativeExponent || '+' == *q)) {
+            ++q;
+        }
+
+        if (q != end && isDecimalDigit(*q)) {
+            int explicitExponent = 0;
+            while (q != end && isDecimalDigit(*q)) {
+                if (explicitExponent < 0x10000) {
+                    explicitExponent = explicitExponent * 10 + (*q - '0');
+                }
+                ++q;
+            }
+            exponent += isNegativeExponent ? -explicitExponent
+                                           :  explicitExponent;
+            p = q;
+        }
+    }
+
+    if (numDigits > 19) {
+        // Leading zeros (in either part) are not significant.
+
+        for (const char *z = integerBegin;
+             z != p && ('0' == *z || '.' == *z);
+             ++z) {
+            if ('0' == *z) {
+                --numDigits;
+            }
+        }
+        if (numDigits > 19) {
+            return false;                                             // RETURN
+        }
+    }
+
+    double value;
+    if (0 == significand) {
+        value = isNegative ? -0.0 : 0.0;
+    }
+#if defined(BSLS_PLATFORM_CPU_64_BIT)
+    else if (significand <= (1ULL << 53)
+          && -22 <= exponent
+          && exponent <= 22) {
+        // Both 'significand' and '10^|exponent|' are exactly representable,
+        // so a single correctly rounded operation yields the result.  This is
+        // not done where 'double' arithmetic might use extended precision.
+
+        static const double k_POWERS[] = {
+            1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9, 1e10,
+            1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20,
+            1e21, 1e22
+        };
+
+        value = static_cast<double>(significand);
+        if (exponent < 0) {
+            value /= k_POWERS[-exponent];
+        }
+        else {
+            value *= k_POWERS[exponent];
+        }
+        if (isNegative) {
+            value = -value;
+        }
+    }
+#endif
+    else if (!eiselLemire(&value, significand, exponent, isNegative)) {
+        return false;                                                 // RETURN
+    }
+
+    *result    = value;
+    *numParsed = p - begin;
+    return true;
+}
+
 }  // close unnamed namespace
 
 
@@ -173,9 +1248,6 @@ static int parseNanAndInf(double            *result,
 
 #endif  // End of Microsoft Visual Studio 2013 and lower specific code
 
-typedef bsls::Types::Int64  Int64;
-typedef bsls::Types::Uint64 Uint64;
-
                           // -----------------------
                           // struct NumericParseUtil
                           // -----------------------
@@ -223,6 +1295,22 @@ int NumericParseUtil::parseDouble(double                   *result,
         return -2;                                                    // RETURN
     }
 
+    // Most inputs are resolved without copying the input or calling 'strtod';
+    // the remaining ones (see 'parseDecimalDouble') are handled by the
+    // correctly rounding, but much slower, C library.
+
+    double    value;
+    size_type numParsed;
+    if (parseDecimalDouble(&value,
+                           &numParsed,
+                           inputString.data(),
+                           inputString.data() + inputString.length())) {
+        *result = value;
+        remainder->assign(inputString.data() + numParsed,
+                          inputString.length() - numParsed);
+        return 0;                                                     // RETURN
+    }
+
     static const size_type k_BUFFER_SIZE = 128;
 
     const bool             useLocalBuffer =
@@ -513,6 +1601,14 @@ int NumericParseUtil::parseUnsignedInteger(
     }
 
     size_type i = 0;
+    if (10 == base) {
+        i     = parseDecimalDigitGroups(&res,
+                                        inputString.data(),
+                                        length,
+                                        maxValue);
+        digit = i < length ? characterToDigit(inputString[i], base) : -1;
+    }
+
     while (-1 != digit) {
         if (res < maxCheck) {
             res = res * base + digit;
@@ -563,6 +1659,21 @@ int NumericParseUtil::parseUnsignedInteger(
     }
 
     size_type i = 0;
+    if (10 == base) {
+        const size_type maxNumCharacters =
+                         length < static_cast<size_type>(maxNumDigits)
+                         ? length
+                         : static_cast<size_type>(maxNumDigits);
+
+        i             = parseDecimalDigitGroups(&res,
+                                                inputString.data(),
+                                                maxNumCharacters,
+                                                maxValue);
+        maxNumDigits -= static_cast<int>(i);
+        digit         = i < length ? characterToDigit(inputString[i], base)
+                                   : -1;
+    }
+
     while (-1 != digit && maxNumDigits--) {
         if (res < maxCheck) {
             res = res * base + digit;
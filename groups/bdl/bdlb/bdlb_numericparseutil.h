@@ -97,6 +97,23 @@ BSLS_IDENT("$Id: $")
 // the standard library function 'strtod'.  For example, the ASCII string
 // "3.14159" is converted, on some platforms, to 3.1415899999999999.
 //
+// 'parseDouble' resolves most inputs without calling 'strtod': decimal
+// numbers having at most 19 significant digits and a normal result are
+// converted directly, either exactly (when both the significand and the power
+// of ten are exactly representable) or using the algorithm of Eisel and
+// Lemire, which determines the correctly rounded result from a 128-bit
+// approximation of the power of ten, or reports that it cannot.  All other
+// input (including input for which the algorithm cannot decide, which is
+// exceedingly rare) is handed to 'strtod'.  The result and remainder are the
+// same in either case.
+//
+///Performance of Decimal Integer Parsing
+///--------------------------------------
+// When parsing base-10 input, runs of eight or more digits are consumed eight
+// digits at a time, as long as doing so cannot exceed the maximum value
+// allowed; the remaining digits are consumed one at a time.  This does not
+// affect the result or the remainder.
+//
 ///Special Floating Point Values
 ///- - - - - - - - - - - - - - -
 // The IEEE-754 (double precision) floating point format supports the following
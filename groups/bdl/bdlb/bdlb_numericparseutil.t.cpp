@@ -6,6 +6,7 @@
 #include <bslma_testallocator.h>           // for testing only
 
 #include <bsls_platform.h>
+#include <bsls_stopwatch.h>
 #include <bsls_types.h>
 
 #include <bslim_testutil.h>
@@ -22,6 +23,7 @@
 #include <bsl_climits.h>
 #include <bsl_limits.h>
 
+#include <bsl_c_stdio.h>
 #include <bsl_c_stdlib.h>
 
 #include <math.h>
@@ -73,7 +75,10 @@ using namespace bdlb;
 // [10] parseUshort(result, rest, input, base = 10)
 // [10] parseUshort(result, input, base = 10)
 //-----------------------------------------------------------------------------
-// [11] USAGE EXAMPLE
+// [11] CONCERN: 'parseDouble' is correctly rounded
+// [12] CONCERN: base-10 digits are consumed correctly in groups
+// [13] USAGE EXAMPLE
+// [-1] BENCHMARK: PARSING NUMERIC CORPORA
 
 // ============================================================================
 //                     STANDARD BSL ASSERT TEST FUNCTION
@@ -145,6 +150,107 @@ int doubleSign(double number)
     return bytes[pos] & 0x80;
 }
 
+static
+Uint64 nextRandom(Uint64 *state)
+    // Advance the specified 'state' of a 64-bit linear congruential generator
+    // and return a value derived from its new state.
+{
+    *state = *state * 6364136223846793005ULL + 1442695040888963407ULL;
+    return *state ^ (*state >> 29);
+}
+
+static
+double randomDouble(Uint64 *state)
+    // Return a finite 'double' value having uniformly distributed bits, using
+    // the specified 'state' as the source of randomness.
+{
+    double result;
+    do {
+        const Uint64 bits = nextRandom(state);
+        memcpy(&result, &bits, sizeof result);
+    } while (result != result || result - result != 0);
+    return result;
+}
+
+static
+void verifyParseDouble(int line, const bsl::string& input)
+    // Verify that 'NumericParseUtil::parseDouble' produces, for the specified
+    // 'input', the same value and remainder as 'strtod', reporting failures
+    // using the specified 'line'.
+{
+    char         *end;
+    const double  expected = strtod(input.c_str(), &end);
+    const ptrdiff_t expectedOffset = end - input.c_str();
+
+    double    result = 37.0;
+    bslstl::StringRef remainder;
+    const int rv = NumericParseUtil::parseDouble(&result,
+                                                 &remainder,
+                                                 input);
+
+    if (0 == expectedOffset) {
+        ASSERTV(line, input, rv, 0 != rv);
+        ASSERTV(line, input, result, 37.0 == result);
+        return;                                                       // RETURN
+    }
+
+    ASSERTV(line, input, rv, 0 == rv);
+    ASSERTV(line,
+            input,
+            expectedOffset,
+            remainder.data() - input.data(),
+            input.data() + expectedOffset == remainder.data());
+    ASSERTV(line,
+            input,
+            input.length() - expectedOffset == remainder.length());
+
+    if (expected != expected) {
+        ASSERTV(line, input, result, result != result);
+    }
+    else {
+        ASSERTV(line,
+                input,
+                expected,
+                result,
+                0 == memcmp(&expected, &result, sizeof result));
+    }
+}
+
+static
+bool referenceParseUnsigned(Uint64            *result,
+                            bsl::size_t       *numParsed,
+                            const bsl::string& input,
+                            bsl::size_t        position,
+                            Uint64             maxValue,
+                            int                maxNumDigits)
+    // Load into the specified 'result' the value of the longest sequence of
+    // at most the specified 'maxNumDigits' decimal digits starting at the
+    // specified 'position' of the specified 'input' whose value does not
+    // exceed the specified 'maxValue', load into the specified 'numParsed'
+    // the number of digits in that sequence, and return 'true'; return
+    // 'false' if there is no digit at 'position'.  This is a straightforward
+    // reference implementation of the rules of 'parseUnsignedInteger'.
+{
+    Uint64      value = 0;
+    bsl::size_t i     = position;
+    while (i < input.length()
+        && static_cast<int>(i - position) < maxNumDigits
+        && '0' <= input[i] && input[i] <= '9') {
+        const unsigned digit = input[i] - '0';
+        if (value > (maxValue - digit) / 10) {
+            break;                                                     // BREAK
+        }
+        value = value * 10 + digit;
+        ++i;
+    }
+    if (i == position) {
+        return false;                                                 // RETURN
+    }
+    *result    = value;
+    *numParsed = i - position;
+    return true;
+}
+
 //=============================================================================
 //                              MAIN PROGRAM
 //-----------------------------------------------------------------------------
@@ -163,7 +269,7 @@ int main(int argc, char *argv[])
     using bslstl::StringRef;
 
     switch (test) { case 0:  // Zero is always the leading case.
-      case 11: {
+      case 13: {
         // --------------------------------------------------------------------
         // TESTING USAGE EXAMPLE
         //
@@ -209,6 +315,367 @@ int main(int argc, char *argv[])
 //..
 
       } break;
+      case 12: {
+        // --------------------------------------------------------------------
+        // TESTING DECIMAL FAST PATH OF INTEGER PARSING
+        //
+        // Concerns:
+        //: 1 Base-10 input containing runs of eight or more digits, which are
+        //:   consumed eight at a time, is parsed to the same value and
+        //:   remainder as when consumed one digit at a time.
+        //:
+        //: 2 A run of digits ending, or a value overflowing, at any position
+        //:   within a group of eight is handled correctly.
+        //:
+        //: 3 Characters adjacent to the digits '0' and '9' in the character
+        //:   set terminate the digits.
+        //:
+        //: 4 'maxNumDigits' limits the number of digits consumed.
+        //
+        // Plan:
+        //: 1 Generate strings having a random sign, a random number (up to
+        //:   40) of random digits, optionally biased to leading zeros or to
+        //:   the largest digits, followed by a random suffix that includes
+        //:   '/' and ':'.  Compare the results of 'parseInt', 'parseInt64',
+        //:   'parseUint', 'parseUint64', and 'parseUnsignedInteger' (with
+        //:   and without 'maxNumDigits') against a simple reference
+        //:   implementation.  (C-1..4)
+        //
+        // Testing:
+        //   CONCERN: base-10 digits are consumed correctly in groups
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "TESTING DECIMAL FAST PATH OF INTEGER PARSING"
+                          << endl
+                          << "============================================"
+                          << endl;
+
+        const Uint64 k_INT64_MAX  = 0x7FFFFFFFFFFFFFFFULL;
+        const Uint64 k_UINT64_MAX = 0xFFFFFFFFFFFFFFFFULL;
+
+        static const char SUFFIXES[] = { '\0', '/', ':', 'x', '.', ' ' };
+        const int NUM_SUFFIXES = sizeof SUFFIXES / sizeof *SUFFIXES;
+
+        Uint64 state = 1;
+        for (int ti = 0; ti < 200000; ++ti) {
+            bsl::string input;
+
+            const Uint64 r = nextRandom(&state);
+            if (0 == r % 3) {
+                input += (r >> 2) % 2 ? '-' : '+';
+            }
+            const bsl::size_t position = input.length();
+
+            const int length = static_cast<int>((r >> 8) % 41);
+            const int style  = static_cast<int>((r >> 16) % 4);
+            for (int i = 0; i < length; ++i) {
+                const int d = static_cast<int>(nextRandom(&state) % 10);
+                const char c = 1 == style && i < length / 2
+                             ? '0'
+                             : static_cast<char>(2 == style ? '9' - d % 2
+                                                            : '0' + d);
+                input += c;
+            }
+            const char suffix = SUFFIXES[(r >> 24) % NUM_SUFFIXES];
+            if (suffix) {
+                input += suffix;
+                input += "123456789";
+            }
+
+            const bool   isNegative   = position && '-' == input[0];
+            const int    maxNumDigits = static_cast<int>((r >> 32) % 30);
+
+            Uint64      EXP;
+            bsl::size_t NUM;
+            bool        valid;
+
+            // 'parseUint64' and 'parseUnsignedInteger'
+
+            if (!isNegative) {
+                valid = referenceParseUnsigned(&EXP,
+                                               &NUM,
+                                               input,
+                                               position,
+                                               k_UINT64_MAX,
+                                               INT_MAX);
+
+                Uint64            result = 7;
+                bslstl::StringRef rest;
+                int rv = NumericParseUtil::parseUint64(&result, &rest, input);
+                ASSERTV(input, rv, valid == (0 == rv));
+                if (valid) {
+                    ASSERTV(input, EXP, result, EXP == result);
+                    ASSERTV(input, NUM, rest.length(),
+                            input.length() - position - NUM == rest.length());
+                }
+
+                unsigned int result32 = 7;
+                rv = NumericParseUtil::parseUint(&result32, &rest, input);
+                valid = referenceParseUnsigned(&EXP,
+                                               &NUM,
+                                               input,
+                                               position,
+                                               0xFFFFFFFF,
+                                               INT_MAX);
+                ASSERTV(input, rv, valid == (0 == rv));
+                if (valid) {
+                    ASSERTV(input, EXP, result32, EXP == result32);
+                    ASSERTV(input, NUM, rest.length(),
+                            input.length() - position - NUM == rest.length());
+                }
+
+                const bslstl::StringRef digits(input.data() + position,
+                                               input.length() - position);
+
+                valid = referenceParseUnsigned(&EXP,
+                                               &NUM,
+                                               input,
+                                               position,
+                                               k_INT64_MAX / 3,
+                                               maxNumDigits);
+                if (valid || (0 != maxNumDigits && !digits.empty())) {
+                    rv = NumericParseUtil::parseUnsignedInteger(
+                                                              &result,
+                                                              &rest,
+                                                              digits,
+                                                              10,
+                                                              k_INT64_MAX / 3,
+                                                              maxNumDigits);
+                    ASSERTV(input, maxNumDigits, rv, valid == (0 == rv));
+                    if (valid) {
+                        ASSERTV(input, maxNumDigits, EXP, result,
+                                EXP == result);
+                        ASSERTV(input, maxNumDigits, NUM, rest.length(),
+                                digits.length() - NUM == rest.length());
+                    }
+                }
+            }
+
+            // 'parseInt64' and 'parseInt'
+
+            {
+                const Uint64 maxMagnitude64 = k_INT64_MAX + isNegative;
+
+                valid = referenceParseUnsigned(&EXP,
+                                               &NUM,
+                                               input,
+                                               position,
+                                               maxMagnitude64,
+                                               INT_MAX);
+
+                Int64             result = 7;
+                bslstl::StringRef rest;
+                int rv = NumericParseUtil::parseInt64(&result, &rest, input);
+                ASSERTV(input, rv, valid == (0 == rv));
+                if (valid) {
+                    const Int64 EXP64 = isNegative
+                                      ? static_cast<Int64>(0 - EXP)
+                                      : static_cast<Int64>(EXP);
+                    ASSERTV(input, EXP64, result, EXP64 == result);
+                    ASSERTV(input, NUM, rest.length(),
+                            input.length() - position - NUM == rest.length());
+                }
+
+                valid = referenceParseUnsigned(&EXP,
+                                               &NUM,
+                                               input,
+                                               position,
+                                               0x7FFFFFFFULL + isNegative,
+                                               INT_MAX);
+
+                int result32 = 7;
+                rv = NumericParseUtil::parseInt(&result32, &rest, input);
+                ASSERTV(input, rv, valid == (0 == rv));
+                if (valid) {
+                    const Int64 EXP64 = isNegative
+                                      ? -static_cast<Int64>(EXP)
+                                      : static_cast<Int64>(EXP);
+                    ASSERTV(input, EXP64, result32, EXP64 == result32);
+                    ASSERTV(input, NUM, rest.length(),
+                            input.length() - position - NUM == rest.length());
+                }
+            }
+        }
+      } break;
+      case 11: {
+        // --------------------------------------------------------------------
+        // TESTING CORRECT ROUNDING OF PARSE DOUBLE
+        //
+        // Concerns:
+        //: 1 'parseDouble' produces the same value as 'strtod' (which is
+        //:   correctly rounded on the platforms we test on) for every input,
+        //:   whether it is resolved by the fast algorithm or by 'strtod'.
+        //:
+        //: 2 The remainder is the same as the 'end' pointer of 'strtod'.
+        //:
+        //: 3 Inputs that are difficult to round (halfway cases, boundaries
+        //:   between binades, and values near the limits of the range) are
+        //:   handled correctly.
+        //:
+        //: 4 Inputs that the fast algorithm does not handle (more than 19
+        //:   significant digits, subnormal values, overflow, hexadecimal,
+        //:   infinity, and NaN) are handled correctly.
+        //
+        // Plan:
+        //: 1 Compare the result and remainder of 'parseDouble' with those of
+        //:   'strtod' for a table of difficult inputs, each with and without
+        //:   a suffix.  (C-1..4)
+        //:
+        //: 2 Repeat P-1 for random 'double' values printed with every
+        //:   precision from 1 to 17 digits, in both '%g' and '%e' style, and
+        //:   for random decimal strings of up to 25 digits having random
+        //:   exponents.  (C-1..4)
+        //
+        // Testing:
+        //   CONCERN: 'parseDouble' is correctly rounded
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "TESTING CORRECT ROUNDING OF PARSE DOUBLE"
+                          << endl
+                          << "========================================"
+                          << endl;
+
+        static const char *SUFFIXES[] = { "", ",", "]", "e", "E+", "x1", "." };
+        const int NUM_SUFFIXES = sizeof SUFFIXES / sizeof *SUFFIXES;
+
+        if (verbose) cout << "\tDifficult values." << endl;
+        {
+            static const struct {
+                int         d_line;   // source line number
+                const char *d_input;  // input string
+            } DATA[] = {
+                //line  input
+                //----  -----------------------------------------------------
+                { L_,   "0"                                                 },
+                { L_,   "-0"                                                },
+                { L_,   "-0.0e-5"                                           },
+                { L_,   "0e999999999999"                                    },
+                { L_,   "00000000000000000000000000000000000"               },
+                { L_,   "0.00000000000000000000000000000000000"             },
+                { L_,   "1"                                                 },
+                { L_,   "5."                                                },
+                { L_,   ".5"                                                },
+                { L_,   "0.1"                                               },
+                { L_,   "0.3"                                               },
+                { L_,   "1e23"                                              },
+                { L_,   "1e22"                                              },
+                { L_,   "123.456e-22"                                       },
+                { L_,   "9007199254740991"                                  },
+                { L_,   "9007199254740992"                                  },
+                { L_,   "9007199254740993"                                  },
+                { L_,   "9007199254740995"                                  },
+                { L_,   "18014398509481983"                                 },
+                { L_,   "9999999999999999999"                               },
+                { L_,   "10000000000000000000"                              },
+                { L_,   "18446744073709551615"                              },
+                { L_,   "18446744073709551616"                              },
+                { L_,   "1000000000000000000000000000000000000000000000000"
+                        "000000000000000"                                   },
+                { L_,   "1.00000000000000011102230246251565404236316680908"
+                        "203125"                                            },
+                { L_,   "1.00000000000000011102230246251565404236316680908"
+                        "203124"                                            },
+                { L_,   "1.00000000000000011102230246251565404236316680908"
+                        "203126"                                            },
+                { L_,   "0.000000000000000000000000000000000000000000012345"
+                        "6789012345678"                                     },
+                { L_,   "7.2057594037927933e16"                             },
+                { L_,   "8.988465674311579e307"                             },
+                { L_,   "1.7976931348623157e308"                            },
+                { L_,   "1.7976931348623158e308"                            },
+                { L_,   "1.7976931348623159e308"                            },
+                { L_,   "-1.8e308"                                          },
+                { L_,   "1e309"                                             },
+                { L_,   "2.2250738585072014e-308"                           },
+                { L_,   "2.2250738585072011e-308"                           },
+                { L_,   "2.2250738585072012e-308"                           },
+                { L_,   "4.9406564584124654e-324"                           },
+                { L_,   "2.4703282292062327e-324"                           },
+                { L_,   "2.4703282292062328e-324"                           },
+                { L_,   "1e-400"                                            },
+                { L_,   "1e-348"                                            },
+                { L_,   "1e347"                                             },
+                { L_,   "12345678.12345678e1"                               },
+                { L_,   "1234567890123456789e-10"                           },
+                { L_,   "1e"                                                },
+                { L_,   "1e+"                                               },
+                { L_,   "1.5e-"                                             },
+                { L_,   "1e+x"                                              },
+                { L_,   "0x1p3"                                             },
+                { L_,   "0X1A"                                              },
+                { L_,   "0x"                                                },
+                { L_,   "inf"                                               },
+                { L_,   "-Infinity"                                         },
+                { L_,   "nan"                                               },
+                { L_,   "."                                                 },
+                { L_,   "-."                                                },
+                { L_,   "+.e1"                                              },
+                { L_,   "e1"                                                },
+            };
+            const int NUM_DATA = sizeof DATA / sizeof *DATA;
+
+            for (int ti = 0; ti < NUM_DATA; ++ti) {
+                for (int si = 0; si < NUM_SUFFIXES; ++si) {
+                    bsl::string input(DATA[ti].d_input);
+                    input += SUFFIXES[si];
+
+                    if (veryVerbose) { P(input) }
+
+                    verifyParseDouble(DATA[ti].d_line, input);
+                }
+            }
+        }
+
+        if (verbose) cout << "\tRandom values at every precision." << endl;
+        {
+            Uint64 state = 12345;
+            for (int ti = 0; ti < 20000; ++ti) {
+                const double value = randomDouble(&state);
+                for (int precision = 1; precision <= 17; ++precision) {
+                    char buffer[64];
+                    sprintf(buffer, "%.*g", precision, value);
+                    verifyParseDouble(L_, buffer);
+                    sprintf(buffer, "%.*e", precision - 1, value);
+                    verifyParseDouble(L_,
+                                      bsl::string(buffer) +
+                                      SUFFIXES[precision % NUM_SUFFIXES]);
+                }
+            }
+        }
+
+        if (verbose) cout << "\tRandom decimal strings." << endl;
+        {
+            Uint64 state = 54321;
+            for (int ti = 0; ti < 200000; ++ti) {
+                const Uint64 r = nextRandom(&state);
+
+                bsl::string input;
+                if (r % 2) {
+                    input += '-';
+                }
+                const int numDigits = static_cast<int>((r >> 4) % 25) + 1;
+                const int point     = static_cast<int>((r >> 12) % 27);
+                for (int i = 0; i < numDigits; ++i) {
+                    if (i == point) {
+                        input += '.';
+                    }
+                    input += static_cast<char>('0' + nextRandom(&state) % 10);
+                }
+                if ((r >> 20) % 4) {
+                    char buffer[16];
+                    sprintf(buffer,
+                            "e%d",
+                            static_cast<int>((r >> 24) % 701) - 350);
+                    input += buffer;
+                }
+                input += SUFFIXES[(r >> 40) % NUM_SUFFIXES];
+
+                verifyParseDouble(L_, input);
+            }
+        }
+      } break;
       case 10: {
         // --------------------------------------------------------------------
         // TESTING PARSE USHORT
@@ -2878,6 +3345,187 @@ int main(int argc, char *argv[])
             }
         }
       } break;
+      case -1: {
+        // --------------------------------------------------------------------
+        // BENCHMARK: PARSING NUMERIC CORPORA
+        //
+        // Concerns:
+        //: 1 'parseDouble' is substantially faster than 'strtod' on input
+        //:   representative of JSON, XML and configuration data.
+        //:
+        //: 2 'parseInt', 'parseInt64', and 'parseUint64' are fast on short
+        //:   and long integers.
+        //
+        // Plan:
+        //: 1 Build corpora of prices, geographic coordinates, full-precision
+        //:   values (as printed with '%.17g'), scientific values (as printed
+        //:   with '%.6e'), and integers of various lengths.  For each, report
+        //:   the average time of parsing one number with the functions under
+        //:   test and with 'strtod' or 'strtoll'.
+        //
+        // Testing:
+        //   BENCHMARK: PARSING NUMERIC CORPORA
+        // --------------------------------------------------------------------
+
+        cout << endl
+             << "BENCHMARK: PARSING NUMERIC CORPORA" << endl
+             << "==================================" << endl;
+
+        const int NUM_VALUES     = 10000;
+        const int NUM_ITERATIONS = 20;
+
+        enum {
+            e_PRICES,
+            e_COORDINATES,
+            e_FULL_PRECISION,
+            e_SCIENTIFIC,
+            e_SMALL_INTEGERS,
+            e_TIMESTAMPS,
+            e_IDENTIFIERS,
+            e_NUM_CORPORA
+        };
+
+        static const char *NAMES[] = {
+            "prices (\"1234.56\")",
+            "coordinates (\"-73.985664\")",
+            "full precision (\"%.17g\")",
+            "scientific (\"%.6e\")",
+            "small integers (\"4096\")",
+            "timestamps (\"1508803200123\")",
+            "identifiers (\"%llu\", 64-bit)"
+        };
+
+        Uint64 state = 2017;
+
+        for (int corpus = 0; corpus < e_NUM_CORPORA; ++corpus) {
+            bsl::vector<bsl::string> inputs;
+            inputs.reserve(NUM_VALUES);
+
+            for (int i = 0; i < NUM_VALUES; ++i) {
+                const Uint64 r = nextRandom(&state);
+                char         buffer[64];
+                switch (corpus) {
+                  case e_PRICES: {
+                    sprintf(buffer,
+                            "%d.%02d",
+                            static_cast<int>(r % 100000),
+                            static_cast<int>((r >> 20) % 100));
+                  } break;
+                  case e_COORDINATES: {
+                    sprintf(buffer,
+                            "%.6f",
+                            static_cast<double>(r % 360000000) / 1e6 - 180);
+                  } break;
+                  case e_FULL_PRECISION: {
+                    sprintf(buffer, "%.17g", randomDouble(&state));
+                  } break;
+                  case e_SCIENTIFIC: {
+                    sprintf(buffer, "%.6e", randomDouble(&state));
+                  } break;
+                  case e_SMALL_INTEGERS: {
+                    sprintf(buffer, "%d", static_cast<int>(r % 10000));
+                  } break;
+                  case e_TIMESTAMPS: {
+                    sprintf(buffer,
+                            "%lld",
+                            1500000000000LL +
+                                 static_cast<long long>(r % 100000000000LL));
+                  } break;
+                  case e_IDENTIFIERS: {
+                    sprintf(buffer,
+                            "%llu",
+                            static_cast<unsigned long long>(r));
+                  } break;
+                }
+                inputs.push_back(buffer);
+            }
+
+            const bool isInteger = corpus >= e_SMALL_INTEGERS;
+
+            double checksum = 0;
+
+            bsls::Stopwatch timer;
+            timer.start(true);
+            for (int iteration = 0; iteration < NUM_ITERATIONS; ++iteration) {
+                for (int i = 0; i < NUM_VALUES; ++i) {
+                    if (isInteger) {
+                        Uint64 value = 0;
+                        NumericParseUtil::parseUint64(&value, inputs[i]);
+                        checksum += static_cast<double>(value);
+                    }
+                    else {
+                        double value = 0;
+                        NumericParseUtil::parseDouble(&value, inputs[i]);
+                        checksum += value;
+                    }
+                }
+            }
+            timer.stop();
+            const double utilTime = timer.accumulatedWallTime();
+
+            timer.reset();
+            timer.start(true);
+            for (int iteration = 0; iteration < NUM_ITERATIONS; ++iteration) {
+                for (int i = 0; i < NUM_VALUES; ++i) {
+                    if (isInteger) {
+                        checksum -= static_cast<double>(
+                                strtoull(inputs[i].c_str(), 0, 10));
+                    }
+                    else {
+                        checksum -= strtod(inputs[i].c_str(), 0);
+                    }
+                }
+            }
+            timer.stop();
+            const double libcTime = timer.accumulatedWallTime();
+
+            const double numParsed = static_cast<double>(NUM_VALUES) *
+                                                                NUM_ITERATIONS;
+
+            cout << NAMES[corpus] << ":\n"
+                 << "\tNumericParseUtil: "
+                 << utilTime / numParsed * 1e9 << " ns/number\n"
+                 << "\t" << (isInteger ? "strtoull" : "strtod") << ":"
+                 << (isInteger ? "         " : "           ")
+                 << libcTime / numParsed * 1e9 << " ns/number\n"
+                 << "\tspeedup:          " << libcTime / utilTime
+                 << " (checksum " << checksum << ")" << endl;
+        }
+
+        if (verbose) cout << "\tSigned integer parsers." << endl;
+        {
+            bsl::vector<bsl::string> inputs;
+            for (int i = 0; i < NUM_VALUES; ++i) {
+                const Uint64 r = nextRandom(&state);
+                char         buffer[32];
+                long long    value = static_cast<long long>(
+                                                        (r >> (r % 64)) >> 1);
+                sprintf(buffer, "%lld", r % 2 ? -value : value);
+                inputs.push_back(buffer);
+            }
+
+            Int64           checksum = 0;
+            bsls::Stopwatch timer;
+            timer.start(true);
+            for (int iteration = 0; iteration < NUM_ITERATIONS; ++iteration) {
+                for (int i = 0; i < NUM_VALUES; ++i) {
+                    Int64 value = 0;
+                    NumericParseUtil::parseInt64(&value, inputs[i]);
+                    checksum += value;
+                    int value32 = 0;
+                    NumericParseUtil::parseInt(&value32, inputs[i]);
+                    checksum += value32;
+                }
+            }
+            timer.stop();
+
+            cout << "parseInt64 + parseInt (mixed lengths): "
+                 << timer.accumulatedWallTime() /
+                        (static_cast<double>(NUM_VALUES) * NUM_ITERATIONS) *
+                                                                           1e9
+                 << " ns/pair (checksum " << checksum << ")" << endl;
+        }
+      } break;
       default: {
         cerr << "WARNING: CASE `" << test << "' NOT FOUND." << endl;
         testStatus = -1;
@@ -0,0 +1,1076 @@
+// bdlc_flathashmap.h                                                 -*-C++-*-
+#ifndef INCLUDED_BDLC_FLATHASHMAP
+#define INCLUDED_BDLC_FLATHASHMAP
+
+#include <bsls_ident.h>
+BSLS_IDENT("$Id: $")
+
+//@PURPOSE: Provide an open-addressed unordered map container.
+//
+//@CLASSES:
+//  bdlc::FlatHashMap: open-addressed unordered map container
+//  bdlc::FlatHashMap_EntryUtil: 'bdlc::FlatHashTable' entry utility
+//
+//@SEE_ALSO: bdlc_flathashtable, bdlc_flathashset
+//
+//@DESCRIPTION: This component defines a single class template,
+// 'bdlc::FlatHashMap', that implements an open-addressed unordered map of
+// items with unique keys.  The interface follows that of 'bsl::unordered_map'
+// where the semantics of open addressing permit.
+//
+// The implementation (see 'bdlc_flathashtable') stores the elements of the
+// map in place in a single contiguous array, and locates an element by
+// examining, sixteen at a time, one-byte control values holding seven bits of
+// the hash of each element's key.  Compared to 'bsl::unordered_map', which
+// allocates a node per element and follows a linked list on each lookup,
+// 'bdlc::FlatHashMap' performs no per-element allocation and typically incurs
+// a single cache miss per lookup, at the cost of invalidating references to
+// elements on rehash.
+//
+// The 'value_type' of a 'bdlc::FlatHashMap' is 'bsl::pair<KEY, VALUE>'.  Note
+// that, unlike 'bsl::unordered_map', the 'first' member of an element is not
+// 'const' (so that elements may be relocated during a rehash), but the
+// behavior is undefined if it is modified through an iterator or reference.
+//
+// By default the map uses 'bslh::Hash<>' to hash keys, which (through
+// 'hashAppend') supports all BDE vocabulary types.  Any hash functor may be
+// supplied: the table mixes the hash values it receives, so a hash function
+// with poor distribution in some bits (e.g., 'bsl::hash<int>') does not lead
+// to excessive collisions.
+//
+///Performance Caveats
+///-------------------
+// 'bdlc::FlatHashMap' is recommended for keys and values that are small or
+// inexpensive to move, and for workloads dominated by lookups.  Since the
+// elements are relocated on rehash, clients anticipating the number of
+// elements should call 'reserve' to avoid repeated rehashing, and clients
+// that require stable references to elements should use
+// 'bsl::unordered_map'.
+//
+///Iterator, Pointer, and Reference Invalidation
+///---------------------------------------------
+// Any change in capacity (by 'rehash', 'reserve', or an insertion that grows
+// the map) invalidates all iterators, pointers, and references to elements.
+// Erasing an element invalidates iterators, pointers, and references to that
+// element only.
+//
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Gathering Document Statistics
+///- - - - - - - - - - - - - - - - - - - -
+// Suppose one wished to gather statistics on the words appearing in a large
+// set of documents on disk or in a database.  Gathering those statistics is
+// intrusive (as one is competing for access to the documents with the regular
+// users) and must be done as quickly as possible.  Moreover, the set of unique
+// words appearing in those documents may be high.  The English language has
+// in excess of a million words (albeit many appear infrequently), and, if the
+// documents contain serial numbers, or Social Security numbers, or chemical
+// formulas, etc., then the 'O[log(n)]' insertion time of ordered maps may well
+// be inadequate.  An unordered map, having an 'O[1]' typical insertion cost,
+// is a viable alternative, and a flat (open-addressed) map further avoids a
+// memory allocation per unique word.
+//
+// First, we define the type of the map, mapping each word to the number of
+// times it has been seen:
+//..
+//  typedef bdlc::FlatHashMap<bsl::string, int> WordTally;
+//..
+// Then, we define some documents to be processed:
+//..
+//  const char *documents[] = {
+//    "Lorem ipsum dolor sit amet, consectetur adipiscing elit.",
+//    "Mauris ut massa ipsum, dolor sit amet.",
+//    "Sit amet consectetur ipsum."
+//  };
+//  const int numDocuments = sizeof documents / sizeof *documents;
+//..
+// Next, we tally the words, ignoring punctuation, using 'operator[]' to
+// default-construct a count for each word seen for the first time:
+//..
+//  WordTally tally;
+//
+//  for (int i = 0; i < numDocuments; ++i) {
+//      bsl::string       word;
+//      const char       *p = documents[i];
+//
+//      for (; ; ++p) {
+//          if (bsl::isalpha(static_cast<unsigned char>(*p))) {
+//              word.push_back(static_cast<char>(
+//                          bsl::tolower(static_cast<unsigned char>(*p))));
+//          }
+//          else {
+//              if (!word.empty()) {
+//                  ++tally[word];
+//                  word.clear();
+//              }
+//              if (0 == *p) {
+//                  break;
+//              }
+//          }
+//      }
+//  }
+//..
+// Finally, we verify the tally of a few words:
+//..
+//  assert(3 == tally["ipsum"]);
+//  assert(3 == tally["sit"]);
+//  assert(1 == tally["lorem"]);
+//  assert(2 == tally["consectetur"]);
+//  assert(tally.end() == tally.find("not-present"));
+//..
+
+#include <bdlscm_version.h>
+
+#include <bdlc_flathashtable.h>
+
+#include <bslh_hash.h>
+
+#include <bslma_allocator.h>
+#include <bslma_constructionutil.h>
+#include <bslma_destructorguard.h>
+#include <bslma_stdallocator.h>
+#include <bslma_usesbslmaallocator.h>
+
+#include <bslmf_movableref.h>
+#include <bslmf_nestedtraitdeclaration.h>
+
+#include <bsls_assert.h>
+#include <bsls_compilerfeatures.h>
+#include <bsls_exceptionutil.h>
+#include <bsls_objectbuffer.h>
+
+#include <bsl_cstddef.h>
+#include <bsl_functional.h>
+#include <bsl_stdexcept.h>
+#include <bsl_utility.h>
+
+namespace BloombergLP {
+namespace bdlc {
+
+                       // ============================
+                       // struct FlatHashMap_EntryUtil
+                       // ============================
+
+template <class KEY, class VALUE, class ENTRY>
+struct FlatHashMap_EntryUtil {
+    // This templated utility provides methods to construct an 'ENTRY' and a
+    // method to extract the key from an 'ENTRY', as required by
+    // 'bdlc::FlatHashTable'.
+
+    // CLASS METHODS
+    template <class ENTRY_TYPE>
+    static void construct(
+                      ENTRY                                         *entry,
+                      bslma::Allocator                              *allocator,
+                      BSLS_COMPILERFEATURES_FORWARD_REF(ENTRY_TYPE)  source)
+        // Create an entry at the specified 'entry' address from the specified
+        // 'source' using the specified 'allocator' to supply memory.
+    {
+        BSLS_ASSERT_SAFE(entry);
+
+        bslma::ConstructionUtil::construct(
+                              entry,
+                              allocator,
+                            BSLS_COMPILERFEATURES_FORWARD(ENTRY_TYPE, source));
+    }
+
+    template <class KEY_TYPE>
+    static void constructFromKey(
+                        ENTRY                                       *entry,
+                        bslma::Allocator                            *allocator,
+                        BSLS_COMPILERFEATURES_FORWARD_REF(KEY_TYPE)  key)
+        // Create an entry at the specified 'entry' address having the
+        // specified 'key' and a default-constructed value, using the specified
+        // 'allocator' to supply memory.
+    {
+        BSLS_ASSERT_SAFE(entry);
+
+        bsls::ObjectBuffer<VALUE> value;
+        bslma::ConstructionUtil::construct(value.address(), allocator);
+        bslma::DestructorGuard<VALUE> guard(value.address());
+
+        bslma::ConstructionUtil::construct(
+                              entry,
+                              allocator,
+                              BSLS_COMPILERFEATURES_FORWARD(KEY_TYPE, key),
+                              bslmf::MovableRefUtil::move(value.object()));
+    }
+
+    static const KEY& key(const ENTRY& entry)
+        // Return the key of the specified 'entry'.
+    {
+        return entry.first;
+    }
+};
+
+                            // =================
+                            // class FlatHashMap
+                            // =================
+
+template <class KEY,
+          class VALUE,
+          class HASH  = bslh::Hash<>,
+          class EQUAL = bsl::equal_to<KEY> >
+class FlatHashMap {
+    // This class template implements a value-semantic container type holding
+    // an unordered set of key-value pairs having unique keys that provide a
+    // mapping from keys (of template parameter type 'KEY') to their associated
+    // values (of template parameter type 'VALUE').  The elements are stored
+    // in place in an open-addressed table (see 'bdlc_flathashtable').
+
+    // PRIVATE TYPES
+    typedef FlatHashTable<KEY,
+                          bsl::pair<KEY, VALUE>,
+                          FlatHashMap_EntryUtil<KEY,
+                                                VALUE,
+                                                bsl::pair<KEY, VALUE> >,
+                          HASH,
+                          EQUAL> ImplType;
+        // This is the underlying implementation class.
+
+    // FRIENDS
+    template <class K, class V, class H, class E>
+    friend bool operator==(const FlatHashMap<K, V, H, E>&,
+                           const FlatHashMap<K, V, H, E>&);
+
+  public:
+    // TYPES
+    typedef bsl::pair<KEY, VALUE>                    value_type;
+    typedef KEY                                      key_type;
+    typedef VALUE                                    mapped_type;
+    typedef bsl::size_t                              size_type;
+    typedef bsl::ptrdiff_t                           difference_type;
+    typedef EQUAL                                    key_equal;
+    typedef HASH                                     hasher;
+    typedef value_type&                              reference;
+    typedef const value_type&                        const_reference;
+    typedef value_type                              *pointer;
+    typedef const value_type                        *const_pointer;
+    typedef typename ImplType::iterator              iterator;
+    typedef typename ImplType::const_iterator        const_iterator;
+
+  private:
+    // DATA
+    ImplType d_impl;  // underlying flat hash table used by this flat hash map
+
+  public:
+    // TRAITS
+    BSLMF_NESTED_TRAIT_DECLARATION(FlatHashMap, bslma::UsesBslmaAllocator);
+
+    // CREATORS
+    FlatHashMap();
+    explicit FlatHashMap(bslma::Allocator *basicAllocator);
+    explicit FlatHashMap(bsl::size_t capacity);
+    FlatHashMap(bsl::size_t capacity, bslma::Allocator *basicAllocator);
+    FlatHashMap(bsl::size_t       capacity,
+                const HASH&       hash,
+                bslma::Allocator *basicAllocator = 0);
+    FlatHashMap(bsl::size_t       capacity,
+                const HASH&       hash,
+                const EQUAL&      equal,
+                bslma::Allocator *basicAllocator = 0);
+        // Create an empty 'FlatHashMap' object.  Optionally specify a
+        // 'capacity' indicating the minimum initial number of slots.  If
+        // 'capacity' is not supplied or is 0, no memory is allocated.
+        // Optionally specify a 'hash' used to generate the hash values for the
+        // keys of elements.  If 'hash' is not supplied, a default-constructed
+        // object of the (template parameter) type 'HASH' is used.  Optionally
+        // specify an equality functor 'equal' used to verify that two keys are
+        // equivalent.  If 'equal' is not supplied, a default-constructed
+        // object of the (template parameter) type 'EQUAL' is used.  Optionally
+        // specify a 'basicAllocator' used to supply memory.  If
+        // 'basicAllocator' is not supplied or is 0, the currently installed
+        // default allocator is used.
+
+    template <class INPUT_ITERATOR>
+    FlatHashMap(INPUT_ITERATOR    first,
+                INPUT_ITERATOR    last,
+                bslma::Allocator *basicAllocator = 0);
+    template <class INPUT_ITERATOR>
+    FlatHashMap(INPUT_ITERATOR    first,
+                INPUT_ITERATOR    last,
+                bsl::size_t       capacity,
+                const HASH&       hash  = HASH(),
+                const EQUAL&      equal = EQUAL(),
+                bslma::Allocator *basicAllocator = 0);
+        // Create a 'FlatHashMap' object initialized by insertion of the values
+        // from the input iterator range specified by 'first' through 'last'
+        // (including 'first', excluding 'last').  Optionally specify a
+        // 'capacity', 'hash', 'equal', and 'basicAllocator' as described for
+        // the previous constructors.  If a key appears multiple times in the
+        // range, only the first occurrence is inserted.  The behavior is
+        // undefined unless 'first' and 'last' refer to a sequence of valid
+        // values where 'first' is at a position at or before 'last'.
+
+    FlatHashMap(const FlatHashMap&  original,
+                bslma::Allocator   *basicAllocator = 0);
+        // Create a 'FlatHashMap' object having the same value, hasher, and
+        // equality comparator as the specified 'original' object.  Optionally
+        // specify a 'basicAllocator' used to supply memory.  If
+        // 'basicAllocator' is not specified or is 0, the currently installed
+        // default allocator is used.
+
+    FlatHashMap(bslmf::MovableRef<FlatHashMap> original);
+        // Create a 'FlatHashMap' object having the same value, hasher,
+        // equality comparator, and allocator as the specified 'original'
+        // object.  The value of 'original' becomes unspecified but valid, and
+        // its allocator remains unchanged.
+
+    FlatHashMap(bslmf::MovableRef<FlatHashMap>  original,
+                bslma::Allocator               *basicAllocator);
+        // Create a 'FlatHashMap' object having the same value, hasher, and
+        // equality comparator as the specified 'original' object, using the
+        // specified 'basicAllocator' to supply memory.  If 'basicAllocator' is
+        // 0, the currently installed default allocator is used.  The allocator
+        // of 'original' remains unchanged.  If 'original' and the newly
+        // created object have the same allocator then the contents of
+        // 'original' are moved (in constant time) to the newly created object,
+        // and 'original' is left empty; otherwise the value of 'original'
+        // becomes unspecified but valid.
+
+    ~FlatHashMap();
+        // Destroy this object and each of its elements.
+
+    // MANIPULATORS
+    FlatHashMap& operator=(const FlatHashMap& rhs);
+        // Assign to this object the value, hasher, and equality functor of the
+        // specified 'rhs' object, and return a reference providing modifiable
+        // access to this object.
+
+    FlatHashMap& operator=(bslmf::MovableRef<FlatHashMap> rhs);
+        // Assign to this object the value, hasher, and equality comparator of
+        // the specified 'rhs' object, and return a reference providing
+        // modifiable access to this object.  The value of 'rhs' becomes
+        // unspecified but valid, and its allocator remains unchanged.
+
+    VALUE& operator[](const KEY& key);
+    VALUE& operator[](bslmf::MovableRef<KEY> key);
+        // Return a reference providing modifiable access to the mapped value
+        // associated with the specified 'key' in this map.  If this map does
+        // not already contain an element having 'key', insert an element with
+        // the 'key' and a default-constructed 'VALUE', and return a reference
+        // to the newly mapped value.  If 'key' is moved into this map, its
+        // value becomes unspecified but valid.
+
+    VALUE& at(const KEY& key);
+        // Return a reference providing modifiable access to the mapped value
+        // associated with the specified 'key' in this map, if such an entry
+        // exists; otherwise, throw a 'std::out_of_range' exception.  Note
+        // that this method may also throw a different kind of exception if
+        // the (template parameter) type 'VALUE' throws when copied.
+
+    void clear();
+        // Remove all elements from this map.  Note that the capacity of this
+        // map is unaffected.
+
+    bsl::pair<iterator, iterator> equal_range(const KEY& key);
+        // Return a pair of iterators defining the sequence of modifiable
+        // elements in this map having the specified 'key', where the first
+        // iterator is positioned at the start of the sequence and the second
+        // iterator is positioned one past the end of the sequence.  If this
+        // map contains no elements having 'key', the two returned iterators
+        // will have the same value.  Note that since a map maintains unique
+        // keys, the range will contain at most one element.
+
+    bsl::size_t erase(const KEY& key);
+        // Remove from this map the element whose key is equal to the
+        // specified 'key', if it exists, and return 1; otherwise (there is no
+        // element having 'key' in this map), return 0 with no other effect.
+
+    iterator erase(const_iterator position);
+    iterator erase(iterator position);
+        // Remove from this map the element at the specified 'position', and
+        // return an iterator referring to the modifiable element immediately
+        // following the removed element, or to the past-the-end position if
+        // the removed element was the last in the sequence.  The behavior is
+        // undefined unless 'position' refers to an element in this map.
+
+    iterator erase(const_iterator first, const_iterator last);
+        // Remove from this map the elements starting at the specified 'first'
+        // position up to, but not including, the specified 'last' position,
+        // and return 'last'.  The behavior is undefined unless 'first' and
+        // 'last' either refer to elements in this map or are the 'end'
+        // iterator, and the 'first' position is at or before the 'last'
+        // position in the iteration sequence provided by this container.
+
+    iterator find(const KEY& key);
+        // Return an iterator referring to the modifiable element in this map
+        // having the specified 'key', or 'end()' if no such entry exists in
+        // this map.
+
+    bsl::pair<iterator, bool> insert(const value_type& value);
+    bsl::pair<iterator, bool> insert(bslmf::MovableRef<value_type> value);
+        // Insert the specified 'value' into this map if the key (the 'first'
+        // element) of 'value' does not already exist in this map; otherwise,
+        // this method has no effect.  Return a 'pair' whose 'first' member is
+        // an iterator referring to the (possibly newly inserted) element in
+        // this map whose key is equivalent to that of 'value', and whose
+        // 'second' member is 'true' if a new element was inserted, and 'false'
+        // if an element having an equivalent key was already present.
+
+    template <class INPUT_ITERATOR>
+    void insert(INPUT_ITERATOR first, INPUT_ITERATOR last);
+        // Create a 'value_type' object from each element in the range starting
+        // at the specified 'first' iterator and ending immediately before the
+        // specified 'last' iterator, and insert those whose keys are not
+        // already present.  The behavior is undefined unless 'first' and
+        // 'last' refer to a sequence of valid values where 'first' is at a
+        // position at or before 'last'.
+
+    void rehash(bsl::size_t minimumCapacity);
+        // Change the capacity of this map to at least the specified
+        // 'minimumCapacity', and redistribute all the contained elements into
+        // the new sequence of slots according to their hash values.  The
+        // resulting capacity is the smallest power of two (and at least 16)
+        // that can hold the current elements within the maximum load factor,
+        // and is not less than 'minimumCapacity'.  If 0 is the resulting
+        // capacity, all memory is released.
+
+    void reserve(bsl::size_t numEntries);
+        // Change the capacity of this map to at least a capacity that can
+        // accommodate the specified 'numEntries' (accounting for the load
+        // factor invariant), and redistribute all the contained elements into
+        // the new sequence of slots according to their hash values.  Note
+        // that no rehash occurs if this map can already hold 'numEntries'.
+
+    void reset();
+        // Remove all entries from this map and release all memory from this
+        // map.
+
+    // Iterators
+
+    iterator begin();
+        // Return an iterator representing the beginning of the sequence of
+        // modifiable elements held by this map.
+
+    iterator end();
+        // Return an iterator representing the end of the sequence of
+        // modifiable elements held by this map.
+
+    // Aspects
+
+    void swap(FlatHashMap& other);
+        // Exchange the value of this object as well as its hasher and
+        // equality functor with those of the specified 'other' object.  This
+        // method provides the no-throw exception-safety guarantee.  The
+        // behavior is undefined unless this object was created with the same
+        // allocator as 'other'.
+
+    // ACCESSORS
+    const VALUE& at(const KEY& key) const;
+        // Return a reference providing non-modifiable access to the mapped
+        // value associated with the specified 'key' in this map, if such an
+        // entry exists; otherwise, throw a 'std::out_of_range' exception.
+
+    bsl::size_t capacity() const;
+        // Return the number of slots (elements and unused positions) in this
+        // map.
+
+    bool contains(const KEY& key) const;
+        // Return 'true' if this map contains an element having the specified
+        // 'key', and 'false' otherwise.
+
+    bsl::size_t count(const KEY& key) const;
+        // Return the number of elements in this map having the specified
+        // 'key'.  Note that since a map maintains unique keys, the returned
+        // value will be either 0 or 1.
+
+    bool empty() const;
+        // Return 'true' if this map contains no elements, and 'false'
+        // otherwise.
+
+    bsl::pair<const_iterator, const_iterator> equal_range(
+                                                         const KEY& key) const;
+        // Return a pair of iterators defining the sequence of non-modifiable
+        // elements in this map having the specified 'key', where the first
+        // iterator is positioned at the start of the sequence and the second
+        // iterator is positioned one past the end of the sequence.  If this
+        // map contains no elements having 'key', the two returned iterators
+        // will have the same value.
+
+    const_iterator find(const KEY& key) const;
+        // Return an iterator referring to the non-modifiable element in this
+        // map having the specified 'key', or 'end()' if no such entry exists
+        // in this map.
+
+    HASH hash_function() const;
+        // Return (a copy of) the unary hash functor used by this map to
+        // generate a hash value (of type 'bsl::size_t') for a 'KEY' object.
+
+    EQUAL key_eq() const;
+        // Return (a copy of) the binary key-equality functor that returns
+        // 'true' if the value of two 'KEY' objects are equivalent, and 'false'
+        // otherwise.
+
+    float load_factor() const;
+        // Return the current ratio between the number of elements in this
+        // container and its capacity.
+
+    float max_load_factor() const;
+        // Return the maximum load factor allowed for this map.  Note that if
+        // an insert operation would cause the load factor to exceed the
+        // 'max_load_factor', that same insert operation will increase the
+        // capacity and rehash the entries of the container.  Also note that
+        // the value returned by 'max_load_factor' is implementation dependent
+        // and cannot be changed by the user.
+
+    bsl::size_t size() const;
+        // Return the number of elements in this map.
+
+    // Iterators
+
+    const_iterator begin() const;
+    const_iterator cbegin() const;
+        // Return an iterator representing the beginning of the sequence of
+        // non-modifiable elements held by this map.
+
+    const_iterator end() const;
+    const_iterator cend() const;
+        // Return an iterator representing the end of the sequence of
+        // non-modifiable elements held by this map.
+
+    // Aspects
+
+    bslma::Allocator *allocator() const;
+        // Return the allocator used by this flat hash map to supply memory.
+};
+
+// FREE OPERATORS
+template <class KEY, class VALUE, class HASH, class EQUAL>
+bool operator==(const FlatHashMap<KEY, VALUE, HASH, EQUAL> &lhs,
+                const FlatHashMap<KEY, VALUE, HASH, EQUAL> &rhs);
+    // Return 'true' if the specified 'lhs' and 'rhs' objects have the same
+    // value, and 'false' otherwise.  Two 'FlatHashMap' objects have the same
+    // value if their sizes are the same and each element contained in one is
+    // equal to an element of the other.  The hash and equality functors are
+    // not involved in the comparison.
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+bool operator!=(const FlatHashMap<KEY, VALUE, HASH, EQUAL> &lhs,
+                const FlatHashMap<KEY, VALUE, HASH, EQUAL> &rhs);
+    // Return 'true' if the specified 'lhs' and 'rhs' objects do not have the
+    // same value, and 'false' otherwise.  Two 'FlatHashMap' objects do not
+    // have the same value if their sizes are different or one contains an
+    // element equal to no element of the other.  The hash and equality
+    // functors are not involved in the comparison.
+
+// FREE FUNCTIONS
+template <class KEY, class VALUE, class HASH, class EQUAL>
+void swap(FlatHashMap<KEY, VALUE, HASH, EQUAL>& a,
+          FlatHashMap<KEY, VALUE, HASH, EQUAL>& b);
+    // Exchange the value, the hasher, and the key-equality functor of the
+    // specified 'a' and 'b' objects.  This method provides the no-throw
+    // exception-safety guarantee if the two objects were created with the
+    // same allocator and the basic guarantee otherwise.
+
+// ============================================================================
+//                  TEMPLATE AND INLINE FUNCTION DEFINITIONS
+// ============================================================================
+
+                            // -----------------
+                            // class FlatHashMap
+                            // -----------------
+
+// CREATORS
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+FlatHashMap<KEY, VALUE, HASH, EQUAL>::FlatHashMap()
+: d_impl(0, HASH(), EQUAL())
+{
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+FlatHashMap<KEY, VALUE, HASH, EQUAL>::FlatHashMap(
+                                              bslma::Allocator *basicAllocator)
+: d_impl(0, HASH(), EQUAL(), basicAllocator)
+{
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+FlatHashMap<KEY, VALUE, HASH, EQUAL>::FlatHashMap(bsl::size_t capacity)
+: d_impl(capacity, HASH(), EQUAL())
+{
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+FlatHashMap<KEY, VALUE, HASH, EQUAL>::FlatHashMap(
+                                              bsl::size_t       capacity,
+                                              bslma::Allocator *basicAllocator)
+: d_impl(capacity, HASH(), EQUAL(), basicAllocator)
+{
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+FlatHashMap<KEY, VALUE, HASH, EQUAL>::FlatHashMap(
+                                              bsl::size_t       capacity,
+                                              const HASH&       hash,
+                                              bslma::Allocator *basicAllocator)
+: d_impl(capacity, hash, EQUAL(), basicAllocator)
+{
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+FlatHashMap<KEY, VALUE, HASH, EQUAL>::FlatHashMap(
+                                              bsl::size_t       capacity,
+                                              const HASH&       hash,
+                                              const EQUAL&      equal,
+                                              bslma::Allocator *basicAllocator)
+: d_impl(capacity, hash, equal, basicAllocator)
+{
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+template <class INPUT_ITERATOR>
+inline
+FlatHashMap<KEY, VALUE, HASH, EQUAL>::FlatHashMap(
+                                              INPUT_ITERATOR    first,
+                                              INPUT_ITERATOR    last,
+                                              bslma::Allocator *basicAllocator)
+: d_impl(0, HASH(), EQUAL(), basicAllocator)
+{
+    insert(first, last);
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+template <class INPUT_ITERATOR>
+inline
+FlatHashMap<KEY, VALUE, HASH, EQUAL>::FlatHashMap(
+                                              INPUT_ITERATOR    first,
+                                              INPUT_ITERATOR    last,
+                                              bsl::size_t       capacity,
+                                              const HASH&       hash,
+                                              const EQUAL&      equal,
+                                              bslma::Allocator *basicAllocator)
+: d_impl(capacity, hash, equal, basicAllocator)
+{
+    insert(first, last);
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+FlatHashMap<KEY, VALUE, HASH, EQUAL>::FlatHashMap(
+                                          const FlatHashMap&  original,
+                                          bslma::Allocator   *basicAllocator)
+: d_impl(original.d_impl, basicAllocator)
+{
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+FlatHashMap<KEY, VALUE, HASH, EQUAL>::FlatHashMap(
+                                       bslmf::MovableRef<FlatHashMap> original)
+: d_impl(bslmf::MovableRefUtil::move(
+                             bslmf::MovableRefUtil::access(original).d_impl))
+{
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+FlatHashMap<KEY, VALUE, HASH, EQUAL>::FlatHashMap(
+                             bslmf::MovableRef<FlatHashMap>  original,
+                             bslma::Allocator               *basicAllocator)
+: d_impl(bslmf::MovableRefUtil::move(
+                              bslmf::MovableRefUtil::access(original).d_impl),
+         basicAllocator)
+{
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+FlatHashMap<KEY, VALUE, HASH, EQUAL>::~FlatHashMap()
+{
+}
+
+// MANIPULATORS
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+FlatHashMap<KEY, VALUE, HASH, EQUAL>&
+FlatHashMap<KEY, VALUE, HASH, EQUAL>::operator=(const FlatHashMap& rhs)
+{
+    d_impl = rhs.d_impl;
+
+    return *this;
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+FlatHashMap<KEY, VALUE, HASH, EQUAL>&
+FlatHashMap<KEY, VALUE, HASH, EQUAL>::operator=(
+                                            bslmf::MovableRef<FlatHashMap> rhs)
+{
+    FlatHashMap& lvalue = rhs;
+
+    d_impl = bslmf::MovableRefUtil::move(lvalue.d_impl);
+
+    return *this;
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+VALUE& FlatHashMap<KEY, VALUE, HASH, EQUAL>::operator[](const KEY& key)
+{
+    return d_impl[key].second;
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+VALUE& FlatHashMap<KEY, VALUE, HASH, EQUAL>::operator[](
+                                                    bslmf::MovableRef<KEY> key)
+{
+    return d_impl[bslmf::MovableRefUtil::move(key)].second;
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+VALUE& FlatHashMap<KEY, VALUE, HASH, EQUAL>::at(const KEY& key)
+{
+    iterator node = d_impl.find(key);
+
+    if (node == d_impl.end()) {
+        BSLS_THROW(std::out_of_range(
+                         "FlatHashMap<...>::at(key_type): invalid key value"));
+    }
+
+    return node->second;
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+void FlatHashMap<KEY, VALUE, HASH, EQUAL>::clear()
+{
+    d_impl.clear();
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+bsl::pair<typename FlatHashMap<KEY, VALUE, HASH, EQUAL>::iterator,
+          typename FlatHashMap<KEY, VALUE, HASH, EQUAL>::iterator>
+FlatHashMap<KEY, VALUE, HASH, EQUAL>::equal_range(const KEY& key)
+{
+    return d_impl.equal_range(key);
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+bsl::size_t FlatHashMap<KEY, VALUE, HASH, EQUAL>::erase(const KEY& key)
+{
+    return d_impl.erase(key);
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+typename FlatHashMap<KEY, VALUE, HASH, EQUAL>::iterator
+FlatHashMap<KEY, VALUE, HASH, EQUAL>::erase(const_iterator position)
+{
+    BSLS_ASSERT_SAFE(position != end());
+
+    return d_impl.erase(position);
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+typename FlatHashMap<KEY, VALUE, HASH, EQUAL>::iterator
+FlatHashMap<KEY, VALUE, HASH, EQUAL>::erase(iterator position)
+{
+    BSLS_ASSERT_SAFE(position != end());
+
+    return d_impl.erase(position);
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+typename FlatHashMap<KEY, VALUE, HASH, EQUAL>::iterator
+FlatHashMap<KEY, VALUE, HASH, EQUAL>::erase(const_iterator first,
+                                            const_iterator last)
+{
+    return d_impl.erase(first, last);
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+typename FlatHashMap<KEY, VALUE, HASH, EQUAL>::iterator
+FlatHashMap<KEY, VALUE, HASH, EQUAL>::find(const KEY& key)
+{
+    return d_impl.find(key);
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+bsl::pair<typename FlatHashMap<KEY, VALUE, HASH, EQUAL>::iterator, bool>
+FlatHashMap<KEY, VALUE, HASH, EQUAL>::insert(const value_type& value)
+{
+    return d_impl.insert(value);
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+bsl::pair<typename FlatHashMap<KEY, VALUE, HASH, EQUAL>::iterator, bool>
+FlatHashMap<KEY, VALUE, HASH, EQUAL>::insert(
+                                           bslmf::MovableRef<value_type> value)
+{
+    return d_impl.insert(bslmf::MovableRefUtil::move(value));
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+template <class INPUT_ITERATOR>
+void FlatHashMap<KEY, VALUE, HASH, EQUAL>::insert(INPUT_ITERATOR first,
+                                                  INPUT_ITERATOR last)
+{
+    for (; first != last; ++first) {
+        const value_type& value = *first;
+        d_impl.insert(value);
+    }
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+void FlatHashMap<KEY, VALUE, HASH, EQUAL>::rehash(bsl::size_t minimumCapacity)
+{
+    d_impl.rehash(minimumCapacity);
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+void FlatHashMap<KEY, VALUE, HASH, EQUAL>::reserve(bsl::size_t numEntries)
+{
+    d_impl.reserve(numEntries);
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+void FlatHashMap<KEY, VALUE, HASH, EQUAL>::reset()
+{
+    d_impl.reset();
+}
+
+                          // Iterators
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+typename FlatHashMap<KEY, VALUE, HASH, EQUAL>::iterator
+FlatHashMap<KEY, VALUE, HASH, EQUAL>::begin()
+{
+    return d_impl.begin();
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+typename FlatHashMap<KEY, VALUE, HASH, EQUAL>::iterator
+FlatHashMap<KEY, VALUE, HASH, EQUAL>::end()
+{
+    return d_impl.end();
+}
+
+                             // Aspects
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+void FlatHashMap<KEY, VALUE, HASH, EQUAL>::swap(FlatHashMap& other)
+{
+    BSLS_ASSERT_SAFE(allocator() == other.allocator());
+
+    d_impl.swap(other.d_impl);
+}
+
+// ACCESSORS
+template <class KEY, class VALUE, class HASH, class EQUAL>
+const VALUE& FlatHashMap<KEY, VALUE, HASH, EQUAL>::at(const KEY& key) const
+{
+    const_iterator node = d_impl.find(key);
+
+    if (node == d_impl.end()) {
+        BSLS_THROW(std::out_of_range(
+                         "FlatHashMap<...>::at(key_type): invalid key value"));
+    }
+
+    return node->second;
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+bsl::size_t FlatHashMap<KEY, VALUE, HASH, EQUAL>::capacity() const
+{
+    return d_impl.capacity();
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+bool FlatHashMap<KEY, VALUE, HASH, EQUAL>::contains(const KEY& key) const
+{
+    return d_impl.contains(key);
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+bsl::size_t FlatHashMap<KEY, VALUE, HASH, EQUAL>::count(const KEY& key) const
+{
+    return d_impl.count(key);
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+bool FlatHashMap<KEY, VALUE, HASH, EQUAL>::empty() const
+{
+    return d_impl.empty();
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+bsl::pair<typename FlatHashMap<KEY, VALUE, HASH, EQUAL>::const_iterator,
+          typename FlatHashMap<KEY, VALUE, HASH, EQUAL>::const_iterator>
+FlatHashMap<KEY, VALUE, HASH, EQUAL>::equal_range(const KEY& key) const
+{
+    return d_impl.equal_range(key);
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+typename FlatHashMap<KEY, VALUE, HASH, EQUAL>::const_iterator
+FlatHashMap<KEY, VALUE, HASH, EQUAL>::find(const KEY& key) const
+{
+    return d_impl.find(key);
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+HASH FlatHashMap<KEY, VALUE, HASH, EQUAL>::hash_function() const
+{
+    return d_impl.hash_function();
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+EQUAL FlatHashMap<KEY, VALUE, HASH, EQUAL>::key_eq() const
+{
+    return d_impl.key_eq();
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+float FlatHashMap<KEY, VALUE, HASH, EQUAL>::load_factor() const
+{
+    return d_impl.load_factor();
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+float FlatHashMap<KEY, VALUE, HASH, EQUAL>::max_load_factor() const
+{
+    return d_impl.max_load_factor();
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+bsl::size_t FlatHashMap<KEY, VALUE, HASH, EQUAL>::size() const
+{
+    return d_impl.size();
+}
+
+                          // Iterators
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+typename FlatHashMap<KEY, VALUE, HASH, EQUAL>::const_iterator
+FlatHashMap<KEY, VALUE, HASH, EQUAL>::begin() const
+{
+    return d_impl.begin();
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+typename FlatHashMap<KEY, VALUE, HASH, EQUAL>::const_iterator
+FlatHashMap<KEY, VALUE, HASH, EQUAL>::cbegin() const
+{
+    return d_impl.begin();
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+typename FlatHashMap<KEY, VALUE, HASH, EQUAL>::const_iterator
+FlatHashMap<KEY, VALUE, HASH, EQUAL>::end() const
+{
+    return d_impl.end();
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+typename FlatHashMap<KEY, VALUE, HASH, EQUAL>::const_iterator
+FlatHashMap<KEY, VALUE, HASH, EQUAL>::cend() const
+{
+    return d_impl.end();
+}
+
+                             // Aspects
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+bslma::Allocator *FlatHashMap<KEY, VALUE, HASH, EQUAL>::allocator() const
+{
+    return d_impl.allocator();
+}
+
+}  // close package namespace
+
+// FREE OPERATORS
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+bool bdlc::operator==(const FlatHashMap<KEY, VALUE, HASH, EQUAL> &lhs,
+                      const FlatHashMap<KEY, VALUE, HASH, EQUAL> &rhs)
+{
+    return lhs.d_impl == rhs.d_impl;
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+bool bdlc::operator!=(const FlatHashMap<KEY, VALUE, HASH, EQUAL> &lhs,
+                      const FlatHashMap<KEY, VALUE, HASH, EQUAL> &rhs)
+{
+    return !(lhs == rhs);
+}
+
+// FREE FUNCTIONS
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+void bdlc::swap(FlatHashMap<KEY, VALUE, HASH, EQUAL>& a,
+                FlatHashMap<KEY, VALUE, HASH, EQUAL>& b)
+{
+    if (a.allocator() == b.allocator()) {
+        a.swap(b);
+
+        return;                                                       // RETURN
+    }
+
+    typedef FlatHashMap<KEY, VALUE, HASH, EQUAL> Map;
+
+    Map futureA(b, a.allocator());
+    Map futureB(a, b.allocator());
+
+    futureA.swap(a);
+    futureB.swap(b);
+}
+
+}  // close enterprise namespace
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2020 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
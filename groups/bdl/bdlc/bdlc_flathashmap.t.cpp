@@ -0,0 +1,1035 @@
+// bdlc_flathashmap.t.cpp                                             -*-C++-*-
+#include <bdlc_flathashmap.h>
+
+#include <bslim_testutil.h>
+
+#include <bslh_hash.h>
+
+#include <bslma_default.h>
+#include <bslma_defaultallocatorguard.h>
+#include <bslma_testallocator.h>
+#include <bslma_testallocatorexception.h>
+
+#include <bslmf_movableref.h>
+
+#include <bsls_asserttest.h>
+#include <bsls_stopwatch.h>
+#include <bsls_types.h>
+
+#include <bsl_cctype.h>
+#include <bsl_cstdlib.h>
+#include <bsl_iostream.h>
+#include <bsl_map.h>
+#include <bsl_stdexcept.h>
+#include <bsl_string.h>
+#include <bsl_unordered_map.h>
+#include <bsl_utility.h>
+#include <bsl_vector.h>
+
+using namespace BloombergLP;
+using namespace bsl;
+
+// ============================================================================
+//                             TEST PLAN
+// ----------------------------------------------------------------------------
+//                             Overview
+//                             --------
+// The component under test is a value-semantic container implemented in terms
+// of 'bdlc::FlatHashTable', which is thoroughly tested in its own component.
+// This test driver therefore concentrates on the forwarding of each method to
+// the implementation, on the map-specific methods ('operator[]' and 'at'), and
+// on the correct propagation of allocators to the keys and values.
+//
+// Negative test case -1 compares the performance of 'bdlc::FlatHashMap' with
+// that of 'bsl::unordered_map' for tables of 1K up to (by default) 1M
+// elements; a larger maximum (e.g., 100M) may be supplied on the command line.
+// ----------------------------------------------------------------------------
+// CREATORS
+// [ 2] FlatHashMap();
+// [ 2] FlatHashMap(Allocator *basicAllocator);
+// [ 2] FlatHashMap(size_t capacity);
+// [ 2] FlatHashMap(size_t capacity, Allocator *basicAllocator);
+// [ 2] FlatHashMap(size_t, const HASH&, Allocator *basicAllocator = 0);
+// [ 2] FlatHashMap(size_t, const HASH&, const EQUAL&, Allocator * = 0);
+// [ 2] FlatHashMap(INPUT_ITERATOR, INPUT_ITERATOR, Allocator * = 0);
+// [ 2] FlatHashMap(INPUT_ITERATOR, INPUT_ITERATOR, size_t, ...);
+// [ 5] FlatHashMap(const FlatHashMap&, Allocator *basicAllocator = 0);
+// [ 5] FlatHashMap(MovableRef<FlatHashMap>);
+// [ 5] FlatHashMap(MovableRef<FlatHashMap>, Allocator *);
+// [ 2] ~FlatHashMap();
+//
+// MANIPULATORS
+// [ 5] FlatHashMap& operator=(const FlatHashMap&);
+// [ 5] FlatHashMap& operator=(MovableRef<FlatHashMap>);
+// [ 3] VALUE& operator[](const KEY&);
+// [ 3] VALUE& operator[](MovableRef<KEY>);
+// [ 3] VALUE& at(const KEY&);
+// [ 4] void clear();
+// [ 4] pair<iterator, iterator> equal_range(const KEY&);
+// [ 4] size_t erase(const KEY&);
+// [ 4] iterator erase(const_iterator);
+// [ 4] iterator erase(iterator);
+// [ 4] iterator erase(const_iterator, const_iterator);
+// [ 4] iterator find(const KEY&);
+// [ 4] pair<iterator, bool> insert(const value_type&);
+// [ 4] pair<iterator, bool> insert(MovableRef<value_type>);
+// [ 4] void insert(INPUT_ITERATOR, INPUT_ITERATOR);
+// [ 4] void rehash(size_t);
+// [ 4] void reserve(size_t);
+// [ 4] void reset();
+// [ 4] iterator begin();
+// [ 4] iterator end();
+// [ 5] void swap(FlatHashMap&);
+//
+// ACCESSORS
+// [ 3] const VALUE& at(const KEY&) const;
+// [ 2] size_t capacity() const;
+// [ 4] bool contains(const KEY&) const;
+// [ 4] size_t count(const KEY&) const;
+// [ 2] bool empty() const;
+// [ 4] pair<cIter, cIter> equal_range(const KEY&) const;
+// [ 4] const_iterator find(const KEY&) const;
+// [ 2] HASH hash_function() const;
+// [ 2] EQUAL key_eq() const;
+// [ 2] float load_factor() const;
+// [ 2] float max_load_factor() const;
+// [ 2] size_t size() const;
+// [ 4] const_iterator begin() const;
+// [ 4] const_iterator cbegin() const;
+// [ 4] const_iterator end() const;
+// [ 4] const_iterator cend() const;
+// [ 2] Allocator *allocator() const;
+//
+// FREE OPERATORS
+// [ 5] bool operator==(const FlatHashMap&, const FlatHashMap&);
+// [ 5] bool operator!=(const FlatHashMap&, const FlatHashMap&);
+//
+// FREE FUNCTIONS
+// [ 5] void swap(FlatHashMap&, FlatHashMap&);
+// ----------------------------------------------------------------------------
+// [ 1] BREATHING TEST
+// [ 6] USAGE EXAMPLE
+// [-1] PERFORMANCE: comparison with 'bsl::unordered_map'
+
+// ============================================================================
+//                     STANDARD BDE ASSERT TEST FUNCTION
+// ----------------------------------------------------------------------------
+
+namespace {
+
+int testStatus = 0;
+
+void aSsErT(bool condition, const char *message, int line)
+{
+    if (condition) {
+        cout << "Error " __FILE__ "(" << line << "): " << message
+             << "    (failed)" << endl;
+
+        if (0 <= testStatus && testStatus <= 100) {
+            ++testStatus;
+        }
+    }
+}
+
+}  // close unnamed namespace
+
+// ============================================================================
+//               STANDARD BDE TEST DRIVER MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT       BSLIM_TESTUTIL_ASSERT
+#define ASSERTV      BSLIM_TESTUTIL_ASSERTV
+
+#define LOOP_ASSERT  BSLIM_TESTUTIL_LOOP_ASSERT
+#define LOOP0_ASSERT BSLIM_TESTUTIL_LOOP0_ASSERT
+#define LOOP1_ASSERT BSLIM_TESTUTIL_LOOP1_ASSERT
+#define LOOP2_ASSERT BSLIM_TESTUTIL_LOOP2_ASSERT
+#define LOOP3_ASSERT BSLIM_TESTUTIL_LOOP3_ASSERT
+#define LOOP4_ASSERT BSLIM_TESTUTIL_LOOP4_ASSERT
+#define LOOP5_ASSERT BSLIM_TESTUTIL_LOOP5_ASSERT
+#define LOOP6_ASSERT BSLIM_TESTUTIL_LOOP6_ASSERT
+
+#define Q            BSLIM_TESTUTIL_Q   // Quote identifier literally.
+#define P            BSLIM_TESTUTIL_P   // Print identifier and value.
+#define P_           BSLIM_TESTUTIL_P_  // P(X) without '\n'.
+#define T_           BSLIM_TESTUTIL_T_  // Print a tab (w/o newline).
+#define L_           BSLIM_TESTUTIL_L_  // current Line number
+
+// ============================================================================
+//                     NEGATIVE-TEST MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT_SAFE_PASS(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_PASS(EXPR)
+#define ASSERT_SAFE_FAIL(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_FAIL(EXPR)
+#define ASSERT_PASS(EXPR)      BSLS_ASSERTTEST_ASSERT_PASS(EXPR)
+#define ASSERT_FAIL(EXPR)      BSLS_ASSERTTEST_ASSERT_FAIL(EXPR)
+#define ASSERT_OPT_PASS(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_PASS(EXPR)
+#define ASSERT_OPT_FAIL(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_FAIL(EXPR)
+
+// ============================================================================
+//                  GLOBAL TYPEDEFS/CONSTANTS FOR TESTING
+// ----------------------------------------------------------------------------
+
+static bool verbose;
+static bool veryVerbose;
+static bool veryVeryVerbose;
+
+typedef bdlc::FlatHashMap<int, int>                 Obj;
+typedef bdlc::FlatHashMap<bsl::string, bsl::string> StrObj;
+
+struct IdentityHash {
+    // This hash functor returns its argument unchanged.
+
+    bsl::size_t operator()(int value) const
+    {
+        return static_cast<bsl::size_t>(value);
+    }
+};
+
+const char *const LONG_STRING = "a string long enough to require allocation";
+
+// ============================================================================
+//                     HELPER FUNCTIONS FOR TESTING
+// ----------------------------------------------------------------------------
+
+static bsl::string makeKey(int value, bslma::Allocator *allocator)
+    // Return a string that is unique for the specified 'value' and long enough
+    // to require allocation, using the specified 'allocator' to supply memory.
+{
+    bsl::string rv(LONG_STRING, allocator);
+    rv += bsl::to_string(value);
+    return rv;
+}
+
+static bsls::Types::Uint64 nextRandom(bsls::Types::Uint64 *state)
+    // Return the next value of a pseudo-random sequence and update the
+    // specified 'state' accordingly.
+{
+    // 'xorshift64*'
+
+    *state ^= *state >> 12;
+    *state ^= *state << 25;
+    *state ^= *state >> 27;
+    return *state * 2685821657736338717ULL;
+}
+
+template <class MAP>
+static void runBenchmark(const char                        *name,
+                         const bsl::vector<int>&            keys,
+                         const bsl::vector<int>&            misses)
+    // Report, for an object of the (template parameter) type 'MAP' identified
+    // by the specified 'name', the time per element to insert the specified
+    // 'keys', to look up each of the 'keys', to look up each of the specified
+    // 'misses', and to erase each of the 'keys'.
+{
+    bsls::Stopwatch timer;
+    bsl::size_t     checksum = 0;
+
+    MAP map;
+
+    timer.start();
+    for (bsl::size_t i = 0; i < keys.size(); ++i) {
+        map[keys[i]] = static_cast<int>(i);
+    }
+    timer.stop();
+    const double insertTime = timer.elapsedTime();
+
+    timer.reset();
+    timer.start();
+    for (bsl::size_t i = 0; i < keys.size(); ++i) {
+        checksum += map.find(keys[i])->second;
+    }
+    timer.stop();
+    const double hitTime = timer.elapsedTime();
+
+    timer.reset();
+    timer.start();
+    for (bsl::size_t i = 0; i < misses.size(); ++i) {
+        checksum += map.count(misses[i]);
+    }
+    timer.stop();
+    const double missTime = timer.elapsedTime();
+
+    timer.reset();
+    timer.start();
+    for (bsl::size_t i = 0; i < keys.size(); ++i) {
+        checksum += map.erase(keys[i]);
+    }
+    timer.stop();
+    const double eraseTime = timer.elapsedTime();
+
+    const double scale = 1.0e9 / static_cast<double>(keys.size());
+
+    cout << "  " << name
+         << ": insert " << insertTime * scale << " ns"
+         << ", hit "    << hitTime    * scale << " ns"
+         << ", miss "   << missTime   * scale << " ns"
+         << ", erase "  << eraseTime  * scale << " ns"
+         << "  (checksum " << checksum << ")" << endl;
+}
+
+// ============================================================================
+//                               MAIN PROGRAM
+// ----------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    int test        = argc > 1 ? atoi(argv[1]) : 0;
+    verbose         = argc > 2;
+    veryVerbose     = argc > 3;
+    veryVeryVerbose = argc > 4;
+
+    cout << "TEST " << __FILE__ << " CASE " << test << endl;
+
+    bslma::TestAllocator globalAllocator("global", veryVeryVerbose);
+    bslma::Default::setGlobalAllocator(&globalAllocator);
+
+    switch (test) { case 0:
+      case 6: {
+        // --------------------------------------------------------------------
+        // USAGE EXAMPLE
+        //   Extracted from component header file.
+        //
+        // Concerns:
+        //: 1 The usage example provided in the component header file compiles,
+        //:   links, and runs as shown.
+        //
+        // Plan:
+        //: 1 Incorporate usage example from header into test driver, remove
+        //:   leading comment characters, and replace 'assert' with 'ASSERT'.
+        //:   (C-1)
+        //
+        // Testing:
+        //   USAGE EXAMPLE
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "USAGE EXAMPLE" << endl
+                          << "=============" << endl;
+
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Gathering Document Statistics
+///- - - - - - - - - - - - - - - - - - - -
+// Suppose one wished to gather statistics on the words appearing in a large
+// set of documents on disk or in a database.  Gathering those statistics is
+// intrusive (as one is competing for access to the documents with the regular
+// users) and must be done as quickly as possible.  Moreover, the set of unique
+// words appearing in those documents may be high.  The English language has
+// in excess of a million words (albeit many appear infrequently), and, if the
+// documents contain serial numbers, or Social Security numbers, or chemical
+// formulas, etc., then the 'O[log(n)]' insertion time of ordered maps may well
+// be inadequate.  An unordered map, having an 'O[1]' typical insertion cost,
+// is a viable alternative, and a flat (open-addressed) map further avoids a
+// memory allocation per unique word.
+//
+// First, we define the type of the map, mapping each word to the number of
+// times it has been seen:
+//..
+    typedef bdlc::FlatHashMap<bsl::string, int> WordTally;
+//..
+// Then, we define some documents to be processed:
+//..
+    const char *documents[] = {
+      "Lorem ipsum dolor sit amet, consectetur adipiscing elit.",
+      "Mauris ut massa ipsum, dolor sit amet.",
+      "Sit amet consectetur ipsum."
+    };
+    const int numDocuments = sizeof documents / sizeof *documents;
+//..
+// Next, we tally the words, ignoring punctuation, using 'operator[]' to
+// default-construct a count for each word seen for the first time:
+//..
+    WordTally tally;
+
+    for (int i = 0; i < numDocuments; ++i) {
+        bsl::string       word;
+        const char       *p = documents[i];
+
+        for (; ; ++p) {
+            if (bsl::isalpha(static_cast<unsigned char>(*p))) {
+                word.push_back(static_cast<char>(
+                            bsl::tolower(static_cast<unsigned char>(*p))));
+            }
+            else {
+                if (!word.empty()) {
+                    ++tally[word];
+                    word.clear();
+                }
+                if (0 == *p) {
+                    break;
+                }
+            }
+        }
+    }
+//..
+// Finally, we verify the tally of a few words:
+//..
+    ASSERT(3 == tally["ipsum"]);
+    ASSERT(3 == tally["sit"]);
+    ASSERT(1 == tally["lorem"]);
+    ASSERT(2 == tally["consectetur"]);
+    ASSERT(tally.end() == tally.find("not-present"));
+//..
+      } break;
+      case 5: {
+        // --------------------------------------------------------------------
+        // TESTING VALUE SEMANTICS
+        //
+        // Concerns:
+        //: 1 The copy and move constructors produce an object having the value
+        //:   of the original and using the intended allocator.
+        //:
+        //: 2 Copy and move assignment produce an object having the value of
+        //:   the source and retaining the allocator of the target.
+        //:
+        //: 3 The equality operators compare keys and values, irrespective of
+        //:   insertion order.
+        //:
+        //: 4 The member 'swap' exchanges values without allocation, and the
+        //:   free 'swap' exchanges values of objects using different
+        //:   allocators.
+        //
+        // Plan:
+        //: 1 Create objects of various sizes and verify the results of each
+        //:   operation and the use of the allocators.  (C-1..4)
+        //
+        // Testing:
+        //   FlatHashMap(const FlatHashMap&, Allocator *basicAllocator = 0);
+        //   FlatHashMap(MovableRef<FlatHashMap>);
+        //   FlatHashMap(MovableRef<FlatHashMap>, Allocator *);
+        //   FlatHashMap& operator=(const FlatHashMap&);
+        //   FlatHashMap& operator=(MovableRef<FlatHashMap>);
+        //   void swap(FlatHashMap&);
+        //   bool operator==(const FlatHashMap&, const FlatHashMap&);
+        //   bool operator!=(const FlatHashMap&, const FlatHashMap&);
+        //   void swap(FlatHashMap&, FlatHashMap&);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "TESTING VALUE SEMANTICS" << endl
+                          << "=======================" << endl;
+
+        bslma::TestAllocator da("default",  veryVeryVerbose);
+        bslma::TestAllocator sa("supplied", veryVeryVerbose);
+        bslma::TestAllocator oa("other",    veryVeryVerbose);
+        bslma::TestAllocator scratch("scratch", veryVeryVerbose);
+
+        bslma::DefaultAllocatorGuard dag(&da);
+
+        static const int SIZES[] = { 0, 1, 2, 14, 15, 100 };
+        const int NUM_SIZES = static_cast<int>(sizeof SIZES / sizeof *SIZES);
+
+        for (int ti = 0; ti < NUM_SIZES; ++ti) {
+            const int SIZE = SIZES[ti];
+
+            StrObj mX(&sa);  const StrObj& X = mX;
+            StrObj mY(&sa);  const StrObj& Y = mY;
+
+            for (int i = 0; i < SIZE; ++i) {
+                mX[makeKey(i, &scratch)] = makeKey(-i, &scratch);
+            }
+            for (int i = SIZE - 1; i >= 0; --i) {
+                mY[makeKey(i, &scratch)] = makeKey(-i, &scratch);
+            }
+            ASSERTV(SIZE, X == Y);
+            ASSERTV(SIZE, !(X != Y));
+
+            if (SIZE) {
+                mY[makeKey(0, &scratch)] = makeKey(1, &scratch);
+                ASSERTV(SIZE, X != Y);
+                mY[makeKey(0, &scratch)] = makeKey(0, &scratch);
+                ASSERTV(SIZE, X == Y);
+            }
+
+            {
+                const StrObj Z(X, &oa);
+                ASSERTV(SIZE, X == Z);
+                ASSERTV(SIZE, &oa == Z.allocator());
+
+                for (StrObj::const_iterator it = Z.begin();
+                                                        it != Z.end(); ++it) {
+                    ASSERTV(SIZE, &oa == it->first.get_allocator());
+                    ASSERTV(SIZE, &oa == it->second.get_allocator());
+                }
+            }
+            ASSERTV(SIZE, 0 == oa.numBlocksInUse());
+
+            {
+                StrObj mZ(X);
+                ASSERTV(SIZE, X == mZ);
+                ASSERTV(SIZE, &da == mZ.allocator());
+            }
+            ASSERTV(SIZE, 0 == da.numBlocksInUse());
+
+            {
+                StrObj mZ(X, &sa);
+                const bsls::Types::Int64 NUM_BLOCKS = sa.numBlocksTotal();
+
+                StrObj mW(bslmf::MovableRefUtil::move(mZ));
+                ASSERTV(SIZE, NUM_BLOCKS == sa.numBlocksTotal());
+                ASSERTV(SIZE, X == mW);
+                ASSERTV(SIZE, &sa == mW.allocator());
+
+                StrObj mV(bslmf::MovableRefUtil::move(mW), &oa);
+                ASSERTV(SIZE, X == mV);
+                ASSERTV(SIZE, &oa == mV.allocator());
+            }
+            ASSERTV(SIZE, 0 == oa.numBlocksInUse());
+
+            {
+                StrObj mZ(&oa);
+                mZ[makeKey(-1, &scratch)];
+
+                mZ = X;
+                ASSERTV(SIZE, X == mZ);
+                ASSERTV(SIZE, &oa == mZ.allocator());
+
+                StrObj mW(X, &sa);
+                mZ.clear();
+                mZ = bslmf::MovableRefUtil::move(mW);
+                ASSERTV(SIZE, X == mZ);
+                ASSERTV(SIZE, &oa == mZ.allocator());
+
+                StrObj mV(&sa);
+                mV[makeKey(-1, &scratch)];
+                const StrObj V(mV, &scratch);
+
+                const bsls::Types::Int64 NUM_BLOCKS = sa.numBlocksTotal();
+                mV.swap(mY);
+                ASSERTV(SIZE, NUM_BLOCKS == sa.numBlocksTotal());
+                ASSERTV(SIZE, X == mV);
+                ASSERTV(SIZE, V == mY);
+                mV.swap(mY);
+
+                bdlc::swap(mV, mZ);
+                ASSERTV(SIZE, X == mV);
+                ASSERTV(SIZE, V == mZ);
+                ASSERTV(SIZE, &sa == mV.allocator());
+                ASSERTV(SIZE, &oa == mZ.allocator());
+            }
+            ASSERTV(SIZE, 0 == oa.numBlocksInUse());
+        }
+        ASSERTV(0 == sa.numBlocksInUse());
+        ASSERTV(0 == da.numBlocksInUse());
+      } break;
+      case 4: {
+        // --------------------------------------------------------------------
+        // TESTING FORWARDING MANIPULATORS AND ACCESSORS
+        //
+        // Concerns:
+        //: 1 Each method forwards to the implementation as documented.
+        //:
+        //: 2 'insert' does not modify the value of an existing element.
+        //:
+        //: 3 Iteration visits each element exactly once.
+        //
+        // Plan:
+        //: 1 Apply a pseudo-random sequence of operations to an object and to
+        //:   a 'bsl::map' oracle, and verify that they agree.  (C-1..3)
+        //
+        // Testing:
+        //   void clear();
+        //   pair<iterator, iterator> equal_range(const KEY&);
+        //   size_t erase(const KEY&);
+        //   iterator erase(const_iterator);
+        //   iterator erase(iterator);
+        //   iterator erase(const_iterator, const_iterator);
+        //   iterator find(const KEY&);
+        //   pair<iterator, bool> insert(const value_type&);
+        //   pair<iterator, bool> insert(MovableRef<value_type>);
+        //   void insert(INPUT_ITERATOR, INPUT_ITERATOR);
+        //   void rehash(size_t);
+        //   void reserve(size_t);
+        //   void reset();
+        //   iterator begin();
+        //   iterator end();
+        //   bool contains(const KEY&) const;
+        //   size_t count(const KEY&) const;
+        //   pair<cIter, cIter> equal_range(const KEY&) const;
+        //   const_iterator find(const KEY&) const;
+        //   const_iterator begin() const;
+        //   const_iterator cbegin() const;
+        //   const_iterator end() const;
+        //   const_iterator cend() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                 << "TESTING FORWARDING MANIPULATORS AND ACCESSORS" << endl
+                 << "=============================================" << endl;
+
+        bslma::TestAllocator da("default",  veryVeryVerbose);
+        bslma::TestAllocator sa("supplied", veryVeryVerbose);
+
+        bslma::DefaultAllocatorGuard dag(&da);
+
+        {
+            Obj mX(&sa);  const Obj& X = mX;
+
+            bsl::map<int, int>  oracle(&sa);
+            bsls::Types::Uint64 state = 0x123456789ULL;
+
+            for (int op = 0; op < 20000; ++op) {
+                const bsls::Types::Uint64 r = nextRandom(&state);
+                const int key   = static_cast<int>(r % 3000);
+                const int value = static_cast<int>((r >> 32) % 1000);
+
+                switch ((r >> 20) % 5) {
+                  case 0: {
+                    const Obj::value_type ENTRY(key, value);
+                    const bool EXP = oracle.insert(ENTRY).second;
+                    bsl::pair<Obj::iterator, bool> rv = mX.insert(ENTRY);
+                    ASSERTV(op, EXP == rv.second);
+                    ASSERTV(op, oracle[key] == rv.first->second);
+                  } break;
+                  case 1: {
+                    Obj::value_type entry(key, value);
+                    const bool EXP = oracle.insert(entry).second;
+                    bsl::pair<Obj::iterator, bool> rv = mX.insert(
+                                         bslmf::MovableRefUtil::move(entry));
+                    ASSERTV(op, EXP == rv.second);
+                    ASSERTV(op, oracle[key] == rv.first->second);
+                  } break;
+                  case 2: {
+                    ASSERTV(op, oracle.erase(key) == mX.erase(key));
+                  } break;
+                  case 3: {
+                    Obj::iterator it = mX.find(key);
+                    if (it != mX.end()) {
+                        oracle.erase(key);
+                        mX.erase(it);
+                    }
+                  } break;
+                  default: {
+                    const bool EXP = 0 != oracle.count(key);
+                    ASSERTV(op, EXP == X.contains(key));
+                    ASSERTV(op, EXP == (1 == X.count(key)));
+                    ASSERTV(op, EXP == (X.find(key) != X.end()));
+
+                    bsl::pair<Obj::iterator, Obj::iterator> range =
+                                                          mX.equal_range(key);
+                    bsl::pair<Obj::const_iterator, Obj::const_iterator>
+                                                 cRange = X.equal_range(key);
+                    ASSERTV(op, EXP == (range.first  != range.second));
+                    ASSERTV(op, EXP == (cRange.first != cRange.second));
+                    if (EXP) {
+                        ASSERTV(op, oracle[key] == range.first->second);
+                    }
+                  } break;
+                }
+            }
+
+            ASSERT(oracle.size() == X.size());
+
+            bsl::size_t numIterated = 0;
+            for (Obj::const_iterator it = X.cbegin(); it != X.cend(); ++it) {
+                ASSERTV(it->first, oracle[it->first] == it->second);
+                ++numIterated;
+            }
+            ASSERT(oracle.size() == numIterated);
+
+            const Obj Y(oracle.begin(), oracle.end(), &sa);
+            ASSERT(X == Y);
+
+            Obj mZ(&sa);
+            mZ.insert(oracle.begin(), oracle.end());
+            ASSERT(X == mZ);
+
+            mZ.erase(mZ.begin(), mZ.end());
+            ASSERT(mZ.empty());
+
+            mX.reserve(10000);
+            ASSERT(X.capacity() >= 10000);
+            ASSERT(X == Y);
+
+            mX.rehash(1 << 16);
+            ASSERT(1 << 16 == X.capacity());
+            ASSERT(X == Y);
+
+            const bsl::size_t CAPACITY = X.capacity();
+            mX.clear();
+            ASSERT(X.empty());
+            ASSERT(CAPACITY == X.capacity());
+            ASSERT(X.begin() == X.end());
+
+            mX.reset();
+            ASSERT(0 == X.capacity());
+        }
+        ASSERT(0 == sa.numBlocksInUse());
+        ASSERT(0 == da.numBlocksTotal());
+      } break;
+      case 3: {
+        // --------------------------------------------------------------------
+        // TESTING 'operator[]' AND 'at'
+        //
+        // Concerns:
+        //: 1 'operator[]' inserts a value-initialized value for a key not
+        //:   present, and returns a reference to the existing value otherwise.
+        //:
+        //: 2 The inserted key and value use the allocator of the map.
+        //:
+        //: 3 'operator[]' taking a movable reference moves the key only when
+        //:   it is inserted.
+        //:
+        //: 4 'at' returns the value for a present key and throws
+        //:   'std::out_of_range' otherwise.
+        //:
+        //: 5 'operator[]' provides the strong exception guarantee.
+        //
+        // Plan:
+        //: 1 Use 'operator[]' and 'at' on maps of 'int' and 'bsl::string'
+        //:   keys, verifying values and allocators, including within the
+        //:   'bslma' exception test macros.  (C-1..5)
+        //
+        // Testing:
+        //   VALUE& operator[](const KEY&);
+        //   VALUE& operator[](MovableRef<KEY>);
+        //   VALUE& at(const KEY&);
+        //   const VALUE& at(const KEY&) const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "TESTING 'operator[]' AND 'at'" << endl
+                          << "=============================" << endl;
+
+        bslma::TestAllocator da("default",  veryVeryVerbose);
+        bslma::TestAllocator sa("supplied", veryVeryVerbose);
+        bslma::TestAllocator scratch("scratch", veryVeryVerbose);
+
+        bslma::DefaultAllocatorGuard dag(&da);
+
+        {
+            Obj mX(&sa);  const Obj& X = mX;
+
+            for (int i = 0; i < 100; ++i) {
+                ASSERTV(i, 0 == mX[i]);
+                mX[i] = i * i;
+            }
+            for (int i = 0; i < 100; ++i) {
+                ASSERTV(i, i * i == mX[i]);
+                ASSERTV(i, i * i == mX.at(i));
+                ASSERTV(i, i * i == X.at(i));
+            }
+            ASSERT(100 == X.size());
+
+#if defined(BDE_BUILD_TARGET_EXC)
+            bool caught = false;
+            try {
+                X.at(100);
+            }
+            catch (const std::out_of_range&) {
+                caught = true;
+            }
+            ASSERT(caught);
+
+            caught = false;
+            try {
+                mX.at(-1);
+            }
+            catch (const std::out_of_range&) {
+                caught = true;
+            }
+            ASSERT(caught);
+            ASSERT(100 == X.size());
+#endif
+        }
+
+        {
+            StrObj mX(&sa);  const StrObj& X = mX;
+
+            for (int i = 0; i < 40; ++i) {
+                const bsl::string KEY = makeKey(i, &scratch);
+
+                BSLMA_TESTALLOCATOR_EXCEPTION_TEST_BEGIN(sa) {
+                    ASSERTV(i, static_cast<bsl::size_t>(i) == X.size());
+
+                    mX[KEY];
+                } BSLMA_TESTALLOCATOR_EXCEPTION_TEST_END
+
+                mX[KEY] = KEY;
+
+                StrObj::const_iterator it = X.find(KEY);
+                ASSERTV(i, it != X.end());
+                ASSERTV(i, &sa == it->first.get_allocator());
+                ASSERTV(i, &sa == it->second.get_allocator());
+                ASSERTV(i, KEY == X.at(KEY));
+            }
+
+            bsl::string key = makeKey(0, &sa);
+            mX[bslmf::MovableRefUtil::move(key)] = "zero";
+            ASSERT(makeKey(0, &scratch) == key);
+            ASSERT("zero" == X.at(key));
+
+            key = makeKey(100, &sa);
+            const bsl::string EXP(key, &scratch);
+            const char *const DATA = key.data();
+
+            mX[bslmf::MovableRefUtil::move(key)] = "hundred";
+            const StrObj::const_iterator it = X.find(EXP);
+            ASSERT(it != X.end());
+            ASSERT(DATA == it->first.data());
+            ASSERT("hundred" == it->second);
+        }
+        ASSERT(0 == sa.numBlocksInUse());
+        ASSERT(0 == da.numBlocksTotal());
+      } break;
+      case 2: {
+        // --------------------------------------------------------------------
+        // TESTING CONSTRUCTORS AND BASIC ACCESSORS
+        //
+        // Concerns:
+        //: 1 Each constructor creates an object having the specified capacity
+        //:   (rounded to a valid capacity), hasher, equality functor, and
+        //:   allocator.
+        //:
+        //: 2 The range constructors insert the elements of the range, keeping
+        //:   the first element for duplicate keys.
+        //:
+        //: 3 The basic accessors reflect the state of the object.
+        //
+        // Plan:
+        //: 1 Create objects with each constructor and verify the state of the
+        //:   objects and the use of the allocators.  (C-1..3)
+        //
+        // Testing:
+        //   FlatHashMap();
+        //   FlatHashMap(Allocator *basicAllocator);
+        //   FlatHashMap(size_t capacity);
+        //   FlatHashMap(size_t capacity, Allocator *basicAllocator);
+        //   FlatHashMap(size_t, const HASH&, Allocator *basicAllocator = 0);
+        //   FlatHashMap(size_t, const HASH&, const EQUAL&, Allocator * = 0);
+        //   FlatHashMap(INPUT_ITERATOR, INPUT_ITERATOR, Allocator * = 0);
+        //   FlatHashMap(INPUT_ITERATOR, INPUT_ITERATOR, size_t, ...);
+        //   ~FlatHashMap();
+        //   size_t capacity() const;
+        //   bool empty() const;
+        //   HASH hash_function() const;
+        //   EQUAL key_eq() const;
+        //   float load_factor() const;
+        //   float max_load_factor() const;
+        //   size_t size() const;
+        //   Allocator *allocator() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                      << "TESTING CONSTRUCTORS AND BASIC ACCESSORS" << endl
+                      << "========================================" << endl;
+
+        bslma::TestAllocator da("default",  veryVeryVerbose);
+        bslma::TestAllocator sa("supplied", veryVeryVerbose);
+
+        bslma::DefaultAllocatorGuard dag(&da);
+
+        typedef bdlc::FlatHashMap<int, int, IdentityHash> IdObj;
+
+        {
+            const Obj X;
+            ASSERT(&da == X.allocator());
+            ASSERT(0 == X.capacity());
+            ASSERT(X.empty());
+            ASSERT(0 == X.size());
+            ASSERT(0.0f == X.load_factor());
+            ASSERT(0.875f == X.max_load_factor());
+            ASSERT(0 == da.numBlocksTotal());
+        }
+        {
+            const Obj X(&sa);
+            ASSERT(&sa == X.allocator());
+            ASSERT(0 == X.capacity());
+            ASSERT(0 == sa.numBlocksTotal());
+        }
+        {
+            const Obj X(20);
+            ASSERT(&da == X.allocator());
+            ASSERT(32 == X.capacity());
+            ASSERT(0 < da.numBlocksInUse());
+        }
+        ASSERT(0 == da.numBlocksInUse());
+        {
+            const Obj X(16, &sa);
+            ASSERT(&sa == X.allocator());
+            ASSERT(16 == X.capacity());
+            ASSERT(0 < sa.numBlocksInUse());
+        }
+        ASSERT(0 == sa.numBlocksInUse());
+        {
+            const IdObj X(0, IdentityHash(), &sa);
+            ASSERT(&sa == X.allocator());
+            ASSERT(7 == X.hash_function()(7));
+        }
+        {
+            const IdObj X(64, IdentityHash(), bsl::equal_to<int>(), &sa);
+            ASSERT(&sa == X.allocator());
+            ASSERT(64 == X.capacity());
+            ASSERT(X.key_eq()(5, 5));
+            ASSERT(!X.key_eq()(5, 6));
+        }
+        {
+            const Obj::value_type DATA[] = {
+                Obj::value_type(1, 10),
+                Obj::value_type(2, 20),
+                Obj::value_type(1, 30),
+                Obj::value_type(3, 40),
+            };
+            const Obj::value_type *const END = DATA + sizeof DATA
+                                                    / sizeof *DATA;
+
+            const Obj X(DATA, END, &sa);
+            ASSERT(&sa == X.allocator());
+            ASSERT(3 == X.size());
+            ASSERT(10 == X.at(1));
+            ASSERT(20 == X.at(2));
+            ASSERT(40 == X.at(3));
+            ASSERT(X.load_factor() > 0.0f);
+
+            const IdObj Y(DATA,
+                          END,
+                          100,
+                          IdentityHash(),
+                          bsl::equal_to<int>(),
+                          &sa);
+            ASSERT(&sa == Y.allocator());
+            ASSERT(128 == Y.capacity());
+            ASSERT(3 == Y.size());
+            ASSERT(10 == Y.at(1));
+        }
+        ASSERT(0 == sa.numBlocksInUse());
+        ASSERT(0 == da.numBlocksInUse());
+      } break;
+      case 1: {
+        // --------------------------------------------------------------------
+        // BREATHING TEST
+        //   This case exercises (but does not fully test) basic functionality.
+        //
+        // Concerns:
+        //: 1 The class is sufficiently functional to enable comprehensive
+        //:   testing in subsequent test cases.
+        //
+        // Plan:
+        //: 1 Create an object, insert, find, and erase elements.  (C-1)
+        //
+        // Testing:
+        //   BREATHING TEST
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "BREATHING TEST" << endl
+                          << "==============" << endl;
+
+        bslma::TestAllocator da("default",  veryVeryVerbose);
+        bslma::TestAllocator sa("supplied", veryVeryVerbose);
+
+        bslma::DefaultAllocatorGuard dag(&da);
+
+        {
+            Obj mX(&sa);  const Obj& X = mX;
+
+            ASSERT(X.empty());
+
+            ASSERT(mX.insert(Obj::value_type(1, 2)).second);
+            ASSERT(!mX.insert(Obj::value_type(1, 3)).second);
+            ASSERT(2 == X.at(1));
+
+            mX[5] = 6;
+            ASSERT(2 == X.size());
+            ASSERT(6 == X.find(5)->second);
+
+            ASSERT(1 == mX.erase(1));
+            ASSERT(!X.contains(1));
+            ASSERT(1 == X.size());
+
+            Obj mY(X, &sa);
+            ASSERT(X == mY);
+            mY[7];
+            ASSERT(X != mY);
+        }
+        ASSERT(0 == sa.numBlocksInUse());
+        ASSERT(0 == da.numBlocksTotal());
+      } break;
+      case -1: {
+        // --------------------------------------------------------------------
+        // PERFORMANCE: COMPARISON WITH 'bsl::unordered_map'
+        //
+        // Concerns:
+        //: 1 'bdlc::FlatHashMap' insertion and lookup are faster than those of
+        //:   'bsl::unordered_map' across table sizes from those fitting in L1
+        //:   cache to those far exceeding the last-level cache.
+        //
+        // Plan:
+        //: 1 For table sizes increasing by a factor of 10 from 1K to a maximum
+        //:   (1M by default; the second command-line argument, if numeric,
+        //:   overrides it, e.g., '100000000'), time the insertion, successful
+        //:   lookup, unsuccessful lookup, and erasure of pseudo-random keys in
+        //:   both containers, and report the time per operation.  Note that
+        //:   the keys and the lookup order are random, so that the larger
+        //:   tables exhibit the cost of cache misses.  (C-1)
+        //
+        // Testing:
+        //   PERFORMANCE: comparison with 'bsl::unordered_map'
+        // --------------------------------------------------------------------
+
+        cout << endl
+             << "PERFORMANCE: COMPARISON WITH 'bsl::unordered_map'" << endl
+             << "=================================================" << endl;
+
+        bsl::size_t maxSize = 1000000;
+        if (argc > 2 && 0 < atoi(argv[2])) {
+            maxSize = static_cast<bsl::size_t>(atoi(argv[2]));
+        }
+
+        typedef bdlc::FlatHashMap<int, int>                FlatMap;
+        typedef bsl::unordered_map<int, int, bslh::Hash<> > NodeMap;
+
+        for (bsl::size_t size = 1000; size <= maxSize; size *= 10) {
+            bsl::vector<int>    keys(size);
+            bsl::vector<int>    misses(size);
+            bsls::Types::Uint64 state = 0x9E3779B97F4A7C15ULL;
+
+            // Use the sign bit to partition the keys from the misses.
+
+            for (bsl::size_t i = 0; i < size; ++i) {
+                keys[i]   = static_cast<int>(nextRandom(&state) & 0x7FFFFFFF);
+                misses[i] = static_cast<int>(nextRandom(&state) | 0x80000000);
+            }
+
+            cout << "size " << size << endl;
+
+            runBenchmark<FlatMap>("bdlc::FlatHashMap  ", keys, misses);
+            runBenchmark<NodeMap>("bsl::unordered_map ", keys, misses);
+        }
+      } break;
+      default: {
+        cerr << "WARNING: CASE `" << test << "' NOT FOUND." << endl;
+        testStatus = -1;
+      }
+    }
+
+    // CONCERN: In no case does memory come from the global allocator.
+
+    ASSERTV(globalAllocator.numBlocksTotal(),
+            0 == globalAllocator.numBlocksTotal());
+
+    if (testStatus > 0) {
+        cerr << "Error, non-zero test status = " << testStatus << "." << endl;
+    }
+
+    return testStatus;
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2020 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
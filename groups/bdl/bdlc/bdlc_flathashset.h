@@ -0,0 +1,816 @@
+// bdlc_flathashset.h                                                 -*-C++-*-
+#ifndef INCLUDED_BDLC_FLATHASHSET
+#define INCLUDED_BDLC_FLATHASHSET
+
+#include <bsls_ident.h>
+BSLS_IDENT("$Id: $")
+
+//@PURPOSE: Provide an open-addressed unordered set container.
+//
+//@CLASSES:
+//  bdlc::FlatHashSet: open-addressed unordered set container
+//  bdlc::FlatHashSet_EntryUtil: 'bdlc::FlatHashTable' entry utility
+//
+//@SEE_ALSO: bdlc_flathashtable, bdlc_flathashmap
+//
+//@DESCRIPTION: This component defines a single class template,
+// 'bdlc::FlatHashSet', that implements an open-addressed unordered set of
+// items with unique values.  The interface follows that of
+// 'bsl::unordered_set' where the semantics of open addressing permit.
+//
+// The implementation (see 'bdlc_flathashtable') stores the elements of the
+// set in place in a single contiguous array, and locates an element by
+// examining, sixteen at a time, one-byte control values holding seven bits of
+// the hash of each element.  Compared to 'bsl::unordered_set', which
+// allocates a node per element and follows a linked list on each lookup,
+// 'bdlc::FlatHashSet' performs no per-element allocation and typically incurs
+// a single cache miss per lookup, at the cost of invalidating references to
+// elements on rehash.
+//
+// By default the set uses 'bslh::Hash<>' to hash elements.  Any hash functor
+// may be supplied: the table mixes the hash values it receives, so a hash
+// function with poor distribution in some bits (e.g., 'bsl::hash<int>') does
+// not lead to excessive collisions.
+//
+///Iterator, Pointer, and Reference Invalidation
+///---------------------------------------------
+// Any change in capacity (by 'rehash', 'reserve', or an insertion that grows
+// the set) invalidates all iterators, pointers, and references to elements.
+// Erasing an element invalidates iterators, pointers, and references to that
+// element only.
+//
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Categorizing Data
+/// - - - - - - - - - - - - - -
+// Suppose one is analyzing data on a set of customers, and each customer is
+// categorized by several attributes: customer type, geographic area, and
+// (internal) project code; and that each attribute takes on one of a limited
+// set of values.  We wish to determine the number of distinct projects that
+// appear in a large set of customer records.
+//
+// First, we define the set type and some (abbreviated) project codes:
+//..
+//  typedef bdlc::FlatHashSet<int> ProjectSet;
+//
+//  const int codes[] = { 17, 4, 17, 99, 4, 4, 23, 17, 99 };
+//  const int numCodes = sizeof codes / sizeof *codes;
+//..
+// Then, we insert each code, noting whether it was newly inserted:
+//..
+//  ProjectSet projects;
+//  int        numNew = 0;
+//
+//  for (int i = 0; i < numCodes; ++i) {
+//      if (projects.insert(codes[i]).second) {
+//          ++numNew;
+//      }
+//  }
+//..
+// Finally, we verify the number of distinct projects:
+//..
+//  assert(4 == numNew);
+//  assert(4 == projects.size());
+//  assert(projects.contains(23));
+//  assert(!projects.contains(5));
+//..
+
+#include <bdlscm_version.h>
+
+#include <bdlc_flathashtable.h>
+
+#include <bslh_hash.h>
+
+#include <bslma_allocator.h>
+#include <bslma_constructionutil.h>
+#include <bslma_usesbslmaallocator.h>
+
+#include <bslmf_movableref.h>
+#include <bslmf_nestedtraitdeclaration.h>
+
+#include <bsls_assert.h>
+#include <bsls_compilerfeatures.h>
+
+#include <bsl_cstddef.h>
+#include <bsl_functional.h>
+#include <bsl_utility.h>
+
+namespace BloombergLP {
+namespace bdlc {
+
+                       // ============================
+                       // struct FlatHashSet_EntryUtil
+                       // ============================
+
+template <class ENTRY>
+struct FlatHashSet_EntryUtil {
+    // This templated utility provides methods to construct an 'ENTRY' and a
+    // method to extract the key from an 'ENTRY' (which is the entry itself),
+    // as required by 'bdlc::FlatHashTable'.
+
+    // CLASS METHODS
+    template <class ENTRY_TYPE>
+    static void construct(
+                   ENTRY                                         *entry,
+                   bslma::Allocator                              *allocator,
+                   BSLS_COMPILERFEATURES_FORWARD_REF(ENTRY_TYPE)  source)
+        // Create an entry at the specified 'entry' address from the specified
+        // 'source' using the specified 'allocator' to supply memory.
+    {
+        BSLS_ASSERT_SAFE(entry);
+
+        bslma::ConstructionUtil::construct(
+                             entry,
+                             allocator,
+                            BSLS_COMPILERFEATURES_FORWARD(ENTRY_TYPE, source));
+    }
+
+    template <class KEY_TYPE>
+    static void constructFromKey(
+                     ENTRY                                       *entry,
+                     bslma::Allocator                            *allocator,
+                     BSLS_COMPILERFEATURES_FORWARD_REF(KEY_TYPE)  key)
+        // Create an entry at the specified 'entry' address from the specified
+        // 'key' using the specified 'allocator' to supply memory.
+    {
+        BSLS_ASSERT_SAFE(entry);
+
+        bslma::ConstructionUtil::construct(
+                                 entry,
+                                 allocator,
+                                 BSLS_COMPILERFEATURES_FORWARD(KEY_TYPE, key));
+    }
+
+    static const ENTRY& key(const ENTRY& entry)
+        // Return the specified 'entry'.
+    {
+        return entry;
+    }
+};
+
+                            // =================
+                            // class FlatHashSet
+                            // =================
+
+template <class KEY,
+          class HASH  = bslh::Hash<>,
+          class EQUAL = bsl::equal_to<KEY> >
+class FlatHashSet {
+    // This class template implements a value-semantic container type holding
+    // an unordered set of unique values (of template parameter type 'KEY').
+    // The elements are stored in place in an open-addressed table (see
+    // 'bdlc_flathashtable').
+
+    // PRIVATE TYPES
+    typedef FlatHashTable<KEY,
+                          KEY,
+                          FlatHashSet_EntryUtil<KEY>,
+                          HASH,
+                          EQUAL> ImplType;
+        // This is the underlying implementation class.
+
+    // FRIENDS
+    template <class K, class H, class E>
+    friend bool operator==(const FlatHashSet<K, H, E>&,
+                           const FlatHashSet<K, H, E>&);
+
+  public:
+    // TYPES
+    typedef KEY                                      key_type;
+    typedef KEY                                      value_type;
+    typedef bsl::size_t                              size_type;
+    typedef bsl::ptrdiff_t                           difference_type;
+    typedef EQUAL                                    key_equal;
+    typedef HASH                                     hasher;
+    typedef value_type&                              reference;
+    typedef const value_type&                        const_reference;
+    typedef value_type                              *pointer;
+    typedef const value_type                        *const_pointer;
+    typedef typename ImplType::const_iterator        iterator;
+    typedef typename ImplType::const_iterator        const_iterator;
+
+  private:
+    // DATA
+    ImplType d_impl;  // underlying flat hash table used by this flat hash set
+
+  public:
+    // TRAITS
+    BSLMF_NESTED_TRAIT_DECLARATION(FlatHashSet, bslma::UsesBslmaAllocator);
+
+    // CREATORS
+    FlatHashSet();
+    explicit FlatHashSet(bslma::Allocator *basicAllocator);
+    explicit FlatHashSet(bsl::size_t capacity);
+    FlatHashSet(bsl::size_t capacity, bslma::Allocator *basicAllocator);
+    FlatHashSet(bsl::size_t       capacity,
+                const HASH&       hash,
+                bslma::Allocator *basicAllocator = 0);
+    FlatHashSet(bsl::size_t       capacity,
+                const HASH&       hash,
+                const EQUAL&      equal,
+                bslma::Allocator *basicAllocator = 0);
+        // Create an empty 'FlatHashSet' object.  Optionally specify a
+        // 'capacity' indicating the minimum initial number of slots.  If
+        // 'capacity' is not supplied or is 0, no memory is allocated.
+        // Optionally specify a 'hash' used to generate the hash values for the
+        // elements.  If 'hash' is not supplied, a default-constructed object
+        // of the (template parameter) type 'HASH' is used.  Optionally specify
+        // an equality functor 'equal' used to verify that two elements are
+        // equivalent.  If 'equal' is not supplied, a default-constructed
+        // object of the (template parameter) type 'EQUAL' is used.  Optionally
+        // specify a 'basicAllocator' used to supply memory.  If
+        // 'basicAllocator' is not supplied or is 0, the currently installed
+        // default allocator is used.
+
+    template <class INPUT_ITERATOR>
+    FlatHashSet(INPUT_ITERATOR    first,
+                INPUT_ITERATOR    last,
+                bslma::Allocator *basicAllocator = 0);
+        // Create a 'FlatHashSet' object initialized by insertion of the values
+        // from the input iterator range specified by 'first' through 'last'
+        // (including 'first', excluding 'last').  Optionally specify a
+        // 'basicAllocator' used to supply memory.  If 'basicAllocator' is not
+        // supplied or is 0, the currently installed default allocator is
+        // used.  The behavior is undefined unless 'first' and 'last' refer to
+        // a sequence of valid values where 'first' is at a position at or
+        // before 'last'.
+
+    FlatHashSet(const FlatHashSet&  original,
+                bslma::Allocator   *basicAllocator = 0);
+        // Create a 'FlatHashSet' object having the same value, hasher, and
+        // equality comparator as the specified 'original' object.  Optionally
+        // specify a 'basicAllocator' used to supply memory.  If
+        // 'basicAllocator' is not specified or is 0, the currently installed
+        // default allocator is used.
+
+    FlatHashSet(bslmf::MovableRef<FlatHashSet> original);
+        // Create a 'FlatHashSet' object having the same value, hasher,
+        // equality comparator, and allocator as the specified 'original'
+        // object.  The value of 'original' becomes unspecified but valid, and
+        // its allocator remains unchanged.
+
+    FlatHashSet(bslmf::MovableRef<FlatHashSet>  original,
+                bslma::Allocator               *basicAllocator);
+        // Create a 'FlatHashSet' object having the same value, hasher, and
+        // equality comparator as the specified 'original' object, using the
+        // specified 'basicAllocator' to supply memory.  If 'basicAllocator' is
+        // 0, the currently installed default allocator is used.  The value of
+        // 'original' becomes unspecified but valid, and its allocator remains
+        // unchanged.
+
+    ~FlatHashSet();
+        // Destroy this object and each of its elements.
+
+    // MANIPULATORS
+    FlatHashSet& operator=(const FlatHashSet& rhs);
+        // Assign to this object the value, hasher, and equality functor of the
+        // specified 'rhs' object, and return a reference providing modifiable
+        // access to this object.
+
+    FlatHashSet& operator=(bslmf::MovableRef<FlatHashSet> rhs);
+        // Assign to this object the value, hasher, and equality comparator of
+        // the specified 'rhs' object, and return a reference providing
+        // modifiable access to this object.  The value of 'rhs' becomes
+        // unspecified but valid, and its allocator remains unchanged.
+
+    void clear();
+        // Remove all elements from this set.  Note that the capacity of this
+        // set is unaffected.
+
+    bsl::size_t erase(const KEY& key);
+        // Remove from this set the element equal to the specified 'key', if it
+        // exists, and return 1; otherwise (there is no such element), return 0
+        // with no other effect.
+
+    iterator erase(const_iterator position);
+        // Remove from this set the element at the specified 'position', and
+        // return an iterator referring to the element immediately following
+        // the removed element, or to the past-the-end position if the removed
+        // element was the last in the sequence.  The behavior is undefined
+        // unless 'position' refers to an element in this set.
+
+    iterator erase(const_iterator first, const_iterator last);
+        // Remove from this set the elements starting at the specified 'first'
+        // position up to, but not including, the specified 'last' position,
+        // and return 'last'.  The behavior is undefined unless 'first' and
+        // 'last' either refer to elements in this set or are the 'end'
+        // iterator, and the 'first' position is at or before the 'last'
+        // position in the iteration sequence provided by this container.
+
+    bsl::pair<iterator, bool> insert(const KEY& value);
+    bsl::pair<iterator, bool> insert(bslmf::MovableRef<KEY> value);
+        // Insert the specified 'value' into this set if an equivalent element
+        // does not already exist in this set; otherwise, this method has no
+        // effect.  Return a 'pair' whose 'first' member is an iterator
+        // referring to the (possibly newly inserted) element in this set
+        // equivalent to 'value', and whose 'second' member is 'true' if a new
+        // element was inserted, and 'false' otherwise.
+
+    template <class INPUT_ITERATOR>
+    void insert(INPUT_ITERATOR first, INPUT_ITERATOR last);
+        // Insert into this set the value of each element in the range starting
+        // at the specified 'first' iterator and ending immediately before the
+        // specified 'last' iterator, if an equivalent element is not already
+        // present.  The behavior is undefined unless 'first' and 'last' refer
+        // to a sequence of valid values where 'first' is at a position at or
+        // before 'last'.
+
+    void rehash(bsl::size_t minimumCapacity);
+        // Change the capacity of this set to at least the specified
+        // 'minimumCapacity', and redistribute all the contained elements into
+        // the new sequence of slots according to their hash values.  If 0 is
+        // the resulting capacity, all memory is released.
+
+    void reserve(bsl::size_t numEntries);
+        // Change the capacity of this set to at least a capacity that can
+        // accommodate the specified 'numEntries' (accounting for the load
+        // factor invariant).  Note that no rehash occurs if this set can
+        // already hold 'numEntries'.
+
+    void reset();
+        // Remove all elements from this set and release all memory from this
+        // set.
+
+    void swap(FlatHashSet& other);
+        // Exchange the value of this object as well as its hasher and
+        // equality functor with those of the specified 'other' object.  This
+        // method provides the no-throw exception-safety guarantee.  The
+        // behavior is undefined unless this object was created with the same
+        // allocator as 'other'.
+
+    // ACCESSORS
+    bsl::size_t capacity() const;
+        // Return the number of slots (elements and unused positions) in this
+        // set.
+
+    bool contains(const KEY& key) const;
+        // Return 'true' if this set contains an element equal to the specified
+        // 'key', and 'false' otherwise.
+
+    bsl::size_t count(const KEY& key) const;
+        // Return the number of elements (0 or 1) in this set equal to the
+        // specified 'key'.
+
+    bool empty() const;
+        // Return 'true' if this set contains no elements, and 'false'
+        // otherwise.
+
+    bsl::pair<const_iterator, const_iterator> equal_range(
+                                                         const KEY& key) const;
+        // Return a pair of iterators defining the (zero or one) elements in
+        // this set equal to the specified 'key'.
+
+    const_iterator find(const KEY& key) const;
+        // Return an iterator referring to the element in this set equal to the
+        // specified 'key', or 'end()' if no such element exists in this set.
+
+    HASH hash_function() const;
+        // Return (a copy of) the unary hash functor used by this set.
+
+    EQUAL key_eq() const;
+        // Return (a copy of) the binary key-equality functor used by this set.
+
+    float load_factor() const;
+        // Return the current ratio between the number of elements in this
+        // container and its capacity.
+
+    float max_load_factor() const;
+        // Return the maximum load factor allowed for this set.
+
+    bsl::size_t size() const;
+        // Return the number of elements in this set.
+
+    const_iterator begin() const;
+    const_iterator cbegin() const;
+        // Return an iterator representing the beginning of the sequence of
+        // elements held by this set.
+
+    const_iterator end() const;
+    const_iterator cend() const;
+        // Return an iterator representing the end of the sequence of elements
+        // held by this set.
+
+    bslma::Allocator *allocator() const;
+        // Return the allocator used by this flat hash set to supply memory.
+};
+
+// FREE OPERATORS
+template <class KEY, class HASH, class EQUAL>
+bool operator==(const FlatHashSet<KEY, HASH, EQUAL> &lhs,
+                const FlatHashSet<KEY, HASH, EQUAL> &rhs);
+    // Return 'true' if the specified 'lhs' and 'rhs' objects have the same
+    // value, and 'false' otherwise.  Two 'FlatHashSet' objects have the same
+    // value if their sizes are the same and each element contained in one is
+    // equal to an element of the other.
+
+template <class KEY, class HASH, class EQUAL>
+bool operator!=(const FlatHashSet<KEY, HASH, EQUAL> &lhs,
+                const FlatHashSet<KEY, HASH, EQUAL> &rhs);
+    // Return 'true' if the specified 'lhs' and 'rhs' objects do not have the
+    // same value, and 'false' otherwise.
+
+// FREE FUNCTIONS
+template <class KEY, class HASH, class EQUAL>
+void swap(FlatHashSet<KEY, HASH, EQUAL>& a, FlatHashSet<KEY, HASH, EQUAL>& b);
+    // Exchange the value, the hasher, and the key-equality functor of the
+    // specified 'a' and 'b' objects.  This method provides the no-throw
+    // exception-safety guarantee if the two objects were created with the
+    // same allocator and the basic guarantee otherwise.
+
+// ============================================================================
+//                  TEMPLATE AND INLINE FUNCTION DEFINITIONS
+// ============================================================================
+
+                            // -----------------
+                            // class FlatHashSet
+                            // -----------------
+
+// CREATORS
+template <class KEY, class HASH, class EQUAL>
+inline
+FlatHashSet<KEY, HASH, EQUAL>::FlatHashSet()
+: d_impl(0, HASH(), EQUAL())
+{
+}
+
+template <class KEY, class HASH, class EQUAL>
+inline
+FlatHashSet<KEY, HASH, EQUAL>::FlatHashSet(bslma::Allocator *basicAllocator)
+: d_impl(0, HASH(), EQUAL(), basicAllocator)
+{
+}
+
+template <class KEY, class HASH, class EQUAL>
+inline
+FlatHashSet<KEY, HASH, EQUAL>::FlatHashSet(bsl::size_t capacity)
+: d_impl(capacity, HASH(), EQUAL())
+{
+}
+
+template <class KEY, class HASH, class EQUAL>
+inline
+FlatHashSet<KEY, HASH, EQUAL>::FlatHashSet(bsl::size_t       capacity,
+                                           bslma::Allocator *basicAllocator)
+: d_impl(capacity, HASH(), EQUAL(), basicAllocator)
+{
+}
+
+template <class KEY, class HASH, class EQUAL>
+inline
+FlatHashSet<KEY, HASH, EQUAL>::FlatHashSet(bsl::size_t       capacity,
+                                           const HASH&       hash,
+                                           bslma::Allocator *basicAllocator)
+: d_impl(capacity, hash, EQUAL(), basicAllocator)
+{
+}
+
+template <class KEY, class HASH, class EQUAL>
+inline
+FlatHashSet<KEY, HASH, EQUAL>::FlatHashSet(bsl::size_t       capacity,
+                                           const HASH&       hash,
+                                           const EQUAL&      equal,
+                                           bslma::Allocator *basicAllocator)
+: d_impl(capacity, hash, equal, basicAllocator)
+{
+}
+
+template <class KEY, class HASH, class EQUAL>
+template <class INPUT_ITERATOR>
+inline
+FlatHashSet<KEY, HASH, EQUAL>::FlatHashSet(INPUT_ITERATOR    first,
+                                           INPUT_ITERATOR    last,
+                                           bslma::Allocator *basicAllocator)
+: d_impl(0, HASH(), EQUAL(), basicAllocator)
+{
+    insert(first, last);
+}
+
+template <class KEY, class HASH, class EQUAL>
+inline
+FlatHashSet<KEY, HASH, EQUAL>::FlatHashSet(
+                                          const FlatHashSet&  original,
+                                          bslma::Allocator   *basicAllocator)
+: d_impl(original.d_impl, basicAllocator)
+{
+}
+
+template <class KEY, class HASH, class EQUAL>
+inline
+FlatHashSet<KEY, HASH, EQUAL>::FlatHashSet(
+                                       bslmf::MovableRef<FlatHashSet> original)
+: d_impl(bslmf::MovableRefUtil::move(
+                             bslmf::MovableRefUtil::access(original).d_impl))
+{
+}
+
+template <class KEY, class HASH, class EQUAL>
+inline
+FlatHashSet<KEY, HASH, EQUAL>::FlatHashSet(
+                             bslmf::MovableRef<FlatHashSet>  original,
+                             bslma::Allocator               *basicAllocator)
+: d_impl(bslmf::MovableRefUtil::move(
+                              bslmf::MovableRefUtil::access(original).d_impl),
+         basicAllocator)
+{
+}
+
+template <class KEY, class HASH, class EQUAL>
+inline
+FlatHashSet<KEY, HASH, EQUAL>::~FlatHashSet()
+{
+}
+
+// MANIPULATORS
+template <class KEY, class HASH, class EQUAL>
+inline
+FlatHashSet<KEY, HASH, EQUAL>&
+FlatHashSet<KEY, HASH, EQUAL>::operator=(const FlatHashSet& rhs)
+{
+    d_impl = rhs.d_impl;
+
+    return *this;
+}
+
+template <class KEY, class HASH, class EQUAL>
+inline
+FlatHashSet<KEY, HASH, EQUAL>&
+FlatHashSet<KEY, HASH, EQUAL>::operator=(bslmf::MovableRef<FlatHashSet> rhs)
+{
+    FlatHashSet& lvalue = rhs;
+
+    d_impl = bslmf::MovableRefUtil::move(lvalue.d_impl);
+
+    return *this;
+}
+
+template <class KEY, class HASH, class EQUAL>
+inline
+void FlatHashSet<KEY, HASH, EQUAL>::clear()
+{
+    d_impl.clear();
+}
+
+template <class KEY, class HASH, class EQUAL>
+inline
+bsl::size_t FlatHashSet<KEY, HASH, EQUAL>::erase(const KEY& key)
+{
+    return d_impl.erase(key);
+}
+
+template <class KEY, class HASH, class EQUAL>
+inline
+typename FlatHashSet<KEY, HASH, EQUAL>::iterator
+FlatHashSet<KEY, HASH, EQUAL>::erase(const_iterator position)
+{
+    BSLS_ASSERT_SAFE(position != end());
+
+    return d_impl.erase(position);
+}
+
+template <class KEY, class HASH, class EQUAL>
+inline
+typename FlatHashSet<KEY, HASH, EQUAL>::iterator
+FlatHashSet<KEY, HASH, EQUAL>::erase(const_iterator first,
+                                     const_iterator last)
+{
+    return d_impl.erase(first, last);
+}
+
+template <class KEY, class HASH, class EQUAL>
+inline
+bsl::pair<typename FlatHashSet<KEY, HASH, EQUAL>::iterator, bool>
+FlatHashSet<KEY, HASH, EQUAL>::insert(const KEY& value)
+{
+    return d_impl.insert(value);
+}
+
+template <class KEY, class HASH, class EQUAL>
+inline
+bsl::pair<typename FlatHashSet<KEY, HASH, EQUAL>::iterator, bool>
+FlatHashSet<KEY, HASH, EQUAL>::insert(bslmf::MovableRef<KEY> value)
+{
+    return d_impl.insert(bslmf::MovableRefUtil::move(value));
+}
+
+template <class KEY, class HASH, class EQUAL>
+template <class INPUT_ITERATOR>
+void FlatHashSet<KEY, HASH, EQUAL>::insert(INPUT_ITERATOR first,
+                                           INPUT_ITERATOR last)
+{
+    for (; first != last; ++first) {
+        const KEY& value = *first;
+        d_impl.insert(value);
+    }
+}
+
+template <class KEY, class HASH, class EQUAL>
+inline
+void FlatHashSet<KEY, HASH, EQUAL>::rehash(bsl::size_t minimumCapacity)
+{
+    d_impl.rehash(minimumCapacity);
+}
+
+template <class KEY, class HASH, class EQUAL>
+inline
+void FlatHashSet<KEY, HASH, EQUAL>::reserve(bsl::size_t numEntries)
+{
+    d_impl.reserve(numEntries);
+}
+
+template <class KEY, class HASH, class EQUAL>
+inline
+void FlatHashSet<KEY, HASH, EQUAL>::reset()
+{
+    d_impl.reset();
+}
+
+template <class KEY, class HASH, class EQUAL>
+inline
+void FlatHashSet<KEY, HASH, EQUAL>::swap(FlatHashSet& other)
+{
+    BSLS_ASSERT_SAFE(allocator() == other.allocator());
+
+    d_impl.swap(other.d_impl);
+}
+
+// ACCESSORS
+template <class KEY, class HASH, class EQUAL>
+inline
+bsl::size_t FlatHashSet<KEY, HASH, EQUAL>::capacity() const
+{
+    return d_impl.capacity();
+}
+
+template <class KEY, class HASH, class EQUAL>
+inline
+bool FlatHashSet<KEY, HASH, EQUAL>::contains(const KEY& key) const
+{
+    return d_impl.contains(key);
+}
+
+template <class KEY, class HASH, class EQUAL>
+inline
+bsl::size_t FlatHashSet<KEY, HASH, EQUAL>::count(const KEY& key) const
+{
+    return d_impl.count(key);
+}
+
+template <class KEY, class HASH, class EQUAL>
+inline
+bool FlatHashSet<KEY, HASH, EQUAL>::empty() const
+{
+    return d_impl.empty();
+}
+
+template <class KEY, class HASH, class EQUAL>
+inline
+bsl::pair<typename FlatHashSet<KEY, HASH, EQUAL>::const_iterator,
+          typename FlatHashSet<KEY, HASH, EQUAL>::const_iterator>
+FlatHashSet<KEY, HASH, EQUAL>::equal_range(const KEY& key) const
+{
+    return d_impl.equal_range(key);
+}
+
+template <class KEY, class HASH, class EQUAL>
+inline
+typename FlatHashSet<KEY, HASH, EQUAL>::const_iterator
+FlatHashSet<KEY, HASH, EQUAL>::find(const KEY& key) const
+{
+    return d_impl.find(key);
+}
+
+template <class KEY, class HASH, class EQUAL>
+inline
+HASH FlatHashSet<KEY, HASH, EQUAL>::hash_function() const
+{
+    return d_impl.hash_function();
+}
+
+template <class KEY, class HASH, class EQUAL>
+inline
+EQUAL FlatHashSet<KEY, HASH, EQUAL>::key_eq() const
+{
+    return d_impl.key_eq();
+}
+
+template <class KEY, class HASH, class EQUAL>
+inline
+float FlatHashSet<KEY, HASH, EQUAL>::load_factor() const
+{
+    return d_impl.load_factor();
+}
+
+template <class KEY, class HASH, class EQUAL>
+inline
+float FlatHashSet<KEY, HASH, EQUAL>::max_load_factor() const
+{
+    return d_impl.max_load_factor();
+}
+
+template <class KEY, class HASH, class EQUAL>
+inline
+bsl::size_t FlatHashSet<KEY, HASH, EQUAL>::size() const
+{
+    return d_impl.size();
+}
+
+template <class KEY, class HASH, class EQUAL>
+inline
+typename FlatHashSet<KEY, HASH, EQUAL>::const_iterator
+FlatHashSet<KEY, HASH, EQUAL>::begin() const
+{
+    return d_impl.begin();
+}
+
+template <class KEY, class HASH, class EQUAL>
+inline
+typename FlatHashSet<KEY, HASH, EQUAL>::const_iterator
+FlatHashSet<KEY, HASH, EQUAL>::cbegin() const
+{
+    return d_impl.begin();
+}
+
+template <class KEY, class HASH, class EQUAL>
+inline
+typename FlatHashSet<KEY, HASH, EQUAL>::const_iterator
+FlatHashSet<KEY, HASH, EQUAL>::end() const
+{
+    return d_impl.end();
+}
+
+template <class KEY, class HASH, class EQUAL>
+inline
+typename FlatHashSet<KEY, HASH, EQUAL>::const_iterator
+FlatHashSet<KEY, HASH, EQUAL>::cend() const
+{
+    return d_impl.end();
+}
+
+template <class KEY, class HASH, class EQUAL>
+inline
+bslma::Allocator *FlatHashSet<KEY, HASH, EQUAL>::allocator() const
+{
+    return d_impl.allocator();
+}
+
+}  // close package namespace
+
+// FREE OPERATORS
+template <class KEY, class HASH, class EQUAL>
+inline
+bool bdlc::operator==(const FlatHashSet<KEY, HASH, EQUAL> &lhs,
+                      const FlatHashSet<KEY, HASH, EQUAL> &rhs)
+{
+    return lhs.d_impl == rhs.d_impl;
+}
+
+template <class KEY, class HASH, class EQUAL>
+inline
+bool bdlc::operator!=(const FlatHashSet<KEY, HASH, EQUAL> &lhs,
+                      const FlatHashSet<KEY, HASH, EQUAL> &rhs)
+{
+    return !(lhs == rhs);
+}
+
+// FREE FUNCTIONS
+template <class KEY, class HASH, class EQUAL>
+inline
+void bdlc::swap(FlatHashSet<KEY, HASH, EQUAL>& a,
+                FlatHashSet<KEY, HASH, EQUAL>& b)
+{
+    if (a.allocator() == b.allocator()) {
+        a.swap(b);
+
+        return;                                                       // RETURN
+    }
+
+    typedef FlatHashSet<KEY, HASH, EQUAL> Set;
+
+    Set futureA(b, a.allocator());
+    Set futureB(a, b.allocator());
+
+    futureA.swap(a);
+    futureB.swap(b);
+}
+
+}  // close enterprise namespace
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2020 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
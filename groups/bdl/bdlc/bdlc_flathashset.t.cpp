@@ -0,0 +1,732 @@
+// bdlc_flathashset.t.cpp                                             -*-C++-*-
+#include <bdlc_flathashset.h>
+
+#include <bslim_testutil.h>
+
+#include <bslma_default.h>
+#include <bslma_defaultallocatorguard.h>
+#include <bslma_testallocator.h>
+#include <bslma_testallocatorexception.h>
+
+#include <bslmf_movableref.h>
+
+#include <bsls_asserttest.h>
+#include <bsls_types.h>
+
+#include <bsl_cstdlib.h>
+#include <bsl_iostream.h>
+#include <bsl_set.h>
+#include <bsl_string.h>
+#include <bsl_utility.h>
+
+using namespace BloombergLP;
+using namespace bsl;
+
+// ============================================================================
+//                             TEST PLAN
+// ----------------------------------------------------------------------------
+//                             Overview
+//                             --------
+// The component under test is a value-semantic container implemented in terms
+// of 'bdlc::FlatHashTable', which is thoroughly tested in its own component.
+// This test driver therefore concentrates on the forwarding of each method to
+// the implementation and on the correct propagation of allocators to the
+// elements.
+// ----------------------------------------------------------------------------
+// CREATORS
+// [ 2] FlatHashSet();
+// [ 2] FlatHashSet(Allocator *basicAllocator);
+// [ 2] FlatHashSet(size_t capacity);
+// [ 2] FlatHashSet(size_t capacity, Allocator *basicAllocator);
+// [ 2] FlatHashSet(size_t, const HASH&, Allocator *basicAllocator = 0);
+// [ 2] FlatHashSet(size_t, const HASH&, const EQUAL&, Allocator * = 0);
+// [ 2] FlatHashSet(INPUT_ITERATOR, INPUT_ITERATOR, Allocator * = 0);
+// [ 4] FlatHashSet(const FlatHashSet&, Allocator *basicAllocator = 0);
+// [ 4] FlatHashSet(MovableRef<FlatHashSet>);
+// [ 4] FlatHashSet(MovableRef<FlatHashSet>, Allocator *);
+// [ 2] ~FlatHashSet();
+//
+// MANIPULATORS
+// [ 4] FlatHashSet& operator=(const FlatHashSet&);
+// [ 4] FlatHashSet& operator=(MovableRef<FlatHashSet>);
+// [ 3] void clear();
+// [ 3] size_t erase(const KEY&);
+// [ 3] iterator erase(const_iterator);
+// [ 3] iterator erase(const_iterator, const_iterator);
+// [ 3] pair<iterator, bool> insert(const KEY&);
+// [ 3] pair<iterator, bool> insert(MovableRef<KEY>);
+// [ 3] void insert(INPUT_ITERATOR, INPUT_ITERATOR);
+// [ 3] void rehash(size_t);
+// [ 3] void reserve(size_t);
+// [ 3] void reset();
+// [ 4] void swap(FlatHashSet&);
+//
+// ACCESSORS
+// [ 2] size_t capacity() const;
+// [ 3] bool contains(const KEY&) const;
+// [ 3] size_t count(const KEY&) const;
+// [ 2] bool empty() const;
+// [ 3] pair<cIter, cIter> equal_range(const KEY&) const;
+// [ 3] const_iterator find(const KEY&) const;
+// [ 2] HASH hash_function() const;
+// [ 2] EQUAL key_eq() const;
+// [ 2] float load_factor() const;
+// [ 2] float max_load_factor() const;
+// [ 2] size_t size() const;
+// [ 3] const_iterator begin() const;
+// [ 3] const_iterator cbegin() const;
+// [ 3] const_iterator end() const;
+// [ 3] const_iterator cend() const;
+// [ 2] Allocator *allocator() const;
+//
+// FREE OPERATORS
+// [ 4] bool operator==(const FlatHashSet&, const FlatHashSet&);
+// [ 4] bool operator!=(const FlatHashSet&, const FlatHashSet&);
+//
+// FREE FUNCTIONS
+// [ 4] void swap(FlatHashSet&, FlatHashSet&);
+// ----------------------------------------------------------------------------
+// [ 1] BREATHING TEST
+// [ 5] USAGE EXAMPLE
+
+// ============================================================================
+//                     STANDARD BDE ASSERT TEST FUNCTION
+// ----------------------------------------------------------------------------
+
+namespace {
+
+int testStatus = 0;
+
+void aSsErT(bool condition, const char *message, int line)
+{
+    if (condition) {
+        cout << "Error " __FILE__ "(" << line << "): " << message
+             << "    (failed)" << endl;
+
+        if (0 <= testStatus && testStatus <= 100) {
+            ++testStatus;
+        }
+    }
+}
+
+}  // close unnamed namespace
+
+// ============================================================================
+//               STANDARD BDE TEST DRIVER MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT       BSLIM_TESTUTIL_ASSERT
+#define ASSERTV      BSLIM_TESTUTIL_ASSERTV
+
+#define LOOP_ASSERT  BSLIM_TESTUTIL_LOOP_ASSERT
+#define LOOP0_ASSERT BSLIM_TESTUTIL_LOOP0_ASSERT
+#define LOOP1_ASSERT BSLIM_TESTUTIL_LOOP1_ASSERT
+#define LOOP2_ASSERT BSLIM_TESTUTIL_LOOP2_ASSERT
+#define LOOP3_ASSERT BSLIM_TESTUTIL_LOOP3_ASSERT
+#define LOOP4_ASSERT BSLIM_TESTUTIL_LOOP4_ASSERT
+#define LOOP5_ASSERT BSLIM_TESTUTIL_LOOP5_ASSERT
+#define LOOP6_ASSERT BSLIM_TESTUTIL_LOOP6_ASSERT
+
+#define Q            BSLIM_TESTUTIL_Q   // Quote identifier literally.
+#define P            BSLIM_TESTUTIL_P   // Print identifier and value.
+#define P_           BSLIM_TESTUTIL_P_  // P(X) without '\n'.
+#define T_           BSLIM_TESTUTIL_T_  // Print a tab (w/o newline).
+#define L_           BSLIM_TESTUTIL_L_  // current Line number
+
+// ============================================================================
+//                     NEGATIVE-TEST MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT_SAFE_PASS(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_PASS(EXPR)
+#define ASSERT_SAFE_FAIL(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_FAIL(EXPR)
+#define ASSERT_PASS(EXPR)      BSLS_ASSERTTEST_ASSERT_PASS(EXPR)
+#define ASSERT_FAIL(EXPR)      BSLS_ASSERTTEST_ASSERT_FAIL(EXPR)
+#define ASSERT_OPT_PASS(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_PASS(EXPR)
+#define ASSERT_OPT_FAIL(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_FAIL(EXPR)
+
+// ============================================================================
+//                  GLOBAL TYPEDEFS/CONSTANTS FOR TESTING
+// ----------------------------------------------------------------------------
+
+static bool verbose;
+static bool veryVerbose;
+static bool veryVeryVerbose;
+
+typedef bdlc::FlatHashSet<int>         Obj;
+typedef bdlc::FlatHashSet<bsl::string> StrObj;
+
+struct IdentityHash {
+    // This hash functor returns its argument unchanged.
+
+    bsl::size_t operator()(int value) const
+    {
+        return static_cast<bsl::size_t>(value);
+    }
+};
+
+const char *const LONG_STRING = "a string long enough to require allocation";
+
+// ============================================================================
+//                     HELPER FUNCTIONS FOR TESTING
+// ----------------------------------------------------------------------------
+
+static bsl::string makeKey(int value, bslma::Allocator *allocator)
+    // Return a string that is unique for the specified 'value' and long enough
+    // to require allocation, using the specified 'allocator' to supply memory.
+{
+    bsl::string rv(LONG_STRING, allocator);
+    rv += bsl::to_string(value);
+    return rv;
+}
+
+// ============================================================================
+//                               MAIN PROGRAM
+// ----------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    int test        = argc > 1 ? atoi(argv[1]) : 0;
+    verbose         = argc > 2;
+    veryVerbose     = argc > 3;
+    veryVeryVerbose = argc > 4;
+
+    cout << "TEST " << __FILE__ << " CASE " << test << endl;
+
+    bslma::TestAllocator globalAllocator("global", veryVeryVerbose);
+    bslma::Default::setGlobalAllocator(&globalAllocator);
+
+    bslma::TestAllocator defaultAllocator("default", veryVeryVerbose);
+    bslma::DefaultAllocatorGuard dag(&defaultAllocator);
+
+    switch (test) { case 0:
+      case 5: {
+        // --------------------------------------------------------------------
+        // USAGE EXAMPLE
+        //   Extracted from component header file.
+        //
+        // Concerns:
+        //: 1 The usage example provided in the component header file compiles,
+        //:   links, and runs as shown.
+        //
+        // Plan:
+        //: 1 Incorporate usage example from header into test driver, remove
+        //:   leading comment characters, and replace 'assert' with 'ASSERT'.
+        //:   (C-1)
+        //
+        // Testing:
+        //   USAGE EXAMPLE
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "USAGE EXAMPLE" << endl
+                          << "=============" << endl;
+
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Categorizing Data
+/// - - - - - - - - - - - - - -
+// Suppose one is analyzing data on a set of customers, and each customer is
+// categorized by several attributes: customer type, geographic area, and
+// (internal) project code; and that each attribute takes on one of a limited
+// set of values.  We wish to determine the number of distinct projects that
+// appear in a large set of customer records.
+//
+// First, we define the set type and some (abbreviated) project codes:
+//..
+    typedef bdlc::FlatHashSet<int> ProjectSet;
+
+    const int codes[] = { 17, 4, 17, 99, 4, 4, 23, 17, 99 };
+    const int numCodes = sizeof codes / sizeof *codes;
+//..
+// Then, we insert each code, noting whether it was newly inserted:
+//..
+    ProjectSet projects;
+    int        numNew = 0;
+
+    for (int i = 0; i < numCodes; ++i) {
+        if (projects.insert(codes[i]).second) {
+            ++numNew;
+        }
+    }
+//..
+// Finally, we verify the number of distinct projects:
+//..
+    ASSERT(4 == numNew);
+    ASSERT(4 == projects.size());
+    ASSERT(projects.contains(23));
+    ASSERT(!projects.contains(5));
+//..
+      } break;
+      case 4: {
+        // --------------------------------------------------------------------
+        // TESTING VALUE SEMANTICS
+        //
+        // Concerns:
+        //: 1 The copy and move constructors produce an object having the value
+        //:   of the original and using the intended allocator.
+        //:
+        //: 2 Copy and move assignment produce an object having the value of
+        //:   the source and retaining the allocator of the target.
+        //:
+        //: 3 The equality operators compare elements irrespective of insertion
+        //:   order.
+        //:
+        //: 4 The member 'swap' exchanges values without allocation, and the
+        //:   free 'swap' exchanges values of objects using different
+        //:   allocators.
+        //
+        // Plan:
+        //: 1 Create objects of various sizes and verify the results of each
+        //:   operation and the use of the allocators.  (C-1..4)
+        //
+        // Testing:
+        //   FlatHashSet(const FlatHashSet&, Allocator *basicAllocator = 0);
+        //   FlatHashSet(MovableRef<FlatHashSet>);
+        //   FlatHashSet(MovableRef<FlatHashSet>, Allocator *);
+        //   FlatHashSet& operator=(const FlatHashSet&);
+        //   FlatHashSet& operator=(MovableRef<FlatHashSet>);
+        //   void swap(FlatHashSet&);
+        //   bool operator==(const FlatHashSet&, const FlatHashSet&);
+        //   bool operator!=(const FlatHashSet&, const FlatHashSet&);
+        //   void swap(FlatHashSet&, FlatHashSet&);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "TESTING VALUE SEMANTICS" << endl
+                          << "=======================" << endl;
+
+        bslma::TestAllocator sa("supplied", veryVeryVerbose);
+        bslma::TestAllocator oa("other",    veryVeryVerbose);
+        bslma::TestAllocator scratch("scratch", veryVeryVerbose);
+
+        static const int SIZES[] = { 0, 1, 2, 14, 15, 100 };
+        const int NUM_SIZES = static_cast<int>(sizeof SIZES / sizeof *SIZES);
+
+        for (int ti = 0; ti < NUM_SIZES; ++ti) {
+            const int SIZE = SIZES[ti];
+
+            StrObj mX(&sa);  const StrObj& X = mX;
+            StrObj mY(&sa);  const StrObj& Y = mY;
+
+            for (int i = 0; i < SIZE; ++i) {
+                mX.insert(makeKey(i, &scratch));
+            }
+            for (int i = SIZE - 1; i >= 0; --i) {
+                mY.insert(makeKey(i, &scratch));
+            }
+            ASSERTV(SIZE, X == Y);
+            ASSERTV(SIZE, !(X != Y));
+
+            if (SIZE) {
+                mY.erase(makeKey(0, &scratch));
+                ASSERTV(SIZE, X != Y);
+                mY.insert(makeKey(-1, &scratch));
+                ASSERTV(SIZE, X != Y);
+                mY.erase(makeKey(-1, &scratch));
+                mY.insert(makeKey(0, &scratch));
+                ASSERTV(SIZE, X == Y);
+            }
+
+            {
+                const StrObj Z(X, &oa);
+                ASSERTV(SIZE, X == Z);
+                ASSERTV(SIZE, &oa == Z.allocator());
+
+                for (StrObj::const_iterator it = Z.begin();
+                                                        it != Z.end(); ++it) {
+                    ASSERTV(SIZE, &oa == it->get_allocator());
+                }
+            }
+            ASSERTV(SIZE, 0 == oa.numBlocksInUse());
+
+            {
+                StrObj mZ(X);
+                ASSERTV(SIZE, X == mZ);
+                ASSERTV(SIZE, &defaultAllocator == mZ.allocator());
+            }
+            ASSERTV(SIZE, 0 == defaultAllocator.numBlocksInUse());
+
+            {
+                StrObj mZ(X, &sa);
+                const bsls::Types::Int64 NUM_BLOCKS = sa.numBlocksTotal();
+
+                StrObj mW(bslmf::MovableRefUtil::move(mZ));
+                ASSERTV(SIZE, NUM_BLOCKS == sa.numBlocksTotal());
+                ASSERTV(SIZE, X == mW);
+                ASSERTV(SIZE, &sa == mW.allocator());
+
+                StrObj mV(bslmf::MovableRefUtil::move(mW), &oa);
+                ASSERTV(SIZE, X == mV);
+                ASSERTV(SIZE, &oa == mV.allocator());
+            }
+            ASSERTV(SIZE, 0 == oa.numBlocksInUse());
+
+            {
+                StrObj mZ(&oa);
+                mZ.insert(makeKey(-1, &scratch));
+
+                mZ = X;
+                ASSERTV(SIZE, X == mZ);
+                ASSERTV(SIZE, &oa == mZ.allocator());
+
+                StrObj mW(X, &sa);
+                mZ.clear();
+                mZ = bslmf::MovableRefUtil::move(mW);
+                ASSERTV(SIZE, X == mZ);
+                ASSERTV(SIZE, &oa == mZ.allocator());
+
+                StrObj mV(&sa);
+                mV.insert(makeKey(-1, &scratch));
+                const StrObj V(mV, &scratch);
+
+                const bsls::Types::Int64 NUM_BLOCKS = sa.numBlocksTotal();
+                mV.swap(mY);
+                ASSERTV(SIZE, NUM_BLOCKS == sa.numBlocksTotal());
+                ASSERTV(SIZE, X == mV);
+                ASSERTV(SIZE, V == mY);
+                mV.swap(mY);
+
+                bdlc::swap(mV, mZ);
+                ASSERTV(SIZE, X == mV);
+                ASSERTV(SIZE, V == mZ);
+                ASSERTV(SIZE, &sa == mV.allocator());
+                ASSERTV(SIZE, &oa == mZ.allocator());
+            }
+            ASSERTV(SIZE, 0 == oa.numBlocksInUse());
+        }
+        ASSERTV(0 == sa.numBlocksInUse());
+        ASSERTV(0 == defaultAllocator.numBlocksInUse());
+      } break;
+      case 3: {
+        // --------------------------------------------------------------------
+        // TESTING FORWARDING MANIPULATORS AND ACCESSORS
+        //
+        // Concerns:
+        //: 1 Each method forwards to the implementation as documented.
+        //:
+        //: 2 Iteration visits each element exactly once.
+        //:
+        //: 3 Inserted elements use the allocator of the set, and insertion
+        //:   provides the strong exception guarantee.
+        //
+        // Plan:
+        //: 1 Apply a pseudo-random sequence of operations to an object and to
+        //:   a 'bsl::set' oracle, and verify that they agree.  (C-1..2)
+        //:
+        //: 2 Insert allocating strings within the 'bslma' exception test
+        //:   macros and verify the allocator of each element.  (C-3)
+        //
+        // Testing:
+        //   void clear();
+        //   size_t erase(const KEY&);
+        //   iterator erase(const_iterator);
+        //   iterator erase(const_iterator, const_iterator);
+        //   pair<iterator, bool> insert(const KEY&);
+        //   pair<iterator, bool> insert(MovableRef<KEY>);
+        //   void insert(INPUT_ITERATOR, INPUT_ITERATOR);
+        //   void rehash(size_t);
+        //   void reserve(size_t);
+        //   void reset();
+        //   bool contains(const KEY&) const;
+        //   size_t count(const KEY&) const;
+        //   pair<cIter, cIter> equal_range(const KEY&) const;
+        //   const_iterator find(const KEY&) const;
+        //   const_iterator begin() const;
+        //   const_iterator cbegin() const;
+        //   const_iterator end() const;
+        //   const_iterator cend() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                 << "TESTING FORWARDING MANIPULATORS AND ACCESSORS" << endl
+                 << "=============================================" << endl;
+
+        bslma::TestAllocator sa("supplied", veryVeryVerbose);
+        bslma::TestAllocator scratch("scratch", veryVeryVerbose);
+
+        {
+            Obj mX(&sa);  const Obj& X = mX;
+
+            bsl::set<int> oracle(&scratch);
+            unsigned int  seed = 54321;
+
+            for (int op = 0; op < 20000; ++op) {
+                seed = seed * 1103515245 + 12345;
+                const int key = static_cast<int>((seed >> 8) % 3000);
+
+                switch ((seed >> 4) % 4) {
+                  case 0: {
+                    const bool EXP = oracle.insert(key).second;
+                    ASSERTV(op, EXP == mX.insert(key).second);
+                  } break;
+                  case 1: {
+                    ASSERTV(op, oracle.erase(key) == mX.erase(key));
+                  } break;
+                  case 2: {
+                    Obj::const_iterator it = X.find(key);
+                    if (it != X.end()) {
+                        oracle.erase(key);
+                        mX.erase(it);
+                    }
+                  } break;
+                  default: {
+                    const bool EXP = 0 != oracle.count(key);
+                    ASSERTV(op, EXP == X.contains(key));
+                    ASSERTV(op, EXP == (1 == X.count(key)));
+
+                    bsl::pair<Obj::const_iterator, Obj::const_iterator>
+                                                  range = X.equal_range(key);
+                    ASSERTV(op, EXP == (range.first != range.second));
+                    if (EXP) {
+                        ASSERTV(op, key == *range.first);
+                    }
+                  } break;
+                }
+            }
+
+            ASSERT(oracle.size() == X.size());
+
+            bsl::size_t numIterated = 0;
+            for (Obj::const_iterator it = X.cbegin(); it != X.cend(); ++it) {
+                ASSERTV(*it, 1 == oracle.count(*it));
+                ++numIterated;
+            }
+            ASSERT(oracle.size() == numIterated);
+
+            const Obj Y(oracle.begin(), oracle.end(), &sa);
+            ASSERT(X == Y);
+
+            Obj mZ(&sa);
+            mZ.insert(oracle.begin(), oracle.end());
+            ASSERT(X == mZ);
+
+            mZ.erase(mZ.begin(), mZ.end());
+            ASSERT(mZ.empty());
+
+            mX.reserve(10000);
+            ASSERT(X.capacity() >= 10000);
+            ASSERT(X == Y);
+
+            mX.rehash(1 << 16);
+            ASSERT(1 << 16 == X.capacity());
+            ASSERT(X == Y);
+
+            const bsl::size_t CAPACITY = X.capacity();
+            mX.clear();
+            ASSERT(X.empty());
+            ASSERT(CAPACITY == X.capacity());
+            ASSERT(X.begin() == X.end());
+
+            mX.reset();
+            ASSERT(0 == X.capacity());
+        }
+        ASSERT(0 == sa.numBlocksInUse());
+
+        {
+            StrObj mX(&sa);  const StrObj& X = mX;
+
+            for (int i = 0; i < 40; ++i) {
+                const bsl::string KEY = makeKey(i, &scratch);
+
+                BSLMA_TESTALLOCATOR_EXCEPTION_TEST_BEGIN(sa) {
+                    ASSERTV(i, static_cast<bsl::size_t>(i) == X.size());
+
+                    mX.insert(KEY);
+                } BSLMA_TESTALLOCATOR_EXCEPTION_TEST_END
+
+                StrObj::const_iterator it = X.find(KEY);
+                ASSERTV(i, it != X.end());
+                ASSERTV(i, &sa == it->get_allocator());
+            }
+
+            bsl::string key = makeKey(100, &sa);
+            const char *const DATA = key.data();
+
+            ASSERT(mX.insert(bslmf::MovableRefUtil::move(key)).second);
+            ASSERT(DATA == X.find(makeKey(100, &scratch))->data());
+        }
+        ASSERT(0 == sa.numBlocksInUse());
+        ASSERT(0 == defaultAllocator.numBlocksTotal());
+      } break;
+      case 2: {
+        // --------------------------------------------------------------------
+        // TESTING CONSTRUCTORS AND BASIC ACCESSORS
+        //
+        // Concerns:
+        //: 1 Each constructor creates an object having the specified capacity
+        //:   (rounded to a valid capacity), hasher, equality functor, and
+        //:   allocator.
+        //:
+        //: 2 The range constructor inserts the unique elements of the range.
+        //:
+        //: 3 The basic accessors reflect the state of the object.
+        //
+        // Plan:
+        //: 1 Create objects with each constructor and verify the state of the
+        //:   objects and the use of the allocators.  (C-1..3)
+        //
+        // Testing:
+        //   FlatHashSet();
+        //   FlatHashSet(Allocator *basicAllocator);
+        //   FlatHashSet(size_t capacity);
+        //   FlatHashSet(size_t capacity, Allocator *basicAllocator);
+        //   FlatHashSet(size_t, const HASH&, Allocator *basicAllocator = 0);
+        //   FlatHashSet(size_t, const HASH&, const EQUAL&, Allocator * = 0);
+        //   FlatHashSet(INPUT_ITERATOR, INPUT_ITERATOR, Allocator * = 0);
+        //   ~FlatHashSet();
+        //   size_t capacity() const;
+        //   bool empty() const;
+        //   HASH hash_function() const;
+        //   EQUAL key_eq() const;
+        //   float load_factor() const;
+        //   float max_load_factor() const;
+        //   size_t size() const;
+        //   Allocator *allocator() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                      << "TESTING CONSTRUCTORS AND BASIC ACCESSORS" << endl
+                      << "========================================" << endl;
+
+        bslma::TestAllocator sa("supplied", veryVeryVerbose);
+
+        typedef bdlc::FlatHashSet<int, IdentityHash> IdObj;
+
+        {
+            const Obj X;
+            ASSERT(&defaultAllocator == X.allocator());
+            ASSERT(0 == X.capacity());
+            ASSERT(X.empty());
+            ASSERT(0 == X.size());
+            ASSERT(0.0f == X.load_factor());
+            ASSERT(0.875f == X.max_load_factor());
+            ASSERT(0 == defaultAllocator.numBlocksTotal());
+        }
+        {
+            const Obj X(&sa);
+            ASSERT(&sa == X.allocator());
+            ASSERT(0 == X.capacity());
+            ASSERT(0 == sa.numBlocksTotal());
+        }
+        {
+            const Obj X(20);
+            ASSERT(&defaultAllocator == X.allocator());
+            ASSERT(32 == X.capacity());
+            ASSERT(0 < defaultAllocator.numBlocksInUse());
+        }
+        ASSERT(0 == defaultAllocator.numBlocksInUse());
+        {
+            const Obj X(16, &sa);
+            ASSERT(&sa == X.allocator());
+            ASSERT(16 == X.capacity());
+            ASSERT(0 < sa.numBlocksInUse());
+        }
+        ASSERT(0 == sa.numBlocksInUse());
+        {
+            const IdObj X(0, IdentityHash(), &sa);
+            ASSERT(&sa == X.allocator());
+            ASSERT(7 == X.hash_function()(7));
+        }
+        {
+            const IdObj X(64, IdentityHash(), bsl::equal_to<int>(), &sa);
+            ASSERT(&sa == X.allocator());
+            ASSERT(64 == X.capacity());
+            ASSERT(X.key_eq()(5, 5));
+            ASSERT(!X.key_eq()(5, 6));
+        }
+        {
+            const int DATA[] = { 3, 1, 4, 1, 5, 9, 2, 6, 5, 3, 5 };
+            const int NUM_DATA = static_cast<int>(sizeof DATA / sizeof *DATA);
+
+            const Obj X(DATA, DATA + NUM_DATA, &sa);
+            ASSERT(&sa == X.allocator());
+            ASSERT(7 == X.size());
+            ASSERT(X.load_factor() > 0.0f);
+            for (int i = 0; i < NUM_DATA; ++i) {
+                ASSERTV(i, X.contains(DATA[i]));
+            }
+            ASSERT(!X.contains(7));
+        }
+        ASSERT(0 == sa.numBlocksInUse());
+        ASSERT(0 == defaultAllocator.numBlocksInUse());
+      } break;
+      case 1: {
+        // --------------------------------------------------------------------
+        // BREATHING TEST
+        //   This case exercises (but does not fully test) basic functionality.
+        //
+        // Concerns:
+        //: 1 The class is sufficiently functional to enable comprehensive
+        //:   testing in subsequent test cases.
+        //
+        // Plan:
+        //: 1 Create an object, insert, find, and erase elements.  (C-1)
+        //
+        // Testing:
+        //   BREATHING TEST
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "BREATHING TEST" << endl
+                          << "==============" << endl;
+
+        bslma::TestAllocator sa("supplied", veryVeryVerbose);
+
+        {
+            Obj mX(&sa);  const Obj& X = mX;
+
+            ASSERT(X.empty());
+
+            ASSERT(mX.insert(1).second);
+            ASSERT(!mX.insert(1).second);
+            ASSERT(mX.insert(5).second);
+            ASSERT(2 == X.size());
+            ASSERT(5 == *X.find(5));
+
+            ASSERT(1 == mX.erase(1));
+            ASSERT(!X.contains(1));
+            ASSERT(1 == X.size());
+
+            Obj mY(X, &sa);
+            ASSERT(X == mY);
+            mY.insert(7);
+            ASSERT(X != mY);
+        }
+        ASSERT(0 == sa.numBlocksInUse());
+        ASSERT(0 == defaultAllocator.numBlocksTotal());
+      } break;
+      default: {
+        cerr << "WARNING: CASE `" << test << "' NOT FOUND." << endl;
+        testStatus = -1;
+      }
+    }
+
+    // CONCERN: In no case does memory come from the global allocator.
+
+    ASSERTV(globalAllocator.numBlocksTotal(),
+            0 == globalAllocator.numBlocksTotal());
+
+    if (testStatus > 0) {
+        cerr << "Error, non-zero test status = " << testStatus << "." << endl;
+    }
+
+    return testStatus;
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2020 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
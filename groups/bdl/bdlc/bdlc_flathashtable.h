@@ -0,0 +1,1445 @@
+// bdlc_flathashtable.h                                               -*-C++-*-
+#ifndef INCLUDED_BDLC_FLATHASHTABLE
+#define INCLUDED_BDLC_FLATHASHTABLE
+
+#include <bsls_ident.h>
+BSLS_IDENT("$Id: $")
+
+//@PURPOSE: Provide an open-addressed hash table like Abseil 'flat_hash_map'.
+//
+//@CLASSES:
+//  bdlc::FlatHashTable: open-addressed hash table like Abseil 'flat_hash_map'
+//  bdlc::FlatHashTable_IteratorImp: forward iterator implementation
+//
+//@SEE_ALSO: bdlc_flathashmap, bdlc_flathashset
+//
+//@DESCRIPTION: This component defines a class template,
+// 'bdlc::FlatHashTable', implementing a value-semantic, open-addressed hash
+// table that stores its entries contiguously in a single array, and is the
+// implementation shared by the 'bdlc::FlatHashMap' and 'bdlc::FlatHashSet'
+// containers.  The design is inspired by the Abseil "Swiss table"
+// ('absl::flat_hash_map').  This class is not intended for direct use by
+// clients.
+//
+// Unlike 'bsl::unordered_map', which allocates a node for each element and
+// traverses a linked list of nodes on each lookup, a 'bdlc::FlatHashTable'
+// stores its entries in place within an array of (a power of two number of)
+// slots, and maintains a parallel array of one-byte "control" values (see
+// 'bdlc_flathashtable_groupcontrol').  Each control value records whether the
+// corresponding slot is empty, erased, or in use, and for a slot in use, seven
+// bits of the hash of the slot's key.  Lookups examine the control values a
+// group of 16 at a time -- using SIMD instructions where available -- and
+// compare keys only for slots whose control values match, so that a
+// successful lookup typically incurs one or two cache misses and an
+// unsuccessful lookup typically incurs one.
+//
+// The table is grown (doubling its capacity) once the number of entries,
+// together with the number of erased slots, would exceed 7/8 of the capacity.
+// Since entries are stored in place, a rehash moves entries, and invalidates
+// all iterators, pointers, and references to entries.  Erasing an entry
+// invalidates only iterators, pointers, and references to the erased entry.
+//
+///Template Parameters
+///-------------------
+// The 'ENTRY_UTIL' template parameter must provide the following 'static'
+// member functions:
+//..
+//  static const KEY& key(const ENTRY& entry);
+//      // Return the key of the specified 'entry'.
+//
+//  template <class ENTRY_TYPE>
+//  static void construct(
+//                       ENTRY                                        *entry,
+//                       bslma::Allocator                             *alloc,
+//                       BSLS_COMPILERFEATURES_FORWARD_REF(ENTRY_TYPE) source);
+//      // Create an entry at the specified 'entry' address from the specified
+//      // 'source' using the specified 'alloc' to supply memory.
+//
+//  template <class KEY_TYPE>
+//  static void constructFromKey(
+//                           ENTRY                                     *entry,
+//                           bslma::Allocator                          *alloc,
+//                           BSLS_COMPILERFEATURES_FORWARD_REF(KEY_TYPE) key);
+//      // Create an entry at the specified 'entry' address having the
+//      // specified 'key' and (if applicable) a default-constructed value,
+//      // using the specified 'alloc' to supply memory.
+//..
+// The 'HASH' and 'EQUAL' template parameters must be copy-constructible
+// function-objects on 'KEY' whose invocations do not throw.  Note that the
+// hash values produced by 'HASH' are further mixed by the table (with a single
+// multiplication), so a weak hash function (e.g., an identity function on
+// integral keys) does not result in pathological performance.
+//
+///Exception Safety
+///----------------
+// Operations inserting a single entry provide the strong exception-safety
+// guarantee.  The behavior is undefined if the move constructor of 'ENTRY'
+// throws during a rehash.
+//
+///Usage
+///-----
+// There is no usage example for this component since it is not meant for
+// direct client use.
+
+#include <bdlscm_version.h>
+
+#include <bdlc_flathashtable_groupcontrol.h>
+
+#include <bdlb_bitutil.h>
+
+#include <bslalg_swaputil.h>
+
+#include <bslma_allocator.h>
+#include <bslma_constructionutil.h>
+#include <bslma_default.h>
+#include <bslma_destructionutil.h>
+#include <bslma_usesbslmaallocator.h>
+
+#include <bslmf_movableref.h>
+#include <bslmf_nestedtraitdeclaration.h>
+
+#include <bsls_assert.h>
+#include <bsls_compilerfeatures.h>
+#include <bsls_exceptionutil.h>
+#include <bsls_performancehint.h>
+#include <bsls_types.h>
+#include <bsls_util.h>
+
+#include <bslstl_forwarditerator.h>
+
+#include <bsl_algorithm.h>
+#include <bsl_cstddef.h>
+#include <bsl_cstdint.h>
+#include <bsl_cstring.h>
+#include <bsl_iterator.h>
+#include <bsl_utility.h>
+
+namespace BloombergLP {
+namespace bdlc {
+
+                      // ===============================
+                      // class FlatHashTable_IteratorImp
+                      // ===============================
+
+template <class ENTRY>
+class FlatHashTable_IteratorImp {
+    // This class implements the methods required by 'bslstl::ForwardIterator'
+    // to provide forward iterators over the entries in use of a
+    // 'bdlc::FlatHashTable'.  The past-the-end iterator has null entry and
+    // control pointers.
+
+    // DATA
+    ENTRY              *d_entries_p;         // current entry, or 0 at end
+
+    const bsl::uint8_t *d_controls_p;        // control value of current entry
+
+    bsl::size_t         d_additionalLength;  // number of slots following the
+                                             // current one
+
+    // FRIENDS
+    template <class OTHER_ENTRY>
+    friend bool operator==(const FlatHashTable_IteratorImp<OTHER_ENTRY>&,
+                           const FlatHashTable_IteratorImp<OTHER_ENTRY>&);
+
+  public:
+    // CREATORS
+    FlatHashTable_IteratorImp();
+        // Create a past-the-end iterator implementation.
+
+    FlatHashTable_IteratorImp(ENTRY              *entries,
+                              const bsl::uint8_t *controls,
+                              bsl::size_t         additionalLength);
+        // Create an iterator implementation referring to the specified
+        // 'entries' having the corresponding specified 'controls', where the
+        // specified 'additionalLength' is the number of slots following
+        // 'entries' in the table.  The behavior is undefined unless 'controls'
+        // indicates an entry in use.
+
+    //! FlatHashTable_IteratorImp(const FlatHashTable_IteratorImp&) = default;
+    //! ~FlatHashTable_IteratorImp() = default;
+
+    // MANIPULATORS
+    //! FlatHashTable_IteratorImp& operator=(
+    //                           const FlatHashTable_IteratorImp&) = default;
+
+    void operator++();
+        // Advance this iterator to the next entry in use, or to the
+        // past-the-end value if there is no such entry.  The behavior is
+        // undefined unless this iterator is dereferenceable.
+
+    // ACCESSORS
+    ENTRY& operator*() const;
+        // Return a reference to the entry referred to by this iterator.  The
+        // behavior is undefined unless this iterator is dereferenceable.
+};
+
+// FREE OPERATORS
+template <class ENTRY>
+bool operator==(const FlatHashTable_IteratorImp<ENTRY>& lhs,
+                const FlatHashTable_IteratorImp<ENTRY>& rhs);
+    // Return 'true' if the specified 'lhs' and 'rhs' refer to the same entry,
+    // and 'false' otherwise.
+
+                            // ===================
+                            // class FlatHashTable
+                            // ===================
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+class FlatHashTable {
+    // This class template implements an open-addressed hash table of 'ENTRY'
+    // objects uniquely identified by 'KEY' values (see {Template
+    // Parameters}).  The capacity of the table is always either 0 or a power
+    // of two that is at least 'k_MIN_CAPACITY'.
+
+  public:
+    // PUBLIC TYPES
+    typedef ENTRY                                        value_type;
+    typedef KEY                                          key_type;
+    typedef HASH                                         hasher;
+    typedef EQUAL                                        key_equal;
+    typedef bsl::size_t                                  size_type;
+    typedef bsl::ptrdiff_t                               difference_type;
+    typedef value_type&                                  reference;
+    typedef const value_type&                            const_reference;
+    typedef value_type                                  *pointer;
+    typedef const value_type                            *const_pointer;
+
+    typedef bslstl::ForwardIterator<ENTRY, FlatHashTable_IteratorImp<ENTRY> >
+                                                         iterator;
+    typedef bslstl::ForwardIterator<const ENTRY,
+                                    FlatHashTable_IteratorImp<ENTRY> >
+                                                         const_iterator;
+
+    // PUBLIC CONSTANTS
+    enum { k_MIN_CAPACITY = FlatHashTable_GroupControl::k_SIZE };
+
+  private:
+    // PRIVATE TYPES
+    typedef FlatHashTable_GroupControl GroupControl;
+    typedef bsls::Types::Uint64        Uint64;
+
+    // PRIVATE CONSTANTS
+    static const Uint64 k_HASH_MULTIPLIER = 0x9E3779B97F4A7C15ULL;
+                                         // Fibonacci hashing multiplier
+
+    // DATA
+    ENTRY            *d_entries_p;          // array of 'd_capacity' slots
+
+    bsl::uint8_t     *d_controls_p;         // array of 'd_capacity' control
+                                            // values
+
+    bsl::size_t       d_size;               // number of entries in use
+
+    bsl::size_t       d_numErased;          // number of erased slots
+
+    bsl::size_t       d_capacity;           // number of slots
+
+    int               d_groupControlShift;  // shift applied to a mixed hash
+                                            // value to obtain a group index
+
+    HASH              d_hasher;             // hash function
+
+    EQUAL             d_equal;              // key equality function
+
+    bslma::Allocator *d_allocator_p;        // memory allocator (held, not
+                                            // owned)
+
+    // PRIVATE CLASS METHODS
+    static bsl::size_t capacityForSize(bsl::size_t numEntries);
+        // Return the smallest valid capacity of a table that can hold the
+        // specified 'numEntries' without exceeding the maximum load factor.
+
+    static Uint64 mix(bsl::size_t hashValue);
+        // Return the specified 'hashValue' after mixing its bits.
+
+    // PRIVATE MANIPULATORS
+    bsl::size_t commitEntry(bsl::size_t index, Uint64 mixedHash);
+        // Mark the slot at the specified 'index' as in use by an entry whose
+        // key has the specified 'mixedHash', update the statistics of this
+        // table, and return 'index'.
+
+    void eraseIndex(bsl::size_t index);
+        // Destroy the entry at the specified 'index' and mark its slot as
+        // available.  The behavior is undefined unless the slot at 'index' is
+        // in use.
+
+    bsl::size_t prepareInsert(Uint64 mixedHash);
+        // Return the index of an available slot in which an entry whose key
+        // has the specified 'mixedHash' may be constructed, growing this table
+        // if required.  Note that the slot is not marked as in use.
+
+    void rehashRaw(bsl::size_t newCapacity);
+        // Move the entries of this table into newly allocated arrays having
+        // the specified 'newCapacity' slots, and release the old arrays.  The
+        // behavior is undefined unless 'newCapacity' is a valid capacity that
+        // can hold 'size()' entries.
+
+    // PRIVATE ACCESSORS
+    bsl::size_t findAvailable(const bsl::uint8_t *controls,
+                              bsl::size_t         capacity,
+                              int                 shift,
+                              Uint64              mixedHash) const;
+        // Return the index of the first available slot, in the probe sequence
+        // for the specified 'mixedHash', of the specified 'controls' array of
+        // the specified 'capacity' using the specified group 'shift'.  The
+        // behavior is undefined unless an available slot exists.
+
+    bsl::size_t findKey(const KEY& key, Uint64 mixedHash) const;
+        // Return the index of the entry having the specified 'key' whose
+        // mixed hash value is the specified 'mixedHash', or 'd_capacity' if
+        // no such entry exists.
+
+    bsl::size_t maxSizeForCapacity() const;
+        // Return the number of slots that may be used (by entries or erased
+        // slots) before this table must grow.
+
+    iterator iteratorAt(bsl::size_t index) const;
+        // Return an iterator to the entry at the specified 'index', or the
+        // past-the-end iterator if 'index == d_capacity'.
+
+  public:
+    // TRAITS
+    BSLMF_NESTED_TRAIT_DECLARATION(FlatHashTable, bslma::UsesBslmaAllocator);
+
+    // CREATORS
+    FlatHashTable(bsl::size_t       capacity,
+                  const HASH&       hash,
+                  const EQUAL&      equal,
+                  bslma::Allocator *basicAllocator = 0);
+        // Create an empty table having at least the specified 'capacity' that
+        // will use the specified 'hash' to generate hash values and the
+        // specified 'equal' to verify that keys are equal.  Optionally specify
+        // a 'basicAllocator' used to supply memory.  If 'basicAllocator' is 0,
+        // the currently installed default allocator is used.  If 'capacity' is
+        // 0, no memory is allocated.
+
+    FlatHashTable(const FlatHashTable&  original,
+                  bslma::Allocator     *basicAllocator = 0);
+        // Create a table having the same value, hasher, and equality
+        // comparator as the specified 'original'.  Optionally specify a
+        // 'basicAllocator' used to supply memory.  If 'basicAllocator' is 0,
+        // the currently installed default allocator is used.
+
+    FlatHashTable(bslmf::MovableRef<FlatHashTable> original);
+        // Create a table having the same value, hasher, equality comparator,
+        // and allocator as the specified 'original' by moving the contents of
+        // 'original' to the new table.  'original' is left empty, having a
+        // capacity of 0.
+
+    FlatHashTable(bslmf::MovableRef<FlatHashTable>  original,
+                  bslma::Allocator                 *basicAllocator);
+        // Create a table having the same value, hasher, and equality
+        // comparator as the specified 'original', using the specified
+        // 'basicAllocator' to supply memory.  If 'basicAllocator' is 0, the
+        // currently installed default allocator is used.  If the allocator of
+        // 'original' is 'basicAllocator', the contents of 'original' are moved
+        // (in constant time) and 'original' is left empty; otherwise the
+        // entries of 'original' are moved individually and 'original' is left
+        // in a valid but unspecified state.
+
+    ~FlatHashTable();
+        // Destroy this object and each of its entries.
+
+    // MANIPULATORS
+    FlatHashTable& operator=(const FlatHashTable& rhs);
+        // Assign to this object the value, hasher, and equality comparator of
+        // the specified 'rhs', and return a reference providing modifiable
+        // access to this object.
+
+    FlatHashTable& operator=(bslmf::MovableRef<FlatHashTable> rhs);
+        // Assign to this object the value, hasher, and equality comparator of
+        // the specified 'rhs', and return a reference providing modifiable
+        // access to this object.  If the allocator of 'rhs' is the allocator
+        // of this object, the contents of 'rhs' are moved (in constant time)
+        // and 'rhs' is left empty; otherwise 'rhs' is left in a valid but
+        // unspecified state.
+
+    template <class KEY_TYPE>
+    ENTRY& operator[](BSLS_COMPILERFEATURES_FORWARD_REF(KEY_TYPE) key);
+        // Return a reference to the entry having the specified 'key', first
+        // inserting an entry created by 'ENTRY_UTIL::constructFromKey' if no
+        // such entry exists.
+
+    iterator begin();
+        // Return an iterator to the first entry in use in this table, or the
+        // past-the-end iterator if this table is empty.
+
+    void clear();
+        // Destroy all entries of this table.  Note that the capacity is not
+        // changed.
+
+    iterator end();
+        // Return the past-the-end iterator of this table.
+
+    bsl::pair<iterator, iterator> equal_range(const KEY& key);
+        // Return a pair of iterators delimiting the (zero or one) entries
+        // having the specified 'key'.
+
+    bsl::size_t erase(const KEY& key);
+        // Erase the entry having the specified 'key', if any, and return the
+        // number of entries erased (0 or 1).
+
+    iterator erase(const_iterator position);
+    iterator erase(iterator position);
+        // Erase the entry at the specified 'position', and return an iterator
+        // to the entry that followed it.  The behavior is undefined unless
+        // 'position' is a dereferenceable iterator into this table.
+
+    iterator erase(const_iterator first, const_iterator last);
+        // Erase the entries in the range '[first, last)', and return 'last'.
+        // The behavior is undefined unless '[first, last)' is a valid range of
+        // this table.
+
+    iterator find(const KEY& key);
+        // Return an iterator to the entry having the specified 'key', or the
+        // past-the-end iterator if no such entry exists.
+
+    template <class ENTRY_TYPE>
+    bsl::pair<iterator, bool> insert(
+                          BSLS_COMPILERFEATURES_FORWARD_REF(ENTRY_TYPE) entry);
+        // Insert an entry created (by 'ENTRY_UTIL::construct') from the
+        // specified 'entry' if no entry having the same key exists.  Return a
+        // pair whose 'first' member is an iterator to the (possibly newly
+        // inserted) entry having the key of 'entry', and whose 'second' member
+        // is 'true' if an insertion occurred.  The behavior is undefined
+        // unless 'ENTRY_TYPE' is (possibly 'const', or a movable reference
+        // to) 'ENTRY'.
+
+    void rehash(bsl::size_t minimumCapacity);
+        // Change the capacity of this table to the smallest valid capacity
+        // that is at least the specified 'minimumCapacity' and can hold the
+        // current entries, removing all erased slots.  If 0 is the resulting
+        // capacity, all memory is released.
+
+    void reserve(bsl::size_t numEntries);
+        // Ensure that this table can hold the specified 'numEntries' without
+        // a subsequent rehash.
+
+    void reset();
+        // Destroy all entries of this table and release all memory.  The
+        // resulting capacity is 0.
+
+    void swap(FlatHashTable& other);
+        // Efficiently exchange the value, hasher, and equality comparator of
+        // this object with those of the specified 'other'.  The behavior is
+        // undefined unless this object was created with the same allocator as
+        // 'other'.
+
+    // ACCESSORS
+    bslma::Allocator *allocator() const;
+        // Return the allocator used by this table to supply memory.
+
+    const_iterator begin() const;
+        // Return an iterator to the first entry in use in this table, or the
+        // past-the-end iterator if this table is empty.
+
+    bsl::size_t capacity() const;
+        // Return the number of slots in this table.
+
+    bool contains(const KEY& key) const;
+        // Return 'true' if this table contains an entry having the specified
+        // 'key', and 'false' otherwise.
+
+    const bsl::uint8_t *controls() const;
+        // Return the address of the array of 'capacity()' control values of
+        // this table.
+
+    bsl::size_t count(const KEY& key) const;
+        // Return the number of entries (0 or 1) having the specified 'key'.
+
+    bool empty() const;
+        // Return 'true' if this table contains no entries, and 'false'
+        // otherwise.
+
+    const_iterator end() const;
+        // Return the past-the-end iterator of this table.
+
+    const ENTRY *entries() const;
+        // Return the address of the array of 'capacity()' slots of this table.
+
+    bsl::pair<const_iterator, const_iterator> equal_range(
+                                                         const KEY& key) const;
+        // Return a pair of iterators delimiting the (zero or one) entries
+        // having the specified 'key'.
+
+    const_iterator find(const KEY& key) const;
+        // Return an iterator to the entry having the specified 'key', or the
+        // past-the-end iterator if no such entry exists.
+
+    HASH hash_function() const;
+        // Return (a copy of) the hash function of this table.
+
+    EQUAL key_eq() const;
+        // Return (a copy of) the key equality function of this table.
+
+    float load_factor() const;
+        // Return the ratio of the number of entries to the capacity of this
+        // table, or 0 if the capacity is 0.
+
+    float max_load_factor() const;
+        // Return the maximum load factor (0.875) of this table.
+
+    bsl::size_t size() const;
+        // Return the number of entries in this table.
+};
+
+// FREE OPERATORS
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+bool operator==(
+              const FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>& lhs,
+              const FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>& rhs);
+    // Return 'true' if the specified 'lhs' and 'rhs' have the same value, and
+    // 'false' otherwise.  Two tables have the same value if they have the same
+    // number of entries and, for each entry of 'lhs', 'rhs' contains an entry
+    // with an equal key that compares equal (using 'operator==') to it.
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+bool operator!=(
+              const FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>& lhs,
+              const FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>& rhs);
+    // Return 'true' if the specified 'lhs' and 'rhs' do not have the same
+    // value, and 'false' otherwise.
+
+// FREE FUNCTIONS
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+void swap(FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>& a,
+          FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>& b);
+    // Exchange the values of the specified 'a' and 'b'.  This method provides
+    // the no-throw exception-safety guarantee if 'a' and 'b' use the same
+    // allocator, and the basic guarantee otherwise.
+
+// ============================================================================
+//                             INLINE DEFINITIONS
+// ============================================================================
+
+                      // -------------------------------
+                      // class FlatHashTable_IteratorImp
+                      // -------------------------------
+
+// CREATORS
+template <class ENTRY>
+inline
+FlatHashTable_IteratorImp<ENTRY>::FlatHashTable_IteratorImp()
+: d_entries_p(0)
+, d_controls_p(0)
+, d_additionalLength(0)
+{
+}
+
+template <class ENTRY>
+inline
+FlatHashTable_IteratorImp<ENTRY>::FlatHashTable_IteratorImp(
+                                          ENTRY              *entries,
+                                          const bsl::uint8_t *controls,
+                                          bsl::size_t         additionalLength)
+: d_entries_p(entries)
+, d_controls_p(controls)
+, d_additionalLength(additionalLength)
+{
+    BSLS_ASSERT_SAFE(entries);
+    BSLS_ASSERT_SAFE(controls);
+    BSLS_ASSERT_SAFE(0 == (FlatHashTable_GroupControl::k_EMPTY & *controls));
+}
+
+// MANIPULATORS
+template <class ENTRY>
+void FlatHashTable_IteratorImp<ENTRY>::operator++()
+{
+    BSLS_ASSERT_SAFE(d_entries_p);
+
+    while (d_additionalLength) {
+        --d_additionalLength;
+        ++d_entries_p;
+        ++d_controls_p;
+        if (0 == (FlatHashTable_GroupControl::k_EMPTY & *d_controls_p)) {
+            return;                                                   // RETURN
+        }
+    }
+
+    d_entries_p  = 0;
+    d_controls_p = 0;
+}
+
+// ACCESSORS
+template <class ENTRY>
+inline
+ENTRY& FlatHashTable_IteratorImp<ENTRY>::operator*() const
+{
+    BSLS_ASSERT_SAFE(d_entries_p);
+
+    return *d_entries_p;
+}
+
+}  // close package namespace
+
+// FREE OPERATORS
+template <class ENTRY>
+inline
+bool bdlc::operator==(const FlatHashTable_IteratorImp<ENTRY>& lhs,
+                      const FlatHashTable_IteratorImp<ENTRY>& rhs)
+{
+    return lhs.d_entries_p == rhs.d_entries_p;
+}
+
+namespace bdlc {
+
+                            // -------------------
+                            // class FlatHashTable
+                            // -------------------
+
+// PRIVATE CLASS METHODS
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+bsl::size_t FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::
+                                        capacityForSize(bsl::size_t numEntries)
+{
+    if (0 == numEntries) {
+        return 0;                                                     // RETURN
+    }
+
+    bsl::size_t capacity = k_MIN_CAPACITY;
+    while (capacity - capacity / 8 < numEntries) {
+        capacity *= 2;
+    }
+    return capacity;
+}
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+inline
+typename FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::Uint64
+FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::mix(bsl::size_t hashValue)
+{
+    return static_cast<Uint64>(hashValue) * k_HASH_MULTIPLIER;
+}
+
+// PRIVATE MANIPULATORS
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+inline
+bsl::size_t FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::commitEntry(
+                                                        bsl::size_t index,
+                                                        Uint64      mixedHash)
+{
+    if (GroupControl::k_ERASED == d_controls_p[index]) {
+        --d_numErased;
+    }
+    d_controls_p[index] = static_cast<bsl::uint8_t>(mixedHash & 0x7F);
+    ++d_size;
+
+    return index;
+}
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+void FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::eraseIndex(
+                                                             bsl::size_t index)
+{
+    BSLS_ASSERT_SAFE(index < d_capacity);
+    BSLS_ASSERT_SAFE(0 == (GroupControl::k_EMPTY & d_controls_p[index]));
+
+    bslma::DestructionUtil::destroy(d_entries_p + index);
+
+    // If the group containing 'index' has an empty slot, no probe sequence
+    // has continued past this group, and the slot can be marked empty.
+    // Otherwise, the slot must be marked erased so that probe sequences
+    // passing through this group are not truncated.
+
+    const bsl::size_t groupStart = index & ~static_cast<bsl::size_t>(
+                                                     GroupControl::k_SIZE - 1);
+
+    if (GroupControl(d_controls_p + groupStart).neverFull()) {
+        d_controls_p[index] = GroupControl::k_EMPTY;
+    }
+    else {
+        d_controls_p[index] = GroupControl::k_ERASED;
+        ++d_numErased;
+    }
+    --d_size;
+}
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+bsl::size_t FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::prepareInsert(
+                                                              Uint64 mixedHash)
+{
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(
+                          d_size + d_numErased >= maxSizeForCapacity())) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+
+        // If at least half of the used slots are erased, rehashing to the
+        // same capacity reclaims them; otherwise, the capacity is doubled.
+
+        const bsl::size_t newCapacity =
+                      d_numErased > d_size && 0 != d_capacity
+                      ? d_capacity
+                      : bsl::max(capacityForSize(d_size + 1), 2 * d_capacity);
+
+        rehashRaw(newCapacity);
+    }
+
+    return findAvailable(d_controls_p,
+                         d_capacity,
+                         d_groupControlShift,
+                         mixedHash);
+}
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+void FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::rehashRaw(
+                                                       bsl::size_t newCapacity)
+{
+    BSLS_ASSERT(0 == newCapacity || k_MIN_CAPACITY <= newCapacity);
+    BSLS_ASSERT(0 == (newCapacity & (newCapacity - 1)));
+    BSLS_ASSERT(d_size <= newCapacity - newCapacity / 8);
+
+    ENTRY        *newEntries  = 0;
+    bsl::uint8_t *newControls = 0;
+    int           newShift    = 63;
+
+    if (newCapacity) {
+        newControls = static_cast<bsl::uint8_t *>(
+                                        d_allocator_p->allocate(newCapacity));
+        BSLS_TRY {
+            newEntries = static_cast<ENTRY *>(
+                         d_allocator_p->allocate(newCapacity * sizeof(ENTRY)));
+        }
+        BSLS_CATCH(...) {
+            d_allocator_p->deallocate(newControls);
+            BSLS_RETHROW;
+        }
+        bsl::memset(newControls, GroupControl::k_EMPTY, newCapacity);
+
+        const int numGroupBits = bdlb::BitUtil::log2(
+           static_cast<bsl::uint64_t>(newCapacity / GroupControl::k_SIZE));
+        newShift = numGroupBits ? 64 - numGroupBits : 63;
+
+        for (bsl::size_t i = 0; i < d_capacity; ++i) {
+            if (0 == (GroupControl::k_EMPTY & d_controls_p[i])) {
+                const Uint64 mixedHash =
+                                mix(d_hasher(ENTRY_UTIL::key(d_entries_p[i])));
+
+                const bsl::size_t index = findAvailable(newControls,
+                                                        newCapacity,
+                                                        newShift,
+                                                        mixedHash);
+
+                bslma::ConstructionUtil::destructiveMove(newEntries + index,
+                                                         d_allocator_p,
+                                                         d_entries_p + i);
+                newControls[index] =
+                                  static_cast<bsl::uint8_t>(mixedHash & 0x7F);
+            }
+        }
+    }
+    else {
+        BSLS_ASSERT(0 == d_size);
+    }
+
+    if (d_capacity) {
+        d_allocator_p->deallocate(d_entries_p);
+        d_allocator_p->deallocate(d_controls_p);
+    }
+
+    d_entries_p         = newEntries;
+    d_controls_p        = newControls;
+    d_capacity          = newCapacity;
+    d_numErased         = 0;
+    d_groupControlShift = newShift;
+}
+
+// PRIVATE ACCESSORS
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+bsl::size_t FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::findAvailable(
+                                     const bsl::uint8_t *controls,
+                                     bsl::size_t         capacity,
+                                     int                 shift,
+                                     Uint64              mixedHash) const
+{
+    BSLS_ASSERT_SAFE(controls);
+    BSLS_ASSERT_SAFE(capacity);
+
+    const bsl::size_t numGroups = capacity / GroupControl::k_SIZE;
+    const bsl::size_t mask      = numGroups - 1;
+
+    bsl::size_t groupIndex = static_cast<bsl::size_t>(mixedHash >> shift)
+                                                                        & mask;
+
+    // Quadratic (triangular number) probing visits every group when the
+    // number of groups is a power of two.
+
+    for (bsl::size_t i = 1; ; ++i) {
+        const bsl::size_t offset = groupIndex * GroupControl::k_SIZE;
+
+        const GroupControl::BitMask available =
+                                  GroupControl(controls + offset).available();
+        if (available) {
+            return offset + bdlb::BitUtil::numTrailingUnsetBits(
+                                                                  available);
+                                                                      // RETURN
+        }
+
+        BSLS_ASSERT_SAFE(i <= numGroups);
+
+        groupIndex = (groupIndex + i) & mask;
+    }
+}
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+bsl::size_t FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::findKey(
+                                                  const KEY& key,
+                                                  Uint64     mixedHash) const
+{
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(0 == d_capacity)) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+        return 0;                                                     // RETURN
+    }
+
+    const bsl::uint8_t h2        = static_cast<bsl::uint8_t>(mixedHash & 0x7F);
+    const bsl::size_t  numGroups = d_capacity / GroupControl::k_SIZE;
+    const bsl::size_t  mask      = numGroups - 1;
+
+    bsl::size_t groupIndex =
+            static_cast<bsl::size_t>(mixedHash >> d_groupControlShift) & mask;
+
+    for (bsl::size_t i = 1; i <= numGroups; ++i) {
+        const bsl::size_t  offset = groupIndex * GroupControl::k_SIZE;
+        const GroupControl group(d_controls_p + offset);
+
+        GroupControl::BitMask candidates = group.match(h2);
+        while (candidates) {
+            const bsl::size_t index =
+                   offset + bdlb::BitUtil::numTrailingUnsetBits(candidates);
+
+            if (BSLS_PERFORMANCEHINT_PREDICT_LIKELY(
+                          d_equal(key, ENTRY_UTIL::key(d_entries_p[index])))) {
+                return index;                                         // RETURN
+            }
+            candidates &= candidates - 1;
+        }
+
+        if (BSLS_PERFORMANCEHINT_PREDICT_LIKELY(group.neverFull())) {
+            return d_capacity;                                        // RETURN
+        }
+
+        groupIndex = (groupIndex + i) & mask;
+    }
+
+    return d_capacity;
+}
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+inline
+bsl::size_t
+FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::maxSizeForCapacity() const
+{
+    return d_capacity - d_capacity / 8;
+}
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+inline
+typename FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::iterator
+FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::iteratorAt(
+                                                       bsl::size_t index) const
+{
+    if (index >= d_capacity) {
+        return iterator();                                            // RETURN
+    }
+    return iterator(FlatHashTable_IteratorImp<ENTRY>(d_entries_p + index,
+                                                     d_controls_p + index,
+                                                     d_capacity - index - 1));
+}
+
+// CREATORS
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::FlatHashTable(
+                                       bsl::size_t       capacity,
+                                       const HASH&       hash,
+                                       const EQUAL&      equal,
+                                       bslma::Allocator *basicAllocator)
+: d_entries_p(0)
+, d_controls_p(0)
+, d_size(0)
+, d_numErased(0)
+, d_capacity(0)
+, d_groupControlShift(63)
+, d_hasher(hash)
+, d_equal(equal)
+, d_allocator_p(bslma::Default::allocator(basicAllocator))
+{
+    if (capacity) {
+        bsl::size_t newCapacity = k_MIN_CAPACITY;
+        while (newCapacity < capacity) {
+            newCapacity *= 2;
+        }
+        rehashRaw(newCapacity);
+    }
+}
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::FlatHashTable(
+                                        const FlatHashTable&  original,
+                                        bslma::Allocator     *basicAllocator)
+: d_entries_p(0)
+, d_controls_p(0)
+, d_size(0)
+, d_numErased(0)
+, d_capacity(0)
+, d_groupControlShift(63)
+, d_hasher(original.d_hasher)
+, d_equal(original.d_equal)
+, d_allocator_p(bslma::Default::allocator(basicAllocator))
+{
+    if (0 == original.d_size) {
+        return;                                                       // RETURN
+    }
+
+    rehashRaw(capacityForSize(original.d_size));
+
+    BSLS_TRY {
+        for (bsl::size_t i = 0; i < original.d_capacity; ++i) {
+            if (0 == (GroupControl::k_EMPTY & original.d_controls_p[i])) {
+                const ENTRY& entry     = original.d_entries_p[i];
+                const Uint64 mixedHash = mix(d_hasher(ENTRY_UTIL::key(entry)));
+                const bsl::size_t index = findAvailable(d_controls_p,
+                                                        d_capacity,
+                                                        d_groupControlShift,
+                                                        mixedHash);
+
+                ENTRY_UTIL::construct(d_entries_p + index,
+                                      d_allocator_p,
+                                      entry);
+                commitEntry(index, mixedHash);
+            }
+        }
+    }
+    BSLS_CATCH(...) {
+        reset();
+        BSLS_RETHROW;
+    }
+}
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::FlatHashTable(
+                                     bslmf::MovableRef<FlatHashTable> original)
+: d_entries_p(bslmf::MovableRefUtil::access(original).d_entries_p)
+, d_controls_p(bslmf::MovableRefUtil::access(original).d_controls_p)
+, d_size(bslmf::MovableRefUtil::access(original).d_size)
+, d_numErased(bslmf::MovableRefUtil::access(original).d_numErased)
+, d_capacity(bslmf::MovableRefUtil::access(original).d_capacity)
+, d_groupControlShift(
+                   bslmf::MovableRefUtil::access(original).d_groupControlShift)
+, d_hasher(bslmf::MovableRefUtil::access(original).d_hasher)
+, d_equal(bslmf::MovableRefUtil::access(original).d_equal)
+, d_allocator_p(bslmf::MovableRefUtil::access(original).d_allocator_p)
+{
+    FlatHashTable& lvalue = original;
+
+    lvalue.d_entries_p         = 0;
+    lvalue.d_controls_p        = 0;
+    lvalue.d_size              = 0;
+    lvalue.d_numErased         = 0;
+    lvalue.d_capacity          = 0;
+    lvalue.d_groupControlShift = 63;
+}
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::FlatHashTable(
+                            bslmf::MovableRef<FlatHashTable>  original,
+                            bslma::Allocator                 *basicAllocator)
+: d_entries_p(0)
+, d_controls_p(0)
+, d_size(0)
+, d_numErased(0)
+, d_capacity(0)
+, d_groupControlShift(63)
+, d_hasher(bslmf::MovableRefUtil::access(original).d_hasher)
+, d_equal(bslmf::MovableRefUtil::access(original).d_equal)
+, d_allocator_p(bslma::Default::allocator(basicAllocator))
+{
+    FlatHashTable& lvalue = original;
+
+    if (d_allocator_p == lvalue.d_allocator_p) {
+        swap(lvalue);
+        return;                                                       // RETURN
+    }
+
+    if (0 == lvalue.d_size) {
+        return;                                                       // RETURN
+    }
+
+    rehashRaw(capacityForSize(lvalue.d_size));
+
+    BSLS_TRY {
+        for (bsl::size_t i = 0; i < lvalue.d_capacity; ++i) {
+            if (0 == (GroupControl::k_EMPTY & lvalue.d_controls_p[i])) {
+                ENTRY&       entry     = lvalue.d_entries_p[i];
+                const Uint64 mixedHash = mix(d_hasher(ENTRY_UTIL::key(entry)));
+                const bsl::size_t index = findAvailable(d_controls_p,
+                                                        d_capacity,
+                                                        d_groupControlShift,
+                                                        mixedHash);
+
+                ENTRY_UTIL::construct(d_entries_p + index,
+                                      d_allocator_p,
+                                      bslmf::MovableRefUtil::move(entry));
+                commitEntry(index, mixedHash);
+            }
+        }
+    }
+    BSLS_CATCH(...) {
+        reset();
+        BSLS_RETHROW;
+    }
+}
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::~FlatHashTable()
+{
+    reset();
+}
+
+// MANIPULATORS
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>&
+FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::operator=(
+                                                      const FlatHashTable& rhs)
+{
+    if (this != &rhs) {
+        FlatHashTable other(rhs, d_allocator_p);
+        swap(other);
+    }
+    return *this;
+}
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>&
+FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::operator=(
+                                          bslmf::MovableRef<FlatHashTable> rhs)
+{
+    FlatHashTable& lvalue = rhs;
+
+    if (this != &lvalue) {
+        FlatHashTable other(bslmf::MovableRefUtil::move(lvalue),
+                            d_allocator_p);
+        swap(other);
+    }
+    return *this;
+}
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+template <class KEY_TYPE>
+ENTRY& FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::operator[](
+                              BSLS_COMPILERFEATURES_FORWARD_REF(KEY_TYPE) key)
+{
+    const KEY&   keyRef    = key;
+    const Uint64 mixedHash = mix(d_hasher(keyRef));
+
+    bsl::size_t index = findKey(keyRef, mixedHash);
+    if (index < d_capacity) {
+        return d_entries_p[index];                                    // RETURN
+    }
+
+    index = prepareInsert(mixedHash);
+    ENTRY_UTIL::constructFromKey(d_entries_p + index,
+                                 d_allocator_p,
+                                 BSLS_COMPILERFEATURES_FORWARD(KEY_TYPE, key));
+
+    return d_entries_p[commitEntry(index, mixedHash)];
+}
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+typename FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::iterator
+FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::begin()
+{
+    for (bsl::size_t offset = 0;
+         offset < d_capacity;
+         offset += GroupControl::k_SIZE) {
+        const GroupControl::BitMask inUse =
+                                   GroupControl(d_controls_p + offset).inUse();
+        if (inUse) {
+            return iteratorAt(offset +
+                              bdlb::BitUtil::numTrailingUnsetBits(inUse));
+                                                                      // RETURN
+        }
+    }
+    return iterator();
+}
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+void FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::clear()
+{
+    for (bsl::size_t i = 0; i < d_capacity; ++i) {
+        if (0 == (GroupControl::k_EMPTY & d_controls_p[i])) {
+            bslma::DestructionUtil::destroy(d_entries_p + i);
+        }
+    }
+    if (d_capacity) {
+        bsl::memset(d_controls_p, GroupControl::k_EMPTY, d_capacity);
+    }
+    d_size      = 0;
+    d_numErased = 0;
+}
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+inline
+typename FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::iterator
+FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::end()
+{
+    return iterator();
+}
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+bsl::pair<
+        typename FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::iterator,
+        typename FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::iterator>
+FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::equal_range(
+                                                                const KEY& key)
+{
+    iterator first = find(key);
+    iterator last  = first;
+    if (last != end()) {
+        ++last;
+    }
+    return bsl::make_pair(first, last);
+}
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+bsl::size_t FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::erase(
+                                                                const KEY& key)
+{
+    const bsl::size_t index = findKey(key, mix(d_hasher(key)));
+    if (index < d_capacity) {
+        eraseIndex(index);
+        return 1;                                                     // RETURN
+    }
+    return 0;
+}
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+typename FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::iterator
+FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::erase(
+                                                       const_iterator position)
+{
+    BSLS_ASSERT(position != end());
+
+    const ENTRY *address = bsls::Util::addressOf(*position);
+
+    BSLS_ASSERT(d_entries_p <= address && address < d_entries_p + d_capacity);
+
+    const bsl::size_t index = static_cast<bsl::size_t>(address - d_entries_p);
+
+    iterator next = iteratorAt(index);
+    ++next;
+
+    eraseIndex(index);
+
+    return next;
+}
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+inline
+typename FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::iterator
+FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::erase(iterator position)
+{
+    return erase(const_iterator(position));
+}
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+typename FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::iterator
+FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::erase(const_iterator first,
+                                                          const_iterator last)
+{
+    iterator rv;
+    while (first != last) {
+        rv    = erase(first);
+        first = rv;
+    }
+    if (last == end()) {
+        return end();                                                 // RETURN
+    }
+    const ENTRY *address = bsls::Util::addressOf(*last);
+    return iteratorAt(static_cast<bsl::size_t>(address - d_entries_p));
+}
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+inline
+typename FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::iterator
+FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::find(const KEY& key)
+{
+    return iteratorAt(findKey(key, mix(d_hasher(key))));
+}
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+template <class ENTRY_TYPE>
+bsl::pair<typename FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::
+                                                             iterator, bool>
+FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::insert(
+                           BSLS_COMPILERFEATURES_FORWARD_REF(ENTRY_TYPE) entry)
+{
+    const ENTRY& entryRef  = entry;
+    const Uint64 mixedHash = mix(d_hasher(ENTRY_UTIL::key(entryRef)));
+
+    bsl::size_t index = findKey(ENTRY_UTIL::key(entryRef), mixedHash);
+    if (index < d_capacity) {
+        return bsl::pair<iterator, bool>(iteratorAt(index), false);  // RETURN
+    }
+
+    index = prepareInsert(mixedHash);
+    ENTRY_UTIL::construct(d_entries_p + index,
+                          d_allocator_p,
+                          BSLS_COMPILERFEATURES_FORWARD(ENTRY_TYPE, entry));
+
+    return bsl::pair<iterator, bool>(
+                        iteratorAt(commitEntry(index, mixedHash)), true);
+}
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+void FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::rehash(
+                                                   bsl::size_t minimumCapacity)
+{
+    bsl::size_t newCapacity = capacityForSize(d_size);
+    if (minimumCapacity) {
+        newCapacity = bsl::max(newCapacity,
+                               static_cast<bsl::size_t>(k_MIN_CAPACITY));
+        while (newCapacity < minimumCapacity) {
+            newCapacity *= 2;
+        }
+    }
+
+    if (newCapacity != d_capacity || d_numErased) {
+        rehashRaw(newCapacity);
+    }
+}
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+void FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::reserve(
+                                                        bsl::size_t numEntries)
+{
+    if (numEntries > maxSizeForCapacity() - d_numErased) {
+        rehashRaw(capacityForSize(numEntries));
+    }
+}
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+void FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::reset()
+{
+    clear();
+    rehashRaw(0);
+}
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+void FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::swap(
+                                                          FlatHashTable& other)
+{
+    BSLS_ASSERT(d_allocator_p == other.d_allocator_p);
+
+    bslalg::SwapUtil::swap(&d_entries_p,         &other.d_entries_p);
+    bslalg::SwapUtil::swap(&d_controls_p,        &other.d_controls_p);
+    bslalg::SwapUtil::swap(&d_size,              &other.d_size);
+    bslalg::SwapUtil::swap(&d_numErased,         &other.d_numErased);
+    bslalg::SwapUtil::swap(&d_capacity,          &other.d_capacity);
+    bslalg::SwapUtil::swap(&d_groupControlShift, &other.d_groupControlShift);
+    bslalg::SwapUtil::swap(&d_hasher,            &other.d_hasher);
+    bslalg::SwapUtil::swap(&d_equal,             &other.d_equal);
+}
+
+// ACCESSORS
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+inline
+bslma::Allocator *
+FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::allocator() const
+{
+    return d_allocator_p;
+}
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+inline
+typename FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::const_iterator
+FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::begin() const
+{
+    return const_cast<FlatHashTable *>(this)->begin();
+}
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+inline
+bsl::size_t
+FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::capacity() const
+{
+    return d_capacity;
+}
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+inline
+bool FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::contains(
+                                                          const KEY& key) const
+{
+    return findKey(key, mix(d_hasher(key))) < d_capacity;
+}
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+inline
+const bsl::uint8_t *
+FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::controls() const
+{
+    return d_controls_p;
+}
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+inline
+bsl::size_t FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::count(
+                                                          const KEY& key) const
+{
+    return contains(key) ? 1 : 0;
+}
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+inline
+bool FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::empty() const
+{
+    return 0 == d_size;
+}
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+inline
+typename FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::const_iterator
+FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::end() const
+{
+    return const_iterator();
+}
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+inline
+const ENTRY *
+FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::entries() const
+{
+    return d_entries_p;
+}
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+inline
+bsl::pair<
+  typename FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::const_iterator,
+  typename FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::const_iterator>
+FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::equal_range(
+                                                          const KEY& key) const
+{
+    const_iterator first = find(key);
+    const_iterator last  = first;
+    if (last != end()) {
+        ++last;
+    }
+    return bsl::make_pair(first, last);
+}
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+inline
+typename FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::const_iterator
+FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::find(const KEY& key) const
+{
+    return iteratorAt(findKey(key, mix(d_hasher(key))));
+}
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+inline
+HASH FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::hash_function() const
+{
+    return d_hasher;
+}
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+inline
+EQUAL FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::key_eq() const
+{
+    return d_equal;
+}
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+inline
+float FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::load_factor() const
+{
+    return d_capacity ? static_cast<float>(d_size)
+                                          / static_cast<float>(d_capacity)
+                      : 0.0f;
+}
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+inline
+float
+FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::max_load_factor() const
+{
+    return 0.875f;
+}
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+inline
+bsl::size_t FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::size() const
+{
+    return d_size;
+}
+
+}  // close package namespace
+
+// FREE OPERATORS
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+bool bdlc::operator==(
+                const FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>& lhs,
+                const FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>& rhs)
+{
+    typedef typename FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::
+                                                 const_iterator ConstIterator;
+
+    if (lhs.size() != rhs.size()) {
+        return false;                                                 // RETURN
+    }
+
+    for (ConstIterator it = lhs.begin(); it != lhs.end(); ++it) {
+        ConstIterator match = rhs.find(ENTRY_UTIL::key(*it));
+        if (match == rhs.end() || !(*match == *it)) {
+            return false;                                             // RETURN
+        }
+    }
+    return true;
+}
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+inline
+bool bdlc::operator!=(
+                const FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>& lhs,
+                const FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>& rhs)
+{
+    return !(lhs == rhs);
+}
+
+// FREE FUNCTIONS
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+void bdlc::swap(FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>& a,
+                FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>& b)
+{
+    typedef FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL> Table;
+
+    if (a.allocator() == b.allocator()) {
+        a.swap(b);
+        return;                                                       // RETURN
+    }
+
+    Table futureA(b, a.allocator());
+    Table futureB(a, b.allocator());
+
+    futureA.swap(a);
+    futureB.swap(b);
+}
+
+}  // close enterprise namespace
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2020 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
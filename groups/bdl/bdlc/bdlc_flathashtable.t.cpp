@@ -0,0 +1,1016 @@
+// bdlc_flathashtable.t.cpp                                           -*-C++-*-
+#include <bdlc_flathashtable.h>
+
+#include <bslim_testutil.h>
+
+#include <bslma_default.h>
+#include <bslma_defaultallocatorguard.h>
+#include <bslma_testallocator.h>
+#include <bslma_testallocatorexception.h>
+
+#include <bslmf_movableref.h>
+
+#include <bsls_asserttest.h>
+#include <bsls_types.h>
+
+#include <bsl_cstdlib.h>
+#include <bsl_functional.h>
+#include <bsl_iostream.h>
+#include <bsl_map.h>
+#include <bsl_set.h>
+#include <bsl_string.h>
+#include <bsl_utility.h>
+
+using namespace BloombergLP;
+using namespace bsl;
+
+// ============================================================================
+//                             TEST PLAN
+// ----------------------------------------------------------------------------
+//                             Overview
+//                             --------
+// The component under test is an open-addressed hash table implemented in
+// terms of a group control query mechanism.  The table is tested with a
+// simple entry utility (holding 'int' keys) and with an entry utility holding
+// allocating 'bsl::string' keys, and its observable state is compared against
+// an oracle ('bsl::set') after sequences of pseudo-random operations.  Hash
+// functors producing poorly distributed and constant values are used to
+// exercise collisions and the probe sequence.
+// ----------------------------------------------------------------------------
+// CREATORS
+// [ 2] FlatHashTable(size_t, const HASH&, const EQUAL&, Allocator *ba = 0);
+// [ 5] FlatHashTable(const FlatHashTable&, Allocator *ba = 0);
+// [ 5] FlatHashTable(MovableRef<FlatHashTable>);
+// [ 5] FlatHashTable(MovableRef<FlatHashTable>, Allocator *);
+// [ 2] ~FlatHashTable();
+//
+// MANIPULATORS
+// [ 5] FlatHashTable& operator=(const FlatHashTable&);
+// [ 5] FlatHashTable& operator=(MovableRef<FlatHashTable>);
+// [ 3] ENTRY& operator[](KEY_TYPE&&);
+// [ 4] iterator begin();
+// [ 3] void clear();
+// [ 4] iterator end();
+// [ 3] pair<iterator, iterator> equal_range(const KEY&);
+// [ 3] size_t erase(const KEY&);
+// [ 4] iterator erase(const_iterator);
+// [ 4] iterator erase(iterator);
+// [ 4] iterator erase(const_iterator, const_iterator);
+// [ 3] iterator find(const KEY&);
+// [ 2] pair<iterator, bool> insert(ENTRY_TYPE&&);
+// [ 6] void rehash(size_t);
+// [ 6] void reserve(size_t);
+// [ 6] void reset();
+// [ 5] void swap(FlatHashTable&);
+//
+// ACCESSORS
+// [ 2] Allocator *allocator() const;
+// [ 4] const_iterator begin() const;
+// [ 2] size_t capacity() const;
+// [ 2] bool contains(const KEY&) const;
+// [ 2] const bsl::uint8_t *controls() const;
+// [ 2] size_t count(const KEY&) const;
+// [ 2] bool empty() const;
+// [ 4] const_iterator end() const;
+// [ 2] const ENTRY *entries() const;
+// [ 3] pair<cIter, cIter> equal_range(const KEY&) const;
+// [ 2] const_iterator find(const KEY&) const;
+// [ 2] HASH hash_function() const;
+// [ 2] EQUAL key_eq() const;
+// [ 2] float load_factor() const;
+// [ 2] float max_load_factor() const;
+// [ 2] size_t size() const;
+//
+// FREE OPERATORS
+// [ 5] bool operator==(const FlatHashTable&, const FlatHashTable&);
+// [ 5] bool operator!=(const FlatHashTable&, const FlatHashTable&);
+//
+// FREE FUNCTIONS
+// [ 5] void swap(FlatHashTable&, FlatHashTable&);
+// ----------------------------------------------------------------------------
+// [ 1] BREATHING TEST
+// [ 3] CONCERN: randomized operations agree with an oracle
+// [ 3] CONCERN: poorly distributed hash values are handled
+// [ 7] CONCERN: insertion provides the strong exception guarantee
+// [ 8] CONCERN: precondition violations are detected when enabled
+
+// ============================================================================
+//                     STANDARD BDE ASSERT TEST FUNCTION
+// ----------------------------------------------------------------------------
+
+namespace {
+
+int testStatus = 0;
+
+void aSsErT(bool condition, const char *message, int line)
+{
+    if (condition) {
+        cout << "Error " __FILE__ "(" << line << "): " << message
+             << "    (failed)" << endl;
+
+        if (0 <= testStatus && testStatus <= 100) {
+            ++testStatus;
+        }
+    }
+}
+
+}  // close unnamed namespace
+
+// ============================================================================
+//               STANDARD BDE TEST DRIVER MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT       BSLIM_TESTUTIL_ASSERT
+#define ASSERTV      BSLIM_TESTUTIL_ASSERTV
+
+#define LOOP_ASSERT  BSLIM_TESTUTIL_LOOP_ASSERT
+#define LOOP0_ASSERT BSLIM_TESTUTIL_LOOP0_ASSERT
+#define LOOP1_ASSERT BSLIM_TESTUTIL_LOOP1_ASSERT
+#define LOOP2_ASSERT BSLIM_TESTUTIL_LOOP2_ASSERT
+#define LOOP3_ASSERT BSLIM_TESTUTIL_LOOP3_ASSERT
+#define LOOP4_ASSERT BSLIM_TESTUTIL_LOOP4_ASSERT
+#define LOOP5_ASSERT BSLIM_TESTUTIL_LOOP5_ASSERT
+#define LOOP6_ASSERT BSLIM_TESTUTIL_LOOP6_ASSERT
+
+#define Q            BSLIM_TESTUTIL_Q   // Quote identifier literally.
+#define P            BSLIM_TESTUTIL_P   // Print identifier and value.
+#define P_           BSLIM_TESTUTIL_P_  // P(X) without '\n'.
+#define T_           BSLIM_TESTUTIL_T_  // Print a tab (w/o newline).
+#define L_           BSLIM_TESTUTIL_L_  // current Line number
+
+// ============================================================================
+//                     NEGATIVE-TEST MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT_SAFE_PASS(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_PASS(EXPR)
+#define ASSERT_SAFE_FAIL(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_FAIL(EXPR)
+#define ASSERT_PASS(EXPR)      BSLS_ASSERTTEST_ASSERT_PASS(EXPR)
+#define ASSERT_FAIL(EXPR)      BSLS_ASSERTTEST_ASSERT_FAIL(EXPR)
+#define ASSERT_OPT_PASS(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_PASS(EXPR)
+#define ASSERT_OPT_FAIL(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_FAIL(EXPR)
+
+// ============================================================================
+//                  GLOBAL TYPEDEFS/CONSTANTS FOR TESTING
+// ----------------------------------------------------------------------------
+
+static bool verbose;
+static bool veryVerbose;
+static bool veryVeryVerbose;
+
+                            // ===============
+                            // struct EntryUtil
+                            // ===============
+
+template <class ENTRY>
+struct EntryUtil {
+    // This test utility implements the 'ENTRY_UTIL' requirements of
+    // 'bdlc::FlatHashTable' for entries that are their own keys.
+
+    template <class ENTRY_TYPE>
+    static void construct(
+                   ENTRY                                         *entry,
+                   bslma::Allocator                              *allocator,
+                   BSLS_COMPILERFEATURES_FORWARD_REF(ENTRY_TYPE)  source)
+    {
+        bslma::ConstructionUtil::construct(
+                            entry,
+                            allocator,
+                            BSLS_COMPILERFEATURES_FORWARD(ENTRY_TYPE, source));
+    }
+
+    template <class KEY_TYPE>
+    static void constructFromKey(
+                     ENTRY                                       *entry,
+                     bslma::Allocator                            *allocator,
+                     BSLS_COMPILERFEATURES_FORWARD_REF(KEY_TYPE)  key)
+    {
+        bslma::ConstructionUtil::construct(
+                                 entry,
+                                 allocator,
+                                 BSLS_COMPILERFEATURES_FORWARD(KEY_TYPE, key));
+    }
+
+    static const ENTRY& key(const ENTRY& entry)
+    {
+        return entry;
+    }
+};
+
+                            // ===============
+                            // struct ModHash
+                            // ===============
+
+struct ModHash {
+    // This hash functor returns the value of an 'int' modulo a configurable
+    // divisor, producing many collisions for small divisors.
+
+    int d_divisor;
+
+    explicit ModHash(int divisor = 1000000007) : d_divisor(divisor) {}
+
+    bsl::size_t operator()(int value) const
+    {
+        return static_cast<bsl::size_t>(value % d_divisor);
+    }
+};
+
+typedef bdlc::FlatHashTable<int,
+                            int,
+                            EntryUtil<int>,
+                            ModHash,
+                            bsl::equal_to<int> >         Obj;
+
+typedef bdlc::FlatHashTable<bsl::string,
+                            bsl::string,
+                            EntryUtil<bsl::string>,
+                            bsl::hash<bsl::string>,
+                            bsl::equal_to<bsl::string> > StrObj;
+
+const char *const LONG_STRING = "a string long enough to require allocation";
+
+// ============================================================================
+//                     HELPER FUNCTIONS FOR TESTING
+// ----------------------------------------------------------------------------
+
+static bool verifyInvariants(const Obj& X)
+    // Return 'true' if the control values of the specified 'X' are consistent
+    // with its size and entries, and 'false' otherwise.
+{
+    bsl::size_t numInUse = 0;
+    for (bsl::size_t i = 0; i < X.capacity(); ++i) {
+        const bsl::uint8_t c = X.controls()[i];
+        if (0 == (0x80 & c)) {
+            ++numInUse;
+            if (X.find(X.entries()[i]) == X.end()) {
+                return false;                                         // RETURN
+            }
+        }
+        else if (bdlc::FlatHashTable_GroupControl::k_EMPTY  != c
+              && bdlc::FlatHashTable_GroupControl::k_ERASED != c) {
+            return false;                                             // RETURN
+        }
+    }
+    return numInUse == X.size()
+        && X.size() <= X.capacity() - X.capacity() / 8;
+}
+
+static bool agrees(const Obj& X, const bsl::set<int>& oracle)
+    // Return 'true' if the specified 'X' contains exactly the values of the
+    // specified 'oracle', and 'false' otherwise.
+{
+    if (X.size() != oracle.size()) {
+        return false;                                                 // RETURN
+    }
+    bsl::size_t numIterated = 0;
+    for (Obj::const_iterator it = X.begin(); it != X.end(); ++it) {
+        if (0 == oracle.count(*it)) {
+            return false;                                             // RETURN
+        }
+        ++numIterated;
+    }
+    return numIterated == oracle.size();
+}
+
+// ============================================================================
+//                               MAIN PROGRAM
+// ----------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    int test        = argc > 1 ? atoi(argv[1]) : 0;
+    verbose         = argc > 2;
+    veryVerbose     = argc > 3;
+    veryVeryVerbose = argc > 4;
+
+    cout << "TEST " << __FILE__ << " CASE " << test << endl;
+
+    bslma::TestAllocator globalAllocator("global", veryVeryVerbose);
+    bslma::Default::setGlobalAllocator(&globalAllocator);
+
+    bslma::TestAllocator defaultAllocator("default", veryVeryVerbose);
+    bslma::DefaultAllocatorGuard dag(&defaultAllocator);
+
+    switch (test) { case 0:
+      case 8: {
+        // --------------------------------------------------------------------
+        // TESTING PRECONDITIONS
+        //
+        // Concerns:
+        //: 1 Precondition violations are detected when enabled.
+        //
+        // Plan:
+        //: 1 Verify defensive checks are triggered for invalid values.  (C-1)
+        //
+        // Testing:
+        //   CONCERN: precondition violations are detected when enabled
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "TESTING PRECONDITIONS" << endl
+                          << "=====================" << endl;
+
+        bsls::AssertTestHandlerGuard hG;
+
+        bslma::TestAllocator sa("supplied", veryVeryVerbose);
+        bslma::TestAllocator oa("other",    veryVeryVerbose);
+
+        Obj mX(0, ModHash(), bsl::equal_to<int>(), &sa);
+        Obj mY(0, ModHash(), bsl::equal_to<int>(), &sa);
+        Obj mZ(0, ModHash(), bsl::equal_to<int>(), &oa);
+
+        mX.insert(1);
+
+        ASSERT_FAIL(mX.erase(mX.end()));
+        ASSERT_PASS(mX.erase(mX.begin()));
+
+        ASSERT_PASS(mX.swap(mY));
+        ASSERT_FAIL(mX.swap(mZ));
+      } break;
+      case 7: {
+        // --------------------------------------------------------------------
+        // TESTING EXCEPTION SAFETY
+        //
+        // Concerns:
+        //: 1 If an allocation fails during an insertion (of the entry or of a
+        //:   rehash), the table is unchanged.
+        //:
+        //: 2 No memory is leaked.
+        //
+        // Plan:
+        //: 1 Insert allocating strings within the 'bslma' exception test
+        //:   macros, and verify the value of the table after each exception.
+        //:   (C-1..2)
+        //
+        // Testing:
+        //   CONCERN: insertion provides the strong exception guarantee
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "TESTING EXCEPTION SAFETY" << endl
+                          << "========================" << endl;
+
+        bslma::TestAllocator sa("supplied", veryVeryVerbose);
+        {
+            StrObj mX(0,
+                      bsl::hash<bsl::string>(),
+                      bsl::equal_to<bsl::string>(),
+                      &sa);
+            const StrObj& X = mX;
+
+            for (int i = 0; i < 40; ++i) {
+                bsl::string value(LONG_STRING, &sa);
+                value.push_back(static_cast<char>('A' + i));
+
+                const bsl::size_t SIZE = X.size();
+
+                BSLMA_TESTALLOCATOR_EXCEPTION_TEST_BEGIN(sa) {
+                    ASSERTV(i, SIZE == X.size());
+                    ASSERTV(i, !X.contains(value));
+
+                    mX.insert(value);
+                } BSLMA_TESTALLOCATOR_EXCEPTION_TEST_END
+
+                ASSERTV(i, SIZE + 1 == X.size());
+                ASSERTV(i, X.contains(value));
+            }
+        }
+        ASSERTV(sa.numBlocksInUse(), 0 == sa.numBlocksInUse());
+      } break;
+      case 6: {
+        // --------------------------------------------------------------------
+        // TESTING 'rehash', 'reserve', AND 'reset'
+        //
+        // Concerns:
+        //: 1 'rehash' results in the smallest power-of-two capacity at least
+        //:   the requested capacity that can hold the entries, and preserves
+        //:   the entries.
+        //:
+        //: 2 'rehash(0)' on an empty table releases all memory.
+        //:
+        //: 3 'reserve' ensures 'n' entries can be inserted without a change of
+        //:   capacity.
+        //:
+        //: 4 'reset' destroys all entries and releases all memory.
+        //:
+        //: 5 Erased slots are reclaimed without growing the table.
+        //
+        // Plan:
+        //: 1 Exercise each method on tables of various sizes and verify the
+        //:   resulting capacity, value, and allocator usage.  (C-1..5)
+        //
+        // Testing:
+        //   void rehash(size_t);
+        //   void reserve(size_t);
+        //   void reset();
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                      << "TESTING 'rehash', 'reserve', AND 'reset'" << endl
+                      << "========================================" << endl;
+
+        bslma::TestAllocator sa("supplied", veryVeryVerbose);
+
+        Obj mX(0, ModHash(), bsl::equal_to<int>(), &sa);  const Obj& X = mX;
+
+        ASSERT(0 == X.capacity());
+        mX.rehash(1);
+        ASSERT(16 == X.capacity());
+        mX.rehash(17);
+        ASSERT(32 == X.capacity());
+        mX.rehash(0);
+        ASSERT(0 == X.capacity());
+        ASSERT(0 == sa.numBlocksInUse());
+
+        for (int numEntries = 1; numEntries < 300; numEntries += 7) {
+            mX.reset();
+            ASSERTV(numEntries, 0 == sa.numBlocksInUse());
+
+            mX.reserve(numEntries);
+            const bsl::size_t CAPACITY = X.capacity();
+            ASSERTV(numEntries, CAPACITY - CAPACITY / 8 >= static_cast<
+                                               bsl::size_t>(numEntries));
+            ASSERTV(numEntries, CAPACITY / 2 - CAPACITY / 16 < static_cast<
+                                  bsl::size_t>(numEntries) || 16 == CAPACITY);
+
+            for (int i = 0; i < numEntries; ++i) {
+                mX.insert(i * 3);
+            }
+            ASSERTV(numEntries, CAPACITY == X.capacity());
+
+            mX.rehash(4 * CAPACITY);
+            ASSERTV(numEntries, 4 * CAPACITY == X.capacity());
+            ASSERTV(numEntries, static_cast<bsl::size_t>(numEntries)
+                                                                 == X.size());
+            ASSERTV(numEntries, verifyInvariants(X));
+
+            mX.rehash(0);
+            ASSERTV(numEntries, CAPACITY == X.capacity());
+            for (int i = 0; i < numEntries; ++i) {
+                ASSERTV(numEntries, i, X.contains(i * 3));
+            }
+        }
+
+        if (verbose) cout << "\tErased slots are reclaimed." << endl;
+        {
+            mX.reset();
+            mX.reserve(100);
+            const bsl::size_t CAPACITY = X.capacity();
+
+            // Repeatedly insert and erase distinct keys; without reclamation
+            // of erased slots the table would grow.
+
+            for (int i = 0; i < 100000; ++i) {
+                mX.insert(i);
+                if (i >= 50) {
+                    ASSERTV(i, 1 == mX.erase(i - 50));
+                }
+            }
+            ASSERTV(CAPACITY, X.capacity(), CAPACITY == X.capacity());
+            ASSERT(50 == X.size());
+            ASSERT(verifyInvariants(X));
+        }
+      } break;
+      case 5: {
+        // --------------------------------------------------------------------
+        // TESTING VALUE SEMANTICS
+        //
+        // Concerns:
+        //: 1 The copy constructor creates an object with the same value, using
+        //:   the supplied (or default) allocator.
+        //:
+        //: 2 The move constructor transfers ownership without allocation when
+        //:   the allocators are the same, and moves entries otherwise.
+        //:
+        //: 3 Copy and move assignment result in the same value and retain the
+        //:   allocator of the target.
+        //:
+        //: 4 'operator==' compares values irrespective of insertion order and
+        //:   capacity, and 'operator!=' is its negation.
+        //:
+        //: 5 'swap' exchanges values; the free 'swap' works with different
+        //:   allocators.
+        //
+        // Plan:
+        //: 1 Create tables from a table of specifications, and verify the
+        //:   result of each operation against the oracle, and the allocators
+        //:   used.  (C-1..5)
+        //
+        // Testing:
+        //   FlatHashTable(const FlatHashTable&, Allocator *ba = 0);
+        //   FlatHashTable(MovableRef<FlatHashTable>);
+        //   FlatHashTable(MovableRef<FlatHashTable>, Allocator *);
+        //   FlatHashTable& operator=(const FlatHashTable&);
+        //   FlatHashTable& operator=(MovableRef<FlatHashTable>);
+        //   void swap(FlatHashTable&);
+        //   bool operator==(const FlatHashTable&, const FlatHashTable&);
+        //   bool operator!=(const FlatHashTable&, const FlatHashTable&);
+        //   void swap(FlatHashTable&, FlatHashTable&);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "TESTING VALUE SEMANTICS" << endl
+                          << "=======================" << endl;
+
+        static const int SIZES[] = { 0, 1, 2, 13, 14, 15, 16, 100, 1000 };
+        const int NUM_SIZES = static_cast<int>(sizeof SIZES / sizeof *SIZES);
+
+        bslma::TestAllocator sa("supplied", veryVeryVerbose);
+        bslma::TestAllocator scratch("scratch", veryVeryVerbose);
+        bslma::TestAllocator oa("other",    veryVeryVerbose);
+
+        for (int ti = 0; ti < NUM_SIZES; ++ti) {
+            const int SIZE = SIZES[ti];
+
+            StrObj mX(0,
+                      bsl::hash<bsl::string>(),
+                      bsl::equal_to<bsl::string>(),
+                      &sa);
+            const StrObj& X = mX;
+
+            StrObj mR(0,
+                      bsl::hash<bsl::string>(),
+                      bsl::equal_to<bsl::string>(),
+                      &sa);
+            const StrObj& R = mR;
+
+            for (int i = 0; i < SIZE; ++i) {
+                bsl::string value(LONG_STRING, &scratch);
+                value += bsl::to_string(i);
+                mX.insert(value);
+                mR.insert(value);
+            }
+            for (int i = SIZE - 1; i >= 0; --i) {
+                bsl::string value(LONG_STRING, &scratch);
+                value += bsl::to_string(i);
+                mR.erase(value);
+                mR.insert(value);
+            }
+            ASSERTV(SIZE, X == R);
+            ASSERTV(SIZE, !(X != R));
+
+            {
+                const StrObj Y(X, &oa);
+                ASSERTV(SIZE, X == Y);
+                ASSERTV(SIZE, &oa == Y.allocator());
+                ASSERTV(SIZE, SIZE <= oa.numBlocksInUse());
+            }
+            ASSERTV(SIZE, 0 == oa.numBlocksInUse());
+
+            {
+                StrObj mY(X, &sa);
+                const bsls::Types::Int64 NUM_BLOCKS = sa.numBlocksTotal();
+
+                const StrObj Z(bslmf::MovableRefUtil::move(mY));
+                ASSERTV(SIZE, NUM_BLOCKS == sa.numBlocksTotal());
+                ASSERTV(SIZE, X == Z);
+                ASSERTV(SIZE, mY.empty());
+                ASSERTV(SIZE, 0 == mY.capacity());
+
+                const StrObj W(bslmf::MovableRefUtil::move(
+                                                   const_cast<StrObj&>(Z)),
+                               &oa);
+                ASSERTV(SIZE, X == W);
+                ASSERTV(SIZE, &oa == W.allocator());
+                ASSERTV(SIZE, Z.size() == X.size());
+            }
+
+            {
+                StrObj mY(0,
+                          bsl::hash<bsl::string>(),
+                          bsl::equal_to<bsl::string>(),
+                          &oa);
+                mY.insert(bsl::string("extra", &scratch));
+                ASSERTV(SIZE, X != mY);
+
+                mY = X;
+                ASSERTV(SIZE, X == mY);
+                ASSERTV(SIZE, &oa == mY.allocator());
+
+                StrObj mZ(X, &sa);
+                mY.insert(bsl::string("another", &scratch));
+                mY = bslmf::MovableRefUtil::move(mZ);
+                ASSERTV(SIZE, X == mY);
+                ASSERTV(SIZE, &oa == mY.allocator());
+
+                StrObj mW(0,
+                          bsl::hash<bsl::string>(),
+                          bsl::equal_to<bsl::string>(),
+                          &sa);
+                mW.insert(bsl::string("single", &scratch));
+                const StrObj WW(mW, &sa);
+
+                mW.swap(mR);
+                ASSERTV(SIZE, X  == mW);
+                ASSERTV(SIZE, WW == mR);
+                mW.swap(mR);
+
+                bdlc::swap(mY, mW);
+                ASSERTV(SIZE, X  == mW);
+                ASSERTV(SIZE, WW == mY);
+                ASSERTV(SIZE, &oa == mY.allocator());
+                ASSERTV(SIZE, &sa == mW.allocator());
+            }
+            ASSERTV(SIZE, 0 == oa.numBlocksInUse());
+        }
+        ASSERTV(0 == sa.numBlocksInUse());
+        ASSERTV(0 == defaultAllocator.numBlocksTotal());
+      } break;
+      case 4: {
+        // --------------------------------------------------------------------
+        // TESTING ITERATION AND ITERATOR ERASURE
+        //
+        // Concerns:
+        //: 1 Iteration visits each entry exactly once, and the past-the-end
+        //:   iterator of an empty table equals its 'begin'.
+        //:
+        //: 2 'erase(position)' returns an iterator to the following entry, so
+        //:   that erasing while iterating visits each entry once.
+        //:
+        //: 3 'erase(first, last)' erases exactly the range.
+        //
+        // Plan:
+        //: 1 Iterate tables of various sizes, comparing with the oracle, and
+        //:   erase selected entries while iterating.  (C-1..3)
+        //
+        // Testing:
+        //   iterator begin();
+        //   iterator end();
+        //   const_iterator begin() const;
+        //   const_iterator end() const;
+        //   iterator erase(const_iterator);
+        //   iterator erase(iterator);
+        //   iterator erase(const_iterator, const_iterator);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "TESTING ITERATION AND ITERATOR ERASURE" << endl
+                          << "======================================" << endl;
+
+        bslma::TestAllocator sa("supplied", veryVeryVerbose);
+        bslma::TestAllocator scratch("scratch", veryVeryVerbose);
+
+        for (int size = 0; size < 200; size += 3) {
+            Obj mX(0, ModHash(), bsl::equal_to<int>(), &sa);
+            const Obj& X = mX;
+
+            ASSERTV(size, X.begin() == X.end());
+
+            bsl::set<int> oracle(&scratch);
+            for (int i = 0; i < size; ++i) {
+                mX.insert(i * 7 + 1);
+                oracle.insert(i * 7 + 1);
+            }
+            ASSERTV(size, agrees(X, oracle));
+
+            // Erase the even values while iterating.
+
+            for (Obj::iterator it = mX.begin(); it != mX.end(); ) {
+                if (0 == *it % 2) {
+                    oracle.erase(*it);
+                    it = mX.erase(it);
+                }
+                else {
+                    ++it;
+                }
+            }
+            ASSERTV(size, agrees(X, oracle));
+            ASSERTV(size, verifyInvariants(X));
+
+            // Erase a range from the second entry to the end.
+
+            if (X.size() > 1) {
+                Obj::const_iterator first = X.begin();
+                ++first;
+                for (Obj::const_iterator it = first; it != X.end(); ++it) {
+                    oracle.erase(*it);
+                }
+                Obj::iterator rv = mX.erase(first, X.end());
+                ASSERTV(size, rv == mX.end());
+                ASSERTV(size, 1 == X.size());
+                ASSERTV(size, agrees(X, oracle));
+            }
+        }
+        ASSERT(0 == sa.numBlocksInUse());
+      } break;
+      case 3: {
+        // --------------------------------------------------------------------
+        // TESTING RANDOMIZED OPERATIONS
+        //
+        // Concerns:
+        //: 1 Any sequence of 'insert', 'operator[]', and 'erase' leaves the
+        //:   table with the same set of keys as an oracle.
+        //:
+        //: 2 The table remains correct with poorly distributed hash values,
+        //:   including a constant hash function.
+        //:
+        //: 3 'find', 'equal_range', and 'clear' behave as expected.
+        //
+        // Plan:
+        //: 1 For a set of hash divisors (including 1), apply pseudo-random
+        //:   operations and compare with a 'bsl::set' oracle.  (C-1..3)
+        //
+        // Testing:
+        //   ENTRY& operator[](KEY_TYPE&&);
+        //   void clear();
+        //   pair<iterator, iterator> equal_range(const KEY&);
+        //   size_t erase(const KEY&);
+        //   iterator find(const KEY&);
+        //   pair<cIter, cIter> equal_range(const KEY&) const;
+        //   CONCERN: randomized operations agree with an oracle
+        //   CONCERN: poorly distributed hash values are handled
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "TESTING RANDOMIZED OPERATIONS" << endl
+                          << "=============================" << endl;
+
+        static const int DIVISORS[] = { 1, 2, 16, 1024, 1000000007 };
+        const int NUM_DIVISORS = static_cast<int>(sizeof DIVISORS
+                                                  / sizeof *DIVISORS);
+
+        bslma::TestAllocator sa("supplied", veryVeryVerbose);
+        bslma::TestAllocator scratch("scratch", veryVeryVerbose);
+
+        for (int ti = 0; ti < NUM_DIVISORS; ++ti) {
+            const int DIVISOR  = DIVISORS[ti];
+            const int NUM_OPS  = 1 == DIVISOR ? 3000 : 20000;
+            const int KEY_SPAN = 1 == DIVISOR ? 300  : 5000;
+
+            if (veryVerbose) { T_ P(DIVISOR) }
+
+            Obj mX(0, ModHash(DIVISOR), bsl::equal_to<int>(), &sa);
+            const Obj& X = mX;
+
+            bsl::set<int> oracle(&scratch);
+            unsigned int  seed = 12345;
+
+            for (int op = 0; op < NUM_OPS; ++op) {
+                seed = seed * 1103515245 + 12345;
+                const int key    = static_cast<int>((seed >> 8) % KEY_SPAN);
+                const int choice = static_cast<int>((seed >> 4) % 4);
+
+                switch (choice) {
+                  case 0: {
+                    const bool EXP = oracle.insert(key).second;
+                    bsl::pair<Obj::iterator, bool> rv = mX.insert(key);
+                    ASSERTV(DIVISOR, op, EXP == rv.second);
+                    ASSERTV(DIVISOR, op, key == *rv.first);
+                  } break;
+                  case 1: {
+                    oracle.insert(key);
+                    ASSERTV(DIVISOR, op, key == mX[key]);
+                  } break;
+                  case 2: {
+                    const bsl::size_t EXP = oracle.erase(key);
+                    ASSERTV(DIVISOR, op, EXP == mX.erase(key));
+                  } break;
+                  default: {
+                    const bool EXP = 1 == oracle.count(key);
+                    ASSERTV(DIVISOR, op, EXP == (mX.find(key) != mX.end()));
+                    ASSERTV(DIVISOR, op, EXP == (X.find(key) != X.end()));
+
+                    bsl::pair<Obj::iterator, Obj::iterator> range =
+                                                          mX.equal_range(key);
+                    ASSERTV(DIVISOR,
+                            op,
+                            EXP == (range.first != range.second));
+
+                    bsl::pair<Obj::const_iterator, Obj::const_iterator>
+                                                 cRange = X.equal_range(key);
+                    ASSERTV(DIVISOR,
+                            op,
+                            EXP == (cRange.first != cRange.second));
+                  } break;
+                }
+
+                if (0 == op % 997) {
+                    ASSERTV(DIVISOR, op, agrees(X, oracle));
+                    ASSERTV(DIVISOR, op, verifyInvariants(X));
+                }
+            }
+            ASSERTV(DIVISOR, agrees(X, oracle));
+            ASSERTV(DIVISOR, verifyInvariants(X));
+
+            const bsl::size_t CAPACITY = X.capacity();
+            mX.clear();
+            ASSERTV(DIVISOR, X.empty());
+            ASSERTV(DIVISOR, CAPACITY == X.capacity());
+            ASSERTV(DIVISOR, X.begin() == X.end());
+        }
+        ASSERT(0 == sa.numBlocksInUse());
+        ASSERT(0 == defaultAllocator.numBlocksTotal());
+      } break;
+      case 2: {
+        // --------------------------------------------------------------------
+        // TESTING PRIMARY MANIPULATORS AND BASIC ACCESSORS
+        //
+        // Concerns:
+        //: 1 A default table allocates no memory, and a table created with a
+        //:   non-zero capacity has the smallest valid capacity not less than
+        //:   the requested capacity.
+        //:
+        //: 2 'insert' adds an entry if and only if its key is not present, and
+        //:   grows the table before exceeding the maximum load factor.
+        //:
+        //: 3 The basic accessors reflect the state of the table.
+        //:
+        //: 4 The allocator supplied at construction (or the default) is used.
+        //
+        // Plan:
+        //: 1 Create tables with a variety of capacities and insert values,
+        //:   verifying the state and allocator usage after each insertion.
+        //:   (C-1..4)
+        //
+        // Testing:
+        //   FlatHashTable(size_t, const HASH&, const EQUAL&, Allocator *ba);
+        //   ~FlatHashTable();
+        //   pair<iterator, bool> insert(ENTRY_TYPE&&);
+        //   Allocator *allocator() const;
+        //   size_t capacity() const;
+        //   bool contains(const KEY&) const;
+        //   const bsl::uint8_t *controls() const;
+        //   size_t count(const KEY&) const;
+        //   bool empty() const;
+        //   const ENTRY *entries() const;
+        //   const_iterator find(const KEY&) const;
+        //   HASH hash_function() const;
+        //   EQUAL key_eq() const;
+        //   float load_factor() const;
+        //   float max_load_factor() const;
+        //   size_t size() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                 << "TESTING PRIMARY MANIPULATORS AND BASIC ACCESSORS" << endl
+                 << "================================================" << endl;
+
+        static const struct {
+            int         d_line;
+            bsl::size_t d_capacity;
+            bsl::size_t d_expCapacity;
+        } DATA[] = {
+            //LINE  CAP  EXP
+            //----  ---  ---
+            { L_,     0,   0 },
+            { L_,     1,  16 },
+            { L_,    15,  16 },
+            { L_,    16,  16 },
+            { L_,    17,  32 },
+            { L_,    64,  64 },
+            { L_,   100, 128 },
+        };
+        const int NUM_DATA = static_cast<int>(sizeof DATA / sizeof *DATA);
+
+        for (int ti = 0; ti < NUM_DATA; ++ti) {
+            const int         LINE         = DATA[ti].d_line;
+            const bsl::size_t CAPACITY     = DATA[ti].d_capacity;
+            const bsl::size_t EXP_CAPACITY = DATA[ti].d_expCapacity;
+
+            bslma::TestAllocator sa("supplied", veryVeryVerbose);
+            {
+                Obj mX(CAPACITY, ModHash(97), bsl::equal_to<int>(), &sa);
+                const Obj& X = mX;
+
+                ASSERTV(LINE, EXP_CAPACITY == X.capacity());
+                ASSERTV(LINE, &sa == X.allocator());
+                ASSERTV(LINE, X.empty());
+                ASSERTV(LINE, 0 == X.size());
+                ASSERTV(LINE, 0.0f == X.load_factor());
+                ASSERTV(LINE, 0.875f == X.max_load_factor());
+                ASSERTV(LINE, 97 == X.hash_function().d_divisor);
+                ASSERTV(LINE, X.key_eq()(3, 3));
+                ASSERTV(LINE, (0 == CAPACITY) == (0 == sa.numBlocksTotal()));
+                ASSERTV(LINE, 0 == defaultAllocator.numBlocksTotal());
+
+                for (int i = 0; i < 500; ++i) {
+                    const bsl::size_t OLD_CAPACITY = X.capacity();
+
+                    ASSERTV(LINE, i, !X.contains(i));
+                    ASSERTV(LINE, i, 0 == X.count(i));
+
+                    bsl::pair<Obj::iterator, bool> rv = mX.insert(i);
+                    ASSERTV(LINE, i, rv.second);
+                    ASSERTV(LINE, i, i == *rv.first);
+                    ASSERTV(LINE,
+                            i,
+                            X.entries() <= &*rv.first
+                         && &*rv.first < X.entries() + X.capacity());
+
+                    rv = mX.insert(i);
+                    ASSERTV(LINE, i, !rv.second);
+                    ASSERTV(LINE, i, i == *rv.first);
+
+                    ASSERTV(LINE, i, X.contains(i));
+                    ASSERTV(LINE, i, 1 == X.count(i));
+                    ASSERTV(LINE, i, i == *X.find(i));
+                    ASSERTV(LINE, i, static_cast<bsl::size_t>(i + 1)
+                                                                == X.size());
+                    ASSERTV(LINE, i, !X.empty());
+                    ASSERTV(LINE, i, X.load_factor() <= X.max_load_factor());
+                    ASSERTV(LINE, i, 0 == (X.capacity() & (X.capacity() - 1)));
+
+                    if (OLD_CAPACITY != X.capacity()) {
+                        ASSERTV(LINE, i, X.capacity() == 2 * OLD_CAPACITY
+                                              || 0 == OLD_CAPACITY);
+                    }
+                }
+                ASSERTV(LINE, verifyInvariants(X));
+                ASSERTV(LINE, 0 == defaultAllocator.numBlocksTotal());
+            }
+            ASSERTV(LINE, 0 == sa.numBlocksInUse());
+        }
+
+        if (verbose) cout << "\tDefault allocator is used." << endl;
+        {
+            Obj mX(1, ModHash(), bsl::equal_to<int>());
+            ASSERT(&defaultAllocator == mX.allocator());
+            ASSERT(2 == defaultAllocator.numBlocksInUse());
+        }
+        ASSERT(0 == defaultAllocator.numBlocksInUse());
+      } break;
+      case 1: {
+        // --------------------------------------------------------------------
+        // BREATHING TEST
+        //   This case exercises (but does not fully test) basic functionality.
+        //
+        // Concerns:
+        //: 1 The class is sufficiently functional to enable comprehensive
+        //:   testing in subsequent test cases.
+        //
+        // Plan:
+        //: 1 Create an object, insert, find, and erase entries.  (C-1)
+        //
+        // Testing:
+        //   BREATHING TEST
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "BREATHING TEST" << endl
+                          << "==============" << endl;
+
+        bslma::TestAllocator sa("supplied", veryVeryVerbose);
+        bslma::TestAllocator scratch("scratch", veryVeryVerbose);
+        {
+            StrObj mX(0,
+                      bsl::hash<bsl::string>(),
+                      bsl::equal_to<bsl::string>(),
+                      &sa);
+            const StrObj& X = mX;
+
+            ASSERT(0 == X.size());
+            ASSERT(0 == sa.numBlocksTotal());
+
+            const bsl::string KEY1(LONG_STRING, &scratch);
+            const bsl::string KEY2("x",         &scratch);
+
+            ASSERT(mX.insert(KEY1).second);
+            ASSERT(!mX.insert(KEY1).second);
+            ASSERT(1 == X.size());
+            ASSERT(16 == X.capacity());
+            ASSERT(X.contains(KEY1));
+            ASSERT(&sa == X.find(KEY1)->get_allocator().mechanism());
+
+            ASSERT(KEY2 == mX[KEY2]);
+            ASSERT(2 == X.size());
+
+            ASSERT(1 == mX.erase(KEY1));
+            ASSERT(0 == mX.erase(KEY1));
+            ASSERT(1 == X.size());
+            ASSERT(!X.contains(KEY1));
+        }
+        ASSERT(0 == sa.numBlocksInUse());
+        ASSERT(0 == defaultAllocator.numBlocksTotal());
+      } break;
+      default: {
+        cerr << "WARNING: CASE `" << test << "' NOT FOUND." << endl;
+        testStatus = -1;
+      }
+    }
+
+    // CONCERN: In no case does memory come from the global allocator.
+
+    ASSERTV(globalAllocator.numBlocksTotal(),
+            0 == globalAllocator.numBlocksTotal());
+
+    if (testStatus > 0) {
+        cerr << "Error, non-zero test status = " << testStatus << "." << endl;
+    }
+
+    return testStatus;
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2020 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,227 @@
+// bdlc_flathashtable_groupcontrol.h                                  -*-C++-*-
+#ifndef INCLUDED_BDLC_FLATHASHTABLE_GROUPCONTROL
+#define INCLUDED_BDLC_FLATHASHTABLE_GROUPCONTROL
+
+#include <bsls_ident.h>
+BSLS_IDENT("$Id: $")
+
+//@PURPOSE: Provide inquiries to a flat hash table group of control values.
+//
+//@CLASSES:
+//  bdlc::FlatHashTable_GroupControl: flat hash table group control inquiries
+//
+//@SEE_ALSO: bdlc_flathashtable
+//
+//@DESCRIPTION: This component implements the class,
+// 'bdlc::FlatHashTable_GroupControl', that provides query methods to a group
+// of flat hash table control values.  Note that the number of entries in a
+// group control and the inquiry performance is platform dependent: on
+// platforms supporting SSE2 a group is examined with a small, fixed number of
+// SIMD instructions, and a portable implementation that examines one control
+// value at a time is used otherwise.
+//
+// The control byte values have the following interpretation:
+//..
+//  +-----------+------------------------------------------------------------+
+//  | Value     | Meaning                                                    |
+//  +===========+============================================================+
+//  | 1000 0000 | 'k_EMPTY': the entry is available and the probe sequence   |
+//  |           | of any key that would visit this group stops here          |
+//  +-----------+------------------------------------------------------------+
+//  | 1111 1110 | 'k_ERASED': the entry is available, but a probe sequence   |
+//  |           | may continue beyond this group                             |
+//  +-----------+------------------------------------------------------------+
+//  | 0xxx xxxx | the entry is in use, and the lower seven bits of the       |
+//  |           | (mixed) hash of its key are 'xxx xxxx'                     |
+//  +-----------+------------------------------------------------------------+
+//..
+// An entry is "available" if and only if its control value has the high-order
+// bit set.
+//
+///Usage
+///-----
+// There is no usage example for this component since it is not meant for
+// direct client use.
+
+#include <bdlscm_version.h>
+
+#include <bsls_assert.h>
+#include <bsls_platform.h>
+#include <bsls_types.h>
+
+#include <bsl_cstddef.h>
+#include <bsl_cstdint.h>
+#include <bsl_cstring.h>
+
+#if defined(BSLS_PLATFORM_CPU_X86_64) ||                                      \
+   (defined(BSLS_PLATFORM_CPU_X86) && defined(__SSE2__))
+#define BDLC_FLATHASHTABLE_GROUPCONTROL_USE_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace BloombergLP {
+namespace bdlc {
+
+                     // ================================
+                     // class FlatHashTable_GroupControl
+                     // ================================
+
+class FlatHashTable_GroupControl {
+    // This class provides methods for making inquiries of the data of a group
+    // of control values of a flat hash table.
+
+  public:
+    // PUBLIC TYPES
+    typedef bsl::uint32_t BitMask;
+
+    // PUBLIC CONSTANTS
+    static const bsl::uint8_t k_EMPTY  = 0x80;
+    static const bsl::uint8_t k_ERASED = 0xFE;
+
+    enum { k_SIZE = 16 };  // number of control values in a group
+
+  private:
+    // DATA
+#if defined(BDLC_FLATHASHTABLE_GROUPCONTROL_USE_SSE2)
+    __m128i             d_value;          // group of control values
+#else
+    bsl::uint8_t        d_value[k_SIZE];  // group of control values
+#endif
+
+    // NOT IMPLEMENTED
+    FlatHashTable_GroupControl();
+    FlatHashTable_GroupControl(const FlatHashTable_GroupControl&);
+    FlatHashTable_GroupControl& operator=(const FlatHashTable_GroupControl&);
+
+  public:
+    // CREATORS
+    explicit FlatHashTable_GroupControl(const bsl::uint8_t *data);
+        // Create a group control query object using the specified 'data'.  The
+        // behavior is undefined unless 'data' has at least 'k_SIZE' readable
+        // values.  Note that 'data' need not be aligned.
+
+    //! ~FlatHashTable_GroupControl() = default;
+        // Destroy this object.
+
+    // ACCESSORS
+    BitMask available() const;
+        // Return a bit mask of the 'k_SIZE' entries that are available (i.e.,
+        // have the control value 'k_EMPTY' or 'k_ERASED'), where bit 'i'
+        // corresponds to the 'i'th control value of this group.
+
+    BitMask inUse() const;
+        // Return a bit mask of the 'k_SIZE' entries that are in use (i.e., are
+        // not available), where bit 'i' corresponds to the 'i'th control value
+        // of this group.
+
+    BitMask match(bsl::uint8_t value) const;
+        // Return a bit mask of the 'k_SIZE' entries having the specified
+        // 'value', where bit 'i' corresponds to the 'i'th control value of
+        // this group.  The behavior is undefined unless '0 == (0x80 & value)'.
+
+    bool neverFull() const;
+        // Return 'true' if this group contains at least one control value
+        // equal to 'k_EMPTY', and 'false' otherwise.  Note that a probe
+        // sequence need never continue past a group for which this method
+        // returns 'true'.
+};
+
+// ============================================================================
+//                             INLINE DEFINITIONS
+// ============================================================================
+
+                     // --------------------------------
+                     // class FlatHashTable_GroupControl
+                     // --------------------------------
+
+// CREATORS
+inline
+FlatHashTable_GroupControl::FlatHashTable_GroupControl(
+                                                     const bsl::uint8_t *data)
+{
+    BSLS_ASSERT_SAFE(data);
+
+#if defined(BDLC_FLATHASHTABLE_GROUPCONTROL_USE_SSE2)
+    d_value = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data));
+#else
+    bsl::memcpy(d_value, data, k_SIZE);
+#endif
+}
+
+// ACCESSORS
+inline
+FlatHashTable_GroupControl::BitMask
+FlatHashTable_GroupControl::available() const
+{
+#if defined(BDLC_FLATHASHTABLE_GROUPCONTROL_USE_SSE2)
+    return static_cast<BitMask>(_mm_movemask_epi8(d_value));
+#else
+    BitMask rv = 0;
+    for (int i = 0; i < k_SIZE; ++i) {
+        rv |= static_cast<BitMask>(d_value[i] >> 7) << i;
+    }
+    return rv;
+#endif
+}
+
+inline
+FlatHashTable_GroupControl::BitMask FlatHashTable_GroupControl::inUse() const
+{
+    return ~available() & static_cast<BitMask>(0xFFFF);
+}
+
+inline
+FlatHashTable_GroupControl::BitMask
+FlatHashTable_GroupControl::match(bsl::uint8_t value) const
+{
+    BSLS_ASSERT_SAFE(0 == (0x80 & value));
+
+#if defined(BDLC_FLATHASHTABLE_GROUPCONTROL_USE_SSE2)
+    const __m128i pattern = _mm_set1_epi8(static_cast<char>(value));
+    return static_cast<BitMask>(
+                      _mm_movemask_epi8(_mm_cmpeq_epi8(d_value, pattern)));
+#else
+    BitMask rv = 0;
+    for (int i = 0; i < k_SIZE; ++i) {
+        rv |= static_cast<BitMask>(value == d_value[i]) << i;
+    }
+    return rv;
+#endif
+}
+
+inline
+bool FlatHashTable_GroupControl::neverFull() const
+{
+#if defined(BDLC_FLATHASHTABLE_GROUPCONTROL_USE_SSE2)
+    const __m128i pattern = _mm_set1_epi8(static_cast<char>(k_EMPTY));
+    return 0 != _mm_movemask_epi8(_mm_cmpeq_epi8(d_value, pattern));
+#else
+    for (int i = 0; i < k_SIZE; ++i) {
+        if (k_EMPTY == d_value[i]) {
+            return true;                                              // RETURN
+        }
+    }
+    return false;
+#endif
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2020 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,333 @@
+// bdlc_flathashtable_groupcontrol.t.cpp                              -*-C++-*-
+#include <bdlc_flathashtable_groupcontrol.h>
+
+#include <bslim_testutil.h>
+
+#include <bsls_asserttest.h>
+
+#include <bsl_cstdint.h>
+#include <bsl_cstdlib.h>
+#include <bsl_cstring.h>
+#include <bsl_iostream.h>
+
+using namespace BloombergLP;
+using namespace bsl;
+
+// ============================================================================
+//                             TEST PLAN
+// ----------------------------------------------------------------------------
+//                             Overview
+//                             --------
+// The component under test is a query mechanism over a group of control
+// values.  The methods are pure functions of the group data, and are tested
+// by comparison against a straight-forward oracle on a table of group values,
+// including unaligned group data.
+// ----------------------------------------------------------------------------
+// CREATORS
+// [ 2] FlatHashTable_GroupControl(const bsl::uint8_t *data);
+//
+// ACCESSORS
+// [ 2] BitMask available() const;
+// [ 2] BitMask inUse() const;
+// [ 2] BitMask match(bsl::uint8_t value) const;
+// [ 2] bool neverFull() const;
+// ----------------------------------------------------------------------------
+// [ 1] BREATHING TEST
+// [ 3] CONCERN: precondition violations are detected when enabled
+
+// ============================================================================
+//                     STANDARD BDE ASSERT TEST FUNCTION
+// ----------------------------------------------------------------------------
+
+namespace {
+
+int testStatus = 0;
+
+void aSsErT(bool condition, const char *message, int line)
+{
+    if (condition) {
+        cout << "Error " __FILE__ "(" << line << "): " << message
+             << "    (failed)" << endl;
+
+        if (0 <= testStatus && testStatus <= 100) {
+            ++testStatus;
+        }
+    }
+}
+
+}  // close unnamed namespace
+
+// ============================================================================
+//               STANDARD BDE TEST DRIVER MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT       BSLIM_TESTUTIL_ASSERT
+#define ASSERTV      BSLIM_TESTUTIL_ASSERTV
+
+#define LOOP_ASSERT  BSLIM_TESTUTIL_LOOP_ASSERT
+#define LOOP0_ASSERT BSLIM_TESTUTIL_LOOP0_ASSERT
+#define LOOP1_ASSERT BSLIM_TESTUTIL_LOOP1_ASSERT
+#define LOOP2_ASSERT BSLIM_TESTUTIL_LOOP2_ASSERT
+#define LOOP3_ASSERT BSLIM_TESTUTIL_LOOP3_ASSERT
+#define LOOP4_ASSERT BSLIM_TESTUTIL_LOOP4_ASSERT
+#define LOOP5_ASSERT BSLIM_TESTUTIL_LOOP5_ASSERT
+#define LOOP6_ASSERT BSLIM_TESTUTIL_LOOP6_ASSERT
+
+#define Q            BSLIM_TESTUTIL_Q   // Quote identifier literally.
+#define P            BSLIM_TESTUTIL_P   // Print identifier and value.
+#define P_           BSLIM_TESTUTIL_P_  // P(X) without '\n'.
+#define T_           BSLIM_TESTUTIL_T_  // Print a tab (w/o newline).
+#define L_           BSLIM_TESTUTIL_L_  // current Line number
+
+// ============================================================================
+//                     NEGATIVE-TEST MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT_SAFE_PASS(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_PASS(EXPR)
+#define ASSERT_SAFE_FAIL(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_FAIL(EXPR)
+#define ASSERT_PASS(EXPR)      BSLS_ASSERTTEST_ASSERT_PASS(EXPR)
+#define ASSERT_FAIL(EXPR)      BSLS_ASSERTTEST_ASSERT_FAIL(EXPR)
+#define ASSERT_OPT_PASS(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_PASS(EXPR)
+#define ASSERT_OPT_FAIL(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_FAIL(EXPR)
+
+// ============================================================================
+//                  GLOBAL TYPEDEFS/CONSTANTS FOR TESTING
+// ----------------------------------------------------------------------------
+
+typedef bdlc::FlatHashTable_GroupControl Obj;
+typedef Obj::BitMask                     BitMask;
+
+const bsl::uint8_t E = Obj::k_EMPTY;
+const bsl::uint8_t D = Obj::k_ERASED;
+
+// ============================================================================
+//                     HELPER FUNCTIONS FOR TESTING
+// ----------------------------------------------------------------------------
+
+static BitMask oracleMatch(const bsl::uint8_t *data, bsl::uint8_t value)
+    // Return the bit mask of the control values in the specified 'data'
+    // equal to the specified 'value'.
+{
+    BitMask rv = 0;
+    for (int i = 0; i < Obj::k_SIZE; ++i) {
+        if (value == data[i]) {
+            rv |= static_cast<BitMask>(1) << i;
+        }
+    }
+    return rv;
+}
+
+static BitMask oracleAvailable(const bsl::uint8_t *data)
+    // Return the bit mask of the control values in the specified 'data'
+    // having the high-order bit set.
+{
+    BitMask rv = 0;
+    for (int i = 0; i < Obj::k_SIZE; ++i) {
+        if (0x80 & data[i]) {
+            rv |= static_cast<BitMask>(1) << i;
+        }
+    }
+    return rv;
+}
+
+// ============================================================================
+//                               MAIN PROGRAM
+// ----------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    int                 test = argc > 1 ? atoi(argv[1]) : 0;
+    bool             verbose = argc > 2;
+    bool         veryVerbose = argc > 3;
+
+    cout << "TEST " << __FILE__ << " CASE " << test << endl;
+
+    switch (test) { case 0:
+      case 3: {
+        // --------------------------------------------------------------------
+        // TESTING PRECONDITIONS
+        //
+        // Concerns:
+        //: 1 Precondition violations are detected when enabled.
+        //
+        // Plan:
+        //: 1 Verify defensive checks are triggered for invalid values.  (C-1)
+        //
+        // Testing:
+        //   CONCERN: precondition violations are detected when enabled
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "TESTING PRECONDITIONS" << endl
+                          << "=====================" << endl;
+
+        bsls::AssertTestHandlerGuard hG;
+
+        bsl::uint8_t data[Obj::k_SIZE];
+        bsl::memset(data, E, sizeof data);
+
+        const Obj X(data);
+
+        ASSERT_SAFE_PASS(X.match(0x00));
+        ASSERT_SAFE_PASS(X.match(0x7F));
+        ASSERT_SAFE_FAIL(X.match(0x80));
+        ASSERT_SAFE_FAIL(X.match(0xFF));
+
+        ASSERT_SAFE_PASS(Obj(data).available());
+        ASSERT_SAFE_FAIL(Obj(0).available());
+      } break;
+      case 2: {
+        // --------------------------------------------------------------------
+        // TESTING ACCESSORS
+        //
+        // Concerns:
+        //: 1 'available' returns a bit for exactly the 'k_EMPTY' and
+        //:   'k_ERASED' control values.
+        //:
+        //: 2 'inUse' is the complement of 'available' within 'k_SIZE' bits.
+        //:
+        //: 3 'match' returns a bit for exactly the control values equal to the
+        //:   supplied value.
+        //:
+        //: 4 'neverFull' returns 'true' if and only if the group contains a
+        //:   'k_EMPTY' control value.
+        //:
+        //: 5 The data need not be aligned.
+        //
+        // Plan:
+        //: 1 Using the table-driven technique, construct groups from various
+        //:   control values at every alignment offset of a buffer and compare
+        //:   the results of the accessors with an oracle.  (C-1..5)
+        //
+        // Testing:
+        //   FlatHashTable_GroupControl(const bsl::uint8_t *data);
+        //   BitMask available() const;
+        //   BitMask inUse() const;
+        //   BitMask match(bsl::uint8_t value) const;
+        //   bool neverFull() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "TESTING ACCESSORS" << endl
+                          << "=================" << endl;
+
+        static const struct {
+            int          d_line;
+            bsl::uint8_t d_data[Obj::k_SIZE];
+        } DATA[] = {
+            //LN  control values
+            //--  ----------------------------------------------------------
+            { L_, { E, E, E, E, E, E, E, E, E, E, E, E, E, E, E, E } },
+            { L_, { D, D, D, D, D, D, D, D, D, D, D, D, D, D, D, D } },
+            { L_, { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 } },
+            { L_, { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9,10,11,12,13,14,15 } },
+            { L_, { 1, E, 1, D, 1, E, 1, D, 1, E, 1, D, 1, E, 1, D } },
+            { L_, { D, D, D, D, D, D, D, D, D, D, D, D, D, D, D, E } },
+            { L_, { E, D, D, D, D, D, D, D, D, D, D, D, D, D, D, D } },
+            { L_, {127,0,127,0,127,0,127,0,127,0,127,0,127,0,127,0 } },
+            { L_, {99,99,99,99,99,99,99,99,99,99,99,99,99,99,99, E } },
+            { L_, { 5, 5, D, D, E, E, 5, 5, D, D, E, E, 5, 5, D, D } },
+        };
+        const int NUM_DATA = static_cast<int>(sizeof DATA / sizeof *DATA);
+
+        static const bsl::uint8_t VALUES[] = { 0, 1, 5, 15, 99, 127 };
+        const int NUM_VALUES = static_cast<int>(sizeof VALUES
+                                                / sizeof *VALUES);
+
+        for (int ti = 0; ti < NUM_DATA; ++ti) {
+            const int LINE = DATA[ti].d_line;
+
+            for (int offset = 0; offset < Obj::k_SIZE; ++offset) {
+                bsl::uint8_t buffer[2 * Obj::k_SIZE];
+                bsl::memset(buffer, 0x55, sizeof buffer);
+
+                bsl::uint8_t *data = buffer + offset;
+                bsl::memcpy(data, DATA[ti].d_data, Obj::k_SIZE);
+
+                if (veryVerbose) { T_ P_(LINE) P(offset) }
+
+                const Obj X(data);
+
+                const BitMask EXP_AVAILABLE = oracleAvailable(data);
+
+                ASSERTV(LINE, offset, EXP_AVAILABLE == X.available());
+                ASSERTV(LINE,
+                        offset,
+                        (~EXP_AVAILABLE & 0xFFFF) == X.inUse());
+                ASSERTV(LINE,
+                        offset,
+                        (0 != oracleMatch(data, E)) == X.neverFull());
+
+                for (int tj = 0; tj < NUM_VALUES; ++tj) {
+                    const bsl::uint8_t VALUE = VALUES[tj];
+
+                    ASSERTV(LINE,
+                            offset,
+                            VALUE,
+                            oracleMatch(data, VALUE) == X.match(VALUE));
+                }
+            }
+        }
+      } break;
+      case 1: {
+        // --------------------------------------------------------------------
+        // BREATHING TEST
+        //   This case exercises (but does not fully test) basic functionality.
+        //
+        // Concerns:
+        //: 1 The class is sufficiently functional to enable comprehensive
+        //:   testing in subsequent test cases.
+        //
+        // Plan:
+        //: 1 Create an object and exercise each accessor.  (C-1)
+        //
+        // Testing:
+        //   BREATHING TEST
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "BREATHING TEST" << endl
+                          << "==============" << endl;
+
+        bsl::uint8_t data[Obj::k_SIZE];
+        bsl::memset(data, E, sizeof data);
+        data[3] = 17;
+        data[7] = D;
+        data[9] = 17;
+
+        const Obj X(data);
+
+        ASSERT(0xFDF7 == X.available());
+        ASSERT(0x0208 == X.inUse());
+        ASSERT(0x0208 == X.match(17));
+        ASSERT(0      == X.match(18));
+        ASSERT(X.neverFull());
+      } break;
+      default: {
+        cerr << "WARNING: CASE `" << test << "' NOT FOUND." << endl;
+        testStatus = -1;
+      }
+    }
+
+    if (testStatus > 0) {
+        cerr << "Error, non-zero test status = " << testStatus << "." << endl;
+    }
+
+    return testStatus;
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2020 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,79 @@
+// bdlcc_shardedcache.cpp                                             -*-C++-*-
+#include <bdlcc_shardedcache.h>
+
+#include <bsls_ident.h>
+BSLS_IDENT_RCSID(bdlcc_shardedcache_cpp,"$Id$ $CSID$")
+
+#include <bsls_assert.h>
+
+namespace BloombergLP {
+namespace bdlcc {
+
+                    // ----------------------------------
+                    // class ShardedCache_FrequencySketch
+                    // ----------------------------------
+
+// CREATORS
+ShardedCache_FrequencySketch::ShardedCache_FrequencySketch(
+                                              bsl::size_t       capacity,
+                                              bslma::Allocator *basicAllocator)
+: d_table_p(0)
+, d_tableMask(0)
+, d_numIncrements(0)
+, d_sampleSize(10 * static_cast<bsls::Types::Uint64>(capacity))
+, d_allocator_p(bslma::Default::allocator(basicAllocator))
+{
+    BSLS_ASSERT(1 <= capacity);
+
+    // Use one word (16 counters) per item, rounded up to a power of two.
+
+    bsl::size_t numWords = 1;
+    while (numWords < capacity) {
+        numWords *= 2;
+    }
+    d_tableMask = numWords - 1;
+
+    d_table_p = static_cast<bsls::AtomicUint64 *>(
+                  d_allocator_p->allocate(numWords * sizeof *d_table_p));
+    for (bsl::size_t i = 0; i < numWords; ++i) {
+        new (d_table_p + i) bsls::AtomicUint64(0);
+    }
+}
+
+ShardedCache_FrequencySketch::~ShardedCache_FrequencySketch()
+{
+    // 'bsls::AtomicUint64' is trivially destructible.
+
+    d_allocator_p->deallocate(d_table_p);
+}
+
+// MANIPULATORS
+void ShardedCache_FrequencySketch::reset()
+{
+    const bsls::Types::Uint64 k_RESET_MASK = 0x7777777777777777ULL;
+
+    for (bsls::Types::Uint64 i = 0; i <= d_tableMask; ++i) {
+        d_table_p[i].storeRelaxed((d_table_p[i].loadRelaxed() >> 1)
+                                                              & k_RESET_MASK);
+    }
+    d_numIncrements.storeRelaxed(d_numIncrements.loadRelaxed() / 2);
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+// ----------------------------------------------------------------------------
+// Copyright 2020 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
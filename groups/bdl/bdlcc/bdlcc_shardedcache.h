@@ -0,0 +1,1544 @@
+// bdlcc_shardedcache.h                                               -*-C++-*-
+#ifndef INCLUDED_BDLCC_SHARDEDCACHE
+#define INCLUDED_BDLCC_SHARDEDCACHE
+
+#include <bsls_ident.h>
+BSLS_IDENT("$Id: $")
+
+//@PURPOSE: Provide a sharded in-process cache with scan-resistant eviction.
+//
+//@CLASSES:
+//  bdlcc::ShardedCacheEvictionPolicy: eviction policies of a sharded cache
+//  bdlcc::ShardedCache: sharded in-process key-value cache
+//
+//@SEE_ALSO: bdlcc_cache
+//
+//@DESCRIPTION: This component defines a single class template,
+// 'bdlcc::ShardedCache', implementing a thread-safe in-memory key-value cache
+// that is partitioned into independently locked shards, and whose eviction
+// policies do not require an exclusive lock when an item is found.
+//
+// 'bdlcc::ShardedCache' has the same template parameters as 'bdlcc::Cache':
+// the key type ('KEY'), the value type ('VALUE'), the optional hash function
+// ('HASH'), and the optional equal function ('EQUAL').  Values are held by
+// 'bsl::shared_ptr', exactly as in 'bdlcc::Cache'.
+//
+// The size of the cache is bounded by the 'capacity' supplied at
+// construction, which is divided among the shards: an item is assigned to a
+// shard by the hash of its key, and each shard evicts its own items when an
+// insertion would exceed its part of the capacity.  Therefore, an item may be
+// evicted while the cache as a whole holds fewer than 'capacity' items.
+//
+///Eviction Policies
+///-----------------
+// The eviction policy of a sharded cache is specified at construction by one
+// of the following values of 'bdlcc::ShardedCacheEvictionPolicy':
+//
+//: 'e_FIFO':
+//:   The item inserted earliest is evicted first.
+//:
+//: 'e_CLOCK':
+//:   Each item has a "visited" flag, set when the item is found by
+//:   'tryGetValue'.  The earliest inserted item is evicted, unless it is
+//:   visited, in which case its flag is cleared and it is moved to the back of
+//:   the eviction queue (also known as "second chance" eviction).
+//:
+//: 'e_SIEVE':
+//:   As with 'e_CLOCK', each item has a "visited" flag.  A "hand" moves from
+//:   the earliest inserted item towards the most recently inserted item,
+//:   clearing the flags of visited items, and evicts the first unvisited item
+//:   found; the hand then stays at the position of the evicted item.  Unlike
+//:   'e_CLOCK', visited items are not moved, so that new items that are not
+//:   accessed again are evicted quickly.
+//:
+//: 'e_TINYLFU':
+//:   Window TinyLFU.  Each shard estimates the access frequency of recently
+//:   used keys with a compact frequency sketch.  A new item is placed in a
+//:   small "window" region holding 1% of the capacity of the shard.  An item
+//:   leaving the window is admitted to the main region (managed as 'e_SIEVE')
+//:   only if its estimated frequency is greater than that of the item the
+//:   main region would evict; otherwise the item leaving the window is
+//:   evicted.
+//
+// LRU eviction (offered by 'bdlcc::Cache') is not provided, because
+// maintaining exact recency order requires every successful lookup to modify
+// the eviction queue under an exclusive lock.  'e_CLOCK' and 'e_SIEVE' are
+// approximations of LRU in which a lookup only sets a flag.  'e_SIEVE' quickly
+// evicts new items that are not accessed again, in preference to older items
+// that are accessed while the hand completes a pass over the queue, and
+// 'e_TINYLFU' admits a new item to the main region only if it is accessed more
+// often than the item it would replace.  Therefore, with these two policies, a
+// sequence of insertions of keys that are not accessed again (e.g., during a
+// full scan of a database) evicts few of the frequently accessed items;
+// 'e_TINYLFU' is the most resistant to such scans.
+//
+///Thread Safety
+///-------------
+// The 'bdlcc::ShardedCache' class template is fully thread-safe (see
+// 'bsldoc_glossary') provided that the allocator supplied at construction and
+// the default allocator in effect during the lifetime of cached items are both
+// fully thread-safe.
+//
+///Thread Contention
+///-----------------
+// Each shard is protected by a reader-writer lock.  'tryGetValue' acquires
+// only a read lock on the shard of the key, regardless of the eviction
+// policy, and records the access using atomic operations.  'insert' and
+// 'erase' acquire a write lock on the shard of the key; threads operating on
+// keys in different shards do not contend.  'size' and 'visit' acquire the
+// read lock of each shard in turn, and so do not observe a consistent snapshot
+// of the cache.  'clear' and 'setPostEvictionCallback' acquire the write lock
+// of every shard.
+//
+///Post-eviction Callback and Potential Deadlocks
+///---------------------------------------------
+// When an item is evicted or erased from the cache, the previously set
+// post-eviction callback (via the 'setPostEvictionCallback' method) will be
+// invoked within the calling thread, supplying a pointer to the item being
+// removed.
+//
+// The cache object itself should not be used in a post-eviction callback;
+// otherwise, a deadlock may result.  Since a write lock is held during the
+// call to the callback, invoking any operation on the cache that acquires a
+// lock inside the callback will lead to a deadlock.
+//
+///Runtime Complexity
+///------------------
+//..
+// +----------------------------------------------------+--------------------+
+// | Operation                                          | Complexity         |
+// +====================================================+====================+
+// | insert                                             | Average: O[1]      |
+// |                                                    | Worst:   O[n]      |
+// +----------------------------------------------------+--------------------+
+// | tryGetValue                                        | Average: O[1]      |
+// +----------------------------------------------------+--------------------+
+// | erase                                              | Average: O[1]      |
+// +----------------------------------------------------+--------------------+
+// | visit                                              | O[n]               |
+// +----------------------------------------------------+--------------------+
+//..
+//
+///Usage
+///-----
+// In this section we show intended use of this component.
+//
+///Example 1: A Scan-Resistant Cache
+///- - - - - - - - - - - - - - - - -
+// Suppose that a service caches records that are frequently looked up, and
+// occasionally performs a report that reads every record once.  With an LRU
+// cache, the report would replace the frequently accessed records with records
+// that are not accessed again.
+//
+// First, we create a cache of at most 100 items using the W-TinyLFU eviction
+// policy, having a single shard so that the capacity applies exactly:
+//..
+//  bdlcc::ShardedCache<int, int> cache(
+//                                bdlcc::ShardedCacheEvictionPolicy::e_TINYLFU,
+//                                100,
+//                                1,
+//                                &talloc);
+//  assert(1   == cache.numShards());
+//  assert(100 == cache.capacity());
+//..
+// Then, we insert the frequently accessed records, having keys 0 to 49, and
+// look each of them up:
+//..
+//  for (int i = 0; i < 50; ++i) {
+//      cache.insert(i, i * i);
+//  }
+//
+//  bsl::shared_ptr<int> value;
+//  for (int i = 0; i < 50; ++i) {
+//      int rc = cache.tryGetValue(&value, i);
+//      assert(0     == rc);
+//      assert(i * i == *value);
+//  }
+//..
+// Next, we simulate the report by inserting 1000 records that are not
+// accessed again:
+//..
+//  for (int i = 1000; i < 2000; ++i) {
+//      cache.insert(i, i * i);
+//  }
+//  assert(100 == cache.size());
+//..
+// Finally, we observe that the frequently accessed records are still cached,
+// because each of the records inserted by the report was accessed less often
+// than the record it would have replaced:
+//..
+//  for (int i = 0; i < 50; ++i) {
+//      int rc = cache.tryGetValue(&value, i);
+//      assert(0 == rc);
+//  }
+//..
+
+#include <bdlscm_version.h>
+
+#include <bslma_allocator.h>
+#include <bslma_autodestructor.h>
+#include <bslma_deallocatorproctor.h>
+#include <bslma_default.h>
+#include <bslma_usesbslmaallocator.h>
+
+#include <bslmf_integralconstant.h>
+#include <bslmf_movableref.h>
+
+#include <bslmt_readerwritermutex.h>
+#include <bslmt_readlockguard.h>
+#include <bslmt_writelockguard.h>
+
+#include <bsls_assert.h>
+#include <bsls_atomic.h>
+#include <bsls_types.h>
+
+#include <bsl_cstddef.h>
+#include <bsl_functional.h>
+#include <bsl_memory.h>
+#include <bsl_unordered_map.h>
+#include <bsl_utility.h>
+#include <bsl_vector.h>
+
+namespace BloombergLP {
+namespace bdlcc {
+
+                     // =================================
+                     // struct ShardedCacheEvictionPolicy
+                     // =================================
+
+struct ShardedCacheEvictionPolicy {
+    // This 'struct' provides a namespace for the eviction policies supported
+    // by 'ShardedCache'.
+
+    // TYPES
+    enum Enum {
+        // Enumeration of supported sharded cache eviction policies.
+
+        e_FIFO,    // First In, First Out
+        e_CLOCK,   // FIFO, giving accessed items a second chance
+        e_SIEVE,   // SIEVE (FIFO with a hand skipping accessed items)
+        e_TINYLFU  // Window TinyLFU (frequency-based admission)
+    };
+};
+
+                    // ==================================
+                    // class ShardedCache_FrequencySketch
+                    // ==================================
+
+class ShardedCache_FrequencySketch {
+    // This class implements a count-min sketch of 4-bit counters estimating
+    // the access frequency of recently accessed keys, identified by 64-bit
+    // hash values, as used by the TinyLFU admission policy.  Each estimate is
+    // the minimum of four counters, packed (with twelve counters of other
+    // keys) into a single 64-bit word.  Once the number of recorded accesses
+    // reaches ten times the capacity supplied at construction, all counters
+    // are halved so that the estimates reflect recent accesses.  'increment'
+    // and 'frequency' may be called concurrently; 'reset' requires exclusive
+    // access.  This class is an implementation detail of 'ShardedCache', and
+    // must not be used directly by clients.
+
+    // DATA
+    bsls::AtomicUint64  *d_table_p;       // counters, 16 per word
+
+    bsls::Types::Uint64  d_tableMask;     // number of words minus one
+
+    bsls::AtomicUint64   d_numIncrements; // accesses recorded since the last
+                                          // reset
+
+    bsls::Types::Uint64  d_sampleSize;    // number of accesses at which the
+                                          // counters are halved
+
+    bslma::Allocator    *d_allocator_p;   // memory allocator (held, not
+                                          // owned)
+
+    // NOT IMPLEMENTED
+    ShardedCache_FrequencySketch(const ShardedCache_FrequencySketch&);
+    ShardedCache_FrequencySketch& operator=(
+                                          const ShardedCache_FrequencySketch&);
+
+    // PRIVATE CLASS METHODS
+    static bsl::size_t indexOf(bsls::Types::Uint64 hash,
+                               int                 row,
+                               bsls::Types::Uint64 mask);
+        // Return the index of the word holding the counter for the specified
+        // 'hash' in the specified 'row' in a table having the specified
+        // 'mask'.
+
+  public:
+    // CREATORS
+    explicit ShardedCache_FrequencySketch(
+                                     bsl::size_t       capacity,
+                                     bslma::Allocator *basicAllocator = 0);
+        // Create a frequency sketch suitable for estimating the access
+        // frequency of the keys of a cache holding at most the specified
+        // 'capacity' items.  Optionally specify a 'basicAllocator' used to
+        // supply memory.  If 'basicAllocator' is 0, the currently installed
+        // default allocator is used.
+
+    ~ShardedCache_FrequencySketch();
+        // Destroy this object.
+
+    // MANIPULATORS
+    void increment(bsls::Types::Uint64 hash);
+        // Record an access to the key having the specified 'hash'.  Counters
+        // saturate at 15.
+
+    void reset();
+        // Halve every counter of this sketch.  The behavior is undefined if
+        // this method is invoked concurrently with any other method of this
+        // object.
+
+    // ACCESSORS
+    int frequency(bsls::Types::Uint64 hash) const;
+        // Return the estimated number of recorded accesses, in the range
+        // '[0 .. 15]', to the key having the specified 'hash'.
+
+    bool needsReset() const;
+        // Return 'true' if the number of accesses recorded since the last
+        // call to 'reset' has reached the sample size of this sketch, and
+        // 'false' otherwise.
+};
+
+                          // =======================
+                          // struct ShardedCache_Node
+                          // =======================
+
+template <class KEY, class VALUE>
+struct ShardedCache_Node {
+    // This 'struct' holds a cached value and the links of its position in the
+    // eviction queue of a shard of a 'ShardedCache'.  This 'struct' is an
+    // implementation detail of 'ShardedCache', and must not be used directly
+    // by clients.
+
+    // DATA
+    bsl::shared_ptr<VALUE>  d_value;      // cached value
+
+    ShardedCache_Node      *d_newer_p;    // next more recently inserted node
+                                          // of the queue, or 0
+
+    ShardedCache_Node      *d_older_p;    // next less recently inserted node
+                                          // of the queue, or 0
+
+    const KEY              *d_key_p;      // address of the key (in the map of
+                                          // the shard)
+
+    bsls::Types::Uint64     d_hash;       // mixed hash value of the key
+
+    bsls::AtomicInt         d_visited;    // 1 if found by 'tryGetValue' since
+                                          // last considered for eviction
+
+    bool                    d_inWindow;   // 'true' if in the TinyLFU window
+
+    // CREATORS
+    ShardedCache_Node();
+        // Create a node that is not linked into a queue.
+
+    ShardedCache_Node(const ShardedCache_Node& original);
+        // Create a node having the value and hash of the specified
+        // 'original' node, that is not linked into a queue.
+};
+
+                          // ========================
+                          // struct ShardedCache_Queue
+                          // ========================
+
+template <class KEY, class VALUE>
+struct ShardedCache_Queue {
+    // This 'struct' holds the ends of a doubly-linked list of
+    // 'ShardedCache_Node' objects in order of insertion.  This 'struct' is an
+    // implementation detail of 'ShardedCache', and must not be used directly
+    // by clients.
+
+    // PUBLIC TYPES
+    typedef ShardedCache_Node<KEY, VALUE> Node;
+
+    // DATA
+    Node        *d_newest_p;  // most recently inserted node, or 0
+    Node        *d_oldest_p;  // least recently inserted node, or 0
+    bsl::size_t  d_size;      // number of nodes
+
+    // CREATORS
+    ShardedCache_Queue();
+        // Create an empty queue.
+
+    // MANIPULATORS
+    void pushNewest(Node *node);
+        // Link the specified 'node' as the most recently inserted node of
+        // this queue.
+
+    void remove(Node *node);
+        // Unlink the specified 'node' from this queue.  The behavior is
+        // undefined unless 'node' is linked into this queue.
+};
+
+                          // ========================
+                          // class ShardedCache_Shard
+                          // ========================
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+class ShardedCache_Shard {
+    // This class holds the items of one shard of a 'ShardedCache', protected
+    // by a reader-writer lock, and implements the eviction policies.  This
+    // class is an implementation detail of 'ShardedCache', and must not be
+    // used directly by clients.
+
+  public:
+    // PUBLIC TYPES
+    typedef bsl::shared_ptr<VALUE>                        ValuePtrType;
+    typedef bsl::function<void(const ValuePtrType&)>      PostEvictionCallback;
+
+  private:
+    // PRIVATE TYPES
+    typedef ShardedCache_Node<KEY, VALUE>                 Node;
+    typedef ShardedCache_Queue<KEY, VALUE>                Queue;
+    typedef bsl::unordered_map<KEY, Node, HASH, EQUAL>    MapType;
+    typedef bslmt::ReaderWriterMutex                      LockType;
+
+    // DATA
+    mutable LockType              d_lock;            // reader-writer lock
+
+    MapType                       d_map;             // key-node pairs
+
+    Queue                         d_window;          // TinyLFU window region
+
+    Queue                         d_main;            // main eviction queue
+
+    Node                         *d_hand_p;          // SIEVE hand, or 0 to
+                                                     // start from the oldest
+                                                     // node
+
+    ShardedCacheEvictionPolicy::Enum
+                                  d_evictionPolicy;  // eviction policy
+
+    bsl::size_t                   d_windowCapacity;  // capacity of the
+                                                     // window region
+
+    bsl::size_t                   d_mainCapacity;    // capacity of the main
+                                                     // region
+
+    ShardedCache_FrequencySketch  d_sketch;          // access frequencies
+                                                     // (TinyLFU only)
+
+    const PostEvictionCallback   *d_postEvictionCallback_p;
+                                                     // callback (held, not
+                                                     // owned)
+
+    // NOT IMPLEMENTED
+    ShardedCache_Shard(const ShardedCache_Shard&);
+    ShardedCache_Shard& operator=(const ShardedCache_Shard&);
+
+    // PRIVATE MANIPULATORS
+    void evict(Node *node);
+        // Remove the specified 'node' from this shard and invoke the
+        // post-eviction callback for its value.
+
+    void makeRoom();
+        // Evict one item according to the eviction policy of this shard.  The
+        // behavior is undefined unless the main queue is not empty.
+
+    void promote();
+        // Move the least recently inserted node of the TinyLFU window to the
+        // main region, if it has room or the estimated frequency of the node
+        // exceeds that of the victim of the main region (which is then
+        // evicted), and evict the node otherwise.
+
+    Node *selectVictim();
+        // Return the node to be evicted next from the main queue according
+        // to the eviction policy of this shard, clearing the visited flag of
+        // the nodes passed over.  The behavior is undefined unless the main
+        // queue is not empty.
+
+    void unlink(Node *node);
+        // Remove the specified 'node' from the queue holding it, moving the
+        // SIEVE hand if it refers to 'node'.
+
+  public:
+    // CREATORS
+    ShardedCache_Shard(
+                     ShardedCacheEvictionPolicy::Enum  evictionPolicy,
+                     bsl::size_t                       capacity,
+                     const HASH&                       hashFunction,
+                     const EQUAL&                      equalFunction,
+                     const PostEvictionCallback       *postEvictionCallback,
+                     bslma::Allocator                 *basicAllocator);
+        // Create an empty shard holding at most the specified 'capacity'
+        // items, evicted according to the specified 'evictionPolicy', using
+        // the specified 'hashFunction' and 'equalFunction' to organize keys,
+        // invoking the specified 'postEvictionCallback' for each evicted
+        // item, and using the specified 'basicAllocator' to supply memory.
+
+    //! ~ShardedCache_Shard() = default;
+        // Destroy this object.
+
+    // MANIPULATORS
+    void clear();
+        // Remove all items from this shard.  Do *not* invoke the
+        // post-eviction callback.
+
+    int erase(const KEY& key);
+        // Remove the item having the specified 'key' from this shard and
+        // invoke the post-eviction callback for it.  Return 0 on success and
+        // 1 if 'key' does not exist.
+
+    bool insert(const KEY&          key,
+                const ValuePtrType& valuePtr,
+                bsls::Types::Uint64 hash);
+        // Insert the specified 'key' having the specified mixed 'hash' and
+        // its associated 'valuePtr' into this shard, evicting items as
+        // required by its capacity.  If 'key' already exists, replace its
+        // value.  Return 'true' if 'key' was not previously in this shard, and
+        // 'false' otherwise.
+
+    LockType& lock();
+        // Return a reference providing modifiable access to the lock of this
+        // shard.
+
+    int tryGetValue(ValuePtrType        *value,
+                    const KEY&           key,
+                    bsls::Types::Uint64  hash);
+        // Load, into the specified 'value', the value associated with the
+        // specified 'key' having the specified mixed 'hash', and record the
+        // access.  Return 0 on success, and 1 if 'key' does not exist.
+
+    // ACCESSORS
+    EQUAL equalFunction() const;
+        // Return (a copy of) the key-equality functor used by this shard.
+
+    HASH hashFunction() const;
+        // Return (a copy of) the hash functor used by this shard.
+
+    bsl::size_t size() const;
+        // Return the number of items in this shard.
+
+    template <class VISITOR>
+    bool visit(VISITOR& visitor) const;
+        // Call the specified 'visitor' for every item stored in this shard
+        // until 'visitor' returns 'false'.  Return 'false' if 'visitor'
+        // returned 'false', and 'true' otherwise.
+};
+
+                             // ==================
+                             // class ShardedCache
+                             // ==================
+
+template <class KEY,
+          class VALUE,
+          class HASH  = bsl::hash<KEY>,
+          class EQUAL = bsl::equal_to<KEY> >
+class ShardedCache {
+    // This class represents an in-process key-value store partitioned into
+    // independently locked shards, supporting eviction policies that do not
+    // modify the eviction queue on a successful lookup.
+
+  public:
+    // PUBLIC TYPES
+    typedef bsl::shared_ptr<VALUE>                        ValuePtrType;
+        // Shared pointer type pointing to value type.
+
+    typedef bsl::function<void(const ValuePtrType&)>      PostEvictionCallback;
+        // Type of function to call after an item has been evicted from the
+        // cache.
+
+    typedef bsl::pair<KEY, ValuePtrType>                  KVType;
+        // Value type of a bulk insert entry.
+
+    // PUBLIC CONSTANTS
+    enum {
+        k_DEFAULT_NUM_SHARDS = 16  // default number of shards
+    };
+
+  private:
+    // PRIVATE TYPES
+    typedef ShardedCache_Shard<KEY, VALUE, HASH, EQUAL>   Shard;
+
+    // DATA
+    bslma::Allocator           *d_allocator_p;          // memory allocator
+                                                        // (held, not owned)
+
+    Shard                      *d_shards_p;             // array of shards
+
+    bsl::size_t                 d_numShards;            // number of shards (a
+                                                        // power of two)
+
+    int                         d_shardShift;           // right shift of a
+                                                        // mixed hash value
+                                                        // yielding the shard
+
+    bsl::size_t                 d_capacity;             // maximum number of
+                                                        // items
+
+    ShardedCacheEvictionPolicy::Enum
+                                d_evictionPolicy;       // eviction policy
+
+    HASH                        d_hashFunction;         // hash functor
+
+    PostEvictionCallback        d_postEvictionCallback; // the function to
+                                                        // call after a value
+                                                        // has been evicted
+                                                        // from the cache
+
+    // NOT IMPLEMENTED
+    ShardedCache(const ShardedCache&);
+    ShardedCache& operator=(const ShardedCache&);
+
+    // PRIVATE CLASS METHODS
+    static bsls::Types::Uint64 mix(bsl::size_t hash);
+        // Return a 64-bit value whose bits each depend on every bit of the
+        // specified 'hash'.
+
+    // PRIVATE MANIPULATORS
+    void init(bsl::size_t  numShards,
+              const HASH&  hashFunction,
+              const EQUAL& equalFunction);
+        // Create the shards of this cache, using the specified 'numShards'
+        // (to be rounded as documented by the constructors), and the
+        // specified 'hashFunction' and 'equalFunction'.
+
+    Shard& shardOf(bsls::Types::Uint64 mixedHash);
+        // Return a reference providing modifiable access to the shard holding
+        // the keys having the specified 'mixedHash'.
+
+    void populateValuePtrType(ValuePtrType             *dst,
+                              const VALUE&              value,
+                              bsl::true_type);
+    void populateValuePtrType(ValuePtrType             *dst,
+                              const VALUE&              value,
+                              bsl::false_type);
+    void populateValuePtrType(ValuePtrType             *dst,
+                              bslmf::MovableRef<VALUE>  value,
+                              bsl::true_type);
+    void populateValuePtrType(ValuePtrType             *dst,
+                              bslmf::MovableRef<VALUE>  value,
+                              bsl::false_type);
+        // Allocate a footprint for the specified 'value', copy or move 'value'
+        // into the footprint and load the specified '*dst' with a pointer to
+        // the value.
+
+  public:
+    // CREATORS
+    ShardedCache(ShardedCacheEvictionPolicy::Enum  evictionPolicy,
+                 bsl::size_t                       capacity,
+                 bslma::Allocator                 *basicAllocator = 0);
+    ShardedCache(ShardedCacheEvictionPolicy::Enum  evictionPolicy,
+                 bsl::size_t                       capacity,
+                 bsl::size_t                       numShards,
+                 bslma::Allocator                 *basicAllocator = 0);
+        // Create an empty cache holding at most the specified 'capacity'
+        // items, evicted according to the specified 'evictionPolicy'.
+        // Optionally specify 'numShards', the number of independently locked
+        // shards, which is rounded up to a power of two, but is at most the
+        // largest power of two not greater than 'capacity'; if 'numShards' is
+        // not specified, 'k_DEFAULT_NUM_SHARDS' is used.  Optionally specify
+        // a 'basicAllocator' used to supply memory.  If 'basicAllocator' is 0,
+        // the currently installed default allocator is used.  The behavior is
+        // undefined unless '1 <= capacity' and '1 <= numShards'.
+
+    ShardedCache(ShardedCacheEvictionPolicy::Enum  evictionPolicy,
+                 bsl::size_t                       capacity,
+                 bsl::size_t                       numShards,
+                 const HASH&                       hashFunction,
+                 const EQUAL&                      equalFunction,
+                 bslma::Allocator                 *basicAllocator = 0);
+        // Create an empty cache holding at most the specified 'capacity'
+        // items, evicted according to the specified 'evictionPolicy', and
+        // having the specified 'numShards' independently locked shards,
+        // rounded up to a power of two, but at most the largest power of two
+        // not greater than 'capacity'.  The specified 'hashFunction' is used
+        // to generate the hash values for a given key, and the specified
+        // 'equalFunction' is used to determine whether two keys have the same
+        // value.  Optionally specify a 'basicAllocator' used to supply memory.
+        // If 'basicAllocator' is 0, the currently installed default allocator
+        // is used.  The behavior is undefined unless '1 <= capacity' and
+        // '1 <= numShards'.
+
+    ~ShardedCache();
+        // Destroy this object.
+
+    // MANIPULATORS
+    void clear();
+        // Remove all items from this cache.  Do *not* invoke the post-eviction
+        // callback.
+
+    int erase(const KEY& key);
+        // Remove the item having the specified 'key' from this cache.  Invoke
+        // the post-eviction callback for the removed item.  Return 0 on
+        // success and 1 if 'key' does not exist.
+
+    int eraseBulk(const bsl::vector<KEY>& keys);
+        // Remove the items having the specified 'keys' from this cache.
+        // Invoke the post-eviction callback for each removed item.  Return
+        // the number of items successfully removed.
+
+    void insert(const KEY& key, const VALUE& value);
+    void insert(const KEY& key, bslmf::MovableRef<VALUE> value);
+        // Insert the specified 'key' and its associated 'value' into this
+        // cache.  If 'key' already exists, then its value will be replaced
+        // with 'value'.  Note that the method taking a moved 'value' provides
+        // the 'basic' but not the 'strong' exception guarantee.
+
+    void insert(const KEY& key, const ValuePtrType& valuePtr);
+        // Insert the specified 'key' and its associated 'valuePtr' into this
+        // cache.  If 'key' already exists, then its value will be replaced
+        // with 'valuePtr'.
+
+    int insertBulk(const bsl::vector<KVType>& data);
+        // Insert the specified 'data' (composed of Key-Value pairs) into this
+        // cache.  If a key already exists, then its value will be replaced
+        // with the value.  Return the number of items successfully inserted.
+
+    void setPostEvictionCallback(
+                             const PostEvictionCallback& postEvictionCallback);
+        // Set the post-eviction callback to the specified
+        // 'postEvictionCallback'.  The post-eviction callback is invoked for
+        // each item evicted or removed from this cache.
+
+    int tryGetValue(bsl::shared_ptr<VALUE> *value, const KEY& key);
+        // Load, into the specified 'value', the value associated with the
+        // specified 'key' in this cache, and record the access for the
+        // eviction policy.  Return 0 on success, and 1 if 'key' does not
+        // exist in this cache.  Note that only a read lock is acquired.
+
+    // ACCESSORS
+    bsl::size_t capacity() const;
+        // Return the maximum number of items held by this cache.
+
+    EQUAL equalFunction() const;
+        // Return (a copy of) the key-equality functor used by this cache that
+        // returns 'true' if two 'KEY' objects have the same value, and 'false'
+        // otherwise.
+
+    ShardedCacheEvictionPolicy::Enum evictionPolicy() const;
+        // Return the eviction policy used by this cache.
+
+    HASH hashFunction() const;
+        // Return (a copy of) the unary hash functor used by this cache to
+        // generate a hash value (of type 'std::size_t') for a 'KEY' object.
+
+    bsl::size_t numShards() const;
+        // Return the number of shards of this cache.
+
+    bsl::size_t size() const;
+        // Return the current size of this cache.
+
+    template <class VISITOR>
+    void visit(VISITOR& visitor) const;
+        // Call the specified 'visitor' for every item stored in this cache,
+        // in unspecified order, until 'visitor' returns 'false'.  The
+        // 'VISITOR' type must be a callable object that can be invoked in the
+        // same way as the function 'bool (const KEY&, const VALUE&)'.
+};
+
+// ============================================================================
+//                        INLINE FUNCTION DEFINITIONS
+// ============================================================================
+
+                    // ----------------------------------
+                    // class ShardedCache_FrequencySketch
+                    // ----------------------------------
+
+// PRIVATE CLASS METHODS
+inline
+bsl::size_t ShardedCache_FrequencySketch::indexOf(bsls::Types::Uint64 hash,
+                                                  int                 row,
+                                                  bsls::Types::Uint64 mask)
+{
+    static const bsls::Types::Uint64 k_SEEDS[] = {
+        0xc3a5c85c97cb3127ULL,
+        0xb492b66fbe98f273ULL,
+        0x9ae16a3b2f90404fULL,
+        0xcbf29ce484222325ULL
+    };
+
+    bsls::Types::Uint64 h = (hash + k_SEEDS[row]) * k_SEEDS[row];
+    h += h >> 32;
+    return static_cast<bsl::size_t>(h & mask);
+}
+
+// MANIPULATORS
+inline
+void ShardedCache_FrequencySketch::increment(bsls::Types::Uint64 hash)
+{
+    const int start = static_cast<int>(hash & 3) << 2;
+
+    for (int row = 0; row < 4; ++row) {
+        bsls::AtomicUint64& word = d_table_p[indexOf(hash, row, d_tableMask)];
+        const int           shift = (start + row) << 2;
+
+        bsls::Types::Uint64 expected = word.loadRelaxed();
+        while (((expected >> shift) & 0xf) != 0xf) {
+            const bsls::Types::Uint64 previous = word.testAndSwapAcqRel(
+                                  expected,
+                                 expected + (bsls::Types::Uint64(1) << shift));
+            if (previous == expected) {
+                break;
+            }
+            expected = previous;
+        }
+    }
+    d_numIncrements.addRelaxed(1);
+}
+
+// ACCESSORS
+inline
+int ShardedCache_FrequencySketch::frequency(bsls::Types::Uint64 hash) const
+{
+    const int start = static_cast<int>(hash & 3) << 2;
+
+    int result = 0xf;
+    for (int row = 0; row < 4; ++row) {
+        const bsls::Types::Uint64 word =
+                      d_table_p[indexOf(hash, row, d_tableMask)].loadRelaxed();
+        const int count = static_cast<int>((word >> ((start + row) << 2))
+                                                                        & 0xf);
+        if (count < result) {
+            result = count;
+        }
+    }
+    return result;
+}
+
+inline
+bool ShardedCache_FrequencySketch::needsReset() const
+{
+    return d_numIncrements.loadRelaxed() >= d_sampleSize;
+}
+
+                          // -----------------------
+                          // struct ShardedCache_Node
+                          // -----------------------
+
+// CREATORS
+template <class KEY, class VALUE>
+inline
+ShardedCache_Node<KEY, VALUE>::ShardedCache_Node()
+: d_value()
+, d_newer_p(0)
+, d_older_p(0)
+, d_key_p(0)
+, d_hash(0)
+, d_visited(0)
+, d_inWindow(false)
+{
+}
+
+template <class KEY, class VALUE>
+inline
+ShardedCache_Node<KEY, VALUE>::ShardedCache_Node(
+                                          const ShardedCache_Node& original)
+: d_value(original.d_value)
+, d_newer_p(0)
+, d_older_p(0)
+, d_key_p(0)
+, d_hash(original.d_hash)
+, d_visited(0)
+, d_inWindow(false)
+{
+}
+
+                          // ------------------------
+                          // struct ShardedCache_Queue
+                          // ------------------------
+
+// CREATORS
+template <class KEY, class VALUE>
+inline
+ShardedCache_Queue<KEY, VALUE>::ShardedCache_Queue()
+: d_newest_p(0)
+, d_oldest_p(0)
+, d_size(0)
+{
+}
+
+// MANIPULATORS
+template <class KEY, class VALUE>
+inline
+void ShardedCache_Queue<KEY, VALUE>::pushNewest(Node *node)
+{
+    node->d_newer_p = 0;
+    node->d_older_p = d_newest_p;
+    if (d_newest_p) {
+        d_newest_p->d_newer_p = node;
+    }
+    else {
+        d_oldest_p = node;
+    }
+    d_newest_p = node;
+    ++d_size;
+}
+
+template <class KEY, class VALUE>
+inline
+void ShardedCache_Queue<KEY, VALUE>::remove(Node *node)
+{
+    BSLS_ASSERT(0 < d_size);
+
+    if (node->d_newer_p) {
+        node->d_newer_p->d_older_p = node->d_older_p;
+    }
+    else {
+        d_newest_p = node->d_older_p;
+    }
+    if (node->d_older_p) {
+        node->d_older_p->d_newer_p = node->d_newer_p;
+    }
+    else {
+        d_oldest_p = node->d_newer_p;
+    }
+    node->d_newer_p = 0;
+    node->d_older_p = 0;
+    --d_size;
+}
+
+                          // ------------------------
+                          // class ShardedCache_Shard
+                          // ------------------------
+
+// PRIVATE MANIPULATORS
+template <class KEY, class VALUE, class HASH, class EQUAL>
+void ShardedCache_Shard<KEY, VALUE, HASH, EQUAL>::evict(Node *node)
+{
+    ValuePtrType value = node->d_value;
+
+    unlink(node);
+    d_map.erase(d_map.find(*node->d_key_p));
+
+    if (*d_postEvictionCallback_p) {
+        (*d_postEvictionCallback_p)(value);
+    }
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+void ShardedCache_Shard<KEY, VALUE, HASH, EQUAL>::makeRoom()
+{
+    evict(selectVictim());
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+void ShardedCache_Shard<KEY, VALUE, HASH, EQUAL>::promote()
+{
+    Node *candidate = d_window.d_oldest_p;
+    BSLS_ASSERT(candidate);
+
+    if (d_main.d_size < d_mainCapacity) {
+        d_window.remove(candidate);
+        candidate->d_inWindow = false;
+        d_main.pushNewest(candidate);
+        return;                                                       // RETURN
+    }
+
+    if (0 == d_main.d_size) {
+        evict(candidate);
+        return;                                                       // RETURN
+    }
+
+    Node *victim = selectVictim();
+    if (d_sketch.frequency(candidate->d_hash) >
+                                          d_sketch.frequency(victim->d_hash)) {
+        evict(victim);
+        d_window.remove(candidate);
+        candidate->d_inWindow = false;
+        d_main.pushNewest(candidate);
+    }
+    else {
+        evict(candidate);
+    }
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+typename ShardedCache_Shard<KEY, VALUE, HASH, EQUAL>::Node *
+ShardedCache_Shard<KEY, VALUE, HASH, EQUAL>::selectVictim()
+{
+    BSLS_ASSERT(d_main.d_oldest_p);
+
+    switch (d_evictionPolicy) {
+      case ShardedCacheEvictionPolicy::e_CLOCK: {
+        Node *node = d_main.d_oldest_p;
+        while (node->d_visited.loadRelaxed()) {
+            node->d_visited.storeRelaxed(0);
+            d_main.remove(node);
+            d_main.pushNewest(node);
+            node = d_main.d_oldest_p;
+        }
+        return node;                                                  // RETURN
+      }
+      case ShardedCacheEvictionPolicy::e_SIEVE:
+      case ShardedCacheEvictionPolicy::e_TINYLFU: {
+        Node *node = d_hand_p ? d_hand_p : d_main.d_oldest_p;
+        while (node->d_visited.loadRelaxed()) {
+            node->d_visited.storeRelaxed(0);
+            node = node->d_newer_p ? node->d_newer_p : d_main.d_oldest_p;
+        }
+        d_hand_p = node;
+        return node;                                                  // RETURN
+      }
+      default: {
+        return d_main.d_oldest_p;                                     // RETURN
+      }
+    }
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+void ShardedCache_Shard<KEY, VALUE, HASH, EQUAL>::unlink(Node *node)
+{
+    if (node->d_inWindow) {
+        d_window.remove(node);
+        return;                                                       // RETURN
+    }
+    if (d_hand_p == node) {
+        d_hand_p = node->d_newer_p;
+    }
+    d_main.remove(node);
+}
+
+// CREATORS
+template <class KEY, class VALUE, class HASH, class EQUAL>
+ShardedCache_Shard<KEY, VALUE, HASH, EQUAL>::ShardedCache_Shard(
+                  ShardedCacheEvictionPolicy::Enum  evictionPolicy,
+                  bsl::size_t                       capacity,
+                  const HASH&                       hashFunction,
+                  const EQUAL&                      equalFunction,
+                  const PostEvictionCallback       *postEvictionCallback,
+                  bslma::Allocator                 *basicAllocator)
+: d_lock()
+, d_map(0, hashFunction, equalFunction, basicAllocator)
+, d_window()
+, d_main()
+, d_hand_p(0)
+, d_evictionPolicy(evictionPolicy)
+, d_windowCapacity(ShardedCacheEvictionPolicy::e_TINYLFU == evictionPolicy
+                   ? (capacity >= 200 ? capacity / 100 : 1)
+                   : 0)
+, d_mainCapacity(capacity - d_windowCapacity)
+, d_sketch(ShardedCacheEvictionPolicy::e_TINYLFU == evictionPolicy
+           ? capacity
+           : 1,
+           basicAllocator)
+, d_postEvictionCallback_p(postEvictionCallback)
+{
+    BSLS_ASSERT(1 <= capacity);
+}
+
+// MANIPULATORS
+template <class KEY, class VALUE, class HASH, class EQUAL>
+void ShardedCache_Shard<KEY, VALUE, HASH, EQUAL>::clear()
+{
+    bslmt::WriteLockGuard<LockType> guard(&d_lock);
+
+    d_map.clear();
+    d_window = Queue();
+    d_main   = Queue();
+    d_hand_p = 0;
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+int ShardedCache_Shard<KEY, VALUE, HASH, EQUAL>::erase(const KEY& key)
+{
+    bslmt::WriteLockGuard<LockType> guard(&d_lock);
+
+    typename MapType::iterator mapIt = d_map.find(key);
+    if (mapIt == d_map.end()) {
+        return 1;                                                     // RETURN
+    }
+    evict(&mapIt->second);
+    return 0;
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+bool ShardedCache_Shard<KEY, VALUE, HASH, EQUAL>::insert(
+                                                const KEY&          key,
+                                                const ValuePtrType& valuePtr,
+                                                bsls::Types::Uint64 hash)
+{
+    bslmt::WriteLockGuard<LockType> guard(&d_lock);
+
+    const bool isTinyLfu =
+                   ShardedCacheEvictionPolicy::e_TINYLFU == d_evictionPolicy;
+
+    if (isTinyLfu) {
+        if (d_sketch.needsReset()) {
+            d_sketch.reset();
+        }
+        d_sketch.increment(hash);
+    }
+
+    typename MapType::iterator mapIt = d_map.find(key);
+    if (mapIt != d_map.end()) {
+        mapIt->second.d_value = valuePtr;
+        mapIt->second.d_visited.storeRelaxed(1);
+        return false;                                                 // RETURN
+    }
+
+    if (!isTinyLfu && d_main.d_size >= d_mainCapacity) {
+        makeRoom();
+    }
+
+    Node node;
+    node.d_value = valuePtr;
+    node.d_hash  = hash;
+
+    mapIt = d_map.emplace(key, node).first;
+    Node *newNode = &mapIt->second;
+    newNode->d_key_p = &mapIt->first;
+
+    if (isTinyLfu) {
+        newNode->d_inWindow = true;
+        d_window.pushNewest(newNode);
+        if (d_window.d_size > d_windowCapacity) {
+            promote();
+        }
+    }
+    else {
+        d_main.pushNewest(newNode);
+    }
+    return true;
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+typename ShardedCache_Shard<KEY, VALUE, HASH, EQUAL>::LockType&
+ShardedCache_Shard<KEY, VALUE, HASH, EQUAL>::lock()
+{
+    return d_lock;
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+int ShardedCache_Shard<KEY, VALUE, HASH, EQUAL>::tryGetValue(
+                                                ValuePtrType        *value,
+                                                const KEY&           key,
+                                                bsls::Types::Uint64  hash)
+{
+    bslmt::ReadLockGuard<LockType> guard(&d_lock);
+
+    typename MapType::iterator mapIt = d_map.find(key);
+    if (mapIt == d_map.end()) {
+        return 1;                                                     // RETURN
+    }
+
+    *value = mapIt->second.d_value;
+
+    // Avoid writing to the cache line of the node if the flag is already set.
+
+    if (0 == mapIt->second.d_visited.loadRelaxed()) {
+        mapIt->second.d_visited.storeRelaxed(1);
+    }
+    if (ShardedCacheEvictionPolicy::e_TINYLFU == d_evictionPolicy) {
+        d_sketch.increment(hash);
+    }
+    return 0;
+}
+
+// ACCESSORS
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+EQUAL ShardedCache_Shard<KEY, VALUE, HASH, EQUAL>::equalFunction() const
+{
+    return d_map.key_eq();
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+HASH ShardedCache_Shard<KEY, VALUE, HASH, EQUAL>::hashFunction() const
+{
+    return d_map.hash_function();
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+bsl::size_t ShardedCache_Shard<KEY, VALUE, HASH, EQUAL>::size() const
+{
+    bslmt::ReadLockGuard<LockType> guard(&d_lock);
+    return d_map.size();
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+template <class VISITOR>
+bool ShardedCache_Shard<KEY, VALUE, HASH, EQUAL>::visit(VISITOR& visitor) const
+{
+    bslmt::ReadLockGuard<LockType> guard(&d_lock);
+
+    for (typename MapType::const_iterator mapIt = d_map.begin();
+         mapIt != d_map.end(); ++mapIt) {
+        if (!visitor(mapIt->first, *mapIt->second.d_value)) {
+            return false;                                             // RETURN
+        }
+    }
+    return true;
+}
+
+                             // ------------------
+                             // class ShardedCache
+                             // ------------------
+
+// PRIVATE CLASS METHODS
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+bsls::Types::Uint64 ShardedCache<KEY, VALUE, HASH, EQUAL>::mix(
+                                                              bsl::size_t hash)
+{
+    bsls::Types::Uint64 h = static_cast<bsls::Types::Uint64>(hash);
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return h;
+}
+
+// PRIVATE MANIPULATORS
+template <class KEY, class VALUE, class HASH, class EQUAL>
+void ShardedCache<KEY, VALUE, HASH, EQUAL>::init(bsl::size_t  numShards,
+                                                 const HASH&  hashFunction,
+                                                 const EQUAL& equalFunction)
+{
+    BSLS_ASSERT(1 <= d_capacity);
+    BSLS_ASSERT(1 <= numShards);
+
+    d_numShards = 1;
+    d_shardShift = 64;
+    while (d_numShards < numShards && d_numShards * 2 <= d_capacity) {
+        d_numShards *= 2;
+        --d_shardShift;
+    }
+
+    d_shards_p = static_cast<Shard *>(
+                         d_allocator_p->allocate(d_numShards * sizeof(Shard)));
+    bslma::DeallocatorProctor<bslma::Allocator> deallocatorProctor(
+                                                                d_shards_p,
+                                                                d_allocator_p);
+    bslma::AutoDestructor<Shard> autoDestructor(d_shards_p, 0);
+
+    // Distribute the capacity so that the shards hold 'd_capacity' items in
+    // total.
+
+    const bsl::size_t base      = d_capacity / d_numShards;
+    const bsl::size_t remainder = d_capacity % d_numShards;
+
+    for (bsl::size_t i = 0; i < d_numShards; ++i, ++autoDestructor) {
+        new (d_shards_p + i) Shard(d_evictionPolicy,
+                                   base + (i < remainder ? 1 : 0),
+                                   hashFunction,
+                                   equalFunction,
+                                   &d_postEvictionCallback,
+                                   d_allocator_p);
+    }
+
+    autoDestructor.release();
+    deallocatorProctor.release();
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+typename ShardedCache<KEY, VALUE, HASH, EQUAL>::Shard&
+ShardedCache<KEY, VALUE, HASH, EQUAL>::shardOf(bsls::Types::Uint64 mixedHash)
+{
+    // Shifting a 64-bit value by 64 is undefined, so handle a single shard
+    // separately.
+
+    return 1 == d_numShards
+           ? d_shards_p[0]
+           : d_shards_p[static_cast<bsl::size_t>(mixedHash >> d_shardShift)];
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+void ShardedCache<KEY, VALUE, HASH, EQUAL>::populateValuePtrType(
+                                                       ValuePtrType *dst,
+                                                       const VALUE&  value,
+                                                       bsl::true_type)
+{
+    dst->createInplace(d_allocator_p, value, d_allocator_p);
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+void ShardedCache<KEY, VALUE, HASH, EQUAL>::populateValuePtrType(
+                                                       ValuePtrType *dst,
+                                                       const VALUE&  value,
+                                                       bsl::false_type)
+{
+    dst->createInplace(d_allocator_p, value);
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+void ShardedCache<KEY, VALUE, HASH, EQUAL>::populateValuePtrType(
+                                               ValuePtrType             *dst,
+                                               bslmf::MovableRef<VALUE>  value,
+                                               bsl::true_type)
+{
+    dst->createInplace(d_allocator_p,
+                       bslmf::MovableRefUtil::move(value),
+                       d_allocator_p);
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+void ShardedCache<KEY, VALUE, HASH, EQUAL>::populateValuePtrType(
+                                               ValuePtrType             *dst,
+                                               bslmf::MovableRef<VALUE>  value,
+                                               bsl::false_type)
+{
+    dst->createInplace(d_allocator_p, bslmf::MovableRefUtil::move(value));
+}
+
+// CREATORS
+template <class KEY, class VALUE, class HASH, class EQUAL>
+ShardedCache<KEY, VALUE, HASH, EQUAL>::ShardedCache(
+                     ShardedCacheEvictionPolicy::Enum  evictionPolicy,
+                     bsl::size_t                       capacity,
+                     bslma::Allocator                 *basicAllocator)
+: d_allocator_p(bslma::Default::allocator(basicAllocator))
+, d_shards_p(0)
+, d_numShards(0)
+, d_shardShift(64)
+, d_capacity(capacity)
+, d_evictionPolicy(evictionPolicy)
+, d_hashFunction()
+, d_postEvictionCallback(bsl::allocator_arg, d_allocator_p)
+{
+    init(k_DEFAULT_NUM_SHARDS, HASH(), EQUAL());
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+ShardedCache<KEY, VALUE, HASH, EQUAL>::ShardedCache(
+                     ShardedCacheEvictionPolicy::Enum  evictionPolicy,
+                     bsl::size_t                       capacity,
+                     bsl::size_t                       numShards,
+                     bslma::Allocator                 *basicAllocator)
+: d_allocator_p(bslma::Default::allocator(basicAllocator))
+, d_shards_p(0)
+, d_numShards(0)
+, d_shardShift(64)
+, d_capacity(capacity)
+, d_evictionPolicy(evictionPolicy)
+, d_hashFunction()
+, d_postEvictionCallback(bsl::allocator_arg, d_allocator_p)
+{
+    init(numShards, HASH(), EQUAL());
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+ShardedCache<KEY, VALUE, HASH, EQUAL>::ShardedCache(
+                     ShardedCacheEvictionPolicy::Enum  evictionPolicy,
+                     bsl::size_t                       capacity,
+                     bsl::size_t                       numShards,
+                     const HASH&                       hashFunction,
+                     const EQUAL&                      equalFunction,
+                     bslma::Allocator                 *basicAllocator)
+: d_allocator_p(bslma::Default::allocator(basicAllocator))
+, d_shards_p(0)
+, d_numShards(0)
+, d_shardShift(64)
+, d_capacity(capacity)
+, d_evictionPolicy(evictionPolicy)
+, d_hashFunction(hashFunction)
+, d_postEvictionCallback(bsl::allocator_arg, d_allocator_p)
+{
+    init(numShards, hashFunction, equalFunction);
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+ShardedCache<KEY, VALUE, HASH, EQUAL>::~ShardedCache()
+{
+    for (bsl::size_t i = 0; i < d_numShards; ++i) {
+        d_shards_p[i].~Shard();
+    }
+    d_allocator_p->deallocate(d_shards_p);
+}
+
+// MANIPULATORS
+template <class KEY, class VALUE, class HASH, class EQUAL>
+void ShardedCache<KEY, VALUE, HASH, EQUAL>::clear()
+{
+    for (bsl::size_t i = 0; i < d_numShards; ++i) {
+        d_shards_p[i].clear();
+    }
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+int ShardedCache<KEY, VALUE, HASH, EQUAL>::erase(const KEY& key)
+{
+    return shardOf(mix(d_hashFunction(key))).erase(key);
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+int ShardedCache<KEY, VALUE, HASH, EQUAL>::eraseBulk(
+                                                  const bsl::vector<KEY>& keys)
+{
+    int count = 0;
+    for (bsl::size_t i = 0; i < keys.size(); ++i) {
+        if (0 == erase(keys[i])) {
+            ++count;
+        }
+    }
+    return count;
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+void ShardedCache<KEY, VALUE, HASH, EQUAL>::insert(const KEY&   key,
+                                                   const VALUE& value)
+{
+    ValuePtrType valuePtr;
+    populateValuePtrType(&valuePtr, value, bslma::UsesBslmaAllocator<VALUE>());
+                                                                 // might throw
+
+    const bsls::Types::Uint64 hash = mix(d_hashFunction(key));
+    shardOf(hash).insert(key, valuePtr, hash);
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+void ShardedCache<KEY, VALUE, HASH, EQUAL>::insert(
+                                               const KEY&               key,
+                                               bslmf::MovableRef<VALUE> value)
+{
+    ValuePtrType valuePtr;
+    populateValuePtrType(&valuePtr,
+                         bslmf::MovableRefUtil::move(value),
+                         bslma::UsesBslmaAllocator<VALUE>());
+                                    // might throw, but BEFORE 'value' is moved
+
+    const bsls::Types::Uint64 hash = mix(d_hashFunction(key));
+    shardOf(hash).insert(key, valuePtr, hash);
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+void ShardedCache<KEY, VALUE, HASH, EQUAL>::insert(
+                                                 const KEY&          key,
+                                                 const ValuePtrType& valuePtr)
+{
+    const bsls::Types::Uint64 hash = mix(d_hashFunction(key));
+    shardOf(hash).insert(key, valuePtr, hash);
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+int ShardedCache<KEY, VALUE, HASH, EQUAL>::insertBulk(
+                                              const bsl::vector<KVType>& data)
+{
+    int count = 0;
+    for (bsl::size_t i = 0; i < data.size(); ++i) {
+        const bsls::Types::Uint64 hash = mix(d_hashFunction(data[i].first));
+        count += shardOf(hash).insert(data[i].first, data[i].second, hash);
+    }
+    return count;
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+void ShardedCache<KEY, VALUE, HASH, EQUAL>::setPostEvictionCallback(
+                              const PostEvictionCallback& postEvictionCallback)
+{
+    // Lock every shard, in order, so that no shard invokes the callback while
+    // it is being modified.
+
+    for (bsl::size_t i = 0; i < d_numShards; ++i) {
+        d_shards_p[i].lock().lockWrite();
+    }
+    d_postEvictionCallback = postEvictionCallback;
+    for (bsl::size_t i = 0; i < d_numShards; ++i) {
+        d_shards_p[i].lock().unlock();
+    }
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+int ShardedCache<KEY, VALUE, HASH, EQUAL>::tryGetValue(
+                                                bsl::shared_ptr<VALUE> *value,
+                                                const KEY&              key)
+{
+    const bsls::Types::Uint64 hash = mix(d_hashFunction(key));
+    return shardOf(hash).tryGetValue(value, key, hash);
+}
+
+// ACCESSORS
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+bsl::size_t ShardedCache<KEY, VALUE, HASH, EQUAL>::capacity() const
+{
+    return d_capacity;
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+EQUAL ShardedCache<KEY, VALUE, HASH, EQUAL>::equalFunction() const
+{
+    return d_shards_p[0].equalFunction();
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+ShardedCacheEvictionPolicy::Enum
+ShardedCache<KEY, VALUE, HASH, EQUAL>::evictionPolicy() const
+{
+    return d_evictionPolicy;
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+HASH ShardedCache<KEY, VALUE, HASH, EQUAL>::hashFunction() const
+{
+    return d_hashFunction;
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+bsl::size_t ShardedCache<KEY, VALUE, HASH, EQUAL>::numShards() const
+{
+    return d_numShards;
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+bsl::size_t ShardedCache<KEY, VALUE, HASH, EQUAL>::size() const
+{
+    bsl::size_t result = 0;
+    for (bsl::size_t i = 0; i < d_numShards; ++i) {
+        result += d_shards_p[i].size();
+    }
+    return result;
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+template <class VISITOR>
+void ShardedCache<KEY, VALUE, HASH, EQUAL>::visit(VISITOR& visitor) const
+{
+    for (bsl::size_t i = 0; i < d_numShards; ++i) {
+        if (!d_shards_p[i].visit(visitor)) {
+            return;                                                   // RETURN
+        }
+    }
+}
+
+}  // close package namespace
+
+namespace bslma {
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+struct UsesBslmaAllocator<bdlcc::ShardedCache<KEY, VALUE, HASH, EQUAL> >
+    : bsl::true_type
+{
+};
+
+}  // close namespace bslma
+
+}  // close enterprise namespace
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2020 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,1577 @@
+// bdlcc_shardedcache.t.cpp                                           -*-C++-*-
+
+#include <bdlcc_shardedcache.h>
+
+#include <bdlcc_cache.h>
+
+#include <bdlf_bind.h>
+#include <bdlf_placeholder.h>
+
+#include <bslim_testutil.h>
+
+#include <bslma_default.h>
+#include <bslma_defaultallocatorguard.h>
+#include <bslma_testallocator.h>
+#include <bslma_testallocatormonitor.h>
+#include <bslma_testallocatorexception.h>
+
+#include <bslmt_barrier.h>
+#include <bslmt_threadgroup.h>
+#include <bslmt_throughputbenchmark.h>
+#include <bslmt_throughputbenchmarkresult.h>
+
+#include <bsls_asserttest.h>
+#include <bsls_atomic.h>
+#include <bsls_types.h>
+
+#include <bsl_algorithm.h>
+#include <bsl_cmath.h>
+#include <bsl_cstdlib.h>
+#include <bsl_functional.h>
+#include <bsl_iomanip.h>
+#include <bsl_iostream.h>
+#include <bsl_memory.h>
+#include <bsl_string.h>
+#include <bsl_vector.h>
+
+using namespace BloombergLP;
+using bsl::cout;
+using bsl::endl;
+
+// ============================================================================
+//                             TEST PLAN
+// ----------------------------------------------------------------------------
+//                              Overview
+//                              --------
+// The component under test defines a mechanism, 'bdlcc::ShardedCache', that
+// provides an in-memory key-value cache partitioned into shards, with
+// eviction policies that do not reorder the eviction queue on a lookup.  The
+// implementation is layered on three implementation classes: a frequency
+// sketch ('ShardedCache_FrequencySketch'), an intrusive queue
+// ('ShardedCache_Queue'), and a shard ('ShardedCache_Shard').  The sketch and
+// the queue are tested directly; the shard is tested through the interface of
+// 'bdlcc::ShardedCache'.
+//
+// The eviction order of each policy is tested using a cache having a single
+// shard, in which the order is deterministic.  The bound on the size of a
+// cache having several shards, and thread safety, are tested by performing
+// random operations from several threads.
+// ----------------------------------------------------------------------------
+// CREATORS
+// [ 4] ShardedCache(policy, capacity, basicAllocator);
+// [ 4] ShardedCache(policy, capacity, numShards, basicAllocator);
+// [ 4] ShardedCache(policy, capacity, numShards, hash, equal, alloc);
+// [ 4] ~ShardedCache();
+//
+// MANIPULATORS
+// [ 5] void clear();
+// [ 5] int erase(const KEY& key);
+// [ 5] int eraseBulk(const bsl::vector<KEY>& keys);
+// [ 5] void insert(const KEY& key, const VALUE& value);
+// [ 5] void insert(const KEY& key, bslmf::MovableRef<VALUE> value);
+// [ 5] void insert(const KEY& key, const ValuePtrType& valuePtr);
+// [ 5] int insertBulk(const bsl::vector<KVType>& data);
+// [ 5] void setPostEvictionCallback(postEvictionCallback);
+// [ 5] int tryGetValue(bsl::shared_ptr<VALUE> *value, const KEY& key);
+//
+// ACCESSORS
+// [ 4] bsl::size_t capacity() const;
+// [ 4] EQUAL equalFunction() const;
+// [ 4] ShardedCacheEvictionPolicy::Enum evictionPolicy() const;
+// [ 4] HASH hashFunction() const;
+// [ 4] bsl::size_t numShards() const;
+// [ 5] bsl::size_t size() const;
+// [ 5] void visit(VISITOR& visitor) const;
+// ----------------------------------------------------------------------------
+// [ 1] BREATHING TEST
+// [ 2] ShardedCache_FrequencySketch
+// [ 3] ShardedCache_Queue
+// [ 6] EVICTION ORDER: FIFO, CLOCK, SIEVE
+// [ 7] EVICTION: TINYLFU ADMISSION
+// [ 8] THREAD SAFETY
+// [ 9] USAGE EXAMPLE
+// [-1] HIT RATE BENCHMARK
+// [-2] THROUGHPUT BENCHMARK
+
+// ============================================================================
+//                     STANDARD BDE ASSERT TEST FUNCTION
+// ----------------------------------------------------------------------------
+
+namespace {
+
+int testStatus = 0;
+
+void aSsErT(bool condition, const char *message, int line)
+{
+    if (condition) {
+        cout << "Error " __FILE__ "(" << line << "): " << message
+             << "    (failed)" << endl;
+
+        if (0 <= testStatus && testStatus <= 100) {
+            ++testStatus;
+        }
+    }
+}
+
+}  // close unnamed namespace
+
+// ============================================================================
+//               STANDARD BDE TEST DRIVER MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT       BSLIM_TESTUTIL_ASSERT
+#define ASSERTV      BSLIM_TESTUTIL_ASSERTV
+
+#define LOOP_ASSERT  BSLIM_TESTUTIL_LOOP_ASSERT
+#define LOOP0_ASSERT BSLIM_TESTUTIL_LOOP0_ASSERT
+#define LOOP1_ASSERT BSLIM_TESTUTIL_LOOP1_ASSERT
+#define LOOP2_ASSERT BSLIM_TESTUTIL_LOOP2_ASSERT
+#define LOOP3_ASSERT BSLIM_TESTUTIL_LOOP3_ASSERT
+#define LOOP4_ASSERT BSLIM_TESTUTIL_LOOP4_ASSERT
+#define LOOP5_ASSERT BSLIM_TESTUTIL_LOOP5_ASSERT
+#define LOOP6_ASSERT BSLIM_TESTUTIL_LOOP6_ASSERT
+
+#define Q            BSLIM_TESTUTIL_Q   // Quote identifier literally.
+#define P            BSLIM_TESTUTIL_P   // Print identifier and value.
+#define P_           BSLIM_TESTUTIL_P_  // P(X) without '\n'.
+#define T_           BSLIM_TESTUTIL_T_  // Print a tab (w/o newline).
+#define L_           BSLIM_TESTUTIL_L_  // current Line number
+
+// ============================================================================
+//                  NEGATIVE-TEST MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT_PASS(EXPR)      BSLS_ASSERTTEST_ASSERT_PASS(EXPR)
+#define ASSERT_FAIL(EXPR)      BSLS_ASSERTTEST_ASSERT_FAIL(EXPR)
+
+// ============================================================================
+//                   GLOBAL TYPEDEFS/CONSTANTS FOR TESTING
+// ----------------------------------------------------------------------------
+
+static bool             verbose;
+static bool         veryVerbose;
+static bool     veryVeryVerbose;
+static bool veryVeryVeryVerbose;
+
+typedef bdlcc::ShardedCacheEvictionPolicy    Policy;
+typedef bdlcc::ShardedCache<int, int>        Obj;
+typedef bdlcc::ShardedCache_FrequencySketch  Sketch;
+typedef bdlcc::ShardedCache_Node<int, int>   Node;
+typedef bdlcc::ShardedCache_Queue<int, int>  Queue;
+typedef bsls::Types::Uint64                  Uint64;
+
+static const Policy::Enum SHARDED_POLICIES[] = {
+    Policy::e_FIFO,
+    Policy::e_CLOCK,
+    Policy::e_SIEVE,
+    Policy::e_TINYLFU
+};
+static const int NUM_SHARDED_POLICIES = static_cast<int>(
+                           sizeof SHARDED_POLICIES / sizeof *SHARDED_POLICIES);
+
+static const char *policyName(Policy::Enum policy)
+    // Return the name of the specified 'policy'.
+{
+    switch (policy) {
+      case Policy::e_FIFO:    return "FIFO";                          // RETURN
+      case Policy::e_CLOCK:   return "CLOCK";                         // RETURN
+      case Policy::e_SIEVE:   return "SIEVE";                         // RETURN
+      case Policy::e_TINYLFU: return "TINYLFU";                       // RETURN
+    }
+    return "(* UNKNOWN *)";
+}
+
+// ============================================================================
+//                   GLOBAL HELPER FUNCTIONS FOR TESTING
+// ----------------------------------------------------------------------------
+
+namespace {
+
+struct KeyCollector {
+    // This visitor appends the keys of the visited items to a vector.
+
+    // DATA
+    bsl::vector<int> *d_keys_p;  // collected keys (held, not owned)
+
+    // CREATORS
+    explicit KeyCollector(bsl::vector<int> *keys)
+    : d_keys_p(keys)
+    {
+    }
+
+    // MANIPULATORS
+    bool operator()(int key, int)
+        // Append the specified 'key' to the collected keys and return 'true'.
+    {
+        d_keys_p->push_back(key);
+        return true;
+    }
+};
+
+bsl::vector<int> sortedKeys(const Obj& cache, bslma::Allocator *allocator)
+    // Return the sorted keys of the items in the specified 'cache', using the
+    // specified 'allocator' to supply memory for the result.  Note that the
+    // eviction state of 'cache' is not modified.
+{
+    bsl::vector<int> keys(allocator);
+    KeyCollector     collector(&keys);
+
+    cache.visit(collector);
+    bsl::sort(keys.begin(), keys.end());
+    return keys;
+}
+
+bsl::vector<int> makeKeys(int k0, int k1, int k2, int k3,
+                          bslma::Allocator *allocator)
+    // Return a vector holding the specified 'k0', 'k1', 'k2', and 'k3', using
+    // the specified 'allocator' to supply memory.
+{
+    bsl::vector<int> keys(allocator);
+    keys.push_back(k0);
+    keys.push_back(k1);
+    keys.push_back(k2);
+    keys.push_back(k3);
+    return keys;
+}
+
+class EvictionRecorder {
+    // This class records the values passed to a post-eviction callback.
+
+    // DATA
+    bsl::vector<int> d_values;  // evicted values, in order
+
+  public:
+    // CREATORS
+    explicit EvictionRecorder(bslma::Allocator *allocator)
+    : d_values(allocator)
+    {
+    }
+
+    // MANIPULATORS
+    void record(const bsl::shared_ptr<int>& value)
+        // Append the specified 'value' to the recorded values.
+    {
+        d_values.push_back(*value);
+    }
+
+    void clear()
+        // Remove all recorded values.
+    {
+        d_values.clear();
+    }
+
+    // ACCESSORS
+    const bsl::vector<int>& values() const
+        // Return a reference to the recorded values.
+    {
+        return d_values;
+    }
+};
+
+struct ModHash {
+    // This hash functor returns its argument modulo 1000, so that keys
+    // differing by a multiple of 1000 collide.
+
+    bsl::size_t operator()(int key) const
+        // Return the hash of the specified 'key'.
+    {
+        return static_cast<bsl::size_t>(key % 1000);
+    }
+};
+
+class Random {
+    // This class implements a small, fast pseudo-random number generator
+    // ("xorshift64*") suitable for generating test workloads.
+
+    // DATA
+    Uint64 d_state;
+
+  public:
+    // CREATORS
+    explicit Random(Uint64 seed)
+    : d_state(seed * 0x9e3779b97f4a7c15ULL + 1)
+    {
+    }
+
+    // MANIPULATORS
+    Uint64 next()
+        // Return the next pseudo-random number.
+    {
+        d_state ^= d_state >> 12;
+        d_state ^= d_state << 25;
+        d_state ^= d_state >> 27;
+        return d_state * 0x2545f4914f6cdd1dULL;
+    }
+
+    int nextInt(int limit)
+        // Return a pseudo-random number in the range '[0 .. limit)'.
+    {
+        return static_cast<int>((next() >> 33) % limit);
+    }
+};
+
+class ZipfGenerator {
+    // This class generates integers in the range '[0 .. n)' following a Zipf
+    // distribution, so that 'i' is generated with probability proportional
+    // to '1 / (i + 1)^s'.
+
+    // DATA
+    bsl::vector<double> d_cdf;  // cumulative distribution
+
+  public:
+    // CREATORS
+    ZipfGenerator(int n, double s, bslma::Allocator *allocator)
+    : d_cdf(allocator)
+    {
+        d_cdf.reserve(n);
+        double sum = 0;
+        for (int i = 0; i < n; ++i) {
+            sum += 1.0 / bsl::pow(i + 1.0, s);
+            d_cdf.push_back(sum);
+        }
+        for (int i = 0; i < n; ++i) {
+            d_cdf[i] /= sum;
+        }
+    }
+
+    // ACCESSORS
+    int operator()(Random *random) const
+        // Return the next integer, using the specified 'random' generator.
+    {
+        const double u = static_cast<double>(random->next() >> 11)
+                                                    / 9007199254740992.0;
+        return static_cast<int>(bsl::lower_bound(d_cdf.begin(),
+                                                 d_cdf.end(),
+                                                 u) - d_cdf.begin());
+    }
+};
+
+bsls::AtomicInt s_threadSeed(0);
+
+void randomOperations(Obj            *cache,
+                      int             numOperations,
+                      int             numKeys,
+                      bslmt::Barrier *barrier)
+    // Wait on the specified 'barrier', then perform the specified
+    // 'numOperations' random insertions, lookups, and erasures on the
+    // specified 'cache', using keys in the range '[0 .. numKeys)', verifying
+    // the value of each item found.
+{
+    Random random(s_threadSeed.add(1));
+
+    barrier->wait();
+
+    bsl::shared_ptr<int> value;
+    for (int i = 0; i < numOperations; ++i) {
+        const int key = random.nextInt(numKeys);
+        const int op  = random.nextInt(10);
+        if (op < 6) {
+            if (0 == cache->tryGetValue(&value, key)) {
+                ASSERTV(key, *value, 2 * key == *value);
+            }
+        }
+        else if (op < 9) {
+            cache->insert(key, 2 * key);
+        }
+        else {
+            cache->erase(key);
+        }
+    }
+}
+
+// ============================================================================
+//                        BENCHMARK SUPPORT
+// ----------------------------------------------------------------------------
+
+template <class CACHE>
+double measureHitRate(CACHE               *cache,
+                      const ZipfGenerator& zipf,
+                      int                  numAccesses,
+                      int                  scanInterval,
+                      int                  scanLength)
+    // Return the fraction of lookups on the specified 'cache' that succeed
+    // for a workload of the specified 'numAccesses' lookups of keys generated
+    // by the specified 'zipf' generator, where each lookup that fails is
+    // followed by an insertion of the key, and where after every
+    // 'scanInterval' lookups a scan inserts the specified 'scanLength' keys
+    // that are never accessed again.
+{
+    Random               random(12345);
+    bsl::shared_ptr<int> value;
+    int                  numHits = 0;
+    int                  nextScanKey = 1 << 24;
+
+    for (int i = 0; i < numAccesses; ++i) {
+        const int key = zipf(&random);
+        if (0 == cache->tryGetValue(&value, key)) {
+            ++numHits;
+        }
+        else {
+            cache->insert(key, key);
+        }
+
+        if (scanInterval && 0 == (i + 1) % scanInterval) {
+            for (int j = 0; j < scanLength; ++j, ++nextScanKey) {
+                if (0 != cache->tryGetValue(&value, nextScanKey)) {
+                    cache->insert(nextScanKey, nextScanKey);
+                }
+            }
+        }
+    }
+    return static_cast<double>(numHits) / numAccesses;
+}
+
+template <class CACHE>
+void benchmarkOperations(CACHE *cache,
+                         int    numKeys,
+                         int    insertPercent,
+                         int    threadIndex)
+    // Perform 100 lookups and insertions on the specified 'cache' of random
+    // keys in the range '[0 .. numKeys)', where the specified 'insertPercent'
+    // percent of the operations are insertions.  Note that this function is a
+    // 'bslmt::ThroughputBenchmark::RunFunction' for the thread having the
+    // specified 'threadIndex'.
+{
+    static const int k_MAX_THREADS = 256;
+    static Random   *s_randoms[k_MAX_THREADS];
+
+    BSLMF_ASSERT(sizeof(Random) <= 64);
+
+    if (!s_randoms[threadIndex % k_MAX_THREADS]) {
+        static bsls::AtomicInt s_seed(1);
+        s_randoms[threadIndex % k_MAX_THREADS] =
+              new (bslma::Default::globalAllocator()->allocate(64))
+                                                         Random(s_seed.add(1));
+    }
+    Random& random = *s_randoms[threadIndex % k_MAX_THREADS];
+
+    bsl::shared_ptr<int> value;
+    for (int i = 0; i < 100; ++i) {
+        const int key = random.nextInt(numKeys);
+        if (random.nextInt(100) < insertPercent) {
+            cache->insert(key, key);
+        }
+        else {
+            cache->tryGetValue(&value, key);
+        }
+    }
+}
+
+template <class CACHE>
+double measureThroughput(CACHE *cache,
+                         int    numThreads,
+                         int    numKeys,
+                         int    insertPercent,
+                         int    numMillis)
+    // Return the median number of operations per second performed by the
+    // specified 'numThreads' threads on the specified 'cache' using random
+    // keys in the range '[0 .. numKeys)', the specified 'insertPercent'
+    // percent of which are insertions, in samples lasting the specified
+    // 'numMillis' milliseconds.
+{
+    for (int key = 0; key < numKeys; ++key) {
+        cache->insert(key, key);
+    }
+
+    bslmt::ThroughputBenchmark       bench;
+    bslmt::ThroughputBenchmarkResult result;
+
+    bench.addThreadGroup(bdlf::BindUtil::bind(&benchmarkOperations<CACHE>,
+                                              cache,
+                                              numKeys,
+                                              insertPercent,
+                                              bdlf::PlaceHolders::_1),
+                         numThreads,
+                         0);
+    bench.execute(&result, numMillis, 5);
+
+    double median;
+    result.getMedian(&median, 0);
+    return median * 100;
+}
+
+}  // close unnamed namespace
+
+// ============================================================================
+//                               MAIN PROGRAM
+// ----------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    int test            = argc > 1 ? bsl::atoi(argv[1]) : 0;
+    verbose             = argc > 2;
+    veryVerbose         = argc > 3;
+    veryVeryVerbose     = argc > 4;
+    veryVeryVeryVerbose = argc > 5;
+
+    cout << "TEST " << __FILE__ << " CASE " << test << endl;
+
+    // CONCERN: In no case does memory come from the default allocator.
+
+    bslma::TestAllocator defaultAllocator("default", veryVeryVeryVerbose);
+    bslma::DefaultAllocatorGuard defaultAllocatorGuard(&defaultAllocator);
+    bslma::TestAllocatorMonitor dam(&defaultAllocator);
+
+    switch (test) { case 0:
+      case 9: {
+        // --------------------------------------------------------------------
+        // USAGE EXAMPLE
+        //   Extracted from component header file.
+        //
+        // Concerns:
+        //: 1 The usage example provided in the component header file compiles,
+        //:   links, and runs as shown.
+        //
+        // Plan:
+        //: 1 Incorporate usage example from header into test driver, remove
+        //:   leading comment characters, and replace 'assert' with 'ASSERT'.
+        //:   (C-1)
+        //
+        // Testing:
+        //   USAGE EXAMPLE
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "USAGE EXAMPLE" << endl
+                          << "=============" << endl;
+
+        bslma::TestAllocator talloc("usage", veryVeryVeryVerbose);
+
+///Usage
+///-----
+// In this section we show intended use of this component.
+//
+///Example 1: A Scan-Resistant Cache
+///- - - - - - - - - - - - - - - - -
+// Suppose that a service caches records that are frequently looked up, and
+// occasionally performs a report that reads every record once.  With an LRU
+// cache, the report would replace the frequently accessed records with records
+// that are not accessed again.
+//
+// First, we create a cache of at most 100 items using the W-TinyLFU eviction
+// policy, having a single shard so that the capacity applies exactly:
+//..
+    bdlcc::ShardedCache<int, int> cache(
+                                bdlcc::ShardedCacheEvictionPolicy::e_TINYLFU,
+                                100,
+                                1,
+                                &talloc);
+    ASSERT(1   == cache.numShards());
+    ASSERT(100 == cache.capacity());
+//..
+// Then, we insert the frequently accessed records, having keys 0 to 49, and
+// look each of them up:
+//..
+    for (int i = 0; i < 50; ++i) {
+        cache.insert(i, i * i);
+    }
+
+    bsl::shared_ptr<int> value;
+    for (int i = 0; i < 50; ++i) {
+        int rc = cache.tryGetValue(&value, i);
+        ASSERT(0     == rc);
+        ASSERT(i * i == *value);
+    }
+//..
+// Next, we simulate the report by inserting 1000 records that are not
+// accessed again:
+//..
+    for (int i = 1000; i < 2000; ++i) {
+        cache.insert(i, i * i);
+    }
+    ASSERT(100 == cache.size());
+//..
+// Finally, we observe that the frequently accessed records are still cached,
+// because each of the records inserted by the report was accessed less often
+// than the record it would have replaced:
+//..
+    for (int i = 0; i < 50; ++i) {
+        int rc = cache.tryGetValue(&value, i);
+        ASSERT(0 == rc);
+    }
+//..
+      } break;
+      case 8: {
+        // --------------------------------------------------------------------
+        // THREAD SAFETY
+        //
+        // Concerns:
+        //: 1 Concurrent insertions, lookups, and erasures on a cache having
+        //:   several shards, with each eviction policy, do not corrupt the
+        //:   cache, and the values found are those inserted.
+        //:
+        //: 2 The size of the cache never exceeds its capacity.
+        //:
+        //: 3 All memory is released when the cache is destroyed.
+        //
+        // Plan:
+        //: 1 For each eviction policy, perform random operations on a cache
+        //:   from several threads, then verify that the size of the cache is
+        //:   at most its capacity, and that 'visit' visits 'size()' items.
+        //:   (C-1..3)
+        //
+        // Testing:
+        //   THREAD SAFETY
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "THREAD SAFETY" << endl
+                          << "=============" << endl;
+
+        const int NUM_THREADS    = 8;
+        const int NUM_OPERATIONS = 20000;
+        const int NUM_KEYS       = 2000;
+        const int CAPACITY       = 300;
+
+        for (int pi = 0; pi < NUM_SHARDED_POLICIES; ++pi) {
+            const Policy::Enum POLICY = SHARDED_POLICIES[pi];
+
+            if (veryVerbose) { T_ P(policyName(POLICY)) }
+
+            bslma::TestAllocator ta("thread", veryVeryVeryVerbose);
+            {
+                Obj mX(POLICY, CAPACITY, 8, &ta);  const Obj& X = mX;
+
+                bslmt::Barrier     barrier(NUM_THREADS);
+                bslmt::ThreadGroup threadGroup(&ta);
+                threadGroup.addThreads(
+                                  bdlf::BindUtil::bind(&randomOperations,
+                                                       &mX,
+                                                       NUM_OPERATIONS,
+                                                       NUM_KEYS,
+                                                       &barrier),
+                                  NUM_THREADS);
+                threadGroup.joinAll();
+
+                ASSERTV(policyName(POLICY), X.size(), CAPACITY >= X.size());
+                ASSERTV(policyName(POLICY),
+                        X.size() == sortedKeys(X, &ta).size());
+            }
+            ASSERTV(policyName(POLICY), 0 == ta.numBlocksInUse());
+        }
+      } break;
+      case 7: {
+        // --------------------------------------------------------------------
+        // EVICTION: TINYLFU ADMISSION
+        //
+        // Concerns:
+        //: 1 Items inserted into a full W-TinyLFU cache, and not accessed
+        //:   again, do not replace frequently accessed items.
+        //:
+        //: 2 An item accessed more frequently than the items of the main
+        //:   region is admitted to it.
+        //:
+        //: 3 A FIFO cache, subjected to the same operations, loses the
+        //:   frequently accessed items (verifying the test itself).
+        //:
+        //: 4 A cache having a capacity of 1 holds the most recently inserted
+        //:   item.
+        //
+        // Plan:
+        //: 1 Insert and look up a set of "hot" keys, then insert many keys
+        //:   once, and verify that the hot keys are still cached.  (C-1, 3)
+        //:
+        //: 2 Insert a new key repeatedly, then insert another key, and verify
+        //:   that the first key is still cached.  (C-2)
+        //:
+        //: 3 Insert several keys into a cache of capacity 1.  (C-4)
+        //
+        // Testing:
+        //   EVICTION: TINYLFU ADMISSION
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "EVICTION: TINYLFU ADMISSION" << endl
+                          << "===========================" << endl;
+
+        bslma::TestAllocator ta("tinylfu", veryVeryVeryVerbose);
+
+        const int CAPACITY = 1000;
+        const int NUM_HOT  = 500;
+
+        bsl::shared_ptr<int> value;
+
+        for (int pi = 0; pi < 2; ++pi) {
+            const Policy::Enum POLICY = pi ? Policy::e_TINYLFU
+                                           : Policy::e_FIFO;
+
+            Obj mX(POLICY, CAPACITY, 1, &ta);  const Obj& X = mX;
+
+            for (int i = 0; i < NUM_HOT; ++i) {
+                mX.insert(i, i);
+            }
+            for (int j = 0; j < 3; ++j) {
+                for (int i = 0; i < NUM_HOT; ++i) {
+                    ASSERTV(i, 0 == mX.tryGetValue(&value, i));
+                }
+            }
+
+            for (int i = 0; i < 10 * CAPACITY; ++i) {
+                mX.insert(100000 + i, i);
+            }
+            ASSERTV(X.size(), CAPACITY == X.size());
+
+            int numHotCached = 0;
+            for (int i = 0; i < NUM_HOT; ++i) {
+                numHotCached += 0 == mX.tryGetValue(&value, i);
+            }
+
+            if (veryVerbose) { T_ P_(policyName(POLICY)) P(numHotCached) }
+
+            if (Policy::e_TINYLFU == POLICY) {
+                ASSERTV(numHotCached, NUM_HOT == numHotCached);
+
+                // Make a new key more popular than the hot keys.
+
+                for (int j = 0; j < 10; ++j) {
+                    mX.insert(-1, -1);
+                }
+                mX.insert(-2, -2);
+
+                ASSERT(0 == mX.tryGetValue(&value, -1));
+                ASSERT(-1 == *value);
+                ASSERTV(X.size(), CAPACITY == X.size());
+            }
+            else {
+                ASSERTV(numHotCached, 0 == numHotCached);
+            }
+        }
+
+        if (verbose) cout << "\tTesting a capacity of 1." << endl;
+
+        for (int pi = 0; pi < NUM_SHARDED_POLICIES; ++pi) {
+            const Policy::Enum POLICY = SHARDED_POLICIES[pi];
+
+            Obj mX(POLICY, 1, &ta);  const Obj& X = mX;
+            ASSERT(1 == X.numShards());
+
+            for (int i = 0; i < 5; ++i) {
+                mX.insert(i, i);
+                ASSERTV(policyName(POLICY), i, 1 == X.size());
+                ASSERTV(policyName(POLICY), i, 0 == mX.tryGetValue(&value, i));
+            }
+        }
+        value.reset();
+        ASSERT(0 == ta.numBlocksInUse());
+      } break;
+      case 6: {
+        // --------------------------------------------------------------------
+        // EVICTION ORDER: FIFO, CLOCK, SIEVE
+        //
+        // Concerns:
+        //: 1 FIFO evicts the items in order of insertion, regardless of
+        //:   lookups.
+        //:
+        //: 2 CLOCK moves a visited item to the back of the queue, clearing its
+        //:   flag, and evicts the first unvisited item.
+        //:
+        //: 3 SIEVE evicts the first unvisited item found by the hand without
+        //:   moving visited items, and the hand resumes from the position of
+        //:   the evicted item.
+        //:
+        //: 4 Replacing the value of an existing item marks it as visited.
+        //:
+        //: 5 The post-eviction callback is invoked for each evicted item, in
+        //:   order.
+        //
+        // Plan:
+        //: 1 Using a single-shard cache of capacity 4, insert keys 1 to 4,
+        //:   look up 1 and 3, insert 5, 6, and 7, and verify the remaining
+        //:   keys and the evicted values for each policy.  (C-1..3, 5)
+        //:
+        //: 2 Repeat P-1, replacing the value of key 1 instead of looking it
+        //:   up.  (C-4)
+        //
+        // Testing:
+        //   EVICTION ORDER: FIFO, CLOCK, SIEVE
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "EVICTION ORDER: FIFO, CLOCK, SIEVE" << endl
+                          << "==================================" << endl;
+
+        bslma::TestAllocator ta("order", veryVeryVeryVerbose);
+
+        static const struct {
+            int          d_line;         // source line number
+            Policy::Enum d_policy;       // eviction policy
+            bool         d_replace;      // replace key 1 instead of lookup
+            int          d_kept[4];      // expected keys, sorted
+            int          d_evicted[3];   // expected evicted values
+        } DATA[] = {
+            //LINE POLICY           REPL  KEPT          EVICTED
+            //---- ---------------  ----  ------------  ---------
+            { L_,  Policy::e_FIFO,  0,    { 4, 5, 6, 7 }, { 1, 2, 3 } },
+            { L_,  Policy::e_CLOCK, 0,    { 3, 5, 6, 7 }, { 2, 4, 1 } },
+            { L_,  Policy::e_SIEVE, 0,    { 1, 3, 6, 7 }, { 2, 4, 5 } },
+            { L_,  Policy::e_FIFO,  1,    { 4, 5, 6, 7 }, { 1, 2, 3 } },
+            { L_,  Policy::e_CLOCK, 1,    { 3, 5, 6, 7 }, { 2, 4, 1 } },
+            { L_,  Policy::e_SIEVE, 1,    { 1, 3, 6, 7 }, { 2, 4, 5 } },
+        };
+        const int NUM_DATA = static_cast<int>(sizeof DATA / sizeof *DATA);
+
+        for (int ti = 0; ti < NUM_DATA; ++ti) {
+            const int          LINE    = DATA[ti].d_line;
+            const Policy::Enum POLICY  = DATA[ti].d_policy;
+            const bool         REPLACE = DATA[ti].d_replace;
+
+            if (veryVerbose) { T_ P_(LINE) P_(policyName(POLICY)) P(REPLACE) }
+
+            EvictionRecorder recorder(&ta);
+
+            Obj mX(POLICY, 4, 1, &ta);  const Obj& X = mX;
+            mX.setPostEvictionCallback(
+                              bdlf::BindUtil::bind(&EvictionRecorder::record,
+                                                   &recorder,
+                                                   bdlf::PlaceHolders::_1));
+
+            for (int i = 1; i <= 4; ++i) {
+                mX.insert(i, i);
+            }
+
+            bsl::shared_ptr<int> value;
+            if (REPLACE) {
+                mX.insert(1, 1);
+            }
+            else {
+                ASSERTV(LINE, 0 == mX.tryGetValue(&value, 1));
+            }
+            ASSERTV(LINE, 0 == mX.tryGetValue(&value, 3));
+
+            for (int i = 5; i <= 7; ++i) {
+                mX.insert(i, i);
+            }
+
+            const bsl::vector<int> EXP_KEPT = makeKeys(DATA[ti].d_kept[0],
+                                                       DATA[ti].d_kept[1],
+                                                       DATA[ti].d_kept[2],
+                                                       DATA[ti].d_kept[3],
+                                                       &ta);
+            ASSERTV(LINE, EXP_KEPT == sortedKeys(X, &ta));
+
+            ASSERTV(LINE, 3 == recorder.values().size());
+            for (bsl::size_t i = 0; i < recorder.values().size() && i < 3;
+                                                                         ++i) {
+                ASSERTV(LINE, i, recorder.values()[i],
+                        DATA[ti].d_evicted[i] == recorder.values()[i]);
+            }
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+      } break;
+      case 5: {
+        // --------------------------------------------------------------------
+        // MANIPULATORS
+        //
+        // Concerns:
+        //: 1 'insert' adds an item, or replaces the value of an existing item,
+        //:   and 'tryGetValue' finds the value of an item.
+        //:
+        //: 2 'erase' and 'eraseBulk' remove items and invoke the post-eviction
+        //:   callback; 'clear' removes all items without invoking it.
+        //:
+        //: 3 'insertBulk' returns the number of new items.
+        //:
+        //: 4 'size' and 'visit' reflect the items in the cache.
+        //:
+        //: 5 Values are allocated using the allocator of the cache, and all
+        //:   memory is released by 'clear' and on destruction.
+        //:
+        //: 6 'insert' is exception neutral.
+        //
+        // Plan:
+        //: 1 For each eviction policy, apply a sequence of manipulators to a
+        //:   cache having several shards and a capacity exceeding the number
+        //:   of keys, and verify the results of the accessors.  (C-1..5)
+        //:
+        //: 2 Use 'BSLMA_TESTALLOCATOR_EXCEPTION_TEST' to insert items while
+        //:   the allocator throws.  (C-6)
+        //
+        // Testing:
+        //   void clear();
+        //   int erase(const KEY& key);
+        //   int eraseBulk(const bsl::vector<KEY>& keys);
+        //   void insert(const KEY& key, const VALUE& value);
+        //   void insert(const KEY& key, bslmf::MovableRef<VALUE> value);
+        //   void insert(const KEY& key, const ValuePtrType& valuePtr);
+        //   int insertBulk(const bsl::vector<KVType>& data);
+        //   void setPostEvictionCallback(postEvictionCallback);
+        //   int tryGetValue(bsl::shared_ptr<VALUE> *value, const KEY& key);
+        //   bsl::size_t size() const;
+        //   void visit(VISITOR& visitor) const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "MANIPULATORS" << endl
+                          << "============" << endl;
+
+        for (int pi = 0; pi < NUM_SHARDED_POLICIES; ++pi) {
+            const Policy::Enum POLICY = SHARDED_POLICIES[pi];
+
+            if (veryVerbose) { T_ P(policyName(POLICY)) }
+
+            bslma::TestAllocator ta("manip", veryVeryVeryVerbose);
+
+            {
+                typedef bdlcc::ShardedCache<int, bsl::string> StrObj;
+
+                StrObj mX(POLICY, 1000, 4, &ta);  const StrObj& X = mX;
+                ASSERT(0 == X.size());
+
+                bsl::shared_ptr<bsl::string> value;
+                ASSERT(1 == mX.tryGetValue(&value, 1));
+
+                const bsl::string LONG("a string long enough to allocate",
+                                       &ta);
+
+                bslma::TestAllocatorMonitor tam(&ta);
+                mX.insert(1, LONG);
+                ASSERT(tam.isInUseUp());
+                ASSERT(1 == X.size());
+                ASSERT(0 == mX.tryGetValue(&value, 1));
+                ASSERT(LONG == *value);
+                ASSERT(&ta == value->get_allocator().mechanism());
+
+                bsl::string moved(LONG, &ta);
+                mX.insert(2, bslmf::MovableRefUtil::move(moved));
+                ASSERT(2 == X.size());
+                ASSERT(0 == mX.tryGetValue(&value, 2));
+                ASSERT(LONG == *value);
+
+                bsl::shared_ptr<bsl::string> ptr;
+                ptr.createInplace(&ta, "pointer", &ta);
+                mX.insert(3, ptr);
+                ASSERT(3 == X.size());
+                ASSERT(0 == mX.tryGetValue(&value, 3));
+                ASSERT(ptr == value);
+
+                mX.insert(1, bsl::string("replaced", &ta));
+                ASSERT(3 == X.size());
+                ASSERT(0 == mX.tryGetValue(&value, 1));
+                ASSERT("replaced" == *value);
+
+                value.reset();
+                mX.clear();
+                ASSERT(0 == X.size());
+                ASSERT(1 == mX.tryGetValue(&value, 1));
+                ASSERT(1 == ptr.use_count());
+
+                BSLMA_TESTALLOCATOR_EXCEPTION_TEST_BEGIN(ta) {
+                    mX.insert(4, LONG);
+                } BSLMA_TESTALLOCATOR_EXCEPTION_TEST_END
+                ASSERT(1 == X.size());
+                ASSERT(0 == mX.tryGetValue(&value, 4));
+                ASSERT(LONG == *value);
+            }
+            ASSERT(0 == ta.numBlocksInUse());
+
+            {
+                EvictionRecorder recorder(&ta);
+
+                Obj mX(POLICY, 1000, 4, &ta);  const Obj& X = mX;
+                mX.setPostEvictionCallback(
+                              bdlf::BindUtil::bind(&EvictionRecorder::record,
+                                                   &recorder,
+                                                   bdlf::PlaceHolders::_1));
+
+                bsl::vector<Obj::KVType> data(&ta);
+                for (int i = 0; i < 100; ++i) {
+                    bsl::shared_ptr<int> ptr;
+                    ptr.createInplace(&ta, 10 * i);
+                    data.push_back(Obj::KVType(i, ptr));
+                }
+                ASSERT(100 == mX.insertBulk(data));
+                ASSERT(100 == X.size());
+                ASSERT(0   == mX.insertBulk(data));
+                ASSERT(100 == X.size());
+                ASSERT(0   == recorder.values().size());
+
+                bsl::vector<int> keys = sortedKeys(X, &ta);
+                ASSERT(100 == keys.size());
+                for (int i = 0; i < 100 && i < static_cast<int>(keys.size());
+                                                                         ++i) {
+                    ASSERTV(i, keys[i], i == keys[i]);
+                }
+
+                bsl::shared_ptr<int> value;
+                for (int i = 0; i < 100; ++i) {
+                    ASSERTV(i, 0 == mX.tryGetValue(&value, i));
+                    ASSERTV(i, 10 * i == *value);
+                }
+
+                ASSERT(0 == mX.erase(7));
+                ASSERT(1 == mX.erase(7));
+                ASSERT(99 == X.size());
+                ASSERT(1 == mX.tryGetValue(&value, 7));
+                ASSERT(1 == recorder.values().size());
+                ASSERT(70 == recorder.values()[0]);
+
+                bsl::vector<int> eraseKeys(&ta);
+                eraseKeys.push_back(7);
+                eraseKeys.push_back(8);
+                eraseKeys.push_back(9);
+                eraseKeys.push_back(1000);
+                ASSERT(2 == mX.eraseBulk(eraseKeys));
+                ASSERT(97 == X.size());
+                ASSERT(3 == recorder.values().size());
+
+                recorder.clear();
+                mX.clear();
+                ASSERT(0 == X.size());
+                ASSERT(0 == recorder.values().size());
+                ASSERT(0 == sortedKeys(X, &ta).size());
+
+                mX.insert(5, 50);
+                ASSERT(1 == X.size());
+                ASSERT(0 == mX.tryGetValue(&value, 5));
+                ASSERT(50 == *value);
+            }
+            ASSERT(0 == ta.numBlocksInUse());
+        }
+      } break;
+      case 4: {
+        // --------------------------------------------------------------------
+        // CREATORS AND BASIC ACCESSORS
+        //
+        // Concerns:
+        //: 1 The number of shards is rounded up to a power of two, and is at
+        //:   most the largest power of two not greater than the capacity.
+        //:
+        //: 2 The accessors return the attributes supplied at construction.
+        //:
+        //: 3 Memory is supplied by the specified (or default) allocator, and
+        //:   released on destruction.
+        //:
+        //: 4 Items are found using the supplied hash and equal functors.  Note
+        //:   that items having the same hash value are in the same shard.
+        //:
+        //: 5 QoI: Asserted precondition violations are detected when enabled.
+        //
+        // Plan:
+        //: 1 Using the table-driven technique, create caches with various
+        //:   capacities and numbers of shards and verify the accessors.
+        //:   (C-1..3)
+        //:
+        //: 2 Create a cache with a hash functor producing many collisions and
+        //:   verify that all items are found.  (C-4)
+        //:
+        //: 3 Verify that, in appropriate build modes, defensive checks are
+        //:   triggered for invalid arguments.  (C-5)
+        //
+        // Testing:
+        //   ShardedCache(policy, capacity, basicAllocator);
+        //   ShardedCache(policy, capacity, numShards, basicAllocator);
+        //   ShardedCache(policy, capacity, numShards, hash, equal, alloc);
+        //   ~ShardedCache();
+        //   bsl::size_t capacity() const;
+        //   EQUAL equalFunction() const;
+        //   ShardedCacheEvictionPolicy::Enum evictionPolicy() const;
+        //   HASH hashFunction() const;
+        //   bsl::size_t numShards() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "CREATORS AND BASIC ACCESSORS" << endl
+                          << "============================" << endl;
+
+        static const struct {
+            int         d_line;       // source line number
+            bsl::size_t d_capacity;   // capacity
+            bsl::size_t d_numShards;  // requested number of shards
+            bsl::size_t d_expShards;  // expected number of shards
+        } DATA[] = {
+            //LINE  CAP    REQ  EXP
+            //----  -----  ---  ---
+            { L_,       1,   1,   1 },
+            { L_,       1,  16,   1 },
+            { L_,       3,  16,   2 },
+            { L_,      16,  16,  16 },
+            { L_,     100,   3,   4 },
+            { L_,     100,  16,  16 },
+            { L_,     100, 100,  64 },
+            { L_,   10000,  17,  32 },
+        };
+        const int NUM_DATA = static_cast<int>(sizeof DATA / sizeof *DATA);
+
+        for (int ti = 0; ti < NUM_DATA; ++ti) {
+            const int         LINE       = DATA[ti].d_line;
+            const bsl::size_t CAPACITY   = DATA[ti].d_capacity;
+            const bsl::size_t NUM_SHARDS = DATA[ti].d_numShards;
+            const bsl::size_t EXP_SHARDS = DATA[ti].d_expShards;
+
+            for (int pi = 0; pi < NUM_SHARDED_POLICIES; ++pi) {
+                const Policy::Enum POLICY = SHARDED_POLICIES[pi];
+
+                if (veryVerbose) {
+                    T_ P_(LINE) P_(CAPACITY) P_(NUM_SHARDS)
+                                                        P(policyName(POLICY))
+                }
+
+                bslma::TestAllocator ta("object", veryVeryVeryVerbose);
+                {
+                    Obj mX(POLICY, CAPACITY, NUM_SHARDS, &ta);
+                    const Obj& X = mX;
+
+                    ASSERTV(LINE, 0 < ta.numBlocksInUse());
+                    ASSERTV(LINE, CAPACITY   == X.capacity());
+                    ASSERTV(LINE, POLICY     == X.evictionPolicy());
+                    ASSERTV(LINE, X.numShards(), EXP_SHARDS == X.numShards());
+                    ASSERTV(LINE, 0          == X.size());
+                }
+                ASSERTV(LINE, 0 == ta.numBlocksInUse());
+                {
+                    Obj mX(POLICY,
+                           CAPACITY,
+                           NUM_SHARDS,
+                           bsl::hash<int>(),
+                           bsl::equal_to<int>(),
+                           &ta);
+                    const Obj& X = mX;
+
+                    ASSERTV(LINE, EXP_SHARDS == X.numShards());
+                    ASSERTV(LINE, CAPACITY   == X.capacity());
+                }
+                ASSERTV(LINE, 0 == ta.numBlocksInUse());
+            }
+        }
+
+        if (verbose) cout << "\tTesting the default number of shards."
+                          << endl;
+        {
+            bslma::TestAllocator ta("object", veryVeryVeryVerbose);
+
+            Obj mX(Policy::e_SIEVE, 1000, &ta);  const Obj& X = mX;
+            ASSERT(Obj::k_DEFAULT_NUM_SHARDS == X.numShards());
+            ASSERT(1000 == X.capacity());
+        }
+
+        if (verbose) cout << "\tTesting the default allocator." << endl;
+        {
+            bslma::TestAllocator         da("default", veryVeryVeryVerbose);
+            bslma::DefaultAllocatorGuard dag(&da);
+            {
+                Obj mX(Policy::e_SIEVE, 100);
+                ASSERT(0 < da.numBlocksInUse());
+            }
+            ASSERT(0 == da.numBlocksInUse());
+        }
+
+        if (verbose) cout << "\tTesting the hash and equal functors."
+                          << endl;
+        {
+            typedef bdlcc::ShardedCache<int, int, ModHash> ModObj;
+
+            bslma::TestAllocator ta("object", veryVeryVeryVerbose);
+
+            ModObj mX(Policy::e_SIEVE,
+                      400,
+                      4,
+                      ModHash(),
+                      bsl::equal_to<int>(),
+                      &ta);
+            const ModObj& X = mX;
+
+            ASSERT(7 == X.hashFunction()(1007));
+            ASSERT(X.equalFunction()(3, 3));
+            ASSERT(!X.equalFunction()(3, 4));
+
+            for (int i = 0; i < 50; ++i) {
+                mX.insert(1000 * i + 7, i);
+            }
+            ASSERT(50 == X.size());
+
+            bsl::shared_ptr<int> value;
+            for (int i = 0; i < 50; ++i) {
+                ASSERTV(i, 0 == mX.tryGetValue(&value, 1000 * i + 7));
+                ASSERTV(i, i == *value);
+            }
+        }
+
+        if (verbose) cout << "\tNegative Testing." << endl;
+        {
+            bsls::AssertTestHandlerGuard hG;
+
+            bslma::TestAllocator ta("negative", veryVeryVeryVerbose);
+
+            ASSERT_PASS(Obj(Policy::e_FIFO, 1, 1, &ta));
+            ASSERT_FAIL(Obj(Policy::e_FIFO, 0, 1, &ta));
+            ASSERT_FAIL(Obj(Policy::e_FIFO, 1, 0, &ta));
+        }
+      } break;
+      case 3: {
+        // --------------------------------------------------------------------
+        // TESTING 'ShardedCache_Queue'
+        //
+        // Concerns:
+        //: 1 'pushNewest' links a node as the newest node of the queue.
+        //:
+        //: 2 'remove' unlinks the oldest, newest, or a middle node.
+        //:
+        //: 3 The size of the queue is maintained.
+        //
+        // Plan:
+        //: 1 Push a set of nodes, remove them in various orders, and verify
+        //:   the links after each operation.  (C-1..3)
+        //
+        // Testing:
+        //   ShardedCache_Queue
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "TESTING 'ShardedCache_Queue'" << endl
+                          << "============================" << endl;
+
+        Node  nodes[3];
+        Queue mX;  const Queue& X = mX;
+
+        ASSERT(0 == X.d_newest_p);
+        ASSERT(0 == X.d_oldest_p);
+        ASSERT(0 == X.d_size);
+
+        mX.pushNewest(&nodes[0]);
+        ASSERT(&nodes[0] == X.d_newest_p);
+        ASSERT(&nodes[0] == X.d_oldest_p);
+        ASSERT(1 == X.d_size);
+
+        mX.pushNewest(&nodes[1]);
+        mX.pushNewest(&nodes[2]);
+        ASSERT(&nodes[2] == X.d_newest_p);
+        ASSERT(&nodes[0] == X.d_oldest_p);
+        ASSERT(3 == X.d_size);
+        ASSERT(&nodes[1] == nodes[0].d_newer_p);
+        ASSERT(&nodes[2] == nodes[1].d_newer_p);
+        ASSERT(0         == nodes[2].d_newer_p);
+        ASSERT(0         == nodes[0].d_older_p);
+        ASSERT(&nodes[0] == nodes[1].d_older_p);
+        ASSERT(&nodes[1] == nodes[2].d_older_p);
+
+        mX.remove(&nodes[1]);
+        ASSERT(2 == X.d_size);
+        ASSERT(&nodes[2] == nodes[0].d_newer_p);
+        ASSERT(&nodes[0] == nodes[2].d_older_p);
+        ASSERT(0 == nodes[1].d_newer_p);
+        ASSERT(0 == nodes[1].d_older_p);
+
+        mX.remove(&nodes[0]);
+        ASSERT(1 == X.d_size);
+        ASSERT(&nodes[2] == X.d_newest_p);
+        ASSERT(&nodes[2] == X.d_oldest_p);
+
+        mX.pushNewest(&nodes[0]);
+        mX.remove(&nodes[0]);
+        ASSERT(1 == X.d_size);
+        ASSERT(&nodes[2] == X.d_newest_p);
+        ASSERT(&nodes[2] == X.d_oldest_p);
+        ASSERT(0 == nodes[2].d_newer_p);
+
+        mX.remove(&nodes[2]);
+        ASSERT(0 == X.d_newest_p);
+        ASSERT(0 == X.d_oldest_p);
+        ASSERT(0 == X.d_size);
+      } break;
+      case 2: {
+        // --------------------------------------------------------------------
+        // TESTING 'ShardedCache_FrequencySketch'
+        //
+        // Concerns:
+        //: 1 The frequency of a key that was never incremented is 0 (in the
+        //:   absence of collisions).
+        //:
+        //: 2 'increment' increases the frequency of a key by 1, saturating at
+        //:   15, without (significantly) affecting other keys.
+        //:
+        //: 3 'needsReset' becomes 'true' after ten times the capacity
+        //:   increments, and 'reset' halves the frequencies and clears
+        //:   'needsReset'.
+        //:
+        //: 4 Memory is supplied by the specified allocator.
+        //
+        // Plan:
+        //: 1 Increment a set of hash values a different number of times each
+        //:   and verify their frequencies, before and after 'reset'.
+        //:   (C-1..4)
+        //
+        // Testing:
+        //   ShardedCache_FrequencySketch
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "TESTING 'ShardedCache_FrequencySketch'" << endl
+                          << "======================================" << endl;
+
+        bslma::TestAllocator ta("sketch", veryVeryVeryVerbose);
+        {
+            const int CAPACITY = 64;
+
+            Sketch mX(CAPACITY, &ta);  const Sketch& X = mX;
+            ASSERT(1 == ta.numBlocksInUse());
+
+            Uint64 hashes[20];
+            for (int i = 0; i < 20; ++i) {
+                hashes[i] = (i + 1) * 0x9e3779b97f4a7c15ULL;
+                ASSERTV(i, 0 == X.frequency(hashes[i]));
+            }
+
+            int numIncrements = 0;
+            for (int i = 0; i < 20; ++i) {
+                for (int j = 0; j < i; ++j) {
+                    mX.increment(hashes[i]);
+                    ++numIncrements;
+                }
+            }
+
+            for (int i = 0; i < 20; ++i) {
+                const int EXP = i < 15 ? i : 15;
+                ASSERTV(i,
+                        X.frequency(hashes[i]),
+                        EXP == X.frequency(hashes[i]));
+            }
+            ASSERT(!X.needsReset());
+
+            while (numIncrements < 10 * CAPACITY) {
+                ASSERTV(numIncrements, !X.needsReset());
+                mX.increment(hashes[0]);
+                ++numIncrements;
+            }
+            ASSERT(X.needsReset());
+            ASSERT(15 == X.frequency(hashes[0]));
+
+            mX.reset();
+            ASSERT(!X.needsReset());
+            ASSERT(7 == X.frequency(hashes[0]));
+            for (int i = 1; i < 20; ++i) {
+                const int EXP = (i < 15 ? i : 15) / 2;
+                ASSERTV(i,
+                        X.frequency(hashes[i]),
+                        EXP == X.frequency(hashes[i]));
+            }
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+      } break;
+      case 1: {
+        // --------------------------------------------------------------------
+        // BREATHING TEST
+        //   This case exercises (but does not fully test) basic functionality.
+        //
+        // Concerns:
+        //: 1 The class is sufficiently functional to enable comprehensive
+        //:   testing in subsequent test cases.
+        //
+        // Plan:
+        //: 1 Create a cache with each eviction policy, insert more items than
+        //:   its capacity, and look up items.  (C-1)
+        //
+        // Testing:
+        //   BREATHING TEST
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "BREATHING TEST" << endl
+                          << "==============" << endl;
+
+        bslma::TestAllocator ta("breathing", veryVeryVeryVerbose);
+
+        for (int pi = 0; pi < NUM_SHARDED_POLICIES; ++pi) {
+            const Policy::Enum POLICY = SHARDED_POLICIES[pi];
+
+            if (veryVerbose) { T_ P(policyName(POLICY)) }
+
+            Obj mX(POLICY, 64, 4, &ta);  const Obj& X = mX;
+
+            ASSERT(64 == X.capacity());
+            ASSERT(4  == X.numShards());
+            ASSERT(0  == X.size());
+
+            mX.insert(1, 10);
+            mX.insert(2, 20);
+            ASSERT(2 == X.size());
+
+            bsl::shared_ptr<int> value;
+            ASSERT(0  == mX.tryGetValue(&value, 1));
+            ASSERT(10 == *value);
+            ASSERT(1  == mX.tryGetValue(&value, 3));
+
+            for (int i = 100; i < 1000; ++i) {
+                mX.insert(i, i);
+            }
+            ASSERTV(X.size(), 64 >= X.size());
+
+            ASSERT(0 == mX.erase(999));
+            ASSERT(1 == mX.erase(999));
+
+            mX.clear();
+            ASSERT(0 == X.size());
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+      } break;
+      case -1: {
+        // --------------------------------------------------------------------
+        // HIT RATE BENCHMARK
+        //   Compare the hit rate of 'bdlcc::Cache' (LRU) and of
+        //   'bdlcc::ShardedCache' with each eviction policy, for a workload of
+        //   Zipf-distributed lookups (each miss followed by an insertion)
+        //   interrupted by scans of keys that are never accessed again.
+        //   Command line parameters:
+        //   2nd parameter: capacity of the caches (default 1000).
+        //   3rd parameter: number of shards (default 1).
+        //   4th parameter: length of each scan (default 2000, 0 for none).
+        //
+        // Concerns:
+        //: 1 Scan-resistant policies keep a higher hit rate than LRU.
+        //
+        // Plan:
+        //: 1 Replay the same workload against each cache, and print the hit
+        //:   rates.
+        //
+        // Testing:
+        //   HIT RATE BENCHMARK
+        // --------------------------------------------------------------------
+
+        cout << endl
+             << "HIT RATE BENCHMARK" << endl
+             << "==================" << endl;
+
+        const int CAPACITY    = argc > 2 ? bsl::atoi(argv[2]) : 1000;
+        const int NUM_SHARDS  = argc > 3 ? bsl::atoi(argv[3]) : 1;
+        const int SCAN_LENGTH = argc > 4 ? bsl::atoi(argv[4]) : 2000;
+
+        const int NUM_KEYS      = 100000;
+        const int NUM_ACCESSES  = 1000000;
+        const int SCAN_INTERVAL = 50000;
+
+        bslma::TestAllocator ta("benchmark", veryVeryVeryVerbose);
+        ZipfGenerator        zipf(NUM_KEYS, 0.9, &ta);
+
+        cout << "policy, shards, hit rate" << endl;
+        {
+            bdlcc::Cache<int, int> cache(bdlcc::CacheEvictionPolicy::e_LRU,
+                                         CAPACITY,
+                                         CAPACITY,
+                                         &ta);
+            const double hitRate = measureHitRate(&cache,
+                                                  zipf,
+                                                  NUM_ACCESSES,
+                                                  SCAN_INTERVAL,
+                                                  SCAN_LENGTH);
+            cout << "Cache LRU, 1, " << hitRate << endl;
+        }
+        for (int pi = 0; pi < NUM_SHARDED_POLICIES; ++pi) {
+            const Policy::Enum POLICY = SHARDED_POLICIES[pi];
+
+            Obj cache(POLICY, CAPACITY, NUM_SHARDS, &ta);
+            const double hitRate = measureHitRate(&cache,
+                                                  zipf,
+                                                  NUM_ACCESSES,
+                                                  SCAN_INTERVAL,
+                                                  SCAN_LENGTH);
+            cout << "ShardedCache " << policyName(POLICY) << ", "
+                 << cache.numShards() << ", " << hitRate << endl;
+        }
+      } break;
+      case -2: {
+        // --------------------------------------------------------------------
+        // THROUGHPUT BENCHMARK
+        //   Compare the throughput of lookups and insertions from several
+        //   threads on 'bdlcc::Cache' (LRU and FIFO) and on
+        //   'bdlcc::ShardedCache' (SIEVE and TINYLFU).  Command line
+        //   parameters:
+        //   2nd parameter: maximum number of threads (default 16).
+        //   3rd parameter: percentage of insertions (default 5).
+        //   4th parameter: milliseconds per sample (default 500).
+        //
+        // Concerns:
+        //: 1 The throughput of 'bdlcc::ShardedCache' scales with the number of
+        //:   threads.
+        //
+        // Plan:
+        //: 1 Using 'bslmt::ThroughputBenchmark', measure the median number of
+        //:   operations per second for 1, 2, 4, ... threads.
+        //
+        // Testing:
+        //   THROUGHPUT BENCHMARK
+        // --------------------------------------------------------------------
+
+        cout << endl
+             << "THROUGHPUT BENCHMARK" << endl
+             << "====================" << endl;
+
+        const int MAX_THREADS    = argc > 2 ? bsl::atoi(argv[2]) : 16;
+        const int INSERT_PERCENT = argc > 3 ? bsl::atoi(argv[3]) : 5;
+        const int NUM_MILLIS     = argc > 4 ? bsl::atoi(argv[4]) : 500;
+
+        const int NUM_KEYS = 100000;
+        const int CAPACITY = 50000;
+
+        bslma::Allocator *alloc = bslma::Default::globalAllocator();
+
+        cout << "threads, Cache LRU, Cache FIFO, ShardedCache SIEVE, "
+                "ShardedCache TINYLFU (operations/s)" << endl;
+
+        for (int numThreads = 1; numThreads <= MAX_THREADS; numThreads *= 2) {
+            bdlcc::Cache<int, int> lru(bdlcc::CacheEvictionPolicy::e_LRU,
+                                       CAPACITY,
+                                       CAPACITY,
+                                       alloc);
+            bdlcc::Cache<int, int> fifo(bdlcc::CacheEvictionPolicy::e_FIFO,
+                                        CAPACITY,
+                                        CAPACITY,
+                                        alloc);
+            Obj sieve(Policy::e_SIEVE, CAPACITY, 64, alloc);
+            Obj tinyLfu(Policy::e_TINYLFU, CAPACITY, 64, alloc);
+
+            cout << numThreads << ", "
+                 << bsl::fixed << bsl::setprecision(0)
+                 << measureThroughput(&lru,
+                                      numThreads,
+                                      NUM_KEYS,
+                                      INSERT_PERCENT,
+                                      NUM_MILLIS) << ", "
+                 << measureThroughput(&fifo,
+                                      numThreads,
+                                      NUM_KEYS,
+                                      INSERT_PERCENT,
+                                      NUM_MILLIS) << ", "
+                 << measureThroughput(&sieve,
+                                      numThreads,
+                                      NUM_KEYS,
+                                      INSERT_PERCENT,
+                                      NUM_MILLIS) << ", "
+                 << measureThroughput(&tinyLfu,
+                                      numThreads,
+                                      NUM_KEYS,
+                                      INSERT_PERCENT,
+                                      NUM_MILLIS) << endl;
+        }
+      } break;
+      default: {
+        cout << "WARNING: CASE `" << test << "' NOT FOUND." << endl;
+        testStatus = -1;
+      }
+    }
+
+    // CONCERN: In no case does memory come from the default allocator.
+
+    if (test > 0) {
+        ASSERTV(dam.isTotalSame());
+    }
+
+    if (testStatus > 0) {
+        cout << "Error, non-zero test status = " << testStatus << "." << endl;
+    }
+    return testStatus;
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2020 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
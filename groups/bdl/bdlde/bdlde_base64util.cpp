@@ -0,0 +1,852 @@
+// bdlde_base64util.cpp                                               -*-C++-*-
+#include <bdlde_base64util.h>
+
+#include <bsls_ident.h>
+BSLS_IDENT_RCSID(bdlde_base64util_cpp,"$Id$ $CSID$")
+
+#include <bdlde_base64decoder.h>  // for testing only
+#include <bdlde_base64encoder.h>  // for testing only
+
+#include <bslmt_once.h>
+
+#include <bsls_assert.h>
+#include <bsls_performancehint.h>
+#include <bsls_platform.h>
+
+#include <bsl_cstring.h>
+
+#if defined(BSLS_PLATFORM_HAS_X86_TARGET_ATTRIBUTE)
+#include <cpuid.h>
+#include <immintrin.h>
+#endif
+
+namespace BloombergLP {
+namespace bdlde {
+namespace {
+
+                        // ======================
+                        // FILE-SCOPE STATIC DATA
+                        // ======================
+
+// The following table is a map of a 6-bit index value to the corresponding
+// Base64 encoding of that index.
+
+const char k_ENCODE[64] = {
+//   0    1    2    3    4    5    6    7
+    'A', 'B', 'C', 'D', 'E', 'F', 'G', 'H',  // 000
+    'I', 'J', 'K', 'L', 'M', 'N', 'O', 'P',  // 010
+    'Q', 'R', 'S', 'T', 'U', 'V', 'W', 'X',  // 020
+    'Y', 'Z', 'a', 'b', 'c', 'd', 'e', 'f',  // 030
+    'g', 'h', 'i', 'j', 'k', 'l', 'm', 'n',  // 040
+    'o', 'p', 'q', 'r', 's', 't', 'u', 'v',  // 050
+    'w', 'x', 'y', 'z', '0', '1', '2', '3',  // 060
+    '4', '5', '6', '7', '8', '9', '+', '/',  // 070
+};
+
+// The following table classifies every input character for the decoder:
+// values in the range '[0 .. 63]' are the 6-bit index of a Base64 alphabet
+// character, and the remaining values are described by the enumerators
+// below.
+
+enum {
+    e_EQUAL      = 64,  // the padding character '='
+    e_WHITESPACE = 65,  // always ignored
+    e_OTHER      = 66   // ignored only in relaxed mode
+};
+
+#define EQ static_cast<unsigned char>(e_EQUAL)
+#define WS static_cast<unsigned char>(e_WHITESPACE)
+#define OT static_cast<unsigned char>(e_OTHER)
+
+const unsigned char k_DECODE[256] = {
+    //  0   1   2   3   4   5   6   7   8   9   A   B   C   D   E   F
+    // --  --  --  --  --  --  --  --  --  --  --  --  --  --  --  --
+       OT, OT, OT, OT, OT, OT, OT, OT, OT, WS, WS, WS, WS, WS, OT, OT,  // 00
+       OT, OT, OT, OT, OT, OT, OT, OT, OT, OT, OT, OT, OT, OT, OT, OT,  // 10
+       WS, OT, OT, OT, OT, OT, OT, OT, OT, OT, OT, 62, OT, OT, OT, 63,  // 20
+       52, 53, 54, 55, 56, 57, 58, 59, 60, 61, OT, OT, OT, EQ, OT, OT,  // 30
+       OT,  0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14,  // 40
+       15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, OT, OT, OT, OT, OT,  // 50
+       OT, 26, 27, 28, 29, 30, 31, 32, 33, 34, 35, 36, 37, 38, 39, 40,  // 60
+       41, 42, 43, 44, 45, 46, 47, 48, 49, 50, 51, OT, OT, OT, OT, OT,  // 70
+       OT, OT, OT, OT, OT, OT, OT, OT, OT, OT, OT, OT, OT, OT, OT, OT,  // 80
+       OT, OT, OT, OT, OT, OT, OT, OT, OT, OT, OT, OT, OT, OT, OT, OT,  // 90
+       OT, OT, OT, OT, OT, OT, OT, OT, OT, OT, OT, OT, OT, OT, OT, OT,  // A0
+       OT, OT, OT, OT, OT, OT, OT, OT, OT, OT, OT, OT, OT, OT, OT, OT,  // B0
+       OT, OT, OT, OT, OT, OT, OT, OT, OT, OT, OT, OT, OT, OT, OT, OT,  // C0
+       OT, OT, OT, OT, OT, OT, OT, OT, OT, OT, OT, OT, OT, OT, OT, OT,  // D0
+       OT, OT, OT, OT, OT, OT, OT, OT, OT, OT, OT, OT, OT, OT, OT, OT,  // E0
+       OT, OT, OT, OT, OT, OT, OT, OT, OT, OT, OT, OT, OT, OT, OT, OT,  // F0
+};
+
+#undef EQ
+#undef WS
+#undef OT
+
+typedef void (*EncodeGroupsFn)(char                *out,
+                               const unsigned char *input,
+                               bsl::size_t          numGroups);
+    // Encode the specified 'numGroups' 3-byte groups starting at the
+    // specified 'input' into '4 * numGroups' characters at the specified
+    // 'out'.
+
+typedef bsl::size_t (*DecodeRunFn)(unsigned char       *out,
+                                   const unsigned char *input,
+                                   bsl::size_t          numChars);
+    // Decode from the specified 'input' the longest prefix of complete
+    // vector-sized blocks that consist entirely of Base64 alphabet characters
+    // into the specified 'out', and return the number of characters consumed
+    // (a multiple of 4, each 4 characters producing 3 bytes).  Never read
+    // beyond 'input + numChars', and never write beyond
+    // 'out + 3 * numChars / 4'.
+
+                          // =====================
+                          // scalar implementation
+                          // =====================
+
+void encodeGroupsScalar(char                *out,
+                        const unsigned char *input,
+                        bsl::size_t          numGroups)
+    // Encode the specified 'numGroups' 3-byte groups starting at the
+    // specified 'input' into the specified 'out' one group at a time.
+{
+    for (; numGroups; --numGroups, input += 3, out += 4) {
+        const unsigned int bits = (static_cast<unsigned int>(input[0]) << 16)
+                                | (static_cast<unsigned int>(input[1]) <<  8)
+                                |  static_cast<unsigned int>(input[2]);
+
+        out[0] = k_ENCODE[ bits >> 18        ];
+        out[1] = k_ENCODE[(bits >> 12) & 0x3f];
+        out[2] = k_ENCODE[(bits >>  6) & 0x3f];
+        out[3] = k_ENCODE[ bits        & 0x3f];
+    }
+}
+
+#if defined(BSLS_PLATFORM_HAS_X86_TARGET_ATTRIBUTE)
+
+                          // ====================
+                          // SSSE3 implementation
+                          // ====================
+
+// The vectorized algorithms below are those described by Wojciech Mula and
+// Daniel Lemire in "Faster Base64 Encoding and Decoding Using AVX2
+// Instructions" (ACM Transactions on the Web, 2018).
+
+__attribute__((target("ssse3")))
+inline
+__m128i encodeLanesSsse3(__m128i input)
+    // Return the 16 Base64 characters encoding the low 12 bytes of the
+    // specified 'input'.
+{
+    // Spread each 3-byte group over a 32-bit lane as 'b1 b0 b2 b1'.
+
+    input = _mm_shuffle_epi8(input, _mm_setr_epi8(1,  0,  2,  1,
+                                                  4,  3,  5,  4,
+                                                  7,  6,  8,  7,
+                                                 10,  9, 11, 10));
+
+    // Isolate the four 6-bit indices of each lane in its four bytes.
+
+    const __m128i t0 = _mm_and_si128(input, _mm_set1_epi32(0x0fc0fc00));
+    const __m128i t1 = _mm_mulhi_epu16(t0, _mm_set1_epi32(0x04000040));
+    const __m128i t2 = _mm_and_si128(input, _mm_set1_epi32(0x003f03f0));
+    const __m128i t3 = _mm_mullo_epi16(t2, _mm_set1_epi32(0x01000010));
+    const __m128i indices = _mm_or_si128(t1, t3);
+
+    // Translate each index to its character by adding an offset that depends
+    // only on the range the index falls in.
+
+    __m128i ranges = _mm_subs_epu8(indices, _mm_set1_epi8(51));
+    const __m128i isUpper = _mm_cmpgt_epi8(_mm_set1_epi8(26), indices);
+    ranges = _mm_or_si128(ranges,
+                          _mm_and_si128(isUpper, _mm_set1_epi8(13)));
+
+    const __m128i offsets = _mm_setr_epi8('a' - 26, '0' - 52, '0' - 52,
+                                          '0' - 52, '0' - 52, '0' - 52,
+                                          '0' - 52, '0' - 52, '0' - 52,
+                                          '0' - 52, '0' - 52, '+' - 62,
+                                          '/' - 63, 'A', 0, 0);
+
+    return _mm_add_epi8(_mm_shuffle_epi8(offsets, ranges), indices);
+}
+
+__attribute__((target("ssse3")))
+inline
+bool decodeLanesSsse3(__m128i *result, __m128i input)
+    // Load into the specified 'result' the 6-bit values of the 16 Base64
+    // characters in the specified 'input' and return 'true' if all 16 are
+    // Base64 alphabet characters, and return 'false' otherwise.
+{
+    const __m128i mask2F   = _mm_set1_epi8(0x2f);
+    const __m128i lutLow   = _mm_setr_epi8(0x15, 0x11, 0x11, 0x11,
+                                           0x11, 0x11, 0x11, 0x11,
+                                           0x11, 0x11, 0x13, 0x1a,
+                                           0x1b, 0x1b, 0x1b, 0x1a);
+    const __m128i lutHigh  = _mm_setr_epi8(0x10, 0x10, 0x01, 0x02,
+                                           0x04, 0x08, 0x04, 0x08,
+                                           0x10, 0x10, 0x10, 0x10,
+                                           0x10, 0x10, 0x10, 0x10);
+    const __m128i lutRoll  = _mm_setr_epi8(0,   16,  19,   4,
+                                           -65, -65, -71, -71,
+                                           0,   0,   0,   0,
+                                           0,   0,   0,   0);
+
+    const __m128i highNibbles = _mm_and_si128(_mm_srli_epi32(input, 4),
+                                              mask2F);
+    const __m128i lowNibbles  = _mm_and_si128(input, mask2F);
+    const __m128i low         = _mm_shuffle_epi8(lutLow, lowNibbles);
+    const __m128i high        = _mm_shuffle_epi8(lutHigh, highNibbles);
+
+    // A byte is valid if and only if its nibble classes do not intersect.
+
+    const __m128i valid = _mm_cmpeq_epi8(_mm_and_si128(low, high),
+                                         _mm_setzero_si128());
+    if (0xffff != _mm_movemask_epi8(valid)) {
+        return false;                                                 // RETURN
+    }
+
+    const __m128i isSlash = _mm_cmpeq_epi8(input, mask2F);
+    const __m128i roll    = _mm_shuffle_epi8(lutRoll,
+                                             _mm_add_epi8(isSlash,
+                                                          highNibbles));
+    *result = _mm_add_epi8(input, roll);
+    return true;
+}
+
+__attribute__((target("ssse3")))
+inline
+__m128i packLanesSsse3(__m128i values)
+    // Return the 12 bytes encoded by the 16 6-bit 'values' in the low 12
+    // bytes of the result.
+{
+    const __m128i merged = _mm_maddubs_epi16(values,
+                                             _mm_set1_epi32(0x01400140));
+    const __m128i packed = _mm_madd_epi16(merged,
+                                          _mm_set1_epi32(0x00011000));
+    return _mm_shuffle_epi8(packed, _mm_setr_epi8( 2,  1,  0,
+                                                   6,  5,  4,
+                                                  10,  9,  8,
+                                                  14, 13, 12,
+                                                  -1, -1, -1, -1));
+}
+
+__attribute__((target("ssse3")))
+inline
+void encodeGroupsSsse3(char                *out,
+                       const unsigned char *input,
+                       bsl::size_t          numGroups)
+    // Encode the specified 'numGroups' 3-byte groups starting at the
+    // specified 'input' into the specified 'out', 4 groups at a time.
+{
+    // Each step loads 16 bytes but consumes only 12, so stop while at least
+    // 16 bytes (6 groups) remain.
+
+    for (; numGroups >= 6; numGroups -= 4, input += 12, out += 16) {
+        const __m128i in = _mm_loadu_si128(
+                                     reinterpret_cast<const __m128i *>(input));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out),
+                         encodeLanesSsse3(in));
+    }
+    encodeGroupsScalar(out, input, numGroups);
+}
+
+__attribute__((target("ssse3")))
+inline
+bsl::size_t decodeRunSsse3(unsigned char       *out,
+                           const unsigned char *input,
+                           bsl::size_t          numChars)
+    // Decode from the specified 'input' the longest prefix of complete
+    // 16-character blocks that consist entirely of Base64 alphabet
+    // characters into the specified 'out', and return the number of
+    // characters consumed.  Note that each step stores 16 bytes but produces
+    // only 12, and is performed only while 32 characters remain, so that
+    // 'out + 3 * numChars / 4' is never exceeded.
+{
+    const unsigned char *const begin = input;
+
+    for (; numChars >= 32; numChars -= 16, input += 16, out += 12) {
+        __m128i values;
+        if (!decodeLanesSsse3(&values,
+                              _mm_loadu_si128(
+                                  reinterpret_cast<const __m128i *>(input)))) {
+            break;
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out),
+                         packLanesSsse3(values));
+    }
+    return input - begin;
+}
+
+                          // ===================
+                          // AVX2 implementation
+                          // ===================
+
+__attribute__((target("avx2")))
+void encodeGroupsAvx2(char                *out,
+                      const unsigned char *input,
+                      bsl::size_t          numGroups)
+    // Encode the specified 'numGroups' 3-byte groups starting at the
+    // specified 'input' into the specified 'out', 8 groups at a time.
+{
+    const __m256i shuffle = _mm256_setr_epi8(1,  0,  2,  1,
+                                             4,  3,  5,  4,
+                                             7,  6,  8,  7,
+                                            10,  9, 11, 10,
+                                             1,  0,  2,  1,
+                                             4,  3,  5,  4,
+                                             7,  6,  8,  7,
+                                            10,  9, 11, 10);
+    const __m256i offsets = _mm256_setr_epi8('a' - 26, '0' - 52, '0' - 52,
+                                             '0' - 52, '0' - 52, '0' - 52,
+                                             '0' - 52, '0' - 52, '0' - 52,
+                                             '0' - 52, '0' - 52, '+' - 62,
+                                             '/' - 63, 'A', 0, 0,
+                                             'a' - 26, '0' - 52, '0' - 52,
+                                             '0' - 52, '0' - 52, '0' - 52,
+                                             '0' - 52, '0' - 52, '0' - 52,
+                                             '0' - 52, '0' - 52, '+' - 62,
+                                             '/' - 63, 'A', 0, 0);
+
+    // Each step loads bytes '[0 .. 16)' and '[12 .. 28)' into the two lanes
+    // but consumes only 24, so stop while at least 28 bytes (10 groups)
+    // remain.
+
+    for (; numGroups >= 10; numGroups -= 8, input += 24, out += 32) {
+        const __m128i lo = _mm_loadu_si128(
+                                     reinterpret_cast<const __m128i *>(input));
+        const __m128i hi = _mm_loadu_si128(
+                                reinterpret_cast<const __m128i *>(input + 12));
+        __m256i in = _mm256_inserti128_si256(_mm256_castsi128_si256(lo),
+                                             hi,
+                                             1);
+        in = _mm256_shuffle_epi8(in, shuffle);
+
+        const __m256i t0 = _mm256_and_si256(in,
+                                            _mm256_set1_epi32(0x0fc0fc00));
+        const __m256i t1 = _mm256_mulhi_epu16(t0,
+                                              _mm256_set1_epi32(0x04000040));
+        const __m256i t2 = _mm256_and_si256(in,
+                                            _mm256_set1_epi32(0x003f03f0));
+        const __m256i t3 = _mm256_mullo_epi16(t2,
+                                              _mm256_set1_epi32(0x01000010));
+        const __m256i indices = _mm256_or_si256(t1, t3);
+
+        __m256i ranges = _mm256_subs_epu8(indices, _mm256_set1_epi8(51));
+        const __m256i isUpper = _mm256_cmpgt_epi8(_mm256_set1_epi8(26),
+                                                  indices);
+        ranges = _mm256_or_si256(ranges,
+                                 _mm256_and_si256(isUpper,
+                                                  _mm256_set1_epi8(13)));
+
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(out),
+                            _mm256_add_epi8(_mm256_shuffle_epi8(offsets,
+                                                                ranges),
+                                            indices));
+    }
+    encodeGroupsSsse3(out, input, numGroups);
+}
+
+__attribute__((target("avx2")))
+bsl::size_t decodeRunAvx2(unsigned char       *out,
+                          const unsigned char *input,
+                          bsl::size_t          numChars)
+    // Decode from the specified 'input' the longest prefix of complete
+    // 32-character blocks that consist entirely of Base64 alphabet
+    // characters into the specified 'out', and return the number of
+    // characters consumed.  Note that each step stores 32 bytes but produces
+    // only 24, and is performed only while 64 characters remain, so that
+    // 'out + 3 * numChars / 4' is never exceeded.
+{
+    const __m256i mask2F  = _mm256_set1_epi8(0x2f);
+    const __m256i lutLow  = _mm256_setr_epi8(0x15, 0x11, 0x11, 0x11,
+                                             0x11, 0x11, 0x11, 0x11,
+                                             0x11, 0x11, 0x13, 0x1a,
+                                             0x1b, 0x1b, 0x1b, 0x1a,
+                                             0x15, 0x11, 0x11, 0x11,
+                                             0x11, 0x11, 0x11, 0x11,
+                                             0x11, 0x11, 0x13, 0x1a,
+                                             0x1b, 0x1b, 0x1b, 0x1a);
+    const __m256i lutHigh = _mm256_setr_epi8(0x10, 0x10, 0x01, 0x02,
+                                             0x04, 0x08, 0x04, 0x08,
+                                             0x10, 0x10, 0x10, 0x10,
+                                             0x10, 0x10, 0x10, 0x10,
+                                             0x10, 0x10, 0x01, 0x02,
+                                             0x04, 0x08, 0x04, 0x08,
+                                             0x10, 0x10, 0x10, 0x10,
+                                             0x10, 0x10, 0x10, 0x10);
+    const __m256i lutRoll = _mm256_setr_epi8(0,   16,  19,   4,
+                                             -65, -65, -71, -71,
+                                             0,   0,   0,   0,
+                                             0,   0,   0,   0,
+                                             0,   16,  19,   4,
+                                             -65, -65, -71, -71,
+                                             0,   0,   0,   0,
+                                             0,   0,   0,   0);
+    const __m256i shuffle = _mm256_setr_epi8( 2,  1,  0,
+                                              6,  5,  4,
+                                             10,  9,  8,
+                                             14, 13, 12,
+                                             -1, -1, -1, -1,
+                                              2,  1,  0,
+                                              6,  5,  4,
+                                             10,  9,  8,
+                                             14, 13, 12,
+                                             -1, -1, -1, -1);
+    const __m256i compact = _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 7, 7);
+
+    const unsigned char *const begin = input;
+
+    for (; numChars >= 64; numChars -= 32, input += 32, out += 24) {
+        const __m256i in = _mm256_loadu_si256(
+                                     reinterpret_cast<const __m256i *>(input));
+
+        const __m256i highNibbles = _mm256_and_si256(
+                                                   _mm256_srli_epi32(in, 4),
+                                                   mask2F);
+        const __m256i lowNibbles  = _mm256_and_si256(in, mask2F);
+        const __m256i low  = _mm256_shuffle_epi8(lutLow,  lowNibbles);
+        const __m256i high = _mm256_shuffle_epi8(lutHigh, highNibbles);
+
+        if (!_mm256_testz_si256(low, high)) {
+            break;
+        }
+
+        const __m256i isSlash = _mm256_cmpeq_epi8(in, mask2F);
+        const __m256i roll    = _mm256_shuffle_epi8(
+                                      lutRoll,
+                                      _mm256_add_epi8(isSlash, highNibbles));
+        const __m256i values  = _mm256_add_epi8(in, roll);
+
+        const __m256i merged = _mm256_maddubs_epi16(
+                                               values,
+                                               _mm256_set1_epi32(0x01400140));
+        const __m256i packed = _mm256_madd_epi16(
+                                               merged,
+                                               _mm256_set1_epi32(0x00011000));
+
+        _mm256_storeu_si256(
+                    reinterpret_cast<__m256i *>(out),
+                    _mm256_permutevar8x32_epi32(
+                                       _mm256_shuffle_epi8(packed, shuffle),
+                                       compact));
+    }
+    return (input - begin) + decodeRunSsse3(out, input, numChars);
+}
+
+#endif  // BSLS_PLATFORM_HAS_X86_TARGET_ATTRIBUTE
+
+                          // =================
+                          // kernel dispatch
+                          // =================
+
+Base64Util_Impl::Kernel detectKernel()
+    // Return the best implementation supported by the running processor.
+{
+#if defined(BSLS_PLATFORM_HAS_X86_TARGET_ATTRIBUTE)
+    const unsigned int k_SSSE3_BIT   = 1U << 9;   // CPUID.1:ECX
+    const unsigned int k_OSXSAVE_BIT = 1U << 27;  // CPUID.1:ECX
+    const unsigned int k_AVX_BIT     = 1U << 28;  // CPUID.1:ECX
+    const unsigned int k_AVX2_BIT    = 1U << 5;   // CPUID.(7,0):EBX
+    const unsigned int k_YMM_STATE   = 0x6;       // XCR0: SSE and AVX state
+
+    unsigned int eax, ebx, ecx, edx;
+    if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx) || !(ecx & k_SSSE3_BIT)) {
+        return Base64Util_Impl::e_SCALAR;                             // RETURN
+    }
+
+    if ((ecx & k_OSXSAVE_BIT) && (ecx & k_AVX_BIT)
+     && 7 <= __get_cpuid_max(0, 0)) {
+        // AVX2 is usable only if the operating system saves the YMM
+        // registers on context switch.
+
+        unsigned int xcr0Low, xcr0High;
+        __asm__ __volatile__("xgetbv"
+                             : "=a"(xcr0Low), "=d"(xcr0High)
+                             : "c"(0));
+        (void)xcr0High;
+
+        if (k_YMM_STATE == (xcr0Low & k_YMM_STATE)) {
+            __cpuid_count(7, 0, eax, ebx, ecx, edx);
+            if (ebx & k_AVX2_BIT) {
+                return Base64Util_Impl::e_AVX2;                       // RETURN
+            }
+        }
+    }
+    return Base64Util_Impl::e_SSSE3;
+#else
+    return Base64Util_Impl::e_SCALAR;
+#endif
+}
+
+EncodeGroupsFn encodeGroupsFn(Base64Util_Impl::Kernel kernel)
+    // Return the group encoder for the specified 'kernel'.
+{
+    switch (kernel) {
+#if defined(BSLS_PLATFORM_HAS_X86_TARGET_ATTRIBUTE)
+      case Base64Util_Impl::e_AVX2:  return encodeGroupsAvx2;         // RETURN
+      case Base64Util_Impl::e_SSSE3: return encodeGroupsSsse3;        // RETURN
+#endif
+      default:                       return encodeGroupsScalar;       // RETURN
+    }
+}
+
+DecodeRunFn decodeRunFn(Base64Util_Impl::Kernel kernel)
+    // Return the vectorized run decoder for the specified 'kernel', or 0 if
+    // 'kernel' has none.
+{
+    switch (kernel) {
+#if defined(BSLS_PLATFORM_HAS_X86_TARGET_ATTRIBUTE)
+      case Base64Util_Impl::e_AVX2:  return decodeRunAvx2;            // RETURN
+      case Base64Util_Impl::e_SSSE3: return decodeRunSsse3;           // RETURN
+#endif
+      default:                       return 0;                        // RETURN
+    }
+}
+
+                          // ===============
+                          // generic drivers
+                          // ===============
+
+char *encodeUnbroken(char                *out,
+                     const unsigned char *input,
+                     bsl::size_t          inputLength,
+                     EncodeGroupsFn       encodeGroups)
+    // Encode the specified 'inputLength' bytes starting at the specified
+    // 'input' into the specified 'out', including '=' padding but without
+    // line breaks, using the specified 'encodeGroups', and return the
+    // address one past the last character written.
+{
+    const bsl::size_t numGroups = inputLength / 3;
+
+    encodeGroups(out, input, numGroups);
+    out   += 4 * numGroups;
+    input += 3 * numGroups;
+
+    switch (inputLength % 3) {
+      case 1: {
+        out[0] = k_ENCODE[  input[0] >> 2];
+        out[1] = k_ENCODE[ (input[0] & 0x03) << 4];
+        out[2] = '=';
+        out[3] = '=';
+        out += 4;
+      } break;
+      case 2: {
+        out[0] = k_ENCODE[  input[0] >> 2];
+        out[1] = k_ENCODE[((input[0] & 0x03) << 4) | (input[1] >> 4)];
+        out[2] = k_ENCODE[ (input[1] & 0x0f) << 2];
+        out[3] = '=';
+        out += 4;
+      } break;
+    }
+    return out;
+}
+
+bsl::size_t encodeImp(char                    *out,
+                      const char              *input,
+                      bsl::size_t              inputLength,
+                      int                      maxLineLength,
+                      Base64Util_Impl::Kernel  kernel)
+    // Implement 'Base64Util::encode' for the specified 'out', 'input',
+    // 'inputLength', and 'maxLineLength' using the specified 'kernel'.
+{
+    BSLS_ASSERT(out);
+    BSLS_ASSERT(input || 0 == inputLength);
+    BSLS_ASSERT(0 <= maxLineLength);
+
+    const EncodeGroupsFn  encodeGroups   = encodeGroupsFn(kernel);
+    const bsl::size_t     length         = Base64Util::encodedLength(
+                                                                inputLength,
+                                                                maxLineLength);
+    const bsl::size_t     unbrokenLength = (inputLength + 2) / 3 * 4;
+    const bsl::size_t     lineLength     =
+                                       static_cast<bsl::size_t>(maxLineLength);
+    const unsigned char  *in             =
+                              reinterpret_cast<const unsigned char *>(input);
+
+    if (length == unbrokenLength) {
+        encodeUnbroken(out, in, inputLength, encodeGroups);
+        return length;                                                // RETURN
+    }
+
+    if (0 == lineLength % 4) {
+        // Each line encodes a whole number of groups, so encode directly
+        // line by line.
+
+        const bsl::size_t lineBytes = lineLength / 4 * 3;
+        char              *cursor   = out;
+
+        while (inputLength > lineBytes) {
+            encodeGroups(cursor, in, lineBytes / 3);
+            cursor      += lineLength;
+            *cursor++    = '\r';
+            *cursor++    = '\n';
+            in          += lineBytes;
+            inputLength -= lineBytes;
+        }
+        encodeUnbroken(cursor, in, inputLength, encodeGroups);
+        return length;                                                // RETURN
+    }
+
+    // Lines end in the middle of a group: encode without line breaks into the
+    // tail of 'out', then move each line to its final position, front to
+    // back.  Line 'k' moves from 'tail + k * lineLength' to
+    // 'out + k * (lineLength + 2)', which is never past its source and never
+    // overwrites a line not yet moved.
+
+    char *const tail = out + (length - unbrokenLength);
+    encodeUnbroken(tail, in, inputLength, encodeGroups);
+
+    const char *source    = tail;
+    const char *sourceEnd = tail + unbrokenLength;
+    char       *cursor    = out;
+
+    while (static_cast<bsl::size_t>(sourceEnd - source) > lineLength) {
+        bsl::memmove(cursor, source, lineLength);
+        cursor    += lineLength;
+        source    += lineLength;
+        *cursor++  = '\r';
+        *cursor++  = '\n';
+    }
+    bsl::memmove(cursor, source, sourceEnd - source);
+    return length;
+}
+
+int decodeImp(char                    *out,
+              bsl::size_t             *numOut,
+              const char              *input,
+              bsl::size_t              inputLength,
+              bool                     unrecognizedIsErrorFlag,
+              Base64Util_Impl::Kernel  kernel)
+    // Implement 'Base64Util::decode' for the specified 'out', 'numOut',
+    // 'input', 'inputLength', and 'unrecognizedIsErrorFlag' using the
+    // specified 'kernel'.
+{
+    BSLS_ASSERT(out);
+    BSLS_ASSERT(numOut);
+    BSLS_ASSERT(input || 0 == inputLength);
+
+    const DecodeRunFn    decodeRun = decodeRunFn(kernel);
+    const unsigned char *in        =
+                              reinterpret_cast<const unsigned char *>(input);
+    const unsigned char *end       = in + inputLength;
+    unsigned char       *cursor    = reinterpret_cast<unsigned char *>(out);
+
+    // The scalar state machine below mirrors 'Base64Decoder': 'stack' holds
+    // the 6-bit values of the 'numChars' alphabet characters seen since the
+    // last complete 4-character group.  Whenever a group is complete, whole
+    // groups of alphabet characters are decoded directly, first by the
+    // vectorized 'decodeRun' (if any) and then 4 characters at a time.  Once
+    // 'decodeRun' stops (at a line break, padding, an invalid character, or
+    // near the end of the input) it is not retried until an ignorable
+    // character has been skipped, so that a line break costs a single
+    // failed attempt.
+
+    unsigned int stack    = 0;
+    int          numChars = 0;
+    bool         attempt  = true;
+
+    while (in != end) {
+        if (0 == numChars) {
+            if (decodeRun && attempt) {
+                const bsl::size_t consumed = decodeRun(cursor, in, end - in);
+                in      += consumed;
+                cursor  += consumed / 4 * 3;
+                attempt  = false;
+            }
+
+            while (end - in >= 4) {
+                const unsigned int v0 = k_DECODE[in[0]];
+                const unsigned int v1 = k_DECODE[in[1]];
+                const unsigned int v2 = k_DECODE[in[2]];
+                const unsigned int v3 = k_DECODE[in[3]];
+
+                if ((v0 | v1 | v2 | v3) >= 64) {
+                    break;
+                }
+
+                const unsigned int bits = (v0 << 18) | (v1 << 12)
+                                        | (v2 <<  6) |  v3;
+                cursor[0] = static_cast<unsigned char>(bits >> 16);
+                cursor[1] = static_cast<unsigned char>(bits >>  8);
+                cursor[2] = static_cast<unsigned char>(bits);
+                cursor   += 3;
+                in       += 4;
+            }
+
+            if (in == end) {
+                break;
+            }
+        }
+
+        const unsigned char value = k_DECODE[*in++];
+
+        if (BSLS_PERFORMANCEHINT_PREDICT_LIKELY(value < 64)) {
+            stack = (stack << 6) | value;
+            if (4 == ++numChars) {
+                cursor[0] = static_cast<unsigned char>(stack >> 16);
+                cursor[1] = static_cast<unsigned char>(stack >>  8);
+                cursor[2] = static_cast<unsigned char>(stack);
+                cursor   += 3;
+                stack     = 0;
+                numChars  = 0;
+            }
+            continue;
+        }
+
+        if (e_WHITESPACE == value
+         || (e_OTHER == value && !unrecognizedIsErrorFlag)) {
+            attempt = true;
+            continue;
+        }
+
+        if (e_OTHER == value) {
+            return -1;                                                // RETURN
+        }
+
+        // 'value' is '=': the input must end a group of 2 (requiring a second
+        // '=') or 3 characters whose unused low-order bits are all 0, and be
+        // followed only by ignorable characters.
+
+        bool needEqual;
+        if (2 == numChars && 0 == (stack & 0xf)) {
+            *cursor++ = static_cast<unsigned char>(stack >> 4);
+            needEqual = true;
+        }
+        else if (3 == numChars && 0 == (stack & 0x3)) {
+            *cursor++ = static_cast<unsigned char>(stack >> 10);
+            *cursor++ = static_cast<unsigned char>(stack >> 2);
+            needEqual = false;
+        }
+        else {
+            return -1;                                                // RETURN
+        }
+
+        for (; in != end; ++in) {
+            const unsigned char trailing = k_DECODE[*in];
+
+            if (e_WHITESPACE == trailing
+             || (e_OTHER == trailing && !unrecognizedIsErrorFlag)) {
+                continue;
+            }
+            if (needEqual && e_EQUAL == trailing) {
+                needEqual = false;
+                continue;
+            }
+            return -1;                                                // RETURN
+        }
+
+        if (needEqual) {
+            return -1;                                                // RETURN
+        }
+
+        *numOut = cursor - reinterpret_cast<unsigned char *>(out);
+        return 0;                                                     // RETURN
+    }
+
+    if (0 != numChars) {
+        return -1;                                                    // RETURN
+    }
+
+    *numOut = cursor - reinterpret_cast<unsigned char *>(out);
+    return 0;
+}
+
+}  // close unnamed namespace
+
+                              // -----------------
+                              // struct Base64Util
+                              // -----------------
+
+// CLASS METHODS
+bsl::size_t Base64Util::encode(char        *out,
+                               const char  *input,
+                               bsl::size_t  inputLength,
+                               int          maxLineLength)
+{
+    return encodeImp(out,
+                     input,
+                     inputLength,
+                     maxLineLength,
+                     Base64Util_Impl::bestKernel());
+}
+
+int Base64Util::decode(char        *out,
+                       bsl::size_t *numOut,
+                       const char  *input,
+                       bsl::size_t  inputLength,
+                       bool         unrecognizedIsErrorFlag)
+{
+    return decodeImp(out,
+                     numOut,
+                     input,
+                     inputLength,
+                     unrecognizedIsErrorFlag,
+                     Base64Util_Impl::bestKernel());
+}
+
+                           // ----------------------
+                           // struct Base64Util_Impl
+                           // ----------------------
+
+// CLASS METHODS
+Base64Util_Impl::Kernel Base64Util_Impl::bestKernel()
+{
+    static Kernel kernel = e_SCALAR;
+
+    BSLMT_ONCE_DO {
+        kernel = detectKernel();
+    }
+    return kernel;
+}
+
+bool Base64Util_Impl::isSupported(Kernel kernel)
+{
+    return kernel <= bestKernel();
+}
+
+bsl::size_t Base64Util_Impl::encode(Kernel       kernel,
+                                    char        *out,
+                                    const char  *input,
+                                    bsl::size_t  inputLength,
+                                    int          maxLineLength)
+{
+    BSLS_ASSERT(isSupported(kernel));
+
+    return encodeImp(out, input, inputLength, maxLineLength, kernel);
+}
+
+int Base64Util_Impl::decode(Kernel       kernel,
+                            char        *out,
+                            bsl::size_t *numOut,
+                            const char  *input,
+                            bsl::size_t  inputLength,
+                            bool         unrecognizedIsErrorFlag)
+{
+    BSLS_ASSERT(isSupported(kernel));
+
+    return decodeImp(out,
+                     numOut,
+                     input,
+                     inputLength,
+                     unrecognizedIsErrorFlag,
+                     kernel);
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+// ----------------------------------------------------------------------------
+// Copyright 2020 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
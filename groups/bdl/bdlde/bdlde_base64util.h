@@ -0,0 +1,268 @@
+// bdlde_base64util.h                                                 -*-C++-*-
+#ifndef INCLUDED_BDLDE_BASE64UTIL
+#define INCLUDED_BDLDE_BASE64UTIL
+
+#include <bsls_ident.h>
+BSLS_IDENT("$Id$")
+
+//@PURPOSE: Provide functions for bulk Base64 encoding and decoding.
+//
+//@CLASSES:
+//  bdlde::Base64Util     : namespace for one-shot Base64 encode and decode
+//  bdlde::Base64Util_Impl: access to the individual (SIMD) implementations
+//
+//@SEE_ALSO: bdlde_base64encoder, bdlde_base64decoder
+//
+//@DESCRIPTION: This component provides a namespace, 'bdlde::Base64Util',
+// containing functions that encode or decode a complete, contiguous buffer in
+// a single call.  The streaming automata 'bdlde::Base64Encoder' and
+// 'bdlde::Base64Decoder' process their input one byte at a time through
+// generic iterators, which is the right choice when data arrives
+// incrementally, but leaves most of the available throughput unused when the
+// whole input is already in memory.  The functions in this component produce
+// exactly the same output as the corresponding automaton ('convert' followed
+// by 'endConvert'), including soft line breaks ("\r\n") and '=' padding, and
+// accept and reject exactly the same inputs.
+//
+// The output buffer is supplied by the caller and must be at least
+// 'encodedLength' (respectively 'maxDecodedLength') bytes long; no memory is
+// allocated.
+//
+///Support for Hardware Acceleration
+///---------------------------------
+// When built for x86 with a compatible compiler (GCC 4.9 or later, or clang),
+// this component contains SSSE3 and AVX2 implementations of the inner encode
+// and decode loops, and the best implementation supported by the running
+// processor is selected (once) at runtime:
+//: o AVX2:  32 input characters (24 output bytes) per decode step, 24 input
+//:   bytes (32 characters) per encode step
+//: o SSSE3: 16 input characters (12 output bytes) per decode step, 12 input
+//:   bytes (16 characters) per encode step
+//: o otherwise a portable scalar implementation is used
+// The vectorized decoder handles runs of Base64 alphabet characters; any
+// other character (whitespace, line breaks, '=', or an invalid character)
+// is handed to the scalar state machine, so the results never depend on the
+// implementation selected.  'bdlde::Base64Util_Impl' exposes each
+// implementation explicitly for testing and benchmarking.
+//
+///Performance
+///-----------
+// See the test driver for this component (negative test case -1) to compare
+// the throughput of this component against 'bdlde::Base64Encoder' and
+// 'bdlde::Base64Decoder'.
+//
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Round-Tripping a Buffer
+/// - - - - - - - - - - - - - - - - -
+// Suppose we need to embed a binary payload in a textual (e.g., MIME) message
+// and later recover it.
+//
+// First, we create the payload:
+//..
+//  const char payload[] = "Hello, world!  This payload is Base64 encoded.";
+//  const bsl::size_t payloadLength = sizeof payload - 1;
+//..
+// Then, we size an output buffer and encode the payload, using the MIME
+// default line length of 76 characters:
+//..
+//  bsl::vector<char> encoded(
+//                       bdlde::Base64Util::encodedLength(payloadLength, 76));
+//  bsl::size_t numEncoded = bdlde::Base64Util::encode(encoded.data(),
+//                                                     payload,
+//                                                     payloadLength,
+//                                                     76);
+//  assert(encoded.size() == numEncoded);
+//..
+// Now, we decode the encoded text back into a buffer large enough to hold
+// the largest possible result:
+//..
+//  bsl::vector<char> decoded(
+//                          bdlde::Base64Util::maxDecodedLength(numEncoded));
+//  bsl::size_t numDecoded;
+//  int rc = bdlde::Base64Util::decode(decoded.data(),
+//                                     &numDecoded,
+//                                     encoded.data(),
+//                                     numEncoded);
+//  assert(0 == rc);
+//..
+// Finally, we verify that we recovered the original payload:
+//..
+//  assert(payloadLength == numDecoded);
+//  assert(0 == bsl::memcmp(payload, decoded.data(), numDecoded));
+//..
+
+#include <bdlscm_version.h>
+
+#include <bsls_assert.h>
+
+#include <bsl_cstddef.h>
+
+namespace BloombergLP {
+namespace bdlde {
+
+                              // =================
+                              // struct Base64Util
+                              // =================
+
+struct Base64Util {
+    // This 'struct' provides a namespace for functions that convert a
+    // complete buffer to and from its Base64 encoding (RFC 2045) in a single
+    // call.
+
+    // CLASS DATA
+    static const int k_DEFAULT_LINE_LENGTH = 76;
+        // Maximum line length used by 'encode' by default; this is also the
+        // default of 'Base64Encoder'.
+
+    // CLASS METHODS
+    static bsl::size_t encodedLength(
+                            bsl::size_t inputLength,
+                            int         maxLineLength = k_DEFAULT_LINE_LENGTH);
+        // Return the exact number of characters produced by 'encode' for an
+        // input of the specified 'inputLength' bytes and the optionally
+        // specified 'maxLineLength' (a value of 0 meaning no line breaks).
+        // The behavior is undefined unless '0 <= maxLineLength'.
+
+    static bsl::size_t maxDecodedLength(bsl::size_t inputLength);
+        // Return the maximum number of bytes that 'decode' can produce from
+        // an input of the specified 'inputLength' characters.
+
+    static bsl::size_t encode(
+                           char        *out,
+                           const char  *input,
+                           bsl::size_t  inputLength,
+                           int          maxLineLength = k_DEFAULT_LINE_LENGTH);
+        // Load into the specified 'out' the Base64 encoding of the specified
+        // 'inputLength' bytes starting at the specified 'input', inserting a
+        // "\r\n" soft line break after every run of the optionally specified
+        // 'maxLineLength' characters that is followed by more output (a value
+        // of 0 meaning no line breaks), and return the number of characters
+        // written.  The output is identical to that of a 'Base64Encoder'
+        // constructed with 'maxLineLength'.  The behavior is undefined unless
+        // '0 <= maxLineLength', 'out' refers to a buffer of at least
+        // 'encodedLength(inputLength, maxLineLength)' bytes that does not
+        // overlap 'input', and 'input' is non-null if '0 < inputLength'.
+
+    static int decode(char        *out,
+                      bsl::size_t *numOut,
+                      const char  *input,
+                      bsl::size_t  inputLength,
+                      bool         unrecognizedIsErrorFlag = true);
+        // Load into the specified 'out' the bytes decoded from the specified
+        // 'inputLength' Base64 characters starting at the specified 'input',
+        // and load into the specified 'numOut' the number of bytes decoded.
+        // If the optionally specified 'unrecognizedIsErrorFlag' is 'true',
+        // characters that are neither Base64 alphabet characters, '=', nor
+        // whitespace are errors; otherwise such characters are ignored.
+        // Return 0 if 'input' is a complete, valid Base64 encoding, and a
+        // non-zero value otherwise, in which case the contents of 'out' and
+        // the value of '*numOut' are unspecified.  The set of accepted inputs
+        // and the decoded bytes are identical to those of a 'Base64Decoder'
+        // constructed with 'unrecognizedIsErrorFlag' that is given the whole
+        // input followed by 'endConvert'.  The behavior is undefined unless
+        // 'out' refers to a buffer of at least 'maxDecodedLength(inputLength)'
+        // bytes that does not overlap 'input', and 'input' is non-null if
+        // '0 < inputLength'.
+};
+
+                           // ======================
+                           // struct Base64Util_Impl
+                           // ======================
+
+struct Base64Util_Impl {
+    // This 'struct' provides access to each implementation underlying
+    // 'Base64Util'.  It is intended for testing and benchmarking only.
+
+    // TYPES
+    enum Kernel {
+        // Enumerates the implementations of the inner encode and decode
+        // loops.
+
+        e_SCALAR,  // portable implementation
+        e_SSSE3,   // x86 SSSE3 implementation
+        e_AVX2     // x86 AVX2 implementation
+    };
+
+    // CLASS METHODS
+    static Kernel bestKernel();
+        // Return the implementation used by 'Base64Util' on this processor.
+
+    static bool isSupported(Kernel kernel);
+        // Return 'true' if the specified 'kernel' is both compiled into this
+        // component and supported by the running processor, and 'false'
+        // otherwise.
+
+    static bsl::size_t encode(Kernel       kernel,
+                              char        *out,
+                              const char  *input,
+                              bsl::size_t  inputLength,
+                              int          maxLineLength);
+        // Encode as per 'Base64Util::encode' using the specified 'kernel'.
+        // The behavior is undefined unless 'isSupported(kernel)' and the
+        // preconditions of 'Base64Util::encode' are met for the specified
+        // 'out', 'input', 'inputLength', and 'maxLineLength'.
+
+    static int decode(Kernel       kernel,
+                      char        *out,
+                      bsl::size_t *numOut,
+                      const char  *input,
+                      bsl::size_t  inputLength,
+                      bool         unrecognizedIsErrorFlag);
+        // Decode as per 'Base64Util::decode' using the specified 'kernel'.
+        // The behavior is undefined unless 'isSupported(kernel)' and the
+        // preconditions of 'Base64Util::decode' are met for the specified
+        // 'out', 'numOut', 'input', 'inputLength', and
+        // 'unrecognizedIsErrorFlag'.
+};
+
+// ============================================================================
+//                            INLINE DEFINITIONS
+// ============================================================================
+
+                              // -----------------
+                              // struct Base64Util
+                              // -----------------
+
+// CLASS METHODS
+inline
+bsl::size_t Base64Util::encodedLength(bsl::size_t inputLength,
+                                      int         maxLineLength)
+{
+    BSLS_ASSERT(0 <= maxLineLength);
+
+    const bsl::size_t length = (inputLength + 2) / 3 * 4;
+    const bsl::size_t max    = static_cast<bsl::size_t>(maxLineLength);
+
+    return 0 == max || length <= max ? length
+                                     : length + 2 * ((length - 1) / max);
+}
+
+inline
+bsl::size_t Base64Util::maxDecodedLength(bsl::size_t inputLength)
+{
+    return (inputLength + 3) / 4 * 3;
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2020 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,996 @@
+// bdlde_base64util.t.cpp                                             -*-C++-*-
+#include <bdlde_base64util.h>
+
+#include <bdlde_base64decoder.h>
+#include <bdlde_base64encoder.h>
+
+#include <bslim_testutil.h>
+
+#include <bslma_default.h>
+#include <bslma_testallocator.h>
+
+#include <bsls_asserttest.h>
+#include <bsls_review.h>
+#include <bsls_timeutil.h>
+#include <bsls_types.h>
+
+#include <bsl_cstdlib.h>
+#include <bsl_cstring.h>
+#include <bsl_iostream.h>
+#include <bsl_iterator.h>
+#include <bsl_string.h>
+#include <bsl_vector.h>
+
+using namespace BloombergLP;
+using namespace bsl;
+
+// ============================================================================
+//                                 TEST PLAN
+// ----------------------------------------------------------------------------
+//                                  Overview
+//                                  --------
+// The component under test provides one-shot Base64 encode and decode
+// functions that are required to behave exactly like the streaming automata
+// 'bdlde::Base64Encoder' and 'bdlde::Base64Decoder', and several
+// implementations (scalar, SSSE3, AVX2) of the inner loops.  We use the
+// streaming automata as oracles, and run every test against every
+// implementation supported by the processor running the test.
+//
+// Performance
+// -----------
+// Test case -1 reports the throughput of each implementation against the
+// streaming automata.  Sample results for 1 MiB of random data, obtained on
+// an x86-64 Linux machine supporting AVX2, built with '-O2' (throughput in
+// MB/s of unencoded data):
+//..
+//  line length |  automaton | scalar |  SSSE3 |  AVX2
+//  ------------+------------+--------+--------+-------
+//  encode    0 |        130 |   1400 |   6100 | 11000
+//  encode   76 |        125 |   1200 |   2800 |  3800
+//  decode    0 |        440 |   1500 |   5500 | 10400
+//  decode   76 |        360 |   1200 |   2000 |  2000
+//..
+// ----------------------------------------------------------------------------
+// CLASS METHODS
+// [ 2] size_t Base64Util::encodedLength(size_t, int);
+// [ 2] size_t Base64Util::maxDecodedLength(size_t);
+// [ 3] size_t Base64Util::encode(char *, const char *, size_t, int);
+// [ 4] int Base64Util::decode(char *, size_t *, const char *, size_t, bool);
+// [ 3] size_t Base64Util_Impl::encode(Kernel, char *, const char *, ...);
+// [ 4] int Base64Util_Impl::decode(Kernel, char *, size_t *, ...);
+// [ 1] Kernel Base64Util_Impl::bestKernel();
+// [ 1] bool Base64Util_Impl::isSupported(Kernel);
+// ----------------------------------------------------------------------------
+// [ 1] BREATHING TEST
+// [ 5] USAGE EXAMPLE
+// [-1] THROUGHPUT BENCHMARK
+// ----------------------------------------------------------------------------
+
+// ============================================================================
+//                     STANDARD BDE ASSERT TEST FUNCTION
+// ----------------------------------------------------------------------------
+
+namespace {
+
+int testStatus = 0;
+
+void aSsErT(bool condition, const char *message, int line)
+{
+    if (condition) {
+        cout << "Error " __FILE__ "(" << line << "): " << message
+             << "    (failed)" << endl;
+
+        if (0 <= testStatus && testStatus <= 100) {
+            ++testStatus;
+        }
+    }
+}
+
+}  // close unnamed namespace
+
+// ============================================================================
+//               STANDARD BDE TEST DRIVER MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT       BSLIM_TESTUTIL_ASSERT
+#define ASSERTV      BSLIM_TESTUTIL_ASSERTV
+
+#define LOOP_ASSERT  BSLIM_TESTUTIL_LOOP_ASSERT
+#define LOOP0_ASSERT BSLIM_TESTUTIL_LOOP0_ASSERT
+#define LOOP1_ASSERT BSLIM_TESTUTIL_LOOP1_ASSERT
+#define LOOP2_ASSERT BSLIM_TESTUTIL_LOOP2_ASSERT
+#define LOOP3_ASSERT BSLIM_TESTUTIL_LOOP3_ASSERT
+#define LOOP4_ASSERT BSLIM_TESTUTIL_LOOP4_ASSERT
+#define LOOP5_ASSERT BSLIM_TESTUTIL_LOOP5_ASSERT
+#define LOOP6_ASSERT BSLIM_TESTUTIL_LOOP6_ASSERT
+
+#define Q            BSLIM_TESTUTIL_Q   // Quote identifier literally.
+#define P            BSLIM_TESTUTIL_P   // Print identifier and value.
+#define P_           BSLIM_TESTUTIL_P_  // P(X) without '\n'.
+#define T_           BSLIM_TESTUTIL_T_  // Print a tab (w/o newline).
+#define L_           BSLIM_TESTUTIL_L_  // current Line number
+
+// ============================================================================
+//                  NEGATIVE-TEST MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT_SAFE_PASS(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_PASS(EXPR)
+#define ASSERT_SAFE_FAIL(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_FAIL(EXPR)
+#define ASSERT_PASS(EXPR)      BSLS_ASSERTTEST_ASSERT_PASS(EXPR)
+#define ASSERT_FAIL(EXPR)      BSLS_ASSERTTEST_ASSERT_FAIL(EXPR)
+
+// ============================================================================
+//                  GLOBAL TYPEDEFS/CONSTANTS FOR TESTING
+// ----------------------------------------------------------------------------
+
+typedef bdlde::Base64Util      Util;
+typedef bdlde::Base64Util_Impl Impl;
+
+const Impl::Kernel KERNELS[] = { Impl::e_SCALAR, Impl::e_SSSE3, Impl::e_AVX2 };
+const int          NUM_KERNELS = sizeof KERNELS / sizeof *KERNELS;
+
+const char *const KERNEL_NAMES[] = { "scalar", "SSSE3", "AVX2" };
+
+const int LINE_LENGTHS[] = { 0, 1, 2, 3, 4, 5, 7, 8, 13, 16, 63, 64, 75, 76,
+                             77, 100 };
+const int NUM_LINE_LENGTHS = sizeof LINE_LENGTHS / sizeof *LINE_LENGTHS;
+
+const char SENTINEL = static_cast<char>(0xa5);
+    // Value used to detect writes past the documented end of output.
+
+const int SENTINEL_LENGTH = 64;
+
+// ============================================================================
+//                  GLOBAL HELPER FUNCTIONS FOR TESTING
+// ----------------------------------------------------------------------------
+
+namespace {
+
+unsigned int nextRandom(unsigned int *state)
+    // Return the next value of a linear congruential generator having the
+    // specified 'state'.
+{
+    *state = *state * 1103515245U + 12345U;
+    return *state >> 8;
+}
+
+void fillRandom(bsl::string *result, bsl::size_t length, unsigned int *state)
+    // Load into the specified 'result' 'length' pseudo-random bytes drawn
+    // from the generator having the specified 'state'.
+{
+    result->resize(length);
+    for (bsl::size_t i = 0; i < length; ++i) {
+        (*result)[i] = static_cast<char>(nextRandom(state));
+    }
+}
+
+bsl::string oracleEncode(const bsl::string& input, int maxLineLength)
+    // Return the encoding of the specified 'input' produced by a
+    // 'bdlde::Base64Encoder' having the specified 'maxLineLength'.
+{
+    bdlde::Base64Encoder encoder(maxLineLength);
+    bsl::string          result;
+
+    encoder.convert(bsl::back_inserter(result), input.begin(), input.end());
+    encoder.endConvert(bsl::back_inserter(result));
+    return result;
+}
+
+bool oracleDecode(bsl::string        *result,
+                  const bsl::string&  input,
+                  bool                unrecognizedIsErrorFlag)
+    // Load into the specified 'result' the decoding of the specified 'input'
+    // produced by a 'bdlde::Base64Decoder' constructed with the specified
+    // 'unrecognizedIsErrorFlag', and return 'true' if the decoder accepts
+    // 'input', and 'false' otherwise.
+{
+    bdlde::Base64Decoder decoder(unrecognizedIsErrorFlag);
+
+    result->clear();
+    if (0 > decoder.convert(bsl::back_inserter(*result),
+                            input.begin(),
+                            input.end())) {
+        return false;                                                 // RETURN
+    }
+    return 0 <= decoder.endConvert(bsl::back_inserter(*result));
+}
+
+bool testEncode(Impl::Kernel       kernel,
+                const bsl::string& input,
+                int                maxLineLength)
+    // Return 'true' if encoding the specified 'input' with the specified
+    // 'kernel' and 'maxLineLength' matches the oracle and writes nothing past
+    // 'encodedLength', and 'false' otherwise.
+{
+    const bsl::string expected = oracleEncode(input, maxLineLength);
+    const bsl::size_t length   = Util::encodedLength(input.size(),
+                                                     maxLineLength);
+
+    if (length != expected.size()) {
+        return false;                                                 // RETURN
+    }
+
+    bsl::vector<char> buffer(length + SENTINEL_LENGTH, SENTINEL);
+
+    const bsl::size_t numOut = Impl::encode(kernel,
+                                            buffer.data(),
+                                            input.data(),
+                                            input.size(),
+                                            maxLineLength);
+
+    if (numOut != length
+     || 0 != bsl::memcmp(buffer.data(), expected.data(), length)) {
+        return false;                                                 // RETURN
+    }
+    for (bsl::size_t i = length; i < buffer.size(); ++i) {
+        if (SENTINEL != buffer[i]) {
+            return false;                                             // RETURN
+        }
+    }
+    return true;
+}
+
+bool testDecode(Impl::Kernel       kernel,
+                const bsl::string& input,
+                bool               unrecognizedIsErrorFlag)
+    // Return 'true' if decoding the specified 'input' with the specified
+    // 'kernel' and 'unrecognizedIsErrorFlag' agrees with the oracle (on both
+    // acceptance and, if accepted, the decoded bytes) and writes nothing past
+    // 'maxDecodedLength', and 'false' otherwise.
+{
+    bsl::string expected;
+    const bool  accepted = oracleDecode(&expected,
+                                        input,
+                                        unrecognizedIsErrorFlag);
+
+    const bsl::size_t length = Util::maxDecodedLength(input.size());
+
+    bsl::vector<char> buffer(length + SENTINEL_LENGTH, SENTINEL);
+
+    bsl::size_t numOut = 0;
+    const int   rc     = Impl::decode(kernel,
+                                      buffer.data(),
+                                      &numOut,
+                                      input.data(),
+                                      input.size(),
+                                      unrecognizedIsErrorFlag);
+
+    if (accepted != (0 == rc)) {
+        return false;                                                 // RETURN
+    }
+    if (accepted && (numOut != expected.size()
+                  || 0 != bsl::memcmp(buffer.data(),
+                                      expected.data(),
+                                      numOut))) {
+        return false;                                                 // RETURN
+    }
+    for (bsl::size_t i = length; i < buffer.size(); ++i) {
+        if (SENTINEL != buffer[i]) {
+            return false;                                             // RETURN
+        }
+    }
+    return true;
+}
+
+double throughput(bsls::Types::Int64 bytes, bsls::Types::Int64 nanoseconds)
+    // Return the throughput, in MB/s, of processing the specified 'bytes' in
+    // the specified 'nanoseconds'.
+{
+    return nanoseconds ? static_cast<double>(bytes) * 1000.0
+                                         / static_cast<double>(nanoseconds)
+                       : 0.0;
+}
+
+}  // close unnamed namespace
+
+// ============================================================================
+//                               MAIN PROGRAM
+// ----------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    int                 test = argc > 1 ? bsl::atoi(argv[1]) : 0;
+    bool             verbose = argc > 2;
+    bool         veryVerbose = argc > 3;
+    bool     veryVeryVerbose = argc > 4;
+    bool veryVeryVeryVerbose = argc > 5;
+
+    (void)veryVeryVerbose;
+
+    cout << "TEST " << __FILE__ << " CASE " << test << endl;
+
+    // CONCERN: 'BSLS_REVIEW' failures should lead to test failures.
+    bsls::ReviewFailureHandlerGuard reviewGuard(&bsls::Review::failByAbort);
+
+    bslma::TestAllocator globalAllocator("global", veryVeryVeryVerbose);
+    bslma::Default::setGlobalAllocator(&globalAllocator);
+
+    switch (test) { case 0:  // Zero is always the leading case.
+      case 5: {
+        // --------------------------------------------------------------------
+        // USAGE EXAMPLE
+        //   Extracted from component header file.
+        //
+        // Concerns:
+        //: 1 The usage example provided in the component header file compiles,
+        //:   links, and runs as shown.
+        //
+        // Plan:
+        //: 1 Incorporate usage example from header into test driver, remove
+        //:   leading comment characters, and replace 'assert' with 'ASSERT'.
+        //:   (C-1)
+        //
+        // Testing:
+        //   USAGE EXAMPLE
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "USAGE EXAMPLE" << endl
+                          << "=============" << endl;
+
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Round-Tripping a Buffer
+/// - - - - - - - - - - - - - - - - -
+// Suppose we need to embed a binary payload in a textual (e.g., MIME) message
+// and later recover it.
+//
+// First, we create the payload:
+//..
+    const char payload[] = "Hello, world!  This payload is Base64 encoded.";
+    const bsl::size_t payloadLength = sizeof payload - 1;
+//..
+// Then, we size an output buffer and encode the payload, using the MIME
+// default line length of 76 characters:
+//..
+    bsl::vector<char> encoded(
+                         bdlde::Base64Util::encodedLength(payloadLength, 76));
+    bsl::size_t numEncoded = bdlde::Base64Util::encode(encoded.data(),
+                                                       payload,
+                                                       payloadLength,
+                                                       76);
+    ASSERT(encoded.size() == numEncoded);
+//..
+// Now, we decode the encoded text back into a buffer large enough to hold
+// the largest possible result:
+//..
+    bsl::vector<char> decoded(
+                            bdlde::Base64Util::maxDecodedLength(numEncoded));
+    bsl::size_t numDecoded;
+    int rc = bdlde::Base64Util::decode(decoded.data(),
+                                       &numDecoded,
+                                       encoded.data(),
+                                       numEncoded);
+    ASSERT(0 == rc);
+//..
+// Finally, we verify that we recovered the original payload:
+//..
+    ASSERT(payloadLength == numDecoded);
+    ASSERT(0 == bsl::memcmp(payload, decoded.data(), numDecoded));
+//..
+      } break;
+      case 4: {
+        // --------------------------------------------------------------------
+        // TESTING 'decode'
+        //
+        // Concerns:
+        //: 1 Every encoding produced by 'Base64Encoder' is decoded to the
+        //:   original bytes, with and without line breaks.
+        //:
+        //: 2 An input is accepted if and only if 'Base64Decoder' accepts it,
+        //:   in both strict and relaxed mode, and the decoded bytes of an
+        //:   accepted input are those produced by 'Base64Decoder'; in
+        //:   particular for padding in every position, non-zero unused bits,
+        //:   data after padding, whitespace, and unrecognized characters
+        //:   (including ones having the high bit set).
+        //:
+        //: 3 Nothing is written beyond 'maxDecodedLength(inputLength)' bytes.
+        //:
+        //: 4 Concerns 1-3 hold for every supported implementation, including
+        //:   when irregular characters fall within, or at the boundary of, a
+        //:   vector-sized block.
+        //:
+        //: 5 'decode' uses the best supported implementation.
+        //
+        // Plan:
+        //: 1 For every supported kernel, decode the oracle encoding of random
+        //:   inputs of every length up to 300 bytes, using several line
+        //:   lengths, in both modes.  (C-1, 3..4)
+        //:
+        //: 2 Using a table of hand-crafted inputs, verify agreement with the
+        //:   oracle.  (C-2..3)
+        //:
+        //: 3 For every supported kernel, insert, replace, or delete
+        //:   characters at random positions of valid encodings of random
+        //:   lengths, and verify agreement with the oracle.  (C-2..4)
+        //:
+        //: 4 Verify that 'decode' agrees with 'Impl::decode' using
+        //:   'bestKernel()'.  (C-5)
+        //
+        // Testing:
+        //   int Base64Util::decode(char *, size_t *, const char *, ...);
+        //   int Base64Util_Impl::decode(Kernel, char *, size_t *, ...);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "TESTING 'decode'" << endl
+                          << "================" << endl;
+
+        if (verbose) cout << "\nRound trip of encoder output." << endl;
+
+        for (int ki = 0; ki < NUM_KERNELS; ++ki) {
+            const Impl::Kernel KERNEL = KERNELS[ki];
+
+            if (!Impl::isSupported(KERNEL)) {
+                continue;
+            }
+            if (veryVerbose) { T_ P(KERNEL_NAMES[ki]) }
+
+            unsigned int seed = 4;
+            for (int li = 0; li < NUM_LINE_LENGTHS; ++li) {
+                const int LINE_LENGTH = LINE_LENGTHS[li];
+
+                for (bsl::size_t len = 0; len <= 300; ++len) {
+                    bsl::string input;
+                    fillRandom(&input, len, &seed);
+
+                    const bsl::string ENCODED = oracleEncode(input,
+                                                             LINE_LENGTH);
+
+                    ASSERTV(KERNEL_NAMES[ki], LINE_LENGTH, len,
+                            testDecode(KERNEL, ENCODED, true));
+                    ASSERTV(KERNEL_NAMES[ki], LINE_LENGTH, len,
+                            testDecode(KERNEL, ENCODED, false));
+                }
+            }
+        }
+
+        if (verbose) cout << "\nHand-crafted inputs." << endl;
+        {
+            static const struct {
+                int         d_line;   // source line number
+                const char *d_input;  // input (null-terminated)
+            } DATA[] = {
+                //LINE  INPUT
+                //----  -----
+                { L_,   ""                                              },
+                { L_,   " "                                             },
+                { L_,   "Zg=="                                          },
+                { L_,   "Zg="                                           },
+                { L_,   "Zg"                                            },
+                { L_,   "Zh=="                                          },
+                { L_,   "Zm8="                                          },
+                { L_,   "Zm9="                                          },
+                { L_,   "Zm8"                                           },
+                { L_,   "Zm9v"                                          },
+                { L_,   "Zm9vYmFy"                                      },
+                { L_,   "Zm9vYmF"                                       },
+                { L_,   "Z"                                             },
+                { L_,   "="                                             },
+                { L_,   "=="                                            },
+                { L_,   "Zm9v="                                         },
+                { L_,   "Z==="                                          },
+                { L_,   "Zg==="                                         },
+                { L_,   "Zm8=="                                         },
+                { L_,   "Zg==Zg=="                                      },
+                { L_,   "Zg== \r\n\t"                                   },
+                { L_,   "Zg= ="                                         },
+                { L_,   "Zg=\r\n="                                      },
+                { L_,   "Zg=!="                                         },
+                { L_,   "Zg==!"                                         },
+                { L_,   "Zm\r\n9v"                                      },
+                { L_,   "Zm-9v"                                         },
+                { L_,   "Zm9v\x80"                                      },
+                { L_,   "\xffZm9v"                                      },
+                { L_,   "Zm9v_"                                         },
+                { L_,   "QUJDREVGR0hJSktMTU5PUFFSU1RVVldYWVphYmNkZWZnaGlq"
+                        "a2xtbm9wcXJzdHV2d3h5ejAxMjM0NTY3ODkrLw=="      },
+                { L_,   "QUJDREVGR0hJSktMTU5PUFFSU1RVVldYWVphYmNkZWZnaGlq"
+                        "a2xtbm9wcXJzdHV2d3h5ejAxMjM0NTY3ODkrLw=\n="    },
+                { L_,   "QUJDREVGR0hJSktMTU5PUFFSU1RVVldYWVphYmNkZWZnaGlq"
+                        "a2xtbm9wcXJzdHV2d3h5ejAx\x01jM0NTY3ODkrLw=="   },
+                { L_,   "QUJDREVGR0hJSktMTU5PUFFSU1RVVldYWVphYmNkZWZnaGlq"
+                        "a2xtbm9wcXJz=HV2d3h5ejAxMjM0NTY3ODkrLw=="      },
+                { L_,   "QUJDREVGR0hJSktMTU5PUFFSU1RVVldYWVphYmNkZWZnaGlq"
+                        "a2xtbm9wcXJzdHV2d3h5ejAxMjM0NTY3ODkrL"         },
+                { L_,   "QUJDREVGR0hJSktMTU5PUFFSU1RVVldYWVphYmNkZWZnaGlq"
+                        "a2xtbm9wcXJzdHV2d3h5ejAxMjM0NTY3ODkr/+/+/+/+"  },
+            };
+            const int NUM_DATA = sizeof DATA / sizeof *DATA;
+
+            for (int ti = 0; ti < NUM_DATA; ++ti) {
+                const int         LINE = DATA[ti].d_line;
+                const bsl::string INPUT(DATA[ti].d_input);
+
+                for (int ki = 0; ki < NUM_KERNELS; ++ki) {
+                    const Impl::Kernel KERNEL = KERNELS[ki];
+
+                    if (!Impl::isSupported(KERNEL)) {
+                        continue;
+                    }
+                    ASSERTV(LINE, KERNEL_NAMES[ki],
+                            testDecode(KERNEL, INPUT, true));
+                    ASSERTV(LINE, KERNEL_NAMES[ki],
+                            testDecode(KERNEL, INPUT, false));
+                }
+            }
+        }
+
+        if (verbose) cout << "\nRandomly damaged encodings." << endl;
+        {
+            static const char NOISE[] = { ' ', '\t', '\n', '\r', '=', '=',
+                                          '-', '_', '@', '.', 'A', '/',
+                                          '+', '\0', '\x7f', '\x80',
+                                          '\xc0', '\xff' };
+            const int NUM_NOISE = sizeof NOISE;
+
+            for (int ki = 0; ki < NUM_KERNELS; ++ki) {
+                const Impl::Kernel KERNEL = KERNELS[ki];
+
+                if (!Impl::isSupported(KERNEL)) {
+                    continue;
+                }
+                if (veryVerbose) { T_ P(KERNEL_NAMES[ki]) }
+
+                unsigned int seed = 7;
+                for (int iteration = 0; iteration < 20000; ++iteration) {
+                    bsl::string input;
+                    fillRandom(&input, nextRandom(&seed) % 200, &seed);
+
+                    const int   LINE_LENGTH =
+                          LINE_LENGTHS[nextRandom(&seed) % NUM_LINE_LENGTHS];
+                    bsl::string encoded = oracleEncode(input, LINE_LENGTH);
+
+                    const int numEdits = 1 + nextRandom(&seed) % 3;
+                    for (int e = 0; e < numEdits; ++e) {
+                        const bsl::size_t pos =
+                                 nextRandom(&seed) % (encoded.size() + 1);
+                        const char        c   =
+                                       NOISE[nextRandom(&seed) % NUM_NOISE];
+
+                        switch (nextRandom(&seed) % 3) {
+                          case 0: {
+                            encoded.insert(pos, 1, c);
+                          } break;
+                          case 1: {
+                            if (pos < encoded.size()) {
+                                encoded[pos] = c;
+                            }
+                          } break;
+                          default: {
+                            if (pos < encoded.size()) {
+                                encoded.erase(pos, 1);
+                            }
+                          } break;
+                        }
+                    }
+
+                    ASSERTV(KERNEL_NAMES[ki], iteration, encoded,
+                            testDecode(KERNEL, encoded, true));
+                    ASSERTV(KERNEL_NAMES[ki], iteration, encoded,
+                            testDecode(KERNEL, encoded, false));
+                }
+            }
+        }
+
+        if (verbose) cout << "\n'decode' uses the best kernel." << endl;
+        {
+            unsigned int seed = 11;
+            bsl::string  input;
+            fillRandom(&input, 1000, &seed);
+
+            const bsl::string ENCODED = oracleEncode(input, 76);
+
+            bsl::vector<char> expected(Util::maxDecodedLength(ENCODED.size()));
+            bsl::vector<char> actual(expected.size());
+            bsl::size_t       numExpected = 0;
+            bsl::size_t       numActual   = 0;
+
+            ASSERT(0 == Impl::decode(Impl::bestKernel(),
+                                     expected.data(),
+                                     &numExpected,
+                                     ENCODED.data(),
+                                     ENCODED.size(),
+                                     true));
+            ASSERT(0 == Util::decode(actual.data(),
+                                     &numActual,
+                                     ENCODED.data(),
+                                     ENCODED.size()));
+            ASSERT(input.size() == numActual);
+            ASSERT(numExpected  == numActual);
+            ASSERT(0 == bsl::memcmp(input.data(), actual.data(), numActual));
+        }
+      } break;
+      case 3: {
+        // --------------------------------------------------------------------
+        // TESTING 'encode'
+        //
+        // Concerns:
+        //: 1 The output is identical to that of 'Base64Encoder' for every
+        //:   input length, including the '=' padding, for line lengths that
+        //:   are 0, smaller than a group, not a multiple of 4, and a multiple
+        //:   of 4.
+        //:
+        //: 2 The returned length is 'encodedLength(inputLength,
+        //:   maxLineLength)' and nothing is written past it.
+        //:
+        //: 3 Every byte value is encoded correctly.
+        //:
+        //: 4 Concerns 1-3 hold for every supported implementation.
+        //:
+        //: 5 'encode' uses the best supported implementation, and
+        //:   'maxLineLength' defaults to 76.
+        //
+        // Plan:
+        //: 1 For every supported kernel and each of a set of line lengths,
+        //:   encode random inputs of every length up to 300 bytes, and some
+        //:   longer inputs, and compare with the oracle; check sentinel bytes
+        //:   following the output.  (C-1..2, 4)
+        //:
+        //: 2 Encode a buffer containing every byte value at every offset
+        //:   modulo 3.  (C-3)
+        //:
+        //: 3 Compare 'encode' with the default line length to 'Impl::encode'
+        //:   using 'bestKernel()' and a line length of 76.  (C-5)
+        //
+        // Testing:
+        //   size_t Base64Util::encode(char *, const char *, size_t, int);
+        //   size_t Base64Util_Impl::encode(Kernel, char *, ...);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "TESTING 'encode'" << endl
+                          << "================" << endl;
+
+        for (int ki = 0; ki < NUM_KERNELS; ++ki) {
+            const Impl::Kernel KERNEL = KERNELS[ki];
+
+            if (!Impl::isSupported(KERNEL)) {
+                continue;
+            }
+            if (veryVerbose) { T_ P(KERNEL_NAMES[ki]) }
+
+            unsigned int seed = 3;
+            for (int li = 0; li < NUM_LINE_LENGTHS; ++li) {
+                const int LINE_LENGTH = LINE_LENGTHS[li];
+
+                for (bsl::size_t len = 0; len <= 300; ++len) {
+                    bsl::string input;
+                    fillRandom(&input, len, &seed);
+
+                    ASSERTV(KERNEL_NAMES[ki], LINE_LENGTH, len,
+                            testEncode(KERNEL, input, LINE_LENGTH));
+                }
+
+                static const bsl::size_t LONG[] = { 1023, 1024, 4095, 65537 };
+                for (int i = 0; i < 4; ++i) {
+                    bsl::string input;
+                    fillRandom(&input, LONG[i], &seed);
+
+                    ASSERTV(KERNEL_NAMES[ki], LINE_LENGTH, LONG[i],
+                            testEncode(KERNEL, input, LINE_LENGTH));
+                }
+            }
+
+            bsl::string allBytes;
+            for (int offset = 0; offset < 3; ++offset) {
+                allBytes.assign(offset, 'x');
+                for (int repeat = 0; repeat < 3; ++repeat) {
+                    for (int c = 0; c < 256; ++c) {
+                        allBytes.push_back(static_cast<char>(c));
+                    }
+                }
+                ASSERTV(KERNEL_NAMES[ki], offset,
+                        testEncode(KERNEL, allBytes, 0));
+                ASSERTV(KERNEL_NAMES[ki], offset,
+                        testEncode(KERNEL, allBytes, 76));
+            }
+        }
+
+        if (verbose) cout << "\n'encode' uses the best kernel." << endl;
+        {
+            unsigned int seed = 5;
+            bsl::string  input;
+            fillRandom(&input, 1000, &seed);
+
+            const bsl::size_t LENGTH = Util::encodedLength(input.size());
+            ASSERT(LENGTH == Util::encodedLength(input.size(), 76));
+
+            bsl::vector<char> expected(LENGTH);
+            bsl::vector<char> actual(LENGTH);
+
+            ASSERT(LENGTH == Impl::encode(Impl::bestKernel(),
+                                          expected.data(),
+                                          input.data(),
+                                          input.size(),
+                                          76));
+            ASSERT(LENGTH == Util::encode(actual.data(),
+                                          input.data(),
+                                          input.size()));
+            ASSERT(expected == actual);
+        }
+      } break;
+      case 2: {
+        // --------------------------------------------------------------------
+        // TESTING 'encodedLength' AND 'maxDecodedLength'
+        //
+        // Concerns:
+        //: 1 'encodedLength' agrees with 'Base64Encoder::encodedLength' for
+        //:   every line length, including 0.
+        //:
+        //: 2 'maxDecodedLength' agrees with 'Base64Decoder::maxDecodedLength'.
+        //:
+        //: 3 'encodedLength' uses a default line length of 76.
+        //:
+        //: 4 QoI: Asserted precondition violations are detected when enabled.
+        //
+        // Plan:
+        //: 1 Compare with the streaming classes over a range of input and
+        //:   line lengths.  (C-1..3)
+        //:
+        //: 2 Verify that a negative line length is detected.  (C-4)
+        //
+        // Testing:
+        //   size_t Base64Util::encodedLength(size_t, int);
+        //   size_t Base64Util::maxDecodedLength(size_t);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                << "TESTING 'encodedLength' AND 'maxDecodedLength'" << endl
+                << "==============================================" << endl;
+
+        for (int len = 0; len < 2000; ++len) {
+            for (int maxLineLength = 0; maxLineLength < 90; ++maxLineLength) {
+                ASSERTV(len, maxLineLength,
+                        static_cast<bsl::size_t>(
+                         bdlde::Base64Encoder::encodedLength(len,
+                                                             maxLineLength)) ==
+                                        Util::encodedLength(len,
+                                                            maxLineLength));
+            }
+            ASSERTV(len, static_cast<bsl::size_t>(
+                              bdlde::Base64Encoder::encodedLength(len, 76)) ==
+                                                    Util::encodedLength(len));
+            ASSERTV(len, static_cast<bsl::size_t>(
+                              bdlde::Base64Decoder::maxDecodedLength(len)) ==
+                                                 Util::maxDecodedLength(len));
+        }
+
+        if (verbose) cout << "\nNegative Testing." << endl;
+        {
+            bsls::AssertTestHandlerGuard hG;
+
+            ASSERT_PASS(Util::encodedLength(10, 0));
+            ASSERT_FAIL(Util::encodedLength(10, -1));
+        }
+      } break;
+      case 1: {
+        // --------------------------------------------------------------------
+        // BREATHING TEST
+        //   This case exercises (but does not fully test) basic
+        //   functionality.
+        //
+        // Concerns:
+        //: 1 The class is sufficiently functional to enable comprehensive
+        //:   testing in subsequent test cases.
+        //
+        // Plan:
+        //: 1 Encode and decode the test vectors of RFC 4648 with every
+        //:   supported kernel.  (C-1)
+        //
+        // Testing:
+        //   BREATHING TEST
+        //   Kernel Base64Util_Impl::bestKernel();
+        //   bool Base64Util_Impl::isSupported(Kernel);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "BREATHING TEST" << endl
+                          << "==============" << endl;
+
+        ASSERT(Impl::isSupported(Impl::e_SCALAR));
+        ASSERT(Impl::isSupported(Impl::bestKernel()));
+
+        if (verbose) { P(KERNEL_NAMES[Impl::bestKernel()]) }
+
+        static const struct {
+            int         d_line;     // source line number
+            const char *d_decoded;  // decoded text
+            const char *d_encoded;  // encoded text
+        } DATA[] = {
+            //LINE  DECODED   ENCODED
+            //----  -------   -------
+            { L_,   "",       ""         },
+            { L_,   "f",      "Zg=="     },
+            { L_,   "fo",     "Zm8="     },
+            { L_,   "foo",    "Zm9v"     },
+            { L_,   "foob",   "Zm9vYg==" },
+            { L_,   "fooba",  "Zm9vYmE=" },
+            { L_,   "foobar", "Zm9vYmFy" },
+        };
+        const int NUM_DATA = sizeof DATA / sizeof *DATA;
+
+        for (int ti = 0; ti < NUM_DATA; ++ti) {
+            const int         LINE    = DATA[ti].d_line;
+            const char *const DECODED = DATA[ti].d_decoded;
+            const char *const ENCODED = DATA[ti].d_encoded;
+            const bsl::size_t DLEN    = bsl::strlen(DECODED);
+            const bsl::size_t ELEN    = bsl::strlen(ENCODED);
+
+            for (int ki = 0; ki < NUM_KERNELS; ++ki) {
+                const Impl::Kernel KERNEL = KERNELS[ki];
+
+                if (!Impl::isSupported(KERNEL)) {
+                    continue;
+                }
+
+                char        buffer[32];
+                bsl::size_t numOut;
+
+                numOut = Impl::encode(KERNEL, buffer, DECODED, DLEN, 76);
+                ASSERTV(LINE, KERNEL_NAMES[ki], ELEN == numOut);
+                ASSERTV(LINE, KERNEL_NAMES[ki],
+                        0 == bsl::memcmp(buffer, ENCODED, ELEN));
+
+                ASSERTV(LINE, KERNEL_NAMES[ki],
+                        0 == Impl::decode(KERNEL,
+                                          buffer,
+                                          &numOut,
+                                          ENCODED,
+                                          ELEN,
+                                          true));
+                ASSERTV(LINE, KERNEL_NAMES[ki], DLEN == numOut);
+                ASSERTV(LINE, KERNEL_NAMES[ki],
+                        0 == bsl::memcmp(buffer, DECODED, DLEN));
+            }
+        }
+      } break;
+      case -1: {
+        // --------------------------------------------------------------------
+        // THROUGHPUT BENCHMARK
+        //
+        // Concerns:
+        //: 1 Report the throughput of every supported implementation, and of
+        //:   the streaming automata, for encoding and decoding, with and
+        //:   without line breaks.
+        //
+        // Plan:
+        //: 1 Encode and decode 1 MiB of random data repeatedly, and report
+        //:   the throughput in MB/s of unencoded data.  (C-1)
+        //
+        // Testing:
+        //   THROUGHPUT BENCHMARK
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "THROUGHPUT BENCHMARK" << endl
+                          << "====================" << endl;
+
+        const bsl::size_t k_SIZE       = 1024 * 1024;
+        const int         k_ITERATIONS = argc > 2 ? bsl::atoi(argv[2]) : 20;
+
+        unsigned int seed = 1;
+        bsl::string  input;
+        fillRandom(&input, k_SIZE, &seed);
+
+        const int LINES[] = { 0, 76 };
+        for (int li = 0; li < 2; ++li) {
+            const int         LINE_LENGTH = LINES[li];
+            const bsl::string ENCODED     = oracleEncode(input, LINE_LENGTH);
+
+            bsl::vector<char> encodeBuffer(ENCODED.size());
+            bsl::vector<char> decodeBuffer(
+                                     Util::maxDecodedLength(ENCODED.size()));
+
+            bsls::Types::Int64 start = bsls::TimeUtil::getTimer();
+            for (int i = 0; i < k_ITERATIONS; ++i) {
+                bdlde::Base64Encoder encoder(LINE_LENGTH);
+                encoder.convert(encodeBuffer.data(),
+                                input.begin(),
+                                input.end());
+                encoder.endConvert(encodeBuffer.data());
+            }
+            bsls::Types::Int64 elapsed = bsls::TimeUtil::getTimer() - start;
+            cout << "encode " << LINE_LENGTH << "\tBase64Encoder\t"
+                 << throughput(k_SIZE * k_ITERATIONS, elapsed) << " MB/s"
+                 << endl;
+
+            for (int ki = 0; ki < NUM_KERNELS; ++ki) {
+                const Impl::Kernel KERNEL = KERNELS[ki];
+
+                if (!Impl::isSupported(KERNEL)) {
+                    continue;
+                }
+                start = bsls::TimeUtil::getTimer();
+                for (int i = 0; i < k_ITERATIONS; ++i) {
+                    Impl::encode(KERNEL,
+                                 encodeBuffer.data(),
+                                 input.data(),
+                                 input.size(),
+                                 LINE_LENGTH);
+                }
+                elapsed = bsls::TimeUtil::getTimer() - start;
+                ASSERT(0 == bsl::memcmp(encodeBuffer.data(),
+                                        ENCODED.data(),
+                                        ENCODED.size()));
+                cout << "encode " << LINE_LENGTH << '\t'
+                     << KERNEL_NAMES[ki] << "\t\t"
+                     << throughput(k_SIZE * k_ITERATIONS, elapsed) << " MB/s"
+                     << endl;
+            }
+
+            start = bsls::TimeUtil::getTimer();
+            for (int i = 0; i < k_ITERATIONS; ++i) {
+                bdlde::Base64Decoder decoder(true);
+                decoder.convert(decodeBuffer.data(),
+                                ENCODED.begin(),
+                                ENCODED.end());
+                decoder.endConvert(decodeBuffer.data());
+            }
+            elapsed = bsls::TimeUtil::getTimer() - start;
+            cout << "decode " << LINE_LENGTH << "\tBase64Decoder\t"
+                 << throughput(k_SIZE * k_ITERATIONS, elapsed) << " MB/s"
+                 << endl;
+
+            for (int ki = 0; ki < NUM_KERNELS; ++ki) {
+                const Impl::Kernel KERNEL = KERNELS[ki];
+
+                if (!Impl::isSupported(KERNEL)) {
+                    continue;
+                }
+                bsl::size_t numOut = 0;
+                start = bsls::TimeUtil::getTimer();
+                for (int i = 0; i < k_ITERATIONS; ++i) {
+                    Impl::decode(KERNEL,
+                                 decodeBuffer.data(),
+                                 &numOut,
+                                 ENCODED.data(),
+                                 ENCODED.size(),
+                                 true);
+                }
+                elapsed = bsls::TimeUtil::getTimer() - start;
+                ASSERT(k_SIZE == numOut);
+                ASSERT(0 == bsl::memcmp(decodeBuffer.data(),
+                                        input.data(),
+                                        k_SIZE));
+                cout << "decode " << LINE_LENGTH << '\t'
+                     << KERNEL_NAMES[ki] << "\t\t"
+                     << throughput(k_SIZE * k_ITERATIONS, elapsed) << " MB/s"
+                     << endl;
+            }
+        }
+      } break;
+      default: {
+        cerr << "WARNING: CASE `" << test << "' NOT FOUND." << endl;
+        testStatus = -1;
+      }
+    }
+
+    // CONCERN: In no case does memory come from the global allocator.
+
+    ASSERTV(globalAllocator.numBlocksTotal(),
+            0 == globalAllocator.numBlocksTotal());
+
+    if (testStatus > 0) {
+        cerr << "Error, non-zero test status = " << testStatus << "." << endl;
+    }
+    return testStatus;
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2020 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -93,10 +93,40 @@ BSLS_IDENT_RCSID(bdlde_crc32_cpp,"$Id$ $CSID$")
 //..
 //  http://ravenphpscripts.com/modules.php?name=Forums&file=viewtopic&t=614
 //..
+//
+// Updates of at least 16 bytes use one of two faster algorithms, selected
+// once at runtime:
+//
+//: o "Slicing-by-8" (Kottmann; see also Kounavis and Berry, "A Systematic
+//:   Approach to Building High Performance Software-based CRC Generators"):
+//:   's_slicingTable[k][i]' holds the CRC of the byte 'i' followed by 'k'
+//:   zero bytes, so that eight table lookups advance the CRC by eight bytes.
+//:
+//: o Folding with carry-less multiplication (Gopal et al., "Fast CRC
+//:   Computation for Generic Polynomials Using PCLMULQDQ Instruction", Intel
+//:   white paper, 2009): four 128-bit accumulators are each "folded" forward
+//:   by 512 bits per 64-byte block, using
+//:   'x = clmul(x.lo, x^(63+D) mod P) ^ clmul(x.hi, x^(D-1) mod P)'
+//:   (in bit-reflected representation, with 'D = 512'), and then combined
+//:   with 128-bit folds ('D = 128').  Instead of the Barrett reduction
+//:   described in the paper, the final 128-bit remainder is reduced by
+//:   running the table-driven algorithm over its 16 bytes, starting from a
+//:   zero register; this costs a few nanoseconds per call and keeps the
+//:   reduction code shared with the portable implementation.
+
+#include <bslmt_once.h>
 
 #include <bsls_assert.h>
+#include <bsls_platform.h>
+#include <bsls_types.h>
+
 #include <bsl_ostream.h>
 
+#if defined(BSLS_PLATFORM_HAS_X86_TARGET_ATTRIBUTE)
+#include <cpuid.h>
+#include <immintrin.h>
+#endif
+
 namespace BloombergLP {
 
 BSLMF_ASSERT(4 == sizeof(unsigned int));
@@ -158,21 +188,44 @@ static const unsigned int CRC_TABLE[256] = {
     0x2d02ef8d
 };
 
-namespace bdlde {
-                                // -----------
-                                // class Crc32
-                                // -----------
+namespace {
 
-// MANIPULATORS
-void Crc32::update(const void *data, bsl::size_t length)
+typedef unsigned int (*UpdateFunction)(unsigned int         crc,
+                                       const unsigned char *data,
+                                       bsl::size_t          length);
+    // Signature of a function returning the CRC register obtained by
+    // processing the specified 'length' bytes at the specified 'data' starting
+    // from the specified 'crc' register.
+
+unsigned int s_slicingTable[8][256];
+    // Lookup tables for the slicing-by-8 algorithm, initialized (once) by
+    // 'selectUpdateFunction'.
+
+bool           s_hardwareSupported = false;
+UpdateFunction s_updateFunction    = 0;
+
+inline
+unsigned int load32(const unsigned char *data)
+    // Return the 32-bit little-endian value stored at the specified 'data'.
 {
-    BSLS_ASSERT(data || !length);
+    return  static_cast<unsigned int>(data[0])
+         | (static_cast<unsigned int>(data[1]) <<  8)
+         | (static_cast<unsigned int>(data[2]) << 16)
+         | (static_cast<unsigned int>(data[3]) << 24);
+}
 
+unsigned int updateBytewise(unsigned int         crc,
+                            const unsigned char *data,
+                            bsl::size_t          length)
+    // Return the CRC register obtained by processing the specified 'length'
+    // bytes at the specified 'data' one at a time, starting from the specified
+    // 'crc' register.
+{
     // The following is a Duff's Device-based implementation of a common
     // algorithm (see end of RFC 1952).
 
-    const unsigned char *d   = (const unsigned char *)data;
-    unsigned int         tmp = d_crc;
+    const unsigned char *d   = data;
+    unsigned int         tmp = crc;
 
     switch (length % 4) {
       case 3: tmp = CRC_TABLE[(tmp ^ *d++) & 0xff] ^ (tmp >> 8);
@@ -193,7 +246,185 @@ void Crc32::update(const void *data, bsl::size_t length)
         --n;
     }
 
-    d_crc = tmp;
+    return tmp;
+}
+
+unsigned int updateSlicingBy8(unsigned int         crc,
+                              const unsigned char *data,
+                              bsl::size_t          length)
+    // Return the CRC register obtained by processing the specified 'length'
+    // bytes at the specified 'data' eight at a time, starting from the
+    // specified 'crc' register.  The behavior is undefined unless
+    // 's_slicingTable' has been initialized.
+{
+    const unsigned int (*t)[256] = s_slicingTable;
+
+    while (length >= 8) {
+        const unsigned int lo = crc ^ load32(data);
+        const unsigned int hi = load32(data + 4);
+
+        crc = t[7][ lo        & 0xff] ^ t[6][(lo >>  8) & 0xff]
+            ^ t[5][(lo >> 16) & 0xff] ^ t[4][ lo >> 24        ]
+            ^ t[3][ hi        & 0xff] ^ t[2][(hi >>  8) & 0xff]
+            ^ t[1][(hi >> 16) & 0xff] ^ t[0][ hi >> 24        ];
+
+        data   += 8;
+        length -= 8;
+    }
+
+    return updateBytewise(crc, data, length);
+}
+
+#if defined(BSLS_PLATFORM_HAS_X86_TARGET_ATTRIBUTE)
+__attribute__((target("sse2,pclmul")))
+inline
+__m128i fold(__m128i accumulator, __m128i constants, __m128i data)
+    // Return the specified 'data' combined with the specified 'accumulator'
+    // folded forward by the distance corresponding to the specified
+    // 'constants'.
+{
+    const __m128i lo = _mm_clmulepi64_si128(accumulator, constants, 0x00);
+    const __m128i hi = _mm_clmulepi64_si128(accumulator, constants, 0x11);
+
+    return _mm_xor_si128(_mm_xor_si128(lo, hi), data);
+}
+
+__attribute__((target("sse2,pclmul")))
+unsigned int updatePclmul(unsigned int         crc,
+                          const unsigned char *data,
+                          bsl::size_t          length)
+    // Return the CRC register obtained by processing the specified 'length'
+    // bytes at the specified 'data' using carry-less multiplication, starting
+    // from the specified 'crc' register.  The behavior is undefined unless
+    // 's_slicingTable' has been initialized and the processor supports the
+    // PCLMULQDQ instruction.
+{
+    if (length < 64) {
+        return updateSlicingBy8(crc, data, length);                   // RETURN
+    }
+
+    // Bit-reflected 'x^(63+D) mod P' (low) and 'x^(D-1) mod P' (high).
+
+    typedef bsls::Types::Int64 Int64;
+
+    const __m128i k512 = _mm_set_epi64x(Int64(0xcad38e8f00000000ULL),
+                                        Int64(0x653d982200000000ULL));
+    const __m128i k128 = _mm_set_epi64x(Int64(0x9ba54c6f00000000ULL),
+                                        Int64(0x65673b4600000000ULL));
+
+    const __m128i *p = reinterpret_cast<const __m128i *>(data);
+
+    __m128i x0 = _mm_xor_si128(_mm_loadu_si128(p),
+                               _mm_cvtsi32_si128(static_cast<int>(crc)));
+    __m128i x1 = _mm_loadu_si128(p + 1);
+    __m128i x2 = _mm_loadu_si128(p + 2);
+    __m128i x3 = _mm_loadu_si128(p + 3);
+
+    p      += 4;
+    length -= 64;
+
+    while (length >= 64) {
+        x0 = fold(x0, k512, _mm_loadu_si128(p));
+        x1 = fold(x1, k512, _mm_loadu_si128(p + 1));
+        x2 = fold(x2, k512, _mm_loadu_si128(p + 2));
+        x3 = fold(x3, k512, _mm_loadu_si128(p + 3));
+
+        p      += 4;
+        length -= 64;
+    }
+
+    x1 = fold(x0, k128, x1);
+    x2 = fold(x1, k128, x2);
+    x3 = fold(x2, k128, x3);
+
+    while (length >= 16) {
+        x3 = fold(x3, k128, _mm_loadu_si128(p));
+
+        ++p;
+        length -= 16;
+    }
+
+    // The CRC of the input so far is the CRC of the 16 bytes of 'x3' computed
+    // from a zero register.
+
+    unsigned char remainder[16];
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(remainder), x3);
+
+    crc = updateSlicingBy8(0, remainder, sizeof remainder);
+
+    return updateSlicingBy8(crc,
+                            reinterpret_cast<const unsigned char *>(p),
+                            length);
+}
+#endif  // BSLS_PLATFORM_HAS_X86_TARGET_ATTRIBUTE
+
+bool detectPclmul()
+    // Return 'true' if 'updatePclmul' is compiled into this component and
+    // supported by the running processor, and 'false' otherwise.
+{
+#if defined(BSLS_PLATFORM_HAS_X86_TARGET_ATTRIBUTE)
+    static const unsigned int k_PCLMULQDQ_BIT = 1u << 1;   // ECX
+    static const unsigned int k_SSE2_BIT      = 1u << 26;  // EDX
+
+    unsigned int eax, ebx, ecx, edx;
+
+    return __get_cpuid(1, &eax, &ebx, &ecx, &edx)
+        && (ecx & k_PCLMULQDQ_BIT)
+        && (edx & k_SSE2_BIT);
+#else
+    return false;
+#endif
+}
+
+UpdateFunction selectUpdateFunction()
+    // Initialize, if not already done, 's_slicingTable' and the function
+    // best suited to the running processor, and return that function.
+{
+    BSLMT_ONCE_DO {
+        for (int i = 0; i < 256; ++i) {
+            s_slicingTable[0][i] = CRC_TABLE[i];
+        }
+        for (int k = 1; k < 8; ++k) {
+            for (int i = 0; i < 256; ++i) {
+                const unsigned int prev = s_slicingTable[k - 1][i];
+
+                s_slicingTable[k][i] = (prev >> 8)
+                                      ^ CRC_TABLE[prev & 0xff];
+            }
+        }
+
+        s_hardwareSupported = detectPclmul();
+#if defined(BSLS_PLATFORM_HAS_X86_TARGET_ATTRIBUTE)
+        s_updateFunction = s_hardwareSupported ? &updatePclmul
+                                               : &updateSlicingBy8;
+#else
+        s_updateFunction = &updateSlicingBy8;
+#endif
+    }
+
+    return s_updateFunction;
+}
+
+}  // close unnamed namespace
+
+namespace bdlde {
+                                // -----------
+                                // class Crc32
+                                // -----------
+
+// MANIPULATORS
+void Crc32::update(const void *data, bsl::size_t length)
+{
+    BSLS_ASSERT(data || !length);
+
+    const unsigned char *d = static_cast<const unsigned char *>(data);
+
+    if (length < 16) {
+        d_crc = updateBytewise(d_crc, d, length);
+    }
+    else {
+        d_crc = selectUpdateFunction()(d_crc, d, length);
+    }
 }
 
 // ACCESSORS
@@ -223,6 +454,62 @@ bsl::ostream& Crc32::print(bsl::ostream& stream) const
     return stream << array;
 }
 
+                             // -----------------
+                             // struct Crc32_Impl
+                             // -----------------
+
+// CLASS METHODS
+unsigned int Crc32_Impl::calculateBytewise(const void   *data,
+                                           bsl::size_t   length,
+                                           unsigned int  crc)
+{
+    BSLS_ASSERT(data || !length);
+
+    return updateBytewise(crc ^ 0xffffffff,
+                          static_cast<const unsigned char *>(data),
+                          length) ^ 0xffffffff;
+}
+
+unsigned int Crc32_Impl::calculateSlicingBy8(const void   *data,
+                                             bsl::size_t   length,
+                                             unsigned int  crc)
+{
+    BSLS_ASSERT(data || !length);
+
+    selectUpdateFunction();
+
+    return updateSlicingBy8(crc ^ 0xffffffff,
+                            static_cast<const unsigned char *>(data),
+                            length) ^ 0xffffffff;
+}
+
+unsigned int Crc32_Impl::calculateHardware(const void   *data,
+                                           bsl::size_t   length,
+                                           unsigned int  crc)
+{
+    BSLS_ASSERT(data || !length);
+
+    const unsigned char *d = static_cast<const unsigned char *>(data);
+
+    selectUpdateFunction();
+
+    UpdateFunction update = &updateSlicingBy8;
+#if defined(BSLS_PLATFORM_HAS_X86_TARGET_ATTRIBUTE)
+    if (s_hardwareSupported) {
+        update = &updatePclmul;
+    }
+#endif
+
+    return update(crc ^ 0xffffffff, d, length) ^ 0xffffffff;
+}
+
+bool Crc32_Impl::isHardwareSupported()
+{
+    selectUpdateFunction();
+
+    return s_hardwareSupported;
+}
+
 }  // close package namespace
 }  // close enterprise namespace
 
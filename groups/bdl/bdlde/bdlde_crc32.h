@@ -16,7 +16,8 @@ BSLS_IDENT("$Id: $")
 //@PURPOSE: Provide a mechanism for computing the CRC-32 checksum of a dataset.
 //
 //@CLASSES:
-//  bdlde::Crc32: stores and updates a CRC-32 checksum
+//  bdlde::Crc32     : stores and updates a CRC-32 checksum
+//  bdlde::Crc32_Impl: access to the individual implementations, for testing
 //
 //@SEE_ALSO:
 //
@@ -29,6 +30,20 @@ BSLS_IDENT("$Id: $")
 // SHA-256, it is relatively easy to find alternate texts with identical
 // checksum.
 //
+///Support for Hardware Acceleration
+///---------------------------------
+// 'update' selects, once per process, the fastest implementation supported by
+// the running processor:
+//: o On x86 processors providing the PCLMULQDQ instruction (when built with
+//:   GCC 4.9 or later, or clang), the input is folded 64 bytes at a time
+//:   using carry-less multiplication, which proceeds at close to memory
+//:   bandwidth on large inputs.
+//: o Otherwise, a portable "slicing-by-8" algorithm consumes 8 bytes per
+//:   step using eight lookup tables.
+// Updates of fewer than 16 bytes use the classic byte-at-a-time algorithm.
+// All implementations produce identical results.  'bdlde::Crc32_Impl' exposes
+// each implementation explicitly for testing and benchmarking.
+//
 ///Usage
 ///-----
 // The following snippets of code illustrate a typical use of the
@@ -243,6 +258,43 @@ bsl::ostream& operator<<(bsl::ostream& stream, const Crc32& checksum);
     // Write to the specified output 'stream' the specified 'checksum' value
     // and return a reference to the modifiable 'stream'.
 
+                             // =================
+                             // struct Crc32_Impl
+                             // =================
+
+struct Crc32_Impl {
+    // This 'struct' provides access to each implementation underlying
+    // 'Crc32::update'.  Each function returns the checksum (as would be
+    // returned by 'Crc32::checksum') of the concatenation of the data that
+    // produced the optionally specified 'crc' checksum (0 corresponding to no
+    // data) and the specified 'length' bytes at the specified 'data'.  The
+    // behavior is undefined unless 'data' is non-null or 0 == 'length'.  This
+    // 'struct' is intended for testing and benchmarking only.
+
+    // CLASS METHODS
+    static unsigned int calculateBytewise(const void   *data,
+                                          bsl::size_t   length,
+                                          unsigned int  crc = 0);
+        // Return the checksum computed one byte at a time.
+
+    static unsigned int calculateSlicingBy8(const void   *data,
+                                            bsl::size_t   length,
+                                            unsigned int  crc = 0);
+        // Return the checksum computed eight bytes at a time using the
+        // portable "slicing-by-8" algorithm.
+
+    static unsigned int calculateHardware(const void   *data,
+                                          bsl::size_t   length,
+                                          unsigned int  crc = 0);
+        // Return the checksum computed using carry-less multiplication if
+        // 'isHardwareSupported()', and using 'calculateSlicingBy8' otherwise.
+
+    static bool isHardwareSupported();
+        // Return 'true' if the carry-less multiplication implementation is
+        // compiled into this component and supported by the running
+        // processor, and 'false' otherwise.
+};
+
 // ============================================================================
 //                        INLINE FUNCTION DEFINITIONS
 // ============================================================================
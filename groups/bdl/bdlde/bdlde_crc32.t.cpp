@@ -96,12 +96,20 @@ using namespace bsl;  // automatically added by script
 // [ 6] bool operator==(const bdlde::Crc32& lhs, const bdlde::Crc32& rhs);
 // [ 6] bool operator!=(const bdlde::Crc32& lhs, const bdlde::Crc32& rhs);
 // [ 5] bsl::ostream& operator<<(bsl::ostream& stream, const bdlde::Crc32&);
+//
+// bdlde::Crc32_Impl
+// [15] unsigned int calculateBytewise(const void *, size_t, unsigned);
+// [15] unsigned int calculateSlicingBy8(const void *, size_t, unsigned);
+// [15] unsigned int calculateHardware(const void *, size_t, unsigned);
+// [15] bool isHardwareSupported();
 //-----------------------------------------------------------------------------
 // [ 1] BREATHING TEST
-// [15] USAGE EXAMPLE
+// [16] USAGE EXAMPLE
 // [ 2] BOOTSTRAP: void update(const void *data, int length);
 // [14] CRC_TABLE TEST
+// [15] ALTERNATIVE IMPLEMENTATIONS
 // [-1] PERFORMANCE TEST
+// [-2] THROUGHPUT OF ALTERNATIVE IMPLEMENTATIONS
 //
 // [ 3] int ggg(bdlde::Crc32 *object, const char *spec, int vF = 1);
 // [ 3] bdlde::Crc32& gg(bdlde::Crc32 *object, const char *spec);
@@ -517,6 +525,170 @@ int main(int argc, char *argv[])
 
     switch (test) { case 0:  // Zero is always the leading case.
       case 15: {
+        // --------------------------------------------------------------------
+        // TESTING ALTERNATIVE IMPLEMENTATIONS
+        //
+        // Concerns:
+        //: 1 'calculateBytewise' computes the standard CRC-32 checksum.
+        //:
+        //: 2 'calculateSlicingBy8' and 'calculateHardware' return the same
+        //:   value as 'calculateBytewise' for every length, in particular
+        //:   around the 8-, 16-, and 64-byte block boundaries.
+        //:
+        //: 3 The result does not depend on the alignment of the data.
+        //:
+        //: 4 Supplying the checksum of a prefix as 'crc' continues the
+        //:   computation, for every implementation and every split point.
+        //:
+        //: 5 'update' (which dispatches to one of the implementations based
+        //:   on the length) agrees with 'calculateBytewise', including when
+        //:   the data is supplied in several pieces.
+        //
+        // Plan:
+        //: 1 Compare the checksum of "123456789" against the published check
+        //:   value.  (C-1)
+        //:
+        //: 2 For every length in '[0 .. 1100]' and every offset in '[0 .. 15]'
+        //:   into a buffer of pseudo-random bytes, compare the result of each
+        //:   implementation, and of 'update', against 'calculateBytewise'.
+        //:   Repeat for a few large lengths.  (C-2..3, 5)
+        //:
+        //: 3 For a selection of lengths, split the data at every point and
+        //:   compute the checksum in two steps with each implementation and
+        //:   with 'update'.  (C-4..5)
+        //
+        // Testing:
+        //   unsigned int calculateBytewise(const void *, size_t, unsigned);
+        //   unsigned int calculateSlicingBy8(const void *, size_t, unsigned);
+        //   unsigned int calculateHardware(const void *, size_t, unsigned);
+        //   bool isHardwareSupported();
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << "\nTESTING ALTERNATIVE IMPLEMENTATIONS"
+                          << "\n===================================" << endl;
+
+        typedef bdlde::Crc32_Impl Impl;
+
+        if (verbose) {
+            P(Impl::isHardwareSupported());
+        }
+
+        if (verbose) cout << "\nCheck value." << endl;
+        {
+            const char DATA[] = "123456789";
+
+            ASSERT(0xcbf43926 == Impl::calculateBytewise(DATA, 9));
+            ASSERT(0xcbf43926 == Impl::calculateSlicingBy8(DATA, 9));
+            ASSERT(0xcbf43926 == Impl::calculateHardware(DATA, 9));
+            ASSERT(0xcbf43926 == Obj(DATA, 9).checksum());
+
+            ASSERT(0 == Impl::calculateBytewise(0, 0));
+            ASSERT(0 == Impl::calculateSlicingBy8(0, 0));
+            ASSERT(0 == Impl::calculateHardware(0, 0));
+        }
+
+        enum { k_MAX_LENGTH = 1100, k_MAX_OFFSET = 16, k_LARGE = 1 << 20 };
+
+        bsl::vector<unsigned char> buffer(k_LARGE + k_MAX_OFFSET);
+        {
+            unsigned int seed = 12345;
+            for (bsl::size_t i = 0; i < buffer.size(); ++i) {
+                seed = seed * 1103515245 + 12345;
+                buffer[i] = static_cast<unsigned char>(seed >> 16);
+            }
+        }
+
+        if (verbose) cout << "\nAll lengths and offsets." << endl;
+
+        for (int offset = 0; offset < k_MAX_OFFSET; ++offset) {
+            for (int length = 0; length <= k_MAX_LENGTH; ++length) {
+                const unsigned char *DATA = &buffer[offset];
+
+                const unsigned int EXP = Impl::calculateBytewise(DATA, length);
+
+                LOOP2_ASSERT(offset, length,
+                             EXP == Impl::calculateSlicingBy8(DATA, length));
+                LOOP2_ASSERT(offset, length,
+                             EXP == Impl::calculateHardware(DATA, length));
+
+                Obj mX;  const Obj& X = mX;
+                mX.update(DATA, length);
+                LOOP2_ASSERT(offset, length, EXP == X.checksum());
+            }
+        }
+
+        if (verbose) cout << "\nLarge lengths." << endl;
+        {
+            static const int LENGTHS[] = {
+                4096, 4096 + 63, 65536 + 17, k_LARGE
+            };
+            const int NUM_LENGTHS = sizeof LENGTHS / sizeof *LENGTHS;
+
+            for (int i = 0; i < NUM_LENGTHS; ++i) {
+                for (int offset = 0; offset < k_MAX_OFFSET; offset += 5) {
+                    const int            LENGTH = LENGTHS[i];
+                    const unsigned char *DATA   = &buffer[offset];
+
+                    const unsigned int EXP = Impl::calculateBytewise(DATA,
+                                                                     LENGTH);
+
+                    LOOP2_ASSERT(LENGTH, offset,
+                               EXP == Impl::calculateSlicingBy8(DATA, LENGTH));
+                    LOOP2_ASSERT(LENGTH, offset,
+                                 EXP == Impl::calculateHardware(DATA, LENGTH));
+                    LOOP2_ASSERT(LENGTH, offset,
+                                 EXP == Obj(DATA, LENGTH).checksum());
+                }
+            }
+        }
+
+        if (verbose) cout << "\nSplit computations." << endl;
+        {
+            static const int LENGTHS[] = {
+                1, 8, 15, 16, 17, 63, 64, 65, 80, 127, 128, 129, 200, 513
+            };
+            const int NUM_LENGTHS = sizeof LENGTHS / sizeof *LENGTHS;
+
+            const unsigned char *DATA = &buffer[3];
+
+            for (int i = 0; i < NUM_LENGTHS; ++i) {
+                const int LENGTH = LENGTHS[i];
+
+                const unsigned int EXP = Impl::calculateBytewise(DATA, LENGTH);
+
+                for (int split = 0; split <= LENGTH; ++split) {
+                    const unsigned char *TAIL   = DATA + split;
+                    const int            REST   = LENGTH - split;
+
+                    unsigned int crc;
+
+                    crc = Impl::calculateBytewise(DATA, split);
+                    LOOP2_ASSERT(LENGTH, split,
+                                 EXP == Impl::calculateBytewise(TAIL,
+                                                                REST,
+                                                                crc));
+
+                    crc = Impl::calculateSlicingBy8(DATA, split);
+                    LOOP2_ASSERT(LENGTH, split,
+                                 EXP == Impl::calculateSlicingBy8(TAIL,
+                                                                  REST,
+                                                                  crc));
+
+                    crc = Impl::calculateHardware(DATA, split);
+                    LOOP2_ASSERT(LENGTH, split,
+                                 EXP == Impl::calculateHardware(TAIL,
+                                                                REST,
+                                                                crc));
+
+                    Obj mX;  const Obj& X = mX;
+                    mX.update(DATA, split);
+                    mX.update(TAIL, REST);
+                    LOOP2_ASSERT(LENGTH, split, EXP == X.checksum());
+                }
+            }
+        }
+      } break;
+      case 16: {
         // --------------------------------------------------------------------
         // TESTING USAGE EXAMPLE
         //   This will test the usage example provided in the component header
@@ -2680,6 +2852,84 @@ int main(int argc, char *argv[])
         }
 
       } break;
+      case -2: {
+        // --------------------------------------------------------------------
+        // THROUGHPUT OF ALTERNATIVE IMPLEMENTATIONS
+        //
+        // Concerns:
+        //: 1 The slicing-by-8 and hardware implementations are substantially
+        //:   faster than the byte-at-a-time implementation on large inputs,
+        //:   and not slower on small ones.
+        //
+        // Plan:
+        //: 1 For a range of buffer sizes, time each implementation and
+        //:   'update' over the same total number of bytes, and report the
+        //:   throughput in MB/s.  (C-1)
+        //
+        // Testing:
+        //   THROUGHPUT OF ALTERNATIVE IMPLEMENTATIONS
+        // --------------------------------------------------------------------
+
+        cout << "\nTHROUGHPUT OF ALTERNATIVE IMPLEMENTATIONS"
+             << "\n=========================================" << endl;
+
+        typedef bdlde::Crc32_Impl Impl;
+
+        P(Impl::isHardwareSupported());
+
+        static const int SIZES[] = { 16, 64, 256, 1024, 16384, 1 << 20 };
+        const int NUM_SIZES = sizeof SIZES / sizeof *SIZES;
+
+        const bsls::Types::Int64 TOTAL = 1 << 28;
+
+        bsl::vector<char> buffer(1 << 20);
+        for (bsl::size_t i = 0; i < buffer.size(); ++i) {
+            buffer[i] = static_cast<char>(i * 7 + (i >> 8));
+        }
+
+        for (int i = 0; i < NUM_SIZES; ++i) {
+            const int                SIZE       = SIZES[i];
+            const bsls::Types::Int64 ITERATIONS = TOTAL / SIZE;
+            const char              *DATA       = buffer.data();
+
+            double times[4];
+            unsigned int crc = 0;
+
+            for (int impl = 0; impl < 4; ++impl) {
+                bsls::Stopwatch timer;
+                timer.start();
+                for (bsls::Types::Int64 j = 0; j < ITERATIONS; ++j) {
+                    switch (impl) {
+                      case 0: {
+                        crc = Impl::calculateBytewise(DATA, SIZE, crc);
+                      } break;
+                      case 1: {
+                        crc = Impl::calculateSlicingBy8(DATA, SIZE, crc);
+                      } break;
+                      case 2: {
+                        crc = Impl::calculateHardware(DATA, SIZE, crc);
+                      } break;
+                      default: {
+                        Obj mX;
+                        mX.update(DATA, SIZE);
+                        crc ^= mX.checksum();
+                      } break;
+                    }
+                }
+                timer.stop();
+                times[impl] = timer.elapsedTime();
+            }
+
+            const double MB = static_cast<double>(TOTAL) / (1024 * 1024);
+
+            cout << "size " << SIZE
+                 << ":\tbytewise "   << MB / times[0]
+                 << "\tslicing-by-8 " << MB / times[1]
+                 << "\thardware "    << MB / times[2]
+                 << "\tupdate "      << MB / times[3]
+                 << " MB/s  (" << crc % 2 << ")" << endl;
+        }
+      } break;
       default: {
         cerr << "WARNING: CASE `" << test << "' NOT FOUND." << endl;
         testStatus = -1;
@@ -6,11 +6,28 @@
 // This implements the CRC-64 defined in ECMA 182 (with reversed polynomial
 // 0xC96C5795D7870F42), in the usual manner:
 //   http://en.wikipedia.org/wiki/Cyclic_redundancy_check
+//
+// Updates of at least 16 bytes use one of two faster algorithms, selected
+// once at runtime: "slicing-by-8", in which 's_slicingTable[k][i]' holds the
+// CRC of the byte 'i' followed by 'k' zero bytes, so that eight table lookups
+// advance the CRC by eight bytes; and, on x86 processors supporting
+// PCLMULQDQ, folding with carry-less multiplication (Gopal et al., "Fast CRC
+// Computation for Generic Polynomials Using PCLMULQDQ Instruction", Intel
+// white paper, 2009).  See the implementation notes in 'bdlde_crc32.cpp',
+// which uses the same scheme; only the folding constants differ.
+
+#include <bslmt_once.h>
 
 #include <bsl_ostream.h>
 #include <bsls_annotation.h>
+#include <bsls_platform.h>
 #include <bsls_types.h>
 
+#if defined(BSLS_PLATFORM_HAS_X86_TARGET_ATTRIBUTE)
+#include <cpuid.h>
+#include <immintrin.h>
+#endif
+
 namespace BloombergLP {
 
 // STATIC DATA
@@ -274,18 +291,48 @@ static const bsls::Types::Uint64 CRC_TABLE[256] = {
     0xe0ada17364673f59ULL
 };
 
-namespace bdlde {
-                                // -----------
-                                // class Crc64
-                                // -----------
+namespace {
 
-// MANIPULATORS
-void Crc64::update(const void *data, bsl::size_t length)
+typedef bsls::Types::Uint64 (*UpdateFunction)(
+                                           bsls::Types::Uint64  crc,
+                                           const unsigned char *data,
+                                           bsl::size_t          length);
+    // Signature of a function returning the CRC register obtained by
+    // processing the specified 'length' bytes at the specified 'data' starting
+    // from the specified 'crc' register.
+
+bsls::Types::Uint64 s_slicingTable[8][256];
+    // Lookup tables for the slicing-by-8 algorithm, initialized (once) by
+    // 'selectUpdateFunction'.
+
+bool           s_hardwareSupported = false;
+UpdateFunction s_updateFunction    = 0;
+
+inline
+bsls::Types::Uint64 load64(const unsigned char *data)
+    // Return the 64-bit little-endian value stored at the specified 'data'.
 {
-    BSLS_ASSERT(data || !length);
+    typedef bsls::Types::Uint64 Uint64;
 
-    const unsigned char *d = (const unsigned char *)data;
-    bsls::Types::Uint64 tmp = d_crc;
+    return  static_cast<Uint64>(data[0])
+         | (static_cast<Uint64>(data[1]) <<  8)
+         | (static_cast<Uint64>(data[2]) << 16)
+         | (static_cast<Uint64>(data[3]) << 24)
+         | (static_cast<Uint64>(data[4]) << 32)
+         | (static_cast<Uint64>(data[5]) << 40)
+         | (static_cast<Uint64>(data[6]) << 48)
+         | (static_cast<Uint64>(data[7]) << 56);
+}
+
+bsls::Types::Uint64 updateBytewise(bsls::Types::Uint64  crc,
+                                   const unsigned char *data,
+                                   bsl::size_t          length)
+    // Return the CRC register obtained by processing the specified 'length'
+    // bytes at the specified 'data' one at a time, starting from the specified
+    // 'crc' register.
+{
+    const unsigned char *d   = data;
+    bsls::Types::Uint64  tmp = crc;
 
     switch (length % 8) {
       case 7:
@@ -325,7 +372,184 @@ void Crc64::update(const void *data, bsl::size_t length)
         --n;
     }
 
-    d_crc = tmp;
+    return tmp;
+}
+
+bsls::Types::Uint64 updateSlicingBy8(bsls::Types::Uint64  crc,
+                                     const unsigned char *data,
+                                     bsl::size_t          length)
+    // Return the CRC register obtained by processing the specified 'length'
+    // bytes at the specified 'data' eight at a time, starting from the
+    // specified 'crc' register.  The behavior is undefined unless
+    // 's_slicingTable' has been initialized.
+{
+    const bsls::Types::Uint64 (*t)[256] = s_slicingTable;
+
+    while (length >= 8) {
+        const bsls::Types::Uint64 x = crc ^ load64(data);
+
+        crc = t[7][ x        & 0xff] ^ t[6][(x >>  8) & 0xff]
+            ^ t[5][(x >> 16) & 0xff] ^ t[4][(x >> 24) & 0xff]
+            ^ t[3][(x >> 32) & 0xff] ^ t[2][(x >> 40) & 0xff]
+            ^ t[1][(x >> 48) & 0xff] ^ t[0][ x >> 56        ];
+
+        data   += 8;
+        length -= 8;
+    }
+
+    return updateBytewise(crc, data, length);
+}
+
+#if defined(BSLS_PLATFORM_HAS_X86_TARGET_ATTRIBUTE)
+__attribute__((target("sse2,pclmul")))
+inline
+__m128i fold(__m128i accumulator, __m128i constants, __m128i data)
+    // Return the specified 'data' combined with the specified 'accumulator'
+    // folded forward by the distance corresponding to the specified
+    // 'constants'.
+{
+    const __m128i lo = _mm_clmulepi64_si128(accumulator, constants, 0x00);
+    const __m128i hi = _mm_clmulepi64_si128(accumulator, constants, 0x11);
+
+    return _mm_xor_si128(_mm_xor_si128(lo, hi), data);
+}
+
+__attribute__((target("sse2,pclmul")))
+bsls::Types::Uint64 updatePclmul(bsls::Types::Uint64  crc,
+                                 const unsigned char *data,
+                                 bsl::size_t          length)
+    // Return the CRC register obtained by processing the specified 'length'
+    // bytes at the specified 'data' using carry-less multiplication, starting
+    // from the specified 'crc' register.  The behavior is undefined unless
+    // 's_slicingTable' has been initialized and the processor supports the
+    // PCLMULQDQ instruction.
+{
+    if (length < 64) {
+        return updateSlicingBy8(crc, data, length);                   // RETURN
+    }
+
+    // Bit-reflected 'x^(63+D) mod P' (low) and 'x^(D-1) mod P' (high).
+
+    typedef bsls::Types::Int64 Int64;
+
+    const __m128i k512 = _mm_set_epi64x(Int64(0x081f6054a7842df4ULL),
+                                        Int64(0x6ae3efbb9dd441f3ULL));
+    const __m128i k128 = _mm_set_epi64x(Int64(0xdabe95afc7875f40ULL),
+                                        Int64(0xe05dd497ca393ae4ULL));
+
+    const __m128i *p = reinterpret_cast<const __m128i *>(data);
+
+    __m128i x0 = _mm_xor_si128(_mm_loadu_si128(p),
+                               _mm_set_epi64x(0, Int64(crc)));
+    __m128i x1 = _mm_loadu_si128(p + 1);
+    __m128i x2 = _mm_loadu_si128(p + 2);
+    __m128i x3 = _mm_loadu_si128(p + 3);
+
+    p      += 4;
+    length -= 64;
+
+    while (length >= 64) {
+        x0 = fold(x0, k512, _mm_loadu_si128(p));
+        x1 = fold(x1, k512, _mm_loadu_si128(p + 1));
+        x2 = fold(x2, k512, _mm_loadu_si128(p + 2));
+        x3 = fold(x3, k512, _mm_loadu_si128(p + 3));
+
+        p      += 4;
+        length -= 64;
+    }
+
+    x1 = fold(x0, k128, x1);
+    x2 = fold(x1, k128, x2);
+    x3 = fold(x2, k128, x3);
+
+    while (length >= 16) {
+        x3 = fold(x3, k128, _mm_loadu_si128(p));
+
+        ++p;
+        length -= 16;
+    }
+
+    // The CRC of the input so far is the CRC of the 16 bytes of 'x3' computed
+    // from a zero register.
+
+    unsigned char remainder[16];
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(remainder), x3);
+
+    crc = updateSlicingBy8(0, remainder, sizeof remainder);
+
+    return updateSlicingBy8(crc,
+                            reinterpret_cast<const unsigned char *>(p),
+                            length);
+}
+#endif  // BSLS_PLATFORM_HAS_X86_TARGET_ATTRIBUTE
+
+bool detectPclmul()
+    // Return 'true' if 'updatePclmul' is compiled into this component and
+    // supported by the running processor, and 'false' otherwise.
+{
+#if defined(BSLS_PLATFORM_HAS_X86_TARGET_ATTRIBUTE)
+    static const unsigned int k_PCLMULQDQ_BIT = 1u << 1;   // ECX
+    static const unsigned int k_SSE2_BIT      = 1u << 26;  // EDX
+
+    unsigned int eax, ebx, ecx, edx;
+
+    return __get_cpuid(1, &eax, &ebx, &ecx, &edx)
+        && (ecx & k_PCLMULQDQ_BIT)
+        && (edx & k_SSE2_BIT);
+#else
+    return false;
+#endif
+}
+
+UpdateFunction selectUpdateFunction()
+    // Initialize, if not already done, 's_slicingTable' and the function
+    // best suited to the running processor, and return that function.
+{
+    BSLMT_ONCE_DO {
+        for (int i = 0; i < 256; ++i) {
+            s_slicingTable[0][i] = CRC_TABLE[i];
+        }
+        for (int k = 1; k < 8; ++k) {
+            for (int i = 0; i < 256; ++i) {
+                const bsls::Types::Uint64 prev = s_slicingTable[k - 1][i];
+
+                s_slicingTable[k][i] = (prev >> 8)
+                                      ^ CRC_TABLE[prev & 0xff];
+            }
+        }
+
+        s_hardwareSupported = detectPclmul();
+#if defined(BSLS_PLATFORM_HAS_X86_TARGET_ATTRIBUTE)
+        s_updateFunction = s_hardwareSupported ? &updatePclmul
+                                               : &updateSlicingBy8;
+#else
+        s_updateFunction = &updateSlicingBy8;
+#endif
+    }
+
+    return s_updateFunction;
+}
+
+}  // close unnamed namespace
+
+namespace bdlde {
+                                // -----------
+                                // class Crc64
+                                // -----------
+
+// MANIPULATORS
+void Crc64::update(const void *data, bsl::size_t length)
+{
+    BSLS_ASSERT(data || !length);
+
+    const unsigned char *d = static_cast<const unsigned char *>(data);
+
+    if (length < 16) {
+        d_crc = updateBytewise(d_crc, d, length);
+    }
+    else {
+        d_crc = selectUpdateFunction()(d_crc, d, length);
+    }
 }
 
 // ACCESSORS
@@ -343,6 +567,65 @@ bsl::ostream& Crc64::print(bsl::ostream& stream) const
     return stream << out;
 }
 
+                             // -----------------
+                             // struct Crc64_Impl
+                             // -----------------
+
+// CLASS METHODS
+bsls::Types::Uint64 Crc64_Impl::calculateBytewise(
+                                             const void          *data,
+                                             bsl::size_t          length,
+                                             bsls::Types::Uint64  crc)
+{
+    BSLS_ASSERT(data || !length);
+
+    return ~updateBytewise(~crc,
+                           static_cast<const unsigned char *>(data),
+                           length);
+}
+
+bsls::Types::Uint64 Crc64_Impl::calculateSlicingBy8(
+                                             const void          *data,
+                                             bsl::size_t          length,
+                                             bsls::Types::Uint64  crc)
+{
+    BSLS_ASSERT(data || !length);
+
+    selectUpdateFunction();
+
+    return ~updateSlicingBy8(~crc,
+                             static_cast<const unsigned char *>(data),
+                             length);
+}
+
+bsls::Types::Uint64 Crc64_Impl::calculateHardware(
+                                             const void          *data,
+                                             bsl::size_t          length,
+                                             bsls::Types::Uint64  crc)
+{
+    BSLS_ASSERT(data || !length);
+
+    const unsigned char *d = static_cast<const unsigned char *>(data);
+
+    selectUpdateFunction();
+
+    UpdateFunction update = &updateSlicingBy8;
+#if defined(BSLS_PLATFORM_HAS_X86_TARGET_ATTRIBUTE)
+    if (s_hardwareSupported) {
+        update = &updatePclmul;
+    }
+#endif
+
+    return ~update(~crc, d, length);
+}
+
+bool Crc64_Impl::isHardwareSupported()
+{
+    selectUpdateFunction();
+
+    return s_hardwareSupported;
+}
+
 }  // close package namespace
 }  // close enterprise namespace
 
@@ -8,7 +8,8 @@ BSLS_IDENT("$Id: $")
 //@PURPOSE: Provide a mechanism for computing the CRC-64 checksum of a dataset.
 //
 //@CLASSES:
-//  bdlde::Crc64: stores and updates a CRC-64 checksum
+//  bdlde::Crc64     : stores and updates a CRC-64 checksum
+//  bdlde::Crc64_Impl: access to the individual implementations, for testing
 //
 //@SEE_ALSO:
 //
@@ -21,6 +22,20 @@ BSLS_IDENT("$Id: $")
 // SHA-256, it is relatively easy to find alternate texts with identical
 // checksum.
 //
+///Support for Hardware Acceleration
+///---------------------------------
+// 'update' selects, once per process, the fastest implementation supported by
+// the running processor:
+//: o On x86 processors providing the PCLMULQDQ instruction (when built with
+//:   GCC 4.9 or later, or clang), the input is folded 64 bytes at a time
+//:   using carry-less multiplication, which proceeds at close to memory
+//:   bandwidth on large inputs.
+//: o Otherwise, a portable "slicing-by-8" algorithm consumes 8 bytes per
+//:   step using eight lookup tables.
+// Updates of fewer than 16 bytes use the classic byte-at-a-time algorithm.
+// All implementations produce identical results.  'bdlde::Crc64_Impl' exposes
+// each implementation explicitly for testing and benchmarking.
+//
 ///Usage
 ///-----
 // The following snippets of code illustrate a typical use of the
@@ -220,6 +235,46 @@ bsl::ostream& operator<<(bsl::ostream& stream, const Crc64& checksum);
     // Write to the specified output 'stream' the specified 'checksum' value
     // and return a reference to the modifiable 'stream'.
 
+                             // =================
+                             // struct Crc64_Impl
+                             // =================
+
+struct Crc64_Impl {
+    // This 'struct' provides access to each implementation underlying
+    // 'Crc64::update'.  Each function returns the checksum (as would be
+    // returned by 'Crc64::checksum') of the concatenation of the data that
+    // produced the optionally specified 'crc' checksum (0 corresponding to no
+    // data) and the specified 'length' bytes at the specified 'data'.  The
+    // behavior is undefined unless 'data' is non-null or 0 == 'length'.  This
+    // 'struct' is intended for testing and benchmarking only.
+
+    // CLASS METHODS
+    static bsls::Types::Uint64 calculateBytewise(
+                            const void          *data,
+                            bsl::size_t          length,
+                            bsls::Types::Uint64  crc = 0);
+        // Return the checksum computed one byte at a time.
+
+    static bsls::Types::Uint64 calculateSlicingBy8(
+                            const void          *data,
+                            bsl::size_t          length,
+                            bsls::Types::Uint64  crc = 0);
+        // Return the checksum computed eight bytes at a time using the
+        // portable "slicing-by-8" algorithm.
+
+    static bsls::Types::Uint64 calculateHardware(
+                            const void          *data,
+                            bsl::size_t          length,
+                            bsls::Types::Uint64  crc = 0);
+        // Return the checksum computed using carry-less multiplication if
+        // 'isHardwareSupported()', and using 'calculateSlicingBy8' otherwise.
+
+    static bool isHardwareSupported();
+        // Return 'true' if the carry-less multiplication implementation is
+        // compiled into this component and supported by the running
+        // processor, and 'false' otherwise.
+};
+
 // ============================================================================
 //                        INLINE DEFINITIONS
 // ============================================================================
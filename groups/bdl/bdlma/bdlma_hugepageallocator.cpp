@@ -0,0 +1,582 @@
+// bdlma_hugepageallocator.cpp                                        -*-C++-*-
+#include <bdlma_hugepageallocator.h>
+
+#include <bsls_ident.h>
+BSLS_IDENT_RCSID(bdlma_hugepageallocator_cpp,"$Id$ $CSID$")
+
+#include <bslmt_lockguard.h>
+
+#include <bsls_alignmentutil.h>
+#include <bsls_assert.h>
+#include <bsls_exceptionutil.h>      // 'BSLS_THROW'
+#include <bsls_performancehint.h>
+#include <bsls_platform.h>
+
+#include <bsl_cstddef.h>             // 'bsl::size_t'
+#include <bsl_new.h>                 // 'bsl::bad_alloc'
+
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+
+#include <windows.h>        // 'VirtualAlloc', 'VirtualFree'
+
+#else
+
+#include <sys/mman.h>       // 'mmap', 'madvise', 'munmap'
+#include <unistd.h>         // 'sysconf'
+
+#ifdef BSLS_PLATFORM_OS_LINUX
+#include <sys/syscall.h>    // 'SYS_mbind'
+#endif
+
+#endif
+
+///IMPLEMENTATION NOTES
+///--------------------
+// Every region mapped by this allocator (chunk or dedicated region) starts
+// on a 'k_CHUNK_SIZE' boundary with a 'Chunk' header, and every block
+// dispensed from a region lies within the first 'k_CHUNK_SIZE' bytes of the
+// region, so that the header of the region holding a block is found by
+// rounding the address of the block down to a multiple of 'k_CHUNK_SIZE'.
+//
+// Regions are mapped with an extra 'k_CHUNK_SIZE' bytes, and the unaligned
+// head and tail of the mapping are unmapped, except for explicit huge pages,
+// which the system aligns on a huge page boundary.  On Windows, where part of
+// a mapping cannot be released, the aligned region is reserved at the address
+// found by a first (released) reservation, which is retried if another thread
+// reserved the address in the meantime.
+
+namespace BloombergLP {
+namespace {
+
+typedef bsls::Types::size_type size_type;
+
+const size_type k_CHUNK_SIZE = bdlma::HugePageAllocator::k_CHUNK_SIZE;
+
+const size_type k_MAX_CARVED_SIZE = k_CHUNK_SIZE / 4;
+    // largest (padded) block size carved from a chunk
+
+#if defined(BSLS_PLATFORM_OS_LINUX)
+const int k_MPOL_PREFERRED = 1;  // 'MPOL_PREFERRED' in '<linux/mempolicy.h>'
+#endif
+
+// HELPER FUNCTIONS
+
+size_type getSystemPageSize()
+    // Return the size (in bytes) of a system memory page.
+{
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return info.dwPageSize;
+
+#else
+
+    return static_cast<size_type>(sysconf(_SC_PAGESIZE));
+
+#endif
+}
+
+char *alignUp(char *address)
+    // Return the least address not less than the specified 'address' that is
+    // a multiple of 'k_CHUNK_SIZE'.
+{
+    const bsls::Types::UintPtr value =
+                               reinterpret_cast<bsls::Types::UintPtr>(address);
+
+    return reinterpret_cast<char *>((value + k_CHUNK_SIZE - 1)
+                                                        & ~(k_CHUNK_SIZE - 1));
+}
+
+void *systemMapExplicit(size_type size)
+    // Map a region of the specified 'size' (in bytes) backed by explicitly
+    // reserved huge pages, and return its address, or return 0 if the
+    // platform does not support such pages or none is available.
+{
+#if defined(BSLS_PLATFORM_OS_LINUX) && defined(MAP_HUGETLB)
+
+    void *address = mmap(0,
+                         size,
+                         PROT_READ | PROT_WRITE,
+                         MAP_ANONYMOUS | MAP_PRIVATE | MAP_HUGETLB,
+                         -1,
+                         0);
+
+    return MAP_FAILED == address ? 0 : address;
+
+#else
+
+    (void)size;
+    return 0;
+
+#endif
+}
+
+void *systemMapAligned(size_type size)
+    // Map a region of the specified 'size' (in bytes) aligned on a
+    // 'k_CHUNK_SIZE' boundary, and return its address, or return 0 if the
+    // region cannot be mapped.
+{
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+
+    for (int attempt = 0; attempt < 8; ++attempt) {
+        char *reservation = static_cast<char *>(VirtualAlloc(
+                                                          0,
+                                                          size + k_CHUNK_SIZE,
+                                                          MEM_RESERVE,
+                                                          PAGE_NOACCESS));
+        if (!reservation) {
+            return 0;                                                 // RETURN
+        }
+        VirtualFree(reservation, 0, MEM_RELEASE);
+
+        void *address = VirtualAlloc(alignUp(reservation),
+                                     size,
+                                     MEM_RESERVE | MEM_COMMIT,
+                                     PAGE_READWRITE);
+        if (address) {
+            return address;                                           // RETURN
+        }
+    }
+    return 0;
+
+#else
+
+    char *mapping = static_cast<char *>(mmap(0,
+                                             size + k_CHUNK_SIZE,
+                                             PROT_READ | PROT_WRITE,
+                                             MAP_ANON | MAP_PRIVATE,
+                                             -1,
+                                             0));
+    if (MAP_FAILED == static_cast<void *>(mapping)) {
+        return 0;                                                     // RETURN
+    }
+
+    char            *address  = alignUp(mapping);
+    const size_type  headSize = address - mapping;
+
+    if (headSize) {
+        munmap(mapping, headSize);
+    }
+    munmap(address + size, k_CHUNK_SIZE - headSize);
+
+    return address;
+
+#endif
+}
+
+void systemAdviseHugePages(void *address, size_type size, bool useHugePages)
+    // Advise the system to back the region at the specified 'address' having
+    // the specified 'size' (in bytes) with transparent huge pages if the
+    // specified 'useHugePages' is 'true', and with pages of the default size
+    // otherwise, if supported by the platform.
+{
+#if defined(BSLS_PLATFORM_OS_LINUX) && defined(MADV_HUGEPAGE)
+
+    madvise(address, size, useHugePages ? MADV_HUGEPAGE : MADV_NOHUGEPAGE);
+
+#else
+
+    (void)address;
+    (void)size;
+    (void)useHugePages;
+
+#endif
+}
+
+void systemPreferNode(void *address, size_type size, int node)
+    // Set the placement policy of the region at the specified 'address'
+    // having the specified 'size' (in bytes) to prefer the specified NUMA
+    // 'node', if supported by the platform.
+{
+#if defined(BSLS_PLATFORM_OS_LINUX) && defined(SYS_mbind)
+
+    enum { k_MAX_NODES = 8 * sizeof(unsigned long) };
+
+    if (node >= k_MAX_NODES) {
+        return;                                                       // RETURN
+    }
+
+    unsigned long nodeMask = 1UL << node;
+
+    // The kernel reads 'maxnode - 1' bits of the mask.
+
+    syscall(SYS_mbind,
+            address,
+            size,
+            k_MPOL_PREFERRED,
+            &nodeMask,
+            k_MAX_NODES + 1,
+            0);
+
+#else
+
+    (void)address;
+    (void)size;
+    (void)node;
+
+#endif
+}
+
+void systemUnmap(void *address, size_type size)
+    // Return the region at the specified 'address' having the specified
+    // 'size' (in bytes) to the system.
+{
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+
+    VirtualFree(address, 0, MEM_RELEASE);
+    (void)size;
+
+#else
+
+    munmap(static_cast<char *>(address), size);
+
+#endif
+}
+
+}  // close unnamed namespace
+
+namespace bdlma {
+
+                      // -------------------------------
+                      // struct HugePageAllocator::Chunk
+                      // -------------------------------
+
+struct HugePageAllocator::Chunk {
+    // This 'struct' provides the header of a region mapped by a
+    // 'HugePageAllocator'.
+
+    // CLASS DATA
+    static const size_type k_HEADER_SIZE;  // offset of the first block of a
+                                           // region
+
+    // DATA
+    Chunk     *d_prev_p;       // previous region
+    Chunk     *d_next_p;       // next region
+    size_type  d_size;         // size of the region
+    int        d_numBlocks;    // number of blocks in use
+    bool       d_isDedicated;  // 'true' if the region holds a single block
+};
+
+const size_type HugePageAllocator::Chunk::k_HEADER_SIZE =
+                 bsls::AlignmentUtil::roundUpToMaximalAlignment(sizeof(Chunk));
+
+                         // -----------------------
+                         // class HugePageAllocator
+                         // -----------------------
+
+// PRIVATE MANIPULATORS
+void *HugePageAllocator::carveBlock(size_type paddedSize)
+{
+    BSLS_ASSERT(d_current_p);
+    BSLS_ASSERT(d_cursor + paddedSize <= k_CHUNK_SIZE);
+
+    char *block = reinterpret_cast<char *>(d_current_p) + d_cursor;
+
+    d_cursor += paddedSize;
+    ++d_current_p->d_numBlocks;
+
+    return block;
+}
+
+HugePageAllocator::Chunk *HugePageAllocator::linkChunk(void      *address,
+                                                       size_type  size,
+                                                       bool       isDedicated,
+                                                       bool       isFallback)
+{
+    Chunk *chunk = static_cast<Chunk *>(address);
+
+    chunk->d_prev_p      = 0;
+    chunk->d_next_p      = d_chunks_p;
+    chunk->d_size        = size;
+    chunk->d_numBlocks   = 0;
+    chunk->d_isDedicated = isDedicated;
+
+    if (d_chunks_p) {
+        d_chunks_p->d_prev_p = chunk;
+    }
+    d_chunks_p = chunk;
+
+    d_numBytesMapped += size;
+    ++d_numChunks;
+
+    if (isFallback) {
+        ++d_numFallbackChunks;
+    }
+
+    return chunk;
+}
+
+void HugePageAllocator::unlinkChunk(Chunk *chunk)
+{
+    if (chunk->d_prev_p) {
+        chunk->d_prev_p->d_next_p = chunk->d_next_p;
+    }
+    else {
+        d_chunks_p = chunk->d_next_p;
+    }
+    if (chunk->d_next_p) {
+        chunk->d_next_p->d_prev_p = chunk->d_prev_p;
+    }
+
+    d_numBytesMapped -= chunk->d_size;
+    --d_numChunks;
+}
+
+// PRIVATE ACCESSORS
+void *HugePageAllocator::mapRegion(size_type  size,
+                                   bool       isDedicated,
+                                   bool      *isFallback) const
+{
+    BSLS_ASSERT(0 == size % k_CHUNK_SIZE);
+    BSLS_ASSERT(isFallback);
+
+    void *address = 0;
+
+    *isFallback = false;
+
+    if (e_EXPLICIT == d_mode) {
+        address     = systemMapExplicit(size);
+        *isFallback = !address;
+    }
+
+    if (!address) {
+        address = systemMapAligned(size);
+        if (!address) {
+            return 0;                                                 // RETURN
+        }
+        systemAdviseHugePages(address, size, e_NONE != d_mode);
+    }
+
+    if (k_LOCAL_NODE != d_numaNode) {
+        systemPreferNode(address, size, d_numaNode);
+    }
+    else if (!isDedicated) {
+        // Touch every page of the chunk, so that the pages are placed on the
+        // node of the calling thread (and faulted in) now.
+
+        const size_type pageSize = getSystemPageSize();
+
+        volatile char *bytes = static_cast<char *>(address);
+        for (size_type offset = 0; offset < size; offset += pageSize) {
+            bytes[offset] = 0;
+        }
+    }
+
+    return address;
+}
+
+// CREATORS
+HugePageAllocator::HugePageAllocator(HugePageMode mode)
+: d_mode(mode)
+, d_numaNode(k_LOCAL_NODE)
+, d_chunks_p(0)
+, d_current_p(0)
+, d_cursor(0)
+, d_numBytesMapped(0)
+, d_numChunks(0)
+, d_numFallbackChunks(0)
+{
+}
+
+HugePageAllocator::HugePageAllocator(HugePageMode mode, int numaNode)
+: d_mode(mode)
+, d_numaNode(numaNode)
+, d_chunks_p(0)
+, d_current_p(0)
+, d_cursor(0)
+, d_numBytesMapped(0)
+, d_numChunks(0)
+, d_numFallbackChunks(0)
+{
+    BSLS_ASSERT(k_LOCAL_NODE <= numaNode);
+}
+
+HugePageAllocator::~HugePageAllocator()
+{
+    release();
+}
+
+// MANIPULATORS
+void *HugePageAllocator::allocate(bsls::Types::size_type size)
+{
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(0 == size)) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+        return 0;                                                     // RETURN
+    }
+
+    const size_type paddedSize =
+                          bsls::AlignmentUtil::roundUpToMaximalAlignment(size);
+
+    bool isFallback;
+
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(
+                                           paddedSize > k_MAX_CARVED_SIZE)) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+
+        const size_type regionSize =
+                         (Chunk::k_HEADER_SIZE + paddedSize + k_CHUNK_SIZE - 1)
+                                                         & ~(k_CHUNK_SIZE - 1);
+
+        void *address = mapRegion(regionSize, true, &isFallback);
+        if (!address) {
+#ifdef BDE_BUILD_TARGET_EXC
+            BSLS_THROW(bsl::bad_alloc());
+#else
+            return 0;                                                 // RETURN
+#endif
+        }
+
+        bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+
+        Chunk *chunk = linkChunk(address, regionSize, true, isFallback);
+        chunk->d_numBlocks = 1;
+        return reinterpret_cast<char *>(chunk)
+             + Chunk::k_HEADER_SIZE;                                  // RETURN
+    }
+
+    {
+        bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+
+        if (BSLS_PERFORMANCEHINT_PREDICT_LIKELY(
+                     d_current_p && d_cursor + paddedSize <= k_CHUNK_SIZE)) {
+            return carveBlock(paddedSize);                            // RETURN
+        }
+    }
+
+    // Map a new chunk (prefaulting it, see 'mapRegion') without holding the
+    // lock.  Note that the current chunk is not empty here, as an empty
+    // current chunk is reused from its beginning (see 'deallocate').
+
+    void *address = mapRegion(k_CHUNK_SIZE, false, &isFallback);
+    if (!address) {
+#ifdef BDE_BUILD_TARGET_EXC
+        BSLS_THROW(bsl::bad_alloc());
+#else
+        return 0;                                                     // RETURN
+#endif
+    }
+
+    Chunk *emptyChunk = 0;
+    void  *block;
+    {
+        bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+
+        // The current chunk may have been emptied, or replaced by another
+        // thread, while the lock was released.  The new chunk becomes the
+        // current chunk regardless; an empty current chunk is returned to the
+        // system.
+
+        if (d_current_p && 0 == d_current_p->d_numBlocks) {
+            emptyChunk = d_current_p;
+            unlinkChunk(emptyChunk);
+        }
+
+        d_current_p = linkChunk(address, k_CHUNK_SIZE, false, isFallback);
+        d_cursor    = Chunk::k_HEADER_SIZE;
+
+        block = carveBlock(paddedSize);
+    }
+
+    if (emptyChunk) {
+        systemUnmap(emptyChunk, emptyChunk->d_size);
+    }
+
+    return block;
+}
+
+void HugePageAllocator::deallocate(void *address)
+{
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(0 == address)) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+        return;                                                       // RETURN
+    }
+
+    Chunk *chunk = reinterpret_cast<Chunk *>(
+                           reinterpret_cast<bsls::Types::UintPtr>(address)
+                                                        & ~(k_CHUNK_SIZE - 1));
+
+    {
+        bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+
+        BSLS_ASSERT(0 < chunk->d_numBlocks);
+
+        if (0 != --chunk->d_numBlocks) {
+            return;                                                   // RETURN
+        }
+
+        if (chunk == d_current_p) {
+            // Reuse the current chunk from its beginning.
+
+            d_cursor = Chunk::k_HEADER_SIZE;
+            return;                                                   // RETURN
+        }
+
+        unlinkChunk(chunk);
+    }
+
+    systemUnmap(chunk, chunk->d_size);
+}
+
+void HugePageAllocator::release()
+{
+    Chunk *chunks;
+    {
+        bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+
+        chunks = d_chunks_p;
+
+        d_chunks_p       = 0;
+        d_current_p      = 0;
+        d_cursor         = 0;
+        d_numBytesMapped = 0;
+        d_numChunks      = 0;
+    }
+
+    while (chunks) {
+        Chunk *next = chunks->d_next_p;
+        systemUnmap(chunks, chunks->d_size);
+        chunks = next;
+    }
+}
+
+// ACCESSORS
+bsls::Types::size_type HugePageAllocator::numBytesMapped() const
+{
+    bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+
+    return d_numBytesMapped;
+}
+
+int HugePageAllocator::numChunks() const
+{
+    bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+
+    return d_numChunks;
+}
+
+int HugePageAllocator::numFallbackChunks() const
+{
+    bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+
+    return d_numFallbackChunks;
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+// ----------------------------------------------------------------------------
+// Copyright 2020 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
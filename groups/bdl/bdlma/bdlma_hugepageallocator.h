@@ -0,0 +1,384 @@
+// bdlma_hugepageallocator.h                                          -*-C++-*-
+#ifndef INCLUDED_BDLMA_HUGEPAGEALLOCATOR
+#define INCLUDED_BDLMA_HUGEPAGEALLOCATOR
+
+#include <bsls_ident.h>
+BSLS_IDENT("$Id: $")
+
+//@PURPOSE: Provide an allocator supplying huge-page-backed, node-local memory.
+//
+//@CLASSES:
+//  bdlma::HugePageAllocator: allocator of memory backed by huge pages
+//
+//@SEE_ALSO: bdlma_guardingallocator, bdlma_multipool,
+//           bdlma_bufferedsequentialallocator
+//
+//@DESCRIPTION: This component provides a concrete allocation mechanism,
+// 'bdlma::HugePageAllocator', that implements the 'bdlma::ManagedAllocator'
+// protocol and supplies memory carved from 2MB chunks obtained directly from
+// the operating system, backed by huge pages and placed on a chosen (or the
+// local) NUMA node:
+//..
+//   ,------------------------.
+//  ( bdlma::HugePageAllocator )
+//   `------------------------'
+//               |         ctor/dtor
+//               |         hugePageMode
+//               |         numaNode
+//               |         numBytesMapped
+//               |         numChunks
+//               |         numFallbackChunks
+//               V
+//    ,-----------------------.
+//   ( bdlma::ManagedAllocator )
+//    `-----------------------'
+//               |         release
+//               V
+//      ,----------------.
+//     ( bslma::Allocator )
+//      `----------------'
+//                         allocate
+//                         deallocate
+//..
+// A 'bdlma::HugePageAllocator' is intended to be supplied as the upstream
+// allocator of the pools and arenas of this package (e.g.,
+// 'bdlma::Multipool', 'bdlma::BufferedSequentialAllocator',
+// 'bdlma::SequentialAllocator'), which allocate comparatively large blocks
+// and return them together, so that the memory they dispense is covered by
+// few TLB entries and is local to the node of the threads using it.  It is
+// not intended to be used as a general-purpose allocator of small objects.
+//
+// Note that, like 'bdlma::GuardingAllocator', and unlike most other BDE
+// allocators, a 'bslma::Allocator *' cannot be supplied upon construction of a
+// 'HugePageAllocator'; instead, memory is obtained from the system facilities
+// mapping virtual memory (e.g., 'mmap').
+//
+///Chunks
+///------
+// A request for a block no larger than a quarter of a chunk is carved
+// sequentially from the current chunk, and a request for a larger block is
+// served by a dedicated region whose size is the least multiple of the chunk
+// size ('k_CHUNK_SIZE', 2MB) that holds the block.  Each chunk counts the
+// blocks allocated from it that have not been deallocated: when the count of
+// a chunk other than the current chunk drops to 0, the chunk is returned to
+// the system, and when the count of the current chunk drops to 0, the chunk
+// is reused from its beginning.  All chunks are returned to the system by
+// 'release' and by the destructor.
+//
+// If no NUMA node is supplied at construction (see {NUMA Placement}), every
+// page of a chunk is touched by the allocating thread, without holding the
+// lock of the allocator, before the first block is carved from it, so that
+// the pages are placed on the node of that thread, and so that the page
+// faults are not incurred later, on the critical path of the pools using the
+// memory.  Note that each such chunk therefore adds 'k_CHUNK_SIZE' bytes to
+// the resident set size of the process as soon as it is mapped, however
+// little of it is used.  The pages of a dedicated region, and of the chunks
+// of an allocator supplied with a NUMA node, are not touched by the
+// allocator: they are faulted in (and become resident) as they are first
+// used.
+//
+///Huge Page Modes
+///---------------
+// The 'HugePageMode' supplied at construction determines how a chunk is
+// backed by huge pages:
+//
+//: 'e_TRANSPARENT':
+//:   The chunk is aligned on a huge page boundary and the system is advised to
+//:   back it with transparent huge pages (e.g., 'madvise(MADV_HUGEPAGE)' on
+//:   Linux).  This is the default mode.
+//:
+//: 'e_EXPLICIT':
+//:   The chunk is mapped from the explicitly reserved huge pages of the
+//:   system (e.g., 'MAP_HUGETLB' on Linux).  If no reserved huge page is
+//:   available, the chunk is mapped as in the 'e_TRANSPARENT' mode, and
+//:   counted by 'numFallbackChunks'.
+//:
+//: 'e_NONE':
+//:   The chunk is backed by pages of the default size, and the system is
+//:   advised not to back it with transparent huge pages (e.g.,
+//:   'madvise(MADV_NOHUGEPAGE)' on Linux, where transparent huge pages may be
+//:   enabled for all memory).  This mode is provided for comparison.
+//
+// On platforms not supporting huge pages, every mode is equivalent to
+// 'e_NONE'.
+//
+///NUMA Placement
+///--------------
+// If a NUMA node is supplied at construction, the memory of each chunk is
+// preferably placed on that node (e.g., 'mbind(MPOL_PREFERRED)' on Linux).
+// Otherwise ('k_LOCAL_NODE'), the memory of a chunk is placed according to
+// the default policy of the system, which, on the supported platforms, places
+// a page on the node of the thread first touching it, i.e., the thread
+// allocating the chunk, which prefaults it (see {Chunks}).  The placement on
+// a supplied node is a preference: it is silently ignored if the node does
+// not exist or if the platform does not support it.
+//
+///Thread Safety
+///-------------
+// The 'bdlma::HugePageAllocator' class is *fully thread-safe* (see
+// 'bsldoc_glossary').
+//
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Backing a Multipool with Huge Pages
+/// - - - - - - - - - - - - - - - - - - - - - - -
+// Suppose that we maintain a large index, stored in a node-based container,
+// that is accessed randomly.  With memory supplied by the default allocator,
+// nearly every lookup accesses a different page of memory, missing in the TLB
+// of the processor.  We can reduce the number of TLB misses by placing the
+// nodes of the container in huge pages.
+//
+// First, we create a 'bdlma::HugePageAllocator' that advises the system to
+// back its chunks with transparent huge pages:
+//..
+//  bdlma::HugePageAllocator hugePageAllocator(
+//                                   bdlma::HugePageAllocator::e_TRANSPARENT);
+//..
+// Then, we create a multipool allocator supplied with memory by the huge page
+// allocator, and an index using the multipool allocator:
+//..
+//  bdlma::MultipoolAllocator multipoolAllocator(&hugePageAllocator);
+//
+//  bsl::map<int, int> index(&multipoolAllocator);
+//..
+// Next, we populate the index:
+//..
+//  enum { k_NUM_ENTRIES = 100000 };
+//
+//  for (int i = 0; i < k_NUM_ENTRIES; ++i) {
+//      index[i * 7] = i;
+//  }
+//  assert(k_NUM_ENTRIES == index.size());
+//..
+// Finally, we observe that the nodes of the index are held in chunks mapped
+// by the huge page allocator, whose total size is a multiple of the chunk
+// size:
+//..
+//  assert(0 <  hugePageAllocator.numChunks());
+//  assert(0 == hugePageAllocator.numBytesMapped()
+//                                % bdlma::HugePageAllocator::k_CHUNK_SIZE);
+//..
+
+#include <bdlscm_version.h>
+
+#include <bdlma_managedallocator.h>
+
+#include <bslmt_mutex.h>
+
+#include <bsls_types.h>
+
+namespace BloombergLP {
+namespace bdlma {
+
+                         // =======================
+                         // class HugePageAllocator
+                         // =======================
+
+class HugePageAllocator : public ManagedAllocator {
+    // This class defines a concrete thread-safe allocator mechanism that
+    // implements the 'ManagedAllocator' protocol, and supplies memory carved
+    // from chunks mapped directly from the operating system, backed by huge
+    // pages according to the 'HugePageMode' supplied at construction, and
+    // placed on the NUMA node supplied at construction (or on the node of the
+    // allocating thread).  Blocks larger than a quarter of a chunk are served
+    // by dedicated regions.  Both the 'release' method and the destructor of
+    // a 'HugePageAllocator' release all memory currently allocated via the
+    // object.
+
+  public:
+    // TYPES
+    enum HugePageMode {
+        // Enumerate the kinds of pages backing the chunks of a
+        // 'HugePageAllocator'.
+
+        e_NONE,         // pages of the default size
+        e_TRANSPARENT,  // transparent huge pages
+        e_EXPLICIT      // explicitly reserved huge pages, or transparent huge
+                        // pages if none is available
+    };
+
+    enum {
+        k_CHUNK_SIZE = 2 * 1024 * 1024,  // size (in bytes) of a chunk, and
+                                         // alignment of each mapped region
+
+        k_LOCAL_NODE = -1                // place memory on the node of the
+                                         // allocating thread
+    };
+
+  private:
+    // PRIVATE TYPES
+    struct Chunk;  // header of a mapped region (defined in the '.cpp')
+
+    // DATA
+    mutable bslmt::Mutex    d_mutex;              // synchronizes access
+
+    HugePageMode            d_mode;               // huge page mode
+
+    int                     d_numaNode;           // preferred node, or
+                                                  // 'k_LOCAL_NODE'
+
+    Chunk                  *d_chunks_p;           // list of all mapped
+                                                  // regions
+
+    Chunk                  *d_current_p;          // chunk from which small
+                                                  // blocks are carved, or 0
+
+    bsls::Types::size_type  d_cursor;             // offset of the next free
+                                                  // byte in 'd_current_p'
+
+    bsls::Types::size_type  d_numBytesMapped;     // total size of the mapped
+                                                  // regions
+
+    int                     d_numChunks;          // number of mapped regions
+
+    int                     d_numFallbackChunks;  // number of regions mapped
+                                                  // without the requested
+                                                  // explicit huge pages
+
+  private:
+    // NOT IMPLEMENTED
+    HugePageAllocator(const HugePageAllocator&);
+    HugePageAllocator& operator=(const HugePageAllocator&);
+
+    // PRIVATE MANIPULATORS
+    void *carveBlock(bsls::Types::size_type paddedSize);
+        // Return the address of a block of the specified 'paddedSize' (in
+        // bytes) carved from the current chunk.  The behavior is undefined
+        // unless the current chunk has room for 'paddedSize' bytes and
+        // 'd_mutex' is locked by the calling thread.
+
+    Chunk *linkChunk(void                   *address,
+                     bsls::Types::size_type  size,
+                     bool                    isDedicated,
+                     bool                    isFallback);
+        // Initialize the header of the region at the specified 'address'
+        // having the specified 'size' (in bytes) as indicated by the specified
+        // 'isDedicated' flag, link it in the list of regions, count it as a
+        // fallback region if the specified 'isFallback' is 'true', and return
+        // its header.  The behavior is undefined unless the region was
+        // returned by 'mapRegion' and 'd_mutex' is locked by the calling
+        // thread.
+
+    void unlinkChunk(Chunk *chunk);
+        // Remove the specified 'chunk' from the list of regions.  The behavior
+        // is undefined unless 'd_mutex' is locked by the calling thread.
+
+    // PRIVATE ACCESSORS
+    void *mapRegion(bsls::Types::size_type  size,
+                    bool                    isDedicated,
+                    bool                   *isFallback) const;
+        // Map a region of the specified 'size' (in bytes) according to the
+        // configuration of this allocator, prefaulting it if it is a chunk
+        // (as indicated by the specified 'isDedicated' flag) and no NUMA node
+        // was supplied at construction, load into the specified 'isFallback'
+        // whether the region was mapped without the requested explicit huge
+        // pages, and return its address, or return 0 if the region cannot be
+        // mapped.  The behavior is undefined unless 'size' is a multiple of
+        // 'k_CHUNK_SIZE'.  Note that this method does not access the mutable
+        // state of this allocator, and is invoked without locking 'd_mutex'.
+
+  public:
+    // CREATORS
+    explicit
+    HugePageAllocator(HugePageMode mode = e_TRANSPARENT);
+    HugePageAllocator(HugePageMode mode, int numaNode);
+        // Create a huge page allocator.  Optionally specify a 'mode'
+        // indicating the kind of pages backing the chunks of this allocator.
+        // If 'mode' is not specified, 'e_TRANSPARENT' is used.  Optionally
+        // specify a 'numaNode' on which the memory of the chunks is
+        // preferably placed.  If 'numaNode' is not specified, or is
+        // 'k_LOCAL_NODE', the memory of a chunk is placed on the node of the
+        // thread allocating the chunk.  The behavior is undefined unless
+        // 'k_LOCAL_NODE <= numaNode'.
+
+    virtual ~HugePageAllocator();
+        // Destroy this allocator.  All memory allocated from this allocator is
+        // returned to the system.
+
+    // MANIPULATORS
+    virtual void *allocate(bsls::Types::size_type size);
+        // Return a newly-allocated maximally-aligned block of memory of (at
+        // least) the specified 'size' (in bytes).  If 'size' is 0, no memory
+        // is allocated and 0 is returned.  If 'size' exceeds a quarter of
+        // 'k_CHUNK_SIZE', the block is served by a dedicated region.  If the
+        // system cannot supply the memory, 'bsl::bad_alloc' is thrown, or 0
+        // is returned if exceptions are not enabled.
+
+    virtual void deallocate(void *address);
+        // Return the memory block at the specified 'address' back to this
+        // allocator.  If 'address' is 0, this method has no effect.  If
+        // 'address' was the last block of its chunk in use, and the chunk is
+        // not the current chunk, the chunk is returned to the system.  The
+        // behavior is undefined unless 'address' was returned by 'allocate'
+        // and has not already been deallocated.
+
+    virtual void release();
+        // Return all memory currently allocated through this allocator to
+        // the system.
+
+    // ACCESSORS
+    HugePageMode hugePageMode() const;
+        // Return the huge page mode of this allocator.
+
+    int numaNode() const;
+        // Return the NUMA node on which the memory of this allocator is
+        // preferably placed, or 'k_LOCAL_NODE' if the memory is placed on the
+        // node of the allocating thread.
+
+    bsls::Types::size_type numBytesMapped() const;
+        // Return the total size (in bytes) of the regions currently mapped by
+        // this allocator.
+
+    int numChunks() const;
+        // Return the number of regions (chunks and dedicated regions)
+        // currently mapped by this allocator.
+
+    int numFallbackChunks() const;
+        // Return the number of regions mapped by this allocator since its
+        // construction for which the explicit huge pages requested by the
+        // 'e_EXPLICIT' mode were not available.
+};
+
+// ============================================================================
+//                             INLINE DEFINITIONS
+// ============================================================================
+
+                         // -----------------------
+                         // class HugePageAllocator
+                         // -----------------------
+
+// ACCESSORS
+inline
+HugePageAllocator::HugePageMode HugePageAllocator::hugePageMode() const
+{
+    return d_mode;
+}
+
+inline
+int HugePageAllocator::numaNode() const
+{
+    return d_numaNode;
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2020 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
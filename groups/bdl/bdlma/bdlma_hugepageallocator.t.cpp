@@ -0,0 +1,1004 @@
+// bdlma_hugepageallocator.t.cpp                                      -*-C++-*-
+#include <bdlma_hugepageallocator.h>
+
+#include <bdlma_bufferedsequentialallocator.h>
+#include <bdlma_concurrentmultipoolallocator.h>
+#include <bdlma_multipoolallocator.h>
+
+#include <bslim_testutil.h>
+
+#include <bslma_default.h>
+#include <bslma_defaultallocatorguard.h>
+#include <bslma_newdeleteallocator.h>
+#include <bslma_testallocator.h>
+
+#include <bslmt_threadutil.h>
+
+#include <bsls_alignmentutil.h>
+#include <bsls_platform.h>
+#include <bsls_review.h>
+#include <bsls_stopwatch.h>
+#include <bsls_types.h>
+
+#include <bsl_cstdio.h>
+#include <bsl_cstdlib.h>
+#include <bsl_cstring.h>
+#include <bsl_iostream.h>
+#include <bsl_map.h>
+#include <bsl_vector.h>
+
+using namespace BloombergLP;
+using namespace bsl;
+
+// ============================================================================
+//                                   TEST PLAN
+// ----------------------------------------------------------------------------
+//                                   Overview
+//                                   --------
+// The component under test is a thread-safe managed allocator that carves
+// blocks from chunks mapped from the operating system, and serves larger
+// blocks from dedicated regions.  We verify that the blocks are aligned,
+// distinct, and writable, that chunks are mapped, reused, and unmapped as
+// documented (as observed through the accessors), that every huge page mode
+// and NUMA node supplies usable memory, that 'release' and the destructor
+// return all regions, and that the allocator can be used concurrently and as
+// the upstream allocator of the pools of this package.
+// ----------------------------------------------------------------------------
+// CREATORS
+// [ 1] HugePageAllocator(HugePageMode mode = e_TRANSPARENT);
+// [ 5] HugePageAllocator(HugePageMode mode, int numaNode);
+// [ 6] ~HugePageAllocator();
+//
+// MANIPULATORS
+// [ 2] void *allocate(bsls::Types::size_type size);
+// [ 2] void deallocate(void *address);
+// [ 6] void release();
+//
+// ACCESSORS
+// [ 4] HugePageMode hugePageMode() const;
+// [ 5] int numaNode() const;
+// [ 2] bsls::Types::size_type numBytesMapped() const;
+// [ 2] int numChunks() const;
+// [ 4] int numFallbackChunks() const;
+// ----------------------------------------------------------------------------
+// [ 1] BREATHING TEST
+// [ 3] CONCERN: Large blocks are served by dedicated regions.
+// [ 7] CONCERN: Concurrent use, and use as the upstream of pools.
+// [ 8] USAGE EXAMPLE
+// [-1] PERFORMANCE: PAGE WALK
+
+// ============================================================================
+//                     STANDARD BDE ASSERT TEST FUNCTION
+// ----------------------------------------------------------------------------
+
+namespace {
+
+int testStatus = 0;
+
+void aSsErT(bool condition, const char *message, int line)
+{
+    if (condition) {
+        cout << "Error " __FILE__ "(" << line << "): " << message
+             << "    (failed)" << endl;
+
+        if (0 <= testStatus && testStatus <= 100) {
+            ++testStatus;
+        }
+    }
+}
+
+}  // close unnamed namespace
+
+// ============================================================================
+//               STANDARD BDE TEST DRIVER MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT       BSLIM_TESTUTIL_ASSERT
+#define ASSERTV      BSLIM_TESTUTIL_ASSERTV
+
+#define LOOP_ASSERT  BSLIM_TESTUTIL_LOOP_ASSERT
+#define LOOP0_ASSERT BSLIM_TESTUTIL_LOOP0_ASSERT
+#define LOOP1_ASSERT BSLIM_TESTUTIL_LOOP1_ASSERT
+#define LOOP2_ASSERT BSLIM_TESTUTIL_LOOP2_ASSERT
+#define LOOP3_ASSERT BSLIM_TESTUTIL_LOOP3_ASSERT
+#define LOOP4_ASSERT BSLIM_TESTUTIL_LOOP4_ASSERT
+#define LOOP5_ASSERT BSLIM_TESTUTIL_LOOP5_ASSERT
+#define LOOP6_ASSERT BSLIM_TESTUTIL_LOOP6_ASSERT
+
+#define Q            BSLIM_TESTUTIL_Q   // Quote identifier literally.
+#define P            BSLIM_TESTUTIL_P   // Print identifier and value.
+#define P_           BSLIM_TESTUTIL_P_  // P(X) without '\n'.
+#define T_           BSLIM_TESTUTIL_T_  // Print a tab (w/o newline).
+#define L_           BSLIM_TESTUTIL_L_  // current Line number
+
+// ============================================================================
+//                  GLOBAL TYPEDEFS/CONSTANTS FOR TESTING
+// ----------------------------------------------------------------------------
+
+typedef bdlma::HugePageAllocator Obj;
+typedef bsls::Types::size_type   size_type;
+typedef bsls::Types::UintPtr     UintPtr;
+
+const size_type k_CHUNK_SIZE = Obj::k_CHUNK_SIZE;
+
+const int k_MAX_ALIGN = bsls::AlignmentUtil::BSLS_MAX_ALIGNMENT;
+
+// ============================================================================
+//                      HELPER FUNCTIONS FOR TESTING
+// ----------------------------------------------------------------------------
+
+static bool isMaxAligned(const void *address)
+    // Return 'true' if the specified 'address' is maximally aligned, and
+    // 'false' otherwise.
+{
+    return 0 == bsls::AlignmentUtil::calculateAlignmentOffset(address,
+                                                              k_MAX_ALIGN);
+}
+
+static const char *chunkOf(const void *address)
+    // Return the address of the 'k_CHUNK_SIZE'-aligned region holding the
+    // specified 'address'.
+{
+    return reinterpret_cast<const char *>(
+                  reinterpret_cast<UintPtr>(address) & ~(k_CHUNK_SIZE - 1));
+}
+
+static size_type regionSize(size_type size)
+    // Return the size of the dedicated region expected to serve a block of
+    // the specified 'size' (in bytes).
+{
+    return (size + k_MAX_ALIGN * 4 + k_CHUNK_SIZE - 1) & ~(k_CHUNK_SIZE - 1);
+}
+
+static size_type residentSetSize()
+    // Return the resident set size (in pages) of this process, or 0 if it
+    // cannot be determined on this platform.
+{
+    size_type result = 0;
+
+#ifdef BSLS_PLATFORM_OS_LINUX
+    FILE *file = fopen("/proc/self/statm", "r");
+    if (file) {
+        unsigned long size;
+        unsigned long resident;
+        if (2 == fscanf(file, "%lu %lu", &size, &resident)) {
+            result = resident;
+        }
+        fclose(file);
+    }
+#endif
+
+    return result;
+}
+
+// ============================================================================
+//                     HELPER THREAD FUNCTIONS FOR TESTING
+// ----------------------------------------------------------------------------
+
+struct AllocateJob {
+    // This 'struct' describes the work of a thread allocating, filling,
+    // verifying, and deallocating blocks.
+
+    bslma::Allocator *d_allocator_p;  // allocator under test
+    int               d_id;           // identifier of the thread
+    int               d_iterations;   // number of rounds
+};
+
+extern "C" void *allocateBlocks(void *arg)
+    // Repeatedly allocate blocks of various sizes using the job described by
+    // the specified 'arg', the address of an 'AllocateJob', fill them with
+    // the identifier of the job, verify them, and deallocate them.
+{
+    enum { k_NUM_BLOCKS = 64 };
+
+    AllocateJob *job = static_cast<AllocateJob *>(arg);
+    void        *blocks[k_NUM_BLOCKS];
+    int          sizes[k_NUM_BLOCKS];
+
+    for (int i = 0; i < job->d_iterations; ++i) {
+        for (int j = 0; j < k_NUM_BLOCKS; ++j) {
+            sizes[j]  = 1 + (i * 131 + j * 977) % 3000;
+            blocks[j] = job->d_allocator_p->allocate(sizes[j]);
+            memset(blocks[j], job->d_id, sizes[j]);
+        }
+        for (int j = 0; j < k_NUM_BLOCKS; ++j) {
+            const char *bytes = static_cast<const char *>(blocks[j]);
+            for (int k = 0; k < sizes[j]; ++k) {
+                if (job->d_id != bytes[k]) {
+                    ASSERTV(job->d_id, j, k, job->d_id == bytes[k]);
+                    break;
+                }
+            }
+            job->d_allocator_p->deallocate(blocks[j]);
+        }
+    }
+    return 0;
+}
+
+static double walkPages(bslma::Allocator *allocator,
+                        size_type         bufferSize,
+                        int               numSteps)
+    // Allocate a buffer of the specified 'bufferSize' (in bytes) from the
+    // specified 'allocator', link one cache line of each page of the buffer
+    // in a random cycle, and return the time (in nanoseconds) per step of a
+    // walk along the specified 'numSteps' links of the cycle.
+{
+    enum { k_PAGE_SIZE = 4096, k_CACHE_LINE_SIZE = 64 };
+
+    const int numPages = static_cast<int>(bufferSize / k_PAGE_SIZE);
+
+    char *buffer = static_cast<char *>(allocator->allocate(bufferSize));
+
+    // Create a random cycle of the pages (Sattolo's algorithm).
+
+    bsl::vector<int> order(numPages);
+    for (int i = 0; i < numPages; ++i) {
+        order[i] = i;
+    }
+    unsigned int seed = 12345;
+    for (int i = numPages - 1; 0 < i; --i) {
+        seed = seed * 1103515245 + 12345;
+        const int j = static_cast<int>((seed >> 8) % i);
+        const int tmp = order[i];
+        order[i] = order[j];
+        order[j] = tmp;
+    }
+
+    // Link a cache line of each page (varying the line, to use every cache
+    // set) to the same line of the next page of the cycle.
+
+    for (int i = 0; i < numPages; ++i) {
+        const int from = order[i];
+        const int to   = order[(i + 1) % numPages];
+
+        char *fromLine = buffer + size_type(from) * k_PAGE_SIZE
+                       + (from % (k_PAGE_SIZE / k_CACHE_LINE_SIZE))
+                                                          * k_CACHE_LINE_SIZE;
+        char *toLine   = buffer + size_type(to) * k_PAGE_SIZE
+                       + (to % (k_PAGE_SIZE / k_CACHE_LINE_SIZE))
+                                                          * k_CACHE_LINE_SIZE;
+
+        *reinterpret_cast<char **>(fromLine) = toLine;
+    }
+
+    char *cursor = buffer + (order[0] % (k_PAGE_SIZE / k_CACHE_LINE_SIZE))
+                                                          * k_CACHE_LINE_SIZE
+                          + size_type(order[0]) * k_PAGE_SIZE;
+
+    bsls::Stopwatch timer;
+    timer.start();
+
+    for (int i = 0; i < numSteps; ++i) {
+        cursor = *reinterpret_cast<char **>(cursor);
+    }
+
+    timer.stop();
+
+    ASSERT(cursor);
+
+    allocator->deallocate(buffer);
+
+    return timer.elapsedTime() * 1e9 / numSteps;
+}
+
+// ============================================================================
+//                               MAIN PROGRAM
+// ----------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    const int                 test = argc > 1 ? atoi(argv[1]) : 0;
+    const bool             verbose = argc > 2;
+    const bool         veryVerbose = argc > 3;
+    const bool     veryVeryVerbose = argc > 4;
+    const bool veryVeryVeryVerbose = argc > 5;
+
+    (void)veryVeryVerbose;
+
+    cout << "TEST " << __FILE__ << " CASE " << test << endl;
+
+    // CONCERN: 'BSLS_REVIEW' failures should lead to test failures.
+    bsls::ReviewFailureHandlerGuard reviewGuard(&bsls::Review::failByAbort);
+
+    // CONCERN: In no case does memory come from the global allocator.
+
+    bslma::TestAllocator globalAllocator("global", veryVeryVeryVerbose);
+    bslma::Default::setGlobalAllocator(&globalAllocator);
+
+    switch (test) { case 0:
+      case 8: {
+        // --------------------------------------------------------------------
+        // USAGE EXAMPLE
+        //   Extracted from component header file.
+        //
+        // Concerns:
+        //: 1 The usage example provided in the component header file compiles,
+        //:   links, and runs as shown.
+        //
+        // Plan:
+        //: 1 Incorporate usage example from header into test driver, remove
+        //:   leading comment characters, and replace 'assert' with 'ASSERT'.
+        //:   (C-1)
+        //
+        // Testing:
+        //   USAGE EXAMPLE
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "USAGE EXAMPLE" << endl
+                          << "=============" << endl;
+
+///Example 1: Backing a Multipool with Huge Pages
+/// - - - - - - - - - - - - - - - - - - - - - - -
+// Suppose that we maintain a large index, stored in a node-based container,
+// that is accessed randomly.  With memory supplied by the default allocator,
+// nearly every lookup accesses a different page of memory, missing in the TLB
+// of the processor.  We can reduce the number of TLB misses by placing the
+// nodes of the container in huge pages.
+//
+// First, we create a 'bdlma::HugePageAllocator' that advises the system to
+// back its chunks with transparent huge pages:
+//..
+    bdlma::HugePageAllocator hugePageAllocator(
+                                     bdlma::HugePageAllocator::e_TRANSPARENT);
+//..
+// Then, we create a multipool allocator supplied with memory by the huge page
+// allocator, and an index using the multipool allocator:
+//..
+    bdlma::MultipoolAllocator multipoolAllocator(&hugePageAllocator);
+
+    bsl::map<int, int> index(&multipoolAllocator);
+//..
+// Next, we populate the index:
+//..
+    enum { k_NUM_ENTRIES = 100000 };
+
+    for (int i = 0; i < k_NUM_ENTRIES; ++i) {
+        index[i * 7] = i;
+    }
+    ASSERT(k_NUM_ENTRIES == index.size());
+//..
+// Finally, we observe that the nodes of the index are held in chunks mapped
+// by the huge page allocator, whose total size is a multiple of the chunk
+// size:
+//..
+    ASSERT(0 <  hugePageAllocator.numChunks());
+    ASSERT(0 == hugePageAllocator.numBytesMapped()
+                                  % bdlma::HugePageAllocator::k_CHUNK_SIZE);
+//..
+      } break;
+      case 7: {
+        // --------------------------------------------------------------------
+        // CONCERN: CONCURRENT USE, AND USE AS THE UPSTREAM OF POOLS
+        //
+        // Concerns:
+        //: 1 Blocks allocated concurrently by several threads are distinct.
+        //:
+        //: 2 The allocator can supply the memory of the pools and arenas of
+        //:   this package, including from several threads.
+        //:
+        //: 3 When all blocks are deallocated, only the current chunk remains
+        //:   mapped.
+        //
+        // Plan:
+        //: 1 Run several threads allocating blocks of various sizes directly
+        //:   from a 'HugePageAllocator', filling and verifying them.  Verify
+        //:   that at most one chunk remains mapped afterwards.  (C-1, 3)
+        //:
+        //: 2 Repeat P-1 with the threads allocating from a
+        //:   'ConcurrentMultipoolAllocator' supplied by a 'HugePageAllocator'.
+        //:   (C-2)
+        //:
+        //: 3 Populate a container using a 'BufferedSequentialAllocator'
+        //:   supplied by a 'HugePageAllocator'.  (C-2)
+        //
+        // Testing:
+        //   CONCERN: Concurrent use, and use as the upstream of pools.
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                 << "CONCERN: CONCURRENT USE, AND USE AS THE UPSTREAM OF POOLS"
+                 << endl
+                 << "========================================================="
+                 << endl;
+
+        enum { k_NUM_THREADS = 6, k_ITERATIONS = 200 };
+
+        if (verbose) cout << "\nDirect concurrent use." << endl;
+        {
+            Obj mX;  const Obj& X = mX;
+
+            AllocateJob               jobs[k_NUM_THREADS];
+            bslmt::ThreadUtil::Handle handles[k_NUM_THREADS];
+
+            for (int i = 0; i < k_NUM_THREADS; ++i) {
+                AllocateJob job = { &mX, i + 1, k_ITERATIONS };
+                jobs[i] = job;
+                ASSERTV(i, 0 == bslmt::ThreadUtil::create(&handles[i],
+                                                          &allocateBlocks,
+                                                          &jobs[i]));
+            }
+            for (int i = 0; i < k_NUM_THREADS; ++i) {
+                bslmt::ThreadUtil::join(handles[i]);
+            }
+
+            ASSERTV(X.numChunks(), 1 == X.numChunks());
+            ASSERTV(X.numBytesMapped(), k_CHUNK_SIZE == X.numBytesMapped());
+        }
+
+        if (verbose) cout << "\nAs the upstream of a concurrent multipool."
+                          << endl;
+        {
+            Obj mX;  const Obj& X = mX;
+            {
+                bdlma::ConcurrentMultipoolAllocator mp(&mX);
+
+                AllocateJob               jobs[k_NUM_THREADS];
+                bslmt::ThreadUtil::Handle handles[k_NUM_THREADS];
+
+                for (int i = 0; i < k_NUM_THREADS; ++i) {
+                    AllocateJob job = { &mp, i + 1, k_ITERATIONS };
+                    jobs[i] = job;
+                    ASSERTV(i, 0 == bslmt::ThreadUtil::create(&handles[i],
+                                                              &allocateBlocks,
+                                                              &jobs[i]));
+                }
+                for (int i = 0; i < k_NUM_THREADS; ++i) {
+                    bslmt::ThreadUtil::join(handles[i]);
+                }
+
+                ASSERT(0 < X.numChunks());
+            }
+            ASSERTV(X.numChunks(), 1 >= X.numChunks());
+        }
+
+        if (verbose) cout << "\nAs the upstream of a sequential arena."
+                          << endl;
+        {
+            Obj mX;  const Obj& X = mX;
+            {
+                char                               buffer[1024];
+                bdlma::BufferedSequentialAllocator arena(buffer,
+                                                         sizeof buffer,
+                                                         &mX);
+
+                bsl::vector<int> values(&arena);
+                for (int i = 0; i < 1000000; ++i) {
+                    values.push_back(i);
+                }
+                for (int i = 0; i < 1000000; ++i) {
+                    ASSERTV(i, i == values[i]);
+                    if (i != values[i]) {
+                        break;
+                    }
+                }
+
+                ASSERT(4000000 < X.numBytesMapped());
+            }
+            ASSERTV(X.numChunks(), 1 >= X.numChunks());
+        }
+      } break;
+      case 6: {
+        // --------------------------------------------------------------------
+        // MANIPULATOR: 'release'
+        //
+        // Concerns:
+        //: 1 'release' unmaps every region, including chunks holding blocks
+        //:   in use and dedicated regions.
+        //:
+        //: 2 The allocator is usable after 'release'.
+        //
+        // Plan:
+        //: 1 Repeatedly allocate blocks filling several chunks and a
+        //:   dedicated region, verify the number of regions, call 'release',
+        //:   and verify that no region remains mapped.  (C-1..2)
+        //
+        // Testing:
+        //   void release();
+        //   ~HugePageAllocator();
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "MANIPULATOR: 'release'" << endl
+                          << "======================" << endl;
+
+        // Twenty blocks of 100000 bytes fit in a chunk.
+
+        enum { k_BLOCK_SIZE = 100000, k_NUM_BLOCKS = 5 * 20 };
+
+        Obj mX;  const Obj& X = mX;
+
+        for (int i = 0; i < 3; ++i) {
+            for (int j = 0; j < k_NUM_BLOCKS; ++j) {
+                memset(mX.allocate(k_BLOCK_SIZE), j, k_BLOCK_SIZE);
+            }
+            ASSERTV(i, X.numChunks(), 5 == X.numChunks());
+
+            mX.allocate(5 * k_CHUNK_SIZE);
+
+            ASSERTV(i, X.numChunks(), 6 == X.numChunks());
+            ASSERTV(i, X.numBytesMapped(),
+                    11 * k_CHUNK_SIZE == X.numBytesMapped());
+
+            mX.release();
+
+            ASSERTV(i, 0 == X.numChunks());
+            ASSERTV(i, 0 == X.numBytesMapped());
+        }
+
+        // The destructor releases the blocks allocated last.
+
+        mX.allocate(k_BLOCK_SIZE);
+        mX.allocate(5 * k_CHUNK_SIZE);
+      } break;
+      case 5: {
+        // --------------------------------------------------------------------
+        // CONCERN: NUMA NODES
+        //
+        // Concerns:
+        //: 1 The NUMA node supplied at construction is reported by 'numaNode'.
+        //:
+        //: 2 Memory is supplied whether or not the node exists, and whether
+        //:   or not the platform supports NUMA placement.
+        //
+        // Plan:
+        //: 1 For a set of nodes including 'k_LOCAL_NODE', node 0, and nodes
+        //:   beyond those of the test machine and of the node masks, allocate
+        //:   and fill small and large blocks.  (C-1..2)
+        //
+        // Testing:
+        //   HugePageAllocator(HugePageMode mode, int numaNode);
+        //   int numaNode() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "CONCERN: NUMA NODES" << endl
+                          << "===================" << endl;
+
+        static const int NODES[] = { Obj::k_LOCAL_NODE, 0, 1, 63, 64, 1000 };
+        enum { NUM_NODES = sizeof NODES / sizeof *NODES };
+
+        for (int i = 0; i < NUM_NODES; ++i) {
+            const int NODE = NODES[i];
+
+            Obj mX(Obj::e_TRANSPARENT, NODE);  const Obj& X = mX;
+
+            ASSERTV(NODE, NODE == X.numaNode());
+
+            void *small = mX.allocate(1000);
+            void *large = mX.allocate(3 * k_CHUNK_SIZE);
+
+            memset(small, 1, 1000);
+            memset(large, 2, 3 * k_CHUNK_SIZE);
+
+            ASSERTV(NODE, 2 == X.numChunks());
+
+            mX.deallocate(small);
+            mX.deallocate(large);
+        }
+      } break;
+      case 4: {
+        // --------------------------------------------------------------------
+        // CONCERN: HUGE PAGE MODES
+        //
+        // Concerns:
+        //: 1 Every mode supplies usable memory, and is reported by
+        //:   'hugePageMode'.
+        //:
+        //: 2 'numFallbackChunks' counts the regions for which explicit huge
+        //:   pages were requested but unavailable, and is 0 in the other
+        //:   modes.
+        //
+        // Plan:
+        //: 1 For each mode, allocate and fill small and large blocks, and
+        //:   verify 'numFallbackChunks'.  (C-1..2)
+        //
+        // Testing:
+        //   HugePageMode hugePageMode() const;
+        //   int numFallbackChunks() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "CONCERN: HUGE PAGE MODES" << endl
+                          << "========================" << endl;
+
+        static const Obj::HugePageMode MODES[] = {
+            Obj::e_NONE, Obj::e_TRANSPARENT, Obj::e_EXPLICIT
+        };
+        enum { NUM_MODES = sizeof MODES / sizeof *MODES };
+
+        for (int i = 0; i < NUM_MODES; ++i) {
+            const Obj::HugePageMode MODE = MODES[i];
+
+            Obj mX(MODE);  const Obj& X = mX;
+
+            ASSERTV(MODE, MODE == X.hugePageMode());
+
+            void *small = mX.allocate(1000);
+            void *large = mX.allocate(3 * k_CHUNK_SIZE);
+
+            memset(small, 1, 1000);
+            memset(large, 2, 3 * k_CHUNK_SIZE);
+
+            if (Obj::e_EXPLICIT == MODE) {
+                ASSERTV(X.numFallbackChunks(), 2 >= X.numFallbackChunks());
+                if (veryVerbose) { T_ P(X.numFallbackChunks()) }
+            }
+            else {
+                ASSERTV(MODE, 0 == X.numFallbackChunks());
+            }
+
+            mX.deallocate(small);
+            mX.deallocate(large);
+        }
+      } break;
+      case 3: {
+        // --------------------------------------------------------------------
+        // CONCERN: LARGE BLOCKS ARE SERVED BY DEDICATED REGIONS
+        //
+        // Concerns:
+        //: 1 A block larger than a quarter of a chunk is served by a region
+        //:   whose size is the least multiple of the chunk size holding the
+        //:   block and the region header, and which is unmapped when the
+        //:   block is deallocated.
+        //:
+        //: 2 Dedicated regions do not affect the current chunk.
+        //:
+        //: 3 The whole block is writable.
+        //:
+        //: 4 A dedicated region is not prefaulted: its pages become resident
+        //:   only as they are used.
+        //
+        // Plan:
+        //: 1 For a set of sizes around the threshold and the chunk size,
+        //:   allocate a block, verify its alignment and the mapped size, fill
+        //:   it, and deallocate it.  (C-1, 3)
+        //:
+        //: 2 Interleave small blocks, and verify that they are carved
+        //:   contiguously from the same chunk.  (C-2)
+        //:
+        //: 3 Where the resident set size of the process can be determined,
+        //:   allocate a 256MB block and verify that the resident set size
+        //:   grows by much less than 256MB.  (C-4)
+        //
+        // Testing:
+        //   CONCERN: Large blocks are served by dedicated regions.
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                 << "CONCERN: LARGE BLOCKS ARE SERVED BY DEDICATED REGIONS"
+                 << endl
+                 << "====================================================="
+                 << endl;
+
+        const size_type SIZES[] = {
+            k_CHUNK_SIZE / 4 + 1,
+            k_CHUNK_SIZE / 2,
+            k_CHUNK_SIZE - 100,
+            k_CHUNK_SIZE,
+            k_CHUNK_SIZE + 1,
+            5 * k_CHUNK_SIZE + 12345
+        };
+        enum { NUM_SIZES = sizeof SIZES / sizeof *SIZES };
+
+        Obj mX;  const Obj& X = mX;
+
+        char *previous = static_cast<char *>(mX.allocate(16));
+
+        const size_type CHUNK_BYTES = X.numBytesMapped();
+
+        ASSERT(k_CHUNK_SIZE == CHUNK_BYTES);
+
+        for (int i = 0; i < NUM_SIZES; ++i) {
+            const size_type SIZE = SIZES[i];
+
+            char *block = static_cast<char *>(mX.allocate(SIZE));
+
+            ASSERTV(SIZE, isMaxAligned(block));
+            ASSERTV(SIZE, 2 == X.numChunks());
+            ASSERTV(SIZE, X.numBytesMapped(),
+                    CHUNK_BYTES + regionSize(SIZE) >= X.numBytesMapped());
+            ASSERTV(SIZE, X.numBytesMapped(),
+                    CHUNK_BYTES + regionSize(SIZE) - k_CHUNK_SIZE
+                                                         < X.numBytesMapped());
+            ASSERTV(SIZE, 0 == X.numBytesMapped() % k_CHUNK_SIZE);
+
+            memset(block, 0x5a, SIZE);
+            ASSERTV(SIZE, 0x5a == block[SIZE - 1]);
+
+            char *small = static_cast<char *>(mX.allocate(16));
+            ASSERTV(SIZE, previous + 16 == small);
+            previous = small;
+
+            mX.deallocate(block);
+
+            ASSERTV(SIZE, 1 == X.numChunks());
+            ASSERTV(SIZE, CHUNK_BYTES == X.numBytesMapped());
+        }
+
+        if (verbose) cout << "\nA dedicated region is not prefaulted." << endl;
+        {
+            const size_type SIZE = 256 * 1024 * 1024;
+
+            const size_type RSS_BEFORE = residentSetSize();
+
+            void *block = mX.allocate(SIZE);
+
+            const size_type RSS_AFTER = residentSetSize();
+
+            if (veryVerbose) { P_(RSS_BEFORE) P(RSS_AFTER) }
+
+            if (RSS_BEFORE) {
+                ASSERTV(RSS_BEFORE, RSS_AFTER,
+                        (RSS_AFTER - RSS_BEFORE) * 4096 < SIZE / 8);
+            }
+
+            mX.deallocate(block);
+        }
+      } break;
+      case 2: {
+        // --------------------------------------------------------------------
+        // ALLOCATE AND DEALLOCATE
+        //
+        // Concerns:
+        //: 1 Blocks are maximally aligned, and carved contiguously from the
+        //:   current chunk.
+        //:
+        //: 2 A new chunk is mapped when the current chunk cannot hold a
+        //:   block.
+        //:
+        //: 3 When the last block of a chunk other than the current chunk is
+        //:   deallocated, the chunk is unmapped.
+        //:
+        //: 4 When the last block of the current chunk is deallocated, the
+        //:   chunk is reused from its beginning.
+        //:
+        //: 5 'allocate(0)' returns 0 and 'deallocate(0)' has no effect.
+        //
+        // Plan:
+        //: 1 Allocate blocks of a size up to the threshold until a second
+        //:   chunk is mapped, verifying the addresses of the blocks and the
+        //:   accessors.  (C-1..2)
+        //:
+        //: 2 Deallocate the blocks of the first chunk, and verify that it is
+        //:   unmapped once the last one is deallocated.  (C-3)
+        //:
+        //: 3 Deallocate the blocks of the second chunk, allocate a block, and
+        //:   verify that it is at the beginning of the same chunk.  (C-4)
+        //:
+        //: 4 Call 'allocate(0)' and 'deallocate(0)'.  (C-5)
+        //
+        // Testing:
+        //   void *allocate(bsls::Types::size_type size);
+        //   void deallocate(void *address);
+        //   bsls::Types::size_type numBytesMapped() const;
+        //   int numChunks() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "ALLOCATE AND DEALLOCATE" << endl
+                          << "=======================" << endl;
+
+        static const size_type SIZES[] = {
+            1, 15, 16, 17, 100, 4096, 100000, k_CHUNK_SIZE / 4
+        };
+        enum { NUM_SIZES = sizeof SIZES / sizeof *SIZES };
+
+        for (int i = 0; i < NUM_SIZES; ++i) {
+            const size_type SIZE   = SIZES[i];
+            const size_type PADDED =
+                          bsls::AlignmentUtil::roundUpToMaximalAlignment(SIZE);
+
+            if (veryVerbose) { T_ P(SIZE) }
+
+            Obj mX;  const Obj& X = mX;
+
+            ASSERT(0 == X.numChunks());
+            ASSERT(0 == X.numBytesMapped());
+
+            bsl::vector<char *> blocks;
+
+            char *block = static_cast<char *>(mX.allocate(SIZE));
+            blocks.push_back(block);
+
+            const char *FIRST_CHUNK = chunkOf(block);
+
+            while (FIRST_CHUNK == chunkOf(blocks.back())) {
+                ASSERTV(SIZE, isMaxAligned(blocks.back()));
+                ASSERTV(SIZE, 1 == X.numChunks());
+
+                block = static_cast<char *>(mX.allocate(SIZE));
+                memset(block, 0xa5, SIZE);
+
+                if (FIRST_CHUNK == chunkOf(block)) {
+                    ASSERTV(SIZE, blocks.back() + PADDED == block);
+                }
+                blocks.push_back(block);
+            }
+
+            const char *SECOND_CHUNK = chunkOf(blocks.back());
+
+            ASSERTV(SIZE, 2 == X.numChunks());
+            ASSERTV(SIZE, 2 * k_CHUNK_SIZE == X.numBytesMapped());
+            ASSERTV(SIZE,
+                    blocks.back() + PADDED <= SECOND_CHUNK + k_CHUNK_SIZE);
+
+            // Deallocate the blocks of the first chunk.
+
+            for (size_type j = 0; j < blocks.size() - 1; ++j) {
+                ASSERTV(SIZE, j, 2 == X.numChunks());
+                mX.deallocate(blocks[j]);
+            }
+            ASSERTV(SIZE, 1 == X.numChunks());
+            ASSERTV(SIZE, k_CHUNK_SIZE == X.numBytesMapped());
+
+            // Deallocate the block of the current chunk; the chunk is reused.
+
+            mX.deallocate(blocks.back());
+            ASSERTV(SIZE, 1 == X.numChunks());
+
+            block = static_cast<char *>(mX.allocate(SIZE));
+            ASSERTV(SIZE, block == blocks.back());
+            ASSERTV(SIZE, 1 == X.numChunks());
+
+            ASSERT(0 == mX.allocate(0));
+            mX.deallocate(0);
+            ASSERTV(SIZE, 1 == X.numChunks());
+        }
+      } break;
+      case 1: {
+        // --------------------------------------------------------------------
+        // BREATHING TEST
+        //   This case exercises (but does not fully test) basic functionality.
+        //
+        // Concerns:
+        //: 1 The class is sufficiently functional to enable comprehensive
+        //:   testing in subsequent test cases.
+        //
+        // Plan:
+        //: 1 Create an allocator using the default configuration, allocate,
+        //:   fill, and deallocate a few blocks, and verify the accessors.
+        //:   (C-1)
+        //
+        // Testing:
+        //   BREATHING TEST
+        //   HugePageAllocator(HugePageMode mode = e_TRANSPARENT);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "BREATHING TEST" << endl
+                          << "==============" << endl;
+
+        bslma::TestAllocator         da("default", veryVeryVeryVerbose);
+        bslma::DefaultAllocatorGuard dag(&da);
+
+        Obj mX;  const Obj& X = mX;
+
+        ASSERT(Obj::e_TRANSPARENT == X.hugePageMode());
+        ASSERT(Obj::k_LOCAL_NODE  == X.numaNode());
+        ASSERT(0 == X.numChunks());
+        ASSERT(0 == X.numBytesMapped());
+        ASSERT(0 == X.numFallbackChunks());
+
+        char *p = static_cast<char *>(mX.allocate(100));
+        char *q = static_cast<char *>(mX.allocate(100));
+
+        ASSERT(p);
+        ASSERT(q);
+        ASSERT(p != q);
+        ASSERT(isMaxAligned(p));
+        ASSERT(isMaxAligned(q));
+
+        memset(p, 1, 100);
+        memset(q, 2, 100);
+        ASSERT(1 == p[99]);
+        ASSERT(2 == q[0]);
+
+        ASSERT(1 == X.numChunks());
+        ASSERT(k_CHUNK_SIZE == X.numBytesMapped());
+
+        mX.deallocate(p);
+        mX.deallocate(q);
+
+        ASSERT(1 == X.numChunks());
+
+        mX.release();
+
+        ASSERT(0 == X.numChunks());
+        ASSERT(0 == X.numBytesMapped());
+
+        ASSERT(0 == da.numBlocksTotal());
+      } break;
+      case -1: {
+        // --------------------------------------------------------------------
+        // PERFORMANCE: PAGE WALK
+        //
+        // Concerns:
+        //: 1 Randomly accessing memory supplied by a 'HugePageAllocator'
+        //:   backed by huge pages incurs fewer TLB misses (and is faster) than
+        //:   accessing memory backed by pages of the default size.
+        //
+        // Plan:
+        //: 1 Allocate a large buffer from a 'HugePageAllocator' in each mode,
+        //:   and from the 'NewDeleteAllocator', link one cache line of each
+        //:   4KB page in a random cycle, and report the time per step of a
+        //:   walk along the cycle.  Optionally specify the size of the buffer
+        //:   in MB as the second argument.
+        //
+        // Testing:
+        //   PERFORMANCE: PAGE WALK
+        // --------------------------------------------------------------------
+
+        cout << endl
+             << "PERFORMANCE: PAGE WALK" << endl
+             << "======================" << endl;
+
+        const int       MEGABYTES   = argc > 2 && atoi(argv[2]) > 0
+                                    ? atoi(argv[2])
+                                    : 256;
+        const size_type BUFFER_SIZE = size_type(MEGABYTES) * 1024 * 1024;
+
+        enum { k_NUM_STEPS = 10 * 1000 * 1000 };
+
+        cout << "buffer: " << MEGABYTES << "MB" << endl;
+
+        {
+            Obj mX(Obj::e_NONE);
+            cout << "HugePageAllocator(e_NONE):        "
+                 << walkPages(&mX, BUFFER_SIZE, k_NUM_STEPS) << " ns/step"
+                 << endl;
+        }
+        {
+            Obj mX(Obj::e_TRANSPARENT);
+            cout << "HugePageAllocator(e_TRANSPARENT): "
+                 << walkPages(&mX, BUFFER_SIZE, k_NUM_STEPS) << " ns/step"
+                 << endl;
+        }
+        {
+            Obj mX(Obj::e_EXPLICIT);
+            const double NS = walkPages(&mX, BUFFER_SIZE, k_NUM_STEPS);
+            cout << "HugePageAllocator(e_EXPLICIT):    " << NS << " ns/step"
+                 << (mX.numFallbackChunks() ? " (fell back to transparent)"
+                                            : "")
+                 << endl;
+        }
+        {
+            cout << "NewDeleteAllocator:               "
+                 << walkPages(&bslma::NewDeleteAllocator::singleton(),
+                              BUFFER_SIZE,
+                              k_NUM_STEPS)
+                 << " ns/step" << endl;
+        }
+      } break;
+      default: {
+        cerr << "WARNING: CASE `" << test << "' NOT FOUND." << endl;
+        testStatus = -1;
+      }
+    }
+
+    // CONCERN: In no case does memory come from the global allocator.
+
+    ASSERTV(globalAllocator.numBlocksTotal(),
+            0 == globalAllocator.numBlocksTotal());
+
+    if (testStatus > 0) {
+        cerr << "Error, non-zero test status = " << testStatus << "." << endl;
+    }
+    return testStatus;
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2020 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
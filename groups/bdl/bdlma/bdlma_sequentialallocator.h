@@ -45,7 +45,9 @@ BSLS_IDENT("$Id: $")
 // allocator, as does the destructor.  The 'rewind' method releases all memory
 // allocated through the allocator and returns to the underlying allocator
 // *only* memory that was allocated outside of the typical internal buffer
-// growth of the allocator (i.e., large blocks).  Note that individually
+// growth of the allocator (i.e., large blocks), and an overload of 'rewind'
+// additionally returns the internal buffers in excess of a specified capacity
+// (see {Rewinding with a Retained Capacity}).  Note that individually
 // allocated memory blocks cannot be separately deallocated.
 //
 // The main difference between a 'bdlma::SequentialAllocator' and a
@@ -92,6 +94,19 @@ BSLS_IDENT("$Id: $")
 // 'alignmentStrategy' is not specified, natural alignment is used.  See
 // 'bsls_alignment' for more details.
 //
+///Rewinding with a Retained Capacity
+///----------------------------------
+// When a sequential allocator serves as a per-request arena, 'rewind()'
+// retains every internal buffer grown by the largest request processed so
+// far, whereas 'release()' returns them all.  'rewind(maxRetainedCapacity)'
+// retains a "warm" set of internal buffers whose total size is at most
+// 'maxRetainedCapacity' and returns the others to the underlying allocator.
+// The 'numRewinds', 'lastWorkingCapacity', 'maxWorkingCapacity', and
+// 'totalWorkingCapacity' accessors report the total size of the buffers that
+// supplied memory in each cycle of allocations ended by 'rewind', and may be
+// used to choose 'maxRetainedCapacity'.  See the component-level
+// documentation of 'bdlma_sequentialpool' for details.
+//
 ///Usage
 ///-----
 // Allocators are often supplied, at construction, to objects requiring
@@ -373,6 +388,17 @@ class SequentialAllocator : public ManagedAllocator {
         // 'rewind' - using a pointer obtained from this object prior to this
         // call to 'rewind' is undefined.
 
+    void rewind(bsls::Types::size_type maxRetainedCapacity);
+        // Release all memory allocated through this allocator, return to the
+        // underlying allocator all memory that was allocated outside of the
+        // typical internal buffer growth of this allocator (i.e., large
+        // blocks), and retain for subsequent allocations only the internal
+        // buffers whose total size does not exceed the specified
+        // 'maxRetainedCapacity' (in bytes), returning the other internal
+        // buffers to the underlying allocator.  The effect of subsequently -
+        // to this invokation of 'rewind' - using a pointer obtained from this
+        // object prior to this call to 'rewind' is undefined.
+
     void reserveCapacity(bsls::Types::size_type numBytes);
         // Reserve sufficient memory to satisfy allocation requests for at
         // least the specified 'numBytes' without replenishment (i.e., without
@@ -396,6 +422,29 @@ class SequentialAllocator : public ManagedAllocator {
         // at 'address' is 'originalSize', 'newSize <= originalSize', and
         // 'release' was not called after allocating the memory block at
         // 'address'.
+
+    // ACCESSORS
+    bsls::Types::size_type lastWorkingCapacity() const;
+        // Return the working capacity (in bytes) of the cycle of allocations
+        // ended by the most recent call to 'rewind', or 0 if 'rewind' has not
+        // been called.  See {Rewinding with a Retained Capacity}.
+
+    bsls::Types::size_type maxWorkingCapacity() const;
+        // Return the maximum working capacity (in bytes) of any cycle of
+        // allocations ended by a call to 'rewind', or 0 if 'rewind' has not
+        // been called.
+
+    bsls::Types::Int64 numRewinds() const;
+        // Return the number of times 'rewind' has been called on this
+        // allocator.
+
+    bsls::Types::size_type retainedCapacity() const;
+        // Return the total size (in bytes) of the internal buffers currently
+        // held by this allocator, excluding large blocks.
+
+    bsls::Types::Uint64 totalWorkingCapacity() const;
+        // Return the total working capacity (in bytes) of all cycles of
+        // allocations ended by calls to 'rewind'.
 };
 
 // ============================================================================
@@ -581,6 +630,12 @@ void SequentialAllocator::rewind()
     d_sequentialPool.rewind();
 }
 
+inline
+void SequentialAllocator::rewind(bsls::Types::size_type maxRetainedCapacity)
+{
+    d_sequentialPool.rewind(maxRetainedCapacity);
+}
+
 inline
 bsls::Types::size_type SequentialAllocator::truncate(
                                           void                   *address,
@@ -590,6 +645,37 @@ bsls::Types::size_type SequentialAllocator::truncate(
     return d_sequentialPool.truncate(address, originalSize, newSize);
 }
 
+// ACCESSORS
+inline
+bsls::Types::size_type SequentialAllocator::lastWorkingCapacity() const
+{
+    return d_sequentialPool.lastWorkingCapacity();
+}
+
+inline
+bsls::Types::size_type SequentialAllocator::maxWorkingCapacity() const
+{
+    return d_sequentialPool.maxWorkingCapacity();
+}
+
+inline
+bsls::Types::Int64 SequentialAllocator::numRewinds() const
+{
+    return d_sequentialPool.numRewinds();
+}
+
+inline
+bsls::Types::size_type SequentialAllocator::retainedCapacity() const
+{
+    return d_sequentialPool.retainedCapacity();
+}
+
+inline
+bsls::Types::Uint64 SequentialAllocator::totalWorkingCapacity() const
+{
+    return d_sequentialPool.totalWorkingCapacity();
+}
+
 }  // close package namespace
 }  // close enterprise namespace
 
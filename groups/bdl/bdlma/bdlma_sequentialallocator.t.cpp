@@ -76,11 +76,19 @@ using namespace bsl;
 // [ 3] void deallocate(void *address);
 // [ 4] void release();
 // [ 5] void rewind();
+// [ 8] void rewind(size_type maxRetainedCapacity);
 // [ 7] void reserveCapacity(int numBytes);
 // [ 6] int truncate(void *address, int originalSize, int newSize);
+//
+// // ACCESSORS
+// [ 8] size_type lastWorkingCapacity() const;
+// [ 8] size_type maxWorkingCapacity() const;
+// [ 8] Int64 numRewinds() const;
+// [ 8] size_type retainedCapacity() const;
+// [ 8] Uint64 totalWorkingCapacity() const;
 //-----------------------------------------------------------------------------
 // [ 1] BREATHING TEST
-// [ 8] USAGE TEST
+// [ 9] USAGE TEST
 
 //=============================================================================
 //                      STANDARD BDE ASSERT TEST MACRO
@@ -286,7 +294,7 @@ int main(int argc, char *argv[])
     bslma::Default::setGlobalAllocator(&globalAllocator);
 
     switch (test) { case 0:
-      case 8: {
+      case 9: {
         // --------------------------------------------------------------------
         // USAGE EXAMPLE
         //   Extracted from component header file.
@@ -317,6 +325,77 @@ int main(int argc, char *argv[])
 //..
 
       } break;
+      case 8: {
+        // --------------------------------------------------------------------
+        // 'rewind(maxRetainedCapacity)' AND STATISTICS TEST
+        //
+        // Concerns:
+        //: 1 'rewind(maxRetainedCapacity)' and the statistics accessors
+        //:   forward to the underlying sequential pool.
+        //:
+        //: 2 The accessors are declared 'const'.
+        //
+        // Plan:
+        //: 1 Using a test allocator, grow geometric buffers of known sizes,
+        //:   invoke 'rewind' with a 'maxRetainedCapacity' that retains only
+        //:   some of them, and verify the blocks in use by the test allocator
+        //:   and the values of the accessors, invoked through a 'const'
+        //:   reference.  (C-1..2)
+        //
+        // Testing:
+        //   void rewind(size_type maxRetainedCapacity);
+        //   size_type lastWorkingCapacity() const;
+        //   size_type maxWorkingCapacity() const;
+        //   Int64 numRewinds() const;
+        //   size_type retainedCapacity() const;
+        //   Uint64 totalWorkingCapacity() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout
+                    << endl
+                    << "'rewind(maxRetainedCapacity)' AND STATISTICS TEST"
+                    << endl
+                    << "================================================="
+                    << endl;
+
+        bslma::TestAllocator ta(veryVeryVeryVerbose);
+
+        {
+            Obj mX(&ta);  const Obj& X = mX;
+
+            ASSERT(0 == X.numRewinds());
+            ASSERT(0 == X.retainedCapacity());
+
+            // Grow buffers of 256, 1024, and 8192 bytes.
+
+            mX.allocate(100);
+            mX.allocate(1000);
+            mX.allocate(5000);
+
+            ASSERT(3    == ta.numBlocksInUse());
+            ASSERT(9472 == X.retainedCapacity());
+
+            mX.rewind(2000);
+
+            ASSERT(1    == X.numRewinds());
+            ASSERT(9472 == X.lastWorkingCapacity());
+            ASSERT(9472 == X.maxWorkingCapacity());
+            ASSERT(9472 == X.totalWorkingCapacity());
+            ASSERT(1280 == X.retainedCapacity());
+            ASSERT(2    == ta.numBlocksInUse());
+
+            mX.allocate(100);
+            mX.rewind();
+
+            ASSERT(2     == X.numRewinds());
+            ASSERT(256   == X.lastWorkingCapacity());
+            ASSERT(9472  == X.maxWorkingCapacity());
+            ASSERT(9728  == X.totalWorkingCapacity());
+            ASSERT(1280  == X.retainedCapacity());
+            ASSERT(2     == ta.numBlocksInUse());
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+      } break;
       case 7: {
         // --------------------------------------------------------------------
         // 'reserveCapacity' TEST
@@ -83,6 +83,8 @@ void *SequentialPool::allocateNonFastPath(bsls::Types::size_type size)
                                                              &block->d_memory),
                                               d_constantGrowthSize);
             }
+
+            d_statistics.d_current += d_constantGrowthSize;
         }
         else {
             // Geometric growth strategy; find bin to use.
@@ -126,6 +128,9 @@ void *SequentialPool::allocateNonFastPath(bsls::Types::size_type size)
                            static_cast<bsls::Types::size_type>(allocatedSize));
 
                 d_unavailable |= (static_cast<uint64_t>(1) << index);
+
+                d_statistics.d_current +=
+                            static_cast<bsls::Types::size_type>(allocatedSize);
             }
             else {
                 // Forward to underlying allocator.
@@ -140,6 +145,8 @@ void *SequentialPool::allocateNonFastPath(bsls::Types::size_type size)
                 d_bufferManager.replaceBuffer(reinterpret_cast<char *>(
                                                              &block->d_memory),
                                               size);
+
+                d_statistics.d_current += size;
             }
         }
 
@@ -149,6 +156,19 @@ void *SequentialPool::allocateNonFastPath(bsls::Types::size_type size)
     return 0;
 }
 
+void SequentialPool::recordRewind()
+{
+    d_statistics.d_last   = d_statistics.d_current;
+    d_statistics.d_total += d_statistics.d_current;
+    ++d_statistics.d_numRewinds;
+
+    if (d_statistics.d_max < d_statistics.d_current) {
+        d_statistics.d_max = d_statistics.d_current;
+    }
+
+    d_statistics.d_current = 0;
+}
+
 // CREATORS
 SequentialPool::SequentialPool(bslma::Allocator *basicAllocator)
 : d_bufferManager()
@@ -162,6 +182,7 @@ SequentialPool::SequentialPool(bslma::Allocator *basicAllocator)
 , d_allocated(0)
 , d_largeBlockList_p(0)
 , d_constantGrowthSize(0)
+, d_statistics()
 , d_allocator_p(bslma::Default::allocator(basicAllocator))
 {
 }
@@ -181,6 +202,7 @@ SequentialPool::SequentialPool(bsls::BlockGrowth::Strategy  growthStrategy,
 , d_constantGrowthSize(  growthStrategy == bsls::BlockGrowth::BSLS_GEOMETRIC
                        ? 0
                        : k_INITIAL_SIZE)
+, d_statistics()
 , d_allocator_p(bslma::Default::allocator(basicAllocator))
 {
 }
@@ -198,6 +220,7 @@ SequentialPool::SequentialPool(bsls::Alignment::Strategy  alignmentStrategy,
 , d_allocated(0)
 , d_largeBlockList_p(0)
 , d_constantGrowthSize(0)
+, d_statistics()
 , d_allocator_p(bslma::Default::allocator(basicAllocator))
 {
 }
@@ -218,6 +241,7 @@ SequentialPool::SequentialPool(bsls::BlockGrowth::Strategy  growthStrategy,
 , d_constantGrowthSize(  growthStrategy == bsls::BlockGrowth::BSLS_GEOMETRIC
                        ? 0
                        : k_INITIAL_SIZE)
+, d_statistics()
 , d_allocator_p(bslma::Default::allocator(basicAllocator))
 {
 }
@@ -234,6 +258,7 @@ SequentialPool::SequentialPool(int initialSize)
 , d_allocated(0)
 , d_largeBlockList_p(0)
 , d_constantGrowthSize(0)
+, d_statistics()
 , d_allocator_p(bslma::Default::allocator(0))
 {
     BSLS_ASSERT(0 < initialSize);
@@ -254,6 +279,7 @@ SequentialPool::SequentialPool(bsls::Types::size_type  initialSize,
 , d_allocated(0)
 , d_largeBlockList_p(0)
 , d_constantGrowthSize(0)
+, d_statistics()
 , d_allocator_p(bslma::Default::allocator(basicAllocator))
 {
     BSLS_ASSERT(0 < initialSize);
@@ -277,6 +303,7 @@ SequentialPool::SequentialPool(bsls::Types::size_type       initialSize,
 , d_constantGrowthSize(  growthStrategy == bsls::BlockGrowth::BSLS_GEOMETRIC
                        ? 0
                        : initialSize)
+, d_statistics()
 , d_allocator_p(bslma::Default::allocator(basicAllocator))
 {
     BSLS_ASSERT(0 < initialSize);
@@ -298,6 +325,7 @@ SequentialPool::SequentialPool(bsls::Types::size_type     initialSize,
 , d_allocated(0)
 , d_largeBlockList_p(0)
 , d_constantGrowthSize(0)
+, d_statistics()
 , d_allocator_p(bslma::Default::allocator(basicAllocator))
 {
     BSLS_ASSERT(0 < initialSize);
@@ -322,6 +350,7 @@ SequentialPool::SequentialPool(bsls::Types::size_type       initialSize,
 , d_constantGrowthSize(  growthStrategy == bsls::BlockGrowth::BSLS_GEOMETRIC
                        ? 0
                        : initialSize)
+, d_statistics()
 , d_allocator_p(bslma::Default::allocator(basicAllocator))
 {
     BSLS_ASSERT(0 < initialSize);
@@ -346,6 +375,7 @@ SequentialPool::SequentialPool(bsls::Types::size_type  initialSize,
 , d_allocated(0)
 , d_largeBlockList_p(0)
 , d_constantGrowthSize(0)
+, d_statistics()
 , d_allocator_p(bslma::Default::allocator(basicAllocator))
 {
     BSLS_ASSERT(0           <  initialSize);
@@ -374,6 +404,7 @@ SequentialPool::SequentialPool(bsls::Types::size_type       initialSize,
 , d_constantGrowthSize(  growthStrategy == bsls::BlockGrowth::BSLS_GEOMETRIC
                        ? 0
                        : initialSize)
+, d_statistics()
 , d_allocator_p(bslma::Default::allocator(basicAllocator))
 {
     BSLS_ASSERT(0           <  initialSize);
@@ -400,6 +431,7 @@ SequentialPool::SequentialPool(bsls::Types::size_type     initialSize,
 , d_allocated(0)
 , d_largeBlockList_p(0)
 , d_constantGrowthSize(0)
+, d_statistics()
 , d_allocator_p(bslma::Default::allocator(basicAllocator))
 {
     BSLS_ASSERT(0           <  initialSize);
@@ -429,6 +461,7 @@ SequentialPool::SequentialPool(bsls::Types::size_type       initialSize,
 , d_constantGrowthSize(  growthStrategy == bsls::BlockGrowth::BSLS_GEOMETRIC
                        ? 0
                        : initialSize)
+, d_statistics()
 , d_allocator_p(bslma::Default::allocator(basicAllocator))
 {
     BSLS_ASSERT(0           <  initialSize);
@@ -460,6 +493,7 @@ SequentialPool::SequentialPool(
 , d_constantGrowthSize(  growthStrategy == bsls::BlockGrowth::BSLS_GEOMETRIC
                        ? 0
                        : initialSize)
+, d_statistics()
 , d_allocator_p(bslma::Default::allocator(basicAllocator))
 {
     BSLS_ASSERT(0           <  initialSize);
@@ -508,6 +542,8 @@ void SequentialPool::release()
         d_largeBlockList_p = d_largeBlockList_p->d_next_p;
         d_allocator_p->deallocate(lastBlock);
     }
+
+    d_statistics.d_current = 0;
 }
 
 void SequentialPool::reserveCapacity(bsls::Types::size_type numBytes)
@@ -576,12 +612,16 @@ void SequentialPool::reserveCapacity(bsls::Types::size_type numBytes)
             d_bufferManager.replaceBuffer(reinterpret_cast<char *>(
                                                              &block->d_memory),
                                           numBytes);
+
+            d_statistics.d_current += numBytes;
         }
     }
 }
 
 void SequentialPool::rewind()
 {
+    recordRewind();
+
     // Set 'd_bufferManager' to not manage any memory.
 
     d_bufferManager.reset();
@@ -604,6 +644,74 @@ void SequentialPool::rewind()
     }
 }
 
+void SequentialPool::rewind(bsls::Types::size_type maxRetainedCapacity)
+{
+    rewind();
+
+    bsls::Types::Uint64 retainedCapacity = 0;
+
+    // Retain the constant growth blocks, in the order in which they were
+    // first used, while they fit within 'maxRetainedCapacity', and return the
+    // remainder of the list to the underlying allocator.
+
+    Block **prevAddr = &d_head_p;
+    while (*prevAddr
+        && retainedCapacity + d_constantGrowthSize <= maxRetainedCapacity) {
+        retainedCapacity += d_constantGrowthSize;
+        prevAddr          = &(*prevAddr)->d_next_p;
+    }
+
+    Block *block = *prevAddr;
+    *prevAddr    = 0;
+
+    while (block) {
+        void *lastBlock = block;
+        block           = block->d_next_p;
+        d_allocator_p->deallocate(lastBlock);
+    }
+
+    // Retain the geometric growth blocks, smallest first, while they fit
+    // within 'maxRetainedCapacity', and return the others to the underlying
+    // allocator.
+
+    uint64_t toDeallocate = 0;
+    uint64_t allocated    = d_allocated;
+
+    while (allocated) {
+        int      i    = bdlb::BitUtil::numTrailingUnsetBits(allocated);
+        uint64_t size = static_cast<uint64_t>(1) << i;
+
+        allocated = bdlb::BitUtil::withBitCleared(allocated, i);
+
+        if (retainedCapacity + size <= maxRetainedCapacity) {
+            retainedCapacity += size;
+        }
+        else {
+            toDeallocate |= size;
+        }
+    }
+
+    while (toDeallocate) {
+        int i = bdlb::BitUtil::numTrailingUnsetBits(toDeallocate);
+        d_allocator_p->deallocate(d_geometricBin[i]);
+        d_allocated  = bdlb::BitUtil::withBitCleared(d_allocated, i);
+        toDeallocate = bdlb::BitUtil::withBitCleared(toDeallocate, i);
+    }
+}
+
+// ACCESSORS
+bsls::Types::size_type SequentialPool::retainedCapacity() const
+{
+    bsls::Types::size_type result = static_cast<bsls::Types::size_type>(
+                                                                 d_allocated);
+
+    for (const Block *block = d_head_p; block; block = block->d_next_p) {
+        result += d_constantGrowthSize;
+    }
+
+    return result;
+}
+
 }  // close package namespace
 }  // close enterprise namespace
 
@@ -23,7 +23,9 @@ BSLS_IDENT("$Id: $")
 // as does the destructor.  The 'rewind' method releases all memory allocated
 // through the pool and returns to the underlying allocator *only* memory that
 // was allocated outside of the typical internal buffer growth of the pool
-// (i.e., large blocks).  Note that individually allocated memory blocks cannot
+// (i.e., large blocks), and an overload of 'rewind' additionally returns the
+// internal buffers in excess of a specified capacity (see {Rewinding with a
+// Retained Capacity}).  Note that individually allocated memory blocks cannot
 // be separately deallocated.
 //
 // A 'bdlma::SequentialPool' is typically used when fast allocation and
@@ -65,6 +67,32 @@ BSLS_IDENT("$Id: $")
 // 'alignmentStrategy' is not specified, natural alignment is used.  See
 // 'bsls_alignment' for more details.
 //
+///Rewinding with a Retained Capacity
+///----------------------------------
+// A sequential pool is often used as a per-request arena: memory is allocated
+// while a request is processed, and all of it is reclaimed at once when the
+// request completes.  'rewind()' retains all of the internal buffers for
+// reuse, so that the memory held by the pool never shrinks below the peak
+// reached by the largest request processed so far, whereas 'release()' returns
+// all of the buffers, so that every request allocates its buffers from the
+// underlying allocator anew.  'rewind(maxRetainedCapacity)' is a middle
+// ground: it retains a "warm" set of internal buffers whose total size is at
+// most 'maxRetainedCapacity', typically chosen to satisfy the common request
+// without replenishment, and returns the other buffers -- those grown by
+// unusually large requests -- to the underlying allocator.  Note that whether
+// the physical memory is then returned to the operating system depends on the
+// underlying allocator; e.g., 'bdlma::HugePageAllocator' (and the 'malloc' of
+// most platforms) unmap large blocks as soon as they are deallocated.
+//
+// To help tune 'maxRetainedCapacity' (and 'initialSize'), the pool records the
+// *working* *capacity* of each cycle of allocations ended by a call to either
+// overload of 'rewind': the total size of the internal buffers, and large
+// blocks, that supplied memory during the cycle.  The 'numRewinds',
+// 'lastWorkingCapacity', 'maxWorkingCapacity', and 'totalWorkingCapacity'
+// accessors report these statistics (the mean working capacity being
+// 'totalWorkingCapacity() / numRewinds()'), and 'retainedCapacity' reports the
+// total size of the internal buffers currently held by the pool.
+//
 ///Usage
 ///-----
 // This section illustrates intended use of this component.
@@ -343,6 +371,25 @@ class SequentialPool {
 
     typedef bsl::uint64_t uint64_t;  // to support old toolchains
 
+    struct Statistics {
+        // This 'struct' records the working capacity of the cycles of
+        // allocations ended by calls to 'rewind'.
+
+        bsls::Types::size_type d_current;     // working capacity of the
+                                              // current cycle
+
+        bsls::Types::size_type d_last;        // working capacity of the last
+                                              // completed cycle
+
+        bsls::Types::size_type d_max;         // maximum working capacity of
+                                              // any completed cycle
+
+        bsls::Types::Uint64    d_total;       // total working capacity of all
+                                              // completed cycles
+
+        bsls::Types::Int64     d_numRewinds;  // number of completed cycles
+    };
+
     // DATA
     BufferManager                  d_bufferManager;  // memory manager for
                                                      // current buffer
@@ -390,6 +437,10 @@ class SequentialPool {
                                                      // and 0 when using
                                                      // geometric growth
 
+    Statistics                     d_statistics;     // working capacity of
+                                                     // the cycles ended by
+                                                     // 'rewind'
+
     bslma::Allocator              *d_allocator_p;    // memory allocator (held,
                                                      // not owned)
 
@@ -403,6 +454,10 @@ class SequentialPool {
         // construction.  If 'size' is 0, no memory is allocated and 0 is
         // returned.
 
+    void recordRewind();
+        // Record the working capacity of the cycle of allocations ended by a
+        // call to 'rewind', and start a new cycle.
+
     // NOT IMPLEMENTED
     SequentialPool(const SequentialPool&);
     SequentialPool& operator=(const SequentialPool&);
@@ -570,6 +625,22 @@ class SequentialPool {
         // a pointer obtained from this object prior to this call to 'rewind'
         // is undefined.
 
+    void rewind(bsls::Types::size_type maxRetainedCapacity);
+        // Release all memory allocated through this pool, return to the
+        // underlying allocator all memory that was allocated outside of the
+        // typical internal buffer growth of this pool (i.e., large blocks),
+        // and retain for subsequent allocations only the internal buffers
+        // whose total size does not exceed the specified
+        // 'maxRetainedCapacity' (in bytes), returning the other internal
+        // buffers to the underlying allocator.  Buffers of geometric growth
+        // are retained smallest first, and buffers of constant growth in the
+        // order in which they were first used.  The effect of subsequently -
+        // to this invokation of 'rewind' - using a pointer obtained from this
+        // object prior to this call to 'rewind' is undefined.  Note that
+        // 'rewind(0)' returns all memory to the underlying allocator, as
+        // 'release' does, but, like 'rewind()', records the working capacity
+        // of the cycle it ends.
+
     void reserveCapacity(bsls::Types::size_type numBytes);
         // Reserve sufficient memory to satisfy allocation requests for at
         // least the specified 'numBytes' without replenishment (i.e., without
@@ -594,6 +665,30 @@ class SequentialPool {
         // 'release' was not called after allocating the memory block at
         // 'address'.
 
+    // ACCESSORS
+    bsls::Types::size_type lastWorkingCapacity() const;
+        // Return the working capacity (in bytes) of the cycle of allocations
+        // ended by the most recent call to 'rewind', or 0 if 'rewind' has not
+        // been called.  See {Rewinding with a Retained Capacity}.
+
+    bsls::Types::size_type maxWorkingCapacity() const;
+        // Return the maximum working capacity (in bytes) of any cycle of
+        // allocations ended by a call to 'rewind', or 0 if 'rewind' has not
+        // been called.
+
+    bsls::Types::Int64 numRewinds() const;
+        // Return the number of times 'rewind' has been called on this pool.
+
+    bsls::Types::size_type retainedCapacity() const;
+        // Return the total size (in bytes) of the internal buffers currently
+        // held by this pool, whether or not they have supplied memory since
+        // the last call to 'rewind', excluding large blocks.  Note that this
+        // is the amount of memory 'rewind()' would retain.
+
+    bsls::Types::Uint64 totalWorkingCapacity() const;
+        // Return the total working capacity (in bytes) of all cycles of
+        // allocations ended by calls to 'rewind'.
+
                                   // Aspects
 
     bslma::Allocator *allocator() const;
@@ -739,6 +834,31 @@ bsls::Types::size_type SequentialPool::truncate(
     return d_bufferManager.truncate(address, originalSize, newSize);
 }
 
+// ACCESSORS
+inline
+bsls::Types::size_type SequentialPool::lastWorkingCapacity() const
+{
+    return d_statistics.d_last;
+}
+
+inline
+bsls::Types::size_type SequentialPool::maxWorkingCapacity() const
+{
+    return d_statistics.d_max;
+}
+
+inline
+bsls::Types::Int64 SequentialPool::numRewinds() const
+{
+    return d_statistics.d_numRewinds;
+}
+
+inline
+bsls::Types::Uint64 SequentialPool::totalWorkingCapacity() const
+{
+    return d_statistics.d_total;
+}
+
 // Aspects
 
 inline
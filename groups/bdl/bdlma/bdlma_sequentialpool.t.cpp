@@ -36,11 +36,13 @@ using namespace bsl;
 // create 12 variations of the constructor, and they must all be thoroughly
 // tested.
 //
-// Because 'bdlma::SequentialPool' does not have any accessors, this test
-// driver verifies the correctness of the pool's allocations *indirectly*
-// through the use of two consecutive allocations -- where the first allocation
-// tests for correctness of 'allocate', and the second verifies the size of the
-// first allocation and its memory alignment.
+// Because 'bdlma::SequentialPool' does not have any accessors for its
+// allocations (its only accessors report the working capacity recorded by
+// 'rewind' and the retained capacity), this test driver verifies the
+// correctness of the pool's allocations *indirectly* through the use of two
+// consecutive allocations -- where the first allocation tests for correctness
+// of 'allocate', and the second verifies the size of the first allocation and
+// its memory alignment.
 //
 // We make heavy use of the 'bslma::TestAllocator' to ensure that:
 //
@@ -86,14 +88,22 @@ using namespace bsl;
 // [ 6] void deleteObject(const TYPE *object);
 // [ 5] void release();
 // [11] void rewind();
+// [13] void rewind(size_type maxRetainedCapacity);
 // [ 9] void reserveCapacity(int numBytes);
 // [ 8] int truncate(void *address, int originalSize, int newSize);
+//
+// // ACCESSORS
+// [13] size_type lastWorkingCapacity() const;
+// [13] size_type maxWorkingCapacity() const;
+// [13] Int64 numRewinds() const;
+// [13] size_type retainedCapacity() const;
+// [13] Uint64 totalWorkingCapacity() const;
 // [12] bslma::Allocator *allocator() const;
 //-----------------------------------------------------------------------------
 // [ 1] BREATHING TEST
 // [ 2] HELPER FUNCTION: 'int blockSize(numBytes)'
 // [10] FREE FUNCTION: 'operator new(size_t, bdlma::SequentialPool)'
-// [13] USAGE EXAMPLE
+// [14] USAGE EXAMPLE
 
 //=============================================================================
 //                      STANDARD BDE ASSERT TEST MACRO
@@ -467,7 +477,7 @@ int main(int argc, char *argv[])
     bslma::Default::setGlobalAllocator(&globalAllocator);
 
     switch (test) { case 0:
-      case 13: {
+      case 14: {
         // --------------------------------------------------------------------
         // USAGE EXAMPLE
         //   Extracted from component header file.
@@ -490,6 +500,204 @@ int main(int argc, char *argv[])
                           << "=============" << endl;
 
       } break;
+      case 13: {
+        // --------------------------------------------------------------------
+        // TESTING 'rewind(maxRetainedCapacity)' AND STATISTICS
+        //
+        // Concerns:
+        //: 1 'rewind(maxRetainedCapacity)' returns large blocks, and the
+        //:   internal buffers in excess of 'maxRetainedCapacity', to the
+        //:   underlying allocator, and retains the others.
+        //:
+        //: 2 Geometric growth buffers are retained smallest first, and
+        //:   constant growth buffers in the order in which they were first
+        //:   used.
+        //:
+        //: 3 Retained buffers are reused by subsequent allocations.
+        //:
+        //: 4 The working capacity of each cycle of allocations, including the
+        //:   sizes of large blocks, is recorded by both overloads of 'rewind',
+        //:   but not by 'release'.
+        //:
+        //: 5 'retainedCapacity' reports the total size of the internal
+        //:   buffers held by the pool, excluding large blocks.
+        //:
+        //: 6 The accessors are declared 'const'.
+        //
+        // Plan:
+        //: 1 Using a 'bslma::TestAllocator', allocate from pools of both
+        //:   growth strategies, and from a pool having a maximum buffer size,
+        //:   sequences of sizes that each grow an internal buffer (or a large
+        //:   block) of known size.  Invoke 'rewind' with various values of
+        //:   'maxRetainedCapacity' and verify the number of blocks and bytes
+        //:   in use by the test allocator, the addresses returned by
+        //:   subsequent allocations, and the values of the accessors, invoked
+        //:   through a 'const' reference.  (C-1..6)
+        //
+        // Testing:
+        //   void rewind(size_type maxRetainedCapacity);
+        //   size_type lastWorkingCapacity() const;
+        //   size_type maxWorkingCapacity() const;
+        //   Int64 numRewinds() const;
+        //   size_type retainedCapacity() const;
+        //   Uint64 totalWorkingCapacity() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout
+                 << endl
+                 << "TESTING 'rewind(maxRetainedCapacity)' AND STATISTICS"
+                 << endl
+                 << "===================================================="
+                 << endl;
+
+        if (verbose) cout << "\nTesting geometric growth." << endl;
+        {
+            bslma::TestAllocator ta("geometric", veryVeryVeryVerbose);
+
+            Obj mX(&ta);  const Obj& X = mX;
+
+            ASSERT(0 == X.numRewinds());
+            ASSERT(0 == X.lastWorkingCapacity());
+            ASSERT(0 == X.maxWorkingCapacity());
+            ASSERT(0 == X.totalWorkingCapacity());
+            ASSERT(0 == X.retainedCapacity());
+
+            // Grow buffers of 256, 1024, and 8192 bytes.
+
+            void *p = mX.allocate(100);
+            mX.allocate(1000);
+            mX.allocate(5000);
+
+            ASSERTV(X.retainedCapacity(), 9472 == X.retainedCapacity());
+            ASSERT(3    == ta.numBlocksInUse());
+            ASSERT(0    == X.numRewinds());
+
+            mX.rewind(2000);
+
+            ASSERT(1    == X.numRewinds());
+            ASSERTV(X.lastWorkingCapacity(),
+                    9472 == X.lastWorkingCapacity());
+            ASSERT(9472 == X.maxWorkingCapacity());
+            ASSERT(9472 == X.totalWorkingCapacity());
+
+            ASSERTV(X.retainedCapacity(), 1280 == X.retainedCapacity());
+            ASSERT(2    == ta.numBlocksInUse());
+            ASSERT(1280 == ta.numBytesInUse());
+
+            bsls::Types::Int64 numBlocksTotal = ta.numBlocksTotal();
+
+            ASSERT(p == mX.allocate(100));
+            mX.allocate(1000);
+            ASSERT(numBlocksTotal == ta.numBlocksTotal());
+
+            mX.rewind();
+
+            ASSERT(2     == X.numRewinds());
+            ASSERT(1280  == X.lastWorkingCapacity());
+            ASSERT(9472  == X.maxWorkingCapacity());
+            ASSERT(10752 == X.totalWorkingCapacity());
+            ASSERT(1280  == X.retainedCapacity());
+            ASSERT(2     == ta.numBlocksInUse());
+
+            // The 8192-byte buffer is grown anew.
+
+            mX.allocate(5000);
+            ASSERT(numBlocksTotal + 1 == ta.numBlocksTotal());
+
+            mX.rewind(0);
+
+            ASSERT(3     == X.numRewinds());
+            ASSERT(8192  == X.lastWorkingCapacity());
+            ASSERT(9472  == X.maxWorkingCapacity());
+            ASSERT(18944 == X.totalWorkingCapacity());
+            ASSERT(0     == X.retainedCapacity());
+            ASSERT(0     == ta.numBlocksInUse());
+
+            // 'release' does not record a cycle.
+
+            mX.allocate(100);
+            mX.release();
+            mX.rewind();
+
+            ASSERT(4     == X.numRewinds());
+            ASSERT(0     == X.lastWorkingCapacity());
+            ASSERT(18944 == X.totalWorkingCapacity());
+        }
+        ASSERT(0 == defaultAllocator.numBlocksTotal());
+
+        if (verbose) cout << "\nTesting constant growth." << endl;
+        {
+            bslma::TestAllocator ta("constant", veryVeryVeryVerbose);
+
+            Obj mX(bsls::BlockGrowth::BSLS_CONSTANT, &ta);  const Obj& X = mX;
+
+            // Grow three constant buffers of 256 bytes.
+
+            void *p1 = mX.allocate(200);
+            void *p2 = mX.allocate(200);
+            mX.allocate(200);
+
+            ASSERT(3   == ta.numBlocksInUse());
+            ASSERT(768 == X.retainedCapacity());
+
+            mX.rewind(600);
+
+            ASSERT(768 == X.lastWorkingCapacity());
+            ASSERT(512 == X.retainedCapacity());
+            ASSERT(2   == ta.numBlocksInUse());
+
+            bsls::Types::Int64 numBlocksTotal = ta.numBlocksTotal();
+
+            ASSERT(p1 == mX.allocate(200));
+            ASSERT(p2 == mX.allocate(200));
+            ASSERT(numBlocksTotal == ta.numBlocksTotal());
+
+            mX.allocate(200);
+            ASSERT(numBlocksTotal + 1 == ta.numBlocksTotal());
+            ASSERT(768                == X.retainedCapacity());
+
+            mX.rewind(255);
+
+            ASSERT(0 == X.retainedCapacity());
+            ASSERT(0 == ta.numBlocksInUse());
+        }
+        ASSERT(0 == defaultAllocator.numBlocksTotal());
+
+        if (verbose) cout << "\nTesting large blocks." << endl;
+        {
+            bslma::TestAllocator ta("large", veryVeryVeryVerbose);
+
+            Obj mX(256, 1024, &ta);  const Obj& X = mX;
+
+            // The initial 256-byte buffer is reserved, but has not supplied
+            // memory.
+
+            ASSERT(1   == ta.numBlocksInUse());
+            ASSERT(256 == X.retainedCapacity());
+
+            void *p = mX.allocate(4096);
+
+            ASSERT(2   == ta.numBlocksInUse());
+            ASSERT(256 == X.retainedCapacity());
+
+            mX.rewind(1024);
+
+            ASSERT(4096 == X.lastWorkingCapacity());
+            ASSERT(256  == X.retainedCapacity());
+            ASSERT(1    == ta.numBlocksInUse());
+
+            ASSERT(p != mX.allocate(100));
+            ASSERT(1 == ta.numBlocksInUse());
+
+            mX.rewind(1024);
+
+            ASSERT(2    == X.numRewinds());
+            ASSERT(256  == X.lastWorkingCapacity());
+            ASSERT(4096 == X.maxWorkingCapacity());
+            ASSERT(4352 == X.totalWorkingCapacity());
+        }
+        ASSERT(0 == defaultAllocator.numBlocksTotal());
+      } break;
       case 12: {
         // --------------------------------------------------------------------
         // ALLOCATOR ACCESSOR TEST
@@ -0,0 +1,599 @@
+// bdlma_threadcachingmultipoolallocator.cpp                          -*-C++-*-
+#include <bdlma_threadcachingmultipoolallocator.h>
+
+#include <bsls_ident.h>
+BSLS_IDENT_RCSID(bdlma_threadcachingmultipoolallocator_cpp,"$Id$ $CSID$")
+
+#include <bdlb_bitutil.h>
+
+#include <bslma_newdeleteallocator.h>
+
+#include <bslmt_lockguard.h>
+#include <bslmt_once.h>
+#include <bslmt_qlock.h>
+#include <bslmt_threadutil.h>
+
+#include <bsls_assert.h>
+#include <bsls_performancehint.h>
+
+#include <bsl_cstdint.h>
+
+#include <new>  // placement 'new'
+
+///IMPLEMENTATION NOTES
+///--------------------
+// The size class 'c' is served by the blocks of the underlying multipool
+// having the size '2^(d_minSizeClassLog2 + c)', where
+// '2^d_minSizeClassLog2 == 2 * sizeof(Header)', so that a request for such a
+// block is served by exactly one pool of the multipool without rounding, and
+// the user part of the smallest block can hold the same number of bytes as
+// the header.
+//
+// A block held in a magazine links to the next block of the magazine through
+// 'd_links.d_next_p' of its header, and a full magazine held in a depot links
+// to the next magazine of the depot through 'd_links.d_nextMagazine_p' of the
+// header of its first block.  The size class stored in the header of an
+// allocated block is written when the block is dispensed, over the links.
+//
+// A thread cache is allocated from the basic allocator (through the adapter
+// serializing its use), rather than from the multipool, so that it survives
+// 'release', which empties (but cannot deallocate) the caches of all threads,
+// since the thread-specific storage of other threads cannot be modified.
+//
+// The value of the thread-specific storage key shared by all allocators,
+// 's_key', is the list of the caches of a thread, linked through
+// 'd_nextInThread_p', which only that thread reads or modifies.  A cache is
+// moved to the front of the list when it is looked up, so that a thread using
+// mostly one allocator finds its cache after a single comparison of the
+// owner.  A list is modified only after the list of the thread is set to the
+// new front of the list, so that a failure to set it leaves the list intact.
+//
+// An allocator cannot unlink its caches from the lists of other threads, so
+// its destructor deallocates their magazines and clears their owner (with
+// release semantics, as the last access to each cache), and the thread of
+// each cache deallocates it when the thread finds it has no owner (with
+// acquire semantics), while looking up another cache or at exit.  Since a
+// cache may outlive its owner, and the basic allocator of that owner, it is
+// allocated from 'bslma::NewDeleteAllocator'.  The destructor of an allocator
+// and the retirement of the caches of an exiting thread are serialized by
+// 's_ownersLock', so that an exiting thread either returns its blocks to a
+// live allocator, or finds that the allocator was destroyed.
+
+namespace BloombergLP {
+namespace bdlma {
+namespace {
+
+static bslmt::QLock s_ownersLock = BSLMT_QLOCK_INITIALIZER;
+    // The lock serializing the destruction of the caches of an allocator by
+    // its destructor and by exiting threads.
+
+static bslmt::ThreadUtil::Key s_key;
+    // The thread-specific storage key, shared by all allocators, of the list
+    // of caches of each thread.
+
+static bool s_hasKey = false;
+    // 'true' if 's_key' was successfully created.
+
+enum {
+    k_DEFAULT_NUM_POOLS         = 10,  // as for 'ConcurrentMultipool'
+
+    k_DEFAULT_MAGAZINE_CAPACITY = 32,
+
+    k_MIN_BLOCK_SIZE            = 8    // block size of the first pool of
+                                       // 'ConcurrentMultipool'
+};
+
+}  // close unnamed namespace
+
+                   // -------------------------------------
+                   // class ThreadCachingMultipoolAllocator
+                   // -------------------------------------
+
+// PRIVATE CLASS METHODS
+inline
+ThreadCachingMultipoolAllocator *
+ThreadCachingMultipoolAllocator::owner(const ThreadCache *cache)
+{
+    return static_cast<ThreadCachingMultipoolAllocator *>(
+                      bsls::AtomicOperations::getPtrAcquire(&cache->d_owner));
+}
+
+void ThreadCachingMultipoolAllocator::retireThreadCaches(void *caches)
+{
+    ThreadCache *cache = static_cast<ThreadCache *>(caches);
+
+    while (cache) {
+        ThreadCache *next = cache->d_nextInThread_p;
+        {
+            bslmt::QLockGuard guard(&s_ownersLock);
+
+            ThreadCachingMultipoolAllocator *cacheOwner = owner(cache);
+            if (cacheOwner) {
+                cacheOwner->drainMagazines(cache);
+                cacheOwner->destroyThreadCache(cache);
+            }
+        }
+        bslma::NewDeleteAllocator::singleton().deallocate(cache);
+        cache = next;
+    }
+}
+
+// PRIVATE MANIPULATORS
+ThreadCachingMultipoolAllocator::Header *
+ThreadCachingMultipoolAllocator::allocateFromDepot(Magazine *magazine,
+                                                   int       sizeClass)
+{
+    BSLS_ASSERT(0 == magazine->d_length);
+
+    Depot&  depot = d_depots_p[sizeClass];
+    Header *block;
+    {
+        bslmt::LockGuard<bslmt::Mutex> guard(&depot.d_mutex);
+
+        block = depot.d_magazines_p;
+        if (block) {
+            depot.d_magazines_p = block->d_links.d_nextMagazine_p;
+            --depot.d_numMagazines;
+        }
+    }
+
+    if (block) {
+        magazine->d_head_p = block->d_links.d_next_p;
+        magazine->d_length = d_magazineCapacity - 1;
+        return block;                                                 // RETURN
+    }
+
+    return static_cast<Header *>(d_multipool.allocate(
+                   static_cast<bsls::Types::size_type>(1)
+                                         << (d_minSizeClassLog2 + sizeClass)));
+}
+
+ThreadCachingMultipoolAllocator::ThreadCache *
+ThreadCachingMultipoolAllocator::createThreadCache()
+{
+    ThreadCache *cache = static_cast<ThreadCache *>(
+               bslma::NewDeleteAllocator::singleton().allocate(sizeof *cache));
+
+    bsls::AtomicOperations::initPointer(&cache->d_owner, this);
+    cache->d_magazines_p    = 0;
+    cache->d_prev_p         = 0;
+    cache->d_nextInThread_p = 0;
+    if (d_numSizeClasses) {
+        cache->d_magazines_p = static_cast<Magazine *>(
+            d_allocAdapter.allocate(d_numSizeClasses * sizeof(Magazine)));
+
+        for (int i = 0; i < d_numSizeClasses; ++i) {
+            cache->d_magazines_p[i].d_head_p = 0;
+            cache->d_magazines_p[i].d_length = 0;
+        }
+    }
+
+    {
+        bslmt::LockGuard<bslmt::Mutex> guard(&d_cachesMutex);
+
+        cache->d_next_p = d_caches_p;
+        if (d_caches_p) {
+            d_caches_p->d_prev_p = cache;
+        }
+        d_caches_p = cache;
+    }
+
+    return cache;
+}
+
+void ThreadCachingMultipoolAllocator::destroyThreadCache(ThreadCache *cache)
+{
+    {
+        bslmt::LockGuard<bslmt::Mutex> guard(&d_cachesMutex);
+
+        if (cache->d_prev_p) {
+            cache->d_prev_p->d_next_p = cache->d_next_p;
+        }
+        else {
+            d_caches_p = cache->d_next_p;
+        }
+        if (cache->d_next_p) {
+            cache->d_next_p->d_prev_p = cache->d_prev_p;
+        }
+    }
+
+    if (cache->d_magazines_p) {
+        d_allocAdapter.deallocate(cache->d_magazines_p);
+        cache->d_magazines_p = 0;
+    }
+    bsls::AtomicOperations::setPtrRelease(&cache->d_owner, 0);
+}
+
+void ThreadCachingMultipoolAllocator::drainMagazines(ThreadCache *cache)
+{
+    for (int i = 0; i < d_numSizeClasses; ++i) {
+        Magazine& magazine = cache->d_magazines_p[i];
+
+        if (d_magazineCapacity == magazine.d_length) {
+            flushToDepot(&magazine, i);
+        }
+        else {
+            while (magazine.d_head_p) {
+                Header *block      = magazine.d_head_p;
+                magazine.d_head_p = block->d_links.d_next_p;
+                d_multipool.deallocate(block);
+            }
+            magazine.d_length = 0;
+        }
+    }
+}
+
+void ThreadCachingMultipoolAllocator::flushToDepot(Magazine *magazine,
+                                                   int       sizeClass)
+{
+    BSLS_ASSERT(d_magazineCapacity == magazine->d_length);
+
+    Depot& depot = d_depots_p[sizeClass];
+    {
+        bslmt::LockGuard<bslmt::Mutex> guard(&depot.d_mutex);
+
+        magazine->d_head_p->d_links.d_nextMagazine_p = depot.d_magazines_p;
+        depot.d_magazines_p = magazine->d_head_p;
+        ++depot.d_numMagazines;
+    }
+
+    magazine->d_head_p = 0;
+    magazine->d_length = 0;
+}
+
+void ThreadCachingMultipoolAllocator::initialize()
+{
+    d_minSizeClassLog2 = bdlb::BitUtil::log2(
+                               static_cast<bsl::uint64_t>(2 * sizeof(Header)));
+
+    d_numSizeClasses = 0;
+    for (int i = 0; i < d_multipool.numPools(); ++i) {
+        if ((k_MIN_BLOCK_SIZE << i) >= (1 << d_minSizeClassLog2)) {
+            ++d_numSizeClasses;
+        }
+    }
+
+    d_maxCachedBlockSize = 0;
+    if (0 == d_numSizeClasses) {
+        return;                                                       // RETURN
+    }
+
+    d_maxCachedBlockSize = (static_cast<bsls::Types::size_type>(1)
+                             << (d_minSizeClassLog2 + d_numSizeClasses - 1))
+                         - sizeof(Header);
+
+    d_depots_p = static_cast<Depot *>(
+                    d_allocAdapter.allocate(d_numSizeClasses * sizeof(Depot)));
+
+    for (int i = 0; i < d_numSizeClasses; ++i) {
+        new (d_depots_p + i) Depot();
+        d_depots_p[i].d_magazines_p  = 0;
+        d_depots_p[i].d_numMagazines = 0;
+    }
+
+    BSLMT_ONCE_DO {
+        s_hasKey = 0 == bslmt::ThreadUtil::createKey(
+                        &s_key,
+                        (bslmt::ThreadUtil::Destructor) &retireThreadCaches);
+    }
+    d_hasKey = s_hasKey;
+}
+
+ThreadCachingMultipoolAllocator::ThreadCache *
+ThreadCachingMultipoolAllocator::lookUpThreadCache(ThreadCache *caches)
+{
+    ThreadCache **link = &caches;
+    while (*link && this != owner(*link)) {
+        link = &(*link)->d_nextInThread_p;
+    }
+
+    const bool   isFound = 0 != *link;
+    ThreadCache *cache   = isFound ? *link : createThreadCache();
+
+    if (0 != bslmt::ThreadUtil::setSpecific(s_key, cache)) {
+        if (!isFound) {
+            destroyThreadCache(cache);
+            bslma::NewDeleteAllocator::singleton().deallocate(cache);
+        }
+        return 0;                                                     // RETURN
+    }
+
+    if (isFound) {
+        *link = cache->d_nextInThread_p;
+    }
+
+    // Append the other caches to 'cache', deallocating those having no owner.
+
+    ThreadCache **tail = &cache->d_nextInThread_p;
+    while (caches) {
+        ThreadCache *next = caches->d_nextInThread_p;
+        if (owner(caches)) {
+            *tail = caches;
+            tail  = &caches->d_nextInThread_p;
+        }
+        else {
+            bslma::NewDeleteAllocator::singleton().deallocate(caches);
+        }
+        caches = next;
+    }
+    *tail = 0;
+
+    return cache;
+}
+
+inline
+ThreadCachingMultipoolAllocator::ThreadCache *
+ThreadCachingMultipoolAllocator::threadCache()
+{
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(!d_hasKey)) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+        return 0;                                                     // RETURN
+    }
+
+    ThreadCache *caches = static_cast<ThreadCache *>(
+                                       bslmt::ThreadUtil::getSpecific(s_key));
+
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(!caches
+                                              || this != owner(caches))) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+        return lookUpThreadCache(caches);                             // RETURN
+    }
+    return caches;
+}
+
+// PRIVATE ACCESSORS
+inline
+int ThreadCachingMultipoolAllocator::findSizeClass(
+                                            bsls::Types::size_type size) const
+{
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(size > d_maxCachedBlockSize)) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+        return -1;                                                    // RETURN
+    }
+
+    const int sizeClass = bdlb::BitUtil::log2(
+                            static_cast<bsl::uint64_t>(size + sizeof(Header)))
+                        - d_minSizeClassLog2;
+
+    return sizeClass < 0 ? 0 : sizeClass;
+}
+
+ThreadCachingMultipoolAllocator::ThreadCache *
+ThreadCachingMultipoolAllocator::findThreadCache() const
+{
+    if (!d_hasKey) {
+        return 0;                                                     // RETURN
+    }
+
+    ThreadCache *cache = static_cast<ThreadCache *>(
+                                       bslmt::ThreadUtil::getSpecific(s_key));
+    while (cache && this != owner(cache)) {
+        cache = cache->d_nextInThread_p;
+    }
+    return cache;
+}
+
+// CREATORS
+ThreadCachingMultipoolAllocator::ThreadCachingMultipoolAllocator(
+                                              bslma::Allocator *basicAllocator)
+: d_allocAdapter(&d_mutex, basicAllocator)
+, d_multipool(k_DEFAULT_NUM_POOLS, &d_allocAdapter)
+, d_magazineCapacity(k_DEFAULT_MAGAZINE_CAPACITY)
+, d_depots_p(0)
+, d_hasKey(false)
+, d_caches_p(0)
+{
+    initialize();
+}
+
+ThreadCachingMultipoolAllocator::ThreadCachingMultipoolAllocator(
+                                              int               numPools,
+                                              bslma::Allocator *basicAllocator)
+: d_allocAdapter(&d_mutex, basicAllocator)
+, d_multipool(numPools, &d_allocAdapter)
+, d_magazineCapacity(k_DEFAULT_MAGAZINE_CAPACITY)
+, d_depots_p(0)
+, d_hasKey(false)
+, d_caches_p(0)
+{
+    BSLS_ASSERT(1 <= numPools);
+
+    initialize();
+}
+
+ThreadCachingMultipoolAllocator::ThreadCachingMultipoolAllocator(
+                                            int               numPools,
+                                            int               magazineCapacity,
+                                            bslma::Allocator *basicAllocator)
+: d_allocAdapter(&d_mutex, basicAllocator)
+, d_multipool(numPools, &d_allocAdapter)
+, d_magazineCapacity(magazineCapacity)
+, d_depots_p(0)
+, d_hasKey(false)
+, d_caches_p(0)
+{
+    BSLS_ASSERT(1 <= numPools);
+    BSLS_ASSERT(1 <= magazineCapacity);
+
+    initialize();
+}
+
+ThreadCachingMultipoolAllocator::~ThreadCachingMultipoolAllocator()
+{
+    {
+        bslmt::QLockGuard guard(&s_ownersLock);
+
+        while (d_caches_p) {
+            destroyThreadCache(d_caches_p);
+        }
+    }
+
+    for (int i = 0; i < d_numSizeClasses; ++i) {
+        d_depots_p[i].~Depot();
+    }
+    if (d_depots_p) {
+        d_allocAdapter.deallocate(d_depots_p);
+    }
+}
+
+// MANIPULATORS
+void ThreadCachingMultipoolAllocator::drainThreadCache()
+{
+    ThreadCache *cache = findThreadCache();
+    if (cache) {
+        drainMagazines(cache);
+    }
+}
+
+void ThreadCachingMultipoolAllocator::trim()
+{
+    for (int i = 0; i < d_numSizeClasses; ++i) {
+        Depot& depot = d_depots_p[i];
+
+        bslmt::LockGuard<bslmt::Mutex> guard(&depot.d_mutex);
+
+        while (depot.d_magazines_p) {
+            Header *block       = depot.d_magazines_p;
+            depot.d_magazines_p = block->d_links.d_nextMagazine_p;
+
+            while (block) {
+                Header *next = block->d_links.d_next_p;
+                d_multipool.deallocate(block);
+                block = next;
+            }
+        }
+        depot.d_numMagazines = 0;
+    }
+}
+
+void *ThreadCachingMultipoolAllocator::allocate(bsls::Types::size_type size)
+{
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(0 == size)) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+        return 0;                                                     // RETURN
+    }
+
+    const int    sizeClass = findSizeClass(size);
+    ThreadCache *cache     = 0 <= sizeClass ? threadCache() : 0;
+
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(!cache)) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+
+        Header *block = static_cast<Header *>(
+                                d_multipool.allocate(size + sizeof(Header)));
+        block->d_sizeClass = -1;
+        return block + 1;                                             // RETURN
+    }
+
+    Magazine& magazine = cache->d_magazines_p[sizeClass];
+    Header   *block    = magazine.d_head_p;
+
+    if (BSLS_PERFORMANCEHINT_PREDICT_LIKELY(0 != block)) {
+        magazine.d_head_p = block->d_links.d_next_p;
+        --magazine.d_length;
+    }
+    else {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+        block = allocateFromDepot(&magazine, sizeClass);
+    }
+
+    block->d_sizeClass = sizeClass;
+    return block + 1;
+}
+
+void ThreadCachingMultipoolAllocator::deallocate(void *address)
+{
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(0 == address)) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+        return;                                                       // RETURN
+    }
+
+    Header    *block     = static_cast<Header *>(address) - 1;
+    const int  sizeClass = block->d_sizeClass;
+
+    ThreadCache *cache = 0 <= sizeClass ? threadCache() : 0;
+
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(!cache)) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+        d_multipool.deallocate(block);
+        return;                                                       // RETURN
+    }
+
+    Magazine& magazine = cache->d_magazines_p[sizeClass];
+
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(
+                                   d_magazineCapacity == magazine.d_length)) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+        flushToDepot(&magazine, sizeClass);
+    }
+
+    block->d_links.d_next_p = magazine.d_head_p;
+    magazine.d_head_p       = block;
+    ++magazine.d_length;
+}
+
+void ThreadCachingMultipoolAllocator::release()
+{
+    {
+        bslmt::LockGuard<bslmt::Mutex> guard(&d_cachesMutex);
+
+        for (ThreadCache *cache = d_caches_p; cache; cache = cache->d_next_p) {
+            for (int i = 0; i < d_numSizeClasses; ++i) {
+                cache->d_magazines_p[i].d_head_p = 0;
+                cache->d_magazines_p[i].d_length = 0;
+            }
+        }
+    }
+
+    for (int i = 0; i < d_numSizeClasses; ++i) {
+        d_depots_p[i].d_magazines_p  = 0;
+        d_depots_p[i].d_numMagazines = 0;
+    }
+
+    d_multipool.release();
+}
+
+// ACCESSORS
+int ThreadCachingMultipoolAllocator::numDepotMagazines() const
+{
+    int numMagazines = 0;
+    for (int i = 0; i < d_numSizeClasses; ++i) {
+        bslmt::LockGuard<bslmt::Mutex> guard(&d_depots_p[i].d_mutex);
+
+        numMagazines += d_depots_p[i].d_numMagazines;
+    }
+    return numMagazines;
+}
+
+int ThreadCachingMultipoolAllocator::numThreadCachedBlocks() const
+{
+    const ThreadCache *cache = findThreadCache();
+    if (!cache) {
+        return 0;                                                     // RETURN
+    }
+
+    int numBlocks = 0;
+    for (int i = 0; i < d_numSizeClasses; ++i) {
+        numBlocks += cache->d_magazines_p[i].d_length;
+    }
+    return numBlocks;
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+// ----------------------------------------------------------------------------
+// Copyright 2020 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,560 @@
+// bdlma_threadcachingmultipoolallocator.h                            -*-C++-*-
+#ifndef INCLUDED_BDLMA_THREADCACHINGMULTIPOOLALLOCATOR
+#define INCLUDED_BDLMA_THREADCACHINGMULTIPOOLALLOCATOR
+
+#include <bsls_ident.h>
+BSLS_IDENT("$Id: $")
+
+//@PURPOSE: Provide a multipool allocator having per-thread block caches.
+//
+//@CLASSES:
+//  bdlma::ThreadCachingMultipoolAllocator: multipool with per-thread caches
+//
+//@SEE_ALSO: bdlma_concurrentmultipoolallocator, bdlma_concurrentmultipool
+//
+//@DESCRIPTION: This component provides an allocator,
+// 'bdlma::ThreadCachingMultipoolAllocator', that implements the
+// 'bdlma::ManagedAllocator' protocol and places a per-thread caching layer in
+// front of a 'bdlma::ConcurrentMultipool'.  Each size class of the multipool
+// is served to a thread from a cache private to that thread, so that the
+// allocation and deallocation of pooled blocks by different threads do not
+// contend on the free list of the multipool's pool for that size class:
+//..
+//   ,--------------------------------------.
+//  ( bdlma::ThreadCachingMultipoolAllocator )
+//   `--------------------------------------'
+//                      |        ctor/dtor
+//                      |        drainThreadCache
+//                      |        trim
+//                      |        magazineCapacity
+//                      |        maxCachedBlockSize
+//                      |        numPools
+//                      |        numThreadCachedBlocks
+//                      V
+//         ,-----------------------.
+//        ( bdlma::ManagedAllocator )
+//         `-----------------------'
+//                      |        release
+//                      V
+//              ,----------------.
+//             ( bslma::Allocator )
+//              `----------------'
+//                               allocate
+//                               deallocate
+//..
+// Both the 'release' method and the destructor of a
+// 'bdlma::ThreadCachingMultipoolAllocator' release all memory currently
+// allocated via the object.
+//
+///Thread Caches and Magazines
+///---------------------------
+// The first time a thread allocates or deallocates memory through a
+// 'bdlma::ThreadCachingMultipoolAllocator', a *thread* *cache* holding one
+// *magazine* (a list of free blocks) per size class is created for that
+// thread.  An allocation request is satisfied from the magazine of the
+// calling thread for the smallest size class that can hold the request, and a
+// deallocated block is added to the magazine of the calling thread for the
+// size class of the block, neither operation requiring any synchronization.
+//
+// A magazine holds at most 'magazineCapacity' blocks, which bounds the memory
+// that a thread can hold in its cache, including blocks that were allocated
+// by another thread (e.g., in a producer-consumer pattern, where a consumer
+// thread deallocates the blocks allocated by a producer thread).  When a
+// block is deallocated to a full magazine, the full magazine is moved, as a
+// whole, to a shared *depot* maintained for the size class, and when a block
+// is requested from an empty magazine, a full magazine is taken from the
+// depot, or, if the depot is empty, the block is allocated from the
+// underlying multipool.  Each transfer between a thread cache and a depot
+// acquires a lock once for an entire magazine of blocks.
+//
+// Each block dispensed from a size class carries a header of the size of the
+// maximal alignment (e.g., 16 bytes on 64-bit platforms) that identifies its
+// size class.  The size classes correspond to the pools of the underlying
+// multipool whose block size is at least twice the size of this header, and
+// a request for more than 'maxCachedBlockSize' bytes is served by the
+// underlying multipool directly.
+//
+// The cache of a thread is returned to the allocator when the thread exits:
+// the full magazines of the cache are moved to the depots, and the blocks in
+// partially filled magazines are returned to the underlying multipool.  A
+// thread can also return its cached blocks explicitly by calling
+// 'drainThreadCache', and the blocks held by the depots can be returned to
+// the underlying multipool by calling 'trim'.  Note that the multipool itself
+// returns memory to the underlying allocator only when 'release' is called or
+// the allocator is destroyed.
+//
+// The caches of a thread, one for each allocator used by the thread, are
+// found through a single thread-specific storage key (see
+// 'bslmt::ThreadUtil::createKey') shared by all the
+// 'bdlma::ThreadCachingMultipoolAllocator' objects, and so the number of such
+// allocators that can exist at one time is not limited by the number of keys
+// available to the process.  The cache of the allocator most recently used by
+// a thread is found without a search.  If the shared key cannot be created,
+// every allocator serves every request from the underlying multipool
+// directly.
+//
+// The magazines of the caches of an allocator are deallocated when the
+// allocator is destroyed.  However, each cache also has a small record
+// linking it to the other caches of its thread, which is allocated using
+// 'bslma::NewDeleteAllocator' and freed by the thread itself: when the thread
+// next looks up the cache of another allocator, or exits.
+//
+///Configuration at Construction
+///-----------------------------
+// When creating a 'bdlma::ThreadCachingMultipoolAllocator', clients can
+// optionally configure:
+//
+//: 1 NUMBER OF POOLS -- the number of pools of the underlying multipool (the
+//:   block size managed by the first pool is eight bytes, with each successive
+//:   pool managing block of a size twice that of the previous pool).
+//:
+//: 2 MAGAZINE CAPACITY -- the maximum number of blocks of one size class held
+//:   by the cache of a thread, which is also the number of blocks transferred
+//:   at once between a thread cache and a depot.
+//:
+//: 3 BASIC ALLOCATOR -- the allocator used to supply memory.  If not
+//:   specified, the currently installed default allocator (see
+//:   'bslma_default') is used.
+//
+///Thread Safety
+///-------------
+// 'bdlma::ThreadCachingMultipoolAllocator' is *fully thread-safe* (see
+// 'bsldoc_glossary'), except for the 'release' and 'trim' methods, which
+// must not be called while other threads use the allocator.  The basic
+// allocator supplied at construction need not be thread-safe.  A thread that
+// used an allocator may exit while that allocator is being destroyed.
+//
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Allocating Messages in a Producer-Consumer Pipeline
+/// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// Suppose that a producer thread allocates messages that are deallocated by a
+// consumer thread.  A 'bdlma::ThreadCachingMultipoolAllocator' serves each of
+// the threads from its own cache, and moves the blocks deallocated by the
+// consumer back to the producer a magazine at a time.
+//
+// First, we define the message type, and a simple queue of messages guarded
+// by a mutex:
+//..
+//  struct Message {
+//      // This 'struct' provides a message exchanged between threads.
+//
+//      int  d_sequenceNumber;  // sequence number of this message
+//      char d_payload[100];    // payload of this message
+//  };
+//
+//  struct MessageQueue {
+//      // This 'struct' provides a queue of messages.
+//
+//      bslmt::Mutex          d_mutex;     // synchronizes access
+//      bsl::deque<Message *> d_messages;  // queued messages
+//  };
+//..
+// Then, we define the function object executed by the producer thread, which
+// allocates messages using the allocator:
+//..
+//  struct Producer {
+//      // This 'struct' provides a function object that produces messages.
+//
+//      MessageQueue     *d_queue_p;      // queue to which to append
+//      bslma::Allocator *d_allocator_p;  // allocator of the messages
+//      int               d_count;        // number of messages to produce
+//
+//      void operator()() const
+//          // Allocate 'd_count' messages from 'd_allocator_p' and append them
+//          // to 'd_queue_p'.
+//      {
+//          for (int i = 0; i < d_count; ++i) {
+//              Message *message = new (*d_allocator_p) Message;
+//              message->d_sequenceNumber = i;
+//
+//              bslmt::LockGuard<bslmt::Mutex> guard(&d_queue_p->d_mutex);
+//              d_queue_p->d_messages.push_back(message);
+//          }
+//      }
+//  };
+//..
+// Next, we define the function executed by the consumer thread, which
+// deallocates the messages it has processed:
+//..
+//  int consume(MessageQueue *queue, bslma::Allocator *allocator, int count)
+//      // Remove the specified 'count' messages from the specified 'queue',
+//      // deallocating them using the specified 'allocator', and return the
+//      // sum of their sequence numbers.
+//  {
+//      int sum = 0;
+//      while (count) {
+//          Message *message = 0;
+//          {
+//              bslmt::LockGuard<bslmt::Mutex> guard(&queue->d_mutex);
+//              if (!queue->d_messages.empty()) {
+//                  message = queue->d_messages.front();
+//                  queue->d_messages.pop_front();
+//              }
+//          }
+//          if (message) {
+//              sum += message->d_sequenceNumber;
+//              allocator->deleteObject(message);
+//              --count;
+//          }
+//          else {
+//              bslmt::ThreadUtil::yield();
+//          }
+//      }
+//      return sum;
+//  }
+//..
+// Then, we create the allocator, and run the producer and the consumer in
+// two threads:
+//..
+//  bdlma::ThreadCachingMultipoolAllocator allocator;
+//  MessageQueue                           queue;
+//
+//  enum { k_NUM_MESSAGES = 1000 };
+//
+//  Producer producer = { &queue, &allocator, k_NUM_MESSAGES };
+//
+//  bslmt::ThreadUtil::Handle handle;
+//  bslmt::ThreadUtil::create(&handle, producer);
+//
+//  const int sum = consume(&queue, &allocator, k_NUM_MESSAGES);
+//  bslmt::ThreadUtil::join(handle);
+//
+//  assert(k_NUM_MESSAGES * (k_NUM_MESSAGES - 1) / 2 == sum);
+//..
+// Finally, we note that the calling thread (the consumer) holds at most one
+// magazine of message blocks in its cache, and return them to the allocator,
+// since the calling thread will not allocate messages anymore:
+//..
+//  assert(allocator.magazineCapacity() >= allocator.numThreadCachedBlocks());
+//
+//  allocator.drainThreadCache();
+//  assert(0 == allocator.numThreadCachedBlocks());
+//..
+
+#include <bdlscm_version.h>
+
+#include <bdlma_concurrentallocatoradapter.h>
+#include <bdlma_concurrentmultipool.h>
+#include <bdlma_managedallocator.h>
+
+#include <bslma_allocator.h>
+
+#include <bslmt_mutex.h>
+
+#include <bsls_alignmentutil.h>
+#include <bsls_atomicoperations.h>
+#include <bsls_types.h>
+
+namespace BloombergLP {
+namespace bdlma {
+
+                   // =====================================
+                   // class ThreadCachingMultipoolAllocator
+                   // =====================================
+
+class ThreadCachingMultipoolAllocator : public ManagedAllocator {
+    // This class implements the 'ManagedAllocator' protocol to provide a
+    // thread-safe allocator that serves memory blocks of the size classes of
+    // an underlying 'ConcurrentMultipool' from caches private to each thread,
+    // each holding at most a configurable number of blocks per size class,
+    // and that exchanges full magazines of blocks between the thread caches
+    // through a shared depot per size class.  Both the 'release' method and
+    // the destructor of a 'ThreadCachingMultipoolAllocator' release all memory
+    // currently allocated via the object.
+
+    // PRIVATE TYPES
+    union Header {
+        // This 'union' provides the header of each block dispensed by this
+        // allocator.  The header stores the size class of an allocated block,
+        // and links a free block in a magazine, and a full magazine (through
+        // its first block) in a depot.
+
+        struct {
+            Header *d_next_p;          // next block in a magazine
+            Header *d_nextMagazine_p;  // next magazine in a depot
+        }                                   d_links;
+
+        int                                 d_sizeClass;  // size class of an
+                                                          // allocated block,
+                                                          // or -1 if not
+                                                          // cached
+
+        bsls::AlignmentUtil::MaxAlignedType d_dummy;      // force maximum
+                                                          // alignment
+    };
+
+    struct Magazine {
+        // This 'struct' provides a list of free blocks of one size class in
+        // the cache of a thread.
+
+        Header *d_head_p;  // first block, or 0 if empty
+        int     d_length;  // number of blocks
+    };
+
+    struct ThreadCache {
+        // This 'struct' provides the cache of a thread, holding one magazine
+        // per size class.  The caches of all threads for one allocator are
+        // linked in a list, and so are the caches of one thread for all
+        // allocators.
+
+        bsls::AtomicOperations::AtomicTypes::Pointer
+                     d_owner;            // owning allocator, or 0 if it was
+                                         // destroyed
+
+        Magazine    *d_magazines_p;      // one per size class
+
+        ThreadCache *d_prev_p;           // previous cache of the owner
+
+        ThreadCache *d_next_p;           // next cache of the owner
+
+        ThreadCache *d_nextInThread_p;   // next cache of the same thread
+    };
+
+    struct Depot {
+        // This 'struct' provides the shared stack of full magazines of one
+        // size class.
+
+        bslmt::Mutex  d_mutex;         // synchronizes access
+        Header       *d_magazines_p;   // first block of the top magazine, or
+                                       // 0 if empty
+        int           d_numMagazines;  // number of magazines
+    };
+
+    // DATA
+    bslmt::Mutex           d_mutex;             // serializes the use of the
+                                                // basic allocator
+
+    ConcurrentAllocatorAdapter
+                           d_allocAdapter;      // thread-safe adapter of the
+                                                // basic allocator
+
+    ConcurrentMultipool    d_multipool;         // underlying multipool
+
+    int                    d_numSizeClasses;    // number of cached size
+                                                // classes
+
+    int                    d_minSizeClassLog2;  // base-2 logarithm of the
+                                                // block size (including the
+                                                // header) of size class 0
+
+    int                    d_magazineCapacity;  // maximum number of blocks in
+                                                // a magazine
+
+    bsls::Types::size_type d_maxCachedBlockSize;
+                                                // maximum size of a block
+                                                // served from a thread cache
+
+    Depot                 *d_depots_p;          // one depot per size class
+
+    bool                   d_hasKey;            // 'true' if the shared key
+                                                // of the thread caches was
+                                                // successfully created
+
+    bslmt::Mutex           d_cachesMutex;       // synchronizes access to
+                                                // 'd_caches_p'
+
+    ThreadCache           *d_caches_p;          // list of all thread caches
+
+  private:
+    // NOT IMPLEMENTED
+    ThreadCachingMultipoolAllocator(const ThreadCachingMultipoolAllocator&);
+    ThreadCachingMultipoolAllocator& operator=(
+                                       const ThreadCachingMultipoolAllocator&);
+
+    // PRIVATE CLASS METHODS
+    static ThreadCachingMultipoolAllocator *owner(const ThreadCache *cache);
+        // Return the address of the allocator owning the specified 'cache',
+        // or 0 if that allocator was destroyed.
+
+    static void retireThreadCaches(void *caches);
+        // Return the blocks held by the specified list of thread 'caches' to
+        // their owning allocators, and destroy the caches.  Note that this
+        // function is the cleanup function of the thread-specific storage
+        // key shared by all allocators, invoked when a thread having a cache
+        // exits.
+
+    // PRIVATE MANIPULATORS
+    Header *allocateFromDepot(Magazine *magazine, int sizeClass);
+        // Load into the specified empty 'magazine' a full magazine taken from
+        // the depot of the specified 'sizeClass', and return a block removed
+        // from 'magazine'.  If the depot is empty, return a block allocated
+        // from the underlying multipool, leaving 'magazine' empty.
+
+    ThreadCache *createThreadCache();
+        // Create a cache for the calling thread, link it to the list of
+        // caches of this allocator, and return its address.
+
+    void destroyThreadCache(ThreadCache *cache);
+        // Unlink the specified 'cache' from the list of caches of this
+        // allocator, deallocate its magazines, and mark it as having no
+        // owner.  Note that the record of 'cache' itself is deallocated by the
+        // thread of 'cache'.
+
+    void drainMagazines(ThreadCache *cache);
+        // Move the full magazines of the specified 'cache' to the depots, and
+        // return the blocks of its other magazines to the underlying
+        // multipool, leaving every magazine of 'cache' empty.
+
+    int findSizeClass(bsls::Types::size_type size) const;
+        // Return the size class of a block having the specified 'size' (in
+        // bytes) available to the user, or -1 if 'size' is too large to be
+        // served from a thread cache.
+
+    ThreadCache *findThreadCache() const;
+        // Return the address of the cache of the calling thread for this
+        // allocator, or 0 if the calling thread has no such cache.
+
+    void flushToDepot(Magazine *magazine, int sizeClass);
+        // Move the blocks of the specified full 'magazine' to the depot of the
+        // specified 'sizeClass', leaving 'magazine' empty.
+
+    void initialize();
+        // Compute the size classes served from the thread caches, create the
+        // depots, and create, if not already done, the thread-specific storage
+        // key shared by all allocators.  Note that this method is called by
+        // the constructors.
+
+    ThreadCache *lookUpThreadCache(ThreadCache *caches);
+        // Return the address of the cache of the calling thread for this
+        // allocator, taken from the specified list of 'caches' of the calling
+        // thread, or created if 'caches' has none, after moving it to the
+        // front of the list and destroying the caches of the list whose owner
+        // was destroyed.  Return 0, leaving 'caches' unchanged, if the list of
+        // the calling thread cannot be updated.
+
+    ThreadCache *threadCache();
+        // Return the address of the cache of the calling thread, creating it
+        // if needed, or 0 if the calling thread cannot have a cache.
+
+  public:
+    // CREATORS
+    explicit ThreadCachingMultipoolAllocator(
+                                         bslma::Allocator *basicAllocator = 0);
+    explicit ThreadCachingMultipoolAllocator(
+                                         int               numPools,
+                                         bslma::Allocator *basicAllocator = 0);
+    ThreadCachingMultipoolAllocator(int               numPools,
+                                    int               magazineCapacity,
+                                    bslma::Allocator *basicAllocator = 0);
+        // Create a thread-caching multipool allocator.  Optionally specify
+        // 'numPools', indicating the number of pools of the underlying
+        // multipool; the block size of the first pool is 8 bytes, with the
+        // block size of each additional pool successively doubling.  If
+        // 'numPools' is not specified, an implementation-defined number of
+        // pools is used.  Optionally specify a 'magazineCapacity', indicating
+        // the maximum number of blocks of each size class held in the cache
+        // of a thread.  If 'magazineCapacity' is not specified, an
+        // implementation-defined value is used.  Optionally specify a
+        // 'basicAllocator' used to supply memory.  If 'basicAllocator' is 0,
+        // the currently installed default allocator is used.  The behavior is
+        // undefined unless '1 <= numPools' and '1 <= magazineCapacity'.
+
+    virtual ~ThreadCachingMultipoolAllocator();
+        // Destroy this allocator.  All memory allocated from this allocator is
+        // released.
+
+    // MANIPULATORS
+    void drainThreadCache();
+        // Return the blocks held in the cache of the calling thread to this
+        // allocator: full magazines are moved to the shared depots, and the
+        // blocks of other magazines are returned to the underlying multipool.
+        // Note that this method is called implicitly when a thread exits.
+
+    void trim();
+        // Return the blocks held in the shared depots of this allocator to the
+        // underlying multipool.  The behavior is undefined if this method is
+        // called while another thread uses this allocator.
+
+                                // Virtual Functions
+
+    virtual void *allocate(bsls::Types::size_type size);
+        // Return the address of a contiguous block of maximally aligned memory
+        // of (at least) the specified 'size' (in bytes).  If 'size' is 0, no
+        // memory is allocated and 0 is returned.  If
+        // 'size > maxCachedBlockSize()', the memory is allocated from the
+        // underlying multipool directly.
+
+    virtual void deallocate(void *address);
+        // Relinquish the memory block at the specified 'address' back to this
+        // allocator for reuse.  If 'address' is 0, this method has no effect.
+        // The behavior is undefined unless 'address' was allocated by this
+        // allocator, and has not already been deallocated.
+
+    virtual void release();
+        // Relinquish all memory currently allocated through this allocator,
+        // including the blocks held in the caches of all threads.  The
+        // behavior is undefined if this method is called while another thread
+        // uses this allocator.
+
+    // ACCESSORS
+    int magazineCapacity() const;
+        // Return the maximum number of blocks of one size class held in the
+        // cache of a thread.
+
+    bsls::Types::size_type maxCachedBlockSize() const;
+        // Return the maximum size of memory blocks served from the cache of a
+        // thread, or 0 if no block is served from a thread cache.
+
+    int numPools() const;
+        // Return the number of pools of the underlying multipool.
+
+    int numDepotMagazines() const;
+        // Return the number of full magazines held in the shared depots of
+        // this allocator.  Note that the value returned may be out of date
+        // if other threads use this allocator.
+
+    int numThreadCachedBlocks() const;
+        // Return the number of blocks held in the cache of the calling thread.
+};
+
+// ============================================================================
+//                             INLINE DEFINITIONS
+// ============================================================================
+
+                   // -------------------------------------
+                   // class ThreadCachingMultipoolAllocator
+                   // -------------------------------------
+
+// ACCESSORS
+inline
+int ThreadCachingMultipoolAllocator::magazineCapacity() const
+{
+    return d_magazineCapacity;
+}
+
+inline
+bsls::Types::size_type
+ThreadCachingMultipoolAllocator::maxCachedBlockSize() const
+{
+    return d_maxCachedBlockSize;
+}
+
+inline
+int ThreadCachingMultipoolAllocator::numPools() const
+{
+    return d_multipool.numPools();
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2020 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
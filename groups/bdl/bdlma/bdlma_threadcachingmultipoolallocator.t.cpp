@@ -0,0 +1,1364 @@
+// bdlma_threadcachingmultipoolallocator.t.cpp                        -*-C++-*-
+#include <bdlma_threadcachingmultipoolallocator.h>
+
+#include <bdlma_concurrentmultipoolallocator.h>
+
+#include <bslim_testutil.h>
+
+#include <bslma_default.h>
+#include <bslma_defaultallocatorguard.h>
+#include <bslma_newdeleteallocator.h>
+#include <bslma_testallocator.h>
+
+#include <bslmt_lockguard.h>
+#include <bslmt_mutex.h>
+#include <bslmt_threadutil.h>
+
+#include <bsls_alignmentutil.h>
+#include <bsls_review.h>
+#include <bsls_stopwatch.h>
+#include <bsls_types.h>
+
+#include <bsl_cstdlib.h>
+#include <bsl_cstring.h>
+#include <bsl_deque.h>
+#include <bsl_iostream.h>
+#include <bsl_vector.h>
+
+using namespace BloombergLP;
+using namespace bsl;
+
+// ============================================================================
+//                                   TEST PLAN
+// ----------------------------------------------------------------------------
+//                                   Overview
+//                                   --------
+// The component under test is a thread-safe managed allocator that serves the
+// size classes of an underlying multipool from per-thread caches of bounded
+// capacity, exchanging full magazines of blocks between threads through a
+// shared depot per size class.  We verify the mapping of requested sizes to
+// size classes (and to the underlying multipool for larger sizes), that the
+// cache of a thread holds at most one magazine per size class however many
+// blocks other threads allocated, that full magazines are reused through the
+// depots without allocating from the basic allocator, that the caches of
+// exiting threads are returned to the allocator, and that 'drainThreadCache',
+// 'trim', and 'release' return memory as documented.  Finally, we verify that
+// concurrent allocation and cross-thread deallocation preserve the contents
+// of the dispensed blocks, and that no memory is leaked.
+// ----------------------------------------------------------------------------
+// CREATORS
+// [ 1] ThreadCachingMultipoolAllocator(bslma::Allocator *ba = 0);
+// [ 2] ThreadCachingMultipoolAllocator(int numPools, Allocator *ba = 0);
+// [ 3] ThreadCachingMultipoolAllocator(int, int, Allocator *ba = 0);
+// [ 1] ~ThreadCachingMultipoolAllocator();
+//
+// MANIPULATORS
+// [ 4] void drainThreadCache();
+// [ 4] void trim();
+// [ 2] void *allocate(bsls::Types::size_type size);
+// [ 2] void deallocate(void *address);
+// [ 6] void release();
+//
+// ACCESSORS
+// [ 1] int magazineCapacity() const;
+// [ 2] bsls::Types::size_type maxCachedBlockSize() const;
+// [ 1] int numPools() const;
+// [ 3] int numDepotMagazines() const;
+// [ 3] int numThreadCachedBlocks() const;
+// ----------------------------------------------------------------------------
+// [ 1] BREATHING TEST
+// [ 5] CONCERN: The caches of exiting threads are returned.
+// [ 5] CONCERN: Cross-thread deallocation is bounded.
+// [ 7] CONCERN: Concurrent allocation and deallocation.
+// [ 8] USAGE EXAMPLE
+// [-1] PERFORMANCE: COMPARISON WITH OTHER ALLOCATORS
+
+// ============================================================================
+//                     STANDARD BDE ASSERT TEST FUNCTION
+// ----------------------------------------------------------------------------
+
+namespace {
+
+int testStatus = 0;
+
+void aSsErT(bool condition, const char *message, int line)
+{
+    if (condition) {
+        cout << "Error " __FILE__ "(" << line << "): " << message
+             << "    (failed)" << endl;
+
+        if (0 <= testStatus && testStatus <= 100) {
+            ++testStatus;
+        }
+    }
+}
+
+}  // close unnamed namespace
+
+// ============================================================================
+//               STANDARD BDE TEST DRIVER MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT       BSLIM_TESTUTIL_ASSERT
+#define ASSERTV      BSLIM_TESTUTIL_ASSERTV
+
+#define LOOP_ASSERT  BSLIM_TESTUTIL_LOOP_ASSERT
+#define LOOP0_ASSERT BSLIM_TESTUTIL_LOOP0_ASSERT
+#define LOOP1_ASSERT BSLIM_TESTUTIL_LOOP1_ASSERT
+#define LOOP2_ASSERT BSLIM_TESTUTIL_LOOP2_ASSERT
+#define LOOP3_ASSERT BSLIM_TESTUTIL_LOOP3_ASSERT
+#define LOOP4_ASSERT BSLIM_TESTUTIL_LOOP4_ASSERT
+#define LOOP5_ASSERT BSLIM_TESTUTIL_LOOP5_ASSERT
+#define LOOP6_ASSERT BSLIM_TESTUTIL_LOOP6_ASSERT
+
+#define Q            BSLIM_TESTUTIL_Q   // Quote identifier literally.
+#define P            BSLIM_TESTUTIL_P   // Print identifier and value.
+#define P_           BSLIM_TESTUTIL_P_  // P(X) without '\n'.
+#define T_           BSLIM_TESTUTIL_T_  // Print a tab (w/o newline).
+#define L_           BSLIM_TESTUTIL_L_  // current Line number
+
+// ============================================================================
+//                  GLOBAL TYPEDEFS/CONSTANTS FOR TESTING
+// ----------------------------------------------------------------------------
+
+typedef bdlma::ThreadCachingMultipoolAllocator Obj;
+typedef bsls::Types::size_type                 size_type;
+typedef bsls::Types::Int64                     Int64;
+
+const int k_MAX_ALIGN = bsls::AlignmentUtil::BSLS_MAX_ALIGNMENT;
+
+const int k_HEADER_SIZE = 2 * static_cast<int>(sizeof(void *)) > k_MAX_ALIGN
+                        ? 2 * static_cast<int>(sizeof(void *))
+                        : k_MAX_ALIGN;
+    // size of the header preceding each block dispensed by the allocator
+
+// ============================================================================
+//                      HELPER FUNCTIONS FOR TESTING
+// ----------------------------------------------------------------------------
+
+static size_type expectedMaxCachedBlockSize(int numPools)
+    // Return the value expected from 'maxCachedBlockSize' for an allocator
+    // having the specified 'numPools'.
+{
+    const size_type maxPoolBlockSize = static_cast<size_type>(8)
+                                                           << (numPools - 1);
+
+    return maxPoolBlockSize < static_cast<size_type>(2 * k_HEADER_SIZE)
+           ? 0
+           : maxPoolBlockSize - k_HEADER_SIZE;
+}
+
+static size_type sizeClassBlockSize(size_type size)
+    // Return the size of the multipool block (including the header) serving a
+    // request for the specified 'size' (in bytes) from a thread cache.
+{
+    size_type blockSize = 2 * k_HEADER_SIZE;
+    while (blockSize < size + k_HEADER_SIZE) {
+        blockSize *= 2;
+    }
+    return blockSize;
+}
+
+static bool isMaxAligned(const void *address)
+    // Return 'true' if the specified 'address' is maximally aligned, and
+    // 'false' otherwise.
+{
+    return 0 == bsls::AlignmentUtil::calculateAlignmentOffset(address,
+                                                              k_MAX_ALIGN);
+}
+
+static void fill(void *address, int size)
+    // Fill the specified 'size' bytes at the specified 'address' with a value
+    // derived from 'size'.
+{
+    memset(address, size & 0xff, size);
+}
+
+static bool isFilled(const void *address, int size)
+    // Return 'true' if the specified 'size' bytes at the specified 'address'
+    // have the value written by 'fill', and 'false' otherwise.
+{
+    const unsigned char *bytes = static_cast<const unsigned char *>(address);
+    for (int i = 0; i < size; ++i) {
+        if ((size & 0xff) != bytes[i]) {
+            return false;                                             // RETURN
+        }
+    }
+    return true;
+}
+
+// ============================================================================
+//                     HELPER THREAD FUNCTIONS FOR TESTING
+// ----------------------------------------------------------------------------
+
+struct BlockJob {
+    // This 'struct' describes the blocks allocated or deallocated by a thread.
+
+    Obj    *d_allocator_p;         // allocator under test
+    void  **d_blocks_p;            // blocks
+    int     d_numBlocks;           // number of blocks
+    int     d_size;                // size of each block
+    int     d_numCachedAtExit;     // 'numThreadCachedBlocks' before the
+                                   // thread exits
+};
+
+extern "C" void *allocateBlocks(void *arg)
+    // Allocate the blocks described by the specified 'arg', the address of a
+    // 'BlockJob', and record the number of blocks cached by the thread.
+{
+    BlockJob *job = static_cast<BlockJob *>(arg);
+
+    for (int i = 0; i < job->d_numBlocks; ++i) {
+        job->d_blocks_p[i] = job->d_allocator_p->allocate(job->d_size);
+        fill(job->d_blocks_p[i], job->d_size);
+    }
+    job->d_numCachedAtExit = job->d_allocator_p->numThreadCachedBlocks();
+    return 0;
+}
+
+extern "C" void *deallocateBlocks(void *arg)
+    // Deallocate the blocks described by the specified 'arg', the address of
+    // a 'BlockJob', and record the number of blocks cached by the thread.
+{
+    BlockJob *job = static_cast<BlockJob *>(arg);
+
+    for (int i = 0; i < job->d_numBlocks; ++i) {
+        ASSERTV(i, isFilled(job->d_blocks_p[i], job->d_size));
+        job->d_allocator_p->deallocate(job->d_blocks_p[i]);
+    }
+    job->d_numCachedAtExit = job->d_allocator_p->numThreadCachedBlocks();
+    return 0;
+}
+
+extern "C" void *cycleBlocksAfterDestruction(void *arg)
+    // Allocate and deallocate a block using each of several allocators, at
+    // the same address, each destroyed while the calling thread has a cache
+    // of it, then allocate and deallocate the blocks described by the
+    // specified 'arg', the address of a 'BlockJob', and record the number of
+    // blocks cached by the thread.
+{
+    BlockJob *job = static_cast<BlockJob *>(arg);
+
+    bslma::TestAllocator ta("temporary");
+
+    for (int i = 0; i < 3; ++i) {
+        Obj mX(&ta);  const Obj& X = mX;
+
+        ASSERTV(i, 0 == X.numThreadCachedBlocks());
+
+        mX.deallocate(mX.allocate(job->d_size));
+
+        ASSERTV(i, 1 == X.numThreadCachedBlocks());
+    }
+    ASSERTV(ta.numBytesInUse(), 0 == ta.numBytesInUse());
+
+    allocateBlocks(arg);
+    return deallocateBlocks(arg);
+}
+
+struct StressJob {
+    // This 'struct' describes the work of a thread exchanging blocks with
+    // other threads through an array of slots.
+
+    Obj          *d_allocator_p;  // allocator under test
+    bslmt::Mutex *d_mutex_p;      // synchronizes access to the slots
+    void        **d_slots_p;      // exchanged blocks
+    int          *d_sizes_p;      // sizes of the exchanged blocks
+    int           d_numSlots;     // number of slots
+    int           d_seed;         // seed of the pseudo-random sequence
+    int           d_iterations;   // number of blocks to allocate
+};
+
+extern "C" void *exchangeBlocks(void *arg)
+    // Repeatedly allocate a block of pseudo-random size, store it in a
+    // pseudo-random slot of the job described by the specified 'arg', the
+    // address of a 'StressJob', and verify and deallocate the block
+    // previously held by that slot.
+{
+    StressJob    *job  = static_cast<StressJob *>(arg);
+    unsigned int  seed = job->d_seed;
+
+    for (int i = 0; i < job->d_iterations; ++i) {
+        seed = seed * 1103515245 + 12345;
+
+        const int slot = (seed >> 8) % job->d_numSlots;
+        const int size = 0 == (seed >> 20) % 64
+                         ? 5000 + static_cast<int>((seed >> 4) % 256)
+                         : 1 + static_cast<int>((seed >> 4) % 600);
+
+        void *block = job->d_allocator_p->allocate(size);
+        ASSERT(isMaxAligned(block));
+        fill(block, size);
+
+        void *oldBlock;
+        int   oldSize;
+        {
+            bslmt::LockGuard<bslmt::Mutex> guard(job->d_mutex_p);
+
+            oldBlock                  = job->d_slots_p[slot];
+            oldSize                   = job->d_sizes_p[slot];
+            job->d_slots_p[slot]      = block;
+            job->d_sizes_p[slot]      = size;
+        }
+
+        if (oldBlock) {
+            ASSERTV(oldSize, isFilled(oldBlock, oldSize));
+            job->d_allocator_p->deallocate(oldBlock);
+        }
+    }
+    return 0;
+}
+
+struct BenchmarkJob {
+    // This 'struct' describes the work of a thread of the benchmark.
+
+    bslma::Allocator *d_allocator_p;  // measured allocator
+    int               d_iterations;   // number of batches
+};
+
+extern "C" void *allocateBatches(void *arg)
+    // Repeatedly allocate and deallocate a batch of blocks of mixed sizes
+    // using the job described by the specified 'arg', the address of a
+    // 'BenchmarkJob'.
+{
+    static const int k_SIZES[] = {
+        16, 24, 32, 48, 64, 96, 128, 200, 256, 24, 32, 64, 100, 128, 16, 40
+    };
+    enum { k_BATCH = sizeof k_SIZES / sizeof *k_SIZES };
+
+    BenchmarkJob *job = static_cast<BenchmarkJob *>(arg);
+    void         *blocks[k_BATCH];
+
+    for (int i = 0; i < job->d_iterations; ++i) {
+        for (int j = 0; j < k_BATCH; ++j) {
+            blocks[j] = job->d_allocator_p->allocate(k_SIZES[j]);
+            *static_cast<char *>(blocks[j]) = static_cast<char>(j);
+        }
+        for (int j = k_BATCH - 1; 0 <= j; --j) {
+            job->d_allocator_p->deallocate(blocks[j]);
+        }
+    }
+    return 0;
+}
+
+static double runBenchmark(bslma::Allocator *allocator,
+                           int               numThreads,
+                           int               iterations)
+    // Run the specified 'numThreads' threads each allocating and deallocating
+    // the specified 'iterations' batches of blocks using the specified
+    // 'allocator', and return the elapsed time per allocation and
+    // deallocation pair in nanoseconds.
+{
+    bsl::vector<bslmt::ThreadUtil::Handle> handles(numThreads);
+    BenchmarkJob                           job = { allocator, iterations };
+
+    bsls::Stopwatch timer;
+    timer.start();
+
+    for (int i = 0; i < numThreads; ++i) {
+        ASSERT(0 == bslmt::ThreadUtil::create(&handles[i],
+                                              &allocateBatches,
+                                              &job));
+    }
+    for (int i = 0; i < numThreads; ++i) {
+        bslmt::ThreadUtil::join(handles[i]);
+    }
+
+    timer.stop();
+
+    return timer.elapsedTime() * 1e9 / (16.0 * numThreads * iterations);
+}
+
+// ============================================================================
+//                               USAGE EXAMPLE
+// ----------------------------------------------------------------------------
+
+namespace USAGE_EXAMPLE_1 {
+
+///Example 1: Allocating Messages in a Producer-Consumer Pipeline
+/// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// Suppose that a producer thread allocates messages that are deallocated by a
+// consumer thread.  A 'bdlma::ThreadCachingMultipoolAllocator' serves each of
+// the threads from its own cache, and moves the blocks deallocated by the
+// consumer back to the producer a magazine at a time.
+//
+// First, we define the message type, and a simple queue of messages guarded
+// by a mutex:
+//..
+    struct Message {
+        // This 'struct' provides a message exchanged between threads.
+
+        int  d_sequenceNumber;  // sequence number of this message
+        char d_payload[100];    // payload of this message
+    };
+
+    struct MessageQueue {
+        // This 'struct' provides a queue of messages.
+
+        bslmt::Mutex          d_mutex;     // synchronizes access
+        bsl::deque<Message *> d_messages;  // queued messages
+    };
+//..
+// Then, we define the function object executed by the producer thread, which
+// allocates messages using the allocator:
+//..
+    struct Producer {
+        // This 'struct' provides a function object that produces messages.
+
+        MessageQueue     *d_queue_p;      // queue to which to append
+        bslma::Allocator *d_allocator_p;  // allocator of the messages
+        int               d_count;        // number of messages to produce
+
+        void operator()() const
+            // Allocate 'd_count' messages from 'd_allocator_p' and append them
+            // to 'd_queue_p'.
+        {
+            for (int i = 0; i < d_count; ++i) {
+                Message *message = new (*d_allocator_p) Message;
+                message->d_sequenceNumber = i;
+
+                bslmt::LockGuard<bslmt::Mutex> guard(&d_queue_p->d_mutex);
+                d_queue_p->d_messages.push_back(message);
+            }
+        }
+    };
+//..
+// Next, we define the function executed by the consumer thread, which
+// deallocates the messages it has processed:
+//..
+    int consume(MessageQueue *queue, bslma::Allocator *allocator, int count)
+        // Remove the specified 'count' messages from the specified 'queue',
+        // deallocating them using the specified 'allocator', and return the
+        // sum of their sequence numbers.
+    {
+        int sum = 0;
+        while (count) {
+            Message *message = 0;
+            {
+                bslmt::LockGuard<bslmt::Mutex> guard(&queue->d_mutex);
+                if (!queue->d_messages.empty()) {
+                    message = queue->d_messages.front();
+                    queue->d_messages.pop_front();
+                }
+            }
+            if (message) {
+                sum += message->d_sequenceNumber;
+                allocator->deleteObject(message);
+                --count;
+            }
+            else {
+                bslmt::ThreadUtil::yield();
+            }
+        }
+        return sum;
+    }
+//..
+
+}  // close namespace USAGE_EXAMPLE_1
+
+// ============================================================================
+//                               MAIN PROGRAM
+// ----------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    const int                 test = argc > 1 ? atoi(argv[1]) : 0;
+    const bool             verbose = argc > 2;
+    const bool         veryVerbose = argc > 3;
+    const bool     veryVeryVerbose = argc > 4;
+    const bool veryVeryVeryVerbose = argc > 5;
+
+    (void)veryVeryVerbose;
+
+    cout << "TEST " << __FILE__ << " CASE " << test << endl;
+
+    // CONCERN: 'BSLS_REVIEW' failures should lead to test failures.
+    bsls::ReviewFailureHandlerGuard reviewGuard(&bsls::Review::failByAbort);
+
+    // CONCERN: In no case does memory leak from the global allocator.
+
+    bslma::TestAllocator globalAllocator("global", veryVeryVeryVerbose);
+    bslma::Default::setGlobalAllocator(&globalAllocator);
+
+    switch (test) { case 0:
+      case 8: {
+        // --------------------------------------------------------------------
+        // USAGE EXAMPLE
+        //   Extracted from component header file.
+        //
+        // Concerns:
+        //: 1 The usage example provided in the component header file compiles,
+        //:   links, and runs as shown.
+        //
+        // Plan:
+        //: 1 Incorporate usage example from header into test driver, remove
+        //:   leading comment characters, and replace 'assert' with 'ASSERT'.
+        //:   (C-1)
+        //
+        // Testing:
+        //   USAGE EXAMPLE
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "USAGE EXAMPLE" << endl
+                          << "=============" << endl;
+
+        using namespace USAGE_EXAMPLE_1;
+
+        bslma::TestAllocator         da("default", veryVeryVeryVerbose);
+        bslma::DefaultAllocatorGuard dag(&da);
+
+// Then, we create the allocator, and run the producer and the consumer in
+// two threads:
+//..
+    bdlma::ThreadCachingMultipoolAllocator allocator;
+    MessageQueue                           queue;
+
+    enum { k_NUM_MESSAGES = 1000 };
+
+    Producer producer = { &queue, &allocator, k_NUM_MESSAGES };
+
+    bslmt::ThreadUtil::Handle handle;
+    bslmt::ThreadUtil::create(&handle, producer);
+
+    const int sum = consume(&queue, &allocator, k_NUM_MESSAGES);
+    bslmt::ThreadUtil::join(handle);
+
+    ASSERT(k_NUM_MESSAGES * (k_NUM_MESSAGES - 1) / 2 == sum);
+//..
+// Finally, we note that the calling thread (the consumer) holds at most one
+// magazine of message blocks in its cache, and return them to the allocator,
+// since the calling thread will not allocate messages anymore:
+//..
+    ASSERT(allocator.magazineCapacity() >= allocator.numThreadCachedBlocks());
+
+    allocator.drainThreadCache();
+    ASSERT(0 == allocator.numThreadCachedBlocks());
+//..
+      } break;
+      case 7: {
+        // --------------------------------------------------------------------
+        // CONCERN: CONCURRENT ALLOCATION AND DEALLOCATION
+        //
+        // Concerns:
+        //: 1 Blocks allocated concurrently by several threads are distinct:
+        //:   the contents of a block are not modified until it is
+        //:   deallocated.
+        //:
+        //: 2 Blocks can be deallocated by a thread other than the allocating
+        //:   thread, whether they are served from the thread caches or from
+        //:   the underlying multipool.
+        //:
+        //: 3 All memory is returned to the basic allocator on destruction.
+        //
+        // Plan:
+        //: 1 Run several threads that allocate blocks of pseudo-random sizes,
+        //:   some of which exceed 'maxCachedBlockSize', fill them, and
+        //:   exchange them through an array of slots, verifying and
+        //:   deallocating the block previously held by the slot.  Use small
+        //:   magazines so that magazines are frequently exchanged through the
+        //:   depots.  (C-1..2)
+        //:
+        //: 2 Deallocate the blocks remaining in the slots, destroy the
+        //:   allocator, and verify that no memory is in use from the basic
+        //:   allocator.  (C-3)
+        //
+        // Testing:
+        //   CONCERN: Concurrent allocation and deallocation.
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "CONCERN: CONCURRENT ALLOCATION AND DEALLOCATION"
+                          << endl
+                          << "==============================================="
+                          << endl;
+
+        enum { k_NUM_THREADS = 8, k_NUM_SLOTS = 256, k_ITERATIONS = 20000 };
+
+        bslma::TestAllocator ta("supplied", veryVeryVeryVerbose);
+        {
+            Obj          mX(10, 4, &ta);
+            bslmt::Mutex mutex;
+            void        *slots[k_NUM_SLOTS] = { 0 };
+            int          sizes[k_NUM_SLOTS] = { 0 };
+
+            StressJob                 jobs[k_NUM_THREADS];
+            bslmt::ThreadUtil::Handle handles[k_NUM_THREADS];
+
+            for (int i = 0; i < k_NUM_THREADS; ++i) {
+                StressJob job = { &mX,
+                                  &mutex,
+                                  slots,
+                                  sizes,
+                                  k_NUM_SLOTS,
+                                  i + 1,
+                                  k_ITERATIONS };
+                jobs[i] = job;
+                ASSERTV(i, 0 == bslmt::ThreadUtil::create(&handles[i],
+                                                          &exchangeBlocks,
+                                                          &jobs[i]));
+            }
+            for (int i = 0; i < k_NUM_THREADS; ++i) {
+                bslmt::ThreadUtil::join(handles[i]);
+            }
+
+            for (int i = 0; i < k_NUM_SLOTS; ++i) {
+                if (slots[i]) {
+                    ASSERTV(i, isFilled(slots[i], sizes[i]));
+                    mX.deallocate(slots[i]);
+                }
+            }
+
+            if (veryVerbose) {
+                P_(mX.numDepotMagazines()) P(ta.numBytesInUse())
+            }
+        }
+        ASSERTV(ta.numBytesInUse(), 0 == ta.numBytesInUse());
+      } break;
+      case 6: {
+        // --------------------------------------------------------------------
+        // MANIPULATOR: 'release'
+        //
+        // Concerns:
+        //: 1 'release' returns all memory allocated from the basic allocator
+        //:   for blocks, whether in use, held in a thread cache, or held in a
+        //:   depot.
+        //:
+        //: 2 The cache of the calling thread is emptied, and remains usable
+        //:   after 'release'.
+        //
+        // Plan:
+        //: 1 Allocate and deallocate blocks so that both the cache of the
+        //:   calling thread and the depot hold blocks, leave some blocks in
+        //:   use, and allocate a block beyond the size classes.  (C-1)
+        //:
+        //: 2 Call 'release', and verify that the only memory remaining in use
+        //:   from the basic allocator is the fixed bookkeeping of the
+        //:   allocator and its thread cache, that the cache and the depots
+        //:   are empty, and that allocation succeeds again.  (C-1..2)
+        //
+        // Testing:
+        //   void release();
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "MANIPULATOR: 'release'" << endl
+                          << "======================" << endl;
+
+        enum { k_CAPACITY = 8, k_NUM_BLOCKS = 5 * k_CAPACITY };
+
+        bslma::TestAllocator ta("supplied", veryVeryVeryVerbose);
+        {
+            Obj mX(10, k_CAPACITY, &ta);  const Obj& X = mX;
+
+            // Create the cache of the calling thread, and measure the fixed
+            // bookkeeping.
+
+            mX.deallocate(mX.allocate(1));
+            mX.release();
+
+            const Int64 k_BOOKKEEPING = ta.numBytesInUse();
+
+            void *blocks[k_NUM_BLOCKS];
+
+            for (int i = 0; i < k_NUM_BLOCKS; ++i) {
+                blocks[i] = mX.allocate(100);
+            }
+            for (int i = 0; i < k_NUM_BLOCKS - 3; ++i) {
+                mX.deallocate(blocks[i]);
+            }
+            void *large = mX.allocate(100000);
+            ASSERT(large);
+
+            ASSERT(0 < X.numThreadCachedBlocks());
+            ASSERT(0 < X.numDepotMagazines());
+            ASSERT(k_BOOKKEEPING < ta.numBytesInUse());
+
+            mX.release();
+
+            ASSERTV(k_BOOKKEEPING, ta.numBytesInUse(),
+                    k_BOOKKEEPING == ta.numBytesInUse());
+            ASSERT(0 == X.numThreadCachedBlocks());
+            ASSERT(0 == X.numDepotMagazines());
+
+            // The caches remain usable.
+
+            for (int i = 0; i < k_NUM_BLOCKS; ++i) {
+                blocks[i] = mX.allocate(100);
+                fill(blocks[i], 100);
+            }
+            for (int i = 0; i < k_NUM_BLOCKS; ++i) {
+                ASSERTV(i, isFilled(blocks[i], 100));
+                mX.deallocate(blocks[i]);
+            }
+            ASSERT(k_CAPACITY == X.numThreadCachedBlocks());
+        }
+        ASSERTV(ta.numBytesInUse(), 0 == ta.numBytesInUse());
+      } break;
+      case 5: {
+        // --------------------------------------------------------------------
+        // CONCERN: THREAD EXIT AND CROSS-THREAD DEALLOCATION
+        //
+        // Concerns:
+        //: 1 A thread deallocating blocks allocated by another thread caches
+        //:   at most one magazine of them; the other blocks are moved to the
+        //:   depot a magazine at a time.
+        //:
+        //: 2 The cache of a thread is returned to the allocator when the
+        //:   thread exits: full magazines are moved to the depot, and the
+        //:   other blocks are returned to the underlying multipool.
+        //:
+        //: 3 In a producer-consumer pattern, the blocks deallocated by the
+        //:   consumer are reused by the producer, so that the memory obtained
+        //:   from the basic allocator does not grow with the number of
+        //:   rounds.
+        //:
+        //: 4 More allocators than the thread-specific storage keys available
+        //:   to a process (e.g., 'PTHREAD_KEYS_MAX') can serve a thread from
+        //:   its caches at the same time.
+        //:
+        //: 5 A thread having a cache of a destroyed allocator can use other
+        //:   allocators, including one created at the same address, and exit,
+        //:   without accessing the destroyed allocator.
+        //
+        // Plan:
+        //: 1 In each of several rounds, have a producer thread allocate a
+        //:   number of blocks that is not a multiple of the magazine capacity,
+        //:   and then a consumer thread deallocate them.  Verify the number of
+        //:   blocks held by the threads before they exit, and the number of
+        //:   magazines in the depot after they exit.  (C-1..2)
+        //:
+        //: 2 Verify that the memory in use from the basic allocator after the
+        //:   first round does not change in the later rounds.  (C-3)
+        //:
+        //: 3 Create 2000 allocators, allocate and deallocate a block using
+        //:   each of them, and verify that the block is cached by the calling
+        //:   thread.  Repeat using the allocators in the order of creation,
+        //:   so that each cache is looked up behind the others, and after
+        //:   destroying half of the allocators.  (C-4)
+        //:
+        //: 4 In a thread, use and destroy several allocators at the same
+        //:   address, then allocate and deallocate more than a magazine of
+        //:   blocks using another allocator, and verify the number of blocks
+        //:   cached by the thread before it exits, and the number of
+        //:   magazines in the depot after it exits.  (C-5)
+        //
+        // Testing:
+        //   CONCERN: The caches of exiting threads are returned.
+        //   CONCERN: Cross-thread deallocation is bounded.
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                      << "CONCERN: THREAD EXIT AND CROSS-THREAD DEALLOCATION"
+                      << endl
+                      << "=================================================="
+                      << endl;
+
+        enum {
+            k_CAPACITY   = 16,
+            k_NUM_BLOCKS = 10 * k_CAPACITY + 5,
+            k_NUM_ROUNDS = 10,
+            k_SIZE       = 200
+        };
+
+        bslma::TestAllocator ta("supplied", veryVeryVeryVerbose);
+        {
+            Obj mX(10, k_CAPACITY, &ta);  const Obj& X = mX;
+
+            void  *blocks[k_NUM_BLOCKS];
+            Int64  bytesAfterFirstRound = 0;
+
+            for (int round = 0; round < k_NUM_ROUNDS; ++round) {
+                BlockJob job = { &mX, blocks, k_NUM_BLOCKS, k_SIZE, -1 };
+
+                bslmt::ThreadUtil::Handle handle;
+
+                ASSERT(0 == bslmt::ThreadUtil::create(&handle,
+                                                      &allocateBlocks,
+                                                      &job));
+                bslmt::ThreadUtil::join(handle);
+
+                // The producer took every full magazine from the depot, and
+                // its cache was empty when it exited.
+
+                ASSERTV(round, job.d_numCachedAtExit,
+                        0 == job.d_numCachedAtExit);
+                ASSERTV(round, X.numDepotMagazines(),
+                        0 == X.numDepotMagazines());
+
+                ASSERT(0 == bslmt::ThreadUtil::create(&handle,
+                                                      &deallocateBlocks,
+                                                      &job));
+                bslmt::ThreadUtil::join(handle);
+
+                // The consumer held one partial magazine when it exited, and
+                // moved the full magazines to the depot.
+
+                ASSERTV(round, job.d_numCachedAtExit,
+                        k_NUM_BLOCKS % k_CAPACITY == job.d_numCachedAtExit);
+                ASSERTV(round, X.numDepotMagazines(),
+                        k_NUM_BLOCKS / k_CAPACITY == X.numDepotMagazines());
+
+                if (0 == round) {
+                    bytesAfterFirstRound = ta.numBytesInUse();
+                }
+                ASSERTV(round, bytesAfterFirstRound, ta.numBytesInUse(),
+                        bytesAfterFirstRound == ta.numBytesInUse());
+            }
+
+            // The calling thread never used the allocator.
+
+            ASSERT(0 == X.numThreadCachedBlocks());
+        }
+        ASSERTV(ta.numBytesInUse(), 0 == ta.numBytesInUse());
+
+        if (verbose) cout << "\tTesting more allocators than keys." << endl;
+        {
+            enum { k_NUM_ALLOCATORS = 2000 };
+
+            bsl::vector<Obj *> allocators(&ta);
+
+            for (int i = 0; i < k_NUM_ALLOCATORS; ++i) {
+                allocators.push_back(new (ta) Obj(4, &ta));
+
+                Obj& mX = *allocators.back();  const Obj& X = mX;
+
+                mX.deallocate(mX.allocate(k_SIZE / 10));
+                ASSERTV(i, 1 == X.numThreadCachedBlocks());
+            }
+
+            for (int i = 0; i < k_NUM_ALLOCATORS; ++i) {
+                Obj& mX = *allocators[i];  const Obj& X = mX;
+
+                mX.deallocate(mX.allocate(k_SIZE / 10));
+                ASSERTV(i, 1 == X.numThreadCachedBlocks());
+            }
+
+            for (int i = 0; i < k_NUM_ALLOCATORS; i += 2) {
+                ta.deleteObject(allocators[i]);
+            }
+
+            for (int i = 1; i < k_NUM_ALLOCATORS; i += 2) {
+                Obj& mX = *allocators[i];  const Obj& X = mX;
+
+                mX.deallocate(mX.allocate(k_SIZE / 10));
+                ASSERTV(i, 1 == X.numThreadCachedBlocks());
+
+                ta.deleteObject(allocators[i]);
+            }
+        }
+        ASSERTV(ta.numBytesInUse(), 0 == ta.numBytesInUse());
+
+        if (verbose) cout << "\tTesting destroyed allocators." << endl;
+        {
+            Obj mX(10, k_CAPACITY, &ta);  const Obj& X = mX;
+
+            void     *blocks[k_CAPACITY + 1];
+            BlockJob  job = { &mX, blocks, k_CAPACITY + 1, k_SIZE, -1 };
+
+            bslmt::ThreadUtil::Handle handle;
+
+            ASSERT(0 == bslmt::ThreadUtil::create(&handle,
+                                                  &cycleBlocksAfterDestruction,
+                                                  &job));
+            bslmt::ThreadUtil::join(handle);
+
+            ASSERTV(job.d_numCachedAtExit, 1 == job.d_numCachedAtExit);
+            ASSERTV(X.numDepotMagazines(), 1 == X.numDepotMagazines());
+        }
+        ASSERTV(ta.numBytesInUse(), 0 == ta.numBytesInUse());
+      } break;
+      case 4: {
+        // --------------------------------------------------------------------
+        // MANIPULATORS: 'drainThreadCache' AND 'trim'
+        //
+        // Concerns:
+        //: 1 'drainThreadCache' empties the cache of the calling thread,
+        //:   moving full magazines to the depots and returning the blocks of
+        //:   partial magazines to the underlying multipool.
+        //:
+        //: 2 'drainThreadCache' has no effect if the calling thread has no
+        //:   cache, and does not create one.
+        //:
+        //: 3 'trim' empties the depots, returning their blocks to the
+        //:   underlying multipool, from which they can be allocated again.
+        //:
+        //: 4 Neither method returns memory to the basic allocator.
+        //
+        // Plan:
+        //: 1 Call 'drainThreadCache' on a new allocator, and verify that
+        //:   nothing is allocated from the basic allocator.  (C-2)
+        //:
+        //: 2 Fill the magazine of one size class and partially fill the
+        //:   magazine of another size class, call 'drainThreadCache', and
+        //:   verify the number of cached blocks and depot magazines.  (C-1)
+        //:
+        //: 3 Call 'trim', verify that the depots are empty, and that blocks
+        //:   can be allocated again without allocating from the basic
+        //:   allocator.  (C-3..4)
+        //
+        // Testing:
+        //   void drainThreadCache();
+        //   void trim();
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                      << "MANIPULATORS: 'drainThreadCache' AND 'trim'" << endl
+                      << "===========================================" << endl;
+
+        enum { k_CAPACITY = 8 };
+
+        bslma::TestAllocator ta("supplied", veryVeryVeryVerbose);
+        {
+            Obj mX(10, k_CAPACITY, &ta);  const Obj& X = mX;
+
+            const Int64 k_NUM_ALLOCATIONS = ta.numAllocations();
+
+            mX.drainThreadCache();
+
+            ASSERT(k_NUM_ALLOCATIONS == ta.numAllocations());
+            ASSERT(0 == X.numThreadCachedBlocks());
+
+            void *small[k_CAPACITY];
+            void *large[k_CAPACITY / 2];
+
+            for (int i = 0; i < k_CAPACITY; ++i) {
+                small[i] = mX.allocate(10);
+            }
+            for (int i = 0; i < k_CAPACITY / 2; ++i) {
+                large[i] = mX.allocate(1000);
+            }
+            for (int i = 0; i < k_CAPACITY; ++i) {
+                mX.deallocate(small[i]);
+            }
+            for (int i = 0; i < k_CAPACITY / 2; ++i) {
+                mX.deallocate(large[i]);
+            }
+
+            ASSERT(k_CAPACITY + k_CAPACITY / 2 == X.numThreadCachedBlocks());
+            ASSERT(0 == X.numDepotMagazines());
+
+            const Int64 k_BYTES_IN_USE = ta.numBytesInUse();
+
+            mX.drainThreadCache();
+
+            ASSERT(0 == X.numThreadCachedBlocks());
+            ASSERT(1 == X.numDepotMagazines());
+            ASSERT(k_BYTES_IN_USE == ta.numBytesInUse());
+
+            mX.trim();
+
+            ASSERT(0 == X.numThreadCachedBlocks());
+            ASSERT(0 == X.numDepotMagazines());
+            ASSERT(k_BYTES_IN_USE == ta.numBytesInUse());
+
+            // The blocks were returned to the underlying multipool.
+
+            const Int64 k_NUM_ALLOCATIONS2 = ta.numAllocations();
+
+            for (int i = 0; i < k_CAPACITY; ++i) {
+                small[i] = mX.allocate(10);
+            }
+            for (int i = 0; i < k_CAPACITY / 2; ++i) {
+                large[i] = mX.allocate(1000);
+            }
+            ASSERT(k_NUM_ALLOCATIONS2 == ta.numAllocations());
+
+            for (int i = 0; i < k_CAPACITY; ++i) {
+                mX.deallocate(small[i]);
+            }
+            for (int i = 0; i < k_CAPACITY / 2; ++i) {
+                mX.deallocate(large[i]);
+            }
+        }
+        ASSERTV(ta.numBytesInUse(), 0 == ta.numBytesInUse());
+      } break;
+      case 3: {
+        // --------------------------------------------------------------------
+        // MAGAZINES AND DEPOTS
+        //
+        // Concerns:
+        //: 1 The cache of a thread holds at most 'magazineCapacity' blocks of
+        //:   each size class.
+        //:
+        //: 2 Deallocating a block to a full magazine moves the magazine to the
+        //:   depot of its size class.
+        //:
+        //: 3 Allocating from an empty magazine takes a full magazine from the
+        //:   depot if one is available, without allocating from the basic
+        //:   allocator.
+        //:
+        //: 4 A magazine capacity of 1 is supported.
+        //
+        // Plan:
+        //: 1 For several magazine capacities, allocate three times the
+        //:   capacity of blocks, deallocate them, and verify the number of
+        //:   cached blocks and depot magazines after each deallocation.
+        //:   (C-1..2, 4)
+        //:
+        //: 2 Allocate the blocks again, and verify the number of cached blocks
+        //:   and depot magazines after each allocation, and that nothing is
+        //:   allocated from the basic allocator.  (C-3)
+        //
+        // Testing:
+        //   ThreadCachingMultipoolAllocator(int, int, Allocator *ba = 0);
+        //   int numDepotMagazines() const;
+        //   int numThreadCachedBlocks() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "MAGAZINES AND DEPOTS" << endl
+                          << "====================" << endl;
+
+        static const int CAPACITIES[] = { 1, 2, 7, 32 };
+        enum { NUM_CAPACITIES = sizeof CAPACITIES / sizeof *CAPACITIES };
+
+        for (int ci = 0; ci < NUM_CAPACITIES; ++ci) {
+            const int CAPACITY   = CAPACITIES[ci];
+            const int NUM_BLOCKS = 3 * CAPACITY;
+
+            if (veryVerbose) { T_ P(CAPACITY) }
+
+            bslma::TestAllocator ta("supplied", veryVeryVeryVerbose);
+            {
+                Obj mX(10, CAPACITY, &ta);  const Obj& X = mX;
+
+                ASSERTV(CAPACITY, CAPACITY == X.magazineCapacity());
+
+                bsl::vector<void *> blocks(NUM_BLOCKS, 0, &ta);
+
+                for (int i = 0; i < NUM_BLOCKS; ++i) {
+                    blocks[i] = mX.allocate(64);
+                }
+                for (int i = 0; i < NUM_BLOCKS; ++i) {
+                    mX.deallocate(blocks[i]);
+
+                    // The magazine is flushed when deallocating to a full
+                    // magazine, so a magazine is full after the last
+                    // deallocation.
+
+                    const int EXP_CACHED = i % CAPACITY + 1;
+                    const int EXP_DEPOT  = i / CAPACITY;
+
+                    ASSERTV(CAPACITY, i, X.numThreadCachedBlocks(),
+                            EXP_CACHED == X.numThreadCachedBlocks());
+                    ASSERTV(CAPACITY, i, X.numDepotMagazines(),
+                            EXP_DEPOT == X.numDepotMagazines());
+                }
+
+                const Int64 NUM_ALLOCATIONS = ta.numAllocations();
+
+                for (int i = 0; i < NUM_BLOCKS; ++i) {
+                    blocks[i] = mX.allocate(64);
+
+                    const int EXP_CACHED = CAPACITY - 1 - i % CAPACITY;
+                    const int EXP_DEPOT  = 2 - i / CAPACITY;
+
+                    ASSERTV(CAPACITY, i, X.numThreadCachedBlocks(),
+                            EXP_CACHED == X.numThreadCachedBlocks());
+                    ASSERTV(CAPACITY, i, X.numDepotMagazines(),
+                            EXP_DEPOT == X.numDepotMagazines());
+                }
+
+                ASSERTV(CAPACITY, NUM_ALLOCATIONS == ta.numAllocations());
+
+                // The blocks are distinct.
+
+                for (int i = 0; i < NUM_BLOCKS; ++i) {
+                    for (int j = 0; j < i; ++j) {
+                        ASSERTV(CAPACITY, i, j, blocks[i] != blocks[j]);
+                    }
+                }
+
+                for (int i = 0; i < NUM_BLOCKS; ++i) {
+                    mX.deallocate(blocks[i]);
+                }
+            }
+            ASSERTV(CAPACITY, ta.numBytesInUse(), 0 == ta.numBytesInUse());
+        }
+      } break;
+      case 2: {
+        // --------------------------------------------------------------------
+        // ALLOCATE AND DEALLOCATE
+        //
+        // Concerns:
+        //: 1 'maxCachedBlockSize' is the largest size served from a thread
+        //:   cache: the largest block of the underlying multipool less the
+        //:   size of the block header, or 0 if that block is smaller than
+        //:   twice the header.
+        //:
+        //: 2 The blocks returned by 'allocate' are maximally aligned, and
+        //:   can hold the requested number of bytes.
+        //:
+        //: 3 A block deallocated to the cache is reused by the next
+        //:   allocation of the same size class by the same thread, but not
+        //:   by an allocation of another size class.
+        //:
+        //: 4 Requests larger than 'maxCachedBlockSize' are served by the
+        //:   underlying multipool, and are not cached.
+        //:
+        //: 5 'allocate(0)' returns 0 and 'deallocate(0)' has no effect.
+        //
+        // Plan:
+        //: 1 For allocators having a varying number of pools, verify
+        //:   'numPools' and 'maxCachedBlockSize'.  (C-1)
+        //:
+        //: 2 For each size up to (and just beyond) 'maxCachedBlockSize',
+        //:   allocate a block, fill it, deallocate it, and verify that
+        //:   allocating a block of every size of the same size class returns
+        //:   the same block, and that a block of the neighbouring size
+        //:   classes is distinct.  (C-2..3)
+        //:
+        //: 3 Allocate and deallocate blocks larger than 'maxCachedBlockSize'
+        //:   and verify that the thread cache is unchanged.  (C-4)
+        //:
+        //: 4 Call 'allocate(0)' and 'deallocate(0)'.  (C-5)
+        //
+        // Testing:
+        //   ThreadCachingMultipoolAllocator(int numPools, Allocator *ba = 0);
+        //   void *allocate(bsls::Types::size_type size);
+        //   void deallocate(void *address);
+        //   bsls::Types::size_type maxCachedBlockSize() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "ALLOCATE AND DEALLOCATE" << endl
+                          << "=======================" << endl;
+
+        if (verbose) cout << "\nTesting 'maxCachedBlockSize'." << endl;
+
+        for (int numPools = 1; numPools <= 16; ++numPools) {
+            bslma::TestAllocator ta("supplied", veryVeryVeryVerbose);
+
+            Obj mX(numPools, &ta);  const Obj& X = mX;
+
+            ASSERTV(numPools, numPools == X.numPools());
+            ASSERTV(numPools, X.maxCachedBlockSize(),
+                    expectedMaxCachedBlockSize(numPools) ==
+                                                      X.maxCachedBlockSize());
+
+            // Allocators without cached size classes serve every request
+            // from the underlying multipool.
+
+            void *p = mX.allocate(100);
+            ASSERTV(numPools, isMaxAligned(p));
+            fill(p, 100);
+            ASSERTV(numPools, isFilled(p, 100));
+            mX.deallocate(p);
+            ASSERTV(numPools, 0 == X.numThreadCachedBlocks() ||
+                                        100 <= X.maxCachedBlockSize());
+        }
+
+        if (verbose) cout << "\nTesting size classes." << endl;
+        {
+            bslma::TestAllocator ta("supplied", veryVeryVeryVerbose);
+
+            Obj mX(8, &ta);  const Obj& X = mX;
+
+            const int MAX = static_cast<int>(X.maxCachedBlockSize());
+
+            for (int size = 1; size <= MAX; ++size) {
+                void *p = mX.allocate(size);
+
+                ASSERTV(size, isMaxAligned(p));
+                fill(p, size);
+                ASSERTV(size, isFilled(p, size));
+
+                mX.deallocate(p);
+                ASSERTV(size, 1 == X.numThreadCachedBlocks());
+
+                const size_type BLOCK_SIZE = sizeClassBlockSize(size);
+
+                // Every size of the same class reuses the block.
+
+                for (int other = 1; other <= MAX; other += 7) {
+                    if (sizeClassBlockSize(other) != BLOCK_SIZE) {
+                        continue;
+                    }
+                    void *q = mX.allocate(other);
+                    ASSERTV(size, other, p == q);
+                    mX.deallocate(q);
+                }
+
+                // A neighbouring class does not.
+
+                const int OTHER = BLOCK_SIZE == sizeClassBlockSize(MAX)
+                                  ? 1
+                                  : MAX;
+                if (sizeClassBlockSize(OTHER) != BLOCK_SIZE) {
+                    void *q = mX.allocate(OTHER);
+                    ASSERTV(size, p != q);
+                    mX.deallocate(q);
+                }
+
+                mX.drainThreadCache();
+                mX.trim();
+            }
+
+            if (verbose) cout << "\nTesting sizes beyond the caches." << endl;
+
+            ASSERT(0 == X.numThreadCachedBlocks());
+
+            const int SIZES[] = { MAX + 1, MAX + 100, 4 * MAX, 100000 };
+            enum { NUM_SIZES = sizeof SIZES / sizeof *SIZES };
+
+            for (int i = 0; i < NUM_SIZES; ++i) {
+                const int SIZE = SIZES[i];
+
+                void *p = mX.allocate(SIZE);
+                ASSERTV(SIZE, isMaxAligned(p));
+                fill(p, SIZE);
+                ASSERTV(SIZE, isFilled(p, SIZE));
+                mX.deallocate(p);
+
+                ASSERTV(SIZE, 0 == X.numThreadCachedBlocks());
+            }
+
+            if (verbose) cout << "\nTesting 0 size and null address." << endl;
+
+            ASSERT(0 == mX.allocate(0));
+            mX.deallocate(0);
+            ASSERT(0 == X.numThreadCachedBlocks());
+        }
+      } break;
+      case 1: {
+        // --------------------------------------------------------------------
+        // BREATHING TEST
+        //   This case exercises (but does not fully test) basic functionality.
+        //
+        // Concerns:
+        //: 1 The class is sufficiently functional to enable comprehensive
+        //:   testing in subsequent test cases.
+        //
+        // Plan:
+        //: 1 Create an allocator using the default configuration, allocate
+        //:   and deallocate a few blocks, and verify the basic accessors.
+        //:
+        //: 2 Verify that the allocator uses the default allocator if no basic
+        //:   allocator is supplied, and that all memory is returned on
+        //:   destruction.  (C-1)
+        //
+        // Testing:
+        //   BREATHING TEST
+        //   ThreadCachingMultipoolAllocator(bslma::Allocator *ba = 0);
+        //   ~ThreadCachingMultipoolAllocator();
+        //   int magazineCapacity() const;
+        //   int numPools() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "BREATHING TEST" << endl
+                          << "==============" << endl;
+
+        bslma::TestAllocator         da("default", veryVeryVeryVerbose);
+        bslma::DefaultAllocatorGuard dag(&da);
+
+        {
+            Obj mX;  const Obj& X = mX;
+
+            ASSERT(0 <  X.numPools());
+            ASSERT(0 <  X.magazineCapacity());
+            ASSERT(0 <  X.maxCachedBlockSize());
+            ASSERT(0 == X.numThreadCachedBlocks());
+            ASSERT(0 == X.numDepotMagazines());
+
+            void *p = mX.allocate(1);
+            void *q = mX.allocate(100);
+            ASSERT(p);
+            ASSERT(q);
+            ASSERT(p != q);
+            ASSERT(0 < da.numBytesInUse());
+
+            mX.deallocate(p);
+            ASSERT(1 == X.numThreadCachedBlocks());
+
+            mX.deallocate(q);
+            ASSERT(2 == X.numThreadCachedBlocks());
+
+            ASSERT(p == mX.allocate(1));
+            ASSERT(1 == X.numThreadCachedBlocks());
+        }
+        ASSERTV(da.numBytesInUse(), 0 == da.numBytesInUse());
+      } break;
+      case -1: {
+        // --------------------------------------------------------------------
+        // PERFORMANCE: COMPARISON WITH OTHER ALLOCATORS
+        //
+        // Concerns:
+        //: 1 Allocating and deallocating small blocks is faster through a
+        //:   'ThreadCachingMultipoolAllocator' than through a
+        //:   'ConcurrentMultipoolAllocator', and the difference increases with
+        //:   the number of threads using the allocator.
+        //
+        // Plan:
+        //: 1 For an increasing number of threads, have each thread repeatedly
+        //:   allocate and deallocate a batch of blocks of mixed sizes through
+        //:   a 'ThreadCachingMultipoolAllocator', a
+        //:   'ConcurrentMultipoolAllocator', and the 'NewDeleteAllocator', and
+        //:   report the time per allocation and deallocation pair.
+        //
+        // Testing:
+        //   PERFORMANCE: COMPARISON WITH OTHER ALLOCATORS
+        // --------------------------------------------------------------------
+
+        cout << endl
+             << "PERFORMANCE: COMPARISON WITH OTHER ALLOCATORS" << endl
+             << "=============================================" << endl;
+
+        enum { ITERATIONS = 200000 };
+
+        static const int NUM_THREADS[] = { 1, 2, 4, 8 };
+        enum { NUM_RUNS = sizeof NUM_THREADS / sizeof *NUM_THREADS };
+
+        cout << "threads  thread-caching  concurrent-multipool  new-delete"
+             << " (ns per pair)" << endl;
+
+        for (int i = 0; i < NUM_RUNS; ++i) {
+            const int NUM = NUM_THREADS[i];
+
+            Obj                                 tcma;
+            bdlma::ConcurrentMultipoolAllocator cma;
+
+            const double TCMA = runBenchmark(&tcma, NUM, ITERATIONS);
+            const double CMA  = runBenchmark(&cma, NUM, ITERATIONS);
+            const double ND   = runBenchmark(
+                                    &bslma::NewDeleteAllocator::singleton(),
+                                    NUM,
+                                    ITERATIONS);
+
+            cout << NUM << "\t " << TCMA << "\t\t " << CMA << "\t\t\t"
+                 << ND << endl;
+        }
+      } break;
+      default: {
+        cerr << "WARNING: CASE `" << test << "' NOT FOUND." << endl;
+        testStatus = -1;
+      }
+    }
+
+    // CONCERN: In no case does memory leak from the global allocator.
+
+    ASSERTV(globalAllocator.numBlocksInUse(),
+            0 == globalAllocator.numBlocksInUse());
+
+    if (testStatus > 0) {
+        cerr << "Error, non-zero test status = " << testStatus << "." << endl;
+    }
+    return testStatus;
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2020 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -12,10 +12,14 @@
 #include <bsls_ident.h>
 BSLS_IDENT_RCSID(bdlmt_eventscheduler_cpp,"$Id$ $CSID$")
 
+#include <bdlb_bitutil.h>
+
 #include <bdlf_bind.h>
 
 #include <bdlt_timeunitratio.h>
 
+#include <bslma_deallocatorproctor.h>
+
 #include <bslmt_lockguard.h>
 
 #include <bsls_assert.h>
@@ -23,6 +27,9 @@ BSLS_IDENT_RCSID(bdlmt_eventscheduler_cpp,"$Id$ $CSID$")
 #include <bsls_review.h>
 
 #include <bsl_algorithm.h>
+#include <bsl_cstdint.h>
+#include <bsl_limits.h>
+#include <bsl_new.h>
 #include <bsl_vector.h>
 
 // Implementation note: When casting, we often cast through 'void *' or
@@ -30,6 +37,16 @@ BSLS_IDENT_RCSID(bdlmt_eventscheduler_cpp,"$Id$ $CSID$")
 
 namespace BloombergLP {
 
+// STATIC DATA
+static const bsls::Types::Int64 k_TIMING_WHEEL_RESOLUTION = 1000;
+    // resolution, in microseconds, of the timing wheel queue type
+
+static const bsls::Types::Int64 k_MAX_TIME =
+                              bsl::numeric_limits<bsls::Types::Int64>::max();
+
+static const bsls::Types::Int64 k_MIN_TIME =
+                              bsl::numeric_limits<bsls::Types::Int64>::min();
+
 // STATIC FUNCTIONS
 static inline
 void defaultDispatcherFunction(const bsl::function<void()>& callback)
@@ -51,6 +68,438 @@ bsl::function<bsls::TimeInterval()> createDefaultCurrentTimeFunctor(
 
 namespace bdlmt {
 
+                      // --------------------------------
+                      // class EventScheduler_TimingWheel
+                      // --------------------------------
+
+// PRIVATE MANIPULATORS
+void EventScheduler_TimingWheel::advance(bsls::Types::Int64 limit)
+{
+    while (d_currentTick < limit) {
+        if (0 == d_numScheduled) {
+            // No slot needs to be expired or redistributed.
+
+            d_currentTick = limit;
+            return;                                                   // RETURN
+        }
+
+        const int slot = findSlot(
+                             0,
+                             static_cast<int>(d_currentTick & k_SLOT_MASK));
+
+        if (k_NUM_SLOTS > slot) {
+            const bsls::Types::Int64 tick =
+                      (d_currentTick & ~static_cast<bsls::Types::Int64>(
+                                                               k_SLOT_MASK))
+                    | slot;
+
+            if (tick >= limit) {
+                d_currentTick = limit;
+                return;                                               // RETURN
+            }
+            expire(slot);
+            d_currentTick = tick + 1;
+        }
+        else {
+            // The rest of the current level-0 block is empty: skip straight to
+            // the next block that has events to redistribute.
+
+            const bsls::Types::Int64 tick = nextCascadeTick();
+
+            if (tick > limit) {
+                d_currentTick = limit;
+                return;                                               // RETURN
+            }
+            d_currentTick = tick;
+        }
+
+        if (0 == (d_currentTick & k_SLOT_MASK)) {
+            cascade();
+        }
+    }
+}
+
+void EventScheduler_TimingWheel::append(int listIndex, Event *event)
+{
+    List& list = d_lists[listIndex];
+
+    event->d_next_p    = 0;
+    event->d_prev_p    = list.d_tail_p;
+    event->d_listIndex = listIndex;
+
+    if (list.d_tail_p) {
+        list.d_tail_p->d_next_p = event;
+    }
+    else {
+        list.d_head_p = event;
+        if (k_OVERFLOW > listIndex) {
+            d_occupied[listIndex / 64] |= 1ULL << (listIndex % 64);
+        }
+    }
+    list.d_tail_p = event;
+}
+
+void EventScheduler_TimingWheel::cascade()
+{
+    BSLS_ASSERT(0 == (d_currentTick & k_SLOT_MASK));
+
+    // Find the highest level whose block starts at the current tick, where
+    // 'k_NUM_LEVELS' denotes the overflow list.
+
+    int level = 1;
+    while (level < k_NUM_LEVELS
+        && 0 == (d_currentTick
+                 & ((1LL << (k_BITS_PER_LEVEL * (level + 1))) - 1))) {
+        ++level;
+    }
+
+    // Redistribute from the highest level down, so that events moved to a
+    // lower level are themselves redistributed if needed.
+
+    for (; 0 < level; --level) {
+        const int listIndex = k_NUM_LEVELS == level
+                            ? static_cast<int>(k_OVERFLOW)
+                            : level * k_NUM_SLOTS
+                              + static_cast<int>(
+                                  (d_currentTick >> (k_BITS_PER_LEVEL * level))
+                                                               & k_SLOT_MASK);
+        List& list  = d_lists[listIndex];
+        Event *event = list.d_head_p;
+
+        list.d_head_p = 0;
+        list.d_tail_p = 0;
+        if (k_OVERFLOW > listIndex) {
+            d_occupied[listIndex / 64] &= ~(1ULL << (listIndex % 64));
+        }
+
+        while (event) {
+            Event *next = event->d_next_p;
+
+            --d_numScheduled;
+            link(event);
+            event = next;
+        }
+    }
+}
+
+void EventScheduler_TimingWheel::expire(int listIndex)
+{
+    List& list = d_lists[listIndex];
+
+    if (0 == list.d_head_p) {
+        return;                                                       // RETURN
+    }
+
+    for (Event *event = list.d_head_p; event; event = event->d_next_p) {
+        event->d_listIndex = k_EXPIRED;
+        --d_numScheduled;
+    }
+
+    List& expired = d_lists[k_EXPIRED];
+
+    if (expired.d_tail_p) {
+        expired.d_tail_p->d_next_p = list.d_head_p;
+        list.d_head_p->d_prev_p    = expired.d_tail_p;
+    }
+    else {
+        expired.d_head_p = list.d_head_p;
+    }
+    expired.d_tail_p = list.d_tail_p;
+
+    list.d_head_p = 0;
+    list.d_tail_p = 0;
+    if (k_OVERFLOW > listIndex) {
+        d_occupied[listIndex / 64] &= ~(1ULL << (listIndex % 64));
+    }
+}
+
+bsls::Types::Int64 EventScheduler_TimingWheel::link(Event *event)
+{
+    if (event->d_time / d_resolution < d_currentTick) {
+        append(k_EXPIRED, event);
+        return d_currentTick * d_resolution;                          // RETURN
+    }
+
+    const bsls::Types::Int64 tick      = event->d_time / d_resolution;
+    int                      listIndex = k_OVERFLOW;
+
+    for (int level = 0; level < k_NUM_LEVELS; ++level) {
+        const int shift = k_BITS_PER_LEVEL * level;
+
+        if (0 == ((tick ^ d_currentTick) >> (shift + k_BITS_PER_LEVEL))) {
+            listIndex = level * k_NUM_SLOTS
+                      + static_cast<int>((tick >> shift) & k_SLOT_MASK);
+            break;
+        }
+    }
+
+    append(listIndex, event);
+    ++d_numScheduled;
+
+    return tick < k_MAX_TIME / d_resolution - 1
+           ? (tick + 1) * d_resolution
+           : k_MAX_TIME;
+}
+
+void EventScheduler_TimingWheel::unlink(Event *event)
+{
+    const int listIndex = event->d_listIndex;
+    List&     list      = d_lists[listIndex];
+
+    if (event->d_prev_p) {
+        event->d_prev_p->d_next_p = event->d_next_p;
+    }
+    else {
+        list.d_head_p = event->d_next_p;
+    }
+
+    if (event->d_next_p) {
+        event->d_next_p->d_prev_p = event->d_prev_p;
+    }
+    else {
+        list.d_tail_p = event->d_prev_p;
+    }
+
+    if (k_OVERFLOW > listIndex && 0 == list.d_head_p) {
+        d_occupied[listIndex / 64] &= ~(1ULL << (listIndex % 64));
+    }
+    if (k_EXPIRED != listIndex) {
+        --d_numScheduled;
+    }
+
+    event->d_next_p    = 0;
+    event->d_prev_p    = 0;
+    event->d_listIndex = -1;
+}
+
+// PRIVATE ACCESSORS
+int EventScheduler_TimingWheel::findSlot(int level, int slot) const
+{
+    int       index = level * k_NUM_SLOTS + slot;
+    const int end   = (level + 1) * k_NUM_SLOTS;
+
+    while (index < end) {
+        const bsls::Types::Uint64 word = d_occupied[index / 64]
+                                                          >> (index % 64);
+        if (word) {
+            return index
+                 + bdlb::BitUtil::numTrailingUnsetBits(
+                                           static_cast<bsl::uint64_t>(word))
+                 - level * k_NUM_SLOTS;
+                                                                      // RETURN
+        }
+        index = (index | 63) + 1;
+    }
+    return k_NUM_SLOTS;
+}
+
+bsls::Types::Int64 EventScheduler_TimingWheel::nextCascadeTick() const
+{
+    for (int level = 1; level < k_NUM_LEVELS; ++level) {
+        const int shift = k_BITS_PER_LEVEL * level;
+        const int slot  = findSlot(
+                    level,
+                    static_cast<int>((d_currentTick >> shift) & k_SLOT_MASK)
+                                                                        + 1);
+
+        if (k_NUM_SLOTS > slot) {
+            const int blockShift = shift + k_BITS_PER_LEVEL;
+
+            return ((d_currentTick >> blockShift) << blockShift)
+                 | (static_cast<bsls::Types::Int64>(slot) << shift);
+                                                                      // RETURN
+        }
+    }
+
+    if (d_lists[k_OVERFLOW].d_head_p) {
+        const int blockShift = k_BITS_PER_LEVEL * k_NUM_LEVELS;
+
+        return ((d_currentTick >> blockShift) + 1) << blockShift;     // RETURN
+    }
+
+    return k_MAX_TIME;
+}
+
+// CREATORS
+EventScheduler_TimingWheel::EventScheduler_TimingWheel(
+                                         bsls::Types::Int64  resolution,
+                                         bsls::Types::Int64  now,
+                                         bslma::Allocator   *basicAllocator)
+: d_currentTick(now / resolution)
+, d_resolution(resolution)
+, d_numScheduled(0)
+, d_numEvents(0)
+, d_numRecurringEvents(0)
+, d_pool(sizeof(Event), basicAllocator)
+, d_allocator_p(bslma::Default::allocator(basicAllocator))
+{
+    BSLS_ASSERT(0 < resolution);
+    BSLS_ASSERT(0 <= now);
+
+    for (int i = 0; i < k_NUM_LISTS; ++i) {
+        d_lists[i].d_head_p = 0;
+        d_lists[i].d_tail_p = 0;
+    }
+    for (int i = 0; i < k_OVERFLOW / 64; ++i) {
+        d_occupied[i] = 0;
+    }
+}
+
+EventScheduler_TimingWheel::~EventScheduler_TimingWheel()
+{
+    removeAll();
+}
+
+// MANIPULATORS
+EventScheduler_TimingWheel::Event *
+EventScheduler_TimingWheel::createEvent(
+                                bsls::Types::Int64           time,
+                                bsls::Types::Int64           interval,
+                                const bsl::function<void()>& callback)
+{
+    Event *event = static_cast<Event *>(d_pool.allocate());
+
+    bslma::DeallocatorProctor<bdlma::ConcurrentPool> proctor(event, &d_pool);
+
+    new (event) Event(time, interval, callback, &d_pool, d_allocator_p);
+
+    proctor.release();
+
+    return event;
+}
+
+bsls::Types::Int64 EventScheduler_TimingWheel::insert(Event *event)
+{
+    BSLS_ASSERT(0 > event->d_listIndex);
+
+    event->addReference();
+
+    if (event->d_interval) {
+        ++d_numRecurringEvents;
+    }
+    else {
+        ++d_numEvents;
+    }
+
+    return link(event);
+}
+
+EventScheduler_TimingWheel::Event *
+EventScheduler_TimingWheel::popExpired(bsls::Types::Int64 now)
+{
+    advance(now / d_resolution);
+
+    Event *event = d_lists[k_EXPIRED].d_head_p;
+
+    if (0 == event) {
+        return 0;                                                     // RETURN
+    }
+
+    unlink(event);
+
+    if (event->d_interval) {
+        // The reference of this wheel is retained by the rescheduled event,
+        // so add one for the caller.
+
+        event->d_time += event->d_interval;
+        link(event);
+        event->addReference();
+    }
+    else {
+        // The reference of this wheel is transferred to the caller.
+
+        --d_numEvents;
+    }
+
+    return event;
+}
+
+int EventScheduler_TimingWheel::remove(Event *event)
+{
+    if (0 > event->d_listIndex) {
+        return 1;                                                     // RETURN
+    }
+
+    unlink(event);
+
+    if (event->d_interval) {
+        --d_numRecurringEvents;
+    }
+    else {
+        --d_numEvents;
+    }
+
+    event->releaseReference();
+
+    return 0;
+}
+
+void EventScheduler_TimingWheel::removeAll()
+{
+    for (int i = 0; i < k_NUM_LISTS; ++i) {
+        Event *event = d_lists[i].d_head_p;
+
+        d_lists[i].d_head_p = 0;
+        d_lists[i].d_tail_p = 0;
+
+        while (event) {
+            Event *next = event->d_next_p;
+
+            event->d_next_p    = 0;
+            event->d_prev_p    = 0;
+            event->d_listIndex = -1;
+            event->releaseReference();
+            event = next;
+        }
+    }
+    for (int i = 0; i < k_OVERFLOW / 64; ++i) {
+        d_occupied[i] = 0;
+    }
+
+    d_numScheduled = 0;
+    d_numEvents    = 0;
+    d_numRecurringEvents = 0;
+}
+
+int EventScheduler_TimingWheel::reschedule(Event              *event,
+                                           bsls::Types::Int64  time,
+                                           bsls::Types::Int64 *dueTime)
+{
+    if (0 > event->d_listIndex) {
+        return 1;                                                     // RETURN
+    }
+
+    unlink(event);
+    event->d_time = time;
+    *dueTime = link(event);
+
+    return 0;
+}
+
+// ACCESSORS
+bsls::Types::Int64 EventScheduler_TimingWheel::nextExpirationTime() const
+{
+    if (d_lists[k_EXPIRED].d_head_p) {
+        return d_currentTick * d_resolution;                          // RETURN
+    }
+
+    const int slot = findSlot(0,
+                              static_cast<int>(d_currentTick & k_SLOT_MASK));
+
+    if (k_NUM_SLOTS > slot) {
+        const bsls::Types::Int64 tick =
+                      (d_currentTick & ~static_cast<bsls::Types::Int64>(
+                                                               k_SLOT_MASK))
+                    | slot;
+
+        return (tick + 1) * d_resolution;                             // RETURN
+    }
+
+    const bsls::Types::Int64 tick = nextCascadeTick();
+
+    return k_MAX_TIME == tick ? k_MAX_TIME : tick * d_resolution;
+}
+
                             // --------------------
                             // class EventScheduler
                             // --------------------
@@ -94,8 +543,37 @@ bsls::Types::Int64 EventScheduler::chooseNextEvent(bsls::Types::Int64 *now)
     return t;
 }
 
+int EventScheduler::cancelTimingWheelEvent(const void *handle, bool wait)
+{
+    if (0 == handle) {
+        return EventQueue::e_INVALID;                                 // RETURN
+    }
+
+    TimingWheelEvent *event = toTimingWheelEvent(handle);
+
+    bslmt::LockGuard<bslmt::Mutex> lock(&d_mutex);
+
+    int ret = d_timingWheel_p->remove(event) ? EventQueue::e_NOT_FOUND : 0;
+
+    if (wait) {
+        // Wait until the next iteration if currently executing the event.
+
+        while (d_currentWheelEvent_p == event) {
+            d_dispatcherAwaited = true;
+            d_iterationCondition.wait(&d_mutex);
+        }
+    }
+
+    return ret;
+}
+
 void EventScheduler::dispatchEvents()
 {
+    if (d_timingWheel_p) {
+        dispatchTimingWheelEvents();
+        return;                                                       // RETURN
+    }
+
     bsls::Types::Int64 now = d_currentTimeFunctor().totalMicroseconds();
 
     while (1) {
@@ -162,6 +640,54 @@ void EventScheduler::dispatchEvents()
 
 }
 
+void EventScheduler::dispatchTimingWheelEvents()
+{
+    while (1) {
+        bslmt::LockGuard<bslmt::Mutex> lock(&d_mutex);
+
+        // Get ready for the next iteration.
+
+        if (d_currentWheelEvent_p) {
+            d_currentWheelEvent_p->releaseReference();
+            d_currentWheelEvent_p = 0;
+        }
+
+        if (d_dispatcherAwaited) {
+            d_dispatcherAwaited = false;
+            d_iterationCondition.broadcast();
+        }
+
+        // Now proceed with the next iteration.
+
+        if (!d_running) {
+            return;                                                   // RETURN
+        }
+
+        d_currentWheelEvent_p = d_timingWheel_p->popExpired(
+                                 d_currentTimeFunctor().totalMicroseconds());
+
+        if (0 == d_currentWheelEvent_p) {
+            d_wheelWakeupTime = d_timingWheel_p->nextExpirationTime();
+            ++d_waitCount;
+            if (k_MAX_TIME == d_wheelWakeupTime) {
+                d_queueCondition.wait(&d_mutex);
+            }
+            else {
+                bsls::TimeInterval w;
+                w.addMicroseconds(d_wheelWakeupTime);
+                d_queueCondition.timedWait(&d_mutex, w);
+            }
+            d_wheelWakeupTime = k_MIN_TIME;
+            continue;
+        }
+
+        // We have an event due for execution.
+
+        lock.release()->unlock();
+        d_dispatcherFunctor(d_currentWheelEvent_p->d_callback);
+    }
+}
+
 void EventScheduler::releaseCurrentEvents()
 {
     if (d_currentRecurringEvent) {
@@ -175,6 +701,26 @@ void EventScheduler::releaseCurrentEvents()
     }
 }
 
+EventScheduler::TimingWheelEvent *EventScheduler::scheduleTimingWheelEvent(
+                                       bsls::Types::Int64            time,
+                                       bsls::Types::Int64            interval,
+                                       const bsl::function<void()>&  callback)
+{
+    TimingWheelEvent *event = d_timingWheel_p->createEvent(time,
+                                                           interval,
+                                                           callback);
+
+    bslmt::LockGuard<bslmt::Mutex> lock(&d_mutex);
+
+    // Wake the dispatcher thread only if it is waiting for a later time.
+
+    if (d_timingWheel_p->insert(event) < d_wheelWakeupTime) {
+        d_queueCondition.signal();
+    }
+
+    return event;
+}
+
 // CREATORS
 EventScheduler::EventScheduler(bslma::Allocator *basicAllocator)
 : d_currentTimeFunctor(bsl::allocator_arg_t(), basicAllocator,
@@ -191,6 +737,9 @@ EventScheduler::EventScheduler(bslma::Allocator *basicAllocator)
 , d_currentEvent(0)
 , d_waitCount(0)
 , d_clockType(bsls::SystemClockType::e_REALTIME)
+, d_timingWheel_p(0)
+, d_currentWheelEvent_p(0)
+, d_wheelWakeupTime(k_MIN_TIME)
 {
 }
 
@@ -210,6 +759,9 @@ EventScheduler::EventScheduler(bsls::SystemClockType::Enum  clockType,
 , d_currentEvent(0)
 , d_waitCount(0)
 , d_clockType(clockType)
+, d_timingWheel_p(0)
+, d_currentWheelEvent_p(0)
+, d_wheelWakeupTime(k_MIN_TIME)
 {
 }
 
@@ -230,12 +782,69 @@ EventScheduler::EventScheduler(
 , d_currentEvent(0)
 , d_waitCount(0)
 , d_clockType(bsls::SystemClockType::e_REALTIME)
+, d_timingWheel_p(0)
+, d_currentWheelEvent_p(0)
+, d_wheelWakeupTime(k_MIN_TIME)
+{
+}
+
+EventScheduler::EventScheduler(
+                          const EventScheduler::Dispatcher&  dispatcherFunctor,
+                          bsls::SystemClockType::Enum        clockType,
+                          bslma::Allocator                  *basicAllocator)
+: d_currentTimeFunctor(bsl::allocator_arg_t(), basicAllocator,
+                       createDefaultCurrentTimeFunctor(clockType))
+, d_eventQueue(basicAllocator)
+, d_recurringQueue(basicAllocator)
+, d_dispatcherFunctor(bsl::allocator_arg_t(), basicAllocator,
+                      dispatcherFunctor)
+, d_dispatcherThread(bslmt::ThreadUtil::invalidHandle())
+, d_queueCondition(clockType)
+, d_running(false)
+, d_dispatcherAwaited(false)
+, d_currentRecurringEvent(0)
+, d_currentEvent(0)
+, d_waitCount(0)
+, d_clockType(clockType)
+, d_timingWheel_p(0)
+, d_currentWheelEvent_p(0)
+, d_wheelWakeupTime(k_MIN_TIME)
 {
 }
 
+EventScheduler::EventScheduler(bsls::SystemClockType::Enum  clockType,
+                               QueueType                    queueType,
+                               bslma::Allocator            *basicAllocator)
+: d_currentTimeFunctor(bsl::allocator_arg_t(), basicAllocator,
+                       createDefaultCurrentTimeFunctor(clockType))
+, d_eventQueue(basicAllocator)
+, d_recurringQueue(basicAllocator)
+, d_dispatcherFunctor(bsl::allocator_arg_t(), basicAllocator,
+                      &defaultDispatcherFunction)
+, d_dispatcherThread(bslmt::ThreadUtil::invalidHandle())
+, d_queueCondition(clockType)
+, d_running(false)
+, d_dispatcherAwaited(false)
+, d_currentRecurringEvent(0)
+, d_currentEvent(0)
+, d_waitCount(0)
+, d_clockType(clockType)
+, d_timingWheel_p(0)
+, d_currentWheelEvent_p(0)
+, d_wheelWakeupTime(k_MIN_TIME)
+{
+    if (e_TIMING_WHEEL == queueType) {
+        d_timingWheel_p = new (*allocator()) EventScheduler_TimingWheel(
+                                 k_TIMING_WHEEL_RESOLUTION,
+                                 d_currentTimeFunctor().totalMicroseconds(),
+                                 allocator());
+    }
+}
+
 EventScheduler::EventScheduler(
                           const EventScheduler::Dispatcher&  dispatcherFunctor,
                           bsls::SystemClockType::Enum        clockType,
+                          QueueType                          queueType,
                           bslma::Allocator                  *basicAllocator)
 : d_currentTimeFunctor(bsl::allocator_arg_t(), basicAllocator,
                        createDefaultCurrentTimeFunctor(clockType))
@@ -251,12 +860,25 @@ EventScheduler::EventScheduler(
 , d_currentEvent(0)
 , d_waitCount(0)
 , d_clockType(clockType)
+, d_timingWheel_p(0)
+, d_currentWheelEvent_p(0)
+, d_wheelWakeupTime(k_MIN_TIME)
 {
+    if (e_TIMING_WHEEL == queueType) {
+        d_timingWheel_p = new (*allocator()) EventScheduler_TimingWheel(
+                                 k_TIMING_WHEEL_RESOLUTION,
+                                 d_currentTimeFunctor().totalMicroseconds(),
+                                 allocator());
+    }
 }
 
 EventScheduler::~EventScheduler()
 {
     BSLS_ASSERT(bslmt::ThreadUtil::invalidHandle() == d_dispatcherThread);
+
+    if (d_timingWheel_p) {
+        allocator()->deleteObject(d_timingWheel_p);
+    }
 }
 
 // MANIPULATORS
@@ -325,6 +947,15 @@ EventScheduler::scheduleEvent(EventHandle                  *event,
                               const bsls::TimeInterval&     epochTime,
                               const bsl::function<void()>&  callback)
 {
+    if (d_timingWheel_p) {
+        event->release();
+        event->d_wheelEvent_p = scheduleTimingWheelEvent(
+                                               epochTime.totalMicroseconds(),
+                                               0,
+                                               callback);
+        return;                                                       // RETURN
+    }
+
     bool newTop;
 
     d_eventQueue.addR(&event->d_handle,
@@ -342,6 +973,20 @@ void EventScheduler::scheduleEventRaw(Event                        **event,
                                       const bsls::TimeInterval&      epochTime,
                                       const bsl::function<void()>&   callback)
 {
+    if (d_timingWheel_p) {
+        TimingWheelEvent *wheelEvent = scheduleTimingWheelEvent(
+                                               epochTime.totalMicroseconds(),
+                                               0,
+                                               callback);
+        if (event) {
+            *event = static_cast<Event *>(static_cast<void *>(wheelEvent));
+        }
+        else {
+            wheelEvent->releaseReference();
+        }
+        return;                                                       // RETURN
+    }
+
     bool newTop;
 
     d_eventQueue.addRawR((EventQueue::Pair **)event,
@@ -372,6 +1017,15 @@ EventScheduler::scheduleRecurringEvent(
         stime = (d_currentTimeFunctor() + interval).totalMicroseconds();
     }
 
+    if (d_timingWheel_p) {
+        event->release();
+        event->d_wheelEvent_p = scheduleTimingWheelEvent(
+                                                 stime,
+                                                 interval.totalMicroseconds(),
+                                                 callback);
+        return;                                                       // RETURN
+    }
+
     RecurringEventData recurringEventData(callback, interval);
 
     bool newTop;
@@ -404,6 +1058,21 @@ EventScheduler::scheduleRecurringEventRaw(
         stime = (d_currentTimeFunctor() + interval).totalMicroseconds();
     }
 
+    if (d_timingWheel_p) {
+        TimingWheelEvent *wheelEvent = scheduleTimingWheelEvent(
+                                                 stime,
+                                                 interval.totalMicroseconds(),
+                                                 callback);
+        if (event) {
+            *event = static_cast<RecurringEvent *>(
+                                         static_cast<void *>(wheelEvent));
+        }
+        else {
+            wheelEvent->releaseReference();
+        }
+        return;                                                       // RETURN
+    }
+
     RecurringEventData recurringEventData(callback, interval);
 
     bool newTop;
@@ -445,6 +1114,10 @@ int EventScheduler::cancelEventAndWait(const RecurringEvent *handle)
     BSLS_ASSERT(!bslmt::ThreadUtil::isEqual(bslmt::ThreadUtil::self(),
                                             d_dispatcherThread));
 
+    if (d_timingWheel_p) {
+        return cancelTimingWheelEvent(handle, true);                  // RETURN
+    }
+
     const RecurringEventQueue::Pair *itemPtr =
                        reinterpret_cast<const RecurringEventQueue::Pair *>(
                                        reinterpret_cast<const void *>(handle));
@@ -482,6 +1155,10 @@ int EventScheduler::cancelEventAndWait(const Event *handle)
     BSLS_ASSERT(!bslmt::ThreadUtil::isEqual(bslmt::ThreadUtil::self(),
                                             d_dispatcherThread));
 
+    if (d_timingWheel_p) {
+        return cancelTimingWheelEvent(handle, true);                  // RETURN
+    }
+
     const EventQueue::Pair *itemPtr =
                              reinterpret_cast<const EventQueue::Pair *>(
                                        reinterpret_cast<const void *>(handle));
@@ -534,6 +1211,25 @@ int EventScheduler::cancelEventAndWait(RecurringEventHandle *handle)
 int EventScheduler::rescheduleEvent(const Event               *handle,
                                     const bsls::TimeInterval&  newEpochTime)
 {
+    if (d_timingWheel_p) {
+        if (0 == handle) {
+            return EventQueue::e_INVALID;                             // RETURN
+        }
+
+        bsls::Types::Int64             dueTime;
+        bslmt::LockGuard<bslmt::Mutex> lock(&d_mutex);
+
+        if (d_timingWheel_p->reschedule(toTimingWheelEvent(handle),
+                                        newEpochTime.totalMicroseconds(),
+                                        &dueTime)) {
+            return EventQueue::e_NOT_FOUND;                           // RETURN
+        }
+        if (dueTime < d_wheelWakeupTime) {
+            d_queueCondition.signal();
+        }
+        return 0;                                                     // RETURN
+    }
+
     const EventQueue::Pair *h = reinterpret_cast<const EventQueue::Pair *>(
                                        reinterpret_cast<const void *>(handle));
 
@@ -557,6 +1253,25 @@ int EventScheduler::rescheduleEventAndWait(
     BSLS_ASSERT(!bslmt::ThreadUtil::isEqual(bslmt::ThreadUtil::self(),
                                             d_dispatcherThread));
 
+    if (d_timingWheel_p) {
+        int ret = rescheduleEvent(handle, newEpochTime);
+
+        if (EventQueue::e_INVALID == ret) {
+            return ret;                                               // RETURN
+        }
+
+        // Wait until event is rescheduled or dispatched.
+
+        const TimingWheelEvent *event = toTimingWheelEvent(handle);
+
+        bslmt::LockGuard<bslmt::Mutex> lock(&d_mutex);
+        while (d_currentWheelEvent_p == event) {
+            d_dispatcherAwaited = true;
+            d_iterationCondition.wait(&d_mutex);
+        }
+        return ret;                                                   // RETURN
+    }
+
     const EventQueue::Pair *h = reinterpret_cast<const EventQueue::Pair *>(
                                        reinterpret_cast<const void *>(handle));
     int ret;
@@ -596,6 +1311,12 @@ int EventScheduler::rescheduleEventAndWait(
 
 void EventScheduler::cancelAllEvents()
 {
+    if (d_timingWheel_p) {
+        bslmt::LockGuard<bslmt::Mutex> lock(&d_mutex);
+        d_timingWheel_p->removeAll();
+        return;                                                       // RETURN
+    }
+
     d_eventQueue.removeAll();
     d_recurringQueue.removeAll();
 }
@@ -605,6 +1326,16 @@ void EventScheduler::cancelAllEventsAndWait()
     BSLS_ASSERT(!bslmt::ThreadUtil::isEqual(bslmt::ThreadUtil::self(),
                                             d_dispatcherThread));
 
+    if (d_timingWheel_p) {
+        bslmt::LockGuard<bslmt::Mutex> lock(&d_mutex);
+        d_timingWheel_p->removeAll();
+        while (d_currentWheelEvent_p) {
+            d_dispatcherAwaited = true;
+            d_iterationCondition.wait(&d_mutex);
+        }
+        return;                                                       // RETURN
+    }
+
     d_eventQueue.removeAll();
     d_recurringQueue.removeAll();
 
@@ -111,6 +111,40 @@ BSLS_IDENT("$Id: $")
 // dispatcher thread becomes available; once the backlog is worked off, events
 // will be executed at or near their scheduled times.
 //
+///Choosing the Event Queue
+///-------------------------
+// By default, pending events are held in a 'bdlcc::SkipList' ordered by their
+// scheduled time, so scheduling and canceling an event is 'O(log(N))' in the
+// number of pending events, and each such operation allocates memory and
+// traverses several nodes.  This is appropriate for most applications, but
+// becomes a bottleneck when a very large number of events (for example, a
+// timeout for each of a million outstanding requests) are scheduled and
+// canceled at a high rate.
+//
+// For such applications, a 'bdlmt::EventScheduler' may be constructed with
+// the 'e_TIMING_WHEEL' queue type, in which case pending events are held in a
+// hashed hierarchical timing wheel (see "Hashed and Hierarchical Timing
+// Wheels", Varghese and Lauck, 1987).  The wheel has a resolution of one
+// millisecond and four levels of 256 slots each; events scheduled more than
+// about 49 days ahead are held in an overflow list and redistributed into the
+// wheel as their time approaches.  Scheduling, rescheduling, and canceling an
+// event are 'O(1)', event memory is supplied by a pool, and all events
+// falling in the same millisecond are expired as a single batch.  The
+// trade-offs are:
+//
+//: o An event is dispatched no earlier than its scheduled time, but may be
+//:   dispatched up to one millisecond later than it would have been using the
+//:   default queue type.
+//:
+//: o Events scheduled within the same millisecond are dispatched in the order
+//:   in which they were scheduled, rather than in the order of their
+//:   scheduled times, and one-time and recurring events are not distinguished
+//:   when ordering dispatches.
+//
+// The interface of 'bdlmt::EventScheduler', including the handle types and the
+// "Raw" API, is identical for both queue types.  Handles and raw pointers
+// obtained from one scheduler must not be supplied to another scheduler.
+//
 ///Supported Clock-Types
 ///---------------------
 // The component 'bsls::SystemClockType' supplies the enumeration indicating
@@ -382,6 +416,8 @@ BSLS_IDENT("$Id: $")
 
 #include <bdlcc_skiplist.h>
 
+#include <bdlma_concurrentpool.h>
+
 #include <bslma_usesbslmaallocator.h>
 
 #include <bslmf_nestedtraitdeclaration.h>
@@ -408,6 +444,251 @@ namespace bdlmt {
 class EventSchedulerEventHandle;
 class EventSchedulerRecurringEventHandle;
 
+                   // ======================================
+                   // struct EventScheduler_TimingWheelEvent
+                   // ======================================
+
+struct EventScheduler_TimingWheelEvent {
+    // This 'struct' holds a single event pending in an
+    // 'EventScheduler_TimingWheel'.  Objects of this type are reference
+    // counted: the timing wheel holds one reference while the event is
+    // pending, and every handle, raw pointer, and dispatch in progress holds
+    // another.  The object is returned to the pool that supplied it when the
+    // last reference is released.  This 'struct' is an implementation detail
+    // of 'EventScheduler' and must not be used directly.
+
+    // DATA
+    EventScheduler_TimingWheelEvent *d_next_p;     // next event in the list
+                                                   // holding this event
+
+    EventScheduler_TimingWheelEvent *d_prev_p;     // previous event in the
+                                                   // list holding this event
+
+    bsls::Types::Int64               d_time;       // scheduled time, in
+                                                   // microseconds
+
+    bsls::Types::Int64               d_interval;   // period, in microseconds,
+                                                   // or 0 for one-time events
+
+    int                              d_listIndex;  // index of the list holding
+                                                   // this event, or -1 if the
+                                                   // event is not pending
+
+    bsls::AtomicInt                  d_refCount;   // number of references
+
+    bdlma::ConcurrentPool           *d_pool_p;     // pool supplying the
+                                                   // memory of this object
+                                                   // (held, not owned)
+
+    bsl::function<void()>            d_callback;   // callback to dispatch
+
+    // CREATORS
+    EventScheduler_TimingWheelEvent(
+                            bsls::Types::Int64            time,
+                            bsls::Types::Int64            interval,
+                            const bsl::function<void()>&  callback,
+                            bdlma::ConcurrentPool        *pool,
+                            bslma::Allocator             *basicAllocator = 0);
+        // Create an event having the specified 'time' and 'interval' that
+        // dispatches the specified 'callback', whose footprint was supplied
+        // by the specified 'pool', and having a reference count of one.
+        // Optionally specify a 'basicAllocator' used to supply memory.  If
+        // 'basicAllocator' is 0, the currently installed default allocator is
+        // used.
+
+    // MANIPULATORS
+    void addReference();
+        // Increment the reference count of this event.
+
+    void releaseReference();
+        // Decrement the reference count of this event, and destroy this event
+        // and return its footprint to the pool that supplied it if no
+        // references remain.
+};
+
+                      // ================================
+                      // class EventScheduler_TimingWheel
+                      // ================================
+
+class EventScheduler_TimingWheel {
+    // This class implements a hashed hierarchical timing wheel holding
+    // 'EventScheduler_TimingWheelEvent' objects.  Time is divided into ticks
+    // of a fixed resolution.  An event due in a tick that shares all but its
+    // lowest 'k_BITS_PER_LEVEL * (L + 1)' bits with the current tick is held
+    // in a slot at level 'L' indexed by bits 'k_BITS_PER_LEVEL * L' and above
+    // of its tick; events too far in the future for the highest level are
+    // held in an overflow list.  Whenever the current tick enters a new block
+    // of a level, the events in the corresponding slot are redistributed into
+    // the lower levels.  Events whose tick has elapsed are moved, a slot at a
+    // time, to a list of expired events.  This class is an implementation
+    // detail of 'EventScheduler', is not thread-safe, and must not be used
+    // directly.
+
+  public:
+    // TYPES
+    typedef EventScheduler_TimingWheelEvent Event;
+
+    enum {
+        k_BITS_PER_LEVEL = 8,                              // bits per level
+        k_NUM_SLOTS      = 1 << k_BITS_PER_LEVEL,          // slots per level
+        k_SLOT_MASK      = k_NUM_SLOTS - 1,
+        k_NUM_LEVELS     = 4,                              // levels in wheel
+        k_OVERFLOW       = k_NUM_LEVELS * k_NUM_SLOTS,     // overflow list
+        k_EXPIRED        = k_OVERFLOW + 1,                 // expired list
+        k_NUM_LISTS      = k_EXPIRED + 1
+    };
+
+  private:
+    // PRIVATE TYPES
+    struct List {
+        // Doubly-linked list of events.
+
+        Event *d_head_p;  // first event, or 0 if empty
+        Event *d_tail_p;  // last event, or 0 if empty
+    };
+
+    // DATA
+    List                  d_lists[k_NUM_LISTS];     // slots of every level,
+                                                    // followed by the
+                                                    // overflow and expired
+                                                    // lists
+
+    bsls::Types::Uint64   d_occupied[k_OVERFLOW / 64];
+                                                    // bit set for each
+                                                    // non-empty slot
+
+    bsls::Types::Int64    d_currentTick;            // earliest tick that has
+                                                    // not yet elapsed
+
+    bsls::Types::Int64    d_resolution;             // microseconds per tick
+
+    int                   d_numScheduled;           // number of events in the
+                                                    // slots and overflow list
+
+    bsls::AtomicInt       d_numEvents;              // number of pending
+                                                    // one-time events
+
+    bsls::AtomicInt       d_numRecurringEvents;     // number of pending
+                                                    // recurring events
+
+    bdlma::ConcurrentPool d_pool;                   // event memory
+
+    bslma::Allocator     *d_allocator_p;            // memory allocator (held,
+                                                    // not owned)
+
+    // NOT IMPLEMENTED
+    EventScheduler_TimingWheel(const EventScheduler_TimingWheel&);
+    EventScheduler_TimingWheel& operator=(const EventScheduler_TimingWheel&);
+
+    // PRIVATE MANIPULATORS
+    void advance(bsls::Types::Int64 limit);
+        // Move to the expired list every event due in a tick earlier than the
+        // specified 'limit', and set the current tick to 'limit' if it is
+        // earlier.
+
+    void append(int listIndex, Event *event);
+        // Append the specified 'event' to the list having the specified
+        // 'listIndex'.
+
+    void cascade();
+        // Redistribute the events in the slot of every level, and in the
+        // overflow list, whose block starts at the current tick.  The
+        // behavior is undefined unless the current tick is a multiple of
+        // 'k_NUM_SLOTS'.
+
+    void expire(int listIndex);
+        // Move all events in the list having the specified 'listIndex' to the
+        // end of the expired list.
+
+    bsls::Types::Int64 link(Event *event);
+        // Add the specified 'event' to the list appropriate for its scheduled
+        // time, and return the time, in microseconds, at which it is due to
+        // be moved to the expired list.
+
+    void unlink(Event *event);
+        // Remove the specified 'event' from the list holding it.
+
+    // PRIVATE ACCESSORS
+    int findSlot(int level, int slot) const;
+        // Return the index of the first non-empty slot at the specified
+        // 'level' that is not earlier than the specified 'slot', or
+        // 'k_NUM_SLOTS' if there is no such slot.
+
+    bsls::Types::Int64 nextCascadeTick() const;
+        // Return the earliest tick later than the current tick at which a
+        // non-empty slot of a level above 0, or the overflow list, must be
+        // redistributed, or the maximum 'bsls::Types::Int64' value if there
+        // is no such tick.
+
+  public:
+    // CREATORS
+    EventScheduler_TimingWheel(bsls::Types::Int64  resolution,
+                               bsls::Types::Int64  now,
+                               bslma::Allocator   *basicAllocator = 0);
+        // Create an empty timing wheel having ticks of the specified
+        // 'resolution' and whose current tick contains the specified 'now',
+        // both in microseconds.  Optionally specify a 'basicAllocator' used
+        // to supply memory.  If 'basicAllocator' is 0, the currently
+        // installed default allocator is used.  The behavior is undefined
+        // unless '0 < resolution' and '0 <= now'.
+
+    ~EventScheduler_TimingWheel();
+        // Remove all pending events and destroy this object.
+
+    // MANIPULATORS
+    Event *createEvent(bsls::Types::Int64           time,
+                       bsls::Types::Int64           interval,
+                       const bsl::function<void()>& callback);
+        // Return a new event, having a reference count of one and not yet
+        // pending in this wheel, that dispatches the specified 'callback' at
+        // the specified 'time' and, unless the specified 'interval' is 0,
+        // every 'interval' thereafter (both in microseconds).  Note that,
+        // unlike other manipulators, this method may be invoked concurrently
+        // with any other method of this object.
+
+    bsls::Types::Int64 insert(Event *event);
+        // Add a reference to the specified 'event', make it pending in this
+        // wheel, and return the time, in microseconds, at which it is due to
+        // expire.  The behavior is undefined unless 'event' was created by
+        // this wheel and is not pending.
+
+    Event *popExpired(bsls::Types::Int64 now);
+        // Expire the events due before the specified 'now' and return the
+        // earliest expired event, or 0 if no events have expired.  A returned
+        // recurring event remains pending, rescheduled one interval later,
+        // and a returned one-time event is no longer pending; in either case,
+        // the caller is responsible for releasing one reference to the
+        // returned event.
+
+    int remove(Event *event);
+        // Remove the specified 'event' from this wheel and release the
+        // reference held by this wheel.  Return 0 on success, and a non-zero
+        // value if 'event' is not pending.
+
+    void removeAll();
+        // Remove all pending events from this wheel.
+
+    int reschedule(Event              *event,
+                   bsls::Types::Int64  time,
+                   bsls::Types::Int64 *dueTime);
+        // Reschedule the specified 'event' at the specified 'time' and load
+        // into the specified 'dueTime' the time, in microseconds, at which it
+        // is due to expire.  Return 0 on success, and a non-zero value (with
+        // no effect) if 'event' is not pending.
+
+    // ACCESSORS
+    bsls::Types::Int64 nextExpirationTime() const;
+        // Return the earliest time, in microseconds, at which an event may
+        // need to be expired or redistributed, or the maximum
+        // 'bsls::Types::Int64' value if no events are pending.
+
+    int numEvents() const;
+        // Return the number of pending one-time events.
+
+    int numRecurringEvents() const;
+        // Return the number of pending recurring events.
+};
+
                             // ====================
                             // class EventScheduler
                             // ====================
@@ -431,6 +712,8 @@ class EventScheduler {
 
     typedef bsl::function<bsls::TimeInterval()>            CurrentTimeFunctor;
 
+    typedef EventScheduler_TimingWheelEvent                TimingWheelEvent;
+
     // FRIENDS
     friend class EventSchedulerEventHandle;
     friend class EventSchedulerRecurringEventHandle;
@@ -451,6 +734,14 @@ class EventScheduler {
                                                Dispatcher;
         // Defines a type alias for the dispatcher functor type.
 
+    enum QueueType {
+        // Enumerate the data structures that may hold the pending events of a
+        // scheduler (see {Choosing the Event Queue}).
+
+        e_SKIP_LIST,     // events are ordered in a skip list (default)
+        e_TIMING_WHEEL   // events are hashed into a hierarchical timing wheel
+    };
+
   private:
     // NOT IMPLEMENTED
     EventScheduler(const EventScheduler&);
@@ -516,6 +807,26 @@ class EventScheduler {
     bsls::SystemClockType::Enum
                           d_clockType;          // clock type used
 
+    EventScheduler_TimingWheel
+                         *d_timingWheel_p;      // pending events, if the
+                                                // 'e_TIMING_WHEEL' queue type
+                                                // is used, and 0 otherwise
+                                                // (owned)
+
+    TimingWheelEvent     *d_currentWheelEvent_p;
+                                                // timing wheel event being
+                                                // executed, if any
+
+    bsls::Types::Int64    d_wheelWakeupTime;    // time, in microseconds, at
+                                                // which the dispatcher thread
+                                                // waiting for the timing wheel
+                                                // will wake up
+
+    // PRIVATE CLASS METHODS
+    static TimingWheelEvent *toTimingWheelEvent(const void *handle);
+        // Return the timing wheel event referred to by the specified
+        // 'handle'.
+
     // PRIVATE MANIPULATORS
     bsls::Types::Int64 chooseNextEvent(bsls::Types::Int64 *now);
         // Pick either 'd_currentEvent' or 'd_currentRecurringEvent' as the
@@ -533,11 +844,32 @@ class EventScheduler {
         // documentation).  Also note that this method may update the value of
         // 'now' with the current system time if necessary.
 
+    int cancelTimingWheelEvent(const void *handle, bool wait);
+        // Cancel the timing wheel event referred to by the specified 'handle'
+        // and, if the specified 'wait' is 'true', block until the event is
+        // not being executed.  Return 0 on successful cancellation, and a
+        // non-zero value if 'handle' is 0 or the event is not pending.
+
     void dispatchEvents();
         // While d_running is true, execute events in the event and recurring
         // event queues at their scheduled times.  Note that this method
         // implements the dispatching thread.
 
+    void dispatchTimingWheelEvents();
+        // While d_running is true, execute events in the timing wheel at
+        // their scheduled times.  Note that this method implements the
+        // dispatching thread when the 'e_TIMING_WHEEL' queue type is used.
+
+    TimingWheelEvent *scheduleTimingWheelEvent(
+                                  bsls::Types::Int64            time,
+                                  bsls::Types::Int64            interval,
+                                  const bsl::function<void()>&  callback);
+        // Schedule in the timing wheel an event that dispatches the specified
+        // 'callback' at the specified 'time' and, unless the specified
+        // 'interval' is 0, every 'interval' thereafter (both in
+        // microseconds).  Return the event, to which the caller is
+        // responsible for releasing one reference.
+
     void releaseCurrentEvents();
         // Release 'd_currentRecurringEvent' and 'd_currentEvent', if they
         // refer to valid events.
@@ -587,6 +919,34 @@ class EventScheduler {
         // 'basicAllocator' used to supply memory.  If 'basicAllocator' is 0,
         // the currently installed default allocator is used.
 
+    EventScheduler(bsls::SystemClockType::Enum  clockType,
+                   QueueType                    queueType,
+                   bslma::Allocator            *basicAllocator = 0);
+        // Construct an event scheduler using the default dispatcher functor
+        // (see the "The dispatcher thread and the dispatcher functor" section
+        // in component-level doc), using the specified 'clockType' to
+        // indicate the epoch used for all time intervals (see {Supported
+        // Clock-Types} in the component documentation), and holding pending
+        // events in a data structure of the specified 'queueType' (see
+        // {Choosing the Event Queue} in the component documentation).
+        // Optionally specify a 'basicAllocator' used to supply memory.  If
+        // 'basicAllocator' is 0, the currently installed default allocator is
+        // used.
+
+    EventScheduler(const Dispatcher&            dispatcherFunctor,
+                   bsls::SystemClockType::Enum  clockType,
+                   QueueType                    queueType,
+                   bslma::Allocator            *basicAllocator = 0);
+        // Construct an event scheduler using the specified 'dispatcherFunctor'
+        // (see "The dispatcher thread and the dispatcher functor" section in
+        // component-level doc), using the specified 'clockType' to indicate
+        // the epoch used for all time intervals (see {Supported Clock-Types}
+        // in the component documentation), and holding pending events in a
+        // data structure of the specified 'queueType' (see {Choosing the
+        // Event Queue} in the component documentation).  Optionally specify a
+        // 'basicAllocator' used to supply memory.  If 'basicAllocator' is 0,
+        // the currently installed default allocator is used.
+
     ~EventScheduler();
         // Discard all unprocessed events and destroy this object.  The
         // behavior is undefined unless the scheduler is stopped.
@@ -820,6 +1180,10 @@ class EventScheduler {
         // Return the number of recurring events registered with this
         // scheduler.
 
+    QueueType queueType() const;
+        // Return the type of the data structure holding the pending events of
+        // this scheduler.
+
                                   // Aspects
 
     bslma::Allocator *allocator() const;
@@ -841,7 +1205,10 @@ class EventSchedulerEventHandle
                             bsl::function<void()> > EventQueue;
 
     // DATA
-    EventQueue::PairHandle  d_handle;
+    EventQueue::PairHandle           d_handle;         // event in a skip list
+
+    EventScheduler_TimingWheelEvent *d_wheelEvent_p;   // event in a timing
+                                                       // wheel, or 0
 
     // FRIENDS
     friend class EventScheduler;
@@ -893,7 +1260,10 @@ class EventSchedulerRecurringEventHandle
                             RecurringEventData>        RecurringEventQueue;
 
     // DATA
-    RecurringEventQueue::PairHandle  d_handle;
+    RecurringEventQueue::PairHandle  d_handle;        // event in a skip list
+
+    EventScheduler_TimingWheelEvent *d_wheelEvent_p;  // event in a timing
+                                                      // wheel, or 0
 
     // FRIENDS
     friend class EventScheduler;
@@ -988,6 +1358,64 @@ class EventSchedulerTestTimeSource {
 //                            INLINE DEFINITIONS
 // ============================================================================
 
+                   // --------------------------------------
+                   // struct EventScheduler_TimingWheelEvent
+                   // --------------------------------------
+
+// CREATORS
+inline
+EventScheduler_TimingWheelEvent::EventScheduler_TimingWheelEvent(
+                                bsls::Types::Int64            time,
+                                bsls::Types::Int64            interval,
+                                const bsl::function<void()>&  callback,
+                                bdlma::ConcurrentPool        *pool,
+                                bslma::Allocator             *basicAllocator)
+: d_next_p(0)
+, d_prev_p(0)
+, d_time(time)
+, d_interval(interval)
+, d_listIndex(-1)
+, d_refCount(1)
+, d_pool_p(pool)
+, d_callback(bsl::allocator_arg_t(), basicAllocator, callback)
+{
+}
+
+// MANIPULATORS
+inline
+void EventScheduler_TimingWheelEvent::addReference()
+{
+    d_refCount.addRelaxed(1);
+}
+
+inline
+void EventScheduler_TimingWheelEvent::releaseReference()
+{
+    if (0 == d_refCount.add(-1)) {
+        bdlma::ConcurrentPool *pool = d_pool_p;
+
+        this->~EventScheduler_TimingWheelEvent();
+        pool->deallocate(this);
+    }
+}
+
+                      // --------------------------------
+                      // class EventScheduler_TimingWheel
+                      // --------------------------------
+
+// ACCESSORS
+inline
+int EventScheduler_TimingWheel::numEvents() const
+{
+    return d_numEvents;
+}
+
+inline
+int EventScheduler_TimingWheel::numRecurringEvents() const
+{
+    return d_numRecurringEvents;
+}
+
                       // -------------------------------
                       // class EventSchedulerEventHandle
                       // -------------------------------
@@ -995,6 +1423,7 @@ class EventSchedulerTestTimeSource {
 // CREATORS
 inline
 EventSchedulerEventHandle::EventSchedulerEventHandle()
+: d_wheelEvent_p(0)
 {
 }
 
@@ -1002,12 +1431,19 @@ inline
 EventSchedulerEventHandle::EventSchedulerEventHandle(
                                      const EventSchedulerEventHandle& original)
 : d_handle(original.d_handle)
+, d_wheelEvent_p(original.d_wheelEvent_p)
 {
+    if (d_wheelEvent_p) {
+        d_wheelEvent_p->addReference();
+    }
 }
 
 inline
 EventSchedulerEventHandle::~EventSchedulerEventHandle()
 {
+    if (d_wheelEvent_p) {
+        d_wheelEvent_p->releaseReference();
+    }
 }
 
 // MANIPULATORS
@@ -1016,6 +1452,15 @@ EventSchedulerEventHandle&
 EventSchedulerEventHandle::operator=(const EventSchedulerEventHandle& rhs)
 {
     d_handle = rhs.d_handle;
+
+    if (rhs.d_wheelEvent_p) {
+        rhs.d_wheelEvent_p->addReference();
+    }
+    if (d_wheelEvent_p) {
+        d_wheelEvent_p->releaseReference();
+    }
+    d_wheelEvent_p = rhs.d_wheelEvent_p;
+
     return *this;
 }
 
@@ -1023,6 +1468,11 @@ inline
 void EventSchedulerEventHandle::release()
 {
     d_handle.release();
+
+    if (d_wheelEvent_p) {
+        d_wheelEvent_p->releaseReference();
+        d_wheelEvent_p = 0;
+    }
 }
 }  // close package namespace
 
@@ -1034,6 +1484,10 @@ inline
 bdlmt::EventSchedulerEventHandle::
 operator const bdlmt::EventSchedulerEventHandle::Event*() const
 {
+    if (d_wheelEvent_p) {
+        return static_cast<const Event *>(
+                               static_cast<const void *>(d_wheelEvent_p));
+    }
     return (const Event*)((const EventQueue::Pair*)d_handle);
 }
 
@@ -1046,6 +1500,7 @@ namespace bdlmt {
 // CREATORS
 inline
 EventSchedulerRecurringEventHandle::EventSchedulerRecurringEventHandle()
+: d_wheelEvent_p(0)
 {
 }
 
@@ -1053,12 +1508,19 @@ inline
 EventSchedulerRecurringEventHandle::EventSchedulerRecurringEventHandle(
                             const EventSchedulerRecurringEventHandle& original)
 : d_handle(original.d_handle)
+, d_wheelEvent_p(original.d_wheelEvent_p)
 {
+    if (d_wheelEvent_p) {
+        d_wheelEvent_p->addReference();
+    }
 }
 
 inline
 EventSchedulerRecurringEventHandle::~EventSchedulerRecurringEventHandle()
 {
+    if (d_wheelEvent_p) {
+        d_wheelEvent_p->releaseReference();
+    }
 }
 
 // MANIPULATORS
@@ -1066,6 +1528,11 @@ inline
 void EventSchedulerRecurringEventHandle::release()
 {
     d_handle.release();
+
+    if (d_wheelEvent_p) {
+        d_wheelEvent_p->releaseReference();
+        d_wheelEvent_p = 0;
+    }
 }
 
 inline
@@ -1074,6 +1541,15 @@ EventSchedulerRecurringEventHandle::operator=(
                                  const EventSchedulerRecurringEventHandle& rhs)
 {
     d_handle = rhs.d_handle;
+
+    if (rhs.d_wheelEvent_p) {
+        rhs.d_wheelEvent_p->addReference();
+    }
+    if (d_wheelEvent_p) {
+        d_wheelEvent_p->releaseReference();
+    }
+    d_wheelEvent_p = rhs.d_wheelEvent_p;
+
     return *this;
 }
 }  // close package namespace
@@ -1086,6 +1562,10 @@ inline
 bdlmt::EventSchedulerRecurringEventHandle::operator
        const bdlmt::EventSchedulerRecurringEventHandle::RecurringEvent*() const
 {
+    if (d_wheelEvent_p) {
+        return static_cast<const RecurringEvent *>(
+                               static_cast<const void *>(d_wheelEvent_p));
+    }
     return (const RecurringEvent*)((const RecurringEventQueue::Pair*)d_handle);
 }
 
@@ -1095,10 +1575,22 @@ namespace bdlmt {
                             // class EventScheduler
                             // --------------------
 
+// PRIVATE CLASS METHODS
+inline
+EventScheduler::TimingWheelEvent *
+EventScheduler::toTimingWheelEvent(const void *handle)
+{
+    return static_cast<TimingWheelEvent *>(const_cast<void *>(handle));
+}
+
 // MANIPULATORS
 inline
 int EventScheduler::cancelEvent(const Event *handle)
 {
+    if (d_timingWheel_p) {
+        return cancelTimingWheelEvent(handle, false);                 // RETURN
+    }
+
     const EventQueue::Pair *itemPtr =
                         reinterpret_cast<const EventQueue::Pair*>(
                                         reinterpret_cast<const void*>(handle));
@@ -1109,6 +1601,10 @@ int EventScheduler::cancelEvent(const Event *handle)
 inline
 int EventScheduler::cancelEvent(const RecurringEvent *handle)
 {
+    if (d_timingWheel_p) {
+        return cancelTimingWheelEvent(handle, false);                 // RETURN
+    }
+
     const RecurringEventQueue::Pair *itemPtr =
                 reinterpret_cast<const RecurringEventQueue::Pair*>(
                                         reinterpret_cast<const void*>(handle));
@@ -1126,6 +1622,11 @@ void EventScheduler::scheduleEvent(const bsls::TimeInterval&    epochTime,
 inline
 void EventScheduler::releaseEventRaw(Event *handle)
 {
+    if (d_timingWheel_p) {
+        toTimingWheelEvent(handle)->releaseReference();
+        return;                                                       // RETURN
+    }
+
     d_eventQueue.releaseReferenceRaw(reinterpret_cast<EventQueue::Pair*>(
                                              reinterpret_cast<void*>(handle)));
 }
@@ -1133,6 +1634,11 @@ void EventScheduler::releaseEventRaw(Event *handle)
 inline
 void EventScheduler::releaseEventRaw(RecurringEvent *handle)
 {
+    if (d_timingWheel_p) {
+        toTimingWheelEvent(handle)->releaseReference();
+        return;                                                       // RETURN
+    }
+
     d_recurringQueue.releaseReferenceRaw(
                          reinterpret_cast<RecurringEventQueue::Pair*>(
                                              reinterpret_cast<void*>(handle)));
@@ -1152,6 +1658,11 @@ inline
 EventScheduler::Event*
 EventScheduler::addEventRefRaw(Event *handle) const
 {
+    if (d_timingWheel_p) {
+        toTimingWheelEvent(handle)->addReference();
+        return handle;                                                // RETURN
+    }
+
     EventQueue::Pair *h = reinterpret_cast<EventQueue::Pair*>(
                                               reinterpret_cast<void*>(handle));
     return reinterpret_cast<Event*>(d_eventQueue.addPairReferenceRaw(h));
@@ -1161,6 +1672,11 @@ inline
 EventScheduler::RecurringEvent*
 EventScheduler::addRecurringEventRefRaw(RecurringEvent *handle) const
 {
+    if (d_timingWheel_p) {
+        toTimingWheelEvent(handle)->addReference();
+        return handle;                                                // RETURN
+    }
+
     RecurringEventQueue::Pair *h =
                                reinterpret_cast<RecurringEventQueue::Pair*>(
                                               reinterpret_cast<void*>(handle));
@@ -1183,13 +1699,21 @@ bsls::TimeInterval EventScheduler::now() const
 inline
 int EventScheduler::numEvents() const
 {
-    return d_eventQueue.length();
+    return d_timingWheel_p ? d_timingWheel_p->numEvents()
+                           : d_eventQueue.length();
 }
 
 inline
 int EventScheduler::numRecurringEvents() const
 {
-    return d_recurringQueue.length();
+    return d_timingWheel_p ? d_timingWheel_p->numRecurringEvents()
+                           : d_recurringQueue.length();
+}
+
+inline
+EventScheduler::QueueType EventScheduler::queueType() const
+{
+    return d_timingWheel_p ? e_TIMING_WHEEL : e_SKIP_LIST;
 }
 
                                   // Aspects
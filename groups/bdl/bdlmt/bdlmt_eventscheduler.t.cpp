@@ -24,6 +24,8 @@
 #include <bslma_testallocator.h>
 
 #include <bslmt_barrier.h>
+#include <bslmt_lockguard.h>
+#include <bslmt_mutex.h>
 #include <bslmt_threadgroup.h>
 #include <bslmt_threadutil.h>
 #include <bslmt_timedsemaphore.h>
@@ -42,6 +44,7 @@
 #include <unistd.h>
 #endif
 
+#include <bsl_algorithm.h>
 #include <bsl_climits.h>
 #include <bsl_cmath.h>
 #include <bsl_cstddef.h>
@@ -52,6 +55,7 @@
 #include <bsl_memory.h>
 #include <bsl_ostream.h>
 #include <bsl_utility.h>
+#include <bsl_vector.h>
 
 using namespace BloombergLP;
 using namespace bsl;  // automatically added by script
@@ -96,6 +100,8 @@ using namespace bsl;  // automatically added by script
 //
 // [08] bdlmt::EventScheduler(dispatcher, allocator = 0);
 // [20] bdlmt::EventScheduler(disp, clockType, alloc = 0);
+// [26] bdlmt::EventScheduler(clockType, queueType, alloc = 0);
+// [26] bdlmt::EventScheduler(disp, clockType, queueType, alloc = 0);
 //
 // [01] ~bdlmt::EventScheduler();
 //
@@ -118,6 +124,7 @@ using namespace bsl;  // automatically added by script
 // [21] bsls::SystemClockType::Enum clockType() const;
 // [23] bsls::TimeInterval now() const;
 // [24] bslma::Allocator *allocator() const;
+// [26] QueueType queueType() const;
 //-----------------------------------------------------------------------------
 // [01] BREATHING TEST
 // [25] DRQS 150355963: 'advanceTime' WITH UNDER A MICROSECOND
@@ -125,7 +132,9 @@ using namespace bsl;  // automatically added by script
 // [10] TESTING CONCURRENT SCHEDULING AND CANCELLING
 // [11] TESTING CONCURRENT SCHEDULING AND CANCELLING-ALL
 // [22] CLOCK REPLACEMENT BREATHING TEST
-// [26] USAGE EXAMPLE
+// [26] TESTING TIMING WHEEL QUEUE TYPE
+// [27] USAGE EXAMPLE
+// [-2] PERFORMANCE: SCHEDULING AND CANCELING TIMEOUTS
 
 // ============================================================================
 //                     STANDARD BDE ASSERT TEST FUNCTION
@@ -941,6 +950,111 @@ void my_Server::dataAvailable(my_Server::Connection *connection,
 
 }  // close namespace EVENTSCHEDULER_TEST_CASE_USAGE
 
+// ============================================================================
+//                         CASE 26 RELATED ENTITIES
+// ----------------------------------------------------------------------------
+
+namespace EVENTSCHEDULER_TEST_CASE_26 {
+
+struct Recorder {
+    // This 'struct' records the identifiers of dispatched events.
+
+    bslmt::Mutex     d_mutex;
+    bsl::vector<int> d_ids;
+
+    void record(int id)
+        // Append the specified 'id' to the recorded identifiers.
+    {
+        bslmt::LockGuard<bslmt::Mutex> lock(&d_mutex);
+        d_ids.push_back(id);
+    }
+
+    int size()
+        // Return the number of recorded identifiers.
+    {
+        bslmt::LockGuard<bslmt::Mutex> lock(&d_mutex);
+        return static_cast<int>(d_ids.size());
+    }
+};
+
+void noop()
+    // Do nothing.
+{
+}
+
+void advanceTo(bdlmt::EventSchedulerTestTimeSource *timeSource,
+               const bsls::TimeInterval&            time)
+    // Advance the specified 'timeSource' to the specified 'time', if it is
+    // later than the current time of 'timeSource'.
+{
+    if (time > timeSource->now()) {
+        timeSource->advanceTime(time - timeSource->now());
+    }
+}
+
+bsls::TimeInterval alignToMillisecond(
+                               bdlmt::EventSchedulerTestTimeSource *timeSource)
+    // Advance the specified 'timeSource' to the next millisecond boundary, and
+    // return the resulting time.
+{
+    const bsls::TimeInterval now = timeSource->now();
+
+    bsls::TimeInterval boundary(now.seconds(),
+                                (now.nanoseconds() / 1000000 + 1) * 1000000);
+    advanceTo(timeSource, boundary);
+
+    return boundary;
+}
+
+void checkedCallback(bdlmt::EventScheduler     *scheduler,
+                     const bsls::TimeInterval&  scheduledTime,
+                     bsls::AtomicInt           *numDispatched)
+    // Verify that the current time of the specified 'scheduler' is not
+    // earlier than the specified 'scheduledTime', and increment the specified
+    // 'numDispatched'.
+{
+    ASSERTT(scheduler->now() >= scheduledTime);
+    ++*numDispatched;
+}
+
+void scheduleAndCancel(bdlmt::EventScheduler *scheduler,
+                       int                    numEvents,
+                       int                    seed,
+                       bsls::AtomicInt       *numDispatched,
+                       bsls::AtomicInt       *numCanceled)
+    // Schedule the specified 'numEvents' events in the specified 'scheduler'
+    // within the next 50 milliseconds, using the specified 'seed' to choose
+    // their times, and cancel every other one.  Increment the specified
+    // 'numDispatched' when an event is dispatched, and the specified
+    // 'numCanceled' when an event is successfully canceled.
+{
+    typedef bdlmt::EventScheduler::EventHandle EventHandle;
+
+    bsl::vector<EventHandle> handles(numEvents);
+    unsigned int             state = seed;
+
+    for (int i = 0; i < numEvents; ++i) {
+        state = state * 1103515245 + 12345;
+
+        const bsls::TimeInterval time = scheduler->now()
+                              + bsls::TimeInterval(0, (state >> 8) % 50000000);
+
+        scheduler->scheduleEvent(&handles[i],
+                                 time,
+                                 bdlf::BindUtil::bind(&checkedCallback,
+                                                      scheduler,
+                                                      time,
+                                                      numDispatched));
+    }
+    for (int i = 0; i < numEvents; i += 2) {
+        if (0 == scheduler->cancelEvent(&handles[i])) {
+            ++*numCanceled;
+        }
+    }
+}
+
+}  // close namespace EVENTSCHEDULER_TEST_CASE_26
+
 // ============================================================================
 //                         CASE 25 RELATED ENTITIES
 // ----------------------------------------------------------------------------
@@ -2364,7 +2478,7 @@ int main(int argc, char *argv[])
     bsl::cout << "TEST " << __FILE__ << " CASE " << test << bsl::endl;
 
     switch (test) { case 0:  // Zero is always the leading case.
-      case 26: {
+      case 27: {
         // --------------------------------------------------------------------
         // TESTING USAGE EXAMPLES:
         //
@@ -2424,6 +2538,413 @@ int main(int argc, char *argv[])
         ASSERT(0 < ta.numAllocations());
         ASSERT(0 == ta.numBytesInUse());
       } break;
+      case 26: {
+        // --------------------------------------------------------------------
+        // TESTING TIMING WHEEL QUEUE TYPE
+        //
+        // Concerns:
+        //: 1 The 'queueType' accessor returns the queue type supplied at
+        //:   construction, and 'e_SKIP_LIST' by default.
+        //:
+        //: 2 Events are dispatched no earlier than their scheduled time, and
+        //:   no later than the end of the millisecond containing it, whether
+        //:   they are held in the lowest level of the wheel, a higher level,
+        //:   or the overflow list.
+        //:
+        //: 3 Events in different milliseconds are dispatched in time order.
+        //:
+        //: 4 Recurring events are dispatched every interval, catching up
+        //:   after a time jump, until canceled.
+        //:
+        //: 5 'cancelEvent', 'cancelEventAndWait', 'rescheduleEvent', and
+        //:   'cancelAllEvents' behave as with the default queue type, and
+        //:   'numEvents' and 'numRecurringEvents' reflect the pending events.
+        //:
+        //: 6 Handles and raw event pointers correctly manage the references
+        //:   to the events, and no memory is leaked.
+        //:
+        //: 7 Scheduling and canceling from multiple threads is thread-safe,
+        //:   and events are dispatched exactly once unless canceled.
+        //
+        // Plan:
+        //: 1 Construct schedulers using each constructor and verify the value
+        //:   of 'queueType'.  (C-1)
+        //:
+        //: 2 Using a test time source aligned on a millisecond boundary,
+        //:   schedule events at a table of offsets spanning every level of
+        //:   the wheel and the overflow list, in an arbitrary order.  For each
+        //:   distinct due time, advance to just before it and verify that no
+        //:   other event was dispatched, then advance to it and verify that
+        //:   the expected events were dispatched in order.  (C-2..3)
+        //:
+        //: 3 Schedule a recurring event, advance the time source by several
+        //:   intervals at once, and verify the number of dispatches; cancel
+        //:   the event and verify that it is no longer dispatched.  (C-4)
+        //:
+        //: 4 Exercise the cancel, reschedule, and raw API methods on pending,
+        //:   dispatched, and canceled events, and verify the return values
+        //:   and counts.  Use a test allocator to verify that all memory is
+        //:   returned.  (C-5..6)
+        //:
+        //: 5 Using the real clock, schedule and cancel events concurrently
+        //:   from several threads, and verify that every event that was not
+        //:   canceled is dispatched exactly once, and not early.  (C-7)
+        //
+        // Testing:
+        //   bdlmt::EventScheduler(clockType, queueType, alloc = 0);
+        //   bdlmt::EventScheduler(disp, clockType, queueType, alloc = 0);
+        //   QueueType queueType() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << "TESTING TIMING WHEEL QUEUE TYPE\n"
+                             "===============================\n";
+
+        using namespace EVENTSCHEDULER_TEST_CASE_26;
+
+        typedef bsls::SystemClockType SCT;
+
+        const Obj::QueueType WHEEL = Obj::e_TIMING_WHEEL;
+
+        if (verbose) cout << "\tTesting 'queueType'." << endl;
+        {
+            bslma::TestAllocator ta(veryVeryVerbose);
+
+            const Obj X(&ta);
+            ASSERT(Obj::e_SKIP_LIST == X.queueType());
+
+            const Obj Y(SCT::e_MONOTONIC, Obj::e_SKIP_LIST, &ta);
+            ASSERT(Obj::e_SKIP_LIST == Y.queueType());
+            ASSERT(SCT::e_MONOTONIC == Y.clockType());
+
+            const Obj Z(SCT::e_REALTIME, WHEEL, &ta);
+            ASSERT(WHEEL             == Z.queueType());
+            ASSERT(SCT::e_REALTIME   == Z.clockType());
+            ASSERT(&ta               == Z.allocator());
+
+            using EVENTSCHEDULER_TEST_CASE_20::dispatcherFunction;
+
+            const Obj W(bdlf::BindUtil::bind(&dispatcherFunction,
+                                             bdlf::PlaceHolders::_1),
+                        SCT::e_MONOTONIC,
+                        WHEEL,
+                        &ta);
+            ASSERT(WHEEL             == W.queueType());
+            ASSERT(SCT::e_MONOTONIC  == W.clockType());
+            ASSERT(0                 == W.numEvents());
+            ASSERT(0                 == W.numRecurringEvents());
+        }
+
+        if (verbose) cout << "\tTesting dispatch times and order." << endl;
+        {
+            static const struct {
+                int                d_line;
+                bsls::Types::Int64 d_offset;  // microseconds
+            } DATA[] = {
+                //LINE  OFFSET
+                //----  ---------------------
+                { L_,              65536000LL },  // level 2
+                { L_,                     1LL },  // level 0
+                { L_,            5184000000LL },  // overflow (60 days)
+                { L_,                  1000LL },
+                { L_,                255999LL },
+                { L_,                   999LL },  // same tick as offset 1
+                { L_,                256000LL },  // level 1
+                { L_,              70000000LL },
+                { L_,                300000LL },
+                { L_,           18000000000LL },  // level 3 (5 hours)
+                { L_,                  1500LL },
+                { L_,            5184000000LL },  // same tick as overflow
+            };
+            const int NUM_DATA = static_cast<int>(sizeof DATA / sizeof *DATA);
+
+            bslma::TestAllocator ta(veryVeryVerbose);
+            {
+                Obj mX(SCT::e_REALTIME, WHEEL, &ta);
+                bdlmt::EventSchedulerTestTimeSource timeSource(&mX);
+
+                const bsls::TimeInterval BASE =
+                                              alignToMillisecond(&timeSource);
+
+                Recorder recorder;
+                for (int i = 0; i < NUM_DATA; ++i) {
+                    bsls::TimeInterval time(BASE);
+                    time.addMicroseconds(DATA[i].d_offset);
+
+                    mX.scheduleEvent(time,
+                                     bdlf::BindUtil::bind(&Recorder::record,
+                                                          &recorder,
+                                                          i));
+                }
+                ASSERT(NUM_DATA == mX.numEvents());
+
+                mX.start();
+
+                // Compute the time, relative to 'BASE', at which each event is
+                // due: the end of the millisecond containing it.
+
+                bsl::vector<bsls::Types::Int64> dueTimes;
+                for (int i = 0; i < NUM_DATA; ++i) {
+                    dueTimes.push_back((DATA[i].d_offset / 1000 + 1) * 1000);
+                }
+                bsl::vector<bsls::Types::Int64> checkpoints(dueTimes);
+                bsl::sort(checkpoints.begin(), checkpoints.end());
+                checkpoints.erase(bsl::unique(checkpoints.begin(),
+                                              checkpoints.end()),
+                                  checkpoints.end());
+
+                int numExpected = 0;
+                for (bsl::size_t j = 0; j < checkpoints.size(); ++j) {
+                    const bsls::Types::Int64 DUE = checkpoints[j];
+
+                    if (veryVerbose) { T_ P(DUE) }
+
+                    bsls::TimeInterval justBefore(BASE);
+                    justBefore.addMicroseconds(DUE - 1);
+                    advanceTo(&timeSource, justBefore);
+                    ASSERTV(DUE, numExpected, recorder.size(),
+                            numExpected == recorder.size());
+
+                    bsls::TimeInterval due(BASE);
+                    due.addMicroseconds(DUE);
+                    advanceTo(&timeSource, due);
+
+                    for (int i = 0; i < NUM_DATA; ++i) {
+                        if (DUE == dueTimes[i]) {
+                            ++numExpected;
+                        }
+                    }
+                    ASSERTV(DUE, numExpected, recorder.size(),
+                            numExpected == recorder.size());
+                }
+
+                mX.stop();
+
+                ASSERT(0        == mX.numEvents());
+                ASSERT(NUM_DATA == recorder.size());
+
+                // Verify that the events were dispatched in the order of
+                // their due times.
+
+                for (int i = 1; i < recorder.size(); ++i) {
+                    const int PREV = recorder.d_ids[i - 1];
+                    const int CURR = recorder.d_ids[i];
+
+                    ASSERTV(DATA[PREV].d_line, DATA[CURR].d_line,
+                            dueTimes[PREV] <= dueTimes[CURR]);
+                }
+            }
+            ASSERT(0 == ta.numBytesInUse());
+        }
+
+        if (verbose) cout << "\tTesting recurring events." << endl;
+        {
+            bslma::TestAllocator ta(veryVeryVerbose);
+            {
+                Obj mX(SCT::e_REALTIME, WHEEL, &ta);
+                bdlmt::EventSchedulerTestTimeSource timeSource(&mX);
+
+                const bsls::TimeInterval BASE =
+                                              alignToMillisecond(&timeSource);
+
+                Recorder                  recorder;
+                Obj::RecurringEventHandle handle;
+
+                mX.scheduleRecurringEvent(&handle,
+                                          bsls::TimeInterval(0, 10000000),
+                                          bdlf::BindUtil::bind(
+                                                          &Recorder::record,
+                                                          &recorder,
+                                                          0),
+                                          BASE + bsls::TimeInterval(0,
+                                                                    5000000));
+                ASSERT(0 == mX.numEvents());
+                ASSERT(1 == mX.numRecurringEvents());
+
+                mX.start();
+
+                // Events at 5ms, 15ms, ..., 95ms are due by 100ms.
+
+                advanceTo(&timeSource, BASE + bsls::TimeInterval(0.1));
+                ASSERTV(recorder.size(), 10 == recorder.size());
+                ASSERT(1 == mX.numRecurringEvents());
+
+                advanceTo(&timeSource, BASE + bsls::TimeInterval(0.106));
+                ASSERTV(recorder.size(), 11 == recorder.size());
+
+                ASSERT(0 == mX.cancelEventAndWait(&handle));
+                ASSERT(0 == mX.numRecurringEvents());
+                ASSERT(0 != mX.cancelEvent(handle));
+
+                advanceTo(&timeSource, BASE + bsls::TimeInterval(1.0));
+                ASSERTV(recorder.size(), 11 == recorder.size());
+
+                mX.stop();
+            }
+            ASSERT(0 == ta.numBytesInUse());
+        }
+
+        if (verbose) cout << "\tTesting cancel, reschedule, and raw API."
+                          << endl;
+        {
+            bslma::TestAllocator ta(veryVeryVerbose);
+            {
+                Obj mX(SCT::e_REALTIME, WHEEL, &ta);
+                bdlmt::EventSchedulerTestTimeSource timeSource(&mX);
+
+                const bsls::TimeInterval BASE =
+                                              alignToMillisecond(&timeSource);
+
+                Recorder recorder;
+
+                Obj::EventHandle h1, h2;
+                Obj::Event      *e3;
+
+                mX.scheduleEvent(&h1,
+                                 BASE + bsls::TimeInterval(0.050),
+                                 bdlf::BindUtil::bind(&Recorder::record,
+                                                      &recorder,
+                                                      1));
+                mX.scheduleEvent(&h2,
+                                 BASE + bsls::TimeInterval(0.050),
+                                 bdlf::BindUtil::bind(&Recorder::record,
+                                                      &recorder,
+                                                      2));
+                mX.scheduleEventRaw(&e3,
+                                    BASE + bsls::TimeInterval(3600.0),
+                                    bdlf::BindUtil::bind(&Recorder::record,
+                                                         &recorder,
+                                                         3));
+                ASSERT(3 == mX.numEvents());
+
+                // Handles are copyable and refer to the same event.
+
+                Obj::EventHandle h1Copy(h1);
+                ASSERT((const Obj::Event *)h1Copy == (const Obj::Event *)h1);
+
+                ASSERT(0 == mX.cancelEvent(h1Copy));
+                ASSERT(0 != mX.cancelEvent(h1));
+                ASSERT(2 == mX.numEvents());
+
+                // Reschedule 'h2' earlier and 'e3' later.
+
+                ASSERT(0 == mX.rescheduleEvent(h2,
+                                           BASE + bsls::TimeInterval(0.002)));
+                ASSERT(0 == mX.rescheduleEvent(e3,
+                                           BASE + bsls::TimeInterval(0.004)));
+                ASSERT(0 != mX.rescheduleEvent(h1,
+                                           BASE + bsls::TimeInterval(0.001)));
+
+                Obj::Event *e3Copy = mX.addEventRefRaw(e3);
+                ASSERT(e3Copy == e3);
+                mX.releaseEventRaw(e3Copy);
+
+                mX.start();
+
+                advanceTo(&timeSource, BASE + bsls::TimeInterval(0.003));
+                ASSERTV(recorder.size(), 1 == recorder.size());
+                ASSERT(2 == recorder.d_ids[0]);
+
+                advanceTo(&timeSource, BASE + bsls::TimeInterval(0.005));
+                ASSERTV(recorder.size(), 2 == recorder.size());
+                ASSERT(3 == recorder.d_ids[1]);
+                ASSERT(0 == mX.numEvents());
+
+                // Dispatched events can no longer be canceled or
+                // rescheduled.
+
+                ASSERT(0 != mX.cancelEvent(h2));
+                ASSERT(0 != mX.cancelEventAndWait(e3));
+                ASSERT(0 != mX.rescheduleEventAndWait(
+                                             e3,
+                                             BASE + bsls::TimeInterval(1.0)));
+                mX.releaseEventRaw(e3);
+
+                // Invalid handles are rejected.
+
+                Obj::EventHandle          empty;
+                Obj::RecurringEventHandle emptyRecurring;
+                ASSERT(0 != mX.cancelEvent(&empty));
+                ASSERT(0 != mX.cancelEventAndWait(&emptyRecurring));
+
+                // 'cancelAllEvents' removes every kind of event.
+
+                for (int i = 0; i < 100; ++i) {
+                    mX.scheduleEvent(BASE + bsls::TimeInterval(0.010 * i),
+                                     bdlf::BindUtil::bind(&Recorder::record,
+                                                          &recorder,
+                                                          10 + i));
+                }
+                for (int i = 0; i < 10; ++i) {
+                    mX.scheduleRecurringEvent(bsls::TimeInterval(0.001 + i),
+                                              bdlf::BindUtil::bind(
+                                                          &Recorder::record,
+                                                          &recorder,
+                                                          200 + i));
+                }
+
+                mX.scheduleEvent(&h1,
+                                 BASE + bsls::TimeInterval(5.0),
+                                 bdlf::BindUtil::bind(&Recorder::record,
+                                                      &recorder,
+                                                      1));
+                ASSERT(10 == mX.numRecurringEvents());
+
+                mX.cancelAllEventsAndWait();
+                ASSERT(0 == mX.numEvents());
+                ASSERT(0 == mX.numRecurringEvents());
+                ASSERT(0 != mX.cancelEvent(h1));
+
+                const int NUM_DISPATCHED = recorder.size();
+
+                advanceTo(&timeSource, BASE + bsls::TimeInterval(86400.0));
+                ASSERTV(NUM_DISPATCHED, recorder.size(),
+                        NUM_DISPATCHED == recorder.size());
+
+                mX.stop();
+            }
+            ASSERT(0 == ta.numBytesInUse());
+        }
+
+        if (verbose) cout << "\tTesting concurrent scheduling." << endl;
+        {
+            enum { k_NUM_THREADS = 4, k_NUM_EVENTS = 2000 };
+
+            bslma::TestAllocator ta(veryVeryVerbose);
+            {
+                Obj mX(SCT::e_MONOTONIC, WHEEL, &ta);
+
+                bsls::AtomicInt numDispatched(0);
+                bsls::AtomicInt numCanceled(0);
+
+                mX.start();
+
+                bslmt::ThreadGroup threadGroup;
+                for (int i = 0; i < k_NUM_THREADS; ++i) {
+                    threadGroup.addThread(bdlf::BindUtil::bind(
+                                                         &scheduleAndCancel,
+                                                         &mX,
+                                                         (int)k_NUM_EVENTS,
+                                                         i + 1,
+                                                         &numDispatched,
+                                                         &numCanceled));
+                }
+                threadGroup.joinAll();
+
+                // Wait for the pending events to be dispatched.
+
+                for (int i = 0; i < 200 && 0 < mX.numEvents(); ++i) {
+                    bslmt::ThreadUtil::microSleep(10000);
+                }
+                mX.stop();
+
+                ASSERT(0 == mX.numEvents());
+                ASSERTV(numDispatched, numCanceled,
+                        k_NUM_THREADS * k_NUM_EVENTS
+                                          == numDispatched + numCanceled);
+            }
+            ASSERT(0 == ta.numBytesInUse());
+        }
+      } break;
       case 25: {
         // --------------------------------------------------------------------
         // DRQS 150355963: 'advanceTime' WITH UNDER A MICROSECOND
@@ -6063,6 +6584,71 @@ int main(int argc, char *argv[])
         }
 
       } break;
+      case -2: {
+        // --------------------------------------------------------------------
+        // PERFORMANCE: SCHEDULING AND CANCELING TIMEOUTS
+        //
+        // Concerns:
+        //: 1 With a large number of pending events, scheduling and canceling
+        //:   an event is faster with the 'e_TIMING_WHEEL' queue type than
+        //:   with the default queue type.
+        //
+        // Plan:
+        //: 1 For each queue type, schedule one million one-time events with
+        //:   deadlines spread over the next minute, then cancel them, and
+        //:   report the time taken by each phase.  (C-1)
+        //
+        // Testing:
+        //   PERFORMANCE: SCHEDULING AND CANCELING TIMEOUTS
+        // --------------------------------------------------------------------
+
+        cout << "PERFORMANCE: SCHEDULING AND CANCELING TIMEOUTS\n"
+                "==============================================\n";
+
+        enum { k_NUM_EVENTS = 1000000 };
+
+        const Obj::QueueType TYPES[] = { Obj::e_SKIP_LIST,
+                                         Obj::e_TIMING_WHEEL };
+        const char *NAMES[] = { "skip list", "timing wheel" };
+
+        for (int t = 0; t < 2; ++t) {
+            Obj mX(bsls::SystemClockType::e_MONOTONIC, TYPES[t]);
+
+            bsl::vector<Obj::Event *> events(k_NUM_EVENTS);
+            const bsls::TimeInterval  NOW = mX.now();
+
+            mX.start();
+
+            bsls::Stopwatch sw;
+            sw.start();
+            for (int i = 0; i < k_NUM_EVENTS; ++i) {
+                bsls::TimeInterval deadline(NOW);
+                deadline.addMilliseconds(
+                          10000 + (static_cast<bsls::Types::Int64>(i) * 7919)
+                                                                     % 60000);
+                mX.scheduleEventRaw(&events[i],
+                                    deadline,
+                                    &EVENTSCHEDULER_TEST_CASE_26::noop);
+            }
+            sw.stop();
+            const double SCHEDULE = sw.elapsedTime();
+
+            sw.reset();
+            sw.start();
+            for (int i = 0; i < k_NUM_EVENTS; ++i) {
+                mX.cancelEvent(events[i]);
+                mX.releaseEventRaw(events[i]);
+            }
+            sw.stop();
+            const double CANCEL = sw.elapsedTime();
+
+            mX.stop();
+
+            cout << NAMES[t] << ": schedule "
+                 << k_NUM_EVENTS / SCHEDULE << " events/s, cancel "
+                 << k_NUM_EVENTS / CANCEL << " events/s" << endl;
+        }
+      } break;
       case -100: {
         // --------------------------------------------------------------------
         // The router simulation (kind of) test
@@ -0,0 +1,668 @@
+// bdlmt_workstealingthreadpool.cpp                                   -*-C++-*-
+#include <bdlmt_workstealingthreadpool.h>
+
+#include <bsls_ident.h>
+BSLS_IDENT_RCSID(bdlmt_workstealingthreadpool_cpp,"$Id$ $CSID$")
+
+#include <bdlf_memfn.h>
+
+#include <bslma_deallocatorproctor.h>
+#include <bslma_default.h>
+
+#include <bslmt_lockguard.h>
+#include <bslmt_once.h>
+#include <bslmt_threadlocalvariable.h>
+#include <bslmt_threadutil.h>
+
+#include <bsls_assert.h>
+#include <bsls_performancehint.h>
+
+#include <bsl_algorithm.h>
+
+namespace BloombergLP {
+namespace bdlmt {
+
+                    // ===================================
+                    // class WorkStealingThreadPool_Worker
+                    // ===================================
+
+class WorkStealingThreadPool_Worker {
+    // This class holds the data of one thread of a 'WorkStealingThreadPool':
+    // its deque of jobs, its inbox of jobs enqueued by threads not in the
+    // pool, and its statistics.
+
+  public:
+    // TYPES
+    typedef WorkStealingThreadPool::Job Job;
+
+    // DATA
+    const WorkStealingThreadPool *d_pool_p;        // pool of this worker
+
+    WorkStealingThreadPool_Deque  d_deque;         // jobs of this worker
+
+    bslmt::Mutex                  d_inboxMutex;    // mutex protecting
+                                                   // 'd_inbox'
+
+    bsl::vector<Job *>            d_inbox;         // jobs enqueued by threads
+                                                   // not in the pool
+
+    bsls::AtomicInt               d_inboxLength;   // length of 'd_inbox'
+
+    bsl::vector<Job *>            d_transfer;      // buffer used by the thread
+                                                   // of this worker to take
+                                                   // the jobs of an inbox
+
+    bsls::AtomicInt64             d_numStolenJobs; // number of jobs taken from
+                                                   // other workers
+
+    unsigned int                  d_randomState;   // state of the generator
+                                                   // selecting steal victims
+
+  private:
+    // NOT IMPLEMENTED
+    WorkStealingThreadPool_Worker(const WorkStealingThreadPool_Worker&);
+    WorkStealingThreadPool_Worker& operator=(
+                                         const WorkStealingThreadPool_Worker&);
+
+  public:
+    // CREATORS
+    WorkStealingThreadPool_Worker(const WorkStealingThreadPool *pool,
+                                  int                           index,
+                                  bslma::Allocator             *allocator)
+        // Create a worker of the specified 'pool' having the specified
+        // 'index', using the specified 'allocator' to supply memory.
+    : d_pool_p(pool)
+    , d_deque(allocator)
+    , d_inbox(allocator)
+    , d_inboxLength(0)
+    , d_transfer(allocator)
+    , d_numStolenJobs(0)
+    , d_randomState(static_cast<unsigned int>(index) * 2654435761U + 1)
+    {
+    }
+
+    // MANIPULATORS
+    unsigned int nextRandom()
+        // Return the next value of the pseudo-random sequence of this worker.
+    {
+        d_randomState ^= d_randomState << 13;
+        d_randomState ^= d_randomState >> 17;
+        d_randomState ^= d_randomState << 5;
+        return d_randomState;
+    }
+};
+
+}  // close package namespace
+
+namespace {
+
+typedef bdlmt::WorkStealingThreadPool_Worker Worker;
+
+enum {
+    k_NUM_SPINS = 64  // number of failed attempts to find a job after which
+                      // a thread blocks
+};
+
+// On supported platforms, define a thread-local variable, 'g_localWorker',
+// holding the address of the worker whose thread is the calling thread; other
+// platforms use 'bslmt::ThreadUtil' thread-specific storage.
+
+#ifdef BSLMT_THREAD_LOCAL_VARIABLE
+BSLMT_THREAD_LOCAL_VARIABLE(Worker *, g_localWorker, 0);
+#else
+const bslmt::ThreadUtil::Key& localWorkerKey()
+    // Return a reference to the non-modifiable thread-specific storage key
+    // holding the address of the worker of each thread.
+{
+    static bslmt::ThreadUtil::Key s_key;
+    BSLMT_ONCE_DO {
+        bslmt::ThreadUtil::createKey(&s_key, 0);
+    }
+    return s_key;
+}
+#endif
+
+void setLocalWorker(Worker *worker)
+    // Set the worker of the calling thread to the specified 'worker'.
+{
+#ifdef BSLMT_THREAD_LOCAL_VARIABLE
+    g_localWorker = worker;
+#else
+    bslmt::ThreadUtil::setSpecific(localWorkerKey(), worker);
+#endif
+}
+
+#if defined(BSLS_PLATFORM_OS_UNIX)
+void initBlockSet(sigset_t *blockSet)
+{
+    sigfillset(blockSet);
+
+    const int synchronousSignals[] = {
+      SIGBUS,
+      SIGFPE,
+      SIGILL,
+      SIGSEGV,
+      SIGSYS,
+      SIGABRT,
+      SIGTRAP,
+     #if !defined(BSLS_PLATFORM_OS_CYGWIN) || defined(SIGIOT)
+      SIGIOT
+     #endif
+    };
+
+    const int SIZE = sizeof synchronousSignals / sizeof *synchronousSignals;
+
+    for (int i=0; i < SIZE; ++i) {
+        sigdelset(blockSet, synchronousSignals[i]);
+    }
+}
+#endif
+
+}  // close unnamed namespace
+
+namespace bdlmt {
+
+                     // ----------------------------------
+                     // class WorkStealingThreadPool_Deque
+                     // ----------------------------------
+
+// PRIVATE CLASS METHODS
+WorkStealingThreadPool_Deque::Array *
+WorkStealingThreadPool_Deque::createArray(bsls::Types::Int64  capacity,
+                                          bslma::Allocator   *allocator)
+{
+    BSLS_ASSERT(0 < capacity);
+    BSLS_ASSERT(0 == (capacity & (capacity - 1)));
+
+    Array *array = static_cast<Array *>(allocator->allocate(sizeof(Array)));
+    bslma::DeallocatorProctor<bslma::Allocator> proctor(array, allocator);
+
+    array->d_slots_p = static_cast<bsls::AtomicPointer<Job> *>(
+                              allocator->allocate(static_cast<bsl::size_t>(
+                                     capacity * sizeof(*array->d_slots_p))));
+    for (bsls::Types::Int64 i = 0; i < capacity; ++i) {
+        new (array->d_slots_p + i) bsls::AtomicPointer<Job>(0);
+    }
+    array->d_mask       = capacity - 1;
+    array->d_previous_p = 0;
+
+    proctor.release();
+    return array;
+}
+
+// PRIVATE MANIPULATORS
+WorkStealingThreadPool_Deque::Array *
+WorkStealingThreadPool_Deque::grow(Array              *array,
+                                   bsls::Types::Int64  top,
+                                   bsls::Types::Int64  bottom)
+{
+    Array *newArray = createArray(2 * (array->d_mask + 1), d_allocator_p);
+
+    for (bsls::Types::Int64 i = top; i < bottom; ++i) {
+        newArray->d_slots_p[i & newArray->d_mask].storeRelaxed(
+                          array->d_slots_p[i & array->d_mask].loadRelaxed());
+    }
+
+    // Thieves may still be reading the old array, which is therefore retained
+    // until this deque is destroyed.
+
+    newArray->d_previous_p = array;
+    d_array_p.storeRelease(newArray);
+
+    return newArray;
+}
+
+// CREATORS
+WorkStealingThreadPool_Deque::WorkStealingThreadPool_Deque(
+                                              bslma::Allocator *basicAllocator)
+: d_top(0)
+, d_topPad()
+, d_bottom(0)
+, d_array_p(0)
+, d_allocator_p(bslma::Default::allocator(basicAllocator))
+{
+    d_array_p = createArray(k_INITIAL_CAPACITY, d_allocator_p);
+}
+
+WorkStealingThreadPool_Deque::~WorkStealingThreadPool_Deque()
+{
+    // 'bsls::AtomicPointer' is trivially destructible.
+
+    Array *array = d_array_p.loadRelaxed();
+    while (array) {
+        Array *previous = array->d_previous_p;
+        d_allocator_p->deallocate(array->d_slots_p);
+        d_allocator_p->deallocate(array);
+        array = previous;
+    }
+}
+
+                        // ----------------------------
+                        // class WorkStealingThreadPool
+                        // ----------------------------
+
+// PRIVATE MANIPULATORS
+WorkStealingThreadPool::Job *WorkStealingThreadPool::findJob(Worker *worker)
+{
+    Job *job = worker->d_deque.popBottom();
+    if (BSLS_PERFORMANCEHINT_PREDICT_LIKELY(job)) {
+        return job;                                                   // RETURN
+    }
+
+    if (transferInbox(worker, worker)) {
+        job = worker->d_deque.popBottom();
+        if (job) {
+            return job;                                               // RETURN
+        }
+    }
+
+    // Look for a victim, starting from a random worker so that idle threads
+    // do not all steal from the same worker.
+
+    const int numWorkers = static_cast<int>(d_workers.size());
+    const int start      = static_cast<int>(worker->nextRandom()
+                                        % static_cast<unsigned>(numWorkers));
+
+    for (int i = 0; i < numWorkers; ++i) {
+        Worker *victim = d_workers[(start + i) % numWorkers];
+        if (victim != worker) {
+            job = victim->d_deque.steal();
+            if (job) {
+                worker->d_numStolenJobs.storeRelaxed(
+                                  worker->d_numStolenJobs.loadRelaxed() + 1);
+                return job;                                           // RETURN
+            }
+        }
+    }
+
+    for (int i = 0; i < numWorkers; ++i) {
+        Worker *victim = d_workers[(start + i) % numWorkers];
+        if (victim != worker && transferInbox(worker, victim)) {
+            job = worker->d_deque.popBottom();
+            if (job) {
+                return job;                                           // RETURN
+            }
+        }
+    }
+    return 0;
+}
+
+void WorkStealingThreadPool::init()
+{
+    BSLS_ASSERT_OPT(1 <= d_numThreads);
+
+    d_workers.reserve(d_numThreads);
+    for (int i = 0; i < d_numThreads; ++i) {
+        Worker *worker = new (*d_allocator_p) Worker(this, i, d_allocator_p);
+        d_workers.push_back(worker);
+    }
+
+#if defined(BSLS_PLATFORM_OS_UNIX)
+    initBlockSet(&d_blockSet);
+#endif
+}
+
+void WorkStealingThreadPool::removeAllJobs()
+{
+    for (bsl::size_t i = 0; i < d_workers.size(); ++i) {
+        Worker *worker = d_workers[i];
+
+        while (Job *job = worker->d_deque.popBottom()) {
+            job->~Job();
+            d_jobPool.deallocate(job);
+        }
+
+        bslmt::LockGuard<bslmt::Mutex> lock(&worker->d_inboxMutex);
+
+        for (bsl::size_t j = 0; j < worker->d_inbox.size(); ++j) {
+            worker->d_inbox[j]->~Job();
+            d_jobPool.deallocate(worker->d_inbox[j]);
+        }
+        worker->d_inbox.clear();
+        worker->d_inboxLength = 0;
+    }
+}
+
+void WorkStealingThreadPool::runJob(Job *job)
+{
+    (*job)();
+    job->~Job();
+    d_jobPool.deallocate(job);
+}
+
+int WorkStealingThreadPool::startNewThread(Worker *worker)
+{
+#if defined(BSLS_PLATFORM_OS_UNIX)
+    // Block all asynchronous signals.
+
+    sigset_t oldset;
+    pthread_sigmask(SIG_BLOCK, &d_blockSet, &oldset);
+#endif
+
+    int rc = d_threadGroup.addThread(
+                         bdlf::BindUtil::bind(
+                                  &WorkStealingThreadPool::workerThread,
+                                  this,
+                                  worker),
+                         d_threadAttributes);
+
+#if defined(BSLS_PLATFORM_OS_UNIX)
+    // Restore the mask.
+
+    pthread_sigmask(SIG_SETMASK, &oldset, &d_blockSet);
+#endif
+
+    return rc;
+}
+
+bool WorkStealingThreadPool::transferInbox(Worker *to, Worker *from)
+{
+    if (0 == from->d_inboxLength.load()) {
+        return false;                                                 // RETURN
+    }
+
+    BSLS_ASSERT(to->d_transfer.empty());
+    {
+        bslmt::LockGuard<bslmt::Mutex> lock(&from->d_inboxMutex);
+
+        to->d_transfer.swap(from->d_inbox);
+        from->d_inboxLength = 0;
+    }
+
+    // Push the jobs in reverse order so that the oldest job is popped first.
+
+    for (bsl::size_t i = to->d_transfer.size(); 0 < i; --i) {
+        to->d_deque.pushBottom(to->d_transfer[i - 1]);
+    }
+
+    const bsl::size_t numJobs = to->d_transfer.size();
+
+    to->d_transfer.clear();
+    if (from != to) {
+        to->d_numStolenJobs.storeRelaxed(to->d_numStolenJobs.loadRelaxed()
+                                                                  + numJobs);
+    }
+    return 0 < numJobs;
+}
+
+void WorkStealingThreadPool::waitUntilIdle()
+{
+    bslmt::LockGuard<bslmt::Mutex> lock(&d_idleMutex);
+
+    while (d_numThreads != d_numThreadsWaiting.load() || hasJobs()) {
+        d_idleCondition.wait(&d_idleMutex);
+    }
+}
+
+void WorkStealingThreadPool::workerThread(Worker *worker)
+{
+    setLocalWorker(worker);
+
+    int numFailures = 0;
+
+    while (BSLS_PERFORMANCEHINT_PREDICT_LIKELY(e_STOP != d_control.load())) {
+        Job *job = findJob(worker);
+
+        if (BSLS_PERFORMANCEHINT_PREDICT_LIKELY(job)) {
+            runJob(job);
+            numFailures = 0;
+            continue;
+        }
+
+        if (++numFailures < k_NUM_SPINS) {
+            bslmt::ThreadUtil::yield();
+            continue;
+        }
+        numFailures = 0;
+
+        // Announce that this thread is about to block, then check again for
+        // jobs: a thread enqueuing a job posts the semaphore if it observes
+        // the incremented count, and otherwise this thread observes the job.
+
+        if (d_numThreads == ++d_numThreadsWaiting && !hasJobs()) {
+            bslmt::LockGuard<bslmt::Mutex> lock(&d_idleMutex);
+            d_idleCondition.broadcast();
+        }
+
+        if (e_STOP != d_control.load() && !hasJobs()) {
+            d_semaphore.wait();
+        }
+
+        --d_numThreadsWaiting;
+    }
+
+    setLocalWorker(0);
+}
+
+// PRIVATE ACCESSORS
+bool WorkStealingThreadPool::hasJobs() const
+{
+    for (bsl::size_t i = 0; i < d_workers.size(); ++i) {
+        if (!d_workers[i]->d_deque.isEmpty()
+         || 0 != d_workers[i]->d_inboxLength.load()) {
+            return true;                                              // RETURN
+        }
+    }
+    return false;
+}
+
+Worker *WorkStealingThreadPool::localWorker() const
+{
+#ifdef BSLMT_THREAD_LOCAL_VARIABLE
+    Worker *worker = g_localWorker;
+#else
+    Worker *worker = static_cast<Worker *>(
+                             bslmt::ThreadUtil::getSpecific(localWorkerKey()));
+#endif
+    return worker && this == worker->d_pool_p ? worker : 0;
+}
+
+// CREATORS
+WorkStealingThreadPool::WorkStealingThreadPool(
+                                              int               numThreads,
+                                              bslma::Allocator *basicAllocator)
+: d_jobPool(sizeof(Job), basicAllocator)
+, d_workers(basicAllocator)
+, d_control(e_STOP)
+, d_nextInbox(0)
+, d_numThreadsWaiting(0)
+, d_threadGroup(basicAllocator)
+, d_threadAttributes(basicAllocator)
+, d_numThreads(numThreads)
+, d_allocator_p(bslma::Default::allocator(basicAllocator))
+{
+    init();
+}
+
+WorkStealingThreadPool::WorkStealingThreadPool(
+                              const bslmt::ThreadAttributes&  threadAttributes,
+                              int                             numThreads,
+                              bslma::Allocator               *basicAllocator)
+: d_jobPool(sizeof(Job), basicAllocator)
+, d_workers(basicAllocator)
+, d_control(e_STOP)
+, d_nextInbox(0)
+, d_numThreadsWaiting(0)
+, d_threadGroup(basicAllocator)
+, d_threadAttributes(threadAttributes, basicAllocator)
+, d_numThreads(numThreads)
+, d_allocator_p(bslma::Default::allocator(basicAllocator))
+{
+    init();
+}
+
+WorkStealingThreadPool::~WorkStealingThreadPool()
+{
+    shutdown();
+
+    // Jobs enqueued concurrently with 'shutdown' or 'stop' may remain.
+
+    removeAllJobs();
+
+    for (bsl::size_t i = 0; i < d_workers.size(); ++i) {
+        d_allocator_p->deleteObject(d_workers[i]);
+    }
+}
+
+// MANIPULATORS
+void WorkStealingThreadPool::drain()
+{
+    bslmt::LockGuard<bslmt::Mutex> lock(&d_metaMutex);
+
+    if (e_RUN == d_control.load()) {
+        waitUntilIdle();
+    }
+}
+
+int WorkStealingThreadPool::enqueueJob(const Job& functor)
+{
+    BSLS_ASSERT(functor);
+
+    Job functorCopy(bsl::allocator_arg, d_allocator_p, functor);
+    return enqueueJob(bslmf::MovableRefUtil::move(functorCopy));
+}
+
+int WorkStealingThreadPool::enqueueJob(bslmf::MovableRef<Job> functor)
+{
+    BSLS_ASSERT(bslmf::MovableRefUtil::access(functor));
+
+    Worker    *worker  = localWorker();
+    const int  control = d_control.load();
+
+    if (worker ? e_STOP == control : e_RUN != control) {
+        return -1;                                                    // RETURN
+    }
+
+    Job *job = static_cast<Job *>(d_jobPool.allocate());
+    {
+        bslma::DeallocatorProctor<bdlma::ConcurrentPool> proctor(job,
+                                                                 &d_jobPool);
+
+        new (job) Job(bsl::allocator_arg,
+                      d_allocator_p,
+                      bslmf::MovableRefUtil::move(functor));
+        proctor.release();
+    }
+
+    if (worker) {
+        worker->d_deque.pushBottom(job);
+    }
+    else {
+        Worker *inbox = d_workers[d_nextInbox.addRelaxed(1) % d_numThreads];
+
+        bslmt::LockGuard<bslmt::Mutex> lock(&inbox->d_inboxMutex);
+
+        inbox->d_inbox.push_back(job);
+        inbox->d_inboxLength = static_cast<int>(inbox->d_inbox.size());
+    }
+
+    if (0 < d_numThreadsWaiting.load()) {
+        // Wake up a waiting thread.
+
+        d_semaphore.post();
+    }
+    return 0;
+}
+
+void WorkStealingThreadPool::shutdown()
+{
+    bslmt::LockGuard<bslmt::Mutex> lock(&d_metaMutex);
+
+    if (e_STOP != d_control.load()) {
+        d_control = e_STOP;
+
+        for (int i = 0; i < d_numThreads; ++i) {
+            d_semaphore.post();
+        }
+        d_threadGroup.joinAll();
+
+        removeAllJobs();
+    }
+}
+
+int WorkStealingThreadPool::start()
+{
+    bslmt::LockGuard<bslmt::Mutex> lock(&d_metaMutex);
+
+    if (e_STOP != d_control.load()) {
+        return 0;                                                     // RETURN
+    }
+
+    d_control = e_RUN;
+
+    for (int i = 0; i < d_numThreads; ++i) {
+        if (0 != startNewThread(d_workers[i])) {
+            d_control = e_STOP;
+
+            for (int j = 0; j < i; ++j) {
+                d_semaphore.post();
+            }
+            d_threadGroup.joinAll();
+            return -1;                                                // RETURN
+        }
+    }
+    return 0;
+}
+
+void WorkStealingThreadPool::stop()
+{
+    bslmt::LockGuard<bslmt::Mutex> lock(&d_metaMutex);
+
+    if (e_RUN == d_control.load()) {
+        d_control = e_DRAIN;
+
+        waitUntilIdle();
+
+        d_control = e_STOP;
+
+        for (int i = 0; i < d_numThreads; ++i) {
+            d_semaphore.post();
+        }
+        d_threadGroup.joinAll();
+
+        // Destroy the jobs enqueued concurrently with this method, if any.
+
+        removeAllJobs();
+    }
+}
+
+// ACCESSORS
+int WorkStealingThreadPool::numPendingJobs() const
+{
+    bsls::Types::Int64 numJobs = 0;
+
+    for (bsl::size_t i = 0; i < d_workers.size(); ++i) {
+        numJobs += d_workers[i]->d_deque.length()
+                 + d_workers[i]->d_inboxLength.load();
+    }
+    return static_cast<int>(numJobs);
+}
+
+bsls::Types::Int64 WorkStealingThreadPool::numStolenJobs() const
+{
+    bsls::Types::Int64 numJobs = 0;
+
+    for (bsl::size_t i = 0; i < d_workers.size(); ++i) {
+        numJobs += d_workers[i]->d_numStolenJobs.loadRelaxed();
+    }
+    return numJobs;
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+// ----------------------------------------------------------------------------
+// Copyright 2020 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,698 @@
+// bdlmt_workstealingthreadpool.h                                     -*-C++-*-
+#ifndef INCLUDED_BDLMT_WORKSTEALINGTHREADPOOL
+#define INCLUDED_BDLMT_WORKSTEALINGTHREADPOOL
+
+#include <bsls_ident.h>
+BSLS_IDENT("$Id: $")
+
+//@PURPOSE: Provide a fixed-size thread pool that balances jobs by stealing.
+//
+//@CLASSES:
+//  bdlmt::WorkStealingThreadPool: thread pool with per-thread job deques
+//
+//@SEE_ALSO: bdlmt_fixedthreadpool, bdlmt_threadpool
+//
+//@DESCRIPTION: This component defines a thread pool,
+// 'bdlmt::WorkStealingThreadPool', that executes user-defined functions
+// ("jobs") on a fixed number of threads.  Unlike 'bdlmt::FixedThreadPool' and
+// 'bdlmt::ThreadPool', in which every thread takes jobs from a single shared
+// queue, each thread of a 'bdlmt::WorkStealingThreadPool' (a "worker") owns a
+// deque of jobs.  A worker pushes and pops jobs at the bottom of its own deque
+// without contending with the other workers, and a worker having no jobs
+// "steals" the oldest job from the top of the deque of another worker.  This
+// design is well suited to fine-grained jobs, and in particular to jobs that
+// themselves enqueue further jobs (e.g., recursive divide-and-conquer
+// algorithms), for which a shared queue quickly becomes the bottleneck.
+//
+// The deques are implemented using the algorithm of Chase and Lev ("Dynamic
+// Circular Work-Stealing Deque", SPAA 2005), with the memory ordering of Le et
+// al. ("Correct and Efficient Work-Stealing for Weak Memory Models", PPoPP
+// 2013): pushing and popping a job are wait-free, and a steal attempt
+// completes in a bounded number of steps (failing only if it races with
+// another thread taking the same job).
+//
+///Enqueuing Jobs
+///--------------
+// Jobs are specified as 'bsl::function<void()>' objects, or as a "void
+// function/void pointer" pair, using the same 'enqueueJob' interface as
+// 'bdlmt::FixedThreadPool', so that this pool can replace an existing pool
+// without changes to the code that creates jobs.  Where a job is placed
+// depends on the thread calling 'enqueueJob':
+//
+//: o A job enqueued by a job running in the pool ("local submission") is
+//:   pushed onto the deque of the worker executing the calling job.  Local
+//:   submission does not acquire any lock.
+//:
+//: o A job enqueued by any other thread is appended, under a mutex, to the
+//:   "inbox" of one of the workers, chosen in a round-robin fashion.  A worker
+//:   moves the jobs in its inbox to its deque when its deque is empty, and an
+//:   idle worker may take the jobs in the inbox of another worker.
+//
+// No guarantee is made about the order in which jobs are executed.  In
+// particular, a worker executes the jobs in its own deque in LIFO order, so
+// that the most recently enqueued (and most likely cache-resident) job is
+// executed first, while other workers steal the oldest jobs.
+//
+///Idle Workers
+///------------
+// A worker that does not find a job, in its own deque, its inbox, or those of
+// the other workers, repeatedly yields and retries for a short time, then
+// blocks on a semaphore.  Enqueuing a job posts the semaphore if (and only if)
+// a worker is blocked, so that a pool whose workers are all busy does not
+// incur the cost of the semaphore.
+//
+///Draining and Stopping
+///---------------------
+// 'drain' blocks until all the workers are idle and there are no pending jobs,
+// including the jobs enqueued by jobs that were running when 'drain' was
+// called.  'stop' rejects jobs subsequently enqueued by threads not in the
+// pool, drains the pool (jobs running in the pool can still enqueue jobs), and
+// then joins the workers.  'shutdown' joins the workers as soon as they
+// complete the jobs they are executing, and destroys the pending jobs without
+// executing them.  Note that 'drain' and 'stop' must not be called from a job
+// executing in the pool.
+//
+///Thread Safety
+///-------------
+// The 'bdlmt::WorkStealingThreadPool' class is both *fully thread-safe* (i.e.,
+// all non-creator methods can correctly execute concurrently), and is
+// *thread-enabled* (i.e., the class does not function correctly in a
+// non-multi-threading environment).  See 'bsldoc_glossary' for complete
+// definitions of *fully thread-safe* and *thread-enabled*.
+//
+///Synchronous Signals on Unix
+///---------------------------
+// A thread pool ensures that, on unix platforms, all the threads in the pool
+// block all asynchronous signals.  Specifically all the signals, except the
+// following synchronous signals are blocked:
+//..
+// SIGBUS
+// SIGFPE
+// SIGILL
+// SIGSEGV
+// SIGSYS
+// SIGABRT
+// SIGTRAP
+// SIGIOT
+//..
+//
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Computing a Sum by Divide and Conquer
+/// - - - - - - - - - - - - - - - - - - - - - - - -
+// In this example we compute the sum of the elements of a large array by
+// recursively splitting the array into halves, each half being summed by a
+// separate job, until the ranges are small enough to be summed directly.
+//
+// First, we define a functor, 'SumJob', that sums a range of the array into
+// an atomic total.  A range that is too large is split in two: the first half
+// is enqueued as a new job, which (being enqueued from a job running in the
+// pool) is pushed onto the deque of the current worker where it can be stolen
+// by an idle worker, and the second half is processed by the current job:
+//..
+//  struct SumJob {
+//      // This functor adds the sum of the elements of a range of integers to
+//      // an atomic total, using a thread pool to process large ranges in
+//      // parallel.
+//
+//      // DATA
+//      bdlmt::WorkStealingThreadPool *d_pool_p;   // pool executing the job
+//      const int                     *d_begin_p;  // beginning of the range
+//      const int                     *d_end_p;    // end of the range
+//      bsls::AtomicInt64             *d_sum_p;    // total
+//
+//      // ACCESSORS
+//      void operator()() const
+//          // Add the sum of the elements of the range of this job to the
+//          // total.
+//      {
+//          if (d_end_p - d_begin_p <= 1000) {
+//              bsls::Types::Int64 sum = 0;
+//              for (const int *p = d_begin_p; p != d_end_p; ++p) {
+//                  sum += *p;
+//              }
+//              d_sum_p->addRelaxed(sum);
+//              return;                                               // RETURN
+//          }
+//
+//          const int *middle = d_begin_p + (d_end_p - d_begin_p) / 2;
+//
+//          SumJob firstHalf(*this);
+//          firstHalf.d_end_p = middle;
+//          d_pool_p->enqueueJob(firstHalf);
+//
+//          SumJob secondHalf(*this);
+//          secondHalf.d_begin_p = middle;
+//          secondHalf();
+//      }
+//  };
+//..
+// Then, we create the array to be summed:
+//..
+//  bsl::vector<int> data(1000000);
+//  for (bsl::size_t i = 0; i < data.size(); ++i) {
+//      data[i] = static_cast<int>(i % 1000);
+//  }
+//..
+// Next, we create and start a pool having four workers:
+//..
+//  bdlmt::WorkStealingThreadPool pool(4);
+//  int rc = pool.start();
+//  assert(0 == rc);
+//..
+// Then, we enqueue a job summing the entire array:
+//..
+//  bsls::AtomicInt64 sum(0);
+//
+//  SumJob job = { &pool, data.data(), data.data() + data.size(), &sum };
+//  rc = pool.enqueueJob(job);
+//  assert(0 == rc);
+//..
+// Finally, we wait until all the jobs, including the jobs enqueued by other
+// jobs, have completed, and verify the result:
+//..
+//  pool.drain();
+//  assert(499500LL * 1000 == sum.load());
+//
+//  pool.stop();
+//..
+
+#include <bdlscm_version.h>
+
+#include <bdlma_concurrentpool.h>
+
+#include <bslma_allocator.h>
+#include <bslma_usesbslmaallocator.h>
+
+#include <bslmf_movableref.h>
+#include <bslmf_nestedtraitdeclaration.h>
+
+#include <bslmt_condition.h>
+#include <bslmt_mutex.h>
+#include <bslmt_platform.h>
+#include <bslmt_semaphore.h>
+#include <bslmt_threadattributes.h>
+#include <bslmt_threadgroup.h>
+
+#include <bsls_atomic.h>
+#include <bsls_platform.h>
+#include <bsls_types.h>
+
+#include <bdlf_bind.h>
+
+#include <bsl_functional.h>
+#include <bsl_vector.h>
+
+#if defined(BSLS_PLATFORM_OS_UNIX)
+#include <bsl_c_signal.h>              // sigset_t
+#endif
+
+namespace BloombergLP {
+namespace bdlmt {
+
+extern "C" typedef void (*WorkStealingThreadPoolJobFunc)(void *);
+    // This type declares the prototype for functions that are suitable to be
+    // specified 'bdlmt::WorkStealingThreadPool::enqueueJob'.
+
+class WorkStealingThreadPool_Worker;
+
+                     // ==================================
+                     // class WorkStealingThreadPool_Deque
+                     // ==================================
+
+class WorkStealingThreadPool_Deque {
+    // This class implements a work-stealing deque of pointers to jobs, having
+    // a single "owner" thread that pushes and pops jobs at the bottom of the
+    // deque, and any number of "thief" threads that remove jobs from its top.
+    // The deque grows as needed; the arrays it outgrows are retained until the
+    // deque is destroyed, as they may still be accessed by thieves.
+
+  public:
+    // TYPES
+    typedef bsl::function<void()> Job;
+
+  private:
+    // PRIVATE TYPES
+    struct Array {
+        // This 'struct' holds a circular array of job pointers, and links to
+        // the array it replaced.
+
+        bsls::Types::Int64         d_mask;        // capacity minus one
+
+        bsls::AtomicPointer<Job>  *d_slots_p;     // array of 'd_mask + 1'
+                                                  // slots
+
+        Array                     *d_previous_p;  // array replaced by this
+                                                  // one, or 0
+    };
+
+    enum {
+        k_INITIAL_CAPACITY = 256,  // capacity of the initial array
+
+        k_PADDING = bslmt::Platform::e_CACHE_LINE_SIZE
+                                                  - sizeof(bsls::AtomicInt64)
+    };
+
+    // DATA
+    bsls::AtomicInt64           d_top;        // index of the oldest job,
+                                              // incremented by thieves and,
+                                              // for the last job, by the owner
+
+    const char                  d_topPad[k_PADDING];
+                                              // padding to prevent false
+                                              // sharing
+
+    bsls::AtomicInt64           d_bottom;     // index following the newest
+                                              // job, modified only by the
+                                              // owner
+
+    bsls::AtomicPointer<Array>  d_array_p;    // current array (owned)
+
+    bslma::Allocator           *d_allocator_p;
+                                              // memory allocator (held, not
+                                              // owned)
+
+    // PRIVATE CLASS METHODS
+    static Array *createArray(bsls::Types::Int64  capacity,
+                              bslma::Allocator   *allocator);
+        // Return a new array having the specified 'capacity', using the
+        // specified 'allocator' to supply memory.  The behavior is undefined
+        // unless 'capacity' is a power of two.
+
+    // PRIVATE MANIPULATORS
+    Array *grow(Array              *array,
+                bsls::Types::Int64  top,
+                bsls::Types::Int64  bottom);
+        // Replace the specified current 'array' by an array of twice its
+        // capacity holding the jobs having the indices in the range
+        // '[top .. bottom)', and return the new array.  The behavior is
+        // undefined unless this method is called by the owner of this deque.
+
+    // NOT IMPLEMENTED
+    WorkStealingThreadPool_Deque(const WorkStealingThreadPool_Deque&);
+    WorkStealingThreadPool_Deque& operator=(
+                                          const WorkStealingThreadPool_Deque&);
+
+  public:
+    // TRAITS
+    BSLMF_NESTED_TRAIT_DECLARATION(WorkStealingThreadPool_Deque,
+                                   bslma::UsesBslmaAllocator);
+
+    // CREATORS
+    explicit
+    WorkStealingThreadPool_Deque(bslma::Allocator *basicAllocator = 0);
+        // Create an empty deque.  Optionally specify a 'basicAllocator' used
+        // to supply memory.  If 'basicAllocator' is 0, the currently installed
+        // default allocator is used.
+
+    ~WorkStealingThreadPool_Deque();
+        // Destroy this deque.  Note that the jobs referred to by this deque
+        // are not destroyed.
+
+    // MANIPULATORS
+    Job *popBottom();
+        // Remove the newest job from this deque and return its address, or
+        // return 0 if this deque is empty.  The behavior is undefined unless
+        // this method is called by the owner of this deque.
+
+    void pushBottom(Job *job);
+        // Add the specified 'job' to the bottom of this deque.  The behavior
+        // is undefined unless this method is called by the owner of this
+        // deque.
+
+    Job *steal();
+        // Remove the oldest job from this deque and return its address, or
+        // return 0 if this deque is empty or if another thread removed that
+        // job concurrently.
+
+    // ACCESSORS
+    bool isEmpty() const;
+        // Return 'true' if this deque holds no jobs, and 'false' otherwise.
+        // Note that the returned value may be out of date when it is used.
+
+    bsls::Types::Int64 length() const;
+        // Return a snapshot of the number of jobs held by this deque.
+};
+
+                        // ============================
+                        // class WorkStealingThreadPool
+                        // ============================
+
+class WorkStealingThreadPool {
+    // This class implements a thread pool, having a fixed number of threads,
+    // in which each thread executes the jobs of its own deque of jobs, and
+    // steals jobs from the other threads when its deque is empty.
+
+  public:
+    // TYPES
+    typedef bsl::function<void()> Job;
+
+  private:
+    // PRIVATE TYPES
+    typedef WorkStealingThreadPool_Worker Worker;
+
+    enum {
+        e_STOP,     // threads are stopped, or stopping
+        e_RUN,      // threads are running and jobs can be enqueued
+        e_DRAIN     // 'stop' is draining the pool
+    };
+
+    // DATA
+    bdlma::ConcurrentPool    d_jobPool;          // pool supplying the
+                                                 // footprint of each job
+
+    bsl::vector<Worker *>    d_workers;          // worker data (owned)
+
+    bsls::AtomicInt          d_control;          // state of the pool (i.e.,
+                                                 // 'e_STOP', 'e_RUN', or
+                                                 // 'e_DRAIN')
+
+    bsls::AtomicUint         d_nextInbox;        // index of the inbox to
+                                                 // receive the next job
+                                                 // enqueued by a thread not in
+                                                 // the pool
+
+    bsls::AtomicInt          d_numThreadsWaiting;
+                                                 // number of threads that
+                                                 // found no job and may block
+                                                 // on 'd_semaphore'
+
+    bslmt::Semaphore         d_semaphore;        // semaphore on which idle
+                                                 // threads block
+
+    bslmt::Mutex             d_idleMutex;        // mutex used with
+                                                 // 'd_idleCondition'
+
+    bslmt::Condition         d_idleCondition;    // condition signaled when all
+                                                 // threads are idle
+
+    bslmt::Mutex             d_metaMutex;        // mutex ensuring that there
+                                                 // is only one controlling
+                                                 // thread at any time
+
+    bslmt::ThreadGroup       d_threadGroup;      // threads of this pool
+
+    bslmt::ThreadAttributes  d_threadAttributes; // attributes of the threads
+
+    const int                d_numThreads;       // number of threads
+
+#if defined(BSLS_PLATFORM_OS_UNIX)
+    sigset_t                 d_blockSet;         // set of signals to be
+                                                 // blocked in managed threads
+#endif
+
+    bslma::Allocator        *d_allocator_p;      // memory allocator (held, not
+                                                 // owned)
+
+    // PRIVATE MANIPULATORS
+    Job *findJob(Worker *worker);
+        // Return the address of a job removed from the deque or the inbox of
+        // the specified 'worker', or stolen from another worker, or 0 if no
+        // job was found.  The behavior is undefined unless this method is
+        // called by the thread of 'worker'.
+
+    void init();
+        // Create the workers of this pool.  Note that this method is called
+        // by the constructors.
+
+    void removeAllJobs();
+        // Destroy, without executing them, all the jobs held by the workers of
+        // this pool.  The behavior is undefined unless no thread of this pool
+        // is running.
+
+    void runJob(Job *job);
+        // Execute, destroy, and deallocate the specified 'job'.
+
+    int startNewThread(Worker *worker);
+        // Start a thread executing the jobs of the specified 'worker'.  Return
+        // 0 on success, and a non-zero value otherwise.
+
+    bool transferInbox(Worker *to, Worker *from);
+        // Move the jobs in the inbox of the specified 'from' worker to the
+        // deque of the specified 'to' worker.  Return 'true' if at least one
+        // job was moved, and 'false' otherwise.  The behavior is undefined
+        // unless this method is called by the thread of 'to'.
+
+    void waitUntilIdle();
+        // Block until every thread of this pool is idle and no job is held by
+        // any worker.
+
+    void workerThread(Worker *worker);
+        // Execute jobs for the specified 'worker' until this pool is stopped.
+        // Note that this method is the main function of each thread of this
+        // pool.
+
+    // PRIVATE ACCESSORS
+    bool hasJobs() const;
+        // Return 'true' if a job is held by the deque or inbox of any worker
+        // of this pool, and 'false' otherwise.
+
+    Worker *localWorker() const;
+        // Return the address of the worker of this pool whose thread is the
+        // calling thread, or 0 if the calling thread is not a thread of this
+        // pool.
+
+    // NOT IMPLEMENTED
+    WorkStealingThreadPool(const WorkStealingThreadPool&);
+    WorkStealingThreadPool& operator=(const WorkStealingThreadPool&);
+
+  public:
+    // TRAITS
+    BSLMF_NESTED_TRAIT_DECLARATION(WorkStealingThreadPool,
+                                   bslma::UsesBslmaAllocator);
+
+    // CREATORS
+    explicit WorkStealingThreadPool(int               numThreads,
+                                    bslma::Allocator *basicAllocator = 0);
+        // Create a thread pool having the specified 'numThreads' threads.
+        // Optionally specify a 'basicAllocator' used to supply memory.  If
+        // 'basicAllocator' is 0, the currently installed default allocator is
+        // used.  The behavior is undefined unless '1 <= numThreads'.  Note
+        // that the threads are not created until 'start' is called.
+
+    WorkStealingThreadPool(const bslmt::ThreadAttributes&  threadAttributes,
+                           int                             numThreads,
+                           bslma::Allocator               *basicAllocator = 0);
+        // Create a thread pool having the specified 'numThreads' threads,
+        // created with the specified 'threadAttributes'.  Optionally specify a
+        // 'basicAllocator' used to supply memory.  If 'basicAllocator' is 0,
+        // the currently installed default allocator is used.  The behavior is
+        // undefined unless '1 <= numThreads'.
+
+    ~WorkStealingThreadPool();
+        // Destroy the pending jobs without executing them, block until the
+        // jobs currently executing complete, and destroy this thread pool.
+
+    // MANIPULATORS
+    void drain();
+        // Block until all the jobs enqueued on this pool, including the jobs
+        // enqueued by those jobs, have completed.  Return immediately if this
+        // pool is not started.  Note that if jobs are enqueued concurrently by
+        // threads not in this pool, this method may or may not wait until they
+        // have completed.  The behavior is undefined if this method is called
+        // by a job executing in this pool.
+
+    int enqueueJob(const Job& functor);
+    int enqueueJob(bslmf::MovableRef<Job> functor);
+        // Enqueue the specified 'functor' to be executed by a thread of this
+        // pool.  If the calling thread is a thread of this pool, push the job
+        // onto the deque of the calling thread; otherwise, add the job to the
+        // inbox of one of the threads.  Return 0 on success, and a non-zero
+        // value if this pool is not started, or if this pool is stopping and
+        // the calling thread is not a thread of this pool.  The behavior is
+        // undefined unless 'functor' is not "unset".
+
+    int enqueueJob(WorkStealingThreadPoolJobFunc function, void *userData);
+        // Enqueue the specified 'function' to be executed by a thread of this
+        // pool with the specified 'userData' as its argument.  Return 0 on
+        // success, and a non-zero value if this pool is not started, or if
+        // this pool is stopping and the calling thread is not a thread of this
+        // pool.
+
+    void shutdown();
+        // Reject subsequently enqueued jobs, block until the jobs currently
+        // executing complete, join the threads of this pool, and destroy the
+        // pending jobs without executing them.  This method has no effect if
+        // this pool is not started.
+
+    int start();
+        // Create the threads of this pool and enable enqueuing jobs.  Return
+        // 0 on success, and a non-zero value otherwise, in which case no
+        // thread of this pool is running.  This method has no effect, and
+        // returns 0, if this pool is already started.
+
+    void stop();
+        // Reject jobs subsequently enqueued by threads not in this pool, block
+        // until all the jobs enqueued on this pool, including the jobs
+        // enqueued by those jobs, have completed, and then join the threads of
+        // this pool.  This method has no effect if this pool is not started.
+        // The behavior is undefined if this method is called by a job
+        // executing in this pool.
+
+    // ACCESSORS
+    bool isStarted() const;
+        // Return 'true' if the threads of this pool are started, and 'false'
+        // otherwise.
+
+    int numPendingJobs() const;
+        // Return a snapshot of the number of jobs enqueued on this pool whose
+        // execution has not started.
+
+    bsls::Types::Int64 numStolenJobs() const;
+        // Return a snapshot of the number of jobs that were executed by a
+        // thread other than the thread to which they were enqueued, since
+        // the construction of this pool.
+
+    int numThreads() const;
+        // Return the number of threads of this pool.
+
+                                  // Aspects
+
+    bslma::Allocator *allocator() const;
+        // Return the allocator used by this pool to supply memory.
+};
+
+// ============================================================================
+//                            INLINE DEFINITIONS
+// ============================================================================
+
+                     // ----------------------------------
+                     // class WorkStealingThreadPool_Deque
+                     // ----------------------------------
+
+// MANIPULATORS
+inline
+WorkStealingThreadPool_Deque::Job *WorkStealingThreadPool_Deque::popBottom()
+{
+    const bsls::Types::Int64 bottom = d_bottom.loadRelaxed() - 1;
+    Array                   *array  = d_array_p.loadRelaxed();
+
+    // The store to 'd_bottom' and the load of 'd_top' must be sequentially
+    // consistent, so that a thief racing for the last job either observes the
+    // decremented 'd_bottom', or is observed by the owner.
+
+    d_bottom.store(bottom);
+    const bsls::Types::Int64 top = d_top.load();
+
+    if (bottom < top) {
+        d_bottom.storeRelaxed(bottom + 1);
+        return 0;                                                     // RETURN
+    }
+
+    Job *job = array->d_slots_p[bottom & array->d_mask].loadRelaxed();
+
+    if (bottom == top) {
+        // This is the last job; race with the thieves for it.
+
+        if (top != d_top.testAndSwap(top, top + 1)) {
+            job = 0;
+        }
+        d_bottom.storeRelaxed(top + 1);
+    }
+    return job;
+}
+
+inline
+void WorkStealingThreadPool_Deque::pushBottom(Job *job)
+{
+    const bsls::Types::Int64 bottom = d_bottom.loadRelaxed();
+    const bsls::Types::Int64 top    = d_top.loadAcquire();
+    Array                   *array  = d_array_p.loadRelaxed();
+
+    if (bottom - top > array->d_mask) {
+        array = grow(array, top, bottom);
+    }
+    array->d_slots_p[bottom & array->d_mask].storeRelaxed(job);
+    d_bottom.storeRelease(bottom + 1);
+}
+
+inline
+WorkStealingThreadPool_Deque::Job *WorkStealingThreadPool_Deque::steal()
+{
+    const bsls::Types::Int64 top    = d_top.load();
+    const bsls::Types::Int64 bottom = d_bottom.load();
+
+    if (top >= bottom) {
+        return 0;                                                     // RETURN
+    }
+
+    Array *array = d_array_p.loadAcquire();
+    Job   *job   = array->d_slots_p[top & array->d_mask].loadRelaxed();
+
+    if (top != d_top.testAndSwap(top, top + 1)) {
+        return 0;                                                     // RETURN
+    }
+    return job;
+}
+
+// ACCESSORS
+inline
+bool WorkStealingThreadPool_Deque::isEmpty() const
+{
+    return 0 >= length();
+}
+
+inline
+bsls::Types::Int64 WorkStealingThreadPool_Deque::length() const
+{
+    const bsls::Types::Int64 top    = d_top.load();
+    const bsls::Types::Int64 bottom = d_bottom.load();
+
+    return bottom > top ? bottom - top : 0;
+}
+
+                        // ----------------------------
+                        // class WorkStealingThreadPool
+                        // ----------------------------
+
+// MANIPULATORS
+inline
+int WorkStealingThreadPool::enqueueJob(WorkStealingThreadPoolJobFunc  function,
+                                       void                          *userData)
+{
+    return enqueueJob(bdlf::BindUtil::bindR<void>(function, userData));
+}
+
+// ACCESSORS
+inline
+bool WorkStealingThreadPool::isStarted() const
+{
+    return e_STOP != d_control.load();
+}
+
+inline
+int WorkStealingThreadPool::numThreads() const
+{
+    return d_numThreads;
+}
+
+                                  // Aspects
+
+inline
+bslma::Allocator *WorkStealingThreadPool::allocator() const
+{
+    return d_allocator_p;
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2020 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
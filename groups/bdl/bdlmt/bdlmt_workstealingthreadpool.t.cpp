@@ -0,0 +1,1154 @@
+// bdlmt_workstealingthreadpool.t.cpp                                 -*-C++-*-
+#include <bdlmt_workstealingthreadpool.h>
+
+#include <bdlmt_fixedthreadpool.h>
+#include <bdlmt_threadpool.h>
+
+#include <bdlf_bind.h>
+
+#include <bslim_testutil.h>
+
+#include <bslma_default.h>
+#include <bslma_defaultallocatorguard.h>
+#include <bslma_testallocator.h>
+#include <bslma_testallocatormonitor.h>
+
+#include <bslmt_barrier.h>
+#include <bslmt_semaphore.h>
+#include <bslmt_threadgroup.h>
+#include <bslmt_threadutil.h>
+
+#include <bsls_asserttest.h>
+#include <bsls_atomic.h>
+#include <bsls_timeutil.h>
+#include <bsls_types.h>
+
+#include <bsl_cstdlib.h>
+#include <bsl_functional.h>
+#include <bsl_iostream.h>
+#include <bsl_memory.h>
+#include <bsl_vector.h>
+
+using namespace BloombergLP;
+using bsl::cout;
+using bsl::endl;
+
+// ============================================================================
+//                             TEST PLAN
+// ----------------------------------------------------------------------------
+//                              Overview
+//                              --------
+// The component under test defines a thread pool,
+// 'bdlmt::WorkStealingThreadPool', built on a work-stealing deque,
+// 'bdlmt::WorkStealingThreadPool_Deque'.  The deque is tested first, from a
+// single thread and then with an owner thread racing with several thieves,
+// verifying that each job is removed exactly once.  The pool is then tested
+// for its life cycle ('start', 'stop', 'shutdown', and restarting), for the
+// placement and execution of jobs enqueued by threads in and out of the pool,
+// and for 'drain' in the presence of jobs that enqueue further jobs.
+// ----------------------------------------------------------------------------
+// WorkStealingThreadPool_Deque
+// [ 2] WorkStealingThreadPool_Deque(basicAllocator);
+// [ 2] ~WorkStealingThreadPool_Deque();
+// [ 2] Job *popBottom();
+// [ 2] void pushBottom(Job *job);
+// [ 2] Job *steal();
+// [ 2] bool isEmpty() const;
+// [ 2] bsls::Types::Int64 length() const;
+//
+// WorkStealingThreadPool
+// [ 4] WorkStealingThreadPool(numThreads, basicAllocator);
+// [ 4] WorkStealingThreadPool(attributes, numThreads, basicAllocator);
+// [ 4] ~WorkStealingThreadPool();
+// [ 5] void drain();
+// [ 5] int enqueueJob(const Job& functor);
+// [ 5] int enqueueJob(bslmf::MovableRef<Job> functor);
+// [ 5] int enqueueJob(WorkStealingThreadPoolJobFunc func, void *data);
+// [ 4] void shutdown();
+// [ 4] int start();
+// [ 4] void stop();
+// [ 4] bool isStarted() const;
+// [ 5] int numPendingJobs() const;
+// [ 6] bsls::Types::Int64 numStolenJobs() const;
+// [ 4] int numThreads() const;
+// [ 4] bslma::Allocator *allocator() const;
+// ----------------------------------------------------------------------------
+// [ 1] BREATHING TEST
+// [ 3] CONCURRENT STEALING
+// [ 6] RECURSIVE JOBS
+// [ 7] USAGE EXAMPLE
+// [-1] THROUGHPUT BENCHMARK
+
+// ============================================================================
+//                     STANDARD BDE ASSERT TEST FUNCTION
+// ----------------------------------------------------------------------------
+
+namespace {
+
+int testStatus = 0;
+
+void aSsErT(bool condition, const char *message, int line)
+{
+    if (condition) {
+        cout << "Error " __FILE__ "(" << line << "): " << message
+             << "    (failed)" << endl;
+
+        if (0 <= testStatus && testStatus <= 100) {
+            ++testStatus;
+        }
+    }
+}
+
+}  // close unnamed namespace
+
+// ============================================================================
+//               STANDARD BDE TEST DRIVER MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT       BSLIM_TESTUTIL_ASSERT
+#define ASSERTV      BSLIM_TESTUTIL_ASSERTV
+
+#define LOOP_ASSERT  BSLIM_TESTUTIL_LOOP_ASSERT
+#define LOOP0_ASSERT BSLIM_TESTUTIL_LOOP0_ASSERT
+#define LOOP1_ASSERT BSLIM_TESTUTIL_LOOP1_ASSERT
+#define LOOP2_ASSERT BSLIM_TESTUTIL_LOOP2_ASSERT
+#define LOOP3_ASSERT BSLIM_TESTUTIL_LOOP3_ASSERT
+#define LOOP4_ASSERT BSLIM_TESTUTIL_LOOP4_ASSERT
+#define LOOP5_ASSERT BSLIM_TESTUTIL_LOOP5_ASSERT
+#define LOOP6_ASSERT BSLIM_TESTUTIL_LOOP6_ASSERT
+
+#define Q            BSLIM_TESTUTIL_Q   // Quote identifier literally.
+#define P            BSLIM_TESTUTIL_P   // Print identifier and value.
+#define P_           BSLIM_TESTUTIL_P_  // P(X) without '\n'.
+#define T_           BSLIM_TESTUTIL_T_  // Print a tab (w/o newline).
+#define L_           BSLIM_TESTUTIL_L_  // current Line number
+
+// ============================================================================
+//                  NEGATIVE-TEST MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT_OPT_PASS(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_PASS(EXPR)
+#define ASSERT_OPT_FAIL(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_FAIL(EXPR)
+
+// ============================================================================
+//                   GLOBAL TYPEDEFS/CONSTANTS FOR TESTING
+// ----------------------------------------------------------------------------
+
+static bool             verbose;
+static bool         veryVerbose;
+static bool     veryVeryVerbose;
+static bool veryVeryVeryVerbose;
+
+typedef bdlmt::WorkStealingThreadPool        Obj;
+typedef bdlmt::WorkStealingThreadPool_Deque  Deque;
+typedef Obj::Job                             Job;
+typedef bsls::Types::Int64                   Int64;
+
+// ============================================================================
+//                   GLOBAL HELPER FUNCTIONS FOR TESTING
+// ----------------------------------------------------------------------------
+
+namespace {
+
+void increment(bsls::AtomicInt *counter)
+    // Increment the specified 'counter'.
+{
+    ++*counter;
+}
+
+extern "C" void incrementCallback(void *counter)
+    // Increment the 'bsls::AtomicInt' at the specified 'counter' address.
+{
+    ++*static_cast<bsls::AtomicInt *>(counter);
+}
+
+void waitAndIncrement(bslmt::Semaphore *gate, bsls::AtomicInt *counter)
+    // Wait on the specified 'gate', then increment the specified 'counter'.
+{
+    gate->wait();
+    ++*counter;
+}
+
+void holdAndIncrement(const bsl::shared_ptr<int>&, bsls::AtomicInt *counter)
+    // Increment the specified 'counter'.  Note that the first argument is
+    // used to verify that the job is destroyed.
+{
+    ++*counter;
+}
+
+void enqueueLocally(Obj             *pool,
+                    int              numJobs,
+                    bsls::AtomicInt *counter,
+                    bsls::AtomicInt *numFailures)
+    // Enqueue, on the specified 'pool', the specified 'numJobs' jobs each
+    // incrementing the specified 'counter', incrementing the specified
+    // 'numFailures' for each job that fails to be enqueued or that is not
+    // placed on the deque of the calling thread.
+{
+    for (int i = 0; i < numJobs; ++i) {
+        const int numPending = pool->numPendingJobs();
+        if (0 != pool->enqueueJob(bdlf::BindUtil::bind(&increment, counter))) {
+            ++*numFailures;
+        }
+        if (1 == pool->numThreads()
+         && numPending + 1 != pool->numPendingJobs()) {
+            ++*numFailures;
+        }
+    }
+}
+
+void enqueueWhileStopping(Obj              *pool,
+                          bslmt::Semaphore *started,
+                          bslmt::Semaphore *gate,
+                          bsls::AtomicInt  *counter,
+                          bsls::AtomicInt  *numFailures)
+    // Post the specified 'started' semaphore, wait on the specified 'gate',
+    // and enqueue on the specified 'pool' a job incrementing the specified
+    // 'counter', incrementing the specified 'numFailures' if it fails to be
+    // enqueued.
+{
+    started->post();
+    gate->wait();
+    if (0 != pool->enqueueJob(bdlf::BindUtil::bind(&increment, counter))) {
+        ++*numFailures;
+    }
+}
+
+void countLeaves(Obj *pool, int depth, bsls::AtomicInt64 *numLeaves)
+    // Increment the specified 'numLeaves' if the specified 'depth' is 0, and
+    // otherwise enqueue on the specified 'pool' two jobs calling this function
+    // with 'depth - 1'.
+{
+    if (0 == depth) {
+        numLeaves->addRelaxed(1);
+        return;                                                       // RETURN
+    }
+    pool->enqueueJob(bdlf::BindUtil::bind(&countLeaves,
+                                          pool,
+                                          depth - 1,
+                                          numLeaves));
+    pool->enqueueJob(bdlf::BindUtil::bind(&countLeaves,
+                                          pool,
+                                          depth - 1,
+                                          numLeaves));
+}
+
+void stealJobs(Deque             *deque,
+               Job               *jobs,
+               bsls::AtomicInt   *numTaken,
+               bsls::AtomicInt   *done,
+               bslmt::Barrier    *barrier,
+               bsls::AtomicInt64 *numStolen)
+    // Wait on the specified 'barrier', then steal jobs from the specified
+    // 'deque' until the specified 'done' flag is set and the deque is empty,
+    // incrementing the element of the specified 'numTaken' array having the
+    // index of each stolen job in the specified 'jobs' array, and adding the
+    // number of stolen jobs to the specified 'numStolen'.
+{
+    barrier->wait();
+
+    Int64 count = 0;
+    while (!*done || !deque->isEmpty()) {
+        Job *job = deque->steal();
+        if (job) {
+            ++numTaken[job - jobs];
+            ++count;
+        }
+    }
+    numStolen->addRelaxed(count);
+}
+
+void benchmarkJob(bsls::AtomicInt64 *counter)
+    // Increment the specified 'counter'.
+{
+    counter->addRelaxed(1);
+}
+
+template <class POOL>
+void spawnBenchmarkJobs(POOL *pool, int numJobs, bsls::AtomicInt64 *counter)
+    // Enqueue on the specified 'pool' the specified 'numJobs' jobs, each
+    // incrementing the specified 'counter'.
+{
+    for (int i = 0; i < numJobs; ++i) {
+        pool->enqueueJob(bdlf::BindUtil::bind(&benchmarkJob, counter));
+    }
+}
+
+}  // close unnamed namespace
+
+// ============================================================================
+//                               USAGE EXAMPLE
+// ----------------------------------------------------------------------------
+
+namespace usage {
+
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Computing a Sum by Divide and Conquer
+/// - - - - - - - - - - - - - - - - - - - - - - - -
+// In this example we compute the sum of the elements of a large array by
+// recursively splitting the array into halves, each half being summed by a
+// separate job, until the ranges are small enough to be summed directly.
+//
+// First, we define a functor, 'SumJob', that sums a range of the array into
+// an atomic total.  A range that is too large is split in two: the first half
+// is enqueued as a new job, which (being enqueued from a job running in the
+// pool) is pushed onto the deque of the current worker where it can be stolen
+// by an idle worker, and the second half is processed by the current job:
+//..
+    struct SumJob {
+        // This functor adds the sum of the elements of a range of integers to
+        // an atomic total, using a thread pool to process large ranges in
+        // parallel.
+
+        // DATA
+        bdlmt::WorkStealingThreadPool *d_pool_p;   // pool executing the job
+        const int                     *d_begin_p;  // beginning of the range
+        const int                     *d_end_p;    // end of the range
+        bsls::AtomicInt64             *d_sum_p;    // total
+
+        // ACCESSORS
+        void operator()() const
+            // Add the sum of the elements of the range of this job to the
+            // total.
+        {
+            if (d_end_p - d_begin_p <= 1000) {
+                bsls::Types::Int64 sum = 0;
+                for (const int *p = d_begin_p; p != d_end_p; ++p) {
+                    sum += *p;
+                }
+                d_sum_p->addRelaxed(sum);
+                return;                                               // RETURN
+            }
+
+            const int *middle = d_begin_p + (d_end_p - d_begin_p) / 2;
+
+            SumJob firstHalf(*this);
+            firstHalf.d_end_p = middle;
+            d_pool_p->enqueueJob(firstHalf);
+
+            SumJob secondHalf(*this);
+            secondHalf.d_begin_p = middle;
+            secondHalf();
+        }
+    };
+//..
+
+}  // close namespace usage
+
+// ============================================================================
+//                               MAIN PROGRAM
+// ----------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    int test            = argc > 1 ? bsl::atoi(argv[1]) : 0;
+    verbose             = argc > 2;
+    veryVerbose         = argc > 3;
+    veryVeryVerbose     = argc > 4;
+    veryVeryVeryVerbose = argc > 5;
+
+    cout << "TEST " << __FILE__ << " CASE " << test << endl;
+
+    // CONCERN: In no case does memory come from the default allocator.
+
+    bslma::TestAllocator defaultAllocator("default", veryVeryVeryVerbose);
+    bslma::DefaultAllocatorGuard defaultAllocatorGuard(&defaultAllocator);
+    bslma::TestAllocatorMonitor dam(&defaultAllocator);
+
+    switch (test) { case 0:
+      case 7: {
+        // --------------------------------------------------------------------
+        // USAGE EXAMPLE
+        //   Extracted from component header file.
+        //
+        // Concerns:
+        //: 1 The usage example provided in the component header file compiles,
+        //:   links, and runs as shown.
+        //
+        // Plan:
+        //: 1 Incorporate usage example from header into test driver, remove
+        //:   leading comment characters, and replace 'assert' with 'ASSERT'.
+        //:   (C-1)
+        //
+        // Testing:
+        //   USAGE EXAMPLE
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "USAGE EXAMPLE" << endl
+                          << "=============" << endl;
+
+        bslma::TestAllocator         ta("usage", veryVeryVeryVerbose);
+        bslma::DefaultAllocatorGuard guard(&ta);
+
+        using namespace usage;
+
+// Then, we create the array to be summed:
+//..
+    bsl::vector<int> data(1000000);
+    for (bsl::size_t i = 0; i < data.size(); ++i) {
+        data[i] = static_cast<int>(i % 1000);
+    }
+//..
+// Next, we create and start a pool having four workers:
+//..
+    bdlmt::WorkStealingThreadPool pool(4);
+    int rc = pool.start();
+    ASSERT(0 == rc);
+//..
+// Then, we enqueue a job summing the entire array:
+//..
+    bsls::AtomicInt64 sum(0);
+
+    SumJob job = { &pool, data.data(), data.data() + data.size(), &sum };
+    rc = pool.enqueueJob(job);
+    ASSERT(0 == rc);
+//..
+// Finally, we wait until all the jobs, including the jobs enqueued by other
+// jobs, have completed, and verify the result:
+//..
+    pool.drain();
+    ASSERT(499500LL * 1000 == sum.load());
+
+    pool.stop();
+//..
+      } break;
+      case 6: {
+        // --------------------------------------------------------------------
+        // RECURSIVE JOBS
+        //
+        // Concerns:
+        //: 1 Jobs enqueued by jobs executing in the pool are executed.
+        //:
+        //: 2 'drain' waits until the jobs enqueued by jobs have completed.
+        //:
+        //: 3 The deques grow beyond their initial capacity as needed.
+        //:
+        //: 4 'numStolenJobs' does not decrease, and is 0 for a pool having a
+        //:   single thread.
+        //
+        // Plan:
+        //: 1 For pools having various numbers of threads, enqueue a job that
+        //:   recursively enqueues a binary tree of jobs, call 'drain', and
+        //:   verify the number of leaves of the tree.  (C-1..4)
+        //
+        // Testing:
+        //   RECURSIVE JOBS
+        //   bsls::Types::Int64 numStolenJobs() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "RECURSIVE JOBS" << endl
+                          << "==============" << endl;
+
+        const int DEPTH = 14;
+
+        for (int numThreads = 1; numThreads <= 8; numThreads *= 2) {
+            bslma::TestAllocator ta("pool", veryVeryVeryVerbose);
+
+            Obj mX(numThreads, &ta);  const Obj& X = mX;
+            ASSERT(0 == mX.start());
+
+            Int64 numStolen = 0;
+            for (int iteration = 0; iteration < 4; ++iteration) {
+                bsls::AtomicInt64 numLeaves(0);
+
+                ASSERT(0 == mX.enqueueJob(bdlf::BindUtil::bind(&countLeaves,
+                                                               &mX,
+                                                               DEPTH,
+                                                               &numLeaves)));
+                mX.drain();
+
+                ASSERTV(numThreads, numLeaves, (1 << DEPTH) == numLeaves);
+                ASSERTV(numThreads, 0 == X.numPendingJobs());
+                ASSERTV(numThreads, numStolen <= X.numStolenJobs());
+                numStolen = X.numStolenJobs();
+            }
+
+            if (veryVerbose) { T_ P_(numThreads) P(X.numStolenJobs()) }
+
+            if (1 == numThreads) {
+                ASSERT(0 == X.numStolenJobs());
+            }
+
+            mX.stop();
+        }
+      } break;
+      case 5: {
+        // --------------------------------------------------------------------
+        // ENQUEUING AND DRAINING
+        //
+        // Concerns:
+        //: 1 Jobs enqueued by threads not in the pool, as functors or as
+        //:   function/pointer pairs, are executed.
+        //:
+        //: 2 A job enqueued by a job executing in the pool is placed on the
+        //:   deque of the calling thread.
+        //:
+        //: 3 'drain' blocks until the pending jobs have completed.
+        //:
+        //: 4 While 'stop' drains the pool, jobs executing in the pool can
+        //:   enqueue jobs, and other threads cannot.
+        //:
+        //: 5 'numPendingJobs' reflects the jobs not yet started.
+        //
+        // Plan:
+        //: 1 Enqueue jobs from the main thread using each overload, call
+        //:   'drain', and verify that each job was executed.  (C-1, 3)
+        //:
+        //: 2 In a pool having a single thread, enqueue a job blocked on a
+        //:   semaphore followed by other jobs, and verify 'numPendingJobs'.
+        //:   (C-5)
+        //:
+        //: 3 Enqueue a job that enqueues jobs and verifies that each of them
+        //:   is added to its deque.  (C-2)
+        //:
+        //: 4 Call 'stop' from a separate thread while a job, blocked on a
+        //:   semaphore, is executing; verify that enqueuing from the main
+        //:   thread eventually fails, then release the blocked job, which
+        //:   enqueues a job, and verify that this job is executed.  (C-4)
+        //
+        // Testing:
+        //   void drain();
+        //   int enqueueJob(const Job& functor);
+        //   int enqueueJob(bslmf::MovableRef<Job> functor);
+        //   int enqueueJob(WorkStealingThreadPoolJobFunc func, void *data);
+        //   int numPendingJobs() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "ENQUEUING AND DRAINING" << endl
+                          << "======================" << endl;
+
+        bslma::TestAllocator ta("pool", veryVeryVeryVerbose);
+
+        if (verbose) cout << "\tEnqueuing from outside the pool." << endl;
+
+        for (int numThreads = 1; numThreads <= 4; ++numThreads) {
+            Obj mX(numThreads, &ta);  const Obj& X = mX;
+            ASSERT(0 == mX.start());
+
+            bsls::AtomicInt counter(0);
+
+            for (int i = 0; i < 1000; ++i) {
+                const Job JOB = bdlf::BindUtil::bind(&increment, &counter);
+                ASSERT(0 == mX.enqueueJob(JOB));
+
+                Job job(bdlf::BindUtil::bind(&increment, &counter));
+                ASSERT(0 == mX.enqueueJob(bslmf::MovableRefUtil::move(job)));
+
+                ASSERT(0 == mX.enqueueJob(&incrementCallback, &counter));
+            }
+            mX.drain();
+
+            ASSERTV(numThreads, counter, 3000 == counter);
+            ASSERTV(numThreads, 0 == X.numPendingJobs());
+        }
+
+        if (verbose) cout << "\tTesting 'numPendingJobs'." << endl;
+        {
+            Obj mX(1, &ta);  const Obj& X = mX;
+            ASSERT(0 == mX.start());
+
+            bslmt::Semaphore gate;
+            bsls::AtomicInt  counter(0);
+
+            ASSERT(0 == mX.enqueueJob(bdlf::BindUtil::bind(&waitAndIncrement,
+                                                           &gate,
+                                                           &counter)));
+            while (0 != X.numPendingJobs()) {
+                bslmt::ThreadUtil::yield();
+            }
+            for (int i = 1; i <= 10; ++i) {
+                ASSERT(0 == mX.enqueueJob(bdlf::BindUtil::bind(&increment,
+                                                               &counter)));
+                ASSERTV(i, X.numPendingJobs(), i == X.numPendingJobs());
+            }
+            gate.post();
+            mX.drain();
+
+            ASSERT(11 == counter);
+            ASSERT(0  == X.numPendingJobs());
+        }
+
+        if (verbose) cout << "\tEnqueuing from inside the pool." << endl;
+
+        for (int numThreads = 1; numThreads <= 4; ++numThreads) {
+            Obj mX(numThreads, &ta);
+            ASSERT(0 == mX.start());
+
+            bsls::AtomicInt counter(0);
+            bsls::AtomicInt numFailures(0);
+
+            ASSERT(0 == mX.enqueueJob(bdlf::BindUtil::bind(&enqueueLocally,
+                                                           &mX,
+                                                           500,
+                                                           &counter,
+                                                           &numFailures)));
+            mX.drain();
+
+            ASSERTV(numThreads, counter,     500 == counter);
+            ASSERTV(numThreads, numFailures, 0   == numFailures);
+        }
+
+        if (verbose) cout << "\tEnqueuing while stopping." << endl;
+        {
+            Obj mX(2, &ta);  const Obj& X = mX;
+            ASSERT(0 == mX.start());
+
+            bslmt::Semaphore started;
+            bslmt::Semaphore gate;
+            bsls::AtomicInt  counter(0);
+            bsls::AtomicInt  numFailures(0);
+
+            ASSERT(0 == mX.enqueueJob(bdlf::BindUtil::bind(
+                                                        &enqueueWhileStopping,
+                                                        &mX,
+                                                        &started,
+                                                        &gate,
+                                                        &counter,
+                                                        &numFailures)));
+            started.wait();
+
+            bslmt::ThreadGroup stopper(&ta);
+            ASSERT(0 == stopper.addThread(bdlf::BindUtil::bind(&Obj::stop,
+                                                               &mX)));
+
+            // Wait until 'stop' rejects jobs from threads not in the pool.
+
+            bsls::AtomicInt ignored(0);
+            while (0 == mX.enqueueJob(bdlf::BindUtil::bind(&increment,
+                                                           &ignored))) {
+                bslmt::ThreadUtil::yield();
+            }
+            ASSERT(X.isStarted());
+
+            gate.post();
+            stopper.joinAll();
+
+            ASSERT(!X.isStarted());
+            ASSERT(1 == counter);
+            ASSERT(0 == numFailures);
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+      } break;
+      case 4: {
+        // --------------------------------------------------------------------
+        // CREATORS, START, STOP, AND SHUTDOWN
+        //
+        // Concerns:
+        //: 1 A pool is created stopped, with the specified number of threads,
+        //:   and enqueuing on a pool that is not started fails.
+        //:
+        //: 2 'start' starts the pool, and has no effect on a started pool.
+        //:
+        //: 3 'stop' executes the pending jobs, and 'shutdown' destroys them
+        //:   without executing them; both have no effect on a stopped pool.
+        //:
+        //: 4 A stopped pool can be restarted.
+        //:
+        //: 5 Memory is supplied by the specified allocator, and released on
+        //:   destruction, including the memory of pending jobs.
+        //:
+        //: 6 QoI: Asserted precondition violations are detected when enabled.
+        //
+        // Plan:
+        //: 1 Create pools using each constructor, and exercise the life cycle
+        //:   methods, verifying 'isStarted' and the execution of jobs.
+        //:   (C-1..5)
+        //:
+        //: 2 Call 'shutdown' from a separate thread while a job, blocked on a
+        //:   semaphore, is executing, and verify that the pending jobs are
+        //:   destroyed without being executed.  (C-3)
+        //:
+        //: 3 Verify that, in appropriate build modes, defensive checks are
+        //:   triggered for invalid arguments.  (C-6)
+        //
+        // Testing:
+        //   WorkStealingThreadPool(numThreads, basicAllocator);
+        //   WorkStealingThreadPool(attributes, numThreads, basicAllocator);
+        //   ~WorkStealingThreadPool();
+        //   void shutdown();
+        //   int start();
+        //   void stop();
+        //   bool isStarted() const;
+        //   int numThreads() const;
+        //   bslma::Allocator *allocator() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "CREATORS, START, STOP, AND SHUTDOWN" << endl
+                          << "===================================" << endl;
+
+        bslma::TestAllocator ta("pool", veryVeryVeryVerbose);
+
+        for (int ci = 0; ci < 2; ++ci) {
+            for (int numThreads = 1; numThreads <= 4; ++numThreads) {
+                if (veryVerbose) { T_ P_(ci) P(numThreads) }
+
+                bslmt::ThreadAttributes attributes(&ta);
+                attributes.setStackSize(1024 * 1024);
+
+                Obj *objPtr = ci
+                            ? new (ta) Obj(attributes, numThreads, &ta)
+                            : new (ta) Obj(numThreads, &ta);
+                Obj& mX = *objPtr;  const Obj& X = mX;
+
+                ASSERT(numThreads == X.numThreads());
+                ASSERT(&ta        == X.allocator());
+                ASSERT(!X.isStarted());
+                ASSERT(0          == X.numPendingJobs());
+                ASSERT(0          == X.numStolenJobs());
+
+                bsls::AtomicInt counter(0);
+                ASSERT(0 != mX.enqueueJob(bdlf::BindUtil::bind(&increment,
+                                                               &counter)));
+
+                mX.drain();
+                mX.stop();
+                mX.shutdown();
+                ASSERT(!X.isStarted());
+
+                for (int iteration = 0; iteration < 3; ++iteration) {
+                    ASSERT(0 == mX.start());
+                    ASSERT(X.isStarted());
+                    ASSERT(0 == mX.start());
+                    ASSERT(X.isStarted());
+
+                    for (int i = 0; i < 100; ++i) {
+                        ASSERT(0 == mX.enqueueJob(bdlf::BindUtil::bind(
+                                                                  &increment,
+                                                                  &counter)));
+                    }
+                    if (iteration % 2) {
+                        mX.stop();
+                    }
+                    else {
+                        mX.drain();
+                        mX.shutdown();
+                    }
+                    ASSERT(!X.isStarted());
+                    ASSERTV(counter, 100 * (iteration + 1) == counter);
+                    ASSERT(0 != mX.enqueueJob(bdlf::BindUtil::bind(
+                                                                  &increment,
+                                                                  &counter)));
+                }
+
+                ASSERT(0 == mX.start());
+                ta.deleteObject(objPtr);
+            }
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+
+        if (verbose) cout << "\tShutting down with pending jobs." << endl;
+        {
+            Obj mX(1, &ta);  const Obj& X = mX;
+            ASSERT(0 == mX.start());
+
+            bslmt::Semaphore     gate;
+            bsls::AtomicInt      counter(0);
+            bsl::shared_ptr<int> token;
+            token.createInplace(&ta, 0);
+
+            ASSERT(0 == mX.enqueueJob(bdlf::BindUtil::bind(&waitAndIncrement,
+                                                           &gate,
+                                                           &counter)));
+            while (0 != X.numPendingJobs()) {
+                bslmt::ThreadUtil::yield();
+            }
+            for (int i = 0; i < 10; ++i) {
+                ASSERT(0 == mX.enqueueJob(bdlf::BindUtil::bind(
+                                                           &holdAndIncrement,
+                                                           token,
+                                                           &counter)));
+            }
+            ASSERT(11 == token.use_count());
+
+            bslmt::ThreadGroup shutter(&ta);
+            ASSERT(0 == shutter.addThread(bdlf::BindUtil::bind(&Obj::shutdown,
+                                                               &mX)));
+            while (X.isStarted()) {
+                bslmt::ThreadUtil::yield();
+            }
+            gate.post();
+            shutter.joinAll();
+
+            ASSERT(1 == counter);
+            ASSERT(1 == token.use_count());
+            ASSERT(0 == X.numPendingJobs());
+        }
+
+        if (verbose) cout << "\tNegative Testing." << endl;
+        {
+            bsls::AssertTestHandlerGuard hG;
+
+            ASSERT_OPT_PASS(Obj(1, &ta));
+            ASSERT_OPT_FAIL(Obj(0, &ta));
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+      } break;
+      case 3: {
+        // --------------------------------------------------------------------
+        // CONCURRENT STEALING
+        //
+        // Concerns:
+        //: 1 When the owner of a deque pushes and pops jobs while other
+        //:   threads steal jobs, each job is removed exactly once, including
+        //:   while the deque grows and when the owner and a thief race for the
+        //:   last job.
+        //
+        // Plan:
+        //: 1 Create a deque and an array of jobs.  The owner thread pushes
+        //:   the jobs in bursts of random length, popping a few jobs after
+        //:   each burst, while several thieves steal jobs.  Count the number
+        //:   of times each job is removed, and verify that each count is 1.
+        //:   (C-1)
+        //
+        // Testing:
+        //   CONCURRENT STEALING
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "CONCURRENT STEALING" << endl
+                          << "===================" << endl;
+
+        const int NUM_JOBS    = 200000;
+        const int NUM_THIEVES = 4;
+
+        bslma::TestAllocator ta("deque", veryVeryVeryVerbose);
+        {
+            static bsls::AtomicInt numTaken[NUM_JOBS];
+
+            bsl::vector<Job> jobs(&ta);
+            jobs.resize(NUM_JOBS);
+
+            Deque             mX(&ta);
+            bsls::AtomicInt   done(0);
+            bsls::AtomicInt64 numStolen(0);
+            bslmt::Barrier    barrier(NUM_THIEVES + 1);
+
+            bslmt::ThreadGroup thieves(&ta);
+            thieves.addThreads(bdlf::BindUtil::bind(&stealJobs,
+                                                    &mX,
+                                                    jobs.data(),
+                                                    &numTaken[0],
+                                                    &done,
+                                                    &barrier,
+                                                    &numStolen),
+                               NUM_THIEVES);
+            barrier.wait();
+
+            unsigned int random = 12345;
+            int          next   = 0;
+            Int64        popped = 0;
+            while (next < NUM_JOBS) {
+                random = random * 1103515245 + 12345;
+                const int burst = static_cast<int>((random >> 16) % 1024);
+
+                for (int i = 0; i < burst && next < NUM_JOBS; ++i, ++next) {
+                    mX.pushBottom(&jobs[next]);
+                }
+                for (int i = 0; i < 3; ++i) {
+                    Job *job = mX.popBottom();
+                    if (job) {
+                        ++numTaken[job - jobs.data()];
+                        ++popped;
+                    }
+                }
+            }
+            while (Job *job = mX.popBottom()) {
+                ++numTaken[job - jobs.data()];
+                ++popped;
+            }
+            done = 1;
+            thieves.joinAll();
+
+            if (veryVerbose) { T_ P_(popped) P(numStolen) }
+
+            ASSERTV(popped, numStolen, NUM_JOBS == popped + numStolen);
+            for (int i = 0; i < NUM_JOBS; ++i) {
+                ASSERTV(i, numTaken[i], 1 == numTaken[i]);
+            }
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+      } break;
+      case 2: {
+        // --------------------------------------------------------------------
+        // TESTING 'WorkStealingThreadPool_Deque'
+        //
+        // Concerns:
+        //: 1 'popBottom' removes the most recently pushed job, and 'steal'
+        //:   removes the least recently pushed job.
+        //:
+        //: 2 Both return 0 on an empty deque.
+        //:
+        //: 3 The deque grows beyond its initial capacity, preserving its jobs.
+        //:
+        //: 4 'isEmpty' and 'length' reflect the jobs in the deque.
+        //:
+        //: 5 Memory is supplied by the specified allocator, and released on
+        //:   destruction.
+        //
+        // Plan:
+        //: 1 From a single thread, push numbers of jobs up to several times
+        //:   the initial capacity, remove them alternately from the bottom and
+        //:   the top, and verify the order of removal.  (C-1..5)
+        //
+        // Testing:
+        //   WorkStealingThreadPool_Deque(basicAllocator);
+        //   ~WorkStealingThreadPool_Deque();
+        //   Job *popBottom();
+        //   void pushBottom(Job *job);
+        //   Job *steal();
+        //   bool isEmpty() const;
+        //   bsls::Types::Int64 length() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "TESTING 'WorkStealingThreadPool_Deque'" << endl
+                          << "======================================" << endl;
+
+        bslma::TestAllocator ta("deque", veryVeryVeryVerbose);
+
+        static const int DATA[] = { 0, 1, 2, 3, 255, 256, 257, 1000, 5000 };
+        const int NUM_DATA = static_cast<int>(sizeof DATA / sizeof *DATA);
+
+        Job jobs[5000];
+
+        for (int ti = 0; ti < NUM_DATA; ++ti) {
+            const int N = DATA[ti];
+
+            if (veryVerbose) { T_ P(N) }
+
+            {
+                Deque mX(&ta);  const Deque& X = mX;
+
+                ASSERTV(N, 0 < ta.numBlocksInUse());
+                ASSERTV(N, X.isEmpty());
+                ASSERTV(N, 0 == X.length());
+                ASSERTV(N, 0 == mX.popBottom());
+                ASSERTV(N, 0 == mX.steal());
+
+                // Push and remove the jobs twice, so that the indices of the
+                // second round do not start at 0.
+
+                for (int round = 0; round < 2; ++round) {
+                    for (int i = 0; i < N; ++i) {
+                        mX.pushBottom(&jobs[i]);
+                        ASSERTV(N, i, i + 1 == X.length());
+                    }
+                    ASSERTV(N, (0 == N) == X.isEmpty());
+
+                    int low  = 0;
+                    int high = N - 1;
+                    for (int i = 0; i < N; ++i) {
+                        if (i % 2) {
+                            ASSERTV(N, i, &jobs[low] == mX.steal());
+                            ++low;
+                        }
+                        else {
+                            ASSERTV(N, i, &jobs[high] == mX.popBottom());
+                            --high;
+                        }
+                        ASSERTV(N, i, N - i - 1 == X.length());
+                    }
+                    ASSERTV(N, X.isEmpty());
+                    ASSERTV(N, 0 == mX.popBottom());
+                    ASSERTV(N, 0 == mX.steal());
+                }
+            }
+            ASSERTV(N, 0 == ta.numBlocksInUse());
+        }
+      } break;
+      case 1: {
+        // --------------------------------------------------------------------
+        // BREATHING TEST
+        //   This case exercises (but does not fully test) basic functionality.
+        //
+        // Concerns:
+        //: 1 The class is sufficiently functional to enable comprehensive
+        //:   testing in subsequent test cases.
+        //
+        // Plan:
+        //: 1 Start a pool, enqueue jobs, drain, and stop the pool.  (C-1)
+        //
+        // Testing:
+        //   BREATHING TEST
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "BREATHING TEST" << endl
+                          << "==============" << endl;
+
+        bslma::TestAllocator ta("breathing", veryVeryVeryVerbose);
+        {
+            Obj mX(4, &ta);  const Obj& X = mX;
+
+            ASSERT(4 == X.numThreads());
+            ASSERT(!X.isStarted());
+            ASSERT(0 == mX.start());
+            ASSERT(X.isStarted());
+
+            bsls::AtomicInt counter(0);
+            for (int i = 0; i < 100; ++i) {
+                ASSERT(0 == mX.enqueueJob(bdlf::BindUtil::bind(&increment,
+                                                               &counter)));
+            }
+            mX.drain();
+            ASSERT(100 == counter);
+
+            mX.stop();
+            ASSERT(!X.isStarted());
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+      } break;
+      case -1: {
+        // --------------------------------------------------------------------
+        // THROUGHPUT BENCHMARK
+        //   Compare the time taken to execute a large number of trivial jobs
+        //   using 'bdlmt::FixedThreadPool', 'bdlmt::ThreadPool', and
+        //   'bdlmt::WorkStealingThreadPool'.  Command line parameters:
+        //   2nd parameter: number of threads (default 4).
+        //   3rd parameter: number of jobs (default 1000000).
+        //
+        // Concerns:
+        //: 1 Jobs enqueued by jobs executing in a work-stealing pool are
+        //:   executed at a higher rate than jobs taken from a shared queue.
+        //
+        // Plan:
+        //: 1 For each pool, enqueue one job per thread, each enqueuing an
+        //:   equal share of the trivial jobs, call 'drain', and print the
+        //:   number of jobs executed per second.  For the work-stealing pool,
+        //:   also measure the jobs enqueued directly from the main thread.
+        //
+        // Testing:
+        //   THROUGHPUT BENCHMARK
+        // --------------------------------------------------------------------
+
+        cout << endl
+             << "THROUGHPUT BENCHMARK" << endl
+             << "====================" << endl;
+
+        const int NUM_THREADS = argc > 2 ? bsl::atoi(argv[2]) : 4;
+        const int NUM_JOBS    = argc > 3 ? bsl::atoi(argv[3]) : 1000000;
+        const int PER_THREAD  = NUM_JOBS / NUM_THREADS;
+
+        bslma::Allocator *alloc = bslma::Default::globalAllocator();
+
+        cout << "threads: " << NUM_THREADS << ", jobs: " << NUM_JOBS << endl;
+        {
+            // The queue must hold all the jobs, as the threads enqueuing them
+            // would otherwise block with no thread left to execute them.
+
+            bdlmt::FixedThreadPool pool(NUM_THREADS, NUM_JOBS, alloc);
+            pool.start();
+
+            bsls::AtomicInt64 counter(0);
+            const Int64 start = bsls::TimeUtil::getTimer();
+            for (int t = 0; t < NUM_THREADS; ++t) {
+                pool.enqueueJob(bdlf::BindUtil::bind(
+                                   &spawnBenchmarkJobs<bdlmt::FixedThreadPool>,
+                                    &pool,
+                                    PER_THREAD,
+                                    &counter));
+            }
+            while (counter < Int64(PER_THREAD) * NUM_THREADS) {
+                bslmt::ThreadUtil::yield();
+            }
+            const Int64 elapsed = bsls::TimeUtil::getTimer() - start;
+            cout << "FixedThreadPool:        "
+                 << 1e9 * double(counter) / double(elapsed) << " jobs/s"
+                 << endl;
+            pool.stop();
+        }
+        {
+            bdlmt::ThreadPool pool(bslmt::ThreadAttributes(),
+                                   NUM_THREADS,
+                                   NUM_THREADS,
+                                   1000,
+                                   alloc);
+            pool.start();
+
+            bsls::AtomicInt64 counter(0);
+            const Int64 start = bsls::TimeUtil::getTimer();
+            for (int t = 0; t < NUM_THREADS; ++t) {
+                pool.enqueueJob(bdlf::BindUtil::bind(
+                                        &spawnBenchmarkJobs<bdlmt::ThreadPool>,
+                                         &pool,
+                                         PER_THREAD,
+                                         &counter));
+            }
+            while (counter < Int64(PER_THREAD) * NUM_THREADS) {
+                bslmt::ThreadUtil::yield();
+            }
+            const Int64 elapsed = bsls::TimeUtil::getTimer() - start;
+            cout << "ThreadPool:             "
+                 << 1e9 * double(counter) / double(elapsed) << " jobs/s"
+                 << endl;
+            pool.stop();
+        }
+        {
+            Obj pool(NUM_THREADS, alloc);
+            pool.start();
+
+            bsls::AtomicInt64 counter(0);
+            Int64 start = bsls::TimeUtil::getTimer();
+            for (int t = 0; t < NUM_THREADS; ++t) {
+                pool.enqueueJob(bdlf::BindUtil::bind(&spawnBenchmarkJobs<Obj>,
+                                                     &pool,
+                                                     PER_THREAD,
+                                                     &counter));
+            }
+            pool.drain();
+            Int64 elapsed = bsls::TimeUtil::getTimer() - start;
+            cout << "WorkStealingThreadPool: "
+                 << 1e9 * double(counter) / double(elapsed) << " jobs/s"
+                 << " (stolen: " << pool.numStolenJobs() << ")" << endl;
+
+            counter = 0;
+            start = bsls::TimeUtil::getTimer();
+            spawnBenchmarkJobs(&pool, PER_THREAD * NUM_THREADS, &counter);
+            pool.drain();
+            elapsed = bsls::TimeUtil::getTimer() - start;
+            cout << "WorkStealingThreadPool (external enqueue): "
+                 << 1e9 * double(counter) / double(elapsed) << " jobs/s"
+                 << endl;
+            pool.stop();
+        }
+      } break;
+      default: {
+        cout << "WARNING: CASE `" << test << "' NOT FOUND." << endl;
+        testStatus = -1;
+      }
+    }
+
+    // CONCERN: In no case does memory come from the default allocator.
+
+    if (test > 0) {
+        ASSERTV(dam.isTotalSame());
+    }
+
+    if (testStatus > 0) {
+        cout << "Error, non-zero test status = " << testStatus << "." << endl;
+    }
+    return testStatus;
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2020 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,1045 @@
+// bslalg_numericformatterutil.cpp                                    -*-C++-*-
+#include <bslalg_numericformatterutil.h>
+
+#include <bsls_ident.h>
+BSLS_IDENT_RCSID(bslalg_numericformatterutil_cpp,"$Id$ $CSID$")
+
+#include <bsls_assert.h>
+#include <bsls_types.h>
+
+#include <stdio.h>   // 'snprintf'
+#include <stdlib.h>  // 'strtod', 'strtof'
+#include <string.h>  // 'memcpy'
+
+// IMPLEMENTATION NOTES: The digit generation follows the Grisu3 algorithm
+// described in "Printing Floating-Point Numbers Quickly and Accurately with
+// Integers" (Florian Loitsch, PLDI 2010).  A finite, positive value 'v' is
+// represented as a "do-it-yourself floating point" ('DiyFp') number 'f * 2^e'
+// with a 64-bit significand, and so are the boundaries 'm-' and 'm+' of its
+// rounding interval (the points halfway to its neighbors).  All three are
+// multiplied by a cached power of ten, '10^k', chosen so that the binary
+// exponent of the products lies in '[-60 .. -32]'; the integral part of the
+// scaled upper boundary then fits in 32 bits, and its fractional part in the
+// remaining bits of a 64-bit word.  Digits are generated from the scaled upper
+// boundary until the remainder falls within the (scaled) rounding interval,
+// at which point the last digit is adjusted ("weeded") towards the scaled
+// value.
+//
+// The multiplications are inexact by up to one unit in the last place, so the
+// algorithm tracks the uncertainty ('unit') and, when it cannot prove that
+// the generated digits are both the shortest and the closest possible, it
+// reports failure.  For those inputs the digits are found by an exact search:
+// for increasing precisions 'p', the correctly rounded 'p'-digit
+// representation produced by 'snprintf' (and its successor, for values at the
+// lower end of a binade, whose lower neighbor is closer than the upper) is
+// tested by parsing it back with 'strtod' (or 'strtof').  The strings given
+// to the parsing functions contain no decimal point, and the decimal point
+// produced by 'snprintf' is skipped, so the search does not depend on the
+// current C locale.
+
+namespace BloombergLP {
+
+namespace {
+
+typedef bsls::Types::Uint64 Uint64;
+
+                              // ===========
+                              // struct DiyFp
+                              // ===========
+
+struct DiyFp {
+    // This 'struct' represents the number 'd_f * 2^d_e'.
+
+    // DATA
+    Uint64 d_f;  // significand
+    int    d_e;  // binary exponent
+};
+
+inline
+DiyFp makeDiyFp(Uint64 f, int e)
+    // Return the 'DiyFp' having the specified significand 'f' and the
+    // specified exponent 'e'.
+{
+    DiyFp result;
+    result.d_f = f;
+    result.d_e = e;
+    return result;
+}
+
+inline
+DiyFp multiply(const DiyFp& lhs, const DiyFp& rhs)
+    // Return the product of the specified 'lhs' and 'rhs', rounded to the
+    // upper 64 bits of the exact 128-bit product of their significands.
+{
+    const Uint64 k_MASK32 = 0xffffffffULL;
+
+    const Uint64 a = lhs.d_f >> 32;
+    const Uint64 b = lhs.d_f & k_MASK32;
+    const Uint64 c = rhs.d_f >> 32;
+    const Uint64 d = rhs.d_f & k_MASK32;
+
+    const Uint64 ac = a * c;
+    const Uint64 bc = b * c;
+    const Uint64 ad = a * d;
+    const Uint64 bd = b * d;
+
+    Uint64 tmp = (bd >> 32) + (ad & k_MASK32) + (bc & k_MASK32);
+    tmp += 1U << 31;                                                  // round
+
+    return makeDiyFp(ac + (ad >> 32) + (bc >> 32) + (tmp >> 32),
+                     lhs.d_e + rhs.d_e + 64);
+}
+
+inline
+DiyFp normalize(DiyFp value)
+    // Return the specified 'value' shifted so that the most significant bit
+    // of its significand is set.  The behavior is undefined unless
+    // '0 != value.d_f'.
+{
+    while (0 == (value.d_f & 0xffc0000000000000ULL)) {
+        value.d_f <<= 10;
+        value.d_e  -= 10;
+    }
+    while (0 == (value.d_f & 0x8000000000000000ULL)) {
+        value.d_f <<= 1;
+        value.d_e  -= 1;
+    }
+    return value;
+}
+
+                            // ==================
+                            // struct CachedPower
+                            // ==================
+
+struct CachedPower {
+    // This 'struct' holds a normalized 'DiyFp' approximation, rounded to
+    // nearest, of the power of ten '10^d_decimalExponent'.
+
+    // DATA
+    Uint64 d_significand;
+    short  d_binaryExponent;
+    short  d_decimalExponent;
+};
+
+const CachedPower k_CACHED_POWERS[] = {
+    // The powers of ten '10^k' for 'k' in '[-348, 340]' in steps of 8.
+
+    { 0xfa8fd5a0081c0288ULL, -1220, -348 },
+    { 0xbaaee17fa23ebf76ULL, -1193, -340 },
+    { 0x8b16fb203055ac76ULL, -1166, -332 },
+    { 0xcf42894a5dce35eaULL, -1140, -324 },
+    { 0x9a6bb0aa55653b2dULL, -1113, -316 },
+    { 0xe61acf033d1a45dfULL, -1087, -308 },
+    { 0xab70fe17c79ac6caULL, -1060, -300 },
+    { 0xff77b1fcbebcdc4fULL, -1034, -292 },
+    { 0xbe5691ef416bd60cULL, -1007, -284 },
+    { 0x8dd01fad907ffc3cULL,  -980, -276 },
+    { 0xd3515c2831559a83ULL,  -954, -268 },
+    { 0x9d71ac8fada6c9b5ULL,  -927, -260 },
+    { 0xea9c227723ee8bcbULL,  -901, -252 },
+    { 0xaecc49914078536dULL,  -874, -244 },
+    { 0x823c12795db6ce57ULL,  -847, -236 },
+    { 0xc21094364dfb5637ULL,  -821, -228 },
+    { 0x9096ea6f3848984fULL,  -794, -220 },
+    { 0xd77485cb25823ac7ULL,  -768, -212 },
+    { 0xa086cfcd97bf97f4ULL,  -741, -204 },
+    { 0xef340a98172aace5ULL,  -715, -196 },
+    { 0xb23867fb2a35b28eULL,  -688, -188 },
+    { 0x84c8d4dfd2c63f3bULL,  -661, -180 },
+    { 0xc5dd44271ad3cdbaULL,  -635, -172 },
+    { 0x936b9fcebb25c996ULL,  -608, -164 },
+    { 0xdbac6c247d62a584ULL,  -582, -156 },
+    { 0xa3ab66580d5fdaf6ULL,  -555, -148 },
+    { 0xf3e2f893dec3f126ULL,  -529, -140 },
+    { 0xb5b5ada8aaff80b8ULL,  -502, -132 },
+    { 0x87625f056c7c4a8bULL,  -475, -124 },
+    { 0xc9bcff6034c13053ULL,  -449, -116 },
+    { 0x964e858c91ba2655ULL,  -422, -108 },
+    { 0xdff9772470297ebdULL,  -396, -100 },
+    { 0xa6dfbd9fb8e5b88fULL,  -369,  -92 },
+    { 0xf8a95fcf88747d94ULL,  -343,  -84 },
+    { 0xb94470938fa89bcfULL,  -316,  -76 },
+    { 0x8a08f0f8bf0f156bULL,  -289,  -68 },
+    { 0xcdb02555653131b6ULL,  -263,  -60 },
+    { 0x993fe2c6d07b7facULL,  -236,  -52 },
+    { 0xe45c10c42a2b3b06ULL,  -210,  -44 },
+    { 0xaa242499697392d3ULL,  -183,  -36 },
+    { 0xfd87b5f28300ca0eULL,  -157,  -28 },
+    { 0xbce5086492111aebULL,  -130,  -20 },
+    { 0x8cbccc096f5088ccULL,  -103,  -12 },
+    { 0xd1b71758e219652cULL,   -77,   -4 },
+    { 0x9c40000000000000ULL,   -50,    4 },
+    { 0xe8d4a51000000000ULL,   -24,   12 },
+    { 0xad78ebc5ac620000ULL,     3,   20 },
+    { 0x813f3978f8940984ULL,    30,   28 },
+    { 0xc097ce7bc90715b3ULL,    56,   36 },
+    { 0x8f7e32ce7bea5c70ULL,    83,   44 },
+    { 0xd5d238a4abe98068ULL,   109,   52 },
+    { 0x9f4f2726179a2245ULL,   136,   60 },
+    { 0xed63a231d4c4fb27ULL,   162,   68 },
+    { 0xb0de65388cc8ada8ULL,   189,   76 },
+    { 0x83c7088e1aab65dbULL,   216,   84 },
+    { 0xc45d1df942711d9aULL,   242,   92 },
+    { 0x924d692ca61be758ULL,   269,  100 },
+    { 0xda01ee641a708deaULL,   295,  108 },
+    { 0xa26da3999aef774aULL,   322,  116 },
+    { 0xf209787bb47d6b85ULL,   348,  124 },
+    { 0xb454e4a179dd1877ULL,   375,  132 },
+    { 0x865b86925b9bc5c2ULL,   402,  140 },
+    { 0xc83553c5c8965d3dULL,   428,  148 },
+    { 0x952ab45cfa97a0b3ULL,   455,  156 },
+    { 0xde469fbd99a05fe3ULL,   481,  164 },
+    { 0xa59bc234db398c25ULL,   508,  172 },
+    { 0xf6c69a72a3989f5cULL,   534,  180 },
+    { 0xb7dcbf5354e9beceULL,   561,  188 },
+    { 0x88fcf317f22241e2ULL,   588,  196 },
+    { 0xcc20ce9bd35c78a5ULL,   614,  204 },
+    { 0x98165af37b2153dfULL,   641,  212 },
+    { 0xe2a0b5dc971f303aULL,   667,  220 },
+    { 0xa8d9d1535ce3b396ULL,   694,  228 },
+    { 0xfb9b7cd9a4a7443cULL,   720,  236 },
+    { 0xbb764c4ca7a44410ULL,   747,  244 },
+    { 0x8bab8eefb6409c1aULL,   774,  252 },
+    { 0xd01fef10a657842cULL,   800,  260 },
+    { 0x9b10a4e5e9913129ULL,   827,  268 },
+    { 0xe7109bfba19c0c9dULL,   853,  276 },
+    { 0xac2820d9623bf429ULL,   880,  284 },
+    { 0x80444b5e7aa7cf85ULL,   907,  292 },
+    { 0xbf21e44003acdd2dULL,   933,  300 },
+    { 0x8e679c2f5e44ff8fULL,   960,  308 },
+    { 0xd433179d9c8cb841ULL,   986,  316 },
+    { 0x9e19db92b4e31ba9ULL,  1013,  324 },
+    { 0xeb96bf6ebadf77d9ULL,  1039,  332 },
+    { 0xaf87023b9bf0ee6bULL,  1066,  340 }
+};
+
+const int k_CACHED_POWERS_OFFSET      = 348;  // '-k_CACHED_POWERS[0]' decimal
+                                              // exponent
+
+const int k_DECIMAL_EXPONENT_DISTANCE = 8;    // distance between consecutive
+                                              // cached powers
+
+const int k_MIN_TARGET_EXPONENT       = -60;  // range of the binary exponent
+const int k_MAX_TARGET_EXPONENT       = -32;  // of a scaled value
+
+const double k_ONE_OVER_LOG2_10       = 0.30102999566398114;  // 1 / lg(10)
+
+void getCachedPower(DiyFp *power, int *decimalExponent, int binaryExponent)
+    // Load into the specified 'power' a cached power of ten, '10^k', such
+    // that multiplying a normalized 'DiyFp' having the specified
+    // 'binaryExponent' by 'power' yields a binary exponent in
+    // '[k_MIN_TARGET_EXPONENT .. k_MAX_TARGET_EXPONENT]', and load 'k' into
+    // the specified 'decimalExponent'.
+{
+    const int    minExponent = k_MIN_TARGET_EXPONENT - (binaryExponent + 64);
+    const double estimate    = (minExponent + 63) * k_ONE_OVER_LOG2_10;
+
+    int k = static_cast<int>(estimate);
+    if (k < estimate) {
+        ++k;                                                          // ceil
+    }
+
+    const int index = (k_CACHED_POWERS_OFFSET + k - 1)
+                                              / k_DECIMAL_EXPONENT_DISTANCE
+                    + 1;
+
+    const CachedPower& cached = k_CACHED_POWERS[index];
+
+    BSLS_ASSERT_SAFE(minExponent <= cached.d_binaryExponent);
+    BSLS_ASSERT_SAFE(cached.d_binaryExponent <=
+                         k_MAX_TARGET_EXPONENT - (binaryExponent + 64));
+
+    *power           = makeDiyFp(cached.d_significand,
+                                 cached.d_binaryExponent);
+    *decimalExponent = cached.d_decimalExponent;
+}
+
+                        // ==========================
+                        // Grisu3 Digit Generation
+                        // ==========================
+
+const unsigned int k_POWERS_OF_TEN[] = {
+    1U, 10U, 100U, 1000U, 10000U, 100000U, 1000000U, 10000000U, 100000000U,
+    1000000000U
+};
+
+inline
+void biggestPowerOfTen(unsigned int *power,
+                       int          *exponentPlusOne,
+                       unsigned int  number)
+    // Load into the specified 'power' the largest power of ten that is not
+    // greater than the specified 'number', and load its exponent plus one
+    // into the specified 'exponentPlusOne'.  The behavior is undefined
+    // unless '0 < number'.
+{
+    int exponent = 9;
+    while (number < k_POWERS_OF_TEN[exponent]) {
+        --exponent;
+    }
+    *power           = k_POWERS_OF_TEN[exponent];
+    *exponentPlusOne = exponent + 1;
+}
+
+bool roundWeed(char   *buffer,
+               int     length,
+               Uint64  distanceTooHighW,
+               Uint64  unsafeInterval,
+               Uint64  rest,
+               Uint64  tenKappa,
+               Uint64  unit)
+    // Adjust the last of the specified 'length' digits in the specified
+    // 'buffer' so that the represented number is the closest, among the
+    // numbers having 'length' digits and lying in the rounding interval, to
+    // the scaled value, whose distance from the scaled (and widened) upper
+    // boundary is the specified 'distanceTooHighW'.  The specified
+    // 'unsafeInterval' is the width of the widened rounding interval, the
+    // specified 'rest' is the distance between the number currently in
+    // 'buffer' and the widened upper boundary, the specified 'tenKappa' is
+    // the weight of the last digit, and the specified 'unit' is the
+    // uncertainty of the computations, all in the same (scaled) units.
+    // Return 'true' if the result is guaranteed to be the shortest and
+    // closest representation, and 'false' otherwise.
+{
+    const Uint64 smallDistance = distanceTooHighW - unit;
+    const Uint64 bigDistance   = distanceTooHighW + unit;
+
+    // Move the digits down while the result is guaranteed to get closer to
+    // the value (even taking into account the imprecision).
+
+    while (rest < smallDistance
+        && unsafeInterval - rest >= tenKappa
+        && (rest + tenKappa < smallDistance
+         || smallDistance - rest >= rest + tenKappa - smallDistance)) {
+        --buffer[length - 1];
+        rest += tenKappa;
+    }
+
+    // If one more step down might also have gotten closer to the value, we
+    // cannot decide which representation is closest.
+
+    if (rest < bigDistance
+     && unsafeInterval - rest >= tenKappa
+     && (rest + tenKappa < bigDistance
+      || bigDistance - rest > rest + tenKappa - bigDistance)) {
+        return false;                                                 // RETURN
+    }
+
+    // The result must be safely inside the rounding interval.
+
+    return 2 * unit <= rest && rest <= unsafeInterval - 4 * unit;
+}
+
+bool digitGen(char        *buffer,
+              int         *length,
+              int         *kappa,
+              const DiyFp& low,
+              const DiyFp& w,
+              const DiyFp& high)
+    // Generate into the specified 'buffer' the shortest digits of a number
+    // lying in the rounding interval '(low, high)' and closest to the
+    // specified 'w' (all three being scaled values having the same exponent
+    // in '[k_MIN_TARGET_EXPONENT .. k_MAX_TARGET_EXPONENT]'), and load the
+    // number of digits into the specified 'length' and the decimal exponent
+    // of the last digit into the specified 'kappa'.  Return 'true' if the
+    // result is guaranteed to be correct, and 'false' otherwise.
+{
+    // The scaled values are imprecise by up to one 'unit'; widen the
+    // interval to be sure no candidate is missed, and verify the result in
+    // 'roundWeed'.
+
+    Uint64 unit = 1;
+
+    const DiyFp  tooLow         = makeDiyFp(low.d_f - unit, low.d_e);
+    const DiyFp  tooHigh        = makeDiyFp(high.d_f + unit, high.d_e);
+    Uint64       unsafeInterval = tooHigh.d_f - tooLow.d_f;
+
+    const int    shift          = -w.d_e;
+    const Uint64 one            = 1ULL << shift;
+
+    unsigned int integrals   = static_cast<unsigned int>(tooHigh.d_f >> shift);
+    Uint64       fractionals = tooHigh.d_f & (one - 1);
+
+    unsigned int divisor;
+    int          divisorExponentPlusOne;
+    biggestPowerOfTen(&divisor, &divisorExponentPlusOne, integrals);
+
+    *kappa  = divisorExponentPlusOne;
+    *length = 0;
+
+    while (*kappa > 0) {
+        const unsigned int digit = integrals / divisor;
+        buffer[(*length)++] = static_cast<char>('0' + digit);
+        integrals %= divisor;
+        --*kappa;
+
+        const Uint64 rest = (static_cast<Uint64>(integrals) << shift)
+                          + fractionals;
+        if (rest < unsafeInterval) {
+            return roundWeed(buffer,
+                             *length,
+                             tooHigh.d_f - w.d_f,
+                             unsafeInterval,
+                             rest,
+                             static_cast<Uint64>(divisor) << shift,
+                             unit);                                   // RETURN
+        }
+        divisor /= 10;
+    }
+
+    for (;;) {
+        fractionals    *= 10;
+        unit           *= 10;
+        unsafeInterval *= 10;
+
+        const int digit = static_cast<int>(fractionals >> shift);
+        buffer[(*length)++] = static_cast<char>('0' + digit);
+        fractionals &= one - 1;
+        --*kappa;
+
+        if (fractionals < unsafeInterval) {
+            return roundWeed(buffer,
+                             *length,
+                             (tooHigh.d_f - w.d_f) * unit,
+                             unsafeInterval,
+                             fractionals,
+                             one,
+                             unit);                                   // RETURN
+        }
+    }
+}
+
+bool grisu3(char   *buffer,
+            int    *length,
+            int    *exponent,
+            Uint64  significand,
+            int     binaryExponent,
+            bool    isLowerBoundaryCloser)
+    // Generate into the specified 'buffer' the shortest, closest digits of
+    // the value 'significand * 2^binaryExponent', defined by the specified
+    // 'significand' and 'binaryExponent', loading the number of digits into
+    // the specified 'length' and the decimal exponent of the last digit into
+    // the specified 'exponent'.  The specified
+    // 'isLowerBoundaryCloser' indicates whether the value is the smallest
+    // normalized value of its binade (and so the gap to its lower neighbor is
+    // half the gap to its upper neighbor).  Return 'true' on success, and
+    // 'false' if the digits could not be determined with certainty.  The
+    // behavior is undefined unless '0 < significand'.
+{
+    const DiyFp w = normalize(makeDiyFp(significand, binaryExponent));
+
+    // Compute the boundaries 'm-' and 'm+', normalized to the exponent of
+    // 'w'.
+
+    const DiyFp plus = normalize(makeDiyFp((significand << 1) + 1,
+                                           binaryExponent - 1));
+    DiyFp       minus;
+    if (isLowerBoundaryCloser) {
+        minus = makeDiyFp((significand << 2) - 1, binaryExponent - 2);
+    }
+    else {
+        minus = makeDiyFp((significand << 1) - 1, binaryExponent - 1);
+    }
+    minus.d_f <<= minus.d_e - plus.d_e;
+    minus.d_e   = plus.d_e;
+
+    BSLS_ASSERT_SAFE(plus.d_e == w.d_e);
+
+    DiyFp tenMk;
+    int   mk;
+    getCachedPower(&tenMk, &mk, w.d_e);
+
+    const DiyFp scaledW     = multiply(w,     tenMk);
+    const DiyFp scaledMinus = multiply(minus, tenMk);
+    const DiyFp scaledPlus  = multiply(plus,  tenMk);
+
+    int        kappa;
+    const bool result = digitGen(buffer,
+                                 length,
+                                 &kappa,
+                                 scaledMinus,
+                                 scaledW,
+                                 scaledPlus);
+
+    *exponent = kappa - mk;
+    return result;
+}
+
+                        // ==========================
+                        // Exact Fallback
+                        // ==========================
+
+bool roundTrips(const char *digits,
+                int         length,
+                int         exponent,
+                double      value,
+                bool        isFloat)
+    // Return 'true' if the number formed by the specified 'length' decimal
+    // 'digits' scaled by '10^exponent', for the specified 'exponent', is
+    // parsed to the specified 'value', and 'false' otherwise.  Parse as a
+    // 'float' if the specified 'isFloat' is 'true', and as a 'double'
+    // otherwise.
+{
+    char text[32];
+    memcpy(text, digits, length);
+    snprintf(text + length, sizeof text - length, "e%d", exponent);
+
+    if (isFloat) {
+        return static_cast<float>(value) == strtof(text, 0);          // RETURN
+    }
+    return value == strtod(text, 0);
+}
+
+bool findDigits(char   *digits,
+                int    *length,
+                int    *exponent,
+                double  value,
+                int     precision,
+                bool    isFloat)
+    // Load into the specified 'digits' the closest round-trip representation
+    // of the specified 'value' having the specified 'precision' digits, if
+    // one exists, load the number of digits (after removing trailing zeros)
+    // into the specified 'length' and the decimal exponent of the last digit
+    // into the specified 'exponent', and return 'true'; otherwise return
+    // 'false'.  Verify the round trip as a 'float' if the specified 'isFloat'
+    // is 'true', and as a 'double' otherwise.
+{
+    char buffer[48];
+    snprintf(buffer, sizeof buffer, "%.*e", precision - 1, value);
+
+    // Collect the digits, skipping the (locale-specific) decimal point.
+
+    int         n = 0;
+    const char *p = buffer;
+    for (; 'e' != *p; ++p) {
+        if ('0' <= *p && *p <= '9') {
+            digits[n++] = *p;
+        }
+    }
+    BSLS_ASSERT(precision == n);
+
+    int e = atoi(p + 1) - (precision - 1);
+
+    bool found = roundTrips(digits, n, e, value, isFloat);
+
+    if (!found) {
+        // The gap to the lower neighbor of 'value' may be half the gap to its
+        // upper neighbor, so the next larger number having 'precision' digits
+        // may round-trip even if the closest one does not.
+
+        int i = n - 1;
+        while (i >= 0 && '9' == digits[i]) {
+            digits[i--] = '0';
+        }
+        if (i >= 0) {
+            ++digits[i];
+        }
+        else {
+            digits[0] = '1';
+            ++e;
+        }
+        found = roundTrips(digits, n, e, value, isFloat);
+    }
+
+    if (found) {
+        while (n > 1 && '0' == digits[n - 1]) {
+            --n;
+            ++e;
+        }
+        *length   = n;
+        *exponent = e;
+    }
+    return found;
+}
+
+int exactShortestDigits(char   *digits,
+                        int    *exponent,
+                        double  value,
+                        int     maxDigits,
+                        bool    isFloat)
+    // Load into the specified 'digits' the shortest, closest round-trip
+    // digits of the specified 'value', having at most the specified
+    // 'maxDigits' digits, and load the decimal exponent of the last digit
+    // into the specified 'exponent'.  Verify the round trip as a 'float' if
+    // the specified 'isFloat' is 'true', and as a 'double' otherwise.  Return
+    // the number of digits.  The behavior is undefined unless 'value' is
+    // finite and positive.
+{
+    // If a representation having 'p' digits round-trips, then so does one
+    // having 'p + 1' digits, so binary search for the shortest precision.
+
+    char candidate[24];
+    int  length;
+    int  e;
+
+    int low  = 1;
+    int high = maxDigits;
+    int best = 0;
+    while (low <= high) {
+        const int precision = (low + high) / 2;
+        if (findDigits(candidate, &length, &e, value, precision, isFloat)) {
+            memcpy(digits, candidate, length);
+            *exponent = e;
+            best      = length;
+            high      = precision - 1;
+        }
+        else {
+            low = precision + 1;
+        }
+    }
+
+    BSLS_ASSERT(0 < best);
+    return best;
+}
+
+                        // ==========================
+                        // Text Layout
+                        // ==========================
+
+char *writeExponent(char *out, int exponent)
+    // Write into the specified 'out' the specified 'exponent' preceded by
+    // its sign and having at least two digits, and return a pointer one past
+    // the last character written.
+{
+    if (exponent < 0) {
+        *out++   = '-';
+        exponent = -exponent;
+    }
+    else {
+        *out++ = '+';
+    }
+    if (exponent >= 100) {
+        *out++    = static_cast<char>('0' + exponent / 100);
+        exponent %= 100;
+    }
+    *out++ = static_cast<char>('0' + exponent / 10);
+    *out++ = static_cast<char>('0' + exponent % 10);
+    return out;
+}
+
+char *writeInteger(char *out, Uint64 significand, int binaryExponent)
+    // Write into the specified 'out' the decimal digits of the integer
+    // 'significand * 2^binaryExponent', for the specified 'significand' and
+    // 'binaryExponent', and return a pointer one past the last character
+    // written.  The behavior is undefined unless '0 < significand',
+    // '0 <= binaryExponent', and the integer is less than '2^96'.
+{
+    // Hold the integer in three 32-bit limbs, most significant first, and
+    // extract its digits (in reverse order) by repeated division by 10.
+
+    unsigned int limbs[3];
+    const Uint64 high = 0 == binaryExponent
+                      ? 0
+                      : significand >> (64 - binaryExponent);
+    const Uint64 low  = significand << binaryExponent;
+
+    limbs[0] = static_cast<unsigned int>(high);
+    limbs[1] = static_cast<unsigned int>(low >> 32);
+    limbs[2] = static_cast<unsigned int>(low);
+
+    char  reversed[32];
+    char *end = reversed;
+    while (limbs[0] | limbs[1] | limbs[2]) {
+        Uint64 remainder = 0;
+        for (int i = 0; i < 3; ++i) {
+            const Uint64 current = (remainder << 32) | limbs[i];
+            limbs[i]  = static_cast<unsigned int>(current / 10);
+            remainder = current % 10;
+        }
+        *end++ = static_cast<char>('0' + remainder);
+    }
+    while (end != reversed) {
+        *out++ = *--end;
+    }
+    return out;
+}
+
+char *writeShortest(char       *first,
+                    char       *last,
+                    bool        isNegative,
+                    const char *digits,
+                    int         length,
+                    int         exponent,
+                    Uint64      significand,
+                    int         binaryExponent)
+    // Write into the range '[first, last)' the number formed by the specified
+    // 'length' decimal 'digits' scaled by '10^exponent', for the specified
+    // 'exponent', negated if the specified 'isNegative' is 'true', in fixed
+    // or in scientific notation, whichever is shorter.  If fixed notation is
+    // chosen and the number is an integer, write instead the exact value
+    // 'significand * 2^binaryExponent', defined by the specified
+    // 'significand' and 'binaryExponent', of the floating point number that
+    // the digits represent (as 'std::to_chars' does).  Return a pointer one
+    // past the last character written, or 0 if the range is too small.
+{
+    // 'pointPosition' is the number of digits before the decimal point in
+    // fixed notation (non-positive if the number is less than 1), and
+    // 'scientificExponent' is the exponent in scientific notation.
+
+    const int pointPosition      = length + exponent;
+    const int scientificExponent = pointPosition - 1;
+
+    int fixedLength;
+    if (exponent >= 0) {
+        fixedLength = pointPosition;                      // "ddd000"
+    }
+    else if (pointPosition > 0) {
+        fixedLength = length + 1;                         // "dd.ddd"
+    }
+    else {
+        fixedLength = 2 - pointPosition + length;         // "0.000ddd"
+    }
+
+    const int absExponent        = scientificExponent < 0
+                                 ? -scientificExponent
+                                 : scientificExponent;
+    const int scientificLength   = length
+                                 + (length > 1 ? 1 : 0)
+                                 + 2
+                                 + (absExponent >= 100 ? 3 : 2);
+
+    const bool isFixed = fixedLength <= scientificLength;
+    const int  total   = (isFixed ? fixedLength : scientificLength)
+                       + (isNegative ? 1 : 0);
+
+    if (last - first < total) {
+        return 0;                                                     // RETURN
+    }
+
+    char *out = first;
+    if (isNegative) {
+        *out++ = '-';
+    }
+
+    if (!isFixed) {
+        *out++ = digits[0];
+        if (length > 1) {
+            *out++ = '.';
+            memcpy(out, digits + 1, length - 1);
+            out += length - 1;
+        }
+        *out++ = 'e';
+        return writeExponent(out, scientificExponent);                // RETURN
+    }
+
+    if (exponent >= 0 && binaryExponent > 0) {
+        // The value is an integer not exactly representable by its shortest
+        // digits followed by zeros.  Note that its digits are no more
+        // numerous than 'fixedLength', as every power of ten that can be
+        // written in fixed notation is exactly representable.
+
+        out = writeInteger(out, significand, binaryExponent);
+    }
+    else if (exponent >= 0) {
+        memcpy(out, digits, length);
+        out += length;
+        for (int i = 0; i < exponent; ++i) {
+            *out++ = '0';
+        }
+    }
+    else if (pointPosition > 0) {
+        memcpy(out, digits, pointPosition);
+        out += pointPosition;
+        *out++ = '.';
+        memcpy(out, digits + pointPosition, length - pointPosition);
+        out += length - pointPosition;
+    }
+    else {
+        *out++ = '0';
+        *out++ = '.';
+        for (int i = 0; i < -pointPosition; ++i) {
+            *out++ = '0';
+        }
+        memcpy(out, digits, length);
+        out += length;
+    }
+    return out;
+}
+
+char *writeSpecial(char *first, char *last, bool isNegative, const char *text)
+    // Write into the range '[first, last)' the specified null-terminated
+    // 'text', preceded by '-' if the specified 'isNegative' is 'true'.
+    // Return a pointer one past the last character written, or 0 if the
+    // range is too small.
+{
+    const int length = static_cast<int>(strlen(text)) + (isNegative ? 1 : 0);
+    if (last - first < length) {
+        return 0;                                                     // RETURN
+    }
+    if (isNegative) {
+        *first++ = '-';
+    }
+    while (*text) {
+        *first++ = *text++;
+    }
+    return first;
+}
+
+int trimTrailingZeros(char *digits, int length, int *exponent)
+    // Remove trailing '0' characters from the specified 'length' 'digits',
+    // incrementing the specified 'exponent' accordingly, and return the new
+    // length.
+{
+    while (length > 1 && '0' == digits[length - 1]) {
+        --length;
+        ++*exponent;
+    }
+    return length;
+}
+
+bool decompose(Uint64 *significand, int *binaryExponent, double value)
+    // Load into the specified 'significand' and 'binaryExponent' the
+    // integers such that the specified 'value' equals
+    // 'significand * 2^binaryExponent', where 'significand' is less than
+    // '2^53', and return 'true' if the gap between 'value' and its lower
+    // neighbor is half the gap to its upper neighbor, and 'false' otherwise.
+    // The behavior is undefined unless 'value' is finite and positive.
+{
+    const Uint64 k_HIDDEN_BIT = 0x0010000000000000ULL;
+    const int    k_BIAS       = 0x3FF + 52;
+
+    Uint64 bits;
+    memcpy(&bits, &value, sizeof bits);
+
+    const Uint64 fraction  = bits & (k_HIDDEN_BIT - 1);
+    const int    biasedExp = static_cast<int>(bits >> 52);
+
+    BSLS_ASSERT(0x7FF != biasedExp);
+
+    if (0 == biasedExp) {
+        *significand    = fraction;                               // subnormal
+        *binaryExponent = 1 - k_BIAS;
+    }
+    else {
+        *significand    = fraction | k_HIDDEN_BIT;
+        *binaryExponent = biasedExp - k_BIAS;
+    }
+    return 0 == fraction && biasedExp > 1;
+}
+
+bool decompose(Uint64 *significand, int *binaryExponent, float value)
+    // Load into the specified 'significand' and 'binaryExponent' the
+    // integers such that the specified 'value' equals
+    // 'significand * 2^binaryExponent', where 'significand' is less than
+    // '2^24', and return 'true' if the gap between 'value' and its lower
+    // neighbor is half the gap to its upper neighbor, and 'false' otherwise.
+    // The behavior is undefined unless 'value' is finite and positive.
+{
+    const unsigned int k_HIDDEN_BIT = 0x00800000U;
+    const int          k_BIAS       = 0x7F + 23;
+
+    unsigned int bits;
+    memcpy(&bits, &value, sizeof bits);
+
+    const unsigned int fraction  = bits & (k_HIDDEN_BIT - 1);
+    const int          biasedExp = static_cast<int>(bits >> 23);
+
+    BSLS_ASSERT(0xFF != biasedExp);
+
+    if (0 == biasedExp) {
+        *significand    = fraction;                               // subnormal
+        *binaryExponent = 1 - k_BIAS;
+    }
+    else {
+        *significand    = fraction | k_HIDDEN_BIT;
+        *binaryExponent = biasedExp - k_BIAS;
+    }
+    return 0 == fraction && biasedExp > 1;
+}
+
+int generateShortestDigits(char   *digits,
+                           int    *exponent,
+                           Uint64  significand,
+                           int     binaryExponent,
+                           bool    isLowerBoundaryCloser,
+                           double  value,
+                           int     maxDigits,
+                           bool    isFloat)
+    // Load into the specified 'digits' the shortest, closest round-trip
+    // digits of the specified 'value', whose representation in its
+    // floating point type is 'significand * 2^binaryExponent' for the
+    // specified 'significand' and 'binaryExponent', and load the decimal
+    // exponent of the last digit into the specified 'exponent'.  The
+    // specified 'isLowerBoundaryCloser' indicates whether the gap to the
+    // lower neighbor of 'value' is half the gap to its upper neighbor, the
+    // specified 'maxDigits' is the most digits the type may need, and the
+    // specified 'isFloat' indicates whether the type is 'float' (rather than
+    // 'double').  Return the number of digits.
+{
+    // 'digitGen' may produce one digit more than the type needs before
+    // failing, so generate into a scratch buffer.
+
+    char buffer[bslalg::NumericFormatterUtil::k_MAX_DIGITS_DOUBLE + 2];
+    int  length;
+
+    if (grisu3(buffer,
+               &length,
+               exponent,
+               significand,
+               binaryExponent,
+               isLowerBoundaryCloser)) {
+        length = trimTrailingZeros(buffer, length, exponent);
+        BSLS_ASSERT_SAFE(length <= maxDigits);
+
+        memcpy(digits, buffer, length);
+        return length;                                                // RETURN
+    }
+
+    return exactShortestDigits(digits, exponent, value, maxDigits, isFloat);
+}
+
+}  // close unnamed namespace
+
+namespace bslalg {
+
+                        // ---------------------------
+                        // struct NumericFormatterUtil
+                        // ---------------------------
+
+// CLASS METHODS
+int NumericFormatterUtil::shortestDigits(char   *digits,
+                                         int    *exponent,
+                                         double  value)
+{
+    BSLS_ASSERT(digits);
+    BSLS_ASSERT(exponent);
+    BSLS_ASSERT(value > 0);
+
+    Uint64     significand;
+    int        binaryExponent;
+    const bool isLowerBoundaryCloser = decompose(&significand,
+                                                 &binaryExponent,
+                                                 value);
+
+    return generateShortestDigits(digits,
+                                  exponent,
+                                  significand,
+                                  binaryExponent,
+                                  isLowerBoundaryCloser,
+                                  value,
+                                  k_MAX_DIGITS_DOUBLE,
+                                  false);
+}
+
+int NumericFormatterUtil::shortestDigits(char  *digits,
+                                         int   *exponent,
+                                         float  value)
+{
+    BSLS_ASSERT(digits);
+    BSLS_ASSERT(exponent);
+    BSLS_ASSERT(value > 0);
+
+    Uint64     significand;
+    int        binaryExponent;
+    const bool isLowerBoundaryCloser = decompose(&significand,
+                                                 &binaryExponent,
+                                                 value);
+
+    return generateShortestDigits(digits,
+                                  exponent,
+                                  significand,
+                                  binaryExponent,
+                                  isLowerBoundaryCloser,
+                                  value,
+                                  k_MAX_DIGITS_FLOAT,
+                                  true);
+}
+
+char *NumericFormatterUtil::toChars(char *first, char *last, double value)
+{
+    BSLS_ASSERT(first <= last);
+
+    Uint64 bits;
+    memcpy(&bits, &value, sizeof bits);
+
+    const bool isNegative = 0 != (bits >> 63);
+
+    if (0x7FF0000000000000ULL == (bits & 0x7FF0000000000000ULL)) {
+        return writeSpecial(first,
+                            last,
+                            isNegative,
+                            bits & 0x000FFFFFFFFFFFFFULL ? "nan" : "inf");
+                                                                      // RETURN
+    }
+
+    if (0 == value) {
+        return writeSpecial(first, last, isNegative, "0");            // RETURN
+    }
+
+    const double absValue = isNegative ? -value : value;
+
+    char digits[k_MAX_DIGITS_DOUBLE];
+    int  exponent;
+    int  length = shortestDigits(digits, &exponent, absValue);
+
+    Uint64 significand;
+    int    binaryExponent;
+    decompose(&significand, &binaryExponent, absValue);
+
+    return writeShortest(first,
+                         last,
+                         isNegative,
+                         digits,
+                         length,
+                         exponent,
+                         significand,
+                         binaryExponent);
+}
+
+char *NumericFormatterUtil::toChars(char *first, char *last, float value)
+{
+    BSLS_ASSERT(first <= last);
+
+    unsigned int bits;
+    memcpy(&bits, &value, sizeof bits);
+
+    const bool isNegative = 0 != (bits >> 31);
+
+    if (0x7F800000U == (bits & 0x7F800000U)) {
+        return writeSpecial(first,
+                            last,
+                            isNegative,
+                            bits & 0x007FFFFFU ? "nan" : "inf");      // RETURN
+    }
+
+    if (0 == value) {
+        return writeSpecial(first, last, isNegative, "0");            // RETURN
+    }
+
+    const float absValue = isNegative ? -value : value;
+
+    char digits[k_MAX_DIGITS_FLOAT];
+    int  exponent;
+    int  length = shortestDigits(digits, &exponent, absValue);
+
+    Uint64 significand;
+    int    binaryExponent;
+    decompose(&significand, &binaryExponent, absValue);
+
+    return writeShortest(first,
+                         last,
+                         isNegative,
+                         digits,
+                         length,
+                         exponent,
+                         significand,
+                         binaryExponent);
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+// ----------------------------------------------------------------------------
+// Copyright 2020 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,172 @@
+// bslalg_numericformatterutil.h                                      -*-C++-*-
+#ifndef INCLUDED_BSLALG_NUMERICFORMATTERUTIL
+#define INCLUDED_BSLALG_NUMERICFORMATTERUTIL
+
+#include <bsls_ident.h>
+BSLS_IDENT("$Id: $")
+
+//@PURPOSE: Provide shortest round-trip formatting of floating point numbers.
+//
+//@CLASSES:
+//  bslalg::NumericFormatterUtil: shortest round-trip floating point formatter
+//
+//@DESCRIPTION: This component provides a namespace 'struct',
+// 'bslalg::NumericFormatterUtil', containing functions that convert 'double'
+// and 'float' values to the shortest sequence of decimal digits that, when
+// read back by a correctly rounding parser (such as 'strtod' or 'strtof'),
+// reproduces exactly the original value.  When more than one such sequence of
+// the minimal length exists, the one closest to the exact binary value is
+// chosen.  The conversions are independent of the current C locale, never
+// allocate memory, and are several times faster than formatting with
+// 'snprintf' at a fixed precision.
+//
+// Two levels of interface are provided:
+//
+//: o 'shortestDigits' produces the significant decimal digits and the decimal
+//:   exponent of a finite, positive value, leaving the textual layout (e.g.,
+//:   the choice between fixed and scientific notation) to the caller.  This is
+//:   the building block for clients, such as encoders and printers, that must
+//:   reproduce an existing output style.
+//:
+//: o 'toChars' writes a complete textual representation of any value
+//:   (including zero, infinity, and NaN) having the same format as the C++17
+//:   function 'std::to_chars(first, last, value)': the value is written in
+//:   either fixed or scientific notation, whichever is shorter (preferring
+//:   fixed notation in case of a tie).
+//
+///Algorithm
+///---------
+// The digits are generated using the Grisu3 algorithm (see "Printing
+// Floating-Point Numbers Quickly and Accurately with Integers", Florian
+// Loitsch, PLDI 2010), which computes the shortest, closest representation
+// using only 64-bit integer arithmetic and a table of cached powers of ten.
+// Grisu3 detects the (rare, approximately 0.5% of 'double' values) inputs for
+// which its imprecise arithmetic cannot guarantee an optimal result, and for
+// those inputs this implementation falls back to a slower exact search that
+// relies on the correctly rounded conversions of the C library.
+//
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Writing a Value That Round-Trips
+///- - - - - - - - - - - - - - - - - - - - - -
+// Suppose we need to write a 'double' to a text-based format such that a
+// reader obtains exactly the same value, without emitting needless digits.
+//
+// First, we create a buffer large enough for any 'double' and a null
+// terminator:
+//..
+//  char buffer[bslalg::NumericFormatterUtil::k_TOCHARS_MAX_LENGTH_DOUBLE + 1];
+//..
+// Then, we format the value '0.1', which a '"%.17g"' format would render as
+// '"0.10000000000000001"':
+//..
+//  char *last = buffer + sizeof buffer - 1;
+//  char *end  = bslalg::NumericFormatterUtil::toChars(buffer, last, 0.1);
+//  assert(0 != end);
+//  *end = '\0';
+//  assert(0 == strcmp("0.1", buffer));
+//..
+// Next, we format a large value, for which scientific notation is shorter:
+//..
+//  end = bslalg::NumericFormatterUtil::toChars(buffer, last, -1.5e300);
+//  *end = '\0';
+//  assert(0 == strcmp("-1.5e+300", buffer));
+//..
+// Finally, we obtain the significant digits of a value directly, so that we
+// can lay them out in a format of our own choosing:
+//..
+//  char digits[bslalg::NumericFormatterUtil::k_MAX_DIGITS_DOUBLE];
+//  int  exponent;
+//  int  numDigits = bslalg::NumericFormatterUtil::shortestDigits(digits,
+//                                                                &exponent,
+//                                                                123.25);
+//  assert(5  == numDigits);
+//  assert(-2 == exponent);
+//  assert(0  == memcmp(digits, "12325", 5));
+//..
+
+#include <bslscm_version.h>
+
+namespace BloombergLP {
+namespace bslalg {
+
+                        // ===========================
+                        // struct NumericFormatterUtil
+                        // ===========================
+
+struct NumericFormatterUtil {
+    // This 'struct' provides a namespace for functions that convert floating
+    // point values to their shortest round-trip decimal representation.
+
+    // CONSTANTS
+    enum {
+        k_MAX_DIGITS_DOUBLE         = 17,  // most significant digits needed
+                                           // by a 'double'
+
+        k_MAX_DIGITS_FLOAT          =  9,  // most significant digits needed
+                                           // by a 'float'
+
+        k_TOCHARS_MAX_LENGTH_DOUBLE = 24,  // longest 'toChars' output for a
+                                           // 'double' (e.g.,
+                                           // "-2.2250738585072014e-308")
+
+        k_TOCHARS_MAX_LENGTH_FLOAT  = 15   // longest 'toChars' output for a
+                                           // 'float' (e.g., "-1.17549435e-38")
+    };
+
+    // CLASS METHODS
+    static int shortestDigits(char *digits, int *exponent, double value);
+    static int shortestDigits(char *digits, int *exponent, float  value);
+        // Load into the specified 'digits' the shortest sequence of decimal
+        // digits, 'D', such that 'D * 10^E', where 'E' is the value loaded
+        // into the specified 'exponent', is converted back to the specified
+        // 'value' by a correctly rounding parser, choosing the sequence
+        // closest to 'value' if several sequences of that length qualify.
+        // Return the number of digits written.  The first and last digits
+        // written are not '0', and no null terminator is written.  The
+        // behavior is undefined unless 'value' is finite and positive, and
+        // 'digits' has room for at least 'k_MAX_DIGITS_DOUBLE' (respectively
+        // 'k_MAX_DIGITS_FLOAT') characters.
+
+    static char *toChars(char *first, char *last, double value);
+    static char *toChars(char *first, char *last, float  value);
+        // Write the shortest round-trip textual representation of the
+        // specified 'value' into the character range starting at the
+        // specified 'first' and ending before the specified 'last', and
+        // return a pointer one past the last character written, or 0 if the
+        // range is too small to hold the representation (in which case the
+        // contents of the range are unspecified).  The representation has the
+        // same format as 'std::to_chars(first, last, value)': finite values
+        // are written in fixed notation (e.g., "0.001", "1500") or in
+        // scientific notation with at least two exponent digits (e.g.,
+        // "1e+21", "2.5e-07"), whichever is shorter, preferring fixed
+        // notation on a tie; infinite values are written as "inf" or "-inf",
+        // and NaN values as "nan" or "-nan".  No null terminator is written.
+        // The behavior is undefined unless 'first <= last'.  Note that a
+        // range of 'k_TOCHARS_MAX_LENGTH_DOUBLE' (respectively
+        // 'k_TOCHARS_MAX_LENGTH_FLOAT') characters is sufficient for any
+        // value.
+};
+
+}  // close package namespace
+}  // close enterprise namespace
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2020 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
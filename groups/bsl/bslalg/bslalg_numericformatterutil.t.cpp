@@ -0,0 +1,804 @@
+// bslalg_numericformatterutil.t.cpp                                  -*-C++-*-
+
+#include <bslalg_numericformatterutil.h>
+
+#include <bsls_assert.h>
+#include <bsls_asserttest.h>
+#include <bsls_bsltestutil.h>
+#include <bsls_stopwatch.h>
+#include <bsls_types.h>
+
+#include <float.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+using namespace BloombergLP;
+
+//=============================================================================
+//                                 TEST PLAN
+//-----------------------------------------------------------------------------
+//                                  Overview
+//                                  --------
+// The component under test provides pure functions that convert floating
+// point values to text.  The digit generation has a fast path (Grisu3) that
+// declines a small fraction of its inputs, and an exact fallback; both are
+// exercised by comparing the results for a large number of pseudo-random
+// values (as well as values at the boundaries of the representable ranges)
+// against an independent oracle built on 'sprintf' and 'strtod'.  The textual
+// layout is then verified with a table of values and expected strings.
+//-----------------------------------------------------------------------------
+// CLASS METHODS
+// [ 2] int shortestDigits(char *, int *, double);
+// [ 2] int shortestDigits(char *, int *, float);
+// [ 3] char *toChars(char *, char *, double);
+// [ 3] char *toChars(char *, char *, float);
+//-----------------------------------------------------------------------------
+// [ 1] BREATHING TEST
+// [ 4] USAGE EXAMPLE
+// [-1] PERFORMANCE: 'toChars' VS. 'sprintf'
+//-----------------------------------------------------------------------------
+
+// ============================================================================
+//                     STANDARD BSL ASSERT TEST FUNCTION
+// ----------------------------------------------------------------------------
+
+namespace {
+
+int testStatus = 0;
+
+void aSsErT(bool condition, const char *message, int line)
+{
+    if (condition) {
+        printf("Error " __FILE__ "(%d): %s    (failed)\n", line, message);
+
+        if (0 <= testStatus && testStatus <= 100) {
+            ++testStatus;
+        }
+    }
+}
+
+}  // close unnamed namespace
+
+// ============================================================================
+//               STANDARD BSL TEST DRIVER MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT       BSLS_BSLTESTUTIL_ASSERT
+#define ASSERTV      BSLS_BSLTESTUTIL_ASSERTV
+
+#define LOOP_ASSERT  BSLS_BSLTESTUTIL_LOOP_ASSERT
+#define LOOP0_ASSERT BSLS_BSLTESTUTIL_LOOP0_ASSERT
+#define LOOP1_ASSERT BSLS_BSLTESTUTIL_LOOP1_ASSERT
+#define LOOP2_ASSERT BSLS_BSLTESTUTIL_LOOP2_ASSERT
+#define LOOP3_ASSERT BSLS_BSLTESTUTIL_LOOP3_ASSERT
+#define LOOP4_ASSERT BSLS_BSLTESTUTIL_LOOP4_ASSERT
+#define LOOP5_ASSERT BSLS_BSLTESTUTIL_LOOP5_ASSERT
+#define LOOP6_ASSERT BSLS_BSLTESTUTIL_LOOP6_ASSERT
+
+#define Q            BSLS_BSLTESTUTIL_Q   // Quote identifier literally.
+#define P            BSLS_BSLTESTUTIL_P   // Print identifier and value.
+#define P_           BSLS_BSLTESTUTIL_P_  // P(X) without '\n'.
+#define T_           BSLS_BSLTESTUTIL_T_  // Print a tab (w/o newline).
+#define L_           BSLS_BSLTESTUTIL_L_  // current Line number
+
+// ============================================================================
+//                  PRINTF FORMAT MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define U64 BSLS_BSLTESTUTIL_FORMAT_U64
+
+// ============================================================================
+//                  NEGATIVE-TEST MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT_SAFE_PASS(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_PASS(EXPR)
+#define ASSERT_SAFE_FAIL(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_FAIL(EXPR)
+#define ASSERT_PASS(EXPR)      BSLS_ASSERTTEST_ASSERT_PASS(EXPR)
+#define ASSERT_FAIL(EXPR)      BSLS_ASSERTTEST_ASSERT_FAIL(EXPR)
+#define ASSERT_OPT_PASS(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_PASS(EXPR)
+#define ASSERT_OPT_FAIL(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_FAIL(EXPR)
+
+//=============================================================================
+//                  GLOBAL TYPEDEFS/CONSTANTS FOR TESTING
+//-----------------------------------------------------------------------------
+
+typedef bslalg::NumericFormatterUtil Util;
+typedef bsls::Types::Uint64          Uint64;
+
+//=============================================================================
+//                       HELPER FUNCTIONS FOR TESTING
+//-----------------------------------------------------------------------------
+
+namespace {
+
+Uint64 nextRandom(Uint64 *state)
+    // Advance the specified 'state' of a 64-bit linear congruential generator
+    // and return a pseudo-random value derived from it.
+{
+    *state = *state * 6364136223846793005ULL + 1442695040888963407ULL;
+    return *state ^ (*state >> 29);
+}
+
+double doubleFromBits(Uint64 bits)
+    // Return the 'double' having the specified 'bits' representation.
+{
+    double result;
+    memcpy(&result, &bits, sizeof result);
+    return result;
+}
+
+float floatFromBits(unsigned int bits)
+    // Return the 'float' having the specified 'bits' representation.
+{
+    float result;
+    memcpy(&result, &bits, sizeof result);
+    return result;
+}
+
+bool parsesTo(const char *digits, int length, int exponent, double value,
+              bool isFloat)
+    // Return 'true' if the specified 'length' 'digits' scaled by
+    // '10^exponent', for the specified 'exponent', parse to the specified
+    // 'value' (as a 'float' if the specified 'isFloat' is 'true').
+{
+    char text[64];
+    memcpy(text, digits, length);
+    sprintf(text + length, "e%d", exponent);
+    if (isFloat) {
+        return static_cast<float>(value) == strtof(text, 0);          // RETURN
+    }
+    return value == strtod(text, 0);
+}
+
+int oracleShortest(char *digits, int *exponent, double value, bool isFloat)
+    // Load into the specified 'digits' and 'exponent' the shortest, closest
+    // round-trip representation of the specified 'value', found by trying
+    // every precision in turn, and return its number of digits.  Verify the
+    // round trip as a 'float' if the specified 'isFloat' is 'true'.
+{
+    for (int precision = 1; precision <= 17; ++precision) {
+        char buffer[64];
+        sprintf(buffer, "%.*e", precision - 1, value);
+
+        char candidates[2][32];
+        int  length = 0;
+        const char *p = buffer;
+        for (; 'e' != *p; ++p) {
+            if ('0' <= *p && *p <= '9') {
+                candidates[0][length++] = *p;
+            }
+        }
+        int exponents[2];
+        exponents[0] = atoi(p + 1) - (precision - 1);
+
+        // The next larger candidate.
+
+        memcpy(candidates[1], candidates[0], length);
+        exponents[1] = exponents[0];
+        int i = length - 1;
+        while (i >= 0 && '9' == candidates[1][i]) {
+            candidates[1][i--] = '0';
+        }
+        if (i >= 0) {
+            ++candidates[1][i];
+        }
+        else {
+            candidates[1][0] = '1';
+            ++exponents[1];
+        }
+
+        for (int c = 0; c < 2; ++c) {
+            if (parsesTo(candidates[c],
+                         length,
+                         exponents[c],
+                         value,
+                         isFloat)) {
+                int n = length;
+                int e = exponents[c];
+                while (n > 1 && '0' == candidates[c][n - 1]) {
+                    --n;
+                    ++e;
+                }
+                memcpy(digits, candidates[c], n);
+                *exponent = e;
+                return n;                                             // RETURN
+            }
+        }
+    }
+    ASSERT(!"unreachable");
+    return 0;
+}
+
+void verifyDouble(int line, double value)
+    // Verify that 'shortestDigits' for the specified 'value' matches the
+    // oracle, reporting failures against the specified 'line'.
+{
+    char digits[Util::k_MAX_DIGITS_DOUBLE + 8];
+    int  exponent = 9999;
+    memset(digits, 'x', sizeof digits);
+
+    const int length = Util::shortestDigits(digits, &exponent, value);
+
+    char expDigits[32];
+    int  expExponent;
+    const int expLength = oracleShortest(expDigits, &expExponent, value,
+                                         false);
+
+    LOOP3_ASSERT(line, length, expLength, expLength == length);
+    LOOP3_ASSERT(line, exponent, expExponent, expExponent == exponent);
+    LOOP_ASSERT(line, 0 == memcmp(digits, expDigits, length));
+    LOOP_ASSERT(line, 'x' == digits[Util::k_MAX_DIGITS_DOUBLE]);
+    LOOP_ASSERT(line, parsesTo(digits, length, exponent, value, false));
+}
+
+void verifyFloat(int line, float value)
+    // Verify that 'shortestDigits' for the specified 'value' matches the
+    // oracle, reporting failures against the specified 'line'.
+{
+    char digits[Util::k_MAX_DIGITS_FLOAT + 8];
+    int  exponent = 9999;
+    memset(digits, 'x', sizeof digits);
+
+    const int length = Util::shortestDigits(digits, &exponent, value);
+
+    char expDigits[32];
+    int  expExponent;
+    const int expLength = oracleShortest(expDigits, &expExponent, value,
+                                         true);
+
+    LOOP3_ASSERT(line, length, expLength, expLength == length);
+    LOOP3_ASSERT(line, exponent, expExponent, expExponent == exponent);
+    LOOP_ASSERT(line, 0 == memcmp(digits, expDigits, length));
+    LOOP_ASSERT(line, 'x' == digits[Util::k_MAX_DIGITS_FLOAT]);
+    LOOP_ASSERT(line, parsesTo(digits, length, exponent, value, true));
+}
+
+}  // close unnamed namespace
+
+//=============================================================================
+//                              MAIN PROGRAM
+//-----------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    int                 test = argc > 1 ? atoi(argv[1]) : 0;
+    bool             verbose = argc > 2;
+    bool         veryVerbose = argc > 3;
+    bool     veryVeryVerbose = argc > 4;
+
+    (void)veryVerbose;
+    (void)veryVeryVerbose;
+
+    printf("TEST " __FILE__ " CASE %d\n", test);
+
+    switch (test) { case 0:  // Zero is always the leading case.
+      case 4: {
+        // --------------------------------------------------------------------
+        // USAGE EXAMPLE
+        //   Extracted from component header file.
+        //
+        // Concerns:
+        //: 1 The usage example provided in the component header file compiles,
+        //:   links, and runs as shown.
+        //
+        // Plan:
+        //: 1 Incorporate usage example from header into test driver, remove
+        //:   leading comment characters, and replace 'assert' with 'ASSERT'.
+        //:   (C-1)
+        //
+        // Testing:
+        //   USAGE EXAMPLE
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nUSAGE EXAMPLE"
+                            "\n=============\n");
+
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Writing a Value That Round-Trips
+///- - - - - - - - - - - - - - - - - - - - - -
+// Suppose we need to write a 'double' to a text-based format such that a
+// reader obtains exactly the same value, without emitting needless digits.
+//
+// First, we create a buffer large enough for any 'double' and a null
+// terminator:
+//..
+    char buffer[bslalg::NumericFormatterUtil::k_TOCHARS_MAX_LENGTH_DOUBLE + 1];
+//..
+// Then, we format the value '0.1', which a '"%.17g"' format would render as
+// '"0.10000000000000001"':
+//..
+    char *last = buffer + sizeof buffer - 1;
+    char *end  = bslalg::NumericFormatterUtil::toChars(buffer, last, 0.1);
+    ASSERT(0 != end);
+    *end = '\0';
+    ASSERT(0 == strcmp("0.1", buffer));
+//..
+// Next, we format a large value, for which scientific notation is shorter:
+//..
+    end = bslalg::NumericFormatterUtil::toChars(buffer, last, -1.5e300);
+    *end = '\0';
+    ASSERT(0 == strcmp("-1.5e+300", buffer));
+//..
+// Finally, we obtain the significant digits of a value directly, so that we
+// can lay them out in a format of our own choosing:
+//..
+    char digits[bslalg::NumericFormatterUtil::k_MAX_DIGITS_DOUBLE];
+    int  exponent;
+    int  numDigits = bslalg::NumericFormatterUtil::shortestDigits(digits,
+                                                                  &exponent,
+                                                                  123.25);
+    ASSERT(5  == numDigits);
+    ASSERT(-2 == exponent);
+    ASSERT(0  == memcmp(digits, "12325", 5));
+//..
+      } break;
+      case 3: {
+        // --------------------------------------------------------------------
+        // TESTING 'toChars'
+        //
+        // Concerns:
+        //: 1 Finite values are written in fixed or scientific notation,
+        //:   whichever is shorter, preferring fixed notation on a tie.
+        //:
+        //: 2 Scientific notation has a signed exponent of at least two digits.
+        //:
+        //: 3 Integers written in fixed notation show their exact value, even
+        //:   where it has more significant digits than needed to round-trip.
+        //:
+        //: 4 Zero, infinity and NaN are written as "0", "inf" and "nan",
+        //:   preceded by '-' if their sign bit is set.
+        //:
+        //: 5 The longest outputs fit in 'k_TOCHARS_MAX_LENGTH_DOUBLE' (resp.
+        //:   'k_TOCHARS_MAX_LENGTH_FLOAT') characters.
+        //:
+        //: 6 0 is returned, and nothing is written outside the range, if the
+        //:   range is too small.
+        //:
+        //: 7 QoI: Asserted precondition violations are detected when enabled.
+        //
+        // Plan:
+        //: 1 Using the table-driven technique, format a set of values chosen
+        //:   to exercise each layout, and compare to the expected strings.
+        //:   (C-1..5)
+        //:
+        //: 2 For each entry of the table, format into every shorter range and
+        //:   verify that 0 is returned and the guard byte is intact.  (C-6)
+        //:
+        //: 3 Verify that, in appropriate build modes, defensive checks are
+        //:   triggered for invalid ranges.  (C-7)
+        //
+        // Testing:
+        //   char *toChars(char *, char *, double);
+        //   char *toChars(char *, char *, float);
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nTESTING 'toChars'"
+                            "\n=================\n");
+
+        if (verbose) printf("\nTesting 'double'.\n");
+        {
+            static const struct {
+                int         d_line;
+                double      d_value;
+                const char *d_expected;
+            } DATA[] = {
+                //LINE  VALUE                      EXPECTED
+                //----  -------------------------  --------------------------
+                { L_,   0.0,                       "0"                       },
+                { L_,   -0.0,                      "-0"                      },
+                { L_,   1.0,                       "1"                       },
+                { L_,   -1.0,                      "-1"                      },
+                { L_,   0.1,                       "0.1"                     },
+                { L_,   0.3,                       "0.3"                     },
+                { L_,   0.1 + 0.2,                 "0.30000000000000004"     },
+                { L_,   123.25,                    "123.25"                  },
+                { L_,   -123.25,                   "-123.25"                 },
+                { L_,   1.5,                       "1.5"                     },
+                { L_,   0.001,                     "0.001"                   },
+                { L_,   0.0001,                    "1e-04"                   },
+                { L_,   0.00001,                   "1e-05"                   },
+                { L_,   0.000125,                  "0.000125"                },
+                { L_,   0.0000125,                 "1.25e-05"                },
+                { L_,   1000.0,                    "1000"                    },
+                { L_,   10000.0,                   "10000"                   },
+                { L_,   100000.0,                  "1e+05"                   },
+                { L_,   120000.0,                  "120000"                  },
+                { L_,   1200000.0,                 "1200000"                 },
+                { L_,   12000000.0,                "1.2e+07"                 },
+                { L_,   123456789.0,               "123456789"               },
+                { L_,   1e15,                      "1e+15"                   },
+                { L_,   9007199254740993.0,        "9007199254740992"        },
+                { L_,   123456789012345680.0,      "123456789012345680"      },
+                { L_,   1e21,                      "1e+21"                   },
+                { L_,   1e22,                      "1e+22"                   },
+                { L_,   1e23,                      "1e+23"                   },
+                { L_,   5e-324,                    "5e-324"                  },
+                { L_,   -5e-324,                   "-5e-324"                 },
+                { L_,   DBL_MIN,                   "2.2250738585072014e-308" },
+                { L_,   -DBL_MIN,                 "-2.2250738585072014e-308" },
+                { L_,   DBL_MAX,                   "1.7976931348623157e+308" },
+                { L_,   DBL_EPSILON,               "2.220446049250313e-16"   },
+                { L_,   1.0 / 3.0,                 "0.3333333333333333"      },
+                { L_,   2.0 / 3.0,                 "0.6666666666666666"      },
+                { L_,   3.14159265358979323846,    "3.141592653589793"       },
+                { L_,   1e100,                     "1e+100"                  },
+                { L_,   1.5e-100,                  "1.5e-100"                },
+            };
+            const int NUM_DATA = sizeof DATA / sizeof *DATA;
+
+            for (int ti = 0; ti < NUM_DATA; ++ti) {
+                const int         LINE     = DATA[ti].d_line;
+                const double      VALUE    = DATA[ti].d_value;
+                const char *const EXPECTED = DATA[ti].d_expected;
+                const int         LENGTH   = static_cast<int>(
+                                                           strlen(EXPECTED));
+
+                if (veryVerbose) { T_ P_(LINE) P(EXPECTED) }
+
+                ASSERTV(LINE, LENGTH <= Util::k_TOCHARS_MAX_LENGTH_DOUBLE);
+
+                char  buffer[64];
+                memset(buffer, 'x', sizeof buffer);
+
+                char *end = Util::toChars(buffer, buffer + LENGTH, VALUE);
+                ASSERTV(LINE, buffer + LENGTH == end);
+                ASSERTV(LINE, 0 == memcmp(buffer, EXPECTED, LENGTH));
+                ASSERTV(LINE, 'x' == buffer[LENGTH]);
+
+                for (int size = 0; size < LENGTH; ++size) {
+                    memset(buffer, 'x', sizeof buffer);
+                    ASSERTV(LINE, size,
+                            0 == Util::toChars(buffer, buffer + size, VALUE));
+                    ASSERTV(LINE, size, 'x' == buffer[size]);
+                }
+            }
+
+            // Infinity and NaN.
+
+            const double INF = DBL_MAX * 2;
+            const double NAN_VALUE = doubleFromBits(0x7FF8000000000000ULL);
+            const double NEG_NAN   = doubleFromBits(0xFFF8000000000000ULL);
+
+            char  buffer[64];
+            char *end = Util::toChars(buffer, buffer + sizeof buffer, INF);
+            ASSERT(0 == memcmp(buffer, "inf", 3) && buffer + 3 == end);
+            end = Util::toChars(buffer, buffer + sizeof buffer, -INF);
+            ASSERT(0 == memcmp(buffer, "-inf", 4) && buffer + 4 == end);
+            end = Util::toChars(buffer, buffer + sizeof buffer, NAN_VALUE);
+            ASSERT(0 == memcmp(buffer, "nan", 3) && buffer + 3 == end);
+            end = Util::toChars(buffer, buffer + sizeof buffer, NEG_NAN);
+            ASSERT(0 == memcmp(buffer, "-nan", 4) && buffer + 4 == end);
+            ASSERT(0 == Util::toChars(buffer, buffer + 3, -INF));
+        }
+
+        if (verbose) printf("\nTesting 'float'.\n");
+        {
+            static const struct {
+                int         d_line;
+                float       d_value;
+                const char *d_expected;
+            } DATA[] = {
+                //LINE  VALUE              EXPECTED
+                //----  -----------------  -----------------
+                { L_,   0.0f,              "0"               },
+                { L_,   -0.0f,             "-0"              },
+                { L_,   1.0f,              "1"               },
+                { L_,   0.1f,              "0.1"             },
+                { L_,   0.3f,              "0.3"             },
+                { L_,   0.123456789f,      "0.12345679"      },
+                { L_,   -123.25f,          "-123.25"         },
+                { L_,   100000.0f,         "1e+05"           },
+                { L_,   16777217.0f,       "16777216"        },
+                { L_,   190944592.0f,      "190944592"       },
+                { L_,   1e10f,             "1e+10"           },
+                { L_,   3.4028235e38f,     "3.4028235e+38"   },
+                { L_,   FLT_MIN,           "1.1754944e-38"   },
+                { L_,   -1.17549435e-38f,  "-1.1754944e-38"  },
+                { L_,   1e-45f,            "1e-45"           },
+                { L_,   FLT_EPSILON,       "1.1920929e-07"   },
+            };
+            const int NUM_DATA = sizeof DATA / sizeof *DATA;
+
+            for (int ti = 0; ti < NUM_DATA; ++ti) {
+                const int         LINE     = DATA[ti].d_line;
+                const float       VALUE    = DATA[ti].d_value;
+                const char *const EXPECTED = DATA[ti].d_expected;
+                const int         LENGTH   = static_cast<int>(
+                                                           strlen(EXPECTED));
+
+                if (veryVerbose) { T_ P_(LINE) P(EXPECTED) }
+
+                ASSERTV(LINE, LENGTH <= Util::k_TOCHARS_MAX_LENGTH_FLOAT);
+
+                char  buffer[64];
+                memset(buffer, 'x', sizeof buffer);
+
+                char *end = Util::toChars(buffer, buffer + LENGTH, VALUE);
+                ASSERTV(LINE, buffer + LENGTH == end);
+                ASSERTV(LINE, 0 == memcmp(buffer, EXPECTED, LENGTH));
+                ASSERTV(LINE, 'x' == buffer[LENGTH]);
+
+                for (int size = 0; size < LENGTH; ++size) {
+                    memset(buffer, 'x', sizeof buffer);
+                    ASSERTV(LINE, size,
+                            0 == Util::toChars(buffer, buffer + size, VALUE));
+                    ASSERTV(LINE, size, 'x' == buffer[size]);
+                }
+            }
+
+            const float INF = FLT_MAX * 2;
+            const float NAN_VALUE = floatFromBits(0x7FC00000U);
+
+            char  buffer[64];
+            char *end = Util::toChars(buffer, buffer + sizeof buffer, -INF);
+            ASSERT(0 == memcmp(buffer, "-inf", 4) && buffer + 4 == end);
+            end = Util::toChars(buffer, buffer + sizeof buffer, NAN_VALUE);
+            ASSERT(0 == memcmp(buffer, "nan", 3) && buffer + 3 == end);
+        }
+
+        if (verbose) printf("\nNegative Testing.\n");
+        {
+            bsls::AssertTestHandlerGuard hG;
+
+            char buffer[32];
+
+            ASSERT_PASS(Util::toChars(buffer, buffer,      1.0));
+            ASSERT_FAIL(Util::toChars(buffer, buffer - 1,  1.0));
+            ASSERT_FAIL(Util::toChars(buffer, buffer - 1,  1.0f));
+        }
+      } break;
+      case 2: {
+        // --------------------------------------------------------------------
+        // TESTING 'shortestDigits'
+        //
+        // Concerns:
+        //: 1 The digits returned parse back to the original value.
+        //:
+        //: 2 No representation having fewer digits parses back to the value.
+        //:
+        //: 3 Among the representations of minimal length, the one closest to
+        //:   the value is returned.
+        //:
+        //: 4 The first and last digits are not '0', and nothing is written
+        //:   beyond 'k_MAX_DIGITS_DOUBLE' (resp. 'k_MAX_DIGITS_FLOAT')
+        //:   characters.
+        //:
+        //: 5 The above hold for subnormal values, for the smallest and largest
+        //:   values, and for powers of two (whose lower neighbor is closer
+        //:   than the upper one).
+        //:
+        //: 6 The above hold for the values Grisu3 declines, which are handled
+        //:   by the exact fallback.
+        //:
+        //: 7 QoI: Asserted precondition violations are detected when enabled.
+        //
+        // Plan:
+        //: 1 Compare 'shortestDigits' against an oracle that tries every
+        //:   precision, in increasing order, using 'sprintf' to obtain the
+        //:   closest representation of that precision (and its successor),
+        //:   and 'strtod' (or 'strtof') to test the round trip.  (C-1..4)
+        //:
+        //: 2 Apply P-1 to boundary values and every power of two.  (C-5)
+        //:
+        //: 3 Apply P-1 to a large number of pseudo-random bit patterns, which
+        //:   includes several hundred values declined by Grisu3.  (C-6)
+        //:
+        //: 4 Verify that, in appropriate build modes, defensive checks are
+        //:   triggered for non-positive values.  (C-7)
+        //
+        // Testing:
+        //   int shortestDigits(char *, int *, double);
+        //   int shortestDigits(char *, int *, float);
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nTESTING 'shortestDigits'"
+                            "\n========================\n");
+
+        if (verbose) printf("\nBoundary values and powers of two.\n");
+        {
+            verifyDouble(L_, doubleFromBits(1));              // min subnormal
+            verifyDouble(L_, doubleFromBits(0x000FFFFFFFFFFFFFULL));
+            verifyDouble(L_, DBL_MIN);
+            verifyDouble(L_, DBL_MAX);
+            verifyDouble(L_, DBL_EPSILON);
+
+            verifyFloat(L_, floatFromBits(1));
+            verifyFloat(L_, floatFromBits(0x007FFFFFU));
+            verifyFloat(L_, FLT_MIN);
+            verifyFloat(L_, FLT_MAX);
+
+            for (int e = 1; e < 0x7FF; ++e) {
+                const Uint64 bits = static_cast<Uint64>(e) << 52;
+                verifyDouble(e, doubleFromBits(bits));
+                verifyDouble(e, doubleFromBits(bits - 1));
+                verifyDouble(e, doubleFromBits(bits + 1));
+            }
+            for (unsigned int e = 1; e < 0xFF; ++e) {
+                const unsigned int bits = e << 23;
+                verifyFloat(e, floatFromBits(bits));
+                verifyFloat(e, floatFromBits(bits - 1));
+                verifyFloat(e, floatFromBits(bits + 1));
+            }
+        }
+
+        if (verbose) printf("\nPseudo-random values.\n");
+        {
+            const int NUM_ITERATIONS = 50000;
+
+            Uint64 state = 0x12345678;
+            for (int i = 0; i < NUM_ITERATIONS; ++i) {
+                const Uint64 bits = nextRandom(&state)
+                                                    & 0x7FFFFFFFFFFFFFFFULL;
+                if ((bits >> 52) != 0x7FF && 0 != bits) {
+                    verifyDouble(i, doubleFromBits(bits));
+                }
+
+                const unsigned int fbits = static_cast<unsigned int>(
+                                                   bits >> 32) & 0x7FFFFFFFU;
+                if ((fbits >> 23) != 0xFF && 0 != fbits) {
+                    verifyFloat(i, floatFromBits(fbits));
+                }
+            }
+
+            // Short decimal values, such as prices.
+
+            for (int i = 1; i < 100000; i += 7) {
+                verifyDouble(i, i / 100.0);
+                verifyDouble(i, i / 1000.0);
+                verifyFloat(i, static_cast<float>(i) / 100.0f);
+            }
+        }
+
+        if (verbose) printf("\nNegative Testing.\n");
+        {
+            bsls::AssertTestHandlerGuard hG;
+
+            char digits[Util::k_MAX_DIGITS_DOUBLE];
+            int  exponent;
+
+            ASSERT_PASS(Util::shortestDigits(digits, &exponent,  1.0));
+            ASSERT_FAIL(Util::shortestDigits(digits, &exponent,  0.0));
+            ASSERT_FAIL(Util::shortestDigits(digits, &exponent, -1.0));
+            ASSERT_FAIL(Util::shortestDigits(0,      &exponent,  1.0));
+            ASSERT_FAIL(Util::shortestDigits(digits, 0,          1.0));
+
+            ASSERT_PASS(Util::shortestDigits(digits, &exponent,  1.0f));
+            ASSERT_FAIL(Util::shortestDigits(digits, &exponent,  0.0f));
+            ASSERT_FAIL(Util::shortestDigits(digits, &exponent, -1.0f));
+        }
+      } break;
+      case 1: {
+        // --------------------------------------------------------------------
+        // BREATHING TEST
+        //   This case exercises (but does not fully test) basic functionality.
+        //
+        // Concerns:
+        //: 1 The class is sufficiently functional to enable comprehensive
+        //:   testing in subsequent test cases.
+        //
+        // Plan:
+        //: 1 Format a few values and check the results.  (C-1)
+        //
+        // Testing:
+        //   BREATHING TEST
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nBREATHING TEST"
+                            "\n==============\n");
+
+        char  buffer[Util::k_TOCHARS_MAX_LENGTH_DOUBLE];
+        char *end = Util::toChars(buffer, buffer + sizeof buffer, 2.5);
+        ASSERT(buffer + 3 == end);
+        ASSERT(0 == memcmp(buffer, "2.5", 3));
+
+        end = Util::toChars(buffer, buffer + sizeof buffer, 1e-7);
+        ASSERT(buffer + 5 == end);
+        ASSERT(0 == memcmp(buffer, "1e-07", 5));
+
+        end = Util::toChars(buffer, buffer + sizeof buffer, 0.2f);
+        ASSERT(buffer + 3 == end);
+        ASSERT(0 == memcmp(buffer, "0.2", 3));
+
+        char digits[Util::k_MAX_DIGITS_DOUBLE];
+        int  exponent;
+        ASSERT(1  == Util::shortestDigits(digits, &exponent, 0.5));
+        ASSERT(-1 == exponent);
+        ASSERT('5' == digits[0]);
+      } break;
+      case -1: {
+        // --------------------------------------------------------------------
+        // PERFORMANCE: 'toChars' VS. 'sprintf'
+        //
+        // Concerns:
+        //: 1 'toChars' is several times faster than 'sprintf' at a fixed
+        //:   precision.
+        //
+        // Plan:
+        //: 1 Format arrays of pseudo-random values spread over the whole
+        //:   exponent range, and of short decimal values, with 'toChars' and
+        //:   with 'sprintf' using the "%.17g" format, and report the average
+        //:   time per value.  (C-1)
+        //
+        // Testing:
+        //   PERFORMANCE: 'toChars' VS. 'sprintf'
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nPERFORMANCE: 'toChars' VS. 'sprintf'"
+                            "\n====================================\n");
+
+        enum { k_NUM_VALUES = 1000000 };
+
+        double *values = static_cast<double *>(
+                                    malloc(k_NUM_VALUES * sizeof(double)));
+
+        for (int set = 0; set < 2; ++set) {
+            Uint64 state = 42;
+            for (int i = 0; i < k_NUM_VALUES; ++i) {
+                const Uint64 r = nextRandom(&state);
+                values[i] = 0 == set
+                          ? doubleFromBits(r % 0x7FEFFFFFFFFFFFFFULL)
+                          : static_cast<double>(r % 100000000) / 100.0;
+            }
+
+            char        buffer[64];
+            Uint64      total = 0;
+            bsls::Stopwatch timer;
+
+            timer.start(true);
+            for (int i = 0; i < k_NUM_VALUES; ++i) {
+                total += Util::toChars(buffer, buffer + 64, values[i])
+                                                                     - buffer;
+            }
+            timer.stop();
+            const double toCharsTime = timer.accumulatedWallTime();
+
+            timer.reset();
+            timer.start(true);
+            for (int i = 0; i < k_NUM_VALUES; ++i) {
+                total += sprintf(buffer, "%.17g", values[i]);
+            }
+            timer.stop();
+            const double sprintfTime = timer.accumulatedWallTime();
+
+            printf("%s values: toChars %.1f ns, sprintf(\"%%.17g\") %.1f ns, "
+                   "speedup %.1fx (" U64 ")\n",
+                   0 == set ? "random" : "decimal",
+                   toCharsTime * 1e9 / k_NUM_VALUES,
+                   sprintfTime * 1e9 / k_NUM_VALUES,
+                   sprintfTime / toCharsTime,
+                   total);
+        }
+
+        free(values);
+      } break;
+      default: {
+        fprintf(stderr, "WARNING: CASE `%d' NOT FOUND.\n", test);
+        testStatus = -1;
+      }
+    }
+
+    if (testStatus > 0) {
+        fprintf(stderr, "Error, non-zero test status = %d.\n", testStatus);
+    }
+    return testStatus;
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2020 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
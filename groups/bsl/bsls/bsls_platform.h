@@ -15,6 +15,7 @@ BSLS_IDENT("$Id: $")
 //  BSLS_PLATFORM_CPU_* instruction set, instruction width, and version
 //  BSLS_PLATFORM_CMP_*: compiler vendor, and version
 //  BSLS_PLATFORM_AGGRESSIVE_INLINE: inline code for speed over text size
+//  BSLS_PLATFORM_HAS_X86_TARGET_ATTRIBUTE: per-function x86 ISA extensions
 //
 //@SEE_ALSO: bsls_compilerfeatures, bsls_libraryfeatures
 //
@@ -108,6 +109,14 @@ BSLS_IDENT("$Id: $")
 // if 'BDE_BUILD_TARGET_AGGRESSIVE_INLINE' is passed in via the '-D' option of
 // the compiler.
 //
+// The macro 'BSLS_PLATFORM_HAS_X86_TARGET_ATTRIBUTE' is defined on x86
+// processors when the compiler supports the per-function
+// '__attribute__((target("...")))' attribute and the '<cpuid.h>' and
+// '<immintrin.h>' headers, so that a function using instruction set
+// extensions (e.g., SSSE3, AVX2, or PCLMULQDQ) can be compiled regardless of
+// the flags used for the rest of its component, and selected at runtime after
+// querying the processor.
+//
 ///Usage
 ///-----
 // Writing portable software sometimes involves specializing implementations to
@@ -721,6 +730,12 @@ struct bsls_Platform_Assert;
     #define BSLS_PLATFORM_HAS_PRAGMA_GCC_DIAGNOSTIC 1
 #endif
 
+#if (defined(BSLS_PLATFORM_CPU_X86) || defined(BSLS_PLATFORM_CPU_X86_64))    \
+ && ((defined(BSLS_PLATFORM_CMP_GNU) && BSLS_PLATFORM_CMP_VERSION >= 40900)   \
+                                    || defined(BSLS_PLATFORM_CMP_CLANG))
+    #define BSLS_PLATFORM_HAS_X86_TARGET_ATTRIBUTE 1
+#endif
+
 #if !(defined(BSLS_PLATFORM_CMP_AIX) || defined(BSLS_PLATFORM_CMP_SUN)) \
                                 || defined(BDE_BUILD_TARGET_AGGRESSIVE_INLINE)
     #define BSLS_PLATFORM_AGGRESSIVE_INLINE inline
@@ -6,6 +6,11 @@
 #include <stdlib.h>     // 'atoi'
 #include <string.h>     // 'strcmp', 'strlen'
 
+#if defined(BSLS_PLATFORM_HAS_X86_TARGET_ATTRIBUTE)
+#include <cpuid.h>
+#include <immintrin.h>
+#endif
+
 using namespace BloombergLP;
 
 // ============================================================================
@@ -31,6 +36,7 @@ using namespace BloombergLP;
 // [ 2] BSLS_PLATFORM_IS_LITTLE_ENDIAN
 // [ 2] BSLS_PLATFORM_IS_BIG_ENDIAN
 // [ 3] BSLS_PLATFORM_NO_64_BIT_LITERALS
+// [ 5] BSLS_PLATFORM_HAS_X86_TARGET_ATTRIBUTE
 // ============================================================================
 
 // ============================================================================
@@ -71,6 +77,21 @@ void aSsErT(bool condition, const char *message, int line)
 //                   SUPPORTING FUNCTIONS USED FOR TESTING
 // ----------------------------------------------------------------------------
 
+#if defined(BSLS_PLATFORM_HAS_X86_TARGET_ATTRIBUTE)
+__attribute__((target("sse2")))
+static
+int addLanesSse2(int value)
+    // Return the sum of the four lanes of a vector, each of which holds the
+    // specified 'value', computed using SSE2 instructions.  The behavior is
+    // undefined unless the processor supports SSE2.
+{
+    __m128i lanes = _mm_set1_epi32(value);
+    lanes = _mm_add_epi32(lanes, _mm_shuffle_epi32(lanes, 0x4e));
+    lanes = _mm_add_epi32(lanes, _mm_shuffle_epi32(lanes, 0xb1));
+    return _mm_cvtsi128_si32(lanes);
+}
+#endif
+
 static
 bool isBigEndian()
     // Return 'true' if this machine is observed to be big endian, and 'false'
@@ -594,6 +615,12 @@ static void printFlags()
     D_MACRO(BSLS_PLATFORM_HAS_PRAGMA_GCC_DIAGNOSTIC);
 #endif
 
+#if defined(BSLS_PLATFORM_HAS_X86_TARGET_ATTRIBUTE)
+    P_MACRO(BSLS_PLATFORM_HAS_X86_TARGET_ATTRIBUTE);
+#else
+    D_MACRO(BSLS_PLATFORM_HAS_X86_TARGET_ATTRIBUTE);
+#endif
+
 #if defined(BSLS_PLATFORM_NO_64_BIT_LITERALS)
     P_MACRO(BSLS_PLATFORM_NO_64_BIT_LITERALS);
 #else
@@ -1603,6 +1630,57 @@ int main(int argc, char *argv[])
     }
 
     switch (test) { case 0:
+      case 5: {
+        // --------------------------------------------------------------------
+        // TESTING 'BSLS_PLATFORM_HAS_X86_TARGET_ATTRIBUTE'
+        //
+        // Concerns:
+        //: 1 The macro is defined only on x86 processors, and only by
+        //:   compilers supporting the GCC 'target' attribute.
+        //:
+        //: 2 When the macro is defined, a function having a 'target'
+        //:   attribute can use intrinsics of an instruction set extension not
+        //:   enabled for the rest of the translation unit, and can be called
+        //:   once the processor is found to support the extension.
+        //
+        // Plan:
+        //: 1 If the macro is defined, verify that an x86 processor macro and
+        //:   either the Clang or the GCC compiler macro are defined.  (C-1)
+        //:
+        //: 2 If the macro is defined, query the processor with '__get_cpuid'
+        //:   and, if SSE2 is supported, verify the result of a function
+        //:   compiled with 'target("sse2")'.  (C-2)
+        //
+        // Testing:
+        //   BSLS_PLATFORM_HAS_X86_TARGET_ATTRIBUTE
+        // --------------------------------------------------------------------
+
+        if (verbose) printf(
+                      "\nTESTING 'BSLS_PLATFORM_HAS_X86_TARGET_ATTRIBUTE'"
+                      "\n================================================\n");
+
+#if defined(BSLS_PLATFORM_HAS_X86_TARGET_ATTRIBUTE)
+        ASSERT(1 == BSLS_PLATFORM_HAS_X86_TARGET_ATTRIBUTE);
+
+  #if !defined(BSLS_PLATFORM_CPU_X86) && !defined(BSLS_PLATFORM_CPU_X86_64)
+        ASSERT(!"x86 target attribute reported on a non-x86 processor");
+  #endif
+  #if !defined(BSLS_PLATFORM_CMP_CLANG) && !defined(BSLS_PLATFORM_CMP_GNU)
+        ASSERT(!"x86 target attribute reported by an unsupported compiler");
+  #endif
+
+        unsigned int eax, ebx, ecx, edx;
+        if (__get_cpuid(1, &eax, &ebx, &ecx, &edx) && (edx & (1u << 26))) {
+            if (veryVerbose) printf("Calling an SSE2 function.\n");
+
+            ASSERT( 0 == addLanesSse2(0));
+            ASSERT(12 == addLanesSse2(3));
+            ASSERT(-4 == addLanesSse2(-1));
+        }
+#else
+        if (veryVerbose) printf("No x86 target attribute support.\n");
+#endif
+      } break;
       case 4: {
         // --------------------------------------------------------------------
         // TESTING CONCERN: REPORT DEFINITION OF ALL PLATFORM MACROS